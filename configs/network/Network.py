@@ -116,6 +116,13 @@ def define_options(parser):
         default=50000,
         help="network-level deadlock threshold.",
     )
+    parser.add_argument(
+        "--garnet-fast-mode",
+        action="store_true",
+        default=False,
+        help="""model garnet packets as single reservations of the
+            links on their route instead of simulating their flits""",
+    )
     parser.add_argument(
         "--simple-physical-channels",
         action="store_true",
@@ -172,6 +179,7 @@ def init_network(options, network, InterfaceClass):
         network.ni_flit_size = options.link_width_bits / 8
         network.routing_algorithm = options.routing_algorithm
         network.garnet_deadlock_threshold = options.garnet_deadlock_threshold
+        network.fast_mode = options.garnet_fast_mode
 
         # Create Bridges and connect them to the corresponding links
         for intLink in network.int_links:
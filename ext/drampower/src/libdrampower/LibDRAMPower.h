@@ -65,6 +65,11 @@ class libDRAMPower {
 
   void calcWindowEnergy(int64_t timestamp);
 
+  // Evaluate the commands issued so far, up to timestamp, into the counters
+  // of the current window, so that they need not be kept until the window
+  // energy is calculated.
+  void evaluateCommands(int64_t timestamp);
+
   const Data::MemoryPowerModel::Energy& getEnergy() const;
   const Data::MemoryPowerModel::Power& getPower() const;
 
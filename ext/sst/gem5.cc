@@ -123,7 +123,8 @@
 namespace py = pybind11;
 
 gem5Component::gem5Component(SST::ComponentId_t id, SST::Params& params):
-    SST::Component(id), threadInitialized(false)
+    SST::Component(id), threadInitialized(false), terminateThreads(false),
+    quantumEvent(nullptr)
 {
     output.init("gem5Component-" + getName() + "->", 1, 0,
                 SST::Output::STDOUT);
@@ -195,6 +196,7 @@ gem5Component::gem5Component(SST::ComponentId_t id, SST::Params& params):
 
 gem5Component::~gem5Component()
 {
+    stopEventQueueThreads();
 }
 
 void
@@ -234,6 +236,8 @@ gem5Component::init(unsigned phase)
                 "simulate() limit reached",
                 0
             );
+            if (gem5::numMainEventQueues > 1)
+                startEventQueueThreads();
         }
 
     }
@@ -255,6 +259,63 @@ void
 gem5Component::finish()
 {
     output.verbose(CALL_INFO, 1, 0, "Component is being finished.\n");
+    stopEventQueueThreads();
+}
+
+void
+gem5Component::startEventQueueThreads()
+{
+    if (gem5::simQuantum == 0) {
+        output.fatal(
+            CALL_INFO, -1, "Quantum for multi-eventq simulation not set.\n"
+        );
+    }
+
+    // Events crossing queues are at least a quantum away, which is what
+    // lets the queues run concurrently between synchronisations.
+    quantumEvent = new gem5::GlobalSyncEvent(
+        gem5::curTick() + gem5::simQuantum, gem5::simQuantum,
+        gem5::EventBase::Progress_Event_Pri, 0
+    );
+
+    threadBarrier.reset(new gem5::Barrier(gem5::numMainEventQueues));
+    for (uint32_t i = 1; i < gem5::numMainEventQueues; i++) {
+        eventQueueThreads.emplace_back(
+            &gem5Component::eventQueueThreadMain, this,
+            gem5::mainEventQueue[i]
+        );
+    }
+}
+
+void
+gem5Component::stopEventQueueThreads()
+{
+    if (eventQueueThreads.empty())
+        return;
+
+    // The threads are all waiting for the next cycle to start
+    terminateThreads = true;
+    threadBarrier->wait();
+    for (auto &thread : eventQueueThreads)
+        thread.join();
+    eventQueueThreads.clear();
+}
+
+void
+gem5Component::eventQueueThreadMain(gem5::EventQueue* eventq)
+{
+    threadBarrier->wait();
+    while (!terminateThreads) {
+        doSimLoop(eventq);
+        threadBarrier->wait();
+    }
+}
+
+void
+gem5Component::flushRequests()
+{
+    for (auto &port : sstPorts)
+        port->flushRequests();
 }
 
 bool
@@ -262,6 +323,7 @@ gem5Component::clockTick(SST::Cycle_t currentCycle)
 {
     // what to do in a SST's cycle
     gem5::GlobalSimLoopExitEvent *event = simulateGem5(currentCycle);
+    flushRequests();
     clocksProcessed++;
     // gem5 exits due to reasons other than reaching simulation limit
     if (event != gem5::simulate_limit_event) {
@@ -301,14 +363,27 @@ gem5Component::simulateGem5(uint64_t current_cycle)
     uint64_t next_end_tick = \
         timeConverter->convertToCoreTime(current_cycle);
 
-    // Here, if the next event in gem5's queue is not executed within the next
-    // cycle, there's no need to enter the gem5's sim loop.
-    if (gem5::mainEventQueue[0]->empty() ||
-        next_end_tick < gem5::mainEventQueue[0]->getHead()->when()) {
-        return gem5::simulate_limit_event;
+    // Here, if the next event in gem5's queues is not executed within the
+    // next cycle, there's no need to enter the gem5's sim loop.
+    bool idle = true;
+    for (uint32_t i = 0; i < gem5::numMainEventQueues && idle; i++) {
+        gem5::EventQueue *eventq = gem5::mainEventQueue[i];
+        idle = eventq->empty() || next_end_tick < eventq->getHead()->when();
     }
+    if (idle)
+        return gem5::simulate_limit_event;
+
     gem5::simulate_limit_event->reschedule(next_end_tick);
-    gem5::Event *local_event = doSimLoop(gem5::mainEventQueue[0]);
+    gem5::Event *local_event;
+    if (eventQueueThreads.empty()) {
+        local_event = doSimLoop(gem5::mainEventQueue[0]);
+    } else {
+        // The other threads leave their loops at the same global event.
+        gem5::inParallelMode = true;
+        threadBarrier->wait();
+        local_event = doSimLoop(gem5::mainEventQueue[0]);
+        gem5::inParallelMode = false;
+    }
     gem5::BaseGlobalEvent *global_event = local_event->globalEvent();
     gem5::GlobalSimLoopExitEvent *global_exit_event =
         dynamic_cast<gem5::GlobalSimLoopExitEvent *>(global_event);
@@ -323,6 +398,8 @@ gem5Component::doSimLoop(gem5::EventQueue* eventq)
     gem5::curEventQueue(eventq);
     eventq->handleAsyncInsertions();
 
+    bool main_queue = eventq == gem5::mainEventQueue[0];
+
     while (true)
     {
         // there should always be at least one event (the SimLoopExitEvent
@@ -332,7 +409,7 @@ gem5Component::doSimLoop(gem5::EventQueue* eventq)
         assert(gem5::curTick() <= eventq->nextTick() &&
                "event scheduled in the past");
 
-        if (gem5::async_event) {
+        if (main_queue && gem5::async_event) {
             // Take the event queue lock in case any of the service
             // routines want to schedule new events.
             if (gem5::async_statdump || gem5::async_statreset) {
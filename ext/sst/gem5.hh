@@ -73,7 +73,10 @@
 
 #define TRACING_ON 0
 
+#include <atomic>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <sst/core/sst_config.h>
@@ -81,6 +84,8 @@
 
 #include <sst/core/interfaces/stringEvent.h>
 
+#include <base/barrier.hh>
+#include <sim/global_event.hh>
 #include <sim/simulate.hh>
 
 #include <sst/core/eli/elementinfo.h>
@@ -123,6 +128,21 @@ class gem5Component: public SST::Component
 
     bool threadInitialized;
 
+    // When gem5 has several event queues, queue 0 is run by the SST
+    // thread and each of the others by a thread of its own. These wait on
+    // the barrier for a cycle to start, and go back to it at its end.
+    std::vector<std::thread> eventQueueThreads;
+    std::unique_ptr<gem5::Barrier> threadBarrier;
+    std::atomic<bool> terminateThreads;
+    gem5::GlobalSyncEvent* quantumEvent;
+
+    void startEventQueueThreads();
+    void stopEventQueueThreads();
+    void eventQueueThreadMain(gem5::EventQueue* eventq);
+
+    // Send the requests gem5 made during a cycle to SST
+    void flushRequests();
+
     gem5::GlobalSimLoopExitEvent* simulateGem5(gem5::Tick n_cycles);
 
     static gem5::Event* doSimLoop(gem5::EventQueue* eventq);
@@ -29,6 +29,7 @@
 #include <cassert>
 #include <sstream>
 #include <iomanip>
+#include <utility>
 
 #ifdef fatal  // gem5 sets this
 #undef fatal
@@ -92,17 +93,27 @@ bool
 SSTResponderSubComponent::handleTimingReq(
     SST::Interfaces::StandardMem::Request* request)
 {
-    memoryInterface->send(request);
+    std::lock_guard<std::mutex> lock(pendingRequestsLock);
+    pendingRequests.push_back(request);
     return true;
 }
 
+void
+SSTResponderSubComponent::flushRequests()
+{
+    // gem5 is not running at this point, no need to take the lock.
+    for (auto request : pendingRequests)
+        memoryInterface->send(request);
+    pendingRequests.clear();
+}
+
 void
 SSTResponderSubComponent::init(unsigned phase)
 {
     if (phase == 1) {
         for (auto p: responseReceiver->getInitData()) {
             gem5::Addr addr = p.first;
-            std::vector<uint8_t> data = p.second;
+            const std::vector<uint8_t> &data = p.second;
             SST::Interfaces::StandardMem::Request* request = \
                 new SST::Interfaces::StandardMem::Write(
                     addr, data.size(), data);
@@ -138,7 +149,7 @@ SSTResponderSubComponent::handleSwapReqResponse(
     SST::Interfaces::StandardMem::Request::id_t request_id = request->getID();
     TPacketMap::iterator it = sstRequestIdToPacketMap.find(request_id);
     assert(it != sstRequestIdToPacketMap.end());
-    std::vector<uint8_t> data = \
+    std::vector<uint8_t> &data = \
         dynamic_cast<SST::Interfaces::StandardMem::ReadResp*>(request)->data;
 
     // step 1
@@ -160,9 +171,10 @@ SSTResponderSubComponent::handleSwapReqResponse(
     SST::Interfaces::StandardMem::Addr addr = \
         dynamic_cast<SST::Interfaces::StandardMem::ReadResp*>(request)->pAddr;
     auto data_size = data.size();
-    // Create the Write request here.
+    // Create the Write request here, handing it the data of the response.
     SST::Interfaces::StandardMem::Request* write_request = \
-        new SST::Interfaces::StandardMem::Write(addr, data_size, data);
+        new SST::Interfaces::StandardMem::Write(
+            addr, data_size, std::move(data));
     // F_LOCKED flag in SimpleMem was changed to ReadLock and WriteUnlock
     // visitor classes. This has to be addressed in the future. The boot test
     // works without using ReadLock and WriteUnlock classes.
@@ -212,7 +224,7 @@ SSTResponderSubComponent::portEventHandler(
         }
         // for Snoop/no response needed
         // presently no consideration for masterId, packet type, flags...
-        gem5::RequestPtr req = std::make_shared<gem5::Request>(
+        gem5::RequestPtr req = gem5::makeRequest(
             dynamic_cast<SST::Interfaces::StandardMem::FlushAddr*>(
                 request)->pAddr,
             dynamic_cast<SST::Interfaces::StandardMem::FlushAddr*>(
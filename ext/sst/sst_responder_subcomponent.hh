@@ -29,6 +29,7 @@
 
 #define TRACING_ON 0
 
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -64,6 +65,12 @@ class SSTResponderSubComponent: public SST::SubComponent
 
     std::vector<SST::Interfaces::StandardMem::Request*> initRequests;
 
+    // Requests made by gem5 during the current cycle, sent to SST at its
+    // end. They may come from any of gem5's event queue threads, while
+    // the memory interface must only be used by the SST thread.
+    std::vector<SST::Interfaces::StandardMem::Request*> pendingRequests;
+    std::mutex pendingRequestsLock;
+
     std::string gem5SimObjectName;
     std::string memSize;
 
@@ -85,6 +92,7 @@ class SSTResponderSubComponent: public SST::SubComponent
     bool findCorrespondingSimObject(gem5::Root* gem5_root);
 
     bool handleTimingReq(SST::Interfaces::StandardMem::Request* request);
+    void flushRequests();
     void handleRecvRespRetry();
     void handleRecvFunctional(gem5::PacketPtr pkt);
     void handleSwapReqResponse(SST::Interfaces::StandardMem::Request* request);
@@ -27,6 +27,8 @@
 #ifndef __TRANSLATOR_H__
 #define __TRANSLATOR_H__
 
+#include <utility>
+
 #include <sst/core/interfaces/stdMem.h>
 #include <sst/core/interfaces/stringEvent.h>
 #include <sst/elements/memHierarchy/memEvent.h>
@@ -120,8 +122,10 @@ gem5RequestToSSTRequest(gem5::PacketPtr pkt,
             request = new SST::Interfaces::StandardMem::Read(addr, data_size);
             break;
         case Write:
+            // The request takes over the copy of the packet's data.
             request =
-                new SST::Interfaces::StandardMem::Write(addr, data_size, data);
+                new SST::Interfaces::StandardMem::Write(
+                    addr, data_size, std::move(data));
             break;
         case FlushAddr: {
             // StandardMem::FlushAddr has a invoking variable called `depth`
@@ -54,8 +54,11 @@ initMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type,
     // local variables
     int req_size = N * sizeof(T);
     int block_size = gpuDynInst->computeUnit()->cacheLineSize();
+    bool merge_lanes = !is_atomic &&
+        gpuDynInst->computeUnit()->mergeLaneRequests;
     Addr vaddr = 0, split_addr = 0;
     bool misaligned_acc = false;
+    int num_lanes = 1;
     RequestPtr req = nullptr, req1 = nullptr, req2 = nullptr;
     PacketPtr pkt = nullptr, pkt1 = nullptr, pkt2 = nullptr;
 
@@ -78,6 +81,23 @@ initMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type,
              */
             misaligned_acc = split_addr > vaddr;
 
+            /**
+             * the following active lanes which access the bytes right
+             * after this one's, in the same cache line, may be sent in
+             * the same request. their data is contiguous in d_data too.
+             */
+            num_lanes = 1;
+            if (merge_lanes && !misaligned_acc) {
+                while (lane + num_lanes < VegaISA::NumVecElemPerVecReg &&
+                       gpuDynInst->exec_mask[lane + num_lanes] &&
+                       gpuDynInst->addr[lane + num_lanes] ==
+                           vaddr + num_lanes * req_size &&
+                       roundDown(vaddr + (num_lanes + 1) * req_size - 1,
+                                 block_size) == split_addr) {
+                    ++num_lanes;
+                }
+            }
+
             if (is_atomic) {
                 // make sure request is word aligned
                 assert((vaddr & 0x3) == 0);
@@ -85,14 +105,14 @@ initMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type,
                 // a given lane's atomic can't cross cache lines
                 assert(!misaligned_acc);
 
-                req = std::make_shared<Request>(vaddr, sizeof(T), 0,
+                req = makeRequest(vaddr, sizeof(T), 0,
                     gpuDynInst->computeUnit()->requestorId(), 0,
                     gpuDynInst->wfDynId,
                     gpuDynInst->makeAtomicOpFunctor<T>(
                         &(reinterpret_cast<T*>(gpuDynInst->a_data))[lane],
                         &(reinterpret_cast<T*>(gpuDynInst->x_data))[lane]));
             } else {
-                req = std::make_shared<Request>(vaddr, req_size, 0,
+                req = makeRequest(vaddr, req_size * num_lanes, 0,
                                   gpuDynInst->computeUnit()->requestorId(), 0,
                                   gpuDynInst->wfDynId);
             }
@@ -122,6 +142,12 @@ initMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type,
                 pkt->dataStatic(&(reinterpret_cast<T*>(
                     gpuDynInst->d_data))[lane * N]);
                 gpuDynInst->computeUnit()->sendRequest(gpuDynInst, lane, pkt);
+
+                // the merged lanes are completed by the response to the
+                // request of the first one
+                for (int i = 1; i < num_lanes; ++i)
+                    gpuDynInst->setStatusVector(lane + i, 0);
+                lane += num_lanes - 1;
             }
         } else { // if lane is not active, then no pending requests
             gpuDynInst->setStatusVector(lane, 0);
@@ -157,7 +183,7 @@ initMemReqScalarHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type)
      */
     bool misaligned_acc = split_addr > vaddr;
 
-    RequestPtr req = std::make_shared<Request>(vaddr, req_size, 0,
+    RequestPtr req = makeRequest(vaddr, req_size, 0,
                                  gpuDynInst->computeUnit()->requestorId(), 0,
                                  gpuDynInst->wfDynId);
 
@@ -33,6 +33,7 @@
 #define __ARCH_VEGA_INSTS_INST_UTIL_HH__
 
 #include <cmath>
+#include <cstdint>
 
 #include "arch/amdgpu/vega/gpu_registers.hh"
 #include "arch/amdgpu/vega/insts/gpu_static_inst.hh"
@@ -242,6 +243,58 @@ namespace VegaISA
         }
     }
 
+    template<typename T, typename Op, typename... SrcT>
+    inline void
+    laneOpImpl(uint64_t mask, T *dst, Op op, const SrcT *...src)
+    {
+        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+            const T result = op(src[lane]...);
+            dst[lane] = ((mask >> lane) & 1) ? result : dst[lane];
+        }
+    }
+
+    /**
+     * Apply op to every lane of the source operands and store the result
+     * in the lanes of vdst enabled in exec_mask. The operation is computed
+     * for the inactive lanes too and the result blended in, so the loop
+     * has no branches or calls and can be turned into host SIMD code. op
+     * must therefore be safe to call on any input (e.g., no integer
+     * division), and have no side effects.
+     */
+    template<typename Dst, typename Op, typename... Srcs>
+    inline void
+    laneOp(const VectorMask &exec_mask, Dst &vdst, Op op, Srcs &...srcs)
+    {
+        static_assert(NumVecElemPerVecReg <= 64,
+                      "The exec mask must fit in 64 bits.");
+        laneOpImpl(exec_mask.to_ullong(), vdst.lanes(), op, srcs.lanes()...);
+    }
+
+    template<typename Op, typename... SrcT>
+    inline uint64_t
+    laneCmpImpl(Op op, const SrcT *...src)
+    {
+        uint64_t result = 0;
+        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+            result |= uint64_t(op(src[lane]...) ? 1 : 0) << lane;
+        }
+        return result;
+    }
+
+    /**
+     * Evaluate the comparison op for every lane of the source operands,
+     * and merge the results into the lanes of sdst enabled in exec_mask.
+     * Like laneOp(), the comparison is computed for all lanes.
+     */
+    template<typename Dst, typename Op, typename... Srcs>
+    inline void
+    laneCmp(const VectorMask &exec_mask, Dst &sdst, Op op, Srcs &...srcs)
+    {
+        const uint64_t mask = exec_mask.to_ullong();
+        const uint64_t result = laneCmpImpl(op, srcs.lanes()...);
+        sdst = (sdst.rawData() & ~mask) | (result & mask);
+    }
+
     template<typename T>
     inline T
     median(T val_0, T val_1, T val_2)
@@ -925,7 +925,7 @@ namespace VegaISA
             // create request and set flags
             gpuDynInst->resetEntireStatusVector();
             gpuDynInst->setStatusVector(0, 1);
-            RequestPtr req = std::make_shared<Request>(0, 0, 0,
+            RequestPtr req = makeRequest(0, 0, 0,
                                        gpuDynInst->computeUnit()->
                                        requestorId(), 0,
                                        gpuDynInst->wfDynId);
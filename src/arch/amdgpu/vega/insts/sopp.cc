@@ -472,6 +472,7 @@ namespace VegaISA
             int bar_id = wf->barrierId();
             assert(wf->getStatus() == Wavefront::S_BARRIER);
             cu->incNumAtBarrier(bar_id);
+            cu->ppBarrier->notify(wf);
             DPRINTF(GPUSync, "CU[%d] WF[%d][%d] Wave[%d] - Stalling at "
                     "barrier Id%d. %d waves now at barrier, %d waves "
                     "remain.\n", cu->cu_id, wf->simdId, wf->wfSlotId,
@@ -699,7 +700,7 @@ namespace VegaISA
 
         gpuDynInst->resetEntireStatusVector();
         gpuDynInst->setStatusVector(0, 1);
-        RequestPtr req = std::make_shared<Request>(0, 0, 0,
+        RequestPtr req = makeRequest(0, 0, 0,
                                    gpuDynInst->computeUnit()->
                                    requestorId(), 0,
                                    gpuDynInst->wfDynId);
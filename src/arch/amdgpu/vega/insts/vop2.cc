@@ -127,11 +127,8 @@ namespace VegaISA
                 }
             }
         } else {
-            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src0[lane] + src1[lane];
-                }
-            }
+            laneOp(wf->execMask(), vdst,
+                [](auto s0, auto s1) { return s0 + s1; }, src0, src1);
         }
 
         vdst.write();
@@ -163,11 +160,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 - s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -198,11 +192,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 - s0; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -232,11 +223,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 * s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -481,11 +469,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::fmin(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -515,11 +500,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::fmax(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -548,11 +530,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::min(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -581,11 +560,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::max(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -614,11 +590,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::min(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -647,11 +620,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::max(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -682,11 +652,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 >> bits(s0, 4, 0); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -717,11 +684,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 >> bits(s0, 4, 0); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -791,11 +755,10 @@ namespace VegaISA
 
             processSDWA_dst(extData.iFmt_VOP_SDWA, vdst, origVdst);
         } else {
-            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src1[lane] << bits(src0[lane], 4, 0);
-                }
-            }
+            laneOp(wf->execMask(), vdst,
+                [](auto s0, auto s1) {
+                    return s1 << bits(s0, 4, 0);
+                }, src0, src1);
         }
 
         vdst.write();
@@ -851,11 +814,8 @@ namespace VegaISA
                 }
             }
         } else {
-            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src0[lane] & src1[lane];
-                }
-            }
+            laneOp(wf->execMask(), vdst,
+                [](auto s0, auto s1) { return s0 & s1; }, src0, src1);
         }
 
         vdst.write();
@@ -926,11 +886,8 @@ namespace VegaISA
 
             processSDWA_dst(extData.iFmt_VOP_SDWA, vdst, origVdst);
         } else {
-            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src0[lane] | src1[lane];
-                }
-            }
+            laneOp(wf->execMask(), vdst,
+                [](auto s0, auto s1) { return s0 | s1; }, src0, src1);
         }
 
         vdst.write();
@@ -961,11 +918,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] ^ src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 ^ s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1024,11 +978,10 @@ namespace VegaISA
                 }
             }
         } else {
-            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = std::fma(src0[lane], src1[lane], vdst[lane]);
-                }
-            }
+            laneOp(wf->execMask(), vdst,
+                [](auto s0, auto s1, auto d) {
+                    return std::fma(s0, s1, d);
+                }, src0, src1, vdst);
         }
 
         vdst.write();
@@ -1598,11 +1551,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 + s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1632,11 +1582,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 - s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1667,11 +1614,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 - s0; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1701,11 +1645,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 * s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1735,11 +1676,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 3, 0);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 << bits(s0, 3, 0); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1770,11 +1708,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> src0[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 >> s0; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1805,11 +1740,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> src0[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 >> s0; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1882,11 +1814,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::max(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1915,11 +1844,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::max(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1948,11 +1874,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::min(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1981,11 +1904,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::min(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -2074,11 +1994,8 @@ namespace VegaISA
 
             processSDWA_dst(extData.iFmt_VOP_SDWA, vdst, origVdst);
         } else {
-            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src0[lane] + src1[lane];
-                }
-            }
+            laneOp(wf->execMask(), vdst,
+                [](auto s0, auto s1) { return s0 + s1; }, src0, src1);
         }
 
         vdst.write();
@@ -2108,11 +2025,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 - s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -2141,11 +2055,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 - s0; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -2175,11 +2086,10 @@ namespace VegaISA
         src1.read();
         vdst.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], vdst[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto d) {
+                return std::fma(s0, s1, d);
+            }, src0, src1, vdst);
 
         vdst.write();
     } // execute
@@ -2209,11 +2119,8 @@ namespace VegaISA
         src1.read();
         vdst.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = ~(src0[lane] ^ src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return ~(s0 ^ s1); }, src0, src1);
 
         vdst.write();
     } // execute
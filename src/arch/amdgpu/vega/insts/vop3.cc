@@ -133,11 +133,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 + s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -190,11 +187,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 - s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -247,11 +241,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 - s0; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -584,11 +575,10 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = bits(src0[lane], 23, 0) * bits(src1[lane], 23, 0);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) {
+                return bits(s0, 23, 0) * bits(s1, 23, 0);
+            }, src0, src1);
 
         vdst.write();
     } // execute
@@ -685,11 +675,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::fmin(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -741,11 +728,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::fmax(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -784,11 +768,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::min(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -827,11 +808,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::max(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -870,11 +848,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::min(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -913,11 +888,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::max(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -958,11 +930,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 >> bits(s0, 4, 0); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1003,11 +972,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 >> bits(s0, 4, 0); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1047,11 +1013,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 4, 0);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 << bits(s0, 4, 0); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1091,11 +1054,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] & src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 & s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1135,11 +1095,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] | src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 | s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1181,11 +1138,10 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] | src1[lane] | src2[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto s2) {
+                return s0 | s1 | s2;
+            }, src0, src1, src2);
 
         vdst.write();
     } // execute
@@ -1225,11 +1181,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] ^ src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 ^ s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1284,11 +1237,10 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], vdst[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto d) {
+                return std::fma(s0, s1, d);
+            }, src0, src1, vdst);
 
         vdst.write();
     } // execute
@@ -1743,11 +1695,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 + s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1787,11 +1736,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 - s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1832,11 +1778,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 - s0; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1876,11 +1819,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 * s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1920,11 +1860,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 3, 0);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 << bits(s0, 3, 0); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1971,11 +1908,8 @@ namespace VegaISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 3, 0);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 >> bits(s0, 3, 0); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -2016,11 +1950,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 3, 0);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 >> bits(s0, 3, 0); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -2109,11 +2040,8 @@ namespace VegaISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::max(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -2158,11 +2086,8 @@ namespace VegaISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::max(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -2207,11 +2132,8 @@ namespace VegaISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::min(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -2256,11 +2178,8 @@ namespace VegaISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::min(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -2319,11 +2238,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 + s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -2362,11 +2278,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s0 - s1; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -2405,11 +2318,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 - s0; }, src0, src1);
 
         vdst.write();
     } // execute
@@ -5093,11 +5003,10 @@ namespace VegaISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto s2) {
+                return std::fma(s0, s1, s2);
+            }, src0, src1, src2);
 
         vdst.write();
     } // execute
@@ -5154,11 +5063,10 @@ namespace VegaISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto s2) {
+                return std::fma(s0, s1, s2);
+            }, src0, src1, src2);
 
         vdst.write();
     } // execute
@@ -5540,11 +5448,10 @@ namespace VegaISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto s2) {
+                return std::fma(s0, s1, s2);
+            }, src0, src1, src2);
 
         vdst.write();
     } // execute
@@ -5601,11 +5508,10 @@ namespace VegaISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto s2) {
+                return std::fma(s0, s1, s2);
+            }, src0, src1, src2);
 
         vdst.write();
     } // execute
@@ -6852,11 +6758,10 @@ namespace VegaISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto s2) {
+                return std::fma(s0, s1, s2);
+            }, src0, src1, src2);
 
         //vdst.write();
     } // execute
@@ -7144,11 +7049,10 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (src0[lane] ^ src1[lane]) + src2[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto s2) {
+                return (s0 ^ s1) + s2;
+            }, src0, src1, src2);
 
         vdst.write();
     } // execute
@@ -7281,11 +7185,10 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane] + src2[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto s2) {
+                return s0 + s1 + s2;
+            }, src0, src1, src2);
 
         vdst.write();
     } // execute
@@ -7373,11 +7276,10 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (src0[lane] & src1[lane]) | src2[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto s2) {
+                return (s0 & s1) | s2;
+            }, src0, src1, src2);
 
         vdst.write();
     } // execute
@@ -7442,11 +7344,10 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane] + src2[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto s2) {
+                return s0 * s1 + s2;
+            }, src0, src1, src2);
 
         vdst.write();
     } // execute
@@ -7489,11 +7390,10 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane] + src2[lane];
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1, auto s2) {
+                return s0 * s1 + s2;
+            }, src0, src1, src2);
 
         vdst.write();
     } // execute
@@ -8109,11 +8009,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::fmin(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -8165,11 +8062,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return std::fmax(s0, s1); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -8677,11 +8571,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 5, 0);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 << bits(s0, 5, 0); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -8722,11 +8613,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 5, 0);
-            }
-        }
+        laneOp(wf->execMask(), vdst,
+            [](auto s0, auto s1) { return s1 >> bits(s0, 5, 0); }, src0, src1);
 
         vdst.write();
     } // execute
@@ -1346,11 +1346,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -1381,11 +1378,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -1416,11 +1410,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -1451,11 +1442,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -1486,11 +1474,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -1521,11 +1506,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -1626,11 +1608,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] >= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 >= s1); }, src0, src1);
 
         sdst.write();
     } // execute
@@ -1697,11 +1676,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] > src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 > s1); }, src0, src1);
 
         sdst.write();
     } // execute
@@ -1732,11 +1708,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] <= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 <= s1); }, src0, src1);
 
         sdst.write();
     } // execute
@@ -1767,11 +1740,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -1802,11 +1772,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] < src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 < s1); }, src0, src1);
 
         sdst.write();
     } // execute
@@ -1900,11 +1867,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -1937,11 +1901,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -1974,11 +1935,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -2011,11 +1969,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -2086,11 +2041,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -2201,11 +2153,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] >= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 >= s1); }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -2276,11 +2225,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] > src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 > s1); }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -2313,11 +2259,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] <= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 <= s1); }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -2350,11 +2293,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -2387,11 +2327,8 @@ namespace VegaISA
         src0.readSrc();
         src1.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] < src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 < s1); }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -2506,11 +2443,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -2563,11 +2497,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -2620,11 +2551,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -2677,11 +2605,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -2792,11 +2717,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -2963,11 +2885,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] >= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 >= s1); }, src0, src1);
 
         sdst.write();
     } // execute
@@ -3078,11 +2997,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] > src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 > s1); }, src0, src1);
 
         sdst.write();
     } // execute
@@ -3135,11 +3051,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] <= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 <= s1); }, src0, src1);
 
         sdst.write();
     } // execute
@@ -3192,11 +3105,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -3249,11 +3159,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] < src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 < s1); }, src0, src1);
 
         sdst.write();
     } // execute
@@ -3369,11 +3276,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -3428,11 +3332,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -3487,11 +3388,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -3546,11 +3444,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -3665,11 +3560,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -3846,11 +3738,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] >= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 >= s1); }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -3965,11 +3854,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] > src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 > s1); }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -4024,11 +3910,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] <= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 <= s1); }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -4083,11 +3966,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -4142,11 +4022,8 @@ namespace VegaISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, !(src0[lane] < src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return !(s0 < s1); }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -4247,11 +4124,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -4291,11 +4165,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -4335,11 +4206,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -4379,11 +4247,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -4423,11 +4288,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -4467,11 +4329,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -4567,11 +4426,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -4611,11 +4467,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -4655,11 +4508,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -4699,11 +4549,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -4743,11 +4590,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -4787,11 +4631,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -4891,11 +4732,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -4937,11 +4775,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -4983,11 +4818,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -5029,11 +4861,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -5075,11 +4904,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -5121,11 +4947,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -5229,11 +5052,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -5275,11 +5095,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -5321,11 +5138,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -5367,11 +5181,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -5413,11 +5224,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -5459,11 +5267,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -5563,11 +5368,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -5607,11 +5409,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -5651,11 +5450,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -5695,11 +5491,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -5739,11 +5532,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -5783,11 +5573,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -5883,11 +5670,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -5927,11 +5711,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -5971,11 +5752,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -6015,11 +5793,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -6059,11 +5834,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -6103,11 +5875,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -6207,11 +5976,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -6253,11 +6019,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -6299,11 +6062,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -6345,11 +6105,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -6391,11 +6148,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -6437,11 +6191,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -6545,11 +6296,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -6591,11 +6339,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -6637,11 +6382,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -6683,11 +6425,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -6729,11 +6468,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -6775,11 +6511,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -6879,11 +6612,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -6923,11 +6653,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -6967,11 +6694,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -7011,11 +6735,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -7055,11 +6776,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -7099,11 +6817,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -7199,11 +6914,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -7243,11 +6955,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -7287,11 +6996,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -7331,11 +7037,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -7375,11 +7078,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -7419,11 +7119,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         sdst.write();
     } // execute
@@ -7523,11 +7220,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -7569,11 +7263,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -7615,11 +7306,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -7661,11 +7349,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -7707,11 +7392,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -7753,11 +7435,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -7861,11 +7540,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -7907,11 +7583,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -7953,11 +7626,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -7999,11 +7669,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -8045,11 +7712,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -8091,11 +7755,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                sdst.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), sdst,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = sdst.rawData();
         sdst.write();
@@ -147,11 +147,13 @@ namespace VegaISA
             result[(i/16)*4+3][(i%16)] = src2[3][i];
         }
 
-        // Compute new result - This is (obviously) not optimized
+        // Compute new result. The innermost loop walks along a row of B
+        // and of the result so it can be vectorized.
         for (int i = 0; i < 16; ++i) {
-            for (int j = 0; j < 16; ++j) {
-                for (int k = 0; k < 16; ++k) {
-                    result[i][j] += A[i][k] * B[k][j];
+            for (int k = 0; k < 16; ++k) {
+                const int32_t a = A[i][k];
+                for (int j = 0; j < 16; ++j) {
+                    result[i][j] += a * B[k][j];
                 }
             }
         }
@@ -250,14 +252,18 @@ namespace VegaISA
             result[(i/16)+12][(i%16)] = src2[3][i];
         }
 
-        // Compute new result
+        // src0 is column major, src1 is row major
+        const double *A = src0.lanes();
+        const double *B = src1.lanes();
+
+        // Compute new result. Each element still accumulates the products
+        // in order of k, but the innermost loop walks along a row of B and
+        // of the result so it can be vectorized.
         for (int i = 0; i < 16; ++i) {
-            for (int j = 0; j < 16; ++j) {
-                for (int k = 0; k < 4; ++k) {
-                    // src0 is column major, src1 is row major
-                    int lane_A = 16*k + i;
-                    int lane_B = 16*k + j;
-                    result[i][j] += src0[lane_A] * src1[lane_B];
+            for (int k = 0; k < 4; ++k) {
+                const double a = A[16*k + i];
+                for (int j = 0; j < 16; ++j) {
+                    result[i][j] += a * B[16*k + j];
                 }
             }
         }
@@ -29,6 +29,7 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "arch/amdgpu/vega/insts/inst_util.hh"
 #include "arch/amdgpu/vega/insts/instructions.hh"
 
 namespace gem5
@@ -1277,11 +1278,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -1311,11 +1309,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -1345,11 +1340,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -1379,11 +1371,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -1448,11 +1437,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -1552,11 +1538,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] >= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 >= s1); }, src0, src1);
 
         vcc.write();
     } // execute
@@ -1621,11 +1604,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] > src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 > s1); }, src0, src1);
 
         vcc.write();
     } // execute
@@ -1655,11 +1635,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] <= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 <= s1); }, src0, src1);
 
         vcc.write();
     } // execute
@@ -1689,11 +1666,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -1723,11 +1697,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] < src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 < s1); }, src0, src1);
 
         vcc.write();
     } // execute
@@ -1818,11 +1789,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         vcc.write();
         wf->execMask() = vcc.rawData();
@@ -1854,11 +1822,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         vcc.write();
         wf->execMask() = vcc.rawData();
@@ -1890,11 +1855,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         vcc.write();
         wf->execMask() = vcc.rawData();
@@ -1926,11 +1888,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         vcc.write();
         wf->execMask() = vcc.rawData();
@@ -1999,11 +1958,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         vcc.write();
         wf->execMask() = vcc.rawData();
@@ -2111,11 +2067,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] >= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 >= s1); }, src0, src1);
 
         vcc.write();
         wf->execMask() = vcc.rawData();
@@ -2184,11 +2137,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] > src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 > s1); }, src0, src1);
 
         vcc.write();
         wf->execMask() = vcc.rawData();
@@ -2220,11 +2170,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] <= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 <= s1); }, src0, src1);
 
         vcc.write();
         wf->execMask() = vcc.rawData();
@@ -2256,11 +2203,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] == src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 == s1); }, src0, src1);
 
         vcc.write();
         wf->execMask() = vcc.rawData();
@@ -2292,11 +2236,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] < src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 < s1); }, src0, src1);
 
         vcc.write();
         wf->execMask() = vcc.rawData();
@@ -2387,11 +2328,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -2421,11 +2359,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -2455,11 +2390,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -2489,11 +2421,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -2558,11 +2487,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -2662,11 +2588,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] >= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 >= s1); }, src0, src1);
 
         vcc.write();
     } // execute
@@ -2731,11 +2654,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] > src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 > s1); }, src0, src1);
 
         vcc.write();
     } // execute
@@ -2765,11 +2685,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] <= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 <= s1); }, src0, src1);
 
         vcc.write();
     } // execute
@@ -2799,11 +2716,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -2833,11 +2747,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] < src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 < s1); }, src0, src1);
 
         vcc.write();
     } // execute
@@ -2928,11 +2839,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         vcc.write();
         wf->execMask() = vcc.rawData();
@@ -2964,11 +2872,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         vcc.write();
         wf->execMask() = vcc.rawData();
@@ -3000,11 +2905,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -3036,11 +2938,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -3109,11 +3008,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -3221,11 +3117,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] >= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 >= s1); }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -3294,11 +3187,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] > src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 > s1); }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -3330,11 +3220,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] <= src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 <= s1); }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -3366,11 +3253,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -3402,11 +3286,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, !(src0[lane] < src1[lane]) ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return !(s0 < s1); }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -3495,11 +3376,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -3528,11 +3406,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -3561,11 +3436,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -3594,11 +3466,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -3627,11 +3496,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -3660,11 +3526,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -3749,11 +3612,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -3782,11 +3642,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -3815,11 +3672,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -3848,11 +3702,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -3881,11 +3732,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -3914,11 +3762,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -4006,11 +3851,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -4041,11 +3883,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -4076,11 +3915,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -4111,11 +3947,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -4146,11 +3979,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -4181,11 +4011,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -4276,11 +4103,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -4311,11 +4135,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -4346,11 +4167,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -4381,11 +4199,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -4416,11 +4231,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -4451,11 +4263,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -4543,11 +4352,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -4576,11 +4382,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -4609,11 +4412,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -4642,11 +4442,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -4675,11 +4472,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -4708,11 +4502,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -4797,11 +4588,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -4830,11 +4618,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -4863,11 +4648,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -4896,11 +4678,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -4929,11 +4708,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -4962,11 +4738,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -5054,11 +4827,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -5089,11 +4859,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -5124,11 +4891,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -5159,11 +4923,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -5194,11 +4955,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -5229,11 +4987,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -5324,11 +5079,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -5359,11 +5111,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -5394,11 +5143,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -5429,11 +5175,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -5464,11 +5207,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -5499,11 +5239,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -5591,11 +5328,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -5624,11 +5358,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -5657,11 +5388,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -5690,11 +5418,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -5723,11 +5448,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -5756,11 +5478,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -5845,11 +5564,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -5878,11 +5594,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -5911,11 +5624,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -5944,11 +5654,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -5977,11 +5684,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -6010,11 +5714,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         vcc.write();
     } // execute
@@ -6102,11 +5803,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -6137,11 +5835,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -6172,11 +5867,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -6207,11 +5899,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -6242,11 +5931,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -6277,11 +5963,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -6372,11 +6055,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] < src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 < s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -6407,11 +6087,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] == src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 == s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -6442,11 +6119,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] <= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 <= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -6477,11 +6151,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] > src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 > s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -6512,11 +6183,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] != src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 != s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -6547,11 +6215,8 @@ namespace VegaISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vcc.setBit(lane, src0[lane] >= src1[lane] ? 1 : 0);
-            }
-        }
+        laneCmp(wf->execMask(), vcc,
+            [](auto s0, auto s1) { return s0 >= s1; }, src0, src1);
 
         wf->execMask() = vcc.rawData();
         vcc.write();
@@ -316,6 +316,42 @@ namespace VegaISA
             return vecReg.template as<DataType>()[idx];
         }
 
+        /**
+         * get the values of all lanes as a plain array, which lane loops
+         * can be vectorized over. scalar operands are broadcast to all
+         * lanes and the abs/neg modifiers are applied first, after which
+         * operator[] reads the same values as before.
+         */
+        template<bool Condition = (NumDwords == 1 || NumDwords == 2) && Const>
+        typename std::enable_if<Condition, const DataType*>::type
+        lanes()
+        {
+            auto vgpr = vecReg.template as<DataType>();
+
+            if (scalar || absMod || negMod) {
+                for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                    vgpr[lane] = (*this)[lane];
+                }
+                scalar = false;
+                absMod = false;
+                negMod = false;
+            }
+
+            return vgpr;
+        }
+
+        /**
+         * get the lanes of a destination operand as a plain array.
+         */
+        template<bool Condition = (NumDwords == 1 || NumDwords == 2) && !Const>
+        typename std::enable_if<Condition, DataType*>::type
+        lanes()
+        {
+            assert(!scalar);
+
+            return vecReg.template as<DataType>();
+        }
+
         private:
           /**
            * if we determine that this operand is a scalar (reg or constant)
@@ -142,6 +142,7 @@ ISA::clear()
     }
 
     updateRegMap(miscRegs[MISCREG_CPSR]);
+    clearPlainMiscRegs();
 }
 
 void
@@ -401,6 +402,9 @@ ISA::readMiscRegNoEffect(RegIndex idx) const
 RegVal
 ISA::readMiscReg(RegIndex idx)
 {
+    if (plainMiscRegReads[idx])
+        return readMiscRegNoEffect(idx);
+
     CPSR cpsr = 0;
     SCR scr = 0;
 
@@ -422,6 +426,7 @@ ISA::readMiscReg(RegIndex idx)
                   miscRegName[idx]);
     }
 #endif
+    const RegIndex orig_idx = idx;
     idx = redirectRegVHE(idx);
 
     switch (unflattenMiscReg(idx)) {
@@ -626,6 +631,10 @@ ISA::readMiscReg(RegIndex idx)
         return getGICv3CPUInterface().readMiscReg(idx);
 
       default:
+        if (idx == orig_idx &&
+                lookUpMiscReg[idx].info[MISCREG_IMPLEMENTED]) {
+            plainMiscRegReads.set(idx);
+        }
         break;
 
     }
@@ -652,11 +661,20 @@ ISA::setMiscRegNoEffect(RegIndex idx, RegVal val)
         DPRINTF(MiscRegs, "Writing MiscReg %s (%d %d) : %#x\n",
                 miscRegName[idx], idx, lower, v);
     }
+
+    if (selectsMiscRegMode(lower) ||
+            (upper > 0 && selectsMiscRegMode(upper))) {
+        clearPlainMiscRegs();
+    }
 }
 
 void
 ISA::setMiscReg(RegIndex idx, RegVal val)
 {
+    if (plainMiscRegWrites[idx]) {
+        setMiscRegNoEffect(idx, val);
+        return;
+    }
 
     RegVal newVal = val;
     bool secure_lookup;
@@ -723,6 +741,7 @@ ISA::setMiscReg(RegIndex idx, RegVal val)
                     miscRegName[idx], val);
         }
 #endif
+        const RegIndex orig_idx = idx;
         idx = redirectRegVHE(idx);
 
         switch (unflattenMiscReg(idx)) {
@@ -1340,6 +1359,12 @@ ISA::setMiscReg(RegIndex idx, RegVal val)
             tc->getDecoderPtr()->as<Decoder>().setSmeLen(
                     (getCurSmeVecLenInBits() >> 7) - 1);
             return;
+          default:
+            if (idx == orig_idx &&
+                    lookUpMiscReg[idx].info[MISCREG_IMPLEMENTED]) {
+                plainMiscRegWrites.set(idx);
+            }
+            break;
         }
         setMiscRegNoEffect(idx, newVal);
     }
@@ -1566,6 +1591,7 @@ ISA::unserialize(CheckpointIn &cp)
 
     CPSR tmp_cpsr = miscRegs[MISCREG_CPSR];
     updateRegMap(tmp_cpsr);
+    clearPlainMiscRegs();
 }
 
 void
@@ -1580,7 +1606,7 @@ ISA::addressTranslation64(MMU::ArmTranslationType tran_type,
     // with unexpected atomic snoop requests.
     warn_once("Doing AT (address translation) in functional mode! Fix Me!\n");
 
-    auto req = std::make_shared<Request>(
+    auto req = makeRequest(
         val, 0, flags,  Request::funcRequestorId,
         tc->pcState().instAddr(), tc->contextId());
 
@@ -1631,7 +1657,7 @@ ISA::addressTranslation(MMU::ArmTranslationType tran_type,
     // with unexpected atomic snoop requests.
     warn_once("Doing AT (address translation) in functional mode! Fix Me!\n");
 
-    auto req = std::make_shared<Request>(
+    auto req = makeRequest(
         val, 0, flags,  Request::funcRequestorId,
         tc->pcState().instAddr(), tc->contextId());
 
@@ -41,6 +41,8 @@
 #ifndef __ARCH_ARM_ISA_HH__
 #define __ARCH_ARM_ISA_HH__
 
+#include <bitset>
+
 #include "arch/arm/isa_device.hh"
 #include "arch/arm/mmu.hh"
 #include "arch/arm/pcstate.hh"
@@ -125,6 +127,39 @@ namespace ArmISA
         RegVal miscRegs[NUM_MISCREGS];
         const RegId *intRegMap;
 
+        /**
+         * Registers whose last read (write) through readMiscReg
+         * (setMiscReg) took none of its special cases and wasn't
+         * redirected, so their accesses can go straight to storage.
+         * Redirection and banking depend on the mode selected by CPSR,
+         * SCR and HCR, so the sets are cleared whenever those change.
+         */
+        std::bitset<NUM_MISCREGS> plainMiscRegReads;
+        std::bitset<NUM_MISCREGS> plainMiscRegWrites;
+
+        static bool
+        selectsMiscRegMode(int reg)
+        {
+            switch (reg) {
+              case MISCREG_CPSR:
+              case MISCREG_SCR:
+              case MISCREG_SCR_EL3:
+              case MISCREG_HCR:
+              case MISCREG_HCR2:
+              case MISCREG_HCR_EL2:
+                return true;
+              default:
+                return false;
+            }
+        }
+
+        void
+        clearPlainMiscRegs()
+        {
+            plainMiscRegReads.reset();
+            plainMiscRegWrites.reset();
+        }
+
         void
         updateRegMap(CPSR cpsr)
         {
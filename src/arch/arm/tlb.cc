@@ -40,6 +40,7 @@
 
 #include "arch/arm/tlb.hh"
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -65,6 +66,19 @@ TLB::TLB(const ArmTLBParams &p)
       tableWalker(nullptr),
       stats(*this), rangeMRU(1), vmid(0)
 {
+    lruPrev.resize(size);
+    lruNext.resize(size);
+    lruStamp.resize(size);
+    slotIndexed.resize(size, Indexed::None);
+    for (int x = 0; x < size; x++) {
+        lruPrev[x] = x - 1;
+        lruNext[x] = x + 1 < size ? x + 1 : -1;
+        lruStamp[x] = size - x;
+    }
+    lruHead = 0;
+    lruTail = size - 1;
+    nextStamp = size;
+
     for (int lvl = LookupLevel::L0;
          lvl < LookupLevel::Num_ArmLookupLevel; lvl++) {
 
@@ -102,52 +116,163 @@ TLB::setTableWalker(TableWalker *table_walker)
     tableWalker->setTlb(this);
 }
 
+void
+TLB::indexSlot(int x)
+{
+    const TlbEntry &entry = table[x];
+    if (entry.N < 64 && entry.size == (Addr(1) << entry.N) - 1) {
+        // Compute the page number as matchAddress() sees it
+        Addr page = (entry.vpn << entry.N) >> entry.N;
+        pageIndex[pageKey(page, entry.N)].push_back(x);
+        pageShifts[entry.N]++;
+        slotIndexed[x] = Indexed::ByPage;
+    } else {
+        unindexed.push_back(x);
+        slotIndexed[x] = Indexed::Unindexed;
+    }
+}
+
+void
+TLB::unindexSlot(int x)
+{
+    auto remove = [x](std::vector<int> &slots) {
+        auto it = std::find(slots.begin(), slots.end(), x);
+        assert(it != slots.end());
+        *it = slots.back();
+        slots.pop_back();
+    };
+
+    const TlbEntry &entry = table[x];
+    if (slotIndexed[x] == Indexed::ByPage) {
+        Addr page = (entry.vpn << entry.N) >> entry.N;
+        auto bucket = pageIndex.find(pageKey(page, entry.N));
+        assert(bucket != pageIndex.end());
+        remove(bucket->second);
+        if (bucket->second.empty())
+            pageIndex.erase(bucket);
+
+        auto shift = pageShifts.find(entry.N);
+        if (--shift->second == 0)
+            pageShifts.erase(shift);
+    } else if (slotIndexed[x] == Indexed::Unindexed) {
+        remove(unindexed);
+    }
+    slotIndexed[x] = Indexed::None;
+}
+
+void
+TLB::touchSlot(int x)
+{
+    if (x == lruHead)
+        return;
+
+    // Unlink the slot
+    lruNext[lruPrev[x]] = lruNext[x];
+    if (lruNext[x] != -1)
+        lruPrev[lruNext[x]] = lruPrev[x];
+    else
+        lruTail = lruPrev[x];
+
+    // And make it the head of the list
+    lruPrev[x] = -1;
+    lruNext[x] = lruHead;
+    lruPrev[lruHead] = x;
+    lruHead = x;
+    lruStamp[x] = ++nextStamp;
+}
+
+bool
+TLB::slotWithin(int x, int pos) const
+{
+    for (int y = lruHead; y != -1 && pos >= 0; y = lruNext[y], pos--) {
+        if (y == x)
+            return true;
+    }
+    return false;
+}
+
 TlbEntry*
 TLB::match(const Lookup &lookup_data)
 {
-    // Vector of TLB entry candidates.
-    // Only one of them will be assigned to retval and will
-    // be returned to the MMU (in case of a hit)
-    // The vector has one entry per lookup level as it stores
-    // both complete and partial matches
-    std::vector<std::pair<int, const TlbEntry*>> hits{
-        LookupLevel::Num_ArmLookupLevel, {0, nullptr}};
-
-    int x = 0;
-    while (x < size) {
-        if (table[x].match(lookup_data)) {
-            const TlbEntry &entry = table[x];
-            hits[entry.lookupLevel] = std::make_pair(x, &entry);
-
-            // This is a complete translation, no need to loop further
-            if (!entry.partial)
+    // TLB entry candidates, one per lookup level as both complete and
+    // partial matches are stored. Only one of them will be returned to
+    // the MMU (in case of a hit)
+    std::array<int, LookupLevel::Num_ArmLookupLevel> hits;
+    hits.fill(-1);
+
+    // Record a matching slot, visiting matches in LRU order. Returns
+    // true for a complete translation, as there is no need to look
+    // further
+    auto visit = [&](int x) {
+        const TlbEntry &entry = table[x];
+        hits[entry.lookupLevel] = x;
+        return !entry.partial;
+    };
+
+    // Gather the matching entries through the page index, which only
+    // holds valid entries. Range lookups, or more matches than fit in
+    // the candidate array, scan all slots instead.
+    constexpr int max_matches = 16;
+    std::array<int, max_matches> matches;
+    int num_matches = 0;
+    bool scan = lookup_data.size != 0;
+
+    auto candidate = [&](int x) {
+        if (scan || !table[x].match(lookup_data))
+            return;
+        if (num_matches == max_matches) {
+            scan = true;
+            return;
+        }
+        // Keep the matches sorted from most to least recently used
+        int i = num_matches++;
+        while (i > 0 && lruStamp[matches[i - 1]] < lruStamp[x]) {
+            matches[i] = matches[i - 1];
+            i--;
+        }
+        matches[i] = x;
+    };
+
+    if (!scan) {
+        for (const auto &[n, count] : pageShifts) {
+            auto bucket = pageIndex.find(pageKey(lookup_data.va >> n, n));
+            if (bucket != pageIndex.end()) {
+                for (int x : bucket->second)
+                    candidate(x);
+            }
+        }
+        for (int x : unindexed)
+            candidate(x);
+    }
+
+    if (scan) {
+        for (int x = lruHead; x != -1; x = lruNext[x]) {
+            if (table[x].match(lookup_data) && visit(x))
+                break;
+        }
+    } else {
+        for (int i = 0; i < num_matches; i++) {
+            if (visit(matches[i]))
                 break;
         }
-        ++x;
     }
 
     // Loop over the list of TLB entries matching our translation
     // request, starting from the highest lookup level (complete
     // translation) and iterating backwards (using reverse iterators)
     for (auto it = hits.rbegin(); it != hits.rend(); it++) {
-        const auto& [idx, entry] = *it;
-        if (!entry) {
+        const int x = *it;
+        if (x == -1) {
             // No match for the current LookupLevel
             continue;
         }
 
-        // Maintaining LRU array
-        // We only move the hit entry ahead when the position is higher
+        // Maintaining LRU order
+        // We only move the hit entry ahead when its position is higher
         // than rangeMRU
-        if (idx > rangeMRU && !lookup_data.functional) {
-            TlbEntry tmp_entry = *entry;
-            for (int i = idx; i > 0; i--)
-                table[i] = table[i - 1];
-            table[0] = tmp_entry;
-            return &table[0];
-        } else {
-            return &table[idx];
-        }
+        if (!lookup_data.functional && !slotWithin(x, rangeMRU))
+            touchSlot(x);
+        return &table[x];
     }
 
     return nullptr;
@@ -248,19 +373,23 @@ TLB::insert(TlbEntry &entry)
             entry.ap, static_cast<uint8_t>(entry.domain), entry.ns,
             entry.nstid, regimeToStr(entry.regime));
 
-    if (table[size - 1].valid)
+    const int x = lruTail;
+    const TlbEntry &victim = table[x];
+    if (victim.valid)
         DPRINTF(TLB, " - Replacing Valid entry %#x, asn %d vmn %d ppn %#x "
                 "size: %#x ap:%d ns:%d nstid:%d g:%d regime: %s\n",
-                table[size-1].vpn << table[size-1].N, table[size-1].asid,
-                table[size-1].vmid, table[size-1].pfn << table[size-1].N,
-                table[size-1].size, table[size-1].ap, table[size-1].ns,
-                table[size-1].nstid, table[size-1].global,
-                regimeToStr(table[size-1].regime));
+                victim.vpn << victim.N, victim.asid,
+                victim.vmid, victim.pfn << victim.N,
+                victim.size, victim.ap, victim.ns,
+                victim.nstid, victim.global,
+                regimeToStr(victim.regime));
 
     // inserting to MRU position and evicting the LRU one
-    for (int i = size - 1; i > 0; --i)
-        table[i] = table[i-1];
-    table[0] = entry;
+    unindexSlot(x);
+    table[x] = entry;
+    touchSlot(x);
+    if (table[x].valid)
+        indexSlot(x);
 
     stats.inserts++;
     ppRefills->notify(1);
@@ -283,14 +412,11 @@ TLB::multiInsert(TlbEntry &entry)
 void
 TLB::printTlb() const
 {
-    int x = 0;
-    TlbEntry *te;
     DPRINTF(TLB, "Current TLB contents:\n");
-    while (x < size) {
-        te = &table[x];
+    for (int x = lruHead; x != -1; x = lruNext[x]) {
+        const TlbEntry *te = &table[x];
         if (te->valid)
             DPRINTF(TLB, " *  %s\n", te->print());
-        ++x;
     }
 }
 
@@ -298,17 +424,15 @@ void
 TLB::flushAll()
 {
     DPRINTF(TLB, "Flushing all TLB entries\n");
-    int x = 0;
-    TlbEntry *te;
-    while (x < size) {
-        te = &table[x];
+    for (int x = lruHead; x != -1; x = lruNext[x]) {
+        TlbEntry *te = &table[x];
 
         if (te->valid) {
             DPRINTF(TLB, " -  %s\n", te->print());
             te->valid = false;
+            unindexSlot(x);
             stats.flushedEntries++;
         }
-        ++x;
     }
 
     stats.flushTlb++;
@@ -317,16 +441,14 @@ TLB::flushAll()
 void
 TLB::flush(const TLBIOp& tlbi_op)
 {
-    int x = 0;
-    TlbEntry *te;
-    while (x < size) {
-        te = &table[x];
+    for (int x = lruHead; x != -1; x = lruNext[x]) {
+        TlbEntry *te = &table[x];
         if (tlbi_op.match(te, vmid)) {
             DPRINTF(TLB, " -  %s\n", te->print());
             te->valid = false;
+            unindexSlot(x);
             stats.flushedEntries++;
         }
-        ++x;
     }
 
     stats.flushTlb++;
@@ -41,6 +41,9 @@
 #ifndef __ARCH_ARM_TLB_HH__
 #define __ARCH_ARM_TLB_HH__
 
+#include <map>
+#include <unordered_map>
+#include <vector>
 
 #include "arch/arm/faults.hh"
 #include "arch/arm/pagetable.hh"
@@ -107,6 +110,40 @@ class TLB : public BaseTLB
     /** TLB Size */
     int size;
 
+    /**
+     * Replacement order of the table slots as a doubly linked list,
+     * from the most to the least recently used slot. Entries stay in
+     * their slot; a slot's position in this list is its LRU position.
+     * @{
+     */
+    std::vector<int> lruPrev;
+    std::vector<int> lruNext;
+    int lruHead;
+    int lruTail;
+    /** @} */
+
+    /**
+     * A slot's stamp is higher than the stamps of all slots after it in
+     * the LRU list, which orders lookup candidates without walking it.
+     */
+    std::vector<uint64_t> lruStamp;
+    uint64_t nextStamp;
+
+    /** How a slot's entry can be found by match() */
+    enum class Indexed : uint8_t { None, ByPage, Unindexed };
+    std::vector<Indexed> slotIndexed;
+
+    /**
+     * Slots of valid entries keyed by their page number and page size,
+     * and the number of indexed entries of each page size. A lookup
+     * probes one bucket per page size in use.
+     */
+    std::unordered_map<Addr, std::vector<int>> pageIndex;
+    std::map<uint8_t, unsigned> pageShifts;
+
+    /** Valid entries whose size is not a power of two page */
+    std::vector<int> unindexed;
+
     /** Indicates this TLB caches IPA->PA translations */
     bool isStage2;
 
@@ -279,6 +316,25 @@ class TLB : public BaseTLB
     /** Helper function looking up for a matching TLB entry
      * Does not update stats; see lookup method instead */
     TlbEntry *match(const Lookup &lookup_data);
+
+    /** Key of a page in the page index */
+    static Addr
+    pageKey(Addr vpn, uint8_t n)
+    {
+        return (vpn << 6) ^ n;
+    }
+
+    /** Add a slot holding a valid entry to the lookup indexes */
+    void indexSlot(int x);
+
+    /** Remove a slot from the lookup indexes */
+    void unindexSlot(int x);
+
+    /** Make a slot the most recently used one */
+    void touchSlot(int x);
+
+    /** True if a slot is within the first pos + 1 LRU positions */
+    bool slotWithin(int x, int pos) const;
 };
 
 } // namespace ArmISA
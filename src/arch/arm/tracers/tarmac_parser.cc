@@ -954,7 +954,7 @@ TarmacParserRecord::TarmacParserRecord(Tick _when, ThreadContext *_thread,
       parsingStarted(false), mismatch(false),
       mismatchOnPcOrOpcode(false), parent(_parent)
 {
-    memReq = std::make_shared<Request>();
+    memReq = makeRequest();
     if (maxVectorLength == 0) {
         maxVectorLength = ArmStaticInst::getCurSveVecLen<uint64_t>(_thread);
     }
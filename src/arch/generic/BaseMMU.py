@@ -49,6 +49,12 @@ class BaseMMU(SimObject):
     itb = Param.BaseTLB("Instruction TLB")
     dtb = Param.BaseTLB("Data TLB")
 
+    # Recently translated pages are remembered by the MMU when the ISA
+    # allows it, so repeated accesses skip the TLB lookup.
+    translation_memo_entries = Param.Unsigned(
+        16, "Number of pages in the translation memo, 0 to disable it"
+    )
+
     @classmethod
     def walkerPorts(cls):
         # This classmethod is used by the BaseCPU. It should return
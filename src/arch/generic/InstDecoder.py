@@ -34,3 +34,9 @@ class InstDecoder(SimObject):
     cxx_class = "gem5::InstDecoder"
 
     isa = Param.BaseISA(NULL, "ISA object for this context")
+    shared_decode_cache = Param.Bool(
+        False,
+        "Share decoded instructions with the decoders of the other CPUs, "
+        "including those simulated by other threads, where the ISA "
+        "supports it",
+    )
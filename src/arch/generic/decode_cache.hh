@@ -50,6 +50,9 @@ class BasicDecodeCache
         EMI machInst;
     };
     decode_cache::AddrMap<AddrMapEntry> decodePages;
+    /// Fast path in front of decodePages. Its instructions are kept
+    /// alive by instMap, which never drops any.
+    decode_cache::DirectMap<EMI> recentInsts;
 
   public:
     /// Decode a machine instruction.
@@ -58,20 +61,23 @@ class BasicDecodeCache
     StaticInstPtr
     decode(Decoder *const decoder, EMI mach_inst, Addr addr)
     {
-        auto &entry = decodePages.lookup(addr);
-        if (entry.inst && (entry.machInst == mach_inst))
-            return entry.inst;
+        if (StaticInst *si = recentInsts.lookup(addr, mach_inst))
+            return si;
 
-        entry.machInst = mach_inst;
+        auto &entry = decodePages.lookup(addr);
+        if (!entry.inst || !(entry.machInst == mach_inst)) {
+            entry.machInst = mach_inst;
 
-        auto iter = instMap.find(mach_inst);
-        if (iter != instMap.end()) {
-            entry.inst = iter->second;
-            return entry.inst;
+            auto iter = instMap.find(mach_inst);
+            if (iter != instMap.end()) {
+                entry.inst = iter->second;
+            } else {
+                entry.inst = decoder->decodeInst(mach_inst);
+                instMap[mach_inst] = entry.inst;
+            }
         }
 
-        entry.inst = decoder->decodeInst(mach_inst);
-        instMap[mach_inst] = entry.inst;
+        recentInsts.insert(addr, mach_inst, entry.inst.get());
         return entry.inst;
     }
 };
@@ -80,6 +80,8 @@ BaseMMU::init()
 void
 BaseMMU::flushAll()
 {
+    flushMemo();
+
     for (auto tlb : instruction) {
         tlb->flushAll();
     }
@@ -96,21 +98,125 @@ BaseMMU::flushAll()
 void
 BaseMMU::demapPage(Addr vaddr, uint64_t asn)
 {
+    flushMemo();
     itb->demapPage(vaddr, asn);
     dtb->demapPage(vaddr, asn);
 }
 
+class BaseMMU::MemoTranslation : public BaseMMU::Translation
+{
+  private:
+    BaseMMU *mmu;
+    Translation *translation;
+    const MemoContext ctx;
+    const Request::FlagsType flags;
+    const uint64_t memoGeneration;
+
+  public:
+    MemoTranslation(BaseMMU *_mmu, Translation *_translation,
+                    const MemoContext &_ctx, Request::FlagsType _flags)
+      : mmu(_mmu), translation(_translation), ctx(_ctx), flags(_flags),
+        memoGeneration(_mmu->memoGeneration)
+    {}
+
+    void markDelayed() override { translation->markDelayed(); }
+
+    void
+    finish(const Fault &fault, const RequestPtr &req, ThreadContext *tc,
+           BaseMMU::Mode mode) override
+    {
+        if (fault == NoFault)
+            mmu->memoInsert(req, tc, mode, ctx, flags, memoGeneration);
+        translation->finish(fault, req, tc, mode);
+        delete this;
+    }
+
+    bool squashed() const override { return translation->squashed(); }
+};
+
+bool
+BaseMMU::memoLookup(const RequestPtr &req, ThreadContext *tc,
+                    BaseMMU::Mode mode, const MemoContext &ctx)
+{
+    if (!ctx.pageBytes)
+        return false;
+
+    const Addr vaddr = req->getVaddr();
+    const Addr offset = vaddr & (ctx.pageBytes - 1);
+    const Addr vpage = vaddr - offset;
+    if (offset + req->getSize() > ctx.pageBytes)
+        return false;
+
+    const MemoEntry &entry = memo[(vpage / ctx.pageBytes) % memo.size()];
+    if (entry.memoGeneration != memoGeneration ||
+            entry.generation != ctx.generation || entry.tc != tc ||
+            entry.mode != mode || entry.pageBytes != ctx.pageBytes ||
+            entry.vpage != vpage || entry.flags != req->getFlags()) {
+        return false;
+    }
+
+    req->setFlags(entry.newFlags);
+    req->setPaddr(entry.ppage | offset);
+    return true;
+}
+
+void
+BaseMMU::memoInsert(const RequestPtr &req, ThreadContext *tc,
+                    BaseMMU::Mode mode, const MemoContext &ctx,
+                    Request::FlagsType flags, uint64_t memo_generation)
+{
+    const Addr vaddr = req->getVaddr();
+    const Addr offset = vaddr & (ctx.pageBytes - 1);
+    const Addr vpage = vaddr - offset;
+    if (offset + req->getSize() > ctx.pageBytes)
+        return;
+
+    MemoEntry &entry = memo[(vpage / ctx.pageBytes) % memo.size()];
+    entry.tc = tc;
+    entry.mode = mode;
+    entry.flags = flags;
+    entry.pageBytes = ctx.pageBytes;
+    entry.vpage = vpage;
+    entry.generation = ctx.generation;
+    entry.memoGeneration = memo_generation;
+    entry.ppage = req->getPaddr() - offset;
+    entry.newFlags = req->getFlags() & ~flags;
+}
+
 Fault
 BaseMMU::translateAtomic(const RequestPtr &req, ThreadContext *tc,
                          BaseMMU::Mode mode)
 {
-    return getTlb(mode)->translateAtomic(req, tc, mode);
+    if (memo.empty())
+        return getTlb(mode)->translateAtomic(req, tc, mode);
+
+    const MemoContext ctx = memoContext(tc, mode);
+    if (memoLookup(req, tc, mode, ctx))
+        return NoFault;
+
+    const Request::FlagsType flags = req->getFlags();
+    const uint64_t memo_generation = memoGeneration;
+    Fault fault = getTlb(mode)->translateAtomic(req, tc, mode);
+    if (fault == NoFault && ctx.pageBytes)
+        memoInsert(req, tc, mode, ctx, flags, memo_generation);
+    return fault;
 }
 
 void
 BaseMMU::translateTiming(const RequestPtr &req, ThreadContext *tc,
                          BaseMMU::Translation *translation, BaseMMU::Mode mode)
 {
+    if (!memo.empty()) {
+        const MemoContext ctx = memoContext(tc, mode);
+        if (memoLookup(req, tc, mode, ctx)) {
+            translation->finish(NoFault, req, tc, mode);
+            return;
+        }
+        if (ctx.pageBytes) {
+            translation = new MemoTranslation(
+                    this, translation, ctx, req->getFlags());
+        }
+    }
     return getTlb(mode)->translateTiming(req, tc, translation, mode);
 }
 
@@ -144,7 +250,7 @@ BaseMMU::MMUTranslationGen::translate(Range &range) const
         next += pageBytes;
     range.size = std::min(range.size, next - range.vaddr);
 
-    auto req = std::make_shared<Request>(
+    auto req = makeRequest(
             range.vaddr, range.size, flags, Request::funcRequestorId, 0, cid);
 
     range.fault = mmu->translateFunctional(req, tc, mode);
@@ -156,6 +262,9 @@ BaseMMU::MMUTranslationGen::translate(Range &range) const
 void
 BaseMMU::takeOverFrom(BaseMMU *old_mmu)
 {
+    flushMemo();
+    old_mmu->flushMemo();
+
     Port *old_itb_port = old_mmu->itb->getTableWalkerPort();
     Port *old_dtb_port = old_mmu->dtb->getTableWalkerPort();
     Port *new_itb_port = itb->getTableWalkerPort();
@@ -39,6 +39,7 @@
 #define __ARCH_GENERIC_MMU_HH__
 
 #include <set>
+#include <vector>
 
 #include "mem/request.hh"
 #include "mem/translation_gen.hh"
@@ -88,7 +89,8 @@ class BaseMMU : public SimObject
     typedef BaseMMUParams Params;
 
     BaseMMU(const Params &p)
-      : SimObject(p), dtb(p.dtb), itb(p.itb)
+      : SimObject(p), dtb(p.dtb), itb(p.itb),
+        memo(p.translation_memo_entries)
     {}
 
     BaseTLB*
@@ -158,6 +160,67 @@ class BaseMMU : public SimObject
     BaseTLB* dtb;
     BaseTLB* itb;
 
+  protected:
+    /** What the memoized translations of a context depend on */
+    struct MemoContext
+    {
+        /** Size of the pages to memoize, 0 to not memoize */
+        Addr pageBytes = 0;
+        /** Changes whenever the translations of the context change */
+        uint64_t generation = 0;
+    };
+
+    /**
+     * Tell whether the translations of a context can be memoized. While
+     * the returned generation stays the same, translating an access that
+     * fits in one page with the same request flags must always give the
+     * same physical page, add the same request flags, and have no other
+     * effect such as updating TLB statistics. By default nothing is
+     * memoized.
+     */
+    virtual MemoContext
+    memoContext(ThreadContext *tc, Mode mode) const
+    {
+        return MemoContext();
+    }
+
+    /** Forget all memoized translations */
+    void flushMemo() { memoGeneration++; }
+
+  private:
+    /** A recently translated page */
+    struct MemoEntry
+    {
+        ThreadContext *tc = nullptr;
+        Mode mode = Read;
+        Request::FlagsType flags = 0;
+        Addr pageBytes = 0;
+        Addr vpage = 0;
+        uint64_t generation = 0;
+        uint64_t memoGeneration = 0;
+        Addr ppage = 0;
+        /** Request flags the translation added */
+        Request::FlagsType newFlags = 0;
+    };
+
+    /** Direct mapped memo of the last translated pages */
+    std::vector<MemoEntry> memo;
+
+    /** Memo entries from an older generation are stale */
+    uint64_t memoGeneration = 1;
+
+    /** Forwards the result of a timing translation to the memo */
+    class MemoTranslation;
+
+    /** Complete a translation from the memo, return false on a miss */
+    bool memoLookup(const RequestPtr &req, ThreadContext *tc, Mode mode,
+                    const MemoContext &ctx);
+
+    /** Memoize the translation of req, started with the given flags */
+    void memoInsert(const RequestPtr &req, ThreadContext *tc, Mode mode,
+                    const MemoContext &ctx, Request::FlagsType flags,
+                    uint64_t memo_generation);
+
   protected:
     /**
      * It is possible from the MMU to traverse the entire hierarchy of
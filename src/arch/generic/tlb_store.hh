@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_GENERIC_TLB_STORE_HH__
+#define __ARCH_GENERIC_TLB_STORE_HH__
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Fixed size, fully associative storage for TLB entries with LRU
+ * replacement.
+ *
+ * Each entry is stored with a key of which only the first width bits,
+ * counted from the most significant one, are significant. This is how
+ * the entries were stored in a Trie, and lookup() gives the same result
+ * as Trie::lookup(): of all the entries matching a key, the one with the
+ * shortest width. Entries are found through an open addressing hash of
+ * their significant bits, probed once for each width in use, so lookups
+ * don't chase pointers or allocate memory.
+ *
+ * Free slots are handed out in the order they were freed, and the LRU
+ * order is kept as a list of slots, so finding the victim is O(1).
+ */
+template <class Entry>
+class TlbStore
+{
+  public:
+    static constexpr unsigned MaxBits = sizeof(Addr) * 8;
+
+  private:
+    struct Slot
+    {
+        bool valid = false;
+        unsigned width = 0;
+        Addr prefix = 0;
+        /** Neighbours in the LRU list, towards the LRU and MRU ends */
+        int older = -1;
+        int newer = -1;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<Slot> slots;
+
+    /** Ring of free slots, oldest freed first */
+    std::vector<int> freeSlots;
+    size_t freeHead = 0;
+    size_t numFree;
+
+    int lruOldest = -1;
+    int lruNewest = -1;
+
+    /** Hash table of slot indices, -1 when empty */
+    std::vector<int> table;
+    size_t tableMask;
+
+    /** Number of entries of each width, and the widths in use sorted */
+    std::array<unsigned, MaxBits + 1> widthCount{};
+    std::vector<unsigned> widths;
+
+    static Addr
+    prefixOf(Addr key, unsigned width)
+    {
+        return width ? key >> (MaxBits - width) : 0;
+    }
+
+    size_t
+    home(Addr prefix, unsigned width) const
+    {
+        uint64_t hash = (prefix + width) * 0x9e3779b97f4a7c15ULL;
+        return (hash ^ (hash >> 32)) & tableMask;
+    }
+
+    void
+    link(int idx)
+    {
+        Slot &slot = slots[idx];
+        slot.older = lruNewest;
+        slot.newer = -1;
+        if (lruNewest != -1)
+            slots[lruNewest].newer = idx;
+        else
+            lruOldest = idx;
+        lruNewest = idx;
+    }
+
+    void
+    unlink(int idx)
+    {
+        Slot &slot = slots[idx];
+        if (slot.older != -1)
+            slots[slot.older].newer = slot.newer;
+        else
+            lruOldest = slot.newer;
+        if (slot.newer != -1)
+            slots[slot.newer].older = slot.older;
+        else
+            lruNewest = slot.older;
+    }
+
+  public:
+    explicit TlbStore(size_t size)
+        : entries(size), slots(size), freeSlots(size), numFree(size)
+    {
+        for (size_t i = 0; i < size; i++)
+            freeSlots[i] = i;
+
+        size_t table_size = 8;
+        while (table_size < 2 * size)
+            table_size *= 2;
+        table.assign(table_size, -1);
+        tableMask = table_size - 1;
+        widths.reserve(MaxBits + 1);
+    }
+
+    size_t size() const { return entries.size(); }
+    size_t numValid() const { return size() - numFree; }
+    bool full() const { return numFree == 0; }
+    bool valid(size_t idx) const { return slots[idx].valid; }
+
+    Entry &operator[](size_t idx) { return entries[idx]; }
+    const Entry &operator[](size_t idx) const { return entries[idx]; }
+
+    /** The slot an entry returned by this store is in */
+    size_t
+    index(const Entry *entry) const
+    {
+        assert(entry >= entries.data() && entry < entries.data() + size());
+        return entry - entries.data();
+    }
+
+    /**
+     * Find the entry with the shortest width whose significant bits match
+     * those of key.
+     */
+    Entry *
+    lookup(Addr key)
+    {
+        for (unsigned width : widths) {
+            const Addr prefix = prefixOf(key, width);
+            for (size_t i = home(prefix, width); table[i] != -1;
+                    i = (i + 1) & tableMask) {
+                const Slot &slot = slots[table[i]];
+                if (slot.width == width && slot.prefix == prefix)
+                    return &entries[table[i]];
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Copy an entry into the oldest free slot and make it the most
+     * recently used one. The store must not be full.
+     *
+     * @param key Key to find the entry by.
+     * @param width Number of significant bits of the key.
+     * @param entry Entry to store.
+     * @return The stored entry.
+     */
+    Entry *
+    insert(Addr key, unsigned width, const Entry &entry)
+    {
+        assert(!full() && width <= MaxBits);
+        const int idx = freeSlots[freeHead];
+        freeHead = (freeHead + 1) % size();
+        numFree--;
+
+        entries[idx] = entry;
+        Slot &slot = slots[idx];
+        slot.valid = true;
+        slot.width = width;
+        slot.prefix = prefixOf(key, width);
+        link(idx);
+
+        size_t i = home(slot.prefix, width);
+        while (table[i] != -1)
+            i = (i + 1) & tableMask;
+        table[i] = idx;
+
+        if (widthCount[width]++ == 0)
+            widths.insert(std::lower_bound(widths.begin(), widths.end(),
+                        width), width);
+
+        return &entries[idx];
+    }
+
+    /** Free a slot holding a valid entry */
+    void
+    remove(size_t idx)
+    {
+        Slot &slot = slots[idx];
+        assert(slot.valid);
+
+        size_t hole = home(slot.prefix, slot.width);
+        while (table[hole] != (int)idx)
+            hole = (hole + 1) & tableMask;
+        // Move back the entries of the probe sequence which can no longer
+        // be reached past the hole.
+        for (size_t i = (hole + 1) & tableMask; table[i] != -1;
+                i = (i + 1) & tableMask) {
+            const Slot &other = slots[table[i]];
+            const size_t other_home = home(other.prefix, other.width);
+            if (((i - other_home) & tableMask) >= ((i - hole) & tableMask)) {
+                table[hole] = table[i];
+                hole = i;
+            }
+        }
+        table[hole] = -1;
+
+        if (--widthCount[slot.width] == 0)
+            widths.erase(std::find(widths.begin(), widths.end(),
+                        slot.width));
+
+        unlink(idx);
+        slot.valid = false;
+        freeSlots[(freeHead + numFree) % size()] = idx;
+        numFree++;
+    }
+
+    /** Make a valid entry the most recently used one */
+    void
+    touch(size_t idx)
+    {
+        assert(slots[idx].valid);
+        if ((int)idx == lruNewest)
+            return;
+        unlink(idx);
+        link(idx);
+    }
+
+    /** The slot of the least recently used valid entry */
+    size_t
+    lru() const
+    {
+        assert(lruOldest != -1);
+        return lruOldest;
+    }
+
+    /**
+     * Rebuild the LRU order from the entries themselves, for instance
+     * after restoring them from a checkpoint.
+     *
+     * @param less Tells whether an entry was used before another one.
+     */
+    template <class Less>
+    void
+    sortLru(Less less)
+    {
+        std::vector<int> order;
+        for (int idx = lruOldest; idx != -1; idx = slots[idx].newer)
+            order.push_back(idx);
+        std::stable_sort(order.begin(), order.end(),
+                [this, &less](int a, int b)
+                { return less(entries[a], entries[b]); });
+
+        lruOldest = lruNewest = -1;
+        for (int idx : order)
+            link(idx);
+    }
+};
+
+} // namespace gem5
+
+#endif // __ARCH_GENERIC_TLB_STORE_HH__
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+#include "arch/generic/tlb_store.hh"
+#include "base/trie.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Entry
+{
+    int id = 0;
+    uint64_t seq = 0;
+};
+
+} // anonymous namespace
+
+TEST(TlbStore, Empty)
+{
+    TlbStore<Entry> store(4);
+    EXPECT_EQ(store.size(), 4);
+    EXPECT_EQ(store.numValid(), 0);
+    EXPECT_FALSE(store.full());
+    EXPECT_EQ(store.lookup(0x1234), nullptr);
+}
+
+TEST(TlbStore, PrefixMatch)
+{
+    TlbStore<Entry> store(4);
+    Entry *e = store.insert(0x0123456789abcdef, 40, Entry{1});
+    EXPECT_EQ(e->id, 1);
+    EXPECT_EQ(store.lookup(0x123456701234567), nullptr);
+    EXPECT_EQ(store.lookup(0x123456789ab0000), e);
+    EXPECT_EQ(store.lookup(0x0123456789ffffff), e);
+}
+
+TEST(TlbStore, ShortestWidthWins)
+{
+    TlbStore<Entry> store(4);
+    Entry *narrow = store.insert(0x0123456789abcdef, 40, Entry{1});
+    Entry *wide = store.insert(0x0123456789abcdef, 36, Entry{2});
+    EXPECT_EQ(store.lookup(0x0123456789abcdef), wide);
+    store.remove(store.index(wide));
+    EXPECT_EQ(store.lookup(0x0123456789abcdef), narrow);
+}
+
+TEST(TlbStore, FullWidthAndZeroWidth)
+{
+    TlbStore<Entry> store(4);
+    Entry *exact = store.insert(0x1000, TlbStore<Entry>::MaxBits, Entry{1});
+    EXPECT_EQ(store.lookup(0x1000), exact);
+    EXPECT_EQ(store.lookup(0x1001), nullptr);
+    Entry *all = store.insert(0, 0, Entry{2});
+    EXPECT_EQ(store.lookup(0x1000), all);
+    EXPECT_EQ(store.lookup(0xffffffffffffffff), all);
+}
+
+TEST(TlbStore, FreeSlotsReusedInOrder)
+{
+    TlbStore<Entry> store(3);
+    for (int i = 0; i < 3; i++)
+        store.insert(i << 12, 52, Entry{i});
+    EXPECT_TRUE(store.full());
+    store.remove(1);
+    store.remove(0);
+    EXPECT_EQ(store.index(store.insert(0x10000, 52, Entry{3})), 1);
+    EXPECT_EQ(store.index(store.insert(0x20000, 52, Entry{4})), 0);
+}
+
+TEST(TlbStore, LruOrder)
+{
+    TlbStore<Entry> store(3);
+    for (int i = 0; i < 3; i++)
+        store.insert(i << 12, 52, Entry{i});
+    EXPECT_EQ(store.lru(), 0);
+    store.touch(0);
+    EXPECT_EQ(store.lru(), 1);
+    store.remove(1);
+    EXPECT_EQ(store.lru(), 2);
+    store.touch(2);
+    EXPECT_EQ(store.lru(), 0);
+}
+
+TEST(TlbStore, SortLru)
+{
+    TlbStore<Entry> store(3);
+    store.insert(0x1000, 52, Entry{0, 30});
+    store.insert(0x2000, 52, Entry{1, 10});
+    store.insert(0x3000, 52, Entry{2, 20});
+    store.sortLru([](const Entry &a, const Entry &b)
+            { return a.seq < b.seq; });
+    EXPECT_EQ(store.lru(), 1);
+    store.remove(1);
+    EXPECT_EQ(store.lru(), 2);
+    store.remove(2);
+    EXPECT_EQ(store.lru(), 0);
+}
+
+/**
+ * Replay random TLB traffic against a Trie with LRU sequence numbers,
+ * which is how the TLBs stored their entries before, and check that
+ * lookups and victims are the same.
+ */
+TEST(TlbStore, MatchesTrie)
+{
+    constexpr int size = 32;
+    std::mt19937_64 rng(1);
+
+    TlbStore<Entry> store(size);
+    Trie<Addr, Entry> trie;
+    struct RefSlot
+    {
+        Entry entry;
+        Trie<Addr, Entry>::Handle handle = nullptr;
+    };
+    std::vector<RefSlot> ref(size);
+    std::vector<int> ref_free;
+    for (int i = 0; i < size; i++)
+        ref_free.push_back(i);
+    uint64_t seq = 0;
+
+    const unsigned shifts[] = {12, 21, 30};
+    for (int i = 0; i < 20000; i++) {
+        const unsigned shift = shifts[rng() % 3];
+        const Addr key = (rng() % 256) << 12;
+        const unsigned width = TlbStore<Entry>::MaxBits - shift;
+
+        Entry *found = store.lookup(key);
+        Entry *expected = trie.lookup(key);
+        ASSERT_EQ(found == nullptr, expected == nullptr);
+        if (found) {
+            ASSERT_EQ(found->id, expected->id);
+            found->seq = expected->seq = ++seq;
+            store.touch(store.index(found));
+        }
+
+        switch (rng() % 4) {
+          case 0:
+          case 1:
+            if (!found) {
+                if (store.full()) {
+                    int lru = 0;
+                    for (int x = 1; x < size; x++) {
+                        if (ref[x].entry.seq < ref[lru].entry.seq)
+                            lru = x;
+                    }
+                    ASSERT_EQ(store.lru(), lru);
+                    trie.remove(ref[lru].handle);
+                    ref[lru].handle = nullptr;
+                    ref[lru].entry.seq = UINT64_MAX;
+                    ref_free.push_back(lru);
+                    store.remove(lru);
+                }
+                Entry entry{i, ++seq};
+                int slot = ref_free.front();
+                ref_free.erase(ref_free.begin());
+                ref[slot].entry = entry;
+                ref[slot].handle = trie.insert(key, width, &ref[slot].entry);
+                ASSERT_EQ(store.index(store.insert(key, width, entry)),
+                        slot);
+            }
+            break;
+          case 2:
+            if (found) {
+                int slot = store.index(found);
+                trie.remove(ref[slot].handle);
+                ref[slot].handle = nullptr;
+                ref[slot].entry.seq = UINT64_MAX;
+                ref_free.push_back(slot);
+                store.remove(slot);
+            }
+            break;
+          default:
+            break;
+        }
+        ASSERT_EQ(store.numValid(), size - ref_free.size());
+    }
+}
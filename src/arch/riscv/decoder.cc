@@ -28,9 +28,13 @@
  */
 
 #include "arch/riscv/decoder.hh"
+
+#include <utility>
+
 #include "arch/riscv/isa.hh"
 #include "arch/riscv/types.hh"
 #include "base/bitfield.hh"
+#include "base/cprintf.hh"
 #include "debug/Decode.hh"
 
 namespace gem5
@@ -44,6 +48,10 @@ Decoder::Decoder(const RiscvDecoderParams &p) : InstDecoder(p, &machInst)
     ISA *isa = dynamic_cast<ISA*>(p.isa);
     vlen = isa->getVecLenInBits();
     elen = isa->getVecElemLenInBits();
+    if (p.shared_decode_cache) {
+        sharedInsts = &decode_cache::SharedInstMap<ExtMachInst>::get(
+                csprintf("riscv vlen=%d elen=%d", vlen, elen));
+    }
     reset();
 }
 
@@ -55,6 +63,23 @@ void Decoder::reset()
     emi = 0;
 }
 
+void
+Decoder::takeOverFrom(InstDecoder *old)
+{
+    InstDecoder::takeOverFrom(old);
+
+    Decoder *dec = dynamic_cast<Decoder *>(old);
+    assert(dec);
+
+    // Move the decode cache over rather than copying it. Only the
+    // decoder of the running CPU uses it, so the cache follows the
+    // CPU switches at no cost.
+    if (dec->vlen == vlen && dec->elen == elen) {
+        std::swap(instMap, dec->instMap);
+        std::swap(recentInsts, dec->recentInsts);
+    }
+}
+
 void
 Decoder::moreBytes(const PCStateBase &pc, Addr fetchPC)
 {
@@ -95,9 +120,18 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
     DPRINTF(Decode, "Decoding instruction 0x%08x at address %#x\n",
             mach_inst.instBits, addr);
 
-    StaticInstPtr &si = instMap[mach_inst];
-    if (!si)
-        si = decodeInst(mach_inst);
+    StaticInstPtr si = recentInsts.lookup(addr, mach_inst);
+    if (!si) {
+        StaticInstPtr &cached = instMap[mach_inst];
+        if (!cached && sharedInsts) {
+            cached = sharedInsts->lookup(mach_inst,
+                    [this, &mach_inst]() { return decodeInst(mach_inst); });
+        } else if (!cached) {
+            cached = decodeInst(mach_inst);
+        }
+        si = cached;
+        recentInsts.insert(addr, mach_inst, si.get());
+    }
 
     si->size(compressed(mach_inst) ? 2 : 4);
 
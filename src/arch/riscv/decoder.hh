@@ -52,6 +52,12 @@ class Decoder : public InstDecoder
 {
   private:
     decode_cache::InstMap<ExtMachInst> instMap;
+    /// PC indexed fast path in front of instMap, which keeps its
+    /// instructions alive.
+    decode_cache::DirectMap<ExtMachInst> recentInsts;
+    /// Where misses in instMap are looked up before decoding, if the
+    /// decoder shares its instructions with those of other CPUs.
+    decode_cache::SharedInstMap<ExtMachInst> *sharedInsts = nullptr;
     bool aligned;
     bool mid;
 
@@ -75,6 +81,8 @@ class Decoder : public InstDecoder
 
     void reset() override;
 
+    void takeOverFrom(InstDecoder *old) override;
+
     inline bool compressed(ExtMachInst inst) { return inst.quadRant < 0x3; }
 
     //Use this to give data to the decoder. This should be used
@@ -43,6 +43,10 @@
 #include "arch/riscv/page_size.hh"
 #include "arch/riscv/pma_checker.hh"
 #include "arch/riscv/tlb.hh"
+#include "cpu/thread_context.hh"
+#include "mem/page_table.hh"
+#include "sim/full_system.hh"
+#include "sim/process.hh"
 
 #include "params/RiscvMMU.hh"
 
@@ -89,6 +93,21 @@ class MMU : public BaseMMU
 
     }
 
+    MemoContext
+    memoContext(ThreadContext *tc, Mode mode) const override
+    {
+        // Full system translations also depend on the privilege level,
+        // satp, and the PMP and PMA state.
+        if (FullSystem)
+            return MemoContext();
+
+        Process *process = tc->getProcessPtr();
+        if (!process)
+            return MemoContext();
+        return MemoContext{process->pTable->pageSize(),
+                           process->pTable->generation()};
+    }
+
     PMP *
     getPMP()
     {
@@ -46,6 +46,7 @@
 #include "arch/riscv/pma_checker.hh"
 #include "arch/riscv/pmp.hh"
 #include "arch/riscv/tlb.hh"
+#include "base/free_list.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
@@ -83,7 +84,7 @@ namespace RiscvISA
         WalkerPort port;
 
         // State to track each walk of the page table
-        class WalkerState
+        class WalkerState : public FreeListAllocated<WalkerState>
         {
           friend class Walker;
           private:
@@ -154,7 +155,8 @@ namespace RiscvISA
         // State for functional accesses (only need one of these per walker)
         WalkerState funcState;
 
-        struct WalkerSenderState : public Packet::SenderState
+        struct WalkerSenderState : public Packet::SenderState,
+                                   public FreeListAllocated<WalkerSenderState>
         {
             WalkerState * senderWalk;
             WalkerSenderState(WalkerState * _senderWalk) :
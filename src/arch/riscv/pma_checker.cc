@@ -107,8 +107,30 @@ PMAChecker::isUncacheable(const AddrRange &range)
 bool
 PMAChecker::isUncacheable(const Addr &addr, const unsigned size)
 {
+    // Accesses within the last region are resolved at once
+    const Addr region = addr >> CacheRegionBits;
+    const bool in_region = region == (addr + size - 1) >> CacheRegionBits;
+    if (in_region && region == lastRegion)
+        return lastRegionUncacheable;
+
     AddrRange range(addr, addr + size);
-    return isUncacheable(range);
+    const bool ret = isUncacheable(range);
+    if (!in_region)
+        return ret;
+
+    // Remember the region if the answer is the same for all of it
+    const Addr start = region << CacheRegionBits;
+    const AddrRange region_range(start, start + (1ULL << CacheRegionBits));
+    bool uniform = true;
+    for (auto const &uncacheable_range: uncacheable) {
+        if (region_range.intersects(uncacheable_range)) {
+            uniform = region_range.isSubset(uncacheable_range);
+            break;
+        }
+    }
+    lastRegion = uniform ? region : MaxAddr;
+    lastRegionUncacheable = ret;
+    return ret;
 }
 
 bool
@@ -124,6 +146,7 @@ PMAChecker::takeOverFrom(BasePMAChecker *old)
     assert(derived_old != nullptr);
     uncacheable = derived_old->uncacheable;
     misaligned = derived_old->misaligned;
+    lastRegion = MaxAddr;
 }
 
 Fault
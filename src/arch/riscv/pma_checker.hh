@@ -134,6 +134,23 @@ class PMAChecker : public BasePMAChecker
 
     AddrRangeList uncacheable;
     AddrRangeMap<bool, 3> misaligned;
+
+    /*
+     * Size of the regions whether accesses are uncacheable is cached
+     * for, log2
+     */
+    static constexpr unsigned CacheRegionBits = 12;
+
+    /*
+     * The last region accessed, if all of it is either in an
+     * uncacheable range or out of all of them, MaxAddr otherwise
+     */
+    Addr lastRegion = MaxAddr;
+
+    /*
+     * Whether the accesses to lastRegion are uncacheable
+     */
+    bool lastRegionUncacheable = false;
 };
 
 } // namespace RiscvISA
@@ -73,6 +73,28 @@ PMP::pmpCheck(const RequestPtr &req, BaseMMU::Mode mode,
                 req->getPaddr());
     }
 
+    // Accesses within a single region are resolved from the
+    // permissions cached for the last region used in this mode
+    const Addr region = req->getPaddr() >> CacheRegionBits;
+    if (region == (req->getPaddr() + req->getSize() - 1) >>
+            CacheRegionBits) {
+        RegionCache &cache = regionCache[pmode];
+        uint8_t perms;
+        if (cache.region != region && regionPerms(region, pmode, perms)) {
+            cache.region = region;
+            cache.perms = perms;
+        }
+
+        if (cache.region == region) {
+            const uint8_t needed = mode == BaseMMU::Mode::Read ? PMP_READ :
+                mode == BaseMMU::Mode::Write ? PMP_WRITE : PMP_EXEC;
+            if (cache.perms & needed)
+                return NoFault;
+            return createAddrfault(req->hasVaddr() ? req->getVaddr() : vaddr,
+                                   mode);
+        }
+    }
+
     // match_index will be used to identify the pmp entry
     // which matched for the given address
     int match_index = -1;
@@ -124,6 +146,35 @@ PMP::pmpCheck(const RequestPtr &req, BaseMMU::Mode mode,
     }
 }
 
+bool
+PMP::regionPerms(Addr region, PrivilegeMode pmode, uint8_t &perms) const
+{
+    const Addr start = region << CacheRegionBits;
+    const AddrRange range(start, start + (1ULL << CacheRegionBits));
+
+    // The lowest numbered entry matching an access decides, so the
+    // region is uniform if the first entry overlapping it covers it
+    for (const auto &entry : pmpTable) {
+        if (PMP_OFF == (entry.pmpCfg & PMP_A_MASK) >> 3 ||
+                !range.intersects(entry.pmpAddr)) {
+            continue;
+        }
+        if (!range.isSubset(entry.pmpAddr))
+            return false;
+
+        if (pmode == PrivilegeMode::PRV_M && (PMP_LOCK & entry.pmpCfg) == 0)
+            perms = PMP_READ | PMP_WRITE | PMP_EXEC;
+        else
+            perms = entry.pmpCfg & (PMP_READ | PMP_WRITE | PMP_EXEC);
+        return true;
+    }
+
+    // no entry matches, only M mode has access
+    perms = pmode == PrivilegeMode::PRV_M ?
+        PMP_READ | PMP_WRITE | PMP_EXEC : 0;
+    return true;
+}
+
 Fault
 PMP::createAddrfault(Addr vaddr, BaseMMU::Mode mode)
 {
@@ -180,6 +231,9 @@ PMP::pmpUpdateRule(uint32_t pmp_index)
     hasLockEntry = false;
     Addr prevAddr = 0;
 
+    // the cached permissions may no longer hold
+    regionCache.fill(RegionCache());
+
     if (pmp_index >= 1) {
         prevAddr = pmpTable[pmp_index - 1].rawAddr;
     }
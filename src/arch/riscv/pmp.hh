@@ -30,6 +30,8 @@
 #ifndef __ARCH_RISCV_PMP_HH__
 #define __ARCH_RISCV_PMP_HH__
 
+#include <array>
+
 #include "arch/generic/tlb.hh"
 #include "arch/riscv/isa.hh"
 #include "base/addr_range.hh"
@@ -115,6 +117,24 @@ class PMP : public SimObject
     /** a table of pmp entries */
     std::vector<PmpEntry> pmpTable;
 
+    /** size of the regions permissions are cached for, log2 */
+    static constexpr unsigned CacheRegionBits = 12;
+
+    /**
+     * permissions of the last region accessed in a privilege
+     * mode, valid until a pmp rule changes
+     */
+    struct RegionCache
+    {
+        /** region number, MaxAddr if the entry is invalid */
+        Addr region = MaxAddr;
+        /** PMP_READ, PMP_WRITE and PMP_EXEC bits allowed */
+        uint8_t perms = 0;
+    };
+
+    /** one cached region per privilege mode, indexed by mode */
+    std::array<RegionCache, PrivilegeMode::PRV_M + 1> regionCache;
+
   public:
     /**
      * pmpCheck checks if a particular memory access
@@ -180,6 +200,20 @@ class PMP : public SimObject
      */
     Fault createAddrfault(Addr vaddr, BaseMMU::Mode mode);
 
+    /**
+     * regionPerms finds the permissions a privilege mode has
+     * over a whole region, which is only possible if the same
+     * pmp entry, or none, matches every access to the region.
+     * @param region region number.
+     * @param pmode privilege mode.
+     * @param perms set to the PMP_READ, PMP_WRITE and PMP_EXEC
+     * bits allowed.
+     * @return true if the permissions are the same for the
+     * whole region.
+     */
+    bool regionPerms(Addr region, PrivilegeMode pmode,
+                     uint8_t &perms) const;
+
     /**
      * pmpUpdateRule updates the pmp rule for a
      * given pmp entry depending on the value
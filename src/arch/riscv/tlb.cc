@@ -31,6 +31,7 @@
 
 #include "arch/riscv/tlb.hh"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -75,11 +76,6 @@ TLB::TLB(const Params &p) :
     lruSeq(0), stats(this), pma(p.pma_checker),
     pmp(p.pmp)
 {
-    for (size_t x = 0; x < size; x++) {
-        tlb[x].trieHandle = NULL;
-        freeList.push_back(&tlb[x]);
-    }
-
     walker = p.walker;
     walker->setTLB(this);
 }
@@ -93,26 +89,21 @@ TLB::getWalker()
 void
 TLB::evictLRU()
 {
-    // Find the entry with the lowest (and hence least recently updated)
+    // Evict the entry with the lowest (and hence least recently updated)
     // sequence number.
-
-    size_t lru = 0;
-    for (size_t i = 1; i < size; i++) {
-        if (tlb[i].lruSeq < tlb[lru].lruSeq)
-            lru = i;
-    }
-
-    remove(lru);
+    remove(tlb.lru());
 }
 
 TlbEntry *
 TLB::lookup(Addr vpn, uint16_t asid, BaseMMU::Mode mode, bool hidden)
 {
-    TlbEntry *entry = trie.lookup(buildKey(vpn, asid));
+    TlbEntry *entry = tlb.lookup(buildKey(vpn, asid));
 
     if (!hidden) {
-        if (entry)
+        if (entry) {
             entry->lruSeq = nextSeq();
+            tlb.touch(tlb.index(entry));
+        }
 
         if (mode == BaseMMU::Write)
             stats.writeAccesses++;
@@ -154,19 +145,15 @@ TLB::insert(Addr vpn, const TlbEntry &entry)
         return newEntry;
     }
 
-    if (freeList.empty())
+    if (tlb.full())
         evictLRU();
 
-    newEntry = freeList.front();
-    freeList.pop_front();
-
     Addr key = buildKey(vpn, entry.asid);
-    *newEntry = entry;
-    newEntry->lruSeq = nextSeq();
-    newEntry->vaddr = vpn;
-    newEntry->trieHandle =
-    trie.insert(key, TlbEntryTrie::MaxBits - entry.logBytes, newEntry);
-    return newEntry;
+    TlbEntry new_entry = entry;
+    new_entry.lruSeq = nextSeq();
+    new_entry.vaddr = vpn;
+    return tlb.insert(key, TlbStore<TlbEntry>::MaxBits - entry.logBytes,
+            new_entry);
 }
 
 void
@@ -181,11 +168,11 @@ TLB::demapPage(Addr vpn, uint64_t asid)
         if (vpn != 0 && asid != 0) {
             TlbEntry *newEntry = lookup(vpn, asid, BaseMMU::Read, true);
             if (newEntry)
-                remove(newEntry - tlb.data());
+                remove(tlb.index(newEntry));
         }
         else {
             for (size_t i = 0; i < size; i++) {
-                if (tlb[i].trieHandle) {
+                if (tlb.valid(i)) {
                     Addr mask = ~(tlb[i].size() - 1);
                     if ((vpn == 0 || (vpn & mask) == tlb[i].vaddr) &&
                         (asid == 0 || tlb[i].asid == asid))
@@ -201,11 +188,34 @@ TLB::flushAll()
 {
     DPRINTF(TLB, "flushAll()\n");
     for (size_t i = 0; i < size; i++) {
-        if (tlb[i].trieHandle)
+        if (tlb.valid(i))
             remove(i);
     }
 }
 
+void
+TLB::takeOverFrom(BaseTLB *old)
+{
+    TLB *old_tlb = dynamic_cast<TLB *>(old);
+    panic_if(!old_tlb, "Cannot take over from a non-RISC-V TLB.");
+
+    // Insert the valid entries from the least to the most recently used
+    // one, so the most recently used ones survive if this TLB is
+    // smaller.
+    std::vector<const TlbEntry *> entries;
+    for (size_t i = 0; i < old_tlb->size; i++) {
+        if (old_tlb->tlb.valid(i))
+            entries.push_back(&old_tlb->tlb[i]);
+    }
+    std::sort(entries.begin(), entries.end(),
+            [](const TlbEntry *a, const TlbEntry *b)
+            { return a->lruSeq < b->lruSeq; });
+
+    flushAll();
+    for (const TlbEntry *entry : entries)
+        insert(entry->vaddr, *entry);
+}
+
 void
 TLB::remove(size_t idx)
 {
@@ -213,10 +223,7 @@ TLB::remove(size_t idx)
         tlb[idx].vaddr, tlb[idx].asid, tlb[idx].paddr, tlb[idx].pte,
         tlb[idx].size());
 
-    assert(tlb[idx].trieHandle);
-    trie.remove(tlb[idx].trieHandle);
-    tlb[idx].trieHandle = NULL;
-    freeList.push_back(&tlb[idx]);
+    tlb.remove(idx);
 }
 
 Fault
@@ -477,13 +484,13 @@ void
 TLB::serialize(CheckpointOut &cp) const
 {
     // Only store the entries in use.
-    uint32_t _size = size - freeList.size();
+    uint32_t _size = tlb.numValid();
     SERIALIZE_SCALAR(_size);
     SERIALIZE_SCALAR(lruSeq);
 
     uint32_t _count = 0;
     for (uint32_t x = 0; x < size; x++) {
-        if (tlb[x].trieHandle != NULL)
+        if (tlb.valid(x))
             tlb[x].serializeSection(cp, csprintf("Entry%d", _count++));
     }
 }
@@ -501,14 +508,14 @@ TLB::unserialize(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(lruSeq);
 
     for (uint32_t x = 0; x < _size; x++) {
-        TlbEntry *newEntry = freeList.front();
-        freeList.pop_front();
-
-        newEntry->unserializeSection(cp, csprintf("Entry%d", x));
-        Addr key = buildKey(newEntry->vaddr, newEntry->asid);
-        newEntry->trieHandle = trie.insert(key,
-            TlbEntryTrie::MaxBits - newEntry->logBytes, newEntry);
+        TlbEntry new_entry;
+        new_entry.unserializeSection(cp, csprintf("Entry%d", x));
+        Addr key = buildKey(new_entry.vaddr, new_entry.asid);
+        tlb.insert(key, TlbStore<TlbEntry>::MaxBits - new_entry.logBytes,
+            new_entry);
     }
+    tlb.sortLru([](const TlbEntry &a, const TlbEntry &b)
+            { return a.lruSeq < b.lruSeq; });
 }
 
 TLB::TlbStats::TlbStats(statistics::Group *parent)
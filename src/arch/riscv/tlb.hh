@@ -32,9 +32,8 @@
 #ifndef __ARCH_RISCV_TLB_HH__
 #define __ARCH_RISCV_TLB_HH__
 
-#include <list>
-
 #include "arch/generic/tlb.hh"
+#include "arch/generic/tlb_store.hh"
 #include "arch/riscv/isa.hh"
 #include "arch/riscv/pagetable.hh"
 #include "arch/riscv/pma_checker.hh"
@@ -58,13 +57,9 @@ class Walker;
 
 class TLB : public BaseTLB
 {
-    typedef std::list<TlbEntry *> EntryList;
-
   protected:
     size_t size;
-    std::vector<TlbEntry> tlb;  // our TLB
-    TlbEntryTrie trie;          // for quick access
-    EntryList freeList;         // free entries
+    TlbStore<TlbEntry> tlb;     // our TLB
     uint64_t lruSeq;
 
     Walker *walker;
@@ -95,7 +90,7 @@ class TLB : public BaseTLB
 
     Walker *getWalker();
 
-    void takeOverFrom(BaseTLB *old) override {}
+    void takeOverFrom(BaseTLB *old) override;
 
     TlbEntry *insert(Addr vpn, const TlbEntry &entry);
     void flushAll() override;
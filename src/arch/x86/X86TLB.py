@@ -49,6 +49,16 @@ class X86PagetableWalker(ClockedObject):
     num_squash_per_cycle = Param.Unsigned(
         4, "Number of outstanding walks that can be squashed per cycle"
     )
+    walk_cache_entries = Param.Unsigned(
+        0,
+        "Number of long mode PML4, PDP and PD entries cached to skip the "
+        "upper levels of a walk (0 to disable)",
+    )
+    coalesce_walks = Param.Bool(
+        False,
+        "Let walks to a page which is already being walked wait for that "
+        "walk instead of walking the page table again",
+    )
 
 
 class X86TLB(BaseTLB):
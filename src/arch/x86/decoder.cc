@@ -683,7 +683,12 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
     if (iter != instMap->end()) {
         si = iter->second;
     } else {
-        si = decodeInst(mach_inst);
+        if (sharedInsts) {
+            si = sharedInsts->lookup(mach_inst,
+                    [this, &mach_inst]() { return decodeInst(mach_inst); });
+        } else {
+            si = decodeInst(mach_inst);
+        }
         (*instMap)[mach_inst] = si;
     }
 
@@ -702,9 +707,13 @@ Decoder::decode(PCStateBase &next_pc)
     instDone = false;
     updateNPC(next_pc.as<PCState>());
 
+    // The bytes at this PC matched those cached with its StaticInst
+    // (a macroop carries its microops), so the state machine was skipped.
     StaticInstPtr &si = instBytes->si;
-    if (si)
+    if (si) {
+        si->size(basePC + offset - origPC);
         return si;
+    }
 
     // We didn't match in the AddrMap, but we still populated an entry. Fix
     // up its byte masks.
@@ -734,7 +743,10 @@ Decoder::decode(PCStateBase &next_pc)
         start = 0;
     }
 
-    return decode(emi, origPC);
+    // Remember the result so the next decode at this PC with the same
+    // bytes goes through FromCacheState instead of predecoding again.
+    si = decode(emi, origPC);
+    return si;
 }
 
 StaticInstPtr
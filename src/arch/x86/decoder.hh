@@ -38,6 +38,7 @@
 #include "arch/x86/regs/misc.hh"
 #include "arch/x86/types.hh"
 #include "base/bitfield.hh"
+#include "base/cprintf.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
@@ -246,6 +247,15 @@ class Decoder : public InstDecoder
             CacheKey, decode_cache::InstMap<ExtMachInst> *> InstCacheMap;
     static InstCacheMap instCacheMap;
 
+    /// With a shared decode cache, the instruction maps are those of
+    /// this decoder alone, and their misses are looked up in the maps
+    /// shared with the other CPUs before decoding.
+    const bool sharedDecodeCache;
+    InstCacheMap ownInstCacheMap;
+    typedef decode_cache::SharedInstMap<ExtMachInst> SharedInsts;
+    SharedInsts *sharedInsts = nullptr;
+    std::unordered_map<CacheKey, SharedInsts *> sharedCacheMap;
+
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
     /// Decode a machine instruction.
@@ -256,7 +266,8 @@ class Decoder : public InstDecoder
     void process();
 
   public:
-    Decoder(const X86DecoderParams &p) : InstDecoder(p, &fetchChunk)
+    Decoder(const X86DecoderParams &p) : InstDecoder(p, &fetchChunk),
+        sharedDecodeCache(p.shared_decode_cache)
     {
         emi.reset();
         emi.mode.cpl = cpl;
@@ -287,12 +298,23 @@ class Decoder : public InstDecoder
             addrCacheMap[m5Reg] = decodePages;
         }
 
-        InstCacheMap::iterator imIter = instCacheMap.find(m5Reg);
-        if (imIter != instCacheMap.end()) {
+        InstCacheMap &inst_maps =
+            sharedDecodeCache ? ownInstCacheMap : instCacheMap;
+        InstCacheMap::iterator imIter = inst_maps.find(m5Reg);
+        if (imIter != inst_maps.end()) {
             instMap = imIter->second;
         } else {
             instMap = new decode_cache::InstMap<ExtMachInst>;
-            instCacheMap[m5Reg] = instMap;
+            inst_maps[m5Reg] = instMap;
+        }
+
+        if (sharedDecodeCache) {
+            SharedInsts *&shared = sharedCacheMap[m5Reg];
+            if (!shared) {
+                shared = &SharedInsts::get(
+                        csprintf("x86 m5reg=%#x", (RegVal)m5Reg));
+            }
+            sharedInsts = shared;
         }
     }
 
@@ -315,6 +337,17 @@ class Decoder : public InstDecoder
         altAddr = dec->altAddr;
         defAddr = dec->defAddr;
         stack = dec->stack;
+
+        // Share the decode pages of the old decoder so code that has
+        // already been decoded does not need decoding again. Cached
+        // instructions are checked against the fetched bytes before
+        // they are used, so sharing them is safe.
+        for (const auto &[key, pages] : dec->addrCacheMap)
+            addrCacheMap[key] = pages;
+        decodePages = dec->decodePages;
+        instMap = dec->instMap;
+        if (sharedDecodeCache)
+            sharedInsts = dec->sharedInsts;
     }
 
     void
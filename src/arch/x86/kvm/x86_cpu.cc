@@ -1389,11 +1389,8 @@ X86KvmCPU::handleKvmExitIO()
     }
 
     const MemCmd cmd(isWrite ? MemCmd::WriteReq : MemCmd::ReadReq);
-    // Temporarily lock and migrate to the device event queue to
-    // prevent races in multi-core mode.
-    EventQueue::ScopedMigration migrate(deviceEventQueue());
     for (int i = 0; i < count; ++i) {
-        RequestPtr io_req = std::make_shared<Request>(
+        RequestPtr io_req = makeRequest(
             pAddr, kvm_run.io.size,
             Request::UNCACHEABLE, dataRequestorId());
 
@@ -1402,7 +1399,7 @@ X86KvmCPU::handleKvmExitIO()
         PacketPtr pkt = new Packet(io_req, cmd);
 
         pkt->dataStatic(guestData);
-        delay += dataPort.submitIO(pkt);
+        delay += submitDeviceIO(pkt);
 
         guestData += kvm_run.io.size;
     }
@@ -1410,6 +1407,40 @@ X86KvmCPU::handleKvmExitIO()
     return delay;
 }
 
+Tick
+X86KvmCPU::handleCoalescedPIO(uint16_t port, void *data, int size)
+{
+    Addr pAddr;
+
+    // Writes to the PCI configuration address register only update the
+    // misc reg, see handleKvmExitIO(). Coalescing them saves one of
+    // the two exits of each PCI configuration space access.
+    if (port == IO_PCI_CONF_ADDR) {
+        assert(size == 4);
+        tc->setMiscReg(misc_reg::PciConfigAddress, *(uint32_t *)data);
+        return 0;
+    } else if ((port & ~0x3) == IO_PCI_CONF_DATA_BASE) {
+        Addr pciConfigAddr(tc->readMiscRegNoEffect(
+                    misc_reg::PciConfigAddress));
+        if (pciConfigAddr & 0x80000000) {
+            pAddr = X86ISA::x86PciConfigAddress((pciConfigAddr & 0x7ffffffc) |
+                                                (port & 0x3));
+        } else {
+            pAddr = X86ISA::x86IOAddress(port);
+        }
+    } else {
+        pAddr = X86ISA::x86IOAddress(port);
+    }
+
+    RequestPtr io_req = makeRequest(
+        pAddr, size, Request::UNCACHEABLE, dataRequestorId());
+    io_req->setContext(tc->contextId());
+
+    PacketPtr pkt = new Packet(io_req, MemCmd::WriteReq);
+    pkt->dataStatic(data);
+    return submitDeviceIO(pkt);
+}
+
 Tick
 X86KvmCPU::handleKvmExitIRQWindowOpen()
 {
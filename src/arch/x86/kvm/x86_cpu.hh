@@ -159,6 +159,12 @@ class X86KvmCPU : public BaseKvmCPU
      */
     Tick handleKvmExitIO() override;
 
+    /**
+     * Handle an x86 legacy IO write coalesced by KVM, including writes
+     * to the PCI configuration space registers
+     */
+    Tick handleCoalescedPIO(uint16_t port, void *data, int size) override;
+
     Tick handleKvmExitIRQWindowOpen() override;
 
     /**
@@ -72,13 +72,24 @@ Fault
 Walker::start(ThreadContext * _tc, BaseMMU::Translation *_translation,
               const RequestPtr &_req, BaseMMU::Mode _mode)
 {
-    // TODO: in timing mode, instead of blocking when there are other
-    // outstanding requests, see if this request can be coalesced with
-    // another one (i.e. either coalesce or start walk)
     WalkerState * newState = new WalkerState(this, _translation, _req);
     newState->initState(_tc, _mode, sys->isTimingMode());
     if (currStates.size()) {
         assert(newState->isTiming());
+        if (coalesceWalks) {
+            // If the page is already being walked, wait for that walk to
+            // fill the TLB rather than walking the page table again.
+            const Addr vpn = _req->getVaddr() >> PageShift;
+            for (WalkerState *walk : currStates) {
+                if (walk->tc == _tc &&
+                        walk->req->getVaddr() >> PageShift == vpn) {
+                    DPRINTF(PageTableWalker, "Coalescing walk for address "
+                            "%#x.\n", _req->getVaddr());
+                    walk->followers.push_back(newState);
+                    return NoFault;
+                }
+            }
+        }
         DPRINTF(PageTableWalker, "Walks in progress: %d\n", currStates.size());
         currStates.push_back(newState);
         return NoFault;
@@ -93,6 +104,107 @@ Walker::start(ThreadContext * _tc, BaseMMU::Translation *_translation,
     }
 }
 
+void
+Walker::finishFollowers(WalkerState *leader)
+{
+    if (leader->followers.empty())
+        return;
+
+    if (leader->timingFault != NoFault) {
+        // The fault may depend on how the page was accessed, so each of
+        // the waiting walks has to find out for itself.
+        currStates.insert(currStates.begin(), leader->followers.begin(),
+                leader->followers.end());
+        leader->followers.clear();
+        return;
+    }
+
+    for (WalkerState *follower : leader->followers) {
+        if (follower->translation->squashed()) {
+            follower->translation->finish(
+                std::make_shared<UnimpFault>("Squashed Inst"),
+                follower->req, follower->tc, follower->mode);
+        } else {
+            // The walk we waited for put the entry in the TLB.
+            bool delayedResponse;
+            Fault fault = tlb->translate(follower->req, follower->tc, NULL,
+                    follower->mode, delayedResponse, true);
+            assert(!delayedResponse);
+            follower->translation->finish(fault, follower->req,
+                    follower->tc, follower->mode);
+        }
+        delete follower;
+    }
+    leader->followers.clear();
+}
+
+unsigned
+Walker::walkCacheTagShift(WalkerState::State next_state)
+{
+    switch (next_state) {
+      case WalkerState::LongPDP:
+        return 39;
+      case WalkerState::LongPD:
+        return 30;
+      case WalkerState::LongPTE:
+        return 21;
+      default:
+        panic("No walk cache entries point to state %d.\n", next_state);
+    }
+}
+
+Walker::WalkCacheEntry *
+Walker::walkCacheLookup(Addr cr3_base, Addr vaddr,
+        WalkerState::State next_state)
+{
+    const Addr tag = vaddr >> walkCacheTagShift(next_state);
+    for (WalkCacheEntry &wc : walkCache) {
+        if (wc.valid && wc.nextState == next_state &&
+                wc.cr3Base == cr3_base && wc.tag == tag) {
+            wc.lruSeq = ++walkCacheSeq;
+            return &wc;
+        }
+    }
+    return nullptr;
+}
+
+void
+Walker::walkCacheInsert(Addr cr3_base, Addr vaddr,
+        WalkerState::State next_state, Addr next_table, bool uncacheable,
+        const TlbEntry &entry, bool any_nx)
+{
+    const Addr tag = vaddr >> walkCacheTagShift(next_state);
+    WalkCacheEntry *victim = &walkCache.front();
+    for (WalkCacheEntry &wc : walkCache) {
+        if (wc.valid && wc.nextState == next_state &&
+                wc.cr3Base == cr3_base && wc.tag == tag) {
+            victim = &wc;
+            break;
+        }
+        if (!wc.valid || (victim->valid && wc.lruSeq < victim->lruSeq))
+            victim = &wc;
+    }
+
+    victim->valid = true;
+    victim->nextState = next_state;
+    victim->cr3Base = cr3_base;
+    victim->tag = tag;
+    victim->nextTable = next_table;
+    victim->uncacheable = uncacheable;
+    victim->writable = entry.writable;
+    victim->user = entry.user;
+    victim->noExec = entry.noExec;
+    victim->anyNX = any_nx;
+    victim->lruSeq = ++walkCacheSeq;
+}
+
+void
+Walker::flushWalkCache()
+{
+    for (WalkCacheEntry &wc : walkCache)
+        wc.valid = false;
+}
+
 Fault
 Walker::startFunctional(ThreadContext * _tc, Addr &addr, unsigned &logBytes,
               BaseMMU::Mode _mode)
@@ -124,6 +236,7 @@ Walker::recvTimingResp(PacketPtr pkt)
                 break;
             }
         }
+        finishFollowers(senderWalk);
         delete senderWalk;
         // Since we block requests when another is outstanding, we
         // need to check if there is a waiting request to be serviced
@@ -199,6 +312,11 @@ Walker::startWalkWrapper()
         currStates.pop_front();
         num_squashed++;
 
+        // The walks waiting for this one have to walk on their own.
+        currStates.insert(currStates.begin(),
+                currState->followers.begin(), currState->followers.end());
+        currState->followers.clear();
+
         DPRINTF(PageTableWalker, "Squashing table walk for address %#x\n",
             currState->req->getVaddr());
 
@@ -522,11 +640,19 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
 
         endWalk();
     } else {
+        if (!functional && !walker->walkCache.empty() &&
+                (nextState == LongPDP || nextState == LongPD ||
+                 nextState == LongPTE)) {
+            anyNX = anyNX || pte.nx;
+            walker->walkCacheInsert(cr3Base, vaddr, nextState,
+                    mbits(pte, 51, 12), uncacheable, entry, anyNX);
+        }
+
         PacketPtr oldRead = read;
         //If we didn't return, we're setting up another read.
         Request::Flags flags = oldRead->req->getFlags();
         flags.set(Request::UNCACHEABLE, uncacheable);
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = makeRequest(
             nextRead, oldRead->getSize(), flags, walker->requestorId);
         read = new Packet(request, MemCmd::ReadReq);
         read->allocate();
@@ -570,6 +696,8 @@ Walker::WalkerState::setupWalk(Addr vaddr)
         state = LongPML4;
         topAddr = (cr3.longPdtb << 12) + addr.longl4 * dataSize;
         enableNX = efer.nxe;
+        cr3Base = cr3.longPdtb;
+        anyNX = false;
     } else {
         // We're in some flavor of legacy mode.
         if (cr4.pae) {
@@ -601,7 +729,40 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     if (!cr4.pcide && cr3.pcd)
         flags.set(Request::UNCACHEABLE);
 
-    RequestPtr request = std::make_shared<Request>(
+    if (state == LongPML4 && !functional && !walker->walkCache.empty()) {
+        // Skip the levels the walk cache knows about, starting from the
+        // deepest one.
+        for (State next : {LongPTE, LongPD, LongPDP}) {
+            WalkCacheEntry *wc =
+                walker->walkCacheLookup(cr3Base, vaddr, next);
+            if (!wc)
+                continue;
+            // Let the walk find the level which doesn't allow execution.
+            if (wc->anyNX && mode == BaseMMU::Execute && enableNX)
+                break;
+            DPRINTF(PageTableWalker, "Walk cache hit for address %#x, "
+                    "resuming at state %d.\n", vaddr, next);
+            state = next;
+            entry.writable = wc->writable;
+            entry.user = wc->user;
+            entry.noExec = wc->noExec;
+            anyNX = wc->anyNX;
+            Addr index;
+            if (next == LongPDP) {
+                index = addr.longl3;
+            } else if (next == LongPD) {
+                index = addr.longl2;
+            } else {
+                index = addr.longl1;
+                entry.logBytes = 12;
+            }
+            topAddr = wc->nextTable + index * dataSize;
+            flags.set(Request::UNCACHEABLE, wc->uncacheable);
+            break;
+        }
+    }
+
+    RequestPtr request = makeRequest(
         topAddr, dataSize, flags, walker->requestorId);
 
     read = new Packet(request, MemCmd::ReadReq);
@@ -43,6 +43,7 @@
 #include "arch/generic/mmu.hh"
 #include "arch/x86/pagetable.hh"
 #include "arch/x86/tlb.hh"
+#include "base/free_list.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
 #include "params/X86PagetableWalker.hh"
@@ -79,7 +80,7 @@ namespace X86ISA
         WalkerPort port;
 
         // State to track each walk of the page table
-        class WalkerState
+        class WalkerState : public FreeListAllocated<WalkerState>
         {
           friend class Walker;
           private:
@@ -115,6 +116,12 @@ namespace X86ISA
             bool retrying;
             bool started;
             bool squashed;
+            // The long mode page table base and whether a level walked so
+            // far has the NX bit set, for the walk cache
+            Addr cr3Base;
+            bool anyNX;
+            // Walks to the same page which wait for this one to finish
+            std::vector<WalkerState *> followers;
           public:
             WalkerState(Walker * _walker, BaseMMU::Translation *_translation,
                         const RequestPtr &_req, bool _isFunctional = false) :
@@ -122,7 +129,8 @@ namespace X86ISA
                 nextState(Ready), inflight(0),
                 translation(_translation),
                 functional(_isFunctional), timing(false),
-                retrying(false), started(false), squashed(false)
+                retrying(false), started(false), squashed(false),
+                cr3Base(0), anyNX(false)
             {
             }
             void initState(ThreadContext * _tc, BaseMMU::Mode _mode,
@@ -153,7 +161,8 @@ namespace X86ISA
         // State for functional accesses (only need one of these per walker)
         WalkerState funcState;
 
-        struct WalkerSenderState : public Packet::SenderState
+        struct WalkerSenderState : public Packet::SenderState,
+                                   public FreeListAllocated<WalkerSenderState>
         {
             WalkerState * senderWalk;
             WalkerSenderState(WalkerState * _senderWalk) :
@@ -178,6 +187,49 @@ namespace X86ISA
         // The number of outstanding walks that can be squashed per cycle.
         unsigned numSquashable;
 
+        /**
+         * An entry of the paging-structure cache. It records where the
+         * table of the next level is for the part of the address space
+         * mapped by a PML4, PDP or (non leaf) PD entry, along with the
+         * permissions accumulated down to it, so a walk which hits in it
+         * can skip the upper levels.
+         */
+        struct WalkCacheEntry
+        {
+            bool valid = false;
+            // The level of the table the entry points to
+            WalkerState::State nextState = WalkerState::Ready;
+            Addr cr3Base = 0;
+            Addr tag = 0;
+            Addr nextTable = 0;
+            bool uncacheable = false;
+            bool writable = false;
+            bool user = false;
+            bool noExec = false;
+            // Whether a level down to here has the NX bit set
+            bool anyNX = false;
+            uint64_t lruSeq = 0;
+        };
+
+        std::vector<WalkCacheEntry> walkCache;
+        uint64_t walkCacheSeq = 0;
+
+        /** Bits of the address a walk cache entry for a level covers */
+        static unsigned walkCacheTagShift(WalkerState::State next_state);
+
+        WalkCacheEntry *walkCacheLookup(Addr cr3_base, Addr vaddr,
+                WalkerState::State next_state);
+        void walkCacheInsert(Addr cr3_base, Addr vaddr,
+                WalkerState::State next_state, Addr next_table,
+                bool uncacheable, const TlbEntry &entry, bool any_nx);
+
+        // Whether walks to a page which is already being walked wait for
+        // that walk instead of walking the page table again.
+        bool coalesceWalks;
+
+        // Finish the walks that waited for the given one.
+        void finishFollowers(WalkerState *leader);
+
         // Wrapper for checking for squashes before starting a translation.
         void startWalkWrapper();
 
@@ -198,6 +250,9 @@ namespace X86ISA
             tlb = _tlb;
         }
 
+        /** Drop the cached paging-structure entries */
+        void flushWalkCache();
+
         using Params = X86PagetableWalkerParams;
 
         Walker(const Params &params) :
@@ -205,6 +260,8 @@ namespace X86ISA
             funcState(this, NULL, NULL, true), tlb(NULL), sys(params.system),
             requestorId(sys->getRequestorId(this)),
             numSquashable(params.num_squash_per_cycle),
+            walkCache(params.walk_cache_entries),
+            coalesceWalks(params.coalesce_walks),
             startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
         {
         }
@@ -37,6 +37,7 @@
 
 #include "arch/x86/tlb.hh"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 
@@ -69,11 +70,6 @@ TLB::TLB(const Params &p)
     if (!size)
         fatal("TLBs must have a non-zero size.\n");
 
-    for (int x = 0; x < size; x++) {
-        tlb[x].trieHandle = NULL;
-        freeList.push_back(&tlb[x]);
-    }
-
     walker = p.walker;
     walker->setTLB(this);
 }
@@ -81,19 +77,9 @@ TLB::TLB(const Params &p)
 void
 TLB::evictLRU()
 {
-    // Find the entry with the lowest (and hence least recently updated)
+    // Evict the entry with the lowest (and hence least recently updated)
     // sequence number.
-
-    unsigned lru = 0;
-    for (unsigned i = 1; i < size; i++) {
-        if (tlb[i].lruSeq < tlb[lru].lruSeq)
-            lru = i;
-    }
-
-    assert(tlb[lru].trieHandle);
-    trie.remove(tlb[lru].trieHandle);
-    tlb[lru].trieHandle = NULL;
-    freeList.push_back(&tlb[lru]);
+    tlb.remove(tlb.lru());
 }
 
 TlbEntry *
@@ -106,38 +92,34 @@ TLB::insert(Addr vpn, const TlbEntry &entry, uint64_t pcid)
     vpn = concAddrPcid(vpn, pcid);
 
     // If somebody beat us to it, just use that existing entry.
-    TlbEntry *newEntry = trie.lookup(vpn);
+    TlbEntry *newEntry = tlb.lookup(vpn);
     if (newEntry) {
         assert(newEntry->vaddr == vpn);
         return newEntry;
     }
 
-    if (freeList.empty())
+    if (tlb.full())
         evictLRU();
 
-    newEntry = freeList.front();
-    freeList.pop_front();
-
-    *newEntry = entry;
-    newEntry->lruSeq = nextSeq();
-    newEntry->vaddr = vpn;
+    TlbEntry new_entry = entry;
+    new_entry.lruSeq = nextSeq();
+    new_entry.vaddr = vpn;
     if (FullSystem) {
-        newEntry->trieHandle =
-        trie.insert(vpn, TlbEntryTrie::MaxBits-entry.logBytes, newEntry);
-    }
-    else {
-        newEntry->trieHandle =
-        trie.insert(vpn, TlbEntryTrie::MaxBits, newEntry);
+        return tlb.insert(vpn, TlbStore<TlbEntry>::MaxBits - entry.logBytes,
+                new_entry);
+    } else {
+        return tlb.insert(vpn, TlbStore<TlbEntry>::MaxBits, new_entry);
     }
-    return newEntry;
 }
 
 TlbEntry *
 TLB::lookup(Addr va, bool update_lru)
 {
-    TlbEntry *entry = trie.lookup(va);
-    if (entry && update_lru)
+    TlbEntry *entry = tlb.lookup(va);
+    if (entry && update_lru) {
         entry->lruSeq = nextSeq();
+        tlb.touch(tlb.index(entry));
+    }
     return entry;
 }
 
@@ -146,12 +128,33 @@ TLB::flushAll()
 {
     DPRINTF(TLB, "Invalidating all entries.\n");
     for (unsigned i = 0; i < size; i++) {
-        if (tlb[i].trieHandle) {
-            trie.remove(tlb[i].trieHandle);
-            tlb[i].trieHandle = NULL;
-            freeList.push_back(&tlb[i]);
-        }
+        if (tlb.valid(i))
+            tlb.remove(i);
     }
+    walker->flushWalkCache();
+}
+
+void
+TLB::takeOverFrom(BaseTLB *otlb)
+{
+    TLB *old = dynamic_cast<TLB *>(otlb);
+    panic_if(!old, "Cannot take over from a non-x86 TLB.");
+
+    // Insert the valid entries from the least to the most recently used
+    // one, so the most recently used ones survive if this TLB is
+    // smaller. The stored vaddr already includes the PCID.
+    std::vector<const TlbEntry *> entries;
+    for (unsigned i = 0; i < old->size; i++) {
+        if (old->tlb.valid(i))
+            entries.push_back(&old->tlb[i]);
+    }
+    std::sort(entries.begin(), entries.end(),
+            [](const TlbEntry *a, const TlbEntry *b)
+            { return a->lruSeq < b->lruSeq; });
+
+    flushAll();
+    for (const TlbEntry *entry : entries)
+        insert(entry->vaddr, *entry, 0);
 }
 
 void
@@ -165,23 +168,20 @@ TLB::flushNonGlobal()
 {
     DPRINTF(TLB, "Invalidating all non global entries.\n");
     for (unsigned i = 0; i < size; i++) {
-        if (tlb[i].trieHandle && !tlb[i].global) {
-            trie.remove(tlb[i].trieHandle);
-            tlb[i].trieHandle = NULL;
-            freeList.push_back(&tlb[i]);
-        }
+        if (tlb.valid(i) && !tlb[i].global)
+            tlb.remove(i);
     }
+    walker->flushWalkCache();
 }
 
 void
 TLB::demapPage(Addr va, uint64_t asn)
 {
-    TlbEntry *entry = trie.lookup(va);
-    if (entry) {
-        trie.remove(entry->trieHandle);
-        entry->trieHandle = NULL;
-        freeList.push_back(entry);
-    }
+    TlbEntry *entry = tlb.lookup(va);
+    if (entry)
+        tlb.remove(tlb.index(entry));
+    // Like invlpg, drop all the paging-structure cache entries.
+    walker->flushWalkCache();
 }
 
 namespace
@@ -593,13 +593,13 @@ void
 TLB::serialize(CheckpointOut &cp) const
 {
     // Only store the entries in use.
-    uint32_t _size = size - freeList.size();
+    uint32_t _size = tlb.numValid();
     SERIALIZE_SCALAR(_size);
     SERIALIZE_SCALAR(lruSeq);
 
     uint32_t _count = 0;
     for (uint32_t x = 0; x < size; x++) {
-        if (tlb[x].trieHandle != NULL)
+        if (tlb.valid(x))
             tlb[x].serializeSection(cp, csprintf("Entry%d", _count++));
     }
 }
@@ -617,13 +617,13 @@ TLB::unserialize(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(lruSeq);
 
     for (uint32_t x = 0; x < _size; x++) {
-        TlbEntry *newEntry = freeList.front();
-        freeList.pop_front();
-
-        newEntry->unserializeSection(cp, csprintf("Entry%d", x));
-        newEntry->trieHandle = trie.insert(newEntry->vaddr,
-            TlbEntryTrie::MaxBits - newEntry->logBytes, newEntry);
+        TlbEntry new_entry;
+        new_entry.unserializeSection(cp, csprintf("Entry%d", x));
+        tlb.insert(new_entry.vaddr,
+            TlbStore<TlbEntry>::MaxBits - new_entry.logBytes, new_entry);
     }
+    tlb.sortLru([](const TlbEntry &a, const TlbEntry &b)
+            { return a.lruSeq < b.lruSeq; });
 }
 
 Port *
@@ -38,12 +38,11 @@
 #ifndef __ARCH_X86_TLB_HH__
 #define __ARCH_X86_TLB_HH__
 
-#include <list>
 #include <vector>
 
 #include "arch/generic/tlb.hh"
+#include "arch/generic/tlb_store.hh"
 #include "arch/x86/pagetable.hh"
-#include "base/trie.hh"
 #include "mem/request.hh"
 #include "params/X86TLB.hh"
 #include "sim/stats.hh"
@@ -62,8 +61,6 @@ namespace X86ISA
       protected:
         friend class Walker;
 
-        typedef std::list<TlbEntry *> EntryList;
-
         uint32_t configAddress;
 
       public:
@@ -71,7 +68,7 @@ namespace X86ISA
         typedef X86TLBParams Params;
         TLB(const Params &p);
 
-        void takeOverFrom(BaseTLB *otlb) override {}
+        void takeOverFrom(BaseTLB *otlb) override;
 
         TlbEntry *lookup(Addr va, bool update_lru = true);
 
@@ -84,8 +81,6 @@ namespace X86ISA
 
       protected:
 
-        EntryList::iterator lookupIt(Addr va, bool update_lru = true);
-
         Walker * walker;
 
       public:
@@ -100,11 +95,8 @@ namespace X86ISA
       protected:
         uint32_t size;
 
-        std::vector<TlbEntry> tlb;
-
-        EntryList freeList;
+        TlbStore<TlbEntry> tlb;
 
-        TlbEntryTrie trie;
         uint64_t lruSeq;
 
         AddrRange m5opRange;
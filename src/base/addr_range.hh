@@ -315,6 +315,16 @@ class AddrRange
      */
     uint32_t stripes() const { return 1ULL << masks.size(); }
 
+    /**
+     * Determine which of the stripes() interleaved stripes this range
+     * is.
+     *
+     * @return The interleaving match value of the range
+     *
+     * @ingroup api_addr_range
+     */
+    uint8_t stripe() const { return intlvMatch; }
+
     /**
      * Get the size of the address range. For a case where
      * interleaving is used we make the simplifying assumption that
@@ -493,20 +503,37 @@ class AddrRange
         // bits from the address match the interleaving value
         bool in_range = a >= _start && a < _end;
         if (in_range) {
-            auto sel = 0;
-            for (unsigned int i = 0; i < masks.size(); i++) {
-                Addr masked = a & masks[i];
-                // The result of an xor operation is 1 if the number
-                // of bits set is odd or 0 othersize, thefore it
-                // suffices to count the number of bits set to
-                // determine the i-th bit of sel.
-                sel |= (popCount(masked) % 2) << i;
-            }
-            return sel == intlvMatch;
+            return intlvMatchFor(a) == intlvMatch;
         }
         return false;
     }
 
+    /**
+     * Determine the interleaving match value the interleaving bits of
+     * an address select, i.e. which of the stripes() ranges sharing
+     * this range's start, end and masks the address belongs to. The
+     * address is not checked to be within the range.
+     *
+     * @param a Address to evaluate
+     * @return the interleaving match value for the address
+     *
+     * @ingroup api_addr_range
+     */
+    uint8_t
+    intlvMatchFor(const Addr& a) const
+    {
+        uint8_t sel = 0;
+        for (unsigned int i = 0; i < masks.size(); i++) {
+            Addr masked = a & masks[i];
+            // The result of an xor operation is 1 if the number
+            // of bits set is odd or 0 othersize, thefore it
+            // suffices to count the number of bits set to
+            // determine the i-th bit of sel.
+            sel |= (popCount(masked) % 2) << i;
+        }
+        return sel;
+    }
+
     /**
      * Remove the interleaving bits from an input address.
      *
@@ -698,6 +698,29 @@ TEST(AddrRangeTest, DISABLED_InterleavingAddressContains)
     }
 }
 
+TEST(AddrRangeTest, InterleavingMatchForAddress)
+{
+    /*
+     * Two masks, the first selecting bit 6 and the second the xor of
+     * bits 7 and 12, split the range into four stripes.
+     */
+    std::vector<Addr> masks;
+    masks.push_back(1 << 6);
+    masks.push_back((1 << 7) | (1 << 12));
+    AddrRange r(0x0, 0x10000, masks, 2);
+
+    EXPECT_EQ(0, r.intlvMatchFor(0x0));
+    EXPECT_EQ(1, r.intlvMatchFor(0x40));
+    EXPECT_EQ(2, r.intlvMatchFor(0x80));
+    EXPECT_EQ(3, r.intlvMatchFor(0xC0));
+    EXPECT_EQ(0, r.intlvMatchFor(0x1080));
+    EXPECT_EQ(2, r.intlvMatchFor(0x1000));
+
+    for (Addr addr = 0; addr < 0x2000; addr += 0x40) {
+        EXPECT_EQ(r.contains(addr), r.intlvMatchFor(addr) == 2);
+    }
+}
+
 TEST(AddrRangeTest, InterleavingAddressAddRemoveInterlvBits)
 {
     Addr start = 0x00000;
@@ -41,11 +41,13 @@
 #ifndef __BASE_ADDR_RANGE_MAP_HH__
 #define __BASE_ADDR_RANGE_MAP_HH__
 
+#include <algorithm>
 #include <cstddef>
 #include <functional>
 #include <list>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include "base/addr_range.hh"
 #include "base/types.hh"
@@ -57,6 +59,10 @@ namespace gem5
  * The AddrRangeMap uses an STL map to implement an interval tree for
  * address decoding. The value stored is a template type and can be
  * e.g. a port identifier, or a pointer.
+ *
+ * Maps whose ranges no longer change can be frozen, in which case
+ * contains() uses a sorted flat table instead of the tree until the
+ * map is modified again.
  */
 template <typename V, int max_cache_size=0>
 class AddrRangeMap
@@ -89,11 +95,13 @@ class AddrRangeMap
     const_iterator
     contains(const AddrRange &r) const
     {
-        return find(r, [r](const AddrRange r1) { return r.isSubset(r1); });
+        return const_cast<AddrRangeMap *>(this)->contains(r);
     }
     iterator
     contains(const AddrRange &r)
     {
+        if (_frozen)
+            return flatContains(r);
         return find(r, [r](const AddrRange r1) { return r.isSubset(r1); });
     }
     /** @} */ // end of api_addr_range
@@ -157,6 +165,7 @@ class AddrRangeMap
         if (intersects(r) != end())
             return tree.end();
 
+        thaw();
         return tree.insert(std::make_pair(r, d)).first;
     }
 
@@ -166,6 +175,7 @@ class AddrRangeMap
     void
     erase(iterator p)
     {
+        thaw();
         cache.remove(p);
         tree.erase(p);
     }
@@ -176,6 +186,7 @@ class AddrRangeMap
     void
     erase(iterator p, iterator q)
     {
+        thaw();
         for (auto it = p; it != q; it++) {
             cache.remove(p);
         }
@@ -188,6 +199,7 @@ class AddrRangeMap
     void
     clear()
     {
+        thaw();
         cache.erase(cache.begin(), cache.end());
         tree.erase(tree.begin(), tree.end());
     }
@@ -246,6 +258,37 @@ class AddrRangeMap
         return tree.empty();
     }
 
+    /**
+     * Build a flat table of the entries, sorted by address, which
+     * contains() searches instead of the tree until the map is
+     * modified. Interleaved ranges which only differ by their stripe
+     * share a slot of the table, and are told apart by the
+     * interleaving bits of the address, so finding the entry is a
+     * binary search of the slots followed by a direct index.
+     *
+     * @ingroup api_addr_range
+     */
+    void
+    freeze()
+    {
+        flat.clear();
+        for (auto it = tree.begin(); it != tree.end(); ++it) {
+            const AddrRange &r = it->first;
+            if (flat.empty() || !r.interleaved() ||
+                    !flat.back().range.mergesWith(r)) {
+                flat.push_back({r, std::vector<iterator>(r.stripes(),
+                                                         tree.end())});
+            }
+            flat.back().stripes[r.stripe()] = it;
+        }
+        _frozen = true;
+    }
+
+    /**
+     * @ingroup api_addr_range
+     */
+    bool frozen() const { return _frozen; }
+
   private:
     /**
      * Add an address range map entry to the cache.
@@ -326,6 +369,38 @@ class AddrRangeMap
         return const_cast<AddrRangeMap *>(this)->find(r, cond);
     }
 
+    /** Drop the flat table once the map is modified */
+    void
+    thaw()
+    {
+        _frozen = false;
+        flat.clear();
+    }
+
+    /**
+     * Find the entry containing the given address range in the flat
+     * table. The entries don't intersect, so only the one containing
+     * the start of the range can contain the range.
+     *
+     * @param r An input address range
+     * @return An iterator that contains the input address range
+     */
+    iterator
+    flatContains(const AddrRange &r)
+    {
+        const Addr addr = r.start();
+        auto slot = std::upper_bound(flat.begin(), flat.end(), addr,
+            [](Addr a, const FlatEntry &e) { return a < e.range.start(); });
+        if (slot == flat.begin())
+            return end();
+        --slot;
+
+        iterator it = slot->stripes[slot->range.intlvMatchFor(addr)];
+        if (it != end() && r.isSubset(it->first))
+            return it;
+        return end();
+    }
+
     RangeMap tree;
 
     /**
@@ -335,6 +410,19 @@ class AddrRangeMap
      * always be valid iterators of the tree.
      */
     mutable std::list<iterator> cache;
+
+    /** Entries sharing a start, an end and interleaving masks */
+    struct FlatEntry
+    {
+        /** Any of the ranges of the entries */
+        AddrRange range;
+        /** The entries, indexed by their stripe */
+        std::vector<iterator> stripes;
+    };
+
+    /** The flat table, sorted by start address, when frozen */
+    std::vector<FlatEntry> flat;
+    bool _frozen = false;
 };
 
 } // namespace gem5
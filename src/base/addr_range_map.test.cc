@@ -156,3 +156,60 @@ TEST(AddrRangeMapTest, InterleavedTest2)
     // intlvMatch = 2 for start = 0x80000000
     EXPECT_EQ(i->second, 2);
 }
+
+/**
+ * A frozen AddrRangeMap must find the same entries as the tree, for both
+ * interleaved and contiguous ranges, and stop using the flat table once
+ * it is modified.
+ */
+TEST(AddrRangeMapTest, FrozenTest)
+{
+    const auto N = 4;
+    const auto masks = std::vector<Addr>{
+        0x1040,
+        0x2080
+    };
+    const Addr start = 0x80000000;
+    const Addr end   = 0xc0000000;
+
+    AddrRangeMap<int> r;
+    AddrRangeMap<int> frozen;
+    for (int k=0; k < N; k++) {
+        r.insert(AddrRange(start, end, masks, k), k);
+        frozen.insert(AddrRange(start, end, masks, k), k);
+    }
+    r.insert(RangeSize(0x1000, 0x1000), N);
+    frozen.insert(RangeSize(0x1000, 0x1000), N);
+    frozen.freeze();
+    ASSERT_TRUE(frozen.frozen());
+
+    const std::vector<Addr> addrs = {
+        0x0, 0xfff, 0x1000, 0x1800, 0x1fff, 0x2000, start - 1, start,
+        start + 0x40, start + 0x80, start + 0xc0, start + 0x1000,
+        start + 0x3fc0, end - 1, end
+    };
+    for (auto a : addrs) {
+        auto i = r.contains(a);
+        auto j = frozen.contains(a);
+        if (i == r.end()) {
+            EXPECT_EQ(j, frozen.end()) << std::hex << a;
+        } else {
+            ASSERT_NE(j, frozen.end()) << std::hex << a;
+            EXPECT_EQ(i->second, j->second) << std::hex << a;
+        }
+    }
+
+    // A range spanning two stripes is contained in none
+    EXPECT_EQ(frozen.contains(RangeSize(start, 0x80)), frozen.end());
+    EXPECT_NE(frozen.contains(RangeSize(start, 0x40)), frozen.end());
+
+    // Removing a stripe thaws the map
+    frozen.erase(frozen.contains(start));
+    EXPECT_FALSE(frozen.frozen());
+    EXPECT_EQ(frozen.contains(start), frozen.end());
+
+    // A missing stripe is not found by the flat table either
+    frozen.freeze();
+    EXPECT_EQ(frozen.contains(start), frozen.end());
+    EXPECT_NE(frozen.contains(start + 0x40), frozen.end());
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/async_writer.hh"
+
+#include <zlib.h>
+
+#include <cstdio>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+AsyncWriter::AsyncWriter(const std::string &_filename, size_t buffer_size,
+                         bool _compress)
+    : filename(_filename), bufferSize(buffer_size), compress(_compress)
+{
+    if (compress)
+        file = gzopen(filename.c_str(), "wb");
+    else
+        file = std::fopen(filename.c_str(), "wb");
+    fatal_if(!file, "Can't open '%s' for writing.\n", filename);
+
+    fill.reserve(bufferSize);
+    drain.reserve(bufferSize);
+
+    thread = std::thread([this]() { run(); });
+}
+
+AsyncWriter::~AsyncWriter()
+{
+    handOver();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cond.notify_all();
+    thread.join();
+
+    if (compress)
+        gzclose(static_cast<gzFile>(file));
+    else
+        std::fclose(static_cast<std::FILE *>(file));
+}
+
+void
+AsyncWriter::handOver()
+{
+    if (fill.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this]() { return drain.empty(); });
+    fill.swap(drain);
+    lock.unlock();
+    cond.notify_all();
+}
+
+void
+AsyncWriter::writeDirect(const void *data, size_t len)
+{
+    // Wait for the buffered data to be written, and write the rest from
+    // this thread while holding the lock so the order is kept.
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this]() { return drain.empty(); });
+    output(static_cast<const char *>(data), len);
+}
+
+void
+AsyncWriter::flush()
+{
+    handOver();
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this]() { return drain.empty(); });
+    if (compress)
+        gzflush(static_cast<gzFile>(file), Z_SYNC_FLUSH);
+    else
+        std::fflush(static_cast<std::FILE *>(file));
+}
+
+void
+AsyncWriter::output(const char *data, size_t len)
+{
+    bool ok;
+    if (compress) {
+        ok = gzwrite(static_cast<gzFile>(file), data, len) == (int)len;
+    } else {
+        ok = std::fwrite(data, 1, len, static_cast<std::FILE *>(file)) ==
+            len;
+    }
+    fatal_if(!ok, "Failed to write to '%s'.\n", filename);
+}
+
+void
+AsyncWriter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cond.wait(lock, [this]() { return stop || !drain.empty(); });
+        if (drain.empty())
+            return;
+
+        // The writing thread only touches the drain buffer once it is
+        // empty again, so it can be written out without the lock.
+        lock.unlock();
+        output(drain.data(), drain.size());
+        lock.lock();
+
+        drain.clear();
+        cond.notify_all();
+    }
+}
+
+} // namespace gem5
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_ASYNC_WRITER_HH__
+#define __BASE_ASYNC_WRITER_HH__
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * Double buffered file writer. Data is copied into a buffer owned by
+ * the calling thread, and whole buffers are handed over to a
+ * background thread which compresses them, if requested, and writes
+ * them to the file. The calling thread only waits if it fills a buffer
+ * before the previous one is written out.
+ *
+ * Only one thread may write to an AsyncWriter at a time.
+ */
+class AsyncWriter
+{
+  public:
+    /**
+     * @param filename File to write to. It is truncated.
+     * @param buffer_size Size of each of the two buffers in bytes.
+     * @param compress Write a gzip compressed file.
+     */
+    AsyncWriter(const std::string &filename, size_t buffer_size=1 << 20,
+                bool compress=false);
+
+    /** Write out everything and close the file. */
+    ~AsyncWriter();
+
+    AsyncWriter(const AsyncWriter &other) = delete;
+    AsyncWriter &operator=(const AsyncWriter &other) = delete;
+
+    void
+    write(const void *data, size_t len)
+    {
+        if (fill.size() + len > bufferSize)
+            handOver();
+
+        if (len > bufferSize) {
+            writeDirect(data, len);
+            return;
+        }
+
+        const char *bytes = static_cast<const char *>(data);
+        fill.insert(fill.end(), bytes, bytes + len);
+    }
+
+    /** Append the bytes of a trivially copyable value */
+    template <typename T>
+    void
+    put(const T &value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write(&value, sizeof(value));
+    }
+
+    /** Wait until everything written so far is in the file. */
+    void flush();
+
+  private:
+    /** Pass the filled buffer to the background thread */
+    void handOver();
+
+    /** Write data that doesn't fit a buffer, after the buffered data */
+    void writeDirect(const void *data, size_t len);
+
+    /** Write bytes to the file, from the background thread */
+    void output(const char *data, size_t len);
+
+    void run();
+
+    const std::string filename;
+    const size_t bufferSize;
+    const bool compress;
+
+    /** File handle, a FILE * or a gzFile */
+    void *file;
+
+    /** Buffer being filled by the writing thread */
+    std::vector<char> fill;
+    /** Buffer being written out by the background thread */
+    std::vector<char> drain;
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool stop = false;
+
+    std::thread thread;
+};
+
+} // namespace gem5
+
+#endif // __BASE_ASYNC_WRITER_HH__
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "base/async_writer.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class AsyncWriterTest : public ::testing::Test
+{
+  protected:
+    char filename[24] = "async_writer-XXXXXX";
+
+    void
+    SetUp() override
+    {
+        int fd = mkstemp(filename);
+        ASSERT_NE(-1, fd);
+        close(fd);
+    }
+
+    void TearDown() override { unlink(filename); }
+
+    std::string
+    read()
+    {
+        std::ifstream in(filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in),
+                           std::istreambuf_iterator<char>());
+    }
+
+    std::string
+    readCompressed()
+    {
+        gzFile in = gzopen(filename, "rb");
+        std::string data;
+        char buf[256];
+        int len;
+        while ((len = gzread(in, buf, sizeof(buf))) > 0)
+            data.append(buf, len);
+        gzclose(in);
+        return data;
+    }
+};
+
+} // anonymous namespace
+
+/** Values come out in order, across many buffer hand-overs. */
+TEST_F(AsyncWriterTest, Order)
+{
+    {
+        AsyncWriter writer(filename, 64);
+        for (uint32_t i = 0; i < 1000; i++)
+            writer.put(i);
+    }
+
+    const std::string data = read();
+    ASSERT_EQ(1000 * sizeof(uint32_t), data.size());
+    const uint32_t *values = reinterpret_cast<const uint32_t *>(data.data());
+    for (uint32_t i = 0; i < 1000; i++)
+        ASSERT_EQ(i, values[i]);
+}
+
+/** Writes larger than a buffer stay in order with the buffered ones. */
+TEST_F(AsyncWriterTest, LargeWrite)
+{
+    const std::string large(100, 'b');
+    {
+        AsyncWriter writer(filename, 16);
+        writer.write("aaaa", 4);
+        writer.write(large.data(), large.size());
+        writer.write("cc", 2);
+    }
+
+    EXPECT_EQ("aaaa" + large + "cc", read());
+}
+
+/** Flushing makes everything written so far visible in the file. */
+TEST_F(AsyncWriterTest, Flush)
+{
+    AsyncWriter writer(filename);
+    writer.write("hello", 5);
+    writer.flush();
+    EXPECT_EQ("hello", read());
+}
+
+TEST_F(AsyncWriterTest, Compressed)
+{
+    {
+        AsyncWriter writer(filename, 32, true);
+        for (int i = 0; i < 20; i++)
+            writer.write("0123456789", 10);
+    }
+
+    const std::string data = readCompressed();
+    ASSERT_EQ(200, data.size());
+    EXPECT_EQ("0123456789", data.substr(190));
+    EXPECT_EQ("\x1f\x8b", read().substr(0, 2));
+}
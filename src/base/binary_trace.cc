@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_trace.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "base/uncontended_mutex.hh"
+#include "debug/FmtFlag.hh"
+#include "debug/FmtTicksOff.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+namespace
+{
+
+/** Source of BinaryLog IDs, which are never reused. */
+std::atomic<uint64_t> nextLogId(1);
+
+} // anonymous namespace
+
+class BinaryLog::Writer
+{
+  public:
+    /**
+     * A single-producer, single-consumer byte ring. The owning thread
+     * appends whole records at head, and whoever holds the file mutex
+     * writes out the bytes between tail and head.
+     *
+     * In a bounded log, the owning thread moves tail itself to drop
+     * the oldest records, so each record is preceded by its length.
+     * The lock keeps flush() from reading the buffer or the string
+     * table while they change.
+     */
+    struct Buffer
+    {
+        Buffer(uint32_t _index, size_t _size)
+            : index(_index), size(_size), data(new char[_size])
+        {}
+
+        const uint32_t index;
+        const size_t size;
+        std::unique_ptr<char[]> data;
+        std::atomic<uint64_t> head{0};
+        std::atomic<uint64_t> tail{0};
+
+        /** IDs of the strings this thread has defined. */
+        std::unordered_map<std::string, uint32_t> strings;
+        /** Cache of format string IDs, keyed by address. */
+        std::unordered_map<const char *,
+                           std::pair<uint32_t, std::string>> formats;
+
+        Record record;
+        UncontendedMutex lock;
+    };
+
+    Writer(const std::string &_filename, size_t buffer_size, bool _bounded)
+        : id(nextLogId++), bufferSize(buffer_size), bounded(_bounded),
+          filename(_filename)
+    {
+        fatal_if(bufferSize < 1024, "Debug trace buffers must be at "
+                 "least 1 KiB.");
+
+        if (bounded)
+            return;
+
+        openFile();
+        thread = std::thread([this]() { run(); });
+    }
+
+    ~Writer()
+    {
+        if (bounded)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stop = true;
+        }
+        wakeCond.notify_one();
+        thread.join();
+
+        drainAll();
+    }
+
+    /** @return The calling thread's buffer, creating it if needed. */
+    Buffer &
+    buffer()
+    {
+        thread_local uint64_t cached_log = 0;
+        thread_local Buffer *cached_buffer = nullptr;
+
+        if (GEM5_UNLIKELY(cached_log != id)) {
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            buffers.emplace_back(new Buffer(buffers.size(), bufferSize));
+            cached_buffer = buffers.back().get();
+            cached_log = id;
+        }
+        return *cached_buffer;
+    }
+
+    uint32_t
+    intern(Buffer &buf, const std::string &str)
+    {
+        auto it = buf.strings.find(str);
+        if (it != buf.strings.end())
+            return it->second;
+
+        uint32_t str_id = buf.strings.size();
+        if (bounded) {
+            // The definitions are written out by dump().
+            std::lock_guard<UncontendedMutex> lock(buf.lock);
+            buf.strings.emplace(str, str_id);
+            return str_id;
+        }
+        buf.strings.emplace(str, str_id);
+
+        Record &rec = buf.record;
+        rec.clear();
+        rec.put(String);
+        rec.put(str_id);
+        rec.putString(str.data(), str.size());
+        append(buf, rec);
+
+        return str_id;
+    }
+
+    /**
+     * Format strings are almost always literals, so look them up by
+     * address. The cached copy catches the rare format string that is
+     * built at run time and reuses an address with different text.
+     */
+    uint32_t
+    internFormat(Buffer &buf, const char *fmt)
+    {
+        auto it = buf.formats.find(fmt);
+        if (it != buf.formats.end() && it->second.second == fmt)
+            return it->second.first;
+
+        uint32_t str_id = intern(buf, fmt);
+        buf.formats[fmt] = std::make_pair(str_id, std::string(fmt));
+        return str_id;
+    }
+
+    void
+    append(Buffer &buf, const Record &rec)
+    {
+        if (bounded) {
+            appendBounded(buf, rec);
+            return;
+        }
+
+        const size_t len = rec.size();
+
+        // A record that doesn't fit the ring is written out directly,
+        // after everything the thread logged before it.
+        if (len > buf.size) {
+            std::lock_guard<std::mutex> lock(fileMutex);
+            drain(buf);
+            writeChunk(buf.index, rec.data(), len, nullptr, 0);
+            return;
+        }
+
+        const uint64_t head = buf.head.load(std::memory_order_relaxed);
+        while (buf.size - (head - buf.tail.load(std::memory_order_acquire))
+                < len) {
+            notify();
+            std::this_thread::yield();
+        }
+
+        copyIn(buf, head, rec.data(), len);
+        buf.head.store(head + len, std::memory_order_release);
+
+        // Wake the writer early rather than let the producer stall.
+        if (head + len - buf.tail.load(std::memory_order_relaxed) >
+                buf.size / 2) {
+            notify();
+        }
+    }
+
+    void
+    flush()
+    {
+        if (bounded)
+            dump();
+        else
+            drainAll();
+    }
+
+    /** Write out everything logged by all threads so far. */
+    void
+    drainAll()
+    {
+        std::lock_guard<std::mutex> file_lock(fileMutex);
+        std::lock_guard<std::mutex> buffers_lock(buffersMutex);
+        for (auto &buf : buffers)
+            drain(*buf);
+        file.flush();
+        fatal_if(!file, "Failed to write the debug trace.");
+    }
+
+    /** Write out the records held by a bounded log. */
+    void
+    dump()
+    {
+        std::lock_guard<std::mutex> file_lock(fileMutex);
+        openFile();
+
+        std::lock_guard<std::mutex> buffers_lock(buffersMutex);
+        std::vector<char> chunk;
+        for (auto &buf : buffers) {
+            std::lock_guard<UncontendedMutex> lock(buf->lock);
+
+            Record defs;
+            for (const auto &[str, str_id] : buf->strings) {
+                defs.put(String);
+                defs.put(str_id);
+                defs.putString(str.data(), str.size());
+            }
+
+            chunk.assign(defs.data(), defs.data() + defs.size());
+            uint64_t pos = buf->tail.load(std::memory_order_relaxed);
+            const uint64_t head = buf->head.load(std::memory_order_relaxed);
+            while (pos < head) {
+                uint32_t len;
+                copyOut(*buf, pos, &len, sizeof(len));
+                const size_t offset = chunk.size();
+                chunk.resize(offset + len);
+                copyOut(*buf, pos + sizeof(len), chunk.data() + offset, len);
+                pos += sizeof(len) + len;
+            }
+            writeChunk(buf->index, chunk.data(), chunk.size(), nullptr, 0);
+        }
+
+        file.close();
+        fatal_if(!file, "Failed to write the debug trace.");
+    }
+
+  private:
+    void
+    openFile()
+    {
+        file.open(filename,
+                  std::ios::out | std::ios::binary | std::ios::trunc);
+        fatal_if(!file, "Can't open debug trace file '%s'.", filename);
+
+        file.write(Magic, sizeof(Magic));
+        file.write(reinterpret_cast<const char *>(&Version),
+                   sizeof(Version));
+    }
+
+    /** Copy bytes into the ring, starting at the given position. */
+    static void
+    copyIn(Buffer &buf, uint64_t pos, const void *src, size_t len)
+    {
+        const size_t offset = pos % buf.size;
+        const size_t first = std::min(len, buf.size - offset);
+        const char *from = static_cast<const char *>(src);
+        std::memcpy(buf.data.get() + offset, from, first);
+        std::memcpy(buf.data.get(), from + first, len - first);
+    }
+
+    /** Copy bytes out of the ring, starting at the given position. */
+    static void
+    copyOut(const Buffer &buf, uint64_t pos, void *dst, size_t len)
+    {
+        const size_t offset = pos % buf.size;
+        const size_t first = std::min(len, buf.size - offset);
+        char *to = static_cast<char *>(dst);
+        std::memcpy(to, buf.data.get() + offset, first);
+        std::memcpy(to + first, buf.data.get(), len - first);
+    }
+
+    /** Append a record, dropping the oldest records to make space. */
+    void
+    appendBounded(Buffer &buf, const Record &rec)
+    {
+        const uint32_t len = rec.size();
+        const size_t total = sizeof(len) + len;
+        // Records that can never fit are lost.
+        if (total > buf.size)
+            return;
+
+        std::lock_guard<UncontendedMutex> lock(buf.lock);
+        uint64_t head = buf.head.load(std::memory_order_relaxed);
+        uint64_t tail = buf.tail.load(std::memory_order_relaxed);
+        while (buf.size - (head - tail) < total) {
+            uint32_t old_len;
+            copyOut(buf, tail, &old_len, sizeof(old_len));
+            tail += sizeof(old_len) + old_len;
+        }
+
+        copyIn(buf, head, &len, sizeof(len));
+        copyIn(buf, head + sizeof(len), rec.data(), len);
+        buf.tail.store(tail, std::memory_order_relaxed);
+        buf.head.store(head + total, std::memory_order_relaxed);
+    }
+
+    void
+    notify()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wake = true;
+        }
+        wakeCond.notify_one();
+    }
+
+    /** Write out a buffer's pending bytes. Needs the file mutex. */
+    void
+    drain(Buffer &buf)
+    {
+        const uint64_t tail = buf.tail.load(std::memory_order_relaxed);
+        const uint64_t head = buf.head.load(std::memory_order_acquire);
+        if (head == tail)
+            return;
+
+        const size_t len = head - tail;
+        const size_t offset = tail % buf.size;
+        const size_t first = std::min(len, buf.size - offset);
+        writeChunk(buf.index, buf.data.get() + offset, first,
+                   buf.data.get(), len - first);
+        buf.tail.store(head, std::memory_order_release);
+    }
+
+    void
+    writeChunk(uint32_t index, const char *data, size_t len,
+               const char *data2, size_t len2)
+    {
+        const uint32_t header[2] = { index, uint32_t(len + len2) };
+        file.write(reinterpret_cast<const char *>(header), sizeof(header));
+        file.write(data, len);
+        if (len2)
+            file.write(data2, len2);
+    }
+
+    void
+    run()
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        while (!stop) {
+            wakeCond.wait_for(lock, std::chrono::milliseconds(100),
+                              [this]() { return wake || stop; });
+            wake = false;
+            lock.unlock();
+            drainAll();
+            lock.lock();
+        }
+    }
+
+    /** Identifies this log in the threads' cached buffer pointers. */
+    const uint64_t id;
+    const size_t bufferSize;
+    const bool bounded;
+
+    const std::string filename;
+    std::ofstream file;
+    std::mutex fileMutex;
+
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    std::mutex buffersMutex;
+
+    std::thread thread;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCond;
+    bool wake = false;
+    bool stop = false;
+};
+
+namespace
+{
+
+uint8_t
+prefix(Tick when, const std::string &flag)
+{
+    uint8_t bits = 0;
+    if (!debug::FmtTicksOff && when != MaxTick)
+        bits |= BinaryLog::PrefixTick;
+    if (debug::FmtFlag && !flag.empty())
+        bits |= BinaryLog::PrefixFlag;
+    return bits;
+}
+
+} // anonymous namespace
+
+BinaryLog::BinaryLog(const std::string &filename, size_t buffer_size,
+                     bool bounded)
+    : writer(new Writer(filename, buffer_size, bounded))
+{
+}
+
+BinaryLog::~BinaryLog()
+{
+}
+
+BinaryLog::Record &
+BinaryLog::begin(Tick when, const std::string &name,
+                 const std::string &flag, const char *fmt, uint8_t nargs)
+{
+    Writer::Buffer &buf = writer->buffer();
+    const uint32_t name_id = writer->intern(buf, name);
+    const uint32_t flag_id = writer->intern(buf, flag);
+    const uint32_t fmt_id = writer->internFormat(buf, fmt);
+
+    Record &rec = buf.record;
+    rec.clear();
+    rec.put(Message);
+    rec.put<uint64_t>(when);
+    rec.put(name_id);
+    rec.put(flag_id);
+    rec.put(prefix(when, flag));
+    rec.put(fmt_id);
+    rec.put(nargs);
+    return rec;
+}
+
+void
+BinaryLog::commit(Record &rec)
+{
+    writer->append(writer->buffer(), rec);
+}
+
+void
+BinaryLog::text(Tick when, const std::string &name, const std::string &flag,
+                const std::string &message)
+{
+    Writer::Buffer &buf = writer->buffer();
+    const uint32_t name_id = writer->intern(buf, name);
+    const uint32_t flag_id = writer->intern(buf, flag);
+
+    Record &rec = buf.record;
+    rec.clear();
+    rec.put(Text);
+    rec.put<uint64_t>(when);
+    rec.put(name_id);
+    rec.put(flag_id);
+    rec.put(prefix(when, flag));
+    rec.putString(message.data(), message.size());
+    writer->append(buf, rec);
+}
+
+void
+BinaryLog::flush()
+{
+    writer->flush();
+}
+
+/** Turns text written to the logger's ostream into Text records. */
+class BinaryLogger::TextBuf : public std::stringbuf
+{
+  private:
+    BinaryLog &log;
+
+  public:
+    TextBuf(BinaryLog &_log) : log(_log) {}
+
+  protected:
+    int
+    sync() override
+    {
+        if (!str().empty()) {
+            log.text(MaxTick, "", "", str());
+            str("");
+        }
+        return 0;
+    }
+};
+
+BinaryLogger::BinaryLogger(const std::string &filename, size_t buffer_size,
+                           bool bounded)
+    : log(filename, buffer_size, bounded), textBuf(new TextBuf(log)),
+      stream(textBuf.get())
+{
+    binaryLog = &log;
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    flush();
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!isEnabled(name))
+        return;
+
+    log.text(when, name, flag, message);
+}
+
+void
+BinaryLogger::flush()
+{
+    stream.flush();
+    log.flush();
+}
+
+} // namespace trace
+} // namespace gem5
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_TRACE_HH__
+#define __BASE_BINARY_TRACE_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+/**
+ * Binary encoding of debug messages. Instead of formatting a message
+ * with cprintf when it is logged, the log stores the format string,
+ * the tick, the object name, the flag and the raw values of the
+ * arguments. Messages are encoded into a buffer owned by the logging
+ * thread and written to the file by a background thread, so the cost
+ * on the simulation thread is a handful of stores per argument.
+ *
+ * Strings (format strings, object names and flags) are replaced by an
+ * ID that is defined the first time a thread uses the string. Each
+ * thread has its own ID space and its own sequence of chunks in the
+ * file. util/decode_debug_trace.py turns a log back into the text the
+ * OstreamLogger would have written.
+ *
+ * Only integer, character, boolean, floating point, string and
+ * pointer arguments are encoded. Messages with any other argument
+ * type are formatted as usual and stored as text.
+ *
+ * File layout, in host byte order:
+ *   header: char magic[8] = "gem5dbg", uint32_t version
+ *   chunk:  uint32_t thread, uint32_t length, length bytes of records
+ *
+ * Records:
+ *   String:  uint8_t type, uint32_t id, uint32_t length, bytes
+ *   Message: uint8_t type, uint64_t tick, uint32_t name, uint32_t flag,
+ *            uint8_t prefix, uint32_t format, uint8_t nargs, arguments
+ *   Text:    uint8_t type, uint64_t tick, uint32_t name, uint32_t flag,
+ *            uint8_t prefix, uint32_t length, bytes
+ *
+ * Each argument is a type tag (ArgType) followed by the value. The
+ * prefix bits record which parts of the message header are printed.
+ *
+ * A bounded log works as a flight recorder: each thread's buffer only
+ * keeps its most recent records, overwriting the oldest ones, and
+ * nothing is written until flush(). The file then has one chunk per
+ * thread with all of its string definitions followed by the records
+ * still in the buffer. Every flush rewrites the file.
+ */
+class BinaryLog
+{
+  public:
+    static constexpr char Magic[8] = "gem5dbg";
+    static constexpr uint32_t Version = 1;
+
+    enum RecordType : uint8_t
+    {
+        String = 0,
+        Message = 1,
+        Text = 2,
+    };
+
+    enum PrefixBits : uint8_t
+    {
+        PrefixTick = 0x1,
+        PrefixFlag = 0x2,
+    };
+
+    /**
+     * Argument type tags. Integers other than the character types use
+     * Signed or Unsigned ORed with their size in bytes. cprintf prints
+     * plain chars like signed or unsigned chars, depending on the
+     * host, so they don't need a tag of their own.
+     */
+    enum ArgType : uint8_t
+    {
+        ArgSignedChar = 0x01,
+        ArgUnsignedChar = 0x02,
+        ArgBool = 0x03,
+        ArgDouble = 0x04,
+        ArgPointer = 0x05,
+        ArgString = 0x06,
+        ArgSigned = 0x10,
+        ArgUnsigned = 0x20,
+    };
+
+    /** A record being encoded by the logging thread. */
+    class Record
+    {
+      private:
+        std::vector<char> bytes;
+
+      public:
+        void clear() { bytes.clear(); }
+        const char *data() const { return bytes.data(); }
+        size_t size() const { return bytes.size(); }
+
+        template <typename T>
+        void
+        put(const T &value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const char *p = reinterpret_cast<const char *>(&value);
+            bytes.insert(bytes.end(), p, p + sizeof(T));
+        }
+
+        void
+        putString(const char *str, size_t len)
+        {
+            put<uint32_t>(len);
+            bytes.insert(bytes.end(), str, str + len);
+        }
+    };
+
+    /** How to encode an argument of type T, if at all. */
+    template <typename T, typename Enable=void>
+    struct Arg
+    {
+        static constexpr bool encodable = false;
+    };
+
+    /**
+     * @param filename File to write the log to.
+     * @param buffer_size Size of each thread's buffer in bytes.
+     * @param bounded Keep only the most recent messages in memory.
+     */
+    BinaryLog(const std::string &filename, size_t buffer_size=1 << 20,
+              bool bounded=false);
+    ~BinaryLog();
+
+    /** Encode a message as its format string and arguments. */
+    template <typename ...Args>
+    void
+    message(Tick when, const std::string &name, const std::string &flag,
+            const char *fmt, const Args &...args)
+    {
+        static_assert(sizeof...(Args) < 256, "Too many arguments");
+        if constexpr ((Arg<Args>::encodable && ...)) {
+            Record &rec = begin(when, name, flag, fmt, sizeof...(Args));
+            (Arg<Args>::put(rec, args), ...);
+            commit(rec);
+        } else {
+            std::ostringstream line;
+            ccprintf(line, fmt, args...);
+            text(when, name, flag, line.str());
+        }
+    }
+
+    /** Store an already formatted message. */
+    void text(Tick when, const std::string &name, const std::string &flag,
+              const std::string &message);
+
+    /**
+     * Write everything logged so far to the file. For a bounded log,
+     * write the messages currently held in memory.
+     */
+    void flush();
+
+  private:
+    /** Thread buffers and the background thread writing them out. */
+    class Writer;
+    std::unique_ptr<Writer> writer;
+
+    /** Start a message record in the calling thread's buffer. */
+    Record &begin(Tick when, const std::string &name,
+                  const std::string &flag, const char *fmt, uint8_t nargs);
+
+    /** Append a finished record to the calling thread's buffer. */
+    void commit(Record &rec);
+};
+
+template <typename T>
+struct BinaryLog::Arg<T, std::enable_if_t<std::is_integral_v<T>>>
+{
+    static constexpr bool encodable = true;
+
+    static void
+    put(Record &rec, T value)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            rec.put<uint8_t>(ArgBool);
+            rec.put<uint8_t>(value);
+        } else if constexpr (sizeof(T) == 1) {
+            rec.put<uint8_t>(std::is_signed_v<T> ?
+                             ArgSignedChar : ArgUnsignedChar);
+            rec.put(value);
+        } else {
+            rec.put<uint8_t>((std::is_signed_v<T> ? ArgSigned : ArgUnsigned) |
+                             sizeof(T));
+            rec.put(value);
+        }
+    }
+};
+
+template <typename T>
+struct BinaryLog::Arg<T, std::enable_if_t<std::is_same_v<T, float> ||
+                                          std::is_same_v<T, double>>>
+{
+    static constexpr bool encodable = true;
+
+    static void
+    put(Record &rec, double value)
+    {
+        rec.put<uint8_t>(ArgDouble);
+        rec.put(value);
+    }
+};
+
+template <>
+struct BinaryLog::Arg<std::string>
+{
+    static constexpr bool encodable = true;
+
+    static void
+    put(Record &rec, const std::string &value)
+    {
+        rec.put<uint8_t>(ArgString);
+        rec.putString(value.data(), value.size());
+    }
+};
+
+template <size_t N>
+struct BinaryLog::Arg<char[N]>
+{
+    static constexpr bool encodable = true;
+
+    static void
+    put(Record &rec, const char *value)
+    {
+        rec.put<uint8_t>(ArgString);
+        rec.putString(value, strnlen(value, N));
+    }
+};
+
+/**
+ * Pointers are stored by value, except for C strings which are stored
+ * by content. Pointers to signed and unsigned chars are printed as
+ * strings by %s and as numbers by anything else, so they use the
+ * fallback.
+ */
+template <typename T>
+struct BinaryLog::Arg<T *, std::enable_if_t<
+    !std::is_same_v<std::remove_cv_t<T>, signed char> &&
+    !std::is_same_v<std::remove_cv_t<T>, unsigned char>>>
+{
+    static constexpr bool encodable = true;
+
+    static void
+    put(Record &rec, const T *value)
+    {
+        if constexpr (std::is_same_v<std::remove_cv_t<T>, char>) {
+            // Streaming a null C string puts the stream in a failed
+            // state. Note the null pointer rather than reproducing that.
+            if (!value)
+                value = "(null)";
+            rec.put<uint8_t>(ArgString);
+            rec.putString(value, std::strlen(value));
+        } else {
+            rec.put<uint8_t>(ArgPointer);
+            rec.put<uint64_t>(reinterpret_cast<uintptr_t>(value));
+        }
+    }
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_BINARY_TRACE_HH__
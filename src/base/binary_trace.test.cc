@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/binary_trace.hh"
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/trace.hh"
+
+using namespace gem5;
+
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+/** A decoded record, with string IDs resolved. */
+struct Entry
+{
+    uint32_t thread;
+    uint8_t type;
+    Tick tick;
+    std::string name;
+    std::string flag;
+    uint8_t prefix;
+    /** The format string, or the text of a Text record. */
+    std::string text;
+    /** The arguments' type tags and values, printed one per item. */
+    std::vector<std::string> args;
+};
+
+/** A minimal reader for the format described in binary_trace.hh. */
+class Reader
+{
+  private:
+    std::string bytes;
+    size_t pos = 0;
+    std::map<uint32_t, std::map<uint32_t, std::string>> strings;
+
+    template <typename T>
+    T
+    get()
+    {
+        T value;
+        EXPECT_LE(pos + sizeof(T), bytes.size());
+        std::memcpy(&value, bytes.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string
+    getString()
+    {
+        uint32_t len = get<uint32_t>();
+        std::string str = bytes.substr(pos, len);
+        pos += len;
+        return str;
+    }
+
+    std::string
+    getArg()
+    {
+        uint8_t tag = get<uint8_t>();
+        std::ostringstream os;
+        switch (tag) {
+          case trace::BinaryLog::ArgSignedChar:
+          case trace::BinaryLog::ArgUnsignedChar:
+            os << "char:" << get<char>();
+            break;
+          case trace::BinaryLog::ArgBool:
+            os << "bool:" << (int)get<uint8_t>();
+            break;
+          case trace::BinaryLog::ArgDouble:
+            os << "double:" << get<double>();
+            break;
+          case trace::BinaryLog::ArgPointer:
+            os << "pointer:" << get<uint64_t>();
+            break;
+          case trace::BinaryLog::ArgString:
+            os << "string:" << getString();
+            break;
+          case trace::BinaryLog::ArgSigned | 4:
+            os << "int32:" << get<int32_t>();
+            break;
+          case trace::BinaryLog::ArgUnsigned | 8:
+            os << "uint64:" << get<uint64_t>();
+            break;
+          default:
+            ADD_FAILURE() << "Unexpected tag " << (int)tag;
+        }
+        return os.str();
+    }
+
+  public:
+    Reader(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+    }
+
+    std::vector<Entry>
+    read()
+    {
+        std::vector<Entry> entries;
+
+        EXPECT_EQ(bytes.compare(0, sizeof(trace::BinaryLog::Magic),
+                trace::BinaryLog::Magic, sizeof(trace::BinaryLog::Magic)),
+                0);
+        pos = sizeof(trace::BinaryLog::Magic);
+        EXPECT_EQ(get<uint32_t>(), trace::BinaryLog::Version);
+
+        while (pos < bytes.size()) {
+            const uint32_t thread = get<uint32_t>();
+            const uint32_t length = get<uint32_t>();
+            const size_t end = pos + length;
+            auto &ids = strings[thread];
+            while (pos < end) {
+                Entry entry;
+                entry.thread = thread;
+                entry.type = get<uint8_t>();
+                if (entry.type == trace::BinaryLog::String) {
+                    uint32_t id = get<uint32_t>();
+                    ids[id] = getString();
+                    continue;
+                }
+                entry.tick = get<uint64_t>();
+                entry.name = ids.at(get<uint32_t>());
+                entry.flag = ids.at(get<uint32_t>());
+                entry.prefix = get<uint8_t>();
+                if (entry.type == trace::BinaryLog::Message) {
+                    entry.text = ids.at(get<uint32_t>());
+                    uint8_t nargs = get<uint8_t>();
+                    for (int i = 0; i < nargs; i++)
+                        entry.args.push_back(getArg());
+                } else {
+                    EXPECT_EQ(entry.type, trace::BinaryLog::Text);
+                    entry.text = getString();
+                }
+                entries.push_back(entry);
+            }
+            EXPECT_EQ(pos, end);
+        }
+        return entries;
+    }
+};
+
+/** A type without a binary encoding. */
+struct Opaque
+{
+    int value;
+};
+
+std::ostream &
+operator<<(std::ostream &os, const Opaque &opaque)
+{
+    return os << "Opaque(" << opaque.value << ")";
+}
+
+class BinaryTraceTest : public testing::Test
+{
+  protected:
+    std::string path;
+
+    void
+    SetUp() override
+    {
+        char name[] = "/tmp/gem5-binary-trace-XXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_NE(fd, -1);
+        close(fd);
+        path = name;
+    }
+
+    void TearDown() override { unlink(path.c_str()); }
+};
+
+} // anonymous namespace
+
+/** Test that messages are stored as their format and raw arguments. */
+TEST_F(BinaryTraceTest, Message)
+{
+    {
+        trace::BinaryLogger logger(path);
+        const std::string str("abc");
+        logger.dprintf_flag(Tick(100), "Foo", "Bar", "%d %s %s %c %#x\n",
+                            -5, str, "lit", 'z', uint64_t(0x10));
+        logger.dprintf(Tick(200), "Foo", "%.2f %s\n", 1.5, true);
+    }
+
+    auto entries = Reader(path).read();
+    ASSERT_EQ(entries.size(), 2);
+
+    EXPECT_EQ(entries[0].type, trace::BinaryLog::Message);
+    EXPECT_EQ(entries[0].tick, 100);
+    EXPECT_EQ(entries[0].name, "Foo");
+    EXPECT_EQ(entries[0].flag, "Bar");
+    EXPECT_EQ(entries[0].prefix, trace::BinaryLog::PrefixTick);
+    EXPECT_EQ(entries[0].text, "%d %s %s %c %#x\n");
+    EXPECT_EQ(entries[0].args, std::vector<std::string>({"int32:-5",
+        "string:abc", "string:lit", "char:z", "uint64:16"}));
+
+    EXPECT_EQ(entries[1].tick, 200);
+    EXPECT_EQ(entries[1].flag, "");
+    EXPECT_EQ(entries[1].args,
+              std::vector<std::string>({"double:1.5", "bool:1"}));
+}
+
+/** Test that messages with other argument types are stored as text. */
+TEST_F(BinaryTraceTest, Fallback)
+{
+    {
+        trace::BinaryLogger logger(path);
+        logger.dprintf(MaxTick, "Foo", "%s and %d\n", Opaque{3}, 4);
+        logger.logMessage(Tick(5), "Foo", "", "preformatted\n");
+        logger.getOstream() << "raw" << std::endl;
+    }
+
+    auto entries = Reader(path).read();
+    ASSERT_EQ(entries.size(), 3);
+
+    EXPECT_EQ(entries[0].type, trace::BinaryLog::Text);
+    EXPECT_EQ(entries[0].prefix, 0);
+    EXPECT_EQ(entries[0].text, "Opaque(3) and 4\n");
+
+    EXPECT_EQ(entries[1].type, trace::BinaryLog::Text);
+    EXPECT_EQ(entries[1].tick, 5);
+    EXPECT_EQ(entries[1].text, "preformatted\n");
+
+    EXPECT_EQ(entries[2].type, trace::BinaryLog::Text);
+    EXPECT_EQ(entries[2].name, "");
+    EXPECT_EQ(entries[2].text, "raw\n");
+}
+
+/** Test that the ignore list applies to binary messages. */
+TEST_F(BinaryTraceTest, Ignore)
+{
+    {
+        trace::BinaryLogger logger(path);
+        logger.addIgnore(ObjectMatch("Foo"));
+        logger.dprintf(Tick(1), "Foo", "%d\n", 1);
+        logger.dprintf(Tick(2), "Bar", "%d\n", 2);
+    }
+
+    auto entries = Reader(path).read();
+    ASSERT_EQ(entries.size(), 1);
+    EXPECT_EQ(entries[0].name, "Bar");
+}
+
+/** Test records larger than the buffer and buffers that wrap around. */
+TEST_F(BinaryTraceTest, SmallBuffer)
+{
+    const std::string big(4096, 'x');
+    {
+        trace::BinaryLog log(path, 1024);
+        for (int i = 0; i < 1000; i++)
+            log.message(Tick(i), "Foo", "", "%d\n", i);
+        log.message(Tick(1000), "Foo", "", "%s\n", big);
+    }
+
+    auto entries = Reader(path).read();
+    ASSERT_EQ(entries.size(), 1001);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(entries[i].tick, i);
+        EXPECT_EQ(entries[i].args[0], "int32:" + std::to_string(i));
+    }
+    EXPECT_EQ(entries[1000].args[0], "string:" + big);
+}
+
+/** Test that each thread gets its own buffer and string IDs. */
+TEST_F(BinaryTraceTest, Threads)
+{
+    const int num_threads = 4;
+    const int num_messages = 1000;
+    {
+        trace::BinaryLog log(path, 4096);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&log, t]() {
+                const std::string name = "thread" + std::to_string(t);
+                for (int i = 0; i < num_messages; i++)
+                    log.message(Tick(i), name, "", "%d\n", i);
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    std::map<uint32_t, std::vector<Entry>> per_thread;
+    for (auto &entry : Reader(path).read())
+        per_thread[entry.thread].push_back(entry);
+
+    ASSERT_EQ(per_thread.size(), num_threads);
+    for (auto &[thread, entries] : per_thread) {
+        ASSERT_EQ(entries.size(), num_messages);
+        for (int i = 0; i < num_messages; i++) {
+            EXPECT_EQ(entries[i].name, entries[0].name);
+            EXPECT_EQ(entries[i].args[0], "int32:" + std::to_string(i));
+        }
+    }
+}
+
+/** Test that a bounded log keeps only the most recent messages. */
+TEST_F(BinaryTraceTest, Bounded)
+{
+    trace::BinaryLogger logger(path, 1024, true);
+    for (int i = 0; i < 1000; i++)
+        logger.dprintf(Tick(i), "Foo", "%d\n", i);
+
+    // Nothing is written until the log is flushed.
+    EXPECT_EQ(std::ifstream(path).peek(), EOF);
+
+    logger.flush();
+    auto entries = Reader(path).read();
+    ASSERT_GT(entries.size(), 10);
+    ASSERT_LT(entries.size(), 1000);
+    const int first = 1000 - entries.size();
+    for (int i = 0; i < entries.size(); i++) {
+        EXPECT_EQ(entries[i].name, "Foo");
+        EXPECT_EQ(entries[i].tick, first + i);
+        EXPECT_EQ(entries[i].args[0], "int32:" + std::to_string(first + i));
+    }
+
+    // A later flush replaces the earlier one.
+    logger.dprintf(Tick(1000), "Bar", "%s\n", "last");
+    logger.flush();
+    entries = Reader(path).read();
+    ASSERT_FALSE(entries.empty());
+    EXPECT_EQ(entries.back().name, "Bar");
+    EXPECT_EQ(entries.back().args[0], "string:last");
+    EXPECT_GT(entries.front().tick, first);
+}
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/chunked_image.hh"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace chunked_image
+{
+
+namespace
+{
+
+constexpr char Magic[8] = {'g', 'e', 'm', '5', 'i', 'm', 'g', '\0'};
+constexpr uint32_t Version = 1;
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t size;
+    uint64_t chunkSize;
+    uint64_t numChunks;
+};
+
+/** Location of a compressed chunk, a length of zero means all zeros. */
+struct IndexEntry
+{
+    uint64_t offset;
+    uint64_t length;
+};
+
+using ChunkFunc =
+    std::function<std::string(uint64_t, std::vector<uint8_t> &)>;
+
+/**
+ * Call func for every chunk in [0, num_chunks) using a pool of
+ * threads, each with its own scratch buffer. Workers stop picking up
+ * chunks once one of them has failed. Errors are returned rather
+ * than reported from the workers so that the caller can clean up
+ * and report them from the calling thread.
+ */
+std::string
+forEachChunk(unsigned threads, uint64_t num_chunks, const ChunkFunc &func)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max<uint64_t>(1, std::min<uint64_t>(threads, num_chunks));
+
+    std::atomic<uint64_t> next{0};
+    std::atomic<bool> failed{false};
+    std::mutex error_mutex;
+    std::string error;
+
+    auto worker = [&]() {
+        std::vector<uint8_t> scratch;
+        for (uint64_t i = next++; i < num_chunks && !failed; i = next++) {
+            std::string msg = func(i, scratch);
+            if (!msg.empty()) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!failed.exchange(true))
+                    error = msg;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool)
+        t.join();
+
+    return error;
+}
+
+bool
+pwriteAll(int fd, const void *buf, uint64_t len, uint64_t offset)
+{
+    auto *p = static_cast<const uint8_t *>(buf);
+    while (len > 0) {
+        ssize_t ret = ::pwrite(fd, p, len, offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+        p += ret;
+        len -= ret;
+        offset += ret;
+    }
+    return true;
+}
+
+bool
+preadAll(int fd, void *buf, uint64_t len, uint64_t offset)
+{
+    auto *p = static_cast<uint8_t *>(buf);
+    while (len > 0) {
+        ssize_t ret = ::pread(fd, p, len, offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0) {
+            // Hitting the end of the file leaves errno untouched.
+            if (ret == 0)
+                errno = EIO;
+            return false;
+        }
+        p += ret;
+        len -= ret;
+        offset += ret;
+    }
+    return true;
+}
+
+bool
+isZero(const uint8_t *data, uint64_t len)
+{
+    return len == 0 ||
+        (data[0] == 0 && std::memcmp(data, data + 1, len - 1) == 0);
+}
+
+/** Hash to find chunks which may be identical, 0 is not a valid hash */
+uint64_t
+hashChunk(const uint8_t *data, uint64_t len)
+{
+    uint64_t hash = len;
+    uint64_t i = 0;
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0x9e3779b97f4a7c15ULL;
+    }
+    for (; i < len; ++i)
+        hash = (hash ^ data[i]) * 0x9e3779b97f4a7c15ULL;
+    return hash | 1;
+}
+
+} // anonymous namespace
+
+void
+write(const std::string &path, const uint8_t *data, uint64_t size,
+      uint64_t chunk_size, unsigned threads,
+      const DataFilter &may_have_data)
+{
+    fatal_if(chunk_size == 0 || chunk_size > UINT32_MAX,
+             "Invalid chunk size %d for image '%s'\n", chunk_size, path);
+
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    fatal_if(fd < 0, "Can't open image file '%s': %s\n",
+             path, strerror(errno));
+
+    const uint64_t num_chunks = divCeil(size, chunk_size);
+    std::vector<IndexEntry> index(num_chunks);
+
+    // Find the chunks holding data, and hash them, with a hash of 0
+    // for the zero chunks.
+    std::vector<uint64_t> hashes(num_chunks, 0);
+    forEachChunk(threads, num_chunks,
+        [&](uint64_t i, std::vector<uint8_t> &) -> std::string {
+            const uint64_t offset = i * chunk_size;
+            const uint64_t len = std::min(chunk_size, size - offset);
+            if ((!may_have_data || may_have_data(offset, len)) &&
+                    !isZero(data + offset, len)) {
+                hashes[i] = hashChunk(data + offset, len);
+            }
+            return "";
+        });
+
+    // Only the first of a set of identical chunks is stored, and the
+    // others share its data.
+    std::vector<uint64_t> source(num_chunks);
+    std::unordered_map<uint64_t, std::vector<uint64_t>> stored;
+    for (uint64_t i = 0; i < num_chunks; ++i) {
+        source[i] = i;
+        if (!hashes[i])
+            continue;
+        const uint64_t len = std::min(chunk_size, size - i * chunk_size);
+        auto &candidates = stored[hashes[i]];
+        for (uint64_t c : candidates) {
+            if (std::min(chunk_size, size - c * chunk_size) == len &&
+                std::memcmp(data + c * chunk_size, data + i * chunk_size,
+                            len) == 0) {
+                source[i] = c;
+                break;
+            }
+        }
+        if (source[i] == i)
+            candidates.push_back(i);
+    }
+
+    // Chunks are appended after the index in whatever order the
+    // workers finish compressing them.
+    std::atomic<uint64_t> tail{sizeof(Header) +
+                               num_chunks * sizeof(IndexEntry)};
+
+    std::string error = forEachChunk(threads, num_chunks,
+        [&](uint64_t i, std::vector<uint8_t> &scratch) -> std::string {
+            const uint64_t offset = i * chunk_size;
+            const uint64_t len = std::min(chunk_size, size - offset);
+            if (!hashes[i]) {
+                index[i] = {0, 0};
+                return "";
+            }
+            if (source[i] != i)
+                return "";
+
+            uLongf compressed_len = compressBound(len);
+            scratch.resize(compressed_len);
+            if (compress2(scratch.data(), &compressed_len, data + offset,
+                          len, Z_BEST_SPEED) != Z_OK) {
+                return csprintf("compressing chunk %d failed", i);
+            }
+
+            const uint64_t pos = tail.fetch_add(compressed_len);
+            if (!pwriteAll(fd, scratch.data(), compressed_len, pos)) {
+                return csprintf("writing chunk %d failed: %s",
+                                i, strerror(errno));
+            }
+            index[i] = {pos, compressed_len};
+            return "";
+        });
+
+    for (uint64_t i = 0; i < num_chunks; ++i) {
+        if (source[i] != i)
+            index[i] = index[source[i]];
+    }
+
+    if (error.empty()) {
+        Header header{};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version = Version;
+        header.size = size;
+        header.chunkSize = chunk_size;
+        header.numChunks = num_chunks;
+        if (!pwriteAll(fd, &header, sizeof(header), 0) ||
+            !pwriteAll(fd, index.data(), num_chunks * sizeof(IndexEntry),
+                       sizeof(header))) {
+            error = csprintf("writing index failed: %s", strerror(errno));
+        }
+    }
+
+    if (::close(fd) != 0 && error.empty())
+        error = csprintf("close failed: %s", strerror(errno));
+
+    fatal_if(!error.empty(), "Failed to write image file '%s': %s\n",
+             path, error);
+}
+
+void
+read(const std::string &path, uint8_t *data, uint64_t size, unsigned threads)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Can't open image file '%s': %s\n",
+             path, strerror(errno));
+
+    Header header;
+    if (!preadAll(fd, &header, sizeof(header), 0) ||
+        std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        ::close(fd);
+        fatal("'%s' is not an image file\n", path);
+    }
+    if (header.version != Version) {
+        ::close(fd);
+        fatal("Image file '%s' has unsupported version %d\n",
+              path, header.version);
+    }
+    if (header.size != size) {
+        ::close(fd);
+        fatal("Image file '%s' has size %d, expected %d\n",
+              path, header.size, size);
+    }
+    if (header.chunkSize == 0 ||
+        header.numChunks != divCeil(size, header.chunkSize)) {
+        ::close(fd);
+        fatal("Image file '%s' has a corrupt header\n", path);
+    }
+
+    const uint64_t chunk_size = header.chunkSize;
+    const uint64_t num_chunks = header.numChunks;
+    std::vector<IndexEntry> index(num_chunks);
+    if (!preadAll(fd, index.data(), num_chunks * sizeof(IndexEntry),
+                  sizeof(header))) {
+        ::close(fd);
+        fatal("Failed to read index of image file '%s': %s\n",
+              path, strerror(errno));
+    }
+
+    std::string error = forEachChunk(threads, num_chunks,
+        [&](uint64_t i, std::vector<uint8_t> &scratch) -> std::string {
+            const IndexEntry &entry = index[i];
+            if (entry.length == 0)
+                return "";
+
+            const uint64_t offset = i * chunk_size;
+            const uint64_t len = std::min(chunk_size, size - offset);
+            scratch.resize(entry.length);
+            if (!preadAll(fd, scratch.data(), entry.length, entry.offset)) {
+                return csprintf("reading chunk %d failed: %s",
+                                i, strerror(errno));
+            }
+
+            uLongf uncompressed_len = len;
+            if (uncompress(data + offset, &uncompressed_len, scratch.data(),
+                           entry.length) != Z_OK ||
+                uncompressed_len != len) {
+                return csprintf("chunk %d is corrupt", i);
+            }
+            return "";
+        });
+
+    ::close(fd);
+
+    fatal_if(!error.empty(), "Failed to read image file '%s': %s\n",
+             path, error);
+}
+
+} // namespace chunked_image
+} // namespace gem5
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_CHUNKED_IMAGE_HH__
+#define __BASE_CHUNKED_IMAGE_HH__
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace gem5
+{
+
+/**
+ * A chunked image stores a large, flat byte array (e.g. the backing
+ * store of a physical memory) in a form that can be written and read
+ * by several threads at once. The array is split into fixed-size
+ * chunks that are compressed independently. All-zero chunks are not
+ * stored at all, so sparse memories produce small files and are
+ * restored without touching the untouched pages. Identical chunks are
+ * only stored once, and share their data in the file.
+ *
+ * The file starts with a header and an index with one entry per
+ * chunk, followed by the compressed chunk data in no particular
+ * order. All fields are stored in host byte order.
+ */
+namespace chunked_image
+{
+
+/** Default size of an uncompressed chunk. */
+constexpr uint64_t DefaultChunkSize = 4 * 1024 * 1024;
+
+/**
+ * Tells whether a part of the data, given by its offset and size, may
+ * hold anything else than zeros. Parts for which it returns false are
+ * stored as zeros without being read, so that e.g. the pages of a
+ * memory which were never touched are not brought in.
+ */
+using DataFilter = std::function<bool(uint64_t, uint64_t)>;
+
+/**
+ * Write an image of a byte array to a file.
+ *
+ * @param path File to create or truncate
+ * @param data The data to store
+ * @param size Size of the data in bytes
+ * @param chunk_size Size of an uncompressed chunk in bytes
+ * @param threads Number of worker threads, 0 to use all host threads
+ * @param may_have_data Optional filter of the parts of the data to read
+ */
+void write(const std::string &path, const uint8_t *data, uint64_t size,
+           uint64_t chunk_size=DefaultChunkSize, unsigned threads=0,
+           const DataFilter &may_have_data=nullptr);
+
+/**
+ * Restore a byte array from an image written by write(). Bytes
+ * belonging to all-zero chunks are left untouched, so the destination
+ * is expected to be zero-initialised.
+ *
+ * @param path File to read
+ * @param data Destination of the data
+ * @param size Expected size of the data in bytes
+ * @param threads Number of worker threads, 0 to use all host threads
+ */
+void read(const std::string &path, uint8_t *data, uint64_t size,
+          unsigned threads=0);
+
+} // namespace chunked_image
+} // namespace gem5
+
+#endif // __BASE_CHUNKED_IMAGE_HH__
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "base/chunked_image.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class ChunkedImageTest : public ::testing::Test
+{
+  protected:
+    char filename[20] = "chunked-XXXXXX";
+
+    void
+    SetUp() override
+    {
+        int fd = mkstemp(filename);
+        ASSERT_NE(-1, fd);
+        close(fd);
+    }
+
+    void TearDown() override { unlink(filename); }
+
+    static std::vector<uint8_t>
+    makeData(uint64_t size)
+    {
+        std::mt19937 gen(0x5eed);
+        std::vector<uint8_t> data(size);
+        for (auto &d : data)
+            d = gen() % 4;
+        return data;
+    }
+};
+
+} // anonymous namespace
+
+/** Data survives a round trip for any number of threads. */
+TEST_F(ChunkedImageTest, RoundTrip)
+{
+    // The last chunk is only partially filled.
+    const auto data = makeData(10 * 4096 + 123);
+    for (unsigned threads : {1, 3, 16}) {
+        chunked_image::write(filename, data.data(), data.size(), 4096,
+                             threads);
+        std::vector<uint8_t> restored(data.size());
+        chunked_image::read(filename, restored.data(), restored.size(),
+                            threads);
+        EXPECT_EQ(data, restored);
+    }
+}
+
+/** All-zero chunks are not stored and the destination is not touched. */
+TEST_F(ChunkedImageTest, ZeroChunksSkipped)
+{
+    std::vector<uint8_t> data(8 * 4096, 0);
+    data[5 * 4096 + 7] = 42;
+    chunked_image::write(filename, data.data(), data.size(), 4096);
+
+    std::vector<uint8_t> restored(data.size(), 0xff);
+    chunked_image::read(filename, restored.data(), restored.size());
+    for (uint64_t i = 0; i < data.size(); ++i) {
+        if (i / 4096 == 5)
+            ASSERT_EQ(data[i], restored[i]);
+        else
+            ASSERT_EQ(0xff, restored[i]);
+    }
+}
+
+TEST_F(ChunkedImageTest, EmptyImage)
+{
+    chunked_image::write(filename, nullptr, 0);
+    chunked_image::read(filename, nullptr, 0);
+}
+
+TEST_F(ChunkedImageTest, SizeMismatch)
+{
+    const auto data = makeData(4096);
+    chunked_image::write(filename, data.data(), data.size(), 1024);
+    std::vector<uint8_t> restored(2 * 4096);
+    EXPECT_ANY_THROW(chunked_image::read(filename, restored.data(),
+                                         restored.size()));
+}
+
+TEST_F(ChunkedImageTest, NotAnImage)
+{
+    std::vector<uint8_t> restored(4096);
+    EXPECT_ANY_THROW(chunked_image::read(filename, restored.data(),
+                                         restored.size()));
+}
+
+/** Identical chunks are stored once and restored everywhere. */
+TEST_F(ChunkedImageTest, IdenticalChunksShared)
+{
+    const auto chunk = makeData(4096);
+    std::vector<uint8_t> data;
+    for (int i = 0; i < 8; ++i)
+        data.insert(data.end(), chunk.begin(), chunk.end());
+    data[3 * 4096] ^= 1;
+    chunked_image::write(filename, data.data(), data.size(), 4096);
+
+    std::vector<uint8_t> restored(data.size());
+    chunked_image::read(filename, restored.data(), restored.size());
+    EXPECT_EQ(data, restored);
+
+    // Only two distinct chunks are stored.
+    std::vector<uint8_t> distinct(chunk);
+    distinct.insert(distinct.end(), chunk.begin(), chunk.end());
+    distinct[4096] ^= 1;
+    char other[20] = "chunked-XXXXXX";
+    int fd = mkstemp(other);
+    ASSERT_NE(-1, fd);
+    close(fd);
+    chunked_image::write(other, distinct.data(), distinct.size(), 4096);
+    std::FILE *f = std::fopen(filename, "rb");
+    std::FILE *g = std::fopen(other, "rb");
+    std::fseek(f, 0, SEEK_END);
+    std::fseek(g, 0, SEEK_END);
+    // The index has one 16 byte entry per chunk.
+    EXPECT_EQ(std::ftell(f), std::ftell(g) + 6 * 16);
+    std::fclose(f);
+    std::fclose(g);
+    unlink(other);
+}
+
+/** Parts filtered out are stored as zeros without being read. */
+TEST_F(ChunkedImageTest, FilteredChunksSkipped)
+{
+    const auto data = makeData(8 * 4096);
+    chunked_image::write(filename, data.data(), data.size(), 4096, 0,
+        [](uint64_t offset, uint64_t len) { return offset != 2 * 4096; });
+
+    std::vector<uint8_t> restored(data.size(), 0xff);
+    chunked_image::read(filename, restored.data(), restored.size());
+    for (uint64_t i = 0; i < data.size(); ++i) {
+        if (i / 4096 == 2)
+            ASSERT_EQ(0xff, restored[i]);
+        else
+            ASSERT_EQ(data[i], restored[i]);
+    }
+}
@@ -32,8 +32,6 @@
 #include <iostream>
 #include <sstream>
 
-#include "base/compiler.hh"
-
 namespace gem5
 {
 
@@ -63,19 +61,13 @@ Print::~Print()
 }
 
 void
-Print::process()
+writeText(std::ostream &stream, const char *text, size_t len)
 {
-    fmt.clear();
-
-    size_t len;
-
-    while (*ptr) {
+    const char *ptr = text;
+    const char *end = text + len;
+    while (ptr < end) {
         switch (*ptr) {
           case '%':
-            if (ptr[1] != '%') {
-                processFlag();
-                return;
-            }
             stream.put('%');
             ptr += 2;
             break;
@@ -86,194 +78,64 @@ Print::process()
             break;
           case '\r':
             ++ptr;
-            if (*ptr != '\n')
+            if (ptr == end || *ptr != '\n')
                 stream << std::endl;
             break;
 
           default:
-            len = strcspn(ptr, "%\n\r\0");
-            stream.write(ptr, len);
-            ptr += len;
+            {
+                const char *stop = ptr;
+                while (stop < end && *stop != '%' && *stop != '\n' &&
+                        *stop != '\r') {
+                    ++stop;
+                }
+                stream.write(ptr, stop - ptr);
+                ptr = stop;
+            }
             break;
         }
     }
 }
 
 void
-Print::processFlag()
+Print::process()
 {
-    bool done = false;
-    bool end_number = false;
-    bool have_precision = false;
-    int number = 0;
-
-    stream.fill(' ');
-    stream.flags((std::ios::fmtflags)0);
+    fmt.clear();
 
-    while (!done) {
-        ++ptr;
-        if (*ptr >= '0' && *ptr <= '9') {
-            if (end_number)
-                continue;
-        } else if (number > 0) {
-            end_number = true;
-        }
+    size_t len;
 
+    while (*ptr) {
         switch (*ptr) {
-          case 's':
-            fmt.format = Format::String;
-            done = true;
-            break;
-
-          case 'c':
-            fmt.format = Format::Character;
-            done = true;
-            break;
-
-          case 'l':
-            continue;
-
-          case 'p':
-            fmt.format = Format::Integer;
-            fmt.base = Format::Hex;
-            fmt.alternateForm = true;
-            done = true;
-            break;
-
-          case 'X':
-            fmt.uppercase = true;
-            [[fallthrough]];
-          case 'x':
-            fmt.base = Format::Hex;
-            fmt.format = Format::Integer;
-            done = true;
-            break;
-
-          case 'o':
-            fmt.base = Format::Oct;
-            fmt.format = Format::Integer;
-            done = true;
-            break;
-
-          case 'd':
-          case 'i':
-          case 'u':
-            fmt.format = Format::Integer;
-            done = true;
-            break;
-
-          case 'G':
-            fmt.uppercase = true;
-            [[fallthrough]];
-          case 'g':
-            fmt.format = Format::Floating;
-            fmt.floatFormat = Format::Best;
-            done = true;
-            break;
-
-          case 'E':
-            fmt.uppercase = true;
-            [[fallthrough]];
-          case 'e':
-            fmt.format = Format::Floating;
-            fmt.floatFormat = Format::Scientific;
-            done = true;
-            break;
-
-          case 'f':
-            fmt.format = Format::Floating;
-            fmt.floatFormat = Format::Fixed;
-            done = true;
-            break;
-
-          case 'n':
-            stream << "we don't do %n!!!\n";
-            done = true;
-            break;
-
-          case '#':
-            fmt.alternateForm = true;
-            break;
-
-          case '-':
-            fmt.flushLeft = true;
-            break;
-
-          case '+':
-            fmt.printSign = true;
-            break;
-
-          case ' ':
-            fmt.blankSpace = true;
-            break;
-
-          case '.':
-            fmt.width = number;
-            fmt.precision = 0;
-            have_precision = true;
-            number = 0;
-            end_number = false;
-            break;
-
-          case '0':
-            if (number == 0) {
-                fmt.fillZero = true;
-                break;
+          case '%':
+            if (ptr[1] != '%') {
+                stream.fill(' ');
+                stream.flags((std::ios::fmtflags)0);
+                ptr = parseFormat(ptr, fmt);
+                if (fmt.format == Format::None && ptr[-1] == 'n')
+                    stream << "we don't do %n!!!\n";
+                return;
             }
-            [[fallthrough]];
-          case '1':
-          case '2':
-          case '3':
-          case '4':
-          case '5':
-          case '6':
-          case '7':
-          case '8':
-          case '9':
-            number = number * 10 + (*ptr - '0');
+            stream.put('%');
+            ptr += 2;
             break;
 
-          case '*':
-            if (have_precision)
-                fmt.getPrecision = true;
-            else
-                fmt.getWidth = true;
+          case '\n':
+            stream << std::endl;
+            ++ptr;
             break;
-
-          case '%':
-            GEM5_UNREACHABLE;
+          case '\r':
+            ++ptr;
+            if (*ptr != '\n')
+                stream << std::endl;
             break;
 
           default:
-            done = true;
+            len = strcspn(ptr, "%\n\r\0");
+            stream.write(ptr, len);
+            ptr += len;
             break;
         }
-
-        if (end_number) {
-            if (have_precision)
-                fmt.precision = number;
-            else
-                fmt.width = number;
-
-            end_number = false;
-            number = 0;
-        }
-
-        if (done) {
-            if ((fmt.format == Format::Integer) && have_precision) {
-                // specified a . but not a float, set width
-                fmt.width = fmt.precision;
-                // precision requries digits for width, must fill with 0
-                fmt.fillZero = true;
-            } else if ((fmt.format == Format::Floating) && !have_precision &&
-                        fmt.fillZero) {
-                // ambiguous case, matching printf
-                fmt.precision = fmt.width;
-            }
-        }
-    } // end while
-
-    ++ptr;
+    }
 }
 
 void
@@ -30,10 +30,12 @@
 #ifndef __BASE_CPRINTF_HH__
 #define __BASE_CPRINTF_HH__
 
+#include <charconv>
 #include <ios>
 #include <iostream>
 #include <list>
 #include <string>
+#include <type_traits>
 
 #include "base/cprintf_formats.hh"
 
@@ -42,6 +44,188 @@ namespace gem5
 
 namespace cp {
 
+/**
+ * Parse a conversion specification into fmt. The format of a specification
+ * which isn't understood is left as Format::None.
+ *
+ * @param ptr Start of the specification, pointing to its '%'.
+ * @param fmt Format to fill in.
+ * @return Pointer just past the specification.
+ */
+constexpr const char *
+parseFormat(const char *ptr, Format &fmt)
+{
+    bool done = false;
+    bool end_number = false;
+    bool have_precision = false;
+    int number = 0;
+
+    fmt.clear();
+
+    while (!done) {
+        ++ptr;
+        if (*ptr >= '0' && *ptr <= '9') {
+            if (end_number)
+                continue;
+        } else if (number > 0) {
+            end_number = true;
+        }
+
+        switch (*ptr) {
+          case 's':
+            fmt.format = Format::String;
+            done = true;
+            break;
+
+          case 'c':
+            fmt.format = Format::Character;
+            done = true;
+            break;
+
+          case 'l':
+            continue;
+
+          case 'p':
+            fmt.format = Format::Integer;
+            fmt.base = Format::Hex;
+            fmt.alternateForm = true;
+            done = true;
+            break;
+
+          case 'X':
+            fmt.uppercase = true;
+            [[fallthrough]];
+          case 'x':
+            fmt.base = Format::Hex;
+            fmt.format = Format::Integer;
+            done = true;
+            break;
+
+          case 'o':
+            fmt.base = Format::Oct;
+            fmt.format = Format::Integer;
+            done = true;
+            break;
+
+          case 'd':
+          case 'i':
+          case 'u':
+            fmt.format = Format::Integer;
+            done = true;
+            break;
+
+          case 'G':
+            fmt.uppercase = true;
+            [[fallthrough]];
+          case 'g':
+            fmt.format = Format::Floating;
+            fmt.floatFormat = Format::Best;
+            done = true;
+            break;
+
+          case 'E':
+            fmt.uppercase = true;
+            [[fallthrough]];
+          case 'e':
+            fmt.format = Format::Floating;
+            fmt.floatFormat = Format::Scientific;
+            done = true;
+            break;
+
+          case 'f':
+            fmt.format = Format::Floating;
+            fmt.floatFormat = Format::Fixed;
+            done = true;
+            break;
+
+          case '#':
+            fmt.alternateForm = true;
+            break;
+
+          case '-':
+            fmt.flushLeft = true;
+            break;
+
+          case '+':
+            fmt.printSign = true;
+            break;
+
+          case ' ':
+            fmt.blankSpace = true;
+            break;
+
+          case '.':
+            fmt.width = number;
+            fmt.precision = 0;
+            have_precision = true;
+            number = 0;
+            end_number = false;
+            break;
+
+          case '0':
+            if (number == 0) {
+                fmt.fillZero = true;
+                break;
+            }
+            [[fallthrough]];
+          case '1':
+          case '2':
+          case '3':
+          case '4':
+          case '5':
+          case '6':
+          case '7':
+          case '8':
+          case '9':
+            number = number * 10 + (*ptr - '0');
+            break;
+
+          case '*':
+            if (have_precision)
+                fmt.getPrecision = true;
+            else
+                fmt.getWidth = true;
+            break;
+
+          default:
+            // Includes %n, which we don't do.
+            done = true;
+            break;
+        }
+
+        if (end_number) {
+            if (have_precision)
+                fmt.precision = number;
+            else
+                fmt.width = number;
+
+            end_number = false;
+            number = 0;
+        }
+
+        if (done) {
+            if ((fmt.format == Format::Integer) && have_precision) {
+                // specified a . but not a float, set width
+                fmt.width = fmt.precision;
+                // precision requries digits for width, must fill with 0
+                fmt.fillZero = true;
+            } else if ((fmt.format == Format::Floating) && !have_precision &&
+                        fmt.fillZero) {
+                // ambiguous case, matching printf
+                fmt.precision = fmt.width;
+            }
+        }
+    } // end while
+
+    return ptr + 1;
+}
+
+/**
+ * Write the text between conversion specifications, handling %% and line
+ * ends like Print does.
+ */
+void writeText(std::ostream &stream, const char *text, size_t len);
+
 struct Print
 {
   protected:
@@ -57,7 +241,6 @@ struct Print
 
     Format fmt;
     void process();
-    void processFlag();
 
   public:
     Print(std::ostream &stream, const std::string &format);
@@ -98,6 +281,7 @@ struct Print
             return;
         }
 
+        cont = false;
         switch (fmt.format) {
           case Format::Character:
             formatChar(stream, data, fmt);
@@ -165,6 +349,323 @@ csprintf(const char *format, const Args &...args)
     return stream.str();
 }
 
+namespace cp
+{
+
+/**
+ * A format string parsed at compile time, see GEM5_FORMAT.
+ *
+ * The string is split into the conversion specifications and the text
+ * before each of them, so printing only walks the arguments. Integers
+ * without unusual flags are written with std::to_chars, everything else
+ * goes through the same formatting functions as Print.
+ */
+class FormatString
+{
+  public:
+    /** Specifications kept parsed, longer formats fall back to Print */
+    static constexpr int MaxSpecs = 16;
+
+    constexpr FormatString(const char *str)
+        : str(str)
+    {
+        const char *ptr = str;
+        const char *text = str;
+        while (*ptr) {
+            if (*ptr != '%' || ptr[1] == '%') {
+                ptr += *ptr == '%' ? 2 : 1;
+                continue;
+            }
+
+            Format fmt;
+            const char *end = parseFormat(ptr, fmt);
+            if (fmt.format == Format::None)
+                badFormat();
+            if (_numSpecs < MaxSpecs) {
+                specs[_numSpecs] = { size_t(text - str), size_t(ptr - text),
+                                     fmt };
+            }
+            _numSpecs++;
+            _numArgs += 1 + fmt.getWidth + fmt.getPrecision;
+            ptr = text = end;
+        }
+        tail = { size_t(text - str), size_t(ptr - text), Format() };
+    }
+
+    /** Number of arguments the format consumes */
+    constexpr int numArgs() const { return _numArgs; }
+
+    const char *c_str() const { return str; }
+
+    template <typename ...Args>
+    void
+    print(std::ostream &stream, const Args &...args) const
+    {
+        if (_numSpecs > MaxSpecs) {
+            Print print(stream, str);
+            ccprintf(print, args...);
+            return;
+        }
+
+        Writer writer(stream, *this);
+        (writer.addArg(args), ...);
+        writer.end();
+    }
+
+  private:
+    /**
+     * Not constexpr, so that calling it while parsing at compile time
+     * makes the compiler point at the bad specification.
+     */
+    static void badFormat() {}
+
+    struct Spec
+    {
+        /** Text before the specification */
+        size_t textOffset = 0;
+        size_t textLen = 0;
+        Format fmt;
+    };
+
+    template <typename T>
+    static constexpr bool isPlainInteger =
+        std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+        !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char16_t> &&
+        !std::is_same_v<T, char32_t>;
+
+    /**
+     * Write an integer the way _formatInteger() would.
+     *
+     * @return False if the format has flags this doesn't handle.
+     */
+    template <typename T>
+    static bool
+    writeInteger(std::ostream &out, T data, const Format &fmt)
+    {
+        if (fmt.uppercase || fmt.printSign || fmt.base == Format::Oct)
+            return false;
+
+        // Promote characters the way formatInteger() does
+        typedef std::conditional_t<sizeof(T) == 1, int, T> Int;
+        const Int value = data;
+        const bool hex = fmt.base == Format::Hex;
+        int width = fmt.width;
+
+        char buf[2 + 3 * sizeof(Int)];
+        char *ptr = buf;
+        if (hex && fmt.alternateForm) {
+            if (fmt.fillZero) {
+                out.write("0x", 2);
+                width -= 2;
+            } else if (value != 0) {
+                // std::ios::showbase
+                *ptr++ = '0';
+                *ptr++ = 'x';
+            }
+        }
+        ptr = hex ?
+            std::to_chars(ptr, std::end(buf),
+                          std::make_unsigned_t<Int>(value), 16).ptr :
+            std::to_chars(ptr, std::end(buf), value).ptr;
+
+        const int len = ptr - buf;
+        if (width <= len) {
+            out.write(buf, len);
+            return true;
+        }
+        const char fill = fmt.fillZero ? '0' : ' ';
+        const bool left = fmt.flushLeft && !fmt.fillZero;
+        if (left)
+            out.write(buf, len);
+        for (int i = len; i < width; i++)
+            out.put(fill);
+        if (!left)
+            out.write(buf, len);
+        return true;
+    }
+
+    class Writer
+    {
+      private:
+        std::ostream &stream;
+        const FormatString &format;
+        int spec = 0;
+        bool cont = false;
+        Format fmt;
+
+        bool saved = false;
+        std::ios::fmtflags savedFlags;
+        char savedFill;
+        int savedPrecision;
+        int savedWidth;
+
+        static int getNumber(int data) { return data; }
+        template <typename T>
+        static int getNumber(const T &data) { return 0; }
+
+        void
+        writeText(const Spec &s)
+        {
+            cp::writeText(stream, format.str + s.textOffset, s.textLen);
+        }
+
+        template <typename T>
+        void
+        formatArg(const T &data)
+        {
+            if constexpr (isPlainInteger<T>) {
+                if (fmt.format == Format::Integer &&
+                        writeInteger(stream, data, fmt)) {
+                    return;
+                }
+            }
+
+            if (!saved) {
+                saved = true;
+                savedFlags = stream.flags();
+                savedFill = stream.fill();
+                savedPrecision = stream.precision();
+                savedWidth = stream.width();
+            }
+            stream.fill(' ');
+            stream.flags((std::ios::fmtflags)0);
+
+            switch (fmt.format) {
+              case Format::Character:
+                formatChar(stream, data, fmt);
+                break;
+
+              case Format::Integer:
+                formatInteger(stream, data, fmt);
+                break;
+
+              case Format::Floating:
+                formatFloat(stream, data, fmt);
+                break;
+
+              case Format::String:
+                formatString(stream, data, fmt);
+                break;
+
+              default:
+                stream << "<bad format>";
+                break;
+            }
+        }
+
+      public:
+        Writer(std::ostream &stream, const FormatString &format)
+            : stream(stream), format(format)
+        {}
+
+        template <typename T>
+        void
+        addArg(const T &data)
+        {
+            if (!cont) {
+                const Spec &s = format.specs[spec++];
+                writeText(s);
+                fmt = s.fmt;
+            }
+
+            if (fmt.getWidth) {
+                fmt.getWidth = false;
+                cont = true;
+                fmt.width = getNumber(data);
+                return;
+            }
+
+            if (fmt.getPrecision) {
+                fmt.getPrecision = false;
+                cont = true;
+                fmt.precision = getNumber(data);
+                return;
+            }
+
+            cont = false;
+            formatArg(data);
+        }
+
+        void
+        end()
+        {
+            writeText(format.tail);
+            if (saved) {
+                stream.flags(savedFlags);
+                stream.fill(savedFill);
+                stream.precision(savedPrecision);
+                stream.width(savedWidth);
+            }
+        }
+    };
+
+    const char *str;
+    Spec specs[MaxSpecs] = {};
+    /** Text after the last specification */
+    Spec tail;
+    int _numSpecs = 0;
+    int _numArgs = 0;
+};
+
+/**
+ * The type of a format string literal, the string being returned by
+ * Str::get(). Created by GEM5_FORMAT.
+ */
+template <class Str>
+struct FormatLiteral
+{
+    static constexpr FormatString format{Str::get()};
+};
+
+} // namespace cp
+
+/**
+ * Parse a format string literal at compile time, for use in place of the
+ * format of ccprintf() and friends, DPRINTF() and the logging functions.
+ * Bad conversion specifications and argument counts not matching the
+ * format are reported by the compiler.
+ *
+ * ccprintf(os, GEM5_FORMAT("%#x: %s\n"), addr, name);
+ */
+#define GEM5_FORMAT(str)                                                  \
+    ([] {                                                                 \
+        struct Str { static constexpr const char *get() { return str; } }; \
+        return ::gem5::cp::FormatLiteral<Str>();                          \
+    }())
+
+template<class Str, typename ...Args> void
+ccprintf(std::ostream &stream, cp::FormatLiteral<Str>, const Args &...args)
+{
+    constexpr const cp::FormatString &format = cp::FormatLiteral<Str>::format;
+    static_assert(format.numArgs() == sizeof...(Args),
+                  "Number of arguments doesn't match the format string");
+    format.print(stream, args...);
+}
+
+template<class Str, typename ...Args> void
+cprintf(cp::FormatLiteral<Str> format, const Args &...args)
+{
+    ccprintf(std::cout, format, args...);
+}
+
+template<class Str, typename ...Args> std::string
+csprintf(cp::FormatLiteral<Str> format, const Args &...args)
+{
+    std::stringstream stream;
+    ccprintf(stream, format, args...);
+    return stream.str();
+}
+
+/** The format string of a literal or of a C string */
+template <class Str>
+constexpr const char *
+formatCString(cp::FormatLiteral<Str>)
+{
+    return Str::get();
+}
+
+inline const char *formatCString(const char *format) { return format; }
+
 /*
  * functions again with std::string.  We have both so we don't waste
  * time converting const char * to std::string since we don't take
@@ -29,6 +29,7 @@
 #include <gtest/gtest.h>
 
 #include <cstdio>
+#include <iomanip>
 #include <sstream>
 #include <string>
 
@@ -180,3 +181,50 @@ TEST(CPrintf, SpecialFormatting)
     CPRINTF_TEST("%07.*f\n", 4, 1.234);
     CPRINTF_TEST("%#0*x\n", 9, 123412);
 }
+
+#define FORMAT_TEST(format, ...)                         \
+    do {                                                 \
+        std::stringstream expected, seen;                \
+        ccprintf(expected, format, ##__VA_ARGS__);       \
+        ccprintf(seen, GEM5_FORMAT(format), ##__VA_ARGS__); \
+        EXPECT_EQ(seen.str(), expected.str());           \
+    } while (0)
+
+TEST(CPrintf, FormatLiteral)
+{
+    FORMAT_TEST("no arguments\n");
+    FORMAT_TEST("%%d %% 100%%\r\n\rend\r");
+    FORMAT_TEST("%d %i %u %x %X %o\n", 1, -2, 3u, 0xabcU, 0xabcU, 8);
+    FORMAT_TEST("%d %x %d %x\n", -1, -1, (int64_t)-1, (int64_t)-1);
+    FORMAT_TEST("%d %x %d %x\n", (int8_t)-1, (int8_t)-1, (short)-3,
+                (short)-3);
+    FORMAT_TEST("%d %x %d\n", 'A', (unsigned char)200, (signed char)-5);
+    FORMAT_TEST("%#x %#x %#o %#d %p\n", 0, 0x1f, 8, 10, (void *)0x1234);
+    FORMAT_TEST("[%5d] [%-5d] [%05d] [%05d] [%.3d]\n", 12, 12, 12, -12, 7);
+    FORMAT_TEST("[%#10x] [%#010x] [%-#10x] [%#018x]\n", 0xbeef, 0xbeef,
+                0xbeef, (uint64_t)0xdeadbeef);
+    FORMAT_TEST("[%2d] [%1d] [%+d] [% d]\n", 12345, 0, 5, 5);
+    FORMAT_TEST("%llu %lld %#llx\n", ~0ULL, (long long)-5, ~0ULL);
+    FORMAT_TEST("%d %s %d\n", true, false, (uint16_t)0xffff);
+    FORMAT_TEST("[%s] [%10s] [%-10s] [%c]\n", "str", std::string("str"),
+                "left", 'c');
+    FORMAT_TEST("%f %.2f %8.3e %g %E\n", 1.5, 2.345, 12345.678, 0.1, 1e10);
+    FORMAT_TEST("%.3f then %f\n", 1.23456, 1.5);
+    FORMAT_TEST("[%*d] [%-*d] [%0*.*f] [%#0*x]\n", 6, 42, 6, 42, 8, 4,
+                99.99, 9, 123412);
+    FORMAT_TEST("%s%d%s%d%s%d%s%d%s%d%s%d%s%d%s%d%s%d\n",
+                "a", 1, "b", 2, "c", 3, "d", 4, "e", 5, "f", 6, "g", 7,
+                "h", 8, "i", 9);
+}
+
+TEST(CPrintf, FormatLiteralKeepsStreamState)
+{
+    std::stringstream ss;
+    ss << std::hex << std::setw(0) << std::setprecision(3);
+    ss.fill('*');
+    ccprintf(ss, GEM5_FORMAT("%d %5.1f %08x"), 10, 1.25, 0xabc);
+    EXPECT_EQ(ss.str(), "10   1.2 00000abc");
+    EXPECT_EQ(ss.flags() & std::ios::basefield, std::ios::hex);
+    EXPECT_EQ(ss.fill(), '*');
+    EXPECT_EQ(ss.precision(), 3);
+}
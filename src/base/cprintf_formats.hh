@@ -44,18 +44,18 @@ namespace cp
 
 struct Format
 {
-    bool alternateForm;
-    bool flushLeft;
-    bool printSign;
-    bool blankSpace;
-    bool fillZero;
-    bool uppercase;
+    bool alternateForm = false;
+    bool flushLeft = false;
+    bool printSign = false;
+    bool blankSpace = false;
+    bool fillZero = false;
+    bool uppercase = false;
     enum
     {
         Dec,
         Hex,
         Oct
-    } base;
+    } base = Dec;
     enum
     {
         None,
@@ -63,36 +63,24 @@ struct Format
         Integer,
         Character,
         Floating
-    } format;
+    } format = None;
     enum
     {
         Best,
         Fixed,
         Scientific
-    } floatFormat;
-    int precision;
-    int width;
-    bool getPrecision;
-    bool getWidth;
+    } floatFormat = Best;
+    int precision = -1;
+    int width = 0;
+    bool getPrecision = false;
+    bool getWidth = false;
 
-    Format() { clear(); }
+    constexpr Format() = default;
 
-    void
+    constexpr void
     clear()
     {
-        alternateForm = false;
-        flushLeft = false;
-        printSign = false;
-        blankSpace = false;
-        fillZero = false;
-        uppercase = false;
-        base = Dec;
-        format = None;
-        floatFormat = Best;
-        precision = -1;
-        width = 0;
-        getPrecision = false;
-        getWidth = false;
+        *this = Format();
     }
 };
 
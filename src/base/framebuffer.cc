@@ -39,6 +39,8 @@
 
 #include <zlib.h>
 
+#include <algorithm>
+
 #include "base/bitfield.hh"
 
 namespace gem5
@@ -48,7 +50,7 @@ const FrameBuffer FrameBuffer::dummy(320, 240);
 
 FrameBuffer::FrameBuffer(unsigned width, unsigned height)
     : pixels(width * height),
-      _width(width), _height(height)
+      _width(width), _height(height), lineVersions(height)
 {
     clear();
 }
@@ -77,6 +79,8 @@ FrameBuffer::unserialize(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(_width);
     UNSERIALIZE_SCALAR(_height);
     UNSERIALIZE_CONTAINER(pixels);
+    lineVersions.resize(_height);
+    markDirty();
 }
 
 void
@@ -86,6 +90,8 @@ FrameBuffer::resize(unsigned width, unsigned height)
     _height = height;
 
     pixels.resize(width * height);
+    lineVersions.resize(height);
+    markDirty();
 }
 
 void
@@ -93,6 +99,7 @@ FrameBuffer::fill(const Pixel &pixel)
 {
     for (auto &p : pixels)
         p = pixel;
+    markDirty();
 }
 
 void
@@ -106,19 +113,54 @@ FrameBuffer::clear()
 void
 FrameBuffer::copyIn(const uint8_t *fb, const PixelConverter &conv)
 {
-    for (auto &p : pixels) {
-        p = conv.toPixel(fb);
-        fb += conv.length;
+    std::vector<Pixel> line(_width);
+    for (unsigned y = 0; y < _height; ++y) {
+        conv.toPixels(fb, line.data(), _width);
+        updateLine(y, line.data());
+        fb += _width * conv.length;
     }
 }
 
 void
 FrameBuffer::copyOut(uint8_t *fb, const PixelConverter &conv) const
 {
-    for (auto &p : pixels) {
-        conv.fromPixel(fb, p);
-        fb += conv.length;
-    }
+    conv.fromPixels(fb, pixels.data(), area());
+}
+
+bool
+FrameBuffer::updateLine(unsigned y, const Pixel *line)
+{
+    Pixel *dst = &pixels[y * _width];
+    if (std::equal(line, line + _width, dst))
+        return false;
+
+    std::copy(line, line + _width, dst);
+    markDirty(y);
+    return true;
+}
+
+void
+FrameBuffer::markDirty()
+{
+    ++_version;
+    std::fill(lineVersions.begin(), lineVersions.end(), _version);
+}
+
+bool
+FrameBuffer::dirtyLines(uint64_t since, unsigned &first,
+                        unsigned &last) const
+{
+    auto newer = [since](uint64_t v) { return v > since; };
+    auto first_it = std::find_if(lineVersions.begin(), lineVersions.end(),
+                                 newer);
+    if (first_it == lineVersions.end())
+        return false;
+
+    auto last_it = std::find_if(lineVersions.rbegin(), lineVersions.rend(),
+                                newer);
+    first = first_it - lineVersions.begin();
+    last = lineVersions.rend() - last_it - 1;
+    return true;
 }
 
 uint64_t
@@ -64,6 +64,12 @@ namespace gem5
  * image. That is, the pixel at position (0, 0) is the upper left
  * corner. The backing store is a linear vector of Pixels ordered left
  * to right starting in the upper left corner.
+ *
+ * Changes are tracked a line at a time to let consumers, such as a VNC
+ * server, only process the parts of the image which changed. Every
+ * change bumps a version number, and each line records the version
+ * in which it last changed. Code writing to pixels directly must call
+ * markDirty() for the lines it changed.
  */
 class FrameBuffer : public Serializable
 {
@@ -115,7 +121,8 @@ class FrameBuffer : public Serializable
 
     /**
      * Fill the frame buffer with pixel data from an external buffer
-     * of the same width and height as this frame buffer.
+     * of the same width and height as this frame buffer. Only the
+     * lines which changed are marked as dirty.
      *
      * @param fb External frame buffer
      * @param conv Pixel conversion helper
@@ -177,6 +184,43 @@ class FrameBuffer : public Serializable
         return pixels[y * _width + x];
     }
 
+    /**
+     * Replace the contents of a line, marking it as dirty if any pixel
+     * changed.
+     *
+     * @param y Line to update.
+     * @param line width() pixels to store in the line.
+     * @return Whether the line changed.
+     */
+    bool updateLine(unsigned y, const Pixel *line);
+
+    /** Record that line y changed */
+    void
+    markDirty(unsigned y)
+    {
+        assert(y < _height);
+        lineVersions[y] = ++_version;
+    }
+
+    /** Record that the whole frame buffer changed */
+    void markDirty();
+
+    /**
+     * Version of the contents of the frame buffer. This increases
+     * every time part of the frame buffer is marked as dirty.
+     */
+    uint64_t version() const { return _version; }
+
+    /**
+     * Find the lines which changed after a given version.
+     *
+     * @param since Version to compare against.
+     * @param first Set to the first line which changed.
+     * @param last Set to the last line which changed.
+     * @return Whether any line changed.
+     */
+    bool dirtyLines(uint64_t since, unsigned &first, unsigned &last) const;
+
     /**
      * Create a hash of the image that can be used for quick
      * comparisons.
@@ -199,6 +243,11 @@ class FrameBuffer : public Serializable
     unsigned _width;
     /** Height in pixels */
     unsigned _height;
+
+    /** Current version of the contents */
+    uint64_t _version = 0;
+    /** Version in which each line last changed */
+    std::vector<uint64_t> lineVersions;
 };
 
 } // namespace gem5
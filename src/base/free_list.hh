@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_FREE_LIST_HH__
+#define __BASE_FREE_LIST_HH__
+
+#include <cstddef>
+#include <new>
+
+namespace gem5
+{
+
+/**
+ * Thread-local free lists of small memory blocks.
+ *
+ * Blocks are grouped in size classes of Granularity bytes. A freed block
+ * is kept on the free list of the thread that frees it and is handed out
+ * again by the next allocation of the same size class on that thread, so
+ * objects that are created and destroyed at a high rate by a simulation
+ * thread stop going through the heap once the lists are warm. Requests
+ * larger than MaxSize bytes are forwarded to the global operator new.
+ */
+class FreeList
+{
+  public:
+    static constexpr std::size_t Granularity = 16;
+    static constexpr std::size_t MaxSize = 512;
+
+    static void *
+    allocate(std::size_t size)
+    {
+        if (size > MaxSize)
+            return ::operator new(size);
+
+        Block *&head = lists().heads[sizeClass(size)];
+        if (!head)
+            return ::operator new(roundUp(size));
+
+        Block *block = head;
+        head = block->next;
+        return block;
+    }
+
+    static void
+    deallocate(void *p, std::size_t size)
+    {
+        if (!p)
+            return;
+
+        if (size > MaxSize) {
+            ::operator delete(p);
+            return;
+        }
+
+        Block *&head = lists().heads[sizeClass(size)];
+        Block *block = static_cast<Block *>(p);
+        block->next = head;
+        head = block;
+    }
+
+  private:
+    struct Block
+    {
+        Block *next;
+    };
+
+    static constexpr std::size_t NumClasses = MaxSize / Granularity;
+
+    struct Lists
+    {
+        Block *heads[NumClasses] = {};
+
+        ~Lists()
+        {
+            for (auto &head : heads) {
+                while (head) {
+                    Block *next = head->next;
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+        }
+    };
+
+    static constexpr std::size_t
+    roundUp(std::size_t size)
+    {
+        return (size + Granularity - 1) / Granularity * Granularity;
+    }
+
+    static constexpr std::size_t
+    sizeClass(std::size_t size)
+    {
+        return size ? (size - 1) / Granularity : 0;
+    }
+
+    static Lists &
+    lists()
+    {
+        static thread_local Lists _lists;
+        return _lists;
+    }
+};
+
+/**
+ * Base class that makes a class (and the classes derived from it) use
+ * FreeList to allocate its instances.
+ *
+ * Classes that are destroyed through a pointer to a base should have a
+ * virtual destructor, which ensures that the size of the most derived
+ * class is passed to operator delete.
+ */
+template <class T>
+class FreeListAllocated
+{
+  public:
+    static void *operator new(std::size_t size)
+    {
+        return FreeList::allocate(size);
+    }
+
+    static void operator delete(void *p, std::size_t size)
+    {
+        FreeList::deallocate(p, size);
+    }
+};
+
+/**
+ * Standard allocator that takes its memory from FreeList. It can be used
+ * with containers and std::allocate_shared to pool the allocations of
+ * short-lived node or control-block objects.
+ */
+template <class T>
+class FreeListAllocator
+{
+  public:
+    using value_type = T;
+
+    FreeListAllocator() = default;
+
+    template <class U>
+    FreeListAllocator(const FreeListAllocator<U> &) {}
+
+    T *
+    allocate(std::size_t n)
+    {
+        return static_cast<T *>(FreeList::allocate(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *p, std::size_t n)
+    {
+        FreeList::deallocate(p, n * sizeof(T));
+    }
+
+    template <class U>
+    bool operator==(const FreeListAllocator<U> &) const { return true; }
+
+    template <class U>
+    bool operator!=(const FreeListAllocator<U> &) const { return false; }
+};
+
+} // namespace gem5
+
+#endif // __BASE_FREE_LIST_HH__
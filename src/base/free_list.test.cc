@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "base/free_list.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Small : public FreeListAllocated<Small>
+{
+    virtual ~Small() = default;
+    int value = 0;
+};
+
+struct Large : public Small
+{
+    char payload[200];
+};
+
+struct Huge : public FreeListAllocated<Huge>
+{
+    char payload[FreeList::MaxSize + 1];
+};
+
+} // anonymous namespace
+
+/** Freed blocks are handed out again by the next allocation. */
+TEST(FreeListTest, ReusesBlocks)
+{
+    Small *a = new Small;
+    delete a;
+    Small *b = new Small;
+    EXPECT_EQ(a, b);
+    delete b;
+}
+
+/** Live objects never share storage. */
+TEST(FreeListTest, DistinctLiveObjects)
+{
+    std::vector<Small *> objs;
+    for (int i = 0; i < 100; i++) {
+        objs.push_back(new Small);
+        objs.back()->value = i;
+    }
+    std::set<Small *> unique(objs.begin(), objs.end());
+    EXPECT_EQ(unique.size(), objs.size());
+
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(objs[i]->value, i);
+        delete objs[i];
+    }
+}
+
+/** Derived classes are returned to the free list of their own size. */
+TEST(FreeListTest, DerivedSizeClasses)
+{
+    Small *large = new Large;
+    delete large;
+
+    Small *small = new Small;
+    EXPECT_NE(static_cast<void *>(small), static_cast<void *>(large));
+    Small *large2 = new Large;
+    EXPECT_EQ(large2, large);
+
+    delete small;
+    delete large2;
+}
+
+/** Objects above the size limit bypass the free lists. */
+TEST(FreeListTest, HugeObjects)
+{
+    Huge *h = new Huge;
+    h->payload[FreeList::MaxSize] = 1;
+    delete h;
+}
+
+/** Every thread has its own free lists. */
+TEST(FreeListTest, ThreadLocal)
+{
+    Small *a = new Small;
+    delete a;
+
+    Small *other = nullptr;
+    std::thread t([&other]() {
+        other = new Small;
+        delete other;
+    });
+    t.join();
+
+    EXPECT_NE(a, other);
+    Small *b = new Small;
+    EXPECT_EQ(a, b);
+    delete b;
+}
+
+/** Shared objects made with FreeListAllocator reuse their storage. */
+TEST(FreeListTest, AllocateShared)
+{
+    auto a = std::allocate_shared<Small>(FreeListAllocator<Small>());
+    Small *first = a.get();
+    a.reset();
+
+    auto b = std::allocate_shared<Small>(FreeListAllocator<Small>());
+    EXPECT_EQ(first, b.get());
+}
@@ -38,13 +38,17 @@ namespace loader
 bool
 MemoryImage::writeSegment(const Segment &seg, const PortProxy &proxy) const
 {
-    if (seg.size != 0) {
-        if (seg.data) {
-            proxy.writeBlob(seg.base, seg.data, seg.size);
-        } else {
-            // no image: must be bss
-            proxy.memsetBlob(seg.base, 0, seg.size);
-        }
+    if (seg.size == 0)
+        return true;
+    // Images are written where the caches can't have a copy of the data
+    // yet, so they can go straight to memory.
+    if (seg.data) {
+        fatal_if(!proxy.tryLoadBlob(seg.base, seg.data, seg.size),
+                "Failed to load segment %s at %#x.", seg.name, seg.base);
+    } else {
+        // no image: must be bss
+        fatal_if(!proxy.tryLoadZeros(seg.base, seg.size),
+                "Failed to zero segment %s at %#x.", seg.name, seg.base);
     }
     return true;
 }
@@ -58,10 +58,19 @@ void
 SymbolTable::clear()
 {
     addrMap.clear();
+    addrMapSorted = true;
     nameMap.clear();
     symbols.clear();
 }
 
+void
+SymbolTable::reserve(size_t n)
+{
+    symbols.reserve(n);
+    addrMap.reserve(n);
+    nameMap.reserve(n);
+}
+
 bool
 SymbolTable::insert(const Symbol &symbol)
 {
@@ -74,8 +83,10 @@ SymbolTable::insert(const Symbol &symbol)
         return false;
 
     // There can be multiple symbols for the same address, so always
-    // update the addrTable multimap when we see a new symbol name.
-    addrMap.insert({ symbol.address(), idx });
+    // update the address map when we see a new symbol name.
+    if (!addrMap.empty() && symbol.address() < addrMap.back().first)
+        addrMapSorted = false;
+    addrMap.emplace_back(symbol.address(), idx);
 
     symbols.emplace_back(symbol);
 
@@ -86,17 +97,17 @@ bool
 SymbolTable::insert(const SymbolTable &other)
 {
     // Check if any symbol in other already exists in our table.
-    NameMap intersection;
-    std::set_intersection(other.nameMap.begin(), other.nameMap.end(),
-                          nameMap.begin(), nameMap.end(),
-                          std::inserter(intersection, intersection.begin()),
-                          nameMap.value_comp());
-    if (!intersection.empty()) {
+    const bool collision = std::any_of(
+            other.nameMap.begin(), other.nameMap.end(),
+            [this](const NameMap::value_type &entry)
+            { return nameMap.count(entry.first); });
+    if (collision) {
         warn("Cannot insert a new symbol table due to name collisions. "
              "Adding prefix to each symbol's name can resolve this issue.");
         return false;
     }
 
+    reserve(symbols.size() + other.symbols.size());
     for (const Symbol &symbol: other)
         insert(symbol);
 
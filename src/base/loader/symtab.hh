@@ -42,11 +42,13 @@
 #ifndef __BASE_LOADER_SYMTAB_HH__
 #define __BASE_LOADER_SYMTAB_HH__
 
+#include <algorithm>
 #include <functional>
 #include <iosfwd>
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "base/compiler.hh"
@@ -103,7 +105,7 @@ class Symbol
         return _type;
     }
 
-    std::string name() const {
+    const std::string &name() const {
         return _name;
     }
 
@@ -156,15 +158,36 @@ class SymbolTable
   private:
     /** Vector containing all the symbols in the table. */
     typedef std::vector<Symbol> SymbolVector;
-    /** Map addresses to an index into the symbol vector. */
-    typedef std::multimap<Addr, int> AddrMap;
+    /**
+     * Addresses and indices into the symbol vector, sorted by address and
+     * then index, so among the symbols of an address the first inserted
+     * comes first.
+     */
+    typedef std::vector<std::pair<Addr, int>> AddrMap;
     /** Map a symbol name to an index into the symbol vector. */
-    typedef std::map<std::string, int> NameMap;
+    typedef std::unordered_map<std::string, int> NameMap;
 
     SymbolVector symbols;
-    AddrMap addrMap;
     NameMap nameMap;
 
+    /**
+     * Symbols are usually inserted out of address order, so the address
+     * map is only sorted when it is first looked up after an insertion.
+     * Access via sortedAddrs()!
+     */
+    mutable AddrMap addrMap;
+    mutable bool addrMapSorted = true;
+
+    const AddrMap &
+    sortedAddrs() const
+    {
+        if (!addrMapSorted) {
+            std::sort(addrMap.begin(), addrMap.end());
+            addrMapSorted = true;
+        }
+        return addrMap;
+    }
+
     /**
      * Get the first address larger than the given address, if any.
      *
@@ -175,11 +198,15 @@ class SymbolTable
     bool
     upperBound(Addr addr, AddrMap::const_iterator &iter) const
     {
+        const AddrMap &addrs = sortedAddrs();
+
         // find first key *larger* than desired address
-        iter = addrMap.upper_bound(addr);
+        iter = std::upper_bound(addrs.begin(), addrs.end(), addr,
+                [](Addr a, const AddrMap::value_type &entry)
+                { return a < entry.first; });
 
         // if very first key is larger, we're out of luck
-        if (iter == addrMap.begin())
+        if (iter == addrs.begin())
             return false;
 
         return true;
@@ -204,6 +231,7 @@ class SymbolTable
     operate(SymTabOp op) const
     {
         SymbolTablePtr symtab(new SymbolTable);
+        symtab->reserve(symbols.size());
         for (const auto &symbol: symbols)
             op(*symtab, symbol);
         return symtab;
@@ -280,6 +308,13 @@ class SymbolTable
     /** Clears the table. */
     void clear();
 
+    /**
+     * Make room for a number of symbols, to be inserted next.
+     *
+     * @param n The number of symbols the table should hold.
+     */
+    void reserve(size_t n);
+
     /**
      * Insert a new symbol in the table if it does not already exist. The
      * symbol must have a defined name.
@@ -434,8 +469,12 @@ class SymbolTable
     const_iterator
     find(Addr address) const
     {
-        AddrMap::const_iterator i = addrMap.find(address);
-        if (i == addrMap.end())
+        const AddrMap &addrs = sortedAddrs();
+        AddrMap::const_iterator i = std::lower_bound(
+                addrs.begin(), addrs.end(), address,
+                [](const AddrMap::value_type &entry, Addr a)
+                { return entry.first < a; });
+        if (i == addrs.end() || i->first != address)
             return end();
 
         // There are potentially multiple symbols that map to the same
@@ -473,7 +512,7 @@ class SymbolTable
     const_iterator
     findNearest(Addr addr, Addr &next_addr) const
     {
-        AddrMap::const_iterator i = addrMap.end();
+        AddrMap::const_iterator i;
         if (!upperBound(addr, i))
             return end();
 
@@ -495,7 +534,7 @@ class SymbolTable
     const_iterator
     findNearest(Addr addr) const
     {
-        AddrMap::const_iterator i = addrMap.end();
+        AddrMap::const_iterator i;
         if (!upperBound(addr, i))
             return end();
 
@@ -727,6 +727,49 @@ TEST(LoaderSymtabTest, FindNearestRoundWithNext)
     ASSERT_EQ(next_addr, symbols[1].address());
 }
 
+/**
+ * Test that lookups by address do not depend on the order in which the
+ * symbols were inserted, and that lookups interleaved with insertions see
+ * the symbols inserted so far.
+ */
+TEST(LoaderSymtabTest, FindNearestUnsortedInsertion)
+{
+    loader::SymbolTable symtab;
+
+    loader::Symbol symbols[] = {
+        {loader::Symbol::Binding::Local, loader::Symbol::SymbolType::Other,
+            "symbol", 0x30},
+        {loader::Symbol::Binding::Local, loader::Symbol::SymbolType::Other,
+            "symbol2", 0x10},
+        {loader::Symbol::Binding::Local, loader::Symbol::SymbolType::Other,
+            "symbol3", 0x20},
+        {loader::Symbol::Binding::Local, loader::Symbol::SymbolType::Other,
+            "symbol4", 0x10},
+    };
+    EXPECT_TRUE(symtab.insert(symbols[0]));
+    EXPECT_TRUE(symtab.insert(symbols[1]));
+
+    Addr next_addr;
+    auto it = symtab.findNearest(symbols[1].address() + 0x1, next_addr);
+    ASSERT_NE(it, symtab.end());
+    ASSERT_PRED_FORMAT2(checkSymbol, *it, symbols[1]);
+    ASSERT_EQ(next_addr, symbols[0].address());
+
+    EXPECT_TRUE(symtab.insert(symbols[2]));
+    EXPECT_TRUE(symtab.insert(symbols[3]));
+
+    // Of the symbols at the nearest address the last inserted one is found,
+    // while find() returns the first one.
+    it = symtab.findNearest(symbols[1].address() + 0x1, next_addr);
+    ASSERT_NE(it, symtab.end());
+    ASSERT_PRED_FORMAT2(checkSymbol, *it, symbols[3]);
+    ASSERT_EQ(next_addr, symbols[2].address());
+
+    it = symtab.find(symbols[3].address());
+    ASSERT_NE(it, symtab.end());
+    ASSERT_PRED_FORMAT2(checkSymbol, *it, symbols[1]);
+}
+
 /**
  * Test that, in a table containing address A, searching for the nearest
  * address of an address B where B=A+x returns A; however, the next address
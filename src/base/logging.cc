@@ -41,6 +41,7 @@
 #include "base/logging.hh"
 
 #include <sstream>
+#include <vector>
 
 #include "base/hostinfo.hh"
 
@@ -49,6 +50,13 @@ namespace gem5
 
 namespace {
 
+std::vector<std::function<void()>> &
+exitHooks()
+{
+    static auto *hooks = new std::vector<std::function<void()>>;
+    return *hooks;
+}
+
 class ExitLogger : public Logger
 {
   public:
@@ -61,6 +69,14 @@ class ExitLogger : public Logger
         std::stringstream ss;
         ccprintf(ss, "Memory Usage: %ld KBytes\n", memUsage());
         Logger::log(loc, s + ss.str());
+
+        // Don't run the hooks again if one of them fails.
+        static bool running_hooks = false;
+        if (!running_hooks) {
+            running_hooks = true;
+            for (auto &hook : exitHooks())
+                hook();
+        }
     }
 };
 
@@ -81,6 +97,12 @@ class FatalLogger : public ExitLogger
 // veriables to ensure they are initialized ondemand, so it is also safe to use
 // them inside constructor of other global objects.
 
+void
+Logger::addExitHook(const std::function<void()> &hook)
+{
+    exitHooks().push_back(hook);
+}
+
 Logger&
 Logger::getPanic() {
     static ExitLogger* panic_logger = new ExitLogger("panic: ");
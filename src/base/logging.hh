@@ -42,6 +42,7 @@
 #define __BASE_LOGGING_HH__
 
 #include <cassert>
+#include <functional>
 #include <sstream>
 #include <utility>
 
@@ -80,6 +81,13 @@ class Logger
         getHack().enabled = (ll >= HACK);
     }
 
+    /**
+     * Register a function to call when panic() or fatal() is about to
+     * end the simulation, after the message has been printed. This is
+     * meant for saving state that helps to debug the failure.
+     */
+    static void addExitHook(const std::function<void()> &hook);
+
     struct Loc
     {
         Loc(const char *file, int line) : file(file), line(line) {}
@@ -94,8 +102,8 @@ class Logger
 
     virtual ~Logger() {};
 
-    template<typename ...Args> void
-    print(const Loc &loc, const char *format, const Args &...args)
+    template<typename Format, typename ...Args> void
+    print(const Loc &loc, const Format &format, const Args &...args)
     {
         std::stringstream ss;
         ccprintf(ss, format, args...);
@@ -110,12 +118,6 @@ class Logger
         log(loc, ss_formatted.str());
     }
 
-    template<typename ...Args> void
-    print(const Loc &loc, const std::string &format, const Args &...args)
-    {
-        print(loc, format.c_str(), args...);
-    }
-
     /**
      * This helper is necessary since noreturn isn't inherited by virtual
      * functions, and gcc will get mad if a function calls panic and then
@@ -40,6 +40,7 @@
 #include <cassert>
 
 #include "base/bitfield.hh"
+#include "base/logging.hh"
 
 namespace gem5
 {
@@ -63,6 +64,10 @@ PixelConverter::PixelConverter(unsigned _length,
       ch_b(bo, bw)
 {
     assert(length > 1);
+
+    narrowChannels = rw <= 8 && gw <= 8 && bw <= 8;
+    isRgba8888 = length == 4 && byte_order == ByteOrder::little &&
+        ro == 0 && go == 8 && bo == 16 && rw == 8 && gw == 8 && bw == 8;
 }
 
 PixelConverter::Channel::Channel(unsigned _offset, unsigned width)
@@ -70,6 +75,10 @@ PixelConverter::Channel::Channel(unsigned _offset, unsigned width)
       mask(gem5::mask(width)),
       factor(255.0 / mask)
 {
+    for (unsigned v = 0; v < toLut.size(); ++v) {
+        toLut[v] = width <= 8 ? toPixel(v << offset) : 0;
+        fromLut[v] = fromPixel(v);
+    }
 }
 
 uint32_t
@@ -100,4 +109,83 @@ PixelConverter::writeWord(uint8_t *p, uint32_t word) const
     }
 }
 
+template <unsigned Length, bool BigEndian>
+void
+PixelConverter::toPixelsLut(const uint8_t *src, Pixel *dst,
+                            size_t count) const
+{
+    for (size_t n = 0; n < count; ++n, src += Length) {
+        uint32_t word = 0;
+        for (unsigned i = 0; i < Length; ++i)
+            word |= src[i] << (8 * (BigEndian ? Length - i - 1 : i));
+
+        dst[n] = Pixel(ch_r.toLut[(word >> ch_r.offset) & ch_r.mask],
+                       ch_g.toLut[(word >> ch_g.offset) & ch_g.mask],
+                       ch_b.toLut[(word >> ch_b.offset) & ch_b.mask]);
+    }
+}
+
+template <unsigned Length, bool BigEndian>
+void
+PixelConverter::fromPixelsLut(uint8_t *dst, const Pixel *src,
+                              size_t count) const
+{
+    for (size_t n = 0; n < count; ++n, dst += Length) {
+        const uint32_t word = ch_r.fromLut[src[n].red] |
+            ch_g.fromLut[src[n].green] | ch_b.fromLut[src[n].blue];
+        for (unsigned i = 0; i < Length; ++i)
+            dst[i] = word >> (8 * (BigEndian ? Length - i - 1 : i));
+    }
+}
+
+void
+PixelConverter::toPixels(const uint8_t *src, Pixel *dst, size_t count) const
+{
+    const bool big = byte_order == ByteOrder::big;
+    if (isRgba8888) {
+        // Simple enough for the compiler to vectorize
+        for (size_t n = 0; n < count; ++n, src += 4)
+            dst[n] = Pixel(src[0], src[1], src[2]);
+    } else if (!narrowChannels) {
+        for (size_t n = 0; n < count; ++n, src += length)
+            dst[n] = toPixel(src);
+    } else if (length == 2) {
+        big ? toPixelsLut<2, true>(src, dst, count) :
+            toPixelsLut<2, false>(src, dst, count);
+    } else if (length == 3) {
+        big ? toPixelsLut<3, true>(src, dst, count) :
+            toPixelsLut<3, false>(src, dst, count);
+    } else if (length == 4) {
+        big ? toPixelsLut<4, true>(src, dst, count) :
+            toPixelsLut<4, false>(src, dst, count);
+    } else {
+        panic("Unsupported pixel length: %u\n", length);
+    }
+}
+
+void
+PixelConverter::fromPixels(uint8_t *dst, const Pixel *src, size_t count) const
+{
+    const bool big = byte_order == ByteOrder::big;
+    if (isRgba8888) {
+        for (size_t n = 0; n < count; ++n, dst += 4) {
+            dst[0] = src[n].red;
+            dst[1] = src[n].green;
+            dst[2] = src[n].blue;
+            dst[3] = 0;
+        }
+    } else if (length == 2) {
+        big ? fromPixelsLut<2, true>(dst, src, count) :
+            fromPixelsLut<2, false>(dst, src, count);
+    } else if (length == 3) {
+        big ? fromPixelsLut<3, true>(dst, src, count) :
+            fromPixelsLut<3, false>(dst, src, count);
+    } else if (length == 4) {
+        big ? fromPixelsLut<4, true>(dst, src, count) :
+            fromPixelsLut<4, false>(dst, src, count);
+    } else {
+        panic("Unsupported pixel length: %u\n", length);
+    }
+}
+
 } // namespace gem5
@@ -38,7 +38,9 @@
 #ifndef __BASE_PIXEL_HH__
 #define __BASE_PIXEL_HH__
 
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -127,6 +129,14 @@ class PixelConverter
          * 8-bit color channel
          */
         float factor;
+
+        /**
+         * Lookup tables equivalent to toPixel() and fromPixel(). The
+         * first one is only valid if the channel is at most 8 bits
+         * wide.
+         */
+        std::array<uint8_t, 256> toLut;
+        std::array<uint32_t, 256> fromLut;
     };
 
     PixelConverter(unsigned length,
@@ -161,6 +171,30 @@ class PixelConverter
         writeWord(rfb, fromPixel(pixel));
     }
 
+    /**
+     * Convert count consecutive color words in memory into Pixels.
+     *
+     * This gives the same result as calling toPixel() on each word,
+     * but uses lookup tables instead of floating point math and has a
+     * fast path for 8-bit channels in a 32-bit little endian word.
+     *
+     * @param src First byte of the first word.
+     * @param dst Where to store the Pixels.
+     * @param count Number of pixels to convert.
+     */
+    void toPixels(const uint8_t *src, Pixel *dst, size_t count) const;
+    /**
+     * Convert count Pixels into consecutive color words in memory.
+     *
+     * This gives the same result as calling fromPixel() on each
+     * Pixel.
+     *
+     * @param dst Where to store the first word.
+     * @param src Pixels to convert.
+     * @param count Number of pixels to convert.
+     */
+    void fromPixels(uint8_t *dst, const Pixel *src, size_t count) const;
+
     /**
      * Read a word of a given length and endianness from memory.
      *
@@ -198,6 +232,19 @@ class PixelConverter
     /** Blue channel conversion helper */
     Channel ch_b;
 
+  private:
+    template <unsigned Length, bool BigEndian>
+    void toPixelsLut(const uint8_t *src, Pixel *dst, size_t count) const;
+    template <unsigned Length, bool BigEndian>
+    void fromPixelsLut(uint8_t *dst, const Pixel *src, size_t count) const;
+
+    /** Pixels are bytes 0-2 of a 32-bit word, and bytes 0-2 of a Pixel */
+    bool isRgba8888;
+    /** All channels can be converted using Channel::toLut */
+    bool narrowChannels;
+
+  public:
+
     /** Predefined 32-bit RGB (red in least significant bits, 8
      * bits/channel, little endian) conversion helper */
     static const PixelConverter rgba8888_le;
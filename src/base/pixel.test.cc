@@ -37,6 +37,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "base/pixel.hh"
 
 using namespace gem5;
@@ -119,3 +121,40 @@ TEST(FBTest, MemToPixelRGBA8888BE)
     EXPECT_EQ(PixelConverter::rgba8888_be.toPixel(green), pixel_green);
     EXPECT_EQ(PixelConverter::rgba8888_be.toPixel(blue), pixel_blue);
 }
+
+/** Check that the bulk conversions agree with the per pixel ones */
+static void
+checkBulkConversion(const PixelConverter &conv)
+{
+    const size_t count = 97;
+    std::vector<uint8_t> words(count * conv.length);
+    for (size_t i = 0; i < words.size(); ++i)
+        words[i] = i * 37 + 11;
+
+    std::vector<Pixel> pixels(count);
+    conv.toPixels(words.data(), pixels.data(), count);
+    for (size_t i = 0; i < count; ++i)
+        EXPECT_EQ(pixels[i], conv.toPixel(&words[i * conv.length]));
+
+    for (size_t i = 0; i < count; ++i)
+        pixels[i] = Pixel(i * 13, i * 29 + 5, 255 - i);
+
+    std::vector<uint8_t> out(words.size());
+    std::vector<uint8_t> expected(words.size());
+    conv.fromPixels(out.data(), pixels.data(), count);
+    for (size_t i = 0; i < count; ++i)
+        conv.fromPixel(&expected[i * conv.length], pixels[i]);
+    EXPECT_EQ(out, expected);
+}
+
+TEST(FBTest, BulkConversion)
+{
+    checkBulkConversion(PixelConverter::rgba8888_le);
+    checkBulkConversion(PixelConverter::rgba8888_be);
+    checkBulkConversion(PixelConverter::rgb565_le);
+    checkBulkConversion(PixelConverter::rgb565_be);
+    // BGR888 in 24 bits
+    checkBulkConversion(PixelConverter(3, 16, 8, 0, 8, 8, 8));
+    // 10 bits per channel, which can't use the lookup tables
+    checkBulkConversion(PixelConverter(4, 0, 10, 20, 10, 10, 10));
+}
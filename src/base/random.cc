@@ -98,4 +98,57 @@ Random::unserialize(CheckpointIn &cp)
 
 Random random_mt;
 
+namespace
+{
+
+uint64_t globalSeed = 5489;
+
+/** Stream id for a name, FNV-1a so that it is stable across hosts */
+uint64_t
+streamId(const std::string &name)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c: name) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+} // anonymous namespace
+
+RandomStream::RandomStream(uint64_t stream) : gen(globalSeed, stream)
+{
+}
+
+RandomStream::RandomStream(const std::string &name)
+    : RandomStream(streamId(name))
+{
+}
+
+void
+RandomStream::setGlobalSeed(uint64_t seed)
+{
+    globalSeed = seed;
+}
+
+void
+RandomStream::serialize(CheckpointOut &cp) const
+{
+    paramOut(cp, "key", gen.key());
+    paramOut(cp, "stream", gen.stream());
+    paramOut(cp, "position", gen.position());
+}
+
+void
+RandomStream::unserialize(CheckpointIn &cp)
+{
+    uint64_t key, stream, position;
+    paramIn(cp, "key", key);
+    paramIn(cp, "stream", stream);
+    paramIn(cp, "position", position);
+    gen.seed(key, stream);
+    gen.setPosition(position);
+}
+
 } // namespace gem5
@@ -39,12 +39,16 @@
  */
 
 /*
- * Mersenne twister random number generator.
+ * Mersenne twister random number generator, and counter based random
+ * number streams.
  */
 
 #ifndef __BASE_RANDOM_HH__
 #define __BASE_RANDOM_HH__
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <random>
 #include <string>
 #include <type_traits>
@@ -125,6 +129,213 @@ class Random : public Serializable
  */
 extern Random random_mt;
 
+/**
+ * Philox4x32-10 counter based random bit generator (Salmon et al.,
+ * "Parallel random numbers: as easy as 1, 2, 3", SC'11).
+ *
+ * Each output block is a pure function of a key and a counter, so a
+ * generator is a few words of state, can be skipped ahead in constant
+ * time, and generators using different keys produce independent
+ * streams without any coordination between them.
+ */
+class Philox
+{
+  public:
+    typedef uint64_t result_type;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    Philox(uint64_t key=0, uint64_t stream=0) { seed(key, stream); }
+
+    /** Restart the stream at the first block */
+    void
+    seed(uint64_t key, uint64_t stream=0)
+    {
+        _key = key;
+        _stream = stream;
+        _counter = 0;
+        pos = BlockSize;
+    }
+
+    result_type
+    operator()()
+    {
+        if (pos == BlockSize) {
+            block = generate(_counter++);
+            pos = 0;
+        }
+        return block[pos++];
+    }
+
+    /** Skip n values */
+    void
+    discard(uint64_t n)
+    {
+        const uint64_t buffered = BlockSize - pos;
+        if (n <= buffered) {
+            pos += n;
+            return;
+        }
+        n -= buffered;
+        _counter += n / BlockSize;
+        pos = BlockSize;
+        for (n %= BlockSize; n; n--)
+            (*this)();
+    }
+
+    /**
+     * Fill a buffer with the next n values, a block at a time.
+     */
+    void
+    fill(uint64_t *buf, size_t n)
+    {
+        while (n && pos != BlockSize) {
+            *buf++ = (*this)();
+            n--;
+        }
+        for (; n >= BlockSize; n -= BlockSize, buf += BlockSize) {
+            const Block b = generate(_counter++);
+            buf[0] = b[0];
+            buf[1] = b[1];
+        }
+        while (n--)
+            *buf++ = (*this)();
+    }
+
+    uint64_t key() const { return _key; }
+    uint64_t stream() const { return _stream; }
+
+    /** Number of values generated so far */
+    uint64_t
+    position() const
+    {
+        return _counter * BlockSize - (BlockSize - pos);
+    }
+
+    /** Move to the given position in the stream */
+    void
+    setPosition(uint64_t position)
+    {
+        _counter = 0;
+        pos = BlockSize;
+        discard(position);
+    }
+
+  private:
+    static constexpr unsigned BlockSize = 2;
+    typedef std::array<uint64_t, BlockSize> Block;
+
+    Block
+    generate(uint64_t counter) const
+    {
+        uint32_t ctr[4] = {
+            uint32_t(counter), uint32_t(counter >> 32),
+            uint32_t(_stream), uint32_t(_stream >> 32)
+        };
+        uint32_t k[2] = { uint32_t(_key), uint32_t(_key >> 32) };
+
+        for (int round = 0; round < 10; round++) {
+            const uint64_t p0 = uint64_t(0xD2511F53) * ctr[0];
+            const uint64_t p1 = uint64_t(0xCD9E8D57) * ctr[2];
+            const uint32_t c0 = uint32_t(p1 >> 32) ^ ctr[1] ^ k[0];
+            const uint32_t c2 = uint32_t(p0 >> 32) ^ ctr[3] ^ k[1];
+            ctr[1] = uint32_t(p1);
+            ctr[3] = uint32_t(p0);
+            ctr[0] = c0;
+            ctr[2] = c2;
+            k[0] += 0x9E3779B9;
+            k[1] += 0xBB67AE85;
+        }
+
+        return {ctr[0] | uint64_t(ctr[1]) << 32,
+                ctr[2] | uint64_t(ctr[3]) << 32};
+    }
+
+    uint64_t _key;
+    uint64_t _stream;
+    uint64_t _counter;
+    Block block;
+    unsigned pos;
+};
+
+/**
+ * A stream of random numbers, with the same interface as Random, for
+ * the exclusive use of one object.
+ *
+ * Streams are identified by a name, usually the one of the SimObject
+ * using it, and derived from a global seed. The numbers an object draws
+ * therefore don't depend on what other objects do, in which order they
+ * are simulated, or on how many event queues and threads the simulation
+ * uses, and streams never contend on shared state.
+ */
+class RandomStream : public Serializable
+{
+  public:
+    Philox gen;
+
+    /**
+     * @ingroup api_base_utils
+     * @{
+     */
+    RandomStream(uint64_t stream);
+    RandomStream(const std::string &name);
+    /** @} */ // end of api_base_utils
+
+    /**
+     * Seed used by streams created from now on, 5489 by default as for
+     * random_mt.
+     */
+    static void setGlobalSeed(uint64_t seed);
+
+    template <typename T>
+    typename std::enable_if_t<std::is_integral_v<T>, T>
+    random()
+    {
+        // [0, max_value] for integer types
+        std::uniform_int_distribution<T> dist;
+        return dist(gen);
+    }
+
+    template <typename T>
+    typename std::enable_if_t<std::is_floating_point_v<T>, T>
+    random()
+    {
+        // [0, 1) for real types
+        std::uniform_real_distribution<T> dist;
+        return dist(gen);
+    }
+
+    template <typename T>
+    typename std::enable_if_t<std::is_integral_v<T>, T>
+    random(T min, T max)
+    {
+        std::uniform_int_distribution<T> dist(min, max);
+        return dist(gen);
+    }
+
+    /**
+     * Fill a buffer with random numbers, for users which need many of
+     * them at once.
+     *
+     * @param buf Buffer to fill.
+     * @param n Number of values to generate.
+     */
+    void fill(uint64_t *buf, size_t n) { gen.fill(buf, n); }
+
+    template <typename T>
+    typename std::enable_if_t<std::is_integral_v<T>>
+    fill(T *buf, size_t n, T min, T max)
+    {
+        std::uniform_int_distribution<T> dist(min, max);
+        for (size_t i = 0; i < n; i++)
+            buf[i] = dist(gen);
+    }
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+};
+
 } // namespace gem5
 
 #endif // __BASE_RANDOM_HH__
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "base/random.hh"
+
+using namespace gem5;
+
+/** Known answer test from the Random123 distribution */
+TEST(PhiloxTest, KnownAnswer)
+{
+    Philox gen(0, 0);
+    EXPECT_EQ(gen(), 0xe169c58d6627e8d5ULL);
+    EXPECT_EQ(gen(), 0x9b00dbd8bc57ac4cULL);
+}
+
+TEST(PhiloxTest, DiscardAndFill)
+{
+    Philox ref(42, 7);
+    std::vector<uint64_t> values(37);
+    for (auto &v: values)
+        v = ref();
+
+    for (unsigned skip = 0; skip < 10; skip++) {
+        Philox gen(42, 7);
+        gen.discard(skip);
+        EXPECT_EQ(gen.position(), skip);
+        EXPECT_EQ(gen(), values[skip]);
+    }
+
+    // Fill from an odd position, so that the buffered value is used
+    Philox gen(42, 7);
+    gen();
+    std::vector<uint64_t> buf(30);
+    gen.fill(buf.data(), buf.size());
+    for (size_t i = 0; i < buf.size(); i++)
+        EXPECT_EQ(buf[i], values[i + 1]);
+    EXPECT_EQ(gen(), values[31]);
+
+    gen.setPosition(5);
+    EXPECT_EQ(gen(), values[5]);
+}
+
+TEST(RandomStreamTest, Streams)
+{
+    RandomStream a("system.cpu0"), b("system.cpu0"), c("system.cpu1");
+    EXPECT_EQ(a.gen.stream(), b.gen.stream());
+    EXPECT_NE(a.gen.stream(), c.gen.stream());
+
+    const auto first = a.random<uint64_t>();
+    EXPECT_EQ(first, b.random<uint64_t>());
+    EXPECT_NE(first, c.random<uint64_t>());
+
+    for (int i = 0; i < 100; i++) {
+        const int v = a.random(-3, 3);
+        EXPECT_GE(v, -3);
+        EXPECT_LE(v, 3);
+        const double d = a.random<double>();
+        EXPECT_GE(d, 0.0);
+        EXPECT_LT(d, 1.0);
+    }
+
+    unsigned buf[16];
+    a.fill(buf, 16, 10u, 20u);
+    for (unsigned v: buf) {
+        EXPECT_GE(v, 10u);
+        EXPECT_LE(v, 20u);
+    }
+}
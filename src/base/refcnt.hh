@@ -41,6 +41,9 @@
 #ifndef __BASE_REFCNT_HH__
 #define __BASE_REFCNT_HH__
 
+#include <cstddef>
+#include <functional>
+#include <limits>
 #include <type_traits>
 
 /**
@@ -105,6 +108,12 @@ class RefCounted
         if (--count <= 0)
             delete this;
     }
+
+    /// Keep the object alive for good, whatever happens to its count
+    /// from now on. Pointers to objects shared by several threads may
+    /// lose updates of the count, as they aren't atomic, and pinning
+    /// stops such an object from being deleted while it is still used.
+    void pin() const { count = std::numeric_limits<int>::max() / 2; }
 };
 
 /**
@@ -140,6 +149,8 @@ class RefCountingPtr
             RefCountingPtr<typename std::remove_const<T>::type>,
             RefCountingPtr<T>>;
     friend NonConstT;
+    template <class U>
+    friend class RefCountingPtr;
     /** @} */
     /// The stored pointer.
     /// Arguably this should be private.
@@ -210,6 +221,24 @@ class RefCountingPtr
     template <bool B = TisConst>
     RefCountingPtr(const NonConstT &r) { copy(r.data); }
 
+    /// Create a new reference counting pointer to a base class of the
+    /// object another one points to.  Adds a reference.
+    template <class U, typename = std::enable_if_t<
+        !std::is_same_v<std::remove_const_t<U>, std::remove_const_t<T>> &&
+        std::is_convertible_v<U *, T *>>>
+    RefCountingPtr(const RefCountingPtr<U> &r) { copy(r.data); }
+
+    /// Move a reference counting pointer to a derived class into a
+    /// pointer to its base class, without touching the reference count.
+    template <class U, typename = std::enable_if_t<
+        !std::is_same_v<std::remove_const_t<U>, std::remove_const_t<T>> &&
+        std::is_convertible_v<U *, T *>>>
+    RefCountingPtr(RefCountingPtr<U> &&r)
+    {
+        data = r.data;
+        r.data = nullptr;
+    }
+
     /// Destroy the pointer and any reference it may hold.
     ~RefCountingPtr() { del(); }
 
@@ -255,6 +284,9 @@ class RefCountingPtr
         return *this;
     }
 
+    /// Drop the reference held by this pointer, if any
+    void reset() { set(nullptr); }
+
     /// Check if the pointer is empty
     bool operator!() const { return data == 0; }
 
@@ -314,6 +346,54 @@ operator!=(const T *l, const RefCountingPtr<T> &r)
     return l != r.get();
 }
 
+/// Check if a reference counting pointer is empty
+template<class T>
+inline bool
+operator==(const RefCountingPtr<T> &l, std::nullptr_t)
+{
+    return !l;
+}
+
+/// Check if a reference counting pointer is empty
+template<class T>
+inline bool
+operator==(std::nullptr_t, const RefCountingPtr<T> &r)
+{
+    return !r;
+}
+
+/// Check if a reference counting pointer is non-empty
+template<class T>
+inline bool
+operator!=(const RefCountingPtr<T> &l, std::nullptr_t)
+{
+    return (bool)l;
+}
+
+/// Check if a reference counting pointer is non-empty
+template<class T>
+inline bool
+operator!=(std::nullptr_t, const RefCountingPtr<T> &r)
+{
+    return (bool)r;
+}
+
 } // namespace gem5
 
+namespace std
+{
+
+/// Hash reference counting pointers by the address they point to
+template <class T>
+struct hash<gem5::RefCountingPtr<T>>
+{
+    size_t
+    operator()(const gem5::RefCountingPtr<T> &p) const
+    {
+        return hash<T *>()(p.get());
+    }
+};
+
+} // namespace std
+
 #endif // __BASE_REFCNT_HH__
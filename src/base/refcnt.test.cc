@@ -31,6 +31,7 @@
 
 #include <gtest/gtest.h>
 
+#include <functional>
 #include <list>
 
 #include "base/refcnt.hh"
@@ -70,6 +71,11 @@ class TestRC : public RefCounted
 };
 typedef RefCountingPtr<TestRC> Ptr;
 
+class DerivedTestRC : public TestRC
+{
+};
+typedef RefCountingPtr<DerivedTestRC> DerivedPtr;
+
 } // anonymous namespace
 
 TEST(RefcntTest, NullPointerCheck)
@@ -172,3 +178,73 @@ TEST(RefcntTest, EqualityOperators)
     EXPECT_TRUE(equalTestAPtr != equalTestB);
     EXPECT_TRUE(equalTestAPtr != equalTestBPtr);
 }
+
+TEST(RefcntTest, NullptrComparison)
+{
+    // Compare empty and non-empty Ptrs against nullptr.
+    Ptr nullTest;
+    Ptr nonNullTest = new TestRC();
+    EXPECT_TRUE(nullTest == nullptr);
+    EXPECT_TRUE(nullptr == nullTest);
+    EXPECT_TRUE(nonNullTest != nullptr);
+    EXPECT_TRUE(nullptr != nonNullTest);
+    EXPECT_FALSE(nonNullTest == nullptr);
+}
+
+TEST(RefcntTest, Reset)
+{
+    // Resetting a Ptr drops its reference.
+    Ptr resetTest = new TestRC();
+    EXPECT_EQ(1, liveListSize());
+    resetTest.reset();
+    EXPECT_EQ(NULL, resetTest.get());
+    EXPECT_EQ(0, liveListSize());
+}
+
+TEST(RefcntTest, Hash)
+{
+    // Ptrs to the same object hash to the same value as the raw pointer.
+    TestRC *hashTest = new TestRC();
+    Ptr hashTestPtr = hashTest;
+    Ptr hashTestPtr2 = hashTest;
+    std::hash<Ptr> hasher;
+    EXPECT_EQ(hasher(hashTestPtr), hasher(hashTestPtr2));
+    EXPECT_EQ(hasher(hashTestPtr), std::hash<TestRC *>()(hashTest));
+}
+
+TEST(RefcntTest, ConversionToBase)
+{
+    // Copying and moving a pointer to a derived class into a pointer to
+    // its base class keeps the object alive until both are gone.
+    DerivedPtr derivedPtr = new DerivedTestRC();
+    Ptr copyPtr = derivedPtr;
+    EXPECT_EQ(1, liveListSize());
+    EXPECT_EQ(derivedPtr.get(), copyPtr.get());
+    derivedPtr = nullptr;
+    EXPECT_EQ(1, liveListSize());
+    copyPtr = nullptr;
+    EXPECT_EQ(0, liveListSize());
+
+    derivedPtr = new DerivedTestRC();
+    DerivedTestRC *derived = derivedPtr.get();
+    Ptr movePtr = std::move(derivedPtr);
+    EXPECT_EQ(NULL, derivedPtr.get());
+    EXPECT_EQ(derived, movePtr.get());
+    EXPECT_EQ(1, liveListSize());
+    movePtr = nullptr;
+    EXPECT_EQ(0, liveListSize());
+}
+
+TEST(RefcntTest, Pin)
+{
+    // A pinned object outlives all the pointers to it.
+    TestRC *pinned = new TestRC();
+    Ptr pinnedPtr = pinned;
+    pinned->pin();
+    Ptr copyPtr = pinnedPtr;
+    pinnedPtr = nullptr;
+    copyPtr = nullptr;
+    EXPECT_EQ(1, liveListSize());
+    delete pinned;
+    EXPECT_EQ(0, liveListSize());
+}
@@ -112,6 +112,8 @@ class InfoProxy : public Base
         visitor.visit(*static_cast<Base *>(this));
     }
     bool zero() const { return s.zero(); }
+    bool dirty() const { return s.dirty(); }
+    void clean() { s.clean(); }
 };
 
 template <class Stat>
@@ -215,6 +217,17 @@ class InfoAccess
      */
     bool zero() const { return true; }
 
+    /**
+     * @return true if this stat may have changed since it was last
+     * cleaned
+     */
+    bool dirty() const { return true; }
+
+    /**
+     * Mark the stat as unchanged.
+     */
+    void clean() { }
+
     /**
      * Check that this stat has been set up properly and is ready for
      * use
@@ -231,6 +244,7 @@ class DataWrap : public InfoAccess
 
   protected:
     Derived &self() { return *static_cast<Derived *>(this); }
+    const Derived &self() const { return *static_cast<const Derived *>(this); }
 
   protected:
     Info *
@@ -455,6 +469,28 @@ class DataWrapVec : public DataWrap<Derived, InfoProxyType>
         for (off_type i = 0; i < size; ++i)
             self.data(i)->reset(info->getStorageParams());
     }
+
+    bool
+    dirty() const
+    {
+        const Derived &self = this->self();
+
+        size_t size = self.size();
+        for (off_type i = 0; i < size; ++i)
+            if (self.data(i)->dirty())
+                return true;
+        return false;
+    }
+
+    void
+    clean()
+    {
+        Derived &self = this->self();
+
+        size_t size = self.size();
+        for (off_type i = 0; i < size; ++i)
+            self.data(i)->clean();
+    }
 };
 
 template <class Derived, template <class> class InfoProxyType>
@@ -625,6 +661,8 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
     Result total() const { return result(); }
 
     bool zero() const { return result() == 0.0; }
+    bool dirty() const { return data()->dirty(); }
+    void clean() { data()->clean(); }
 
     void reset() { data()->reset(this->info()->getStorageParams()); }
     void prepare() { data()->prepare(this->info()->getStorageParams()); }
@@ -930,8 +968,11 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
     friend class DataWrapVec<Derived, VectorInfoProxy>;
 
   protected:
-    /** The storage of this stat. */
-    std::vector<Storage*> storage;
+    /**
+     * The storage of this stat. The elements are kept contiguous so
+     * that evaluating and resetting the vector walks a single array.
+     */
+    std::vector<Storage> storage;
 
   protected:
     /**
@@ -939,14 +980,14 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
      * @param index The vector index to access.
      * @return The storage object at the given index.
      */
-    Storage *data(off_type index) { return storage[index]; }
+    Storage *data(off_type index) { return &storage[index]; }
 
     /**
      * Retrieve a const pointer to the storage.
      * @param index The vector index to access.
      * @return A const pointer to the storage object at the given index.
      */
-    const Storage *data(off_type index) const { return storage[index]; }
+    const Storage *data(off_type index) const { return &storage[index]; }
 
     void
     doInit(size_type s)
@@ -956,7 +997,7 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
 
         storage.reserve(s);
         for (size_type i = 0; i < s; ++i)
-            storage.push_back(new Storage(this->info()->getStorageParams()));
+            storage.emplace_back(this->info()->getStorageParams());
 
         this->setInit();
     }
@@ -965,9 +1006,10 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
     void
     value(VCounter &vec) const
     {
-        vec.resize(size());
-        for (off_type i = 0; i < size(); ++i)
-            vec[i] = data(i)->value();
+        const size_type size = this->size();
+        vec.resize(size);
+        for (off_type i = 0; i < size; ++i)
+            vec[i] = storage[i].value();
     }
 
     /**
@@ -977,9 +1019,10 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
     void
     result(VResult &vec) const
     {
-        vec.resize(size());
-        for (off_type i = 0; i < size(); ++i)
-            vec[i] = data(i)->result();
+        const size_type size = this->size();
+        vec.resize(size);
+        for (off_type i = 0; i < size; ++i)
+            vec[i] = storage[i].result();
     }
 
     /**
@@ -990,8 +1033,8 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
     total() const
     {
         Result total = 0.0;
-        for (off_type i = 0; i < size(); ++i)
-            total += data(i)->result();
+        for (const auto &stor : storage)
+            total += stor.result();
         return total;
     }
 
@@ -1023,13 +1066,6 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
           storage()
     {}
 
-    ~VectorBase()
-    {
-        for (auto& stor : storage) {
-            delete stor;
-        }
-    }
-
     /**
      * Set this vector to have the given size.
      * @param size The new size.
@@ -1085,9 +1121,9 @@ class VectorProxy
     const VResult &
     result() const
     {
-        vec.resize(size());
+        vec.resize(len);
 
-        for (off_type i = 0; i < size(); ++i)
+        for (off_type i = 0; i < len; ++i)
             vec[i] = data(i)->result();
 
         return vec;
@@ -1097,7 +1133,7 @@ class VectorProxy
     total() const
     {
         Result total = 0.0;
-        for (off_type i = 0; i < size(); ++i)
+        for (off_type i = 0; i < len; ++i)
             total += data(i)->result();
         return total;
     }
@@ -1148,11 +1184,12 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
   protected:
     size_type x;
     size_type y;
-    std::vector<Storage*> storage;
+    /** The storage of this stat, row-major and contiguous. */
+    std::vector<Storage> storage;
 
   protected:
-    Storage *data(off_type index) { return storage[index]; }
-    const Storage *data(off_type index) const { return storage[index]; }
+    Storage *data(off_type index) { return &storage[index]; }
+    const Storage *data(off_type index) const { return &storage[index]; }
 
   public:
     Vector2dBase(Group *parent, const char *name,
@@ -1162,13 +1199,6 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
           x(0), y(0), storage()
     {}
 
-    ~Vector2dBase()
-    {
-        for (auto& stor : storage) {
-            delete stor;
-        }
-    }
-
     Derived &
     init(size_type _x, size_type _y)
     {
@@ -1185,7 +1215,7 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
 
         storage.reserve(x * y);
         for (size_type i = 0; i < x * y; ++i)
-            storage.push_back(new Storage(this->info()->getStorageParams()));
+            storage.emplace_back(this->info()->getStorageParams());
 
         this->setInit();
 
@@ -1221,8 +1251,8 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
     total() const
     {
         Result total = 0.0;
-        for (off_type i = 0; i < size(); ++i)
-            total += data(i)->result();
+        for (const auto &stor : storage)
+            total += stor.result();
         return total;
     }
 
@@ -1336,6 +1366,8 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
      * @return True if there haven't been any samples.
      */
     bool zero() const { return data()->zero(); }
+    bool dirty() const { return data()->dirty(); }
+    void clean() { data()->clean(); }
 
     void
     prepare()
@@ -1374,19 +1406,19 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
     friend class DataWrapVec<Derived, VectorDistInfoProxy>;
 
   protected:
-    std::vector<Storage*> storage;
+    std::vector<Storage> storage;
 
   protected:
     Storage *
     data(off_type index)
     {
-        return storage[index];
+        return &storage[index];
     }
 
     const Storage *
     data(off_type index) const
     {
-        return storage[index];
+        return &storage[index];
     }
 
     void
@@ -1397,7 +1429,7 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
 
         storage.reserve(s);
         for (size_type i = 0; i < s; ++i)
-            storage.push_back(new Storage(this->info()->getStorageParams()));
+            storage.emplace_back(this->info()->getStorageParams());
 
         this->setInit();
     }
@@ -1410,13 +1442,6 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
           storage()
     {}
 
-    ~VectorDistBase()
-    {
-        for (auto& stor : storage) {
-            delete stor;
-        }
-    }
-
     Proxy operator[](off_type index)
     {
         assert(index < size());
@@ -1748,8 +1773,8 @@ class UnaryNode : public Node
     {
         const VResult &vec = this->result();
         Result total = 0.0;
-        for (off_type i = 0; i < size(); i++)
-            total += vec[i];
+        for (const auto &v : vec)
+            total += v;
         return total;
     }
 
@@ -1808,7 +1833,6 @@ class BinaryNode : public Node
     Result
     total() const override
     {
-        const VResult &vec = this->result();
         const VResult &lvec = l->result();
         const VResult &rvec = r->result();
         Result total = 0.0;
@@ -1822,16 +1846,28 @@ class BinaryNode : public Node
 
         /** If vectors are the same divide their sums (x0+x1)/(y0+y1) */
         if (lvec.size() == rvec.size() && lvec.size() > 1) {
-            for (off_type i = 0; i < size(); ++i) {
+            const size_type size = lvec.size();
+            for (off_type i = 0; i < size; ++i) {
                 lsum += lvec[i];
                 rsum += rvec[i];
             }
             return op(lsum, rsum);
         }
 
-        /** Otherwise divide each item by the divisor */
-        for (off_type i = 0; i < size(); ++i) {
-            total += vec[i];
+        /**
+         * Otherwise divide each item by the divisor. The operands have
+         * already been evaluated, so apply the operator directly rather
+         * than walking the subtrees a second time through result().
+         */
+        if (lvec.size() == 1 && rvec.size() == 1)
+            return op(lvec[0], rvec[0]);
+
+        if (lvec.size() == 1) {
+            for (const auto &v : rvec)
+                total += op(lvec[0], v);
+        } else {
+            for (const auto &v : lvec)
+                total += op(v, rvec[0]);
         }
 
         return total;
@@ -2473,6 +2509,8 @@ class SparseHistBase : public DataWrap<Derived, SparseHistInfoProxy>
      * @return True if there haven't been any samples.
      */
     bool zero() const { return data()->zero(); }
+    bool dirty() const { return data()->dirty(); }
+    void clean() { data()->clean(); }
 
     void
     prepare()
@@ -2614,6 +2652,13 @@ class Formula : public DataWrapVec<Formula, FormulaInfoProxy>
 
     void prepare() { }
 
+    /**
+     * Formulas are evaluated when they are output, they can't tell
+     * whether their operands changed.
+     */
+    bool dirty() const { return true; }
+    void clean() { }
+
     /**
      * Formulas don't need to be reset
      */
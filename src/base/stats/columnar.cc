@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/columnar.hh"
+
+#include <cstring>
+#include <limits>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/stats/info.hh"
+#include "base/stats/units.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+constexpr char Magic[8] = {'g', 'e', 'm', '5', 'c', 'o', 'l', 's'};
+constexpr uint32_t Version = 1;
+constexpr uint32_t NoColumn = std::numeric_limits<uint32_t>::max();
+
+template <typename T>
+void
+writeValue(std::ostream &os, const T &value)
+{
+    os.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void
+writeString(std::ostream &os, const std::string &str)
+{
+    os << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\')
+            os << '\\' << c;
+        else if (c >= ' ')
+            os << c;
+    }
+    os << '"';
+}
+
+/** Name of element i of a stat, using its subname if it has one. */
+std::string
+subname(const std::vector<std::string> &subnames, size_type i)
+{
+    if (i < subnames.size() && !subnames[i].empty())
+        return subnames[i];
+    return std::to_string(i);
+}
+
+} // anonymous namespace
+
+Columnar::Columnar(const std::string &file, bool desc, bool formulas,
+                   Encoding encoding)
+    : fname(file), enableDescriptions(desc), enableFormula(formulas),
+      encoding(encoding), cursor(0), dumpCount(0)
+{
+    data.open(fname, std::ios::out | std::ios::trunc | std::ios::binary);
+    fatal_if(!data, "Can't open stats file '%s'\n", fname);
+
+    data.write(Magic, sizeof(Magic));
+    writeValue(data, Version);
+    writeValue(data, static_cast<uint32_t>(encoding));
+}
+
+Columnar::~Columnar()
+{
+}
+
+void
+Columnar::begin()
+{
+    // Stats that aren't visited keep their previous values.
+    record = previous;
+}
+
+void
+Columnar::end()
+{
+    assert(valid());
+
+    if (dumpCount == 0) {
+        writeSchema();
+        previous.assign(columns.size(), 0.0);
+    }
+
+    writeRecord();
+    previous = record;
+    data.flush();
+
+    dumpCount++;
+}
+
+bool
+Columnar::valid() const
+{
+    return data.good();
+}
+
+bool
+Columnar::onlyChanged() const
+{
+    // The layout is discovered by the first dump, which has to see
+    // every stat.
+    return encoding == Encoding::Delta && dumpCount > 0;
+}
+
+void
+Columnar::beginGroup(const char *name)
+{
+    if (path.empty())
+        path.push(name);
+    else
+        path.push(csprintf("%s.%s", path.top(), name));
+}
+
+void
+Columnar::endGroup()
+{
+    assert(!path.empty());
+    path.pop();
+}
+
+bool
+Columnar::noOutput(const Info &info) const
+{
+    // Unlike the text output, prerequisites are ignored since the
+    // set of columns must not change between dumps.
+    return !info.flags.isSet(display);
+}
+
+void
+Columnar::seek(const Info &info)
+{
+    if (dumpCount == 0) {
+        if (firstColumn.size() <= static_cast<size_t>(info.id))
+            firstColumn.resize(info.id + 1, NoColumn);
+        firstColumn[info.id] = columns.size();
+        return;
+    }
+
+    fatal_if(static_cast<size_t>(info.id) >= firstColumn.size() ||
+             firstColumn[info.id] == NoColumn,
+             "Stat %s was not part of the first dump to '%s'\n",
+             info.name, fname);
+    cursor = firstColumn[info.id];
+}
+
+void
+Columnar::append(const Info &info, const std::string &suffix, Result value)
+{
+    if (dumpCount == 0) {
+        Column column;
+        column.name = path.empty() ? info.name :
+            csprintf("%s.%s", path.top(), info.name);
+        column.name += suffix;
+        if (enableDescriptions) {
+            column.unit = info.unit->getUnitString();
+            column.desc = info.desc;
+        }
+        columns.push_back(std::move(column));
+        record.push_back(value);
+        return;
+    }
+
+    fatal_if(cursor >= record.size(),
+             "Stat %s has more values than in the first dump to '%s'\n",
+             info.name, fname);
+    record[cursor++] = value;
+}
+
+void
+Columnar::appendDist(const Info &info, const std::string &prefix,
+                     const DistData &data)
+{
+    // The suffixes are only used by the first dump, so don't bother
+    // building them later on.
+    const bool first = dumpCount == 0;
+    auto suffix = [&](const char *field) {
+        return first ? prefix + info.separatorString + field : std::string();
+    };
+
+    append(info, suffix("samples"), data.samples);
+    append(info, suffix("sum"), data.sum);
+    append(info, suffix("squares"), data.squares);
+    append(info, suffix("min_value"), data.min_val);
+    append(info, suffix("max_value"), data.max_val);
+    append(info, suffix("underflows"), data.underflow);
+    append(info, suffix("overflows"), data.overflow);
+    for (size_type i = 0; i < data.cvec.size(); ++i) {
+        append(info, first ? csprintf("%s%sbucket%d", prefix,
+                                      info.separatorString, i) : "",
+               data.cvec[i]);
+    }
+}
+
+void
+Columnar::visit(const ScalarInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    seek(info);
+    append(info, "", info.result());
+}
+
+void
+Columnar::visit(const VectorInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    seek(info);
+    const VResult &vr = info.result();
+    for (size_type i = 0; i < vr.size(); ++i) {
+        append(info, dumpCount == 0 ?
+               info.separatorString + subname(info.subnames, i) : "",
+               vr[i]);
+    }
+}
+
+void
+Columnar::visit(const DistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    seek(info);
+    appendDist(info, "", info.data);
+}
+
+void
+Columnar::visit(const VectorDistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    seek(info);
+    for (size_type i = 0; i < info.size(); ++i) {
+        appendDist(info, dumpCount == 0 ?
+                   info.separatorString + subname(info.subnames, i) : "",
+                   info.data[i]);
+    }
+}
+
+void
+Columnar::visit(const Vector2dInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    seek(info);
+    for (size_type x = 0; x < info.x; ++x) {
+        for (size_type y = 0; y < info.y; ++y) {
+            append(info, dumpCount == 0 ?
+                   info.separatorString + subname(info.subnames, x) +
+                   info.separatorString + subname(info.y_subnames, y) : "",
+                   info.cvec[x * info.y + y]);
+        }
+    }
+}
+
+void
+Columnar::visit(const FormulaInfo &info)
+{
+    if (!enableFormula)
+        return;
+
+    visit(static_cast<const VectorInfo &>(info));
+}
+
+void
+Columnar::visit(const SparseHistInfo &info)
+{
+    warn_once("Columnar stat files don't support sparse histograms.\n");
+}
+
+void
+Columnar::writeSchema()
+{
+    std::ofstream schema(fname + ".json", std::ios::out | std::ios::trunc);
+    fatal_if(!schema, "Can't open stats schema '%s.json'\n", fname);
+
+    schema << "{\n  \"version\": " << Version << ",\n  \"encoding\": "
+           << (encoding == Encoding::Dense ? "\"dense\"" : "\"delta\"")
+           << ",\n  \"columns\": [";
+    const char *sep = "\n";
+    for (const auto &column : columns) {
+        schema << sep << "    {\"name\": ";
+        writeString(schema, column.name);
+        if (enableDescriptions) {
+            schema << ", \"unit\": ";
+            writeString(schema, column.unit);
+            schema << ", \"desc\": ";
+            writeString(schema, column.desc);
+        }
+        schema << "}";
+        sep = ",\n";
+    }
+    schema << "\n  ]\n}\n";
+}
+
+void
+Columnar::writeRecord()
+{
+    writeValue(data, static_cast<uint64_t>(curTick()));
+
+    if (encoding == Encoding::Dense) {
+        data.write(reinterpret_cast<const char *>(record.data()),
+                   record.size() * sizeof(Result));
+        return;
+    }
+
+    // Only keep the columns whose bit pattern changed, which also
+    // catches changes to and from NaN.
+    std::vector<char> changes;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < record.size(); ++i) {
+        if (std::memcmp(&record[i], &previous[i], sizeof(Result)) == 0)
+            continue;
+
+        const size_t pos = changes.size();
+        changes.resize(pos + sizeof(i) + sizeof(Result));
+        std::memcpy(changes.data() + pos, &i, sizeof(i));
+        std::memcpy(changes.data() + pos + sizeof(i), &record[i],
+                    sizeof(Result));
+        count++;
+    }
+
+    writeValue(data, count);
+    data.write(changes.data(), changes.size());
+}
+
+std::unique_ptr<Output>
+initColumnar(const std::string &filename, bool desc, bool formulas,
+             bool delta)
+{
+    return std::unique_ptr<Output>(
+        new Columnar(simout.resolve(filename), desc, formulas,
+                     delta ? Columnar::Encoding::Delta :
+                     Columnar::Encoding::Dense));
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_COLUMNAR_HH__
+#define __BASE_STATS_COLUMNAR_HH__
+
+#include <fstream>
+#include <memory>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+/**
+ * Binary, column-oriented stat output for frequent periodic dumps.
+ *
+ * Every stat value is flattened into a numbered column. The column
+ * names, units and descriptions are written once, to a JSON schema
+ * next to the data file, when stats are first dumped. Every dump then
+ * only appends a record with the tick of the dump and the values.
+ *
+ * The data file starts with a 16 byte header (the magic "gem5cols",
+ * a 32-bit version and a 32-bit encoding) followed by one record per
+ * dump. All fields are in host byte order. With the dense encoding a
+ * record is a 64-bit tick followed by one double per column, so the
+ * file can be memory-mapped as a 2-d array. With the delta encoding a
+ * record is a 64-bit tick, a 32-bit count and the given number of
+ * packed (32-bit column, double value) pairs holding only the columns
+ * that changed since the previous dump. Columns that stay the same,
+ * including ones that stay zero, cost nothing. The delta encoding
+ * only asks for the stats that changed, so stats whose storage has
+ * not been touched since the previous dump are not even visited.
+ *
+ * util/columnar_stats.py reads both encodings.
+ */
+class Columnar : public Output
+{
+  public:
+    enum class Encoding : uint32_t
+    {
+        Dense = 0,
+        Delta = 1,
+    };
+
+    Columnar(const std::string &file, bool desc, bool formulas,
+             Encoding encoding);
+    ~Columnar();
+
+    Columnar() = delete;
+    Columnar(const Columnar &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+    bool onlyChanged() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    struct Column
+    {
+        std::string name;
+        std::string unit;
+        std::string desc;
+    };
+
+    /** Should this stat be part of the output? */
+    bool noOutput(const Info &info) const;
+
+    /** Start storing the values of a stat at its first column. */
+    void seek(const Info &info);
+
+    /**
+     * Store the next value of the current stat. The column is only
+     * described while the first record is collected.
+     */
+    void append(const Info &info, const std::string &suffix, Result value);
+
+    /** Append the columns of one distribution. */
+    void appendDist(const Info &info, const std::string &prefix,
+                    const DistData &data);
+
+    void writeSchema();
+    void writeRecord();
+
+  protected:
+    const std::string fname;
+    const bool enableDescriptions;
+    const bool enableFormula;
+    const Encoding encoding;
+
+    std::ofstream data;
+    std::stack<std::string> path;
+
+    /** Column layout, only filled in by the first dump. */
+    std::vector<Column> columns;
+    /** First column of each stat, indexed by stat id. */
+    std::vector<uint32_t> firstColumn;
+    /** Values of the current dump. */
+    std::vector<Result> record;
+    /** Values of the previous dump. */
+    std::vector<Result> previous;
+    /** Column the next value of the current stat goes to. */
+    uint32_t cursor;
+
+    unsigned dumpCount;
+};
+
+std::unique_ptr<Output> initColumnar(const std::string &filename,
+                                     bool desc=true, bool formulas=true,
+                                     bool delta=false);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_COLUMNAR_HH__
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/stats/columnar.hh"
+#include "base/stats/info.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+GTestTickHandler tickHandler;
+
+class TestScalarInfo : public statistics::ScalarInfo
+{
+  public:
+    statistics::Result val = 0;
+
+    TestScalarInfo(const std::string &name)
+    {
+        setName(name, false);
+        flags.set(statistics::display);
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return val == 0; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+
+    statistics::Counter value() const override { return val; }
+    statistics::Result result() const override { return val; }
+    statistics::Result total() const override { return val; }
+};
+
+class TestVectorInfo : public statistics::VectorInfo
+{
+  public:
+    statistics::VCounter vals;
+    statistics::VResult results;
+
+    TestVectorInfo(const std::string &name, size_t size)
+        : vals(size, 0), results(size, 0)
+    {
+        setName(name, false);
+        subnames = {"a", ""};
+        flags.set(statistics::display);
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+
+    statistics::size_type size() const override { return vals.size(); }
+    const statistics::VCounter &value() const override { return vals; }
+    const statistics::VResult &result() const override { return results; }
+    statistics::Result total() const override { return 0; }
+};
+
+class StatsColumnarTest : public ::testing::Test
+{
+  protected:
+    char filename[20] = "columnar-XXXXXX";
+    TestScalarInfo scalar{"scalar"};
+    TestVectorInfo vector{"vector", 3};
+
+    void
+    SetUp() override
+    {
+        int fd = mkstemp(filename);
+        ASSERT_NE(-1, fd);
+        close(fd);
+        tickHandler.setCurTick(0);
+    }
+
+    void
+    TearDown() override
+    {
+        unlink(filename);
+        unlink((std::string(filename) + ".json").c_str());
+    }
+
+    void
+    dump(statistics::Output &output, Tick when)
+    {
+        tickHandler.setCurTick(when);
+        output.begin();
+        output.beginGroup("system");
+        scalar.visit(output);
+        output.endGroup();
+        vector.visit(output);
+        output.end();
+    }
+
+    std::vector<char>
+    read(const std::string &name)
+    {
+        std::ifstream in(name, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in),
+                                 std::istreambuf_iterator<char>());
+    }
+
+    template <typename T>
+    static T
+    get(const std::vector<char> &buf, size_t &pos)
+    {
+        T value;
+        std::memcpy(&value, buf.data() + pos, sizeof(value));
+        pos += sizeof(value);
+        return value;
+    }
+};
+
+} // anonymous namespace
+
+/** The schema names every column once. */
+TEST_F(StatsColumnarTest, Schema)
+{
+    statistics::Columnar output(filename, true, true,
+                                statistics::Columnar::Encoding::Dense);
+    dump(output, 10);
+
+    std::vector<char> schema = read(std::string(filename) + ".json");
+    std::string text(schema.begin(), schema.end());
+    EXPECT_NE(std::string::npos, text.find("\"encoding\": \"dense\""));
+    EXPECT_NE(std::string::npos, text.find("\"name\": \"system.scalar\""));
+    EXPECT_NE(std::string::npos, text.find("\"name\": \"vector::a\""));
+    EXPECT_NE(std::string::npos, text.find("\"name\": \"vector::1\""));
+    EXPECT_NE(std::string::npos, text.find("\"name\": \"vector::2\""));
+}
+
+/** Dense records hold the tick and every value. */
+TEST_F(StatsColumnarTest, Dense)
+{
+    {
+        statistics::Columnar output(filename, false, true,
+                                    statistics::Columnar::Encoding::Dense);
+        scalar.val = 1;
+        vector.results = {2, 3, 4};
+        dump(output, 10);
+        scalar.val = 5;
+        dump(output, 20);
+    }
+
+    std::vector<char> buf = read(filename);
+    ASSERT_EQ(16 + 2 * (8 + 4 * 8), buf.size());
+    EXPECT_EQ(0, std::memcmp(buf.data(), "gem5cols", 8));
+
+    size_t pos = 16;
+    EXPECT_EQ(10, get<uint64_t>(buf, pos));
+    EXPECT_EQ(1, get<double>(buf, pos));
+    EXPECT_EQ(2, get<double>(buf, pos));
+    EXPECT_EQ(3, get<double>(buf, pos));
+    EXPECT_EQ(4, get<double>(buf, pos));
+    EXPECT_EQ(20, get<uint64_t>(buf, pos));
+    EXPECT_EQ(5, get<double>(buf, pos));
+}
+
+/** Delta records only hold the values that changed. */
+TEST_F(StatsColumnarTest, Delta)
+{
+    {
+        statistics::Columnar output(filename, false, true,
+                                    statistics::Columnar::Encoding::Delta);
+        scalar.val = 1;
+        dump(output, 10);
+        vector.results[2] = 7;
+        dump(output, 20);
+        dump(output, 30);
+    }
+
+    std::vector<char> buf = read(filename);
+    size_t pos = 12;
+    EXPECT_EQ(1, get<uint32_t>(buf, pos));
+
+    // Zero columns are left out of the first record.
+    EXPECT_EQ(10, get<uint64_t>(buf, pos));
+    ASSERT_EQ(1, get<uint32_t>(buf, pos));
+    EXPECT_EQ(0, get<uint32_t>(buf, pos));
+    EXPECT_EQ(1, get<double>(buf, pos));
+
+    EXPECT_EQ(20, get<uint64_t>(buf, pos));
+    ASSERT_EQ(1, get<uint32_t>(buf, pos));
+    EXPECT_EQ(3, get<uint32_t>(buf, pos));
+    EXPECT_EQ(7, get<double>(buf, pos));
+
+    EXPECT_EQ(30, get<uint64_t>(buf, pos));
+    EXPECT_EQ(0, get<uint32_t>(buf, pos));
+    EXPECT_EQ(buf.size(), pos);
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_DEFERRED_HH__
+#define __BASE_STATS_DEFERRED_HH__
+
+#include <cassert>
+#include <functional>
+#include <vector>
+
+#include "base/stats/group.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+/**
+ * A dense block of counters that are folded into stats when the stats are
+ * dumped, for stats incremented on hot paths.
+ *
+ * Each counter (slot) is bound to a scalar stat or to an element of a
+ * vector stat. Incrementing a slot only touches the block, and the pending
+ * counts are added to the stats by preDumpStats(). Resetting the stats
+ * discards the pending counts. The block is merged into its parent group,
+ * so this happens whenever the parent's stats are dumped or reset.
+ *
+ * The stats bound to a block don't include the pending counts until the
+ * next dump, so only stats which aren't read by the model itself should
+ * be bound to one.
+ *
+ * \code
+ * struct MyStats : public statistics::Group
+ * {
+ *     statistics::Vector hits;
+ *     statistics::DeferredCounters counters;
+ *     statistics::DeferredCounters::Slot hitsSlot;
+ *
+ *     void regStats() override
+ *     {
+ *         statistics::Group::regStats();
+ *         hits.init(numRequestors);
+ *         hitsSlot = counters.addVector(hits);
+ *     }
+ * };
+ *
+ * counters.inc(hitsSlot + requestor_id);
+ * \endcode
+ */
+class DeferredCounters : public Group
+{
+  public:
+    typedef size_type Slot;
+
+  private:
+    std::vector<Counter> counters;
+    /** Adds the count of each slot to the stat it is bound to */
+    std::vector<std::function<void(Counter)>> folds;
+
+    Slot
+    addFold(std::function<void(Counter)> fold)
+    {
+        counters.push_back(Counter());
+        folds.push_back(std::move(fold));
+        return counters.size() - 1;
+    }
+
+  public:
+    DeferredCounters(Group *parent) : Group(parent) {}
+
+    /** Bind a new slot to a scalar stat */
+    template <class Stat>
+    Slot
+    add(Stat &stat)
+    {
+        return addFold([&stat](Counter count) { stat += count; });
+    }
+
+    /** Bind a new slot to an element of a vector stat */
+    template <class Stat>
+    Slot
+    add(Stat &stat, off_type index)
+    {
+        return addFold([&stat, index](Counter count)
+                { stat[index] += count; });
+    }
+
+    /**
+     * Bind a new slot to each element of an initialized vector stat.
+     *
+     * @return The slot of the first element, the others follow it.
+     */
+    template <class Stat>
+    Slot
+    addVector(Stat &stat)
+    {
+        const Slot first = counters.size();
+        for (off_type i = 0; i < stat.size(); ++i)
+            add(stat, i);
+        return first;
+    }
+
+    size_type size() const { return counters.size(); }
+
+    void
+    inc(Slot slot, Counter count = 1)
+    {
+        assert(slot < counters.size());
+        counters[slot] += count;
+    }
+
+    /** The count of a slot not yet added to its stat */
+    Counter
+    pending(Slot slot) const
+    {
+        assert(slot < counters.size());
+        return counters[slot];
+    }
+
+    /** Add the pending counts to the stats and clear them */
+    void flush();
+
+    void preDumpStats() override;
+    void resetStats() override;
+};
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_DEFERRED_HH__
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "base/stats/deferred.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Stand-ins for the scalar and vector stats the counters are folded to */
+struct FakeScalar
+{
+    statistics::Counter value = 0;
+
+    FakeScalar &
+    operator+=(statistics::Counter count)
+    {
+        value += count;
+        return *this;
+    }
+};
+
+struct FakeVector
+{
+    std::vector<FakeScalar> elements;
+
+    FakeVector(statistics::size_type size) : elements(size) {}
+
+    statistics::size_type size() const { return elements.size(); }
+    FakeScalar &operator[](statistics::off_type i) { return elements[i]; }
+};
+
+} // anonymous namespace
+
+/** Test that counts are only added to the stats when they are dumped */
+TEST(StatsDeferredCountersTest, FoldOnDump)
+{
+    statistics::Group group(nullptr);
+    statistics::DeferredCounters counters(&group);
+    FakeScalar scalar;
+    FakeVector vector(3);
+
+    const auto scalar_slot = counters.add(scalar);
+    const auto element_slot = counters.add(vector, 2);
+    const auto vector_slot = counters.addVector(vector);
+    ASSERT_EQ(counters.size(), 5);
+
+    counters.inc(scalar_slot);
+    counters.inc(scalar_slot, 4);
+    counters.inc(element_slot, 2);
+    counters.inc(vector_slot + 2, 3);
+    counters.inc(vector_slot);
+    ASSERT_EQ(counters.pending(scalar_slot), 5);
+    ASSERT_EQ(scalar.value, 0);
+    ASSERT_EQ(vector[2].value, 0);
+
+    group.preDumpStats();
+    ASSERT_EQ(scalar.value, 5);
+    ASSERT_EQ(vector[0].value, 1);
+    ASSERT_EQ(vector[1].value, 0);
+    ASSERT_EQ(vector[2].value, 5);
+    ASSERT_EQ(counters.pending(scalar_slot), 0);
+
+    // Counts are not added twice
+    counters.inc(scalar_slot);
+    group.preDumpStats();
+    ASSERT_EQ(scalar.value, 6);
+    ASSERT_EQ(vector[2].value, 5);
+}
+
+/** Test that resetting the stats discards the pending counts */
+TEST(StatsDeferredCountersTest, DiscardOnReset)
+{
+    statistics::Group group(nullptr);
+    statistics::DeferredCounters counters(&group);
+    FakeScalar scalar;
+
+    const auto slot = counters.add(scalar);
+    counters.inc(slot, 7);
+    group.resetStats();
+    ASSERT_EQ(counters.pending(slot), 0);
+
+    group.preDumpStats();
+    ASSERT_EQ(scalar.value, 0);
+}
@@ -41,6 +41,7 @@
 #include "base/logging.hh"
 #include "base/named.hh"
 #include "base/stats/info.hh"
+#include "base/stats/output.hh"
 #include "base/trace.hh"
 #include "debug/Stats.hh"
 
@@ -88,6 +89,9 @@ Group::resetStats()
     for (auto &s : stats)
         s->reset();
 
+    for (auto &s : filteredStats)
+        s->reset();
+
     for (auto &g : mergedStatGroups)
         g->resetStats();
 
@@ -105,6 +109,60 @@ Group::preDumpStats()
         g.second->preDumpStats();
 }
 
+void
+Group::prepareStats()
+{
+    for (auto &s : stats)
+        s->prepare();
+
+    for (auto &g : statGroups)
+        g.second->prepareStats();
+}
+
+void
+Group::visitStats(Output &visitor)
+{
+    const bool only_changed = visitor.onlyChanged();
+    for (auto &s : stats) {
+        if (!only_changed || s->dirty())
+            s->visit(visitor);
+    }
+
+    for (auto &g : statGroups) {
+        visitor.beginGroup(g.first.c_str());
+        g.second->visitStats(visitor);
+        visitor.endGroup();
+    }
+}
+
+void
+Group::cleanStats()
+{
+    for (auto &s : stats)
+        s->clean();
+
+    for (auto &g : statGroups)
+        g.second->cleanStats();
+}
+
+void
+Group::filterStats(const std::function<bool(const std::string &)> &keep,
+                   const std::string &path)
+{
+    const std::string prefix = path.empty() ? "" : path + ".";
+    auto kept = stats.begin();
+    for (auto s = stats.begin(); s != stats.end(); ++s) {
+        if (keep(prefix + (*s)->name))
+            *kept++ = *s;
+        else
+            filteredStats.push_back(*s);
+    }
+    stats.erase(kept, stats.end());
+
+    for (auto &g : statGroups)
+        g.second->filterStats(keep, prefix + g.first);
+}
+
 void
 Group::addStat(statistics::Info *info)
 {
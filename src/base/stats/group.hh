@@ -38,6 +38,7 @@
 #ifndef __BASE_STATS_GROUP_HH__
 #define __BASE_STATS_GROUP_HH__
 
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -78,6 +79,7 @@ namespace statistics
 {
 
 class Info;
+struct Output;
 
 /**
  * Statistics container.
@@ -154,6 +156,32 @@ class Group
      */
     virtual void preDumpStats();
 
+    /**
+     * Prepare the stats in this group and all sub-groups for dumping.
+     *
+     * @ingroup api_stats
+     */
+    void prepareStats();
+
+    /**
+     * Visit the stats in this group and all sub-groups. Sub-groups
+     * are announced to the visitor using Output::beginGroup() and
+     * Output::endGroup(). If the visitor only asks for changed stats
+     * (Output::onlyChanged()), stats that haven't changed since the
+     * last call to cleanStats() are skipped.
+     *
+     * @ingroup api_stats
+     */
+    void visitStats(Output &visitor);
+
+    /**
+     * Mark the stats in this group and all sub-groups as unchanged.
+     * This is done once all outputs have seen a dump.
+     *
+     * @ingroup api_stats
+     */
+    void cleanStats();
+
     /**
      * Register a stat with this group. This method is normally called
      * automatically when a stat is instantiated.
@@ -211,6 +239,18 @@ class Group
      */
     void mergeStatGroup(Group *block);
 
+    /**
+     * Filter the stats in this group and all sub-groups by their full
+     * names. Stats that are filtered out are still reset with the other
+     * stats, since formulas may depend on them, but they are no longer
+     * prepared, visited or returned by getStats().
+     *
+     * @param keep Tells whether the stat with the given name is kept.
+     * @param path Name of this group, empty for the root of the hierarchy.
+     */
+    void filterStats(const std::function<bool(const std::string &)> &keep,
+                     const std::string &path = "");
+
   private:
     /** Parent pointer if merged into parent */
     Group *mergedParent;
@@ -218,6 +258,8 @@ class Group
     std::map<std::string, Group *> statGroups;
     std::vector<Group *> mergedStatGroups;
     std::vector<Info *> stats;
+    /** Stats removed by filterStats() */
+    std::vector<Info *> filteredStats;
 };
 
 } // namespace statistics
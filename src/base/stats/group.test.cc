@@ -29,6 +29,9 @@
 #include <gtest/gtest-spi.h>
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include "base/stats/group.hh"
 #include "base/stats/info.hh"
 #include "base/stats/output.hh"
@@ -485,6 +488,49 @@ TEST(StatsGroupTest, ResetStats)
     ASSERT_EQ(info5.value, 0);
 }
 
+/**
+ * Test that filtering stats matches them by their full names, and that the
+ * filtered stats are still reset.
+ */
+TEST(StatsGroupTest, FilterStats)
+{
+    statistics::Group root(nullptr);
+    statistics::Group node1(&root, "Node1");
+    statistics::Group node1_1(&node1, "Node1_1");
+
+    DummyInfo info;
+    info.setName("InfoFilterStats");
+    info.value = 1;
+    root.addStat(&info);
+
+    DummyInfo info2;
+    info2.setName("InfoFilterStats2");
+    info2.value = 2;
+    node1.addStat(&info2);
+
+    DummyInfo info3;
+    info3.setName("InfoFilterStats3");
+    info3.value = 3;
+    node1_1.addStat(&info3);
+
+    std::vector<std::string> names;
+    root.filterStats([&names](const std::string &name) {
+        names.push_back(name);
+        return name != "Node1.InfoFilterStats2";
+    });
+    ASSERT_EQ(names, std::vector<std::string>({"InfoFilterStats",
+                "Node1.InfoFilterStats2", "Node1.Node1_1.InfoFilterStats3"}));
+
+    ASSERT_EQ(root.getStats().size(), 1);
+    ASSERT_EQ(node1.getStats().size(), 0);
+    ASSERT_EQ(node1_1.getStats().size(), 1);
+
+    root.resetStats();
+    ASSERT_EQ(info.value, 0);
+    ASSERT_EQ(info2.value, 0);
+    ASSERT_EQ(info3.value, 0);
+}
+
 /**
  * Test that calling preDumpStats calls the respective function of all sub-
  * groups and merged groups.
@@ -657,3 +703,120 @@ TEST(StatsGroupTest, ResolveStatMergedSubGroup)
     ASSERT_NE(info_found, nullptr);
     ASSERT_EQ(info_found->name, "InfoResolveStatMergedSubGroup");
 }
+
+namespace
+{
+
+/** Info that counts how it is used by the group traversals. */
+class TrackedInfo : public DummyInfo
+{
+  public:
+    int prepared = 0;
+    int visited = 0;
+    bool isDirty = true;
+
+    void prepare() override { prepared++; }
+    bool dirty() const override { return isDirty; }
+    void clean() override { isDirty = false; }
+    void visit(statistics::Output &visitor) override { visited++; }
+};
+
+/** Output that records the groups it is told about. */
+class TrackingOutput : public statistics::Output
+{
+  public:
+    bool changed = false;
+    std::vector<std::string> groups;
+
+    void begin() override {}
+    void end() override {}
+    bool valid() const override { return true; }
+    bool onlyChanged() const override { return changed; }
+
+    void beginGroup(const char *name) override { groups.push_back(name); }
+    void endGroup() override { groups.push_back("end"); }
+
+    void visit(const statistics::ScalarInfo &info) override {}
+    void visit(const statistics::VectorInfo &info) override {}
+    void visit(const statistics::DistInfo &info) override {}
+    void visit(const statistics::VectorDistInfo &info) override {}
+    void visit(const statistics::Vector2dInfo &info) override {}
+    void visit(const statistics::FormulaInfo &info) override {}
+    void visit(const statistics::SparseHistInfo &info) override {}
+};
+
+} // anonymous namespace
+
+/** Test that prepareStats prepares the stats of all sub-groups. */
+TEST(StatsGroupTest, PrepareStats)
+{
+    statistics::Group root(nullptr);
+    statistics::Group node1(&root, "Node1");
+    statistics::Group node1_1(&node1);
+
+    TrackedInfo info;
+    info.setName("InfoPrepareStats");
+    root.addStat(&info);
+
+    TrackedInfo info2;
+    info2.setName("InfoPrepareStats2");
+    node1_1.addStat(&info2);
+
+    root.prepareStats();
+    ASSERT_EQ(info.prepared, 1);
+    ASSERT_EQ(info2.prepared, 1);
+}
+
+/** Test that visitStats visits all stats and announces all groups. */
+TEST(StatsGroupTest, VisitStats)
+{
+    statistics::Group root(nullptr);
+    statistics::Group node1(&root, "Node1");
+    statistics::Group node1_1(&node1, "Node1_1");
+
+    TrackedInfo info;
+    info.setName("InfoVisitStats");
+    root.addStat(&info);
+
+    TrackedInfo info2;
+    info2.setName("InfoVisitStats2");
+    node1_1.addStat(&info2);
+    info2.isDirty = false;
+
+    TrackingOutput output;
+    root.visitStats(output);
+    ASSERT_EQ(info.visited, 1);
+    ASSERT_EQ(info2.visited, 1);
+    ASSERT_EQ(output.groups, std::vector<std::string>(
+        {"Node1", "Node1_1", "end", "end"}));
+}
+
+/** Test that outputs can skip the stats that didn't change. */
+TEST(StatsGroupTest, VisitChangedStats)
+{
+    statistics::Group root(nullptr);
+    statistics::Group node1(&root, "Node1");
+
+    TrackedInfo info;
+    info.setName("InfoVisitChangedStats");
+    root.addStat(&info);
+
+    TrackedInfo info2;
+    info2.setName("InfoVisitChangedStats2");
+    node1.addStat(&info2);
+
+    TrackingOutput output;
+    output.changed = true;
+    root.visitStats(output);
+    ASSERT_EQ(info.visited, 1);
+    ASSERT_EQ(info2.visited, 1);
+
+    root.cleanStats();
+    ASSERT_FALSE(info.isDirty);
+    ASSERT_FALSE(info2.isDirty);
+
+    info2.isDirty = true;
+    root.visitStats(output);
+    ASSERT_EQ(info.visited, 1);
+    ASSERT_EQ(info2.visited, 2);
+}
@@ -156,6 +156,17 @@ class Info
      */
     virtual bool zero() const = 0;
 
+    /**
+     * @return true if the stat may have changed since it was last
+     * cleaned. Stats that can't tell always report true.
+     */
+    virtual bool dirty() const { return true; }
+
+    /**
+     * Mark the stat as unchanged, called after every dump.
+     */
+    virtual void clean() {}
+
     /**
      * Visitor entry for outputing statistics data
      */
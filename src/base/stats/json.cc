@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/json.hh"
+
+#include <charconv>
+#include <cmath>
+#include <ctime>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "base/stats/units.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+Json::Json(const std::string &file, unsigned indent)
+    : fname(file), indent(indent), finalTick(NAN), simTicks(NAN)
+{
+}
+
+void
+Json::begin()
+{
+    stream.open(fname, std::ios::out | std::ios::trunc);
+    fatal_if(!stream, "Can't open stats file '%s'\n", fname);
+
+    finalTick = NAN;
+    simTicks = NAN;
+
+    char created[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(created, sizeof(created), "%Y-%m-%dT%H:%M:%S",
+                  std::localtime(&now));
+
+    beginObject();
+    key("creation_time");
+    writeString(created);
+    key("time_conversion");
+    stream << "null";
+}
+
+void
+Json::end()
+{
+    assert(hasMembers.size() == 1);
+
+    // Like pystats, fall back to the current tick if the root stats
+    // weren't part of the dump.
+    const double end_time = std::isnan(finalTick) ? curTick() : finalTick;
+    key("simulated_begin_time");
+    if (std::isnan(simTicks))
+        stream << "null";
+    else
+        stream << (uint64_t)(end_time - simTicks);
+    key("simulated_end_time");
+    stream << (uint64_t)end_time;
+
+    endObject();
+    stream << "\n";
+    stream.close();
+}
+
+bool
+Json::valid() const
+{
+    return !stream.is_open() || stream.good();
+}
+
+void
+Json::newline()
+{
+    stream << "\n" << std::string(hasMembers.size() * indent, ' ');
+}
+
+void
+Json::key(const std::string &name)
+{
+    element();
+    writeString(name);
+    stream << ": ";
+}
+
+void
+Json::element()
+{
+    assert(!hasMembers.empty());
+    if (hasMembers.back())
+        stream << ",";
+    hasMembers.back() = true;
+    newline();
+}
+
+void
+Json::beginObject()
+{
+    stream << "{";
+    hasMembers.push_back(false);
+}
+
+void
+Json::endObject()
+{
+    assert(!hasMembers.empty());
+    const bool empty = !hasMembers.back();
+    hasMembers.pop_back();
+    if (!empty)
+        newline();
+    stream << "}";
+}
+
+void
+Json::beginGroup(const char *name)
+{
+    key(name);
+    beginObject();
+    key("type");
+    writeString("Group");
+    key("time_conversion");
+    stream << "null";
+}
+
+void
+Json::endGroup()
+{
+    assert(hasMembers.size() > 1);
+    endObject();
+}
+
+void
+Json::writeScalar(const std::string &name, Counter value, const Info &info,
+                  const std::string &desc)
+{
+    key(name);
+    beginObject();
+    key("value");
+    writeValue(value);
+    key("type");
+    writeString("Scalar");
+    key("unit");
+    writeString(info.unit->getUnitString());
+    key("description");
+    writeString(desc);
+    key("datatype");
+    writeString("f64");
+    endObject();
+}
+
+void
+Json::writeString(const std::string &str)
+{
+    stream << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\')
+            stream << '\\' << c;
+        else if ((unsigned char)c < ' ')
+            ccprintf(stream, "\\u%04x", (unsigned char)c);
+        else
+            stream << c;
+    }
+    stream << '"';
+}
+
+void
+Json::writeValue(double value)
+{
+    // Use the same spelling as Python's json module.
+    if (std::isnan(value)) {
+        stream << "NaN";
+    } else if (std::isinf(value)) {
+        stream << (value < 0 ? "-Infinity" : "Infinity");
+    } else {
+        char buf[32];
+        const auto res = std::to_chars(buf, buf + sizeof(buf), value);
+        const std::string_view str(buf, res.ptr - buf);
+        stream << str;
+        if (str.find_first_of(".e") == std::string_view::npos)
+            stream << ".0";
+    }
+}
+
+void
+Json::visit(const ScalarInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    if (hasMembers.size() == 1) {
+        if (info.name == "finalTick")
+            finalTick = info.value();
+        else if (info.name == "simTicks")
+            simTicks = info.value();
+    }
+
+    writeScalar(info.name, info.value(), info, info.desc);
+}
+
+void
+Json::visit(const VectorInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    key(info.name);
+    beginObject();
+    key("type");
+    writeString("Vector");
+    key("time_conversion");
+    stream << "null";
+
+    const VCounter &values = info.value();
+    for (size_type i = 0; i < values.size(); ++i) {
+        const bool named = i < info.subnames.size() &&
+            !info.subnames[i].empty();
+        writeScalar(named ? info.subnames[i] : std::to_string(i), values[i],
+                    info, i < info.subdescs.size() ? info.subdescs[i] : "");
+    }
+    endObject();
+}
+
+void
+Json::visit(const DistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const DistData &data = info.data;
+
+    key(info.name);
+    beginObject();
+    key("value");
+    stream << "[";
+    hasMembers.push_back(false);
+    for (Counter count : data.cvec) {
+        element();
+        writeValue(count);
+    }
+    const bool empty = !hasMembers.back();
+    hasMembers.pop_back();
+    if (!empty)
+        newline();
+    stream << "]";
+
+    key("type");
+    writeString("Distribution");
+    key("unit");
+    writeString(info.unit->getUnitString());
+    key("description");
+    writeString(info.desc);
+    key("datatype");
+    writeString("f64");
+    key("min");
+    writeValue(data.min_val);
+    key("max");
+    writeValue(data.max_val);
+    key("num_bins");
+    stream << data.cvec.size();
+    key("bin_size");
+    writeValue(data.bucket_size);
+    key("sum");
+    writeValue(data.sum);
+    key("underflow");
+    writeValue(data.underflow);
+    key("overflow");
+    writeValue(data.overflow);
+    key("logs");
+    writeValue(data.logs);
+    key("sum_squared");
+    writeValue(data.squares);
+    endObject();
+}
+
+void
+Json::visit(const VectorDistInfo &info)
+{
+}
+
+void
+Json::visit(const Vector2dInfo &info)
+{
+}
+
+void
+Json::visit(const FormulaInfo &info)
+{
+}
+
+void
+Json::visit(const SparseHistInfo &info)
+{
+}
+
+std::unique_ptr<Output>
+initJson(const std::string &filename, unsigned indent)
+{
+    return std::unique_ptr<Output>(new Json(filename, indent));
+}
+
+} // namespace statistics
+} // namespace gem5
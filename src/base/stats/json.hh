@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_JSON_HH__
+#define __BASE_STATS_JSON_HH__
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+/**
+ * JSON stat output, written while the stats are visited.
+ *
+ * The file has the layout of the JSON written by m5.ext.pystats
+ * (SimStat.dump()), so it can still be read back with
+ * m5.ext.pystats.jsonloader: groups are objects of type "Group", stats
+ * are objects holding their value, type, unit, description and datatype,
+ * vectors are objects of type "Vector" holding one scalar per element.
+ * As with pystats, formulas, 2d vectors, vector distributions and sparse
+ * histograms are not written. Unlike pystats, the stats of the root
+ * group are written too.
+ *
+ * Each dump replaces the contents of the file.
+ */
+class Json : public Output
+{
+  public:
+    Json(const std::string &file, unsigned indent);
+
+    Json() = delete;
+    Json(const Json &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /** Start a member of the current object, or an element of a list */
+    void key(const std::string &name);
+    void element();
+    void newline();
+
+    void beginObject();
+    void endObject();
+
+    void writeScalar(const std::string &name, Counter value,
+                     const Info &info, const std::string &desc);
+
+    void writeString(const std::string &str);
+    void writeValue(double value);
+
+  protected:
+    const std::string fname;
+    const unsigned indent;
+
+    std::ofstream stream;
+
+    /** Whether each open object or list has had any member yet */
+    std::vector<bool> hasMembers;
+
+    /** Root stats the simulated time range is taken from */
+    double finalTick;
+    double simTicks;
+};
+
+std::unique_ptr<Output> initJson(const std::string &filename,
+                                 unsigned indent=4);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_JSON_HH__
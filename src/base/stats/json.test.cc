@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/stats/info.hh"
+#include "base/stats/json.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+GTestTickHandler tickHandler;
+
+class TestScalarInfo : public statistics::ScalarInfo
+{
+  public:
+    statistics::Counter val = 0;
+
+    TestScalarInfo(const std::string &name)
+    {
+        setName(name, false);
+        flags.set(statistics::display);
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return val == 0; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+
+    statistics::Counter value() const override { return val; }
+    statistics::Result result() const override { return val; }
+    statistics::Result total() const override { return val; }
+};
+
+class TestVectorInfo : public statistics::VectorInfo
+{
+  public:
+    statistics::VCounter vals;
+    statistics::VResult results;
+
+    TestVectorInfo(const std::string &name, size_t size)
+        : vals(size, 0), results(size, 0)
+    {
+        setName(name, false);
+        subnames = {"a", ""};
+        subdescs = {"first"};
+        flags.set(statistics::display);
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+
+    statistics::size_type size() const override { return vals.size(); }
+    const statistics::VCounter &value() const override { return vals; }
+    const statistics::VResult &result() const override { return results; }
+    statistics::Result total() const override { return 0; }
+};
+
+class StatsJsonTest : public ::testing::Test
+{
+  protected:
+    char filename[20] = "json-XXXXXX";
+    TestScalarInfo finalTick{"finalTick"};
+    TestScalarInfo simTicks{"simTicks"};
+    TestScalarInfo scalar{"scalar"};
+    TestVectorInfo vector{"vector", 2};
+
+    void
+    SetUp() override
+    {
+        int fd = mkstemp(filename);
+        ASSERT_NE(-1, fd);
+        close(fd);
+        tickHandler.setCurTick(0);
+    }
+
+    void TearDown() override { unlink(filename); }
+
+    std::string
+    dump(statistics::Output &output)
+    {
+        output.begin();
+        finalTick.visit(output);
+        simTicks.visit(output);
+        output.beginGroup("system");
+        scalar.visit(output);
+        vector.visit(output);
+        output.endGroup();
+        output.end();
+
+        std::ifstream in(filename);
+        return std::string(std::istreambuf_iterator<char>(in),
+                           std::istreambuf_iterator<char>());
+    }
+};
+
+} // anonymous namespace
+
+/** Groups and stats are written as nested objects. */
+TEST_F(StatsJsonTest, Layout)
+{
+    statistics::Json output(filename, 0);
+    finalTick.val = 30;
+    simTicks.val = 20;
+    scalar.val = 1.5;
+    vector.vals = {2, 3};
+    std::string text = dump(output);
+
+    EXPECT_NE(std::string::npos, text.find(
+        "\"system\": {\n"
+        "\"type\": \"Group\",\n"
+        "\"time_conversion\": null,\n"
+        "\"scalar\": {\n"
+        "\"value\": 1.5,\n"
+        "\"type\": \"Scalar\",\n"
+        "\"unit\": \"Unspecified\",\n"
+        "\"description\": \"\",\n"
+        "\"datatype\": \"f64\"\n"
+        "},\n"
+        "\"vector\": {\n"
+        "\"type\": \"Vector\",\n"
+        "\"time_conversion\": null,\n"
+        "\"a\": {\n"
+        "\"value\": 2.0,\n"));
+    EXPECT_NE(std::string::npos, text.find("\"description\": \"first\""));
+    EXPECT_NE(std::string::npos, text.find("\"1\": {\n\"value\": 3.0,"));
+    EXPECT_NE(std::string::npos, text.find(
+        "\"simulated_begin_time\": 10,\n"
+        "\"simulated_end_time\": 30\n"
+        "}\n"));
+}
+
+/** Nested members are indented, and each dump replaces the file. */
+TEST_F(StatsJsonTest, Indent)
+{
+    statistics::Json output(filename, 2);
+    dump(output);
+    scalar.val = 4;
+    std::string text = dump(output);
+
+    EXPECT_EQ("{\n  \"creation_time\": ", text.substr(0, 21));
+    EXPECT_NE(std::string::npos, text.find(
+        "\n    \"scalar\": {\n      \"value\": 4.0,"));
+    EXPECT_EQ(text.find("creation_time"), text.rfind("creation_time"));
+}
+
+/** Strings are escaped, and non-finite values spelled as Python does. */
+TEST_F(StatsJsonTest, Escape)
+{
+    statistics::Json output(filename, 0);
+    scalar.desc = "a \"quoted\"\tdesc\\";
+    scalar.val = 1.0 / 0.0;
+    std::string text = dump(output);
+
+    EXPECT_NE(std::string::npos, text.find("\"value\": Infinity,"));
+    EXPECT_NE(std::string::npos,
+              text.find("\"a \\\"quoted\\\"\\u0009desc\\\\\""));
+}
@@ -69,6 +69,13 @@ struct Output
     virtual void end() = 0;
     virtual bool valid() const = 0;
 
+    /**
+     * Outputs that only need the stats that changed since the
+     * previous dump return true. Stats that are known not to have
+     * changed are then not visited.
+     */
+    virtual bool onlyChanged() const { return false; }
+
     virtual void beginGroup(const char *name) = 0;
     virtual void endGroup() = 0;
 
@@ -58,6 +58,7 @@ DistStor::sample(Counter val, int number)
     else if (val > max_track)
         overflow += number;
     else {
+        allocate();
         cvec[std::floor((val - min_track) / bucket_size)] += number;
     }
 
@@ -70,6 +71,7 @@ DistStor::sample(Counter val, int number)
     sum += val * number;
     squares += val * val * number;
     samples += number;
+    _dirty = true;
 }
 
 void
@@ -176,6 +178,7 @@ void
 HistStor::sample(Counter val, int number)
 {
     assert(min_bucket < max_bucket);
+    allocate();
     if (val < min_bucket) {
         if (min_bucket == 0)
             growDown();
@@ -203,6 +206,7 @@ HistStor::sample(Counter val, int number)
     squares += val * val * number;
     logs += std::log(val) * number;
     samples += number;
+    _dirty = true;
 }
 
 void
@@ -212,18 +216,25 @@ HistStor::add(HistStor *hs)
     assert(size() == b_size);
     assert(min_bucket == hs->min_bucket);
 
+    allocate();
+    hs->allocate();
+
     sum += hs->sum;
     logs += hs->logs;
     squares += hs->squares;
     samples += hs->samples;
 
-    while (bucket_size > hs->bucket_size)
+    // Growing changes the other histogram's buckets as well
+    while (bucket_size > hs->bucket_size) {
         hs->growUp();
+        hs->_dirty = true;
+    }
     while (bucket_size < hs->bucket_size)
         growUp();
 
     for (uint32_t i = 0; i < b_size; i++)
         cvec[i] += hs->cvec[i];
+    _dirty = true;
 }
 
 } // namespace statistics
@@ -50,10 +50,29 @@ struct StorageParams
     virtual ~StorageParams() = default;
 };
 
+/**
+ * Dirty state of a storage. Storages set the flag whenever they are
+ * modified and the stat framework clears it after every dump, which
+ * lets outputs skip the stats that did not change in between.
+ */
+class DirtyFlag
+{
+  protected:
+    /** Has the storage changed since it was last cleaned? */
+    bool _dirty = true;
+
+  public:
+    /** @return true if the storage changed since the last clean() */
+    bool dirty() const { return _dirty; }
+
+    /** Mark the storage as unchanged. */
+    void clean() { _dirty = false; }
+};
+
 /**
  * Templatized storage and interface for a simple scalar stat.
  */
-class StatStor
+class StatStor : public DirtyFlag
 {
   private:
     /** The statistic value. */
@@ -74,19 +93,19 @@ class StatStor
      * The the stat to the given value.
      * @param val The new value.
      */
-    void set(Counter val) { data = val; }
+    void set(Counter val) { data = val; _dirty = true; }
 
     /**
      * Increment the stat by the given value.
      * @param val The new value.
      */
-    void inc(Counter val) { data += val; }
+    void inc(Counter val) { data += val; _dirty = true; }
 
     /**
      * Decrement the stat by the given value.
      * @param val The new value.
      */
-    void dec(Counter val) { data -= val; }
+    void dec(Counter val) { data -= val; _dirty = true; }
 
     /**
      * Return the value of this stat as its base type.
@@ -108,7 +127,12 @@ class StatStor
     /**
      * Reset stat value to default
      */
-    void reset(const StorageParams* const storage_params) { data = Counter(); }
+    void
+    reset(const StorageParams* const storage_params)
+    {
+        data = Counter();
+        _dirty = true;
+    }
 
     /**
      * @return true if zero value
@@ -192,6 +216,12 @@ class AvgStor
      */
     bool zero() const { return total == 0.0; }
 
+    /**
+     * The average changes with time, so it is always dirty.
+     */
+    bool dirty() const { return true; }
+    void clean() { }
+
     /**
      * Prepare stat data for dumping or serialization
      */
@@ -229,7 +259,7 @@ struct DistParams : public StorageParams
  * in buckets themselves; two special counters, underflow and overflow store
  * the number of occurrences of such values.
  */
-class DistStor
+class DistStor : public DirtyFlag
 {
   private:
     /** The minimum value to track. */
@@ -253,9 +283,21 @@ class DistStor
     Counter squares;
     /** The number of samples. */
     Counter samples;
-    /** Counter for each bucket. */
+    /** The number of buckets. */
+    size_type buckets;
+    /**
+     * Counter for each bucket. The buckets are only allocated when the
+     * first value is sampled, as many distributions never see any.
+     */
     VCounter cvec;
 
+    void
+    allocate()
+    {
+        if (cvec.empty())
+            cvec.resize(buckets);
+    }
+
   public:
     /** The parameters for a distribution stat. */
     struct Params : public DistParams
@@ -285,7 +327,7 @@ class DistStor
     };
 
     DistStor(const StorageParams* const storage_params)
-        : cvec(safe_cast<const Params *>(storage_params)->buckets)
+        : buckets(safe_cast<const Params *>(storage_params)->buckets)
     {
         reset(storage_params);
     }
@@ -301,7 +343,7 @@ class DistStor
      * Return the number of buckets in this distribution.
      * @return the number of buckets.
      */
-    size_type size() const { return cvec.size(); }
+    size_type size() const { return buckets; }
 
     /**
      * Returns true if any calls to sample have been made.
@@ -329,9 +371,10 @@ class DistStor
         data.underflow = underflow;
         data.overflow = overflow;
 
-        data.cvec.resize(params->buckets);
-        for (off_type i = 0; i < params->buckets; ++i)
-            data.cvec[i] = cvec[i];
+        if (cvec.empty())
+            data.cvec.assign(params->buckets, Counter());
+        else
+            data.cvec = cvec;
 
         data.sum = sum;
         data.squares = squares;
@@ -361,6 +404,7 @@ class DistStor
         sum = Counter();
         squares = Counter();
         samples = Counter();
+        _dirty = true;
     }
 };
 
@@ -395,7 +439,7 @@ class DistStor
  * buckets are grown, the zero bucket would grow its range to [-4,4[, which
  * cannot be easily extracted from the neighor buckets.
  */
-class HistStor
+class HistStor : public DirtyFlag
 {
   private:
     /** Lower bound of the first bucket's range. */
@@ -413,9 +457,21 @@ class HistStor
     Counter squares;
     /** The number of samples. */
     Counter samples;
-    /** Counter for each bucket. */
+    /** The number of buckets. */
+    size_type buckets;
+    /**
+     * Counter for each bucket. The buckets are only allocated when the
+     * first value is sampled, as many distributions never see any.
+     */
     VCounter cvec;
 
+    void
+    allocate()
+    {
+        if (cvec.empty())
+            cvec.resize(buckets);
+    }
+
     /**
      * Given a bucket size B, and a range of values [0, N], this function
      * doubles the bucket size to double the range of values towards the
@@ -471,7 +527,7 @@ class HistStor
     };
 
     HistStor(const StorageParams* const storage_params)
-        : cvec(safe_cast<const Params *>(storage_params)->buckets)
+        : buckets(safe_cast<const Params *>(storage_params)->buckets)
     {
         reset(storage_params);
     }
@@ -493,7 +549,7 @@ class HistStor
      * Return the number of buckets in this distribution.
      * @return the number of buckets.
      */
-    size_type size() const { return cvec.size(); }
+    size_type size() const { return buckets; }
 
     /**
      * Returns true if any calls to sample have been made.
@@ -519,10 +575,10 @@ class HistStor
         data.min_val = min_bucket;
         data.max_val = max_bucket;
 
-        int buckets = params->buckets;
-        data.cvec.resize(buckets);
-        for (off_type i = 0; i < buckets; ++i)
-            data.cvec[i] = cvec[i];
+        if (cvec.empty())
+            data.cvec.assign(params->buckets, Counter());
+        else
+            data.cvec = cvec;
 
         data.sum = sum;
         data.logs = logs;
@@ -549,6 +605,7 @@ class HistStor
         squares = Counter();
         samples = Counter();
         logs = Counter();
+        _dirty = true;
     }
 };
 
@@ -556,7 +613,7 @@ class HistStor
  * Templatized storage and interface for a distribution that calculates mean
  * and variance.
  */
-class SampleStor
+class SampleStor : public DirtyFlag
 {
   private:
     /** The current sum. */
@@ -592,6 +649,7 @@ class SampleStor
         sum += val * number;
         squares += val * val * number;
         samples += number;
+        _dirty = true;
     }
 
     /**
@@ -627,6 +685,7 @@ class SampleStor
         sum = Counter();
         squares = Counter();
         samples = Counter();
+        _dirty = true;
     }
 };
 
@@ -680,6 +739,12 @@ class AvgSampleStor
      */
     bool zero() const { return sum == Counter(); }
 
+    /**
+     * The number of samples is the current tick, so it is always dirty.
+     */
+    bool dirty() const { return true; }
+    void clean() { }
+
     void
     prepare(const StorageParams* const storage_params, DistData &data)
     {
@@ -710,7 +775,7 @@ class AvgSampleStor
  * need to keep track of the samples that occur in between two distant
  * sampled values.
  */
-class SparseHistStor
+class SparseHistStor : public DirtyFlag
 {
   private:
     /** Counter for number of samples */
@@ -740,6 +805,7 @@ class SparseHistStor
     {
         cmap[val] += number;
         samples += number;
+        _dirty = true;
     }
 
     /**
@@ -778,6 +844,7 @@ class SparseHistStor
     {
         cmap.clear();
         samples = 0;
+        _dirty = true;
     }
 };
 
@@ -129,6 +129,30 @@ TEST(StatsStatStorTest, ZeroReset)
     ASSERT_FALSE(stor.zero());
 }
 
+/** Test that modifying the storage marks it as dirty. */
+TEST(StatsStatStorTest, Dirty)
+{
+    statistics::StatStor stor(nullptr);
+    ASSERT_TRUE(stor.dirty());
+
+    stor.clean();
+    ASSERT_FALSE(stor.dirty());
+    stor.prepare(nullptr);
+    ASSERT_FALSE(stor.dirty());
+
+    stor.inc(1);
+    ASSERT_TRUE(stor.dirty());
+    stor.clean();
+    stor.set(2);
+    ASSERT_TRUE(stor.dirty());
+    stor.clean();
+    stor.dec(1);
+    ASSERT_TRUE(stor.dirty());
+    stor.clean();
+    stor.reset(nullptr);
+    ASSERT_TRUE(stor.dirty());
+}
+
 /** Test setting and getting a value to the storage. */
 TEST(StatsAvgStorTest, SetValueResult)
 {
@@ -374,6 +398,20 @@ prepareCheckDistStor(statistics::DistStor::Params& params,
     checkExpectedDistData(data, expected_data, true);
 }
 
+/** Test that a distribution that was never sampled has empty buckets. */
+TEST(StatsDistStorTest, PrepareUnsampled)
+{
+    statistics::DistStor::Params params(0, 19, 5);
+    statistics::DistStor stor(&params);
+    statistics::DistData data;
+    stor.prepare(&params, data);
+
+    ASSERT_EQ(data.cvec, statistics::VCounter(params.buckets));
+    ASSERT_EQ(data.underflow, 0);
+    ASSERT_EQ(data.overflow, 0);
+    ASSERT_EQ(data.samples, 0);
+}
+
 /** Test setting and getting value from storage. */
 TEST(StatsDistStorTest, SamplePrepareSingle)
 {
@@ -471,6 +509,25 @@ TEST(StatsDistStorTest, Reset)
     checkExpectedDistData(data, expected_data, true);
 }
 
+/** Test that sampling and resetting mark the storage as dirty. */
+TEST(StatsDistStorTest, Dirty)
+{
+    statistics::DistStor::Params params(0, 99, 5);
+    statistics::DistStor stor(&params);
+    ASSERT_TRUE(stor.dirty());
+
+    stor.clean();
+    statistics::DistData data;
+    stor.prepare(&params, data);
+    ASSERT_FALSE(stor.dirty());
+
+    stor.sample(10, 1);
+    ASSERT_TRUE(stor.dirty());
+    stor.clean();
+    stor.reset(&params);
+    ASSERT_TRUE(stor.dirty());
+}
+
 #if TRACING_ON
 /** Test that an assertion is thrown when not enough buckets are provided. */
 TEST(StatsHistStorDeathTest, NotEnoughBuckets0)
@@ -970,6 +1027,48 @@ TEST(StatsHistStorTest, Add)
     checkExpectedDistData(merge_data, expected_data, false);
 }
 
+/** Test that a histogram that was never sampled has empty buckets. */
+TEST(StatsHistStorTest, PrepareUnsampled)
+{
+    statistics::HistStor::Params params(4);
+    statistics::HistStor stor(&params);
+    statistics::DistData data;
+    stor.prepare(&params, data);
+
+    ASSERT_EQ(data.cvec, statistics::VCounter(params.buckets));
+    ASSERT_EQ(data.min, 0);
+    ASSERT_EQ(data.max, 3);
+    ASSERT_EQ(data.bucket_size, 1);
+    ASSERT_EQ(data.samples, 0);
+}
+
+/** Test merging histograms when one of them was never sampled. */
+TEST(StatsHistStorTest, AddUnsampled)
+{
+    statistics::HistStor::Params params(4);
+
+    statistics::HistStor stor(&params);
+    ValueSamples values[] = {{2, 3}, {9, 4}};
+    for (const auto &value : values)
+        stor.sample(value.value, value.numSamples);
+    statistics::DistData data;
+    stor.prepare(&params, data);
+
+    // Merge a sampled histogram into an unsampled one
+    statistics::HistStor stor2(&params);
+    stor2.add(&stor);
+    statistics::DistData data2;
+    stor2.prepare(&params, data2);
+    checkExpectedDistData(data2, data, false);
+
+    // Merge an unsampled histogram into a sampled one
+    statistics::HistStor stor3(&params);
+    stor.add(&stor3);
+    statistics::DistData data3;
+    stor.prepare(&params, data3);
+    checkExpectedDistData(data3, data, false);
+}
+
 /**
  * Test whether zero is correctly set as the reset value. The test order is
  * to check if it is initially zero on creation, then it is made non zero,
@@ -32,10 +32,12 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <memory>
 #include <ostream>
 #include <string>
 #include <sstream>
 
+#include "base/binary_trace.hh"
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
 #include "base/debug.hh"
@@ -64,6 +66,9 @@ class Logger
     /** Name match for objects to activate log */
     ObjectMatch activate;
 
+    /** Binary log to record messages in instead of formatting them */
+    BinaryLog *binaryLog = nullptr;
+
     bool isEnabled(const std::string &name) const
     {
         if (name.empty()) // Enable the logger with a empty name.
@@ -81,21 +86,26 @@ class Logger
 
   public:
     /** Log a single message */
-    template <typename ...Args>
-    void dprintf(Tick when, const std::string &name, const char *fmt,
+    template <typename Format, typename ...Args>
+    void dprintf(Tick when, const std::string &name, const Format &fmt,
                  const Args &...args)
     {
         dprintf_flag(when, name, "", fmt, args...);
     }
 
     /** Log a single message with a flag prefix. */
-    template <typename ...Args>
+    template <typename Format, typename ...Args>
     void dprintf_flag(Tick when, const std::string &name,
             const std::string &flag,
-            const char *fmt, const Args &...args)
+            const Format &fmt, const Args &...args)
     {
         if (!isEnabled(name))
             return;
+        if (binaryLog) {
+            binaryLog->message(when, name, flag, formatCString(fmt),
+                               args...);
+            return;
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -116,6 +126,9 @@ class Logger
      *  way, or just set to one of std::cout, std::cerr */
     virtual std::ostream &getOstream() = 0;
 
+    /** Make sure that everything logged so far has been written out */
+    virtual void flush() {}
+
     /** Set objects to ignore */
     void setIgnore(ObjectMatch &ignore_) { ignore = ignore_; }
 
@@ -146,6 +159,39 @@ class OstreamLogger : public Logger
             const std::string &flag, const std::string &message) override;
 
     std::ostream &getOstream() override { return stream; }
+
+    void flush() override { stream.flush(); }
+};
+
+/** Logger that records messages in the binary format described in
+ *  base/binary_trace.hh. Messages are not formatted until the log is
+ *  decoded by util/decode_debug_trace.py, which makes enabling debug
+ *  flags much cheaper. The FmtStackTrace flag has no effect.
+ *
+ *  A bounded logger is a flight recorder: it keeps only the most
+ *  recent messages of each thread in memory and writes them out when
+ *  flushed, e.g. when gem5 exits or panics. */
+class BinaryLogger : public Logger
+{
+  protected:
+    class TextBuf;
+
+    BinaryLog log;
+    /** Turns text written to getOstream() into log records */
+    std::unique_ptr<TextBuf> textBuf;
+    std::ostream stream;
+
+  public:
+    BinaryLogger(const std::string &filename, size_t buffer_size=1 << 20,
+                 bool bounded=false);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    std::ostream &getOstream() override { return stream; }
+
+    void flush() override;
 };
 
 /** Get the current global debug logger.  This takes ownership of the given
@@ -43,11 +43,13 @@
 
 #include <sys/types.h>
 
+#include <limits>
+
 #include "base/logging.hh"
 #include "base/output.hh"
-
 #include "base/trace.hh"
 #include "debug/VNC.hh"
+#include "sim/sim_exit.hh"
 
 namespace gem5
 {
@@ -58,7 +60,8 @@ VncInput::VncInput(const Params &p)
       _videoWidth(fb->width()), _videoHeight(fb->height()),
       captureEnabled(p.frame_capture),
       captureCurrentFrame(0), captureLastHash(0),
-      imgFormat(p.img_format)
+      captureLastVersion(std::numeric_limits<uint64_t>::max()),
+      imgFormat(p.img_format), captureStop(false)
 {
     if (captureEnabled) {
         // remove existing frame output directory if it exists, then create a
@@ -67,9 +70,17 @@ VncInput::VncInput(const Params &p)
         simout.remove(FRAME_OUTPUT_SUBDIR, true);
         captureOutputDirectory = simout.createSubdirectory(
                                 FRAME_OUTPUT_SUBDIR);
+
+        captureThread = std::thread([this]() { captureWorker(); });
+        registerExitCallback([this]() { stopCapture(); });
     }
 }
 
+VncInput::~VncInput()
+{
+    stopCapture();
+}
+
 void
 VncInput::setFrameBuffer(const FrameBuffer *rfb)
 {
@@ -77,6 +88,7 @@ VncInput::setFrameBuffer(const FrameBuffer *rfb)
         panic("Trying to VNC frame buffer to NULL!");
 
     fb = rfb;
+    captureLastVersion = std::numeric_limits<uint64_t>::max();
 
     // Create the Image Writer object in charge of dumping
     // the frame buffer raw data into a file in a specific format.
@@ -114,7 +126,12 @@ VncInput::captureFrameBuffer()
 {
     assert(captureImage);
 
-    // skip identical frames
+    // skip identical frames, without hashing them if nothing was
+    // written to the frame buffer
+    if (fb->version() == captureLastVersion)
+        return;
+    captureLastVersion = fb->version();
+
     uint64_t new_hash = fb->getHash();
     if (captureLastHash == new_hash)
         return;
@@ -127,12 +144,59 @@ VncInput::captureFrameBuffer()
             captureImage->getImgExtension());
     const std::string frameFilename(frameFilenameBuffer);
 
-    // create the compressed framebuffer file
-    OutputStream *fb_out(captureOutputDirectory->create(frameFilename, true));
-    captureImage->write(*fb_out->stream());
-    captureOutputDirectory->close(fb_out);
+    // hand a copy of the frame to the capture thread, waiting for it
+    // to catch up if too many frames are pending
+    std::unique_lock<std::mutex> lock(captureLock);
+    captureCond.wait(lock, [this]() {
+        return pendingFrames.size() < MaxPendingFrames;
+    });
+    pendingFrames.push_back({*fb, frameFilename});
+    captureCond.notify_all();
 
     ++captureCurrentFrame;
 }
 
+void
+VncInput::captureWorker()
+{
+    std::unique_lock<std::mutex> lock(captureLock);
+    while (true) {
+        captureCond.wait(lock, [this]() {
+            return captureStop || !pendingFrames.empty();
+        });
+        if (pendingFrames.empty())
+            return;
+
+        // The frame stays queued while it's being written, new frames
+        // are only ever added at the back
+        CapturedFrame &pending = pendingFrames.front();
+        lock.unlock();
+
+        // create the compressed framebuffer file
+        auto writer = createImgWriter(imgFormat, &pending.frame);
+        OutputStream *fb_out(
+                captureOutputDirectory->create(pending.filename, true));
+        writer->write(*fb_out->stream());
+        captureOutputDirectory->close(fb_out);
+
+        lock.lock();
+        pendingFrames.pop_front();
+        captureCond.notify_all();
+    }
+}
+
+void
+VncInput::stopCapture()
+{
+    if (!captureThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(captureLock);
+        captureStop = true;
+        captureCond.notify_all();
+    }
+    captureThread.join();
+}
+
 } // namespace gem5
@@ -42,10 +42,16 @@
 #ifndef __BASE_VNC_VNC_INPUT_HH__
 #define __BASE_VNC_VNC_INPUT_HH__
 
+#include <condition_variable>
+#include <deque>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #include "base/compiler.hh"
+#include "base/framebuffer.hh"
 #include "base/imgwriter.hh"
 #include "params/VncInput.hh"
 #include "sim/sim_object.hh"
@@ -165,6 +171,7 @@ class VncInput : public SimObject
 
     typedef VncInputParams Params;
     VncInput(const Params &p);
+    ~VncInput();
 
     /** Set the address of the frame buffer we are going to show.
      * To avoid copying, just have the display controller
@@ -235,6 +242,9 @@ class VncInput : public SimObject
     /** Computed hash of the last captured frame */
     uint64_t captureLastHash;
 
+    /** Frame buffer version of the last frame considered for capture */
+    uint64_t captureLastVersion;
+
     /** Cached ImgWriter object for writing out frame buffers to file */
     std::unique_ptr<ImgWriter> captureImage;
 
@@ -243,6 +253,35 @@ class VncInput : public SimObject
 
     /** Captures the current frame buffer to a file */
     void captureFrameBuffer();
+
+    /** A copy of a frame waiting to be written out */
+    struct CapturedFrame
+    {
+        FrameBuffer frame;
+        std::string filename;
+    };
+
+    /**
+     * Maximum number of captured frames waiting to be written. The
+     * simulation stalls when the capture thread falls this far behind.
+     */
+    static constexpr size_t MaxPendingFrames = 4;
+
+    /**
+     * Captured frames are compressed and written out by a separate
+     * thread, so the simulation doesn't wait for the encoder.
+     * @{
+     */
+    std::deque<CapturedFrame> pendingFrames;
+    std::mutex captureLock;
+    std::condition_variable captureCond;
+    bool captureStop;
+    std::thread captureThread;
+
+    void captureWorker();
+    /** Write out all pending frames and stop the capture thread */
+    void stopCapture();
+    /** @} */
 };
 
 } // namespace gem5
@@ -118,7 +118,8 @@ VncServer::DataEvent::process(int revent)
 VncServer::VncServer(const Params &p)
     : VncInput(p), listenEvent(NULL), dataEvent(NULL), number(p.number),
       dataFd(-1), listener(p.port.build(p.name)),
-      sendUpdate(false), supportsRawEnc(false), supportsResizeEnc(false)
+      sendUpdate(false), fullUpdate(true), sentVersion(0),
+      supportsRawEnc(false), supportsResizeEnc(false)
 {
     if (p.port)
         listen();
@@ -469,6 +470,7 @@ VncServer::sendServerInit()
     if (!write(&msg))
         return;
     curState = NormalPhase;
+    fullUpdate = true;
 }
 
 void
@@ -556,6 +558,13 @@ VncServer::requestFbUpdate()
     DPRINTF(VNC, " -- x = %d y = %d w = %d h = %d\n", fbr.x, fbr.y, fbr.width,
             fbr.height);
 
+    // A non-incremental request asks for the whole frame buffer
+    // whether it changed or not
+    if (!fbr.incremental) {
+        fullUpdate = true;
+        sendUpdate = true;
+    }
+
     sendFrameBufferUpdate();
 }
 
@@ -629,7 +638,19 @@ VncServer::sendFrameBufferUpdate()
     // The client will request data constantly, unless we throttle it
     sendUpdate = false;
 
-    DPRINTF(VNC, "Sending framebuffer update\n");
+    assert(fb);
+
+    unsigned first = 0;
+    unsigned last = fb->height() - 1;
+    if (!fullUpdate && !fb->dirtyLines(sentVersion, first, last)) {
+        DPRINTF(VNC, "Frame buffer unchanged, NOT sending update\n");
+        return;
+    }
+    fullUpdate = false;
+    sentVersion = fb->version();
+    const unsigned rows = fb->height() ? last - first + 1 : 0;
+
+    DPRINTF(VNC, "Sending framebuffer update, lines %d-%d\n", first, last);
 
     FrameBufferUpdate fbu;
     FrameBufferRect fbr;
@@ -637,9 +658,9 @@ VncServer::sendFrameBufferUpdate()
     fbu.type = ServerFrameBufferUpdate;
     fbu.num_rects = 1;
     fbr.x = 0;
-    fbr.y = 0;
+    fbr.y = first;
     fbr.width = videoWidth();
-    fbr.height = videoHeight();
+    fbr.height = rows;
     fbr.encoding = EncodingRaw;
 
     // fix up endian
@@ -654,16 +675,12 @@ VncServer::sendFrameBufferUpdate()
     if (!write(&fbu) || !write(&fbr))
         return;
 
-    assert(fb);
-
     std::vector<uint8_t> line_buffer(pixelConverter.length * fb->width());
-    for (int y = 0; y < fb->height(); ++y) {
+    for (unsigned y = first; y < first + rows; ++y) {
         // Convert and send a line at a time
-        uint8_t *raw_pixel(line_buffer.data());
-        for (unsigned x = 0; x < fb->width(); ++x) {
-            pixelConverter.fromPixel(raw_pixel, fb->pixel(x, y));
-            raw_pixel += pixelConverter.length;
-        }
+        pixelConverter.fromPixels(line_buffer.data(),
+                                  fb->pixels.data() + y * fb->width(),
+                                  fb->width());
 
         if (!write(line_buffer.data(), line_buffer.size()))
             return;
@@ -703,6 +720,14 @@ VncServer::sendFrameBufferResized()
     // No actual data is sent in this message
 }
 
+void
+VncServer::setFrameBuffer(const FrameBuffer *rfb)
+{
+    // Versions of different frame buffers can't be compared
+    fullUpdate = true;
+    VncInput::setFrameBuffer(rfb);
+}
+
 void
 VncServer::setDirty()
 {
@@ -715,6 +740,7 @@ VncServer::setDirty()
 void
 VncServer::frameBufferResized()
 {
+    fullUpdate = true;
     if (dataFd > 0 && curState == NormalPhase) {
         if (supportsResizeEnc)
             sendFrameBufferResized();
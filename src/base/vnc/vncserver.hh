@@ -202,6 +202,13 @@ class VncServer : public VncInput
      * client will constantly request data that is pointless */
     bool sendUpdate;
 
+    /** The client needs the whole frame buffer, not just the lines
+     * which changed since the last update */
+    bool fullUpdate;
+
+    /** Frame buffer version sent in the last update */
+    uint64_t sentVersion;
+
     /** The one and only pixel format we support */
     PixelFormat pixelFormat;
 
@@ -281,8 +288,9 @@ class VncServer : public VncInput
      */
     void sendError(std::string error_msg);
 
-    /** Send a updated frame buffer to the client.
-     * @todo this doesn't do anything smart and just sends the entire image
+    /** Send a updated frame buffer to the client. Only the range of
+     * lines which changed since the last update is sent, unless the
+     * client asked for the whole frame buffer.
      */
     void sendFrameBufferUpdate();
 
@@ -315,6 +323,7 @@ class VncServer : public VncInput
     static const PixelConverter pixelConverter;
 
   public:
+    void setFrameBuffer(const FrameBuffer *rfb) override;
     void setDirty() override;
     void frameBufferResized() override;
 };
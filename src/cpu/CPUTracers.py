@@ -46,3 +46,18 @@ class NativeTrace(ExeTracer):
     type = "NativeTrace"
     cxx_class = "gem5::trace::NativeTrace"
     cxx_header = "cpu/nativetrace.hh"
+
+
+class BinaryExeTracer(InstTracer):
+    type = "BinaryExeTracer"
+    cxx_class = "gem5::trace::BinaryExeTracer"
+    cxx_header = "cpu/binary_exetrace.hh"
+
+    trace_file = Param.String(
+        "",
+        "File to write the trace to, relative to the output directory. "
+        "Defaults to the name of the tracer followed by .bin",
+    )
+    buffer_size = Param.MemorySize(
+        "1MiB", "Size of each of the two trace buffers"
+    )
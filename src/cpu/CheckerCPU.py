@@ -43,6 +43,18 @@ class CheckerCPU(BaseCPU):
         True,
         "If a load result is incorrect, only print a warning and do not exit",
     )
+    sampleWindow = Param.Unsigned(
+        0,
+        "Only verify randomly placed windows of this many instructions, "
+        "copying the state of the main CPU at the start of each, and every "
+        "instruction around faults, interrupts and serializing "
+        "instructions. 0 verifies every instruction",
+    )
+    samplePeriod = Param.Unsigned(
+        100000,
+        "Average number of instructions from the start of a sampling "
+        "window to the start of the next one",
+    )
 
     def generateDeviceTree(self, state):
         # The CheckerCPU is not a real CPU and shouldn't generate a DTB
@@ -56,6 +56,7 @@
 #include "base/output.hh"
 #include "base/trace.hh"
 #include "cpu/checker/cpu.hh"
+#include "cpu/pred/bpred_unit.hh"
 #include "cpu/thread_context.hh"
 #include "debug/Mwait.hh"
 #include "debug/SyscallVerbose.hh"
@@ -279,7 +280,7 @@ BaseCPU::mwaitAtomic(ThreadID tid, ThreadContext *tc, BaseMMU *mmu)
     assert(tid < numThreads);
     AddressMonitor &monitor = addressMonitor[tid];
 
-    RequestPtr req = std::make_shared<Request>();
+    RequestPtr req = makeRequest();
 
     Addr addr = monitor.vAddr;
     Addr block_size = cacheLineSize();
@@ -590,9 +591,8 @@ BaseCPU::switchOut()
     assert(!_switchedOut);
     _switchedOut = true;
 
-    // Flush all TLBs in the CPU to avoid having stale translations if
-    // it gets switched in later.
-    flushTLBs();
+    // The TLBs are flushed once the new CPU has taken over their
+    // entries, see takeOverFrom().
 
     // Go to the power gating state
     powerState->set(enums::PwrState::OFF);
@@ -646,6 +646,17 @@ BaseCPU::takeOverFrom(BaseCPU *oldCPU)
         }
     }
 
+    // Flush all TLBs in the old CPU to avoid having stale translations
+    // if it gets switched in later.
+    oldCPU->flushTLBs();
+
+    // Hand the branch predictor state over so that the new CPU does
+    // not start with cold predictors.
+    branch_prediction::BPredUnit *bpred = getBranchPredictor();
+    branch_prediction::BPredUnit *old_bpred = oldCPU->getBranchPredictor();
+    if (bpred && old_bpred && bpred != old_bpred)
+        bpred->takeOverFrom(old_bpred);
+
     interrupts = oldCPU->interrupts;
     for (ThreadID tid = 0; tid < numThreads; tid++) {
         interrupts[tid]->setThreadContext(threadContexts[tid]);
@@ -67,6 +67,11 @@ struct BaseCPUParams;
 class CheckerCPU;
 class ThreadContext;
 
+namespace branch_prediction
+{
+class BPredUnit;
+} // namespace branch_prediction
+
 struct AddressMonitor
 {
     AddressMonitor();
@@ -341,6 +346,19 @@ class BaseCPU : public ClockedObject
      */
     virtual void takeOverFrom(BaseCPU *cpu);
 
+    /**
+     * Get the branch predictor of this CPU, if it has any. When both
+     * the old and the new CPU have one, takeOverFrom() hands the state
+     * of the old predictor over to the new one.
+     *
+     * @return The branch predictor or nullptr.
+     */
+    virtual branch_prediction::BPredUnit *
+    getBranchPredictor() const
+    {
+        return nullptr;
+    }
+
     /**
      * Set the reset of the CPU to be either asserted or deasserted.
      *
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/binary_exetrace.hh"
+
+#include <sstream>
+
+#include "base/loader/symtab.hh"
+#include "base/output.hh"
+#include "cpu/base.hh"
+#include "cpu/thread_context.hh"
+#include "debug/ExecAll.hh"
+#include "debug/FmtFlag.hh"
+#include "debug/FmtTicksOff.hh"
+#include "enums/OpClass.hh"
+#include "params/BinaryExeTracer.hh"
+#include "sim/core.hh"
+#include "sim/full_system.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace trace {
+
+void
+BinaryExeTracerRecord::traceInst(const StaticInstPtr &inst, bool ran)
+{
+    const bool in_user_mode = thread->getIsaPtr()->inUserMode();
+    if (in_user_mode && !debug::ExecUser)
+        return;
+    if (!in_user_mode && !debug::ExecKernel)
+        return;
+
+    tracer.updateFormat();
+
+    BinaryExeTracer::ExecRecord rec;
+    rec.tick = when;
+    rec.pc = pc->instAddr();
+    rec.data = dataStatus == DataReg ? 0 : data.asInt;
+    rec.addr = addr;
+    rec.inst = tracer.instId(inst, *pc);
+    rec.cpu = tracer.cpuId(thread->getCpuPtr());
+    rec.thread = thread->threadId();
+    rec.microPC = pc->microPC();
+    rec.dataStatus = dataStatus;
+
+    rec.bits = 0;
+    if (ran)
+        rec.bits |= BinaryExeTracer::ExecRan;
+    if (predicate)
+        rec.bits |= BinaryExeTracer::ExecPredicate;
+    if (in_user_mode)
+        rec.bits |= BinaryExeTracer::ExecUserMode;
+    if (getMemValid())
+        rec.bits |= BinaryExeTracer::ExecMemValid;
+    if (fetch_seq_valid)
+        rec.bits |= BinaryExeTracer::ExecFetchSeqValid;
+    if (cp_seq_valid)
+        rec.bits |= BinaryExeTracer::ExecCPSeqValid;
+    if (debug::ExecAsid)
+        rec.bits |= BinaryExeTracer::ExecHasAsid;
+
+    AsyncWriter &out = *tracer.trace;
+    out.put(BinaryExeTracer::RecExec);
+    out.put(rec);
+    if (fetch_seq_valid)
+        out.put<uint64_t>(fetch_seq);
+    if (cp_seq_valid)
+        out.put<uint64_t>(cp_seq);
+    if (debug::ExecAsid)
+        out.put<uint64_t>(thread->getIsaPtr()->getExecutingAsid());
+    if (dataStatus == DataReg)
+        tracer.putString(data.asReg.asString());
+}
+
+void
+BinaryExeTracerRecord::dump()
+{
+    // The same choice of macroops and microops as ExeTracerRecord::dump.
+    if (debug::ExecMacro && staticInst->isMicroop() &&
+        ((debug::ExecMicro &&
+            macroStaticInst && staticInst->isFirstMicroop()) ||
+            (!debug::ExecMicro &&
+             macroStaticInst && staticInst->isLastMicroop()))) {
+        traceInst(macroStaticInst, false);
+    }
+    if (debug::ExecMicro || !staticInst->isMicroop()) {
+        traceInst(staticInst, true);
+    }
+}
+
+BinaryExeTracer::BinaryExeTracer(const Params &p)
+    : InstTracer(p)
+{
+    const std::string filename = simout.resolve(
+            p.trace_file.empty() ? name() + ".bin" : p.trace_file);
+    trace.reset(new AsyncWriter(filename, p.buffer_size));
+
+    // The destructor isn't called, so write out the trace on exit.
+    registerExitCallback([this]() { closeTrace(); });
+}
+
+void
+BinaryExeTracer::startup()
+{
+    trace->write(TraceMagic, sizeof(TraceMagic));
+    trace->put(TraceVersion);
+    trace->put<uint64_t>(sim_clock::Frequency);
+    trace->put<uint8_t>(FullSystem);
+}
+
+void
+BinaryExeTracer::closeTrace()
+{
+    trace.reset();
+}
+
+void
+BinaryExeTracer::putString(const std::string &str)
+{
+    trace->put<uint32_t>(str.size());
+    trace->write(str.data(), str.size());
+}
+
+uint16_t
+BinaryExeTracer::cpuId(BaseCPU *cpu)
+{
+    // There is usually a tracer per CPU, so this is a very short list.
+    for (size_t i = 0; i < cpus.size(); i++) {
+        if (cpus[i] == cpu)
+            return i;
+    }
+
+    const uint16_t id = cpus.size();
+    cpus.push_back(cpu);
+    trace->put(RecCpu);
+    trace->put(id);
+    putString(cpu->name());
+    return id;
+}
+
+uint32_t
+BinaryExeTracer::instId(const StaticInstPtr &inst, const PCStateBase &pc)
+{
+    const InstKey key{inst.get(), pc.instAddr(), pc.microPC()};
+    auto [it, inserted] = instIds.emplace(key, insts.size());
+    if (!inserted)
+        return it->second;
+
+    insts.push_back(inst);
+
+    trace->put(RecInst);
+    trace->put(it->second);
+    trace->put<uint8_t>(inst->isMicroop());
+    putString(disassemble(inst, pc, &loader::debugSymbolTable));
+
+    // Whether the symbol is printed depends on the mode the CPU is in,
+    // which is left to the decoder.
+    const Addr cur_pc = pc.instAddr();
+    auto sym = loader::debugSymbolTable.findNearest(cur_pc);
+    if (sym != loader::debugSymbolTable.end()) {
+        const Addr delta = cur_pc - sym->address();
+        putString(delta ? csprintf("@%s+%d", sym->name(), delta) :
+                csprintf("@%s", sym->name()));
+    } else {
+        putString("");
+    }
+
+    putString(enums::OpClassStrings[inst->opClass()]);
+
+    std::stringstream flags;
+    inst->printFlags(flags, "|");
+    putString(flags.str());
+
+    return it->second;
+}
+
+void
+BinaryExeTracer::updateFormat()
+{
+    uint32_t current = 0;
+    if (debug::ExecAsid)
+        current |= FmtAsid;
+    if (debug::ExecThread)
+        current |= FmtThread;
+    if (debug::ExecSymbol)
+        current |= FmtSymbol;
+    if (debug::ExecOpClass)
+        current |= FmtOpClass;
+    if (debug::ExecResult)
+        current |= FmtResult;
+    if (debug::ExecEffAddr)
+        current |= FmtEffAddr;
+    if (debug::ExecFetchSeq)
+        current |= FmtFetchSeq;
+    if (debug::ExecCPSeq)
+        current |= FmtCPSeq;
+    if (debug::ExecFlags)
+        current |= FmtFlags;
+    if (debug::FmtTicksOff)
+        current |= FmtTicksOff;
+    if (debug::FmtFlag)
+        current |= FmtFlag;
+
+    if (current == format)
+        return;
+    format = current;
+    trace->put(RecFormat);
+    trace->put(format);
+}
+
+} // namespace trace
+} // namespace gem5
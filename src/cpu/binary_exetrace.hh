@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __CPU_BINARY_EXETRACE_HH__
+#define __CPU_BINARY_EXETRACE_HH__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/async_writer.hh"
+#include "base/types.hh"
+#include "cpu/static_inst.hh"
+#include "debug/ExecEnable.hh"
+#include "sim/insttracer.hh"
+
+namespace gem5
+{
+
+struct BinaryExeTracerParams;
+class BaseCPU;
+class ThreadContext;
+
+namespace trace {
+
+class BinaryExeTracer;
+
+class BinaryExeTracerRecord : public InstRecord
+{
+  public:
+    BinaryExeTracerRecord(Tick _when, ThreadContext *_thread,
+               const StaticInstPtr _staticInst, const PCStateBase &_pc,
+               BinaryExeTracer &_tracer,
+               const StaticInstPtr _macroStaticInst = NULL)
+        : InstRecord(_when, _thread, _staticInst, _pc, _macroStaticInst),
+          tracer(_tracer)
+    {
+    }
+
+    void dump() override;
+
+  protected:
+    void traceInst(const StaticInstPtr &inst, bool ran);
+
+    BinaryExeTracer &tracer;
+};
+
+/**
+ * Instruction tracer writing what ExeTracer would print as compact
+ * binary records, so tracing every instruction doesn't spend most of
+ * the simulation time formatting text. The text of an instruction, its
+ * disassembly, symbol, op class and flags, is only produced the first
+ * time it is seen at a given PC, and is referred to by an ID after
+ * that. The records are written out by a background thread, and
+ * util/decode_exec_trace.py turns the trace back into the text
+ * ExeTracer writes.
+ *
+ * The same debug flags as for ExeTracer select which instructions are
+ * traced and which fields are shown.
+ */
+class BinaryExeTracer : public InstTracer
+{
+  public:
+    typedef BinaryExeTracerParams Params;
+    BinaryExeTracer(const Params &params);
+
+    InstRecord *
+    getInstRecord(Tick when, ThreadContext *tc,
+            const StaticInstPtr staticInst, const PCStateBase &pc,
+            const StaticInstPtr macroStaticInst=nullptr) override
+    {
+        if (!debug::ExecEnable)
+            return NULL;
+
+        return new BinaryExeTracerRecord(when, tc,
+                staticInst, pc, *this, macroStaticInst);
+    }
+
+    /**
+     * The trace starts with TraceMagic, the uint32_t TraceVersion, the
+     * uint64_t tick frequency and a uint8_t which is 1 in full system
+     * mode. Then come records, each starting with a uint8_t RecordType,
+     * in host byte order. Strings are a uint32_t length followed by the
+     * characters.
+     *
+     * RecCpu: uint16_t ID, string name of the CPU.
+     * RecFormat: uint32_t FormatFlags currently set.
+     * RecInst: uint32_t ID, uint8_t 1 for microops, strings disassembly,
+     *     symbol ("" if none, else "@name" or "@name+delta"), op class
+     *     and instruction flags.
+     * RecExec: an ExecRecord, then uint64_t fetch sequence number,
+     *     commit sequence number and ASID if the corresponding ExecBits
+     *     are set, then the result as a string if the data status is
+     *     InstRecord::DataReg.
+     */
+    static constexpr char TraceMagic[8] =
+        {'g', 'e', 'm', '5', 'e', 'x', 'e', '\0'};
+    static constexpr uint32_t TraceVersion = 1;
+
+    enum RecordType : uint8_t
+    {
+        RecCpu = 0,
+        RecFormat = 1,
+        RecInst = 2,
+        RecExec = 3
+    };
+
+    enum FormatFlags : uint32_t
+    {
+        FmtAsid = 0x1,
+        FmtThread = 0x2,
+        FmtSymbol = 0x4,
+        FmtOpClass = 0x8,
+        FmtResult = 0x10,
+        FmtEffAddr = 0x20,
+        FmtFetchSeq = 0x40,
+        FmtCPSeq = 0x80,
+        FmtFlags = 0x100,
+        FmtTicksOff = 0x200,
+        FmtFlag = 0x400
+    };
+
+    enum ExecBits : uint8_t
+    {
+        ExecRan = 0x1,
+        ExecPredicate = 0x2,
+        ExecUserMode = 0x4,
+        ExecMemValid = 0x8,
+        ExecFetchSeqValid = 0x10,
+        ExecCPSeqValid = 0x20,
+        ExecHasAsid = 0x40
+    };
+
+    struct ExecRecord
+    {
+        uint64_t tick;
+        uint64_t pc;
+        uint64_t data;
+        uint64_t addr;
+        uint32_t inst;
+        uint16_t cpu;
+        uint16_t thread;
+        uint16_t microPC;
+        uint8_t bits;
+        uint8_t dataStatus;
+        uint32_t pad = 0;
+    };
+    static_assert(sizeof(ExecRecord) == 48);
+
+    void startup() override;
+
+  protected:
+    friend class BinaryExeTracerRecord;
+
+    /** The ID of a CPU, writing out its name if it is new */
+    uint16_t cpuId(BaseCPU *cpu);
+
+    /**
+     * The ID of an instruction at a PC, writing out its text if it
+     * hasn't been seen there before.
+     */
+    uint32_t instId(const StaticInstPtr &inst, const PCStateBase &pc);
+
+    /** Write out the format flags if they changed */
+    void updateFormat();
+
+    void putString(const std::string &str);
+
+    void closeTrace();
+
+    std::unique_ptr<AsyncWriter> trace;
+
+    struct InstKey
+    {
+        const StaticInst *inst;
+        Addr pc;
+        MicroPC upc;
+
+        bool
+        operator==(const InstKey &other) const
+        {
+            return inst == other.inst && pc == other.pc && upc == other.upc;
+        }
+    };
+
+    struct InstKeyHash
+    {
+        size_t
+        operator()(const InstKey &key) const
+        {
+            uint64_t hash = (uintptr_t)key.inst ^ (key.pc << 16) ^ key.upc;
+            hash *= 0x9e3779b97f4a7c15ULL;
+            return hash ^ (hash >> 32);
+        }
+    };
+
+    std::unordered_map<InstKey, uint32_t, InstKeyHash> instIds;
+    /**
+     * References to the instructions with an ID, so their addresses
+     * aren't reused by other instructions.
+     */
+    std::vector<StaticInstPtr> insts;
+
+    std::vector<BaseCPU *> cpus;
+
+    uint32_t format = ~0U;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __CPU_BINARY_EXETRACE_HH__
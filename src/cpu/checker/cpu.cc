@@ -67,8 +67,14 @@ CheckerCPU::CheckerCPU(const Params &p)
       systemPtr(NULL), icachePort(NULL), dcachePort(NULL),
       tc(NULL), thread(NULL),
       unverifiedReq(nullptr),
-      unverifiedMemData(nullptr)
+      unverifiedMemData(nullptr),
+      sampleWindow(p.sampleWindow), samplePeriod(p.samplePeriod),
+      sampleLeft(p.sampleWindow), sampleSkip(0),
+      sampleRng(name())
 {
+    fatal_if(sampleWindow && samplePeriod < sampleWindow,
+             "%s: samplePeriod must be at least sampleWindow.", name());
+
     curStaticInst = NULL;
     curMacroStaticInst = NULL;
 
@@ -92,6 +98,19 @@ CheckerCPU::~CheckerCPU()
 {
 }
 
+void
+CheckerCPU::sampleVerified()
+{
+    if (!sampleWindow || --sampleLeft > 0)
+        return;
+
+    // Spread the windows randomly, samplePeriod apart on average.
+    sampleSkip = sampleRng.random<unsigned>(
+            0, 2 * (samplePeriod - sampleWindow));
+    DPRINTF(Checker, "Sampling window over, skipping %d instructions\n",
+            sampleSkip);
+}
+
 void
 CheckerCPU::setSystem(System *system)
 {
@@ -154,7 +173,7 @@ CheckerCPU::genMemFragmentRequest(Addr frag_addr, int size,
                                                     size_left));
     auto it_end = byte_enable.cbegin() + (size - size_left);
     if (isAnyActiveElement(it_start, it_end)) {
-        mem_req = std::make_shared<Request>(frag_addr, frag_size,
+        mem_req = makeRequest(frag_addr, frag_size,
                 flags, requestorId, thread->pcState().instAddr(),
                 tc->contextId());
         mem_req->setByteEnable(std::vector<bool>(it_start, it_end));
@@ -47,6 +47,7 @@
 #include <queue>
 
 #include "arch/generic/pcstate.hh"
+#include "base/random.hh"
 #include "base/statistics.hh"
 #include "cpu/base.hh"
 #include "cpu/exec_context.hh"
@@ -435,6 +436,44 @@ class CheckerCPU : public BaseCPU, public ExecContext
     bool warnOnlyOnLoadError;
 
     InstSeqNum youngestSN;
+
+    /**
+     * Size of the sampled windows of instructions which are verified,
+     * 0 when every instruction is.
+     */
+    const unsigned sampleWindow;
+
+    /** Average distance between the starts of two windows. */
+    const unsigned samplePeriod;
+
+    /** Instructions left to verify in the current window. */
+    unsigned sampleLeft;
+
+    /** Instructions left to skip before the next window can start. */
+    unsigned sampleSkip;
+
+    /** Picks where the windows start. */
+    RandomStream sampleRng;
+
+    /**
+     * Count a verified instruction against the current window, and pick
+     * the number of instructions to skip once it is over.
+     */
+    void sampleVerified();
+
+    /**
+     * Make sure the instructions following a fault, an interrupt or a
+     * change of mode are verified: extend the current window, or start
+     * one as soon as possible if there is none.
+     */
+    void
+    sampleEvent()
+    {
+        if (sampleLeft > 0)
+            sampleLeft = sampleWindow;
+        else
+            sampleSkip = 0;
+    }
 };
 
 /**
@@ -467,6 +506,33 @@ class Checker : public CheckerCPU
     void handlePendingInt();
 
   private:
+    /**
+     * Tell whether an instruction falls between two sampling windows and
+     * shouldn't be verified. Once enough of them are skipped, the state
+     * of the main CPU is copied so that the next window starts in sync.
+     *
+     * @param inst The instruction about to be verified.
+     * @return true if the instruction is skipped.
+     */
+    bool skipInst(const DynInstPtr &inst);
+
+    /**
+     * Copy the architectural state of the main CPU.
+     *
+     * @param inst The instruction the state is taken at.
+     * @param after Whether the state is taken after the instruction,
+     * which then isn't verified, or before it.
+     */
+    void resync(const DynInstPtr &inst, bool after);
+
+    /** Whether an instruction may change the mode of the CPU. */
+    static bool
+    isModeChange(const DynInstPtr &inst)
+    {
+        return inst->isSerializing() || inst->isNonSpeculative() ||
+            inst->isSquashAfter() || inst->isSyscall();
+    }
+
     void
     handleError(const DynInstPtr &inst)
     {
@@ -112,6 +112,69 @@ Checker<DynInstPtr>::handlePendingInt()
     boundaryInst = NULL;
     thread->decoder->reset();
     curMacroStaticInst = nullStaticInstPtr;
+
+    // Verify the start of the handler.
+    if (sampleWindow)
+        sampleEvent();
+}
+
+template <class DynInstPtr>
+bool
+Checker<DynInstPtr>::skipInst(const DynInstPtr &inst)
+{
+    if (!sampleWindow || sampleLeft > 0)
+        return false;
+
+    // An instruction carrying a fault didn't change the state of the main
+    // CPU yet, so the checker can catch up and verify it.
+    if (inst->getFault() != NoFault) {
+        resync(inst, false);
+        sampleLeft = sampleWindow;
+        return false;
+    }
+
+    if (isModeChange(inst))
+        sampleEvent();
+    if (sampleSkip > 0)
+        sampleSkip--;
+
+    // The state of the main CPU matches this instruction only if it's
+    // the last one committed, and can be resumed from only at the
+    // boundary of a macroop.
+    if (sampleSkip == 0 && instList.empty() &&
+            (!inst->isMicroop() || inst->isLastMicroop())) {
+        resync(inst, true);
+        sampleLeft = sampleWindow;
+    }
+
+    DPRINTF(Checker, "Skipping instruction [sn:%lli] PC:%s.\n",
+            inst->seqNum, inst->pcState());
+    return true;
+}
+
+template <class DynInstPtr>
+void
+Checker<DynInstPtr>::resync(const DynInstPtr &inst, bool after)
+{
+    DPRINTF(Checker, "Copying the main CPU state %s [sn:%lli] PC:%s.\n",
+            after ? "after" : "before", inst->seqNum, inst->pcState());
+
+    // Same dance as validateState() to keep the O3 model from squashing
+    bool no_squash_from_TC = inst->thread->noSquashFromTC;
+    inst->thread->noSquashFromTC = true;
+    thread->copyArchRegs(inst->tcBase());
+    inst->thread->noSquashFromTC = no_squash_from_TC;
+
+    thread->decoder->reset();
+    curMacroStaticInst = nullStaticInstPtr;
+    changedPC = willChangePC = false;
+
+    if (after) {
+        // The main CPU advances its PC past the instruction once it's
+        // verified.
+        curStaticInst = inst->staticInst;
+        advancePC(NoFault);
+    }
 }
 
 template <class DynInstPtr>
@@ -189,6 +252,14 @@ Checker<DynInstPtr>::verify(const DynInstPtr &completed_inst)
     while (1) {
         DPRINTF(Checker, "Processing instruction [sn:%lli] PC:%s.\n",
                 unverifiedInst->seqNum, unverifiedInst->pcState());
+
+        if (skipInst(unverifiedInst)) {
+            if (instList.empty() || !instList.front()->isCompleted())
+                break;
+            unverifiedInst = instList.front();
+            instList.pop_front();
+            continue;
+        }
         unverifiedReq = NULL;
         unverifiedReq = unverifiedInst->reqToVerify;
         unverifiedMemData = unverifiedInst->memData;
@@ -230,7 +301,7 @@ Checker<DynInstPtr>::verify(const DynInstPtr &completed_inst)
             // If not in the middle of a macro instruction
             if (!curMacroStaticInst) {
                 // set up memory request for instruction fetch
-                auto mem_req = std::make_shared<Request>(
+                auto mem_req = makeRequest(
                     fetch_PC, decoder->moreBytesSize(), 0, requestorId,
                     fetch_PC, thread->contextId());
 
@@ -411,6 +482,14 @@ Checker<DynInstPtr>::verify(const DynInstPtr &completed_inst)
         // that have been modified).
         validateState();
 
+        // Keep verifying around faults and changes of mode.
+        if (sampleWindow) {
+            if (unverifiedInst->getFault() != NoFault ||
+                    isModeChange(unverifiedInst))
+                sampleLeft = sampleWindow;
+            sampleVerified();
+        }
+
         // Continue verifying instructions if there's another completed
         // instruction waiting to be verified.
         if (instList.empty()) {
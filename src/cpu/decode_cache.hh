@@ -29,10 +29,17 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
 #include <unordered_map>
 
 #include "base/bitfield.hh"
 #include "base/compiler.hh"
+#include "base/intmath.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -135,6 +142,129 @@ class AddrMap
     }
 };
 
+/// A direct mapped, PC indexed cache of decoded instructions. Lookups
+/// only compare the address and machine instruction of a single entry,
+/// and hand out raw pointers so that no reference counting happens
+/// until the caller needs a StaticInstPtr. The entries don't own the
+/// instructions, it's up to the user to keep them alive, e.g. in an
+/// InstMap, for as long as they are in the cache.
+template <typename EMI, size_t Entries = 4096>
+class DirectMap
+{
+    static_assert(isPowerOf2(Entries),
+            "The number of entries must be a power of 2");
+
+    struct Entry
+    {
+        Addr addr = 0;
+        EMI machInst = {};
+        StaticInst *inst = nullptr;
+    };
+    std::array<Entry, Entries> entries;
+
+    // Instructions are at least two bytes apart on all the ISAs which
+    // use this cache, so ignore the least significant address bit.
+    static constexpr size_t
+    index(Addr addr)
+    {
+        return (addr >> 1) & (Entries - 1);
+    }
+
+  public:
+    /// Look up the instruction decoded from mach_inst at addr.
+    /// @retval The instruction, or nullptr if it isn't cached.
+    StaticInst *
+    lookup(Addr addr, const EMI &mach_inst) const
+    {
+        const Entry &entry = entries[index(addr)];
+        if (entry.inst && entry.addr == addr && entry.machInst == mach_inst)
+            return entry.inst;
+        return nullptr;
+    }
+
+    /// Cache an instruction, replacing whatever was at its index.
+    void
+    insert(Addr addr, const EMI &mach_inst, StaticInst *inst)
+    {
+        Entry &entry = entries[index(addr)];
+        entry.addr = addr;
+        entry.machInst = mach_inst;
+        entry.inst = inst;
+    }
+
+    /// Drop all entries.
+    void
+    clear()
+    {
+        entries.fill(Entry());
+    }
+};
+
+/// A map of decoded instructions shared by the decoders of all the CPUs
+/// in the process, which may be simulated by different threads. It is
+/// meant to sit behind the caches of each decoder, so it is only looked
+/// up on their misses, and lookups only take a shared lock.
+///
+/// Decoded instructions are never dropped. Their reference counts
+/// aren't atomic, so they are pinned when they are added.
+template <typename EMI>
+class SharedInstMap
+{
+  private:
+    mutable std::shared_mutex mutex;
+    InstMap<EMI> insts;
+
+  public:
+    /// Find the instruction decoded from mach_inst, or decode it with
+    /// decode() and share the result.
+    template <typename Decode>
+    StaticInstPtr
+    lookup(const EMI &mach_inst, Decode &&decode)
+    {
+        {
+            std::shared_lock<std::shared_mutex> guard(mutex);
+            auto iter = insts.find(mach_inst);
+            if (iter != insts.end())
+                return iter->second;
+        }
+
+        // Decode without the lock. If another thread decodes the same
+        // instruction in the meantime, its copy is the one kept.
+        auto si = decode();
+        std::unique_lock<std::shared_mutex> guard(mutex);
+        auto [iter, inserted] = insts.emplace(mach_inst, si);
+        if (inserted)
+            iter->second->pin();
+        return iter->second;
+    }
+
+    size_t
+    size() const
+    {
+        std::shared_lock<std::shared_mutex> guard(mutex);
+        return insts.size();
+    }
+
+    /// The map shared by the decoders with the same context, which
+    /// describes everything besides the machine instruction that
+    /// decoding depends on, e.g. the ISA and its configuration.
+    static SharedInstMap &
+    get(const std::string &context)
+    {
+        // The maps are never destroyed, as instructions may be in use
+        // until the very end.
+        static std::mutex registryMutex;
+        static auto *registry =
+            new std::map<std::string, std::unique_ptr<SharedInstMap>>;
+
+        std::lock_guard<std::mutex> guard(registryMutex);
+        auto &map = (*registry)[context];
+        if (!map)
+            map = std::make_unique<SharedInstMap>();
+        return *map;
+    }
+};
+
 } // namespace decode_cache
 } // namespace gem5
 
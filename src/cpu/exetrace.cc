@@ -77,24 +77,24 @@ ExeTracerRecord::traceInst(const StaticInstPtr &inst, bool ran)
 
     Addr cur_pc = pc->instAddr();
     loader::SymbolTable::const_iterator it;
-    ccprintf(outs, "%#x", cur_pc);
+    ccprintf(outs, GEM5_FORMAT("%#x"), cur_pc);
     if (debug::ExecSymbol && (!FullSystem || !in_user_mode) &&
             (it = loader::debugSymbolTable.findNearest(cur_pc)) !=
                 loader::debugSymbolTable.end()) {
         Addr delta = cur_pc - it->address();
         if (delta)
-            ccprintf(outs, " @%s+%d", it->name(), delta);
+            ccprintf(outs, GEM5_FORMAT(" @%s+%d"), it->name(), delta);
         else
-            ccprintf(outs, " @%s", it->name());
+            ccprintf(outs, GEM5_FORMAT(" @%s"), it->name());
     }
 
     if (inst->isMicroop()) {
-        ccprintf(outs, ".%2d", pc->microPC());
+        ccprintf(outs, GEM5_FORMAT(".%2d"), pc->microPC());
     } else {
-        ccprintf(outs, "   ");
+        outs << "   ";
     }
 
-    ccprintf(outs, " : ");
+    outs << " : ";
 
     //
     //  Print decoded instruction
@@ -116,9 +116,9 @@ ExeTracerRecord::traceInst(const StaticInstPtr &inst, bool ran)
 
         if (debug::ExecResult && dataStatus != DataInvalid) {
             if (dataStatus == DataReg)
-                ccprintf(outs, " D=%s", data.asReg.asString());
+                ccprintf(outs, GEM5_FORMAT(" D=%s"), data.asReg.asString());
             else
-                ccprintf(outs, " D=%#018x", data.asInt);
+                ccprintf(outs, GEM5_FORMAT(" D=%#018x"), data.asInt);
         }
 
         if (debug::ExecEffAddr && getMemValid())
@@ -143,7 +143,7 @@ ExeTracerRecord::traceInst(const StaticInstPtr &inst, bool ran)
     outs << std::endl;
 
     trace::getDebugLogger()->dprintf_flag(
-        when, thread->getCpuPtr()->name(), "ExecEnable", "%s",
+        when, thread->getCpuPtr()->name(), "ExecEnable", GEM5_FORMAT("%s"),
         outs.str().c_str());
 }
 
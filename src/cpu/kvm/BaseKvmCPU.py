@@ -69,6 +69,11 @@ class BaseKvmCPU(BaseCPU):
         "statistic-related functionalities",
     )
     useCoalescedMMIO = Param.Bool(False, "Use coalesced MMIO (EXPERIMENTAL)")
+    postDeviceWrites = Param.Bool(
+        False,
+        "Hand device writes over to the device event queue instead of "
+        "waiting for them, when the CPU has its own event queue",
+    )
     usePerfOverflow = Param.Bool(
         False, "Use perf event overflow counters (EXPERIMENTAL)"
     )
@@ -46,5 +46,10 @@ class KvmVM(SimObject):
     coalescedMMIO = VectorParam.AddrRange(
         [], "memory ranges for coalesced MMIO"
     )
+    coalescedPIO = VectorParam.AddrRange(
+        [],
+        "IO port ranges for coalesced port IO (e.g. a UART transmit "
+        "register), only writes are coalesced",
+    )
 
     system = Param.System(Parent.any, "system this VM belongs to")
@@ -77,6 +77,8 @@ BaseKvmCPU::BaseKvmCPU(const BaseKvmCPUParams &params)
       pageSize(sysconf(_SC_PAGE_SIZE)),
       tickEvent([this]{ tick(); }, "BaseKvmCPU tick",
                 false, Event::CPU_Tick_Pri),
+      postDeviceWrites(params.postDeviceWrites),
+      postedFlushScheduled(false),
       activeInstPeriod(0),
       hwCycles(nullptr),
       hwInstructions(nullptr),
@@ -174,6 +176,9 @@ BaseKvmCPU::startup()
     } else {
         inform("KVM: Coalesced not supported by host OS\n");
     }
+    fatal_if(!mmioRing && vm->hasCoalescedIO(),
+             "KVM: The VM coalesces IO, but %s doesn't flush the MMIO ring "
+             "buffer. Set useCoalescedMMIO.\n", name());
 
     schedule(new EventFunctionWrapper([this]{
                 restartEqThread();
@@ -290,6 +295,8 @@ BaseKvmCPU::StatGroup::StatGroup(statistics::Group *parent)
              "number of VM exits due to memory mapped IO"),
     ADD_STAT(numCoalescedMMIO, statistics::units::Count::get(),
              "number of coalesced memory mapped IO requests"),
+    ADD_STAT(numPostedIO, statistics::units::Count::get(),
+             "number of device writes performed asynchronously"),
     ADD_STAT(numIO, statistics::units::Count::get(),
              "number of VM exits due to legacy IO"),
     ADD_STAT(numHalt, statistics::units::Count::get(),
@@ -338,6 +345,13 @@ BaseKvmCPU::drain()
     // synchronize the thread context.
     std::lock_guard<EventQueue> lock(*this->eventQueue());
 
+    // Posted writes have to reach the devices before they are
+    // checkpointed.
+    {
+        EventQueue::ScopedMigration migrate(deviceEventQueue());
+        flushPostedWrites(false);
+    }
+
     switch (_status) {
       case Running:
         // The base KVM code is normally ready when it is in the
@@ -1110,13 +1124,20 @@ BaseKvmCPU::handleKvmExitFailEntry()
           _kvmRun->fail_entry.hardware_entry_failure_reason);
 }
 
+Tick
+BaseKvmCPU::handleCoalescedPIO(uint16_t port, void *data, int size)
+{
+    panic("KVM: Unhandled coalesced guest IO (port: 0x%x, size: %i)\n",
+          port, size);
+}
+
 Tick
 BaseKvmCPU::doMMIOAccess(Addr paddr, void *data, int size, bool write)
 {
     ThreadContext *tc(thread->getTC());
     syncThreadContext();
 
-    RequestPtr mmio_req = std::make_shared<Request>(
+    RequestPtr mmio_req = makeRequest(
         paddr, size, Request::UNCACHEABLE, dataRequestorId());
 
     mmio_req->setContext(tc->contextId());
@@ -1154,11 +1175,62 @@ BaseKvmCPU::doMMIOAccess(Addr paddr, void *data, int size, bool write)
         delete pkt;
         return clockPeriod() * ipr_delay;
     } else {
-        // Temporarily lock and migrate to the device event queue to
-        // prevent races in multi-core mode.
-        EventQueue::ScopedMigration migrate(deviceEventQueue());
+        return submitDeviceIO(pkt);
+    }
+}
+
+Tick
+BaseKvmCPU::submitDeviceIO(PacketPtr pkt)
+{
+    if (postDeviceWrites && pkt->isWrite() && system->isAtomicMode() &&
+            deviceEventQueue() != curEventQueue()) {
+        // The data of the request usually lives in the kvm_run
+        // structure, which is reused on the next exit.
+        PacketPtr posted = new Packet(pkt->req, pkt->cmd);
+        posted->allocate();
+        posted->setData(pkt->getConstPtr<uint8_t>());
+        delete pkt;
 
-        return dataPort.submitIO(pkt);
+        ++stats.numPostedIO;
+        std::lock_guard<std::mutex> posted_lock(postedLock);
+        postedWrites.push_back(posted);
+        if (!postedFlushScheduled) {
+            postedFlushScheduled = true;
+            // Events scheduled on another event queue must be at least
+            // one quantum in the future.
+            deviceEventQueue()->schedule(new EventFunctionWrapper(
+                        [this]{ flushPostedWrites(true); },
+                        name() + ".postedWrites", true),
+                    curTick() + simQuantum);
+        }
+        return 0;
+    }
+
+    // Temporarily lock and migrate to the device event queue to
+    // prevent races in multi-core mode.
+    EventQueue::ScopedMigration migrate(deviceEventQueue());
+
+    flushPostedWrites(false);
+    return dataPort.submitIO(pkt);
+}
+
+void
+BaseKvmCPU::flushPostedWrites(bool from_event)
+{
+    std::vector<PacketPtr> writes;
+    {
+        std::lock_guard<std::mutex> posted_lock(postedLock);
+        writes.swap(postedWrites);
+        // The scheduled event still runs if the writes are performed
+        // earlier, it is only rescheduled once it has.
+        if (from_event)
+            postedFlushScheduled = false;
+    }
+
+    for (auto pkt : writes) {
+        DPRINTF(KvmIO, "KVM: Performing posted write (addr: 0x%x)\n",
+                pkt->getAddr());
+        dataPort.submitIO(pkt);
     }
 }
 
@@ -1193,26 +1265,47 @@ BaseKvmCPU::ioctl(int request, long p1) const
     return ::ioctl(vcpuFD, request, p1);
 }
 
+/** Was a ring buffer entry written by an IO instruction? */
+static bool
+isCoalescedPIO(const struct kvm_coalesced_mmio &ent)
+{
+#ifdef KVM_CAP_COALESCED_PIO
+    return ent.pio;
+#else
+    return false;
+#endif
+}
+
 Tick
 BaseKvmCPU::flushCoalescedMMIO()
 {
     if (!mmioRing)
         return 0;
 
+    // The ring buffer is shared by all the vCPUs of the VM. Hold the
+    // lock until it is empty so that its writes are performed in
+    // order, even if other vCPUs exit at the same time.
+    std::lock_guard<std::mutex> ring_lock(vm->mmioRingLock);
+    if (mmioRing->first == mmioRing->last)
+        return 0;
+
     DPRINTF(KvmIO, "KVM: Flushing the coalesced MMIO ring buffer\n");
 
-    // TODO: We might need to do synchronization when we start to
-    // support multiple CPUs
     Tick ticks(0);
     while (mmioRing->first != mmioRing->last) {
         struct kvm_coalesced_mmio &ent(
             mmioRing->coalesced_mmio[mmioRing->first]);
 
-        DPRINTF(KvmIO, "KVM: Handling coalesced MMIO (addr: 0x%x, len: %u)\n",
-                ent.phys_addr, ent.len);
-
         ++stats.numCoalescedMMIO;
-        ticks += doMMIOAccess(ent.phys_addr, ent.data, ent.len, true);
+        if (isCoalescedPIO(ent)) {
+            DPRINTF(KvmIO, "KVM: Handling coalesced PIO "
+                    "(port: 0x%x, len: %u)\n", ent.phys_addr, ent.len);
+            ticks += handleCoalescedPIO(ent.phys_addr, ent.data, ent.len);
+        } else {
+            DPRINTF(KvmIO, "KVM: Handling coalesced MMIO "
+                    "(addr: 0x%x, len: %u)\n", ent.phys_addr, ent.len);
+            ticks += doMMIOAccess(ent.phys_addr, ent.data, ent.len, true);
+        }
 
         mmioRing->first = (mmioRing->first + 1) % KVM_COALESCED_MMIO_MAX;
     }
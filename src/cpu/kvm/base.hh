@@ -42,7 +42,9 @@
 
 #include <csignal>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "cpu/kvm/perfevent.hh"
@@ -468,6 +470,17 @@ class BaseKvmCPU : public BaseCPU
      */
     virtual Tick handleKvmExitIO();
 
+    /**
+     * Perform a legacy IO write which was coalesced in the MMIO ring
+     * buffer (see KvmVM::coalescePIO()).
+     *
+     * @param port IO port written to
+     * @param data Data written
+     * @param size Size of the access in bytes
+     * @return Number of ticks spent servicing the IO request
+     */
+    virtual Tick handleCoalescedPIO(uint16_t port, void *data, int size);
+
     /**
      * The guest requested a monitor service using a hypercall
      *
@@ -551,6 +564,20 @@ class BaseKvmCPU : public BaseCPU
      */
     Tick doMMIOAccess(Addr paddr, void *data, int size, bool write);
 
+    /**
+     * Send an IO request to the devices.
+     *
+     * The request is sent from the device event queue. When posting
+     * device writes, writes don't wait for the devices in that case:
+     * they are handed over to the device event queue and are performed
+     * by its thread one simulation quantum later, or before the next
+     * request of this CPU which isn't posted, whichever comes first.
+     *
+     * @param pkt Request to send, deleted in atomic mode
+     * @return Number of ticks spent servicing the request
+     */
+    Tick submitDeviceIO(PacketPtr pkt);
+
     /** @{ */
     /**
      * Set the signal mask used in kvmRun()
@@ -672,6 +699,14 @@ class BaseKvmCPU : public BaseCPU
      */
     Tick flushCoalescedMMIO();
 
+    /**
+     * Perform the posted device writes, in the order they were
+     * made. Must be called from the device event queue.
+     *
+     * @param from_event Called from the event handing the writes over.
+     */
+    void flushPostedWrites(bool from_event);
+
     /**
      * Setup a signal handler to catch the timer signal used to
      * switch back to the monitor.
@@ -727,6 +762,15 @@ class BaseKvmCPU : public BaseCPU
 
     EventFunctionWrapper tickEvent;
 
+    /** Post device writes when running in another event queue */
+    const bool postDeviceWrites;
+    /** Protects the posted writes, which are shared with the devices */
+    std::mutex postedLock;
+    /** Posted device writes which haven't been performed yet */
+    std::vector<PacketPtr> postedWrites;
+    /** Is an event handing the posted writes over scheduled? */
+    bool postedFlushScheduled;
+
     /**
      * Setup an instruction break if there is one pending.
      *
@@ -812,6 +856,7 @@ class BaseKvmCPU : public BaseCPU
         statistics::Scalar numExitSignal;
         statistics::Scalar numMMIO;
         statistics::Scalar numCoalescedMMIO;
+        statistics::Scalar numPostedIO;
         statistics::Scalar numIO;
         statistics::Scalar numHalt;
         statistics::Scalar numInterrupts;
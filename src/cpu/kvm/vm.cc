@@ -46,8 +46,10 @@
 #include <unistd.h>
 
 #include <cerrno>
+#include <cstring>
 #include <memory>
 
+#include "base/intmath.hh"
 #include "cpu/kvm/base.hh"
 #include "debug/Kvm.hh"
 #include "mem/physical.hh"
@@ -138,6 +140,16 @@ Kvm::capCoalescedMMIO() const
     return checkExtension(KVM_CAP_COALESCED_MMIO);
 }
 
+bool
+Kvm::capCoalescedPIO() const
+{
+#ifdef KVM_CAP_COALESCED_PIO
+    return checkExtension(KVM_CAP_COALESCED_PIO) != 0;
+#else
+    return false;
+#endif
+}
+
 int
 Kvm::capNumMemSlots() const
 {
@@ -319,6 +331,7 @@ KvmVM::KvmVM(const KvmVMParams &params)
       vmFD(kvm->createVM()),
       started(false),
       _hasKernelIRQChip(false),
+      _hasCoalescedIO(false),
       nextVCPUID(0)
 {
     system->setKvmVM(this);
@@ -329,6 +342,8 @@ KvmVM::KvmVM(const KvmVMParams &params)
     /* Setup the coalesced MMIO regions */
     for (int i = 0; i < params.coalescedMMIO.size(); ++i)
         coalesceMMIO(params.coalescedMMIO[i]);
+    for (const auto &range : params.coalescedPIO)
+        coalescePIO(range);
 }
 
 KvmVM::~KvmVM()
@@ -367,8 +382,10 @@ KvmVM::cpuStartup()
 void
 KvmVM::delayedStartup()
 {
+    memory::PhysicalMemory &physmem = system->getPhysMem();
     const std::vector<memory::BackingStoreEntry> &memories(
-        system->getPhysMem().getBackingStore());
+        physmem.getBackingStore());
+    const bool log_dirty = physmem.tracksDirtyPages();
 
     DPRINTF(Kvm, "Mapping %i memory region(s)\n", memories.size());
     for (int slot(0); slot < memories.size(); ++slot) {
@@ -390,12 +407,51 @@ KvmVM::delayedStartup()
             }
 
             const MemSlot slot = allocMemSlot(range.size());
-            setupMemSlot(slot, pmem, range.start(), 0/* flags */);
+            setupMemSlot(slot, pmem, range.start(),
+                         log_dirty ? KVM_MEM_LOG_DIRTY_PAGES : 0);
+            if (log_dirty) {
+                dirtyLogSlots.push_back(
+                    {(uint32_t)slot.num, (uint8_t *)pmem, range.size()});
+            }
         } else {
             DPRINTF(Kvm, "Zero-region not mapped: [0x%llx]\n", range.start());
             hack("KVM: Zero memory handled as IO\n");
         }
     }
+
+    if (log_dirty)
+        physmem.addDirtyPageSource([this]() { collectDirtyLog(); });
+}
+
+void
+KvmVM::collectDirtyLog()
+{
+    const uint64_t page_size = sysconf(_SC_PAGE_SIZE);
+    memory::PhysicalMemory &physmem = system->getPhysMem();
+
+    for (const auto &s : dirtyLogSlots) {
+        const uint64_t num_pages = divCeil(s.size, page_size);
+        std::vector<uint64_t> bitmap(divCeil(num_pages, 64));
+
+        struct kvm_dirty_log log;
+        memset(&log, 0, sizeof(log));
+        log.slot = s.slot;
+        log.dirty_bitmap = bitmap.data();
+        if (ioctl(KVM_GET_DIRTY_LOG, (void *)&log) == -1)
+            panic("KVM: Failed to get the dirty log of slot %i (%i)\n",
+                  s.slot, errno);
+
+        uint64_t num_dirty = 0;
+        for (uint64_t word = 0; word < bitmap.size(); ++word) {
+            for (uint64_t bits = bitmap[word]; bits; bits &= bits - 1) {
+                const uint64_t page = word * 64 + ctz64(bits);
+                physmem.markDirty(s.pmem + page * page_size, page_size);
+                ++num_dirty;
+            }
+        }
+        DPRINTF(Kvm, "KVM: %i of %i pages of slot %i written by the guest\n",
+                num_dirty, num_pages, s.slot);
+    }
 }
 
 const KvmVM::MemSlot
@@ -497,6 +553,37 @@ KvmVM::coalesceMMIO(Addr start, int size)
     if (ioctl(KVM_REGISTER_COALESCED_MMIO, (void *)&zone) == -1)
         panic("KVM: Failed to register coalesced MMIO region (%i)\n",
               errno);
+    _hasCoalescedIO = true;
+}
+
+void
+KvmVM::coalescePIO(const AddrRange &range)
+{
+    coalescePIO(range.start(), range.size());
+}
+
+void
+KvmVM::coalescePIO(Addr start, int size)
+{
+#ifdef KVM_CAP_COALESCED_PIO
+    if (!kvm->capCoalescedPIO())
+        fatal("KVM: Coalesced PIO not supported by host OS\n");
+
+    struct kvm_coalesced_mmio_zone zone;
+
+    zone.addr = start;
+    zone.size = size;
+    zone.pio = 1;
+
+    DPRINTF(Kvm, "KVM: Registering coalesced PIO region [0x%x, 0x%x]\n",
+            zone.addr, zone.addr + zone.size - 1);
+    if (ioctl(KVM_REGISTER_COALESCED_MMIO, (void *)&zone) == -1)
+        panic("KVM: Failed to register coalesced PIO region (%i)\n",
+              errno);
+    _hasCoalescedIO = true;
+#else
+    fatal("KVM: Coalesced PIO not supported by the kernel headers\n");
+#endif
 }
 
 void
@@ -39,6 +39,7 @@
 #ifndef __CPU_KVM_KVMVM_HH__
 #define __CPU_KVM_KVMVM_HH__
 
+#include <mutex>
 #include <vector>
 
 #include "base/addr_range.hh"
@@ -114,6 +115,12 @@ class Kvm
      */
     int capCoalescedMMIO() const;
 
+    /**
+     * Support for coalescing writes to IO ports in the MMIO ring
+     * buffer (see KvmVM::coalescePIO()).
+     */
+    bool capCoalescedPIO() const;
+
     /**
      * Attempt to determine how many memory slots are available. If it can't
      * be determined, this function returns 0.
@@ -333,6 +340,32 @@ class KvmVM : public SimObject
     void coalesceMMIO(const AddrRange &range);
     /** @} */
 
+    /** @{ */
+    /**
+     * Request coalescing writes to a range of IO ports.
+     *
+     * @note This functionality depends on Kvm::capCoalescedPIO().
+     *
+     * @param start First IO port of the range
+     * @param size Number of IO ports in the range
+     */
+    void coalescePIO(Addr start, int size);
+
+    /**
+     * Request coalescing writes to a range of IO ports.
+     *
+     * @param range Coalesced IO port range
+     */
+    void coalescePIO(const AddrRange &range);
+    /** @} */
+
+    /**
+     * Are writes to any memory or IO port range coalesced? If so, the
+     * vCPUs have to flush the MMIO ring buffer or the writes would be
+     * lost.
+     */
+    bool hasCoalescedIO() const { return _hasCoalescedIO; }
+
     /**
      * @addtogroup KvmInterrupts
      * @{
@@ -469,6 +502,13 @@ class KvmVM : public SimObject
      */
     void delayedStartup();
 
+    /**
+     * Report the pages written by the guest since the last call to
+     * the physical memory, for incremental checkpoints. This uses the
+     * dirty log of the memory slots.
+     */
+    void collectDirtyLog();
+
 
     /** @{ */
     /**
@@ -542,6 +582,15 @@ class KvmVM : public SimObject
     /** Do we have in-kernel IRQ-chip emulation enabled? */
     bool _hasKernelIRQChip;
 
+    /** Has a coalesced MMIO or PIO region been registered? */
+    bool _hasCoalescedIO;
+
+    /**
+     * The MMIO ring buffer is shared by all the vCPUs of the VM, this
+     * serializes flushing it.
+     */
+    std::mutex mmioRingLock;
+
     /** Next unallocated vCPU ID */
     long nextVCPUID;
 
@@ -557,6 +606,15 @@ class KvmVM : public SimObject
     };
     std::vector<MemorySlot> memorySlots;
     uint32_t maxMemorySlot;
+
+    /** Memory slots logging the pages written by the guest */
+    struct DirtyLogSlot
+    {
+        uint32_t slot;
+        uint8_t *pmem;
+        uint64_t size;
+    };
+    std::vector<DirtyLogSlot> dirtyLogSlots;
 };
 
 } // namespace gem5
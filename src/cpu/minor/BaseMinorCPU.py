@@ -438,6 +438,12 @@ class BaseMinorCPU(BaseCPU):
         TournamentBP(numThreads=Parent.numThreads), "Branch Predictor"
     )
 
+    pipe_tracer = Param.PipeTracer(
+        NULL,
+        "Binary recorder of the pipeline stages of the committed "
+        "instructions",
+    )
+
     def addCheckerCpu(self):
         print("Checker not yet supported by MinorCPU")
         exit(1)
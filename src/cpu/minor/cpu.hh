@@ -49,6 +49,7 @@
 #include "cpu/base.hh"
 #include "cpu/minor/activity.hh"
 #include "cpu/minor/stats.hh"
+#include "cpu/pipe_tracer.hh"
 #include "cpu/simple_thread.hh"
 #include "enums/ThreadPolicy.hh"
 #include "params/BaseMinorCPU.hh"
@@ -117,6 +118,9 @@ class MinorCPU : public BaseCPU
 
     /** Thread Scheduling Policy (RoundRobin, Random, etc) */
     enums::ThreadPolicy threadPolicy;
+
+    /** Records the pipeline stages of committed instructions, if set */
+    PipeTracer *pipeTracer;
   protected:
      /** Return a reference to the data port. */
     Port &getDataPort() override;
@@ -236,6 +236,8 @@ Decode::evaluate()
                 /* Add tracing */
 #if TRACING_ON
                 dynInstAddTracing(output_inst, parent_static_inst, cpu);
+                output_inst->fetchTick = inst->fetchTick;
+                output_inst->decodeTick = curTick();
 #endif
 
                 /* Step to next sequence number */
@@ -337,6 +339,13 @@ Decode::isDrained()
     return (*inp.outputWire).isBubble();
 }
 
+bool
+Decode::isIdle()
+{
+    return cpu.threadPolicy != enums::Random &&
+        isDrained();
+}
+
 void
 Decode::minorTrace() const
 {
@@ -156,6 +156,12 @@ class Decode : public Named
      *  into Decode and on to Execute which is responsible for
      *  actually killing instructions */
     bool isDrained();
+
+    /** Is there nothing for this stage to do this cycle?  If so, the
+     *  pipeline skips evaluate() for it.  With the Random thread policy
+     *  the stage is always evaluated as picking a thread draws a random
+     *  number */
+    bool isIdle();
 };
 
 } // namespace minor
@@ -236,6 +236,14 @@ class MinorDynInst : public RefCounted
      *  up */
     std::vector<RegId> flatDestRegIdx;
 
+#if TRACING_ON
+    /** When the instruction went through each stage, for the PipeTracer.
+     *  The microops of a macroop are all fetched with it */
+    Tick fetchTick = 0;
+    Tick decodeTick = 0;
+    Tick issueTick = 0;
+#endif
+
   public:
     MinorDynInst(StaticInstPtr si, InstId id_=InstId(), Fault fault_=NoFault) :
         staticInst(si), id(id_), fault(fault_), translationFault(NoFault),
@@ -775,6 +775,11 @@ Execute::issue(ThreadID thread_id)
         }
 
         if (issued) {
+#if TRACING_ON
+            if (inst->isInst())
+                inst->issueTick = curTick();
+#endif
+
             /* Generate MinorTrace's MinorInst lines.  Do this at commit
              *  to allow better instruction annotation? */
             if (debug::MinorTrace && !inst->isBubble()) {
@@ -882,6 +887,20 @@ Execute::doInstCommitAccounting(MinorDynInstPtr inst)
         inst->traceData->setCPSeq(thread->numOp);
 
     cpu.probeInstCommit(inst->staticInst, inst->pc->instAddr());
+
+#if TRACING_ON
+    if (cpu.pipeTracer &&
+        cpu.pipeTracer->accepts(inst->id.execSeqNum, inst->pc->instAddr()))
+    {
+        PipeTracer::StageTicks ticks = {};
+        ticks[PipeTracer::Fetch] = inst->fetchTick;
+        ticks[PipeTracer::Decode] = inst->decodeTick;
+        ticks[PipeTracer::Issue] = inst->issueTick;
+        ticks[PipeTracer::Retire] = curTick();
+        cpu.pipeTracer->record(inst->id.execSeqNum, *inst->pc,
+            inst->staticInst, ticks);
+    }
+#endif
 }
 
 bool
@@ -400,6 +400,9 @@ Fetch2::evaluate()
                     /* Make a new instruction and pick up the line, stream,
                      *  prediction, thread ids from the incoming line */
                     dyn_inst = new MinorDynInst(decoded_inst, line_in->id);
+#if TRACING_ON
+                    dyn_inst->fetchTick = curTick();
+#endif
 
                     /* Fetch and prediction sequence numbers originate here */
                     dyn_inst->id.fetchSeqNum = fetch_info.fetchSeqNum;
@@ -627,6 +630,14 @@ Fetch2::Fetch2Stats::Fetch2Stats(MinorCPU *cpu)
             .flags(statistics::total);
 }
 
+bool
+Fetch2::isIdle()
+{
+    return cpu.threadPolicy != enums::Random &&
+        (*branchInp.outputWire).isBubble() &&
+        isDrained();
+}
+
 void
 Fetch2::minorTrace() const
 {
@@ -218,6 +218,12 @@ class Fetch2 : public Named
      *  Execute halting Fetch1 causing Fetch2 to naturally drain.
      *  Branch predictions are ignored by Fetch1 during halt */
     bool isDrained();
+
+    /** Is there nothing for this stage to do this cycle?  If so, the
+     *  pipeline skips evaluate() for it.  With the Random thread policy
+     *  the stage is always evaluated as picking a thread draws a random
+     *  number */
+    bool isIdle();
 };
 
 } // namespace minor
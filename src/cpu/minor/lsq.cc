@@ -71,7 +71,7 @@ LSQ::LSQRequest::LSQRequest(LSQ &port_, MinorDynInstPtr inst_, bool isLoad_,
     isTranslationDelayed(false),
     state(NotIssued)
 {
-    request = std::make_shared<Request>();
+    request = makeRequest();
 }
 
 void
@@ -493,7 +493,7 @@ LSQ::SplitDataRequest::makeFragmentRequests()
             }
         }
 
-        RequestPtr fragment = std::make_shared<Request>();
+        RequestPtr fragment = makeRequest();
         bool disabled_fragment = false;
 
         fragment->setContext(request->contextId());
@@ -131,8 +131,12 @@ Pipeline::evaluate()
      *  'immediate', 0-time-offset TimeBuffer activity to be visible from
      *  later stages to earlier ones in the same cycle */
     execute.evaluate();
-    decode.evaluate();
-    fetch2.evaluate();
+    /* Decode and Fetch2 only act on their inputs, so don't bother
+     *  evaluating them when they have none */
+    if (!decode.isIdle())
+        decode.evaluate();
+    if (!fetch2.isIdle())
+        fetch2.evaluate();
     fetch1.evaluate();
 
     if (debug::MinorTrace)
@@ -106,6 +106,16 @@ class BaseO3CPU(BaseCPU):
     commitToRenameDelay = Param.Cycles(1, "Commit to rename delay")
     decodeToRenameDelay = Param.Cycles(1, "Decode to rename delay")
     renameWidth = Param.Unsigned(8, "Rename width")
+    renameBitmapFreeList = Param.Bool(
+        False,
+        "Keep the free physical registers in bitmaps rather than FIFO "
+        "queues",
+    )
+    numRenameCheckpoints = Param.Unsigned(
+        0,
+        "Number of rename map checkpoints taken at control instructions "
+        "to recover from squashes, 0 to always undo the rename history",
+    )
 
     commitToIEWDelay = Param.Cycles(
         1, "Commit to Issue/Execute/Writeback delay"
@@ -191,3 +201,7 @@ class BaseO3CPU(BaseCPU):
         TournamentBP(numThreads=Parent.numThreads), "Branch Predictor"
     )
     needsTSO = Param.Bool(False, "Enable TSO Memory model")
+
+    pipe_tracer = Param.PipeTracer(
+        NULL, "Binary recorder of the pipeline stages of the instructions"
+    )
@@ -94,7 +94,8 @@ CPU::CPU(const BaseO3CPUParams &params)
               params.numPhysCCRegs,
               params.isa[0]->regClasses()),
 
-      freeList(name() + ".freelist", &regFile),
+      freeList(name() + ".freelist", &regFile,
+               params.renameBitmapFreeList),
 
       rob(this, params),
 
@@ -113,6 +114,7 @@ CPU::CPU(const BaseO3CPUParams &params)
 
       globalSeqNum(1),
       system(params.system),
+      pipeTracer(params.pipe_tracer),
       lastRunningCycle(curCycle()),
       cpuStats(this)
 {
@@ -143,6 +145,12 @@ CPU::CPU(const BaseO3CPUParams &params)
         tids.resize(numThreads);
     }
 
+    // Keep enough instruction buffers around for a full ROB and fetch
+    // queue so that wrong-path fetch and squashes recycle them rather
+    // than going back to the heap.
+    DynInst::reserveRecycled(params.numROBEntries +
+                             params.numThreads * params.fetchQueueSize);
+
     // The stages also need their CPU pointer setup.  However this
     // must be done at the upper level CPU because they have pointers
     // to the upper level CPU, and not this CPU.
@@ -1457,7 +1465,7 @@ CPU::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
     RequestPtr req =
-        std::make_shared<Request>(addr, size, flags, _dataRequestorId);
+        makeRequest(addr, size, flags, _dataRequestorId);
 
     req->taskId(taskId());
     req->setContext(thread[tid]->contextId());
@@ -65,6 +65,7 @@
 #include "cpu/o3/thread_state.hh"
 #include "cpu/activity.hh"
 #include "cpu/base.hh"
+#include "cpu/pipe_tracer.hh"
 #include "cpu/simple_thread.hh"
 #include "cpu/timebuf.hh"
 #include "params/BaseO3CPU.hh"
@@ -278,6 +279,12 @@ class CPU : public BaseCPU
     /** Takes over from another CPU. */
     void takeOverFrom(BaseCPU *oldCPU) override;
 
+    branch_prediction::BPredUnit *
+    getBranchPredictor() const override
+    {
+        return fetch.getBranchPredictor();
+    }
+
     void verifyMemoryMode() const override;
 
     /** Get the current instruction sequence number, and increment it. */
@@ -529,6 +536,9 @@ class CPU : public BaseCPU
     /** Pointer to the system. */
     System *system;
 
+    /** Records the pipeline stages of the instructions, if set. */
+    PipeTracer *pipeTracer;
+
     /** Pointers to all of the threads in the CPU. */
     std::vector<ThreadState *> thread;
 
@@ -41,6 +41,8 @@
 #include "cpu/o3/dyn_inst.hh"
 
 #include <algorithm>
+#include <cstddef>
+#include <vector>
 
 #include "base/intmath.hh"
 #include "debug/DynInst.hh"
@@ -53,6 +55,81 @@ namespace gem5
 namespace o3
 {
 
+namespace
+{
+
+/**
+ * Free lists of DynInst buffers. As the size of a buffer depends on the
+ * number of operands of the instruction, buffers are binned by size in
+ * units of the header that precedes each of them. The header records
+ * the bin so that a buffer can be returned without knowing the size of
+ * the instruction it held.
+ */
+class DynInstPool
+{
+  public:
+    static constexpr size_t HeaderSize = alignof(std::max_align_t);
+
+    /** Maximum number of buffers kept in each bin. */
+    static inline size_t capacity = 0;
+
+    void *
+    allocate(size_t size)
+    {
+        const size_t bin = divCeil(size, HeaderSize);
+
+        uint8_t *buf;
+        if (bin < bins.size() && !bins[bin].empty()) {
+            buf = bins[bin].back();
+            bins[bin].pop_back();
+        } else {
+            buf = (uint8_t *)::operator new((bin + 1) * HeaderSize);
+            *(size_t *)buf = bin;
+        }
+
+        return buf + HeaderSize;
+    }
+
+    void
+    release(void *ptr)
+    {
+        uint8_t *buf = (uint8_t *)ptr - HeaderSize;
+        const size_t bin = *(size_t *)buf;
+
+        if (bin >= bins.size())
+            bins.resize(bin + 1);
+
+        if (bins[bin].size() < capacity)
+            bins[bin].push_back(buf);
+        else
+            ::operator delete(buf);
+    }
+
+  private:
+    std::vector<std::vector<uint8_t *>> bins;
+};
+
+/*
+ * Instructions are only ever created and destroyed by the thread
+ * simulating their CPU, so every simulation thread gets its own pool.
+ * The pool is deliberately never destroyed as instructions may still be
+ * released during exit.
+ */
+DynInstPool &
+dynInstPool()
+{
+    thread_local DynInstPool *pool = new DynInstPool;
+    return *pool;
+}
+
+} // anonymous namespace
+
+void
+DynInst::reserveRecycled(size_t count)
+{
+    DynInstPool::capacity += count;
+}
+
 DynInst::DynInst(const Arrays &arrays, const StaticInstPtr &static_inst,
         const StaticInstPtr &_macroop, InstSeqNum seq_num, CPU *_cpu)
     : seqNum(seq_num), staticInst(static_inst), cpu(_cpu),
@@ -110,7 +187,9 @@ DynInst::DynInst(const Arrays &arrays, const StaticInstPtr &_staticInst,
  * This custom "new" operator uses the default "new" operator to allocate space
  * for a DynInst, but also pads out the number of bytes to make room for some
  * extra structures the DynInst needs. We save time and improve performance by
- * only going to the heap once to get space for all these structures.
+ * only going to the heap once to get space for all these structures. The
+ * buffers are recycled through a free list when instructions are destroyed,
+ * so in steady state fetching an instruction doesn't touch the heap at all.
  *
  * When a DynInst is allocated with new, the compiler will call this "new"
  * operator with "count" set to the number of bytes it needs to store the
@@ -168,7 +247,7 @@ DynInst::operator new(size_t count, Arrays &arrays)
     size_t total_size = ready_src_idx + ready_src_idx_size;
 
     // Actually allocate it.
-    uint8_t *buf = (uint8_t *)::operator new(total_size);
+    uint8_t *buf = (uint8_t *)dynInstPool().allocate(total_size);
 
     // Fill in "arrays" with pointers to all the arrays.
     arrays.flatDestIdx = (RegId *)(buf + flat_dest_idx);
@@ -189,11 +268,12 @@ DynInst::operator new(size_t count, Arrays &arrays)
 
 // Because of the custom "new" operator that allocates more bytes than the
 // size of the DynInst object, AddressSanitizer throw new-delete-type-mismatch.
-// Adding a custom delete function is enough to shut down this false positive
+// The custom delete function, which hands the buffer back to the pool, is
+// also enough to shut down this false positive
 void
 DynInst::operator delete(void *ptr)
 {
-    ::operator delete(ptr);
+    dynInstPool().release(ptr);
 }
 
 DynInst::~DynInst()
@@ -249,6 +329,23 @@ DynInst::~DynInst()
                     val, valS);
         }
     }
+
+    PipeTracer *pipe_tracer = cpu->pipeTracer;
+    if (pipe_tracer && fetchTick != -1 &&
+            pipe_tracer->accepts(seqNum, pcState().instAddr())) {
+        auto stage = [this](int32_t delta)
+            { return delta == -1 ? 0 : fetchTick + delta; };
+        PipeTracer::StageTicks ticks = {};
+        ticks[PipeTracer::Fetch] = fetchTick;
+        ticks[PipeTracer::Decode] = stage(decodeTick);
+        ticks[PipeTracer::Rename] = stage(renameTick);
+        ticks[PipeTracer::Dispatch] = stage(dispatchTick);
+        ticks[PipeTracer::Issue] = stage(issueTick);
+        ticks[PipeTracer::Complete] = stage(completeTick);
+        ticks[PipeTracer::Retire] = stage(commitTick);
+        ticks[PipeTracer::Store] = stage(storeTick);
+        pipe_tracer->record(seqNum, pcState(), staticInst, ticks);
+    }
 #endif
 
     delete [] memData;
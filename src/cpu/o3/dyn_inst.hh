@@ -97,6 +97,13 @@ class DynInst : public ExecContext, public RefCounted
     static void *operator new(size_t count, Arrays &arrays);
     static void  operator delete(void* ptr);
 
+    /**
+     * Allow up to count more instruction buffers of each size to be
+     * kept for reuse instead of being returned to the heap. Each CPU
+     * reserves enough to cover the instructions it can have in flight.
+     */
+    static void reserveRecycled(size_t count);
+
     /** BaseDynInst constructor given a binary instruction. */
     DynInst(const Arrays &arrays, const StaticInstPtr &staticInst,
             const StaticInstPtr &macroop, InstSeqNum seq_num, CPU *cpu);
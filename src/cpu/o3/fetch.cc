@@ -558,7 +558,7 @@ Fetch::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
     // Setup the memReq to do a read of the first instruction's address.
     // Set the appropriate read size and flags as well.
     // Build request here.
-    RequestPtr mem_req = std::make_shared<Request>(
+    RequestPtr mem_req = makeRequest(
         fetchBufferBlockPC, fetchBufferSize,
         Request::INST_FETCH, cpu->instRequestorId(), pc,
         cpu->thread[tid]->contextId());
@@ -1254,7 +1254,9 @@ Fetch::fetch(bool &status_change)
             numInst++;
 
 #if TRACING_ON
-            if (debug::O3PipeView) {
+            if (debug::O3PipeView || (cpu->pipeTracer &&
+                        cpu->pipeTracer->accepts(instruction->seqNum,
+                            this_pc.instAddr()))) {
                 instruction->fetchTick = curTick();
             }
 #endif
@@ -244,6 +244,13 @@ class Fetch
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
+    /** Returns the branch predictor used by fetch. */
+    branch_prediction::BPredUnit *
+    getBranchPredictor() const
+    {
+        return branchPred;
+    }
+
     /**
      * Stall the fetch stage after reaching a safe drain point.
      *
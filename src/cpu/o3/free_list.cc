@@ -39,11 +39,14 @@ namespace o3
 {
 
 UnifiedFreeList::UnifiedFreeList(const std::string &_my_name,
-                                 PhysRegFile *_regFile)
+                                 PhysRegFile *_regFile, bool bitmap)
     : _name(_my_name), regFile(_regFile)
 {
     DPRINTF(FreeList, "Creating new free list object.\n");
 
+    for (auto &free_list: freeLists)
+        free_list.useBitmap = bitmap;
+
     // Have the register file initialize the free list since it knows
     // about its internal organization
     regFile->initFreeList(this);
@@ -44,9 +44,12 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <iostream>
 #include <queue>
+#include <vector>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/o3/comm.hh"
@@ -75,36 +78,88 @@ class SimpleFreeList
     /** The actual free list */
     std::queue<PhysRegIdPtr> freeRegs;
 
+    /**
+     * Whether free registers are kept in freeBits instead, in which case
+     * the free register with the lowest index is handed out first.
+     */
+    bool useBitmap = false;
+
+    /** One bit per register index, set if the register is free. */
+    std::vector<uint64_t> freeBits;
+
+    /** The registers of the list, by index. */
+    std::vector<PhysRegIdPtr> regs;
+
+    /** Number of set bits in freeBits. */
+    unsigned numFree = 0;
+
+    void
+    setFree(PhysRegIdPtr reg)
+    {
+        const size_t idx = reg->index();
+        if (idx >= regs.size()) {
+            regs.resize(idx + 1, nullptr);
+            freeBits.resize((idx + 64) / 64, 0);
+        }
+        assert(!regs[idx] || regs[idx] == reg);
+        assert(!bits(freeBits[idx / 64], idx % 64));
+        regs[idx] = reg;
+        freeBits[idx / 64] |= 1ULL << (idx % 64);
+        numFree++;
+    }
+
+    friend class UnifiedFreeList;
+
   public:
 
     SimpleFreeList() {};
 
     /** Add a physical register to the free list */
-    void addReg(PhysRegIdPtr reg) { freeRegs.push(reg); }
+    void
+    addReg(PhysRegIdPtr reg)
+    {
+        if (useBitmap)
+            setFree(reg);
+        else
+            freeRegs.push(reg);
+    }
 
     /** Add physical registers to the free list */
     template<class InputIt>
     void
     addRegs(InputIt first, InputIt last) {
         std::for_each(first, last, [this](typename InputIt::value_type& reg) {
-            freeRegs.push(&reg);
+            addReg(&reg);
         });
     }
 
     /** Get the next available register from the free list */
     PhysRegIdPtr getReg()
     {
-        assert(!freeRegs.empty());
+        assert(hasFreeRegs());
+        if (useBitmap) {
+            size_t word = 0;
+            while (!freeBits[word])
+                word++;
+            const int bit = findLsbSet(freeBits[word]);
+            freeBits[word] &= ~(1ULL << bit);
+            numFree--;
+            return regs[word * 64 + bit];
+        }
         PhysRegIdPtr free_reg = freeRegs.front();
         freeRegs.pop();
         return free_reg;
     }
 
     /** Return the number of free registers on the list. */
-    unsigned numFreeRegs() const { return freeRegs.size(); }
+    unsigned
+    numFreeRegs() const
+    {
+        return useBitmap ? numFree : freeRegs.size();
+    }
 
     /** True iff there are free registers on the list. */
-    bool hasFreeRegs() const { return !freeRegs.empty(); }
+    bool hasFreeRegs() const { return numFreeRegs() != 0; }
 };
 
 
@@ -152,8 +207,10 @@ class UnifiedFreeList
      *  @param _numPhysicalFloatRegs Number of physical fp registers.
      *  @param reservedFloatRegs Number of fp registers already
      *                           used by initial mappings.
+     *  @param bitmap Whether to keep free registers in bitmaps.
      */
-    UnifiedFreeList(const std::string &_my_name, PhysRegFile *_regFile);
+    UnifiedFreeList(const std::string &_my_name, PhysRegFile *_regFile,
+                    bool bitmap=false);
 
     /** Gives the name of the freelist. */
     std::string name() const { return _name; };
@@ -44,6 +44,7 @@
 #include <limits>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "cpu/o3/dyn_inst.hh"
 #include "cpu/o3/fu_pool.hh"
@@ -418,11 +419,9 @@ InstructionQueue::resetState()
     for (int i = 0; i < Num_OpClasses; ++i) {
         while (!readyInsts[i].empty())
             readyInsts[i].pop();
-        queueOnList[i] = false;
-        readyIt[i] = listOrder.end();
     }
+    readyClasses.fill(0);
     nonSpecInsts.clear();
-    listOrder.clear();
     deferredMemInsts.clear();
     blockedMemInsts.clear();
     retryMemInsts.clear();
@@ -546,12 +545,8 @@ InstructionQueue::isFull(ThreadID tid)
 bool
 InstructionQueue::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
-        return true;
-    }
-
-    for (int i = 0; i < Num_OpClasses; ++i) {
-        if (!readyInsts[i].empty()) {
+    for (auto word : readyClasses) {
+        if (word) {
             return true;
         }
     }
@@ -675,54 +670,47 @@ InstructionQueue::getInstToExecute()
 }
 
 void
-InstructionQueue::addToOrderList(OpClass op_class)
+InstructionQueue::pushReadyInst(const DynInstPtr &inst)
 {
-    assert(!readyInsts[op_class].empty());
+    OpClass op_class = inst->opClass();
 
-    ListOrderEntry queue_entry;
-
-    queue_entry.queueType = op_class;
-
-    queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
-
-    ListOrderIt list_it = listOrder.begin();
-    ListOrderIt list_end_it = listOrder.end();
-
-    while (list_it != list_end_it) {
-        if ((*list_it).oldestInst > queue_entry.oldestInst) {
-            break;
-        }
+    readyInsts[op_class].push(inst);
+    readyClasses[op_class / 64] |= 1ULL << (op_class % 64);
+}
 
-        list_it++;
-    }
+void
+InstructionQueue::popReadyInst(OpClass op_class)
+{
+    assert(!readyInsts[op_class].empty());
 
-    readyIt[op_class] = listOrder.insert(list_it, queue_entry);
-    queueOnList[op_class] = true;
+    readyInsts[op_class].pop();
+    if (readyInsts[op_class].empty())
+        readyClasses[op_class / 64] &= ~(1ULL << (op_class % 64));
 }
 
-void
-InstructionQueue::moveToYoungerInst(ListOrderIt list_order_it)
+int
+InstructionQueue::oldestReadyClass(const OpClassMask &skip) const
 {
-    // Get iterator of next item on the list
-    // Delete the original iterator
-    // Determine if the next item is either the end of the list or younger
-    // than the new instruction.  If so, then add in a new iterator right here.
-    // If not, then move along.
-    ListOrderEntry queue_entry;
-    OpClass op_class = (*list_order_it).queueType;
-    ListOrderIt next_it = list_order_it;
-
-    ++next_it;
-
-    queue_entry.queueType = op_class;
-    queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
-
-    while (next_it != listOrder.end() &&
-           (*next_it).oldestInst < queue_entry.oldestInst) {
-        ++next_it;
+    int oldest_class = Num_OpClasses;
+    InstSeqNum oldest_inst = std::numeric_limits<InstSeqNum>::max();
+
+    // Only the op classes that have ready instructions are visited,
+    // which is typically a handful of them.
+    for (int word = 0; word < ReadyClassWords; ++word) {
+        uint64_t bits = readyClasses[word] & ~skip[word];
+        while (bits) {
+            int op_class = word * 64 + findLsbSet(bits);
+            bits &= bits - 1;
+
+            InstSeqNum seq_num = readyInsts[op_class].top()->seqNum;
+            if (seq_num < oldest_inst) {
+                oldest_inst = seq_num;
+                oldest_class = op_class;
+            }
+        }
     }
 
-    readyIt[op_class] = listOrder.insert(next_it, queue_entry);
+    return oldest_class;
 }
 
 void
@@ -766,22 +754,18 @@ InstructionQueue::scheduleReadyInsts()
         addReadyMemInst(mem_inst);
     }
 
-    // Have iterator to head of the list
-    // While I haven't exceeded bandwidth or reached the end of the list,
-    // Try to get a FU that can do what this op needs.
-    // If successful, change the oldestInst to the new top of the list, put
-    // the queue in the proper place in the list.
-    // Increment the iterator.
+    // Repeatedly pick the op class with the oldest ready instruction
+    // and try to get a FU that can do what this op needs. If there is
+    // none free, skip that op class for the rest of the cycle.
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
     int total_issued = 0;
-    ListOrderIt order_it = listOrder.begin();
-    ListOrderIt order_end_it = listOrder.end();
+    OpClassMask fu_busy = {};
+    int next_class;
 
-    while (total_issued < totalWidth && order_it != order_end_it) {
-        OpClass op_class = (*order_it).queueType;
-
-        assert(!readyInsts[op_class].empty());
+    while (total_issued < totalWidth &&
+           (next_class = oldestReadyClass(fu_busy)) != Num_OpClasses) {
+        OpClass op_class = static_cast<OpClass>(next_class);
 
         DynInstPtr issuing_inst = readyInsts[op_class].top();
 
@@ -793,19 +777,8 @@ InstructionQueue::scheduleReadyInsts()
             iqIOStats.intInstQueueReads++;
         }
 
-        assert(issuing_inst->seqNum == (*order_it).oldestInst);
-
         if (issuing_inst->isSquashed()) {
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
-
-            listOrder.erase(order_it++);
+            popReadyInst(op_class);
 
             ++iqStats.squashedInstsIssued;
 
@@ -866,14 +839,7 @@ InstructionQueue::scheduleReadyInsts()
                     tid, issuing_inst->pcState(),
                     issuing_inst->seqNum);
 
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
+            popReadyInst(op_class);
 
             issuing_inst->setIssued();
             ++total_issued;
@@ -895,12 +861,11 @@ InstructionQueue::scheduleReadyInsts()
                 memDepUnit[tid].issue(issuing_inst);
             }
 
-            listOrder.erase(order_it++);
             iqStats.statIssuedInstType[tid][op_class]++;
         } else {
             iqStats.statFuBusy[op_class]++;
             iqStats.fuBusy[tid]++;
-            ++order_it;
+            fu_busy[op_class / 64] |= 1ULL << (op_class % 64);
         }
     }
 
@@ -1068,17 +1033,7 @@ InstructionQueue::addReadyMemInst(const DynInstPtr &ready_inst)
 {
     OpClass op_class = ready_inst->opClass();
 
-    readyInsts[op_class].push(ready_inst);
-
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
-    }
+    pushReadyInst(ready_inst);
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
             "the ready list, PC %s opclass:%i [sn:%llu].\n",
@@ -1437,17 +1392,7 @@ InstructionQueue::addIfReady(const DynInstPtr &inst)
                 "the ready list, PC %s opclass:%i [sn:%llu].\n",
                 inst->pcState(), op_class, inst->seqNum);
 
-        readyInsts[op_class].push(inst);
-
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
-        }
+        pushReadyInst(inst);
     }
 }
 
@@ -1481,18 +1426,12 @@ InstructionQueue::dumpLists()
 
     cprintf("\n");
 
-    ListOrderIt list_order_it = listOrder.begin();
-    ListOrderIt list_order_end_it = listOrder.end();
-    int i = 1;
-
-    cprintf("List order: ");
+    cprintf("Ready op classes: ");
 
-    while (list_order_it != list_order_end_it) {
-        cprintf("%i OpClass:%i [sn:%llu] ", i, (*list_order_it).queueType,
-                (*list_order_it).oldestInst);
-
-        ++list_order_it;
-        ++i;
+    for (int i = 0; i < Num_OpClasses; ++i) {
+        if (!readyInsts[i].empty()) {
+            cprintf("OpClass:%i [sn:%llu] ", i, readyInsts[i].top()->seqNum);
+        }
     }
 
     cprintf("\n");
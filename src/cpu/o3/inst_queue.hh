@@ -42,11 +42,13 @@
 #ifndef __CPU_O3_INST_QUEUE_HH__
 #define __CPU_O3_INST_QUEUE_HH__
 
+#include <array>
 #include <list>
 #include <map>
 #include <queue>
 #include <vector>
 
+#include "base/free_list.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
@@ -102,7 +104,8 @@ class InstructionQueue
     typedef typename std::list<DynInstPtr>::iterator ListIt;
 
     /** FU completion event class. */
-    class FUCompletion : public Event
+    class FUCompletion : public Event,
+                         public FreeListAllocated<FUCompletion>
     {
       private:
         /** Executing instruction. */
@@ -367,40 +370,28 @@ class InstructionQueue
 
     typedef std::map<InstSeqNum, DynInstPtr>::iterator NonSpecMapIt;
 
-    /** Entry for the list age ordering by op class. */
-    struct ListOrderEntry
-    {
-        OpClass queueType;
-        InstSeqNum oldestInst;
-    };
+    /** Number of 64 bit words needed to hold one bit per op class. */
+    static constexpr int ReadyClassWords = (Num_OpClasses + 63) / 64;
 
-    /** List that contains the age order of the oldest instruction of each
-     *  ready queue.  Used to select the oldest instruction available
-     *  among op classes.
-     *  @todo: Might be better to just move these entries around instead
-     *  of creating new ones every time the position changes due to an
-     *  instruction issuing.  Not sure std::list supports this.
-     */
-    std::list<ListOrderEntry> listOrder;
+    typedef std::array<uint64_t, ReadyClassWords> OpClassMask;
 
-    typedef typename std::list<ListOrderEntry>::iterator ListOrderIt;
+    /** Has a bit set for each op class that has ready instructions. */
+    OpClassMask readyClasses;
 
-    /** Tracks if each ready queue is on the age order list. */
-    bool queueOnList[Num_OpClasses];
+    /** Add an instruction to the ready queue of its op class. */
+    void pushReadyInst(const DynInstPtr &inst);
 
-    /** Iterators of each ready queue.  Points to their spot in the age order
-     *  list.
+    /**
+     * Remove the oldest instruction from the ready queue of an op class.
      */
-    ListOrderIt readyIt[Num_OpClasses];
-
-    /** Add an op class to the age order list. */
-    void addToOrderList(OpClass op_class);
+    void popReadyInst(OpClass op_class);
 
     /**
-     * Called when the oldest instruction has been removed from a ready queue;
-     * this places that ready queue into the proper spot in the age order list.
+     * Select the op class whose oldest ready instruction is the oldest
+     * among all op classes, ignoring the ones set in skip.
+     * @return The op class, or Num_OpClasses if there is none.
      */
-    void moveToYoungerInst(ListOrderIt age_order_it);
+    int oldestReadyClass(const OpClassMask &skip) const;
 
     DependencyGraph<DynInstPtr> dependGraph;
 
@@ -160,7 +160,8 @@ LSQUnit::completeDataAccess(PacketPtr pkt)
         }
     }
 
-    cpu->ppDataAccessComplete->notify(std::make_pair(inst, pkt));
+    cpu->ppDataAccessComplete->notifyLazy(
+        [&] { return std::make_pair(inst, pkt); });
 
     assert(!cpu->switchedOut());
     if (!inst->isSquashed()) {
@@ -236,6 +237,9 @@ LSQUnit::resetState()
     retryPkt = NULL;
     memDepViolator = NULL;
 
+    loadFilter.clear();
+    storeFilter.clear();
+
     stalled = false;
 
     cacheBlockMask = ~(cpu->cacheLineSize() - 1);
@@ -513,6 +517,12 @@ LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
     Addr inst_eff_addr1 = inst->effAddr >> depCheckShift;
     Addr inst_eff_addr2 = (inst->effAddr + inst->effSize - 1) >> depCheckShift;
 
+    // No load in the LQ touches these blocks, so none can conflict.
+    if (!loadFilter.mayOverlap(inst_eff_addr1, inst_eff_addr2)) {
+        loadIt = loadQueue.end();
+        return NoFault;
+    }
+
     /** @todo in theory you only need to check an instruction that has executed
      * however, there isn't a good way in the pipeline at the moment to check
      * all instructions that will execute before the store writes back. Thus,
@@ -734,6 +744,7 @@ LSQUnit::commitLoad()
                     inst->lastWakeDependents - inst->firstIssue));
     }
 
+    loadFilter.remove(loadQueue.front());
     loadQueue.front().clear();
     loadQueue.pop_front();
 }
@@ -954,6 +965,7 @@ LSQUnit::squash(const InstSeqNum &squashed_num)
         }
         // Clear the smart pointer to make sure it is decremented.
         loadQueue.back().instruction()->setSquashed();
+        loadFilter.remove(loadQueue.back());
         loadQueue.back().clear();
 
         loadQueue.pop_back();
@@ -1025,6 +1037,7 @@ LSQUnit::squash(const InstSeqNum &squashed_num)
         // Must delete request now that it wasn't handed off to
         // memory.  This is quite ugly.  @todo: Figure out the proper
         // place to really handle request deletes.
+        storeFilter.remove(storeQueue.back());
         storeQueue.back().clear();
 
         storeQueue.pop_back();
@@ -1149,6 +1162,7 @@ LSQUnit::completeStore(typename StoreQueue::iterator store_idx)
     DynInstPtr store_inst = store_idx->instruction();
     if (store_idx == storeQueue.begin()) {
         do {
+            storeFilter.remove(storeQueue.front());
             storeQueue.front().clear();
             storeQueue.pop_front();
         } while (storeQueue.front().completed() &&
@@ -1324,6 +1338,9 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
 
     assert(!load_inst->isExecuted());
 
+    loadFilter.insert(load_entry, load_inst->effAddr >> depCheckShift,
+            (load_inst->effAddr + load_inst->effSize - 1) >> depCheckShift);
+
     // Make sure this isn't a strictly ordered load
     // A bit of a hackish way to get strictly ordered accesses to work
     // only if they're at the head of the LSQ and are ready to commit
@@ -1385,6 +1402,12 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
     // Check the SQ for any previous stores that might lead to forwarding
     auto store_it = load_inst->sqIt;
     assert (store_it >= storeWBIt);
+    // Skip the scan if no store in the SQ touches the load's blocks
+    Addr req_blk1 = request->mainReq()->getVaddr() >> depCheckShift;
+    Addr req_blk2 = (request->mainReq()->getVaddr() +
+            request->mainReq()->getSize() - 1) >> depCheckShift;
+    if (!storeFilter.mayOverlap(req_blk1, req_blk2))
+        store_it = storeWBIt;
     // End once we've reached the top of the LSQ
     while (store_it != storeWBIt && !load_inst->isDataPrefetch()) {
         // Move the index to one younger
@@ -1613,6 +1636,12 @@ LSQUnit::write(LSQRequest *request, uint8_t *data, ssize_t store_idx)
     storeQueue[store_idx].setRequest(request);
     unsigned size = request->_size;
     storeQueue[store_idx].size() = size;
+    if (size != 0) {
+        auto &store_inst = storeQueue[store_idx].instruction();
+        storeFilter.insert(storeQueue[store_idx],
+                store_inst->effAddr >> depCheckShift,
+                (store_inst->effAddr + size - 1) >> depCheckShift);
+    }
     bool store_no_data =
         request->mainReq()->getFlags() & Request::STORE_NO_DATA;
     storeQueue[store_idx].isAllZeros() = store_no_data;
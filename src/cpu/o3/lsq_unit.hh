@@ -43,6 +43,7 @@
 #define __CPU_O3_LSQ_UNIT_HH__
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include <map>
 #include <memory>
@@ -51,6 +52,7 @@
 #include "arch/generic/debugfaults.hh"
 #include "arch/generic/vec_reg.hh"
 #include "base/circular_queue.hh"
+#include "base/free_list.hh"
 #include "cpu/base.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/comm.hh"
@@ -103,6 +105,11 @@ class LSQUnit
         uint32_t _size = 0;
         /** Valid entry. */
         bool _valid = false;
+        /** Whether the entry is counted in an address filter. */
+        bool _filtered = false;
+        /** First and last dependence check block counted in the filter. */
+        Addr _filterFirst = 0;
+        Addr _filterLast = 0;
 
       public:
         ~LSQEntry()
@@ -122,6 +129,7 @@ class LSQUnit
             }
             _request = nullptr;
             _valid = false;
+            _filtered = false;
             _size = 0;
         }
 
@@ -137,6 +145,9 @@ class LSQUnit
         LSQRequest* request() { return _request; }
         void setRequest(LSQRequest* r) { _request = r; }
         bool hasRequest() { return _request != nullptr; }
+        bool& filtered() { return _filtered; }
+        Addr& filterFirst() { return _filterFirst; }
+        Addr& filterLast() { return _filterLast; }
         /** Member accessors. */
         /** @{ */
         bool valid() const { return _valid; }
@@ -196,6 +207,71 @@ class LSQUnit
     };
     using LQEntry = LSQEntry;
 
+    /**
+     * Counting filter over the dependence check blocks touched by the
+     * entries of one queue. A block that hashes to a zero count is not
+     * touched by any entry, so the queue does not need to be scanned for
+     * it. Aliasing only causes extra scans, never missed ones.
+     */
+    class BlockFilter
+    {
+      private:
+        static constexpr Addr Size = 256;
+        std::array<unsigned, Size> counts{};
+        /** Entries spanning more blocks than the filter can tell apart. */
+        unsigned wide = 0;
+
+        void
+        update(Addr first, Addr last, int delta)
+        {
+            if (last - first >= Size) {
+                wide += delta;
+                return;
+            }
+            for (Addr blk = first; blk <= last; ++blk)
+                counts[blk & (Size - 1)] += delta;
+        }
+
+      public:
+        void
+        insert(LSQEntry &entry, Addr first, Addr last)
+        {
+            remove(entry);
+            update(first, last, 1);
+            entry.filtered() = true;
+            entry.filterFirst() = first;
+            entry.filterLast() = last;
+        }
+
+        void
+        remove(LSQEntry &entry)
+        {
+            if (entry.filtered()) {
+                update(entry.filterFirst(), entry.filterLast(), -1);
+                entry.filtered() = false;
+            }
+        }
+
+        bool
+        mayOverlap(Addr first, Addr last) const
+        {
+            if (wide || last - first >= Size)
+                return true;
+            for (Addr blk = first; blk <= last; ++blk) {
+                if (counts[blk & (Size - 1)])
+                    return true;
+            }
+            return false;
+        }
+
+        void
+        clear()
+        {
+            counts.fill(0);
+            wide = 0;
+        }
+    };
+
     /** Coverage of one address range with another */
     enum class AddrRangeCoverage
     {
@@ -408,7 +484,8 @@ class LSQUnit
     RequestPort *dcachePort;
 
     /** Writeback event, specifically for when stores forward data to loads. */
-    class WritebackEvent : public Event
+    class WritebackEvent : public Event,
+                           public FreeListAllocated<WritebackEvent>
     {
       public:
         /** Constructs a writeback event. */
@@ -457,6 +534,12 @@ class LSQUnit
      */
     unsigned depCheckShift;
 
+    /** Blocks touched by loads in the LQ that have an address. */
+    BlockFilter loadFilter;
+
+    /** Blocks touched by stores in the SQ that have an address. */
+    BlockFilter storeFilter;
+
     /** Should loads be checked for dependency issues */
     bool checkLoads;
 
@@ -28,12 +28,12 @@
 
 #include "cpu/o3/mem_dep_unit.hh"
 
-#include <map>
-#include <memory>
+#include <algorithm>
 #include <vector>
 
 #include "base/compiler.hh"
 #include "base/debug.hh"
+#include "base/intmath.hh"
 #include "cpu/o3/dyn_inst.hh"
 #include "cpu/o3/inst_queue.hh"
 #include "cpu/o3/limits.hh"
@@ -46,12 +46,6 @@ namespace gem5
 namespace o3
 {
 
-#ifdef GEM5_DEBUG
-int MemDepUnit::MemDepEntry::memdep_count = 0;
-int MemDepUnit::MemDepEntry::memdep_insert = 0;
-int MemDepUnit::MemDepEntry::memdep_erase = 0;
-#endif
-
 MemDepUnit::MemDepUnit() : iqPtr(NULL), stats(nullptr) {}
 
 MemDepUnit::MemDepUnit(const BaseO3CPUParams &params)
@@ -66,26 +60,6 @@ MemDepUnit::MemDepUnit(const BaseO3CPUParams &params)
 
 MemDepUnit::~MemDepUnit()
 {
-    for (ThreadID tid = 0; tid < MaxThreads; tid++) {
-
-        ListIt inst_list_it = instList[tid].begin();
-
-        MemDepHashIt hash_it;
-
-        while (!instList[tid].empty()) {
-            hash_it = memDepHash.find((*inst_list_it)->seqNum);
-
-            assert(hash_it != memDepHash.end());
-
-            memDepHash.erase(hash_it);
-
-            instList[tid].erase(inst_list_it++);
-        }
-    }
-
-#ifdef GEM5_DEBUG
-    assert(MemDepEntry::memdep_count == 0);
-#endif
 }
 
 void
@@ -99,6 +73,12 @@ MemDepUnit::init(const BaseO3CPUParams &params, ThreadID tid, CPU *cpu)
     depPred.init(params.store_set_clear_period, params.SSITSize,
             params.LFSTSize);
 
+    // Every instruction in the unit is in the ROB, so the ring only
+    // grows if the ROB is shared between threads and more than it.
+    entries.resize(size_t(1) << ceilLog2(std::max(params.numROBEntries, 1U)));
+    head = 0;
+    numEntries = 0;
+
     std::string stats_group_name = csprintf("MemDepUnit__%i", tid);
     cpu->addStatGroup(stats_group_name.c_str(), &stats);
 }
@@ -119,24 +99,14 @@ MemDepUnit::MemDepUnitStats::MemDepUnitStats(statistics::Group *parent)
 bool
 MemDepUnit::isDrained() const
 {
-    bool drained = instsToReplay.empty()
-                 && memDepHash.empty()
-                 && instsToReplay.empty();
-    for (int i = 0; i < MaxThreads; ++i)
-        drained = drained && instList[i].empty();
-
-    return drained;
+    return instsToReplay.empty() && numEntries == 0;
 }
 
 void
 MemDepUnit::drainSanityCheck() const
 {
     assert(instsToReplay.empty());
-    assert(memDepHash.empty());
-    for (int i = 0; i < MaxThreads; ++i)
-        assert(instList[i].empty());
-    assert(instsToReplay.empty());
-    assert(memDepHash.empty());
+    assert(numEntries == 0);
 }
 
 void
@@ -186,27 +156,80 @@ MemDepUnit::insertBarrierSN(const DynInstPtr &barr_inst)
     }
 }
 
+MemDepUnit::MemDepEntry &
+MemDepUnit::allocEntry(const DynInstPtr &inst)
+{
+    assert(numEntries == 0 || entryAt(numEntries - 1).seqNum < inst->seqNum);
+
+    if (numEntries == entries.size()) {
+        // Unwrap the ring into one twice as large
+        std::vector<MemDepEntry> grown(std::max<size_t>(2 * entries.size(),
+                                                        16));
+        for (size_t i = 0; i < numEntries; i++)
+            grown[i] = std::move(entryAt(i));
+        entries.swap(grown);
+        head = 0;
+    }
+
+    MemDepEntry &entry = entryAt(numEntries++);
+    entry.inst = inst;
+    entry.seqNum = inst->seqNum;
+    entry.regsReady = false;
+    entry.memDeps = 0;
+    assert(entry.dependInsts.empty());
+    return entry;
+}
+
 void
-MemDepUnit::insert(const DynInstPtr &inst)
+MemDepUnit::freeEntry(MemDepEntry &entry)
 {
-    ThreadID tid = inst->threadNumber;
+    entry.inst = nullptr;
+    entry.dependInsts.clear();
 
-    MemDepEntryPtr inst_entry = std::make_shared<MemDepEntry>(inst);
+    while (numEntries && !entryAt(0).inst) {
+        head = (head + 1) & (entries.size() - 1);
+        numEntries--;
+    }
+    while (numEntries && !entryAt(numEntries - 1).inst)
+        numEntries--;
+}
 
-    // Add the MemDepEntry to the hash.
-    memDepHash.insert(
-        std::pair<InstSeqNum, MemDepEntryPtr>(inst->seqNum, inst_entry));
-#ifdef GEM5_DEBUG
-    MemDepEntry::memdep_insert++;
-#endif
+MemDepUnit::MemDepEntry *
+MemDepUnit::lookupEntry(InstSeqNum seq_num)
+{
+    size_t lo = 0, hi = numEntries;
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        if (entryAt(mid).seqNum < seq_num)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == numEntries)
+        return nullptr;
+    MemDepEntry &entry = entryAt(lo);
+    return entry.inst && entry.seqNum == seq_num ? &entry : nullptr;
+}
 
-    instList[tid].push_back(inst);
+MemDepUnit::MemDepEntry &
+MemDepUnit::findEntry(const DynInstConstPtr &inst)
+{
+    MemDepEntry *entry = lookupEntry(inst->seqNum);
 
-    inst_entry->listIt = --(instList[tid].end());
+    assert(entry);
+
+    return *entry;
+}
+
+void
+MemDepUnit::insert(const DynInstPtr &inst)
+{
+    MemDepEntry &inst_entry = allocEntry(inst);
 
     // Check any barriers and the dependence predictor for any
     // producing memrefs/stores.
-    std::vector<InstSeqNum>  producing_stores;
+    std::vector<InstSeqNum> &producing_stores = producingStores;
+    producing_stores.clear();
     if ((inst->isLoad() || inst->isAtomic()) && hasLoadBarrier()) {
         DPRINTF(MemDepUnit, "%d load barriers in flight\n",
                 loadBarrierSNs.size());
@@ -225,16 +248,17 @@ MemDepUnit::insert(const DynInstPtr &inst)
             producing_stores.push_back(dep);
     }
 
-    std::vector<MemDepEntryPtr> store_entries;
+    std::vector<MemDepEntry *> &store_entries = storeEntries;
+    store_entries.clear();
 
     // If there is a producing store, try to find the entry.
     for (auto producing_store : producing_stores) {
         DPRINTF(MemDepUnit, "Searching for producer [sn:%lli]\n",
                             producing_store);
-        MemDepHashIt hash_it = memDepHash.find(producing_store);
+        MemDepEntry *store_entry = lookupEntry(producing_store);
 
-        if (hash_it != memDepHash.end()) {
-            store_entries.push_back((*hash_it).second);
+        if (store_entry) {
+            store_entries.push_back(store_entry);
             DPRINTF(MemDepUnit, "Producer found\n");
         }
     }
@@ -245,10 +269,10 @@ MemDepUnit::insert(const DynInstPtr &inst)
         DPRINTF(MemDepUnit, "No dependency for inst PC "
                 "%s [sn:%lli].\n", inst->pcState(), inst->seqNum);
 
-        assert(inst_entry->memDeps == 0);
+        assert(inst_entry.memDeps == 0);
 
         if (inst->readyToIssue()) {
-            inst_entry->regsReady = true;
+            inst_entry.regsReady = true;
 
             moveToReady(inst_entry);
         }
@@ -260,7 +284,7 @@ MemDepUnit::insert(const DynInstPtr &inst)
                 inst->pcState(), producing_store);
 
         if (inst->readyToIssue()) {
-            inst_entry->regsReady = true;
+            inst_entry.regsReady = true;
         }
 
         // Clear the bit saying this instruction can issue.
@@ -268,9 +292,9 @@ MemDepUnit::insert(const DynInstPtr &inst)
 
         // Add this instruction to the list of dependents.
         for (auto store_entry : store_entries)
-            store_entry->dependInsts.push_back(inst_entry);
+            store_entry->dependInsts.push_back(inst->seqNum);
 
-        inst_entry->memDeps = store_entries.size();
+        inst_entry.memDeps = store_entries.size();
 
         if (inst->isLoad()) {
             ++stats.conflictingLoads;
@@ -322,21 +346,7 @@ MemDepUnit::insertNonSpec(const DynInstPtr &inst)
 void
 MemDepUnit::insertBarrier(const DynInstPtr &barr_inst)
 {
-    ThreadID tid = barr_inst->threadNumber;
-
-    MemDepEntryPtr inst_entry = std::make_shared<MemDepEntry>(barr_inst);
-
-    // Add the MemDepEntry to the hash.
-    memDepHash.insert(
-        std::pair<InstSeqNum, MemDepEntryPtr>(barr_inst->seqNum, inst_entry));
-#ifdef GEM5_DEBUG
-    MemDepEntry::memdep_insert++;
-#endif
-
-    // Add the instruction to the instruction list.
-    instList[tid].push_back(barr_inst);
-
-    inst_entry->listIt = --(instList[tid].end());
+    allocEntry(barr_inst);
 
     insertBarrierSN(barr_inst);
 }
@@ -348,11 +358,11 @@ MemDepUnit::regsReady(const DynInstPtr &inst)
             "instruction PC %s [sn:%lli].\n",
             inst->pcState(), inst->seqNum);
 
-    MemDepEntryPtr inst_entry = findInHash(inst);
+    MemDepEntry &inst_entry = findEntry(inst);
 
-    inst_entry->regsReady = true;
+    inst_entry.regsReady = true;
 
-    if (inst_entry->memDeps == 0) {
+    if (inst_entry.memDeps == 0) {
         DPRINTF(MemDepUnit, "Instruction has its memory "
                 "dependencies resolved, adding it to the ready list.\n");
 
@@ -370,9 +380,7 @@ MemDepUnit::nonSpecInstReady(const DynInstPtr &inst)
             "instruction PC %s as ready [sn:%lli].\n",
             inst->pcState(), inst->seqNum);
 
-    MemDepEntryPtr inst_entry = findInHash(inst);
-
-    moveToReady(inst_entry);
+    moveToReady(findEntry(inst));
 }
 
 void
@@ -390,7 +398,7 @@ MemDepUnit::replay()
     while (!instsToReplay.empty()) {
         temp_inst = instsToReplay.front();
 
-        MemDepEntryPtr inst_entry = findInHash(temp_inst);
+        MemDepEntry &inst_entry = findEntry(temp_inst);
 
         DPRINTF(MemDepUnit, "Replaying mem instruction PC %s [sn:%lli].\n",
                 temp_inst->pcState(), temp_inst->seqNum);
@@ -407,21 +415,8 @@ MemDepUnit::completed(const DynInstPtr &inst)
     DPRINTF(MemDepUnit, "Completed mem instruction PC %s [sn:%lli].\n",
             inst->pcState(), inst->seqNum);
 
-    ThreadID tid = inst->threadNumber;
-
-    // Remove the instruction from the hash and the list.
-    MemDepHashIt hash_it = memDepHash.find(inst->seqNum);
-
-    assert(hash_it != memDepHash.end());
-
-    instList[tid].erase((*hash_it).second->listIt);
-
-    (*hash_it).second = NULL;
-
-    memDepHash.erase(hash_it);
-#ifdef GEM5_DEBUG
-    MemDepEntry::memdep_erase++;
-#endif
+    // Remove the instruction from the unit.
+    freeEntry(findEntry(inst));
 }
 
 void
@@ -464,12 +459,12 @@ MemDepUnit::wakeDependents(const DynInstPtr &inst)
         return;
     }
 
-    MemDepEntryPtr inst_entry = findInHash(inst);
+    MemDepEntry &inst_entry = findEntry(inst);
 
-    for (int i = 0; i < inst_entry->dependInsts.size(); ++i ) {
-        MemDepEntryPtr woken_inst = inst_entry->dependInsts[i];
+    for (auto dep_seq_num : inst_entry.dependInsts) {
+        MemDepEntry *woken_inst = lookupEntry(dep_seq_num);
 
-        if (!woken_inst->inst) {
+        if (!woken_inst) {
             // Potentially removed mem dep entries could be on this list
             continue;
         }
@@ -481,40 +476,11 @@ MemDepUnit::wakeDependents(const DynInstPtr &inst)
         assert(woken_inst->memDeps > 0);
         woken_inst->memDeps -= 1;
 
-        if ((woken_inst->memDeps == 0) &&
-            woken_inst->regsReady &&
-            !woken_inst->squashed) {
-            moveToReady(woken_inst);
-        }
-    }
-
-    inst_entry->dependInsts.clear();
-}
-
-MemDepUnit::MemDepEntry::MemDepEntry(const DynInstPtr &new_inst) :
-    inst(new_inst)
-{
-#ifdef GEM5_DEBUG
-    ++memdep_count;
-
-    DPRINTF(MemDepUnit,
-            "Memory dependency entry created. memdep_count=%i %s\n",
-            memdep_count, inst->pcState());
-#endif
-}
-
-MemDepUnit::MemDepEntry::~MemDepEntry()
-{
-    for (int i = 0; i < dependInsts.size(); ++i) {
-        dependInsts[i] = NULL;
+        if ((woken_inst->memDeps == 0) && woken_inst->regsReady)
+            moveToReady(*woken_inst);
     }
-#ifdef GEM5_DEBUG
-    --memdep_count;
 
-    DPRINTF(MemDepUnit,
-            "Memory dependency entry deleted. memdep_count=%i %s\n",
-            memdep_count, inst->pcState());
-#endif
+    inst_entry.dependInsts.clear();
 }
 
 void
@@ -532,35 +498,21 @@ MemDepUnit::squash(const InstSeqNum &squashed_num, ThreadID tid)
         }
     }
 
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
+    // Entries are in program order and the youngest one is always valid,
+    // so squash from the youngest one until reaching an older one.
+    while (numEntries) {
+        MemDepEntry &entry = entryAt(numEntries - 1);
+        if (entry.seqNum <= squashed_num)
+            break;
+        assert(entry.inst && entry.inst->threadNumber == tid);
 
-    MemDepHashIt hash_it;
+        DPRINTF(MemDepUnit, "Squashing inst [sn:%lli]\n", entry.seqNum);
 
-    while (!instList[tid].empty() &&
-           (*squash_it)->seqNum > squashed_num) {
+        loadBarrierSNs.erase(entry.seqNum);
 
-        DPRINTF(MemDepUnit, "Squashing inst [sn:%lli]\n",
-                (*squash_it)->seqNum);
+        storeBarrierSNs.erase(entry.seqNum);
 
-        loadBarrierSNs.erase((*squash_it)->seqNum);
-
-        storeBarrierSNs.erase((*squash_it)->seqNum);
-
-        hash_it = memDepHash.find((*squash_it)->seqNum);
-
-        assert(hash_it != memDepHash.end());
-
-        (*hash_it).second->squashed = true;
-
-        (*hash_it).second = NULL;
-
-        memDepHash.erase(hash_it);
-#ifdef GEM5_DEBUG
-        MemDepEntry::memdep_erase++;
-#endif
-
-        instList[tid].erase(squash_it--);
+        freeEntry(entry);
     }
 
     // Tell the dependency predictor to squash as well.
@@ -588,56 +540,36 @@ MemDepUnit::issue(const DynInstPtr &inst)
     depPred.issued(inst->pcState().instAddr(), inst->seqNum, inst->isStore());
 }
 
-MemDepUnit::MemDepEntryPtr &
-MemDepUnit::findInHash(const DynInstConstPtr &inst)
-{
-    MemDepHashIt hash_it = memDepHash.find(inst->seqNum);
-
-    assert(hash_it != memDepHash.end());
-
-    return (*hash_it).second;
-}
-
 void
-MemDepUnit::moveToReady(MemDepEntryPtr &woken_inst_entry)
+MemDepUnit::moveToReady(MemDepEntry &woken_inst_entry)
 {
     DPRINTF(MemDepUnit, "Adding instruction [sn:%lli] "
-            "to the ready list.\n", woken_inst_entry->inst->seqNum);
+            "to the ready list.\n", woken_inst_entry.seqNum);
 
-    assert(!woken_inst_entry->squashed);
+    assert(woken_inst_entry.inst);
 
-    iqPtr->addReadyMemInst(woken_inst_entry->inst);
+    iqPtr->addReadyMemInst(woken_inst_entry.inst);
 }
 
 
 void
 MemDepUnit::dumpLists()
 {
-    for (ThreadID tid = 0; tid < MaxThreads; tid++) {
-        cprintf("Instruction list %i size: %i\n",
-                tid, instList[tid].size());
-
-        ListIt inst_list_it = instList[tid].begin();
-        int num = 0;
-
-        while (inst_list_it != instList[tid].end()) {
-            cprintf("Instruction:%i\nPC: %s\n[sn:%llu]\n[tid:%i]\nIssued:%i\n"
-                    "Squashed:%i\n\n",
-                    num, (*inst_list_it)->pcState(),
-                    (*inst_list_it)->seqNum,
-                    (*inst_list_it)->threadNumber,
-                    (*inst_list_it)->isIssued(),
-                    (*inst_list_it)->isSquashed());
-            inst_list_it++;
-            ++num;
-        }
-    }
+    cprintf("Instruction list %i size: %i\n", id, numEntries);
 
-    cprintf("Memory dependence hash size: %i\n", memDepHash.size());
+    int num = 0;
+    for (size_t i = 0; i < numEntries; i++) {
+        const DynInstPtr &inst = entryAt(i).inst;
+        if (!inst)
+            continue;
+        cprintf("Instruction:%i\nPC: %s\n[sn:%llu]\n[tid:%i]\nIssued:%i\n"
+                "Squashed:%i\n\n",
+                num, inst->pcState(), inst->seqNum, inst->threadNumber,
+                inst->isIssued(), inst->isSquashed());
+        ++num;
+    }
 
-#ifdef GEM5_DEBUG
-    cprintf("Memory dependence entries: %i\n", MemDepEntry::memdep_count);
-#endif
+    cprintf("Memory dependence entries: %i\n", num);
 }
 
 } // namespace o3
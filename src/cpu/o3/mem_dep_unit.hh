@@ -42,10 +42,8 @@
 #define __CPU_O3_MEM_DEP_UNIT_HH__
 
 #include <list>
-#include <memory>
-#include <set>
-#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "cpu/inst_seq.hh"
@@ -57,17 +55,6 @@
 namespace gem5
 {
 
-struct SNHash
-{
-    size_t
-    operator()(const InstSeqNum &seq_num) const
-    {
-        unsigned a = (unsigned)seq_num;
-        unsigned hash = (((a >> 14) ^ ((a >> 2) & 0xffff))) & 0x7FFFFFFF;
-        return hash;
-    }
-};
-
 struct BaseO3CPUParams;
 
 namespace o3
@@ -171,67 +158,75 @@ class MemDepUnit
 
     typedef typename std::list<DynInstPtr>::iterator ListIt;
 
-    class MemDepEntry;
-
-    typedef std::shared_ptr<MemDepEntry> MemDepEntryPtr;
-
     /** Memory dependence entries that track memory operations, marking
      *  when the instruction is ready to execute and what instructions depend
      *  upon it.
      */
-    class MemDepEntry
+    struct MemDepEntry
     {
-      public:
-        /** Constructs a memory dependence entry. */
-        MemDepEntry(const DynInstPtr &new_inst);
-
-        /** Frees any pointers. */
-        ~MemDepEntry();
-
-        /** Returns the name of the memory dependence entry. */
-        std::string name() const { return "memdepentry"; }
-
-        /** The instruction being tracked. */
+        /** The instruction being tracked, null once the entry is freed. */
         DynInstPtr inst;
 
-        /** The iterator to the instruction's location inside the list. */
-        ListIt listIt;
+        /** Sequence number of the instruction, kept once the entry is
+         *  freed to order the entries. */
+        InstSeqNum seqNum = 0;
 
-        /** A vector of any dependent instructions. */
-        std::vector<MemDepEntryPtr> dependInsts;
+        /** Sequence numbers of any dependent instructions. Dependents
+         *  squashed in the meantime are not found anymore and ignored. */
+        std::vector<InstSeqNum> dependInsts;
 
         /** If the registers are ready or not. */
         bool regsReady = false;
         /** Number of memory dependencies that need to be satisfied. */
         int memDeps = 0;
-        /** If the instruction is completed. */
-        bool completed = false;
-        /** If the instruction is squashed. */
-        bool squashed = false;
-
-        /** For debugging. */
-#ifdef GEM5_DEBUG
-        static int memdep_count;
-        static int memdep_insert;
-        static int memdep_erase;
-#endif
     };
 
-    /** Finds the memory dependence entry in the hash map. */
-    MemDepEntryPtr &findInHash(const DynInstConstPtr& inst);
+    /**
+     * The entries of all instructions in the memory dependence unit, in
+     * program order. This is a ring buffer of entries[head] to
+     * entries[head + numEntries - 1], modulo its size, which is a power
+     * of two. Freed entries are left in place until they reach either
+     * end, so entries can be found by binary search on their sequence
+     * numbers, and the ring never holds more entries than there are
+     * instructions in the ROB.
+     */
+    std::vector<MemDepEntry> entries;
+    size_t head = 0;
+    size_t numEntries = 0;
 
-    /** Moves an entry to the ready list. */
-    void moveToReady(MemDepEntryPtr &ready_inst_entry);
+    /** The i-th entry from the oldest one. */
+    MemDepEntry &
+    entryAt(size_t i)
+    {
+        return entries[(head + i) & (entries.size() - 1)];
+    }
+
+    const MemDepEntry &
+    entryAt(size_t i) const
+    {
+        return entries[(head + i) & (entries.size() - 1)];
+    }
+
+    /** Allocates the entry of a new, youngest, instruction. */
+    MemDepEntry &allocEntry(const DynInstPtr &inst);
 
-    typedef std::unordered_map<InstSeqNum, MemDepEntryPtr, SNHash> MemDepHash;
+    /** Frees the entry of an instruction. */
+    void freeEntry(MemDepEntry &entry);
 
-    typedef typename MemDepHash::iterator MemDepHashIt;
+    /** Finds the entry of an instruction, null if it is not in the unit.
+     */
+    MemDepEntry *lookupEntry(InstSeqNum seq_num);
 
-    /** A hash map of all memory dependence entries. */
-    MemDepHash memDepHash;
+    /** Finds the entry of an instruction which must be in the unit. */
+    MemDepEntry &findEntry(const DynInstConstPtr& inst);
+
+    /** Moves an entry to the ready list. */
+    void moveToReady(MemDepEntry &ready_inst_entry);
 
-    /** A list of all instructions in the memory dependence unit. */
-    std::list<DynInstPtr> instList[MaxThreads];
+    /** Scratch lists of producers, to avoid allocating them for each
+     *  inserted instruction. */
+    std::vector<InstSeqNum> producingStores;
+    std::vector<MemDepEntry *> storeEntries;
 
     /** A list of all instructions that are going to be replayed. */
     std::list<DynInstPtr> instsToReplay;
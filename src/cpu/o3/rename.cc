@@ -65,6 +65,7 @@ Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
       commitToRenameDelay(params.commitToRenameDelay),
       renameWidth(params.renameWidth),
       numThreads(params.numThreads),
+      numCheckpoints(params.numRenameCheckpoints),
       stats(_cpu)
 {
     if (renameWidth > MaxWidth)
@@ -85,6 +86,9 @@ Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
         stalls[tid] = {false, false};
         serializeInst[tid] = nullptr;
         serializeOnNextInst[tid] = false;
+        checkpoints[tid].resize(numCheckpoints);
+        checkpointHead[tid] = 0;
+        numCheckpointsUsed[tid] = 0;
     }
 }
 
@@ -140,6 +144,8 @@ Rename::RenameStats::RenameStats(statistics::Group *parent)
                "Number of HB maps that are committed"),
       ADD_STAT(undoneMaps, statistics::units::Count::get(),
                "Number of HB maps that are undone due to squashing"),
+      ADD_STAT(checkpointRestores, statistics::units::Count::get(),
+               "Number of squashes recovered from a rename map checkpoint"),
       ADD_STAT(serializing, statistics::units::Count::get(),
                "count of serializing insts renamed"),
       ADD_STAT(tempSerializing, statistics::units::Count::get(),
@@ -173,6 +179,7 @@ Rename::RenameStats::RenameStats(statistics::Group *parent)
 
     committedMaps.prereq(committedMaps);
     undoneMaps.prereq(undoneMaps);
+    checkpointRestores.prereq(checkpointRestores);
     serializing.flags(statistics::total);
     tempSerializing.flags(statistics::total);
     skidInsts.flags(statistics::total);
@@ -245,6 +252,8 @@ Rename::clearStates(ThreadID tid)
     storesInProgress[tid] = 0;
 
     serializeOnNextInst[tid] = false;
+
+    clearCheckpoints(tid);
 }
 
 void
@@ -275,6 +284,8 @@ Rename::resetStage()
         storesInProgress[tid] = 0;
 
         serializeOnNextInst[tid] = false;
+
+        clearCheckpoints(tid);
     }
 }
 
@@ -714,6 +725,8 @@ Rename::renameInsts(ThreadID tid)
 
         renameDestRegs(inst, inst->threadNumber);
 
+        takeCheckpoint(inst, inst->threadNumber);
+
         if (inst->isAtomic() || inst->isStore()) {
             storesInProgress[tid]++;
         } else if (inst->isLoad()) {
@@ -911,9 +924,48 @@ Rename::unblock(ThreadID tid)
     return false;
 }
 
+void
+Rename::takeCheckpoint(const DynInstPtr &inst, ThreadID tid)
+{
+    if (!inst->isControl() || numCheckpointsUsed[tid] == numCheckpoints)
+        return;
+
+    RenameCheckpoint &checkpoint =
+        checkpointAt(tid, numCheckpointsUsed[tid]++);
+    checkpoint.seqNum = inst->seqNum;
+    renameMap[tid]->save(checkpoint.map);
+}
+
+void
+Rename::clearCheckpoints(ThreadID tid)
+{
+    checkpointHead[tid] = 0;
+    numCheckpointsUsed[tid] = 0;
+}
+
 void
 Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
 {
+    // Checkpoints of squashed instructions are gone, and one of the
+    // instruction squashed back to holds the map as it must be restored.
+    while (numCheckpointsUsed[tid] &&
+           checkpointAt(tid, numCheckpointsUsed[tid] - 1).seqNum >
+           squashed_seq_num) {
+        numCheckpointsUsed[tid]--;
+    }
+
+    bool restored = false;
+    if (numCheckpointsUsed[tid] &&
+        checkpointAt(tid, numCheckpointsUsed[tid] - 1).seqNum ==
+        squashed_seq_num) {
+        DPRINTF(Rename, "[tid:%i] Restoring the rename map checkpoint of "
+                "[sn:%llu].\n", tid, squashed_seq_num);
+        renameMap[tid]->restore(
+                checkpointAt(tid, numCheckpointsUsed[tid] - 1).map);
+        restored = true;
+        ++stats.checkpointRestores;
+    }
+
     auto hb_it = historyBuffer[tid].begin();
 
     // After a syscall squashes everything, the history buffer may be empty
@@ -937,8 +989,10 @@ Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
         // don't want to put these on the free list.
         if (hb_it->newPhysReg != hb_it->prevPhysReg) {
             // Tell the rename map to set the architected register to the
-            // previous physical register that it was renamed to.
-            renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
+            // previous physical register that it was renamed to, unless
+            // the whole map was restored already.
+            if (!restored)
+                renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
 
             // The phys regs can still be owned by squashing but
             // executing instructions in IEW at this moment. To avoid
@@ -950,8 +1004,9 @@ Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
         // Notify potential listeners that the register mapping needs to be
         // removed because the instruction it was mapped to got squashed. Note
         // that this is done before hb_it is incremented.
-        ppSquashInRename->notify(std::make_pair(hb_it->instSeqNum,
-                                                hb_it->newPhysReg));
+        ppSquashInRename->notifyLazy([&] {
+            return std::make_pair(hb_it->instSeqNum, hb_it->newPhysReg);
+        });
 
         historyBuffer[tid].erase(hb_it++);
 
@@ -1006,6 +1061,13 @@ Rename::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
 
         historyBuffer[tid].erase(hb_it--);
     }
+
+    // Committed instructions cannot be squashed back to anymore
+    while (numCheckpointsUsed[tid] &&
+           checkpointAt(tid, 0).seqNum <= inst_seq_num) {
+        checkpointHead[tid] = (checkpointHead[tid] + 1) % numCheckpoints;
+        numCheckpointsUsed[tid]--;
+    }
 }
 
 void
@@ -320,6 +320,38 @@ class Rename
      */
     std::list<RenameHistory> historyBuffer[MaxThreads];
 
+    /** The rename map as it was right after renaming an instruction. */
+    struct RenameCheckpoint
+    {
+        InstSeqNum seqNum;
+        UnifiedRenameMap::Snapshot map;
+    };
+
+    /**
+     * Per-thread rename map checkpoints, taken at control instructions
+     * so that squashing them back restores the map at once rather than
+     * undoing the history one mapping at a time. This is a ring buffer
+     * of up to numCheckpoints checkpoints, in program order, starting at
+     * checkpointHead. The snapshots of the ring are reused.
+     */
+    std::vector<RenameCheckpoint> checkpoints[MaxThreads];
+    size_t checkpointHead[MaxThreads];
+    size_t numCheckpointsUsed[MaxThreads];
+
+    /** The i-th oldest checkpoint of a thread. */
+    RenameCheckpoint &
+    checkpointAt(ThreadID tid, size_t i)
+    {
+        return checkpoints[tid][(checkpointHead[tid] + i) % numCheckpoints];
+    }
+
+    /** Checkpoints the rename map after renaming an instruction, if it is
+     *  a control instruction and a checkpoint is available. */
+    void takeCheckpoint(const DynInstPtr &inst, ThreadID tid);
+
+    /** Drops all checkpoints of a thread. */
+    void clearCheckpoints(ThreadID tid);
+
     /** Pointer to CPU. */
     CPU *cpu;
 
@@ -459,6 +491,10 @@ class Rename
     /** The number of threads active in rename. */
     ThreadID numThreads;
 
+    /** Maximum number of rename map checkpoints per thread, 0 if
+     *  disabled. */
+    const unsigned numCheckpoints;
+
     /** The maximum skid buffer size. */
     unsigned skidBufferMax;
 
@@ -530,6 +566,8 @@ class Rename
         /** Stat for total number of mappings that were undone due to a
          *  squash. */
         statistics::Scalar undoneMaps;
+        /** Stat for number of squashes recovered from a checkpoint. */
+        statistics::Scalar checkpointRestores;
         /** Number of serialize instructions handled. */
         statistics::Scalar serializing;
         /** Number of instructions marked as temporarily serializing. */
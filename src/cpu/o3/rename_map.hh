@@ -184,6 +184,9 @@ class UnifiedRenameMap
 
     typedef std::array<UnifiedRenameMap, MaxThreads> PerThreadUnifiedRenameMap;
 
+    /** A copy of the mappings of all register classes. */
+    typedef std::array<std::vector<PhysRegIdPtr>, CCRegClass + 1> Snapshot;
+
     /** Default constructor.  init() must be called prior to use. */
     UnifiedRenameMap() : regFile(nullptr) {};
 
@@ -289,6 +292,25 @@ class UnifiedRenameMap
      * Return whether there are enough registers to serve the request.
      */
     bool canRename(DynInstPtr inst) const;
+
+    /** Copies the current mappings into a snapshot. */
+    void
+    save(Snapshot &snapshot) const
+    {
+        for (int i = 0; i <= CCRegClass; i++)
+            snapshot[i].assign(renameMaps[i].begin(), renameMaps[i].end());
+    }
+
+    /** Restores the mappings saved in a snapshot. */
+    void
+    restore(const Snapshot &snapshot)
+    {
+        for (int i = 0; i <= CCRegClass; i++) {
+            assert(snapshot[i].size() == renameMaps[i].numArchRegs());
+            std::copy(snapshot[i].begin(), snapshot[i].end(),
+                      renameMaps[i].begin());
+        }
+    }
 };
 
 } // namespace o3
@@ -28,6 +28,8 @@
 
 #include "cpu/o3/store_set.hh"
 
+#include <algorithm>
+
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
@@ -75,6 +77,8 @@ StoreSet::StoreSet(uint64_t clear_period, int _SSIT_size, int _LFST_size)
     offsetBits = 2;
 
     memOpsPred = 0;
+
+    storeList.resize(64);
 }
 
 StoreSet::~StoreSet()
@@ -113,6 +117,40 @@ StoreSet::init(uint64_t clear_period, int _SSIT_size, int _LFST_size)
     offsetBits = 2;
 
     memOpsPred = 0;
+
+    storeList.assign(64, StoreListEntry());
+    storeListHead = 0;
+    storeListSize = 0;
+}
+
+void
+StoreSet::pushStore(InstSeqNum seq_num, SSID ssid)
+{
+    assert(storeListSize == 0 ||
+           storeAt(storeListSize - 1).seqNum < seq_num);
+
+    if (storeListSize == storeList.size()) {
+        // Unwrap the ring into one twice as large
+        std::vector<StoreListEntry> grown(
+                std::max<size_t>(2 * storeList.size(), 64));
+        for (size_t i = 0; i < storeListSize; i++)
+            grown[i] = storeAt(i);
+        storeList.swap(grown);
+        storeListHead = 0;
+    }
+
+    storeAt(storeListSize++) = {seq_num, ssid, true};
+}
+
+void
+StoreSet::trimStores()
+{
+    while (storeListSize && !storeAt(0).valid) {
+        storeListHead = (storeListHead + 1) & (storeList.size() - 1);
+        storeListSize--;
+    }
+    while (storeListSize && !storeAt(storeListSize - 1).valid)
+        storeListSize--;
 }
 
 
@@ -232,7 +270,7 @@ StoreSet::insertStore(Addr store_PC, InstSeqNum store_seq_num, ThreadID tid)
 
         validLFST[store_SSID] = 1;
 
-        storeList[store_seq_num] = store_SSID;
+        pushStore(store_seq_num, store_SSID);
 
         DPRINTF(StoreSet, "Store %#x updated the LFST, SSID: %i\n",
                 store_PC, store_SSID);
@@ -288,10 +326,18 @@ StoreSet::issued(Addr issued_PC, InstSeqNum issued_seq_num, bool is_store)
 
     assert(index < SSITSize);
 
-    SeqNumMapIt store_list_it = storeList.find(issued_seq_num);
+    size_t lo = 0, hi = storeListSize;
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        if (storeAt(mid).seqNum < issued_seq_num)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
 
-    if (store_list_it != storeList.end()) {
-        storeList.erase(store_list_it);
+    if (lo != storeListSize && storeAt(lo).seqNum == issued_seq_num) {
+        storeAt(lo).valid = false;
+        trimStores();
     }
 
     // Make sure the SSIT still has a valid entry for the issued store.
@@ -318,26 +364,27 @@ StoreSet::squash(InstSeqNum squashed_num, ThreadID tid)
             squashed_num);
 
     int idx;
-    SeqNumMapIt store_list_it = storeList.begin();
 
     //@todo:Fix to only delete from correct thread
-    while (!storeList.empty()) {
-        idx = (*store_list_it).second;
+    // The youngest store in the list is always a valid one.
+    while (storeListSize) {
+        StoreListEntry &store = storeAt(storeListSize - 1);
+        idx = store.ssid;
 
-        if ((*store_list_it).first <= squashed_num) {
+        if (store.seqNum <= squashed_num) {
             break;
         }
 
-        bool younger = LFST[idx] > squashed_num;
+        // The LFST entry of a store is the store itself or a younger one
+        assert(LFST[idx] > squashed_num);
 
-        if (validLFST[idx] && younger) {
+        if (validLFST[idx]) {
             DPRINTF(StoreSet, "Squashed [sn:%lli]\n", LFST[idx]);
             validLFST[idx] = false;
-
-            storeList.erase(store_list_it++);
-        } else if (!validLFST[idx] && younger) {
-            storeList.erase(store_list_it++);
         }
+
+        store.valid = false;
+        trimStores();
     }
 }
 
@@ -352,22 +399,27 @@ StoreSet::clear()
         validLFST[i] = false;
     }
 
-    storeList.clear();
+    storeListHead = 0;
+    storeListSize = 0;
 }
 
 void
 StoreSet::dump()
 {
-    cprintf("storeList.size(): %i\n", storeList.size());
-    SeqNumMapIt store_list_it = storeList.begin();
+    int size = 0;
+    for (size_t i = 0; i < storeListSize; i++)
+        size += storeAt(i).valid;
+    cprintf("storeList.size(): %i\n", size);
 
+    // Youngest store first
     int num = 0;
 
-    while (store_list_it != storeList.end()) {
-        cprintf("%i: [sn:%lli] SSID:%i\n",
-                num, (*store_list_it).first, (*store_list_it).second);
+    for (size_t i = storeListSize; i-- > 0; ) {
+        const StoreListEntry &store = storeAt(i);
+        if (!store.valid)
+            continue;
+        cprintf("%i: [sn:%lli] SSID:%i\n", num, store.seqNum, store.ssid);
         num++;
-        store_list_it++;
     }
 }
 
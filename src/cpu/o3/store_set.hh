@@ -29,9 +29,6 @@
 #ifndef __CPU_O3_STORE_SET_HH__
 #define __CPU_O3_STORE_SET_HH__
 
-#include <list>
-#include <map>
-#include <utility>
 #include <vector>
 
 #include "base/types.hh"
@@ -43,15 +40,6 @@ namespace gem5
 namespace o3
 {
 
-struct ltseqnum
-{
-    bool
-    operator()(const InstSeqNum &lhs, const InstSeqNum &rhs) const
-    {
-        return lhs > rhs;
-    }
-};
-
 /**
  * Implements a store set predictor for determining if memory
  * instructions are dependent upon each other.  See paper "Memory
@@ -135,12 +123,37 @@ class StoreSet
     /** Bit vector to tell if the LFST has a valid entry. */
     std::vector<bool> validLFST;
 
-    /** Map of stores that have been inserted into the store set, but
-     * not yet issued or squashed.
+    /** A store that has been inserted into the store set. */
+    struct StoreListEntry
+    {
+        InstSeqNum seqNum;
+        SSID ssid;
+        bool valid;
+    };
+
+    /** Stores that have been inserted into the store set, but not yet
+     * issued or squashed, with their SSID. Stores are inserted in program
+     * order, so this is a ring buffer sorted by sequence number, of
+     * storeList[storeListHead] to storeList[storeListHead +
+     * storeListSize - 1] modulo its size, a power of two. Issued stores
+     * are invalidated in place until they reach either end.
      */
-    std::map<InstSeqNum, int, ltseqnum> storeList;
+    std::vector<StoreListEntry> storeList;
+    size_t storeListHead = 0;
+    size_t storeListSize = 0;
+
+    /** The i-th store from the oldest one. */
+    StoreListEntry &
+    storeAt(size_t i)
+    {
+        return storeList[(storeListHead + i) & (storeList.size() - 1)];
+    }
+
+    /** Adds the youngest store to storeList. */
+    void pushStore(InstSeqNum seq_num, SSID ssid);
 
-    typedef std::map<InstSeqNum, int, ltseqnum>::iterator SeqNumMapIt;
+    /** Drops the invalid stores at both ends of storeList. */
+    void trimStores();
 
     /** Number of loads/stores to process before wiping predictor so all
      * entries don't get saturated
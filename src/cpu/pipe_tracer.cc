@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pipe_tracer.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "arch/generic/pcstate.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "cpu/static_inst.hh"
+#include "params/PipeTracer.hh"
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+PipeTracer::PipeTracer(const Params &p)
+    : SimObject(p), startSeq(p.start_seq), maxInsts(p.max_insts),
+      pcRange(p.pc_range),
+      filename(simout.resolve(
+                  p.trace_file.empty() ? name() + ".bin" : p.trace_file))
+{
+#if !TRACING_ON
+    warn("%s: This build has no tracing support, no instructions will be "
+         "recorded.", name());
+#endif
+
+    fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0664);
+    fatal_if(fd < 0, "%s: Could not open %s: %s.", name(), filename,
+             strerror(errno));
+    grow(maxInsts ? std::min<uint64_t>(maxInsts, 1 << 16) : 1 << 16);
+
+    // The destructor isn't called, so write out the trace on exit.
+    registerExitCallback([this]() { closeTrace(); });
+}
+
+PipeTracer::~PipeTracer()
+{
+    closeTrace();
+}
+
+void
+PipeTracer::grow(uint64_t records)
+{
+    const uint64_t new_capacity = std::max(records, capacity * 2);
+    const size_t old_size = sizeof(Header) + capacity * sizeof(Record);
+    const size_t new_size = sizeof(Header) + new_capacity * sizeof(Record);
+
+    fatal_if(ftruncate(fd, new_size) != 0, "%s: Could not grow %s: %s.",
+             name(), filename, strerror(errno));
+    if (map)
+        munmap(map, old_size);
+    void *addr = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, 0);
+    fatal_if(addr == MAP_FAILED, "%s: Could not map %s: %s.", name(),
+             filename, strerror(errno));
+
+    map = static_cast<char *>(addr);
+    capacity = new_capacity;
+}
+
+void
+PipeTracer::record(InstSeqNum seq_num, const PCStateBase &pc,
+                   const StaticInstPtr &inst, const StageTicks &ticks)
+{
+    if (numRecords == capacity)
+        grow(capacity + 1);
+
+    std::string disasm = inst->disassemble(pc.instAddr());
+    auto [it, inserted] = stringIds.emplace(std::move(disasm),
+                                            strings.size());
+    if (inserted)
+        strings.push_back(it->first);
+
+    Record rec;
+    rec.seqNum = seq_num;
+    rec.pc = pc.instAddr();
+    rec.disasm = it->second;
+    rec.microPC = pc.microPC();
+    std::copy(ticks.begin(), ticks.end(), rec.ticks);
+    std::memcpy(map + sizeof(Header) + numRecords * sizeof(Record), &rec,
+                sizeof(rec));
+    numRecords++;
+}
+
+void
+PipeTracer::closeTrace()
+{
+    if (fd < 0)
+        return;
+
+    Header header;
+    std::memcpy(header.magic, TraceMagic, sizeof(TraceMagic));
+    header.version = TraceVersion;
+    header.recordSize = sizeof(Record);
+    header.numRecords = numRecords;
+    header.numStrings = strings.size();
+    std::memcpy(map, &header, sizeof(header));
+    munmap(map, sizeof(Header) + capacity * sizeof(Record));
+    map = nullptr;
+
+    // Drop the unused part of the mapping and append the strings.
+    const off_t end = sizeof(Header) + numRecords * sizeof(Record);
+    bool ok = ftruncate(fd, end) == 0 && lseek(fd, end, SEEK_SET) == end;
+    for (const auto &str : strings) {
+        const uint32_t len = str.size();
+        ok = ok && write(fd, &len, sizeof(len)) == sizeof(len) &&
+            write(fd, str.data(), len) == (ssize_t)len;
+    }
+    warn_if(!ok, "%s: Could not write out %s: %s.", name(), filename,
+            strerror(errno));
+
+    close(fd);
+    fd = -1;
+}
+
+} // namespace gem5
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PIPE_TRACER_HH__
+#define __CPU_PIPE_TRACER_HH__
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/static_inst_fwd.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+struct PipeTracerParams;
+class PCStateBase;
+
+/**
+ * Records when each instruction went through each stage of a CPU
+ * pipeline, as one fixed size record per instruction in a memory mapped
+ * file. This is what the O3PipeView debug flag prints as text, without
+ * formatting anything while simulating. util/o3-pipeview.py reads the
+ * file directly.
+ *
+ * Only the instructions with a sequence number of at least start_seq
+ * and a PC in pc_range are recorded, up to max_insts of them.
+ */
+class PipeTracer : public SimObject
+{
+  public:
+    enum Stage
+    {
+        Fetch,
+        Decode,
+        Rename,
+        Dispatch,
+        Issue,
+        Complete,
+        Retire,
+        Store,
+        NumStages
+    };
+
+    /** Tick of each stage of an instruction, 0 for the ones it missed */
+    typedef std::array<Tick, NumStages> StageTicks;
+
+    /**
+     * The file starts with a Header, in host byte order. The records
+     * follow, then the disassembly strings the records refer to by
+     * their index, each a uint32_t length followed by the characters.
+     */
+    static constexpr char TraceMagic[8] =
+        {'g', 'e', 'm', '5', 'p', 'i', 'p', '\0'};
+    static constexpr uint32_t TraceVersion = 1;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t recordSize;
+        uint64_t numRecords;
+        uint64_t numStrings;
+    };
+    static_assert(sizeof(Header) == 32);
+
+    struct Record
+    {
+        uint64_t seqNum;
+        uint64_t pc;
+        uint32_t disasm;
+        uint16_t microPC;
+        uint16_t pad = 0;
+        uint64_t ticks[NumStages];
+    };
+    static_assert(sizeof(Record) == 88);
+
+    typedef PipeTracerParams Params;
+    PipeTracer(const Params &p);
+    ~PipeTracer();
+
+    /** Whether an instruction is to be recorded, if it still can be */
+    bool
+    accepts(InstSeqNum seq_num, Addr pc) const
+    {
+        return seq_num >= startSeq && pcRange.contains(pc) &&
+            (!maxInsts || numRecords < maxInsts);
+    }
+
+    /** Record an instruction the tracer accepts */
+    void record(InstSeqNum seq_num, const PCStateBase &pc,
+                const StaticInstPtr &inst, const StageTicks &ticks);
+
+  protected:
+    const InstSeqNum startSeq;
+    const uint64_t maxInsts;
+    const AddrRange pcRange;
+
+    const std::string filename;
+    int fd = -1;
+
+    /** The mapped start of the file, with room for capacity records */
+    char *map = nullptr;
+    uint64_t capacity = 0;
+    uint64_t numRecords = 0;
+
+    /** The disassembly strings and their indices */
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> stringIds;
+
+    /** Map the file with room for at least records records */
+    void grow(uint64_t records);
+
+    void closeTrace();
+};
+
+} // namespace gem5
+
+#endif // __CPU_PIPE_TRACER_HH__
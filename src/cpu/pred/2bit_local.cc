@@ -132,6 +132,20 @@ LocalBP::update(ThreadID tid, Addr branch_addr, bool taken, void *&bp_history,
     }
 }
 
+bool
+LocalBP::takeOverPredictorState(const BPredUnit &old)
+{
+    auto *old_bp = dynamic_cast<const LocalBP *>(&old);
+    if (!old_bp || old_bp->localCtrs.size() != localCtrs.size() ||
+            old_bp->localCtrBits != localCtrBits ||
+            old_bp->indexMask != indexMask) {
+        return false;
+    }
+
+    localCtrs = old_bp->localCtrs;
+    return true;
+}
+
 inline
 bool
 LocalBP::getPrediction(uint8_t &count)
@@ -83,6 +83,8 @@ class LocalBP : public BPredUnit
     void squash(ThreadID tid, void * &bp_history) override
     { assert(bp_history == NULL); }
 
+    bool takeOverPredictorState(const BPredUnit &old) override;
+
   private:
     /**
      *  Returns the taken/not taken prediction given the value of the
@@ -118,6 +118,28 @@ BiModeBP::squash(ThreadID tid, void * &bp_history)
     bp_history = nullptr;
 }
 
+bool
+BiModeBP::takeOverPredictorState(const BPredUnit &old)
+{
+    auto *old_bp = dynamic_cast<const BiModeBP *>(&old);
+    if (!old_bp ||
+            old_bp->choiceCounters.size() != choiceCounters.size() ||
+            old_bp->choiceCtrBits != choiceCtrBits ||
+            old_bp->takenCounters.size() != takenCounters.size() ||
+            old_bp->notTakenCounters.size() != notTakenCounters.size() ||
+            old_bp->globalCtrBits != globalCtrBits ||
+            old_bp->globalHistoryReg.size() != globalHistoryReg.size() ||
+            old_bp->globalHistoryBits != globalHistoryBits) {
+        return false;
+    }
+
+    choiceCounters = old_bp->choiceCounters;
+    takenCounters = old_bp->takenCounters;
+    notTakenCounters = old_bp->notTakenCounters;
+    globalHistoryReg = old_bp->globalHistoryReg;
+    return true;
+}
+
 /*
  * Here we lookup the actual branch prediction. We use the PC to
  * identify the bias of a particular branch, which is based on the
@@ -45,6 +45,7 @@
 #ifndef __CPU_PRED_BI_MODE_PRED_HH__
 #define __CPU_PRED_BI_MODE_PRED_HH__
 
+#include "base/free_list.hh"
 #include "base/sat_counter.hh"
 #include "cpu/pred/bpred_unit.hh"
 #include "params/BiModeBP.hh"
@@ -80,12 +81,13 @@ class BiModeBP : public BPredUnit
     void update(ThreadID tid, Addr pc, bool taken,
                 void * &bp_history, bool squashed,
                 const StaticInstPtr & inst, Addr target) override;
+    bool takeOverPredictorState(const BPredUnit &old) override;
 
   private:
     void updateGlobalHistReg(ThreadID tid, bool taken);
     void uncondBranch(ThreadID tid, Addr pc, void * &bp_history);
 
-    struct BPHistory
+    struct BPHistory : public FreeListAllocated<BPHistory>
     {
         unsigned globalHistoryReg;
         // was the taken array's prediction used?
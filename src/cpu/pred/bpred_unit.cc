@@ -46,6 +46,7 @@
 
 #include "arch/generic/pcstate.hh"
 #include "base/compiler.hh"
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/Branch.hh"
 
@@ -94,6 +95,22 @@ BPredUnit::drainSanityCheck() const
         assert(ph.empty());
 }
 
+void
+BPredUnit::takeOverFrom(BPredUnit *old)
+{
+    assert(old != this);
+
+    if (!takeOverPredictorState(*old)) {
+        warn_once("%s cannot take over the state of %s, the predictor "
+                  "starts with its own tables.\n", name(), old->name());
+    }
+
+    if (btb && old->btb && btb != old->btb)
+        btb->takeOverFrom(*old->btb);
+    if (ras && old->ras && ras != old->ras)
+        ras->takeOverFrom(*old->ras);
+}
+
 
 bool
 BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
@@ -44,6 +44,7 @@
 
 #include <deque>
 
+#include "base/free_list.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
@@ -87,6 +88,16 @@ class BPredUnit : public SimObject
     /** Perform sanity checks after a drain. */
     void drainSanityCheck() const;
 
+    /**
+     * Take over the state of the branch predictor of a CPU that is being
+     * switched out, so that the new CPU starts with warm predictor
+     * tables. The BTB and the RAS state is transferred as well. State
+     * that cannot be transferred (e.g., a different predictor type or
+     * geometry) is left as is.
+     * @param old The predictor of the CPU being switched out.
+     */
+    void takeOverFrom(BPredUnit *old);
+
     /**
      * Predicts whether or not the instruction is a taken branch, and the
      * target of the branch if it is taken.
@@ -145,6 +156,19 @@ class BPredUnit : public SimObject
      */
     virtual bool lookup(ThreadID tid, Addr pc, void * &bp_history) = 0;
 
+    /**
+     * Copies the conditional predictor tables and global histories of
+     * another predictor. Predictors that support it must override this
+     * function.
+     * @param old The predictor to copy the state from.
+     * @return Whether the state has been copied.
+     */
+    virtual bool
+    takeOverPredictorState(const BPredUnit &old)
+    {
+        return false;
+    }
+
     /**
      * Ones done with the prediction this function updates the
      * path and global history. All branches call this function
@@ -245,7 +269,7 @@ class BPredUnit : public SimObject
     void dump();
 
   private:
-    struct PredictorHistory
+    struct PredictorHistory : public FreeListAllocated<PredictorHistory>
     {
         /**
          * Makes a predictor history struct that contains any
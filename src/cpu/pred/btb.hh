@@ -98,6 +98,12 @@ class BranchTargetBuffer : public ClockedObject
                           BranchType type = BranchType::NoBranch,
                           StaticInstPtr inst = nullptr) = 0;
 
+    /** Takes over the entries of the BTB of a CPU being switched out.
+     *  BTBs that can copy their entries override this function.
+     *  @param old The BTB to copy the entries from.
+     */
+    virtual void takeOverFrom(const BranchTargetBuffer &old) {}
+
     /** Update BTB statistics
      */
     virtual void incorrectTarget(Addr inst_pc,
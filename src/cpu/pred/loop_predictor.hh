@@ -44,6 +44,7 @@
 #ifndef __CPU_PRED_LOOP_PREDICTOR_HH__
 #define __CPU_PRED_LOOP_PREDICTOR_HH__
 
+#include "base/free_list.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "sim/sim_object.hh"
@@ -137,7 +138,7 @@ class LoopPredictor : public SimObject
     }
   public:
     // Primary branch history entry
-    struct BranchInfo
+    struct BranchInfo : public FreeListAllocated<BranchInfo>
     {
         uint16_t loopTag;
         uint16_t currentIter;
@@ -287,6 +287,25 @@ MultiperspectivePerceptron::findBest(ThreadID tid,
     }
 }
 
+const std::vector<bool> &
+MultiperspectivePerceptron::bestFeatures(ThreadID tid) const
+{
+    ThreadData &data = *threadData[tid];
+    if (!data.isBestValid) {
+        std::vector<int> best_preds(specs.size(), -1);
+        findBest(tid, best_preds);
+
+        data.isBest.assign(specs.size(), false);
+        for (int j = 0; j < std::min(nbest, (int) best_preds.size()); j += 1) {
+            if (best_preds[j] >= 0) {
+                data.isBest[best_preds[j]] = true;
+            }
+        }
+        data.isBestValid = true;
+    }
+    return data.isBest;
+}
+
 unsigned int
 MultiperspectivePerceptron::getIndex(ThreadID tid, const MPPBranchInfo &bi,
                                      const HistorySpec &spec, int index) const
@@ -321,9 +340,6 @@ MultiperspectivePerceptron::getIndex(ThreadID tid, const MPPBranchInfo &bi,
 int
 MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
 {
-    // list of best predictors
-    std::vector<int> best_preds(specs.size(), -1);
-
     // initialize sum
     bi.yout = 0;
 
@@ -342,7 +358,7 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
     }
     // find the best subset of features to use in case of a low-confidence
     // branch
-    findBest(tid, best_preds);
+    const std::vector<bool> &is_best = bestFeatures(tid);
 
     // begin computation of the sum for low-confidence branch
     int bestval = 0;
@@ -364,16 +380,8 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
         // add the value
         bi.yout += val;
         // if this is one of those good features, add the value to bestval
-        if (threshold >= 0) {
-            for (int j = 0;
-                 j < std::min(nbest, (int) best_preds.size());
-                 j += 1)
-            {
-                if (best_preds[j] == i) {
-                    bestval += val;
-                    break;
-                }
-            }
+        if (threshold >= 0 && is_best[i]) {
+            bestval += val;
         }
     }
     // apply a fudge factor to affect when training is triggered
@@ -446,6 +454,7 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
             bool pred = weight >= 1;
             if (pred != taken) {
                 mpreds[i] += 1;
+                threadData[tid]->isBestValid = false;
                 if (mpreds[i] == (1 << tunebits) - 1) {
                     halve = true;
                 }
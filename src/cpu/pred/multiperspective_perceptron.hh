@@ -54,6 +54,7 @@
 #include <array>
 #include <vector>
 
+#include "base/free_list.hh"
 #include "cpu/pred/bpred_unit.hh"
 #include "params/MultiperspectivePerceptron.hh"
 
@@ -69,7 +70,7 @@ class MultiperspectivePerceptron : public BPredUnit
     /**
      * Branch information data
      */
-    class MPPBranchInfo
+    class MPPBranchInfo : public FreeListAllocated<MPPBranchInfo>
     {
         /** pc of the branch */
         const unsigned int pc;
@@ -365,6 +366,10 @@ class MultiperspectivePerceptron : public BPredUnit
         int occupancy;
 
         std::vector<int> mpreds;
+        /** Cached result of findBest(), as a flag per feature. It only
+         *  changes when mpreds does, so it is recomputed lazily */
+        std::vector<bool> isBest;
+        bool isBestValid = false;
         std::vector<std::vector<short int>> tables;
         std::vector<std::vector<std::array<bool, 2>>> sign_bits;
     };
@@ -468,6 +473,15 @@ class MultiperspectivePerceptron : public BPredUnit
      */
     void findBest(ThreadID tid, std::vector<int> &best_preds) const;
 
+    /**
+     * Get the best subset of features, as found by findBest(), for a
+     * thread. The result is cached until the misprediction counters of
+     * the thread change.
+     * @param tid Thread ID of the branch
+     * @return A flag per predictor table, set for the best tables
+     */
+    const std::vector<bool> &bestFeatures(ThreadID tid) const;
+
     /**
      * Computes the output of the predictor for a given branch and the
      * resulting best value in case the prediction has low confidence
@@ -42,6 +42,7 @@
 
 #include <iomanip>
 
+#include "base/logging.hh"
 #include "debug/RAS.hh"
 
 namespace gem5
@@ -153,6 +154,25 @@ ReturnAddrStack::reset()
         r.reset();
 }
 
+void
+ReturnAddrStack::takeOverFrom(const ReturnAddrStack &old)
+{
+    if (old.numEntries != numEntries || old.numThreads != numThreads) {
+        warn_once("%s has a different size than %s, its stacks are not "
+                  "taken over.\n", name(), old.name());
+        return;
+    }
+
+    for (unsigned i = 0; i < numThreads; ++i) {
+        const AddrStack &from = old.addrStacks[i];
+        AddrStack &to = addrStacks[i];
+        for (unsigned j = 0; j < numEntries; ++j)
+            set(to.addrStack[j], from.addrStack[j]);
+        to.usedEntries = from.usedEntries;
+        to.tos = from.tos;
+    }
+}
+
 void
 ReturnAddrStack::makeRASHistory(void* &ras_history)
 {
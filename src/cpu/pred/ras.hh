@@ -44,6 +44,7 @@
 #include <vector>
 
 #include "arch/generic/pcstate.hh"
+#include "base/free_list.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/pred/branch_type.hh"
@@ -147,6 +148,12 @@ class ReturnAddrStack : public SimObject
 
     void reset();
 
+    /**
+     * Takes over the stacks of the RAS of a CPU being switched out.
+     * @param old The RAS to copy the stacks from.
+     */
+    void takeOverFrom(const ReturnAddrStack &old);
+
     /**
      * Pushes an address onto the RAS.
      * @param PC The current PC (should be a call).
@@ -181,7 +188,7 @@ class ReturnAddrStack : public SimObject
 
   private:
 
-    class RASHistory
+    class RASHistory : public FreeListAllocated<RASHistory>
     {
       public:
         /* Was the RAS pushed or poped for this branch. */
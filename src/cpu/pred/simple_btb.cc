@@ -41,6 +41,7 @@
 #include "cpu/pred/simple_btb.hh"
 
 #include "base/intmath.hh"
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/BTB.hh"
 
@@ -84,6 +85,30 @@ SimpleBTB::memInvalidate()
     }
 }
 
+void
+SimpleBTB::takeOverFrom(const BranchTargetBuffer &old)
+{
+    auto *old_btb = dynamic_cast<const SimpleBTB *>(&old);
+    if (!old_btb || old_btb->numEntries != numEntries ||
+            old_btb->tagBits != tagBits ||
+            old_btb->instShiftAmt != instShiftAmt ||
+            old_btb->log2NumThreads != log2NumThreads) {
+        warn_once("%s has a different layout than %s, its entries are not "
+                  "taken over.\n", name(), old.name());
+        return;
+    }
+
+    for (unsigned i = 0; i < numEntries; ++i) {
+        const BTBEntry &from = old_btb->btb[i];
+        BTBEntry &to = btb[i];
+        to.tag = from.tag;
+        to.tid = from.tid;
+        to.valid = from.valid;
+        to.inst = from.inst;
+        set(to.target, from.target);
+    }
+}
+
 inline
 unsigned
 SimpleBTB::getIndex(Addr instPC, ThreadID tid)
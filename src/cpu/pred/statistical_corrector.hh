@@ -42,6 +42,7 @@
 #ifndef __CPU_PRED_STATISTICAL_CORRECTOR_HH__
 #define __CPU_PRED_STATISTICAL_CORRECTOR_HH__
 
+#include "base/free_list.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/static_inst.hh"
@@ -197,7 +198,7 @@ class StatisticalCorrector : public SimObject
     } stats;
 
   public:
-    struct BranchInfo
+    struct BranchInfo : public FreeListAllocated<BranchInfo>
     {
         BranchInfo() : lowConf(false), highConf(false), altConf(false),
               medConf(false), scPred(false), lsum(0), thres(0),
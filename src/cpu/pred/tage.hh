@@ -62,6 +62,7 @@
 
 #include <vector>
 
+#include "base/free_list.hh"
 #include "base/types.hh"
 #include "cpu/pred/bpred_unit.hh"
 #include "cpu/pred/tage_base.hh"
@@ -78,7 +79,7 @@ class TAGE: public BPredUnit
   protected:
     TAGEBase *tage;
 
-    struct TageBranchInfo
+    struct TageBranchInfo : public FreeListAllocated<TageBranchInfo>
     {
         TAGEBase::BranchInfo *tageBranchInfo;
 
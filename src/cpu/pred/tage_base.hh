@@ -50,6 +50,7 @@
 
 #include <vector>
 
+#include "base/free_list.hh"
 #include "base/statistics.hh"
 #include "cpu/null_static_inst.hh"
 #include "cpu/static_inst.hh"
@@ -125,7 +126,7 @@ class TAGEBase : public SimObject
     };
 
     // Primary branch history entry
-    struct BranchInfo
+    struct BranchInfo : public FreeListAllocated<BranchInfo>
     {
         int pathHist;
         int ptGhist;
@@ -144,8 +145,10 @@ class TAGEBase : public SimObject
 
         // Pointer to dynamically allocated storage
         // to save table indices and folded histories.
-        // To do one call to new instead of five.
+        // To do one call to new instead of five. It is
+        // recycled through the free list as well.
         int *storage;
+        size_t storageSize;
 
         // Pointers to actual saved array within the dynamically
         // allocated storage.
@@ -169,7 +172,8 @@ class TAGEBase : public SimObject
               provider(-1)
         {
             int sz = tage.nHistoryTables + 1;
-            storage = new int [sz * 5];
+            storageSize = sizeof(int) * sz * 5;
+            storage = static_cast<int *>(FreeList::allocate(storageSize));
             tableIndices = storage;
             tableTags = storage + sz;
             ci = tableTags + sz;
@@ -179,7 +183,7 @@ class TAGEBase : public SimObject
 
         virtual ~BranchInfo()
         {
-            delete[] storage;
+            FreeList::deallocate(storage, storageSize);
         }
     };
 
@@ -320,6 +320,31 @@ TournamentBP::squash(ThreadID tid, void * &bp_history)
     bp_history = nullptr;
 }
 
+bool
+TournamentBP::takeOverPredictorState(const BPredUnit &old)
+{
+    auto *old_bp = dynamic_cast<const TournamentBP *>(&old);
+    if (!old_bp || old_bp->localCtrs.size() != localCtrs.size() ||
+            old_bp->localCtrBits != localCtrBits ||
+            old_bp->localHistoryTable.size() != localHistoryTable.size() ||
+            old_bp->localHistoryBits != localHistoryBits ||
+            old_bp->globalCtrs.size() != globalCtrs.size() ||
+            old_bp->globalCtrBits != globalCtrBits ||
+            old_bp->globalHistory.size() != globalHistory.size() ||
+            old_bp->globalHistoryBits != globalHistoryBits ||
+            old_bp->choiceCtrs.size() != choiceCtrs.size() ||
+            old_bp->choiceCtrBits != choiceCtrBits) {
+        return false;
+    }
+
+    localCtrs = old_bp->localCtrs;
+    localHistoryTable = old_bp->localHistoryTable;
+    globalCtrs = old_bp->globalCtrs;
+    globalHistory = old_bp->globalHistory;
+    choiceCtrs = old_bp->choiceCtrs;
+    return true;
+}
+
 #ifdef GEM5_DEBUG
 int
 TournamentBP::BPHistory::newCount = 0;
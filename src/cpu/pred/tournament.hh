@@ -44,6 +44,7 @@
 
 #include <vector>
 
+#include "base/free_list.hh"
 #include "base/sat_counter.hh"
 #include "base/types.hh"
 #include "cpu/pred/bpred_unit.hh"
@@ -79,6 +80,7 @@ class TournamentBP : public BPredUnit
                 void * &bp_history, bool squashed,
                 const StaticInstPtr & inst, Addr target) override;
     void squash(ThreadID tid, void * &bp_history) override;
+    bool takeOverPredictorState(const BPredUnit &old) override;
 
   private:
     /**
@@ -113,7 +115,7 @@ class TournamentBP : public BPredUnit
      * when the BP can use this information to update/restore its
      * state properly.
      */
-    struct BPHistory
+    struct BPHistory : public FreeListAllocated<BPHistory>
     {
 #ifdef GEM5_DEBUG
         BPHistory()
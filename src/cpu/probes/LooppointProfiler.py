@@ -0,0 +1,63 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects import SimObject
+from m5.objects.Probe import ProbeListenerObject
+from m5.params import *
+
+
+class LooppointProfiler(SimObject):
+    """Divides the execution of a multithreaded program into LoopPoint
+    regions ending at loop entries, and writes the basic block vector of
+    each region, counted across all the cores, to profile_file. It is fed
+    by a LooppointProfilerProbe on each core. The regions are clustered by
+    gem5.utils.looppoint_profile.
+    """
+
+    type = "LooppointProfiler"
+    cxx_header = "cpu/probes/looppoint_profiler.hh"
+    cxx_class = "gem5::LooppointProfiler"
+
+    region_length = Param.UInt64(
+        100000000,
+        "Minimum number of instructions retired by all the cores in a region",
+    )
+    max_inst_size = Param.Unsigned(
+        16,
+        "Largest instruction size in bytes, a retired PC further than this "
+        "from the previous one starts a new basic block",
+    )
+    profile_file = Param.String("looppoint.profile", "Profile (output) file")
+
+
+class LooppointProfilerProbe(ProbeListenerObject):
+    """Passes the instructions retired by a core to a LooppointProfiler."""
+
+    type = "LooppointProfilerProbe"
+    cxx_header = "cpu/probes/looppoint_profiler.hh"
+    cxx_class = "gem5::LooppointProfilerProbe"
+
+    profiler = Param.LooppointProfiler("the LooppointProfiler")
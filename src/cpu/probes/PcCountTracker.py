@@ -48,6 +48,16 @@ class PcCountTrackerManager(SimObject):
 
     targets = VectorParam.PcCountPair("the target PC Count pairs")
 
+    exit_on_target = Param.Bool(
+        True, "Raise an exit event when a target is encountered"
+    )
+    roi_end_targets = VectorParam.PcCountPair(
+        [],
+        "Targets that end a region of interest, all the other ones begin "
+        "one. Regions are reported through the RegionOfInterest probe "
+        "point.",
+    )
+
 
 class PcCountTracker(ProbeListenerObject):
     """This probe listener tracks the number of times a particular pc has been
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/probes/looppoint_profiler.hh"
+
+#include <algorithm>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "params/LooppointProfiler.hh"
+#include "params/LooppointProfilerProbe.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+LooppointProfiler::LooppointProfiler(const LooppointProfilerParams &p)
+    : SimObject(p), regionLength(p.region_length),
+      maxInstSize(p.max_inst_size)
+{
+    fatal_if(regionLength == 0, "%s: region_length must not be 0", name());
+
+    profileStream = simout.create(p.profile_file, false);
+    if (!profileStream)
+        fatal("unable to open LooppointProfiler profile_file");
+
+    // The destructor isn't called, so end the last region on exit.
+    registerExitCallback([this]() { closeProfile(); });
+}
+
+unsigned
+LooppointProfiler::addCore()
+{
+    cores.emplace_back();
+    return cores.size() - 1;
+}
+
+void
+LooppointProfiler::flushBlock(CoreState &core, unsigned index)
+{
+    if (!core.blockInsts)
+        return;
+
+    const size_t idx = core.block * cores.size() + index;
+    if (idx >= counts.size())
+        counts.resize(std::max(idx + 1, 2 * counts.size()));
+    if (counts[idx] == 0)
+        active.push_back(idx);
+    counts[idx] += core.blockInsts;
+    core.blockInsts = 0;
+}
+
+void
+LooppointProfiler::retire(unsigned index, Addr pc)
+{
+    CoreState &core = cores[index];
+    const uint64_t count = ++pcCounts[pc];
+
+    if (!core.started && regionId == 0 && regionInsts == 0) {
+        // The first region starts with the first instruction retired.
+        startPc = pc;
+        startCount = count;
+    }
+
+    // Anything but the next instruction starts a new basic block, and
+    // jumping backwards enters a loop.
+    const bool sequential = core.started && pc > core.lastPc &&
+        pc - core.lastPc <= maxInstSize;
+    const bool loop_entry = core.started && pc <= core.lastPc;
+    if (!sequential) {
+        flushBlock(core, index);
+        core.block = blockIds.emplace(pc, blockIds.size()).first->second;
+    }
+    core.lastPc = pc;
+    core.started = true;
+    core.blockInsts++;
+    regionInsts++;
+
+    if (loop_entry) {
+        lastEntryPc = pc;
+        if (regionInsts >= regionLength)
+            endRegion(pc, count);
+    }
+}
+
+void
+LooppointProfiler::endRegion(Addr pc, uint64_t count)
+{
+    for (unsigned i = 0; i < cores.size(); i++)
+        flushBlock(cores[i], i);
+
+    std::ostream &os = *profileStream->stream();
+    ccprintf(os, "region %d %#x %d %#x %d %d\n", regionId, startPc,
+             startCount, pc, count, regionInsts);
+
+    std::sort(active.begin(), active.end());
+    os << "bbv";
+    for (size_t idx : active) {
+        os << " :" << idx + 1 << ":" << counts[idx];
+        counts[idx] = 0;
+    }
+    os << "\n";
+    active.clear();
+
+    regionId++;
+    startPc = pc;
+    startCount = count;
+    regionInsts = 0;
+}
+
+void
+LooppointProfiler::closeProfile()
+{
+    if (!profileStream)
+        return;
+
+    // End the last region at the last loop entry retired, which is
+    // reached when the last iteration of that loop has been entered.
+    if (regionInsts)
+        endRegion(lastEntryPc, pcCounts[lastEntryPc]);
+
+    simout.close(profileStream);
+    profileStream = nullptr;
+}
+
+LooppointProfilerProbe::LooppointProfilerProbe(
+        const LooppointProfilerProbeParams &p)
+    : ProbeListenerObject(p), profiler(p.profiler),
+      coreIndex(p.profiler->addCore())
+{
+}
+
+void
+LooppointProfilerProbe::regProbeListeners()
+{
+    typedef ProbeListenerArg<LooppointProfilerProbe, Addr>
+        RetiredInstsPcListener;
+    listeners.push_back(new RetiredInstsPcListener(this, "RetiredInstsPC",
+                &LooppointProfilerProbe::retire));
+}
+
+} // namespace gem5
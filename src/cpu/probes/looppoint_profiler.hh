@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __CPU_PROBES_LOOPPOINT_PROFILER_HH__
+#define __CPU_PROBES_LOOPPOINT_PROFILER_HH__
+
+#include <unordered_map>
+#include <vector>
+
+#include "base/output.hh"
+#include "base/types.hh"
+#include "sim/probe/probe.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+struct LooppointProfilerParams;
+struct LooppointProfilerProbeParams;
+
+/**
+ * Profiler dividing the execution of a multithreaded program into
+ * LoopPoint regions. A region ends at the first loop entry retired by any
+ * core once all the cores together retired at least region_length
+ * instructions in it. A loop entry is the target of a backward jump, and
+ * the boundary is recorded as the PC of the entry and the number of
+ * times it was retired by all the cores, which is what a
+ * PcCountTrackerManager looks for.
+ *
+ * The basic block vector of each region, with the blocks of each core
+ * counted separately, is written to the profile file, one region per
+ * two lines:
+ *
+ *   region <id> <start pc> <start count> <end pc> <end count> <insts>
+ *   bbv :<block>:<insts> :<block>:<insts> ...
+ *
+ * gem5.utils.looppoint_profile clusters the regions and selects the
+ * ones to simulate.
+ */
+class LooppointProfiler : public SimObject
+{
+  public:
+    LooppointProfiler(const LooppointProfilerParams &params);
+
+    /** Add a core, returning the index to retire its instructions with */
+    unsigned addCore();
+
+    /** An instruction retired on a core */
+    void retire(unsigned core, Addr pc);
+
+  private:
+    struct CoreState
+    {
+        /** PC of the last retired instruction */
+        Addr lastPc = 0;
+        /** Block being executed and the instructions retired in it */
+        size_t block = SIZE_MAX;
+        uint64_t blockInsts = 0;
+        bool started = false;
+    };
+
+    /** Add the instructions of the block a core is in to the bbv */
+    void flushBlock(CoreState &core, unsigned index);
+
+    /** Write out the region so far and start the next one at pc */
+    void endRegion(Addr pc, uint64_t count);
+
+    void closeProfile();
+
+    const uint64_t regionLength;
+    const Addr maxInstSize;
+
+    std::vector<CoreState> cores;
+
+    /** Number of times each PC was retired by any core */
+    std::unordered_map<Addr, uint64_t> pcCounts;
+
+    /** IDs of the basic blocks, by the PC they start at */
+    std::unordered_map<Addr, size_t> blockIds;
+
+    /**
+     * Instructions retired in each block of each core in this region,
+     * indexed by block ID times the number of cores plus the core, and
+     * the indices which are not zero.
+     */
+    std::vector<uint64_t> counts;
+    std::vector<size_t> active;
+
+    /** The region being profiled */
+    unsigned regionId = 0;
+    Addr startPc = 0;
+    uint64_t startCount = 0;
+    uint64_t regionInsts = 0;
+
+    /** The last loop entry retired, to end the last region with */
+    Addr lastEntryPc = 0;
+
+    OutputStream *profileStream = nullptr;
+};
+
+/** Probe listener passing the instructions retired by a core on */
+class LooppointProfilerProbe : public ProbeListenerObject
+{
+  public:
+    LooppointProfilerProbe(const LooppointProfilerProbeParams &params);
+
+    void regProbeListeners() override;
+
+    void retire(const Addr &pc) { profiler->retire(coreIndex, pc); }
+
+  private:
+    LooppointProfiler *profiler;
+    const unsigned coreIndex;
+};
+
+} // namespace gem5
+
+#endif // __CPU_PROBES_LOOPPOINT_PROFILER_HH__
@@ -33,7 +33,9 @@ namespace gem5
 
 PcCountTrackerManager::PcCountTrackerManager(
     const PcCountTrackerManagerParams &p)
-    : SimObject(p)
+    : SimObject(p), exitOnTarget(p.exit_on_target),
+      roiEnd(p.roi_end_targets.begin(), p.roi_end_targets.end()),
+      ppRegionOfInterest(nullptr)
 {
     currentPair = PcCountPair(0,0);
     ifListNotEmpty = true;
@@ -67,9 +69,12 @@ PcCountTrackerManager::checkCount(Addr pc)
             DPRINTF(PcCountTracker,
                 "pc:%s encountered\n", currentPair.to_string());
 
-            exitSimLoopNow("simpoint starting point found");
+            if (exitOnTarget)
+                exitSimLoopNow("simpoint starting point found");
             // raise the SIMPOINT_BEGIN exit event
 
+            ppRegionOfInterest->notify(!roiEnd.count(currentPair));
+
             targetPair.erase(currentPair);
             // erase the encountered PC Count pair from the target pairs
             DPRINTF(PcCountTracker,
@@ -85,4 +90,12 @@ PcCountTrackerManager::checkCount(Addr pc)
     }
 }
 
+void
+PcCountTrackerManager::regProbePoints()
+{
+    SimObject::regProbePoints();
+    ppRegionOfInterest = new ProbePointArg<bool>(getProbeManager(),
+                                                 "RegionOfInterest");
+}
+
 }
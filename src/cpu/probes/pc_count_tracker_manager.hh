@@ -34,6 +34,7 @@
 
 #include "cpu/base.hh"
 #include "params/PcCountTrackerManager.hh"
+#include "sim/probe/probe.hh"
 #include "sim/sim_exit.hh"
 #include "debug/PcCountTracker.hh"
 
@@ -50,6 +51,8 @@ class PcCountTrackerManager : public SimObject {
      */
     void checkCount(Addr pc);
 
+    void regProbePoints() override;
+
   private:
     /** a counter that stores all the target PC addresses and the number
      * of times the target PC has been executed
@@ -72,6 +75,15 @@ class PcCountTrackerManager : public SimObject {
      */
     bool ifListNotEmpty;
 
+    /** whether to raise an exit event when a target is encountered */
+    const bool exitOnTarget;
+
+    /** the targets that end a region of interest rather than begin one */
+    std::unordered_set<PcCountPair, PcCountPair::HashFunction> roiEnd;
+
+    /** notified with whether an encountered target begins a region */
+    ProbePointArg<bool> *ppRegionOfInterest;
+
   public:
 
     /** this function returns the corresponding value of count for the
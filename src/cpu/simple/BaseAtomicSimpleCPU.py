@@ -61,6 +61,18 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    fetch_buffer = Param.Bool(
+        False,
+        "Fetch whole cache lines and serve the following fetches from "
+        "the same line without accessing the memory system. Speeds up "
+        "fast-forwarding, but the icache only sees the first fetch to "
+        "each line",
+    )
+    fuse_macroops = Param.Bool(
+        False,
+        "Execute all the microops of a macroop in the same cycle, "
+        "counting them against the width as a single instruction",
+    )
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
@@ -33,6 +33,15 @@ class BaseTimingSimpleCPU(BaseSimpleCPU):
     cxx_header = "cpu/simple/timing.hh"
     cxx_class = "gem5::TimingSimpleCPU"
 
+    fetch_buffer = Param.Bool(
+        False,
+        "Keep the last fetched cache line and serve sequential fetches "
+        "from it instead of the icache",
+    )
+    fetch_buffer_latency = Param.Cycles(
+        1, "Latency of a fetch served by the fetch buffer"
+    )
+
     @classmethod
     def memory_mode(cls):
         return "timing"
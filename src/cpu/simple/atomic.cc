@@ -78,16 +78,19 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       width(p.width), locked(false),
       simulate_data_stalls(p.simulate_data_stalls),
       simulate_inst_stalls(p.simulate_inst_stalls),
+      fuseMacroops(p.fuse_macroops),
+      fetchBufferEnabled(p.fetch_buffer), fetchBufferValid(false),
+      fetchBufferAddr(0), fetchBuffer(p.system->cacheLineSize()),
       icachePort(name() + ".icache_port"),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
       ppCommit(nullptr)
 {
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
-    data_amo_req = std::make_shared<Request>();
+    ifetch_req = makeRequest();
+    data_read_req = makeRequest();
+    data_write_req = makeRequest();
+    data_amo_req = makeRequest();
 }
 
 
@@ -148,6 +151,9 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // memory may have been changed behind our back while drained
+    fetchBufferValid = false;
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -298,6 +304,7 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
             t_info->thread->getIsaPtr()->handleLockedSnoop(pkt,
                     cacheBlockMask);
         }
+        cpu->invalidateFetchBuffer(pkt->getAddr(), pkt->getSize());
     }
 
     return 0;
@@ -325,6 +332,9 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
                     cacheBlockMask);
         }
     }
+
+    if (pkt->isInvalidate() || pkt->isWrite())
+        cpu->invalidateFetchBuffer(pkt->getAddr(), pkt->getSize());
 }
 
 bool
@@ -495,6 +505,8 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                 Packet pkt(req, Packet::makeWriteCmd(req));
                 pkt.dataStatic(data);
 
+                invalidateFetchBuffer(req->getPaddr(), req->getSize());
+
                 if (req->isLocalAccess()) {
                     dcache_latency +=
                         req->localAccessor(thread->getTC(), &pkt);
@@ -586,6 +598,8 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
         Packet pkt(req, Packet::makeWriteCmd(req));
         pkt.dataStatic(data);
 
+        invalidateFetchBuffer(req->getPaddr(), req->getSize());
+
         if (req->isLocalAccess()) {
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         } else {
@@ -630,9 +644,14 @@ AtomicSimpleCPU::tick()
 
     Tick latency = 0;
 
+    // Whether the previous microop was fused with this one
+    bool fused = false;
+
     for (int i = 0; i < width || locked; ++i) {
-        baseStats.numCycles++;
-        updateCycleCounters(BaseCPU::CPU_STATE_ON);
+        if (!fused) {
+            baseStats.numCycles++;
+            updateCycleCounters(BaseCPU::CPU_STATE_ON);
+        }
 
         if (!curStaticInst || !curStaticInst->isDelayedCommit()) {
             checkForInterrupts();
@@ -686,7 +705,10 @@ AtomicSimpleCPU::tick()
                 // keep an instruction count
                 if (fault == NoFault) {
                     countInst();
-                    ppCommit->notify(std::make_pair(thread, curStaticInst));
+                    if (ppCommit->hasListeners()) {
+                        ppCommit->notify(
+                            std::make_pair(thread, curStaticInst));
+                    }
                 } else if (traceData) {
                     traceFault();
                 }
@@ -725,6 +747,12 @@ AtomicSimpleCPU::tick()
         }
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
+
+        // Keep going with the rest of the macroop in this cycle
+        fused = fuseMacroops && fault == NoFault && !t_info.stayAtPC &&
+            curMacroStaticInst;
+        if (fused)
+            --i;
     }
 
     if (tryCompleteDrain())
@@ -743,15 +771,49 @@ AtomicSimpleCPU::fetchInstMem()
 {
     auto &decoder = threadInfo[curThread]->thread->decoder;
 
-    Packet pkt = Packet(ifetch_req, MemCmd::ReadReq);
+    const Addr paddr = ifetch_req->getPaddr();
+    const Addr line_addr = roundDown(paddr, fetchBuffer.size());
+    const bool bufferable = fetchBufferEnabled &&
+        !ifetch_req->isUncacheable() && !ifetch_req->isLocalAccess() &&
+        paddr + ifetch_req->getSize() <= line_addr + fetchBuffer.size();
+
+    if (!bufferable) {
+        Packet pkt = Packet(ifetch_req, MemCmd::ReadReq);
+
+        // ifetch_req is initialized to read the instruction
+        // directly into the CPU object's inst field.
+        pkt.dataStatic(decoder->moreBytesPtr());
 
-    // ifetch_req is initialized to read the instruction
-    // directly into the CPU object's inst field.
-    pkt.dataStatic(decoder->moreBytesPtr());
+        Tick latency = sendPacket(icachePort, &pkt);
+        panic_if(pkt.isError(), "Instruction fetch (%s) failed: %s",
+                pkt.getAddrRange().to_string(), pkt.print());
+
+        return latency;
+    }
+
+    Tick latency = 0;
+    if (!fetchBufferValid || fetchBufferAddr != line_addr) {
+        // fetch the whole line, inheriting the attributes the MMU
+        // gave the original request
+        auto req = std::make_shared<Request>(line_addr, fetchBuffer.size(),
+            ifetch_req->getFlags(), instRequestorId());
+        if (ifetch_req->hasContextId())
+            req->setContext(ifetch_req->contextId());
+        req->taskId(ifetch_req->taskId());
+
+        Packet pkt = Packet(req, MemCmd::ReadReq);
+        pkt.dataStatic(fetchBuffer.data());
+
+        latency = sendPacket(icachePort, &pkt);
+        panic_if(pkt.isError(), "Instruction fetch (%s) failed: %s",
+                pkt.getAddrRange().to_string(), pkt.print());
+
+        fetchBufferAddr = line_addr;
+        fetchBufferValid = true;
+    }
 
-    Tick latency = sendPacket(icachePort, &pkt);
-    panic_if(pkt.isError(), "Instruction fetch (%s) failed: %s",
-            pkt.getAddrRange().to_string(), pkt.print());
+    memcpy(decoder->moreBytesPtr(), fetchBuffer.data() + (paddr - line_addr),
+           ifetch_req->getSize());
 
     return latency;
 }
@@ -67,6 +67,35 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
+    /**
+     * Run the microops following the first one of a macroop in the same
+     * iteration of the tick loop, so a macroop costs one cycle and one
+     * slot of the width however many microops it expands to.
+     */
+    const bool fuseMacroops;
+
+    /**
+     * Copy of the cache line the last instruction fetch came from, in
+     * use when the fetch buffer is enabled. It is indexed by physical
+     * address, so the MMU is still consulted for every fetch, and it
+     * is invalidated by any write to the line that this CPU performs
+     * or snoops.
+     */
+    const bool fetchBufferEnabled;
+    bool fetchBufferValid;
+    Addr fetchBufferAddr;
+    std::vector<uint8_t> fetchBuffer;
+
+    /** Drop the fetch buffer if it overlaps with [addr, addr + size). */
+    void
+    invalidateFetchBuffer(Addr addr, Addr size)
+    {
+        if (fetchBufferValid && addr < fetchBufferAddr + fetchBuffer.size() &&
+            fetchBufferAddr < addr + size) {
+            fetchBufferValid = false;
+        }
+    }
+
     // main simulation loop (one cycle)
     void tick();
 
@@ -141,7 +170,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     {
 
       public:
-        AtomicCPUDPort(const std::string &_name, BaseSimpleCPU *_cpu)
+        AtomicCPUDPort(const std::string &_name, AtomicSimpleCPU *_cpu)
             : AtomicCPUPort(_name), cpu(_cpu)
         {
             cacheBlockMask = ~(cpu->cacheLineSize() - 1);
@@ -151,7 +180,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
         Addr cacheBlockMask;
       protected:
-        BaseSimpleCPU *cpu;
+        AtomicSimpleCPU *cpu;
 
         virtual Tick recvAtomicSnoop(PacketPtr pkt);
         virtual void recvFunctionalSnoop(PacketPtr pkt);
@@ -93,6 +93,12 @@ class BaseSimpleCPU : public BaseCPU
     BaseSimpleCPU(const BaseSimpleCPUParams &params);
     virtual ~BaseSimpleCPU();
     void wakeup(ThreadID tid) override;
+
+    branch_prediction::BPredUnit *
+    getBranchPredictor() const override
+    {
+        return branchPred;
+    }
   public:
     trace::InstRecord *traceData;
     CheckerCPU *checker;
@@ -46,3 +46,8 @@ class SimPoint(ProbeListenerObject):
 
     interval = Param.UInt64(100000000, "Interval Size (insts)")
     profile_file = Param.String("simpoint.bb.gz", "BBV (output) file")
+    binary_output = Param.Bool(
+        False,
+        "Write the BBVs as binary counts instead of text, see "
+        "util/decode_bbv.py",
+    )
@@ -37,7 +37,10 @@
 
 #include "cpu/simple/probes/simpoint.hh"
 
+#include <algorithm>
+
 #include "base/output.hh"
+#include "sim/sim_exit.hh"
 
 namespace gem5
 {
@@ -51,6 +54,23 @@ SimPoint::SimPoint(const SimPointParams &p)
       currentBBV(0, 0),
       currentBBVInstCount(0)
 {
+    if (p.binary_output) {
+        const std::string &name = p.profile_file;
+        const std::string suffix = ".gz";
+        const bool compress = name.size() >= suffix.size() &&
+            name.compare(name.size() - suffix.size(), suffix.size(),
+                         suffix) == 0;
+        binaryStream.reset(new AsyncWriter(simout.resolve(name), 1 << 20,
+                                           compress));
+        binaryStream->write(BinaryMagic, sizeof(BinaryMagic));
+        binaryStream->put(BinaryVersion);
+        binaryStream->put<uint64_t>(intervalSize);
+
+        // The destructor isn't called, so write out the file on exit.
+        registerExitCallback([this]() { closeStreams(); });
+        return;
+    }
+
     simpointStream = simout.create(p.profile_file, false);
     if (!simpointStream)
         fatal("unable to open SimPoint profile_file");
@@ -58,7 +78,17 @@ SimPoint::SimPoint(const SimPointParams &p)
 
 SimPoint::~SimPoint()
 {
-    simout.close(simpointStream);
+    closeStreams();
+}
+
+void
+SimPoint::closeStreams()
+{
+    if (simpointStream) {
+        simout.close(simpointStream);
+        simpointStream = NULL;
+    }
+    binaryStream.reset();
 }
 
 void
@@ -74,6 +104,30 @@ SimPoint::regProbeListeners()
                                              &SimPoint::profile));
 }
 
+size_t
+SimPoint::blockIndex(const BasicBlockRange &range)
+{
+    CachedBlock &cached =
+        blockCache[std::hash<BasicBlockRange>()(range) % BlockCacheSize];
+    if (cached.index != SIZE_MAX && cached.range == range)
+        return cached.index;
+
+    auto [map_itr, inserted] = bbMap.emplace(range, blocks.size());
+    if (inserted) {
+        // If a new (previously unseen) basic block is found, give it
+        // the next unique id and record its num of insts.
+        BBInfo info;
+        info.id = blocks.size() + 1;
+        info.insts = currentBBVInstCount;
+        info.count = 0;
+        blocks.push_back(info);
+    }
+
+    cached.range = range;
+    cached.index = map_itr->second;
+    return cached.index;
+}
+
 void
 SimPoint::profile(const std::pair<SimpleThread*, StaticInstPtr>& p)
 {
@@ -93,53 +147,54 @@ SimPoint::profile(const std::pair<SimpleThread*, StaticInstPtr>& p)
     if (inst->isControl()) {
         currentBBV.second = thread->pcState().instAddr();
 
-        auto map_itr = bbMap.find(currentBBV);
-        if (map_itr == bbMap.end()){
-            // If a new (previously unseen) basic block is found,
-            // add a new unique id, record num of insts and insert
-            // into bbMap.
-            BBInfo info;
-            info.id = bbMap.size() + 1;
-            info.insts = currentBBVInstCount;
-            info.count = currentBBVInstCount;
-            bbMap.insert(std::make_pair(currentBBV, info));
-        } else {
-            // If basic block is seen before, just increment the count by the
-            // number of insts in basic block.
-            BBInfo& info = map_itr->second;
-            info.count += currentBBVInstCount;
-        }
+        // Increment the count of the basic block by the number of insts
+        // in it, remembering which blocks were executed in this interval.
+        const size_t index = blockIndex(currentBBV);
+        BBInfo &info = blocks[index];
+        if (info.count == 0)
+            active.push_back(index);
+        info.count += currentBBVInstCount;
         currentBBVInstCount = 0;
 
         // Reached end of interval if the sum of the current inst count
         // (intervalCount) and the excessive inst count from the previous
         // interval (intervalDrift) is greater than/equal to the interval size.
         if (intervalCount + intervalDrift >= intervalSize) {
-            // summarize interval and display BBV info
-            std::vector<std::pair<uint64_t, uint64_t> > counts;
-            for (auto map_itr = bbMap.begin(); map_itr != bbMap.end();
-                    ++map_itr) {
-                BBInfo& info = map_itr->second;
-                if (info.count != 0) {
-                    counts.push_back(std::make_pair(info.id, info.count));
-                    info.count = 0;
-                }
-            }
-            std::sort(counts.begin(), counts.end());
-
-            // Print output BBV info
-            *simpointStream->stream() << "T";
-            for (auto cnt_itr = counts.begin(); cnt_itr != counts.end();
-                    ++cnt_itr) {
-                *simpointStream->stream() << ":" << cnt_itr->first
-                                << ":" << cnt_itr->second << " ";
-            }
-            *simpointStream->stream() << "\n";
-
+            dumpInterval();
             intervalDrift = (intervalCount + intervalDrift) - intervalSize;
             intervalCount = 0;
         }
     }
 }
 
+void
+SimPoint::dumpInterval()
+{
+    // Blocks are numbered in the order they are found, so sorting the
+    // indices sorts the blocks by ID.
+    std::sort(active.begin(), active.end());
+
+    if (binaryStream) {
+        binaryStream->put<uint32_t>(active.size());
+        for (size_t index : active) {
+            BBInfo &info = blocks[index];
+            binaryStream->put(BinaryCount{info.id, info.count});
+            info.count = 0;
+        }
+        active.clear();
+        return;
+    }
+
+    // Print output BBV info
+    std::ostream &os = *simpointStream->stream();
+    os << "T";
+    for (size_t index : active) {
+        BBInfo &info = blocks[index];
+        os << ":" << info.id << ":" << info.count << " ";
+        info.count = 0;
+    }
+    os << "\n";
+    active.clear();
+}
+
 } // namespace gem5
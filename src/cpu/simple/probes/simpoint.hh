@@ -38,8 +38,12 @@
 #ifndef __CPU_SIMPLE_PROBES_SIMPOINT_HH__
 #define __CPU_SIMPLE_PROBES_SIMPOINT_HH__
 
+#include <array>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
+#include "base/async_writer.hh"
 #include "base/output.hh"
 #include "cpu/simple_thread.hh"
 #include "params/SimPoint.hh"
@@ -96,7 +100,33 @@ class SimPoint : public ProbeListenerObject
      */
     void profile(const std::pair<SimpleThread*, StaticInstPtr>&);
 
+    /**
+     * Binary BBV files start with BinaryMagic, the uint32_t BinaryVersion
+     * and the uint64_t interval size. Each interval is then a uint32_t
+     * number of basic blocks executed in it, followed by that many
+     * BinaryCount records sorted by ID, in host byte order.
+     * util/decode_bbv.py converts them to the text format.
+     */
+    static constexpr char BinaryMagic[8] =
+        {'g', 'e', 'm', '5', 'b', 'b', 'v', '\0'};
+    static constexpr uint32_t BinaryVersion = 1;
+
+    struct BinaryCount
+    {
+        uint64_t id;
+        uint64_t count;
+    };
+    static_assert(sizeof(BinaryCount) == 16);
+
   private:
+    /** The index in blocks of the basic block being finished */
+    size_t blockIndex(const BasicBlockRange &range);
+
+    /** Write out the counts of the interval and clear them */
+    void dumpInterval();
+
+    void closeStreams();
+
     /** SimPoint profiling interval size in instructions */
     const uint64_t intervalSize;
 
@@ -106,6 +136,8 @@ class SimPoint : public ProbeListenerObject
     uint64_t intervalDrift;
     /** Pointer to SimPoint BBV output stream */
     OutputStream *simpointStream;
+    /** Binary BBV output, used instead of simpointStream if set */
+    std::unique_ptr<AsyncWriter> binaryStream;
 
     /** Basic Block information */
     struct BBInfo
@@ -118,8 +150,25 @@ class SimPoint : public ProbeListenerObject
         uint64_t count;
     };
 
-    /** Hash table containing all previously seen basic blocks */
-    std::unordered_map<BasicBlockRange, BBInfo> bbMap;
+    /** All previously seen basic blocks, block i has ID i + 1 */
+    std::vector<BBInfo> blocks;
+    /** Hash table of the index in blocks of each basic block */
+    std::unordered_map<BasicBlockRange, size_t> bbMap;
+
+    /**
+     * Direct mapped cache of bbMap. Most basic blocks finished are ones
+     * which finished recently, so this avoids most hash table lookups.
+     */
+    struct CachedBlock
+    {
+        BasicBlockRange range{0, 0};
+        size_t index = SIZE_MAX;
+    };
+    static constexpr size_t BlockCacheSize = 4096;
+    std::array<CachedBlock, BlockCacheSize> blockCache;
+
+    /** Indices of the blocks with a non-zero count in this interval */
+    std::vector<size_t> active;
     /** Currently executing basic block */
     BasicBlockRange currentBBV;
     /** inst count in current basic block */
@@ -41,6 +41,8 @@
 
 #include "cpu/simple/timing.hh"
 
+#include <cstring>
+
 #include "arch/generic/decoder.hh"
 #include "base/compiler.hh"
 #include "cpu/exetrace.hh"
@@ -75,7 +77,14 @@ TimingSimpleCPU::TimingCPUPort::TickEvent::schedule(PacketPtr _pkt, Tick t)
 
 TimingSimpleCPU::TimingSimpleCPU(const BaseTimingSimpleCPUParams &p)
     : BaseSimpleCPU(p), fetchTranslation(this), icachePort(this),
-      dcachePort(this), ifetch_pkt(NULL), dcache_pkt(NULL), previousCycle(0),
+      dcachePort(this), ifetch_pkt(NULL), dcache_pkt(NULL),
+      fetchBufferEnabled(p.fetch_buffer),
+      fetchBufferLatency(p.fetch_buffer_latency),
+      fetchBuffer(p.fetch_buffer ? cacheLineSize() : 0),
+      fetchBufferAddr(MaxAddr), fetchBufferFillAddr(MaxAddr),
+      fetchBufferEvent([this]{ completeIfetch(NULL); },
+                       name() + ".fetchBufferEvent"),
+      previousCycle(0),
       fetchEvent([this]{ fetch(); }, name())
 {
     _status = Idle;
@@ -124,6 +133,9 @@ TimingSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have been changed behind our back while drained
+    invalidateFetchBuffer();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -178,6 +190,7 @@ TimingSimpleCPU::switchOut()
     BaseSimpleCPU::switchOut();
 
     assert(!fetchEvent.scheduled());
+    assert(!fetchBufferEvent.scheduled());
     assert(_status == BaseSimpleCPU::Running || _status == Idle);
     assert(!t_info.stayAtPC);
     assert(thread->pcState().microPC() == 0);
@@ -192,6 +205,7 @@ TimingSimpleCPU::takeOverFrom(BaseCPU *oldCPU)
 {
     BaseSimpleCPU::takeOverFrom(oldCPU);
 
+    invalidateFetchBuffer();
     previousCycle = curCycle();
 }
 
@@ -412,6 +426,8 @@ TimingSimpleCPU::translationFault(const Fault &fault)
 PacketPtr
 TimingSimpleCPU::buildPacket(const RequestPtr &req, bool read)
 {
+    if ((!read || req->isAtomic()) && req->hasPaddr())
+        invalidateFetchBuffer(req->getPaddr());
     return read ? Packet::createRead(req) : Packet::createWrite(req);
 }
 
@@ -463,7 +479,7 @@ TimingSimpleCPU::initiateMemRead(Addr addr, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         addr, size, flags, dataRequestorId(), pc, thread->contextId());
     req->setByteEnable(byte_enable);
 
@@ -545,7 +561,7 @@ TimingSimpleCPU::writeMem(uint8_t *data, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         addr, size, flags, dataRequestorId(), pc, thread->contextId());
     req->setByteEnable(byte_enable);
 
@@ -601,7 +617,7 @@ TimingSimpleCPU::initiateMemAMO(Addr addr, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(addr, size, flags,
+    RequestPtr req = makeRequest(addr, size, flags,
                             dataRequestorId(), pc, thread->contextId(),
                             std::move(amo_op));
 
@@ -698,7 +714,7 @@ TimingSimpleCPU::fetch()
 
     if (needToFetch) {
         _status = BaseSimpleCPU::Running;
-        RequestPtr ifetch_req = std::make_shared<Request>();
+        RequestPtr ifetch_req = makeRequest();
         ifetch_req->taskId(taskId());
         ifetch_req->setContext(thread->contextId());
         setupFetchRequest(ifetch_req);
@@ -722,10 +738,39 @@ TimingSimpleCPU::sendFetch(const Fault &fault, const RequestPtr &req,
     auto &decoder = threadInfo[curThread]->thread->decoder;
 
     if (fault == NoFault) {
+        const Addr line = fetchBufferLine(req);
+        if (line != MaxAddr && line == fetchBufferAddr) {
+            DPRINTF(SimpleCPU, "Fetch buffer hit for addr %#x(pa: %#x)\n",
+                    req->getVaddr(), req->getPaddr());
+            std::memcpy(decoder->moreBytesPtr(),
+                        &fetchBuffer[req->getPaddr() - line], req->getSize());
+            _status = IcacheWaitResponse;
+            schedule(fetchBufferEvent, clockEdge(fetchBufferLatency));
+
+            updateCycleCounts();
+            updateCycleCounters(BaseCPU::CPU_STATE_ON);
+            return;
+        }
+
         DPRINTF(SimpleCPU, "Sending fetch for addr %#x(pa: %#x)\n",
                 req->getVaddr(), req->getPaddr());
-        ifetch_pkt = new Packet(req, MemCmd::ReadReq);
-        ifetch_pkt->dataStatic(decoder->moreBytesPtr());
+        if (line != MaxAddr) {
+            // Read the whole line into the fetch buffer, the fetched
+            // bytes are handed to the decoder when it arrives
+            RequestPtr fill_req = std::make_shared<Request>(*req);
+            fill_req->setVirt(req->getVaddr() - (req->getPaddr() - line),
+                    cacheLineSize(), req->getFlags(), req->requestorId(),
+                    req->getPC());
+            fill_req->setPaddr(line);
+            fetchBufferAddr = MaxAddr;
+            fetchBufferFillAddr = line;
+            fetchBufferFillReq = req;
+            ifetch_pkt = new Packet(fill_req, MemCmd::ReadReq);
+            ifetch_pkt->dataStatic(fetchBuffer.data());
+        } else {
+            ifetch_pkt = new Packet(req, MemCmd::ReadReq);
+            ifetch_pkt->dataStatic(decoder->moreBytesPtr());
+        }
         DPRINTF(SimpleCPU, " -- pkt addr: %#x\n", ifetch_pkt->getAddr());
 
         if (!icachePort.sendTimingReq(ifetch_pkt)) {
@@ -837,6 +882,15 @@ TimingSimpleCPU::completeIfetch(PacketPtr pkt)
     if (pkt)
         pkt->req->setAccessLatency();
 
+    if (pkt && fetchBufferFillReq) {
+        const RequestPtr &req = fetchBufferFillReq;
+        std::memcpy(threadInfo[curThread]->thread->decoder->moreBytesPtr(),
+                    &fetchBuffer[req->getPaddr() - pkt->getAddr()],
+                    req->getSize());
+        fetchBufferAddr = fetchBufferFillAddr;
+        fetchBufferFillAddr = MaxAddr;
+        fetchBufferFillReq = nullptr;
+    }
 
     preExecute();
 
@@ -897,6 +951,35 @@ TimingSimpleCPU::completeIfetch(PacketPtr pkt)
     }
 }
 
+Addr
+TimingSimpleCPU::fetchBufferLine(const RequestPtr &req) const
+{
+    if (!fetchBufferEnabled || req->isUncacheable() ||
+            req->isStrictlyOrdered()) {
+        return MaxAddr;
+    }
+
+    const Addr line = req->getPaddr() & ~Addr(cacheLineSize() - 1);
+    if (req->getPaddr() + req->getSize() > line + cacheLineSize())
+        return MaxAddr;
+    return line;
+}
+
+void
+TimingSimpleCPU::invalidateFetchBuffer(Addr addr)
+{
+    if (!fetchBufferEnabled)
+        return;
+
+    const Addr line = addr & ~Addr(cacheLineSize() - 1);
+    if (addr == MaxAddr || line == fetchBufferAddr)
+        fetchBufferAddr = MaxAddr;
+    // A fill which may be stale is still handed to the decoder, but
+    // isn't kept
+    if (addr == MaxAddr || line == fetchBufferFillAddr)
+        fetchBufferFillAddr = MaxAddr;
+}
+
 void
 TimingSimpleCPU::IcachePort::ITickEvent::process()
 {
@@ -1101,6 +1184,7 @@ TimingSimpleCPU::DcachePort::recvTimingSnoopReq(PacketPtr pkt)
     // using caches) It is not necessary to wake up the processor on
     // all incoming packets
     if (pkt->isInvalidate() || pkt->isWrite()) {
+        cpu->invalidateFetchBuffer(pkt->getAddr());
         for (auto &t_info : cpu->threadInfo) {
             t_info->thread->getIsaPtr()->handleLockedSnoop(pkt,
                     cacheBlockMask);
@@ -1127,6 +1211,9 @@ TimingSimpleCPU::DcachePort::recvTimingSnoopReq(PacketPtr pkt)
 void
 TimingSimpleCPU::DcachePort::recvFunctionalSnoop(PacketPtr pkt)
 {
+    if (pkt->isWrite())
+        cpu->invalidateFetchBuffer(pkt->getAddr());
+
     for (ThreadID tid = 0; tid < cpu->numThreads; tid++) {
         if (cpu->getCpuAddrMonitor(tid)->doMonitor(pkt)) {
             cpu->wakeup(tid);
@@ -1244,7 +1331,7 @@ TimingSimpleCPU::initiateMemMgmtCmd(Request::Flags flags)
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         addr, size, flags, dataRequestorId());
 
     req->setPC(pc);
@@ -1299,7 +1386,7 @@ TimingSimpleCPU::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         addr, size, flags, dataRequestorId());
 
     req->setPC(pc);
@@ -41,6 +41,8 @@
 #ifndef __CPU_SIMPLE_TIMING_HH__
 #define __CPU_SIMPLE_TIMING_HH__
 
+#include <vector>
+
 #include "arch/generic/mmu.hh"
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
@@ -261,6 +263,34 @@ class TimingSimpleCPU : public BaseSimpleCPU
     PacketPtr ifetch_pkt;
     PacketPtr dcache_pkt;
 
+    /**
+     * Fetch line buffer. When enabled, an instruction fetch that misses
+     * in it reads the whole cache line, and the following fetches from
+     * that physical line are completed after fetchBufferLatency without
+     * sending a request to the icache. The buffer is dropped on stores
+     * from this CPU and snooped writes to the line, so only writes which
+     * are neither (e.g., from non-coherent devices) can leave it stale.
+     */
+    const bool fetchBufferEnabled;
+    const Cycles fetchBufferLatency;
+    std::vector<uint8_t> fetchBuffer;
+    /** Physical address of the buffered line, MaxAddr if there is none */
+    Addr fetchBufferAddr;
+    /** Physical address of the line being filled, MaxAddr if dropped */
+    Addr fetchBufferFillAddr;
+    /** Fetch waiting for the line being filled, if any */
+    RequestPtr fetchBufferFillReq;
+    EventFunctionWrapper fetchBufferEvent;
+
+    /**
+     * The physical line of a translated fetch request if it may be
+     * buffered, MaxAddr otherwise.
+     */
+    Addr fetchBufferLine(const RequestPtr &req) const;
+
+    /** Drop the buffered line if it contains addr, or all lines */
+    void invalidateFetchBuffer(Addr addr=MaxAddr);
+
     Cycles previousCycle;
 
   protected:
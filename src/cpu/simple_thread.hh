@@ -88,9 +88,14 @@ class CheckerCPU;
  * all the necessary state for full architecture-level functional
  * simulation.  See the AtomicSimpleCPU or TimingSimpleCPU for
  * examples.
+ *
+ * The class is final so that the register and PC accessors called
+ * through a SimpleThread pointer, e.g. by SimpleExecContext on behalf
+ * of every executing instruction, are bound statically and inlined
+ * instead of going through the ThreadContext vtable.
  */
 
-class SimpleThread : public ThreadState, public ThreadContext
+class SimpleThread final : public ThreadState, public ThreadContext
 {
   public:
     typedef ThreadContext::Status Status;
@@ -63,8 +63,8 @@ InvalidateGenerator::initiate()
     Packet::Command cmd;
 
     // For simplicity, requests are assumed to be 1 byte-sized
-    RequestPtr req = std::make_shared<Request>(m_address, 1, flags,
-                                               requestorId);
+    RequestPtr req = makeRequest(m_address, 1, flags,
+                                 requestorId);
 
     //
     // Based on the current state, issue a load or a store
@@ -31,6 +31,7 @@
 
 #include <set>
 
+#include "base/random.hh"
 #include "base/statistics.hh"
 #include "mem/port.hh"
 #include "params/GarnetSyntheticTraffic.hh"
@@ -135,6 +136,9 @@ class GarnetSyntheticTraffic : public ClockedObject
 
     RequestorID requestorId;
 
+    // Random numbers used to decide injections and destinations
+    RandomStream rng;
+
     void completeRequest(PacketPtr pkt);
 
     void generatePkt();
@@ -0,0 +1,57 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.ClockedObject import ClockedObject
+from m5.params import *
+from m5.proxy import *
+
+
+class GpuTracePlayer(ClockedObject):
+    """Replays a trace written by GpuMemTrace into the GPU caches without
+    the shader pipeline. The coalescer the vector port is connected to
+    must have using_ruby_tester set."""
+
+    type = "GpuTracePlayer"
+    cxx_header = "cpu/testers/gpu_trace_player/gpu_trace_player.hh"
+    cxx_class = "gem5::GpuTracePlayer"
+
+    port = RequestPort("Vector memory port, to a GPU coalescer")
+    scalar_port = RequestPort("Scalar memory port, for scalar requests")
+    gm_token_port = RequestPort("Token port of the coalescer")
+
+    trace_file = Param.String("Trace written by GpuMemTrace")
+    issue_width = Param.Unsigned(
+        1, "Memory instructions issued per cycle at most"
+    )
+    max_tokens = Param.Int(
+        256,
+        "Number of requests that can be uncoalesced before back-pressure "
+        "occurs from the coalescer",
+    )
+    cache_line_size = Param.Unsigned(
+        Parent.cache_line_size, "Size of the lines requests are merged in"
+    )
+    system = Param.System(Parent.any, "System the player belongs to")
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/gpu_trace_player/gpu_trace_player.hh"
+
+#include <algorithm>
+
+#include "base/amo.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/GpuTracePlayer.hh"
+#include "params/GpuTracePlayer.hh"
+#include "proto/gpu_mem_trace.pb.h"
+#include "proto/protoio.hh"
+#include "sim/core.hh"
+#include "sim/sim_exit.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+int GpuTracePlayer::numActivePlayers = 0;
+
+GpuTracePlayer::GpuTracePlayer(const GpuTracePlayerParams &p)
+    : ClockedObject(p),
+      traceFile(p.trace_file),
+      issueWidth(p.issue_width),
+      cacheLineSize(p.cache_line_size),
+      requestorId(p.system->getRequestorId(this)),
+      port(name() + ".port", *this),
+      scalarPort(name() + ".scalar_port", *this),
+      tokenPort(name() + ".gm_token_port", this),
+      tokenManager(p.max_tokens),
+      tickEvent([this]{ tick(); }, name()),
+      stats(this)
+{
+    fatal_if(issueWidth == 0, "%s: issue_width must be at least 1\n",
+             name());
+    fatal_if(!isPowerOf2(cacheLineSize),
+             "%s: cache_line_size must be a power of 2\n", name());
+    tokenPort.setTokenManager(&tokenManager);
+    ++numActivePlayers;
+}
+
+Port &
+GpuTracePlayer::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "port")
+        return port;
+    else if (if_name == "scalar_port")
+        return scalarPort;
+    else if (if_name == "gm_token_port")
+        return tokenPort;
+    return ClockedObject::getPort(if_name, idx);
+}
+
+void
+GpuTracePlayer::init()
+{
+    fatal_if(!port.isConnected(), "%s: port is not connected\n", name());
+    readTrace();
+}
+
+void
+GpuTracePlayer::readTrace()
+{
+    ProtoInputStream trace(traceFile);
+
+    ProtoMessage::GpuMemTraceHeader header;
+    fatal_if(!trace.read(header), "%s: could not read the header of %s\n",
+             name(), traceFile);
+    fatal_if(header.tick_freq() != sim_clock::Frequency,
+             "%s: trace %s was recorded with a tick frequency of %d, "
+             "not %d\n", name(), traceFile, header.tick_freq(),
+             sim_clock::Frequency);
+
+    bool first = true;
+    ProtoMessage::GpuMemTraceRecord rec;
+    while (trace.read(rec)) {
+        if (first) {
+            traceStartTick = rec.tick();
+            first = false;
+        }
+        Wave &wave = waves[rec.wf_id()];
+
+        if (rec.type() == ProtoMessage::GpuMemTraceRecord::BARRIER) {
+            Inst inst;
+            inst.tick = rec.tick();
+            inst.barrier = true;
+            inst.wgId = rec.wg_id();
+            inst.numWaves = rec.num_waves();
+            wave.insts.push_back(std::move(inst));
+            continue;
+        }
+
+        // Requests of an instruction are recorded as they go to memory,
+        // so they may come after those of the next instruction.
+        auto inst = std::find_if(wave.insts.rbegin(), wave.insts.rend(),
+            [&rec](const Inst &inst)
+            { return !inst.barrier && inst.seqNum == rec.seq_num(); });
+        if (inst == wave.insts.rend()) {
+            wave.insts.emplace_back();
+            inst = wave.insts.rbegin();
+            inst->seqNum = rec.seq_num();
+            inst->tick = rec.tick();
+            inst->scalar = rec.scalar();
+            inst->outstanding = std::max(rec.outstanding(), 1u);
+        }
+
+        Access access{(MemCmd::Command)rec.cmd(), rec.addr(), rec.size(),
+                      rec.flags(), rec.coherence_flags(), rec.pc()};
+
+        // Merge the requests to the same cache line, as the coalescer
+        // would. Atomics and fences are sent as they came.
+        const MemCmd cmd(access.cmd);
+        const bool mergeable = !inst->scalar &&
+            (cmd == MemCmd::ReadReq || cmd == MemCmd::WriteReq);
+        bool merged = false;
+        if (mergeable) {
+            const Addr line = roundDown(access.addr, cacheLineSize);
+            for (auto &other : inst->accesses) {
+                if (other.cmd == access.cmd &&
+                    roundDown(other.addr, cacheLineSize) == line) {
+                    const Addr end = std::max(other.addr + other.size,
+                                              access.addr + access.size);
+                    other.addr = std::min(other.addr, access.addr);
+                    other.size = end - other.addr;
+                    merged = true;
+                    break;
+                }
+            }
+        }
+        if (!merged)
+            inst->accesses.push_back(access);
+    }
+
+    DPRINTF(GpuTracePlayer, "Read %d wavefronts from %s\n", waves.size(),
+            traceFile);
+}
+
+void
+GpuTracePlayer::startup()
+{
+    replayStartTick = curTick();
+    for (auto &[id, wave] : waves) {
+        wave.lastTraceTick = traceStartTick;
+        wave.readyTick = replayStartTick;
+    }
+    scheduleTick(curTick());
+}
+
+void
+GpuTracePlayer::scheduleTick(Tick when)
+{
+    when = std::max(when, clockEdge());
+    if (!tickEvent.scheduled()) {
+        schedule(tickEvent, when);
+    } else if (when < tickEvent.when()) {
+        reschedule(tickEvent, when);
+    }
+}
+
+bool
+GpuTracePlayer::tryIssue(Wave &wave)
+{
+    if (wave.insts.empty() || wave.atBarrier)
+        return false;
+
+    const Inst &inst = wave.insts.front();
+    const Tick ready = wave.readyTick + (inst.tick - wave.lastTraceTick);
+    if (ready > curTick())
+        return false;
+
+    if (inst.barrier) {
+        issueBarrier(wave);
+        return true;
+    }
+
+    if (wave.outstandingInsts >= inst.outstanding)
+        return false;
+
+    if (!inst.scalar && tokenPort.isConnected() &&
+        !tokenPort.haveTokens(inst.accesses.size())) {
+        stats.tokenStalls++;
+        return false;
+    }
+
+    issueRequests(wave);
+    return true;
+}
+
+void
+GpuTracePlayer::issueBarrier(Wave &wave)
+{
+    const Inst &inst = wave.insts.front();
+    Barrier &barrier = barriers[inst.wgId];
+    barrier.waves.push_back(&wave);
+    wave.atBarrier = true;
+    stats.barriers++;
+
+    DPRINTF(GpuTracePlayer, "Wave at barrier of workgroup %#x, %d of %d\n",
+            inst.wgId, barrier.waves.size(), inst.numWaves);
+
+    if (barrier.waves.size() < inst.numWaves)
+        return;
+
+    for (Wave *waiting : barrier.waves) {
+        waiting->lastTraceTick = waiting->insts.front().tick;
+        waiting->readyTick = curTick();
+        waiting->atBarrier = false;
+        waiting->insts.pop_front();
+    }
+    barriers.erase(inst.wgId);
+}
+
+PacketPtr
+GpuTracePlayer::makePacket(const Access &access)
+{
+    const MemCmd cmd(access.cmd);
+    const Request::Flags flags(access.flags);
+
+    RequestPtr req;
+    if (flags.isSet(Request::ATOMIC_RETURN_OP |
+                    Request::ATOMIC_NO_RETURN_OP)) {
+        // The operation itself is not in the trace, only its timing
+        // matters.
+        AtomicOpFunctor *amo_op = access.size == 8 ?
+            (AtomicOpFunctor *)new AtomicOpInc<uint64_t>() :
+            (AtomicOpFunctor *)new AtomicOpInc<uint32_t>();
+        req = makeRequest(access.addr, access.size, flags, requestorId,
+                          access.pc, 0, AtomicOpFunctorPtr(amo_op));
+    } else {
+        req = makeRequest(access.addr, access.size, flags, requestorId,
+                          access.pc, 0);
+    }
+    req->setPaddr(access.addr);
+    req->setCacheCoherenceFlags(access.coherenceFlags);
+    req->setReqInstSeqNum(nextSeqNum++);
+
+    PacketPtr pkt = new Packet(req, cmd);
+    if (access.size)
+        pkt->allocate();
+    return pkt;
+}
+
+void
+GpuTracePlayer::issueRequests(Wave &wave)
+{
+    const Inst &inst = wave.insts.front();
+    DataPort &data_port = inst.scalar ? scalarPort : port;
+    fatal_if(!data_port.isConnected(), "%s: %s is needed by the trace but "
+             "is not connected\n", name(), data_port.name());
+
+    if (!inst.scalar && tokenPort.isConnected())
+        tokenPort.acquireTokens(inst.accesses.size());
+
+    auto remaining = std::make_shared<unsigned>(inst.accesses.size());
+    for (const auto &access : inst.accesses) {
+        PacketPtr pkt = makePacket(access);
+        pkt->senderState = new SenderState(&wave, remaining, curTick());
+        data_port.pending.push_back(pkt);
+    }
+
+    DPRINTF(GpuTracePlayer, "Issued instruction %d with %d requests\n",
+            inst.seqNum, inst.accesses.size());
+
+    stats.insts++;
+    stats.requests += inst.accesses.size();
+    numOutstanding += inst.accesses.size();
+    wave.outstandingInsts++;
+    wave.lastTraceTick = inst.tick;
+    wave.readyTick = curTick();
+    wave.insts.pop_front();
+}
+
+void
+GpuTracePlayer::tick()
+{
+    unsigned issued = 0;
+    bool blocked = false;
+    Tick next = MaxTick;
+
+    for (auto &[id, wave] : waves) {
+        if (wave.insts.empty())
+            continue;
+        if (issued < issueWidth && tryIssue(wave))
+            issued++;
+        if (wave.insts.empty() || wave.atBarrier)
+            continue;
+
+        // Keep ticking while the wavefront only waits for time to pass or
+        // for tokens, the others are woken up by a response.
+        const Inst &inst = wave.insts.front();
+        const Tick ready = wave.readyTick + (inst.tick - wave.lastTraceTick);
+        if (ready > curTick()) {
+            next = std::min(next, ready);
+        } else if (inst.barrier || wave.outstandingInsts < inst.outstanding) {
+            blocked = true;
+        }
+    }
+
+    port.sendPending();
+    scalarPort.sendPending();
+
+    if (blocked)
+        next = nextCycle();
+    if (next != MaxTick) {
+        scheduleTick(clockEdge(ticksToCycles(next - curTick())));
+        return;
+    }
+
+    if (!done && numOutstanding == 0 &&
+        std::all_of(waves.begin(), waves.end(),
+                    [](const auto &w) { return w.second.insts.empty(); })) {
+        done = true;
+        DPRINTF(GpuTracePlayer, "Replay of %s done\n", traceFile);
+        if (--numActivePlayers == 0)
+            exitSimLoop("End of GPU trace reached");
+    }
+}
+
+void
+GpuTracePlayer::completeRequest(PacketPtr pkt)
+{
+    auto *sender_state = safe_cast<SenderState *>(pkt->senderState);
+    Wave &wave = *sender_state->wave;
+
+    assert(numOutstanding > 0);
+    numOutstanding--;
+    if (--*sender_state->remaining == 0) {
+        assert(wave.outstandingInsts > 0);
+        wave.outstandingInsts--;
+        stats.instLatency.sample(curTick() - sender_state->issueTick);
+    }
+
+    delete sender_state;
+    delete pkt;
+
+    scheduleTick(nextCycle());
+}
+
+void
+GpuTracePlayer::DataPort::sendPending()
+{
+    while (!waitingRetry && !pending.empty()) {
+        if (!sendTimingReq(pending.front())) {
+            waitingRetry = true;
+            break;
+        }
+        pending.pop_front();
+    }
+}
+
+bool
+GpuTracePlayer::DataPort::recvTimingResp(PacketPtr pkt)
+{
+    // The coalescer acknowledges the completion of stores separately,
+    // their WriteResp already completed the request.
+    if (pkt->cmd == MemCmd::WriteCompleteResp) {
+        delete pkt;
+        return true;
+    }
+
+    player.completeRequest(pkt);
+    return true;
+}
+
+void
+GpuTracePlayer::DataPort::recvReqRetry()
+{
+    assert(waitingRetry);
+    waitingRetry = false;
+    sendPending();
+}
+
+GpuTracePlayer::GpuTracePlayerStats::GpuTracePlayerStats(
+        statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(insts, statistics::units::Count::get(),
+               "Number of memory instructions issued"),
+      ADD_STAT(requests, statistics::units::Count::get(),
+               "Number of requests sent"),
+      ADD_STAT(barriers, statistics::units::Count::get(),
+               "Number of barriers wavefronts arrived at"),
+      ADD_STAT(tokenStalls, statistics::units::Count::get(),
+               "Number of times an instruction waited for tokens"),
+      ADD_STAT(instLatency, statistics::units::Tick::get(),
+               "Ticks from issuing an instruction to its completion")
+{
+    instLatency.init(16);
+}
+
+} // namespace gem5
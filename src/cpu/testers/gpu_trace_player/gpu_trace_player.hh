@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_TESTERS_GPU_TRACE_PLAYER_GPU_TRACE_PLAYER_HH__
+#define __CPU_TESTERS_GPU_TRACE_PLAYER_GPU_TRACE_PLAYER_HH__
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "mem/port.hh"
+#include "mem/request.hh"
+#include "mem/token_port.hh"
+#include "sim/clocked_object.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+struct GpuTracePlayerParams;
+
+/**
+ * Replays a GPU memory trace captured from a compute unit by GpuMemTrace
+ * (see proto/gpu_mem_trace.proto), without the shader pipeline.
+ *
+ * Each wavefront of the trace issues its memory instructions in order.
+ * An instruction issues once the time between it and the previous
+ * instruction of the wavefront in the trace has passed, and once no more
+ * memory instructions of the wavefront are outstanding than when it was
+ * captured. Wavefronts wait at barriers until all the wavefronts of their
+ * workgroup arrive. The requests of a vector load or store which fall in
+ * the same cache line are sent as one, as the coalescer would have.
+ *
+ * The vector port sends each request with a sequence number of its own,
+ * so the coalescer it is connected to must run with using_ruby_tester
+ * set, as for the GPU protocol tester.
+ */
+class GpuTracePlayer : public ClockedObject
+{
+  public:
+    GpuTracePlayer(const GpuTracePlayerParams &p);
+
+    void init() override;
+    void startup() override;
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+  private:
+    class DataPort : public RequestPort
+    {
+      public:
+        DataPort(const std::string &_name, GpuTracePlayer &_player)
+            : RequestPort(_name), player(_player)
+        {}
+
+        /** Requests waiting to be sent, oldest first */
+        std::deque<PacketPtr> pending;
+        /** The port refused a request and we are waiting for a retry */
+        bool waitingRetry = false;
+
+        /** Send the pending requests until the port refuses one */
+        void sendPending();
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override;
+        void recvReqRetry() override;
+
+      private:
+        GpuTracePlayer &player;
+    };
+
+    class TracePlayerTokenPort : public TokenRequestPort
+    {
+      public:
+        TracePlayerTokenPort(const std::string &_name,
+                             GpuTracePlayer *_player)
+            : TokenRequestPort(_name, _player)
+        {}
+
+      protected:
+        bool recvTimingResp(PacketPtr) override { return false; }
+        void recvReqRetry() override {}
+    };
+
+    /** A request of the trace */
+    struct Access
+    {
+        MemCmd::Command cmd;
+        Addr addr;
+        unsigned size;
+        Request::FlagsType flags;
+        Request::CacheCoherenceFlagsType coherenceFlags;
+        Addr pc;
+    };
+
+    /**
+     * A memory instruction, made of the requests with the same sequence
+     * number, or a barrier.
+     */
+    struct Inst
+    {
+        InstSeqNum seqNum = 0;
+        /** Tick of its first request in the trace */
+        Tick tick = 0;
+        bool barrier = false;
+        bool scalar = false;
+        /** Outstanding memory instructions, this one included, when it
+         *  was captured */
+        unsigned outstanding = 0;
+        uint64_t wgId = 0;
+        unsigned numWaves = 0;
+        std::vector<Access> accesses;
+    };
+
+    struct Wave
+    {
+        std::deque<Inst> insts;
+        /** Tick in the trace of the last instruction issued */
+        Tick lastTraceTick = 0;
+        /** Earliest tick at which the next instruction may issue */
+        Tick readyTick = 0;
+        unsigned outstandingInsts = 0;
+        bool atBarrier = false;
+    };
+
+    /** Attached to each request to find its instruction */
+    struct SenderState : public Packet::SenderState
+    {
+        SenderState(Wave *_wave, std::shared_ptr<unsigned> _remaining,
+                    Tick _issueTick)
+            : wave(_wave), remaining(std::move(_remaining)),
+              issueTick(_issueTick)
+        {}
+
+        Wave *wave;
+        /** Requests of the instruction which have not completed */
+        std::shared_ptr<unsigned> remaining;
+        Tick issueTick;
+    };
+
+    /** Wavefronts of a workgroup which are at a barrier */
+    struct Barrier
+    {
+        std::vector<Wave *> waves;
+    };
+
+    void readTrace();
+
+    void tick();
+
+    /** Issue the next instruction of a wavefront if it can */
+    bool tryIssue(Wave &wave);
+    void issueBarrier(Wave &wave);
+    void issueRequests(Wave &wave);
+    PacketPtr makePacket(const Access &access);
+
+    void completeRequest(PacketPtr pkt);
+    void scheduleTick(Tick when);
+
+    const std::string traceFile;
+    const unsigned issueWidth;
+    const unsigned cacheLineSize;
+    RequestorID requestorId;
+
+    DataPort port;
+    DataPort scalarPort;
+    TracePlayerTokenPort tokenPort;
+    TokenManager tokenManager;
+
+    /** Wavefronts by id, in the order they first appear in the trace */
+    std::map<uint64_t, Wave> waves;
+    std::map<uint64_t, Barrier> barriers;
+
+    /** Tick of the first record of the trace, and when replay started */
+    Tick traceStartTick = 0;
+    Tick replayStartTick = 0;
+
+    /** Sequence number of the next request, unique to each request */
+    InstSeqNum nextSeqNum = 1;
+    unsigned numOutstanding = 0;
+    bool done = false;
+
+    EventFunctionWrapper tickEvent;
+
+    /** Number of players which have not finished replaying */
+    static int numActivePlayers;
+
+    struct GpuTracePlayerStats : public statistics::Group
+    {
+        GpuTracePlayerStats(statistics::Group *parent);
+
+        statistics::Scalar insts;
+        statistics::Scalar requests;
+        statistics::Scalar barriers;
+        statistics::Scalar tokenStalls;
+        statistics::Histogram instLatency;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TESTERS_GPU_TRACE_PLAYER_GPU_TRACE_PLAYER_HH__
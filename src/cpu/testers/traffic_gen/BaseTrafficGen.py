@@ -79,6 +79,31 @@ class BaseTrafficGen(ClockedObject):
         0, "Maximum number of outstanding requests"
     )
 
+    # Replay traces as fast as the memory system allows instead of at
+    # the recorded ticks. Issue is limited by max_outstanding_reqs, and
+    # a request waits for older requests to the same cache line.
+    untimed_trace = Param.Bool(
+        False, "Replay traces back-to-back, ignoring recorded ticks"
+    )
+
+    # Traces can be replayed faster or slower than they were recorded,
+    # moved to other addresses and shared between several generators,
+    # each playing every trace_shards-th request, so one trace can
+    # drive different memory systems.
+    trace_tick_scale = Param.Float(
+        1.0, "Factor to multiply the trace ticks by, 0.5 plays at 2x speed"
+    )
+    trace_addr_mask = Param.Addr(
+        MaxAddr, "Mask applied to trace addresses before the offset"
+    )
+    trace_shards = Param.Unsigned(1, "Number of generators sharing a trace")
+    trace_shard = Param.Unsigned(0, "Shard of the trace this one plays")
+    trace_prefetch = Param.Unsigned(
+        0,
+        "Trace requests decoded ahead by a reader thread, 0 to read the "
+        "trace on the simulation thread",
+    )
+
     # Let the user know if we have waited for a retry and not made any
     # progress for a long period of time. The default value is
     # somewhat arbitrary and may well have to be tuned.
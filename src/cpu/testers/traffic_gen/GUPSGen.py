@@ -42,7 +42,11 @@ class GUPSGen(ClockedObject):
 
     system = Param.System(Parent.any, "System this generator is a part of")
 
-    port = RequestPort("Port that should be connected to other components")
+    port = VectorRequestPort(
+        "Ports that should be connected to other components, each one"
+        " carries a stream of updates of its own. An update goes through"
+        " a port which accepts its address, in turn when several do"
+    )
 
     start_addr = Param.Addr(
         0,
@@ -62,11 +66,11 @@ class GUPSGen(ClockedObject):
     )
 
     request_queue_size = Param.Int(
-        1024, "Maximum number of parallel outstanding requests"
+        1024, "Maximum number of parallel outstanding updates per port"
     )
 
     init_memory = Param.Bool(
         False,
-        "Whether or not to initialize the memory,"
-        " it does not effect the performance",
+        "Whether or not to initialize the memory through back doors"
+        " at startup, it does not effect the performance",
     )
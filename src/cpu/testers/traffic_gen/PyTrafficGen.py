@@ -52,6 +52,15 @@ class PyTrafficGen(BaseTrafficGen):
         """
         pass
 
+    @cxxMethod
+    def startSequence(self, generators, repeat=1):
+        """
+        Start generating traffic from a list of traffic generator
+        instances, going through it repeat times. Unlike start(), the
+        transitions between the generators don't call back into Python.
+        """
+        pass
+
     cxx_exports = [
         PyBindMethod("createIdle"),
         PyBindMethod("createExit"),
@@ -62,6 +71,7 @@ class PyTrafficGen(BaseTrafficGen):
         PyBindMethod("createHybrid"),
         PyBindMethod("createNvm"),
         PyBindMethod("createStrided"),
+        PyBindMethod("createBatch"),
     ]
 
     @cxxMethod(override=True)
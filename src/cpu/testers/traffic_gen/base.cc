@@ -42,6 +42,7 @@
 #include "base/random.hh"
 #include "config/have_protobuf.hh"
 #include "cpu/testers/traffic_gen/base_gen.hh"
+#include "cpu/testers/traffic_gen/batch_gen.hh"
 #include "cpu/testers/traffic_gen/dram_gen.hh"
 #include "cpu/testers/traffic_gen/dram_rot_gen.hh"
 #include "cpu/testers/traffic_gen/exit_gen.hh"
@@ -72,6 +73,12 @@ BaseTrafficGen::BaseTrafficGen(const BaseTrafficGenParams &p)
       system(p.system),
       elasticReq(p.elastic_req),
       progressCheck(p.progress_check),
+      untimedTrace(p.untimed_trace),
+      traceTickScale(p.trace_tick_scale),
+      traceAddrMask(p.trace_addr_mask),
+      traceShards(p.trace_shards),
+      traceShard(p.trace_shard),
+      tracePrefetch(p.trace_prefetch),
       noProgressEvent([this]{ noProgress(); }, name()),
       nextTransitionTick(0),
       nextPacketTick(0),
@@ -84,6 +91,9 @@ BaseTrafficGen::BaseTrafficGen(const BaseTrafficGenParams &p)
       requestorId(system->getRequestorId(this)),
       streamGenerator(StreamGen::create(p))
 {
+    lineMask = ~(Addr(system->cacheLineSize()) - 1);
+    readData.resize(system->cacheLineSize());
+    writeData.resize(system->cacheLineSize(), (uint8_t)requestorId);
 }
 
 BaseTrafficGen::~BaseTrafficGen()
@@ -175,46 +185,24 @@ BaseTrafficGen::update()
     // perform the transition
     if (curTick() >= nextTransitionTick) {
         transition();
-    } else {
+    } else if (activeGenerator->sendTogether()) {
         assert(curTick() >= nextPacketTick);
-        // get the next packet and try to send it
-        PacketPtr pkt = activeGenerator->getNextPacket();
-
-        // If generating stream/substream IDs are enabled,
-        // try to pick and assign them to the new packet
-        if (streamGenerator) {
-            auto sid = streamGenerator->pickStreamID();
-            auto ssid = streamGenerator->pickSubstreamID();
-
-            pkt->req->setStreamId(sid);
-
-            if (streamGenerator->ssidValid()) {
-                pkt->req->setSubstreamId(ssid);
-            }
-        }
-
-        // suppress packets that are not destined for a memory, such as
-        // device accesses that could be part of a trace
-        if (pkt && system->isMemAddr(pkt->getAddr())) {
-            stats.numPackets++;
-            // Only attempts to send if not blocked by pending responses
-            blockedWaitingResp = allocateWaitingRespSlot(pkt);
-            if (blockedWaitingResp || !port.sendTimingReq(pkt)) {
-                retryPkt = pkt;
-                retryPktTick = curTick();
-            }
-        } else if (pkt) {
-            DPRINTF(TrafficGen, "Suppressed packet %s 0x%x\n",
-                    pkt->cmdString(), pkt->getAddr());
-
-            ++stats.numSuppressed;
-            if (!(static_cast<int>(stats.numSuppressed.value()) % 10000))
-                warn("%s suppressed %d packets with non-memory addresses\n",
-                     name(), stats.numSuppressed.value());
-
-            delete pkt;
-            pkt = nullptr;
+        // send all the packets due now without going through the event
+        // queue for each of them
+        while (true) {
+            sendPacket();
+            if (retryPkt != NULL)
+                return;
+
+            nextPacketTick = activeGenerator->nextPacketTick(elasticReq, 0);
+            if (nextPacketTick > curTick() || curTick() >= nextTransitionTick)
+                break;
         }
+        scheduleUpdate();
+        return;
+    } else {
+        assert(curTick() >= nextPacketTick);
+        sendPacket();
     }
 
     // if we are waiting for a retry or for a response, do not schedule any
@@ -226,6 +214,49 @@ BaseTrafficGen::update()
     }
 }
 
+void
+BaseTrafficGen::sendPacket()
+{
+    // get the next packet and try to send it
+    PacketPtr pkt = activeGenerator->getNextPacket();
+
+    // If generating stream/substream IDs are enabled,
+    // try to pick and assign them to the new packet
+    if (streamGenerator) {
+        auto sid = streamGenerator->pickStreamID();
+        auto ssid = streamGenerator->pickSubstreamID();
+
+        pkt->req->setStreamId(sid);
+
+        if (streamGenerator->ssidValid()) {
+            pkt->req->setSubstreamId(ssid);
+        }
+    }
+
+    // suppress packets that are not destined for a memory, such as
+    // device accesses that could be part of a trace
+    if (pkt && system->isMemAddr(pkt->getAddr())) {
+        stats.numPackets++;
+        // Only attempts to send if not blocked by pending responses
+        blockedWaitingResp = allocateWaitingRespSlot(pkt);
+        if (blockedWaitingResp || !port.sendTimingReq(pkt)) {
+            retryPkt = pkt;
+            retryPktTick = curTick();
+        }
+    } else if (pkt) {
+        DPRINTF(TrafficGen, "Suppressed packet %s 0x%x\n",
+                pkt->cmdString(), pkt->getAddr());
+
+        ++stats.numSuppressed;
+        if (!(static_cast<int>(stats.numSuppressed.value()) % 10000))
+            warn("%s suppressed %d packets with non-memory addresses\n",
+                 name(), stats.numSuppressed.value());
+
+        delete pkt;
+        pkt = nullptr;
+    }
+}
+
 void
 BaseTrafficGen::transition()
 {
@@ -526,6 +557,24 @@ BaseTrafficGen::createNvm(Tick duration,
                                                 nbr_of_ranks));
 }
 
+std::shared_ptr<BaseGen>
+BaseTrafficGen::createBatch(Tick duration,
+                            Addr start_addr, Addr end_addr, Addr blocksize,
+                            Tick min_period, Tick max_period,
+                            uint8_t read_percent, Addr data_limit,
+                            unsigned int batch_size, unsigned int num_streams,
+                            bool random_addrs)
+{
+    return std::shared_ptr<BaseGen>(new BatchGen(*this, requestorId,
+                                                 duration, start_addr,
+                                                 end_addr, blocksize,
+                                                 system->cacheLineSize(),
+                                                 min_period, max_period,
+                                                 read_percent, data_limit,
+                                                 batch_size, num_streams,
+                                                 random_addrs));
+}
+
 std::shared_ptr<BaseGen>
 BaseTrafficGen::createStrided(
         Tick duration,
@@ -549,7 +598,9 @@ BaseTrafficGen::createTrace(Tick duration,
 {
 #if HAVE_PROTOBUF
     return std::shared_ptr<BaseGen>(
-        new TraceGen(*this, requestorId, duration, trace_file, addr_offset));
+        new TraceGen(*this, requestorId, duration, trace_file, addr_offset,
+                     untimedTrace, traceTickScale, traceAddrMask,
+                     traceShards, traceShard, tracePrefetch));
 #else
     panic("Can't instantiate trace generation without Protobuf support!\n");
 #endif
@@ -578,10 +629,17 @@ BaseTrafficGen::recvTimingResp(PacketPtr pkt)
 
     waitingResp.erase(iter);
 
+    if (untimedTrace) {
+        auto line = waitingLines.find(pkt->getAddr() & lineMask);
+        assert(line != waitingLines.end());
+        if (--line->second == 0)
+            waitingLines.erase(line);
+    }
+
     delete pkt;
 
     // Sends up the request if we were blocked
-    if (blockedWaitingResp) {
+    if (blockedWaitingResp && !waitingRespBlocked(retryPkt)) {
         blockedWaitingResp = false;
         retryReq();
     }
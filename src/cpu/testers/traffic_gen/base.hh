@@ -41,6 +41,7 @@
 #include <memory>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "enums/AddrMap.hh"
@@ -87,6 +88,19 @@ class BaseTrafficGen : public ClockedObject
      */
     const Tick progressCheck;
 
+    /**
+     * Replay traces back-to-back, ignoring the recorded ticks, and
+     * keep requests to the same cache line in trace order.
+     */
+    const bool untimedTrace;
+
+    /** How traces are replayed, see TraceGen */
+    const double traceTickScale;
+    const Addr traceAddrMask;
+    const unsigned traceShards;
+    const unsigned traceShard;
+    const unsigned tracePrefetch;
+
   private:
     /**
      * Receive a retry from the neighbouring port and attempt to
@@ -174,7 +188,8 @@ class BaseTrafficGen : public ClockedObject
 
     /**
      * Puts this packet in the waitingResp list and returns true if
-     * we are above the maximum number of oustanding requests.
+     * we are above the maximum number of oustanding requests, or if
+     * the packet has to wait for an older request to the same line.
      */
     bool allocateWaitingRespSlot(PacketPtr pkt)
     {
@@ -182,14 +197,54 @@ class BaseTrafficGen : public ClockedObject
         assert(pkt->needsResponse());
 
         waitingResp[pkt->req] = curTick();
+        if (untimedTrace)
+            ++waitingLines[pkt->getAddr() & lineMask];
 
-        return (maxOutstandingReqs > 0) &&
-               (waitingResp.size() > maxOutstandingReqs);
+        return waitingRespBlocked(pkt);
     }
 
+    /**
+     * Check if a packet that already holds a waitingResp slot has to
+     * keep waiting for outstanding responses.
+     */
+    bool waitingRespBlocked(PacketPtr pkt) const
+    {
+        if ((maxOutstandingReqs > 0) &&
+            (waitingResp.size() > maxOutstandingReqs))
+            return true;
+
+        if (untimedTrace) {
+            auto it = waitingLines.find(pkt->getAddr() & lineMask);
+            assert(it != waitingLines.end());
+            return it->second > 1;
+        }
+
+        return false;
+    }
+
+    /** Mask selecting the cache line of an address */
+    Addr lineMask;
+
+    /**
+     * Outstanding requests per cache line, only kept when replaying
+     * untimed traces.
+     */
+    std::unordered_map<Addr, unsigned> waitingLines;
+
     /** Event for scheduling updates */
     EventFunctionWrapper updateEvent;
 
+    /**
+     * Packet data shared by all the packets of generators which don't
+     * look at it, a cache line written by the memory for reads and one
+     * filled with the requestor ID for writes.
+     */
+    std::vector<uint8_t> readData;
+    std::vector<uint8_t> writeData;
+
+    /** Generate one packet and try to send it */
+    void sendPacket();
+
   protected: // Stats
     /** Reqs waiting for response **/
     std::unordered_map<RequestPtr,Tick> waitingResp;
@@ -256,6 +311,17 @@ class BaseTrafficGen : public ClockedObject
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 
+    /**
+     * Data for a packet which doesn't need its own, up to a cache line.
+     *
+     * @param is_write Whether the data is written to memory.
+     */
+    uint8_t *
+    sharedData(bool is_write)
+    {
+        return is_write ? writeData.data() : readData.data();
+    }
+
   public: // Generator factory methods
     std::shared_ptr<BaseGen> createIdle(Tick duration);
     std::shared_ptr<BaseGen> createExit(Tick duration);
@@ -318,6 +384,14 @@ class BaseTrafficGen : public ClockedObject
         enums::AddrMap addr_mapping,
         unsigned int nbr_of_ranks);
 
+    std::shared_ptr<BaseGen> createBatch(
+        Tick duration,
+        Addr start_addr, Addr end_addr, Addr blocksize,
+        Tick min_period, Tick max_period,
+        uint8_t read_percent, Addr data_limit,
+        unsigned int batch_size, unsigned int num_streams,
+        bool random_addrs);
+
     std::shared_ptr<BaseGen> createStrided(
         Tick duration,
         Addr start_addr, Addr end_addr, Addr offset,
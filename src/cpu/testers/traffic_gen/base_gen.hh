@@ -134,6 +134,12 @@ class BaseGen
      */
     virtual Tick nextPacketTick(bool elastic, Tick delay) const = 0;
 
+    /**
+     * Should the packets due at the same tick all be sent in a single
+     * update of the traffic generator, instead of an update each.
+     */
+    virtual bool sendTogether() const { return false; }
+
 };
 
 class StochasticGen : public BaseGen
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/testers/traffic_gen/batch_gen.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "cpu/testers/traffic_gen/base.hh"
+#include "debug/TrafficGen.hh"
+
+namespace gem5
+{
+
+BatchGen::BatchGen(BaseTrafficGen &gen, RequestorID requestor_id,
+                   Tick _duration, Addr start_addr, Addr end_addr,
+                   Addr _blocksize, Addr cacheline_size,
+                   Tick min_period, Tick max_period,
+                   uint8_t read_percent, Addr data_limit,
+                   unsigned batch_size, unsigned num_streams,
+                   bool random_addrs)
+    : StochasticGen(gen, requestor_id, _duration, start_addr, end_addr,
+                    _blocksize, cacheline_size, min_period, max_period,
+                    read_percent, data_limit),
+      trafficGen(gen), batchSize(batch_size), numStreams(num_streams),
+      randomAddrs(random_addrs), rng(gen.name() + ".batch_gen"),
+      addrs(batch_size), reads(batch_size), randoms(batch_size),
+      next(batch_size), count(0), dataManipulated(0)
+{
+    if (batchSize == 0 || numStreams == 0)
+        fatal("%s needs at least one packet per batch and one stream",
+              name());
+
+    streamSize = (endAddr - startAddr + 1) / numStreams / blocksize *
+        blocksize;
+    if (streamSize == 0)
+        fatal("%s range is too small for %d streams of %d byte blocks",
+              name(), numStreams, blocksize);
+}
+
+void
+BatchGen::enter()
+{
+    next = batchSize;
+    count = 0;
+    dataManipulated = 0;
+}
+
+void
+BatchGen::refill()
+{
+    // Packet count + i goes to stream (count + i) % numStreams, which it
+    // accesses for the ((count + i) / numStreams)th time. The loops only
+    // depend on i, so the compiler can vectorise them.
+    const Addr blocks = streamSize / blocksize;
+    if (randomAddrs) {
+        rng.fill(randoms.data(), batchSize);
+        for (unsigned i = 0; i < batchSize; i++) {
+            const uint64_t c = count + i;
+            addrs[i] = startAddr + (c % numStreams) * streamSize +
+                (randoms[i] % blocks) * blocksize;
+        }
+    } else {
+        for (unsigned i = 0; i < batchSize; i++) {
+            const uint64_t c = count + i;
+            addrs[i] = startAddr + (c % numStreams) * streamSize +
+                (c / numStreams % blocks) * blocksize;
+        }
+    }
+
+    if (readPercent == 0 || readPercent == 100) {
+        std::fill(reads.begin(), reads.end(), readPercent == 100);
+    } else {
+        rng.fill(randoms.data(), batchSize);
+        for (unsigned i = 0; i < batchSize; i++)
+            reads[i] = randoms[i] % 100 < readPercent;
+    }
+
+    next = 0;
+}
+
+PacketPtr
+BatchGen::getNextPacket()
+{
+    if (next == batchSize)
+        refill();
+
+    const Addr addr = addrs[next];
+    const bool is_read = reads[next];
+    next++;
+    count++;
+
+    DPRINTF(TrafficGen, "BatchGen::getNextPacket: %c to addr %x, size %d\n",
+            is_read ? 'r' : 'w', addr, blocksize);
+
+    dataManipulated += blocksize;
+
+    RequestPtr req = makeRequest(addr, blocksize, 0, requestorId);
+    // Dummy PC to have PC-based prefetchers latch on; get entropy into
+    // higher bits
+    req->setPC(((Addr)requestorId) << 2);
+
+    PacketPtr pkt = new Packet(req,
+                               is_read ? MemCmd::ReadReq : MemCmd::WriteReq);
+    pkt->dataStatic(trafficGen.sharedData(!is_read));
+    return pkt;
+}
+
+Tick
+BatchGen::nextPacketTick(bool elastic, Tick delay) const
+{
+    if (dataLimit && dataManipulated >= dataLimit) {
+        DPRINTF(TrafficGen, "Data limit for BatchGen reached.\n");
+        return MaxTick;
+    }
+
+    // The rest of the batch goes out right away.
+    if (count % batchSize)
+        return curTick();
+
+    Tick wait = random_mt.random(minPeriod, maxPeriod);
+
+    // compensate for the delay experienced to not be elastic
+    if (!elastic) {
+        if (wait < delay)
+            wait = 0;
+        else
+            wait -= delay;
+    }
+
+    return curTick() + wait;
+}
+
+} // namespace gem5
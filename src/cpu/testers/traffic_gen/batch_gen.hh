@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * @file
+ * Declaration of the batched generator that produces high rate traffic
+ * from several address streams.
+ */
+
+#ifndef __CPU_TRAFFIC_GEN_BATCH_GEN_HH__
+#define __CPU_TRAFFIC_GEN_BATCH_GEN_HH__
+
+#include <vector>
+
+#include "base/random.hh"
+#include "base_gen.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+/**
+ * The batch generator sends batch_size packets at once every period,
+ * all of them in a single update of the traffic generator. The address
+ * range is split between num_streams streams, which are accessed in
+ * turn, each either linearly or at random. The addresses of a whole
+ * batch are computed together, and the packets carry no data of their
+ * own, so generating traffic takes little more than creating the
+ * packets and is unlikely to limit the memory bandwidth reached.
+ */
+class BatchGen : public StochasticGen
+{
+
+  public:
+
+    /**
+     * Create a batched address sequence generator.
+     *
+     * @param gen Traffic generator owning this sequence generator
+     * @param requestor_id RequestorID related to the memory requests
+     * @param _duration duration of this state before transitioning
+     * @param start_addr Start address
+     * @param end_addr End address
+     * @param _blocksize Size used for transactions injected
+     * @param cacheline_size cache line size in the system
+     * @param min_period Lower limit of random inter-batch time
+     * @param max_period Upper limit of random inter-batch time
+     * @param read_percent Percent of transactions that are reads
+     * @param data_limit Upper limit on how much data to read/write
+     * @param batch_size Number of packets sent at once
+     * @param num_streams Number of streams the range is split into
+     * @param random_addrs Pick random addresses within each stream
+     */
+    BatchGen(BaseTrafficGen &gen, RequestorID requestor_id, Tick _duration,
+             Addr start_addr, Addr end_addr,
+             Addr _blocksize, Addr cacheline_size,
+             Tick min_period, Tick max_period,
+             uint8_t read_percent, Addr data_limit,
+             unsigned batch_size, unsigned num_streams, bool random_addrs);
+
+    void enter() override;
+
+    PacketPtr getNextPacket() override;
+
+    Tick nextPacketTick(bool elastic, Tick delay) const override;
+
+    bool sendTogether() const override { return true; }
+
+  protected:
+    /** Compute the addresses and commands of the next batch */
+    void refill();
+
+    /** Traffic generator providing the packet data */
+    BaseTrafficGen &trafficGen;
+
+    const unsigned batchSize;
+    const unsigned numStreams;
+    const bool randomAddrs;
+
+    /** Size of the part of the range each stream accesses */
+    Addr streamSize;
+
+    RandomStream rng;
+
+    /** The addresses and commands of the batch being sent */
+    std::vector<Addr> addrs;
+    std::vector<uint8_t> reads;
+    std::vector<uint64_t> randoms;
+    unsigned next;
+
+    /** Number of packets generated since entering */
+    uint64_t count;
+
+    /** Amount of data manipulated since entering */
+    Addr dataManipulated;
+};
+
+} // namespace gem5
+
+#endif
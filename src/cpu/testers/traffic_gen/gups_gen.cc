@@ -28,11 +28,13 @@
 
 #include "cpu/testers/traffic_gen/gups_gen.hh"
 
-#include <cstring>
+#include <algorithm>
 #include <string>
 
+#include "base/cast.hh"
 #include "base/random.hh"
 #include "debug/GUPSGen.hh"
+#include "mem/port_proxy.hh"
 #include "sim/sim_exit.hh"
 
 namespace gem5
@@ -44,15 +46,38 @@ GUPSGen::GUPSGen(const GUPSGenParams& params):
     nextSendEvent([this]{ sendNextReq(); }, name()),
     system(params.system),
     requestorId(system->getRequestorId(this)),
-    port(name() + ".port", this),
     startAddr(params.start_addr),
     memSize(params.mem_size),
     updateLimit(params.update_limit),
     elementSize(sizeof(uint64_t)), // every element in the table is a uint64_t
     reqQueueSize(params.request_queue_size),
     initMemory(params.init_memory),
+    rng(name()),
     stats(this)
-{}
+{
+    fatal_if(params.port_port_connection_count == 0,
+             "%s: port must be connected.", name());
+    fatal_if(reqQueueSize <= 0, "%s: request_queue_size must be positive.",
+             name());
+
+    const unsigned num_ports = params.port_port_connection_count;
+    ports.reserve(num_ports);
+    for (unsigned i = 0; i < num_ports; i++) {
+        ports.emplace_back(csprintf("%s.port[%d]", name(), i), this, i);
+    }
+
+    slots.resize(num_ports * reqQueueSize);
+    freeSlots.reserve(slots.size());
+    for (int i = slots.size() - 1; i >= 0; i--) {
+        slots[i].index = i;
+        freeSlots.push_back(i);
+    }
+    pendingWrites.resize(slots.size());
+    sendQueues.resize(num_ports);
+    for (auto &queue : sendQueues) {
+        queue.resize(slots.size());
+    }
+}
 
 Port&
 GUPSGen::getPort(const std::string &if_name, PortID idx)
@@ -60,7 +85,9 @@ GUPSGen::getPort(const std::string &if_name, PortID idx)
     if (if_name != "port") {
         return ClockedObject::getPort(if_name, idx);
     } else {
-        return port;
+        panic_if(idx == InvalidPortID || idx >= (PortID)ports.size(),
+                 "%s: no port with index %d.", name(), idx);
+        return ports[idx];
     }
 }
 
@@ -70,6 +97,8 @@ GUPSGen::init()
     doneReading = false;
     onTheFlyRequests = 0;
     readRequests = 0;
+    queuedRequests = 0;
+    nextPort = 0;
 
     tableSize = memSize / elementSize;
     numUpdates = 4 * tableSize;
@@ -78,24 +107,73 @@ GUPSGen::init()
 void
 GUPSGen::startup()
 {
-    int block_size = 64; // Write the initial values in 64 byte blocks.
-    uint64_t stride_size = block_size / elementSize;
+    portRanges.clear();
+    for (auto &port : ports) {
+        portRanges.push_back(port.getAddrRanges());
+    }
+
     if (initMemory) {
-        for (uint64_t start_index = 0; start_index < tableSize;
-                                    start_index += stride_size) {
-            uint8_t write_data[block_size];
-            for (uint64_t offset = 0; offset < stride_size; offset++) {
-                uint64_t value = start_index + offset;
-                std::memcpy(write_data + offset * elementSize,
-                            &value, elementSize);
+        initTable();
+    }
+    schedule(nextCreateEvent, nextCycle());
+}
+
+void
+GUPSGen::initTable()
+{
+    // Build the initial values a chunk at a time, and hand each chunk to
+    // the port which sees it. The proxy copies it straight into the
+    // memory when the memory offers a back door, and falls back to
+    // functional writes when it doesn't.
+    const uint64_t chunk_elements = 8192;
+    std::vector<uint64_t> values(chunk_elements);
+
+    for (uint64_t start = 0; start < tableSize; start += chunk_elements) {
+        const uint64_t count = std::min<uint64_t>(chunk_elements,
+                                                  tableSize - start);
+        for (uint64_t i = 0; i < count; i++) {
+            values[i] = start + i;
+        }
+
+        // A chunk no single port sees, when the ports each lead to a
+        // memory channel, is split into cache lines.
+        const Addr chunk_addr = indexToAddr(start);
+        const AddrRange chunk(chunk_addr, chunk_addr + count * elementSize);
+        PortID whole = InvalidPortID;
+        for (PortID i = 0; i < (PortID)ports.size(); i++) {
+            for (const auto &range : portRanges[i]) {
+                if (chunk.isSubset(range)) {
+                    whole = i;
+                }
             }
-            Addr addr = indexToAddr(start_index);
-            PacketPtr pkt = getWritePacket(addr, block_size, write_data);
-            port.sendFunctionalPacket(pkt);
-            delete pkt;
+        }
+        const uint64_t stride = whole != InvalidPortID ? count :
+                                system->cacheLineSize() / elementSize;
+        for (uint64_t done = 0; done < count; done += stride) {
+            const Addr addr = indexToAddr(start + done);
+            const PortID port = whole != InvalidPortID ? whole :
+                                routeAddr(addr);
+            const PortProxy proxy(ports[port], system->cacheLineSize());
+            proxy.loadBlobPhys(addr, 0, values.data() + done,
+                               std::min(stride, count - done) * elementSize);
         }
     }
-    schedule(nextCreateEvent, nextCycle());
+}
+
+PortID
+GUPSGen::routeAddr(Addr addr)
+{
+    const PortID num_ports = ports.size();
+    for (PortID i = 0; i < num_ports; i++) {
+        const PortID port = (nextPort + i) % num_ports;
+        for (const auto &range : portRanges[port]) {
+            if (range.contains(addr)) {
+                nextPort = (port + 1) % num_ports;
+                return port;
+            }
+        }
+    }
+    panic("%s: no port accepts address %#x.", name(), addr);
 }
 
 Addr
@@ -108,7 +186,7 @@ GUPSGen::indexToAddr (uint64_t index)
 PacketPtr
 GUPSGen::getReadPacket(Addr addr, unsigned int size)
 {
-    RequestPtr req = std::make_shared<Request>(addr, size, 0, requestorId);
+    RequestPtr req = makeRequest(addr, size, 0, requestorId);
     // Dummy PC to have PC-based prefetchers latch on; get entropy into higher
     // bits
     req->setPC(((Addr)requestorId) << 2);
@@ -123,8 +201,8 @@ GUPSGen::getReadPacket(Addr addr, unsigned int size)
 PacketPtr
 GUPSGen::getWritePacket(Addr addr, unsigned int size, uint8_t *data)
 {
-    RequestPtr req = std::make_shared<Request>(addr, size, 0,
-                                               requestorId);
+    RequestPtr req = makeRequest(addr, size, 0,
+                                 requestorId);
     // Dummy PC to have PC-based prefetchers latch on; get entropy into higher
     // bits
     req->setPC(((Addr)requestorId) << 2);
@@ -142,6 +220,8 @@ GUPSGen::handleResponse(PacketPtr pkt)
     onTheFlyRequests--;
     DPRINTF(GUPSGen, "%s: onTheFlyRequests: %d.\n",
                 __func__, onTheFlyRequests);
+
+    Slot *slot = safe_cast<Slot *>(pkt->popSenderState());
     if (pkt->isWrite()) {
         DPRINTF(GUPSGen, "%s: received a write resp. pkt->addr_range: %s,"
                         " pkt->data: %d\n", __func__,
@@ -150,9 +230,9 @@ GUPSGen::handleResponse(PacketPtr pkt)
         stats.totalUpdates++;
         stats.totalWrites++;
         stats.totalBytesWritten += elementSize;
-        stats.totalWriteLat += curTick() - exitTimes[pkt->req];
+        stats.totalWriteLat += curTick() - slot->exitTime;
 
-        exitTimes.erase(pkt->req);
+        freeSlots.push_back(slot->index);
         delete pkt;
     } else {
         DPRINTF(GUPSGen, "%s: received a read resp. pkt->addr_range: %s\n",
@@ -160,29 +240,37 @@ GUPSGen::handleResponse(PacketPtr pkt)
 
         stats.totalReads++;
         stats.totalBytesRead += elementSize;
-        stats.totalReadLat += curTick() - exitTimes[pkt->req];
-
-        exitTimes.erase(pkt->req);
+        stats.totalReadLat += curTick() - slot->exitTime;
 
-        responsePool.push(pkt);
+        slot->pkt = pkt;
+        pendingWrites.push(slot->index);
     }
-    if (doneReading && requestPool.empty() && onTheFlyRequests == 0) {
+    if (doneReading && freeSlots.size() == slots.size()) {
         exitSimLoop(name() + " is finished updating the memory.\n");
         return;
     }
 
-    if ((requestPool.size() < reqQueueSize) &&
-        (!doneReading || !responsePool.empty()) &&
-        !nextCreateEvent.scheduled())
+    scheduleEvents();
+}
+
+void
+GUPSGen::scheduleEvents()
+{
+    if (!nextCreateEvent.scheduled() &&
+        (!pendingWrites.empty() || (!doneReading && !freeSlots.empty())))
     {
         schedule(nextCreateEvent, nextCycle());
     }
+
+    if (!nextSendEvent.scheduled() && queuedRequests > 0) {
+        schedule(nextSendEvent, nextCycle());
+    }
 }
 
 void
 GUPSGen::wakeUp()
 {
-    if (!nextSendEvent.scheduled() && !requestPool.empty()) {
+    if (!nextSendEvent.scheduled() && queuedRequests > 0) {
         schedule(nextSendEvent, nextCycle());
     }
 }
@@ -190,64 +278,80 @@ GUPSGen::wakeUp()
 void
 GUPSGen::createNextReq()
 {
-    // Prioritize pending writes over reads
-    // Write as soon as the data is read
-    if (!responsePool.empty()) {
-        PacketPtr pkt = responsePool.front();
-        responsePool.pop();
-
-        uint64_t *updated_value = pkt->getPtr<uint64_t>();
-        DPRINTF(GUPSGen, "%s: Read value %lu from address %s", __func__,
-                            *updated_value, pkt->getAddrRange().to_string());
-        *updated_value ^= updateTable[pkt->req];
-        updateTable.erase(pkt->req);
-        Addr addr = pkt->getAddr();
-        PacketPtr new_pkt = getWritePacket(addr,
-                            elementSize, (uint8_t*) updated_value);
-        delete pkt;
-        requestPool.push(new_pkt);
-    } else if (!doneReading) {
-        // If no writes then read
-        // Check to make sure we're not reading more than we should.
-        assert (readRequests < numUpdates);
-
-        uint64_t value = readRequests;
-        uint64_t index = random_mt.random((int64_t) 0, tableSize);
-        Addr addr = indexToAddr(index);
-        PacketPtr pkt = getReadPacket(addr, elementSize);
-        updateTable[pkt->req] = value;
-        requestPool.push(pkt);
-        readRequests++;
-
-        if (readRequests >= numUpdates) {
-            DPRINTF(GUPSGen, "%s: Done creating reads.\n", __func__);
-            doneReading = true;
-        }
-        else if (readRequests == updateLimit && updateLimit != 0) {
-            DPRINTF(GUPSGen, "%s: Update limit reached.\n", __func__);
-            doneReading = true;
-        }
-    }
+    // Create as many requests per cycle as there are streams, so each one
+    // can send a request every cycle.
+    for (size_t created = 0; created < ports.size(); created++) {
+        // Prioritize pending writes over reads
+        // Write as soon as the data is read
+        if (!pendingWrites.empty()) {
+            Slot &slot = slots[pendingWrites.front()];
+            pendingWrites.pop();
+
+            PacketPtr pkt = slot.pkt;
+            slot.pkt = nullptr;
+            uint64_t *updated_value = pkt->getPtr<uint64_t>();
+            DPRINTF(GUPSGen, "%s: Read value %lu from address %s", __func__,
+                    *updated_value, pkt->getAddrRange().to_string());
+            *updated_value ^= slot.update;
+            Addr addr = pkt->getAddr();
+            PacketPtr new_pkt = getWritePacket(addr,
+                                elementSize, (uint8_t*) updated_value);
+            delete pkt;
 
-    if (!nextCreateEvent.scheduled() &&
-        (requestPool.size() < reqQueueSize) &&
-        (!doneReading || !responsePool.empty()))
-    {
-        schedule(nextCreateEvent, nextCycle());
+            new_pkt->pushSenderState(&slot);
+            sendQueues[slot.port].push(slot.index);
+            slot.pkt = new_pkt;
+        } else if (!doneReading && !freeSlots.empty()) {
+            // If no writes then read
+            // Check to make sure we're not reading more than we should.
+            assert (readRequests < numUpdates);
+
+            Slot &slot = slots[freeSlots.back()];
+            freeSlots.pop_back();
+
+            uint64_t index = rng.random((int64_t) 0, tableSize);
+            Addr addr = indexToAddr(index);
+            PacketPtr pkt = getReadPacket(addr, elementSize);
+            slot.update = readRequests;
+            slot.port = routeAddr(addr);
+            slot.pkt = pkt;
+            pkt->pushSenderState(&slot);
+            sendQueues[slot.port].push(slot.index);
+            readRequests++;
+
+            if (readRequests >= numUpdates) {
+                DPRINTF(GUPSGen, "%s: Done creating reads.\n", __func__);
+                doneReading = true;
+            }
+            else if (readRequests == updateLimit && updateLimit != 0) {
+                DPRINTF(GUPSGen, "%s: Update limit reached.\n", __func__);
+                doneReading = true;
+            }
+        } else {
+            break;
+        }
+        queuedRequests++;
     }
 
-    if (!nextSendEvent.scheduled() && !requestPool.empty()) {
-        schedule(nextSendEvent, nextCycle());
-    }
+    scheduleEvents();
 }
 
 void
 GUPSGen::sendNextReq()
 {
-    if (!port.blocked()) {
-        PacketPtr pkt = requestPool.front();
+    for (auto &port : ports) {
+        SlotRing &queue = sendQueues[port.getId()];
+        if (port.blocked() || queue.empty()) {
+            continue;
+        }
+
+        Slot &slot = slots[queue.front()];
+        queue.pop();
+        queuedRequests--;
 
-        exitTimes[pkt->req] = curTick();
+        PacketPtr pkt = slot.pkt;
+        slot.pkt = nullptr;
+        slot.exitTime = curTick();
         if (pkt->isWrite()) {
             DPRINTF(GUPSGen, "%s: Sent write pkt, pkt->addr_range: "
                     "%s, pkt->data: %lu.\n", __func__,
@@ -261,21 +365,9 @@ GUPSGen::sendNextReq()
         onTheFlyRequests++;
         DPRINTF(GUPSGen, "%s: onTheFlyRequests: %d.\n",
                 __func__, onTheFlyRequests);
-        requestPool.pop();
     }
 
-    if (!nextCreateEvent.scheduled() &&
-        (requestPool.size() < reqQueueSize) &&
-        (!doneReading || !responsePool.empty()))
-    {
-        schedule(nextCreateEvent, nextCycle());
-    }
-
-    if (!nextSendEvent.scheduled()) {
-        if (!requestPool.empty()) {
-            schedule(nextSendEvent, nextCycle());
-        }
-    }
+    scheduleEvents();
 }
 
 
@@ -294,12 +386,6 @@ GUPSGen::GenPort::sendTimingPacket(PacketPtr pkt)
     }
 }
 
-void
-GUPSGen::GenPort::sendFunctionalPacket(PacketPtr pkt)
-{
-    sendFunctional(pkt);
-}
-
 void
 GUPSGen::GenPort::recvReqRetry()
 {
@@ -37,10 +37,10 @@
  * Find more details: [https://icl.cs.utk.edu/projectsfiles/hpcc/RandomAccess/]
  */
 
-#include <queue>
-#include <unordered_map>
+#include <cassert>
 #include <vector>
 
+#include "base/random.hh"
 #include "base/statistics.hh"
 #include "mem/port.hh"
 #include "params/GUPSGen.hh"
@@ -86,8 +86,8 @@ class GUPSGen : public ClockedObject
 
       public:
 
-        GenPort(const std::string& name, GUPSGen *owner) :
-            RequestPort(name), owner(owner), _blocked(false),
+        GenPort(const std::string& name, GUPSGen *owner, PortID id) :
+            RequestPort(name, id), owner(owner), _blocked(false),
             blockedPacket(nullptr)
         {}
 
@@ -108,13 +108,6 @@ class GUPSGen : public ClockedObject
          */
         void sendTimingPacket(PacketPtr pkt);
 
-        /**
-         * @brief This function send a functional request to the port's peer
-         * responsePort
-         * @param pkt Pointer to the packet for the timing request
-         */
-        void sendFunctionalPacket(PacketPtr pkt);
-
       protected:
 
         bool recvTimingResp(PacketPtr pkt) override;
@@ -122,6 +115,57 @@ class GUPSGen : public ClockedObject
         void recvReqRetry() override;
     };
 
+    /**
+     * @brief State of one update, from the creation of its read until the
+     * response to its write. It rides along with the packets of the update
+     * as their sender state, so finding it back takes no lookup.
+     */
+    struct Slot : public Packet::SenderState
+    {
+        /** Value to xor the element with. */
+        uint64_t update = 0;
+        /** When the current request left the generator. */
+        Tick exitTime = 0;
+        /** Stream the update goes through. */
+        PortID port = 0;
+        /** Index of this slot in the slot table. */
+        int index = 0;
+        /** The read response while the write is waiting to be created. */
+        PacketPtr pkt = nullptr;
+    };
+
+    /**
+     * @brief Fixed size FIFO of slot indices.
+     */
+    class SlotRing
+    {
+      private:
+        std::vector<int> buf;
+        size_t head = 0;
+        size_t count = 0;
+
+      public:
+        void resize(size_t size) { buf.resize(size); }
+        bool empty() const { return count == 0; }
+        size_t size() const { return count; }
+        int front() const { return buf[head]; }
+
+        void
+        push(int idx)
+        {
+            assert(count < buf.size());
+            buf[(head + count++) % buf.size()] = idx;
+        }
+
+        void
+        pop()
+        {
+            assert(count > 0);
+            head = (head + 1) % buf.size();
+            count--;
+        }
+    };
+
     virtual void init() override;
 
     virtual void startup() override;
@@ -155,12 +199,34 @@ class GUPSGen : public ClockedObject
      */
     PacketPtr getWritePacket(Addr addr, unsigned int size, uint8_t* data);
 
+    /**
+     * @brief Write the initial values of the table, through back doors
+     * into the memories where they are available.
+     */
+    void initTable();
+
+    /**
+     * @brief Pick the stream an address goes through. Streams are tried
+     * in turn, starting after the last one picked, and the first one whose
+     * peer accepts the address wins. When all the ports see the whole
+     * table this spreads the updates evenly, and when each one leads to a
+     * memory channel of its own the address goes to its channel.
+     * @param addr Physical address of the update.
+     * @return The index of the stream.
+     */
+    PortID routeAddr(Addr addr);
+
     /**
      * @brief Handles the incoming responses from the outside.
      * @param pkt Pointer to the packet that includes the response.
      */
     void handleResponse(PacketPtr pkt);
 
+    /**
+     * @brief Schedule the events that can make progress.
+     */
+    void scheduleEvents();
+
     /**
      * @brief This function allows the port to wake its owner GUPSGen object
      * in case it has stopped working due to back pressure, it will wake up
@@ -169,7 +235,8 @@ class GUPSGen : public ClockedObject
     void wakeUp();
 
     /**
-     * @brief Create the next request and store in the requestPool.
+     * @brief Create the next request of every stream and queue it for
+     * sending on its port.
      */
     void createNextReq();
 
@@ -180,7 +247,7 @@ class GUPSGen : public ClockedObject
     EventFunctionWrapper nextCreateEvent;
 
     /**
-     * @brief Send outstanding requests from requestPool to the port.
+     * @brief Send the request at the head of every unblocked stream.
      */
     void sendNextReq();
 
@@ -191,34 +258,38 @@ class GUPSGen : public ClockedObject
     EventFunctionWrapper nextSendEvent;
 
     /**
-     * @brief Use an unordered map to store future updates on current reads
-     * as the updated value depends on the index which is know when a read
-     * request is created. The respective write will use the value stored to
-     * update the value.
+     * @brief The outstanding updates, request_queue_size of them for each
+     * stream. A slot is taken when the read of an update is created and
+     * given back when the response to its write arrives.
      */
-    std::unordered_map<RequestPtr, uint64_t> updateTable;
+    std::vector<Slot> slots;
 
     /**
-     * @brief Use an unordered map to track the time at which each request
-     * exits the GUPSGen. This is useful when we need to compute request
-     * latency.
+     * @brief Slots which don't hold an update.
      */
-    std::unordered_map<RequestPtr, Tick> exitTimes;
+    std::vector<int> freeSlots;
 
     /**
-     * @brief A queue to store the outstanding requests whether read or write.
-     * The element at the front of the queue is sent to outside everytime
-     * nextSendEvent is scheduled.
+     * @brief Slots whose read came back, waiting for their write to be
+     * created. Writes are prioritized over new reads.
      */
-    std::queue<PacketPtr> requestPool;
+    SlotRing pendingWrites;
 
     /**
-     * @brief A queue to store response packets from reads. each response in
-     * the response pool will generate a write request. The write request
-     * updates the value of data in the response packet with its corresponding
-     * value in the update table.
+     * @brief For each stream, the slots whose request is created but not
+     * yet sent.
      */
-    std::queue<PacketPtr> responsePool;
+    std::vector<SlotRing> sendQueues;
+
+    /**
+     * @brief The number of requests waiting in the send queues.
+     */
+    size_t queuedRequests;
+
+    /**
+     * @brief Stream the next address routing starts from.
+     */
+    PortID nextPort;
 
     /**
      * @brief The total number of updates (one read and one write) to do for
@@ -244,9 +315,14 @@ class GUPSGen : public ClockedObject
     const RequestorID requestorId;
 
     /**
-     * @brief An instance of GenPort to communicate with the outside.
+     * @brief The ports to communicate with the outside, one per stream.
+     */
+    std::vector<GenPort> ports;
+
+    /**
+     * @brief The address ranges each port accepts, learned at startup.
      */
-    GenPort port;
+    std::vector<AddrRangeList> portRanges;
 
     /**
      * @brief The beginning address for allocating the array.
@@ -270,8 +346,8 @@ class GUPSGen : public ClockedObject
     const int elementSize;
 
     /**
-     * @brief  The maximum number of outstanding requests (i.e. maximum length
-     * of the requestPool), specified as 1024 by the HPCC benchmark.
+     * @brief  The maximum number of outstanding updates of each stream,
+     * specified as 1024 by the HPCC benchmark.
      */
     int reqQueueSize;
 
@@ -282,6 +358,11 @@ class GUPSGen : public ClockedObject
      */
     bool initMemory;
 
+    /**
+     * @brief Random numbers used to pick the elements to update.
+     */
+    RandomStream rng;
+
     /**
      * @brief Boolean to indicate whether the generator is done creating read
      * requests, which means number of reads equal either updateLimit or
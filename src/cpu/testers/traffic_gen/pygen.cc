@@ -59,9 +59,39 @@ PyTrafficGen::start(pybind11::object meta_generator)
     BaseTrafficGen::start();
 }
 
+void
+PyTrafficGen::startSequence(pybind11::iterable generators, unsigned repeat)
+{
+    fatal_if(repeat == 0, "%s: a generator sequence must be run at least "
+             "once\n", name());
+
+    sequence.clear();
+    try {
+        for (auto gen : generators)
+            sequence.push_back(gen.cast<std::shared_ptr<BaseGen>>());
+    } catch (py::cast_error&) {
+        fatal("Generator sequence contains an invalid trace generator\n");
+    }
+    sequenceNext = 0;
+    sequenceRepeat = repeat;
+    BaseTrafficGen::start();
+}
+
 std::shared_ptr<BaseGen>
 PyTrafficGen::nextGenerator()
 {
+    if (!sequence.empty()) {
+        if (sequenceNext == sequence.size()) {
+            sequenceNext = 0;
+            if (--sequenceRepeat == 0) {
+                DPRINTF(TrafficGen, "Generator sequence done.\n");
+                sequence.clear();
+                return std::shared_ptr<BaseGen>();
+            }
+        }
+        return sequence[sequenceNext++];
+    }
+
     if (!metaGenerator)
         return std::shared_ptr<BaseGen>();
 
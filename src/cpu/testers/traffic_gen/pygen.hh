@@ -38,6 +38,9 @@
 #ifndef __CPU_TRAFFIC_GEN_PYGEN_HH__
 #define __CPU_TRAFFIC_GEN_PYGEN_HH__
 
+#include <memory>
+#include <vector>
+
 #include "pybind11/pybind11.h"
 
 #include "base/compiler.hh"
@@ -58,11 +61,22 @@ class GEM5_LOCAL PyTrafficGen : public BaseTrafficGen
   public: // Python API
     void start(pybind11::object meta_generator);
 
+    /**
+     * Run through a list of generators, repeat times, without calling
+     * back into Python between them.
+     */
+    void startSequence(pybind11::iterable generators, unsigned repeat);
+
   protected: // BaseTrafficGen
     std::shared_ptr<BaseGen> nextGenerator() override;
 
   protected: // Internal state
     pybind11::iterator metaGenerator;
+
+    /** Generators given to startSequence and the next one to run */
+    std::vector<std::shared_ptr<BaseGen>> sequence;
+    size_t sequenceNext = 0;
+    unsigned sequenceRepeat = 0;
 };
 
 } // namespace gem5
@@ -39,6 +39,7 @@
 
 #include <algorithm>
 
+#include "base/logging.hh"
 #include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/TrafficGen.hh"
@@ -49,10 +50,86 @@
 namespace gem5
 {
 
-TraceGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceGen::InputStream::InputStream(const std::string& filename,
+                                   double tick_scale, unsigned num_shards,
+                                   unsigned shard, size_t prefetch)
+    : trace(filename), tickScale(tick_scale), numShards(num_shards),
+      shard(shard), numRead(0),
+      chunkSize(prefetch ? (prefetch + MaxChunks - 1) / MaxChunks : 0),
+      pos(0), endOfTrace(false), stop(false)
 {
+    if (numShards == 0 || shard >= numShards)
+        fatal("Trace shard %d is not one of %d shards\n", shard, numShards);
+
     init();
+    startReader();
+}
+
+TraceGen::InputStream::~InputStream()
+{
+    stopReader();
+}
+
+void
+TraceGen::InputStream::startReader()
+{
+    if (!chunkSize)
+        return;
+
+    current.clear();
+    pos = 0;
+    ready.clear();
+    endOfTrace = false;
+    stop = false;
+    reader = std::thread([this]() { runReader(); });
+}
+
+void
+TraceGen::InputStream::stopReader()
+{
+    if (!reader.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cond.notify_all();
+    reader.join();
+}
+
+void
+TraceGen::InputStream::runReader()
+{
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this]() {
+                return stop || ready.size() < MaxChunks;
+            });
+            if (stop)
+                return;
+        }
+
+        // Decode a chunk without holding the lock, so the simulation
+        // thread can take the chunks decoded already meanwhile.
+        std::vector<TraceElement> chunk;
+        chunk.reserve(chunkSize);
+        TraceElement element;
+        while (chunk.size() < chunkSize && readElement(element))
+            chunk.push_back(element);
+
+        const bool done = chunk.size() < chunkSize;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!chunk.empty())
+                ready.push_back(std::move(chunk));
+            endOfTrace = done;
+        }
+        cond.notify_all();
+        if (done)
+            return;
+    }
 }
 
 void
@@ -71,19 +148,26 @@ TraceGen::InputStream::init()
 void
 TraceGen::InputStream::reset()
 {
+    stopReader();
     trace.reset();
+    numRead = 0;
     init();
+    startReader();
 }
 
 bool
-TraceGen::InputStream::read(TraceElement& element)
+TraceGen::InputStream::readElement(TraceElement& element)
 {
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    while (trace.read(pkt_msg)) {
+        if (numRead++ % numShards != shard)
+            continue;
+
         element.cmd = pkt_msg.cmd();
         element.addr = pkt_msg.addr();
         element.blocksize = pkt_msg.size();
-        element.tick = pkt_msg.tick();
+        element.tick = tickScale == 1.0 ? pkt_msg.tick() :
+            Tick(pkt_msg.tick() * tickScale);
         element.flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
         return true;
     }
@@ -92,6 +176,28 @@ TraceGen::InputStream::read(TraceElement& element)
     return false;
 }
 
+bool
+TraceGen::InputStream::read(TraceElement& element)
+{
+    if (!chunkSize)
+        return readElement(element);
+
+    if (pos == current.size()) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]() { return !ready.empty() || endOfTrace; });
+        if (ready.empty())
+            return false;
+        current = std::move(ready.front());
+        ready.pop_front();
+        pos = 0;
+        lock.unlock();
+        cond.notify_all();
+    }
+
+    element = current[pos++];
+    return true;
+}
+
 Tick
 TraceGen::nextPacketTick(bool elastic, Tick delay) const
 {
@@ -105,6 +211,10 @@ TraceGen::nextPacketTick(bool elastic, Tick delay) const
 
     assert(nextElement.isValid());
 
+    // untimed replay is only throttled by the outstanding requests
+    if (untimed)
+        return curTick();
+
     DPRINTF(TrafficGen, "Next packet tick is %d\n", tickOffset +
             nextElement.tick);
 
@@ -149,7 +259,7 @@ TraceGen::getNextPacket()
             currElement.tick,
             currElement.flags);
 
-    PacketPtr pkt = getPacket(currElement.addr + addrOffset,
+    PacketPtr pkt = getPacket((currElement.addr & addrMask) + addrOffset,
                               currElement.blocksize,
                               currElement.cmd, currElement.flags);
 
@@ -44,6 +44,12 @@
 #ifndef __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 #define __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base_gen.hh"
@@ -104,7 +110,8 @@ class TraceGen : public BaseGen
     /**
      * The InputStream encapsulates a trace file and the
      * internal buffers and populates TraceElements based on
-     * the input.
+     * the input. It can decode the trace ahead of time in a thread of
+     * its own, into a ring of chunks of elements.
      */
     class InputStream
     {
@@ -114,14 +121,57 @@ class TraceGen : public BaseGen
         /// Input file stream for the protobuf trace
         ProtoInputStream trace;
 
+        /** Factor the recorded ticks are multiplied by */
+        const double tickScale;
+
+        /** Only elements numShards * i + shard are played */
+        const unsigned numShards;
+        const unsigned shard;
+
+        /** Number of elements read from the file so far */
+        uint64_t numRead;
+
+        /** Number of elements per chunk, 0 to read on demand */
+        const size_t chunkSize;
+
+        /** Number of chunks decoded ahead at most */
+        static constexpr size_t MaxChunks = 4;
+
+        /** The chunk being played and the position in it */
+        std::vector<TraceElement> current;
+        size_t pos;
+
+        /** Chunks decoded by the reader thread, and its state */
+        std::deque<std::vector<TraceElement>> ready;
+        bool endOfTrace;
+        bool stop;
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::thread reader;
+
+        /** Read the next element of the shard from the file */
+        bool readElement(TraceElement& element);
+
+        void startReader();
+        void stopReader();
+        void runReader();
+
       public:
 
         /**
          * Create a trace input stream for a given file name.
          *
          * @param filename Path to the file to read from
+         * @param tick_scale Factor to multiply the recorded ticks by
+         * @param num_shards Number of shards the trace is split in
+         * @param shard Shard of the trace to play
+         * @param prefetch Elements to decode ahead, 0 to read on demand
          */
-        InputStream(const std::string& filename);
+        InputStream(const std::string& filename, double tick_scale = 1.0,
+                    unsigned num_shards = 1, unsigned shard = 0,
+                    size_t prefetch = 0);
+
+        ~InputStream();
 
         /**
          * Reset the stream such that it can be played once
@@ -156,13 +206,27 @@ class TraceGen : public BaseGen
      * @param _duration duration of this state before transitioning
      * @param trace_file File to read the transactions from
      * @param addr_offset Positive offset to add to trace address
+     * @param untimed Issue requests back-to-back, ignoring trace ticks
+     * @param tick_scale Factor to multiply the trace ticks by, e.g.
+     *                   0.5 to play the trace twice as fast
+     * @param addr_mask Mask applied to trace addresses before the offset
+     * @param num_shards Number of generators sharing the trace
+     * @param shard Which of the num_shards generators this is, every
+     *              num_shards-th request starting from this one is played
+     * @param prefetch Requests decoded ahead by a reader thread, 0 to
+     *                 read the trace on demand
      */
     TraceGen(SimObject &obj, RequestorID requestor_id, Tick _duration,
-             const std::string& trace_file, Addr addr_offset)
+             const std::string& trace_file, Addr addr_offset,
+             bool untimed = false, double tick_scale = 1.0,
+             Addr addr_mask = MaxAddr, unsigned num_shards = 1,
+             unsigned shard = 0, size_t prefetch = 0)
         : BaseGen(obj, requestor_id, _duration),
-          trace(trace_file),
+          trace(trace_file, tick_scale, num_shards, shard, prefetch),
           tickOffset(0),
           addrOffset(addr_offset),
+          addrMask(addr_mask),
+          untimed(untimed),
           traceComplete(false)
     {
     }
@@ -202,6 +266,15 @@ class TraceGen : public BaseGen
      */
     Addr addrOffset;
 
+    /** Mask applied to the trace addresses before adding the offset */
+    const Addr addrMask;
+
+    /**
+     * Ignore the recorded ticks and make every request available as
+     * soon as the previous one is sent.
+     */
+    const bool untimed;
+
     /**
      * Set to true when the trace replay for one instance of
      * state is complete.
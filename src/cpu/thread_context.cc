@@ -41,9 +41,11 @@
 
 #include "cpu/thread_context.hh"
 
+#include <functional>
 #include <vector>
 
 #include "arch/generic/vec_pred_reg.hh"
+#include "base/cprintf.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/base.hh"
@@ -51,6 +53,7 @@
 #include "debug/Quiesce.hh"
 #include "mem/port.hh"
 #include "params/BaseCPU.hh"
+#include "sim/eventq.hh"
 #include "sim/full_system.hh"
 
 namespace gem5
@@ -163,6 +166,49 @@ ThreadContext::sendFunctional(PacketPtr pkt)
     port->sendFunctional(pkt);
 }
 
+void
+ThreadContext::sendMemBackdoorReq(const MemBackdoorReq &req,
+        MemBackdoorPtr &backdoor)
+{
+    auto *port = dynamic_cast<RequestPort *>(&getCpuPtr()->getDataPort());
+    assert(port);
+    port->sendMemBackdoorReq(req, backdoor);
+}
+
+namespace
+{
+
+void
+runInQueueOf(ThreadContext *tc, const char *what, std::function<void()> f)
+{
+    EventQueue *target = tc->getCpuPtr()->eventQueue();
+    if (target == curEventQueue()) {
+        f();
+        return;
+    }
+    target->schedule(new EventFunctionWrapper(std::move(f),
+                csprintf("%s.%s", tc->getCpuPtr()->name(), what), true),
+            curTick() + simQuantum, true);
+}
+
+} // anonymous namespace
+
+void
+ThreadContext::activateFromAnyQueue()
+{
+    runInQueueOf(this, "activate", [this]() { activate(); });
+}
+
+void
+ThreadContext::haltFromAnyQueue(std::function<void()> then)
+{
+    runInQueueOf(this, "halt", [this, then]() {
+        halt();
+        if (then)
+            then();
+    });
+}
+
 void
 ThreadContext::quiesce()
 {
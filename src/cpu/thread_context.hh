@@ -42,6 +42,7 @@
 #ifndef __CPU_THREAD_CONTEXT_HH__
 #define __CPU_THREAD_CONTEXT_HH__
 
+#include <functional>
 #include <iostream>
 #include <string>
 
@@ -51,6 +52,7 @@
 #include "base/types.hh"
 #include "cpu/pc_event.hh"
 #include "cpu/reg_class.hh"
+#include "mem/backdoor.hh"
 
 namespace gem5
 {
@@ -144,6 +146,10 @@ class ThreadContext : public PCEventScope
 
     virtual void sendFunctional(PacketPtr pkt);
 
+    /** Ask for a back door to memory through the data port of the CPU */
+    virtual void sendMemBackdoorReq(const MemBackdoorReq &req,
+            MemBackdoorPtr &backdoor);
+
     virtual Process *getProcessPtr() = 0;
 
     virtual void setProcessPtr(Process *p) = 0;
@@ -161,6 +167,17 @@ class ThreadContext : public PCEventScope
     /// Set the status to Halted.
     virtual void halt() = 0;
 
+    /**
+     * Activate or halt the thread from any event queue. If the thread is
+     * simulated by another queue than the caller's, which may be running
+     * in parallel, this happens one simulation quantum from now through
+     * an asynchronous event.
+     *
+     * @param then Called right after the thread is halted.
+     */
+    void activateFromAnyQueue();
+    void haltFromAnyQueue(std::function<void()> then = {});
+
     /// Quiesce thread context
     void quiesce();
 
@@ -75,6 +75,14 @@ class TraceCPU(ClockedObject):
         1.0, "Multiplier scale the Trace CPU frequency up or down"
     )
 
+    # Number of elastic trace records decoded ahead of use by a separate
+    # thread. Decoding, and decompressing gzipped traces, then overlaps with
+    # simulation. A value of 0 decodes records on demand in the simulation
+    # thread.
+    readAheadRecords = Param.Unsigned(
+        0, "Elastic trace records to decode ahead in a separate thread"
+    )
+
     # Enable exiting when any one Trace CPU completes execution which is set to
     # false by default
     enableEarlyExit = Param.Bool(
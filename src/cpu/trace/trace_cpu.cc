@@ -593,7 +593,7 @@ TraceCPU::ElasticDataGen::executeMemReq(GraphNode* node_ptr)
     }
 
     // Create a request and the packet containing request
-    auto req = std::make_shared<Request>(
+    auto req = makeRequest(
         node_ptr->physAddr, node_ptr->size, node_ptr->flags, requestorId);
     req->setReqInstSeqNum(node_ptr->seqNum);
 
@@ -1084,7 +1084,7 @@ TraceCPU::FixedRetryGen::send(Addr addr, unsigned size, const MemCmd& cmd,
 {
 
     // Create new request
-    auto req = std::make_shared<Request>(addr, size, flags, requestorId);
+    auto req = makeRequest(addr, size, flags, requestorId);
     req->setPC(pc);
 
     // If this is not done it triggers assert in L1 cache for invalid contextId
@@ -1203,8 +1203,15 @@ TraceCPU::DcachePort::recvReqRetry()
 }
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
-        const std::string& filename, const double time_multiplier) :
+        const std::string& filename, const double time_multiplier,
+        size_t read_ahead) :
     trace(filename),
+    ring(read_ahead),
+    readAhead(read_ahead),
+    ringHead(0),
+    ringCount(0),
+    readerDone(false),
+    readerStop(false),
     timeMultiplier(time_multiplier),
     microOpCount(0)
 {
@@ -1222,19 +1229,102 @@ TraceCPU::ElasticDataGen::InputStream::InputStream(
         // when the data dependency trace was captured in the o3cpu model
         windowSize = header_msg.window_size();
     }
+
+    startReader();
+}
+
+TraceCPU::ElasticDataGen::InputStream::~InputStream()
+{
+    stopReader();
 }
 
 void
 TraceCPU::ElasticDataGen::InputStream::reset()
 {
+    stopReader();
     trace.reset();
+    startReader();
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::startReader()
+{
+    if (!readAhead)
+        return;
+
+    ringHead = 0;
+    ringCount = 0;
+    readerDone = false;
+    readerStop = false;
+    reader = std::thread(&InputStream::readAheadLoop, this);
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::stopReader()
+{
+    if (!reader.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(ringMutex);
+        readerStop = true;
+    }
+    ringNotFull.notify_one();
+    reader.join();
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::readAheadLoop()
+{
+    ProtoMessage::InstDepRecord msg;
+    while (true) {
+        // Decode outside the lock so the simulation thread only waits
+        // for the handoff itself.
+        bool valid = trace.read(msg);
+
+        std::unique_lock<std::mutex> lock(ringMutex);
+        ringNotFull.wait(lock, [this] {
+            return readerStop || ringCount < readAhead;
+        });
+        if (readerStop)
+            return;
+        if (!valid) {
+            readerDone = true;
+            lock.unlock();
+            ringNotEmpty.notify_one();
+            return;
+        }
+        ring[(ringHead + ringCount) % readAhead].Swap(&msg);
+        ++ringCount;
+        lock.unlock();
+        ringNotEmpty.notify_one();
+    }
+}
+
+bool
+TraceCPU::ElasticDataGen::InputStream::next(
+        ProtoMessage::InstDepRecord &msg)
+{
+    if (!readAhead)
+        return trace.read(msg);
+
+    std::unique_lock<std::mutex> lock(ringMutex);
+    ringNotEmpty.wait(lock, [this] { return readerDone || ringCount; });
+    if (!ringCount)
+        return false;
+    msg.Swap(&ring[ringHead]);
+    ringHead = (ringHead + 1) % readAhead;
+    --ringCount;
+    lock.unlock();
+    ringNotFull.notify_one();
+    return true;
 }
 
 bool
 TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
 {
     ProtoMessage::InstDepRecord pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (next(pkt_msg)) {
         // Required fields
         element->seqNum = pkt_msg.seq_num();
         element->type = pkt_msg.type();
@@ -38,10 +38,13 @@
 #ifndef __CPU_TRACE_TRACE_CPU_HH__
 #define __CPU_TRACE_TRACE_CPU_HH__
 
+#include <condition_variable>
 #include <cstdint>
 #include <list>
+#include <mutex>
 #include <queue>
 #include <set>
+#include <thread>
 #include <unordered_map>
 
 #include "base/statistics.hh"
@@ -749,6 +752,33 @@ class TraceCPU : public ClockedObject
             /** Input file stream for the protobuf trace */
             ProtoInputStream trace;
 
+            /**
+             * Records decoded ahead of use by the reader thread. The
+             * ring holds readAhead slots, ringHead is the oldest decoded
+             * record and ringCount the number of records waiting. The
+             * reader thread is only started if readAhead is non-zero.
+             */
+            std::vector<ProtoMessage::InstDepRecord> ring;
+            const size_t readAhead;
+            size_t ringHead;
+            size_t ringCount;
+            /** The reader thread reached the end of the trace. */
+            bool readerDone;
+            /** Ask the reader thread to stop. */
+            bool readerStop;
+            std::mutex ringMutex;
+            std::condition_variable ringNotEmpty;
+            std::condition_variable ringNotFull;
+            std::thread reader;
+
+            /** Body of the reader thread. */
+            void readAheadLoop();
+            void startReader();
+            void stopReader();
+
+            /** Get the next record, from the ring if reading ahead. */
+            bool next(ProtoMessage::InstDepRecord &msg);
+
             /**
              * A multiplier for the compute delays in the trace to modulate
              * the Trace CPU frequency either up or down. The Trace CPU's
@@ -772,9 +802,14 @@ class TraceCPU : public ClockedObject
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param read_ahead Records to decode ahead in a separate
+             *                   thread, zero to decode on demand
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier,
+                        size_t read_ahead = 0);
+
+            ~InputStream();
 
             /**
              * Reset the stream such that it can be played once
@@ -809,7 +844,8 @@ class TraceCPU : public ClockedObject
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file, 1.0 / params.freqMultiplier),
+            trace(trace_file, 1.0 / params.freqMultiplier,
+                  params.readAheadRecords),
             genName(owner.name() + ".elastic." + _name),
             retryPkt(nullptr),
             traceComplete(false),
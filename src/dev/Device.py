@@ -111,6 +111,21 @@ class DmaDevice(PioDevice):
         "several devices attached to it",
     )
 
+    dma_burst_size = Param.MemorySize(
+        "0B",
+        "Size of the packets DMA requests are split into, 0 for the cache "
+        "line size. Bursts larger than a cache line must not go through "
+        "caches",
+    )
+    dma_bulk_latency = Param.Latency(
+        "0ns", "Fixed latency of the DMA requests done in bulk"
+    )
+    dma_bulk_bandwidth = Param.MemoryBandwidth(
+        "0B/s",
+        "Bandwidth of the DMA requests done in bulk through memory "
+        "backdoors in timing mode, bypassing any cache, 0 to disable them",
+    )
+
     def addIommuProperty(self, state, node):
         """
         This method takes an FdtState and a FdtNode as parameters, and
@@ -367,8 +367,8 @@ AMDGPUDevice::readFrame(PacketPtr pkt, Addr offset)
      * because this method is called by the PCIDevice::read method which
      * is a non-timing read.
      */
-    RequestPtr req = std::make_shared<Request>(offset, pkt->getSize(), 0,
-                                               vramRequestorId());
+    RequestPtr req = makeRequest(offset, pkt->getSize(), 0,
+                                 vramRequestorId());
     PacketPtr readPkt = Packet::createRead(req);
     uint8_t *dataPtr = new uint8_t[pkt->getSize()];
     readPkt->dataDynamic(dataPtr);
@@ -437,8 +437,8 @@ AMDGPUDevice::writeFrame(PacketPtr pkt, Addr offset)
      * because this method is called by the PCIDevice::write method which
      * is a non-timing write.
      */
-    RequestPtr req = std::make_shared<Request>(offset, pkt->getSize(), 0,
-                                               vramRequestorId());
+    RequestPtr req = makeRequest(offset, pkt->getSize(), 0,
+                                 vramRequestorId());
     PacketPtr writePkt = Packet::createWrite(req);
     uint8_t *dataPtr = new uint8_t[pkt->getSize()];
     std::memcpy(dataPtr, pkt->getPtr<uint8_t>(),
@@ -657,7 +657,7 @@ AMDGPUDevice::getRegVal(uint64_t addr)
     Addr fixup_addr = bits(addr, 31, 31) ? addr : addr & 0x7fffffff;
 
     uint32_t pkt_data = 0;
-    RequestPtr request = std::make_shared<Request>(fixup_addr,
+    RequestPtr request = makeRequest(fixup_addr,
             sizeof(uint32_t), 0 /* flags */, vramRequestorId());
     PacketPtr pkt = Packet::createRead(request);
     pkt->dataStatic((uint8_t *)&pkt_data);
@@ -675,7 +675,7 @@ AMDGPUDevice::setRegVal(uint64_t addr, uint32_t value)
             addr, value);
 
     uint32_t pkt_data = value;
-    RequestPtr request = std::make_shared<Request>(addr,
+    RequestPtr request = makeRequest(addr,
             sizeof(uint32_t), 0 /* flags */, vramRequestorId());
     PacketPtr pkt = Packet::createWrite(request);
     pkt->dataStatic((uint8_t *)&pkt_data);
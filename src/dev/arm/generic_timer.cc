@@ -73,7 +73,8 @@ SystemCounter::SystemCounter(const SystemCounterParams &p)
       _activeFreqEntry(0),
       _updateTick(0),
       _freqUpdateEvent([this]{ freqUpdateCallback(); }, name()),
-      _nextFreqEntry(0)
+      _nextFreqEntry(0),
+      _deadlineEvent([this]{ deadlineCallback(); }, name() + ".deadline")
 {
     fatal_if(_freqTable.empty(), "SystemCounter::SystemCounter: Base "
         "frequency not provided\n");
@@ -207,11 +208,68 @@ SystemCounter::registerListener(SystemCounterListener *listener)
     _listeners.push_back(listener);
 }
 
+size_t
+SystemCounter::registerTimer(ArchTimer *timer)
+{
+    _timers.push_back(timer);
+    return _timers.size() - 1;
+}
+
+void
+SystemCounter::setDeadline(ArchTimer *timer, Tick when)
+{
+    cancelDeadline(timer);
+    timer->_deadline = when;
+    _deadlines.emplace(when, timer->_timerId);
+    scheduleDeadlineEvent();
+}
+
 void
-SystemCounter::notifyListeners() const
+SystemCounter::cancelDeadline(ArchTimer *timer)
 {
+    if (timer->_deadline == MaxTick)
+        return;
+    _deadlines.erase({timer->_deadline, timer->_timerId});
+    timer->_deadline = MaxTick;
+    scheduleDeadlineEvent();
+}
+
+void
+SystemCounter::scheduleDeadlineEvent()
+{
+    if (_notifying)
+        return;
+    if (_deadlines.empty()) {
+        if (_deadlineEvent.scheduled())
+            deschedule(_deadlineEvent);
+    } else if (!_deadlineEvent.scheduled() ||
+               _deadlineEvent.when() != _deadlines.begin()->first) {
+        reschedule(_deadlineEvent, _deadlines.begin()->first, true);
+    }
+}
+
+void
+SystemCounter::deadlineCallback()
+{
+    while (!_deadlines.empty() && _deadlines.begin()->first <= curTick()) {
+        ArchTimer *timer = _timers[_deadlines.begin()->second];
+        _deadlines.erase(_deadlines.begin());
+        timer->_deadline = MaxTick;
+        timer->counterLimitReached();
+    }
+    scheduleDeadlineEvent();
+}
+
+void
+SystemCounter::notifyListeners()
+{
+    // All the deadlines are likely to move, only schedule the event for
+    // the earliest one once they have
+    _notifying = true;
     for (auto &listener : _listeners)
         listener->notify();
+    _notifying = false;
+    scheduleDeadlineEvent();
 }
 
 void
@@ -264,7 +322,7 @@ ArchTimer::ArchTimer(const std::string &name,
     : _name(name), _parent(parent), _systemCounter(sysctr),
       _interrupt(interrupt),
       _control(0), _counterLimit(0), _offset(0),
-      _counterLimitReachedEvent([this]{ counterLimitReached(); }, name)
+      _timerId(sysctr.registerTimer(this))
 {
     _systemCounter.registerListener(this);
 }
@@ -290,8 +348,7 @@ ArchTimer::counterLimitReached()
 void
 ArchTimer::updateCounter()
 {
-    if (_counterLimitReachedEvent.scheduled())
-        _parent.deschedule(_counterLimitReachedEvent);
+    _systemCounter.cancelDeadline(this);
     if (value() >= _counterLimit) {
         counterLimitReached();
     } else {
@@ -303,10 +360,8 @@ ArchTimer::updateCounter()
 
         _control.istatus = 0;
 
-        if (scheduleEvents()) {
-            _parent.schedule(_counterLimitReachedEvent,
-                             whenValue(_counterLimit));
-        }
+        if (scheduleEvents())
+            _systemCounter.setDeadline(this, whenValue(_counterLimit));
     }
 }
 
@@ -395,8 +450,7 @@ ArchTimer::unserialize(CheckpointIn &cp)
 DrainState
 ArchTimer::drain()
 {
-    if (_counterLimitReachedEvent.scheduled())
-        _parent.deschedule(_counterLimitReachedEvent);
+    _systemCounter.cancelDeadline(this);
 
     return DrainState::Drained;
 }
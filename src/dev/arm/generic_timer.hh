@@ -39,6 +39,8 @@
 #define __DEV_ARM_GENERIC_TIMER_HH__
 
 #include <cstdint>
+#include <set>
+#include <utility>
 #include <vector>
 
 #include "arch/arm/isa_device.hh"
@@ -65,6 +67,7 @@
 namespace gem5
 {
 
+class ArchTimer;
 class Checkpoint;
 struct SystemCounterParams;
 struct GenericTimerParams;
@@ -83,6 +86,10 @@ class SystemCounterListener
 
 /// Global system counter.  It is shared by the architected and memory-mapped
 /// timers.
+///
+/// The counter also keeps the deadlines of all the timers relying on it,
+/// ordered by tick, and only schedules an event for the earliest one, so
+/// that timer register writes don't reschedule events.
 class SystemCounter : public SimObject
 {
   protected:
@@ -107,6 +114,14 @@ class SystemCounter : public SimObject
     /// Listeners to changes in counting speed
     std::vector<SystemCounterListener *> _listeners;
 
+    /// Timers relying on the counter, by id
+    std::vector<ArchTimer *> _timers;
+    /// Deadlines of the timers, with their ids
+    std::set<std::pair<Tick, size_t>> _deadlines;
+    /// Whether listeners are being notified, in which case the deadline
+    /// event is only scheduled once they all have been
+    bool _notifying = false;
+
     /// Maximum architectural number of frequency table entries
     static constexpr size_t MAX_FREQ_ENTRIES = 1004;
 
@@ -148,6 +163,13 @@ class SystemCounter : public SimObject
     /// Called from System Counter Listeners to register
     void registerListener(SystemCounterListener *listener);
 
+    /// Called from timers to register, returns their id
+    size_t registerTimer(ArchTimer *timer);
+    /// Sets the tick at which a timer reaches its limit
+    void setDeadline(ArchTimer *timer, Tick when);
+    /// Removes the deadline of a timer, if any
+    void cancelDeadline(ArchTimer *timer);
+
     /// Returns the tick at which a certain counter value is reached
     Tick whenValue(uint64_t target_val);
     Tick whenValue(uint64_t cur_val, uint64_t target_val) const;
@@ -165,6 +187,11 @@ class SystemCounter : public SimObject
     /// Callback for the frequency update
     void freqUpdateCallback();
 
+    /// Deadline event handling, for the earliest timer deadline
+    EventFunctionWrapper _deadlineEvent;
+    void deadlineCallback();
+    void scheduleDeadlineEvent();
+
     /// Updates the counter value.
     void updateValue(void);
 
@@ -172,7 +199,7 @@ class SystemCounter : public SimObject
     void updateTick(void);
 
     /// Notifies counting speed changes to listeners
-    void notifyListeners(void) const;
+    void notifyListeners(void);
 };
 
 /// Per-CPU architected timer.
@@ -204,6 +231,11 @@ class ArchTimer : public SystemCounterListener, public Drainable,
     /// Offset relative to the physical timer (CNTVOFF)
     uint64_t _offset;
 
+    /// Id of the timer in the system counter
+    const size_t _timerId;
+    /// Tick at which the limit is reached, MaxTick if not tracked
+    Tick _deadline = MaxTick;
+
     /**
      * Timer settings or the offset has changed, re-evaluate
      * trigger condition and raise interrupt if necessary.
@@ -212,7 +244,7 @@ class ArchTimer : public SystemCounterListener, public Drainable,
 
     /// Called when the upcounter reaches the programmed value.
     void counterLimitReached();
-    EventFunctionWrapper _counterLimitReachedEvent;
+    friend class SystemCounter;
 
     virtual bool scheduleEvents() { return true; }
 
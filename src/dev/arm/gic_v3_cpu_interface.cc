@@ -2031,7 +2031,7 @@ Gicv3CPUInterface::highestActiveGroup() const
 void
 Gicv3CPUInterface::updateDistributor()
 {
-    distributor->update();
+    distributor->update(this);
 }
 
 void
@@ -85,6 +85,7 @@ Gicv3Distributor::Gicv3Distributor(Gicv3 * gic, uint32_t it_lines)
       irqGrpmod(it_lines, 0),
       irqNsacr(it_lines, 0),
       irqAffinityRouting(it_lines, 0),
+      irqCandidates(divCeil(it_lines, 64), 0),
       gicdTyper(0),
       gicdPidr0(0x92),
       gicdPidr1(0xb4),
@@ -559,6 +560,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
                 }
 
                 irqEnabled[int_id] = true;
+                updateCandidate(int_id);
             }
         }
 
@@ -588,6 +590,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
                 }
 
                 irqEnabled[int_id] = false;
+                updateCandidate(int_id);
             }
         }
 
@@ -617,6 +620,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
                 DPRINTF(GIC, "Gicv3Distributor::write() (GICD_ISPENDR): "
                         "int_id %d (SPI) pending bit set\n", int_id);
                 irqPending[int_id] = true;
+                updateCandidate(int_id);
                 irqPendingIspendr[int_id] = true;
             }
         }
@@ -646,6 +650,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
 
             if (clear && treatAsEdgeTriggered(int_id)) {
                 irqPending[int_id] = false;
+                updateCandidate(int_id);
                 clearIrqCpuInterface(int_id);
             }
         }
@@ -672,6 +677,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
 
             if (active) {
                 irqActive[int_id] = 1;
+                updateCandidate(int_id);
             }
         }
 
@@ -701,6 +707,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
                 }
 
                 irqActive[int_id] = false;
+                updateCandidate(int_id);
             }
         }
 
@@ -1010,10 +1017,11 @@ Gicv3Distributor::sendInt(uint32_t int_id)
     panic_if(int_id < Gicv3::SGI_MAX + Gicv3::PPI_MAX, "Invalid SPI!");
     panic_if(int_id > itLines, "Invalid SPI!");
     irqPending[int_id] = true;
+    updateCandidate(int_id);
     irqPendingIspendr[int_id] = false;
     DPRINTF(GIC, "Gicv3Distributor::sendInt(): "
             "int_id %d (SPI) pending bit set\n", int_id);
-    update();
+    update(nullptr);
 }
 
 void
@@ -1032,9 +1040,12 @@ Gicv3Distributor::deassertSPI(uint32_t int_id)
     panic_if(int_id < Gicv3::SGI_MAX + Gicv3::PPI_MAX, "Invalid SPI!");
     panic_if(int_id > itLines, "Invalid SPI!");
     irqPending[int_id] = false;
+    updateCandidate(int_id);
     clearIrqCpuInterface(int_id);
 
-    update();
+    // Only the interface the interrupt was routed to may have to signal
+    // something else
+    update(route(int_id));
 }
 
 Gicv3CPUInterface*
@@ -1082,20 +1093,47 @@ Gicv3Distributor::clearIrqCpuInterface(uint32_t int_id)
         cpu_interface->resetHppi(int_id);
 }
 
+void
+Gicv3Distributor::updateCandidate(uint32_t int_id)
+{
+    const uint64_t bit = 1ULL << (int_id % 64);
+    if (irqPending[int_id] && irqEnabled[int_id] && !irqActive[int_id])
+        irqCandidates[int_id / 64] |= bit;
+    else
+        irqCandidates[int_id / 64] &= ~bit;
+}
+
 void
 Gicv3Distributor::update()
+{
+    updateSPIs(nullptr, true);
+}
+
+void
+Gicv3Distributor::update(Gicv3CPUInterface *affected)
+{
+    updateSPIs(affected, false);
+}
+
+void
+Gicv3Distributor::updateSPIs(Gicv3CPUInterface *affected, bool all)
 {
     if (gic->blockIntUpdate())
         return;
 
-    // Find the highest priority pending SPI
-    for (int int_id = Gicv3::SGI_MAX + Gicv3::PPI_MAX; int_id < itLines;
-         int_id++) {
-        Gicv3::GroupId int_group = getIntGroup(int_id);
-        bool group_enabled = groupEnabled(int_group);
-
-        if (irqPending[int_id] && irqEnabled[int_id] &&
-            !irqActive[int_id] && group_enabled) {
+    const int num_cpus = gic->getSystem()->threads.size();
+    hppiChanged.assign(num_cpus, all);
+    if (affected)
+        hppiChanged[affected->cpuId] = true;
+
+    // Find the highest priority pending SPI, only looking at the ones
+    // which are pending, enabled and not active
+    for (int word = 0; word < irqCandidates.size(); word++) {
+        for (uint64_t bits = irqCandidates[word]; bits; bits &= bits - 1) {
+            const int int_id = word * 64 + ctz64(bits);
+            Gicv3::GroupId int_group = getIntGroup(int_id);
+            if (!groupEnabled(int_group))
+                continue;
 
             // Find the cpu interface where to route the interrupt
             Gicv3CPUInterface *target_cpu_interface = route(int_id);
@@ -1110,13 +1148,16 @@ Gicv3Distributor::update()
                 target_cpu_interface->hppi.intid = int_id;
                 target_cpu_interface->hppi.prio = irqPriority[int_id];
                 target_cpu_interface->hppi.group = int_group;
+                hppiChanged[target_cpu_interface->cpuId] = true;
             }
         }
     }
 
-    // Update all redistributors
-    for (int i = 0; i < gic->getSystem()->threads.size(); i++) {
-        gic->getRedistributor(i)->update();
+    // Update the redistributors of the cpu interfaces which may signal
+    // something else than before
+    for (int i = 0; i < num_cpus; i++) {
+        if (hppiChanged[i])
+            gic->getRedistributor(i)->update();
     }
 }
 
@@ -1171,14 +1212,17 @@ Gicv3Distributor::activateIRQ(uint32_t int_id)
 {
     if (treatAsEdgeTriggered(int_id)) {
         irqPending[int_id] = false;
+        updateCandidate(int_id);
     }
     irqActive[int_id] = true;
+    updateCandidate(int_id);
 }
 
 void
 Gicv3Distributor::deactivateIRQ(uint32_t int_id)
 {
     irqActive[int_id] = false;
+    updateCandidate(int_id);
 }
 
 void
@@ -1242,6 +1286,9 @@ Gicv3Distributor::unserialize(CheckpointIn & cp)
     UNSERIALIZE_CONTAINER(irqGrpmod);
     UNSERIALIZE_CONTAINER(irqNsacr);
     UNSERIALIZE_CONTAINER(irqAffinityRouting);
+
+    for (uint32_t int_id = 0; int_id < itLines; int_id++)
+        updateCandidate(int_id);
 }
 
 } // namespace gem5
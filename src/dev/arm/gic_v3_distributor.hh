@@ -165,6 +165,16 @@ class Gicv3Distributor : public Serializable
     std::vector <uint8_t> irqNsacr;
     std::vector <IROUTER> irqAffinityRouting;
 
+    /**
+     * One bit per interrupt which is pending, enabled and not active,
+     * kept up to date with those, so that finding the SPIs to signal
+     * only looks at the ones which may be signalled.
+     */
+    std::vector <uint64_t> irqCandidates;
+
+    /** Cpu interfaces which may signal something else, by cpu id */
+    std::vector <bool> hppiChanged;
+
     uint32_t gicdTyper;
     uint32_t gicdPidr0;
     uint32_t gicdPidr1;
@@ -181,6 +191,8 @@ class Gicv3Distributor : public Serializable
 
     void activateIRQ(uint32_t int_id);
     void deactivateIRQ(uint32_t int_id);
+    void updateCandidate(uint32_t int_id);
+    void updateSPIs(Gicv3CPUInterface *affected, bool all);
     void fullUpdate();
     Gicv3::GroupId getIntGroup(int int_id) const;
 
@@ -273,7 +285,19 @@ class Gicv3Distributor : public Serializable
                bool is_secure_access);
 
     void copy(Gicv3Registers *from, Gicv3Registers *to);
+
+    /** Update the highest priority pending interrupts of all cpus */
     void update();
+
+    /**
+     * Update the highest priority pending interrupts after a change
+     * which only affects a cpu interface, and the SPIs. Only the
+     * affected interface and those an SPI is now signalled to are
+     * updated.
+     *
+     * @param affected The affected interface, if any
+     */
+    void update(Gicv3CPUInterface *affected);
 };
 
 } // namespace gem5
@@ -791,7 +791,7 @@ Gicv3Redistributor::intStatus(uint32_t int_id) const
 void
 Gicv3Redistributor::updateDistributor()
 {
-    distributor->update();
+    distributor->update(cpuInterface);
 }
 
 /*
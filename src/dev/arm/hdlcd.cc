@@ -518,11 +518,7 @@ HDLcd::lineNext(std::vector<Pixel>::iterator pixel_it, size_t line_length)
 
     bypassLineAddress += fb_line_pitch;
 
-    uint8_t *bufPtr = lineBuffer.data();
-    for (size_t i = 0; i < line_length; i++) {
-        *pixel_it++ = conv.toPixel(bufPtr);
-        bufPtr += conv.length;
-    }
+    conv.toPixels(lineBuffer.data(), &*pixel_it, line_length);
 
     return line_length;
 }
@@ -570,7 +566,9 @@ HDLcd::pxlFrameDone()
     if (vnc)
         vnc->setDirty();
 
-    if (enableCapture) {
+    // Only rewrite the image if the frame changed since the last one
+    if (enableCapture &&
+        (!pic || pixelPump.fb.version() != capturedVersion)) {
         if (!pic) {
             pic = simout.create(
                 csprintf("%s.framebuffer.%s",
@@ -581,6 +579,7 @@ HDLcd::pxlFrameDone()
         assert(pic);
         pic->stream()->seekp(0);
         imgWriter->write(*pic->stream());
+        capturedVersion = pixelPump.fb.version();
     }
 }
 
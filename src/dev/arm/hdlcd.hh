@@ -377,6 +377,8 @@ class HDLcd: public AmbaDmaDevice
 
     /** Picture of what the current frame buffer looks like */
     OutputStream *pic = nullptr;
+    /** Frame buffer version last written to pic */
+    uint64_t capturedVersion = 0;
 
     /** Cached pixel converter, set when the converter is enabled. */
     PixelConverter conv = PixelConverter::rgba8888_le;
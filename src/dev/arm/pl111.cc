@@ -65,7 +65,7 @@ Pl111::Pl111(const Params &p)
       clcdCrsrIcr(0), clcdCrsrRis(0), clcdCrsrMis(0),
       pixelClock(p.pixel_clock),
       converter(PixelConverter::rgba8888_le), fb(LcdMaxWidth, LcdMaxHeight),
-      vnc(p.vnc), bmp(&fb), pic(NULL),
+      vnc(p.vnc), bmp(&fb), pic(NULL), capturedVersion(0),
       width(LcdMaxWidth), height(LcdMaxHeight),
       bytesPerPixel(4), startTime(0), startAddr(0), maxAddr(0), curAddr(0),
       waterMark(0), dmaPendingNum(0),
@@ -492,7 +492,8 @@ Pl111::dmaDone()
         if (vnc)
             vnc->setDirty();
 
-        if (enableCapture) {
+        // Only rewrite the image if the frame changed since the last one
+        if (enableCapture && (!pic || fb.version() != capturedVersion)) {
             DPRINTF(PL111, "-- write out frame buffer into bmp\n");
 
             if (!pic)
@@ -502,6 +503,7 @@ Pl111::dmaDone()
             assert(pic);
             pic->stream()->seekp(0);
             bmp.write(*pic->stream());
+            capturedVersion = fb.version();
         }
 
         // schedule the next read based on when the last frame started
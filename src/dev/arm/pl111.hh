@@ -272,6 +272,9 @@ class Pl111: public AmbaDmaDevice
     /** Picture of what the current frame buffer looks like */
     OutputStream *pic;
 
+    /** Frame buffer version last written to pic */
+    uint64_t capturedVersion;
+
     /** Frame buffer width - pixels per line */
     uint16_t width;
 
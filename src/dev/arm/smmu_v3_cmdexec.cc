@@ -37,12 +37,40 @@
 
 #include "dev/arm/smmu_v3_cmdexec.hh"
 
+#include <algorithm>
+#include <cstring>
+
 #include "base/bitfield.hh"
 #include "dev/arm/smmu_v3.hh"
 
 namespace gem5
 {
 
+bool
+SMMUCommandExecProcess::redundant(const SMMUCommand *cmds, unsigned idx)
+{
+    switch (cmds[idx].dw0.type) {
+      case CMD_CFGI_STE:
+      case CMD_CFGI_STE_RANGE:
+      case CMD_CFGI_CD:
+      case CMD_CFGI_CD_ALL:
+      case CMD_TLBI_NH_ALL:
+      case CMD_TLBI_NH_ASID:
+      case CMD_TLBI_NH_VAA:
+      case CMD_TLBI_NH_VA:
+      case CMD_TLBI_S2_IPA:
+      case CMD_TLBI_S12_VMALL:
+      case CMD_TLBI_NSNH_ALL:
+        for (unsigned i = 0; i < idx; i++) {
+            if (!memcmp(&cmds[i], &cmds[idx], sizeof(SMMUCommand)))
+                return true;
+        }
+        return false;
+      default:
+        return false;
+    }
+}
+
 void
 SMMUCommandExecProcess::main(Yield &yield)
 {
@@ -71,15 +99,32 @@ SMMUCommandExecProcess::main(Yield &yield)
                     (smmu.regs.cmdq_prod & size_mask_wrap))
                 break; // command queue empty
 
+            int index = smmu.regs.cmdq_cons & size_mask;
             Addr cmd_addr =
                 (smmu.regs.cmdq_base & Q_BASE_ADDR_MASK) +
-                (smmu.regs.cmdq_cons & size_mask) * sizeof(SMMUCommand);
+                index * sizeof(SMMUCommand);
+
+            // Read as many of the pending commands as possible at once,
+            // without going past the end of the queue or of the aligned
+            // block the first one is in.
+            unsigned avail = (smmu.regs.cmdq_prod - smmu.regs.cmdq_cons) &
+                size_mask_wrap;
+            unsigned count = std::min({avail,
+                    (unsigned)(size_mask + 1 - index),
+                    BatchSize - index % BatchSize});
 
             // This deliberately resets the error field in cmdq_cons!
-            smmu.regs.cmdq_cons = (smmu.regs.cmdq_cons + 1) & size_mask_wrap;
+            smmu.regs.cmdq_cons =
+                (smmu.regs.cmdq_cons + count) & size_mask_wrap;
+
+            doRead(yield, cmd_addr, cmds, count * sizeof(SMMUCommand));
 
-            doRead(yield, cmd_addr, &cmd, sizeof(SMMUCommand));
-            smmu.processCommand(cmd);
+            // Nothing can run in between, so repeated invalidations in
+            // the batch can be dropped.
+            for (unsigned i = 0; i < count; i++) {
+                if (!redundant(cmds, i))
+                    smmu.processCommand(cmds[i]);
+            }
         }
 
         busy = false;
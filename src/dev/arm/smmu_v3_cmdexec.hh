@@ -49,7 +49,20 @@ class SMMUv3;
 class SMMUCommandExecProcess : public SMMUProcess
 {
   private:
-    SMMUCommand cmd;
+    /**
+     * Commands are read from the queue in aligned blocks of up to this
+     * many, with a single memory access.
+     */
+    static constexpr unsigned BatchSize = 4;
+
+    SMMUCommand cmds[BatchSize];
+
+    /**
+     * Whether a command has the same effect as an identical one executed
+     * earlier in the same batch: invalidations, as nothing fills the
+     * caches while a batch is processed.
+     */
+    static bool redundant(const SMMUCommand *cmds, unsigned idx);
 
     bool busy;
 
@@ -37,6 +37,7 @@
 
 #include "dev/arm/smmu_v3_deviceifc.hh"
 
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/SMMUv3.hh"
 #include "dev/arm/smmu_v3.hh"
@@ -124,12 +125,78 @@ SMMUv3DeviceInterface::schedAtsTimingResp(PacketPtr pkt)
     }
 }
 
+bool
+SMMUv3DeviceInterface::tryAtomicFastPath(PacketPtr pkt, Tick &delay)
+{
+    if (!(smmu->regs.cr0 & CR0_SMMUEN_MASK))
+        return false;
+
+    const Addr addr = pkt->getAddr();
+    const Addr next4k = (addr + 0x1000ULL) & ~0xfffULL;
+    if (addr + pkt->getSize() > next4k)
+        return false;
+
+    const uint32_t sid = pkt->req->streamId();
+    const uint32_t ssid = pkt->req->hasSubstreamId() ?
+        pkt->req->substreamId() : 0;
+
+    // Check for a hit first without touching the statistics, which the
+    // translation process updates if there is none. Prefetched entries
+    // of the main TLB are left to it too, as they trigger a prefetch.
+    const bool micro_hit = microTLBEnable &&
+        microTLB->lookup(sid, ssid, addr, false);
+    if (!micro_hit) {
+        const SMMUTLB::Entry *main_e = mainTLBEnable ?
+            mainTLB->lookup(sid, ssid, addr, false) : nullptr;
+        if (!main_e || main_e->prefetched)
+            return false;
+    }
+
+    // Same lookups and latencies as a translation process hitting in the
+    // TLBs, which in atomic mode never waits on anything.
+    Cycles lat(pkt->isWrite() ? divCeil(pkt->getSize(), portWidth) : 1);
+    const SMMUTLB::Entry *e = nullptr;
+    if (microTLBEnable) {
+        lat += microTLBLat;
+        e = microTLB->lookup(sid, ssid, addr);
+    }
+    if (!e) {
+        const SMMUTLB::Entry *main_e = mainTLB->lookup(sid, ssid, addr);
+        lat += mainTLBLat;
+        DPRINTF(SMMUv3, "[a] fast path main TLB hit vaddr=%#x sid=%#x "
+                "ssid=%#x\n", addr, sid, ssid);
+        if (microTLBEnable) {
+            SMMUTLB::Entry micro_e = *main_e;
+            micro_e.prefetched = false;
+            microTLB->store(micro_e, SMMUTLB::ALLOC_ANY_WAY);
+        }
+        e = main_e;
+    }
+
+    const Addr paddr = e->pa + (addr & ~e->vaMask);
+    DPRINTF(SMMUv3, "[a] fast path vaddr=%#x paddr=%#x\n", addr, paddr);
+
+    lat += Cycles(pkt->isWrite() ?
+            divCeil(pkt->getSize(), smmu->requestPortWidth) : 1);
+    smmu->stats.translationTimeDist.sample(0);
+
+    pkt->setAddr(paddr);
+    pkt->req->setPaddr(paddr);
+    delay = lat * smmu->clockPeriod() + smmu->requestPort.sendAtomic(pkt);
+    pkt->setAddr(addr);
+    return true;
+}
+
 Tick
 SMMUv3DeviceInterface::recvAtomic(PacketPtr pkt)
 {
     DPRINTF(SMMUv3, "[a] req from %s addr=%#x size=%#x\n",
             devicePort->getPeer(), pkt->getAddr(), pkt->getSize());
 
+    Tick delay;
+    if (tryAtomicFastPath(pkt, delay))
+        return delay;
+
     std::string proc_name = csprintf("%s.port", name());
     SMMUTranslationProcess proc(proc_name, *smmu, *this);
     proc.beginTransaction(SMMUTranslRequest::fromPacket(pkt));
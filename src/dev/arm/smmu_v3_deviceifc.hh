@@ -96,6 +96,16 @@ class SMMUv3DeviceInterface : public ClockedObject
     std::list<SMMUTranslationProcess *> dependentWrites[SMMU_MAX_TRANS_ID];
     SMMUSignal dependentReqRemoved;
 
+    /**
+     * Translate an atomic request which hits in the micro TLB or main
+     * TLB, and forward it, without running a translation process.
+     *
+     * @param pkt The request from the device
+     * @param delay Set to the latency of the request when translated
+     * @return Whether the request was translated and forwarded
+     */
+    bool tryAtomicFastPath(PacketPtr pkt, Tick &delay);
+
     // Receiving translation requests from the requestor device
     Tick recvAtomic(PacketPtr pkt);
     bool recvTimingReq(PacketPtr pkt);
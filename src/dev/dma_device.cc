@@ -45,6 +45,7 @@
 #include <cstring>
 #include <utility>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/DMA.hh"
@@ -60,9 +61,26 @@ DmaPort::DmaPort(ClockedObject *dev, System *s,
     : RequestPort(dev->name() + ".dma"),
       device(dev), sys(s), requestorId(s->getRequestorId(dev)),
       sendEvent([this]{ sendDma(); }, dev->name()),
-      defaultSid(sid), defaultSSid(ssid), cacheLineSize(s->cacheLineSize())
+      defaultSid(sid), defaultSSid(ssid), cacheLineSize(s->cacheLineSize()),
+      burstSize(cacheLineSize),
+      bulkDoneEvent([this]{ completeBulkReqs(); }, dev->name() + ".bulk")
 { }
 
+void
+DmaPort::setBurstSize(Addr size)
+{
+    fatal_if(size && !isPowerOf2(size),
+             "%s: DMA burst size %d is not a power of 2.", name(), size);
+    burstSize = size ? size : cacheLineSize;
+}
+
+void
+DmaPort::setBulkAccess(Tick latency, double ticks_per_byte)
+{
+    bulkLatency = latency;
+    bulkTicksPerByte = ticks_per_byte;
+}
+
 void
 DmaPort::handleRespPacket(PacketPtr pkt, Tick delay)
 {
@@ -127,7 +145,7 @@ DmaPort::handleResp(DmaReqState *state, Addr addr, Addr size, Tick delay)
 PacketPtr
 DmaPort::DmaReqState::createPacket()
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
             gen.addr(), gen.size(), flags, id);
     req->setStreamId(sid);
     req->setSubstreamId(ssid);
@@ -156,7 +174,10 @@ DmaPort::recvTimingResp(PacketPtr pkt)
 
 DmaDevice::DmaDevice(const Params &p)
     : PioDevice(p), dmaPort(this, sys, p.sid, p.ssid)
-{ }
+{
+    dmaPort.setBurstSize(p.dma_burst_size);
+    dmaPort.setBulkAccess(p.dma_bulk_latency, p.dma_bulk_bandwidth);
+}
 
 void
 DmaDevice::init()
@@ -194,10 +215,10 @@ DmaPort::dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
             event ? event->scheduled() : -1);
 
     // One DMA request sender state for every action, that is then
-    // split into many requests and packets based on the block size,
-    // i.e. cache line size.
+    // split into many requests and packets based on the burst size,
+    // by default the cache line size.
     transmitList.push_back(
-            new DmaReqState(cmd, addr, cacheLineSize, size,
+            new DmaReqState(cmd, addr, burstSize, size,
                 data, flag, requestorId, sid, ssid, event, delay));
 
     // In zero time, also initiate the sending of the packets for the request
@@ -257,6 +278,13 @@ DmaPort::trySendTimingReq()
     // and schedule the following send if it is successful
     DmaReqState *state = transmitList.front();
 
+    if (!inRetry && trySendBulkReq(state)) {
+        transmitList.pop_front();
+        if (!transmitList.empty())
+            device->schedule(sendEvent, device->clockEdge(Cycles(1)));
+        return;
+    }
+
     PacketPtr pkt = inRetry ? inRetry : state->createPacket();
     inRetry = nullptr;
 
@@ -293,6 +321,68 @@ DmaPort::trySendTimingReq()
             transmitList.size(), retryPending ? 1 : 0);
 }
 
+bool
+DmaPort::trySendBulkReq(DmaReqState *state)
+{
+    if (bulkTicksPerByte == 0 || state->gen.complete() != 0 ||
+            state->totBytes == 0) {
+        return false;
+    }
+
+    const bool is_read = MemCmd(state->cmd).isRead();
+    const AddrRange range = RangeSize(state->gen.addr(), state->totBytes);
+    auto bd_it = memBackdoors.contains(range);
+    if (bd_it == memBackdoors.end()) {
+        MemBackdoorPtr bd = nullptr;
+        sendMemBackdoorReq(MemBackdoorReq(range, is_read ?
+                    MemBackdoor::Readable : MemBackdoor::Writeable), bd);
+        if (!bd || !range.isSubset(bd->range()))
+            return false;
+        recordBackdoor(bd);
+    } else {
+        assert(range.isSubset(bd_it->second->range()));
+    }
+
+    const MemBackdoor *bd = memBackdoors.contains(range)->second;
+    if (!(is_read ? bd->readable() : bd->writeable()))
+        return false;
+
+    DPRINTF(DMA, "Handling DMA for addr: %#x size %d in bulk\n",
+            range.start(), range.size());
+
+    if (state->data) {
+        uint8_t *bd_data = bd->ptr() + (range.start() - bd->range().start());
+        if (is_read)
+            memcpy(state->data, bd_data, range.size());
+        else
+            memcpy(bd_data, state->data, range.size());
+    }
+
+    // The data has moved already, so only the time the request takes
+    // is left to model.
+    state->gen.setNext(range.end());
+    bulkBusyUntil = std::max(bulkBusyUntil, curTick()) + bulkLatency +
+        (Tick)(range.size() * bulkTicksPerByte);
+    // Requests complete in order, after the previous ones.
+    bulkList.emplace_back(bulkBusyUntil, state);
+    pendingCount++;
+    if (!bulkDoneEvent.scheduled())
+        device->schedule(bulkDoneEvent, bulkBusyUntil);
+    return true;
+}
+
+void
+DmaPort::completeBulkReqs()
+{
+    while (!bulkList.empty() && bulkList.front().first <= curTick()) {
+        DmaReqState *state = bulkList.front().second;
+        bulkList.pop_front();
+        handleResp(state, state->gen.addr(), state->totBytes);
+    }
+    if (!bulkList.empty())
+        device->schedule(bulkDoneEvent, bulkList.front().first);
+}
+
 bool
 DmaPort::sendAtomicReq(DmaReqState *state)
 {
@@ -326,20 +416,8 @@ DmaPort::sendAtomicBdReq(DmaReqState *state)
         Tick lat = sendAtomicBackdoor(pkt, bd);
 
         // If we got a backdoor, record it.
-        if (bd && memBackdoors.insert(bd->range(), bd) != memBackdoors.end()) {
-            // Invalidation callback which finds this backdoor and removes it.
-            auto callback = [this](const MemBackdoor &backdoor) {
-                for (auto it = memBackdoors.begin();
-                        it != memBackdoors.end(); it++) {
-                    if (it->second == &backdoor) {
-                        memBackdoors.erase(it);
-                        return;
-                    }
-                }
-                panic("Got invalidation for unknown memory backdoor.");
-            };
-            bd->addInvalidationCallback(callback);
-        }
+        if (bd)
+            recordBackdoor(bd);
 
         // Check if we're done now, since handleResp may delete state.
         done = !state->gen.next();
@@ -381,6 +459,26 @@ DmaPort::sendAtomicBdReq(DmaReqState *state)
     return done;
 }
 
+void
+DmaPort::recordBackdoor(MemBackdoorPtr bd)
+{
+    if (memBackdoors.insert(bd->range(), bd) == memBackdoors.end())
+        return;
+
+    // Invalidation callback which finds this backdoor and removes it.
+    auto callback = [this](const MemBackdoor &backdoor) {
+        for (auto it = memBackdoors.begin();
+                it != memBackdoors.end(); it++) {
+            if (it->second == &backdoor) {
+                memBackdoors.erase(it);
+                return;
+            }
+        }
+        panic("Got invalidation for unknown memory backdoor.");
+    };
+    bd->addInvalidationCallback(callback);
+}
+
 void
 DmaPort::sendDma()
 {
@@ -133,6 +133,21 @@ class DmaPort : public RequestPort, public Drainable
 
     /** Send the next packet from a DMA request in atomic mode. */
     bool sendAtomicReq(DmaReqState *state);
+
+    /** Remember a backdoor, and forget it when it is invalidated. */
+    void recordBackdoor(MemBackdoorPtr bd);
+
+    /**
+     * Do a whole timing mode DMA request through a memory backdoor, if
+     * bulk accesses are enabled and there is one covering it, and
+     * complete it once its modeled latency has passed.
+     *
+     * @return Whether the request was done through a backdoor.
+     */
+    bool trySendBulkReq(DmaReqState *state);
+
+    /** Complete the bulk requests whose latency has passed. */
+    void completeBulkReqs();
     /**
      * Send the next packet from a DMA request in atomic mode, and request
      * and/or use memory backdoors if possible.
@@ -189,6 +204,24 @@ class DmaPort : public RequestPort, public Drainable
 
     const Addr cacheLineSize;
 
+    /** Size of the packets DMA requests are split into. */
+    Addr burstSize;
+
+    /**
+     * Latency and ticks per byte of bulk requests, done through memory
+     * backdoors in timing mode. Bulk requests are disabled when the
+     * number of ticks per byte is 0.
+     */
+    Tick bulkLatency = 0;
+    double bulkTicksPerByte = 0;
+
+    /** When the requests done so far through backdoors are complete. */
+    Tick bulkBusyUntil = 0;
+
+    /** Bulk requests in flight, with their completion times in order. */
+    std::deque<std::pair<Tick, DmaReqState *>> bulkList;
+    EventFunctionWrapper bulkDoneEvent;
+
   protected:
 
     bool recvTimingResp(PacketPtr pkt) override;
@@ -198,6 +231,25 @@ class DmaPort : public RequestPort, public Drainable
 
     DmaPort(ClockedObject *dev, System *s, uint32_t sid=0, uint32_t ssid=0);
 
+    /**
+     * Split DMA requests into packets of up to size bytes, aligned to
+     * their size, instead of cache lines. Bursts larger than a cache
+     * line must only be used when the memory is reached without going
+     * through caches, e.g. through non-coherent crossbars to a memory
+     * controller which splits them into its own bursts.
+     */
+    void setBurstSize(Addr size);
+
+    /**
+     * Enable bulk DMA requests in timing mode: requests to memory for
+     * which a backdoor is found are done with a single copy, and
+     * complete after latency plus their size times ticks_per_byte, one
+     * after the other. This bypasses any cache, so it must only be
+     * used for memory that is only accessed by DMA while the requests
+     * are in flight.
+     */
+    void setBulkAccess(Tick latency, double ticks_per_byte);
+
     void
     dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
               uint8_t *data, Tick delay, Request::Flags flag=0);
@@ -328,8 +380,7 @@ class DmaCallback : public Drainable
     getChunkEvent()
     {
         ++count;
-        return new EventFunctionWrapper([this]{ chunkComplete(); }, name(),
-                                        true);
+        return new OneShotEvent([this]{ chunkComplete(); });
     }
 };
 
@@ -50,6 +50,12 @@ class HSAPacketProcessor(DmaVirtDevice):
     # See: https://github.com/RadeonOpenCompute/atmi/tree/master/examples/
     #      runtime/kps
     pktProcessDelay = Param.Tick(4400000, "Packet processing delay")
+    pktsPerWakeup = Param.Unsigned(
+        1,
+        "Maximum number of AQL packets dispatched from a queue each "
+        "pktProcessDelay, to amortize the processing delay over a batch of "
+        "small kernels",
+    )
     walker = Param.VegaPagetableWalker(
         VegaPagetableWalker(), "Page table walker"
     )
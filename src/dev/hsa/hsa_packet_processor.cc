@@ -76,8 +76,10 @@ HSAPP_EVENT_DESCRIPTION_GENERATOR(QueueProcessEvent)
 HSAPacketProcessor::HSAPacketProcessor(const Params &p)
     : DmaVirtDevice(p), walker(p.walker),
       numHWQueues(p.numHWQueues), pioAddr(p.pioAddr),
-      pioSize(PAGE_SIZE), pioDelay(10), pktProcessDelay(p.pktProcessDelay)
+      pioSize(PAGE_SIZE), pioDelay(10), pktProcessDelay(p.pktProcessDelay),
+      pktsPerWakeup(p.pktsPerWakeup)
 {
+    fatal_if(pktsPerWakeup == 0, "pktsPerWakeup must be at least 1");
     DPRINTF(HSAPacketProcessor, "%s:\n", __FUNCTION__);
     hwSchdlr = new HWScheduler(this, p.wakeupDelay);
     regdQList.resize(numHWQueues);
@@ -424,9 +426,9 @@ HSAPacketProcessor::processPkt(void* pkt, uint32_t rl_idx, Addr host_pkt_addr)
     return is_submitted;
 }
 
-// Wakes up every fixed time interval (pktProcessDelay) and processes a single
-// packet from the queue that scheduled this wakeup. If there are more
-// packets in that queue, the next wakeup is scheduled.
+// Wakes up every fixed time interval (pktProcessDelay) and processes up to
+// pktsPerWakeup packets from the queue that scheduled this wakeup. If there
+// are more packets in that queue, the next wakeup is scheduled.
 void
 HSAPacketProcessor::QueueProcessEvent::process()
 {
@@ -443,10 +445,7 @@ HSAPacketProcessor::QueueProcessEvent::process()
             "Dummy wakeup with barrier bit for rdIdx %d\n", rqIdx);
         return;
     }
-    // In the future, we may support batch processing of packets.
-    // Then, we can just remove the break statements and the code
-    // will support batch processing. That is why we are using a
-    // "while loop" here instead on an "if" condition.
+    unsigned num_processed = 0;
     while (hsaPP->regdQList[rqIdx]->dispPending()) {
         void *pkt = aqlRingBuffer->ptr(aqlRingBuffer->dispIdx());
         DPRINTF(HSAPacketProcessor, "%s: Attempting dispatch @ dispIdx[%d]\n",
@@ -457,6 +456,9 @@ HSAPacketProcessor::QueueProcessEvent::process()
              aqlRingBuffer->incDispIdx(1);
              DPRINTF(HSAPacketProcessor, "%s: Increment dispIdx[%d]\n",
                      __FUNCTION__, aqlRingBuffer->dispIdx());
+             if (++num_processed < hsaPP->pktsPerWakeup) {
+                 continue;
+             }
              if (hsaPP->regdQList[rqIdx]->dispPending()) {
                  hsaPP->schedAQLProcessing(rqIdx);
              }
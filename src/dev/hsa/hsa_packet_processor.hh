@@ -334,6 +334,7 @@ class HSAPacketProcessor: public DmaVirtDevice
     Addr pioSize;
     Tick pioDelay;
     const Tick pktProcessDelay;
+    const unsigned pktsPerWakeup;
 
     typedef HSAPacketProcessorParams Params;
     HSAPacketProcessor(const Params &p);
@@ -70,13 +70,8 @@ LupioBLK::LupioBLK(const Params &params) :
 void
 LupioBLK::dmaEventDone()
 {
-    int64_t _offset = lba;
-
-    if (writeOp) {
-        for (int i = 0; i < reqLen; i += SECTOR_SIZE, _offset++) {
-            image.write(&reqData[i], _offset);
-        }
-    }
+    if (writeOp)
+        image.writeSectors(reqData, lba, reqLen / SECTOR_SIZE);
 
     delete[] reqData;
     busy = false;
@@ -182,13 +177,10 @@ LupioBLK::lupioBLKCmd(void)
     // Perform transfer
     reqLen = nblk * SECTOR_SIZE;
     reqData = new uint8_t[reqLen];
-    int64_t _offset = lba;
 
     if (!writeOp) {
         // Read command (block -> mem)
-        for (int i = 0; i < reqLen; i += SECTOR_SIZE, _offset++) {
-            image.read(&reqData[i], _offset);
-        }
+        image.readSectors(reqData, lba, nblk);
         dmaWrite(mem, reqLen, &dmaEvent, reqData, 0);
     } else {
         // Write command (mem -> block)
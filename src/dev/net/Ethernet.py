@@ -89,9 +89,19 @@ class DistEtherLink(SimObject):
     sync_repeat = Param.Latency("10us", "dist sync barrier repeat")
     server_name = Param.String("localhost", "Message server name")
     server_port = Param.UInt32("2200", "Message server port")
+    shared_memory = Param.Bool(
+        False,
+        "Talk to the message server through shared memory instead of TCP, "
+        "when all gem5 processes run on the same host",
+    )
     is_switch = Param.Bool(False, "true if this a link in etherswitch")
     dist_sync_on_pseudo_op = Param.Bool(False, "Start sync with pseudo_op")
     num_nodes = Param.UInt32("2", "Number of simulate nodes")
+    adaptive_sync = Param.Bool(
+        False,
+        "Skip dist syncs while no gem5 process could send a packet, "
+        "e.g. while they are all idle",
+    )
 
 
 class EtherBus(SimObject):
@@ -84,6 +84,32 @@ DistIface::Sync::init(Tick start_tick, Tick repeat_tick)
     }
 }
 
+void
+DistIface::Sync::noteSend(Tick arrival)
+{
+    Tick prev = nextArrival.load();
+    while (arrival < prev && !nextArrival.compare_exchange_weak(prev, arrival))
+        ;
+}
+
+Tick
+DistIface::Sync::earliestSend()
+{
+    const Tick now = curTick();
+    if (!adaptive)
+        return now;
+
+    Tick earliest = nextArrival.exchange(MaxTick);
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        EventQueue *eventq = mainEventQueue[i];
+        eventq->lock();
+        if (!eventq->empty())
+            earliest = std::min(earliest, eventq->nextTick());
+        eventq->unlock();
+    }
+    return std::max(earliest, now);
+}
+
 void
 DistIface::Sync::abort()
 {
@@ -101,12 +127,17 @@ DistIface::SyncSwitch::SyncSwitch(int num_nodes)
     numExitReq = 0;
     numCkptReq = 0;
     numStopSyncReq = 0;
+    minNextSend = MaxTick;
     doExit = false;
     doCkpt = false;
     doStopSync = false;
     nextAt = std::numeric_limits<Tick>::max();
     nextRepeat = std::numeric_limits<Tick>::max();
     isAbort = false;
+    adaptive = false;
+    localNextSend = 0;
+    nextSendAt = 0;
+    nextArrival = MaxTick;
 }
 
 DistIface::SyncNode::SyncNode()
@@ -121,6 +152,10 @@ DistIface::SyncNode::SyncNode()
     nextAt = std::numeric_limits<Tick>::max();
     nextRepeat = std::numeric_limits<Tick>::max();
     isAbort = false;
+    adaptive = false;
+    localNextSend = 0;
+    nextSendAt = 0;
+    nextArrival = MaxTick;
 }
 
 bool
@@ -135,6 +170,8 @@ DistIface::SyncNode::run(bool same_tick)
     // initiate the global synchronisation
     header.msgType = MsgType::cmdSyncReq;
     header.sendTick = curTick();
+    header.nextSendTick = std::max(localNextSend, curTick());
+    localNextSend = 0;
     header.syncRepeat = nextRepeat;
     header.needCkpt = needCkpt;
     header.needStopSync = needStopSync;
@@ -171,8 +208,12 @@ DistIface::SyncSwitch::run(bool same_tick)
     assert(!same_tick || (nextAt == curTick()));
     waitNum = numNodes;
     // Complete the global synchronisation
+    nextSendAt = std::min(minNextSend, std::max(localNextSend, curTick()));
+    minNextSend = MaxTick;
+    localNextSend = 0;
     header.msgType = MsgType::cmdSyncAck;
     header.sendTick = nextAt;
+    header.nextSendTick = nextSendAt;
     header.syncRepeat = nextRepeat;
     if (doCkpt || numCkptReq == numNodes) {
         doCkpt = true;
@@ -200,6 +241,7 @@ DistIface::SyncSwitch::run(bool same_tick)
 
 bool
 DistIface::SyncSwitch::progress(Tick send_tick,
+                                 Tick next_send,
                                  Tick sync_repeat,
                                  ReqType need_ckpt,
                                  ReqType need_exit,
@@ -212,6 +254,8 @@ DistIface::SyncSwitch::progress(Tick send_tick,
 
     if (send_tick > nextAt)
         nextAt = send_tick;
+    if (next_send < minNextSend)
+        minNextSend = next_send;
     if (nextRepeat > sync_repeat)
         nextRepeat = sync_repeat;
 
@@ -241,6 +285,7 @@ DistIface::SyncSwitch::progress(Tick send_tick,
 
 bool
 DistIface::SyncNode::progress(Tick max_send_tick,
+                               Tick next_send,
                                Tick next_repeat,
                                ReqType do_ckpt,
                                ReqType do_exit,
@@ -252,6 +297,7 @@ DistIface::SyncNode::progress(Tick max_send_tick,
     assert(waitNum > 0);
 
     nextAt = max_send_tick;
+    nextSendAt = next_send;
     nextRepeat = next_repeat;
     doCkpt = (do_ckpt != ReqType::none);
     doExit = (do_exit != ReqType::none);
@@ -392,6 +438,7 @@ DistIface::SyncEvent::process()
      */
     {
         EventQueue::ScopedRelease sr(curEventQueue());
+        DistIface::sync->localNextSend = DistIface::sync->earliestSend();
         // we do a global sync here that is supposed to happen at the same
         // tick in all gem5 peers
         if (!DistIface::sync->run(true))
@@ -425,7 +472,17 @@ DistIface::SyncEvent::process()
     }
     // schedule the next periodic sync
     repeat = DistIface::sync->nextRepeat;
-    schedule(curTick() + repeat);
+    // No packet is sent before the earliest send tick the peers agreed
+    // on, and it takes at least a sync interval (which is not longer than
+    // the link delay) to arrive, so the syncs in between can be skipped.
+    // Without adaptive sync, the earliest send tick is the current one.
+    Tick next_send = std::max(DistIface::sync->nextSendAt, curTick());
+    next_send = std::min(next_send, MaxTick - repeat);
+    if (next_send > curTick()) {
+        DPRINTF(DistEthernet, "Skipping dist syncs until %lu\n",
+                next_send + repeat);
+    }
+    schedule(next_send + repeat);
 }
 
 void
@@ -608,8 +665,8 @@ DistIface::DistIface(unsigned dist_rank,
                      Tick sync_repeat,
                      EventManager *em,
                      bool use_pseudo_op,
-                     bool is_switch, int num_nodes) :
-    syncStart(sync_start), syncRepeat(sync_repeat),
+                     bool is_switch, int num_nodes, bool adaptive_sync) :
+    syncStart(sync_start), syncRepeat(sync_repeat), linkDelay(0),
     recvThread(nullptr), recvScheduler(em), syncStartOnPseudoOp(use_pseudo_op),
     rank(dist_rank), size(dist_size)
 {
@@ -623,6 +680,7 @@ DistIface::DistIface(unsigned dist_rank,
             sync = new SyncSwitch(num_nodes);
         else
             sync = new SyncNode();
+        sync->adaptive = adaptive_sync;
         syncEvent = new SyncEvent();
         primary = this;
         isPrimary = true;
@@ -662,6 +720,7 @@ DistIface::packetOut(EthPacketPtr pkt, Tick send_delay)
 
     // Send out the packet and the meta info.
     sendPacket(header, pkt);
+    sync->noteSend(curTick() + send_delay + linkDelay);
 
     DPRINTF(DistEthernetPkt,
             "DistIface::sendDataPacket() done size:%d send_delay:%llu\n",
@@ -704,6 +763,7 @@ DistIface::recvThreadFunc(Event *recv_done, Tick link_delay)
         } else {
             // everything else must be synchronisation related command
             if (!sync->progress(header.sendTick,
+                                header.nextSendTick,
                                 header.syncRepeat,
                                 header.needCkpt,
                                 header.needExit,
@@ -788,6 +848,7 @@ DistIface::init(const Event *done_event, Tick link_delay)
     // Init hook for the underlaying message transport to setup/finalize
     // communication channels
     initTransport();
+    linkDelay = link_delay;
 
     // Spawn a new receiver thread that will process messages
     // coming in from peer gem5 processes.
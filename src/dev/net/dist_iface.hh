@@ -76,6 +76,7 @@
 #define __DEV_DIST_IFACE_HH__
 
 #include <array>
+#include <atomic>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -157,7 +158,27 @@ class DistIface : public Drainable, public Serializable
          *  Flag is set if the sync is aborted (e.g. due to connection lost)
          */
         bool isAbort;
+        /**
+         * Flag is set if the sync interval adapts to the network traffic
+         */
+        bool adaptive;
+        /**
+         * Earliest tick this process could send a packet at, announced in
+         * the next sync (zero for the current tick)
+         */
+        Tick localNextSend;
+        /**
+         * Earliest tick any process could send a packet at, agreed on in
+         * the last sync
+         */
+        Tick nextSendAt;
+        /**
+         * Earliest arrival tick of the packets sent since the last
+         * periodic sync
+         */
+        std::atomic<Tick> nextArrival;
 
+        friend class DistIface;
         friend class SyncEvent;
 
       public:
@@ -169,6 +190,19 @@ class DistIface : public Drainable, public Serializable
          *
          */
         void init(Tick start, Tick repeat);
+        /**
+         * Record a packet sent to a peer.
+         *
+         * @param arrival The tick the packet arrives at the peer.
+         */
+        void noteSend(Tick arrival);
+        /**
+         * The earliest tick this process could send a packet at, or make
+         * one arrive at a peer, if it doesn't receive any. This is the
+         * tick of the next event in its event queues, unless some packet
+         * it sent arrives earlier.
+         */
+        Tick earliestSend();
         /**
          *  Core method to perform a full dist sync.
          *
@@ -182,6 +216,7 @@ class DistIface : public Drainable, public Serializable
          * simulation is to exit)
          */
         virtual bool progress(Tick send_tick,
+                              Tick next_send,
                               Tick next_repeat,
                               ReqType do_ckpt,
                               ReqType do_exit,
@@ -224,6 +259,7 @@ class DistIface : public Drainable, public Serializable
         ~SyncNode() {}
         bool run(bool same_tick) override;
         bool progress(Tick max_req_tick,
+                      Tick next_send,
                       Tick next_repeat,
                       ReqType do_ckpt,
                       ReqType do_exit,
@@ -256,6 +292,10 @@ class DistIface : public Drainable, public Serializable
          *  Number of connected simulated nodes
          */
         unsigned numNodes;
+        /**
+         * Minimum of the next send ticks of the nodes in the on-going sync
+         */
+        Tick minNextSend;
 
       public:
         SyncSwitch(int num_nodes);
@@ -263,6 +303,7 @@ class DistIface : public Drainable, public Serializable
 
         bool run(bool same_tick) override;
         bool progress(Tick max_req_tick,
+                      Tick next_send,
                       Tick next_repeat,
                       ReqType do_ckpt,
                       ReqType do_exit,
@@ -461,6 +502,10 @@ class DistIface : public Drainable, public Serializable
      * Frequency of dist sync events in ticks.
      */
     Tick syncRepeat;
+    /**
+     * Delay of the simulated link, the least time a packet takes.
+     */
+    Tick linkDelay;
     /**
      * Receiver thread pointer.
      * Each DistIface object must have exactly one receiver thread.
@@ -572,6 +617,7 @@ class DistIface : public Drainable, public Serializable
      * @param sync_start Start tick for dist synchronisation
      * @param sync_repeat Frequency for dist synchronisation
      * @param em The event manager associated with the simulated Ethernet link
+     * @param adaptive_sync Skip the syncs while no packet could be sent
      */
     DistIface(unsigned dist_rank,
               unsigned dist_size,
@@ -580,7 +626,8 @@ class DistIface : public Drainable, public Serializable
               EventManager *em,
               bool use_pseudo_op,
               bool is_switch,
-              int num_nodes);
+              int num_nodes,
+              bool adaptive_sync);
 
     virtual ~DistIface();
     /**
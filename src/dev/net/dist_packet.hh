@@ -87,6 +87,11 @@ class DistHeaderPkt
          */
         MsgType msgType;
         Tick sendTick;
+        /**
+         * Earliest tick the sender could send a data packet at, or make
+         * one arrive at, after a sync (used by sync messages).
+         */
+        Tick nextSendTick;
         /**
          * Length used for modeling timing in the simulator.
          * (from EthPacketData::simLength).
@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory based interface class implementation for dist-gem5 runs.
+ */
+
+#include "dev/net/shm_iface.hh"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/DistEthernet.hh"
+#include "debug/DistEthernetCmd.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+/**
+ * A single producer, single consumer ring buffer of bytes. The head and
+ * tail count all the bytes ever written and read, and each side waits
+ * for the other one on a sequence number which is bumped whenever it
+ * moves.
+ */
+struct ShmIface::Ring
+{
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+    /** Bumped when data is written, for the reader to wait on */
+    alignas(64) std::atomic<uint32_t> dataSeq;
+    std::atomic<uint32_t> readerWaiting;
+    /** Bumped when data is read, for the writer to wait on */
+    alignas(64) std::atomic<uint32_t> spaceSeq;
+    std::atomic<uint32_t> writerWaiting;
+    /** Set when one of the ends goes away */
+    std::atomic<uint32_t> closed;
+};
+
+/** The start of the shared memory segment of a link */
+struct ShmIface::Segment
+{
+    std::atomic<uint32_t> nodeReady;
+    std::atomic<uint32_t> switchReady;
+    uint32_t rank;
+    uint32_t nodeIfaceId;
+    uint32_t nodeIfaceNum;
+    uint32_t switchIfaceId;
+    int32_t nodePid;
+    int32_t switchPid;
+    uint64_t ringSize;
+    Ring toSwitch;
+    Ring toNode;
+};
+
+namespace
+{
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+              std::atomic<uint32_t>::is_always_lock_free,
+              "Shared memory rings need lock free atomics");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "Futexes need plain 32 bit words");
+
+/** Number of times to poll a ring before sleeping on it */
+const int spinCount = 1000;
+
+bool
+alive(pid_t pid)
+{
+    return pid <= 0 || kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+/** Sleep until word changes from val, or for a bit */
+void
+waitWord(std::atomic<uint32_t> &word, uint32_t val)
+{
+#ifdef __linux__
+    struct timespec timeout = { 0, 1000000 };
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT,
+            val, &timeout, nullptr, 0);
+#else
+    usleep(100);
+#endif
+}
+
+void
+wakeWord(std::atomic<uint32_t> &word)
+{
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE,
+            1, nullptr, nullptr, 0);
+#endif
+}
+
+/**
+ * Wait until ready() returns true, spinning at first and then sleeping
+ * on seq.
+ *
+ * @return False if the ring was closed or the peer died first.
+ */
+template <typename Ready>
+bool
+waitRing(std::atomic<uint32_t> &closed, std::atomic<uint32_t> &seq,
+         std::atomic<uint32_t> &waiting, pid_t peer, Ready ready)
+{
+    for (int i = 0; i < spinCount; i++) {
+        if (ready())
+            return true;
+    }
+
+    for (;;) {
+        const uint32_t val = seq.load();
+        if (ready())
+            return true;
+        if (closed.load() || !alive(peer))
+            return false;
+        // The other end wakes us up if it sees the flag, or has already
+        // changed seq if we don't see what it did.
+        waiting.store(1);
+        if (!ready())
+            waitWord(seq, val);
+        waiting.store(0);
+    }
+}
+
+} // anonymous namespace
+
+std::vector<ShmIface *> ShmIface::ifaceRegistry;
+
+ShmIface::ShmIface(unsigned server_port,
+                   unsigned dist_rank, unsigned dist_size,
+                   Tick sync_start, Tick sync_repeat,
+                   EventManager *em, bool use_pseudo_op, bool is_switch,
+                   int num_nodes, bool adaptive_sync) :
+    DistIface(dist_rank, dist_size, sync_start, sync_repeat, em, use_pseudo_op,
+              is_switch, num_nodes, adaptive_sync), serverPort(server_port),
+    isSwitch(is_switch), segment(nullptr), segSize(0),
+    txRing(nullptr), rxRing(nullptr), txData(nullptr), rxData(nullptr),
+    peerPid(0)
+{
+}
+
+ShmIface::~ShmIface()
+{
+    if (!segment)
+        return;
+
+    for (Ring *ring : { txRing, rxRing }) {
+        ring->closed.store(1);
+        ring->dataSeq++;
+        ring->spaceSeq++;
+        wakeWord(ring->dataSeq);
+        wakeWord(ring->spaceSeq);
+    }
+    munmap(segment, segSize);
+}
+
+void
+ShmIface::mapSegment(int fd, size_t size)
+{
+    void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, 0);
+    panic_if(addr == MAP_FAILED, "mmap() failed: %s", strerror(errno));
+    segment = static_cast<Segment *>(addr);
+    segSize = size;
+}
+
+void
+ShmIface::establishConnection()
+{
+    static unsigned cur_rank = 0;
+    static unsigned cur_id = 0;
+
+    const size_t data_offset = (sizeof(Segment) + 63) & ~size_t(63);
+    const size_t size = data_offset + 2 * RingSize;
+
+    if (isSwitch) {
+        segName = csprintf("/gem5-dist-%d-%d-%d", serverPort, cur_rank,
+                           cur_id);
+        DPRINTF(DistEthernet, "Waiting for %s\n", segName);
+        // Poll until the node has set up the segment, mapping it again
+        // every time in case it replaced a stale one.
+        for (;;) {
+            int fd = shm_open(segName.c_str(), O_RDWR, 0);
+            if (fd >= 0) {
+                struct stat st;
+                if (fstat(fd, &st) == 0 && (size_t)st.st_size == size)
+                    mapSegment(fd, size);
+                close(fd);
+            }
+            if (segment) {
+                if (segment->nodeReady.load() && alive(segment->nodePid))
+                    break;
+                munmap(segment, segSize);
+                segment = nullptr;
+            }
+            usleep(1000);
+        }
+
+        panic_if(segment->ringSize != RingSize,
+                 "Shared memory ring sizes don't match");
+        assert(segment->rank == cur_rank);
+        assert(segment->nodeIfaceId == cur_id);
+        inform("Link okay  (iface:%d -> (node:%d, iface:%d))",
+               distIfaceId, segment->rank, segment->nodeIfaceId);
+        if (segment->nodeIfaceId < segment->nodeIfaceNum - 1) {
+            cur_id++;
+        } else {
+            cur_rank++;
+            cur_id = 0;
+        }
+
+        txRing = &segment->toNode;
+        rxRing = &segment->toSwitch;
+        txData = (uint8_t *)segment + data_offset + RingSize;
+        rxData = (uint8_t *)segment + data_offset;
+        peerPid = segment->nodePid;
+
+        // send ack
+        segment->switchIfaceId = distIfaceId;
+        segment->switchPid = getpid();
+        segment->switchReady.store(1);
+        // Both ends have the segment mapped, so it doesn't need a name
+        // any more.
+        shm_unlink(segName.c_str());
+    } else { // this is not a switch
+        segName = csprintf("/gem5-dist-%d-%d-%d", serverPort, rank,
+                           distIfaceId);
+        shm_unlink(segName.c_str());
+        int fd = shm_open(segName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        panic_if(fd < 0, "shm_open() failed: %s", strerror(errno));
+        panic_if(ftruncate(fd, size) < 0, "ftruncate() failed: %s",
+                 strerror(errno));
+        mapSegment(fd, size);
+        close(fd);
+
+        txRing = &segment->toSwitch;
+        rxRing = &segment->toNode;
+        txData = (uint8_t *)segment + data_offset;
+        rxData = (uint8_t *)segment + data_offset + RingSize;
+
+        // send link info
+        segment->rank = rank;
+        segment->nodeIfaceId = distIfaceId;
+        segment->nodeIfaceNum = distIfaceNum;
+        segment->nodePid = getpid();
+        segment->ringSize = RingSize;
+        segment->nodeReady.store(1);
+        DPRINTF(DistEthernet, "Created %s, waiting for ack "
+                "(distIfaceId:%d)\n", segName, distIfaceId);
+        while (!segment->switchReady.load())
+            usleep(1000);
+        peerPid = segment->switchPid;
+        inform("Link okay  (iface:%d -> switch iface:%d)", distIfaceId,
+               segment->switchIfaceId);
+    }
+    ifaceRegistry.push_back(this);
+}
+
+void
+ShmIface::send(const void *buf, size_t length)
+{
+    const uint8_t *src = static_cast<const uint8_t *>(buf);
+    while (length > 0) {
+        const uint64_t head = txRing->head.load();
+        const bool ok = waitRing(txRing->closed, txRing->spaceSeq,
+                txRing->writerWaiting, peerPid,
+                [&]() { return head - txRing->tail.load() < RingSize; });
+        if (!ok) {
+            exitSimLoop("Message server closed connection, simulation "
+                        "is exiting");
+            return;
+        }
+
+        const uint64_t room = RingSize - (head - txRing->tail.load());
+        const size_t chunk = std::min<uint64_t>(
+                { length, room, RingSize - head % RingSize });
+        memcpy(txData + head % RingSize, src, chunk);
+        txRing->head.store(head + chunk);
+        txRing->dataSeq++;
+        if (txRing->readerWaiting.load())
+            wakeWord(txRing->dataSeq);
+
+        src += chunk;
+        length -= chunk;
+    }
+}
+
+bool
+ShmIface::recv(void *buf, size_t length)
+{
+    uint8_t *dst = static_cast<uint8_t *>(buf);
+    while (length > 0) {
+        const uint64_t tail = rxRing->tail.load();
+        const bool ok = waitRing(rxRing->closed, rxRing->dataSeq,
+                rxRing->readerWaiting, peerPid,
+                [&]() { return rxRing->head.load() != tail; });
+        if (!ok) {
+            inform("recv(): Connection closed");
+            return false;
+        }
+
+        const uint64_t avail = rxRing->head.load() - tail;
+        const size_t chunk = std::min<uint64_t>(
+                { length, avail, RingSize - tail % RingSize });
+        memcpy(dst, rxData + tail % RingSize, chunk);
+        rxRing->tail.store(tail + chunk);
+        rxRing->spaceSeq++;
+        if (rxRing->writerWaiting.load())
+            wakeWord(rxRing->spaceSeq);
+
+        dst += chunk;
+        length -= chunk;
+    }
+    return true;
+}
+
+void
+ShmIface::sendPacket(const Header &header, const EthPacketPtr &packet)
+{
+    std::lock_guard<std::mutex> lock(txLock);
+    send(&header, sizeof(header));
+    send(packet->data, packet->length);
+}
+
+void
+ShmIface::sendCmd(const Header &header)
+{
+    DPRINTF(DistEthernetCmd, "ShmIface::sendCmd() type: %d\n",
+            static_cast<int>(header.msgType));
+    // Global commands (i.e. sync request) are always sent by the primary
+    // DistIface, to all the links of this process.
+    for (auto iface: ifaceRegistry) {
+        std::lock_guard<std::mutex> lock(iface->txLock);
+        iface->send(&header, sizeof(header));
+    }
+}
+
+bool
+ShmIface::recvHeader(Header &header)
+{
+    bool ret = recv(&header, sizeof(header));
+    DPRINTF(DistEthernetCmd, "ShmIface::recvHeader() type: %d ret: %d\n",
+            static_cast<int>(header.msgType), ret);
+    return ret;
+}
+
+void
+ShmIface::recvPacket(const Header &header, EthPacketPtr &packet)
+{
+    packet = std::make_shared<EthPacketData>(header.dataPacketLength);
+    bool ret = recv(packet->data, header.dataPacketLength);
+    panic_if(!ret, "Error while reading shared memory link");
+    packet->simLength = header.simLength;
+    packet->length = header.dataPacketLength;
+}
+
+void
+ShmIface::initTransport()
+{
+    // As with TCPIface, the links are set up in the init phase, when the
+    // number of dist interfaces in each process is known.
+    establishConnection();
+}
+
+} // namespace gem5
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory based interface class for dist-gem5 runs.
+ *
+ * For a high level description about dist-gem5 see comments in
+ * header file dist_iface.hh.
+ *
+ * This is an alternative to TCPIface for gem5 processes running on the
+ * same host as the server (the gem5 process which simulates the switch
+ * box). Each link between a compute node and the server is a shared
+ * memory segment holding a lock free ring buffer in each direction, so
+ * messages and synchronisation don't go through the network stack.
+ */
+#ifndef __DEV_NET_SHM_IFACE_HH__
+#define __DEV_NET_SHM_IFACE_HH__
+
+#include <sys/types.h>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dev/net/dist_iface.hh"
+
+namespace gem5
+{
+
+class EventManager;
+
+class ShmIface : public DistIface
+{
+  private:
+    struct Ring;
+    struct Segment;
+
+    /** Size of the ring buffer in each direction */
+    static const size_t RingSize = 4 << 20;
+
+    /** Port number of the server, which names the segments */
+    int serverPort;
+
+    bool isSwitch;
+
+    std::string segName;
+    Segment *segment;
+    size_t segSize;
+
+    /** Ring buffers to and from the remote end */
+    Ring *txRing;
+    Ring *rxRing;
+    uint8_t *txData;
+    uint8_t *rxData;
+
+    /** Process at the remote end */
+    pid_t peerPid;
+
+    /** Serialises the messages sent by different threads */
+    std::mutex txLock;
+
+    /**
+     * All the interfaces of this process, which commands are sent
+     * through.
+     */
+    static std::vector<ShmIface *> ifaceRegistry;
+
+  private:
+    /**
+     * Send out a message through the ring buffer to the remote end,
+     * waiting for room in it as necessary.
+     *
+     * @param buf Start address of the message.
+     * @param length Size of the message in bytes.
+     */
+    void send(const void *buf, size_t length);
+
+    /**
+     * Receive the next incoming message, waiting for it as necessary.
+     *
+     * @param buf Start address of buffer to store the message.
+     * @param length Exact size of the expected message in bytes.
+     * @return False if the remote end went away.
+     */
+    bool recv(void *buf, size_t length);
+
+    void mapSegment(int fd, size_t size);
+    void establishConnection();
+
+  protected:
+
+    void sendPacket(const Header &header,
+                    const EthPacketPtr &packet) override;
+
+    void sendCmd(const Header &header) override;
+
+    bool recvHeader(Header &header) override;
+
+    void recvPacket(const Header &header, EthPacketPtr &packet) override;
+
+    void initTransport() override;
+
+  public:
+    /**
+     * @param server_port The port number the server would listen to with
+     * TCPIface, which tells the segments of different runs apart.
+     * @param sync_start The tick for the first dist synchronisation.
+     * @param sync_repeat The frequency of dist synchronisation.
+     * @param em The EventManager object associated with the simulated
+     * Ethernet link.
+     */
+    ShmIface(unsigned server_port,
+             unsigned dist_rank, unsigned dist_size,
+             Tick sync_start, Tick sync_repeat, EventManager *em,
+             bool use_pseudo_op, bool is_switch, int num_nodes,
+             bool adaptive_sync);
+
+    ~ShmIface() override;
+};
+
+} // namespace gem5
+
+#endif // __DEV_NET_SHM_IFACE_HH__
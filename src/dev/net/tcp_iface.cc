@@ -83,9 +83,9 @@ TCPIface::TCPIface(std::string server_name, unsigned server_port,
                    unsigned dist_rank, unsigned dist_size,
                    Tick sync_start, Tick sync_repeat,
                    EventManager *em, bool use_pseudo_op, bool is_switch,
-                   int num_nodes) :
+                   int num_nodes, bool adaptive_sync) :
     DistIface(dist_rank, dist_size, sync_start, sync_repeat, em, use_pseudo_op,
-              is_switch, num_nodes), serverName(server_name),
+              is_switch, num_nodes, adaptive_sync), serverName(server_name),
     serverPort(server_port), isSwitch(is_switch), listening(false)
 {
     if (is_switch && isPrimary) {
@@ -226,6 +226,7 @@ BasePixelPump::renderPixels()
 
     Pixel pixel(0, 0, 0);
     const Pixel underrun_pixel(0, 0, 0);
+    bool changed = false;
     for (; _posX < x_end && !_underrun; ++_posX) {
         if (!nextPixel(pixel)) {
             warn("Input buffer underrun in BasePixelPump (%u, %u)\n",
@@ -234,13 +235,21 @@ BasePixelPump::renderPixels()
             onUnderrun(_posX, pos_y);
             pixel = underrun_pixel;
         }
-        fb.pixel(_posX, pos_y) = pixel;
+        Pixel &dst = fb.pixel(_posX, pos_y);
+        changed |= !(dst == pixel);
+        dst = pixel;
     }
 
     // Fill remaining pixels with a dummy pixel value if we ran out of
     // data
-    for (; _posX < x_end; ++_posX)
-        fb.pixel(_posX, pos_y) = underrun_pixel;
+    for (; _posX < x_end; ++_posX) {
+        Pixel &dst = fb.pixel(_posX, pos_y);
+        changed |= !(dst == underrun_pixel);
+        dst = underrun_pixel;
+    }
+
+    if (changed)
+        fb.markDirty(pos_y);
 
     // Schedule a new event to handle the next block of pixels
     if (_posX < _timings.width) {
@@ -289,9 +298,10 @@ BasePixelPump::renderLine()
     const unsigned pos_y = posY();
     const size_t _width = fb.width();
 
-    auto pixel_it = fb.pixels.begin() + _width * pos_y;
-    panic_if(nextLine(pixel_it, _width) != _width,
+    lineBuffer.resize(_width);
+    panic_if(nextLine(lineBuffer.begin(), _width) != _width,
             "Unexpected underrun in BasePixelPump (%u, %u)", _width, pos_y);
+    fb.updateLine(pos_y, lineBuffer.data());
 }
 
 
@@ -341,6 +341,9 @@ class BasePixelPump
     /** Fast and event-free line rendering function */
     void renderLine();
 
+    /** Scratch buffer for renderLine() */
+    std::vector<Pixel> lineBuffer;
+
     /** Convenience vector when doing operations on all events */
     std::vector<PixelEvent *> pixelEvents;
 
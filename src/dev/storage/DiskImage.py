@@ -50,3 +50,13 @@ class CowDiskImage(DiskImage):
     child = Param.DiskImage(RawDiskImage(read_only=True), "child image")
     table_size = Param.Int(65536, "initial table size")
     image_file = ""
+
+
+class MappedCowDiskImage(DiskImage):
+    type = "MappedCowDiskImage"
+    cxx_header = "dev/storage/disk_image.hh"
+    cxx_class = "gem5::MappedCowDiskImage"
+    child = Param.DiskImage(RawDiskImage(read_only=True), "child image")
+    image_file = Param.String(
+        "overlay file, created if it doesn't exist and kept afterwards"
+    )
@@ -32,14 +32,25 @@
 
 #include "dev/storage/disk_image.hh"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
+
+#include <algorithm>
 #include <cerrno>
+#include <climits>
 #include <cstring>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "base/callback.hh"
 #include "base/logging.hh"
@@ -53,6 +64,91 @@
 namespace gem5
 {
 
+namespace
+{
+
+size_t
+iovecsSize(const struct iovec *iov, int iovcnt)
+{
+    size_t size = 0;
+    for (int i = 0; i < iovcnt; i++)
+        size += iov[i].iov_len;
+    return size;
+}
+
+/** The part of a set of buffers len bytes long, starting at pos */
+std::vector<struct iovec>
+sliceIovecs(const struct iovec *iov, int iovcnt, size_t pos, size_t len)
+{
+    std::vector<struct iovec> slice;
+    for (int i = 0; i < iovcnt && len > 0; i++) {
+        if (pos >= iov[i].iov_len) {
+            pos -= iov[i].iov_len;
+            continue;
+        }
+        const size_t chunk = std::min(len, iov[i].iov_len - pos);
+        slice.push_back({static_cast<uint8_t *>(iov[i].iov_base) + pos,
+                chunk});
+        len -= chunk;
+        pos = 0;
+    }
+    return slice;
+}
+
+/** Copy len bytes between data and position pos of a set of buffers */
+void
+copyIovecs(const struct iovec *iov, int iovcnt, size_t pos,
+        uint8_t *data, size_t len, bool to_iovecs)
+{
+    for (const auto &part: sliceIovecs(iov, iovcnt, pos, len)) {
+        if (to_iovecs)
+            memcpy(part.iov_base, data, part.iov_len);
+        else
+            memcpy(data, part.iov_base, part.iov_len);
+        data += part.iov_len;
+    }
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////
+//
+// Disk image
+//
+std::streamsize
+DiskImage::readSectors(const struct iovec *iov, int iovcnt,
+                       std::streampos offset) const
+{
+    const size_t total = iovecsSize(iov, iovcnt);
+    panic_if(total % SectorSize, "Disk image accesses must be whole sectors");
+
+    uint8_t sector[SectorSize];
+    std::streamsize done = 0;
+    for (; done < total; done += SectorSize) {
+        if (read(sector, offset + done / SectorSize) != SectorSize)
+            break;
+        copyIovecs(iov, iovcnt, done, sector, SectorSize, true);
+    }
+    return done;
+}
+
+std::streamsize
+DiskImage::writeSectors(const struct iovec *iov, int iovcnt,
+                        std::streampos offset)
+{
+    const size_t total = iovecsSize(iov, iovcnt);
+    panic_if(total % SectorSize, "Disk image accesses must be whole sectors");
+
+    uint8_t sector[SectorSize];
+    std::streamsize done = 0;
+    for (; done < total; done += SectorSize) {
+        copyIovecs(iov, iovcnt, done, sector, SectorSize, false);
+        if (write(sector, offset + done / SectorSize) != SectorSize)
+            break;
+    }
+    return done;
+}
+
 ////////////////////////////////////////////////////////////////////////
 //
 // Raw Disk image
@@ -87,11 +183,8 @@ RawDiskImage::open(const std::string &filename, bool rd_only)
         readonly = rd_only;
         file = filename;
 
-        std::ios::openmode mode = std::ios::in | std::ios::binary;
-        if (!readonly)
-            mode |= std::ios::out;
-        stream.open(file.c_str(), mode);
-        if (!stream.is_open())
+        fd = ::open(file.c_str(), readonly ? O_RDONLY : O_RDWR);
+        if (fd < 0)
             panic("Error opening %s", filename);
     }
 }
@@ -99,17 +192,18 @@ RawDiskImage::open(const std::string &filename, bool rd_only)
 void
 RawDiskImage::close()
 {
-    stream.close();
+    if (fd >= 0)
+        ::close(fd);
+    fd = -1;
 }
 
 std::streampos
 RawDiskImage::size() const
 {
     if (disk_size == 0) {
-        if (!stream.is_open())
+        if (fd < 0)
             panic("file not open!\n");
-        stream.seekg(0, std::ios::end);
-        disk_size = stream.tellg();
+        disk_size = lseek(fd, 0, SEEK_END);
     }
 
     return disk_size / SectorSize;
@@ -117,28 +211,55 @@ RawDiskImage::size() const
 
 std::streampos
 RawDiskImage::read(uint8_t *data, std::streampos offset) const
+{
+    return readSectors(data, offset, 1);
+}
+
+std::streampos
+RawDiskImage::write(const uint8_t *data, std::streampos offset)
+{
+    return writeSectors(data, offset, 1);
+}
+
+std::streamsize
+RawDiskImage::readSectors(const struct iovec *iov, int iovcnt,
+                          std::streampos offset) const
 {
     if (!initialized)
         panic("RawDiskImage not initialized");
 
-    if (!stream.is_open())
+    if (fd < 0)
         panic("file not open!\n");
 
-    stream.seekg(offset * SectorSize, std::ios::beg);
-    if (!stream.good())
-        panic("Could not seek to location in file");
-
-    std::streampos pos = stream.tellg();
-    stream.read((char *)data, SectorSize);
+    const size_t total = iovecsSize(iov, iovcnt);
+    panic_if(total % SectorSize, "Disk image accesses must be whole sectors");
+
+    const off_t pos = std::streamoff(offset) * SectorSize;
+    size_t done = 0;
+    while (done < total) {
+        auto parts = sliceIovecs(iov, iovcnt, done, total - done);
+        const ssize_t bytes = preadv(fd, parts.data(),
+                std::min<size_t>(parts.size(), IOV_MAX), pos + done);
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        if (bytes <= 0)
+            break;
+        done += bytes;
+    }
 
-    DPRINTF(DiskImageRead, "read: offset=%d\n", (uint64_t)offset);
-    DDUMP(DiskImageRead, data, SectorSize);
+    DPRINTF(DiskImageRead, "read: offset=%d count=%d\n", (uint64_t)offset,
+            total / SectorSize);
+    if (debug::DiskImageRead) {
+        for (const auto &part: sliceIovecs(iov, iovcnt, 0, done))
+            DDUMP(DiskImageRead, (uint8_t *)part.iov_base, part.iov_len);
+    }
 
-    return stream.tellg() - pos;
+    return done;
 }
 
-std::streampos
-RawDiskImage::write(const uint8_t *data, std::streampos offset)
+std::streamsize
+RawDiskImage::writeSectors(const struct iovec *iov, int iovcnt,
+                           std::streampos offset)
 {
     if (!initialized)
         panic("RawDiskImage not initialized");
@@ -146,19 +267,32 @@ RawDiskImage::write(const uint8_t *data, std::streampos offset)
     if (readonly)
         panic("Cannot write to a read only disk image");
 
-    if (!stream.is_open())
+    if (fd < 0)
         panic("file not open!\n");
 
-    stream.seekp(offset * SectorSize, std::ios::beg);
-    if (!stream.good())
-        panic("Could not seek to location in file");
+    const size_t total = iovecsSize(iov, iovcnt);
+    panic_if(total % SectorSize, "Disk image accesses must be whole sectors");
 
-    DPRINTF(DiskImageWrite, "write: offset=%d\n", (uint64_t)offset);
-    DDUMP(DiskImageWrite, data, SectorSize);
+    DPRINTF(DiskImageWrite, "write: offset=%d count=%d\n", (uint64_t)offset,
+            total / SectorSize);
+    if (debug::DiskImageWrite) {
+        for (const auto &part: sliceIovecs(iov, iovcnt, 0, total))
+            DDUMP(DiskImageWrite, (uint8_t *)part.iov_base, part.iov_len);
+    }
 
-    std::streampos pos = stream.tellp();
-    stream.write((const char *)data, SectorSize);
-    return stream.tellp() - pos;
+    const off_t pos = std::streamoff(offset) * SectorSize;
+    size_t done = 0;
+    while (done < total) {
+        auto parts = sliceIovecs(iov, iovcnt, done, total - done);
+        const ssize_t bytes = pwritev(fd, parts.data(),
+                std::min<size_t>(parts.size(), IOV_MAX), pos + done);
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        if (bytes <= 0)
+            break;
+        done += bytes;
+    }
+    return done;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -169,7 +303,8 @@ const uint32_t CowDiskImage::VersionMajor = 1;
 const uint32_t CowDiskImage::VersionMinor = 0;
 
 CowDiskImage::CowDiskImage(const Params &p)
-    : DiskImage(p), filename(p.image_file), child(p.child), table(NULL)
+    : DiskImage(p), filename(p.image_file), child(p.child), table(NULL),
+      hostMem(name())
 {
     if (filename.empty()) {
         initSectorTable(p.table_size);
@@ -270,6 +405,7 @@ CowDiskImage::open(const std::string &file)
 
         Sector *sector = new Sector;
         SafeRead(stream, sector, sizeof(Sector));
+        hostMem.add(sizeof(Sector));
 
         assert(table->find(offset) == table->end());
         (*table)[offset] = sector;
@@ -410,6 +546,7 @@ CowDiskImage::write(const uint8_t *data, std::streampos offset)
     if (i == table->end()) {
         Sector *sector = new Sector;
         memcpy(sector, data, SectorSize);
+        hostMem.add(sizeof(Sector));
         table->insert(make_pair(offset, sector));
     } else {
         memcpy((*i).second->data, data, SectorSize);
@@ -421,6 +558,80 @@ CowDiskImage::write(const uint8_t *data, std::streampos offset)
     return SectorSize;
 }
 
+std::streamsize
+CowDiskImage::readSectors(const struct iovec *iov, int iovcnt,
+                          std::streampos offset) const
+{
+    if (!initialized)
+        panic("CowDiskImage not initialized");
+
+    const size_t total = iovecsSize(iov, iovcnt);
+    panic_if(total % SectorSize, "Disk image accesses must be whole sectors");
+    const uint64_t first = std::streamoff(offset);
+    const uint64_t count = total / SectorSize;
+
+    if (count && first + count - 1 > (uint64_t)std::streamoff(size()))
+        panic("access out of bounds");
+
+    // Sectors this layer doesn't have are read from the child, each run
+    // of them at once.
+    uint64_t run = 0;
+    for (uint64_t i = 0; i <= count; i++) {
+        SectorTable::const_iterator sector = table->end();
+        if (i < count) {
+            sector = table->find(first + i);
+            if (sector == table->end())
+                continue;
+        }
+
+        if (i > run) {
+            auto parts = sliceIovecs(iov, iovcnt, run * SectorSize,
+                    (i - run) * SectorSize);
+            const std::streamsize bytes = child->readSectors(parts.data(),
+                    parts.size(), first + run);
+            if (bytes != std::streamsize((i - run) * SectorSize))
+                return run * SectorSize + std::max<std::streamsize>(bytes, 0);
+        }
+        if (sector != table->end()) {
+            copyIovecs(iov, iovcnt, i * SectorSize, sector->second->data,
+                    SectorSize, true);
+        }
+        run = i + 1;
+    }
+
+    DPRINTF(DiskImageRead, "read: offset=%d count=%d\n", first, count);
+    return total;
+}
+
+std::streamsize
+CowDiskImage::writeSectors(const struct iovec *iov, int iovcnt,
+                           std::streampos offset)
+{
+    if (!initialized)
+        panic("CowDiskImage not initialized");
+
+    const size_t total = iovecsSize(iov, iovcnt);
+    panic_if(total % SectorSize, "Disk image accesses must be whole sectors");
+    const uint64_t first = std::streamoff(offset);
+    const uint64_t count = total / SectorSize;
+
+    if (count && first + count - 1 > (uint64_t)std::streamoff(size()))
+        panic("access out of bounds");
+
+    for (uint64_t i = 0; i < count; i++) {
+        Sector *&sector = (*table)[first + i];
+        if (!sector) {
+            sector = new Sector;
+            hostMem.add(sizeof(Sector));
+        }
+        copyIovecs(iov, iovcnt, i * SectorSize, sector->data, SectorSize,
+                false);
+    }
+
+    DPRINTF(DiskImageWrite, "write: offset=%d count=%d\n", first, count);
+    return total;
+}
+
 void
 CowDiskImage::serialize(CheckpointOut &cp) const
 {
@@ -438,4 +649,316 @@ CowDiskImage::unserialize(CheckpointIn &cp)
     open(cowFilename);
 }
 
+////////////////////////////////////////////////////////////////////////
+//
+// Memory mapped, file backed copy on write Disk image
+//
+const uint32_t MappedCowDiskImage::VersionMajor = 1;
+const uint32_t MappedCowDiskImage::VersionMinor = 0;
+
+namespace
+{
+
+const char mappedCowMagic[8] = { 'C', 'O', 'W', 'M', 'A', 'P', '!', '\0' };
+
+/**
+ * Copy a file, sharing its blocks with the copy if the file system can,
+ * and otherwise leaving the holes of a sparse file as holes.
+ */
+void
+copyFile(const std::string &from, const std::string &to)
+{
+    int in = ::open(from.c_str(), O_RDONLY);
+    if (in < 0)
+        fatal("Could not open %s: %s", from, strerror(errno));
+    int out = ::open(to.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out < 0)
+        fatal("Could not create %s: %s", to, strerror(errno));
+
+    struct stat st;
+    if (fstat(in, &st) < 0)
+        fatal("Could not stat %s: %s", from, strerror(errno));
+    const off_t size = st.st_size;
+    if (ftruncate(out, size) < 0)
+        fatal("Could not resize %s: %s", to, strerror(errno));
+
+#ifdef FICLONE
+    if (ioctl(out, FICLONE, in) == 0) {
+        ::close(in);
+        ::close(out);
+        return;
+    }
+#endif
+
+    std::vector<uint8_t> buf(1 << 20);
+    off_t pos = 0;
+    while (pos < size) {
+        off_t end = size;
+#ifdef SEEK_DATA
+        const off_t data = lseek(in, pos, SEEK_DATA);
+        if (data < 0)
+            break;
+        const off_t hole = lseek(in, data, SEEK_HOLE);
+        pos = data;
+        if (hole > data)
+            end = hole;
+#endif
+        while (pos < end) {
+            const size_t len = std::min<off_t>(end - pos, buf.size());
+            ssize_t bytes = pread(in, buf.data(), len, pos);
+            if (bytes < 0 && errno == EINTR)
+                continue;
+            if (bytes <= 0 || pwrite(out, buf.data(), bytes, pos) != bytes)
+                fatal("Could not copy %s to %s", from, to);
+            pos += bytes;
+        }
+    }
+
+    ::close(in);
+    ::close(out);
+}
+
+} // anonymous namespace
+
+MappedCowDiskImage::MappedCowDiskImage(const Params &p)
+    : DiskImage(p), child(p.child), file(p.image_file),
+      readonly(p.read_only)
+{
+    fatal_if(file.empty(), "%s: A MappedCowDiskImage needs a file.",
+            name());
+    open(file);
+}
+
+MappedCowDiskImage::~MappedCowDiskImage()
+{
+    close();
+}
+
+void
+MappedCowDiskImage::notifyFork()
+{
+    if (!readonly)
+        panic("Attempting to fork system with read-write disk image.");
+}
+
+void
+MappedCowDiskImage::open(const std::string &filename)
+{
+    numSectors = std::streamoff(child->size());
+    const uint64_t page_size = sysconf(_SC_PAGESIZE);
+    const uint64_t bitmap_end = sizeof(Header) + (numSectors + 7) / 8;
+    const uint64_t data_offset =
+        (bitmap_end + page_size - 1) / page_size * page_size;
+
+    bool create = false;
+    fd = ::open(filename.c_str(), readonly ? O_RDONLY : O_RDWR);
+    if (fd < 0 && errno == ENOENT && !readonly) {
+        fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        create = true;
+    }
+    if (fd < 0)
+        fatal("Could not open %s: %s", filename, strerror(errno));
+
+    if (create) {
+        if (ftruncate(fd, data_offset + numSectors * SectorSize) < 0)
+            fatal("Could not resize %s: %s", filename, strerror(errno));
+        dataOffset = data_offset;
+    } else {
+        Header header;
+        if (pread(fd, &header, sizeof(header), 0) != sizeof(header))
+            fatal("%s is not a mapped COW file", filename);
+        if (memcmp(header.magic, mappedCowMagic, sizeof(mappedCowMagic)))
+            fatal("%s is not a mapped COW file", filename);
+        if (letoh(header.majorVersion) != VersionMajor)
+            fatal("Unsupported mapped COW file version %d.%d",
+                    letoh(header.majorVersion), letoh(header.minorVersion));
+        if (letoh(header.numSectors) != numSectors) {
+            fatal("%s has %d sectors but its child has %d", filename,
+                    letoh(header.numSectors), numSectors);
+        }
+        dataOffset = letoh(header.dataOffset);
+        if (dataOffset < bitmap_end)
+            fatal("%s is corrupt", filename);
+    }
+
+    void *addr = mmap(nullptr, dataOffset,
+            readonly ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+        fatal("Could not map %s: %s", filename, strerror(errno));
+    mapping = (uint8_t *)addr;
+    bitmap = mapping + sizeof(Header);
+
+    if (create) {
+        Header header;
+        memcpy(header.magic, mappedCowMagic, sizeof(mappedCowMagic));
+        header.majorVersion = htole(VersionMajor);
+        header.minorVersion = htole(VersionMinor);
+        header.numSectors = htole(numSectors);
+        header.dataOffset = htole(dataOffset);
+        memcpy(mapping, &header, sizeof(header));
+    }
+
+    initialized = true;
+}
+
+void
+MappedCowDiskImage::close()
+{
+    if (mapping)
+        munmap(mapping, dataOffset);
+    mapping = bitmap = nullptr;
+    if (fd >= 0)
+        ::close(fd);
+    fd = -1;
+    initialized = false;
+}
+
+std::streampos
+MappedCowDiskImage::size() const
+{
+    return child->size();
+}
+
+std::streampos
+MappedCowDiskImage::read(uint8_t *data, std::streampos offset) const
+{
+    return readSectors(data, offset, 1);
+}
+
+std::streampos
+MappedCowDiskImage::write(const uint8_t *data, std::streampos offset)
+{
+    return writeSectors(data, offset, 1);
+}
+
+std::streamsize
+MappedCowDiskImage::readSectors(const struct iovec *iov, int iovcnt,
+                                std::streampos offset) const
+{
+    if (!initialized)
+        panic("MappedCowDiskImage not initialized");
+
+    const size_t total = iovecsSize(iov, iovcnt);
+    panic_if(total % SectorSize, "Disk image accesses must be whole sectors");
+    const uint64_t first = std::streamoff(offset);
+    const uint64_t count = total / SectorSize;
+
+    if (first + count > numSectors)
+        panic("access out of bounds");
+
+    // Each run of sectors is read at once, from the child if this layer
+    // doesn't have them or from the file if it does.
+    uint64_t run = 0;
+    while (run < count) {
+        const bool here = present(first + run);
+        uint64_t end = run + 1;
+        while (end < count && present(first + end) == here)
+            end++;
+
+        const size_t pos = run * SectorSize;
+        const size_t len = (end - run) * SectorSize;
+        size_t done = 0;
+        if (here) {
+            while (done < len) {
+                auto parts = sliceIovecs(iov, iovcnt, pos + done, len - done);
+                const ssize_t bytes = preadv(fd, parts.data(),
+                        std::min<size_t>(parts.size(), IOV_MAX),
+                        dataOffset + (first + run) * SectorSize + done);
+                if (bytes < 0 && errno == EINTR)
+                    continue;
+                if (bytes <= 0)
+                    break;
+                done += bytes;
+            }
+        } else {
+            auto parts = sliceIovecs(iov, iovcnt, pos, len);
+            done = std::max<std::streamsize>(
+                    child->readSectors(parts.data(), parts.size(),
+                        first + run), 0);
+        }
+        if (done != len)
+            return pos + done;
+        run = end;
+    }
+
+    DPRINTF(DiskImageRead, "read: offset=%d count=%d\n", first, count);
+    if (debug::DiskImageRead) {
+        for (const auto &part: sliceIovecs(iov, iovcnt, 0, total))
+            DDUMP(DiskImageRead, (uint8_t *)part.iov_base, part.iov_len);
+    }
+    return total;
+}
+
+std::streamsize
+MappedCowDiskImage::writeSectors(const struct iovec *iov, int iovcnt,
+                                 std::streampos offset)
+{
+    if (!initialized)
+        panic("MappedCowDiskImage not initialized");
+
+    if (readonly)
+        panic("Cannot write to a read only disk image");
+
+    const size_t total = iovecsSize(iov, iovcnt);
+    panic_if(total % SectorSize, "Disk image accesses must be whole sectors");
+    const uint64_t first = std::streamoff(offset);
+    const uint64_t count = total / SectorSize;
+
+    if (first + count > numSectors)
+        panic("access out of bounds");
+
+    DPRINTF(DiskImageWrite, "write: offset=%d count=%d\n", first, count);
+    if (debug::DiskImageWrite) {
+        for (const auto &part: sliceIovecs(iov, iovcnt, 0, total))
+            DDUMP(DiskImageWrite, (uint8_t *)part.iov_base, part.iov_len);
+    }
+
+    size_t done = 0;
+    while (done < total) {
+        auto parts = sliceIovecs(iov, iovcnt, done, total - done);
+        const ssize_t bytes = pwritev(fd, parts.data(),
+                std::min<size_t>(parts.size(), IOV_MAX),
+                dataOffset + first * SectorSize + done);
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        if (bytes <= 0)
+            break;
+        done += bytes;
+    }
+
+    // Only whole sectors which made it to the file are in this layer.
+    for (uint64_t i = first; i < first + done / SectorSize; i++)
+        bitmap[i / 8] |= 1 << (i % 8);
+
+    return done / SectorSize * SectorSize;
+}
+
+void
+MappedCowDiskImage::serialize(CheckpointOut &cp) const
+{
+    std::string cowFilename = name() + ".cowmap";
+    SERIALIZE_SCALAR(cowFilename);
+    if (!readonly)
+        msync(mapping, dataOffset, MS_SYNC);
+    copyFile(file, CheckpointIn::dir() + "/" + cowFilename);
+}
+
+void
+MappedCowDiskImage::unserialize(CheckpointIn &cp)
+{
+    std::string cowFilename;
+    UNSERIALIZE_SCALAR(cowFilename);
+    cowFilename = cp.getCptDir() + "/" + cowFilename;
+
+    close();
+    // A read only layer uses its copy in the checkpoint as it is, while
+    // a writable one starts from a copy of it which it goes on changing.
+    if (readonly) {
+        file = cowFilename;
+    } else {
+        copyFile(cowFilename, file);
+    }
+    open(file);
+}
+
 } // namespace gem5
@@ -33,12 +33,16 @@
 #ifndef __DEV_STORAGE_DISK_IMAGE_HH__
 #define __DEV_STORAGE_DISK_IMAGE_HH__
 
+#include <sys/uio.h>
+
 #include <fstream>
 #include <unordered_map>
 
 #include "params/CowDiskImage.hh"
 #include "params/DiskImage.hh"
+#include "params/MappedCowDiskImage.hh"
 #include "params/RawDiskImage.hh"
+#include "sim/host_mem.hh"
 #include "sim/sim_object.hh"
 
 #define SectorSize (512)
@@ -65,6 +69,42 @@ class DiskImage : public SimObject
                                 std::streampos offset) const = 0;
     virtual std::streampos write(const uint8_t *data,
                                  std::streampos offset) = 0;
+
+    /**
+     * Read consecutive sectors, starting at sector offset, into a set of
+     * buffers which add up to a whole number of sectors. By default the
+     * sectors are read one at a time.
+     *
+     * @return The number of bytes read.
+     */
+    virtual std::streamsize readSectors(const struct iovec *iov, int iovcnt,
+                                        std::streampos offset) const;
+
+    /**
+     * Write consecutive sectors, starting at sector offset, from a set of
+     * buffers which add up to a whole number of sectors. By default the
+     * sectors are written one at a time.
+     *
+     * @return The number of bytes written.
+     */
+    virtual std::streamsize writeSectors(const struct iovec *iov,
+                                         int iovcnt, std::streampos offset);
+
+    /** Read count sectors, starting at sector offset, into data. */
+    std::streamsize
+    readSectors(uint8_t *data, std::streampos offset, size_t count) const
+    {
+        struct iovec iov = {data, count * SectorSize};
+        return readSectors(&iov, 1, offset);
+    }
+
+    /** Write count sectors, starting at sector offset, from data. */
+    std::streamsize
+    writeSectors(const uint8_t *data, std::streampos offset, size_t count)
+    {
+        struct iovec iov = {const_cast<uint8_t *>(data), count * SectorSize};
+        return writeSectors(&iov, 1, offset);
+    }
 };
 
 /**
@@ -73,7 +113,7 @@ class DiskImage : public SimObject
 class RawDiskImage : public DiskImage
 {
   protected:
-    mutable std::fstream stream;
+    int fd = -1;
     std::string file;
     bool readonly;
     mutable std::streampos disk_size;
@@ -92,6 +132,13 @@ class RawDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    using DiskImage::readSectors;
+    using DiskImage::writeSectors;
+    std::streamsize readSectors(const struct iovec *iov, int iovcnt,
+                                std::streampos offset) const override;
+    std::streamsize writeSectors(const struct iovec *iov, int iovcnt,
+                                 std::streampos offset) override;
 };
 
 /**
@@ -121,6 +168,8 @@ class CowDiskImage : public DiskImage
     std::string filename;
     DiskImage *child;
     SectorTable *table;
+    /** The sectors written, which are all kept in host memory */
+    host_mem::Account hostMem;
 
   public:
     typedef CowDiskImageParams Params;
@@ -142,6 +191,86 @@ class CowDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    using DiskImage::readSectors;
+    using DiskImage::writeSectors;
+    std::streamsize readSectors(const struct iovec *iov, int iovcnt,
+                                std::streampos offset) const override;
+    std::streamsize writeSectors(const struct iovec *iov, int iovcnt,
+                                 std::streampos offset) override;
+};
+
+/**
+ * A copy-on-write layer kept in a file instead of in memory, which
+ * persists across simulations. The file starts with a bitmap of the
+ * sectors the layer holds, mapped into memory and updated in place. The
+ * sectors follow at their own offsets, in a sparse file, so the file
+ * only takes as much storage as what was written to it, allocated by
+ * the host file system in clusters of its own block size.
+ *
+ * Checkpoints get a copy of the file, which is a reflink where the host
+ * file system supports them. The child, typically a read-only raw
+ * image, can be shared by any number of simulations.
+ */
+class MappedCowDiskImage : public DiskImage
+{
+  public:
+    static const uint32_t VersionMajor;
+    static const uint32_t VersionMinor;
+
+  protected:
+    /** The start of the file, in little endian */
+    struct Header
+    {
+        char magic[8];
+        uint32_t majorVersion;
+        uint32_t minorVersion;
+        uint64_t numSectors;
+        uint64_t dataOffset;
+    };
+
+    DiskImage *child;
+    std::string file;
+    bool readonly;
+
+    int fd = -1;
+    uint64_t numSectors = 0;
+    /** Where the sectors start in the file */
+    uint64_t dataOffset = 0;
+    /** The file mapped up to the sectors, i.e. the header and bitmap */
+    uint8_t *mapping = nullptr;
+    uint8_t *bitmap = nullptr;
+
+    bool
+    present(uint64_t sector) const
+    {
+        return bitmap[sector / 8] & (1 << (sector % 8));
+    }
+
+    void open(const std::string &filename);
+    void close();
+
+  public:
+    typedef MappedCowDiskImageParams Params;
+    MappedCowDiskImage(const Params &p);
+    ~MappedCowDiskImage();
+
+    void notifyFork() override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+    std::streampos size() const override;
+
+    std::streampos read(uint8_t *data, std::streampos offset) const override;
+    std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    using DiskImage::readSectors;
+    using DiskImage::writeSectors;
+    std::streamsize readSectors(const struct iovec *iov, int iovcnt,
+                                std::streampos offset) const override;
+    std::streamsize writeSectors(const struct iovec *iov, int iovcnt,
+                                 std::streampos offset) override;
 };
 
 void SafeRead(std::ifstream &stream, void *data, int count);
@@ -55,6 +55,11 @@ class VirtIODeviceBase(SimObject):
 
     system = Param.System(Parent.any, "system object")
     byte_order = Param.ByteOrder("little", "Device byte order")
+    event_idx = Param.Bool(
+        False,
+        "Offer VIRTIO_RING_F_EVENT_IDX, which lets the guest suppress "
+        "notifications it doesn't need",
+    )
 
 
 class VirtIODummyDevice(VirtIODeviceBase):
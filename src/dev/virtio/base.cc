@@ -263,6 +263,10 @@ VirtQueue::reset()
 {
     _address = 0;
     _last_avail = 0;
+    eventIdx = false;
+    batching = false;
+    usedPending = false;
+    kickWanted = false;
 
     avail.reset();
     used.reset();
@@ -282,15 +286,8 @@ VirtQueue::setAddress(Addr address)
 }
 
 VirtDescriptor *
-VirtQueue::consumeDescriptor()
+VirtQueue::takeAvail()
 {
-    avail.read();
-    DPRINTF(VIO, "consumeDescriptor: _last_avail: %i, avail.idx: %i (->%i)\n",
-            _last_avail, avail.header.index,
-            avail.ring[_last_avail % used.ring.size()]);
-    if (_last_avail == avail.header.index)
-        return NULL;
-
     VirtDescriptor::Index index(avail.ring[_last_avail % used.ring.size()]);
     ++_last_avail;
 
@@ -300,18 +297,87 @@ VirtQueue::consumeDescriptor()
     return d;
 }
 
+VirtDescriptor *
+VirtQueue::consumeDescriptor()
+{
+    avail.readHeader();
+    if (_last_avail == avail.header.index) {
+        DPRINTF(VIO, "consumeDescriptor: _last_avail: %i, avail.idx: %i\n",
+                _last_avail, avail.header.index);
+        return NULL;
+    }
+
+    avail.readEntries(_last_avail, 1);
+    DPRINTF(VIO, "consumeDescriptor: _last_avail: %i, avail.idx: %i (->%i)\n",
+            _last_avail, avail.header.index,
+            avail.ring[_last_avail % used.ring.size()]);
+    VirtDescriptor *d(takeAvail());
+    if (eventIdx && !batching)
+        used.writeEvent(_last_avail);
+
+    return d;
+}
+
 void
 VirtQueue::produceDescriptor(VirtDescriptor *desc, uint32_t len)
 {
-    used.readHeader();
+    // The used ring index only changes when the device publishes it, so
+    // it only needs to be read once per batch.
+    if (!usedPending) {
+        used.readHeader();
+        usedPublished = used.header.index;
+    }
     DPRINTF(VIO, "produceDescriptor: dscIdx: %i, len: %i, used.idx: %i\n",
             desc->index(), len, used.header.index);
 
     struct vring_used_elem &e(used.ring[used.header.index % used.ring.size()]);
     e.id = desc->index();
     e.len = len;
+    used.writeEntries(used.header.index, 1);
     used.header.index += 1;
-    used.write();
+    usedPending = true;
+
+    if (!batching)
+        publishUsed();
+}
+
+void
+VirtQueue::publishUsed()
+{
+    used.writeHeader();
+    usedPending = false;
+
+    if (eventIdx) {
+        kickWanted = kickWanted || vring_need_event(avail.readEvent(),
+                used.header.index, usedPublished);
+    } else {
+        kickWanted = true;
+    }
+    usedPublished = used.header.index;
+}
+
+void
+VirtQueue::beginBatch()
+{
+    batching = true;
+}
+
+void
+VirtQueue::endBatch()
+{
+    batching = false;
+    if (usedPending)
+        publishUsed();
+    if (eventIdx && _address != 0)
+        used.writeEvent(_last_avail);
+}
+
+bool
+VirtQueue::takeKick()
+{
+    const bool wanted = kickWanted;
+    kickWanted = false;
+    return wanted;
 }
 
 void
@@ -329,10 +395,23 @@ VirtQueue::onNotify()
 {
     DPRINTF(VIO, "onNotify\n");
 
-    // Consume all pending descriptors from the input queue.
-    VirtDescriptor *d;
-    while ((d = consumeDescriptor()) != NULL)
-        onNotifyDescriptor(d);
+    // Consume all pending descriptors from the input queue, reading all
+    // the available ring entries the guest has added at once.
+    avail.readHeader();
+    while (_last_avail != avail.header.index) {
+        const uint16_t count = avail.header.index - _last_avail;
+        if (count > _size)
+            panic("Guest made %i descriptors available in a queue of %i.\n",
+                  count, _size);
+
+        avail.readEntries(_last_avail, count);
+        DPRINTF(VIO, "onNotify: _last_avail: %i, avail.idx: %i\n",
+                _last_avail, avail.header.index);
+        for (uint16_t i = 0; i < count; ++i)
+            onNotifyDescriptor(takeAvail());
+
+        avail.readHeader();
+    }
 }
 
 
@@ -341,7 +420,9 @@ VirtIODeviceBase::VirtIODeviceBase(const Params &params, DeviceId id,
     : SimObject(params),
       guestFeatures(0),
       byteOrder(params.byte_order),
-      deviceId(id), configSize(config_size), deviceFeatures(features),
+      deviceId(id), configSize(config_size),
+      deviceFeatures(features |
+              (params.event_idx ? 1 << VIRTIO_RING_F_EVENT_IDX : 0)),
       _deviceStatus(0), _queueSelect(0)
 {
 }
@@ -367,8 +448,11 @@ VirtIODeviceBase::unserialize(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(guestFeatures);
     UNSERIALIZE_SCALAR(_deviceStatus);
     UNSERIALIZE_SCALAR(_queueSelect);
-    for (QueueID i = 0; i < _queues.size(); ++i)
+    const bool event_idx(guestFeatures & (1 << VIRTIO_RING_F_EVENT_IDX));
+    for (QueueID i = 0; i < _queues.size(); ++i) {
         _queues[i]->unserializeSection(cp, csprintf("_queues.%i", i));
+        _queues[i]->setEventIdx(event_idx);
+    }
 }
 
 void
@@ -391,7 +475,37 @@ VirtIODeviceBase::onNotify(QueueID idx)
               "queues registered.\n",
               idx, _queues.size());
     }
-    _queues[idx]->onNotify();
+
+    // Process the whole batch of pending descriptors before telling the
+    // guest about the results, with one used ring update and one kick.
+    VirtQueue &queue(*_queues[idx]);
+    const bool defer_kicks(deferKicks);
+    deferKicks = true;
+    queue.beginBatch();
+    queue.onNotify();
+    queue.endBatch();
+    deferKicks = defer_kicks;
+
+    if (kickPending && !deferKicks)
+        kick();
+}
+
+void
+VirtIODeviceBase::kick()
+{
+    assert(transKick);
+    if (deferKicks) {
+        kickPending = true;
+        return;
+    }
+    kickPending = false;
+
+    // Without event indices, the guest is notified of everything.
+    bool wanted(!(guestFeatures & (1 << VIRTIO_RING_F_EVENT_IDX)));
+    for (VirtQueue *queue : _queues)
+        wanted = queue->takeKick() || wanted;
+    if (wanted)
+        transKick();
 }
 
 void
@@ -405,6 +519,10 @@ VirtIODeviceBase::setGuestFeatures(FeatureBits features)
               deviceFeatures, features);
     }
     guestFeatures = features;
+
+    const bool event_idx(features & (1 << VIRTIO_RING_F_EVENT_IDX));
+    for (VirtQueue *queue : _queues)
+        queue->setEventIdx(event_idx);
 }
 
 
@@ -38,6 +38,7 @@
 #ifndef __DEV_VIRTIO_BASE_HH__
 #define __DEV_VIRTIO_BASE_HH__
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <vector>
@@ -353,6 +354,33 @@ class VirtQueue : public Serializable
     VirtDescriptor *getDescriptor(VirtDescriptor::Index index) {
         return &descriptors[index];
     }
+
+    /**
+     * Use the used and available buffer event indices of the
+     * VIRTIO_RING_F_EVENT_IDX feature.
+     *
+     * @param enabled True if the guest accepted the feature.
+     */
+    void setEventIdx(bool enabled) { eventIdx = enabled; }
+
+    /**
+     * Start processing a batch of descriptor chains.
+     *
+     * Descriptor chains produced until the end of the batch are
+     * written to the used ring right away, but the guest only sees
+     * them when the index of the used ring is updated, once, at the
+     * end of the batch.
+     */
+    void beginBatch();
+    /** Publish the descriptor chains produced during a batch. */
+    void endBatch();
+
+    /**
+     * Tell whether the guest wants to be notified of the descriptor
+     * chains published since this method was last called, and forget
+     * about them.
+     */
+    bool takeKick();
     /** @} */
 
     /** @{
@@ -543,6 +571,64 @@ class VirtQueue : public Serializable
             writeHeader();
         }
 
+        /**
+         * Read elements of the ring from the guest.
+         *
+         * @param first Index of the first element, modulo the size.
+         * @param count Number of elements to read.
+         */
+        void
+        readEntries(Index first, Index count)
+        {
+            assert(_base != 0 && count <= ring.size());
+            T temp[count];
+            transferEntries(first, count, temp, false);
+            for (Index i = 0; i < count; ++i) {
+                const Index pos = (first + i) % ring.size();
+                ring[pos] = gtoh(temp[i], byteOrder);
+            }
+        }
+
+        /**
+         * Write elements of the ring to the guest.
+         *
+         * @param first Index of the first element, modulo the size.
+         * @param count Number of elements to write.
+         */
+        void
+        writeEntries(Index first, Index count)
+        {
+            assert(_base != 0 && count <= ring.size());
+            T temp[count];
+            for (Index i = 0; i < count; ++i) {
+                const Index pos = (first + i) % ring.size();
+                temp[i] = htog(ring[pos], byteOrder);
+            }
+            transferEntries(first, count, temp, true);
+        }
+
+        /**
+         * Read the event index after the ring, used_event in the
+         * available ring and avail_event in the used ring.
+         */
+        Index
+        readEvent()
+        {
+            Index event;
+            assert(_base != 0);
+            _proxy.readBlob(eventAddr(), &event, sizeof(event));
+            return gtoh(event, byteOrder);
+        }
+
+        /** Write the event index after the ring */
+        void
+        writeEvent(Index event)
+        {
+            assert(_base != 0);
+            event = htog(event, byteOrder);
+            _proxy.writeBlob(eventAddr(), &event, sizeof(event));
+        }
+
         /** Ring buffer header in host byte order */
         Header header;
         /** Elements in ring in host byte order */
@@ -552,6 +638,30 @@ class VirtQueue : public Serializable
         // Remove default constructor
         VirtRing<T>();
 
+        Addr
+        eventAddr() const
+        {
+            return _base + sizeof(header) + sizeof(T) * ring.size();
+        }
+
+        /** Copy elements in guest byte order, at most two blobs */
+        void
+        transferEntries(Index first, Index count, T *temp, bool write)
+        {
+            const Index start = first % ring.size();
+            const Index head = std::min<size_t>(count, ring.size() - start);
+            const Addr addr = _base + sizeof(header) + sizeof(T) * start;
+            if (write) {
+                _proxy.writeBlob(addr, temp, sizeof(T) * head);
+                _proxy.writeBlob(_base + sizeof(header), temp + head,
+                                 sizeof(T) * (count - head));
+            } else {
+                _proxy.readBlob(addr, temp, sizeof(T) * head);
+                _proxy.readBlob(_base + sizeof(header), temp + head,
+                                sizeof(T) * (count - head));
+            }
+        }
+
         /** Guest physical memory proxy */
         PortProxy &_proxy;
         /** Guest physical base address of the ring buffer */
@@ -572,6 +682,23 @@ class VirtQueue : public Serializable
     /** Vector of pre-created descriptors indexed by their index into
      * the queue. */
     std::vector<VirtDescriptor> descriptors;
+
+    /** Take the next chain out of the available ring, which has been
+     * read up to it. */
+    VirtDescriptor *takeAvail();
+    /** Make the chains produced so far visible to the guest */
+    void publishUsed();
+
+    /** Is the VIRTIO_RING_F_EVENT_IDX feature in use? */
+    bool eventIdx = false;
+    /** Is a batch of descriptor chains being processed? */
+    bool batching = false;
+    /** Have chains been produced since the used ring was published? */
+    bool usedPending = false;
+    /** Index of the used ring when it was last published */
+    uint16_t usedPublished = 0;
+    /** Does the guest want to be notified of published chains? */
+    bool kickWanted = false;
 };
 
 /**
@@ -633,13 +760,12 @@ class VirtIODeviceBase : public SimObject
      * method used to inform the guest is transport dependent, but is
      * typically through an interrupt. Device models call this method
      * to tell the transport interface to notify the guest.
+     *
+     * Kicks while the device processes a notification are sent as one
+     * at the end of it. If the guest uses VIRTIO_RING_F_EVENT_IDX,
+     * kicks it didn't ask for are dropped.
      */
-    void
-    kick()
-    {
-        assert(transKick);
-        transKick();
-    };
+    void kick();
 
     /**
      * Register a new VirtQueue with the device model.
@@ -901,6 +1027,11 @@ class VirtIODeviceBase : public SimObject
 
     /** Callbacks to kick the guest through the transport layer  */
     std::function<void()> transKick;
+
+    /** Are kicks held back until the end of a batch? */
+    bool deferKicks = false;
+    /** Has a kick been held back? */
+    bool kickPending = false;
 };
 
 class VirtIODummyDevice : public VirtIODeviceBase
@@ -37,6 +37,8 @@
 
 #include "dev/virtio/block.hh"
 
+#include <algorithm>
+
 #include "debug/VIOBlock.hh"
 #include "params/VirtIOBlock.hh"
 #include "sim/system.hh"
@@ -82,12 +84,12 @@ VirtIOBlock::read(const BlkRequest &req, VirtDescriptor *desc_chain,
     if (size % SectorSize != 0)
         panic("Unexpected request/sector size relationship\n");
 
-    for (Addr offset = 0; offset < size; offset += SectorSize) {
-        if (image.read(&data[offset], sector) != SectorSize) {
-            warn("Failed to read sector %i\n", sector);
-            return S_IOERR;
-        }
-        ++sector;
+    const std::streamsize bytes =
+        image.readSectors(data.data(), sector, size / SectorSize);
+    if (bytes != (std::streamsize)size) {
+        warn("Failed to read sector %i\n",
+                sector + std::max<std::streamsize>(bytes, 0) / SectorSize);
+        return S_IOERR;
     }
 
     desc_chain->chainWrite(off_data, &data[0], size);
@@ -111,12 +113,12 @@ VirtIOBlock::write(const BlkRequest &req, VirtDescriptor *desc_chain,
 
     desc_chain->chainRead(off_data, &data[0], size);
 
-    for (Addr offset = 0; offset < size; offset += SectorSize) {
-        if (image.write(&data[offset], sector) != SectorSize) {
-            warn("Failed to write sector %i\n", sector);
-            return S_IOERR;
-        }
-        ++sector;
+    const std::streamsize bytes =
+        image.writeSectors(data.data(), sector, size / SectorSize);
+    if (bytes != (std::streamsize)size) {
+        warn("Failed to write sector %i\n",
+                sector + std::max<std::streamsize>(bytes, 0) / SectorSize);
+        return S_IOERR;
     }
 
     return S_OK;
@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dev/virtio/net.hh"
+
+#include <algorithm>
+
+#include "base/inet.hh"
+#include "base/trace.hh"
+#include "debug/VIONet.hh"
+#include "params/VirtIONet.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+VirtIONet::VirtIONet(const Params &params)
+    : VirtIODeviceBase(params, ID_NET, sizeof(Config),
+                       F_MAC | F_STATUS |
+                       (params.queue_pairs > 1 ? F_CTRL_VQ | F_MQ : 0)),
+      interface(name() + ".interface", *this),
+      activePairs(1), txNext(0), stats(this)
+{
+    fatal_if(params.queue_pairs < 1 || params.queue_pairs > 0x8000,
+             "%s: Unsupported number of queue pairs (%d).", name(),
+             params.queue_pairs);
+
+    PortProxy &proxy(params.system->physProxy);
+    for (unsigned i = 0; i < params.queue_pairs; ++i) {
+        rxQueues.emplace_back(new RxQueue(proxy, byteOrder, params.queueSize,
+                    params.rx_fifo_size, i, *this));
+        txQueues.emplace_back(new TxQueue(proxy, byteOrder, params.queueSize,
+                    i, *this));
+        registerQueue(*rxQueues.back());
+        registerQueue(*txQueues.back());
+    }
+    if (params.queue_pairs > 1) {
+        ctrlQueue.reset(new CtrlQueue(proxy, byteOrder, params.queueSize,
+                    *this));
+        registerQueue(*ctrlQueue);
+    }
+
+    memcpy(config.mac, params.hardware_address.bytes(), sizeof(config.mac));
+    config.status = S_LINK_UP;
+    config.maxVirtqueuePairs = params.queue_pairs;
+}
+
+VirtIONet::~VirtIONet()
+{
+}
+
+void
+VirtIONet::readConfig(PacketPtr pkt, Addr cfgOffset)
+{
+    Config cfg_out;
+    memcpy(cfg_out.mac, config.mac, sizeof(cfg_out.mac));
+    cfg_out.status = htog(config.status, byteOrder);
+    cfg_out.maxVirtqueuePairs = htog(config.maxVirtqueuePairs, byteOrder);
+
+    readConfigBlob(pkt, cfgOffset, (uint8_t *)&cfg_out);
+}
+
+Port &
+VirtIONet::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "interface")
+        return interface;
+    return VirtIODeviceBase::getPort(if_name, idx);
+}
+
+void
+VirtIONet::reset()
+{
+    VirtIODeviceBase::reset();
+
+    activePairs = 1;
+    txNext = 0;
+    for (auto &queue : rxQueues)
+        queue->fifo.clear();
+}
+
+unsigned
+VirtIONet::steer(const EthPacketPtr &packet) const
+{
+    if (activePairs == 1)
+        return 0;
+
+    networking::IpPtr ip(packet);
+    if (!ip)
+        return 0;
+
+    // Hash the addresses and ports of the flow, in a way that doesn't
+    // depend on its direction.
+    uint64_t hash(ip->src() ^ ip->dst());
+    networking::TcpPtr tcp(ip);
+    networking::UdpPtr udp(ip);
+    if (tcp)
+        hash ^= (uint64_t)(tcp->sport() ^ tcp->dport()) << 32;
+    else if (udp)
+        hash ^= (uint64_t)(udp->sport() ^ udp->dport()) << 32;
+    hash *= 0x9e3779b97f4a7c15ULL;
+
+    return (hash >> 32) % activePairs;
+}
+
+bool
+VirtIONet::recvPacket(EthPacketPtr packet)
+{
+    stats.rxBytes += packet->length;
+    stats.rxPackets++;
+
+    RxQueue &queue(*rxQueues[steer(packet)]);
+    DPRINTF(VIONet, "Received frame (len: %i) for %s\n", packet->length,
+            queue.name());
+
+    if (!queue.fifo.push(packet)) {
+        DPRINTF(VIONet, "Receive FIFO full, frame dropped\n");
+        stats.rxDrops++;
+        return true;
+    }
+
+    queue.deliver();
+    return true;
+}
+
+void
+VirtIONet::RxQueue::deliver()
+{
+    if (getAddress() == 0)
+        return;
+
+    VirtDescriptor *d;
+    while (!fifo.empty() && (d = consumeDescriptor())) {
+        EthPacketPtr packet(fifo.front());
+        fifo.pop();
+
+        const size_t size(sizeof(NetHeader) + packet->length);
+        if (d->chainSize() < size) {
+            warn_once("%s: Receive buffer too small for a frame, "
+                      "frames dropped.\n", name());
+            parent.stats.rxDrops++;
+            produceDescriptor(d, 0);
+            parent.kick();
+            continue;
+        }
+
+        DPRINTF(VIONet, "Delivering frame (len: %i) in %s\n",
+                packet->length, name());
+        // Checksums and segmentation aren't offloaded, so the header is
+        // all zeros.
+        NetHeader header{};
+        d->chainWrite(0, (uint8_t *)&header, sizeof(header));
+        d->chainWrite(sizeof(header), packet->data, packet->length);
+
+        produceDescriptor(d, size);
+        parent.kick();
+    }
+}
+
+void
+VirtIONet::transferDone()
+{
+    DPRINTF(VIONet, "Link done with frame\n");
+    transmit();
+}
+
+void
+VirtIONet::transmit()
+{
+    while (true) {
+        if (txPacket) {
+            if (!interface.sendPacket(txPacket)) {
+                DPRINTF(VIONet, "Link busy\n");
+                return;
+            }
+            stats.txBytes += txPacket->length;
+            stats.txPackets++;
+            txPacket = nullptr;
+        }
+
+        // Take the next frame from the transmit queues in turn.
+        VirtDescriptor *d(nullptr);
+        TxQueue *queue(nullptr);
+        for (unsigned i = 0; i < activePairs && !d; ++i) {
+            queue = txQueues[txNext].get();
+            txNext = (txNext + 1) % activePairs;
+            if (queue->getAddress() != 0)
+                d = queue->consumeDescriptor();
+        }
+        if (!d)
+            return;
+
+        const size_t size(d->chainSize());
+        if (size < sizeof(NetHeader)) {
+            warn_once("%s: Transmit buffer without header, frames "
+                      "dropped.\n", queue->name());
+            queue->produceDescriptor(d, 0);
+            kick();
+            continue;
+        }
+
+        const unsigned length(size - sizeof(NetHeader));
+        txPacket = std::make_shared<EthPacketData>(length);
+        txPacket->length = length;
+        txPacket->simLength = length;
+        d->chainRead(sizeof(NetHeader), txPacket->data, length);
+        DPRINTF(VIONet, "Transmitting frame (len: %i) from %s\n", length,
+                queue->name());
+
+        // The frame has been copied out, so the guest can have its
+        // buffer back right away.
+        queue->produceDescriptor(d, 0);
+        kick();
+    }
+}
+
+void
+VirtIONet::CtrlQueue::onNotifyDescriptor(VirtDescriptor *desc)
+{
+    CtrlHeader header;
+    desc->chainRead(0, (uint8_t *)&header, sizeof(header));
+
+    CtrlAck ack(CTRL_ERR);
+    if (header.cls == CTRL_MQ && header.cmd == CTRL_MQ_VQ_PAIRS_SET) {
+        uint16_t pairs;
+        desc->chainRead(sizeof(header), (uint8_t *)&pairs, sizeof(pairs));
+        pairs = gtoh(pairs, byteOrder);
+        DPRINTF(VIONet, "Guest asks for %i queue pairs\n", pairs);
+        if (pairs >= 1 && pairs <= parent.rxQueues.size()) {
+            parent.activePairs = pairs;
+            parent.txNext = 0;
+            ack = CTRL_OK;
+        }
+    } else {
+        DPRINTF(VIONet, "Unsupported control command %i.%i\n",
+                header.cls, header.cmd);
+    }
+
+    desc->chainWrite(desc->chainSize() - sizeof(ack), &ack, sizeof(ack));
+    produceDescriptor(desc, sizeof(ack));
+    parent.kick();
+}
+
+void
+VirtIONet::serialize(CheckpointOut &cp) const
+{
+    VirtIODeviceBase::serialize(cp);
+
+    SERIALIZE_SCALAR(activePairs);
+    SERIALIZE_SCALAR(txNext);
+
+    bool txPacketExists = txPacket != nullptr;
+    SERIALIZE_SCALAR(txPacketExists);
+    if (txPacketExists)
+        txPacket->serialize("txPacket", cp);
+
+    for (unsigned i = 0; i < rxQueues.size(); ++i)
+        rxQueues[i]->fifo.serialize(csprintf("rxFifo%d", i), cp);
+}
+
+void
+VirtIONet::unserialize(CheckpointIn &cp)
+{
+    VirtIODeviceBase::unserialize(cp);
+
+    UNSERIALIZE_SCALAR(activePairs);
+    UNSERIALIZE_SCALAR(txNext);
+
+    bool txPacketExists;
+    UNSERIALIZE_SCALAR(txPacketExists);
+    if (txPacketExists) {
+        txPacket = std::make_shared<EthPacketData>();
+        txPacket->unserialize("txPacket", cp);
+    } else {
+        txPacket = nullptr;
+    }
+
+    for (unsigned i = 0; i < rxQueues.size(); ++i)
+        rxQueues[i]->fifo.unserialize(csprintf("rxFifo%d", i), cp);
+}
+
+VirtIONet::NetStats::NetStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(txBytes, statistics::units::Byte::get(),
+               "Bytes Transmitted"),
+      ADD_STAT(rxBytes, statistics::units::Byte::get(), "Bytes Received"),
+      ADD_STAT(txPackets, statistics::units::Count::get(),
+               "Number of Packets Transmitted"),
+      ADD_STAT(rxPackets, statistics::units::Count::get(),
+               "Number of Packets Received"),
+      ADD_STAT(rxDrops, statistics::units::Count::get(),
+               "Number of Packets Dropped on Receive")
+{
+}
+
+} // namespace gem5
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __DEV_VIRTIO_NET_HH__
+#define __DEV_VIRTIO_NET_HH__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/statistics.hh"
+#include "dev/net/etherint.hh"
+#include "dev/net/etherpkt.hh"
+#include "dev/net/pktfifo.hh"
+#include "dev/virtio/base.hh"
+
+namespace gem5
+{
+
+struct VirtIONetParams;
+
+/**
+ * VirtIO network device
+ *
+ * The network device uses the following queues:
+ *  -# Receive queue 0
+ *  -# Transmit queue 0
+ *  -# ...
+ *  -# Receive queue N-1
+ *  -# Transmit queue N-1
+ *  -# Control queue, if there's more than one pair of queues
+ *
+ * Every descriptor chain starts with a NetHeader followed by an
+ * Ethernet frame. Frames are passed to and from the Ethernet interface
+ * as EthPacketPtrs, so sending them to a link, switch or tap involves
+ * no further copies than the one to or from guest memory.
+ *
+ * Received frames are steered to a pair of queues by a hash of their
+ * IP addresses and ports, and wait in the FIFO of that pair until the
+ * guest makes a buffer available. A frame is transmitted at a time,
+ * the device takes the next one from the transmit queues in turn once
+ * the link has accepted it.
+ *
+ * @see https://github.com/rustyrussell/virtio-spec
+ * @see http://docs.oasis-open.org/virtio/virtio/v1.0/virtio-v1.0.html
+ */
+class VirtIONet : public VirtIODeviceBase
+{
+  public:
+    typedef VirtIONetParams Params;
+    VirtIONet(const Params &params);
+    virtual ~VirtIONet();
+
+    void readConfig(PacketPtr pkt, Addr cfgOffset);
+    void reset() override;
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+    /** Receive a frame from the Ethernet interface */
+    bool recvPacket(EthPacketPtr packet);
+    /** Continue transmitting once the link is done with a frame */
+    void transferDone();
+
+  protected:
+    static const DeviceId ID_NET = 0x01;
+
+    /** Network device configuration structure */
+    struct GEM5_PACKED Config
+    {
+        uint8_t mac[6];
+        uint16_t status;
+        uint16_t maxVirtqueuePairs;
+    };
+    Config config;
+
+    /** @{
+     * @name Feature bits
+     */
+    static const FeatureBits F_MAC = (1 << 5);
+    static const FeatureBits F_STATUS = (1 << 16);
+    static const FeatureBits F_CTRL_VQ = (1 << 17);
+    static const FeatureBits F_MQ = (1 << 22);
+    /** @} */
+
+    /** Link is up, in Config::status */
+    static const uint16_t S_LINK_UP = 1;
+
+    /** Header of every frame, in the legacy layout without F_MRG_RXBUF */
+    struct GEM5_PACKED NetHeader
+    {
+        uint8_t flags;
+        uint8_t gsoType;
+        uint16_t hdrLen;
+        uint16_t gsoSize;
+        uint16_t csumStart;
+        uint16_t csumOffset;
+    };
+
+    /** @{
+     * @name Control queue commands
+     */
+    struct GEM5_PACKED CtrlHeader
+    {
+        uint8_t cls;
+        uint8_t cmd;
+    };
+    typedef uint8_t CtrlAck;
+    static const CtrlAck CTRL_OK = 0;
+    static const CtrlAck CTRL_ERR = 1;
+    /** Class of multiqueue commands */
+    static const uint8_t CTRL_MQ = 4;
+    /** Set the number of queue pairs in use */
+    static const uint8_t CTRL_MQ_VQ_PAIRS_SET = 0;
+    /** @} */
+
+    class NetInterface : public EtherInt
+    {
+      public:
+        NetInterface(const std::string &name, VirtIONet &_parent)
+            : EtherInt(name), parent(_parent) {}
+
+        bool recvPacket(EthPacketPtr pkt) override
+        {
+            return parent.recvPacket(pkt);
+        }
+        void sendDone() override { parent.transferDone(); }
+
+      protected:
+        VirtIONet &parent;
+    };
+    NetInterface interface;
+
+    class RxQueue : public VirtQueue
+    {
+      public:
+        RxQueue(PortProxy &proxy, ByteOrder bo, uint16_t size,
+                unsigned fifo_size, unsigned _idx, VirtIONet &_parent)
+            : VirtQueue(proxy, bo, size), fifo(fifo_size), idx(_idx),
+              parent(_parent) {}
+
+        void onNotify() override { deliver(); }
+
+        /** Copy frames from the FIFO to the buffers of the guest */
+        void deliver();
+
+        std::string
+        name() const
+        {
+            return csprintf("%s.rxQueue%d", parent.name(), idx);
+        }
+
+        /** Frames waiting for buffers */
+        PacketFifo fifo;
+
+      protected:
+        const unsigned idx;
+        VirtIONet &parent;
+    };
+
+    class TxQueue : public VirtQueue
+    {
+      public:
+        TxQueue(PortProxy &proxy, ByteOrder bo, uint16_t size,
+                unsigned _idx, VirtIONet &_parent)
+            : VirtQueue(proxy, bo, size), idx(_idx), parent(_parent) {}
+
+        void onNotify() override { parent.transmit(); }
+
+        std::string
+        name() const
+        {
+            return csprintf("%s.txQueue%d", parent.name(), idx);
+        }
+
+      protected:
+        const unsigned idx;
+        VirtIONet &parent;
+    };
+
+    class CtrlQueue : public VirtQueue
+    {
+      public:
+        CtrlQueue(PortProxy &proxy, ByteOrder bo, uint16_t size,
+                  VirtIONet &_parent)
+            : VirtQueue(proxy, bo, size), parent(_parent) {}
+
+        void onNotifyDescriptor(VirtDescriptor *desc) override;
+
+        std::string name() const { return parent.name() + ".ctrlQueue"; }
+
+      protected:
+        VirtIONet &parent;
+    };
+
+    std::vector<std::unique_ptr<RxQueue>> rxQueues;
+    std::vector<std::unique_ptr<TxQueue>> txQueues;
+    std::unique_ptr<CtrlQueue> ctrlQueue;
+
+    /** Number of queue pairs the guest uses */
+    unsigned activePairs;
+    /** Transmit queue to take the next frame from */
+    unsigned txNext;
+    /** Frame the link hasn't accepted yet */
+    EthPacketPtr txPacket;
+
+    /** Send frames until the link or the transmit queues run out */
+    void transmit();
+
+    /** Pair of queues a received frame belongs to */
+    unsigned steer(const EthPacketPtr &packet) const;
+
+    struct NetStats : public statistics::Group
+    {
+        NetStats(statistics::Group *parent);
+
+        statistics::Scalar txBytes;
+        statistics::Scalar rxBytes;
+        statistics::Scalar txPackets;
+        statistics::Scalar rxPackets;
+        statistics::Scalar rxDrops;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __DEV_VIRTIO_NET_HH__
@@ -236,10 +236,27 @@ class ComputeUnit(ClockedObject):
     execPolicy = Param.String("OLDEST-FIRST", "WF execution selection policy")
     debugSegFault = Param.Bool(False, "enable debugging GPU seg faults")
     functionalTLB = Param.Bool(False, "Assume TLB causes no delay")
+    idle_skip = Param.Bool(
+        False,
+        "Stop ticking while all waves are waiting on memory and the "
+        "pipeline is empty, and wake up on dispatch or memory responses",
+    )
 
     localMemBarrier = Param.Bool(
         False, "Assume Barriers do not wait on kernel end"
     )
+    merge_lane_requests = Param.Bool(
+        False,
+        "Send the accesses of consecutive lanes of a vector memory "
+        "instruction to consecutive bytes of the same cache line as a "
+        "single request",
+    )
+    translate_pages_once = Param.Bool(
+        False,
+        "Send one translation request per page a vector memory "
+        "instruction accesses, and translate the other requests of the "
+        "instruction to that page when it returns",
+    )
 
     countPages = Param.Bool(
         False,
@@ -364,6 +381,24 @@ class GPUCommandProcessor(DmaVirtDevice):
         0,
         "Skip kernels until reaching this kernel (counting only non-blit kernels)",
     )
+    functional_kernel_ids = VectorParam.Int(
+        [],
+        "Kernels (counting only non-blit kernels) whose memory accesses are "
+        "functional, bypassing the TLBs and the Ruby GPU protocol, for "
+        "fast-forwarding to the kernels of interest",
+    )
+    kernel_object_cache_size = Param.Unsigned(
+        0,
+        "Number of kernel code descriptors kept by the CP so that dispatches "
+        "of a recently dispatched kernel skip reading its code object from "
+        "memory. Assumes code objects are not rewritten in place. 0 disables "
+        "the cache",
+    )
+    cache_queue_desc_offset = Param.Bool(
+        False,
+        "Read the offset of the queue descriptor from its read pointer once "
+        "per queue instead of once per dispatch",
+    )
 
 
 class StorageClassType(Enum):
@@ -98,6 +98,11 @@ ComputeUnit::ComputeUnit(const Params &p) : ClockedObject(p),
     prefetchStride(p.prefetch_stride), prefetchType(p.prefetch_prev_type),
     debugSegFault(p.debugSegFault),
     functionalTLB(p.functionalTLB), localMemBarrier(p.localMemBarrier),
+    mergeLaneRequests(p.merge_lane_requests),
+    translatePagesOnce(p.translate_pages_once),
+    scheduledAddEvent([this]{ execScheduledAdds(); },
+          "Compute unit scheduled adds event", false, Event::CPU_Tick_Pri),
+    idleSkip(p.idle_skip),
     countPages(p.countPages),
     req_tick_latency(p.mem_req_latency * p.clk_domain->clockPeriod()),
     resp_tick_latency(p.mem_resp_latency * p.clk_domain->clockPeriod()),
@@ -337,6 +342,7 @@ ComputeUnit::startWavefront(Wavefront *w, int waveId, LdsChunk *ldsChunk,
     w->execMask() = init_mask;
 
     w->kernId = task->dispatchId();
+    w->functionalMem = task->functional();
     w->wfId = waveId;
     w->initMask = init_mask.to_ullong();
 
@@ -462,7 +468,9 @@ void
 ComputeUnit::dispWorkgroup(HSAQueueEntry *task, int num_wfs_in_wg)
 {
     // If we aren't ticking, start it up!
-    if (!tickEvent.scheduled()) {
+    if (sleepingWhileIdle) {
+        wakeFromIdle();
+    } else if (!tickEvent.scheduled()) {
         DPRINTF(GPUDisp, "CU%d: Scheduling wakeup next cycle\n", cu_id);
         schedule(tickEvent, nextCycle());
     }
@@ -782,12 +790,69 @@ ComputeUnit::exec()
     stats.totalCycles++;
 
     // Put this CU to sleep if there is no more work to be done.
-    if (!isDone()) {
-        schedule(tickEvent, nextCycle());
-    } else {
+    if (isDone()) {
         shader->notifyCuSleep();
         DPRINTF(GPUDisp, "CU%d: Going to sleep\n", cu_id);
+    } else if (idleSkip && isIdle()) {
+        // The CU still has work, but it can only continue once memory
+        // responds. Stop ticking until then.
+        sleepingWhileIdle = true;
+        idleSince = nextCycle();
+        DPRINTF(GPUDisp, "CU%d: Waiting for memory while idle\n", cu_id);
+    } else {
+        schedule(tickEvent, nextCycle());
+    }
+}
+
+void
+ComputeUnit::ScheduleAdd(int *val, Tick delay, int x)
+{
+    const Tick when = curTick() + delay;
+    scheduledAdds.push({when, val, x});
+    if (!scheduledAddEvent.scheduled() || when < scheduledAddEvent.when()) {
+        DPRINTF(GPUDisp, "CU%d: New scheduled add; wakeup at %lu\n",
+                cu_id, when);
+        reschedule(scheduledAddEvent, when, true);
+    }
+}
+
+void
+ComputeUnit::execScheduledAdds()
+{
+    assert(!scheduledAdds.empty());
+
+    while (!scheduledAdds.empty() && scheduledAdds.top().when <= curTick()) {
+        const ScheduledAdd &add = scheduledAdds.top();
+        *add.val += add.x;
+        panic_if(*add.val < 0, "Negative counter value\n");
+        scheduledAdds.pop();
+    }
+
+    if (!scheduledAdds.empty()) {
+        schedule(scheduledAddEvent, scheduledAdds.top().when);
     }
+
+    wakeFromIdle();
+}
+
+void
+ComputeUnit::wakeFromIdle()
+{
+    if (!sleepingWhileIdle)
+        return;
+
+    sleepingWhileIdle = false;
+    const Tick next = nextCycle();
+    assert(next >= idleSince);
+
+    // Account for the cycles we skipped as if we had ticked through them
+    const Cycles skipped((next - idleSince) / clockPeriod());
+    stats.totalCycles += skipped;
+    stats.idleSkippedCycles += skipped;
+
+    DPRINTF(GPUDisp, "CU%d: Waking up after %d idle cycles\n", cu_id,
+            skipped);
+    schedule(tickEvent, next);
 }
 
 void
@@ -839,6 +904,15 @@ ComputeUnit::init()
     gmTokenPort.setTokenManager(memPortTokens);
 }
 
+void
+ComputeUnit::regProbePoints()
+{
+    ppMemRequest = new ProbePointArg<MemRequestInfo>(getProbeManager(),
+                                                     "MemRequest");
+    ppBarrier = new ProbePointArg<Wavefront *>(getProbeManager(),
+                                               "Barrier");
+}
+
 bool
 ComputeUnit::DataPort::recvTimingResp(PacketPtr pkt)
 {
@@ -932,7 +1006,7 @@ ComputeUnit::DataPort::handleResponse(PacketPtr pkt)
         return true;
     }
 
-    EventFunctionWrapper *mem_resp_event =
+    Event *mem_resp_event =
         computeUnit->memPort[index].createMemRespEvent(pkt);
 
     DPRINTF(GPUPort,
@@ -957,6 +1031,8 @@ ComputeUnit::ScalarDataPort::handleResponse(PacketPtr pkt)
 {
     assert(!pkt->req->isKernel());
 
+    computeUnit->wakeFromIdle();
+
     // retrieve sender state
     SenderState *sender_state = safe_cast<SenderState*>(pkt->senderState);
     GPUDynInstPtr gpuDynInst = sender_state->_gpuDynInst;
@@ -1047,6 +1123,7 @@ ComputeUnit::SQCPort::recvTimingResp(PacketPtr pkt)
 void
 ComputeUnit::handleSQCReturn(PacketPtr pkt)
 {
+    wakeFromIdle();
     fetchStage.processFetchReturn(pkt);
 }
 
@@ -1136,14 +1213,49 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt)
         fatal("pkt is not a read nor a write\n");
     }
 
-    if (!functionalTLB) {
+    // Functional accesses don't wait for the TLB
+    const bool timing = shader->timingSim &&
+        !gpuDynInst->wavefront()->functionalMem;
+
+    if (!functionalTLB && timing) {
         stats.tlbCycles -= curTick();
     }
     ++stats.tlbRequests;
 
     PortID tlbPort_index = perLaneTLB ? index : 0;
 
-    if (shader->timingSim) {
+    // With translatePagesOnce, only the first request of the instruction
+    // to a page is sent to the TLB. The others wait for its translation.
+    if (timing && translatePagesOnce && !functionalTLB) {
+        const Addr vpage = roundDown(tmp_vaddr, X86ISA::PageBytes);
+        auto *translation = gpuDynInst->findPageTranslation(vpage);
+
+        if (translation && translation->done) {
+            stats.tlbCycles += curTick();
+            stats.hitsPerTLBLevel[translation->hitLevel]++;
+            gpuDynInst->tlbHitLevel[index] = translation->hitLevel;
+
+            pkt->req->setPaddr(translation->ppage |
+                               (tmp_vaddr & (X86ISA::PageBytes - 1)));
+            if (translation->uncacheable)
+                pkt->req->setFlags(Request::UNCACHEABLE);
+            pkt->req->setSystemReq(translation->systemReq);
+
+            sendTranslatedRequest(gpuDynInst, index, pkt);
+            return;
+        } else if (translation) {
+            DPRINTF(GPUTLB, "CU%d: WF[%d][%d]: Translation for addr %#x "
+                    "waits for page %#x\n", cu_id, gpuDynInst->simdId,
+                    gpuDynInst->wfSlotId, tmp_vaddr, vpage);
+            translation->waiting.emplace_back(pkt, index);
+            return;
+        }
+
+        gpuDynInst->pageTranslations.emplace_back();
+        gpuDynInst->pageTranslations.back().vpage = vpage;
+    }
+
+    if (timing) {
         if (!FullSystem && debugSegFault) {
             Process *p = shader->gpuTc->getProcessPtr();
             Addr vaddr = pkt->req->getVaddr();
@@ -1218,7 +1330,7 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt)
 
             // translation is done. Schedule the mem_req_event at the
             // appropriate cycle to send the timing memory request to ruby
-            EventFunctionWrapper *mem_req_event =
+            Event *mem_req_event =
                 memPort[index].createMemReqEvent(pkt);
 
             DPRINTF(GPUPort, "CU%d: WF[%d][%d]: index %d, addr %#x data "
@@ -1301,6 +1413,30 @@ ComputeUnit::sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt)
 
     BaseMMU::Mode tlb_mode = pkt->isRead() ? BaseMMU::Read : BaseMMU::Write;
 
+    if (gpuDynInst->wavefront()->functionalMem) {
+        // Translate and access memory right away, then complete the
+        // request as if its response had come back
+        pkt->senderState = new GpuTranslationState(tlb_mode, shader->gpuTc);
+        scalarDTLBPort.sendFunctional(pkt);
+
+        GpuTranslationState *translation_state =
+            safe_cast<GpuTranslationState*>(pkt->senderState);
+        fatal_if(!translation_state->tlbEntry,
+                 "Translation of vaddr %#x failed\n", pkt->req->getVaddr());
+        delete translation_state->tlbEntry;
+        delete translation_state;
+
+        PacketPtr req_pkt = new Packet(pkt->req, pkt->cmd);
+        req_pkt->dataStatic(pkt->getPtr<uint8_t>());
+        delete pkt;
+
+        req_pkt->senderState =
+            new ComputeUnit::ScalarDataPort::SenderState(gpuDynInst);
+        scalarDataPort.sendFunctional(req_pkt);
+        scalarDataPort.handleResponse(req_pkt);
+        return;
+    }
+
     pkt->senderState =
         new ComputeUnit::ScalarDTLBPort::SenderState(gpuDynInst);
 
@@ -1332,7 +1468,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
     // Fences will never be issued to system memory, so we can mark the
     // requestor as a device memory ID here.
     if (!req) {
-        req = std::make_shared<Request>(
+        req = makeRequest(
             0, 0, 0, vramRequestorId(), 0, gpuDynInst->wfDynId);
     } else {
         req->requestorId(vramRequestorId());
@@ -1352,7 +1488,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
             pkt->pushSenderState(
                new ComputeUnit::DataPort::SenderState(gpuDynInst, 0, nullptr));
 
-            EventFunctionWrapper *mem_req_event =
+            Event *mem_req_event =
               memPort[0].createMemReqEvent(pkt);
 
             DPRINTF(GPUPort, "CU%d: WF[%d][%d]: index %d, addr %#x scheduling "
@@ -1373,7 +1509,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
           pkt->pushSenderState(
              new ComputeUnit::DataPort::SenderState(gpuDynInst, 0, nullptr));
 
-          EventFunctionWrapper *mem_req_event =
+          Event *mem_req_event =
             memPort[0].createMemReqEvent(pkt);
 
           DPRINTF(GPUPort, "CU%d: WF[%d][%d]: index %d, addr %#x scheduling "
@@ -1391,7 +1527,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
         pkt->pushSenderState(
             new ComputeUnit::DataPort::SenderState(gpuDynInst, 0, nullptr));
 
-        EventFunctionWrapper *mem_req_event =
+        Event *mem_req_event =
           memPort[0].createMemReqEvent(pkt);
 
         DPRINTF(GPUPort,
@@ -1414,6 +1550,8 @@ ComputeUnit::DataPort::processMemRespEvent(PacketPtr pkt)
 
     assert(gpuDynInst);
 
+    compute_unit->wakeFromIdle();
+
     DPRINTF(GPUPort, "CU%d: WF[%d][%d]: Response for addr %#x, index %d\n",
             compute_unit->cu_id, gpuDynInst->simdId, gpuDynInst->wfSlotId,
             pkt->req->getPaddr(), id);
@@ -1533,9 +1671,12 @@ ComputeUnit::DTLBPort::recvTimingResp(PacketPtr pkt)
     GPUDynInstPtr gpuDynInst = sender_state->_gpuDynInst;
     PortID mp_index = sender_state->portIndex;
     Addr vaddr = pkt->req->getVaddr();
-    gpuDynInst->memStatusVector[line].push_back(mp_index);
     gpuDynInst->tlbHitLevel[mp_index] = hit_level;
 
+    if (computeUnit->translatePagesOnce && !computeUnit->functionalTLB) {
+        computeUnit->completePageTranslation(gpuDynInst, pkt, hit_level);
+    }
+
     MemCmd requestCmd;
 
     if (pkt->cmd == MemCmd::ReadResp) {
@@ -1596,7 +1737,7 @@ ComputeUnit::DTLBPort::recvTimingResp(PacketPtr pkt)
             if (!stride)
                 break;
 
-            RequestPtr prefetch_req = std::make_shared<Request>(
+            RequestPtr prefetch_req = makeRequest(
                 vaddr + stride * pf * X86ISA::PageBytes,
                 sizeof(uint8_t), 0,
                 computeUnit->requestorId(),
@@ -1633,6 +1774,51 @@ ComputeUnit::DTLBPort::recvTimingResp(PacketPtr pkt)
     delete pkt->senderState;
     delete pkt;
 
+    computeUnit->sendTranslatedRequest(gpuDynInst, mp_index, new_pkt);
+
+    return true;
+}
+
+void
+ComputeUnit::completePageTranslation(GPUDynInstPtr gpuDynInst,
+                                     const PacketPtr translated,
+                                     int hit_level)
+{
+    const Addr vaddr = translated->req->getVaddr();
+    auto *translation = gpuDynInst->findPageTranslation(
+        roundDown(vaddr, X86ISA::PageBytes));
+    assert(translation && !translation->done);
+
+    translation->done = true;
+    translation->ppage = roundDown(translated->req->getPaddr(),
+                                   X86ISA::PageBytes);
+    translation->uncacheable = translated->req->isUncacheable();
+    translation->systemReq = translated->req->systemReq();
+    translation->hitLevel = hit_level;
+
+    for (auto &[pkt, index] : translation->waiting) {
+        stats.tlbCycles += curTick();
+        stats.hitsPerTLBLevel[hit_level]++;
+        gpuDynInst->tlbHitLevel[index] = hit_level;
+
+        pkt->req->setPaddr(translation->ppage |
+                           (pkt->req->getVaddr() & (X86ISA::PageBytes - 1)));
+        if (translation->uncacheable)
+            pkt->req->setFlags(Request::UNCACHEABLE);
+        pkt->req->setSystemReq(translation->systemReq);
+
+        sendTranslatedRequest(gpuDynInst, index, pkt);
+    }
+    translation->waiting.clear();
+}
+
+void
+ComputeUnit::sendTranslatedRequest(GPUDynInstPtr gpuDynInst,
+                                   PortID mp_index, PacketPtr new_pkt)
+{
+    gpuDynInst->memStatusVector[new_pkt->req->getPaddr()].push_back(
+        mp_index);
+
     // New SenderState for the memory access
     new_pkt->senderState =
             new ComputeUnit::DataPort::SenderState(gpuDynInst, mp_index,
@@ -1649,42 +1835,34 @@ ComputeUnit::DTLBPort::recvTimingResp(PacketPtr pkt)
         // the token acquired when the dispatch list is filled as system
         // requests do not require a GPU coalescer token.
         if (!gpuDynInst->isSystemReq()) {
-            computeUnit->getTokenManager()->recvTokens(1);
+            getTokenManager()->recvTokens(1);
             gpuDynInst->setSystemReq();
         }
     } else {
-        new_pkt->req->requestorId(computeUnit->vramRequestorId());
+        new_pkt->req->requestorId(vramRequestorId());
     }
 
     // translation is done. Schedule the mem_req_event at the appropriate
     // cycle to send the timing memory request to ruby
-    EventFunctionWrapper *mem_req_event =
-        computeUnit->memPort[mp_index].createMemReqEvent(new_pkt);
+    Event *mem_req_event = memPort[mp_index].createMemReqEvent(new_pkt);
 
     DPRINTF(GPUPort, "CU%d: WF[%d][%d]: index %d, addr %#x data scheduled\n",
-            computeUnit->cu_id, gpuDynInst->simdId,
+            cu_id, gpuDynInst->simdId,
             gpuDynInst->wfSlotId, mp_index, new_pkt->req->getPaddr());
 
-    computeUnit->schedule(mem_req_event, curTick() +
-                          computeUnit->req_tick_latency);
-
-    return true;
+    schedule(mem_req_event, curTick() + req_tick_latency);
 }
 
-EventFunctionWrapper*
+Event*
 ComputeUnit::DataPort::createMemReqEvent(PacketPtr pkt)
 {
-    return new EventFunctionWrapper(
-        [this, pkt]{ processMemReqEvent(pkt); },
-        "ComputeUnit memory request event", true);
+    return new OneShotEvent([this, pkt]{ processMemReqEvent(pkt); });
 }
 
-EventFunctionWrapper*
+Event*
 ComputeUnit::DataPort::createMemRespEvent(PacketPtr pkt)
 {
-    return new EventFunctionWrapper(
-        [this, pkt]{ processMemRespEvent(pkt); },
-        "ComputeUnit memory response event", true);
+    return new OneShotEvent([this, pkt]{ processMemRespEvent(pkt); });
 }
 
 void
@@ -1694,6 +1872,8 @@ ComputeUnit::DataPort::processMemReqEvent(PacketPtr pkt)
     GPUDynInstPtr gpuDynInst = sender_state->_gpuDynInst;
     [[maybe_unused]] ComputeUnit *compute_unit = computeUnit;
 
+    compute_unit->ppMemRequest->notify({gpuDynInst, pkt});
+
     if (pkt->req->systemReq()) {
         assert(compute_unit->shader->systemHub);
         SystemHubEvent *resp_event = new SystemHubEvent(pkt, this);
@@ -1727,6 +1907,8 @@ ComputeUnit::ScalarDataPort::MemReqEvent::process()
     GPUDynInstPtr gpuDynInst = sender_state->_gpuDynInst;
     [[maybe_unused]] ComputeUnit *compute_unit = scalarDataPort.computeUnit;
 
+    compute_unit->ppMemRequest->notify({gpuDynInst, pkt});
+
     if (pkt->req->systemReq()) {
         assert(compute_unit->shader->systemHub);
         SystemHubEvent *resp_event = new SystemHubEvent(pkt, &scalarDataPort);
@@ -2085,6 +2267,12 @@ ComputeUnit::isDone() const
         }
     }
 
+    return memPipesReady();
+}
+
+bool
+ComputeUnit::memPipesReady() const
+{
     // TODO: FIXME if more than 1 of any memory pipe supported
     if (!srfToScalarMemPipeBus.rdy()) {
         return false;
@@ -2113,6 +2301,30 @@ ComputeUnit::getRefCounter(const uint32_t dispatchId,
     return lds.getRefCounter(dispatchId, wgId);
 }
 
+bool
+ComputeUnit::isIdle() const
+{
+    for (int i = 0; i < numVectorALUs; ++i) {
+        for (int i_wf = 0; i_wf < shader->n_wf; ++i_wf) {
+            const Wavefront *wf = wfList[i][i_wf];
+            if (wf->getStatus() != Wavefront::S_STOPPED &&
+                !wf->waitingOnMemory()) {
+                return false;
+            }
+        }
+    }
+
+    for (int unit = 0; unit < numExeUnits(); ++unit) {
+        if (scheduleToExecute.dispatchStatus(unit) != EMPTY) {
+            return false;
+        }
+    }
+
+    return memPipesReady() && fetchStage.isIdle() &&
+        scheduleStage.isIdle() && globalMemoryPipe.isIdle() &&
+        localMemoryPipe.isIdle() && scalarMemoryPipe.isIdle();
+}
+
 bool
 ComputeUnit::isVectorAluIdle(uint32_t simdId) const
 {
@@ -2137,7 +2349,7 @@ ComputeUnit::sendToLds(GPUDynInstPtr gpuDynInst)
 {
     // this is just a request to carry the GPUDynInstPtr
     // back and forth
-    RequestPtr newRequest = std::make_shared<Request>();
+    RequestPtr newRequest = makeRequest();
     newRequest->setPaddr(0x0);
 
     // ReadReq is not evaluted by the LDS but the Packet ctor requires this
@@ -2175,6 +2387,7 @@ ComputeUnit::LDSPort::recvTimingResp(PacketPtr packet)
     delete packet;
 
     computeUnit->localMemoryPipe.getLMRespFIFO().push(gpuDynInst);
+    computeUnit->wakeFromIdle();
     return true;
 }
 
@@ -2403,6 +2616,8 @@ ComputeUnit::ComputeUnitStats::ComputeUnitStats(statistics::Group *parent,
       ADD_STAT(numVecOpsExecutedTwoOpFP,
                "number of two op FP vec ops executed (e.g. WF size/inst)"),
       ADD_STAT(totalCycles, "number of cycles the CU ran for"),
+      ADD_STAT(idleSkippedCycles, "number of cycles the CU didn't tick "
+               "because all its waves were waiting for memory"),
       ADD_STAT(vpc, "Vector Operations per cycle (this CU only)"),
       ADD_STAT(vpc_f16, "F16 Vector Operations per cycle (this CU only)"),
       ADD_STAT(vpc_f32, "F32 Vector Operations per cycle (this CU only)"),
@@ -34,6 +34,7 @@
 
 #include <deque>
 #include <map>
+#include <queue>
 #include <unordered_set>
 #include <vector>
 
@@ -57,6 +58,7 @@
 #include "mem/port.hh"
 #include "mem/token_port.hh"
 #include "sim/clocked_object.hh"
+#include "sim/probe/probe.hh"
 
 namespace gem5
 {
@@ -288,6 +290,13 @@ class ComputeUnit : public ClockedObject
 
     EventFunctionWrapper tickEvent;
 
+    /**
+     * Add x to the counter val delay Ticks from now. The memory pipelines
+     * use this to retire their outstanding request counters once the
+     * data has been written back.
+     */
+    void ScheduleAdd(int *val, Tick delay, int x);
+
     typedef ComputeUnitParams Params;
     std::vector<std::vector<Wavefront*>> wfList;
     int cu_id;
@@ -349,6 +358,46 @@ class ComputeUnit : public ClockedObject
     int idleWfs;
     bool functionalTLB;
     bool localMemBarrier;
+    /**
+     * Consecutive lanes of a vector memory instruction accessing
+     * consecutive bytes of a cache line share a single request, see
+     * initMemReqHelper()
+     */
+    const bool mergeLaneRequests;
+    /**
+     * Translate each page a vector memory instruction accesses once,
+     * rather than once per request
+     */
+    const bool translatePagesOnce;
+
+    struct ScheduledAdd
+    {
+        Tick when;
+        int *val;
+        int x;
+
+        bool operator>(const ScheduledAdd &other) const
+        {
+            return when > other.when;
+        }
+    };
+
+    /**
+     * Adds which are not due yet, earliest first. They are kept by each
+     * CU rather than by the shader so that the CUs share no state through
+     * their memory pipelines.
+     */
+    std::priority_queue<ScheduledAdd, std::vector<ScheduledAdd>,
+                        std::greater<ScheduledAdd>> scheduledAdds;
+    EventFunctionWrapper scheduledAddEvent;
+    void execScheduledAdds();
+
+    /** Stop ticking while idle, see isIdle() */
+    const bool idleSkip;
+    /** The tick event was not rescheduled because the CU was idle */
+    bool sleepingWhileIdle = false;
+    /** First tick which was skipped while idle */
+    Tick idleSince = 0;
 
     /*
      * for Counting page accesses
@@ -456,7 +505,36 @@ class ComputeUnit : public ClockedObject
     void doSmReturn(GPUDynInstPtr gpuDynInst);
 
     virtual void init() override;
+    void regProbePoints() override;
+
+    /** Argument of the MemRequest probe point */
+    struct MemRequestInfo
+    {
+        GPUDynInstPtr gpuDynInst;
+        PacketPtr pkt;
+    };
+
+    /**
+     * Notified with each vector or scalar data request, once translated,
+     * when it is first sent to the memory system.
+     */
+    ProbePointArg<MemRequestInfo> *ppMemRequest;
+    /** Notified when a wavefront arrives at a barrier */
+    ProbePointArg<Wavefront *> *ppBarrier;
+
     void sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt);
+    /**
+     * Send a request whose translation is done to memory through the
+     * data port of lane index.
+     */
+    void sendTranslatedRequest(GPUDynInstPtr gpuDynInst, PortID index,
+                               PacketPtr pkt);
+    /**
+     * Translate the requests waiting for the translation of a page by
+     * another request of the same instruction, and send them.
+     */
+    void completePageTranslation(GPUDynInstPtr gpuDynInst,
+                                 const PacketPtr translated, int hit_level);
     void sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt);
     void injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
                               bool kernelMemSync,
@@ -472,9 +550,27 @@ class ComputeUnit : public ClockedObject
     bool isDone() const;
     bool isVectorAluIdle(uint32_t simdId) const;
 
+    /**
+     * Whether ticking would not make any progress until a memory
+     * response arrives: the waves are either stopped or waiting for
+     * outstanding memory operations at an s_waitcnt, and no stage has
+     * any work queued up.
+     */
+    bool isIdle() const;
+
+    /**
+     * Start ticking again if the CU stopped because it was idle. This
+     * is called whenever something which may let a wave make progress
+     * arrives at the CU.
+     */
+    void wakeFromIdle();
+
     void handleSQCReturn(PacketPtr pkt);
 
   protected:
+    /** The memory pipelines and the busses to and from them are free */
+    bool memPipesReady() const;
+
     RequestorID _requestorId;
 
     LdsState &lds;
@@ -561,10 +657,10 @@ class ComputeUnit : public ClockedObject
         };
 
         void processMemReqEvent(PacketPtr pkt);
-        EventFunctionWrapper *createMemReqEvent(PacketPtr pkt);
+        Event *createMemReqEvent(PacketPtr pkt);
 
         void processMemRespEvent(PacketPtr pkt);
-        EventFunctionWrapper *createMemRespEvent(PacketPtr pkt);
+        Event *createMemRespEvent(PacketPtr pkt);
 
         std::deque<std::pair<PacketPtr, GPUDynInstPtr>> retries;
 
@@ -1135,6 +1231,8 @@ class ComputeUnit : public ClockedObject
         statistics::Scalar numVecOpsExecutedTwoOpFP;
         // Total cycles that something is running on the GPU
         statistics::Scalar totalCycles;
+        // Cycles in totalCycles which were skipped because the CU was idle
+        statistics::Scalar idleSkippedCycles;
         statistics::Formula vpc; // vector ops per cycle
         statistics::Formula vpc_f16; // vector ops per cycle
         statistics::Formula vpc_f32; // vector ops per cycle
@@ -61,6 +61,16 @@ FetchStage::init()
     }
 }
 
+bool
+FetchStage::isIdle() const
+{
+    for (const auto &fetch_unit : _fetchUnit) {
+        if (!fetch_unit.isIdle())
+            return false;
+    }
+    return true;
+}
+
 void
 FetchStage::exec()
 {
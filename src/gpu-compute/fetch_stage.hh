@@ -58,6 +58,8 @@ class FetchStage
     ~FetchStage();
     void init();
     void exec();
+    /** None of the fetch units has work to do, see FetchUnit::isIdle() */
+    bool isIdle() const;
     void processFetchReturn(PacketPtr pkt);
     void fetch(PacketPtr pkt, Wavefront *wave);
 
@@ -132,6 +132,31 @@ FetchUnit::exec()
     }
 }
 
+bool
+FetchUnit::isIdle() const
+{
+    if (!fetchQueue.empty())
+        return false;
+
+    for (const auto &fetch_buf : fetchBuf) {
+        if (fetch_buf.canDecode())
+            return false;
+    }
+
+    for (int j = 0; j < computeUnit.shader->n_wf; ++j) {
+        const Wavefront *wave = fetchStatusQueue[j].first;
+        if (!fetchStatusQueue[j].second &&
+            (wave->getStatus() == Wavefront::S_RUNNING ||
+             wave->getStatus() == Wavefront::S_WAITCNT) &&
+            fetchBuf[j].hasFreeSpace() && !wave->stopFetch() &&
+            !wave->pendingFetch) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void
 FetchUnit::initiateFetch(Wavefront *wavefront)
 {
@@ -162,13 +187,13 @@ FetchUnit::initiateFetch(Wavefront *wavefront)
             computeUnit.cu_id, wavefront->simdId, wavefront->wfSlotId, vaddr);
 
     // set up virtual request
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         vaddr, computeUnit.cacheLineSize(), Request::INST_FETCH,
         computeUnit.requestorId(), 0, 0, nullptr);
 
     PacketPtr pkt = new Packet(req, MemCmd::ReadReq);
 
-    if (timingSim) {
+    if (timingSim && !wavefront->functionalMem) {
         // SenderState needed on Return
         pkt->senderState = new ComputeUnit::ITLBPort::SenderState(wavefront);
 
@@ -278,7 +303,7 @@ FetchUnit::fetch(PacketPtr pkt, Wavefront *wavefront)
     // New SenderState for the memory access
     pkt->senderState = new ComputeUnit::SQCPort::SenderState(wavefront);
 
-    if (timingSim) {
+    if (timingSim && !wavefront->functionalMem) {
         // translation is done. Send the appropriate timing memory request.
 
         if (pkt->req->systemReq()) {
@@ -514,6 +539,13 @@ FetchUnit::FetchBufDesc::hasFetchDataToProcess() const
     return fetchBytesRemaining() >= sizeof(TheGpuISA::RawMachInst);
 }
 
+bool
+FetchUnit::FetchBufDesc::canDecode() const
+{
+    return hasFetchDataToProcess() &&
+        wavefront->instructionBuffer.size() < maxIbSize;
+}
+
 void
 FetchUnit::FetchBufDesc::checkWaveReleaseBuf()
 {
@@ -59,6 +59,11 @@ class FetchUnit
     ~FetchUnit();
     void init();
     void exec();
+    /**
+     * Ticking the fetch unit would neither decode any instruction nor
+     * start any fetch until a fetch returns or a wave makes progress.
+     */
+    bool isIdle() const;
     void bindWaveList(std::vector<Wavefront*> *list);
     void initiateFetch(Wavefront *wavefront);
     void fetch(PacketPtr pkt, Wavefront *wavefront);
@@ -147,6 +152,12 @@ class FetchUnit
          */
         bool hasFetchDataToProcess() const;
 
+        /**
+         * checks if there is data to decode and room for it in the
+         * WF's IB.
+         */
+        bool canDecode() const;
+
         /**
          * each time the fetch stage is ticked, we check if there
          * are any data in the fetch buffer that may be decoded and
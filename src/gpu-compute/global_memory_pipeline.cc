@@ -150,16 +150,16 @@ GlobalMemPipeline::exec()
         Tick accessTime = curTick() - m->getAccessTime();
 
         // Decrement outstanding requests count
-        computeUnit.shader->ScheduleAdd(&w->outstandingReqs, m->time, -1);
+        computeUnit.ScheduleAdd(&w->outstandingReqs, m->time, -1);
         if (m->isStore() || m->isAtomic() || m->isMemSync()) {
             computeUnit.shader->sampleStore(accessTime);
-            computeUnit.shader->ScheduleAdd(&w->outstandingReqsWrGm,
+            computeUnit.ScheduleAdd(&w->outstandingReqsWrGm,
                                              m->time, -1);
         }
 
         if (m->isLoad() || m->isAtomic() || m->isMemSync()) {
             computeUnit.shader->sampleLoad(accessTime);
-            computeUnit.shader->ScheduleAdd(&w->outstandingReqsRdGm,
+            computeUnit.ScheduleAdd(&w->outstandingReqsRdGm,
                                              m->time, -1);
         }
 
@@ -310,6 +310,7 @@ GlobalMemPipeline::handleResponse(GPUDynInstPtr gpuDynInst)
     // buffer
     assert(mem_req != gmOrderedRespBuffer.end());
     mem_req->second.second = true;
+    computeUnit.wakeFromIdle();
 }
 
 GlobalMemPipeline::
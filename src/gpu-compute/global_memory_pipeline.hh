@@ -62,6 +62,16 @@ class GlobalMemPipeline
     GlobalMemPipeline(const ComputeUnitParams &p, ComputeUnit &cu);
     void init();
     void exec();
+    /**
+     * No request is waiting to be issued, and the oldest one in flight,
+     * if any, hasn't got its response yet.
+     */
+    bool
+    isIdle() const
+    {
+        return gmIssuedRequests.empty() && (gmOrderedRespBuffer.empty() ||
+            !gmOrderedRespBuffer.begin()->second.second);
+    }
 
     /**
      * Find the next ready response to service. In order to ensure
@@ -58,7 +58,11 @@ namespace gem5
 GPUCommandProcessor::GPUCommandProcessor(const Params &p)
     : DmaVirtDevice(p), dispatcher(*p.dispatcher), _driver(nullptr),
       walker(p.walker), hsaPP(p.hsapp),
-      target_non_blit_kernel_id(p.target_non_blit_kernel_id)
+      target_non_blit_kernel_id(p.target_non_blit_kernel_id),
+      functionalKernelIds(p.functional_kernel_ids.begin(),
+                          p.functional_kernel_ids.end()),
+      kernelObjectCacheSize(p.kernel_object_cache_size),
+      cacheQueueDescOffset(p.cache_queue_desc_offset)
 {
     assert(hsaPP);
     hsaPP->setDevice(this);
@@ -132,6 +136,13 @@ GPUCommandProcessor::submitDispatchPkt(void *raw_pkt, uint32_t queue_id,
      */
     AMDKernelCode *akc = new AMDKernelCode;
 
+    if (lookupKernelObject(disp_pkt->kernel_object, akc)) {
+        DPRINTF(GPUCommandProc, "kernel_object %#lx found in cache\n",
+                disp_pkt->kernel_object);
+        dispatchKernelObject(akc, raw_pkt, queue_id, host_pkt_addr);
+        return;
+    }
+
     /**
      * The kernel_object is a pointer to the machine code, whose entry
      * point is an 'amd_kernel_code_t' type, which is included in the
@@ -217,7 +228,7 @@ GPUCommandProcessor::submitDispatchPkt(void *raw_pkt, uint32_t queue_id,
                     dummy, BaseMMU::Mode::Read, is_system_page);
 
                 Request::Flags flags = Request::PHYSICAL;
-                RequestPtr request = std::make_shared<Request>(chunk_addr,
+                RequestPtr request = makeRequest(chunk_addr,
                     akc_alignment_granularity, flags,
                     walker->getDevRequestor());
                 Packet *readPkt = new Packet(request, MemCmd::ReadReq);
@@ -241,6 +252,7 @@ GPUCommandProcessor::dispatchKernelObject(AMDKernelCode *akc, void *raw_pkt,
     _hsa_dispatch_packet_t *disp_pkt = (_hsa_dispatch_packet_t*)raw_pkt;
 
     sanityCheckAKC(akc);
+    cacheKernelObject(disp_pkt->kernel_object, *akc);
 
     DPRINTF(GPUCommandProc, "GPU machine code is %lli bytes from start of the "
         "kernel object\n", akc->kernel_code_entry_byte_offset);
@@ -324,6 +336,13 @@ GPUCommandProcessor::dispatchKernelObject(AMDKernelCode *akc, void *raw_pkt,
         "LDS size: %d)\n", kernel_name, task->numVectorRegs(),
         task->numScalarRegs(), task->codeAddr(), 0, 0);
 
+    if (!is_blit_kernel && functionalKernelIds.count(non_blit_kernel_id)) {
+        DPRINTF(GPUCommandProc, "Running non-blit kernel %i (Task ID: %i) "
+                "with functional memory accesses\n", non_blit_kernel_id,
+                dynamic_task_id);
+        task->setFunctional(true);
+    }
+
     initABI(task);
     ++dynamic_task_id;
     if (!is_blit_kernel) ++non_blit_kernel_id;
@@ -331,6 +350,41 @@ GPUCommandProcessor::dispatchKernelObject(AMDKernelCode *akc, void *raw_pkt,
     delete akc;
 }
 
+bool
+GPUCommandProcessor::lookupKernelObject(Addr kernel_object,
+                                        AMDKernelCode *akc)
+{
+    auto it = kernelObjectCache.begin();
+    for (; it != kernelObjectCache.end(); ++it) {
+        if (it->first == kernel_object)
+            break;
+    }
+    if (it == kernelObjectCache.end())
+        return false;
+
+    *akc = it->second;
+    kernelObjectCache.splice(kernelObjectCache.begin(), kernelObjectCache,
+                             it);
+    return true;
+}
+
+void
+GPUCommandProcessor::cacheKernelObject(Addr kernel_object,
+                                       const AMDKernelCode &akc)
+{
+    if (!kernelObjectCacheSize)
+        return;
+
+    // A kernel found in the cache was moved to the front by the lookup.
+    if (!kernelObjectCache.empty() &&
+            kernelObjectCache.front().first == kernel_object)
+        return;
+
+    if (kernelObjectCache.size() == kernelObjectCacheSize)
+        kernelObjectCache.pop_back();
+    kernelObjectCache.emplace_front(kernel_object, akc);
+}
+
 void
 GPUCommandProcessor::sendCompletionSignal(Addr signal_handle)
 {
@@ -649,13 +703,25 @@ GPUCommandProcessor::signalWakeupEvent(uint32_t event_id)
 void
 GPUCommandProcessor::initABI(HSAQueueEntry *task)
 {
-    auto cb = new DmaVirtCallback<uint32_t>(
-        [ = ] (const uint32_t &readDispIdOffset)
-            { ReadDispIdOffsetDmaEvent(task, readDispIdOffset); }, 0);
-
     Addr hostReadIdxPtr
         = hsaPP->getQueueDesc(task->queueId())->hostReadIndexPtr;
 
+    if (cacheQueueDescOffset) {
+        auto it = queueDescOffsets.find(hostReadIdxPtr);
+        if (it != queueDescOffsets.end()) {
+            ReadDispIdOffsetDmaEvent(task, it->second);
+            return;
+        }
+    }
+
+    auto cb = new DmaVirtCallback<uint32_t>(
+        [ = ] (const uint32_t &readDispIdOffset)
+        {
+            if (cacheQueueDescOffset)
+                queueDescOffsets[hostReadIdxPtr] = readDispIdOffset;
+            ReadDispIdOffsetDmaEvent(task, readDispIdOffset);
+        }, 0);
+
     dmaReadVirt(hostReadIdxPtr + sizeof(hostReadIdxPtr),
         sizeof(uint32_t), cb, &cb->dmaBuffer);
 }
@@ -45,6 +45,10 @@
 
 #include <cstdint>
 #include <functional>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include "arch/amdgpu/vega/gpu_registers.hh"
 #include "base/logging.hh"
@@ -149,6 +153,8 @@ class GPUCommandProcessor : public DmaVirtDevice
     typedef void (DmaDevice::*DmaFnPtr)(Addr, int, Event*, uint8_t*, Tick);
     void initABI(HSAQueueEntry *task);
     void sanityCheckAKC(AMDKernelCode *akc);
+    bool lookupKernelObject(Addr kernel_object, AMDKernelCode *akc);
+    void cacheKernelObject(Addr kernel_object, const AMDKernelCode &akc);
     HSAPacketProcessor *hsaPP;
     TranslationGenPtr translate(Addr vaddr, Addr size) override;
 
@@ -161,6 +167,19 @@ class GPUCommandProcessor : public DmaVirtDevice
     // Skip all user (non-blit) kernels until reaching this kernel
     int target_non_blit_kernel_id = 0;
 
+    // User (non-blit) kernels whose memory accesses are functional
+    std::unordered_set<int> functionalKernelIds;
+
+    // Copies of the kernel code descriptors of recently dispatched kernels
+    // by kernel object address, most recently used first
+    const unsigned kernelObjectCacheSize;
+    std::list<std::pair<Addr, AMDKernelCode>> kernelObjectCache;
+
+    // Offsets of the queue descriptors from their read pointers, by read
+    // pointer address
+    const bool cacheQueueDescOffset;
+    std::unordered_map<Addr, uint32_t> queueDescOffsets;
+
     // Keep track of start times for task dispatches.
     std::unordered_map<Addr, Tick> dispatchStartTime;
 
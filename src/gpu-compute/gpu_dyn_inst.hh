@@ -461,6 +461,31 @@ class GPUDynInst : public GPUExecContext
     // for ld_v# or st_v#
     std::vector<int> tlbHitLevel;
 
+    // Translation of a virtual page accessed by this instruction when the
+    // CU translates each page only once, along with the requests waiting
+    // for it. See ComputeUnit::sendRequest().
+    struct PageTranslation
+    {
+        Addr vpage = 0;
+        bool done = false;
+        Addr ppage = 0;
+        bool uncacheable = false;
+        bool systemReq = false;
+        int hitLevel = 0;
+        std::vector<std::pair<PacketPtr, PortID>> waiting;
+    };
+    std::vector<PageTranslation> pageTranslations;
+
+    PageTranslation *
+    findPageTranslation(Addr vpage)
+    {
+        for (auto &translation : pageTranslations) {
+            if (translation.vpage == vpage)
+                return &translation;
+        }
+        return nullptr;
+    }
+
     // for misaligned scalar ops we track the number
     // of outstanding reqs here
     int numScalarReqs;
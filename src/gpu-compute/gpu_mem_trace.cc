@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gpu-compute/gpu_mem_trace.hh"
+
+#include "base/callback.hh"
+#include "base/output.hh"
+#include "gpu-compute/gpu_dyn_inst.hh"
+#include "gpu-compute/wavefront.hh"
+#include "params/GpuMemTrace.hh"
+#include "proto/gpu_mem_trace.pb.h"
+#include "sim/core.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+GpuMemTrace::GpuMemTrace(const GpuMemTraceParams &p)
+    : ProbeListenerObject(p),
+      computeUnit(dynamic_cast<ComputeUnit *>(p.manager)),
+      traceStream(nullptr)
+{
+    fatal_if(!computeUnit, "%s must be attached to a ComputeUnit\n", name());
+
+    std::string filename = p.trace_file;
+    if (filename.empty())
+        filename = name() + ".trc";
+    // Compress the trace unless told otherwise, see MemTraceProbe
+    const std::string suffix = ".gz";
+    if (p.trace_compress &&
+        (filename.size() < suffix.size() ||
+         filename.compare(filename.size() - suffix.size(), suffix.size(),
+                          suffix) != 0))
+        filename += suffix;
+
+    traceStream = new ProtoOutputStream(simout.resolve(filename));
+
+    registerExitCallback([this]() { closeStreams(); });
+}
+
+void
+GpuMemTrace::regProbeListeners()
+{
+    listeners.push_back(
+        new ProbeListenerArg<GpuMemTrace, ComputeUnit::MemRequestInfo>(
+            this, "MemRequest", &GpuMemTrace::traceRequest));
+    listeners.push_back(
+        new ProbeListenerArg<GpuMemTrace, Wavefront *>(
+            this, "Barrier", &GpuMemTrace::traceBarrier));
+}
+
+void
+GpuMemTrace::startup()
+{
+    ProtoMessage::GpuMemTraceHeader header_msg;
+    header_msg.set_obj_id(computeUnit->name());
+    header_msg.set_tick_freq(sim_clock::Frequency);
+    header_msg.set_cu_id(computeUnit->cu_id);
+    traceStream->write(header_msg);
+}
+
+void
+GpuMemTrace::closeStreams()
+{
+    delete traceStream;
+    traceStream = nullptr;
+}
+
+void
+GpuMemTrace::traceRequest(const ComputeUnit::MemRequestInfo &info)
+{
+    const GPUDynInstPtr &inst = info.gpuDynInst;
+    const RequestPtr &req = info.pkt->req;
+
+    ProtoMessage::GpuMemTraceRecord rec;
+    rec.set_type(ProtoMessage::GpuMemTraceRecord::REQUEST);
+    rec.set_tick(curTick());
+    rec.set_wf_id(inst->wfDynId);
+    rec.set_seq_num(inst->seqNum());
+    rec.set_cmd(info.pkt->cmd.toInt());
+    rec.set_addr(req->getPaddr());
+    rec.set_size(req->hasSize() ? req->getSize() : 0);
+    rec.set_flags(req->getFlags());
+    rec.set_coherence_flags(req->getCacheCoherenceFlags());
+    if (req->hasPC())
+        rec.set_pc(req->getPC());
+    rec.set_scalar(inst->isScalar());
+    rec.set_outstanding(inst->wavefront()->outstandingReqs);
+
+    traceStream->write(rec);
+}
+
+void
+GpuMemTrace::traceBarrier(Wavefront *const &wf)
+{
+    ProtoMessage::GpuMemTraceRecord rec;
+    rec.set_type(ProtoMessage::GpuMemTraceRecord::BARRIER);
+    rec.set_tick(curTick());
+    rec.set_wf_id(wf->wfDynId);
+    rec.set_wg_id((uint64_t)wf->dispatchId << 32 | wf->wgId);
+    rec.set_num_waves(computeUnit->maxBarrierCnt(wf->barrierId()));
+
+    traceStream->write(rec);
+}
+
+} // namespace gem5
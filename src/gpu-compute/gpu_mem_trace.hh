@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __GPU_COMPUTE_GPU_MEM_TRACE_HH__
+#define __GPU_COMPUTE_GPU_MEM_TRACE_HH__
+
+#include "gpu-compute/compute_unit.hh"
+#include "proto/protoio.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+struct GpuMemTraceParams;
+
+/**
+ * Listens to the probe points of a compute unit and writes the requests
+ * it sends to the memory system, and the barriers its wavefronts arrive
+ * at, to a protobuf trace (see proto/gpu_mem_trace.proto). The trace can
+ * be replayed without the shader pipeline by a GpuTracePlayer.
+ */
+class GpuMemTrace : public ProbeListenerObject
+{
+  public:
+    GpuMemTrace(const GpuMemTraceParams &params);
+
+    void regProbeListeners() override;
+
+    void startup() override;
+
+  private:
+    void traceRequest(const ComputeUnit::MemRequestInfo &info);
+    void traceBarrier(Wavefront *const &wf);
+
+    /**
+     * Callback to flush and close the output stream on exit, as the
+     * destructor is not called.
+     */
+    void closeStreams();
+
+    ComputeUnit *computeUnit;
+
+    /** Trace output stream */
+    ProtoOutputStream *traceStream;
+};
+
+} // namespace gem5
+
+#endif // __GPU_COMPUTE_GPU_MEM_TRACE_HH__
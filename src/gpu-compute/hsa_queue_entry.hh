@@ -209,6 +209,22 @@ class HSAQueueEntry
         return kernargAddress;
     }
 
+    /**
+     * Whether the memory accesses of this kernel bypass the timing memory
+     * system, see GPUCommandProcessor::functionalKernelIds
+     */
+    bool
+    functional() const
+    {
+        return _functional;
+    }
+
+    void
+    setFunctional(bool functional)
+    {
+        _functional = functional;
+    }
+
     int
     ldsSize() const
     {
@@ -469,6 +485,8 @@ class HSAQueueEntry
     Addr codeAddress;
     // base address of the kernel args
     Addr kernargAddress;
+    // the kernel's memory accesses are functional
+    bool _functional = false;
     /**
      * Number of outstanding invs for the kernel.
      * values:
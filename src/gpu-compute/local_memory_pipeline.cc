@@ -90,15 +90,15 @@ LocalMemPipeline::exec()
         }
 
         // Decrement outstanding request count
-        computeUnit.shader->ScheduleAdd(&w->outstandingReqs, m->time, -1);
+        computeUnit.ScheduleAdd(&w->outstandingReqs, m->time, -1);
 
         if (m->isStore() || m->isAtomic()) {
-            computeUnit.shader->ScheduleAdd(&w->outstandingReqsWrLm,
+            computeUnit.ScheduleAdd(&w->outstandingReqsWrLm,
                                              m->time, -1);
         }
 
         if (m->isLoad() || m->isAtomic()) {
-            computeUnit.shader->ScheduleAdd(&w->outstandingReqsRdLm,
+            computeUnit.ScheduleAdd(&w->outstandingReqsRdLm,
                                              m->time, -1);
         }
 
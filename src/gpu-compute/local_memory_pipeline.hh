@@ -59,6 +59,12 @@ class LocalMemPipeline
   public:
     LocalMemPipeline(const ComputeUnitParams &p, ComputeUnit &cu);
     void exec();
+    /** No request is waiting to be issued or completed */
+    bool
+    isIdle() const
+    {
+        return lmIssuedRequests.empty() && lmReturnedRequests.empty();
+    }
     std::queue<GPUDynInstPtr> &getLMRespFIFO() { return lmReturnedRequests; }
 
     void issueRequest(GPUDynInstPtr gpuDynInst);
@@ -54,6 +54,8 @@ RegisterFile::RegisterFile(const RegisterFileParams &p)
 
     busy.clear();
     busy.resize(_numRegs, 0);
+    busyTick.resize(_numRegs, 0);
+    freeTick.resize(_numRegs, MaxTick);
 }
 
 RegisterFile::~RegisterFile()
@@ -72,7 +74,7 @@ RegisterFile::dump() const
     std::stringstream ss;
     ss << "Busy: ";
     for (int i = 0; i < busy.size(); i++) {
-        ss << (int)busy[i];
+        ss << (int)regBusy(i);
     }
     ss << "\n";
     return ss.str();
@@ -89,33 +91,43 @@ RegisterFile::operandsReady(Wavefront *w, GPUDynInstPtr ii) const
 bool
 RegisterFile::regBusy(int idx) const
 {
-    return busy.at(idx);
+    return busy.at(idx) && !freePending(idx);
 }
 
 void
-RegisterFile::markReg(int regIdx, bool value)
+RegisterFile::updateBusy(int idx)
 {
-    DPRINTF(GPURF, "SIMD[%d] markReg(): physReg[%d] = %d\n",
-            simdId, regIdx, (int)value);
-    busy.at(regIdx) = value;
+    if (freePending(idx)) {
+        DPRINTF(GPURF, "SIMD[%d] markReg(): physReg[%d] = 0\n",
+                simdId, idx);
+        busy[idx] = false;
+    }
+    if (freeTick[idx] <= curTick()) {
+        freeTick[idx] = MaxTick;
+    }
 }
 
 void
-RegisterFile::enqRegFreeEvent(uint32_t regIdx, uint64_t delay)
+RegisterFile::markReg(int regIdx, bool value)
 {
-    DPRINTF(GPURF, "SIMD[%d] enqRegFreeEvent physReg[%d] at %llu\n",
-            simdId, regIdx, curTick() + delay);
-    schedule(new MarkRegFreeScbEvent(this, regIdx),
-             curTick() + delay);
+    updateBusy(regIdx);
+    DPRINTF(GPURF, "SIMD[%d] markReg(): physReg[%d] = %d\n",
+            simdId, regIdx, (int)value);
+    busy.at(regIdx) = value;
+    if (value) {
+        busyTick[regIdx] = curTick();
+    }
 }
 
 void
-RegisterFile::enqRegBusyEvent(uint32_t regIdx, uint64_t delay)
+RegisterFile::enqRegFree(uint32_t regIdx, uint64_t delay)
 {
-    DPRINTF(GPURF, "SIMD[%d] enqRegBusyEvent physReg[%d] at %llu\n",
+    DPRINTF(GPURF, "SIMD[%d] enqRegFree physReg[%d] at %llu\n",
             simdId, regIdx, curTick() + delay);
-    schedule(new MarkRegBusyScbEvent(this, regIdx),
-             curTick() + delay);
+    // The scoreboard does not let a busy register be written again, so
+    // at most one free is pending at a time once a due one is applied.
+    updateBusy(regIdx);
+    freeTick[regIdx] = curTick() + delay;
 }
 
 // Schedule functions
@@ -169,22 +181,6 @@ RegisterFile::waveExecuteInst(Wavefront *w, GPUDynInstPtr ii)
 {
 }
 
-// Events
-
-// Mark a register as free in the scoreboard/busy vector
-void
-RegisterFile::MarkRegFreeScbEvent::process()
-{
-    rf->markReg(regIdx, false);
-}
-
-// Mark a register as busy in the scoreboard/busy vector
-void
-RegisterFile::MarkRegBusyScbEvent::process()
-{
-    rf->markReg(regIdx, true);
-}
-
 void
 RegisterFile::dispatchInstruction(GPUDynInstPtr ii)
 {
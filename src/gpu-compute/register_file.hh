@@ -68,40 +68,10 @@ class RegisterFile : public SimObject
     virtual bool regBusy(int idx) const;
     virtual void markReg(int regIdx, bool value);
 
-    // Abstract Register Event
-    class RegisterEvent : public Event
-    {
-      protected:
-        RegisterFile *rf;
-        int regIdx;
-
-      public:
-        RegisterEvent(RegisterFile *_rf, int _regIdx)
-            : rf(_rf), regIdx(_regIdx) { setFlags(AutoDelete); }
-    };
-
-    // Register Event to mark a register as free in the scoreboard/busy vector
-    class MarkRegFreeScbEvent : public RegisterEvent
-    {
-      public:
-        MarkRegFreeScbEvent(RegisterFile *_rf, int _regIdx)
-            : RegisterEvent(_rf, _regIdx) { }
-        void process();
-    };
-
-    // Register Event to mark a register as busy in the scoreboard/busy vector
-    class MarkRegBusyScbEvent : public RegisterEvent
-    {
-      public:
-        MarkRegBusyScbEvent(RegisterFile *_rf, int _regIdx)
-            : RegisterEvent(_rf, _regIdx) { }
-        void process();
-    };
-
-    // Schedule an event to mark a register as free/busy in
-    // the scoreboard/busy vector. Delay is already in Ticks
-    virtual void enqRegFreeEvent(uint32_t regIdx, uint64_t delay);
-    virtual void enqRegBusyEvent(uint32_t regIdx, uint64_t delay);
+    // Mark a register as free in the scoreboard/busy vector once delay
+    // Ticks have passed. No event is scheduled, the busy vector is
+    // brought up to date whenever the register is looked at.
+    virtual void enqRegFree(uint32_t regIdx, uint64_t delay);
 
     // Schedule functions
 
@@ -149,6 +119,22 @@ class RegisterFile : public SimObject
     // flag indicating if a register is busy
     std::vector<bool> busy;
 
+    // Tick at which each register was last marked busy, and Tick at
+    // which its pending free takes effect (MaxTick if there is none).
+    // A pending free clears the busy flag only if it was due after the
+    // register was last marked busy.
+    std::vector<Tick> busyTick;
+    std::vector<Tick> freeTick;
+
+    bool
+    freePending(int idx) const
+    {
+        return busyTick[idx] < freeTick[idx] && freeTick[idx] <= curTick();
+    }
+
+    // Apply the pending free of a register if it is due
+    void updateBusy(int idx);
+
     // numer of registers in this register file
     int _numRegs;
 
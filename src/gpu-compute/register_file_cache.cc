@@ -63,7 +63,8 @@ RegisterFileCache::setParent(ComputeUnit *_computeUnit)
 bool
 RegisterFileCache::inRFC(int regIdx)
 {
-    return (lruHash.find(regIdx) != lruHash.end());
+    processInserts();
+    return regIdx < lruRegs.size() && lruRegs[regIdx].cached;
 }
 
 std::string
@@ -71,71 +72,84 @@ RegisterFileCache::dumpLL() const
 {
     std::stringstream ss;
     ss << "lru_order: ";
-    for (auto i=lruHead; i!=nullptr; i=i->next) {
-        if (i->prev == nullptr) {
-            ss << "reg: " << i->regIdx << " ";
+    for (int i = lruHead; i != -1; i = lruRegs[i].next) {
+        if (lruRegs[i].prev == -1) {
+            ss << "reg: " << i << " ";
         } else {
-            ss << "reg: " << i->regIdx << " (prev: " << i->prev->regIdx<<") ";
+            ss << "reg: " << i << " (prev: " << lruRegs[i].prev << ") ";
         }
-        if (i->next != nullptr) {
-            ss << " (next: " << i->next->regIdx<<") ";
+        if (lruRegs[i].next != -1) {
+            ss << " (next: " << lruRegs[i].next << ") ";
         }
     }
     ss << "\n";
     return ss.str();
 }
 
+void
+RegisterFileCache::lruUnlink(int regIdx)
+{
+    OrderedReg &reg = lruRegs[regIdx];
+    if (reg.prev != -1) {
+        lruRegs[reg.prev].next = reg.next;
+    } else {
+        lruHead = reg.next;
+    }
+    if (reg.next != -1) {
+        lruRegs[reg.next].prev = reg.prev;
+    } else {
+        lruTail = reg.prev;
+    }
+}
+
+void
+RegisterFileCache::lruPushFront(int regIdx)
+{
+    OrderedReg &reg = lruRegs[regIdx];
+    reg.prev = -1;
+    reg.next = lruHead;
+    if (lruHead != -1) {
+        lruRegs[lruHead].prev = regIdx;
+    } else {
+        lruTail = regIdx;
+    }
+    lruHead = regIdx;
+}
+
 void
 RegisterFileCache::markRFC(int regIdx)
 {
     if (_capacity == 0) {
         return;
     }
-    if (lruHash.find(regIdx) == lruHash.end()) {
-        if (lruHead == nullptr) {
-            DPRINTF(GPURFC, "RFC SIMD[%d] cache miss inserting physReg[%d]\n",
-                simdId, regIdx);
-            OrderedRegs *oreg = new OrderedRegs(regIdx);
-            lruHash[regIdx] = oreg;
-            lruHead = oreg;
-            lruTail = oreg;
-            return;
-        }
-
-        if (lruHash.size() >= _capacity) {
-            int val = lruTail->regIdx;
+    if (regIdx >= lruRegs.size()) {
+        lruRegs.resize(regIdx + 1);
+    }
+    if (!lruRegs[regIdx].cached) {
+        if (numCached >= _capacity) {
+            int val = lruTail;
             DPRINTF(GPURFC, "RFC SIMD[%d] cache miss inserting "
                 "physReg[%d] evicting physReg[%d]\n", simdId, regIdx, val);
-
-            lruTail = lruTail->prev;
-            lruTail->next = nullptr;
-            lruHash.erase(val);
+            lruUnlink(val);
+            lruRegs[val].cached = false;
+            numCached--;
         } else {
             DPRINTF(GPURFC, "RFC SIMD[%d] cache miss inserting physReg[%d]\n",
                 simdId, regIdx);
         }
+        lruRegs[regIdx].cached = true;
+        numCached++;
     } else { // Exists in cache need to update
         DPRINTF(GPURFC, "RFC SIMD[%d] cache hit physReg[%d]\n",
             simdId, regIdx);
 
-        if (lruHead->regIdx == regIdx) {
+        if (lruHead == regIdx) {
             return;
         }
-        if (lruHash[regIdx]==lruTail) {
-            lruTail = lruHash[regIdx]->prev;
-        }
-        if (lruHash[regIdx]->next != nullptr) {
-            lruHash[regIdx]->next->prev = lruHash[regIdx]->prev;
-        }
-        lruHash[regIdx]->prev->next = lruHash[regIdx]->next;
-        lruHash.erase(regIdx);
+        lruUnlink(regIdx);
     }
 
-    OrderedRegs *oreg = new OrderedRegs(regIdx);
-    lruHash[regIdx] = oreg;
-    oreg->next = lruHead;
-    lruHead->prev = oreg;
-    lruHead = oreg;
+    lruPushFront(regIdx);
 }
 
 void
@@ -148,23 +162,26 @@ RegisterFileCache::waveExecuteInst(Wavefront *w, GPUDynInstPtr ii)
 
         for (const auto& dstVecOp : ii->dstVecRegOperands()) {
             for (const auto& physIdx : dstVecOp.physIndices()) {
-                enqCacheInsertEvent(physIdx, tickDelay);
+                enqCacheInsert(physIdx, tickDelay);
             }
         }
     }
 }
 
 void
-RegisterFileCache::enqCacheInsertEvent(uint32_t regIdx, uint64_t delay)
+RegisterFileCache::enqCacheInsert(uint32_t regIdx, uint64_t delay)
 {
-    schedule(new MarkRegCachedEvent(this, regIdx),
-                curTick() + delay);
+    pendingInserts.emplace_back(curTick() + delay, regIdx);
 }
 
 void
-RegisterFileCache::MarkRegCachedEvent::process()
+RegisterFileCache::processInserts()
 {
-    rfc->markRFC(regIdx);
+    while (!pendingInserts.empty() &&
+           pendingInserts.front().first <= curTick()) {
+        markRFC(pendingInserts.front().second);
+        pendingInserts.pop_front();
+    }
 }
 
 }
@@ -30,8 +30,10 @@
 #ifndef __REGISTER_FILE_CACHE_HH__
 #define __REGISTER_FILE_CACHE_HH__
 
+#include <deque>
 #include <limits>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -58,27 +60,10 @@ class RegisterFileCache : public SimObject
     // Debug functions
     virtual std::string dumpLL() const;
 
-    // Abstract Register Event
-    class RegisterCacheEvent : public Event
-    {
-      protected:
-        RegisterFileCache *rfc;
-        int regIdx;
-
-      public:
-        RegisterCacheEvent(RegisterFileCache *rfc, int regIdx)
-            : rfc(rfc), regIdx(regIdx) { setFlags(AutoDelete); }
-    };
-
-    class MarkRegCachedEvent : public RegisterCacheEvent
-    {
-      public:
-        MarkRegCachedEvent(RegisterFileCache *rfc, int regIdx)
-            : RegisterCacheEvent(rfc, regIdx) { }
-        void process();
-    };
-
-    virtual void enqCacheInsertEvent(uint32_t regIdx, uint64_t delay);
+    // Insert a register into the rfc once delay Ticks have passed. No
+    // event is scheduled, due insertions are applied in order whenever
+    // the rfc is looked up.
+    virtual void enqCacheInsert(uint32_t regIdx, uint64_t delay);
 
     virtual void waveExecuteInst(Wavefront *w, GPUDynInstPtr ii);
 
@@ -91,20 +76,29 @@ class RegisterFileCache : public SimObject
     ComputeUnit* computeUnit;
     int simdId, _capacity;
 
-    class OrderedRegs
-    {
-      public:
-        int regIdx;
+    // Apply the insertions which are due
+    void processInserts();
+
+    // Insertions not yet applied, as (Tick, register). They all have
+    // the same delay so they are due in the order they were queued.
+    std::deque<std::pair<Tick, int>> pendingInserts;
 
-        OrderedRegs* next;
-        OrderedRegs* prev;
-        OrderedRegs(int val) : regIdx(val), next(nullptr), prev(nullptr) {}
+    // Doubly linked list of the cached registers indexed by register,
+    // head is the most recently used. -1 terminates the list.
+    struct OrderedReg
+    {
+        bool cached = false;
+        int next = -1;
+        int prev = -1;
     };
 
-    // Doubly linked list, head is the most recently used
-    std::unordered_map<int, OrderedRegs*> lruHash;
-    OrderedRegs* lruHead = nullptr;
-    OrderedRegs* lruTail = nullptr;
+    std::vector<OrderedReg> lruRegs;
+    int lruHead = -1;
+    int lruTail = -1;
+    int numCached = 0;
+
+    void lruUnlink(int regIdx);
+    void lruPushFront(int regIdx);
 
 };
 
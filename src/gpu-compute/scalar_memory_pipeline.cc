@@ -97,15 +97,15 @@ ScalarMemPipeline::exec()
         }
 
         // Decrement outstanding register count
-        computeUnit.shader->ScheduleAdd(&w->outstandingReqs, m->time, -1);
+        computeUnit.ScheduleAdd(&w->outstandingReqs, m->time, -1);
 
         if (m->isStore() || m->isAtomic()) {
-            computeUnit.shader->ScheduleAdd(&w->scalarOutstandingReqsWrGm,
+            computeUnit.ScheduleAdd(&w->scalarOutstandingReqsWrGm,
                                              m->time, -1);
         }
 
         if (m->isLoad() || m->isAtomic()) {
-            computeUnit.shader->ScheduleAdd(&w->scalarOutstandingReqsRdGm,
+            computeUnit.ScheduleAdd(&w->scalarOutstandingReqsRdGm,
                                              m->time, -1);
         }
 
@@ -168,7 +168,7 @@ ScalarMemPipeline::injectScalarMemFence(GPUDynInstPtr gpuDynInst,
     assert(gpuDynInst->isScalar());
 
     if (!req) {
-        req = std::make_shared<Request>(
+        req = makeRequest(
                 0, 0, 0, computeUnit.requestorId(), 0, gpuDynInst->wfDynId);
     } else {
         req->requestorId(computeUnit.requestorId());
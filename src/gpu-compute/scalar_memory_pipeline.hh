@@ -61,6 +61,13 @@ class ScalarMemPipeline
   public:
     ScalarMemPipeline(const ComputeUnitParams &p, ComputeUnit &cu);
     void exec();
+    /** No request is waiting to be issued or completed */
+    bool
+    isIdle() const
+    {
+        return issuedRequests.empty() && returnedStores.empty() &&
+            returnedLoads.empty();
+    }
 
     std::queue<GPUDynInstPtr> &getGMReqFIFO() { return issuedRequests; }
     std::queue<GPUDynInstPtr> &getGMStRespFIFO() { return returnedStores; }
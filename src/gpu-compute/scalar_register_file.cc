@@ -98,7 +98,7 @@ ScalarRegisterFile::waveExecuteInst(Wavefront *w, GPUDynInstPtr ii)
 
         for (const auto& dstScalarOp : ii->dstScalarRegOperands()) {
             for (const auto& physIdx : dstScalarOp.physIndices()) {
-                enqRegFreeEvent(physIdx, tickDelay);
+                enqRegFree(physIdx, tickDelay);
             }
         }
 
@@ -113,7 +113,7 @@ ScalarRegisterFile::scheduleWriteOperandsFromLoad(Wavefront *w,
     assert(ii->isLoad() || ii->isAtomicRet());
     for (const auto& dstScalarOp : ii->dstScalarRegOperands()) {
         for (const auto& physIdx : dstScalarOp.physIndices()) {
-            enqRegFreeEvent(physIdx, computeUnit->clockPeriod());
+            enqRegFree(physIdx, computeUnit->clockPeriod());
         }
     }
 
@@ -87,6 +87,16 @@ ScheduleStage::init()
     assert(computeUnit.numVectorSharedMemUnits == 1);
 }
 
+bool
+ScheduleStage::isIdle() const
+{
+    for (const auto &sch_list : schList) {
+        if (!sch_list.empty())
+            return false;
+    }
+    return true;
+}
+
 void
 ScheduleStage::exec()
 {
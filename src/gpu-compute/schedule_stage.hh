@@ -68,6 +68,8 @@ class ScheduleStage
     ~ScheduleStage();
     void init();
     void exec();
+    /** No wave is waiting to be scheduled */
+    bool isIdle() const;
 
     // Stats related variables and methods
     const std::string& name() const { return _name; }
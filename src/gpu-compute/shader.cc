@@ -57,8 +57,6 @@ namespace gem5
 Shader::Shader(const Params &p) : ClockedObject(p),
     _activeCus(0), _lastInactiveTick(0), cpuThread(nullptr),
     gpuTc(nullptr), cpuPointer(p.cpu_pointer),
-    tickEvent([this]{ execScheduledAdds(); }, "Shader scheduled adds event",
-          false, Event::CPU_Tick_Pri),
     timingSim(p.timing), hsail_mode(SIMT),
     impl_kern_launch_acq(p.impl_kern_launch_acq),
     impl_kern_end_rel(p.impl_kern_end_rel),
@@ -66,7 +64,7 @@ Shader::Shader(const Params &p) : ClockedObject(p),
     trace_vgpr_all(1), n_cu((p.CUs).size()), n_wf(p.n_wf),
     n_cu_per_sqc(p.cu_per_sqc),
     globalMemSize(p.globalmem),
-    nextSchedCu(0), sa_n(0), gpuCmdProc(*p.gpu_cmd_proc),
+    nextSchedCu(0), gpuCmdProc(*p.gpu_cmd_proc),
     _dispatcher(*p.dispatcher), systemHub(p.system_hub),
     max_valu_insts(p.max_valu_insts), total_valu_insts(0),
     stats(this, p.CUs[0]->wfSize())
@@ -153,6 +151,16 @@ Shader::init()
     assert(cpuPointer);
     gpuTc = cpuPointer->getContext(0);
     assert(gpuTc);
+
+    // The dispatcher calls into the CUs, and the CUs into the shader, the
+    // dispatcher and each other's Ruby controllers, directly. None of
+    // these calls can cross event queues yet.
+    for (auto *cu : cuList) {
+        fatal_if(cu->eventQueue() != eventQueue(),
+                 "%s is not on the event queue of %s. Compute units must "
+                 "share the event queue of their shader.\n", cu->name(),
+                 name());
+    }
 }
 
 Shader::~Shader()
@@ -169,33 +177,6 @@ Shader::updateContext(int cid) {
     assert(gpuTc);
 }
 
-void
-Shader::execScheduledAdds()
-{
-    assert(!sa_when.empty());
-
-    // apply any scheduled adds
-    for (int i = 0; i < sa_n; ++i) {
-        if (sa_when[i] <= curTick()) {
-            *sa_val[i] += sa_x[i];
-            panic_if(*sa_val[i] < 0, "Negative counter value\n");
-            sa_val.erase(sa_val.begin() + i);
-            sa_x.erase(sa_x.begin() + i);
-            sa_when.erase(sa_when.begin() + i);
-            --sa_n;
-            --i;
-        }
-    }
-    if (!sa_when.empty()) {
-        Tick shader_wakeup = *std::max_element(sa_when.begin(),
-                 sa_when.end());
-        DPRINTF(GPUDisp, "Scheduling shader wakeup at %lu\n", shader_wakeup);
-        schedule(tickEvent, shader_wakeup);
-    } else {
-        DPRINTF(GPUDisp, "sa_when empty, shader going to sleep!\n");
-    }
-}
-
 /*
  * dispatcher/shader arranges invalidate requests to the CUs
  */
@@ -214,9 +195,9 @@ Shader::prepareInvalidate(HSAQueueEntry *task) {
     for (int i_cu = 0; i_cu < n_cu; ++i_cu) {
         // create a request to hold INV info; the request's fields will
         // be updated in cu before use
-        auto req = std::make_shared<Request>(0, 0, 0,
-                                             cuList[i_cu]->requestorId(),
-                                             0, -1);
+        auto req = makeRequest(0, 0, 0,
+                               cuList[i_cu]->requestorId(),
+                               0, -1);
 
         _dispatcher.updateInvCounter(kernId, +1);
         // all necessary INV flags are all set now, call cu to execute
@@ -372,25 +353,6 @@ Shader::doFunctionalAccess(const RequestPtr &req, MemCmd cmd, void *data,
     }
 }
 
-void
-Shader::ScheduleAdd(int *val,Tick when,int x)
-{
-    sa_val.push_back(val);
-    when += curTick();
-    sa_when.push_back(when);
-    sa_x.push_back(x);
-    ++sa_n;
-    if (!tickEvent.scheduled() || (when < tickEvent.when())) {
-        DPRINTF(GPUDisp, "New scheduled add; scheduling shader wakeup at "
-                "%lu\n", when);
-        reschedule(tickEvent, when, true);
-    } else {
-        assert(tickEvent.scheduled());
-        DPRINTF(GPUDisp, "New scheduled add; wakeup already scheduled at "
-                "%lu\n", when);
-    }
-}
-
 void
 Shader::AccessMem(uint64_t address, void *ptr, uint32_t size, int cu_id,
                   MemCmd cmd, bool suppress_func_errors)
@@ -400,7 +362,7 @@ Shader::AccessMem(uint64_t address, void *ptr, uint32_t size, int cu_id,
     for (ChunkGenerator gen(address, size, cuList.at(cu_id)->cacheLineSize());
          !gen.done(); gen.next()) {
 
-        RequestPtr req = std::make_shared<Request>(
+        RequestPtr req = makeRequest(
             gen.addr(), gen.size(), 0,
             cuList[0]->requestorId(), 0, 0, nullptr);
 
@@ -222,8 +222,6 @@ class Shader : public ClockedObject
 
     RequestorID vramRequestorId();
 
-    EventFunctionWrapper tickEvent;
-
     // is this simulation going to be timing mode in the memory?
     bool timingSim;
     hsail_mode_e hsail_mode;
@@ -249,16 +247,6 @@ class Shader : public ClockedObject
     // Tracks CU that rr dispatcher should attempt scheduling
     int nextSchedCu;
 
-    // Size of scheduled add queue
-    uint32_t sa_n;
-
-    // Pointer to value to be increments
-    std::vector<int*> sa_val;
-    // When to do the increment
-    std::vector<uint64_t> sa_when;
-    // Amount to increment by
-    std::vector<int32_t> sa_x;
-
     // List of Compute Units (CU's)
     std::vector<ComputeUnit*> cuList;
 
@@ -273,11 +261,6 @@ class Shader : public ClockedObject
     ~Shader();
     virtual void init();
 
-    // Run shader scheduled adds
-    void execScheduledAdds();
-
-    // Schedule a 32-bit value to be incremented some time in the future
-    void ScheduleAdd(int *val, Tick when, int x);
     bool processTimingPacket(PacketPtr pkt);
 
     void AccessMem(uint64_t address, void *ptr, uint32_t size, int cu_id,
@@ -162,7 +162,7 @@ VectorRegisterFile::waveExecuteInst(Wavefront *w, GPUDynInstPtr ii)
 
         for (const auto& dstVecOp : ii->dstVecRegOperands()) {
             for (const auto& physIdx : dstVecOp.physIndices()) {
-                enqRegFreeEvent(physIdx, tickDelay);
+                enqRegFree(physIdx, tickDelay);
             }
         }
         // increment count of number of DWords written to VRF
@@ -187,7 +187,7 @@ VectorRegisterFile::scheduleWriteOperandsFromLoad(
     assert(ii->isLoad() || ii->isAtomicRet());
     for (const auto& dstVecOp : ii->dstVecRegOperands()) {
         for (const auto& physIdx : dstVecOp.physIndices()) {
-            enqRegFreeEvent(physIdx, computeUnit->clockPeriod());
+            enqRegFree(physIdx, computeUnit->clockPeriod());
         }
     }
     // increment count of number of DWords written to VRF
@@ -757,7 +757,7 @@ Wavefront::isOldestInstFlatMem()
 }
 
 bool
-Wavefront::stopFetch()
+Wavefront::stopFetch() const
 {
     for (auto it : instructionBuffer) {
         GPUDynInstPtr ii = it;
@@ -1229,6 +1229,19 @@ Wavefront::discardFetch()
     computeUnit->fetchStage.fetchUnit(simdId).flushBuf(wfSlotId);
 }
 
+bool
+Wavefront::waitingOnMemory() const
+{
+    if (status != S_WAITCNT ||
+        (vmWaitCnt == -1 && expWaitCnt == -1 && lgkmWaitCnt == -1)) {
+        return false;
+    }
+
+    return (vmWaitCnt != -1 && vmemInstsIssued > vmWaitCnt) ||
+        (expWaitCnt != -1 && expInstsIssued > expWaitCnt) ||
+        (lgkmWaitCnt != -1 && lgkmInstsIssued > lgkmWaitCnt);
+}
+
 bool
 Wavefront::waitCntsSatisfied()
 {
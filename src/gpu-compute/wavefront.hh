@@ -95,6 +95,9 @@ class Wavefront : public SimObject
     // HW slot id where the WF is mapped to inside a SIMD unit
     const int wfSlotId;
     int kernId;
+    // The kernel of this WF runs with functional memory accesses, see
+    // HSAQueueEntry::functional()
+    bool functionalMem = false;
     // SIMD unit where the WV has been scheduled
     const int simdId;
     // id of the execution unit (or pipeline) where the oldest instruction
@@ -136,7 +139,7 @@ class Wavefront : public SimObject
     void freeResources();
     GPUDynInstPtr nextInstr();
     void setStatus(status_e newStatus);
-    status_e getStatus() { return status; }
+    status_e getStatus() const { return status; }
     void resizeRegFiles(int num_vregs, int num_sregs);
     bool isGmInstruction(GPUDynInstPtr ii);
     bool isLmInstruction(GPUDynInstPtr ii);
@@ -259,7 +262,7 @@ class Wavefront : public SimObject
     void exec();
     // called by SCH stage to reserve
     std::vector<int> reserveResources();
-    bool stopFetch();
+    bool stopFetch() const;
 
     Addr pc() const;
     void pc(Addr new_pc);
@@ -271,6 +274,11 @@ class Wavefront : public SimObject
     void discardFetch();
 
     bool waitCntsSatisfied();
+    /**
+     * The wave executed an s_waitcnt whose counts aren't satisfied yet,
+     * so it can't make progress until some memory request completes.
+     */
+    bool waitingOnMemory() const;
     void setWaitCnts(int vm_wait_cnt, int exp_wait_cnt, int lgkm_wait_cnt);
     void clearWaitCnts();
 
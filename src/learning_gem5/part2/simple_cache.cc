@@ -382,7 +382,7 @@ SimpleCache::insert(PacketPtr pkt)
 
         // Write back the data.
         // Create a new request-packet pair
-        RequestPtr req = std::make_shared<Request>(
+        RequestPtr req = makeRequest(
             block->first, blockSize, 0, 0);
 
         PacketPtr new_pkt = new Packet(req, MemCmd::WritebackDirty, blockSize);
@@ -69,6 +69,16 @@ class AbstractMemory(ClockedObject):
     # the kernel, e.g. using ATAG or ACPI
     conf_table_reported = Param.Bool(True, "Report to configuration table")
 
+    # With multi-threaded simulation, the backing store of a memory can
+    # be bound to the host NUMA node of the threads accessing it. The
+    # backing store of interleaved memories bound to different nodes
+    # is interleaved across those nodes by the host.
+    host_numa_node = Param.Int(
+        -1,
+        "Host NUMA node to allocate the backing store on, -1 to leave it "
+        "to the host",
+    )
+
     # Image file to load into this memory as its initial contents. This is
     # particularly useful for ROMs.
     image_file = Param.String(
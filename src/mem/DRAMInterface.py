@@ -70,6 +70,16 @@ class DRAMInterface(MemInterface):
     # performance being lower when enabled
     enable_dram_powerdown = Param.Bool(False, "Enable powerdown states")
 
+    # Collapse the refreshes of a rank that has nothing queued into a
+    # single event per refresh interval instead of walking the full
+    # drain/precharge/refresh/idle sequence. The rank is brought back
+    # into the regular refresh state machine as soon as a request
+    # arrives, so timing and the DRAMPower command stream are unchanged.
+    # Only affects ranks that are not using the powerdown states.
+    coalesce_idle_refresh = Param.Bool(
+        False, "Coalesce refresh of idle ranks into one event per tREFI"
+    )
+
     # For power modelling we need to know if the DRAM has a DLL or not
     dll = Param.Bool(True, "DRAM has DLL or not")
 
@@ -137,6 +147,12 @@ class DRAMInterface(MemInterface):
     # to be sent. It is 7.8 us for a 64ms refresh requirement
     tREFI = Param.Latency("Refresh command interval")
 
+    # time taken to refresh one bank in every bank group (same-bank
+    # refresh, e.g. DDR5 REFsb). When set, awake ranks refresh one such
+    # set of banks every tREFI / banks per bank group and keep serving
+    # requests to the other banks, 0 uses all-bank refresh only
+    tRFCsb = Param.Latency("0ns", "Same-bank refresh cycle time")
+
     # write-to-read, same rank turnaround penalty for same bank group
     tWTR_L = Param.Latency(
         Self.tWTR,
@@ -15,3 +15,7 @@ class SharedMemoryServer(SimObject):
     server_path = Param.String(
         "The unix socket path where the server should be running upon."
     )
+    channel_entries = Param.Unsigned(
+        256,
+        "Number of messages in each ring of a channel, a power of 2.",
+    )
@@ -40,14 +40,17 @@
 
 #include "mem/abstract_mem.hh"
 
+#include <algorithm>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/loader/memory_image.hh"
 #include "base/loader/object_file.hh"
 #include "cpu/thread_context.hh"
 #include "debug/LLSC.hh"
 #include "debug/MemoryAccess.hh"
 #include "mem/packet_access.hh"
+#include "mem/physical.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -63,7 +66,8 @@ AbstractMemory::AbstractMemory(const Params &p) :
                  MemBackdoor::Readable | MemBackdoor::Writeable :
                  MemBackdoor::Readable)),
     confTableReported(p.conf_table_reported), inAddrMap(p.in_addr_map),
-    kvmMap(p.kvm_map), writeable(p.writeable), collectStats(p.collect_stats),
+    kvmMap(p.kvm_map), hostNumaNode(p.host_numa_node),
+    writeable(p.writeable), collectStats(p.collect_stats),
     _system(NULL), stats(*this)
 {
     panic_if(!range.valid() || !range.size(),
@@ -108,6 +112,9 @@ AbstractMemory::setBackingStore(uint8_t* pmem_addr)
     // If there was an existing backdoor, let everybody know it's going away.
     if (backdoor.ptr())
         backdoor.invalidate();
+    for (auto &region : regionBackdoors)
+        region.second->invalidate();
+    regionBackdoors.clear();
 
     // The back door can't handle interleaved memory.
     backdoor.ptr(range.interleaved() ? nullptr : pmem_addr);
@@ -115,6 +122,36 @@ AbstractMemory::setBackingStore(uint8_t* pmem_addr)
     pmemAddr = pmem_addr;
 }
 
+void
+AbstractMemory::getBackdoor(MemBackdoorPtr &bd_ptr, Addr addr)
+{
+    if (!backdoor.ptr() || !range.contains(addr))
+        return;
+
+    MemBackdoorPtr bd = &backdoor;
+    if (!lockedLines.empty()) {
+        const Addr region = addr & ~mask(RegionBits);
+        if (lockedRegions.count(region))
+            return;
+
+        auto &region_bd = regionBackdoors[region];
+        if (!region_bd) {
+            const Addr start = std::max(region, range.start());
+            const Addr end = std::min<Addr>(region + (1ULL << RegionBits),
+                                      range.end());
+            region_bd.reset(new MemBackdoor(AddrRange(start, end),
+                        pmemAddr + (start - range.start()),
+                        backdoor.flags()));
+        }
+        bd = region_bd.get();
+    }
+
+    // writes through the backdoor can't be tracked
+    if (dirtyPageTracker && bd->writeable())
+        dirtyPageTracker->markUntracked(pmemAddr);
+    bd_ptr = bd;
+}
+
 AbstractMemory::MemStats::MemStats(AbstractMemory &_mem)
     : statistics::Group(&_mem), mem(_mem),
     ADD_STAT(bytesRead, statistics::units::Byte::get(),
@@ -252,33 +289,81 @@ AbstractMemory::getAddrRange() const
     return range;
 }
 
-// Add load-locked to tracking list.  Should only be called if the
-// operation is a load and the LLSC flag is set.
 void
-AbstractMemory::trackLoadLocked(PacketPtr pkt)
+AbstractMemory::lockAddr(Addr addr, ContextID cid)
 {
-    const RequestPtr &req = pkt->req;
-    Addr paddr = LockedAddr::mask(req->getPaddr());
+    assert(cid != InvalidContextID);
+    if (cid >= lockSlots.size())
+        lockSlots.resize(cid + 1, NoLock);
 
-    // first we check if we already have a locked addr for this
-    // xc.  Since each xc only gets one, we just update the
-    // existing record with the new address.
-    std::list<LockedAddr>::iterator i;
+    Addr &slot = lockSlots[cid];
+    if (slot == addr)
+        return;
+    if (slot != NoLock)
+        unlockAddr(slot, cid);
+    slot = addr;
 
-    for (i = lockedAddrList.begin(); i != lockedAddrList.end(); ++i) {
-        if (i->matchesContext(req)) {
-            DPRINTF(LLSC, "Modifying lock record: context %d addr %#x\n",
-                    req->contextId(), paddr);
-            i->addr = paddr;
-            return;
+    auto &holders = lockedLines[addr];
+    holders.push_back(cid);
+    if (holders.size() > 1)
+        return;
+
+    // Stores to the address must now be seen, so the back doors which
+    // cover it go away.
+    backdoor.invalidate();
+    const Addr region = addr & ~mask(RegionBits);
+    if (lockedRegions[region]++ == 0) {
+        auto it = regionBackdoors.find(region);
+        if (it != regionBackdoors.end()) {
+            it->second->invalidate();
+            regionBackdoors.erase(it);
         }
     }
+}
+
+void
+AbstractMemory::unlockAddr(Addr addr, ContextID cid)
+{
+    lockSlots[cid] = NoLock;
+
+    auto it = lockedLines.find(addr);
+    assert(it != lockedLines.end());
+    auto &holders = it->second;
+    holders.erase(std::find(holders.begin(), holders.end(), cid));
+    if (!holders.empty())
+        return;
+
+    lockedLines.erase(it);
+    const Addr region = addr & ~mask(RegionBits);
+    auto region_it = lockedRegions.find(region);
+    if (--region_it->second == 0)
+        lockedRegions.erase(region_it);
+}
+
+std::list<LockedAddr>
+AbstractMemory::getLockedAddrList() const
+{
+    std::list<LockedAddr> locked;
+    for (ContextID cid = 0; cid < lockSlots.size(); cid++) {
+        if (lockSlots[cid] != NoLock)
+            locked.emplace_back(lockSlots[cid], cid);
+    }
+    return locked;
+}
 
-    // no record for this xc: need to allocate a new one
-    DPRINTF(LLSC, "Adding lock record: context %d addr %#x\n",
+// Add load-locked to tracking table.  Should only be called if the
+// operation is a load and the LLSC flag is set.
+void
+AbstractMemory::trackLoadLocked(PacketPtr pkt)
+{
+    const RequestPtr &req = pkt->req;
+    Addr paddr = LockedAddr::mask(req->getPaddr());
+
+    // Each xc only gets one locked addr, so a new one replaces the
+    // existing record.
+    DPRINTF(LLSC, "Setting lock record: context %d addr %#x\n",
             req->contextId(), paddr);
-    lockedAddrList.push_front(LockedAddr(req));
-    backdoor.invalidate();
+    lockAddr(paddr, req->contextId());
 }
 
 
@@ -298,53 +383,42 @@ AbstractMemory::checkLockedAddrList(PacketPtr pkt)
     // otherwise.
     bool allowStore = !isLLSC;
 
-    // Iterate over list.  Note that there could be multiple matching records,
-    // as more than one context could have done a load locked to this location.
-    // Only remove records when we succeed in finding a record for (xc, addr);
-    // then, remove all records with this address.  Failed store-conditionals do
-    // not blow unrelated reservations.
-    std::list<LockedAddr>::iterator i = lockedAddrList.begin();
+    // There could be several contexts holding a reservation on this
+    // address, as more than one context could have done a load locked to
+    // this location. Only remove them when we succeed in finding one for
+    // (xc, addr). Failed store-conditionals do not blow unrelated
+    // reservations.
+    auto it = lockedLines.find(paddr);
 
     if (isLLSC) {
-        while (i != lockedAddrList.end()) {
-            if (i->addr == paddr && i->matchesContext(req)) {
-                // it's a store conditional, and as far as the memory system can
-                // tell, the requesting context's lock is still valid.
-                DPRINTF(LLSC, "StCond success: context %d addr %#x\n",
-                        req->contextId(), paddr);
-                allowStore = true;
-                break;
-            }
-            // If we didn't find a match, keep searching!  Someone else may well
-            // have a reservation on this line here but we may find ours in just
-            // a little while.
-            i++;
+        assert(req->hasContextId());
+        if (it != lockedLines.end() &&
+                std::find(it->second.begin(), it->second.end(),
+                    req->contextId()) != it->second.end()) {
+            // it's a store conditional, and as far as the memory system can
+            // tell, the requesting context's lock is still valid.
+            DPRINTF(LLSC, "StCond success: context %d addr %#x\n",
+                    req->contextId(), paddr);
+            allowStore = true;
         }
         req->setExtraData(allowStore ? 1 : 0);
     }
     // LLSCs that succeeded AND non-LLSC stores both fall into here:
-    if (allowStore) {
-        // We write address paddr.  However, there may be several entries with a
-        // reservation on this address (for other contextIds) and they must all
-        // be removed.
-        i = lockedAddrList.begin();
-        while (i != lockedAddrList.end()) {
-            if (i->addr == paddr) {
-                DPRINTF(LLSC, "Erasing lock record: context %d addr %#x\n",
-                        i->contextId, paddr);
-                ContextID owner_cid = i->contextId;
-                assert(owner_cid != InvalidContextID);
-                ContextID requestor_cid = req->hasContextId() ?
-                                           req->contextId() :
-                                           InvalidContextID;
-                if (owner_cid != requestor_cid) {
-                    ThreadContext* ctx = system()->threads[owner_cid];
-                    ctx->getIsaPtr()->globalClearExclusive();
-                }
-                i = lockedAddrList.erase(i);
-            } else {
-                i++;
+    if (allowStore && it != lockedLines.end()) {
+        // We write address paddr.  However, there may be several contexts
+        // with a reservation on this address and they must all be removed.
+        ContextID requestor_cid = req->hasContextId() ?
+                                   req->contextId() :
+                                   InvalidContextID;
+        const std::vector<ContextID> holders = it->second;
+        for (ContextID owner_cid : holders) {
+            DPRINTF(LLSC, "Erasing lock record: context %d addr %#x\n",
+                    owner_cid, paddr);
+            if (owner_cid != requestor_cid) {
+                ThreadContext* ctx = system()->threads[owner_cid];
+                ctx->getIsaPtr()->globalClearExclusive();
             }
+            unlockAddr(paddr, owner_cid);
         }
     }
 
@@ -395,6 +469,9 @@ AbstractMemory::access(PacketPtr pkt)
 
     uint8_t *host_addr = toHostAddr(pkt->getAddr());
 
+    if (dirtyPageTracker && pkt->isWrite())
+        dirtyPageTracker->markDirty(host_addr, pkt->getSize());
+
     if (pkt->cmd == MemCmd::SwapReq) {
         if (pkt->isAtomicOp()) {
             if (pmemAddr) {
@@ -501,6 +578,8 @@ AbstractMemory::functionalAccess(PacketPtr pkt)
     } else if (pkt->isWrite()) {
         if (pmemAddr) {
             pkt->writeData(host_addr);
+            if (dirtyPageTracker)
+                dirtyPageTracker->markDirty(host_addr, pkt->getSize());
         }
         TRACE_PACKET("Write");
         pkt->makeResponse();
@@ -46,6 +46,11 @@
 #ifndef __MEM_ABSTRACT_MEMORY_HH__
 #define __MEM_ABSTRACT_MEMORY_HH__
 
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "mem/backdoor.hh"
 #include "mem/port.hh"
 #include "params/AbstractMemory.hh"
@@ -60,6 +65,8 @@ class System;
 namespace memory
 {
 
+class PhysicalMemory;
+
 /**
  * Locked address class that represents a physical address and a
  * context id.
@@ -120,6 +127,9 @@ class AbstractMemory : public ClockedObject
     // Backdoor to access this memory.
     MemBackdoor backdoor;
 
+    // Physical memory tracking the pages written, if any
+    PhysicalMemory *dirtyPageTracker = nullptr;
+
     // Enable specific memories to be reported to the configuration table
     const bool confTableReported;
 
@@ -129,18 +139,48 @@ class AbstractMemory : public ClockedObject
     // Should KVM map this memory for the guest
     const bool kvmMap;
 
+    // Host NUMA node of the backing store, -1 if not bound to one
+    const int hostNumaNode;
+
     // Are writes allowed to this memory
     const bool writeable;
 
     // Should collect traffic statistics
     const bool collectStats;
 
-    std::list<LockedAddr> lockedAddrList;
+    // Value of the lock slot of a context without a reservation
+    static constexpr Addr NoLock = MaxAddr;
+
+    // The address each context reserved with a load-locked, indexed by
+    // context id, NoLock if it has none. A context only ever holds one.
+    std::vector<Addr> lockSlots;
+
+    // The contexts holding a reservation, for each reserved address
+    std::unordered_map<Addr, std::vector<ContextID>> lockedLines;
+
+    // While some addresses are reserved, back doors are handed out to
+    // regions of 1 << RegionBits bytes which hold no reservation, rather
+    // than to the whole memory, so that stores through them can't miss
+    // a reservation
+    static constexpr unsigned RegionBits = 16;
+
+    // Number of reserved addresses in each region
+    std::unordered_map<Addr, unsigned> lockedRegions;
+
+    // The back doors handed out to regions, by region start address
+    std::unordered_map<Addr, std::unique_ptr<MemBackdoor>> regionBackdoors;
+
+    // Reserve an address for a context, and invalidate the back doors
+    // which cover it
+    void lockAddr(Addr addr, ContextID cid);
+
+    // Drop the reservation of a context on an address
+    void unlockAddr(Addr addr, ContextID cid);
 
     // helper function for checkLockedAddrs(): we really want to
-    // inline a quick check for an empty locked addr list (hopefully
-    // the common case), and do the full list search (if necessary) in
-    // this out-of-line function
+    // inline a quick check for no locked addrs (hopefully the common
+    // case), and do the table lookup (if necessary) in this
+    // out-of-line function
     bool checkLockedAddrList(PacketPtr pkt);
 
     // Record the address of a load-locked operation so that we can
@@ -161,7 +201,7 @@ class AbstractMemory : public ClockedObject
         const RequestPtr &req = pkt->req;
         if (!writeable)
             return false;
-        if (lockedAddrList.empty()) {
+        if (lockedLines.empty()) {
             // no locked addrs: nothing to check, store_conditional fails
             bool isLLSC = pkt->isLLSC();
             if (isLLSC) {
@@ -169,7 +209,7 @@ class AbstractMemory : public ClockedObject
             }
             return !isLLSC; // only do write if not an sc
         } else {
-            // iterate over list...
+            // look the address up...
             return checkLockedAddrList(pkt);
         }
     }
@@ -244,21 +284,32 @@ class AbstractMemory : public ClockedObject
      */
     void setBackingStore(uint8_t* pmem_addr);
 
-    void
-    getBackdoor(MemBackdoorPtr &bd_ptr)
+    /**
+     * Report the writes to the backing store to the physical memory
+     * owning it, for incremental checkpoints.
+     *
+     * @param tracker Physical memory tracking the pages written
+     */
+    void trackDirtyPages(PhysicalMemory *tracker)
     {
-        if (lockedAddrList.empty() && backdoor.ptr())
-            bd_ptr = &backdoor;
+        dirtyPageTracker = tracker;
     }
 
+    /**
+     * Get a back door to this memory, if it can be accessed through one.
+     * While no address is reserved by a load-locked, the back door covers
+     * the whole memory. Otherwise, it covers the region around an address
+     * if that region holds no reservation.
+     *
+     * @param bd_ptr Set to the back door, left alone if there is none.
+     * @param addr Address the back door should cover.
+     */
+    void getBackdoor(MemBackdoorPtr &bd_ptr, Addr addr);
+
     /**
      * Get the list of locked addresses to allow checkpointing.
      */
-    const std::list<LockedAddr> &
-    getLockedAddrList() const
-    {
-        return lockedAddrList;
-    }
+    std::list<LockedAddr> getLockedAddrList() const;
 
     /**
      * Add a locked address to allow for checkpointing.
@@ -266,8 +317,7 @@ class AbstractMemory : public ClockedObject
     void
     addLockedAddr(LockedAddr addr)
     {
-        backdoor.invalidate();
-        lockedAddrList.push_back(addr);
+        lockAddr(addr.addr, addr.contextId);
     }
 
     /** read the system pointer
@@ -341,6 +391,14 @@ class AbstractMemory : public ClockedObject
      */
     bool isKvmMap() const { return kvmMap; }
 
+    /**
+     * Get the host NUMA node the backing store of this memory should be
+     * allocated on.
+     *
+     * @return the NUMA node, or -1 if the memory is not bound to one
+     */
+    int getHostNumaNode() const { return hostNumaNode; }
+
     /**
      * Perform an untimed memory access and update all the state
      * (e.g. locked addresses) and statistics accordingly. The packet
@@ -135,6 +135,13 @@ class BaseCache(ClockedObject):
         False, "Whether to access tags and data sequentially"
     )
 
+    atomic_warm = Param.Bool(
+        False,
+        "In atomic mode, look plain reads and writes up through a "
+        "reduced path which only charges the tag latency on a hit. Meant "
+        "for functional warming, where timing does not matter",
+    )
+
     cpu_side = ResponsePort("Upstream port closer to the CPU and/or device")
     mem_side = RequestPort("Downstream port closer to memory")
 
@@ -101,6 +101,7 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       fillLatency(p.data_latency),
       responseLatency(p.response_latency),
       sequentialAccess(p.sequential_access),
+      atomicWarm(p.atomic_warm),
       numTarget(p.tgts_per_mshr),
       forwardSnoops(true),
       clusivity(p.clusivity),
@@ -248,7 +249,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = makeRequest(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -450,7 +451,7 @@ BaseCache::recvTimingReq(PacketPtr pkt)
     if (satisfied) {
         // notify before anything else as later handleTimingReqHit might turn
         // the packet in a response
-        ppHit->notify(CacheAccessProbeArg(pkt,accessor));
+        ppHit->notifyLazy([&] { return CacheAccessProbeArg(pkt, accessor); });
 
         if (prefetcher && blk && blk->wasPrefetched()) {
             DPRINTF(Cache, "Hit on prefetch for addr %#x (%s)\n",
@@ -462,7 +463,8 @@ BaseCache::recvTimingReq(PacketPtr pkt)
     } else {
         handleTimingReqMiss(pkt, blk, forward_time, request_time);
 
-        ppMiss->notify(CacheAccessProbeArg(pkt,accessor));
+        ppMiss->notifyLazy(
+            [&] { return CacheAccessProbeArg(pkt, accessor); });
     }
 
     if (prefetcher) {
@@ -559,7 +561,8 @@ BaseCache::recvTimingResp(PacketPtr pkt)
             writeAllocator->allocate() : mshr->allocOnFill();
         blk = handleFill(pkt, blk, writebacks, allocate);
         assert(blk != nullptr);
-        ppFill->notify(CacheAccessProbeArg(pkt, accessor));
+        ppFill->notifyLazy(
+            [&] { return CacheAccessProbeArg(pkt, accessor); });
     }
 
     // Don't want to promote the Locked RMW Read until
@@ -646,7 +649,9 @@ BaseCache::recvAtomic(PacketPtr pkt)
 
     CacheBlk *blk = nullptr;
     PacketList writebacks;
-    bool satisfied = access(pkt, blk, lat, writebacks);
+    // With atomicWarm, a hit only costs the lookup latency
+    const bool satisfied = atomicWarm && isWarmAccess(pkt) ?
+        warmAccess(pkt, blk) : access(pkt, blk, lat, writebacks);
 
     if (pkt->isClean() && blk && blk->isSet(CacheBlk::DirtyBit)) {
         // A cache clean opearation is looking for a dirty
@@ -1506,6 +1511,40 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
     return false;
 }
 
+bool
+BaseCache::isWarmAccess(PacketPtr pkt) const
+{
+    return (pkt->isRead() || pkt->isWrite()) && !pkt->isEviction() &&
+        pkt->cmd != MemCmd::WriteClean && !pkt->isLLSC() &&
+        !pkt->req->isUncacheable() && !pkt->req->isCacheMaintenance();
+}
+
+bool
+BaseCache::warmAccess(PacketPtr pkt, CacheBlk *&blk)
+{
+    gem5_assert(!(isReadOnly && pkt->isWrite()),
+                "Should never see a write in a read-only cache %s\n",
+                name());
+
+    Cycles tag_latency(0);
+    blk = tags->accessBlock(pkt, tag_latency);
+
+    DPRINTF(Cache, "%s for %s %s\n", __func__, pkt->print(),
+            blk ? "hit " + blk->print() : "miss");
+
+    if (blk && (pkt->needsWritable() ?
+            blk->isSet(CacheBlk::WritableBit) :
+            blk->isSet(CacheBlk::ReadableBit))) {
+        incHitCount(pkt);
+        satisfyRequest(pkt, blk);
+        maintainClusivity(pkt->fromCache(), blk);
+        return true;
+    }
+
+    incMissCount(pkt);
+    return false;
+}
+
 void
 BaseCache::maintainClusivity(bool from_cache, CacheBlk *blk)
 {
@@ -1712,7 +1751,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1755,7 +1794,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1829,7 +1868,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = makeRequest(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -490,6 +490,23 @@ class BaseCache : public ClockedObject
     virtual bool access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
                         PacketList &writebacks);
 
+    /**
+     * Whether an atomic request is a plain cacheable read or write that
+     * warmAccess() can perform.
+     */
+    bool isWarmAccess(PacketPtr pkt) const;
+
+    /**
+     * Reduced version of access() used with atomicWarm. It updates the
+     * tags and replacement state and satisfies hits, but doesn't
+     * calculate any latency, and it never produces writebacks.
+     *
+     * @param pkt The memory request to perform.
+     * @param blk The cache block found, if any.
+     * @return Boolean indicating whether the request was satisfied.
+     */
+    bool warmAccess(PacketPtr pkt, CacheBlk *&blk);
+
     /*
      * Handle a timing request that hit in the cache
      *
@@ -920,6 +937,12 @@ class BaseCache : public ClockedObject
      */
     const bool sequentialAccess;
 
+    /**
+     * Whether atomic accesses which warmAccess() can handle bypass
+     * access() and its latency calculations.
+     */
+    const bool atomicWarm;
+
     /** The number of targets for each MSHR. */
     const int numTarget;
 
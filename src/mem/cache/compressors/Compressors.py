@@ -64,6 +64,17 @@ class BaseCacheCompressor(SimObject):
         "to finish decompression (e.g., due to shifting and packaging).",
     )
 
+    size_only = Param.Bool(
+        False,
+        "Only compute the compressed size and latencies. The compressed "
+        "data cannot be decompressed afterwards.",
+    )
+    memo_entries = Param.Unsigned(
+        0,
+        "Number of recently compressed lines whose size and latencies are "
+        "remembered in size-only mode (0 to disable).",
+    )
+
 
 class BaseDictionaryCompressor(BaseCacheCompressor):
     type = "BaseDictionaryCompressor"
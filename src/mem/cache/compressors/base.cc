@@ -36,8 +36,10 @@
 #include <climits>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
@@ -88,6 +90,7 @@ Base::Base(const Params &p)
     compExtraLatency(p.comp_extra_latency),
     decompChunksPerCycle(p.decomp_chunks_per_cycle),
     decompExtraLatency(p.decomp_extra_latency),
+    sizeOnly(p.size_only), memo(p.memo_entries),
     cache(nullptr), stats(*this)
 {
     fatal_if(64 % chunkSizeBits,
@@ -101,6 +104,9 @@ Base::Base(const Params &p)
         "chunks in the input");
 
     fatal_if(blkSize < sizeThreshold, "Compressed data must fit in a block");
+
+    fatal_if(!sizeOnly && !memo.empty(),
+        "The compression memo can only be used in size-only mode.");
 }
 
 void
@@ -118,12 +124,12 @@ Base::toChunks(const uint64_t* data) const
         (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
 
     // Turn a 64-bit array into a chunkSizeBits-array
-    std::vector<Chunk> chunks((blkSize * CHAR_BIT) / chunkSizeBits, 0);
+    std::vector<Chunk> chunks((blkSize * CHAR_BIT) / chunkSizeBits);
+    const uint64_t chunk_mask = mask(chunkSizeBits);
     for (int i = 0; i < chunks.size(); i++) {
-        const int index_64 = std::floor(i / (double)num_chunks_per_64);
         const unsigned start = i % num_chunks_per_64;
-        chunks[i] = bits(data[index_64],
-            (start + 1) * chunkSizeBits - 1, start * chunkSizeBits);
+        chunks[i] = (data[i / num_chunks_per_64] >> (start * chunkSizeBits)) &
+            chunk_mask;
     }
 
     return chunks;
@@ -138,20 +144,73 @@ Base::fromChunks(const std::vector<Chunk>& chunks, uint64_t* data) const
 
     // Turn a chunkSizeBits-array into a 64-bit array
     std::memset(data, 0, blkSize);
+    const uint64_t chunk_mask = mask(chunkSizeBits);
     for (int i = 0; i < chunks.size(); i++) {
-        const int index_64 = std::floor(i / (double)num_chunks_per_64);
         const unsigned start = i % num_chunks_per_64;
-        replaceBits(data[index_64], (start + 1) * chunkSizeBits - 1,
-            start * chunkSizeBits, chunks[i]);
+        data[i / num_chunks_per_64] |=
+            (chunks[i] & chunk_mask) << (start * chunkSizeBits);
+    }
+}
+
+std::size_t
+Base::memoIndex(const uint64_t* data) const
+{
+    uint64_t hash = 0;
+    for (std::size_t i = 0; i < blkSize / sizeof(uint64_t); i++) {
+        hash = (hash ^ data[i]) * 0x9e3779b97f4a7c15ULL;
     }
+    return (hash ^ (hash >> 32)) % memo.size();
+}
+
+std::size_t
+Base::compressSize(const std::vector<Chunk>& chunks, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    return compress(chunks, comp_lat, decomp_lat)->getSizeBits();
 }
 
 std::unique_ptr<Base::CompressionData>
 Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
+{
+    if (!sizeOnly) {
+        return compressChunks(toChunks(data), data, comp_lat, decomp_lat);
+    }
+
+    MemoEntry* entry = nullptr;
+    if (!memo.empty()) {
+        entry = &memo[memoIndex(data)];
+    }
+
+    std::unique_ptr<CompressionData> comp_data(new CompressionData());
+    if (entry && entry->valid &&
+            std::memcmp(entry->data.data(), data, blkSize) == 0) {
+        comp_data->setSizeBits(entry->sizeBits);
+        comp_lat = entry->compLat;
+        decomp_lat = entry->decompLat;
+        stats.memoHits++;
+    } else {
+        comp_data->setSizeBits(
+            compressSize(toChunks(data), comp_lat, decomp_lat));
+        if (entry) {
+            entry->valid = true;
+            entry->data.assign(data, data + blkSize / sizeof(uint64_t));
+            entry->sizeBits = comp_data->getSizeBits();
+            entry->compLat = comp_lat;
+            entry->decompLat = decomp_lat;
+        }
+    }
+
+    recordCompression(*comp_data, comp_lat, decomp_lat);
+    return comp_data;
+}
+
+std::unique_ptr<Base::CompressionData>
+Base::compressChunks(const std::vector<Chunk>& chunks, const uint64_t* data,
+    Cycles& comp_lat, Cycles& decomp_lat)
 {
     // Apply compression
     std::unique_ptr<CompressionData> comp_data =
-        compress(toChunks(data), comp_lat, decomp_lat);
+        compress(chunks, comp_lat, decomp_lat);
 
     // If we are in debug mode apply decompression just after the compression.
     // If the results do not match, we've got an error
@@ -166,12 +225,20 @@ Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
              "Decompressed line does not match original line.");
     #endif
 
+    recordCompression(*comp_data, comp_lat, decomp_lat);
+    return comp_data;
+}
+
+void
+Base::recordCompression(CompressionData& comp_data, Cycles comp_lat,
+    Cycles decomp_lat)
+{
     // Get compression size. If compressed size is greater than the size
     // threshold, the compression is seen as unsuccessful
-    std::size_t comp_size_bits = comp_data->getSizeBits();
+    std::size_t comp_size_bits = comp_data.getSizeBits();
     if (comp_size_bits > sizeThreshold * CHAR_BIT) {
         comp_size_bits = blkSize * CHAR_BIT;
-        comp_data->setSizeBits(comp_size_bits);
+        comp_data.setSizeBits(comp_size_bits);
         stats.failedCompressions++;
     }
 
@@ -188,8 +255,6 @@ Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
     DPRINTF(CacheComp, "Compressed cache line from %d to %d bits. " \
             "Compression latency: %llu, decompression latency: %llu\n",
             blkSize*8, comp_size_bits, comp_lat, decomp_lat);
-
-    return comp_data;
 }
 
 Cycles
@@ -245,7 +310,9 @@ Base::BaseStats::BaseStats(Base& _compressor)
                 statistics::units::Bit, statistics::units::Count>::get(),
              "Average compression size"),
     ADD_STAT(decompressions, statistics::units::Count::get(),
-             "Total number of decompressions")
+             "Total number of decompressions"),
+    ADD_STAT(memoHits, statistics::units::Count::get(),
+             "Number of size-only compressions found in the memo")
 {
 }
 
@@ -269,6 +336,8 @@ Base::BaseStats::regStats()
     avgCompressionSizeBits.flags(statistics::total | statistics::nozero |
         statistics::nonan);
     avgCompressionSizeBits = compressionSizeBits / compressions;
+
+    memoHits.flags(statistics::nozero);
 }
 
 } // namespace compression
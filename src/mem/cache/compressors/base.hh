@@ -125,6 +125,29 @@ class Base : public SimObject
      */
     const Cycles decompExtraLatency;
 
+    /**
+     * Whether only the size and latencies of the compressed data are
+     * needed, so that the data itself does not have to be generated.
+     */
+    const bool sizeOnly;
+
+    /** A line recently compressed in size-only mode. */
+    struct MemoEntry
+    {
+        bool valid = false;
+        std::vector<uint64_t> data;
+        std::size_t sizeBits = 0;
+        Cycles compLat;
+        Cycles decompLat;
+    };
+
+    /**
+     * Direct mapped table of the results of recent size-only compressions,
+     * indexed by a hash of the line contents. Zero lines and lines that
+     * are copied around are common, and are not compressed again.
+     */
+    std::vector<MemoEntry> memo;
+
     /** Pointer to the parent cache. */
     BaseCache* cache;
 
@@ -153,6 +176,9 @@ class Base : public SimObject
 
         /** Number of decompressions performed. */
         statistics::Scalar decompressions;
+
+        /** Number of size-only compressions found in the memo. */
+        statistics::Scalar memoHits;
     } stats;
 
     /**
@@ -172,6 +198,35 @@ class Base : public SimObject
      */
     void fromChunks(const std::vector<Chunk>& chunks, uint64_t* data) const;
 
+    /**
+     * Apply the compression process to a cache line that has already been
+     * divided into chunks of this compressor's chunk size, and update the
+     * stats. This is what compress(const uint64_t*, ...) does after the
+     * split, and allows sharing the split between compressors.
+     *
+     * @param chunks The cache line to be compressed, divided into chunks.
+     * @param data The cache line to be compressed.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     * @return Cache line after compression.
+     */
+    std::unique_ptr<CompressionData> compressChunks(
+        const std::vector<Chunk>& chunks, const uint64_t* data,
+        Cycles& comp_lat, Cycles& decomp_lat);
+
+    /**
+     * Apply the size threshold to a compressed line and update the stats.
+     *
+     * @param comp_data Cache line after compression.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     */
+    void recordCompression(CompressionData& comp_data, Cycles comp_lat,
+        Cycles decomp_lat);
+
+    /** Index in the memo of the entry a line maps to. */
+    std::size_t memoIndex(const uint64_t* data) const;
+
     /**
      * Apply the compression process to the cache line.
      * Returns the number of cycles used by the compressor, however it is
@@ -197,6 +252,20 @@ class Base : public SimObject
     virtual void decompress(const CompressionData* comp_data,
                               uint64_t* cache_line) = 0;
 
+    /**
+     * Calculate the size the cache line compresses to, without generating
+     * the compressed data. By default the line is compressed, and the
+     * data discarded, so compressors that can tell the size faster should
+     * override this.
+     *
+     * @param chunks The cache line to be compressed, divided into chunks.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     * @return Size of the compressed line, in bits.
+     */
+    virtual std::size_t compressSize(const std::vector<Chunk>& chunks,
+        Cycles& comp_lat, Cycles& decomp_lat);
+
   public:
     typedef BaseCacheCompressorParams Params;
     Base(const Params &p);
@@ -207,7 +276,8 @@ class Base : public SimObject
 
     /**
      * Apply the compression process to the cache line. Ignores compression
-     * cycles.
+     * cycles. In size-only mode the returned data only holds the size, and
+     * cannot be decompressed.
      *
      * @param data The cache line to be compressed.
      * @param comp_lat Compression latency in number of cycles.
@@ -106,6 +106,15 @@ class BaseDelta : public DictionaryCompressor<BaseType>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    int
+    getPatternIndex(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes,
+        const int match_location) const override
+    {
+        return PatternFactory::getPatternIndex(bytes, dict_bytes,
+                                               match_location);
+    }
+
     std::string
     getName(int number) const override
     {
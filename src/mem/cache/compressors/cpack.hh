@@ -101,6 +101,15 @@ class CPack : public DictionaryCompressor<uint32_t>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    int
+    getPatternIndex(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes,
+        const int match_location) const override
+    {
+        return PatternFactory::getPatternIndex(bytes, dict_bytes,
+                                               match_location);
+    }
+
     void addToDictionary(DictionaryEntry data) override;
 
   public:
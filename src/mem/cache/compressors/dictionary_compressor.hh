@@ -167,6 +167,25 @@ class DictionaryCompressor : public BaseDictionaryCompressor
                                                     match_location);
             }
         }
+
+        /**
+         * Find the pattern getPattern() would instantiate, without
+         * instantiating it.
+         *
+         * @return The position of the pattern in the factory.
+         */
+        static int
+        getPatternIndex(const DictionaryEntry& bytes,
+            const DictionaryEntry& dict_bytes, const int match_location,
+            const int index = 0)
+        {
+            if (Head::isPattern(bytes, dict_bytes, match_location)) {
+                return index;
+            }
+            return Factory<Tail...>::getPatternIndex(bytes, dict_bytes,
+                                                     match_location,
+                                                     index + 1);
+        }
     };
 
     /**
@@ -188,6 +207,14 @@ class DictionaryCompressor : public BaseDictionaryCompressor
         {
             return std::unique_ptr<Pattern>(new Head(bytes, match_location));
         }
+
+        static int
+        getPatternIndex(const DictionaryEntry& bytes,
+            const DictionaryEntry& dict_bytes, const int match_location,
+            const int index = 0)
+        {
+            return index;
+        }
     };
 
     /** The dictionary. */
@@ -202,6 +229,16 @@ class DictionaryCompressor : public BaseDictionaryCompressor
     getPattern(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
         const int match_location) const = 0;
 
+    /**
+     * Likewise, classes that inherit from this base class have to implement
+     * the call to their factory's getPatternIndex. It is used to skip the
+     * dictionary entries that can't give a smaller pattern without
+     * instantiating their pattern.
+     */
+    virtual int
+    getPatternIndex(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes, const int match_location) const = 0;
+
     /**
      * Compress data.
      *
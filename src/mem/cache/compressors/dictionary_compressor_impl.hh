@@ -101,9 +101,18 @@ DictionaryCompressor<T>::compressValue(const T data)
     // patterns that depend on the dictionary entry don't match
     std::unique_ptr<Pattern> pattern =
         getPattern(bytes, toDictionaryEntry(0), -1);
+    int pattern_index = getPatternIndex(bytes, toDictionaryEntry(0), -1);
 
     // Search for word on dictionary
     for (std::size_t i = 0; i < numEntries; i++) {
+        // The factories are sorted by size, so only the entries matching
+        // an earlier pattern can be better. This avoids instantiating a
+        // pattern for every entry.
+        const int temp_index = getPatternIndex(bytes, dictionary[i], i);
+        if (temp_index >= pattern_index) {
+            continue;
+        }
+
         // Try matching input with possible patterns
         std::unique_ptr<Pattern> temp_pattern =
             getPattern(bytes, dictionary[i], i);
@@ -111,6 +120,7 @@ DictionaryCompressor<T>::compressValue(const T data)
         // Check if found pattern is better than previous
         if (temp_pattern->getSizeBits() < pattern->getSizeBits()) {
             pattern = std::move(temp_pattern);
+            pattern_index = temp_index;
         }
     }
 
@@ -112,17 +112,27 @@ class FPC : public DictionaryCompressor<uint32_t>
         return patternNames[number];
     };
 
+    using PatternFactory = Factory<ZeroRun, SignExtended4Bits,
+        SignExtended1Byte, SignExtendedHalfword, ZeroPaddedHalfword,
+        SignExtendedTwoHalfwords, RepBytes, Uncompressed>;
+
     std::unique_ptr<Pattern> getPattern(
         const DictionaryEntry& bytes,
         const DictionaryEntry& dict_bytes,
         const int match_location) const override
     {
-        using PatternFactory = Factory<ZeroRun, SignExtended4Bits,
-            SignExtended1Byte, SignExtendedHalfword, ZeroPaddedHalfword,
-            SignExtendedTwoHalfwords, RepBytes, Uncompressed>;
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    int
+    getPatternIndex(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes,
+        const int match_location) const override
+    {
+        return PatternFactory::getPatternIndex(bytes, dict_bytes,
+                                               match_location);
+    }
+
     void addToDictionary(const DictionaryEntry data) override;
 
     std::unique_ptr<DictionaryCompressor::CompData>
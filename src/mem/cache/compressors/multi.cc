@@ -33,6 +33,7 @@
 
 #include "mem/cache/compressors/multi.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <queue>
 
@@ -137,10 +138,12 @@ Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     };
 
     // Each sub-compressor can have its own chunk size; therefore, revert
-    // the chunks to raw data, so that they handle the conversion internally
+    // the chunks to raw data, and split it once for each distinct size
     uint64_t data[blkSize / sizeof(uint64_t)];
     std::memset(data, 0, blkSize);
     fromChunks(chunks, data);
+    std::vector<std::pair<unsigned, std::vector<Chunk>>> splits;
+    splits.emplace_back(chunkSizeBits, chunks);
 
     // Find the ranking of the compressor outputs
     std::priority_queue<std::shared_ptr<Results>,
@@ -148,8 +151,16 @@ Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     Cycles max_comp_lat;
     for (unsigned i = 0; i < compressors.size(); i++) {
         Cycles temp_decomp_lat;
-        auto temp_comp_data =
-            compressors[i]->compress(data, comp_lat, temp_decomp_lat);
+        Base *const compressor = compressors[i];
+        auto split = std::find_if(splits.begin(), splits.end(),
+            [compressor](const auto &split)
+            { return split.first == compressor->chunkSizeBits; });
+        if (split == splits.end()) {
+            split = splits.emplace(splits.end(), compressor->chunkSizeBits,
+                compressor->toChunks(data));
+        }
+        auto temp_comp_data = compressor->compressChunks(split->second, data,
+            comp_lat, temp_decomp_lat);
         temp_comp_data->setSizeBits(temp_comp_data->getSizeBits() +
             numEncodingBits);
         results.push(std::make_shared<Results>(i, std::move(temp_comp_data),
@@ -49,6 +49,19 @@ Perfect::Perfect(const Params &p)
 {
 }
 
+std::size_t
+Perfect::compressSize(const std::vector<Chunk>& chunks,
+    Cycles& comp_lat, Cycles& decomp_lat)
+{
+    // Set latencies based on the degree of parallelization, and any extra
+    // latencies due to shifting or packaging
+    comp_lat = Cycles((chunks.size() / compChunksPerCycle) + compExtraLatency);
+    decomp_lat = Cycles((chunks.size() / decompChunksPerCycle) +
+        decompExtraLatency);
+
+    return compressedSize;
+}
+
 std::unique_ptr<Base::CompressionData>
 Perfect::compress(const std::vector<Chunk>& chunks,
     Cycles& comp_lat, Cycles& decomp_lat)
@@ -57,13 +70,7 @@ Perfect::compress(const std::vector<Chunk>& chunks,
     std::unique_ptr<Base::CompressionData> comp_data(new CompData(chunks));
 
     // Set relevant metadata
-    comp_data->setSizeBits(compressedSize);
-
-    // Set latencies based on the degree of parallelization, and any extra
-    // latencies due to shifting or packaging
-    comp_lat = Cycles((chunks.size() / compChunksPerCycle) + compExtraLatency);
-    decomp_lat = Cycles((chunks.size() / decompChunksPerCycle) +
-        decompExtraLatency);
+    comp_data->setSizeBits(compressSize(chunks, comp_lat, decomp_lat));
 
     return comp_data;
 }
@@ -69,6 +69,9 @@ class Perfect : public Base
 
     void decompress(const CompressionData* comp_data, uint64_t* data) override;
 
+    std::size_t compressSize(const std::vector<Chunk>& chunks,
+        Cycles& comp_lat, Cycles& decomp_lat) override;
+
   public:
     typedef PerfectCompressorParams Params;
     Perfect(const Params &p);
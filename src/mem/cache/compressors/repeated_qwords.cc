@@ -33,6 +33,8 @@
 
 #include "mem/cache/compressors/repeated_qwords.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
 #include "mem/cache/compressors/dictionary_compressor_impl.hh"
@@ -81,5 +83,31 @@ RepeatedQwords::compress(const std::vector<Chunk>& chunks,
     return comp_data;
 }
 
+std::size_t
+RepeatedQwords::compressSize(const std::vector<Chunk>& chunks,
+    Cycles& comp_lat, Cycles& decomp_lat)
+{
+    // The first occurrence of each value is stored uncompressed, and the
+    // others are matches of size 0, as compress() would find
+    std::size_t num_values = 0;
+    for (auto it = chunks.begin(); it != chunks.end(); ++it) {
+        if (std::find(chunks.begin(), it, *it) == it) {
+            num_values++;
+        }
+    }
+    dictionaryStats.patterns[X] += num_values;
+    dictionaryStats.patterns[M] += chunks.size() - num_values;
+
+    comp_lat = Cycles(1);
+    decomp_lat = Cycles(1);
+
+    assert(num_values >= 1);
+    if (num_values > 1) {
+        DPRINTF(CacheComp, "Repeated qwords compression failed\n");
+        return blkSize * 8;
+    }
+    return PatternX(toDictionaryEntry(chunks[0]), 0).getSizeBits();
+}
+
 } // namespace compression
 } // namespace gem5
@@ -61,6 +61,8 @@ class AssociativeSet
     replacement_policy::Base* const replacementPolicy;
     /** Vector containing the entries of the container */
     std::vector<Entry> entries;
+    /** Storage reused by the indexing policy to look entries up */
+    mutable std::vector<ReplaceableEntry*> lookupEntries;
 
   public:
     /**
@@ -46,10 +46,11 @@ AssociativeSet<Entry>::AssociativeSet(int assoc, int num_entries,
              "AssociativeSet<> must be a power of 2");
     fatal_if(!isPowerOf2(assoc), "The associativity of an AssociativeSet<> "
              "must be a power of 2");
+    auto replacement_data = replacementPolicy->instantiateEntries(numEntries);
     for (unsigned int entry_idx = 0; entry_idx < numEntries; entry_idx += 1) {
         Entry* entry = &entries[entry_idx];
         indexingPolicy->setEntry(entry, entry_idx);
-        entry->replacementData = replacementPolicy->instantiateEntry();
+        entry->replacementData = std::move(replacement_data[entry_idx]);
     }
 }
 
@@ -58,8 +59,8 @@ Entry*
 AssociativeSet<Entry>::findEntry(Addr addr, bool is_secure) const
 {
     Addr tag = indexingPolicy->extractTag(addr);
-    const std::vector<ReplaceableEntry*> selected_entries =
-        indexingPolicy->getPossibleEntries(addr);
+    const std::vector<ReplaceableEntry*> &selected_entries =
+        indexingPolicy->lookupPossibleEntries(addr, lookupEntries);
 
     for (const auto& location : selected_entries) {
         Entry* entry = static_cast<Entry *>(location);
@@ -83,10 +84,11 @@ Entry*
 AssociativeSet<Entry>::findVictim(Addr addr)
 {
     // Get possible entries to be victimized
-    const std::vector<ReplaceableEntry*> selected_entries =
-        indexingPolicy->getPossibleEntries(addr);
-    Entry* victim = static_cast<Entry*>(replacementPolicy->getVictim(
-                            selected_entries));
+    const std::vector<ReplaceableEntry*> &selected_entries =
+        indexingPolicy->lookupPossibleEntries(addr, lookupEntries);
+    Entry* victim = static_cast<Entry*>(replacementPolicy->getVictimInRange(
+        selected_entries.data(),
+        selected_entries.data() + selected_entries.size()));
     // There is only one eviction for this replacement
     invalidate(victim);
     return victim;
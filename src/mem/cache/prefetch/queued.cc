@@ -37,6 +37,7 @@
 
 #include "mem/cache/prefetch/queued.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "arch/generic/tlb.hh"
@@ -54,26 +55,26 @@ namespace gem5
 namespace prefetch
 {
 
-void
-Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
+PacketPtr
+Queued::DeferredPacket::createPkt(unsigned blk_size,
                                             RequestorID requestor_id,
-                                            bool tag_prefetch,
-                                            Tick t) {
+                                            bool tag_prefetch) const
+{
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size,
+    RequestPtr req = makeRequest(paddr, blk_size,
                                                 0, requestor_id);
 
     if (pfInfo.isSecure()) {
         req->setFlags(Request::SECURE);
     }
     req->taskId(context_switch_task_id::Prefetcher);
-    pkt = new Packet(req, MemCmd::HardPFReq);
+    PacketPtr pkt = new Packet(req, MemCmd::HardPFReq);
     pkt->allocate();
     if (tag_prefetch && pfInfo.hasPC()) {
         // Tag prefetch packet with  accessing pc
         pkt->req->setPC(pfInfo.getPC());
     }
-    tick = t;
+    return pkt;
 }
 
 void
@@ -108,14 +109,6 @@ Queued::Queued(const QueuedPrefetcherParams &p)
 {
 }
 
-Queued::~Queued()
-{
-    // Delete the queued prefetch packets
-    for (DeferredPacket &p : pfq) {
-        delete p.pkt;
-    }
-}
-
 void
 Queued::printQueue(const std::list<DeferredPacket> &queue) const
 {
@@ -131,8 +124,8 @@ Queued::printQueue(const std::list<DeferredPacket> &queue) const
     for (const_iterator it = queue.cbegin(); it != queue.cend();
                                                             it++, pos++) {
         Addr vaddr = it->pfInfo.getAddr();
-        /* Set paddr to 0 if not yet translated */
-        Addr paddr = it->pkt ? it->pkt->getAddr() : 0;
+        /* paddr is 0 if not yet translated */
+        Addr paddr = it->paddr;
         DPRINTF(HWPrefetchQueue, "%s[%d]: Prefetch Req VA: %#x PA: %#x "
                 "prio: %3d\n", queue_name, pos, vaddr, paddr, it->priority);
     }
@@ -178,20 +171,15 @@ Queued::notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi)
 
     // Squash queued prefetches if demand miss to same line
     if (queueSquash) {
-        auto itr = pfq.begin();
-        while (itr != pfq.end()) {
-            if (blockAddress(itr->pfInfo.getAddr()) == blk_addr &&
-                itr->pfInfo.isSecure() == is_secure) {
-                DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
-                        "(cl: %#x), demand request going to the same addr\n",
-                        itr->pfInfo.getAddr(),
-                        blockAddress(itr->pfInfo.getAddr()));
-                delete itr->pkt;
-                itr = pfq.erase(itr);
-                statsQueued.pfRemovedDemand++;
-            } else {
-                ++itr;
-            }
+        auto range = pfqIndex.equal_range(blk_addr | (is_secure ? 1 : 0));
+        while (range.first != range.second) {
+            iterator itr = (range.first++)->second;
+            DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
+                    "(cl: %#x), demand request going to the same addr\n",
+                    itr->pfInfo.getAddr(),
+                    blockAddress(itr->pfInfo.getAddr()));
+            dequeue(pfq, itr);
+            statsQueued.pfRemovedDemand++;
         }
     }
 
@@ -251,12 +239,11 @@ Queued::getPacket()
         return nullptr;
     }
 
-    PacketPtr pkt = pfq.front().pkt;
-    pfq.pop_front();
+    PacketPtr pkt = pfq.front().createPkt(blkSize, requestorId, tagPrefetch);
+    dequeue(pfq, pfq.begin());
 
     prefetchStats.pfIssued++;
     issuedPrefetches += 1;
-    assert(pkt != nullptr);
     DPRINTF(HWPrefetch, "Generating prefetch for %#x.\n", pkt->getAddr());
 
     processMissingTranslations(queueSize - pfq.size());
@@ -303,14 +290,12 @@ void
 Queued::translationComplete(DeferredPacket *dp, bool failed,
                             const CacheAccessor &cache)
 {
-    auto it = pfqMissingTranslation.begin();
-    while (it != pfqMissingTranslation.end()) {
-        if (&(*it) == dp) {
-            break;
-        }
-        it++;
-    }
-    assert(it != pfqMissingTranslation.end());
+    auto range = pfqMissingTranslationIndex.equal_range(
+        indexKey(dp->pfInfo));
+    auto entry = std::find_if(range.first, range.second,
+        [dp](const auto &candidate) { return &(*candidate.second) == dp; });
+    assert(entry != range.second);
+    iterator it = entry->second;
     if (!failed) {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x succeeded: "
                 "paddr %#x \n", mmu->name(),
@@ -326,8 +311,7 @@ Queued::translationComplete(DeferredPacket *dp, bool failed,
                     "cache/MSHR prefetch addr:%#x\n", target_paddr);
         } else {
             Tick pf_time = curTick() + clockPeriod() * latency;
-            it->createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
-                          pf_time);
+            it->setPaddr(target_paddr, pf_time);
             addToQueue(pfq, *it);
         }
     } else {
@@ -335,49 +319,51 @@ Queued::translationComplete(DeferredPacket *dp, bool failed,
                 "prefetch request %#x \n", mmu->name(),
                 it->translationRequest->getVaddr());
     }
-    pfqMissingTranslation.erase(it);
+    dequeue(pfqMissingTranslation, it);
 }
 
 bool
 Queued::alreadyInQueue(std::list<DeferredPacket> &queue,
                                  const PrefetchInfo &pfi, int32_t priority)
 {
-    bool found = false;
-    iterator it;
-    for (it = queue.begin(); it != queue.end() && !found; it++) {
-        found = it->pfInfo.sameAddr(pfi);
+    QueueIndex &index = queueIndex(queue);
+    auto range = index.equal_range(indexKey(pfi));
+    auto entry = std::find_if(range.first, range.second,
+        [&pfi](const auto &candidate)
+        { return candidate.second->pfInfo.sameAddr(pfi); });
+    if (entry == range.second) {
+        return false;
     }
 
-    /* If the address is already in the queue, update priority and leave */
-    if (it != queue.end()) {
-        statsQueued.pfBufferHit++;
-        if (it->priority < priority) {
-            /* Update priority value and position in the queue */
-            it->priority = priority;
-            iterator prev = it;
-            while (prev != queue.begin()) {
-                prev--;
-                /* If the packet has higher priority, swap */
-                if (*it > *prev) {
-                    std::swap(*it, *prev);
-                    it = prev;
-                }
-            }
-            DPRINTF(HWPrefetch, "Prefetch addr already in "
-                "prefetch queue, priority updated\n");
-        } else {
-            DPRINTF(HWPrefetch, "Prefetch addr already in "
-                "prefetch queue\n");
+    /* The address is already in the queue, update priority and leave */
+    iterator it = entry->second;
+    statsQueued.pfBufferHit++;
+    if (it->priority < priority) {
+        /*
+         * Update priority value and position in the queue, moving the
+         * entry itself so that the index and any ongoing translation
+         * keep referring to it
+         */
+        it->priority = priority;
+        iterator pos = it;
+        while (pos != queue.begin() && std::prev(pos)->priority < priority) {
+            pos--;
         }
+        queue.splice(pos, queue, it);
+        DPRINTF(HWPrefetch, "Prefetch addr already in "
+            "prefetch queue, priority updated\n");
+    } else {
+        DPRINTF(HWPrefetch, "Prefetch addr already in "
+            "prefetch queue\n");
     }
-    return found;
+    return true;
 }
 
 RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = makeRequest(
             addr, blkSize, pkt->req->getFlags(), requestorId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
@@ -467,8 +453,7 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
     DeferredPacket dpp(this, new_pfi, 0, priority, cache);
     if (has_target_pa) {
         Tick pf_time = curTick() + clockPeriod() * latency;
-        dpp.createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
-                      pf_time);
+        dpp.setPaddr(target_paddr, pf_time);
         DPRINTF(HWPrefetch, "Prefetch queued. "
                 "addr:%#x priority: %3d tick:%lld.\n",
                 new_pfi.getAddr(), priority, pf_time);
@@ -511,12 +496,11 @@ Queued::addToQueue(std::list<DeferredPacket> &queue,
         }
         DPRINTF(HWPrefetch, "Prefetch queue full, removing lowest priority "
                             "oldest packet, addr: %#x\n",it->pfInfo.getAddr());
-        delete it->pkt;
-        queue.erase(it);
+        dequeue(queue, it);
     }
 
     if ((queue.size() == 0) || (dpp <= queue.back())) {
-        queue.emplace_back(dpp);
+        enqueue(queue, queue.end(), dpp);
     } else {
         iterator it = queue.end();
         do {
@@ -526,12 +510,53 @@ Queued::addToQueue(std::list<DeferredPacket> &queue,
          * or not */
         if (it == queue.begin() && dpp <= *it)
             it++;
-        queue.insert(it, dpp);
+        enqueue(queue, it, dpp);
     }
 
     if (debug::HWPrefetchQueue)
         printQueue(queue);
 }
 
+Queued::QueueIndex &
+Queued::queueIndex(const std::list<DeferredPacket> &queue)
+{
+    if (&queue == &pfq) {
+        return pfqIndex;
+    } else {
+        assert(&queue == &pfqMissingTranslation);
+        return pfqMissingTranslationIndex;
+    }
+}
+
+Queued::iterator
+Queued::enqueue(std::list<DeferredPacket> &queue, iterator pos,
+                const DeferredPacket &dp)
+{
+    if (freeEntries.empty()) {
+        freeEntries.emplace_back(dp);
+    } else {
+        freeEntries.front() = dp;
+    }
+    iterator it = freeEntries.begin();
+    queue.splice(pos, freeEntries, it);
+    queueIndex(queue).emplace(indexKey(it->pfInfo), it);
+    return it;
+}
+
+void
+Queued::dequeue(std::list<DeferredPacket> &queue, iterator it)
+{
+    QueueIndex &index = queueIndex(queue);
+    auto range = index.equal_range(indexKey(it->pfInfo));
+    auto entry = std::find_if(range.first, range.second,
+        [it](const auto &candidate) { return candidate.second == it; });
+    assert(entry != range.second);
+    index.erase(entry);
+
+    // Do not keep the translation request alive while the entry is free
+    it->translationRequest = nullptr;
+    freeEntries.splice(freeEntries.end(), queue, it);
+}
+
 } // namespace prefetch
 } // namespace gem5
@@ -40,6 +40,7 @@
 
 #include <cstdint>
 #include <list>
+#include <unordered_map>
 #include <utility>
 
 #include "arch/generic/mmu.hh"
@@ -67,8 +68,8 @@ class Queued : public Base
         PrefetchInfo pfInfo;
         /** Time when this prefetch becomes ready */
         Tick tick;
-        /** The memory packet generated by this prefetch */
-        PacketPtr pkt;
+        /** Physical address of this prefetch, 0 if not yet translated */
+        Addr paddr;
         /** The priority of this prefetch */
         int32_t priority;
         /** Request used when a translation is needed */
@@ -87,7 +88,7 @@ class Queued : public Base
          */
         DeferredPacket(Queued *o, PrefetchInfo const &pfi, Tick t,
             int32_t prio, const CacheAccessor &_cache)
-            : owner(o), pfInfo(pfi), tick(t), pkt(nullptr),
+            : owner(o), pfInfo(pfi), tick(t), paddr(0),
             priority(prio), translationRequest(), tc(nullptr),
             ongoingTranslation(false), cache(&_cache) {
         }
@@ -106,17 +107,30 @@ class Queued : public Base
         }
 
         /**
-         * Create the associated memory packet
-         * @param paddr physical address of this packet
+         * Set the physical address of this prefetch once it is known
+         * @param _paddr physical address of this prefetch
+         * @param t time when the prefetch becomes ready
+         */
+        void
+        setPaddr(Addr _paddr, Tick t)
+        {
+            paddr = _paddr;
+            tick = t;
+        }
+
+        /**
+         * Create the associated memory packet. This is only done when the
+         * prefetch is issued, so that prefetches dropped from the queue
+         * never allocate one.
          * @param blk_size block size used by the prefetcher
          * @param requestor_id Requestor ID of the access that generated
          * this prefetch
          * @param tag_prefetch flag to indicate if the packet needs to be
          *        tagged
-         * @param t time when the prefetch becomes ready
+         * @return the memory packet of this prefetch
          */
-        void createPkt(Addr paddr, unsigned blk_size, RequestorID requestor_id,
-                       bool tag_prefetch, Tick t);
+        PacketPtr createPkt(unsigned blk_size, RequestorID requestor_id,
+                            bool tag_prefetch) const;
 
         /**
          * Sets the translation request needed to obtain the physical address
@@ -147,6 +161,21 @@ class Queued : public Base
     using const_iterator = std::list<DeferredPacket>::const_iterator;
     using iterator = std::list<DeferredPacket>::iterator;
 
+    /**
+     * Index of the entries of a queue by block address and security, to
+     * find the queued prefetches to an address without scanning the queue
+     */
+    using QueueIndex = std::unordered_multimap<Addr, iterator>;
+    QueueIndex pfqIndex;
+    QueueIndex pfqMissingTranslationIndex;
+
+    /**
+     * Entries removed from the queues, kept to hold the next queued
+     * prefetches, so that queueing stops allocating memory once the
+     * queues have been filled
+     */
+    std::list<DeferredPacket> freeEntries;
+
     // PARAMETERS
 
     /** Maximum size of the prefetch queue */
@@ -192,7 +221,7 @@ class Queued : public Base
     using AddrPriority = std::pair<Addr, int32_t>;
 
     Queued(const QueuedPrefetcherParams &p);
-    virtual ~Queued();
+    virtual ~Queued() = default;
 
     void
     notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi) override;
@@ -221,6 +250,42 @@ class Queued : public Base
      */
     void addToQueue(std::list<DeferredPacket> &queue, DeferredPacket &dpp);
 
+    /**
+     * Key of a prefetch in the queue indexes
+     * @param pfi information of the prefetch request
+     * @return its block address, tagged with its security
+     */
+    Addr
+    indexKey(const PrefetchInfo &pfi) const
+    {
+        return blockAddress(pfi.getAddr()) | (pfi.isSecure() ? 1 : 0);
+    }
+
+    /**
+     * Gets the index of the specified queue
+     * @param queue selected queue
+     * @return the index of its entries
+     */
+    QueueIndex &queueIndex(const std::list<DeferredPacket> &queue);
+
+    /**
+     * Places a copy of a DeferredPacket in a queue, reusing a free entry
+     * if there is one
+     * @param queue selected queue to use
+     * @param pos position of the queue to insert the packet before
+     * @param dp DeferredPacket to add
+     * @return the queued entry
+     */
+    iterator enqueue(std::list<DeferredPacket> &queue, iterator pos,
+                     const DeferredPacket &dp);
+
+    /**
+     * Removes an entry from a queue, keeping it for later reuse
+     * @param queue selected queue
+     * @param it entry to remove
+     */
+    void dequeue(std::list<DeferredPacket> &queue, iterator it);
+
     /**
      * Starts the translations of the queued prefetches with a
      * missing translation. It performs a maximum specified number of
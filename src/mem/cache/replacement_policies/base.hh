@@ -30,6 +30,7 @@
 #define __MEM_CACHE_REPLACEMENT_POLICIES_BASE_HH__
 
 #include <memory>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
@@ -103,12 +104,73 @@ class Base : public SimObject
     virtual ReplaceableEntry* getVictim(
                            const ReplacementCandidates& candidates) const = 0;
 
+    /**
+     * Find replacement victim among a contiguous range of candidates, such
+     * as the ways of a set, without building a ReplacementCandidates. The
+     * default implementation copies the range to use getVictim().
+     *
+     * @param first The first replacement candidate.
+     * @param last One past the last replacement candidate.
+     * @return Replacement entry to be replaced.
+     */
+    virtual ReplaceableEntry*
+    getVictimInRange(ReplaceableEntry* const* first,
+                     ReplaceableEntry* const* last) const
+    {
+        return getVictim(ReplacementCandidates(first, last));
+    }
+
     /**
      * Instantiate a replacement data entry.
      *
      * @return A shared pointer to the new replacement data.
      */
     virtual std::shared_ptr<ReplacementData> instantiateEntry() = 0;
+
+    /**
+     * Instantiate the replacement data entries of a whole table at once.
+     * Policies whose entries are independent of each other allocate them
+     * in a single contiguous array, instead of one allocation per entry.
+     *
+     * @param num_entries The number of entries to instantiate.
+     * @return Shared pointers to the new replacement data.
+     */
+    virtual std::vector<std::shared_ptr<ReplacementData>>
+    instantiateEntries(std::size_t num_entries)
+    {
+        std::vector<std::shared_ptr<ReplacementData>> entries;
+        entries.reserve(num_entries);
+        for (std::size_t i = 0; i < num_entries; i++) {
+            entries.push_back(instantiateEntry());
+        }
+        return entries;
+    }
+
+  protected:
+    /**
+     * Instantiate replacement data entries of a given type in a single
+     * array. The returned pointers share the ownership of the array,
+     * which is freed along with the last of them.
+     *
+     * @param num_entries The number of entries to instantiate.
+     * @param args The arguments to construct each entry with.
+     * @return Shared pointers to the new replacement data.
+     */
+    template <class Data, class... Args>
+    static std::vector<std::shared_ptr<ReplacementData>>
+    instantiateContiguous(std::size_t num_entries, const Args&... args)
+    {
+        auto storage = std::make_shared<std::vector<Data>>();
+        storage->reserve(num_entries);
+
+        std::vector<std::shared_ptr<ReplacementData>> entries;
+        entries.reserve(num_entries);
+        for (std::size_t i = 0; i < num_entries; i++) {
+            storage->emplace_back(args...);
+            entries.emplace_back(storage, &storage->back());
+        }
+        return entries;
+    }
 };
 
 } // namespace replacement_policy
@@ -94,47 +94,56 @@ BRRIP::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 
 ReplaceableEntry*
 BRRIP::getVictim(const ReplacementCandidates& candidates) const
+{
+    return BRRIP::getVictimInRange(candidates.data(),
+                                   candidates.data() + candidates.size());
+}
+
+ReplaceableEntry*
+BRRIP::getVictimInRange(ReplaceableEntry* const* first,
+                        ReplaceableEntry* const* last) const
 {
     // There must be at least one replacement candidate
-    assert(candidates.size() > 0);
+    assert(first != last);
+
+    // The replacement data is accessed through plain pointers to avoid
+    // reference counting
+    auto repl_data = [](ReplaceableEntry* entry) {
+        return static_cast<BRRIPReplData*>(entry->replacementData.get());
+    };
 
     // Use first candidate as dummy victim
-    ReplaceableEntry* victim = candidates[0];
+    ReplaceableEntry* victim = *first;
 
     // Store victim->rrpv in a variable to improve code readability
-    int victim_RRPV = std::static_pointer_cast<BRRIPReplData>(
-                        victim->replacementData)->rrpv;
+    int victim_RRPV = repl_data(victim)->rrpv;
 
     // Visit all candidates to find victim
-    for (const auto& candidate : candidates) {
-        std::shared_ptr<BRRIPReplData> candidate_repl_data =
-            std::static_pointer_cast<BRRIPReplData>(
-                candidate->replacementData);
+    for (auto candidate = first; candidate != last; ++candidate) {
+        BRRIPReplData* candidate_repl_data = repl_data(*candidate);
 
         // Stop searching for victims if an invalid entry is found
         if (!candidate_repl_data->valid) {
-            return candidate;
+            return *candidate;
         }
 
         // Update victim entry if necessary
         int candidate_RRPV = candidate_repl_data->rrpv;
         if (candidate_RRPV > victim_RRPV) {
-            victim = candidate;
+            victim = *candidate;
             victim_RRPV = candidate_RRPV;
         }
     }
 
     // Get difference of victim's RRPV to the highest possible RRPV in
     // order to update the RRPV of all the other entries accordingly
-    int diff = std::static_pointer_cast<BRRIPReplData>(
-        victim->replacementData)->rrpv.saturate();
+    int diff = repl_data(victim)->rrpv.saturate();
 
     // No need to update RRPV if there is no difference
     if (diff > 0){
         // Update RRPV of all candidates
-        for (const auto& candidate : candidates) {
-            std::static_pointer_cast<BRRIPReplData>(
-                candidate->replacementData)->rrpv += diff;
+        for (auto candidate = first; candidate != last; ++candidate) {
+            repl_data(*candidate)->rrpv += diff;
         }
     }
 
@@ -147,5 +156,11 @@ BRRIP::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new BRRIPReplData(numRRPVBits));
 }
 
+std::vector<std::shared_ptr<ReplacementData>>
+BRRIP::instantiateEntries(std::size_t num_entries)
+{
+    return instantiateContiguous<BRRIPReplData>(num_entries, numRRPVBits);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
@@ -94,5 +94,11 @@ FIFO::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new FIFOReplData());
 }
 
+std::vector<std::shared_ptr<ReplacementData>>
+FIFO::instantiateEntries(std::size_t num_entries)
+{
+    return instantiateContiguous<FIFOReplData>(num_entries);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
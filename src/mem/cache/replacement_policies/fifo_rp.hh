@@ -115,6 +115,8 @@ class FIFO : public Base
      * @return A shared pointer to the new replacement data.
      */
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+    std::vector<std::shared_ptr<ReplacementData>>
+    instantiateEntries(std::size_t num_entries) override;
 };
 
 } // namespace replacement_policy
@@ -92,5 +92,11 @@ LFU::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new LFUReplData());
 }
 
+std::vector<std::shared_ptr<ReplacementData>>
+LFU::instantiateEntries(std::size_t num_entries)
+{
+    return instantiateContiguous<LFUReplData>(num_entries);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
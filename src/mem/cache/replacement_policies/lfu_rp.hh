@@ -109,6 +109,8 @@ class LFU : public Base
      * @return A shared pointer to the new replacement data.
      */
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+    std::vector<std::shared_ptr<ReplacementData>>
+    instantiateEntries(std::size_t num_entries) override;
 };
 
 } // namespace replacement_policy
@@ -71,19 +71,30 @@ LRU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 
 ReplaceableEntry*
 LRU::getVictim(const ReplacementCandidates& candidates) const
+{
+    return LRU::getVictimInRange(candidates.data(),
+                                 candidates.data() + candidates.size());
+}
+
+ReplaceableEntry*
+LRU::getVictimInRange(ReplaceableEntry* const* first,
+                      ReplaceableEntry* const* last) const
 {
     // There must be at least one replacement candidate
-    assert(candidates.size() > 0);
+    assert(first != last);
 
-    // Visit all candidates to find victim
-    ReplaceableEntry* victim = candidates[0];
-    for (const auto& candidate : candidates) {
+    // Visit all candidates to find victim. The replacement data is
+    // accessed through plain pointers to avoid reference counting.
+    ReplaceableEntry* victim = *first;
+    Tick victim_tick = static_cast<const LRUReplData*>(
+        victim->replacementData.get())->lastTouchTick;
+    for (auto candidate = first; candidate != last; ++candidate) {
         // Update victim entry if necessary
-        if (std::static_pointer_cast<LRUReplData>(
-                    candidate->replacementData)->lastTouchTick <
-                std::static_pointer_cast<LRUReplData>(
-                    victim->replacementData)->lastTouchTick) {
-            victim = candidate;
+        const Tick tick = static_cast<const LRUReplData*>(
+            (*candidate)->replacementData.get())->lastTouchTick;
+        if (tick < victim_tick) {
+            victim = *candidate;
+            victim_tick = tick;
         }
     }
 
@@ -96,5 +107,11 @@ LRU::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new LRUReplData());
 }
 
+std::vector<std::shared_ptr<ReplacementData>>
+LRU::instantiateEntries(std::size_t num_entries)
+{
+    return instantiateContiguous<LRUReplData>(num_entries);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
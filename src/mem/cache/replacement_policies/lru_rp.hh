@@ -101,12 +101,25 @@ class LRU : public Base
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
 
+    /**
+     * Find replacement victim among a contiguous range of candidates.
+     *
+     * @param first The first replacement candidate.
+     * @param last One past the last replacement candidate.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictimInRange(ReplaceableEntry* const* first,
+                                       ReplaceableEntry* const* last) const
+                                                                 override;
+
     /**
      * Instantiate a replacement data entry.
      *
      * @return A shared pointer to the new replacement data.
      */
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+    std::vector<std::shared_ptr<ReplacementData>>
+    instantiateEntries(std::size_t num_entries) override;
 };
 
 } // namespace replacement_policy
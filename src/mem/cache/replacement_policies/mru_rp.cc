@@ -101,5 +101,11 @@ MRU::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new MRUReplData());
 }
 
+std::vector<std::shared_ptr<ReplacementData>>
+MRU::instantiateEntries(std::size_t num_entries)
+{
+    return instantiateContiguous<MRUReplData>(num_entries);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
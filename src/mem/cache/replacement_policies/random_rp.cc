@@ -41,7 +41,7 @@ namespace replacement_policy
 {
 
 Random::Random(const Params &p)
-  : Base(p)
+  : Base(p), rng(name())
 {
 }
 
@@ -73,7 +73,7 @@ Random::getVictim(const ReplacementCandidates& candidates) const
     assert(candidates.size() > 0);
 
     // Choose one candidate at random
-    ReplaceableEntry* victim = candidates[random_mt.random<unsigned>(0,
+    ReplaceableEntry* victim = candidates[rng.random<unsigned>(0,
                                     candidates.size() - 1)];
 
     // Visit all candidates to search for an invalid entry. If one is found,
@@ -95,5 +95,11 @@ Random::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new RandomReplData());
 }
 
+std::vector<std::shared_ptr<ReplacementData>>
+Random::instantiateEntries(std::size_t num_entries)
+{
+    return instantiateContiguous<RandomReplData>(num_entries);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
@@ -35,6 +35,7 @@
 #ifndef __MEM_CACHE_REPLACEMENT_POLICIES_RANDOM_RP_HH__
 #define __MEM_CACHE_REPLACEMENT_POLICIES_RANDOM_RP_HH__
 
+#include "base/random.hh"
 #include "mem/cache/replacement_policies/base.hh"
 
 namespace gem5
@@ -63,6 +64,9 @@ class Random : public Base
         RandomReplData() : valid(false) {}
     };
 
+    /** Random numbers used to pick victims */
+    mutable RandomStream rng;
+
   public:
     typedef RandomRPParams Params;
     Random(const Params &p);
@@ -110,6 +114,8 @@ class Random : public Base
      * @return A shared pointer to the new replacement data.
      */
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+    std::vector<std::shared_ptr<ReplacementData>>
+    instantiateEntries(std::size_t num_entries) override;
 };
 
 } // namespace replacement_policy
@@ -137,5 +137,11 @@ SecondChance::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new SecondChanceReplData());
 }
 
+std::vector<std::shared_ptr<ReplacementData>>
+SecondChance::instantiateEntries(std::size_t num_entries)
+{
+    return instantiateContiguous<SecondChanceReplData>(num_entries);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
@@ -147,6 +147,12 @@ SHiP::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new SHiPReplData(numRRPVBits));
 }
 
+std::vector<std::shared_ptr<ReplacementData>>
+SHiP::instantiateEntries(std::size_t num_entries)
+{
+    return instantiateContiguous<SHiPReplData>(num_entries, numRRPVBits);
+}
+
 SHiPMem::SHiPMem(const SHiPMemRPParams &p) : SHiP(p) {}
 
 SHiP::SignatureType
@@ -158,6 +158,8 @@ class SHiP : public BRRIP
      * @return A shared pointer to the new replacement data.
      */
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+    std::vector<std::shared_ptr<ReplacementData>>
+    instantiateEntries(std::size_t num_entries) override;
 };
 
 /** SHiP that Uses memory addresses as signatures. */
@@ -169,13 +169,21 @@ const
 
 ReplaceableEntry*
 TreePLRU::getVictim(const ReplacementCandidates& candidates) const
+{
+    return TreePLRU::getVictimInRange(candidates.data(),
+                                      candidates.data() + candidates.size());
+}
+
+ReplaceableEntry*
+TreePLRU::getVictimInRange(ReplaceableEntry* const* first,
+                           ReplaceableEntry* const* last) const
 {
     // There must be at least one replacement candidate
-    assert(candidates.size() > 0);
+    assert(first != last);
 
     // Get tree
-    const PLRUTree* tree = std::static_pointer_cast<TreePLRUReplData>(
-            candidates[0]->replacementData)->tree.get();
+    const PLRUTree* tree = static_cast<const TreePLRUReplData*>(
+            (*first)->replacementData.get())->tree.get();
 
     // Index of the tree entry we are currently checking. Start with root.
     uint64_t tree_index = 0;
@@ -192,7 +200,7 @@ TreePLRU::getVictim(const ReplacementCandidates& candidates) const
 
     // The tree index is currently at the leaf of the victim displaced by the
     // number of non-leaf nodes
-    return candidates[tree_index - (numLeaves - 1)];
+    return first[tree_index - (numLeaves - 1)];
 }
 
 std::shared_ptr<ReplacementData>
@@ -196,6 +196,17 @@ class TreePLRU : public Base
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
 
+    /**
+     * Find replacement victim among a contiguous range of candidates.
+     *
+     * @param first The first replacement candidate.
+     * @param last One past the last replacement candidate.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictimInRange(ReplaceableEntry* const* first,
+                                       ReplaceableEntry* const* last) const
+                                                                 override;
+
     /**
      * Instantiate a replacement data entry. Consecutive calls to this
      * function use the same tree up to numLeaves. When numLeaves replacement
@@ -90,11 +90,25 @@ WeightedLRU::getVictim(const ReplacementCandidates& candidates) const
     return victim;
 }
 
+ReplaceableEntry*
+WeightedLRU::getVictimInRange(ReplaceableEntry* const* first,
+                              ReplaceableEntry* const* last) const
+{
+    // Do not inherit the plain LRU selection
+    return Base::getVictimInRange(first, last);
+}
+
 std::shared_ptr<ReplacementData>
 WeightedLRU::instantiateEntry()
 {
     return std::shared_ptr<ReplacementData>(new WeightedLRUReplData);
 }
 
+std::vector<std::shared_ptr<ReplacementData>>
+WeightedLRU::instantiateEntries(std::size_t num_entries)
+{
+    return instantiateContiguous<WeightedLRUReplData>(num_entries);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
@@ -74,6 +74,8 @@ class WeightedLRU : public LRU
      * @return A shared pointer to the new replacement data.
      */
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+    std::vector<std::shared_ptr<ReplacementData>>
+    instantiateEntries(std::size_t num_entries) override;
 
     /**
      * Find replacement victim using weight.
@@ -83,6 +85,18 @@ class WeightedLRU : public LRU
      */
     ReplaceableEntry* getVictim(const ReplacementCandidates&
                                               candidates) const override;
+
+    /**
+     * Find replacement victim among a contiguous range of candidates,
+     * using the weights rather than the LRU timestamps alone.
+     *
+     * @param first The first replacement candidate.
+     * @param last One past the last replacement candidate.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictimInRange(ReplaceableEntry* const* first,
+                                       ReplaceableEntry* const* last) const
+                                                                 override;
 };
 
 } // namespace replacement_policy
@@ -85,8 +85,8 @@ BaseTags::findBlock(Addr addr, bool is_secure) const
     Addr tag = extractTag(addr);
 
     // Find possible entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
-        indexingPolicy->getPossibleEntries(addr);
+    const std::vector<ReplaceableEntry*> &entries =
+        indexingPolicy->lookupPossibleEntries(addr, lookupEntries);
 
     // Search for block
     for (const auto& location : entries) {
@@ -93,6 +93,9 @@ class BaseTags : public ClockedObject
     std::vector<partitioning_policy::BasePartitioningPolicy *>
         partitioningPolicies;
 
+    /** Storage reused by the indexing policy to look blocks up */
+    mutable std::vector<ReplaceableEntry*> lookupEntries;
+
     /**
      * The number of tags that need to be touched to meet the warmup
      * percentage.
@@ -69,6 +69,9 @@ BaseSetAssoc::BaseSetAssoc(const Params &p)
 void
 BaseSetAssoc::tagsInit()
 {
+    // Instantiate the replacement data of all blocks at once
+    auto replacement_data = replacementPolicy->instantiateEntries(numBlocks);
+
     // Initialize all blocks
     for (unsigned blk_index = 0; blk_index < numBlocks; blk_index++) {
         // Locate next cache block
@@ -81,7 +84,7 @@ BaseSetAssoc::tagsInit()
         blk->data = &dataBlks[blkSize*blk_index];
 
         // Associate a replacement data entry to the block
-        blk->replacementData = replacementPolicy->instantiateEntry();
+        blk->replacementData = std::move(replacement_data[blk_index]);
     }
 }
 
@@ -172,6 +172,18 @@ class BaseSetAssoc : public BaseTags
                          std::vector<CacheBlk*>& evict_blks,
                          const uint64_t partition_id=0) override
     {
+        // Without partitioning, the victim can be chosen among the
+        // possible entries without copying them
+        if (partitioningPolicies.empty()) {
+            const std::vector<ReplaceableEntry*> &entries =
+                indexingPolicy->lookupPossibleEntries(addr, lookupEntries);
+            CacheBlk* victim = static_cast<CacheBlk*>(
+                replacementPolicy->getVictimInRange(
+                    entries.data(), entries.data() + entries.size()));
+            evict_blks.push_back(victim);
+            return victim;
+        }
+
         // Get possible entries to be victimized
         std::vector<ReplaceableEntry*> entries =
             indexingPolicy->getPossibleEntries(addr);
@@ -68,6 +68,9 @@ CompressedTags::tagsInit()
     blks = std::vector<CompressionBlk>(numBlocks);
     superBlks = std::vector<SuperBlk>(numSectors);
 
+    // Instantiate the replacement data of all superblocks at once
+    auto replacement_data = replacementPolicy->instantiateEntries(numSectors);
+
     // Initialize all blocks
     unsigned blk_index = 0;          // index into blks array
     for (unsigned superblock_index = 0; superblock_index < numSectors;
@@ -81,7 +84,8 @@ CompressedTags::tagsInit()
         superblock->setBlkSize(blkSize);
 
         // Associate a replacement data entry to the block
-        superblock->replacementData = replacementPolicy->instantiateEntry();
+        superblock->replacementData =
+            std::move(replacement_data[superblock_index]);
 
         // Initialize all blocks in this superblock
         superblock->blks.resize(numBlocksPerSector, nullptr);
@@ -101,4 +101,12 @@ BaseIndexingPolicy::extractTag(const Addr addr) const
     return (addr >> tagShift);
 }
 
+const std::vector<ReplaceableEntry*>&
+BaseIndexingPolicy::lookupPossibleEntries(const Addr addr,
+    std::vector<ReplaceableEntry*> &entries) const
+{
+    entries = getPossibleEntries(addr);
+    return entries;
+}
+
 } // namespace gem5
@@ -149,6 +149,21 @@ class BaseIndexingPolicy : public SimObject
     virtual std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr)
                                                                     const = 0;
 
+    /**
+     * Find all possible entries of an address to search them, without
+     * allocating a new vector on every lookup. Policies that keep all the
+     * possible entries of an address in a single set return that set
+     * directly; the others fill and return the given vector, whose
+     * storage is reused from one lookup to the next.
+     *
+     * @param addr The addr to a find possible entries for.
+     * @param entries Vector to hold the entries if needed.
+     * @return The possible entries, valid until the next lookup.
+     */
+    virtual const std::vector<ReplaceableEntry*>&
+    lookupPossibleEntries(const Addr addr,
+                          std::vector<ReplaceableEntry*> &entries) const;
+
     /**
      * Regenerate an entry's address from its tag and assigned indexing bits.
      *
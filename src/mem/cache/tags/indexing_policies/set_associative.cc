@@ -75,4 +75,11 @@ SetAssociative::getPossibleEntries(const Addr addr) const
     return sets[extractSet(addr)];
 }
 
+const std::vector<ReplaceableEntry*>&
+SetAssociative::lookupPossibleEntries(const Addr addr,
+    std::vector<ReplaceableEntry*> &entries) const
+{
+    return sets[extractSet(addr)];
+}
+
 } // namespace gem5
@@ -118,6 +118,19 @@ class SetAssociative : public BaseIndexingPolicy
     std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
                                                                      override;
 
+    /**
+     * Find the possible entries of an address for a lookup. All of them
+     * belong to the set of the address, which is returned without copy.
+     *
+     * @param addr The addr to a find possible entries for.
+     * @param entries Unused.
+     * @return The set of the address.
+     */
+    const std::vector<ReplaceableEntry*>&
+    lookupPossibleEntries(const Addr addr,
+                          std::vector<ReplaceableEntry*> &entries) const
+                                                                 override;
+
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
      *
@@ -220,4 +220,16 @@ SkewedAssociative::getPossibleEntries(const Addr addr) const
     return entries;
 }
 
+const std::vector<ReplaceableEntry*>&
+SkewedAssociative::lookupPossibleEntries(const Addr addr,
+    std::vector<ReplaceableEntry*> &entries) const
+{
+    entries.clear();
+    for (uint32_t way = 0; way < assoc; ++way) {
+        entries.push_back(sets[extractSet(addr, way)][way]);
+    }
+
+    return entries;
+}
+
 } // namespace gem5
@@ -163,6 +163,19 @@ class SkewedAssociative : public BaseIndexingPolicy
     std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
                                                                    override;
 
+    /**
+     * Find the possible entries of an address for a lookup, reusing the
+     * storage of the given vector.
+     *
+     * @param addr The addr to a find possible entries for.
+     * @param entries Vector to hold the entries.
+     * @return The possible entries.
+     */
+    const std::vector<ReplaceableEntry*>&
+    lookupPossibleEntries(const Addr addr,
+                          std::vector<ReplaceableEntry*> &entries) const
+                                                                 override;
+
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
      * Uses the inverse of the skewing function.
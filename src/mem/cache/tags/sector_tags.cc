@@ -88,6 +88,9 @@ SectorTags::tagsInit()
     blks = std::vector<SectorSubBlk>(numBlocks);
     secBlks = std::vector<SectorBlk>(numSectors);
 
+    // Instantiate the replacement data of all sectors at once
+    auto replacement_data = replacementPolicy->instantiateEntries(numSectors);
+
     // Initialize all blocks
     unsigned blk_index = 0;       // index into blks array
     for (unsigned sec_blk_index = 0; sec_blk_index < numSectors;
@@ -97,7 +100,8 @@ SectorTags::tagsInit()
         SectorBlk* sec_blk = &secBlks[sec_blk_index];
 
         // Associate a replacement data entry to the sector
-        sec_blk->replacementData = replacementPolicy->instantiateEntry();
+        sec_blk->replacementData =
+            std::move(replacement_data[sec_blk_index]);
 
         // Initialize all blocks in this sector
         sec_blk->blks.resize(numBlocksPerSector);
@@ -271,8 +275,8 @@ SectorTags::findBlock(Addr addr, bool is_secure) const
     const Addr offset = extractSectorOffset(addr);
 
     // Find all possible sector entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
-        indexingPolicy->getPossibleEntries(addr);
+    const std::vector<ReplaceableEntry*> &entries =
+        indexingPolicy->lookupPossibleEntries(addr, lookupEntries);
 
     // Search for block
     for (const auto& sector : entries) {
@@ -696,9 +696,10 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
 }
 
 
+template <typename Dests>
 void
 CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
-                           const std::vector<QueuedResponsePort*>& dests)
+                           const Dests& dests)
 {
     DPRINTF(CoherentXBar, "%s for %s\n", __func__, pkt->print());
 
@@ -926,10 +927,11 @@ CoherentXBar::recvAtomicSnoop(PacketPtr pkt, PortID mem_side_port_id)
     return snoop_response_latency;
 }
 
+template <typename Dests>
 std::pair<MemCmd, Tick>
 CoherentXBar::forwardAtomic(PacketPtr pkt, PortID exclude_cpu_side_port_id,
                            PortID source_mem_side_port_id,
-                           const std::vector<QueuedResponsePort*>& dests)
+                           const Dests& dests)
 {
     // the packet may be changed on snoops, record the original
     // command to enable us to restore it between snoops so that
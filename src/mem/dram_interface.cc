@@ -59,116 +59,111 @@ namespace memory
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
-    std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
+    // The queue indexes its packets by bank and row, so rather than
+    // checking every queued packet only look at the oldest packet to
+    // the open row, and the oldest one to any other row, of each bank
+    // with queued packets. The choice is the same as the one made going
+    // through the whole queue in arrival order: the oldest row hit that
+    // can issue seamlessly, else the oldest packet to one of the banks
+    // that can be activated first if that activate can be hidden, else
+    // the oldest row hit to a prepped bank, else the oldest packet to
+    // one of the banks that can be activated first.
+
+    // oldest row hit that can issue seamlessly
+    MemPacket *seamless_pkt = nullptr;
+    // oldest row hit, not seamless, but bank prepped and ready
+    MemPacket *prepped_pkt = nullptr;
+    // is there a row miss to a rank that is available?
+    bool found_row_miss = false;
+
+    const auto bank_queues = queue.banks(true, pseudoChannel);
+    for (auto i = bank_queues.first; i != bank_queues.second; ++i) {
+        const MemPacketQueue::BankQueue &bank_queue = i->second;
+        MemPacket* first_pkt = bank_queue.front();
+        const Bank& bank = ranks[first_pkt->rank]->banks[first_pkt->bank];
+
+        DPRINTF(DRAM, "%s checking DRAM packets in bank %d\n", __func__,
+                first_pkt->bank);
+
+        // check if rank is not doing a refresh and thus is available,
+        // if not, jump to the next bank
+        if (!burstReady(first_pkt)) {
+            DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
+                    first_pkt->bank, first_pkt->rank);
+            continue;
+        }
 
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
+        DPRINTF(DRAM, "%s bank %d - Rank %d available\n", __func__,
+                first_pkt->bank, first_pkt->rank);
 
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
-
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
-
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
-
-    Tick selected_col_at = MaxTick;
-    auto selected_pkt_it = queue.end();
-
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        MemPacket* pkt = *i;
-
-        // select optimal DRAM packet in Q
-        if (pkt->isDram() && (pkt->pseudoChannel == pseudoChannel)) {
-            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
-            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
-                                                        bank.wrAllowedAt;
-
-            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
-                    __func__, pkt->bank, pkt->row);
-
-            // check if rank is not doing a refresh and thus is available,
-            // if not, jump to the next packet
-            if (burstReady(pkt)) {
-
-                DPRINTF(DRAM,
-                        "%s bank %d - Rank %d available\n", __func__,
-                        pkt->bank, pkt->rank);
-
-                // check if it is a row hit
-                if (bank.openRow == pkt->row) {
-                    // no additional rank-to-rank or same bank-group
-                    // delays, or we switched read/write and might as well
-                    // go for the row hit
-                    if (col_allowed_at <= min_col_at) {
-                        // FCFS within the hits, giving priority to
-                        // commands that can issue seamlessly, without
-                        // additional delay, such as same rank accesses
-                        // and/or different bank-group accesses
-                        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        // no need to look through the remaining queue entries
-                        break;
-                    } else if (!found_hidden_bank && !found_prepped_pkt) {
-                        // if we did not find a packet to a closed row that can
-                        // issue the bank commands without incurring delay, and
-                        // did not yet find a packet to a prepped row, remember
-                        // the current one
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        found_prepped_pkt = true;
-                        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                    }
-                } else if (!found_earliest_pkt) {
-                    // if we have not initialised the bank status, do it
-                    // now, and only once per scheduling decisions
-                    if (!filled_earliest_banks) {
-                        // determine entries with earliest bank delay
-                        std::tie(earliest_banks, hidden_bank_prep) =
-                            minBankPrep(queue, min_col_at);
-                        filled_earliest_banks = true;
-                    }
+        MemPacket* hit_pkt = bank_queue.oldestTo(bank.openRow);
+        if (hit_pkt) {
+            const Tick col_allowed_at = hit_pkt->isRead() ?
+                bank.rdAllowedAt : bank.wrAllowedAt;
 
-                    // bank is amongst first available banks
-                    // minBankPrep will give priority to packets that can
-                    // issue seamlessly
-                    if (bits(earliest_banks[pkt->rank],
-                             pkt->bank, pkt->bank)) {
-                        found_earliest_pkt = true;
-                        found_hidden_bank = hidden_bank_prep;
-
-                        // give priority to packets that can issue
-                        // bank commands 'behind the scenes'
-                        // any additional delay if any will be due to
-                        // col-to-col command requirements
-                        if (hidden_bank_prep || !found_prepped_pkt) {
-                            selected_pkt_it = i;
-                            selected_col_at = col_allowed_at;
-                        }
-                    }
-                }
-            } else {
-                DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                        pkt->bank, pkt->rank);
+            // no additional rank-to-rank or same bank-group delays, or
+            // we switched read/write and might as well go for the row hit
+            MemPacket* &candidate = col_allowed_at <= min_col_at ?
+                seamless_pkt : prepped_pkt;
+            if (!candidate || hit_pkt->queueSeq < candidate->queueSeq)
+                candidate = hit_pkt;
+        }
+
+        if (bank_queue.oldestNotTo(bank.openRow))
+            found_row_miss = true;
+    }
+
+    MemPacket* selected_pkt = seamless_pkt;
+    if (selected_pkt) {
+        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
+    } else if (found_row_miss) {
+        // determine the banks with the earliest bank delay
+        std::vector<uint32_t> earliest_banks;
+        bool hidden_bank_prep;
+        std::tie(earliest_banks, hidden_bank_prep) =
+            minBankPrep(queue, min_col_at);
+
+        // oldest row miss to a bank amongst the first available banks
+        MemPacket* earliest_pkt = nullptr;
+        for (auto i = bank_queues.first; i != bank_queues.second; ++i) {
+            const MemPacketQueue::BankQueue &bank_queue = i->second;
+            MemPacket* first_pkt = bank_queue.front();
+            if (!burstReady(first_pkt) ||
+                !bits(earliest_banks[first_pkt->rank],
+                      first_pkt->bank, first_pkt->bank)) {
+                continue;
+            }
+
+            const Bank& bank =
+                ranks[first_pkt->rank]->banks[first_pkt->bank];
+            MemPacket* miss_pkt = bank_queue.oldestNotTo(bank.openRow);
+            if (miss_pkt && (!earliest_pkt ||
+                             miss_pkt->queueSeq < earliest_pkt->queueSeq)) {
+                earliest_pkt = miss_pkt;
             }
         }
+
+        // give priority to packets that can issue bank commands 'behind
+        // the scenes', any additional delay if any will be due to
+        // col-to-col command requirements
+        if (earliest_pkt && (hidden_bank_prep || !prepped_pkt))
+            selected_pkt = earliest_pkt;
+        else
+            selected_pkt = prepped_pkt;
+    } else {
+        selected_pkt = prepped_pkt;
     }
 
-    if (selected_pkt_it == queue.end()) {
+    if (!selected_pkt) {
         DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+        return std::make_pair(queue.end(), MaxTick);
     }
 
-    return std::make_pair(selected_pkt_it, selected_col_at);
+    const Bank& bank = ranks[selected_pkt->rank]->banks[selected_pkt->bank];
+    const Tick selected_col_at = selected_pkt->isRead() ? bank.rdAllowedAt :
+                                                          bank.wrAllowedAt;
+
+    return std::make_pair(queue.find(selected_pkt), selected_col_at);
 }
 
 void
@@ -556,6 +551,8 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
                                                    MemCommand::WR;
 
     rank_ref.cmdList.push_back(Command(command, mem_pkt->bank, cmd_at));
+    if (rank_ref.cmdList.size() >= Rank::cmdListFlushSize)
+        rank_ref.flushCmdList();
 
     DPRINTF(DRAMPower, "%llu,%s,%d,%d\n", divCeil(cmd_at, tCK) -
             timeStampOffset, mem_cmd, mem_pkt->bank, mem_pkt->rank);
@@ -643,7 +640,8 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       tCCD_L_WR(_p.tCCD_L_WR), tCCD_L(_p.tCCD_L),
       tRCD_RD(_p.tRCD), tRCD_WR(_p.tRCD_WR),
       tRP(_p.tRP), tRAS(_p.tRAS), tWR(_p.tWR), tRTP(_p.tRTP),
-      tRFC(_p.tRFC), tREFI(_p.tREFI), tRRD(_p.tRRD), tRRD_L(_p.tRRD_L),
+      tRFC(_p.tRFC), tREFI(_p.tREFI), tRFCsb(_p.tRFCsb),
+      tRRD(_p.tRRD), tRRD_L(_p.tRRD_L),
       tPPD(_p.tPPD), tAAD(_p.tAAD),
       tXAW(_p.tXAW), tXP(_p.tXP), tXS(_p.tXS),
       clkResyncDelay(_p.tBURST_MAX),
@@ -657,6 +655,9 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       maxAccessesPerRow(_p.max_accesses_per_row),
       timeStampOffset(0), activeRank(0),
       enableDRAMPowerdown(_p.enable_dram_powerdown),
+      coalesceIdleRefresh(_p.coalesce_idle_refresh),
+      sameBankRefreshBanks(bankGroupArch ? bankGroupsPerRank : 1),
+      tREFIsb(tREFI / (banksPerRank / sameBankRefreshBanks)),
       lastStatsResetTick(0),
       stats(*this)
 {
@@ -736,6 +737,11 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
                   tRRD_L, tRRD, bankGroupsPerRank);
         }
     }
+
+    if (tRFCsb != 0 && (tREFIsb <= tRP || tREFIsb <= tRFCsb)) {
+        fatal("Same-bank refresh interval (%d) must be larger than tRP (%d) "
+              "and tRFCsb (%d)\n", tREFIsb, tRP, tRFCsb);
+    }
 }
 
 void
@@ -919,6 +925,12 @@ DRAMInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
 
 void DRAMInterface::setupRank(const uint8_t rank, const bool is_read)
 {
+    // the request may be scheduled against any rank of the channel,
+    // so none of them can be midway through a coalesced refresh
+    for (auto r : ranks) {
+        r->expandCoalescedRefresh();
+    }
+
     // increment entry count of the rank based on packet type
     if (is_read) {
         ++ranks[rank]->readEntries;
@@ -992,6 +1004,8 @@ DRAMInterface::drainRanks()
 {
     // also need to kick off events to exit self-refresh
     for (auto r : ranks) {
+        r->expandCoalescedRefresh();
+
         // force self-refresh exit, which in turn will issue auto-refresh
         if (r->pwrState == PWR_SREF) {
             DPRINTF(DRAM,"Rank%d: Forcing self-refresh wakeup in drain\n",
@@ -1041,10 +1055,10 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // determine if we have queued transactions targetting the
     // bank in question
     std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->pseudoChannel != pseudoChannel)
-            continue;
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
+    const auto bank_queues = queue.banks(true, pseudoChannel);
+    for (auto i = bank_queues.first; i != bank_queues.second; ++i) {
+        const MemPacket* p = i->second.front();
+        if (ranks[p->rank]->inRefIdleState())
             got_waiting[p->bankId] = true;
     }
 
@@ -1119,7 +1133,9 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
                          int _rank, DRAMInterface& _dram)
     : EventManager(&_dram), dram(_dram),
       pwrStateTrans(PWR_IDLE), pwrStatePostRefresh(PWR_IDLE),
-      pwrStateTick(0), refreshDueAt(0), pwrState(PWR_IDLE),
+      pwrStateTick(0), refreshDueAt(0), coalescedRefreshAt(MaxTick),
+      sameBankRefreshIdx(0),
+      pwrState(PWR_IDLE),
       refreshState(REF_IDLE), inLowPowerState(false), rank(_rank),
       readEntries(0), writeEntries(0), outstandingEvents(0),
       wakeUpAllowedAt(0), power(_p, false), banks(_p.banks_per_rank),
@@ -1168,6 +1184,8 @@ DRAMInterface::Rank::startup(Tick ref_tick)
 void
 DRAMInterface::Rank::suspend()
 {
+    expandCoalescedRefresh();
+
     deschedule(refreshEvent);
 
     // Update the stats
@@ -1228,7 +1246,14 @@ DRAMInterface::Rank::flushCmdList()
     // reset cmdList to only contain commands after curTick
     // if there are no commands after curTick, updated cmdList will be empty
     // in this case, next_iter is cmdList.end()
-    cmdList.assign(next_iter, cmdList.end());
+    cmdList.erase(cmdList.begin(), next_iter);
+
+    // Evaluate the commands right away rather than buffering them in
+    // DRAMPower until the window energy is calculated. The evaluation is
+    // incremental, so the energy is the same but a stats dump only has to
+    // turn the counters into energy.
+    power.powerlib.evaluateCommands(divCeil(curTick(), dram.tCK) -
+                                    dram.timeStampOffset);
 }
 
 void
@@ -1286,6 +1311,18 @@ DRAMInterface::Rank::processWriteDoneEvent()
 void
 DRAMInterface::Rank::processRefreshEvent()
 {
+    if (refreshState == REF_IDLE && canCoalesceRefresh()) {
+        coalesceRefresh();
+        return;
+    }
+
+    // a rank that is awake refreshes a set of banks at a time, while
+    // one in a low-power state wakes up for a regular all-bank refresh
+    if (refreshState == REF_IDLE && dram.tRFCsb != 0 && !inLowPowerState) {
+        sameBankRefresh();
+        return;
+    }
+
     // when first preparing the refresh, remember when it was due
     if ((refreshState == REF_IDLE) || (refreshState == REF_SREF_EXIT)) {
         // remember when the refresh is due
@@ -1421,6 +1458,7 @@ DRAMInterface::Rank::processRefreshEvent()
 
         // Update for next refresh
         refreshDueAt += dram.tREFI;
+        sameBankRefreshIdx = 0;
 
         // make sure we did not wait so long that we cannot make up
         // for it
@@ -1488,6 +1526,134 @@ DRAMInterface::Rank::processRefreshEvent()
     }
 }
 
+bool
+DRAMInterface::Rank::canCoalesceRefresh() const
+{
+    // the refresh must go straight from idle to refresh and back to
+    // idle, with the scheduler wake-up at the end of the refresh
+    // finding nothing to do and no reason to turn the bus around
+    return dram.coalesceIdleRefresh && !dram.enableDRAMPowerdown &&
+        pwrState == PWR_IDLE && numBanksActive == 0 &&
+        outstandingEvents == 0 && readEntries == 0 && writeEntries == 0 &&
+        !powerEvent.scheduled() && !activateEvent.scheduled() &&
+        !prechargeEvent.scheduled() &&
+        dram.readQueueSize == 0 && dram.writeQueueSize == 0 &&
+        dram.ctrl->inReadBusState(false, &dram) &&
+        dram.ctrl->inReadBusState(true, &dram) &&
+        !dram.ctrl->requestEventScheduled(dram.pseudoChannel) &&
+        dram.ctrl->drainState() == DrainState::Running;
+}
+
+void
+DRAMInterface::Rank::coalesceRefresh()
+{
+    // this is the same sequence of updates the refresh state machine
+    // makes over REF_DRAIN to REF_RUN and the two power events, with
+    // the idle residency accounted up to now and the refresh
+    // residency accounted upfront
+    refreshDueAt = curTick();
+    stats.pwrStateTime[PWR_IDLE] += curTick() - pwrStateTick;
+
+    Tick ref_done_at = curTick() + dram.tRFC;
+
+    for (auto &b : banks) {
+        b.actAllowedAt = ref_done_at;
+    }
+
+    // keep the command list short while idle, the energy of the
+    // window is computed at the next stats update
+    cmdList.push_back(Command(MemCommand::REF, 0, curTick()));
+    flushCmdList();
+
+    DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(curTick(), dram.tCK) -
+            dram.timeStampOffset, rank);
+
+    refreshDueAt += dram.tREFI;
+    sameBankRefreshIdx = 0;
+
+    if (refreshDueAt < ref_done_at) {
+        fatal("Refresh was delayed so long we cannot catch up\n");
+    }
+
+    stats.pwrStateTime[PWR_REF] += dram.tRFC;
+    pwrStateTick = ref_done_at;
+    coalescedRefreshAt = curTick();
+
+    schedule(refreshEvent, refreshDueAt - dram.tRP);
+
+    DPRINTF(DRAMState, "Coalesced idle refresh done at %llu and next "
+            "refresh at %llu\n", ref_done_at, refreshDueAt);
+}
+
+void
+DRAMInterface::Rank::sameBankRefresh()
+{
+    // the banks with the same index in each bank group, see the bank
+    // numbering in the constructor
+    const uint32_t first = sameBankRefreshIdx * dram.sameBankRefreshBanks;
+    const uint32_t last = first + dram.sameBankRefreshBanks;
+
+    // close any open bank of the set, and start the refresh once all of
+    // them are precharged
+    Tick ref_at = curTick();
+    for (uint32_t i = first; i < last; ++i) {
+        Bank &b = banks[i];
+        if (b.openRow != Bank::NO_ROW) {
+            dram.prechargeBank(*this, b, std::max(b.preAllowedAt, curTick()),
+                               false, true);
+        }
+        ref_at = std::max(ref_at, b.actAllowedAt);
+    }
+
+    Tick ref_done_at = ref_at + dram.tRFCsb;
+
+    for (uint32_t i = first; i < last; ++i) {
+        banks[i].actAllowedAt = ref_done_at;
+        cmdList.push_back(Command(MemCommand::REFB, i, ref_at));
+
+        DPRINTF(DRAMPower, "%llu,REFB,%d,%d\n", divCeil(ref_at, dram.tCK) -
+                dram.timeStampOffset, i, rank);
+    }
+
+    DPRINTF(DRAMState, "Same-bank refresh of banks %d-%d, rank %d, from "
+            "%llu to %llu\n", first, last - 1, rank, ref_at, ref_done_at);
+
+    // move on to the next set, a regular refresh restarts from the first
+    sameBankRefreshIdx = (sameBankRefreshIdx + 1) %
+        (dram.banksPerRank / dram.sameBankRefreshBanks);
+
+    schedule(refreshEvent, curTick() + dram.tREFIsb);
+}
+
+void
+DRAMInterface::Rank::expandCoalescedRefresh()
+{
+    if (coalescedRefreshAt == MaxTick) {
+        return;
+    }
+
+    Tick ref_done_at = coalescedRefreshAt + dram.tRFC;
+
+    // a refresh that has completed by now looks no different from one
+    // done by the state machine, as it would already have returned
+    // the rank to idle
+    if (curTick() < ref_done_at) {
+        DPRINTF(DRAMState, "Resuming coalesced refresh started at %llu\n",
+                coalescedRefreshAt);
+
+        // undo the upfront accounting and pick up the state machine in
+        // REF_RUN, where it waits for the refresh to complete
+        stats.pwrStateTime[PWR_REF] -= dram.tRFC;
+        pwrState = PWR_REF;
+        pwrStateTick = coalescedRefreshAt;
+        refreshState = REF_RUN;
+        ++outstandingEvents;
+        reschedule(refreshEvent, ref_done_at);
+    }
+
+    coalescedRefreshAt = MaxTick;
+}
+
 void
 DRAMInterface::Rank::schedulePowerEvent(PowerState pwr_state, Tick tick)
 {
@@ -1811,6 +1977,8 @@ DRAMInterface::Rank::computeStats()
 {
     DPRINTF(DRAM,"Computing stats due to a dump callback\n");
 
+    expandCoalescedRefresh();
+
     // Update the stats
     updatePowerStats();
 
@@ -2016,6 +2184,9 @@ DRAMInterface::RankStats::regStats()
 void
 DRAMInterface::RankStats::resetStats()
 {
+    // settle any coalesced refresh before its residency is cleared
+    rank.expandCoalescedRefresh();
+
     statistics::Group::resetStats();
 
     rank.resetStats();
@@ -256,6 +256,39 @@ class DRAMInterface : public MemInterface
          */
         Tick refreshDueAt;
 
+        /**
+         * Start of the last refresh performed by the coalesced idle
+         * path, or MaxTick if the rank has no such refresh that could
+         * still be in progress.
+         */
+        Tick coalescedRefreshAt;
+
+        /**
+         * Check if a due refresh can be performed in one go, i.e. the
+         * rank and the scheduler of its channel have nothing to do and
+         * the regular state machine would only cycle the rank through
+         * refresh and back to idle.
+         */
+        bool canCoalesceRefresh() const;
+
+        /**
+         * Perform a due refresh without its intermediate events,
+         * accounting the refresh residency upfront.
+         */
+        void coalesceRefresh();
+
+        /**
+         * Index of the bank in each bank group that the next same-bank
+         * refresh targets.
+         */
+        uint32_t sameBankRefreshIdx;
+
+        /**
+         * Refresh the next set of same-index banks, one per bank
+         * group, while the other banks of the rank stay available.
+         */
+        void sameBankRefresh();
+
         /**
          * Function to update Power Stats
          */
@@ -321,12 +354,20 @@ class DRAMInterface : public MemInterface
 
         /**
          * List of commands issued, to be sent to DRAMPpower at refresh
-         * and stats dump.  Keep commands here since commands to different
-         * banks are added out of order.  Will only pass commands up to
-         * curTick() to DRAMPower after sorting.
+         * and stats dump, or once it holds cmdListFlushSize commands.
+         * Keep commands here since commands to different banks are added
+         * out of order.  Will only pass commands up to curTick() to
+         * DRAMPower after sorting.
          */
         std::vector<Command> cmdList;
 
+        /**
+         * Number of commands after which cmdList is flushed without
+         * waiting for a refresh or a stats dump, which bounds the work
+         * done when updating the power stats.
+         */
+        static constexpr size_t cmdListFlushSize = 1024;
+
         /**
          * Vector of Banks. Each rank is made of several devices which in
          * term are made from several banks.
@@ -365,6 +406,14 @@ class DRAMInterface : public MemInterface
          */
         void suspend();
 
+        /**
+         * If a coalesced refresh is still in progress, hand it back to
+         * the regular refresh state machine so that requests, drain and
+         * stats observe the rank exactly as they would without
+         * coalescing.
+         */
+        void expandCoalescedRefresh();
+
         /**
          * Check if there is no refresh and no preparation of refresh ongoing
          * i.e. the refresh state machine is in idle
@@ -421,7 +470,8 @@ class DRAMInterface : public MemInterface
 
         /**
          * Push command out of cmdList queue that are scheduled at
-         * or before curTick() to DRAMPower library
+         * or before curTick() to DRAMPower library, and have it fold
+         * them into the counters of the current energy window.
          * All commands before curTick are guaranteed to be complete
          * and can safely be flushed.
          */
@@ -512,6 +562,7 @@ class DRAMInterface : public MemInterface
     const Tick tRTP;
     const Tick tRFC;
     const Tick tREFI;
+    const Tick tRFCsb;
     const Tick tRRD;
     const Tick tRRD_L;
     const Tick tPPD;
@@ -544,6 +595,15 @@ class DRAMInterface : public MemInterface
     /** Enable or disable DRAM powerdown states. */
     bool enableDRAMPowerdown;
 
+    /** Coalesce the refresh events of idle ranks. */
+    const bool coalesceIdleRefresh;
+
+    /** Banks refreshed together by a same-bank refresh */
+    uint32_t sameBankRefreshBanks;
+
+    /** Interval between same-bank refreshes of a rank */
+    Tick tREFIsb;
+
     /** The time when stats were last reset used to calculate average power */
     Tick lastStatsResetTick;
 
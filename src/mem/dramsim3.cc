@@ -57,7 +57,7 @@ DRAMsim3::DRAMsim3(const Params &p) :
     write_cb(std::bind(&DRAMsim3::writeComplete,
                        this, 0, std::placeholders::_1)),
     wrapper(p.configFile, p.filePath, read_cb, write_cb),
-    retryReq(false), retryResp(false), startTick(0),
+    retryReq(false), retryResp(false), startTick(0), nextTickAt(MaxTick),
     nbrOutstandingReads(0), nbrOutstandingWrites(0),
     sendResponseEvent([this]{ sendResponse(); }, name()),
     tickEvent([this]{ tick(); }, name())
@@ -68,7 +68,10 @@ DRAMsim3::DRAMsim3(const Params &p) :
 
     // Register a callback to compensate for the destructor not
     // being called. The callback prints the DRAMsim3 stats.
-    registerExitCallback([this]() { wrapper.printStats(); });
+    registerExitCallback([this]() {
+        catchUp();
+        wrapper.printStats();
+    });
 }
 
 void
@@ -98,6 +101,7 @@ DRAMsim3::startup()
 
 void
 DRAMsim3::resetStats() {
+    catchUp();
     wrapper.resetStats();
 }
 
@@ -150,12 +154,50 @@ DRAMsim3::tick()
             retryReq = false;
             port.sendRetryReq();
         }
+
+        // with nothing in flight the model has no callbacks to make,
+        // so rather than paying for an event every DRAM cycle, stop
+        // the clock and let catchUp() replay the idle cycles in one
+        // go when the next request arrives
+        if (nbrOutstandingReads + nbrOutstandingWrites == 0 && !retryReq) {
+            nextTickAt =
+                curTick() + wrapper.clockPeriod() * sim_clock::as_int::ns;
+            return;
+        }
     }
 
     schedule(tickEvent,
         curTick() + wrapper.clockPeriod() * sim_clock::as_int::ns);
 }
 
+void
+DRAMsim3::catchUp()
+{
+    if (tickEvent.scheduled())
+        return;
+
+    // tick the model for every cycle that elapsed while the clock was
+    // stopped, the resulting state is the same as if each cycle had
+    // been simulated by its own tick event
+    while (nextTickAt < curTick()) {
+        wrapper.tick();
+        nextTickAt += wrapper.clockPeriod() * sim_clock::as_int::ns;
+    }
+}
+
+void
+DRAMsim3::wakeUp()
+{
+    if (tickEvent.scheduled())
+        return;
+
+    catchUp();
+
+    DPRINTF(DRAMsim3, "Restarting clock at %lld\n", nextTickAt);
+
+    schedule(tickEvent, nextTickAt);
+}
+
 Tick
 DRAMsim3::recvAtomic(PacketPtr pkt)
 {
@@ -230,6 +272,9 @@ DRAMsim3::recvTimingReq(PacketPtr pkt)
 
         DPRINTF(DRAMsim3, "Enqueueing address %lld\n", pkt->getAddr());
 
+        // bring the model up to date before it sees the request
+        wakeUp();
+
         // @todo what about the granularity here, implicit assumption that
         // a transaction matches the burst size of the memory (which we
         // cannot determine without parsing the ini file ourselves)
@@ -350,11 +395,24 @@ DRAMsim3::getPort(const std::string &if_name, PortID idx)
 DrainState
 DRAMsim3::drain()
 {
+    // make sure the model is up to date in case we are switched to a
+    // different memory mode while drained
+    catchUp();
+
     // check our outstanding reads and writes and if any they need to
     // drain
     return nbrOutstanding() != 0 ? DrainState::Draining : DrainState::Drained;
 }
 
+void
+DRAMsim3::drainResume()
+{
+    // outside of timing mode the clock runs without ticking the
+    // model, so restart it if it was stopped
+    if (!tickEvent.scheduled() && !system()->isTimingMode())
+        schedule(tickEvent, nextTickAt);
+}
+
 DRAMsim3::MemoryPort::MemoryPort(const std::string& _name,
                                  DRAMsim3& _memory)
     : ResponsePort(_name), mem(_memory)
@@ -120,6 +120,12 @@ class DRAMsim3 : public AbstractMemory
      */
     Tick startTick;
 
+    /**
+     * When the clock is stopped, the tick at which the next DRAMsim3
+     * cycle is due.
+     */
+    Tick nextTickAt;
+
     /**
      * Keep track of what packets are outstanding per
      * address, and do so separately for reads and writes. This is
@@ -168,6 +174,17 @@ class DRAMsim3 : public AbstractMemory
      */
     void tick();
 
+    /**
+     * Tick the model for all the cycles skipped while the clock was
+     * stopped, up to but not including the current tick.
+     */
+    void catchUp();
+
+    /**
+     * Catch up and restart the clock if it is stopped.
+     */
+    void wakeUp();
+
     /**
      * Event to schedule clock ticks
      */
@@ -203,6 +220,7 @@ class DRAMsim3 : public AbstractMemory
     void writeComplete(unsigned id, uint64_t addr);
 
     DrainState drain() override;
+    void drainResume() override;
 
     virtual Port& getPort(const std::string& if_name,
                           PortID idx = InvalidPortID) override;
@@ -129,9 +129,9 @@ HBMCtrl::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor)
     Tick latency = recvAtomic(pkt);
 
     if (pc0Int && pc0Int->getAddrRange().contains(pkt->getAddr())) {
-        pc0Int->getBackdoor(backdoor);
+        pc0Int->getBackdoor(backdoor, pkt->getAddr());
     } else if (pc1Int && pc1Int->getAddrRange().contains(pkt->getAddr())) {
-        pc1Int->getBackdoor(backdoor);
+        pc1Int->getBackdoor(backdoor, pkt->getAddr());
     }
     else {
         panic("Can't handle address range for packet %s\n",
@@ -146,9 +146,9 @@ HBMCtrl::recvMemBackdoorReq(const MemBackdoorReq &req,
 {
     auto &range = req.range();
     if (pc0Int && pc0Int->getAddrRange().isSubset(range)) {
-        pc0Int->getBackdoor(backdoor);
+        pc0Int->getBackdoor(backdoor, range.start());
     } else if (pc1Int && pc1Int->getAddrRange().isSubset(range)) {
-        pc1Int->getBackdoor(backdoor);
+        pc1Int->getBackdoor(backdoor, range.start());
     }
     else {
         panic("Can't handle address range for range %s\n", range.to_string());
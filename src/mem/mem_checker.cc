@@ -66,15 +66,14 @@ MemChecker::WriteCluster::startWrite(MemChecker::Serial serial, Tick _start,
     }
 
     // Create new transaction, and denote completion time to be in the future.
-    writes.insert(std::make_pair(serial,
-                  MemChecker::Transaction(serial, _start, TICK_FUTURE, data)));
+    writes.emplace_back(serial, _start, TICK_FUTURE, data);
 }
 
 void
 MemChecker::WriteCluster::completeWrite(MemChecker::Serial serial,
     Tick _complete)
 {
-    auto it = writes.find(serial);
+    auto it = findWrite(serial);
 
     if (it == writes.end()) {
         warn("Could not locate write transaction: serial = %d, "
@@ -83,8 +82,8 @@ MemChecker::WriteCluster::completeWrite(MemChecker::Serial serial,
     }
 
     // Record completion time of the write
-    assert(it->second.complete == TICK_FUTURE);
-    it->second.complete = _complete;
+    assert(it->complete == TICK_FUTURE);
+    it->complete = _complete;
 
     // Update max completion time for the cluster
     if (completeMax < _complete) {
@@ -105,10 +104,13 @@ MemChecker::WriteCluster::completeWrite(MemChecker::Serial serial,
 void
 MemChecker::WriteCluster::abortWrite(MemChecker::Serial serial)
 {
-    if (!writes.erase(serial)) {
+    auto it = findWrite(serial);
+
+    if (it == writes.end()) {
         warn("Could not locate write transaction: serial = %d\n", serial);
         return;
     }
+    writes.erase(it);
 
     if (--numIncomplete == 0 && !writes.empty()) {
         // This write cluster is now complete, and we can assign the current
@@ -124,8 +126,7 @@ MemChecker::WriteCluster::abortWrite(MemChecker::Serial serial)
 void
 MemChecker::ByteTracker::startRead(MemChecker::Serial serial, Tick start)
 {
-    outstandingReads.insert(std::make_pair(serial,
-            MemChecker::Transaction(serial, start, TICK_FUTURE)));
+    outstandingReads.emplace(findRead(serial), serial, start, TICK_FUTURE);
 }
 
 bool
@@ -145,9 +146,7 @@ MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
     // preceding & overlapping writes.
     for (auto cluster = writeClusters.rbegin();
          cluster != writeClusters.rend() && wc_overlap; ++cluster) {
-        for (const auto& addr_write : cluster->writes) {
-            const Transaction& write = addr_write.second;
-
+        for (const Transaction& write : cluster->writes) {
             if (write.complete < last_obs.start) {
                 // If this write transaction completed before the last
                 // observation, we ignore it as the last_observation has the
@@ -226,16 +225,16 @@ bool
 MemChecker::ByteTracker::completeRead(MemChecker::Serial serial,
                                       Tick complete, uint8_t data)
 {
-    auto it = outstandingReads.find(serial);
+    auto it = findRead(serial);
 
-    if (it == outstandingReads.end()) {
+    if (it == outstandingReads.end() || it->serial != serial) {
         // Can happen if concurrent with reset_address_range
         warn("Could not locate read transaction: serial = %d, complete = %d\n",
              serial, complete);
         return true;
     }
 
-    Tick start = it->second.start;
+    Tick start = it->start;
     outstandingReads.erase(it);
 
     // Verify data
@@ -285,7 +284,7 @@ MemChecker::ByteTracker::pruneTransactions()
     // reads, we use curTick(), i.e. we will remove all readObservation except
     // the most recent one.
     const Tick before = outstandingReads.empty() ? curTick() :
-                        outstandingReads.begin()->second.start;
+                        outstandingReads.begin()->start;
 
     // Pruning of readObservations
     readObservations.erase(readObservations.begin(),
@@ -308,10 +307,8 @@ MemChecker::completeRead(MemChecker::Serial serial, Tick complete,
             "completing read: serial = %d, complete = %d, "
             "addr = %#llx, size = %d\n", serial, complete, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        ByteTracker *tracker = getByteTracker(addr + i);
-
-        if (!tracker->completeRead(serial, complete, data[i])) {
+    forEachByte(addr, size, [&](ByteTracker &tracker, size_t i) {
+        if (!tracker.completeRead(serial, complete, data[i])) {
             // Generate error message, and aggregate all failures for the bytes
             // considered in this transaction in one message.
             if (result) {
@@ -325,15 +322,15 @@ MemChecker::completeRead(MemChecker::Serial serial, Tick complete,
                                      "failed: received %#x, expected ",
                                      (unsigned long long)(addr + i), data[i]);
 
-            for (size_t j = 0; j < tracker->lastExpectedData().size(); ++j) {
+            for (size_t j = 0; j < tracker.lastExpectedData().size(); ++j) {
                 errorMessage +=
                     csprintf("%#x%s",
-                             tracker->lastExpectedData()[j],
-                             (j == tracker->lastExpectedData().size() - 1)
+                             tracker.lastExpectedData()[j],
+                             (j == tracker.lastExpectedData().size() - 1)
                              ? "" : "|");
             }
         }
-    }
+    });
 
     if (!result) {
         DPRINTF(MemChecker, "read of %#llx @ cycle %d failed:\n%s\n", addr,
@@ -347,7 +344,15 @@ void
 MemChecker::reset(Addr addr, size_t size)
 {
     for (size_t i = 0; i < size; ++i) {
-        byte_trackers.erase(addr + i);
+        const Addr line_addr = (addr + i) & ~(LineBytes - 1);
+        auto it = lineTrackers.find(line_addr);
+        if (it == lineTrackers.end()) {
+            // Nothing tracked in this line, skip to the next one
+            i += line_addr + LineBytes - (addr + i) - 1;
+            continue;
+        }
+        const Addr offset = (addr + i) - line_addr;
+        it->second[offset] = ByteTracker(addr + i, this);
     }
 }
 
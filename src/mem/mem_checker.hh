@@ -38,16 +38,14 @@
 #ifndef __MEM_MEM_CHECKER_HH__
 #define __MEM_MEM_CHECKER_HH__
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
-#include <list>
-#include <map>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "base/cprintf.hh"
-#include "base/named.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
 #include "debug/MemChecker.hh"
@@ -184,31 +182,38 @@ class MemChecker : public SimObject
         Tick complete;  //!< Completion of last write in cluster
 
         /**
-         * Map of Serial --> Transaction of all writes in cluster; contains
-         * all, in-flight or already completed.
+         * All writes in cluster, in-flight or already completed. Clusters
+         * hold few writes, so these are simply searched by serial.
          */
-        std::unordered_map<Serial, Transaction> writes;
+        std::vector<Transaction> writes;
 
       private:
+        std::vector<Transaction>::iterator
+        findWrite(Serial serial)
+        {
+            return std::find_if(writes.begin(), writes.end(),
+                    [serial](const Transaction &t)
+                    { return t.serial == serial; });
+        }
+
         Tick completeMax;
         size_t numIncomplete;
     };
 
-    typedef std::list<Transaction> TransactionList;
-    typedef std::list<WriteCluster> WriteClusterList;
+    typedef std::vector<Transaction> TransactionList;
+    typedef std::vector<WriteCluster> WriteClusterList;
 
     /**
      * The ByteTracker keeps track of transactions for the *same byte* -- all
      * outstanding reads, the completed reads (and what they observed) and write
      * clusters (see WriteCluster).
      */
-    class ByteTracker : public Named
+    class ByteTracker
     {
       public:
 
-        ByteTracker(Addr addr = 0, const MemChecker *parent = NULL)
-            : Named((parent != NULL ? parent->name() : "") +
-                     csprintf(".ByteTracker@%#llx", addr))
+        ByteTracker(Addr _addr = 0, const MemChecker *_parent = NULL)
+            : addr(_addr), parent(_parent)
         {
             // The initial transaction has start == complete == TICK_INITIAL,
             // indicating that there has been no real write to this location;
@@ -301,6 +306,17 @@ class MemChecker : public SimObject
         const std::vector<uint8_t>& lastExpectedData() const
         { return _lastExpectedData; }
 
+        /**
+         * The name is only built when tracing, so trackers are cheap to
+         * create.
+         */
+        std::string
+        name() const
+        {
+            return (parent != NULL ? parent->name() : "") +
+                csprintf(".ByteTracker@%#llx", addr);
+        }
+
       private:
 
         /**
@@ -346,15 +362,32 @@ class MemChecker : public SimObject
          */
         void pruneTransactions();
 
+        /**
+         * The first outstanding read with a serial not less than the given
+         * one, i.e. where a read with that serial is or would go.
+         */
+        std::vector<Transaction>::iterator
+        findRead(Serial serial)
+        {
+            return std::lower_bound(outstandingReads.begin(),
+                    outstandingReads.end(), serial,
+                    [](const Transaction &t, Serial s)
+                    { return t.serial < s; });
+        }
+
       private:
 
+        Addr addr;
+        const MemChecker *parent;
+
         /**
-         * Maintains a map of Serial -> Transaction for all outstanding reads.
+         * All outstanding reads, sorted by serial.
          *
-         * Use an ordered map here, as this makes pruneTransactions() more
-         * efficient (find first outstanding read).
+         * Keeping them ordered makes pruneTransactions() more efficient
+         * (find first outstanding read), and as serials are handed out in
+         * order new reads are simply appended.
          */
-        std::map<Serial, Transaction> outstandingReads;
+        std::vector<Transaction> outstandingReads;
 
         /**
          * List of completed reads, i.e. observations of reads.
@@ -451,8 +484,13 @@ class MemChecker : public SimObject
      * same serial S and then receive a completion of the transaction before
      * the reset with serial S.
      */
-    void reset()
-    { byte_trackers.clear(); }
+    void
+    reset()
+    {
+        lineTrackers.clear();
+        lastLineAddr = MaxAddr;
+        lastLine = nullptr;
+    }
 
     /**
      * Resets an address-range. This may be useful in case other unmonitored
@@ -477,17 +515,54 @@ class MemChecker : public SimObject
 
   private:
     /**
-     * Returns the instance of ByteTracker for the requested location.
+     * Bytes are tracked in groups of this many, aligned, so that each
+     * transaction looks up its trackers once per group rather than once
+     * per byte.
      */
-    ByteTracker* getByteTracker(Addr addr)
+    static constexpr Addr LineBytes = 64;
+
+    typedef std::vector<ByteTracker> LineTracker;
+
+    /**
+     * Returns the trackers of the line holding the requested location,
+     * indexed by the offset of bytes within the line.
+     */
+    LineTracker &
+    getLineTracker(Addr addr)
     {
-        auto it = byte_trackers.find(addr);
-        if (it == byte_trackers.end()) {
-            it = byte_trackers.insert(
-                std::make_pair(addr, ByteTracker(addr, this))).first;
+        const Addr line_addr = addr & ~(LineBytes - 1);
+        if (line_addr == lastLineAddr)
+            return *lastLine;
+
+        auto it = lineTrackers.find(line_addr);
+        if (it == lineTrackers.end()) {
+            it = lineTrackers.emplace(line_addr, LineTracker()).first;
+            it->second.reserve(LineBytes);
+            for (Addr i = 0; i < LineBytes; ++i)
+                it->second.emplace_back(line_addr + i, this);
         }
-        return &it->second;
-    };
+        lastLineAddr = line_addr;
+        lastLine = &it->second;
+        return it->second;
+    }
+
+    /**
+     * Calls f(tracker, i) for the tracker of each byte addr + i of a
+     * transaction.
+     */
+    template <class F>
+    void
+    forEachByte(Addr addr, size_t size, F f)
+    {
+        for (size_t i = 0; i < size; ) {
+            LineTracker &line = getLineTracker(addr + i);
+            const Addr offset = (addr + i) & (LineBytes - 1);
+            const size_t n = std::min<size_t>(size - i, LineBytes - offset);
+            for (size_t j = 0; j < n; ++j)
+                f(line[offset + j], i + j);
+            i += n;
+        }
+    }
 
   private:
     /**
@@ -502,17 +577,21 @@ class MemChecker : public SimObject
     Serial nextSerial;
 
     /**
-     * Maintain a map of address --> byte-tracker. Per-byte entries are
-     * initialized as needed.
+     * Maintain a map of line address --> byte-trackers of the line. Lines
+     * are initialized as needed.
      *
      * The required space for this obviously grows with the number of distinct
      * addresses used for a particular workload. The used size is independent on
      * the number of nodes in the system, those may affect the size of per-byte
      * tracking information.
      *
-     * Access via getByteTracker()!
+     * Access via getLineTracker()!
      */
-    std::unordered_map<Addr, ByteTracker> byte_trackers;
+    std::unordered_map<Addr, LineTracker> lineTrackers;
+
+    /** The line last looked up, as transactions tend to hit it again */
+    Addr lastLineAddr = MaxAddr;
+    LineTracker *lastLine = nullptr;
 };
 
 inline MemChecker::Serial
@@ -522,9 +601,8 @@ MemChecker::startRead(Tick start, Addr addr, size_t size)
             "starting read: serial = %d, start = %d, addr = %#llx, "
             "size = %d\n", nextSerial, start, addr , size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->startRead(nextSerial, start);
-    }
+    forEachByte(addr, size, [this, start](ByteTracker &tracker, size_t i)
+                { tracker.startRead(nextSerial, start); });
 
     return nextSerial++;
 }
@@ -536,9 +614,9 @@ MemChecker::startWrite(Tick start, Addr addr, size_t size, const uint8_t *data)
             "starting write: serial = %d, start = %d, addr = %#llx, "
             "size = %d\n", nextSerial, start, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->startWrite(nextSerial, start, data[i]);
-    }
+    forEachByte(addr, size,
+                [this, start, data](ByteTracker &tracker, size_t i)
+                { tracker.startWrite(nextSerial, start, data[i]); });
 
     return nextSerial++;
 }
@@ -551,9 +629,8 @@ MemChecker::completeWrite(MemChecker::Serial serial, Tick complete,
             "completing write: serial = %d, complete = %d, "
             "addr = %#llx, size = %d\n", serial, complete, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->completeWrite(serial, complete);
-    }
+    forEachByte(addr, size, [serial, complete](ByteTracker &tracker, size_t)
+                { tracker.completeWrite(serial, complete); });
 }
 
 inline void
@@ -563,9 +640,8 @@ MemChecker::abortWrite(MemChecker::Serial serial, Addr addr, size_t size)
             "aborting write: serial = %d, addr = %#llx, size = %d\n",
             serial, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->abortWrite(serial);
-    }
+    forEachByte(addr, size, [serial](ByteTracker &tracker, size_t)
+                { tracker.abortWrite(serial); });
 }
 
 } // namespace gem5
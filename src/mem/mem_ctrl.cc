@@ -40,6 +40,8 @@
 
 #include "mem/mem_ctrl.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/DRAM.hh"
 #include "debug/Drain.hh"
@@ -57,6 +59,117 @@ namespace gem5
 namespace memory
 {
 
+namespace
+{
+
+bool
+beforeSeq(const MemPacket *pkt, uint64_t seq)
+{
+    return pkt->queueSeq < seq;
+}
+
+} // anonymous namespace
+
+MemPacket *
+MemPacketQueue::BankQueue::front() const
+{
+    assert(!rowHeads.empty());
+    return rows.at(rowHeads.begin()->second).front();
+}
+
+MemPacket *
+MemPacketQueue::BankQueue::oldestTo(uint32_t row) const
+{
+    auto it = rows.find(row);
+    return it == rows.end() ? nullptr : it->second.front();
+}
+
+MemPacket *
+MemPacketQueue::BankQueue::oldestNotTo(uint32_t row) const
+{
+    // At most one of the row heads is to the given row
+    for (const auto &[seq, head_row] : rowHeads) {
+        if (head_row != row)
+            return rows.at(head_row).front();
+    }
+    return nullptr;
+}
+
+void
+MemPacketQueue::push_back(MemPacket *pkt)
+{
+    pkt->queueSeq = nextSeq++;
+    packets.push_back(pkt);
+
+    BankQueue &bank_queue = bankQueues[bankKey(pkt->isDram(),
+            pkt->pseudoChannel, pkt->bankId)];
+    auto &row = bank_queue.rows[pkt->row];
+    if (row.empty())
+        bank_queue.rowHeads.emplace(pkt->queueSeq, pkt->row);
+    row.push_back(pkt);
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::erase(iterator pos)
+{
+    MemPacket *pkt = *pos;
+
+    auto bank_it = bankQueues.find(bankKey(pkt->isDram(),
+            pkt->pseudoChannel, pkt->bankId));
+    assert(bank_it != bankQueues.end());
+    BankQueue &bank_queue = bank_it->second;
+
+    auto row_it = bank_queue.rows.find(pkt->row);
+    assert(row_it != bank_queue.rows.end());
+    auto &row = row_it->second;
+
+    auto it = std::lower_bound(row.begin(), row.end(), pkt->queueSeq,
+                               beforeSeq);
+    assert(it != row.end() && *it == pkt);
+    if (it == row.begin()) {
+        bank_queue.rowHeads.erase({pkt->queueSeq, pkt->row});
+        row.pop_front();
+        if (!row.empty())
+            bank_queue.rowHeads.emplace(row.front()->queueSeq, pkt->row);
+    } else {
+        row.erase(it);
+    }
+
+    if (row.empty()) {
+        bank_queue.rows.erase(row_it);
+        if (bank_queue.rows.empty())
+            bankQueues.erase(bank_it);
+    }
+
+    return packets.erase(pos);
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::find(const MemPacket *pkt)
+{
+    auto it = std::lower_bound(packets.begin(), packets.end(),
+                               pkt->queueSeq, beforeSeq);
+    assert(it != packets.end() && *it == pkt);
+    return it;
+}
+
+std::pair<MemPacketQueue::BankMap::const_iterator,
+          MemPacketQueue::BankMap::const_iterator>
+MemPacketQueue::banks(bool dram, uint8_t pseudo_channel) const
+{
+    return std::make_pair(
+            bankQueues.lower_bound(bankKey(dram, pseudo_channel, 0)),
+            bankQueues.upper_bound(bankKey(dram, pseudo_channel, 0xffff)));
+}
+
+const MemPacketQueue::BankQueue *
+MemPacketQueue::bank(bool dram, uint8_t pseudo_channel,
+                     uint16_t bank_id) const
+{
+    auto it = bankQueues.find(bankKey(dram, pseudo_channel, bank_id));
+    return it == bankQueues.end() ? nullptr : &it->second;
+}
+
 MemCtrl::MemCtrl(const MemCtrlParams &p) :
     qos::MemCtrl(p),
     port(name() + ".port", *this), isTimingMode(false),
@@ -158,7 +271,7 @@ Tick
 MemCtrl::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor)
 {
     Tick latency = recvAtomic(pkt);
-    dram->getBackdoor(backdoor);
+    dram->getBackdoor(backdoor, pkt->getAddr());
     return latency;
 }
 
@@ -486,7 +599,7 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
 
 void
 MemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -865,21 +978,21 @@ MemCtrl::nvmWriteBlock(MemInterface* mem_intr) {
 void
 MemCtrl::nonDetermReads(MemInterface* mem_intr) {
 
-    for (auto queue = readQueue.rbegin();
-            queue != readQueue.rend(); ++queue) {
+    for (int prio = highestReadyPriority(READ); prio >= 0;
+            prio = highestReadyPriority(READ, prio)) {
             // select non-deterministic NVM read to issue
             // assume that we have the command bandwidth to issue this along
             // with additional RD/WR burst with needed bank operations
             if (mem_intr->readsWaitingToIssue()) {
                 // select non-deterministic NVM read to issue
-                mem_intr->chooseRead(*queue);
+                mem_intr->chooseRead(readQueue[prio]);
             }
     }
 }
 
 void
 MemCtrl::processNextReqEvent(MemInterface* mem_intr,
-                        MemPacketQueue& resp_queue,
+                        std::deque<MemPacket*>& resp_queue,
                         EventFunctionWrapper& resp_event,
                         EventFunctionWrapper& next_req_event,
                         bool& retry_wr_req) {
@@ -967,24 +1080,24 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
 
             bool read_found = false;
             MemPacketQueue::iterator to_read;
-            uint8_t prio = numPriorities();
 
-            for (auto queue = readQueue.rbegin();
-                 queue != readQueue.rend(); ++queue) {
+            // Only visit the priorities with queued reads, highest first
+            for (int prio = highestReadyPriority(READ); prio >= 0;
+                 prio = highestReadyPriority(READ, prio)) {
 
-                prio--;
+                MemPacketQueue &queue = readQueue[prio];
 
                 DPRINTF(QOS,
                         "Checking READ queue [%d] priority [%d elements]\n",
-                        prio, queue->size());
+                        prio, queue.size());
 
                 // Figure out which read request goes next
                 // If we are changing command type, incorporate the minimum
                 // bus turnaround delay which will be rank to rank delay
-                to_read = chooseNext((*queue), switched_cmd_type ?
+                to_read = chooseNext(queue, switched_cmd_type ?
                                      minWriteToReadDataGap() : 0, mem_intr);
 
-                if (to_read != queue->end()) {
+                if (to_read != queue.end()) {
                     // candidate read found
                     read_found = true;
                     break;
@@ -1059,23 +1172,23 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
 
         bool write_found = false;
         MemPacketQueue::iterator to_write;
-        uint8_t prio = numPriorities();
 
-        for (auto queue = writeQueue.rbegin();
-             queue != writeQueue.rend(); ++queue) {
+        // Only visit the priorities with queued writes, highest first
+        for (int prio = highestReadyPriority(WRITE); prio >= 0;
+             prio = highestReadyPriority(WRITE, prio)) {
 
-            prio--;
+            MemPacketQueue &queue = writeQueue[prio];
 
             DPRINTF(QOS,
                     "Checking WRITE queue [%d] priority [%d elements]\n",
-                    prio, queue->size());
+                    prio, queue.size());
 
             // If we are changing command type, incorporate the minimum
             // bus turnaround delay
-            to_write = chooseNext((*queue),
+            to_write = chooseNext(queue,
                     switched_cmd_type ? minReadToWriteDataGap() : 0, mem_intr);
 
-            if (to_write != queue->end()) {
+            if (to_write != queue.end()) {
                 write_found = true;
                 break;
             }
@@ -1388,7 +1501,7 @@ MemCtrl::recvMemBackdoorReq(const MemBackdoorReq &req,
             "Can't handle address range for backdoor %s.",
             req.range().to_string());
 
-    dram->getBackdoor(backdoor);
+    dram->getBackdoor(backdoor, req.range().start());
 }
 
 bool
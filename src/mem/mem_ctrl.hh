@@ -47,6 +47,8 @@
 #define __MEM_CTRL_HH__
 
 #include <deque>
+#include <map>
+#include <set>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -156,6 +158,12 @@ class MemPacket
      */
     uint8_t _qosValue;
 
+    /**
+     * Position of the packet in the MemPacketQueue holding it, increasing
+     * from the front of the queue to the back
+     */
+    uint64_t queueSeq = 0;
+
     /**
      * Set the packet QoS value
      * (interface compatibility with Packet)
@@ -215,9 +223,88 @@ class MemPacket
 
 };
 
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
+/**
+ * A queue of memory packets, in arrival order, which also indexes its
+ * packets by bank and, within a bank, by row. This lets the schedulers
+ * find the oldest packet to a bank's open row, or the oldest one that
+ * misses it, without walking the whole queue. Packets only ever join
+ * the back of a queue, and a packet must leave its queue before joining
+ * another one.
+ *
+ * The memory packets are stored in one such queue per QoS priority.
+ */
+class MemPacketQueue
+{
+  public:
+    typedef std::deque<MemPacket*>::iterator iterator;
+    typedef std::deque<MemPacket*>::const_iterator const_iterator;
+
+    /** The packets of one bank, indexed by row */
+    class BankQueue
+    {
+      public:
+        /** The oldest packet to the bank */
+        MemPacket *front() const;
+
+        /** The oldest packet to the given row, or nullptr if none */
+        MemPacket *oldestTo(uint32_t row) const;
+
+        /** The oldest packet to any other row, or nullptr if none */
+        MemPacket *oldestNotTo(uint32_t row) const;
+
+      private:
+        friend class MemPacketQueue;
+
+        /** The packets to each row, oldest first */
+        std::map<uint32_t, std::deque<MemPacket*>> rows;
+
+        /** The queue position of the oldest packet of each row */
+        std::set<std::pair<uint64_t, uint32_t>> rowHeads;
+    };
+
+    /** Non-empty banks, by media, pseudo channel and bank id */
+    typedef std::map<uint32_t, BankQueue> BankMap;
+
+    iterator begin() { return packets.begin(); }
+    iterator end() { return packets.end(); }
+    const_iterator begin() const { return packets.begin(); }
+    const_iterator end() const { return packets.end(); }
+
+    bool empty() const { return packets.empty(); }
+    size_t size() const { return packets.size(); }
+    MemPacket *front() const { return packets.front(); }
+    MemPacket *back() const { return packets.back(); }
+
+    void push_back(MemPacket *pkt);
+    void pop_front() { erase(packets.begin()); }
+    iterator erase(iterator pos);
+
+    /** Find a packet, which must be in this queue */
+    iterator find(const MemPacket *pkt);
+
+    /**
+     * The non-empty banks of one media type and pseudo channel, as a
+     * range of (key, BankQueue) pairs ordered by bank id.
+     */
+    std::pair<BankMap::const_iterator, BankMap::const_iterator>
+    banks(bool dram, uint8_t pseudo_channel) const;
+
+    /** The packets to one bank, or nullptr if there are none */
+    const BankQueue *bank(bool dram, uint8_t pseudo_channel,
+                          uint16_t bank_id) const;
+
+  private:
+    static uint32_t
+    bankKey(bool dram, uint8_t pseudo_channel, uint16_t bank_id)
+    {
+        return (uint32_t(dram) << 24) | (uint32_t(pseudo_channel) << 16) |
+            bank_id;
+    }
+
+    std::deque<MemPacket*> packets;
+    BankMap bankQueues;
+    uint64_t nextSeq = 0;
+};
 
 
 /**
@@ -300,14 +387,14 @@ class MemCtrl : public qos::MemCtrl
      * in these methods
      */
     virtual void processNextReqEvent(MemInterface* mem_intr,
-                          MemPacketQueue& resp_queue,
+                          std::deque<MemPacket*>& resp_queue,
                           EventFunctionWrapper& resp_event,
                           EventFunctionWrapper& next_req_event,
                           bool& retry_wr_req);
     EventFunctionWrapper nextReqEvent;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req);
     EventFunctionWrapper respondEvent;
@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/multi_channel_mem_ctrl.hh"
+
+#include "base/trace.hh"
+#include "debug/Drain.hh"
+#include "debug/MemCtrl.hh"
+#include "mem/dram_interface.hh"
+#include "mem/mem_interface.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+MultiChannelMemCtrl::Channel::Channel(MultiChannelMemCtrl &ctrl,
+                                      DRAMInterface *_intf)
+    : intf(_intf), retryRdReq(false), retryWrReq(false),
+      nextReqEvent([this, &ctrl] { ctrl.processChannelReqEvent(*this); },
+                   ctrl.name()),
+      respondEvent([this, &ctrl] { ctrl.processRespondEvent(intf,
+                        respQueue, respondEvent, retryRdReq); },
+                   ctrl.name())
+{
+}
+
+MultiChannelMemCtrl::MultiChannelMemCtrl(
+        const MultiChannelMemCtrlParams &p)
+    : MemCtrl(p)
+{
+    DPRINTF(MemCtrl, "Setting up multi-channel controller\n");
+
+    fatal_if(p.channels.empty(), "%s: needs at least one channel\n",
+             name());
+    fatal_if(p.channels.size() > 256, "%s: supports at most 256 "
+             "channels\n", name());
+    fatal_if(p.dram != p.channels[0], "%s: the dram interface must be "
+             "the first channel\n", name());
+
+    std::vector<AddrRange> ranges;
+    for (int i = 0; i < p.channels.size(); i++) {
+        DRAMInterface *intf = p.channels[i];
+        ranges.push_back(intf->getAddrRange());
+        channels.emplace_back(new Channel(*this, intf));
+        intf->setCtrl(this, commandWindow, i);
+    }
+
+    // the channels have to hold the interleaved stripes of a single
+    // range in order, which lets the channel of a request be read
+    // straight from the interleaving bits of its address
+    channelRange = ranges[0];
+    if (channels.size() > 1) {
+        // merging the ranges checks that they cover all stripes in
+        // order and share the same start, end and interleaving bits
+        AddrRange merged(ranges);
+        fatal_if(merged.interleaved(), "%s: the channels must cover "
+                 "the whole interleaved range\n", name());
+    } else {
+        fatal_if(channelRange.interleaved(), "%s: a single channel "
+                 "can not be interleaved\n", name());
+    }
+
+    readBufferSize = 0;
+    writeBufferSize = 0;
+    for (const auto &channel : channels) {
+        readBufferSize += channel->intf->readBufferSize;
+        writeBufferSize += channel->intf->writeBufferSize;
+    }
+
+    // the write thresholds apply to the write queue of each channel
+    writeHighThreshold = channels[0]->intf->writeBufferSize *
+        p.write_high_thresh_perc / 100.0;
+    writeLowThreshold = channels[0]->intf->writeBufferSize *
+        p.write_low_thresh_perc / 100.0;
+}
+
+void
+MultiChannelMemCtrl::startup()
+{
+    MemCtrl::startup();
+
+    if (isTimingMode) {
+        // as for the first channel in MemCtrl::startup, keep the bus
+        // busy time far enough ahead to never go negative
+        for (const auto &channel : channels) {
+            channel->intf->nextBurstAt =
+                curTick() + channel->intf->commandOffset();
+        }
+    }
+}
+
+MultiChannelMemCtrl::Channel &
+MultiChannelMemCtrl::decodeChannel(Addr addr)
+{
+    panic_if(addr < channelRange.start() || addr >= channelRange.end(),
+             "Can't handle address %#x\n", addr);
+
+    Channel &channel = *channels[channelRange.intlvMatchFor(addr)];
+    assert(channel.intf->getAddrRange().contains(addr));
+    return channel;
+}
+
+void
+MultiChannelMemCtrl::processChannelReqEvent(Channel &channel)
+{
+    // the channels have independent command buses, so the contention
+    // checks of the shared scheduler code only see this channel
+    burstTicks.swap(channel.burstTicks);
+    processNextReqEvent(channel.intf, channel.respQueue,
+                        channel.respondEvent, channel.nextReqEvent,
+                        channel.retryWrReq);
+    burstTicks.swap(channel.burstTicks);
+}
+
+bool
+MultiChannelMemCtrl::readQueueFull(const Channel &channel,
+                                   unsigned int neededEntries) const
+{
+    DPRINTF(MemCtrl,
+            "Read queue limit %d, channel %d size %d, entries needed %d\n",
+            channel.intf->readBufferSize, channel.intf->pseudoChannel,
+            channel.intf->readQueueSize + channel.respQueue.size(),
+            neededEntries);
+
+    auto rdsize_new = channel.intf->readQueueSize +
+        channel.respQueue.size() + neededEntries;
+    return rdsize_new > channel.intf->readBufferSize;
+}
+
+bool
+MultiChannelMemCtrl::writeQueueFull(const Channel &channel,
+                                    unsigned int neededEntries) const
+{
+    DPRINTF(MemCtrl,
+            "Write queue limit %d, channel %d size %d, entries needed %d\n",
+            channel.intf->writeBufferSize, channel.intf->pseudoChannel,
+            channel.intf->writeQueueSize, neededEntries);
+
+    auto wrsize_new = channel.intf->writeQueueSize + neededEntries;
+    return wrsize_new > channel.intf->writeBufferSize;
+}
+
+bool
+MultiChannelMemCtrl::recvTimingReq(PacketPtr pkt)
+{
+    // This is where we enter from the outside world
+    DPRINTF(MemCtrl, "recvTimingReq: request %s addr %#x size %d\n",
+            pkt->cmdString(), pkt->getAddr(), pkt->getSize());
+
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    panic_if(!(pkt->isRead() || pkt->isWrite()),
+             "Should only see read and writes at memory controller\n");
+
+    // Calc avg gap between requests
+    if (prevArrival != 0) {
+        stats.totGap += curTick() - prevArrival;
+    }
+    prevArrival = curTick();
+
+    Channel &channel = decodeChannel(pkt->getAddr());
+
+    // Find out how many memory packets a pkt translates to
+    unsigned size = pkt->getSize();
+    uint32_t burst_size = channel.intf->bytesPerBurst();
+
+    unsigned offset = pkt->getAddr() & (burst_size - 1);
+    unsigned int pkt_count = divCeil(offset + size, burst_size);
+
+    // run the QoS scheduler and assign a QoS priority value to the packet
+    qosSchedule( { &readQueue, &writeQueue }, burst_size, pkt);
+
+    // check local buffers and do not accept if full
+    if (pkt->isWrite()) {
+        assert(size != 0);
+        if (writeQueueFull(channel, pkt_count)) {
+            DPRINTF(MemCtrl, "Write queue full, not accepting\n");
+            // remember that we have to retry this port
+            channel.retryWrReq = true;
+            stats.numWrRetry++;
+            return false;
+        } else {
+            addToWriteQueue(pkt, pkt_count, channel.intf);
+            if (!channel.nextReqEvent.scheduled()) {
+                DPRINTF(MemCtrl, "Request scheduled immediately\n");
+                schedule(channel.nextReqEvent, curTick());
+            }
+            stats.writeReqs++;
+            stats.bytesWrittenSys += size;
+        }
+    } else {
+        assert(pkt->isRead());
+        assert(size != 0);
+        if (readQueueFull(channel, pkt_count)) {
+            DPRINTF(MemCtrl, "Read queue full, not accepting\n");
+            // remember that we have to retry this port
+            channel.retryRdReq = true;
+            stats.numRdRetry++;
+            return false;
+        } else {
+            if (!addToReadQueue(pkt, pkt_count, channel.intf)) {
+                if (!channel.nextReqEvent.scheduled()) {
+                    DPRINTF(MemCtrl, "Request scheduled immediately\n");
+                    schedule(channel.nextReqEvent, curTick());
+                }
+            }
+            stats.readReqs++;
+            stats.bytesReadSys += size;
+        }
+    }
+
+    return true;
+}
+
+Tick
+MultiChannelMemCtrl::recvAtomic(PacketPtr pkt)
+{
+    return recvAtomicLogic(pkt, decodeChannel(pkt->getAddr()).intf);
+}
+
+Tick
+MultiChannelMemCtrl::recvAtomicBackdoor(PacketPtr pkt,
+                                        MemBackdoorPtr &backdoor)
+{
+    Channel &channel = decodeChannel(pkt->getAddr());
+    Tick latency = recvAtomicLogic(pkt, channel.intf);
+    channel.intf->getBackdoor(backdoor, pkt->getAddr());
+    return latency;
+}
+
+void
+MultiChannelMemCtrl::recvFunctional(PacketPtr pkt)
+{
+    bool found = recvFunctionalLogic(pkt,
+                                     decodeChannel(pkt->getAddr()).intf);
+    panic_if(!found, "Can't handle address range for packet %s\n",
+             pkt->print());
+}
+
+void
+MultiChannelMemCtrl::recvMemBackdoorReq(const MemBackdoorReq &req,
+                                        MemBackdoorPtr &backdoor)
+{
+    decodeChannel(req.range().start()).intf->getBackdoor(
+            backdoor, req.range().start());
+}
+
+bool
+MultiChannelMemCtrl::respQEmpty()
+{
+    for (const auto &channel : channels) {
+        if (!channel->respQueue.empty())
+            return false;
+    }
+    return true;
+}
+
+bool
+MultiChannelMemCtrl::respondEventScheduled(uint8_t pseudo_channel) const
+{
+    assert(pseudo_channel < channels.size());
+    return channels[pseudo_channel]->respondEvent.scheduled();
+}
+
+bool
+MultiChannelMemCtrl::requestEventScheduled(uint8_t pseudo_channel) const
+{
+    assert(pseudo_channel < channels.size());
+    return channels[pseudo_channel]->nextReqEvent.scheduled();
+}
+
+void
+MultiChannelMemCtrl::restartScheduler(Tick tick, uint8_t pseudo_channel)
+{
+    assert(pseudo_channel < channels.size());
+    schedule(channels[pseudo_channel]->nextReqEvent, tick);
+}
+
+bool
+MultiChannelMemCtrl::allIntfDrained() const
+{
+    for (const auto &channel : channels) {
+        if (!channel->intf->allRanksDrained())
+            return false;
+    }
+    return true;
+}
+
+DrainState
+MultiChannelMemCtrl::drain()
+{
+    if (totalWriteQueueSize || totalReadQueueSize || !respQEmpty() ||
+          !allIntfDrained()) {
+        DPRINTF(Drain, "Memory controller not drained, write: %d, read: %d\n",
+                totalWriteQueueSize, totalReadQueueSize);
+
+        for (const auto &channel : channels) {
+            // the only queue that is not drained automatically over
+            // time is the write queue, thus kick things into action
+            if (channel->intf->writeQueueSize &&
+                !channel->nextReqEvent.scheduled()) {
+                DPRINTF(Drain, "Scheduling nextReqEvent from drain\n");
+                schedule(channel->nextReqEvent, curTick());
+            }
+
+            channel->intf->drainRanks();
+        }
+
+        return DrainState::Draining;
+    } else {
+        return DrainState::Drained;
+    }
+}
+
+void
+MultiChannelMemCtrl::drainResume()
+{
+    if (!isTimingMode && system()->isTimingMode()) {
+        // if we switched to timing mode, kick things into action,
+        // and behave as if we restored from a checkpoint
+        startup();
+        for (const auto &channel : channels) {
+            channel->intf->startup();
+        }
+    } else if (isTimingMode && !system()->isTimingMode()) {
+        // if we switch from timing mode, stop the refresh events to
+        // not cause issues with KVM
+        for (const auto &channel : channels) {
+            channel->intf->suspend();
+        }
+    }
+
+    // update the mode
+    isTimingMode = system()->isTimingMode();
+}
+
+AddrRangeList
+MultiChannelMemCtrl::getAddrRanges()
+{
+    // a single range covering all channels, so that whatever is in
+    // front of the controller only has one entry to look up
+    std::vector<AddrRange> ranges;
+    for (const auto &channel : channels) {
+        ranges.push_back(channel->intf->getAddrRange());
+    }
+    return { AddrRange(ranges) };
+}
+
+} // namespace memory
+} // namespace gem5
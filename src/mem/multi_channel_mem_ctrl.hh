@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * MultiChannelMemCtrl declaration
+ */
+
+#ifndef __MEM_MULTI_CHANNEL_MEM_CTRL_HH__
+#define __MEM_MULTI_CHANNEL_MEM_CTRL_HH__
+
+#include <deque>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "mem/mem_ctrl.hh"
+#include "params/MultiChannelMemCtrl.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+class DRAMInterface;
+
+/**
+ * A memory controller for a set of independent DRAM channels behind a
+ * single response port. Each channel has its own scheduler, response
+ * queue and command bus, exactly as if it had a controller of its
+ * own, but the channel of a request is decoded from the interleaving
+ * bits of its address directly in the controller rather than by a
+ * crossbar in front of one controller per channel. The read and write
+ * queues are shared and partitioned per channel, using the buffer
+ * sizes of the interfaces, in the same way the HBMCtrl handles its
+ * two pseudo channels.
+ */
+class MultiChannelMemCtrl : public MemCtrl
+{
+  private:
+
+    /**
+     * The per-channel scheduling state, the channel index doubling as
+     * the pseudo channel number of its interface.
+     */
+    struct Channel
+    {
+        Channel(MultiChannelMemCtrl &ctrl, DRAMInterface *intf);
+
+        DRAMInterface *intf;
+
+        /** Reads that have been issued, waiting for their response */
+        std::deque<MemPacket*> respQueue;
+
+        /** Command bus occupancy of this channel */
+        std::unordered_multiset<Tick> burstTicks;
+
+        bool retryRdReq;
+        bool retryWrReq;
+
+        EventFunctionWrapper nextReqEvent;
+        EventFunctionWrapper respondEvent;
+    };
+
+    std::vector<std::unique_ptr<Channel>> channels;
+
+    /**
+     * The address range of the first channel, used to decode the
+     * channel of an address from its interleaving bits.
+     */
+    AddrRange channelRange;
+
+    /**
+     * Find the channel holding an address.
+     *
+     * @param addr Address to decode
+     * @return the channel, which holds the address
+     */
+    Channel &decodeChannel(Addr addr);
+
+    /**
+     * Run the scheduler of a channel, with the command bus of the
+     * channel swapped in as the one checked by verifySingleCmd and
+     * verifyMultiCmd.
+     */
+    void processChannelReqEvent(Channel &channel);
+
+    bool readQueueFull(const Channel &channel,
+                       unsigned int pkt_count) const;
+    bool writeQueueFull(const Channel &channel,
+                        unsigned int pkt_count) const;
+
+  protected:
+
+    bool respQEmpty() override;
+
+    AddrRangeList getAddrRanges() override;
+
+    Tick recvAtomic(PacketPtr pkt) override;
+    Tick recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor) override;
+    void recvFunctional(PacketPtr pkt) override;
+    void recvMemBackdoorReq(const MemBackdoorReq &req,
+            MemBackdoorPtr &backdoor) override;
+    bool recvTimingReq(PacketPtr pkt) override;
+
+  public:
+
+    MultiChannelMemCtrl(const MultiChannelMemCtrlParams &p);
+
+    bool respondEventScheduled(uint8_t pseudo_channel) const override;
+    bool requestEventScheduled(uint8_t pseudo_channel) const override;
+    void restartScheduler(Tick tick, uint8_t pseudo_channel) override;
+
+    bool allIntfDrained() const override;
+    DrainState drain() override;
+
+    void startup() override;
+    void drainResume() override;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_MULTI_CHANNEL_MEM_CTRL_HH__
@@ -57,6 +57,7 @@
 #include "base/compiler.hh"
 #include "base/extensible.hh"
 #include "base/flags.hh"
+#include "base/free_list.hh"
 #include "base/logging.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
@@ -291,7 +292,8 @@ class MemCmd
  * ultimate destination and back, possibly being conveyed by several
  * different Packets along the way.)
  */
-class Packet : public Printable, public Extensible<Packet>
+class Packet : public Printable, public Extensible<Packet>,
+               public FreeListAllocated<Packet>
 {
   public:
     typedef uint32_t FlagsType;
@@ -353,6 +355,10 @@ class Packet : public Printable, public Extensible<Packet>
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// Set together with DYNAMIC_DATA when the data was allocated by
+        /// allocate() and should be returned to the FreeList pools
+        /// rather than freed with delete [].
+        POOLED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -1355,14 +1361,20 @@ class Packet : public Printable, public Extensible<Packet>
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(POOLED_DATA))
+            FreeList::deallocate(data, getSize());
+        else if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA);
         data = NULL;
     }
 
-    /** Allocate memory for the packet. */
+    /**
+     * Allocate memory for the packet. The buffer is taken from the
+     * size-classed FreeList pools, so data for the common cache line
+     * sized packets is recycled rather than going through the heap.
+     */
     void
     allocate()
     {
@@ -1370,8 +1382,9 @@ class Packet : public Printable, public Extensible<Packet>
         // payload, actually allocate space
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
-            flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            flags.set(DYNAMIC_DATA|POOLED_DATA);
+            data = static_cast<PacketDataPtr>(
+                FreeList::allocate(getSize()));
         }
     }
 
@@ -131,6 +131,12 @@ PacketQueue::schedSendTiming(PacketPtr pkt, Tick when)
     // ourselves again before we had a chance to update waitingOnRetry
     // assert(waitingOnRetry || sendEvent.scheduled());
 
+    // in the common case the packet goes at the end of the list
+    if (!transmitList.empty() && transmitList.back().tick <= when) {
+        transmitList.emplace_back(when, pkt);
+        return;
+    }
+
     // this belongs in the middle somewhere, so search from the end to
     // order by tick; however, if forceOrder is set, also make sure
     // not to re-order in front of some existing packet with the same
@@ -49,7 +49,7 @@
  * for the flow control of the port.
  */
 
-#include <list>
+#include <deque>
 
 #include "mem/port.hh"
 #include "sim/drain.hh"
@@ -76,9 +76,14 @@ class PacketQueue : public Drainable
         {}
     };
 
-    typedef std::list<DeferredPacket> DeferredPacketList;
+    /**
+     * Packets are nearly always scheduled in tick order, so they are
+     * added at the back and taken from the front, which a deque does in
+     * constant time without allocating each packet its own node.
+     */
+    typedef std::deque<DeferredPacket> DeferredPacketList;
 
-    /** A list of outgoing packets. */
+    /** A list of outgoing packets, in the order they are sent in. */
     DeferredPacketList transmitList;
 
     /** The manager which is used for the event queue */
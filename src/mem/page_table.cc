@@ -33,6 +33,7 @@
  */
 #include "mem/page_table.hh"
 
+#include <sstream>
 #include <string>
 
 #include "base/compiler.hh"
@@ -44,30 +45,182 @@
 namespace gem5
 {
 
+EmulationPageTable::Node::Node(unsigned _level, host_mem::Account &host_mem)
+    : level(_level), hostMem(host_mem)
+{
+    hostMem.add(sizeof(Node));
+    if (level == 0) {
+        entries.reset(new Entry[Fanout]);
+        hostMem.add(Fanout * sizeof(Entry));
+    } else {
+        children.reset(new std::unique_ptr<Node>[Fanout]);
+        hostMem.add(Fanout * sizeof(std::unique_ptr<Node>));
+    }
+}
+
+EmulationPageTable::Node::~Node()
+{
+    hostMem.sub(sizeof(Node));
+    if (entries)
+        hostMem.sub(Fanout * sizeof(Entry));
+    if (children)
+        hostMem.sub(Fanout * sizeof(std::unique_ptr<Node>));
+}
+
+EmulationPageTable::Entry &
+EmulationPageTable::Node::entry(unsigned idx)
+{
+    if (!entries) {
+        entries.reset(new Entry[Fanout]);
+        hostMem.add(Fanout * sizeof(Entry));
+    }
+    return entries[idx];
+}
+
+thread_local EmulationPageTable::LookupCache
+    EmulationPageTable::lookupCache;
+
+EmulationPageTable::~EmulationPageTable() {}
+
+EmulationPageTable::Node &
+EmulationPageTable::splitSlot(Node &node, unsigned idx)
+{
+    assert(node.level > 0 && node.mapped[idx] && !node.children[idx]);
+    const Entry whole = node.entries[idx];
+    auto *child = new Node(node.level - 1, hostMem);
+    const Addr span = Addr(1) << (child->level * LevelBits);
+    for (unsigned i = 0; i < Fanout; i++) {
+        child->entry(i) = Entry(whole.paddr + ((i * span) << pageShift),
+                whole.flags);
+    }
+    child->mapped.set();
+    child->used = Fanout;
+
+    node.mapped.reset(idx);
+    node.children[idx].reset(child);
+    return *child;
+}
+
+EmulationPageTable::Node &
+EmulationPageTable::childOf(Node &node, unsigned idx)
+{
+    assert(node.level > 0);
+    if (node.mapped[idx])
+        return splitSlot(node, idx);
+    if (!node.children[idx]) {
+        node.children[idx].reset(new Node(node.level - 1, hostMem));
+        node.used++;
+    }
+    return *node.children[idx];
+}
+
+void
+EmulationPageTable::mapPages(Node &node, Addr vpn, Addr pages, Addr paddr,
+        uint64_t flags)
+{
+    const bool clobber = flags & Clobber;
+    const Addr span = Addr(1) << (node.level * LevelBits);
+    while (pages > 0) {
+        const unsigned idx = slotOf(node, vpn);
+        const Addr count = std::min(pages, span - (vpn & (span - 1)));
+        if (count == span && (node.level == 0 || !node.children[idx])) {
+            if (node.mapped[idx]) {
+                panic_if(!clobber,
+                         "EmulationPageTable::allocate: addr %#x already "
+                         "mapped", vpn << pageShift);
+            } else {
+                node.mapped.set(idx);
+                node.used++;
+                numPages += span;
+            }
+            node.entry(idx) = Entry(paddr, flags);
+        } else {
+            mapPages(childOf(node, idx), vpn, count, paddr, flags);
+        }
+        vpn += count;
+        pages -= count;
+        paddr += count << pageShift;
+    }
+}
+
+void
+EmulationPageTable::unmapPages(Node &node, Addr vpn, Addr pages)
+{
+    const Addr span = Addr(1) << (node.level * LevelBits);
+    while (pages > 0) {
+        const unsigned idx = slotOf(node, vpn);
+        const Addr count = std::min(pages, span - (vpn & (span - 1)));
+        if (count == span && node.mapped[idx]) {
+            node.mapped.reset(idx);
+            node.used--;
+            numPages -= span;
+        } else {
+            assert(node.level > 0 &&
+                   (node.mapped[idx] || node.children[idx]));
+            Node &child = childOf(node, idx);
+            unmapPages(child, vpn, count);
+            if (child.used == 0) {
+                node.children[idx].reset();
+                node.used--;
+            }
+        }
+        vpn += count;
+        pages -= count;
+    }
+}
+
+bool
+EmulationPageTable::anyMapped(const Node &node, Addr vpn, Addr pages) const
+{
+    const Addr span = Addr(1) << (node.level * LevelBits);
+    while (pages > 0) {
+        const unsigned idx = slotOf(node, vpn);
+        const Addr count = std::min(pages, span - (vpn & (span - 1)));
+        if (node.mapped[idx])
+            return true;
+        if (node.level > 0 && node.children[idx] &&
+                anyMapped(*node.children[idx], vpn, count)) {
+            return true;
+        }
+        vpn += count;
+        pages -= count;
+    }
+    return false;
+}
+
+template <class F>
+void
+EmulationPageTable::forEachPage(const Node &node, Addr vpn, F &&f) const
+{
+    const unsigned shift = node.level * LevelBits;
+    for (unsigned idx = 0; idx < Fanout; idx++) {
+        const Addr first = vpn | (Addr(idx) << shift);
+        if (node.mapped[idx]) {
+            const Entry &whole = node.entries[idx];
+            for (Addr i = 0; i < (Addr(1) << shift); i++) {
+                f((first + i) << pageShift,
+                  Entry(whole.paddr + (i << pageShift), whole.flags));
+            }
+        } else if (node.level > 0 && node.children[idx]) {
+            forEachPage(*node.children[idx], first, f);
+        }
+    }
+}
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
-    bool clobber = flags & Clobber;
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
-    while (size > 0) {
-        auto it = pTable.find(vaddr);
-        if (it != pTable.end()) {
-            // already mapped
-            panic_if(!clobber,
-                     "EmulationPageTable::allocate: addr %#x already mapped",
-                     vaddr);
-            it->second = Entry(paddr, flags);
-        } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
-        }
+    std::lock_guard<std::recursive_mutex> guard(mutex);
+    updateGeneration();
 
-        size -= _pageSize;
-        vaddr += _pageSize;
-        paddr += _pageSize;
+    if (size > 0) {
+        mapPages(*root, vaddr >> pageShift, divCeil(size, _pageSize),
+                 paddr, flags);
     }
 }
 
@@ -80,13 +233,17 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
     DPRINTF(MMU, "moving pages from vaddr %08p to %08p, size = %d\n", vaddr,
             new_vaddr, size);
 
-    while (size > 0) {
-        [[maybe_unused]] auto new_it = pTable.find(new_vaddr);
-        auto old_it = pTable.find(vaddr);
-        assert(old_it != pTable.end() && new_it == pTable.end());
+    std::lock_guard<std::recursive_mutex> guard(mutex);
 
-        pTable.emplace(new_vaddr, old_it->second);
-        pTable.erase(old_it);
+    while (size > 0) {
+        const Entry *old_entry = lookup(vaddr);
+        assert(old_entry && !lookup(new_vaddr));
+        const Entry moved = *old_entry;
+
+        mapPages(*root, new_vaddr >> pageShift, 1, moved.paddr, moved.flags);
+        unmapPages(*root, vaddr >> pageShift, 1);
+        // The node the lookups remember may be gone.
+        updateGeneration();
         size -= _pageSize;
         vaddr += _pageSize;
         new_vaddr += _pageSize;
@@ -96,8 +253,10 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
-    for (auto &iter : pTable)
-        addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    std::lock_guard<std::recursive_mutex> guard(mutex);
+    forEachPage(*root, 0, [addr_maps](Addr vaddr, const Entry &entry) {
+        addr_maps->push_back(std::make_pair(vaddr, entry.paddr));
+    });
 }
 
 void
@@ -107,13 +266,11 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
-    while (size > 0) {
-        auto it = pTable.find(vaddr);
-        assert(it != pTable.end());
-        pTable.erase(it);
-        size -= _pageSize;
-        vaddr += _pageSize;
-    }
+    std::lock_guard<std::recursive_mutex> guard(mutex);
+    updateGeneration();
+
+    if (size > 0)
+        unmapPages(*root, vaddr >> pageShift, divCeil(size, _pageSize));
 }
 
 bool
@@ -122,21 +279,45 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
-    for (int64_t offset = 0; offset < size; offset += _pageSize)
-        if (pTable.find(vaddr + offset) != pTable.end())
-            return false;
-
-    return true;
+    if (size <= 0)
+        return true;
+    std::lock_guard<std::recursive_mutex> guard(mutex);
+    return !anyMapped(*root, vaddr >> pageShift, divCeil(size, _pageSize));
 }
 
 const EmulationPageTable::Entry *
 EmulationPageTable::lookup(Addr vaddr)
 {
-    Addr page_addr = pageAlign(vaddr);
-    PTableItr iter = pTable.find(page_addr);
-    if (iter == pTable.end())
-        return nullptr;
-    return &(iter->second);
+    const Addr vpn = vaddr >> pageShift;
+    LookupCache &cache = lookupCache;
+
+    std::lock_guard<std::recursive_mutex> guard(mutex);
+    if (cache.generation == _generation && cache.leaf &&
+            (vpn & ~Addr(Fanout - 1)) == cache.leafVpn) {
+        const unsigned idx = vpn & (Fanout - 1);
+        return cache.leaf->mapped[idx] ? &cache.leaf->entries[idx] : nullptr;
+    }
+
+    const Node *node = root.get();
+    while (true) {
+        const unsigned idx = slotOf(*node, vpn);
+        if (node->mapped[idx] && node->level > 0) {
+            const Entry &whole = node->entries[idx];
+            const Addr offset = vpn & mask(node->level * LevelBits);
+            cache.blockPage = Entry(whole.paddr + (offset << pageShift),
+                    whole.flags);
+            return &cache.blockPage;
+        }
+        if (node->level == 0) {
+            cache.generation = _generation;
+            cache.leaf = node;
+            cache.leafVpn = vpn & ~Addr(Fanout - 1);
+            return node->mapped[idx] ? &node->entries[idx] : nullptr;
+        }
+        node = node->children[slotOf(*node, vpn)].get();
+        if (!node)
+            return nullptr;
+    }
 }
 
 bool
@@ -185,18 +366,19 @@ EmulationPageTable::PageTableTranslationGen::translate(Range &range) const
 void
 EmulationPageTable::serialize(CheckpointOut &cp) const
 {
+    std::lock_guard<std::recursive_mutex> guard(mutex);
     ScopedCheckpointSection sec(cp, "ptable");
-    paramOut(cp, "size", pTable.size());
+    paramOut(cp, "size", numPages);
 
-    PTable::size_type count = 0;
-    for (auto &pte : pTable) {
+    uint64_t count = 0;
+    forEachPage(*root, 0, [&cp, &count](Addr vaddr, const Entry &entry) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
 
-        paramOut(cp, "vaddr", pte.first);
-        paramOut(cp, "paddr", pte.second.paddr);
-        paramOut(cp, "flags", pte.second.flags);
-    }
-    assert(count == pTable.size());
+        paramOut(cp, "vaddr", vaddr);
+        paramOut(cp, "paddr", entry.paddr);
+        paramOut(cp, "flags", entry.flags);
+    });
+    assert(count == numPages);
 }
 
 void
@@ -204,7 +386,9 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
 {
     int count;
     ScopedCheckpointSection sec(cp, "ptable");
+    std::lock_guard<std::recursive_mutex> guard(mutex);
     paramIn(cp, "size", count);
+    updateGeneration();
 
     for (int i = 0; i < count; ++i) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", i));
@@ -216,17 +400,21 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
 
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        // Keep a page which is already mapped, as the map the entries
+        // used to be kept in did.
+        if (!lookup(vaddr))
+            mapPages(*root, vaddr >> pageShift, 1, paddr, flags);
     }
 }
 
 const std::string
 EmulationPageTable::externalize() const
 {
+    std::lock_guard<std::recursive_mutex> guard(mutex);
     std::stringstream ss;
-    for (PTable::const_iterator it=pTable.begin(); it != pTable.end(); ++it) {
-        ss << std::hex << it->first << ":" << it->second.paddr << ";";
-    }
+    forEachPage(*root, 0, [&ss](Addr vaddr, const Entry &entry) {
+        ss << std::hex << vaddr << ":" << entry.paddr << ";";
+    });
     return ss.str();
 }
 
@@ -35,14 +35,17 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <bitset>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
 
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base/types.hh"
 #include "mem/request.hh"
 #include "mem/translation_gen.hh"
+#include "sim/host_mem.hh"
 #include "sim/serialize.hh"
 
 namespace gem5
@@ -63,29 +66,120 @@ class EmulationPageTable : public Serializable
     };
 
   protected:
-    typedef std::unordered_map<Addr, Entry> PTable;
-    typedef PTable::iterator PTableItr;
-    PTable pTable;
+    /**
+     * The mappings are kept in a radix tree indexed by the virtual page
+     * number, LevelBits of it at each level. A slot of a lowest level
+     * node holds the entry of a page. A slot of a higher level node
+     * points to a node of the level below or, when all the pages under
+     * it were mapped together, holds a single entry for all of them, the
+     * way a huge page would be mapped.
+     */
+    static constexpr unsigned LevelBits = 9;
+    static constexpr unsigned Fanout = 1 << LevelBits;
+
+    struct Node
+    {
+        const unsigned level;
+        /** Number of slots which hold an entry or point to a node */
+        unsigned used = 0;
+        std::bitset<Fanout> mapped;
+        /** Entries, which higher level nodes only allocate when needed */
+        std::unique_ptr<Entry[]> entries;
+        std::unique_ptr<std::unique_ptr<Node>[]> children;
+        /** The account of the table, which the node is charged to */
+        host_mem::Account &hostMem;
+
+        Node(unsigned _level, host_mem::Account &host_mem);
+        ~Node();
+        Entry &entry(unsigned idx);
+    };
 
     const Addr _pageSize;
     const Addr offsetMask;
+    const unsigned pageShift;
+    /** Number of levels needed to index every virtual page */
+    const unsigned numLevels;
+
+    host_mem::Account hostMem;
+    std::unique_ptr<Node> root;
+    /** Number of mapped pages */
+    uint64_t numPages = 0;
+
+    /**
+     * The threads of a process may be simulated by several event queues
+     * at once, so the accesses to the table hold this lock.
+     */
+    mutable std::recursive_mutex mutex;
+
+    /**
+     * What lookup() remembers between calls, kept for each simulator
+     * thread. It is only valid for the table with the same generation.
+     */
+    struct LookupCache
+    {
+        uint64_t generation = 0;
+        /** The lowest level node of the last lookup and its first page */
+        const Node *leaf = nullptr;
+        Addr leafVpn = 0;
+        /** What lookup() returns for a page of a range mapped as a whole */
+        Entry blockPage;
+    };
+    static thread_local LookupCache lookupCache;
+
+    static unsigned
+    slotOf(const Node &node, Addr vpn)
+    {
+        return (vpn >> (node.level * LevelBits)) & (Fanout - 1);
+    }
+
+    void mapPages(Node &node, Addr vpn, Addr pages, Addr paddr,
+            uint64_t flags);
+    void unmapPages(Node &node, Addr vpn, Addr pages);
+    bool anyMapped(const Node &node, Addr vpn, Addr pages) const;
+    /** Replace the entry of a slot which maps a range by a node */
+    Node &splitSlot(Node &node, unsigned idx);
+    Node &childOf(Node &node, unsigned idx);
+
+    /** Call f(vaddr, entry) for every mapped page */
+    template <class F>
+    void forEachPage(const Node &node, Addr vpn, F &&f) const;
 
     const uint64_t _pid;
     const std::string _name;
 
+    /**
+     * Changes every time a mapping is added, moved or removed. Values
+     * are unique across all page tables so a generation also identifies
+     * the table it was read from.
+     */
+    uint64_t _generation;
+
+    /** Give the table a new generation after changing its mappings */
+    void
+    updateGeneration()
+    {
+        static uint64_t last_generation = 0;
+        _generation = ++last_generation;
+    }
+
   public:
 
     EmulationPageTable(
             const std::string &__name, uint64_t _pid, Addr _pageSize) :
             _pageSize(_pageSize), offsetMask(mask(floorLog2(_pageSize))),
+            pageShift(floorLog2(_pageSize)),
+            numLevels(divCeil(sizeof(Addr) * 8 - pageShift, LevelBits)),
+            hostMem(__name + ".pageTable"),
+            root(new Node(numLevels - 1, hostMem)),
             _pid(_pid), _name(__name), shared(false)
     {
         assert(isPowerOf2(_pageSize));
+        updateGeneration();
     }
 
     uint64_t pid() const { return _pid; };
 
-    virtual ~EmulationPageTable() {};
+    virtual ~EmulationPageTable();
 
     /* generic page table mapping flags
      *              unset | set
@@ -115,7 +209,15 @@ class EmulationPageTable : public Serializable
     Addr pageSize()   { return _pageSize; }
 
     /**
-     * Maps a virtual memory region to a physical memory region.
+     * A translation read from the table is still valid while the table
+     * has the same generation.
+     */
+    uint64_t generation() const { return _generation; }
+
+    /**
+     * Maps a virtual memory region to a physical memory region. The
+     * pages of a large region are mapped in bulk, whole aligned ranges
+     * of them with a single entry.
      * @param vaddr The starting virtual address of the region.
      * @param paddr The starting physical address where the region is mapped.
      * @param size The length of the region.
@@ -137,7 +239,9 @@ class EmulationPageTable : public Serializable
     /**
      * Lookup function
      * @param vaddr The virtual address.
-     * @return The page table entry corresponding to vaddr.
+     * @return The page table entry corresponding to vaddr. It may only
+     *         be valid until the next lookup by the same thread or the
+     *         next change of the table.
      */
     const Entry *lookup(Addr vaddr);
 
@@ -39,17 +39,27 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <set>
 #include <string>
 
+#include "base/chunked_image.hh"
 #include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
@@ -76,14 +86,34 @@ namespace gem5
 namespace memory
 {
 
+namespace
+{
+
+/** Size of the host huge pages used with MAP_HUGETLB */
+const uint64_t HugePageSize = 2 * 1024 * 1024;
+
+#if defined(__linux__) && defined(SYS_mbind)
+/** Memory policies of mbind(), from linux/mempolicy.h */
+const int MPOL_BIND_ = 2;
+const int MPOL_INTERLEAVE_ = 3;
+#endif
+
+} // anonymous namespace
+
 PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               MemoryCheckpointFormat checkpoint_format,
+                               unsigned checkpoint_threads,
+                               bool incremental_checkpoints,
+                               HugePageMode huge_pages) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), checkpointFormat(checkpoint_format),
+    checkpointThreads(checkpoint_threads),
+    incrementalCheckpoints(incremental_checkpoints), hugePages(huge_pages)
 {
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
@@ -93,6 +123,9 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
 
+    fatal_if(hugePages == HugePageMode::hugetlb && !sharedBackstore.empty(),
+             "Huge TLB pages cannot be used with a shared backstore\n");
+
     // add the memories from the system to the address map as
     // appropriate
     for (const auto& m : _memories) {
@@ -131,6 +164,9 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
         }
     }
 
+    // the memories are fixed from here on
+    addrMap.freeze();
+
     // iterate over the increasing addresses and chunks of contiguous
     // space to be mapped to backing store, create it and inform the
     // memories
@@ -238,30 +274,100 @@ PhysicalMemory::createBackingStore(
         map_flags |= MAP_NORESERVE;
     }
 
+    if (hugePages == HugePageMode::hugetlb) {
+#ifdef MAP_HUGETLB
+        fatal_if(range.size() % HugePageSize,
+                 "Range %s must be a multiple of %d bytes to use huge TLB "
+                 "pages\n", range.to_string(), HugePageSize);
+        map_flags |= MAP_HUGETLB;
+#else
+        fatal("Huge TLB pages are not supported on this host\n");
+#endif
+    }
+
     uint8_t* pmem = (uint8_t*) mmap(NULL, range.size(),
                                     PROT_READ | PROT_WRITE,
                                     map_flags, shm_fd, map_offset);
 
     if (pmem == (uint8_t*) MAP_FAILED) {
         perror("mmap");
-        fatal("Could not mmap %d bytes for range %s!\n", range.size(),
-              range.to_string());
+        fatal("Could not mmap %d bytes for range %s!%s\n", range.size(),
+              range.to_string(), hugePages == HugePageMode::hugetlb ?
+              " Check that enough huge pages are reserved on the host." :
+              "");
     }
 
+    // the memories of an interleaved range may be bound to different
+    // nodes, in which case the pages are interleaved across them
+    std::set<int> node_set;
+    for (const auto& m : _memories) {
+        if (m->getHostNumaNode() >= 0)
+            node_set.insert(m->getHostNumaNode());
+    }
+    std::vector<int> nodes(node_set.begin(), node_set.end());
+    placeBackingStore(pmem, range.size(), nodes);
+
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
                               conf_table_reported, in_addr_map, kvm_map,
                               shm_fd, map_offset);
+    backingStore.back().hostNumaNodes = nodes;
+
+    if (incrementalCheckpoints) {
+        dirtyLogs.emplace_back();
+        dirtyLogs.back().pages.assign(divCeil(range.size(), pageSize), 0);
+    }
 
     // point the memories to their backing store
     for (const auto& m : _memories) {
         DPRINTF(AddrRanges, "Mapping memory %s to backing store\n",
                 m->name());
         m->setBackingStore(pmem);
+        if (incrementalCheckpoints)
+            m->trackDirtyPages(this);
     }
 }
 
+void
+PhysicalMemory::placeBackingStore(uint8_t *pmem, uint64_t size,
+                                  const std::vector<int> &nodes) const
+{
+    if (hugePages == HugePageMode::transparent) {
+#ifdef MADV_HUGEPAGE
+        if (madvise(pmem, size, MADV_HUGEPAGE) != 0)
+            warn("Could not use transparent huge pages for %s: %s\n",
+                 name(), std::strerror(errno));
+#else
+        warn_once("Transparent huge pages are not supported on this "
+                  "host\n");
+#endif
+    }
+
+    if (nodes.empty())
+        return;
+
+#if defined(__linux__) && defined(SYS_mbind)
+    const unsigned long bits = sizeof(unsigned long) * CHAR_BIT;
+    std::vector<unsigned long> mask(nodes.back() / bits + 1, 0);
+    for (int node : nodes)
+        mask[node / bits] |= 1UL << (node % bits);
+    const int mode = nodes.size() == 1 ? MPOL_BIND_ : MPOL_INTERLEAVE_;
+    // the kernel ignores the last bit of the mask
+    if (syscall(SYS_mbind, pmem, size, mode, mask.data(),
+                mask.size() * bits + 1, 0) != 0) {
+        std::string node_list;
+        for (int node : nodes)
+            node_list += csprintf("%s%d", node_list.empty() ? "" : ",", node);
+        fatal("Could not bind the backing store of %s to host NUMA "
+              "node(s) %s: %s\n", name(), node_list, std::strerror(errno));
+    }
+#else
+    fatal("NUMA binding of the backing store is not supported on this "
+          "host\n");
+#endif
+}
+
 PhysicalMemory::~PhysicalMemory()
 {
     // unmap the backing store
@@ -329,6 +435,44 @@ PhysicalMemory::functionalAccess(PacketPtr pkt)
     m->second->functionalAccess(pkt);
 }
 
+void
+PhysicalMemory::markDirty(const uint8_t *host_addr, uint64_t len)
+{
+    if (!incrementalCheckpoints || !len)
+        return;
+
+    for (size_t i = 0; i < backingStore.size(); ++i) {
+        const BackingStoreEntry &s = backingStore[i];
+        if (host_addr < s.pmem || host_addr >= s.pmem + s.range.size())
+            continue;
+
+        const uint64_t offset = host_addr - s.pmem;
+        const uint64_t first = offset / pageSize;
+        const uint64_t last = (offset + len - 1) / pageSize;
+        std::fill(dirtyLogs[i].pages.begin() + first,
+                  dirtyLogs[i].pages.begin() + last + 1, 1);
+        return;
+    }
+}
+
+void
+PhysicalMemory::markUntracked(const uint8_t *host_addr)
+{
+    if (!incrementalCheckpoints)
+        return;
+
+    for (size_t i = 0; i < backingStore.size(); ++i) {
+        const BackingStoreEntry &s = backingStore[i];
+        if (host_addr >= s.pmem && host_addr < s.pmem + s.range.size()) {
+            if (!dirtyLogs[i].untracked) {
+                warn("Writes to %s are not tracked, checkpoints will "
+                     "contain all of it\n", s.range.to_string());
+            }
+            dirtyLogs[i].untracked = true;
+        }
+    }
+}
+
 void
 PhysicalMemory::serialize(CheckpointOut &cp) const
 {
@@ -347,6 +491,10 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
     SERIALIZE_CONTAINER(lal_addr);
     SERIALIZE_CONTAINER(lal_cid);
 
+    // get the pages written behind the back of the memories
+    for (const auto &source : dirtyPageSources)
+        source();
+
     // serialize the backing stores
     unsigned int nbr_of_stores = backingStore.size();
     SERIALIZE_SCALAR(nbr_of_stores);
@@ -363,10 +511,17 @@ void
 PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
                                AddrRange range, uint8_t* pmem) const
 {
+    // only write the pages written since the previous image of the
+    // store if they are all known
+    const bool delta = incrementalCheckpoints &&
+        !dirtyLogs[store_id].untracked && !dirtyLogs[store_id].image.empty();
+    std::string format = delta ? "delta" : MemoryCheckpointFormatStrings[
+        static_cast<int>(checkpointFormat)];
+
     // we cannot use the address range for the name as the
     // memories that are not part of the address map can overlap
-    std::string filename =
-        name() + ".store" + std::to_string(store_id) + ".pmem";
+    std::string filename = name() + ".store" + std::to_string(store_id) +
+        (format == "gzip" ? ".pmem" : "." + format);
     long range_size = range.size();
 
     DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
@@ -374,36 +529,271 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 
     SERIALIZE_SCALAR(store_id);
     SERIALIZE_SCALAR(filename);
+    SERIALIZE_SCALAR(format);
     SERIALIZE_SCALAR(range_size);
 
     // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
-    gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'\n",
-              filename);
+    if (delta) {
+        serializeDeltaStore(filepath, store_id);
+    } else if (checkpointFormat == MemoryCheckpointFormat::chunked) {
+        const std::vector<uint8_t> touched = touchedPages(store_id);
+        chunked_image::write(filepath, pmem, range.size(),
+                             chunked_image::DefaultChunkSize,
+                             checkpointThreads,
+                             [&](uint64_t offset, uint64_t len) {
+                                 auto first = touched.begin() +
+                                     offset / pageSize;
+                                 auto last = touched.begin() +
+                                     divCeil(offset + len, pageSize);
+                                 return std::find(first, last, 1) != last;
+                             });
+    } else if (checkpointFormat == MemoryCheckpointFormat::raw) {
+        serializeRawStore(filepath, range, pmem, touchedPages(store_id));
+    } else {
+        gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
+        if (compressed_mem == NULL)
+            fatal("Can't open physical memory checkpoint file '%s'\n",
+                  filename);
 
-    uint64_t pass_size = 0;
+        uint64_t pass_size = 0;
 
-    // gzwrite fails if (int)len < 0 (gzwrite returns int)
-    for (uint64_t written = 0; written < range.size();
-         written += pass_size) {
-        pass_size = (uint64_t)INT_MAX < (range.size() - written) ?
-            (uint64_t)INT_MAX : (range.size() - written);
+        // gzwrite fails if (int)len < 0 (gzwrite returns int)
+        for (uint64_t written = 0; written < range.size();
+             written += pass_size) {
+            pass_size = (uint64_t)INT_MAX < (range.size() - written) ?
+                (uint64_t)INT_MAX : (range.size() - written);
 
-        if (gzwrite(compressed_mem, pmem + written,
-                    (unsigned int) pass_size) != (int) pass_size) {
-            fatal("Write failed on physical memory checkpoint file '%s'\n",
-                  filename);
+            if (gzwrite(compressed_mem, pmem + written,
+                        (unsigned int) pass_size) != (int) pass_size) {
+                fatal("Write failed on physical memory checkpoint file "
+                      "'%s'\n", filename);
+            }
         }
+
+        // close the compressed stream and check that the exit status
+        // is zero
+        if (gzclose(compressed_mem))
+            fatal("Close failed on physical memory checkpoint file '%s'\n",
+                  filename);
     }
 
-    // close the compressed stream and check that the exit status
-    // is zero
-    if (gzclose(compressed_mem))
+    // the next checkpoint of the store is layered on this one
+    if (incrementalCheckpoints) {
+        DirtyLog &log = dirtyLogs[store_id];
+        log.image = filepath;
+        log.imageFormat = format;
+        std::fill(log.pages.begin(), log.pages.end(), 0);
+    }
+}
+
+namespace
+{
+
+/**
+ * Header of a delta image. It is followed by the path of the image it
+ * is layered on, relative to the directory of the delta image unless
+ * it is absolute, the format of that image, the indices of the pages
+ * in the delta image, and the pages themselves.
+ */
+struct DeltaImageHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t pageSize;
+    uint64_t storeSize;
+    uint64_t numPages;
+    uint32_t baseLen;
+    uint32_t baseFormatLen;
+};
+
+constexpr char deltaImageMagic[8] = "G5DELTA";
+constexpr uint32_t deltaImageVersion = 1;
+
+void
+writeAll(std::FILE *f, const void *data, size_t len,
+         const std::string &filepath)
+{
+    if (len && std::fwrite(data, len, 1, f) != 1)
+        fatal("Write failed on physical memory checkpoint file '%s'\n",
+              filepath);
+}
+
+void
+readAll(std::FILE *f, void *data, size_t len, const std::string &filepath)
+{
+    if (len && std::fread(data, len, 1, f) != 1)
+        fatal("Read failed on physical memory checkpoint file '%s'\n",
+              filepath);
+}
+
+} // anonymous namespace
+
+void
+PhysicalMemory::serializeDeltaStore(const std::string &filepath,
+                                    unsigned int store_id) const
+{
+    const DirtyLog &log = dirtyLogs[store_id];
+    const uint8_t *pmem = backingStore[store_id].pmem;
+    const uint64_t size = backingStore[store_id].range.size();
+
+    std::vector<uint64_t> pages;
+    for (uint64_t i = 0; i < log.pages.size(); ++i) {
+        if (log.pages[i])
+            pages.push_back(i);
+    }
+
+    // refer to the base image relative to the delta so that the
+    // checkpoints can be moved together
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::path(filepath).parent_path();
+    const std::string base = fs::proximate(log.image, dir).string();
+
+    DPRINTF(Checkpoint, "Writing %d of %d pages to delta image %s on top "
+            "of %s\n", pages.size(), log.pages.size(), filepath, base);
+
+    std::FILE *f = std::fopen(filepath.c_str(), "wb");
+    if (!f)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filepath);
+
+    DeltaImageHeader header;
+    std::memcpy(header.magic, deltaImageMagic, sizeof(header.magic));
+    header.version = deltaImageVersion;
+    header.pageSize = pageSize;
+    header.storeSize = size;
+    header.numPages = pages.size();
+    header.baseLen = base.size();
+    header.baseFormatLen = log.imageFormat.size();
+
+    writeAll(f, &header, sizeof(header), filepath);
+    writeAll(f, base.data(), base.size(), filepath);
+    writeAll(f, log.imageFormat.data(), log.imageFormat.size(), filepath);
+    writeAll(f, pages.data(), pages.size() * sizeof(uint64_t), filepath);
+    for (uint64_t page : pages) {
+        const uint64_t offset = page * pageSize;
+        writeAll(f, pmem + offset,
+                 std::min<uint64_t>(pageSize, size - offset), filepath);
+    }
+
+    if (std::fclose(f) != 0)
         fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+              filepath);
+}
+
+std::vector<uint8_t>
+PhysicalMemory::touchedPages(unsigned int store_id) const
+{
+    const BackingStoreEntry &store = backingStore[store_id];
+    const uint64_t size = store.range.size();
+    std::vector<uint8_t> touched(divCeil(size, pageSize), 1);
+
+#if defined(__linux__)
+    if (store.imageMapped)
+        return touched;
+
+    if (store.shmFd != -1) {
+        // pages of a shared memory file that were never written are
+        // holes in the file
+        std::fill(touched.begin(), touched.end(), 0);
+        const off_t end = store.shmOffset + size;
+        off_t data = lseek(store.shmFd, store.shmOffset, SEEK_DATA);
+        while (data >= 0 && data < end) {
+            off_t hole = lseek(store.shmFd, data, SEEK_HOLE);
+            if (hole < 0 || hole > end)
+                hole = end;
+            std::fill(touched.begin() + (data - store.shmOffset) / pageSize,
+                      touched.begin() +
+                      divCeil(hole - store.shmOffset, pageSize), 1);
+            data = lseek(store.shmFd, hole, SEEK_DATA);
+        }
+        if (data < 0 && errno != ENXIO)
+            std::fill(touched.begin(), touched.end(), 1);
+        return touched;
+    }
 
+    // anonymous pages that were never touched are neither present nor
+    // swapped out, as told by the page map of the process
+    int fd = open("/proc/self/pagemap", O_RDONLY);
+    if (fd < 0)
+        return touched;
+
+    const uint64_t present = 1ULL << 63;
+    const uint64_t swapped = 1ULL << 62;
+    const uint64_t first = (uintptr_t)store.pmem / pageSize;
+    std::vector<uint64_t> entries(4096);
+    for (uint64_t page = 0; page < touched.size(); ) {
+        const uint64_t count = std::min<uint64_t>(entries.size(),
+                                                  touched.size() - page);
+        ssize_t ret = pread(fd, entries.data(), count * sizeof(uint64_t),
+                            (first + page) * sizeof(uint64_t));
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0 || ret % sizeof(uint64_t)) {
+            std::fill(touched.begin(), touched.end(), 1);
+            break;
+        }
+        for (uint64_t i = 0; i < ret / sizeof(uint64_t); ++i, ++page)
+            touched[page] = (entries[i] & (present | swapped)) != 0;
+    }
+    close(fd);
+#endif
+
+    return touched;
+}
+
+void
+PhysicalMemory::serializeRawStore(const std::string &filepath,
+                                  AddrRange range, const uint8_t *pmem,
+                                  const std::vector<uint8_t> &touched) const
+{
+    int fd = open(filepath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filepath);
+
+    // size the file up front and only write the pages that are not
+    // zero, which leaves holes in the file for untouched memory
+    const uint64_t size = range.size();
+    if (ftruncate(fd, size) != 0)
+        fatal("Can't size physical memory checkpoint file '%s'\n",
+              filepath);
+
+    auto zero_page = [&](uint64_t offset) {
+        if (!touched[offset / pageSize])
+            return true;
+        const uint64_t len = std::min<uint64_t>(pageSize, size - offset);
+        return pmem[offset] == 0 &&
+            memcmp(pmem + offset, pmem + offset + 1, len - 1) == 0;
+    };
+
+    uint64_t offset = 0;
+    while (offset < size) {
+        if (zero_page(offset)) {
+            offset += pageSize;
+            continue;
+        }
+
+        // coalesce consecutive non-zero pages into a single write
+        uint64_t end = offset + pageSize;
+        while (end < size && !zero_page(end))
+            end += pageSize;
+        end = std::min(end, size);
+
+        while (offset < end) {
+            ssize_t ret = pwrite(fd, pmem + offset, end - offset, offset);
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0)
+                fatal("Write failed on physical memory checkpoint file "
+                      "'%s'\n", filepath);
+            offset += ret;
+        }
+    }
+
+    if (close(fd) != 0)
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              filepath);
 }
 
 void
@@ -434,8 +824,6 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
 void
 PhysicalMemory::unserializeStore(CheckpointIn &cp)
 {
-    const uint32_t chunk_size = 16384;
-
     unsigned int store_id;
     UNSERIALIZE_SCALAR(store_id);
 
@@ -443,13 +831,10 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
-
+    // checkpoints without a format predate chunked images
+    std::string format = "gzip";
+    UNSERIALIZE_OPT_SCALAR(format);
     // we've already got the actual backing store mapped
-    uint8_t* pmem = backingStore[store_id].pmem;
     AddrRange range = backingStore[store_id].range;
 
     long range_size;
@@ -462,6 +847,53 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    restoreStore(filepath, format, store_id);
+
+    // the next checkpoint of the store is layered on this one
+    if (incrementalCheckpoints) {
+        DirtyLog &log = dirtyLogs[store_id];
+        log.image = filepath;
+        log.imageFormat = format;
+        std::fill(log.pages.begin(), log.pages.end(), 0);
+    }
+}
+
+void
+PhysicalMemory::restoreStore(const std::string &filepath,
+                             const std::string &format, unsigned int store_id)
+{
+    const uint32_t chunk_size = 16384;
+
+    fatal_if(format != "gzip" && format != "chunked" && format != "raw" &&
+             format != "delta",
+             "Unknown format '%s' of physical memory checkpoint file '%s'\n",
+             format, filepath);
+
+    uint8_t* pmem = backingStore[store_id].pmem;
+    AddrRange range = backingStore[store_id].range;
+
+    if (format == "chunked") {
+        chunked_image::read(filepath, pmem, range.size(), checkpointThreads);
+        return;
+    }
+
+    if (format == "raw") {
+        unserializeRawStore(filepath, backingStore[store_id]);
+        backingStore[store_id].imageMapped =
+            backingStore[store_id].shmFd == -1;
+        return;
+    }
+
+    if (format == "delta") {
+        unserializeDeltaStore(filepath, store_id);
+        return;
+    }
+
+    // mmap memoryfile
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filepath);
+
     uint64_t curr_size = 0;
     long* temp_page = new long[chunk_size];
     long* pmem_current;
@@ -488,7 +920,110 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
 
     if (gzclose(compressed_mem))
         fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+              filepath);
+}
+
+void
+PhysicalMemory::unserializeDeltaStore(const std::string &filepath,
+                                      unsigned int store_id)
+{
+    uint8_t *pmem = backingStore[store_id].pmem;
+    const uint64_t size = backingStore[store_id].range.size();
+
+    std::FILE *f = std::fopen(filepath.c_str(), "rb");
+    if (!f)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filepath);
+
+    DeltaImageHeader header;
+    readAll(f, &header, sizeof(header), filepath);
+    if (std::memcmp(header.magic, deltaImageMagic, sizeof(header.magic)) ||
+            header.version != deltaImageVersion || !header.pageSize) {
+        fatal("Physical memory checkpoint file '%s' is not a delta image\n",
+              filepath);
+    }
+    if (header.storeSize != size) {
+        fatal("Physical memory checkpoint file '%s' does not match the "
+              "size of its store (%lld bytes)\n", filepath, size);
+    }
+
+    std::string base(header.baseLen, '\0');
+    std::string base_format(header.baseFormatLen, '\0');
+    readAll(f, base.data(), base.size(), filepath);
+    readAll(f, base_format.data(), base_format.size(), filepath);
+    std::vector<uint64_t> pages(header.numPages);
+    readAll(f, pages.data(), pages.size() * sizeof(uint64_t), filepath);
+
+    // restore the image the delta is layered on first
+    namespace fs = std::filesystem;
+    const fs::path base_path =
+        fs::path(filepath).parent_path() / fs::path(base);
+    DPRINTF(Checkpoint, "Restoring %d pages from delta image %s on top "
+            "of %s\n", pages.size(), filepath, base_path.string());
+    restoreStore(base_path.string(), base_format, store_id);
+
+    for (uint64_t page : pages) {
+        const uint64_t offset = page * header.pageSize;
+        fatal_if(offset >= size, "Page %d out of range in physical memory "
+                 "checkpoint file '%s'\n", page, filepath);
+        readAll(f, pmem + offset,
+                std::min<uint64_t>(header.pageSize, size - offset), filepath);
+    }
+
+    std::fclose(f);
+}
+
+void
+PhysicalMemory::unserializeRawStore(const std::string &filepath,
+                                    const BackingStoreEntry &store)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filepath);
+
+    const uint64_t size = store.range.size();
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size != size)
+        fatal("Physical memory checkpoint file '%s' does not match the "
+              "size of its store (%lld bytes)\n", filepath, size);
+
+    if (store.shmFd == -1) {
+        // replace the anonymous backing store with a private mapping
+        // of the image, at the same address so that the memories keep
+        // their pointers. Pages are read in when first touched and
+        // stay shared with all other processes using the image until
+        // they are written.
+        int map_flags = MAP_PRIVATE | MAP_FIXED;
+        if (mmapUsingNoReserve)
+            map_flags |= MAP_NORESERVE;
+        void *pmem = mmap(store.pmem, size, PROT_READ | PROT_WRITE,
+                          map_flags, fd, 0);
+        if (pmem == MAP_FAILED) {
+            perror("mmap");
+            fatal("Could not mmap physical memory checkpoint file '%s'\n",
+                  filepath);
+        }
+        assert(pmem == store.pmem);
+        placeBackingStore(store.pmem, size, store.hostNumaNodes);
+    } else {
+        // a shared backing store must hold the data itself
+        warn_once("Copying memory image '%s' into shared backing store "
+                  "instead of mapping it\n", filepath);
+        uint64_t offset = 0;
+        while (offset < size) {
+            ssize_t ret = pread(fd, store.pmem + offset, size - offset,
+                                offset);
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0)
+                fatal("Read failed on physical memory checkpoint file "
+                      "'%s'\n", filepath);
+            offset += ret;
+        }
+    }
+
+    close(fd);
 }
 
 } // namespace memory
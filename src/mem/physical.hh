@@ -39,11 +39,14 @@
 #define __MEM_PHYSICAL_HH__
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "enums/HugePageMode.hh"
+#include "enums/MemoryCheckpointFormat.hh"
 #include "mem/packet.hh"
 #include "sim/serialize.hh"
 
@@ -115,6 +118,18 @@ class BackingStoreEntry
       * of this backing store in the share memory. Otherwise, the value is 0.
       */
      off_t shmOffset;
+
+     /**
+      * Host NUMA nodes the memory is allocated on, empty if it is not
+      * bound to any.
+      */
+     std::vector<int> hostNumaNodes;
+
+     /**
+      * Whether the memory is a private mapping of a checkpoint image,
+      * in which case pages that were never touched still hold data.
+      */
+     bool imageMapped = false;
 };
 
 /**
@@ -158,6 +173,37 @@ class PhysicalMemory : public Serializable
 
     long pageSize;
 
+    // Format of the backing store images written to checkpoints
+    const MemoryCheckpointFormat checkpointFormat;
+
+    // Host threads used for chunked images, 0 to use all of them
+    const unsigned checkpointThreads;
+
+    // Only write the pages written since the previous checkpoint
+    const bool incrementalCheckpoints;
+
+    // Whether the backing store uses host huge pages
+    const HugePageMode hugePages;
+
+    /**
+     * The pages of a backing store written since its image was last
+     * written to or restored from a checkpoint.
+     */
+    struct DirtyLog
+    {
+        /** One byte per page, set if the page may have been written */
+        std::vector<uint8_t> pages;
+        /** Set if the store may have been written without tracking */
+        bool untracked = false;
+        /** The last image of the store, and its format */
+        std::string image;
+        std::string imageFormat;
+    };
+    mutable std::vector<DirtyLog> dirtyLogs;
+
+    // Collect the pages written outside of gem5, e.g. by KVM
+    std::vector<std::function<void()>> dirtyPageSources;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
@@ -182,6 +228,17 @@ class PhysicalMemory : public Serializable
                             bool conf_table_reported,
                             bool in_addr_map, bool kvm_map);
 
+    /**
+     * Apply the huge page and NUMA placement policies to host memory
+     * backing a store.
+     *
+     * @param pmem The host memory
+     * @param size Size of the host memory in bytes
+     * @param nodes Host NUMA nodes to allocate the memory on, if any
+     */
+    void placeBackingStore(uint8_t *pmem, uint64_t size,
+                           const std::vector<int> &nodes) const;
+
   public:
 
     /**
@@ -191,7 +248,12 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   MemoryCheckpointFormat checkpoint_format=
+                       MemoryCheckpointFormat::chunked,
+                   unsigned checkpoint_threads=0,
+                   bool incremental_checkpoints=false,
+                   HugePageMode huge_pages=HugePageMode::none);
 
     /**
      * Unmap all the backing store we have used.
@@ -245,6 +307,46 @@ class PhysicalMemory : public Serializable
     std::vector<BackingStoreEntry> getBackingStore() const
     { return backingStore; }
 
+    /**
+     * Are the pages written to the backing store tracked, so that
+     * checkpoints only contain the pages written since the previous
+     * one?
+     */
+    bool tracksDirtyPages() const { return incrementalCheckpoints; }
+
+    /**
+     * Record a write to the backing store. This does nothing unless
+     * tracksDirtyPages().
+     *
+     * @param host_addr Host address written to
+     * @param len Number of bytes written
+     */
+    void markDirty(const uint8_t *host_addr, uint64_t len);
+
+    /**
+     * Record that the backing store including a host address may be
+     * written without calling markDirty(), for instance through a
+     * memory backdoor. The checkpoints of the store contain all of it
+     * from then on.
+     *
+     * @param host_addr Host address in the backing store
+     */
+    void markUntracked(const uint8_t *host_addr);
+
+    /**
+     * Register a function that calls markDirty() for the pages which
+     * were written since it was last called without going through the
+     * memories, for instance by a virtualized CPU. The functions are
+     * called before a checkpoint is written.
+     *
+     * @param source Function marking the pages written
+     */
+    void
+    addDirtyPageSource(std::function<void()> source)
+    {
+        dirtyPageSources.push_back(std::move(source));
+    }
+
     /**
      * Perform an untimed memory access and update all the state
      * (e.g. locked addresses) and statistics accordingly. The packet
@@ -284,6 +386,38 @@ class PhysicalMemory : public Serializable
     void serializeStore(CheckpointOut &cp, unsigned int store_id,
                         AddrRange range, uint8_t* pmem) const;
 
+    /**
+     * Write a store as an uncompressed image that can be mapped
+     * directly when restoring. Zero pages are left as holes.
+     *
+     * @param filepath The image file to write
+     * @param range The address range of this backing store
+     * @param pmem The host pointer to this backing store
+     */
+    void serializeRawStore(const std::string &filepath, AddrRange range,
+                           const uint8_t *pmem,
+                           const std::vector<uint8_t> &touched) const;
+
+    /**
+     * Find the host pages of a store that were ever touched, and may
+     * hold something else than zeros, without bringing any of them in.
+     * Pages are reported as touched when the host can't tell.
+     *
+     * @param store_id Unique identifier of this backing store
+     * @return One flag per host page of the store
+     */
+    std::vector<uint8_t> touchedPages(unsigned int store_id) const;
+
+    /**
+     * Write the pages of a store written since its previous image to a
+     * delta image layered on top of that image.
+     *
+     * @param filepath The image file to write
+     * @param store_id Unique identifier of this backing store
+     */
+    void serializeDeltaStore(const std::string &filepath,
+                             unsigned int store_id) const;
+
     /**
      * Unserialize the memories in the system. As with the
      * serialization, this action is independent of how the address
@@ -296,6 +430,28 @@ class PhysicalMemory : public Serializable
      */
     void unserializeStore(CheckpointIn &cp);
 
+    /**
+     * Restore a store from an uncompressed image by mapping the image
+     * copy-on-write in place of the backing store. Shared backing
+     * stores are filled by copying instead.
+     */
+    void unserializeRawStore(const std::string &filepath,
+                             const BackingStoreEntry &store);
+
+    /**
+     * Restore a store from an image in any format, restoring the
+     * images a delta image is layered on first.
+     */
+    void restoreStore(const std::string &filepath,
+                      const std::string &format, unsigned int store_id);
+
+    /**
+     * Restore the pages of a delta image on top of the image it is
+     * layered on.
+     */
+    void unserializeDeltaStore(const std::string &filepath,
+                               unsigned int store_id);
+
 };
 
 } // namespace memory
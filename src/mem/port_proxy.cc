@@ -37,6 +37,10 @@
 
 #include "mem/port_proxy.hh"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "base/chunk_generator.hh"
 #include "cpu/thread_context.hh"
 #include "mem/port.hh"
@@ -46,14 +50,54 @@ namespace gem5
 
 PortProxy::PortProxy(ThreadContext *tc, Addr cache_line_size) :
     PortProxy([tc](PacketPtr pkt)->void { tc->sendFunctional(pkt); },
+        [tc](const MemBackdoorReq &req, MemBackdoorPtr &backdoor)->void {
+            tc->sendMemBackdoorReq(req, backdoor);
+        },
         cache_line_size)
 {}
 
 PortProxy::PortProxy(const RequestPort &port, Addr cache_line_size) :
     PortProxy([&port](PacketPtr pkt)->void { port.sendFunctional(pkt); },
+        [&port](const MemBackdoorReq &req, MemBackdoorPtr &backdoor)->void {
+            // Asking for a back door doesn't change the port.
+            const_cast<RequestPort &>(port).sendMemBackdoorReq(
+                    req, backdoor);
+        },
         cache_line_size)
 {}
 
+void
+PortProxy::accessDirect(Addr addr, Request::Flags flags, uint64_t size,
+        MemBackdoor::Flags access,
+        const std::function<void(uint8_t *, uint64_t, uint64_t)> &direct,
+        const std::function<void(Addr, uint64_t, uint64_t)> &functional)
+    const
+{
+    uint64_t done = 0;
+    while (done < size) {
+        const Addr start = addr + done;
+        MemBackdoorPtr backdoor = nullptr;
+        // Only ask for the first byte, the back door covers as much of
+        // the rest as it can.
+        if (sendBackdoorReq && flags == 0) {
+            sendBackdoorReq(MemBackdoorReq(AddrRange(start, start + 1),
+                        access), backdoor);
+        }
+        if (!backdoor || backdoor->range().interleaved() ||
+                (backdoor->flags() & access) != access ||
+                !backdoor->range().contains(start)) {
+            functional(start, done, size - done);
+            return;
+        }
+
+        const uint64_t len = std::min<uint64_t>(size - done,
+                backdoor->range().end() - start);
+        direct(backdoor->ptr() + (start - backdoor->range().start()),
+                done, len);
+        done += len;
+    }
+}
+
 void
 PortProxy::readBlobPhys(Addr addr, Request::Flags flags,
                         void *p, uint64_t size) const
@@ -61,7 +105,7 @@ PortProxy::readBlobPhys(Addr addr, Request::Flags flags,
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
-        auto req = std::make_shared<Request>(
+        auto req = makeRequest(
             gen.addr(), gen.size(), flags, Request::funcRequestorId);
 
         Packet pkt(req, MemCmd::ReadReq);
@@ -78,7 +122,7 @@ PortProxy::writeBlobPhys(Addr addr, Request::Flags flags,
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
-        auto req = std::make_shared<Request>(
+        auto req = makeRequest(
             gen.addr(), gen.size(), flags, Request::funcRequestorId);
 
         Packet pkt(req, MemCmd::WriteReq);
@@ -92,13 +136,54 @@ void
 PortProxy::memsetBlobPhys(Addr addr, Request::Flags flags,
                           uint8_t v, uint64_t size) const
 {
-    // quick and dirty...
-    uint8_t *buf = new uint8_t[size];
+    // Write from a buffer of bounded size, however big the range is.
+    const uint64_t buf_size = std::min<uint64_t>(size, 64 * 1024);
+    std::vector<uint8_t> buf(buf_size, v);
+
+    for (uint64_t done = 0; done < size; done += buf_size) {
+        PortProxy::writeBlobPhys(addr + done, flags, buf.data(),
+                std::min(buf_size, size - done));
+    }
+}
 
-    std::memset(buf, v, size);
-    PortProxy::writeBlobPhys(addr, flags, buf, size);
+void
+PortProxy::loadBlobPhys(Addr addr, Request::Flags flags,
+                        const void *p, uint64_t size) const
+{
+    const uint8_t *src = static_cast<const uint8_t *>(p);
+    accessDirect(addr, flags, size, MemBackdoor::Writeable,
+        [src](uint8_t *host, uint64_t offset, uint64_t len) {
+            std::memcpy(host, src + offset, len);
+        },
+        [this, flags, src](Addr start, uint64_t offset, uint64_t len) {
+            PortProxy::writeBlobPhys(start, flags, src + offset, len);
+        });
+}
 
-    delete [] buf;
+void
+PortProxy::loadZerosPhys(Addr addr, Request::Flags flags, uint64_t size) const
+{
+    constexpr uint64_t block_size = 4096;
+    static const uint8_t zeros[block_size] = {};
+
+    // A read of an untouched page of anonymous memory doesn't make the
+    // host allocate it, a write does.
+    auto zero = [](uint8_t *host, uint64_t, uint64_t len) {
+        while (len > 0) {
+            const uint64_t chunk = std::min(len,
+                    block_size - ((uintptr_t)host & (block_size - 1)));
+            if (std::memcmp(host, zeros, chunk) != 0)
+                std::memset(host, 0, chunk);
+            host += chunk;
+            len -= chunk;
+        }
+    };
+    accessDirect(addr, flags, size,
+        (MemBackdoor::Flags)(MemBackdoor::Readable | MemBackdoor::Writeable),
+        zero,
+        [this, flags](Addr start, uint64_t, uint64_t len) {
+            PortProxy::memsetBlobPhys(start, flags, 0, len);
+        });
 }
 
 bool
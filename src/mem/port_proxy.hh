@@ -60,6 +60,7 @@
 #include <functional>
 #include <limits>
 
+#include "mem/backdoor.hh"
 #include "mem/protocol/functional.hh"
 #include "sim/byteswap.hh"
 
@@ -87,9 +88,13 @@ class PortProxy : FunctionalRequestProtocol
 {
   public:
     typedef std::function<void(PacketPtr pkt)> SendFunctionalFunc;
+    typedef std::function<void(const MemBackdoorReq &req,
+            MemBackdoorPtr &backdoor)> SendBackdoorReqFunc;
 
   private:
     SendFunctionalFunc sendFunctional;
+    /** How to ask for a back door, if the target may grant them. */
+    SendBackdoorReqFunc sendBackdoorReq;
 
     /** Granularity of any transactions issued through this proxy. */
     const Addr _cacheLineSize;
@@ -102,10 +107,28 @@ class PortProxy : FunctionalRequestProtocol
         panic("Port proxies should never receive snoops.");
     }
 
+    /**
+     * Call direct() on the parts of a physical range which memory grants
+     * a back door to, with their host address and offset in the range,
+     * and functional() on whatever is left from the first part without
+     * one.
+     */
+    void accessDirect(Addr addr, Request::Flags flags, uint64_t size,
+            MemBackdoor::Flags access,
+            const std::function<void(uint8_t *host, uint64_t offset,
+                uint64_t size)> &direct,
+            const std::function<void(Addr addr, uint64_t offset,
+                uint64_t size)> &functional) const;
+
   public:
     PortProxy(SendFunctionalFunc func, Addr cache_line_size) :
         sendFunctional(func), _cacheLineSize(cache_line_size)
     {}
+    PortProxy(SendFunctionalFunc func, SendBackdoorReqFunc backdoor_func,
+            Addr cache_line_size) :
+        sendFunctional(func), sendBackdoorReq(backdoor_func),
+        _cacheLineSize(cache_line_size)
+    {}
 
     // Helpers which create typical SendFunctionalFunc-s from other objects.
     PortProxy(ThreadContext *tc, Addr cache_line_size);
@@ -134,6 +157,23 @@ class PortProxy : FunctionalRequestProtocol
     void memsetBlobPhys(Addr addr, Request::Flags flags,
                         uint8_t v, uint64_t size) const;
 
+    /**
+     * Write size bytes from p to physical address, straight to the
+     * backing store of the memories which grant a back door to it, and
+     * with functional accesses elsewhere. Back doors skip the caches,
+     * so this is only for when those can't hold any of the data, like
+     * when images are loaded before simulating.
+     */
+    void loadBlobPhys(Addr addr, Request::Flags flags,
+                      const void *p, uint64_t size) const;
+
+    /**
+     * Zero size bytes starting at physical addr, like loadBlobPhys().
+     * The pages which are already zero, as fresh memory is, aren't
+     * written so that the host doesn't have to back them.
+     */
+    void loadZerosPhys(Addr addr, Request::Flags flags, uint64_t size) const;
+
 
 
     /** Methods to override in base classes */
@@ -171,6 +211,28 @@ class PortProxy : FunctionalRequestProtocol
         return true;
     }
 
+    /**
+     * Load size bytes from p to address, see loadBlobPhys().
+     * Returns true on success and false on failure.
+     */
+    virtual bool
+    tryLoadBlob(Addr addr, const void *p, uint64_t size) const
+    {
+        loadBlobPhys(addr, 0, p, size);
+        return true;
+    }
+
+    /**
+     * Zero size bytes starting at addr, see loadZerosPhys().
+     * Returns true on success and false on failure.
+     */
+    virtual bool
+    tryLoadZeros(Addr addr, uint64_t size) const
+    {
+        loadZerosPhys(addr, 0, size);
+        return true;
+    }
+
 
 
     /** Higher level interfaces based on the above. */
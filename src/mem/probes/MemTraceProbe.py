@@ -52,5 +52,16 @@ class MemTraceProbe(BaseMemProbe):
     # packet trace output file, disabled by default
     trace_file = Param.String("", "Packet trace output file")
 
+    # Write fixed-width records from a background thread instead of
+    # protobuf messages
+    trace_binary = Param.Bool(
+        False,
+        "Write the trace as fixed-width binary records from a "
+        "background thread",
+    )
+    trace_buffer_size = Param.MemorySize(
+        "1MiB", "Size of each of the two binary trace buffers"
+    )
+
     # System object to look up the name associated with a requestor ID
     system = Param.System(Parent.any, "System the probe belongs to")
@@ -58,6 +58,13 @@ class StackDistProbe(BaseMemProbe):
         False, "Verify behaviuor with reference implementation"
     )
 
+    # SHARDS-style sampling of the lines whose distance is computed
+    sample_rate = Param.Float(
+        1.0,
+        "Fraction of the lines to compute stack distances for, the "
+        "distances are scaled back up by it",
+    )
+
     # linear histogram bins and enable/disable
     linear_hist_bins = Param.Unsigned("16", "Bins in linear histograms")
     disable_linear_hists = Param.Bool(False, "Disable linear histograms")
@@ -50,6 +50,9 @@ BaseMemProbe::BaseMemProbe(const BaseMemProbeParams &p)
 void
 BaseMemProbe::regProbeListeners()
 {
+    if (!enabled)
+        return;
+
     const BaseMemProbeParams &p =
         dynamic_cast<const BaseMemProbeParams &>(params());
 
@@ -60,4 +63,17 @@ BaseMemProbe::regProbeListeners()
     }
 }
 
+void
+BaseMemProbe::setEnabled(bool on)
+{
+    if (on == enabled)
+        return;
+
+    enabled = on;
+    if (on)
+        regProbeListeners();
+    else
+        listeners.clear();
+}
+
 } // namespace gem5
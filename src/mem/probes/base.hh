@@ -68,6 +68,13 @@ class BaseMemProbe : public SimObject
 
     void regProbeListeners() override;
 
+    /**
+     * Start or stop listening to the probe points. Probes that are
+     * disabled before their listeners are registered don't register
+     * them until they are enabled.
+     */
+    void setEnabled(bool on);
+
   protected:
     /**
      * Callback to analyse intercepted Packets.
@@ -92,6 +99,8 @@ class BaseMemProbe : public SimObject
     };
 
     std::vector<std::unique_ptr<PacketListener>> listeners;
+
+    bool enabled = true;
 };
 
 } // namespace gem5
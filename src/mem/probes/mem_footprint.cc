@@ -38,6 +38,8 @@
 
 #include "mem/probes/mem_footprint.hh"
 
+#include <algorithm>
+
 #include "base/intmath.hh"
 #include "params/MemFootprintProbe.hh"
 
@@ -88,9 +90,17 @@ MemFootprintProbe::MemFootprintProbeStats::MemFootprintProbeStats(
 }
 
 void
-MemFootprintProbe::insertAddr(Addr addr, AddrSet *set, uint64_t limit)
+MemFootprintProbe::AddrBitmap::clear()
+{
+    for (auto &chunk : chunks)
+        std::fill(chunk.second.get(), chunk.second.get() + ChunkWords, 0);
+    _size = 0;
+}
+
+void
+MemFootprintProbe::insertAddr(Addr idx, AddrBitmap *set, uint64_t limit)
 {
-    set->insert(addr);
+    set->insert(idx);
     assert(set->size() <= limit);
 }
 
@@ -100,12 +110,12 @@ MemFootprintProbe::handleRequest(const probing::PacketInfo &pi)
     if (!pi.cmd.isRequest() || !system->isMemAddr(pi.addr))
         return;
 
-    const Addr cl_addr = (pi.addr >> cacheLineSizeLg2) << cacheLineSizeLg2;
-    const Addr page_addr = (pi.addr >> pageSizeLg2) << pageSizeLg2;
-    insertAddr(cl_addr, &cacheLines, totalCacheLinesInMem);
-    insertAddr(cl_addr, &cacheLinesAll, totalCacheLinesInMem);
-    insertAddr(page_addr, &pages, totalPagesInMem);
-    insertAddr(page_addr, &pagesAll, totalPagesInMem);
+    const Addr cl_idx = pi.addr >> cacheLineSizeLg2;
+    const Addr page_idx = pi.addr >> pageSizeLg2;
+    insertAddr(cl_idx, &cacheLines, totalCacheLinesInMem);
+    insertAddr(cl_idx, &cacheLinesAll, totalCacheLinesInMem);
+    insertAddr(page_idx, &pages, totalPagesInMem);
+    insertAddr(page_idx, &pagesAll, totalPagesInMem);
 
     assert(cacheLines.size() <= cacheLinesAll.size());
     assert(pages.size() <= pagesAll.size());
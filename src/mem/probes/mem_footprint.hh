@@ -39,7 +39,9 @@
 #ifndef __MEM_PROBES_MEM_FOOTPRINT_HH__
 #define __MEM_PROBES_MEM_FOOTPRINT_HH__
 
-#include <unordered_set>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
 
 #include "base/callback.hh"
 #include "mem/packet.hh"
@@ -57,7 +59,51 @@ struct MemFootprintProbeParams;
 class MemFootprintProbe : public BaseMemProbe
 {
   public:
-    typedef std::unordered_set<Addr> AddrSet;
+    /// Sparse bitmap of line or page numbers. The bits are kept in chunks
+    /// allocated as the footprint grows, and the number of bits set is
+    /// counted as they are set.
+    class AddrBitmap
+    {
+      public:
+        /// Set the bit of a line or page number
+        /// @return true if the bit was not set before
+        bool
+        insert(Addr idx)
+        {
+            const Addr chunk = idx >> ChunkBitsLg2;
+            if (chunk != lastChunk) {
+                auto &words = chunks[chunk];
+                if (!words)
+                    words.reset(new uint64_t[ChunkWords]());
+                lastChunk = chunk;
+                lastWords = words.get();
+            }
+            const Addr bit = idx & (ChunkBits - 1);
+            uint64_t &word = lastWords[bit / 64];
+            const uint64_t mask = 1ULL << (bit % 64);
+            if (word & mask)
+                return false;
+            word |= mask;
+            _size++;
+            return true;
+        }
+
+        /// Clear all bits, keeping the chunks for reuse
+        void clear();
+
+        /// Number of bits set
+        uint64_t size() const { return _size; }
+
+      private:
+        static constexpr unsigned ChunkBitsLg2 = 15;
+        static constexpr Addr ChunkBits = 1ULL << ChunkBitsLg2;
+        static constexpr size_t ChunkWords = ChunkBits / 64;
+
+        std::unordered_map<Addr, std::unique_ptr<uint64_t[]>> chunks;
+        Addr lastChunk = MaxAddr;
+        uint64_t *lastWords = nullptr;
+        uint64_t _size = 0;
+    };
 
     MemFootprintProbe(const MemFootprintProbeParams &p);
     // Fix footprint tracking state on stat reset
@@ -71,7 +117,7 @@ class MemFootprintProbe : public BaseMemProbe
     const uint64_t totalCacheLinesInMem;
     const uint64_t totalPagesInMem;
 
-    void insertAddr(Addr addr, AddrSet *set, uint64_t limit);
+    void insertAddr(Addr idx, AddrBitmap *set, uint64_t limit);
     void handleRequest(const probing::PacketInfo &pkt_info) override;
 
     struct MemFootprintProbeStats : public statistics::Group
@@ -88,14 +134,14 @@ class MemFootprintProbe : public BaseMemProbe
         statistics::Scalar pageTotal;
     };
 
-    // Addr set to track unique cache lines accessed
-    AddrSet cacheLines;
-    // Addr set to track unique cache lines accessed since simulation begin
-    AddrSet cacheLinesAll;
-    // Addr set to track unique pages accessed
-    AddrSet pages;
-    // Addr set to track unique pages accessed since simulation begin
-    AddrSet pagesAll;
+    // Bitmap to track unique cache lines accessed
+    AddrBitmap cacheLines;
+    // Bitmap to track unique cache lines accessed since simulation begin
+    AddrBitmap cacheLinesAll;
+    // Bitmap to track unique pages accessed
+    AddrBitmap pages;
+    // Bitmap to track unique pages accessed since simulation begin
+    AddrBitmap pagesAll;
     System *system;
 
     MemFootprintProbeStats stats;
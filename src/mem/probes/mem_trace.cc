@@ -74,7 +74,11 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
                                   (p.trace_compress ? ".gz" : ""));
     }
 
-    traceStream = new ProtoOutputStream(filename);
+    if (p.trace_binary)
+        binaryTrace.reset(new AsyncWriter(filename, p.trace_buffer_size,
+                                          p.trace_compress));
+    else
+        traceStream = new ProtoOutputStream(filename);
 
     // Register a callback to compensate for the destructor not
     // being called. The callback forces the stream to flush and
@@ -85,6 +89,21 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
 void
 MemTraceProbe::startup()
 {
+    if (binaryTrace) {
+        binaryTrace->write(BinaryMagic, sizeof(BinaryMagic));
+        binaryTrace->put(BinaryVersion);
+        binaryTrace->put<uint32_t>(sizeof(BinaryRecord));
+        binaryTrace->put<uint64_t>(sim_clock::Frequency);
+        binaryTrace->put<uint32_t>(system->maxRequestors());
+        for (int i = 0; i < system->maxRequestors(); i++) {
+            const std::string &id_name = system->getRequestorName(i);
+            binaryTrace->put<uint16_t>(i);
+            binaryTrace->put<uint32_t>(id_name.size());
+            binaryTrace->write(id_name.data(), id_name.size());
+        }
+        return;
+    }
+
     // Create a protobuf message for the header and write it to
     // the stream
     ProtoMessage::PacketHeader header_msg;
@@ -105,11 +124,25 @@ MemTraceProbe::closeStreams()
 {
     if (traceStream != NULL)
         delete traceStream;
+    binaryTrace.reset();
 }
 
 void
 MemTraceProbe::handleRequest(const probing::PacketInfo &pkt_info)
 {
+    if (binaryTrace) {
+        BinaryRecord rec;
+        rec.tick = curTick();
+        rec.addr = pkt_info.addr;
+        rec.flags = pkt_info.flags;
+        rec.pc = withPC ? pkt_info.pc : 0;
+        rec.size = pkt_info.size;
+        rec.cmd = pkt_info.cmd.toInt();
+        rec.requestor = pkt_info.id;
+        binaryTrace->put(rec);
+        return;
+    }
+
     ProtoMessage::Packet pkt_msg;
 
     pkt_msg.set_tick(curTick());
@@ -38,6 +38,10 @@
 #ifndef __MEM_PROBES_MEM_TRACE_HH__
 #define __MEM_PROBES_MEM_TRACE_HH__
 
+#include <cstdint>
+#include <memory>
+
+#include "base/async_writer.hh"
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
 #include "proto/protoio.hh"
@@ -53,6 +57,31 @@ class MemTraceProbe : public BaseMemProbe
   public:
     MemTraceProbe(const MemTraceProbeParams &params);
 
+    /**
+     * Binary traces start with BinaryMagic, the uint32_t BinaryVersion,
+     * the uint32_t size of a BinaryRecord, the uint64_t tick frequency
+     * and the uint32_t number of requestor names, each of which is a
+     * uint16_t ID followed by a uint32_t length and the characters.
+     * Then comes one BinaryRecord per packet, in host byte order.
+     * util/decode_packet_trace.py reads both formats.
+     */
+    static constexpr char BinaryMagic[8] =
+        {'m', '5', 'p', 'k', 't', 'b', 'i', 'n'};
+    static constexpr uint32_t BinaryVersion = 1;
+
+    struct BinaryRecord
+    {
+        uint64_t tick;
+        uint64_t addr;
+        uint64_t flags;
+        /** 0 if the request has no PC or with_pc is false */
+        uint64_t pc;
+        uint32_t size;
+        uint16_t cmd;
+        uint16_t requestor;
+    };
+    static_assert(sizeof(BinaryRecord) == 40);
+
   protected:
     void handleRequest(const probing::PacketInfo &pkt_info) override;
 
@@ -69,6 +98,9 @@ class MemTraceProbe : public BaseMemProbe
     /** Trace output stream */
     ProtoOutputStream *traceStream;
 
+    /** Binary trace output, used instead of traceStream if set */
+    std::unique_ptr<AsyncWriter> binaryTrace;
+
     System *system;
 
   private:
@@ -48,12 +48,15 @@ StackDistProbe::StackDistProbe(const StackDistProbeParams &p)
       lineSize(p.line_size),
       disableLinearHists(p.disable_linear_hists),
       disableLogHists(p.disable_log_hists),
-      calc(p.verify),
+      calc(p.sample_rate),
+      verifyCalc(p.verify ? new StackDistCalc(true) : nullptr),
       stats(this)
 {
     fatal_if(p.system->cacheLineSize() > p.line_size,
              "The stack distance probe must use a cache line size that is "
              "larger or equal to the system's cahce line size.");
+    fatal_if(p.verify && p.sample_rate < 1.0,
+             "The stack distance probe can't verify sampled distances.");
 }
 
 StackDistProbe::StackDistProbeStats::StackDistProbeStats(
@@ -106,8 +109,17 @@ StackDistProbe::handleRequest(const probing::PacketInfo &pkt_info)
     // Align the address to a cache line size
     const Addr aligned_addr(roundDown(pkt_info.addr, lineSize));
 
+    if (!calc.sampled(aligned_addr))
+        return;
+
     // Calculate the stack distance
     const uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
+    if (verifyCalc) {
+        const uint64_t expected(
+            verifyCalc->calcStackDistAndUpdate(aligned_addr).first);
+        panic_if(sd != expected, "Expected stack distance %d for address "
+                 "%#x but found %d.", expected, aligned_addr, sd);
+    }
     if (sd == StackDistCalc::Infinity) {
         stats.infiniteSD++;
         return;
@@ -38,8 +38,11 @@
 #ifndef __MEM_PROBES_STACK_DIST_HH__
 #define __MEM_PROBES_STACK_DIST_HH__
 
+#include <memory>
+
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
+#include "mem/reuse_dist_calc.hh"
 #include "mem/stack_dist_calc.hh"
 #include "sim/stats.hh"
 
@@ -67,7 +70,10 @@ class StackDistProbe : public BaseMemProbe
     const bool disableLogHists;
 
   protected:
-    StackDistCalc calc;
+    ReuseDistCalc calc;
+
+    // Reference implementation, when verifying
+    std::unique_ptr<StackDistCalc> verifyCalc;
 
     struct StackDistProbeStats : public statistics::Group
     {
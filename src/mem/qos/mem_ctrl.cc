@@ -37,6 +37,8 @@
 
 #include "mem/qos/mem_ctrl.hh"
 
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
 #include "mem/qos/policy.hh"
 #include "mem/qos/q_policy.hh"
 #include "mem/qos/turnaround_policy.hh"
@@ -81,12 +83,44 @@ MemCtrl::MemCtrl(const QoSMemCtrlParams &p)
 
     readQueueSizes.resize(_numPriorities);
     writeQueueSizes.resize(_numPriorities);
+    readReady.resize(divCeil(_numPriorities, 64));
+    writeReady.resize(divCeil(_numPriorities, 64));
     serviceTick.resize(_numPriorities);
 }
 
 MemCtrl::~MemCtrl()
 {}
 
+void
+MemCtrl::updateReady(BusState dir, uint8_t prio)
+{
+    auto &ready = dir == READ ? readReady : writeReady;
+    const uint64_t size = dir == READ ? readQueueSizes[prio] :
+                                        writeQueueSizes[prio];
+    if (size) {
+        ready[prio / 64] |= 1ULL << (prio % 64);
+    } else {
+        ready[prio / 64] &= ~(1ULL << (prio % 64));
+    }
+}
+
+int
+MemCtrl::highestReadyPriority(BusState dir, int below) const
+{
+    if (below <= 0)
+        return -1;
+
+    const auto &ready = dir == READ ? readReady : writeReady;
+    int word = (below - 1) / 64;
+    uint64_t bits = ready[word] & mask((below - 1) % 64 + 1);
+    while (!bits) {
+        if (--word < 0)
+            return -1;
+        bits = ready[word];
+    }
+    return word * 64 + findMsbSet(bits);
+}
+
 void
 MemCtrl::logRequest(BusState dir, RequestorID id, uint8_t _qos,
                     Addr addr, uint64_t entries)
@@ -110,6 +144,7 @@ MemCtrl::logRequest(BusState dir, RequestorID id, uint8_t _qos,
         writeQueueSizes[_qos] += entries;
         totalWriteQueueSize += entries;
     }
+    updateReady(dir, _qos);
 
     packetPriorities[id][_qos] += entries;
     for (auto j = 0; j < entries; ++j) {
@@ -166,6 +201,7 @@ MemCtrl::logResponse(BusState dir, RequestorID id, uint8_t _qos,
         writeQueueSizes[_qos] -= entries;
         totalWriteQueueSize -= entries;
     }
+    updateReady(dir, _qos);
 
     panic_if(packetPriorities[id][_qos] == 0,
              "qos::MemCtrl::logResponse requestor %s negative packets "
@@ -126,6 +126,15 @@ class MemCtrl : public ClockedObject
     /** Write request packets queue length in #packets, per QoS priority */
     std::vector<uint64_t> writeQueueSizes;
 
+    /**
+     * Priorities with queued read request packets, one bit per priority,
+     * so the highest one is found without visiting the empty queues
+     */
+    std::vector<uint64_t> readReady;
+
+    /** Priorities with queued write request packets */
+    std::vector<uint64_t> writeReady;
+
     /** Total read request packets queue length in #packets */
     uint64_t totalReadQueueSize;
 
@@ -182,6 +191,15 @@ class MemCtrl : public ClockedObject
      */
     void addRequestor(const RequestorID id);
 
+    /**
+     * Sets or clears the ready bit of a priority from the size of its
+     * queue
+     *
+     * @param dir queue direction
+     * @param prio QoS Priority of the queue
+     */
+    void updateReady(BusState dir, uint8_t prio);
+
     /**
      * Called upon receiving a request or
      * updates statistics and updates queues status
@@ -335,6 +353,25 @@ class MemCtrl : public ClockedObject
     uint64_t getWriteQueueSize(const uint8_t prio) const
     { return writeQueueSizes[prio]; }
 
+    /**
+     * Gets the highest QoS priority below a given one which has packets
+     * queued, with a find-first-set per 64 priorities
+     *
+     * @param dir queue direction
+     * @param below only priorities lower than this one are considered
+     * @return the priority, or -1 if none has packets queued
+     */
+    int highestReadyPriority(BusState dir, int below) const;
+
+    /**
+     * Gets the highest QoS priority which has packets queued
+     *
+     * @param dir queue direction
+     * @return the priority, or -1 if none has packets queued
+     */
+    int highestReadyPriority(BusState dir) const
+    { return highestReadyPriority(dir, numPriorities()); }
+
     /**
      * Gets the total combined READ queues size
      *
@@ -412,6 +449,8 @@ MemCtrl::escalateQueues(Queues& queues, uint64_t queue_entry_size,
                         requestors[id], tgt_prio);
                 readQueueSizes[curr_prio] -= moved_entries;
                 readQueueSizes[tgt_prio] += moved_entries;
+                updateReady(READ, curr_prio);
+                updateReady(READ, tgt_prio);
             } else if (pkt->isWrite()) {
                 panic_if(writeQueueSizes[curr_prio] < moved_entries,
                          "qos::MemCtrl::escalateQueues requestor %s negative "
@@ -419,15 +458,19 @@ MemCtrl::escalateQueues(Queues& queues, uint64_t queue_entry_size,
                         requestors[id], tgt_prio);
                 writeQueueSizes[curr_prio] -= moved_entries;
                 writeQueueSizes[tgt_prio] += moved_entries;
+                updateReady(WRITE, curr_prio);
+                updateReady(WRITE, tgt_prio);
             }
 
-            // Change QoS priority and move packet
-            pkt->qosValue(tgt_prio);
-            queues[tgt_prio].push_back(pkt);
-
             // Erase element from source packet queue, this will
             // increment the iterator
             it = queues[curr_prio].erase(it);
+
+            // Change QoS priority and move packet. This follows the
+            // erase as the memory controller queues track the position
+            // of the packets they hold.
+            pkt->qosValue(tgt_prio);
+            queues[tgt_prio].push_back(pkt);
             panic_if(packetPriorities[id][curr_prio] < moved_entries,
                      "qos::MemCtrl::escalateQueues requestor %s negative "
                      "packets for priority %d",
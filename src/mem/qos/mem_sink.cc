@@ -245,34 +245,27 @@ MemSinkCtrl::processNextReqEvent()
         }
     }
 
-    uint8_t curr_prio = numPriorities();
+    // The highest priority with queued packets
+    const int curr_prio = highestReadyPriority(busState);
+    assert(curr_prio >= 0);
 
-    for (auto queue = (*queue_ptr).rbegin();
-         queue != (*queue_ptr).rend(); ++queue) {
+    PacketQueue &queue = (*queue_ptr)[curr_prio];
 
-        curr_prio--;
-
-        DPRINTF(QOS,
-                "%s checking %s queue [%d] priority [%d packets]\n",
-                __func__, (busState == READ? "READ" : "WRITE"),
-                curr_prio, queue->size());
+    DPRINTF(QOS,
+            "%s checking %s queue [%d] priority [%d packets]\n",
+            __func__, (busState == READ? "READ" : "WRITE"),
+            curr_prio, queue.size());
 
-        if (!queue->empty()) {
-            // Call the queue policy to select packet from priority queue
-            auto p_it = queuePolicy->selectPacket(&(*queue));
-            pkt = *p_it;
-            queue->erase(p_it);
+    // Call the queue policy to select packet from priority queue
+    auto p_it = queuePolicy->selectPacket(&queue);
+    pkt = *p_it;
+    queue.erase(p_it);
 
-            DPRINTF(QOS,
-                    "%s scheduling packet address %d for requestor %s from "
-                    "priority queue %d\n", __func__, pkt->getAddr(),
-                    _system->getRequestorName(pkt->req->requestorId()),
-                    curr_prio);
-            break;
-        }
-    }
-
-    assert(pkt);
+    DPRINTF(QOS,
+            "%s scheduling packet address %d for requestor %s from "
+            "priority queue %d\n", __func__, pkt->getAddr(),
+            _system->getRequestorName(pkt->req->requestorId()),
+            curr_prio);
 
     // Setup next request service time - do it here as retry request
     // hands over control to the port
@@ -37,7 +37,6 @@
 
 #include "mem/qos/q_policy.hh"
 
-#include <unordered_map>
 #include <utility>
 
 #include "base/logging.hh"
@@ -90,10 +89,13 @@ LrgQueuePolicy::selectPacket(PacketQueue* q)
 {
     panic_if(q->empty(),
              "Provided packet queue is not usable by queue policy");
-    QueuePolicy::PacketQueue::iterator ret = q->end();
+    panic_if(toServe.empty(),
+             "%s: toServe list is empty\n", __func__);
 
-    // Tracks one packet per requestor in the queue
-    std::unordered_map<RequestorID, QueuePolicy::PacketQueue::iterator> track;
+    // The first packet of the requestor closest to the front of the
+    // toServe list
+    QueuePolicy::PacketQueue::iterator ret = q->end();
+    int ret_rank = toServe.size();
 
     // Cycle queue only once
     for (auto pkt_it = q->begin(); pkt_it != q->end(); ++pkt_it) {
@@ -112,49 +114,42 @@ LrgQueuePolicy::selectPacket(PacketQueue* q)
         panic_if(!memCtrl->hasRequestor(requestor_id),
                  "%s: Unrecognized Requestor\n", __func__);
 
-        panic_if(toServe.size() <= 0,
-                 "%s: toServe list is empty\n", __func__);
+        const int rank = serveRank(requestor_id);
+        panic_if(rank < 0, "%s: Requestor %d never enqueued a packet\n",
+                 __func__, requestor_id);
 
-        if (toServe.front() == requestor_id) {
+        if (rank == 0) {
             DPRINTF(QOS, "QoSQPolicy::lrg matched to served "
                          "requestor id %d\n", requestor_id);
             // This packet matches the RequestorID to be served next
             // move toServe front to back
-            toServe.push_back(requestor_id);
-            toServe.pop_front();
+            serveHead = (serveHead + 1) % toServe.size();
 
             return pkt_it;
         }
 
         // The requestor generating the packet is not first in the toServe list
         // (Doesn't have the highest priority among requestors)
-        // Check if this is the first packet seen with its requestor id
-        // and remember it. Then keep looping over the remaining packets
-        // in the queue.
-        if (track.find(requestor_id) == track.end()) {
-            track[requestor_id] = pkt_it;
+        // Remember its first packet if it is closer to the front than the
+        // requestors seen so far, then keep looping over the remaining
+        // packets in the queue.
+        if (rank < ret_rank) {
+            ret = pkt_it;
+            ret_rank = rank;
             DPRINTF(QOS, "QoSQPolicy::lrg tracking a packet for "
                          "requestor id %d\n", requestor_id);
         }
     }
 
     // If here, the current requestor to be serviced doesn't have a pending
-    // packet in the queue: look for the next requestor in the list.
-    for (const auto& requestorId : toServe) {
-        DPRINTF(QOS, "QoSQPolicy::lrg evaluating alternative "
-                     "requestor id %d\n", requestorId);
-
-        if (track.find(requestorId) != track.end()) {
-            ret = track[requestorId];
-            DPRINTF(QOS, "QoSQPolicy::lrg requestor id "
-                         "%d selected for service\n", requestorId);
-
-            return ret;
-        }
+    // packet in the queue: the next requestor in the list is served.
+    if (ret != q->end()) {
+        DPRINTF(QOS, "QoSQPolicy::lrg requestor id "
+                     "%d selected for service\n", (*ret)->req->requestorId());
+    } else {
+        DPRINTF(QOS, "QoSQPolicy::lrg no packet was serviced\n");
     }
 
-    DPRINTF(QOS, "QoSQPolicy::lrg no packet was serviced\n");
-
     // Ret will be : packet to serve
     return ret;
 }
@@ -163,10 +158,20 @@ void
 LrgQueuePolicy::enqueuePacket(PacketPtr pkt)
 {
     RequestorID requestor_id = pkt->requestorId();
-    if (!memCtrl->hasRequestor(requestor_id)) {
-        toServe.push_back(requestor_id);
-    }
-};
+    if (serveRank(requestor_id) >= 0)
+        return;
+
+    // Insert the new requestor at the back of the ring, which is just
+    // before its front
+    toServe.insert(toServe.begin() + serveHead, requestor_id);
+    if (toServe.size() > 1)
+        serveHead++;
+
+    if (requestor_id >= servePos.size())
+        servePos.resize(requestor_id + 1, -1);
+    for (size_t i = 0; i < toServe.size(); i++)
+        servePos[toServe[i]] = i;
+}
 
 } // namespace qos
 } // namespace memory
@@ -39,8 +39,8 @@
 #define __MEM_QOS_Q_POLICY_HH__
 
 #include <deque>
-#include <list>
 #include <unordered_set>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "mem/packet.hh"
@@ -180,9 +180,31 @@ class LrgQueuePolicy : public QueuePolicy
     /**
      * Support structure for lrg algorithms:
      * keeps track of serviced requestors,
-     * always serve the front element.
+     * always serve the front element. It is a ring
+     * starting at serveHead, so moving the front
+     * element to the back is a single increment.
      */
-    std::list<RequestorID> toServe;
+    std::vector<RequestorID> toServe;
+
+    /** Index of the front element of toServe */
+    size_t serveHead = 0;
+
+    /** Index in toServe of each requestor id, -1 if it isn't there */
+    std::vector<int> servePos;
+
+    /**
+     * Position of a requestor from the front of toServe
+     *
+     * @param id requestor id to lookup
+     * @return the position, or -1 if the requestor isn't tracked
+     */
+    int
+    serveRank(RequestorID id) const
+    {
+        if (id >= servePos.size() || servePos[id] < 0)
+            return -1;
+        return (servePos[id] + toServe.size() - serveHead) % toServe.size();
+    }
 };
 
 } // namespace qos
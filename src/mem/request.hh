@@ -54,13 +54,17 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "base/amo.hh"
 #include "base/compiler.hh"
 #include "base/extensible.hh"
 #include "base/flags.hh"
+#include "base/free_list.hh"
+#include "base/refcnt.hh"
 #include "base/types.hh"
+#include "config/use_intrusive_request_refcount.hh"
 #include "cpu/inst_seq.hh"
 #include "mem/htm.hh"
 #include "sim/cur_tick.hh"
@@ -91,10 +95,34 @@ class Packet;
 class Request;
 class ThreadContext;
 
+/**
+ * Requests are shared by every packet of a transaction. By default they
+ * are managed by std::shared_ptr, whose reference count is updated with
+ * atomic operations. When USE_INTRUSIVE_REQUEST_REFCOUNT is enabled the
+ * count is kept in the request itself and updated non-atomically, which
+ * is cheaper but requires that a request is only ever referenced from
+ * one simulation thread at a time.
+ */
+#if USE_INTRUSIVE_REQUEST_REFCOUNT
+typedef RefCountingPtr<Request> RequestPtr;
+#else
 typedef std::shared_ptr<Request> RequestPtr;
+#endif
 typedef uint16_t RequestorID;
 
+/**
+ * Create a new request, forwarding the arguments to its constructor.
+ * The storage comes from the thread-local FreeList pools. This should
+ * be used instead of std::make_shared<Request> so that the request
+ * pointer type can be switched at build time.
+ */
+template <typename... Args>
+RequestPtr makeRequest(Args&&... args);
+
 class Request : public Extensible<Request>
+#if USE_INTRUSIVE_REQUEST_REFCOUNT
+              , public RefCounted, public FreeListAllocated<Request>
+#endif
 {
   public:
     typedef uint64_t FlagsType;
@@ -530,7 +558,7 @@ class Request : public Extensible<Request>
     static RequestPtr
     createMemManagement(Flags flags, RequestorID id)
     {
-        auto mgmt_req = std::make_shared<Request>();
+        auto mgmt_req = makeRequest();
         mgmt_req->_flags.set(flags);
         mgmt_req->_requestorId = id;
         mgmt_req->_time = curTick();
@@ -612,8 +640,8 @@ class Request : public Extensible<Request>
         assert(hasVaddr());
         assert(!hasPaddr());
         assert(split_addr > _vaddr && split_addr < _vaddr + _size);
-        req1 = std::make_shared<Request>(*this);
-        req2 = std::make_shared<Request>(*this);
+        req1 = makeRequest(*this);
+        req2 = makeRequest(*this);
         req1->_size = split_addr - _vaddr;
         req2->_vaddr = split_addr;
         req2->_size = _size - req1->_size;
@@ -814,6 +842,13 @@ class Request : public Extensible<Request>
         _flags.clear(flags);
     }
 
+    /** Accessor for cache coherence flags. */
+    CacheCoherenceFlags
+    getCacheCoherenceFlags() const
+    {
+        return _cacheCoherenceFlags;
+    }
+
     void
     setCacheCoherenceFlags(CacheCoherenceFlags extraFlags)
     {
@@ -1121,6 +1156,18 @@ class Request : public Extensible<Request>
     /** @} */
 };
 
+template <typename... Args>
+RequestPtr
+makeRequest(Args&&... args)
+{
+#if USE_INTRUSIVE_REQUEST_REFCOUNT
+    return RequestPtr(new Request(std::forward<Args>(args)...));
+#else
+    return std::allocate_shared<Request>(FreeListAllocator<Request>(),
+                                         std::forward<Args>(args)...);
+#endif
+}
+
 } // namespace gem5
 
 #endif // __MEM_REQUEST_HH__
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/reuse_dist_calc.hh"
+
+#include <cmath>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+ReuseDistCalc::ReuseDistCalc(double sample_rate)
+    : sampleRate(sample_rate),
+      threshold(sample_rate >= 1.0 ? HashRange + 1 :
+                std::llround(sample_rate * HashRange)),
+      tree(MinCapacity + 1, 0), accessed(MinCapacity)
+{
+    fatal_if(!(sample_rate > 0.0 && sample_rate <= 1.0),
+             "Reuse distance sampling rate %f is not in (0, 1].\n",
+             sample_rate);
+    fatal_if(threshold == 0,
+             "Reuse distance sampling rate %f is too small.\n", sample_rate);
+}
+
+uint64_t
+ReuseDistCalc::distanceFrom(uint64_t time) const
+{
+    uint64_t up_to = 0;
+    for (uint64_t i = time + 1; i > 0; i -= i & -i)
+        up_to += tree[i];
+    return lastAccess.size() - up_to;
+}
+
+void
+ReuseDistCalc::update(uint64_t time, int64_t delta)
+{
+    for (uint64_t i = time + 1; i < tree.size(); i += i & -i)
+        tree[i] += delta;
+}
+
+void
+ReuseDistCalc::compact()
+{
+    const size_t capacity = std::max(MinCapacity, 2 * lastAccess.size());
+    std::vector<Addr> live;
+    live.reserve(capacity);
+    for (uint64_t time = 0; time < nextTime; time++) {
+        auto it = lastAccess.find(accessed[time]);
+        if (it != lastAccess.end() && it->second.time == time) {
+            it->second.time = live.size();
+            live.push_back(accessed[time]);
+        }
+    }
+
+    // Build the tree in linear time by pushing each count to its parent.
+    tree.assign(capacity + 1, 0);
+    for (size_t i = 1; i <= live.size(); i++)
+        tree[i] = 1;
+    for (size_t i = 1; i <= capacity; i++) {
+        const size_t parent = i + (i & -i);
+        if (parent <= capacity)
+            tree[parent] += tree[i];
+    }
+
+    nextTime = live.size();
+    live.resize(capacity);
+    accessed = std::move(live);
+}
+
+uint64_t
+ReuseDistCalc::scale(uint64_t dist) const
+{
+    if (dist == Infinity || threshold > HashRange)
+        return dist;
+    return dist / sampleRate;
+}
+
+std::pair<uint64_t, bool>
+ReuseDistCalc::calcStackDist(Addr addr, bool mark)
+{
+    auto it = lastAccess.find(addr);
+    if (it == lastAccess.end())
+        return std::make_pair(Infinity, false);
+
+    const bool was_marked = it->second.marked;
+    it->second.marked = mark;
+    return std::make_pair(scale(distanceFrom(it->second.time)), was_marked);
+}
+
+std::pair<uint64_t, bool>
+ReuseDistCalc::calcStackDistAndUpdate(Addr addr, bool add_new_node)
+{
+    uint64_t dist = Infinity;
+    bool was_marked = false;
+
+    auto it = lastAccess.find(addr);
+    if (it != lastAccess.end()) {
+        dist = scale(distanceFrom(it->second.time));
+        was_marked = it->second.marked;
+        update(it->second.time, -1);
+        if (!add_new_node) {
+            lastAccess.erase(it);
+            return std::make_pair(dist, was_marked);
+        }
+    } else if (!add_new_node) {
+        return std::make_pair(dist, was_marked);
+    }
+
+    if (nextTime == accessed.size()) {
+        // The entry of addr, if any, is no longer live in the tree.
+        if (it != lastAccess.end())
+            it->second.time = Infinity;
+        compact();
+    }
+
+    const uint64_t time = nextTime++;
+    lastAccess[addr] = Entry{time, false};
+    accessed[time] = addr;
+    update(time, 1);
+
+    return std::make_pair(dist, was_marked);
+}
+
+} // namespace gem5
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_REUSE_DIST_CALC_HH__
+#define __MEM_REUSE_DIST_CALC_HH__
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Reuse (stack) distance calculator using Bennett and Kruskal's
+ * algorithm: every access gets a timestamp, and a Fenwick tree
+ * (binary indexed tree) over the timestamps counts the addresses whose
+ * most recent access is at each of them. The stack distance of an
+ * address is then the number of counted timestamps after its previous
+ * access, which takes O(log n) time without any pointer chasing or
+ * allocation.
+ *
+ * The timestamps of the addresses still being tracked are compacted
+ * once the tree is full, so its size stays proportional to the number of
+ * distinct addresses rather than to the number of accesses.
+ *
+ * The interface and results are the same as the ones of StackDistCalc.
+ * In addition, the distances can be estimated from a sample of the
+ * addresses as done by SHARDS (Waldspurger et al., FAST'15): only the
+ * addresses for which sampled() is true should be passed in, and the
+ * distances are scaled back up by the sampling rate.
+ */
+class ReuseDistCalc
+{
+  public:
+    /** A convenient way of refering to infinity. */
+    static constexpr uint64_t Infinity = std::numeric_limits<uint64_t>::max();
+
+    /**
+     * @param sample_rate Fraction of the addresses to track, in (0, 1].
+     */
+    ReuseDistCalc(double sample_rate = 1.0);
+
+    /** Whether an address is part of the tracked sample. */
+    bool
+    sampled(Addr addr) const
+    {
+        if (threshold > HashRange)
+            return true;
+        uint64_t hash = addr * 0x9e3779b97f4a7c15ULL;
+        return ((hash ^ (hash >> 29)) & (HashRange - 1)) < threshold;
+    }
+
+    /**
+     * Get the stack distance of an address without accessing it. If
+     * mark is true, mark the address, else unmark it.
+     *
+     * @param addr The address to look up.
+     * @param mark Value to set the mark flag of the address to.
+     * @return The stack distance of the address and the previous value
+     *         of its mark flag.
+     */
+    std::pair<uint64_t, bool> calcStackDist(Addr addr, bool mark = false);
+
+    /**
+     * Access an address, or if add_new_node is false stop tracking it.
+     *
+     * @param addr The address to access.
+     * @param add_new_node Whether the address stays tracked.
+     * @return The stack distance of the address before the access and
+     *         its mark flag, which the access clears.
+     */
+    std::pair<uint64_t, bool> calcStackDistAndUpdate(Addr addr,
+                                                     bool add_new_node = true);
+
+    /** Number of addresses being tracked */
+    size_t size() const { return lastAccess.size(); }
+
+  protected:
+    struct Entry
+    {
+        uint64_t time;
+        bool marked;
+    };
+
+    /** Number of tracked addresses accessed after a timestamp */
+    uint64_t distanceFrom(uint64_t time) const;
+
+    /** Add delta to the count of a timestamp */
+    void update(uint64_t time, int64_t delta);
+
+    /** Renumber the tracked timestamps from 0 and resize the tree */
+    void compact();
+
+    /** Scale a sampled distance back up */
+    uint64_t scale(uint64_t dist) const;
+
+    static constexpr uint64_t HashRange = 1ULL << 24;
+    static constexpr size_t MinCapacity = 1024;
+
+    const double sampleRate;
+    const uint64_t threshold;
+
+    std::unordered_map<Addr, Entry> lastAccess;
+
+    /** Fenwick tree of the counts, indexed by timestamp + 1 */
+    std::vector<uint32_t> tree;
+    /** Address accessed at each timestamp, for compaction */
+    std::vector<Addr> accessed;
+
+    uint64_t nextTime = 0;
+};
+
+} // namespace gem5
+
+#endif // __MEM_REUSE_DIST_CALC_HH__
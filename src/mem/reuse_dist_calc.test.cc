@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "base/gtest/logging.hh"
+#include "mem/reuse_dist_calc.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Stack of addresses, most recently used last. */
+class NaiveStack
+{
+  public:
+    uint64_t
+    access(Addr addr, bool keep = true)
+    {
+        auto it = std::find(stack.begin(), stack.end(), addr);
+        uint64_t dist = ReuseDistCalc::Infinity;
+        if (it != stack.end()) {
+            dist = stack.end() - it - 1;
+            stack.erase(it);
+        }
+        if (keep)
+            stack.push_back(addr);
+        return dist;
+    }
+
+    size_t size() const { return stack.size(); }
+
+  private:
+    std::vector<Addr> stack;
+};
+
+} // anonymous namespace
+
+/** Distances are counted in distinct addresses. */
+TEST(ReuseDistCalcTest, Distances)
+{
+    ReuseDistCalc calc;
+    EXPECT_EQ(ReuseDistCalc::Infinity, calc.calcStackDistAndUpdate(1).first);
+    EXPECT_EQ(ReuseDistCalc::Infinity, calc.calcStackDistAndUpdate(2).first);
+    EXPECT_EQ(0, calc.calcStackDistAndUpdate(2).first);
+    EXPECT_EQ(ReuseDistCalc::Infinity, calc.calcStackDistAndUpdate(3).first);
+    EXPECT_EQ(2, calc.calcStackDistAndUpdate(1).first);
+    EXPECT_EQ(1, calc.calcStackDist(3).first);
+    EXPECT_EQ(3, calc.size());
+}
+
+/** Removed addresses are no longer counted. */
+TEST(ReuseDistCalcTest, Remove)
+{
+    ReuseDistCalc calc;
+    calc.calcStackDistAndUpdate(1);
+    calc.calcStackDistAndUpdate(2);
+    calc.calcStackDistAndUpdate(3);
+    EXPECT_EQ(1, calc.calcStackDistAndUpdate(2, false).first);
+    EXPECT_EQ(1, calc.calcStackDist(1).first);
+    EXPECT_EQ(ReuseDistCalc::Infinity, calc.calcStackDist(2).first);
+    EXPECT_EQ(ReuseDistCalc::Infinity,
+              calc.calcStackDistAndUpdate(4, false).first);
+    EXPECT_EQ(2, calc.size());
+}
+
+/** Marks are returned once, and cleared by accesses. */
+TEST(ReuseDistCalcTest, Marks)
+{
+    ReuseDistCalc calc;
+    calc.calcStackDistAndUpdate(1);
+    EXPECT_FALSE(calc.calcStackDist(1, true).second);
+    EXPECT_TRUE(calc.calcStackDist(1, true).second);
+    EXPECT_TRUE(calc.calcStackDistAndUpdate(1).second);
+    EXPECT_FALSE(calc.calcStackDistAndUpdate(1).second);
+}
+
+/** Compactions don't change the distances. */
+TEST(ReuseDistCalcTest, MatchesNaiveStack)
+{
+    ReuseDistCalc calc;
+    NaiveStack stack;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<Addr> addrs(0, 1500);
+
+    for (int i = 0; i < 20000; i++) {
+        const Addr addr = addrs(rng);
+        const bool keep = i % 7 != 0;
+        ASSERT_EQ(stack.access(addr, keep),
+                  calc.calcStackDistAndUpdate(addr, keep).first);
+    }
+    EXPECT_EQ(stack.size(), calc.size());
+}
+
+/** Sampled distances are scaled back up to estimate the real ones. */
+TEST(ReuseDistCalcTest, Sampled)
+{
+    ReuseDistCalc calc(0.25);
+    const Addr lines = 4096;
+
+    size_t sampled = 0;
+    for (Addr addr = 0; addr < lines; addr++) {
+        if (calc.sampled(addr)) {
+            calc.calcStackDistAndUpdate(addr);
+            sampled++;
+        }
+    }
+    EXPECT_NEAR(lines / 4, sampled, lines / 16);
+
+    for (Addr addr = 0; addr < lines; addr++) {
+        if (calc.sampled(addr)) {
+            EXPECT_EQ((sampled - 1) * 4,
+                      calc.calcStackDistAndUpdate(addr).first);
+        }
+    }
+}
+
+TEST(ReuseDistCalcTest, BadRate)
+{
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(ReuseDistCalc calc(0.0));
+    EXPECT_NE(gtestLogOutput.str().find("is not in (0, 1]"),
+              std::string::npos);
+}
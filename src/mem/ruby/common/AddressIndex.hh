@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_COMMON_ADDRESSINDEX_HH__
+#define __MEM_RUBY_COMMON_ADDRESSINDEX_HH__
+
+#include <cstddef>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * Open-addressing hash table that maps line addresses to small integer
+ * values, such as the slot where the structure indexed by the address
+ * keeps its data. It uses linear probing over a power of two number of
+ * slots, at least twice the maximum number of addresses it has to hold,
+ * so that lookups rarely touch more than one cache line. The table never
+ * grows: the owner must not insert more addresses than it was sized for.
+ */
+class AddressIndex
+{
+  public:
+    void
+    init(std::size_t max_entries)
+    {
+        std::size_t size = 2;
+        m_shift = 63;
+        while (size < 2 * max_entries) {
+            size <<= 1;
+            m_shift--;
+        }
+        m_slots.assign(size, Slot());
+        m_mask = size - 1;
+    }
+
+    /** Returns the value of the address, or -1 if it is not present */
+    int
+    find(Addr addr) const
+    {
+        for (std::size_t i = home(addr); ; i = (i + 1) & m_mask) {
+            if (m_slots[i].tag == addr)
+                return m_slots[i].value;
+            if (m_slots[i].tag == EmptyTag)
+                return -1;
+        }
+    }
+
+    /** Maps the address to value, replacing its previous value if any */
+    void
+    insert(Addr addr, int value)
+    {
+        std::size_t i = home(addr);
+        while (m_slots[i].tag != EmptyTag && m_slots[i].tag != addr)
+            i = (i + 1) & m_mask;
+        m_slots[i].tag = addr;
+        m_slots[i].value = value;
+    }
+
+    void
+    erase(Addr addr)
+    {
+        std::size_t hole = home(addr);
+        while (m_slots[hole].tag != addr) {
+            if (m_slots[hole].tag == EmptyTag)
+                return;
+            hole = (hole + 1) & m_mask;
+        }
+
+        // Shift back the following entries of the probe sequence that
+        // would not be reachable any more once the hole is emptied
+        for (std::size_t i = (hole + 1) & m_mask;
+             m_slots[i].tag != EmptyTag; i = (i + 1) & m_mask) {
+            std::size_t ideal = home(m_slots[i].tag);
+            if (((i - ideal) & m_mask) >= ((i - hole) & m_mask)) {
+                m_slots[hole] = m_slots[i];
+                hole = i;
+            }
+        }
+        m_slots[hole] = Slot();
+    }
+
+  private:
+    static constexpr Addr EmptyTag = MaxAddr;
+
+    struct Slot
+    {
+        Addr tag = EmptyTag;
+        int value = -1;
+    };
+
+    std::size_t
+    home(Addr addr) const
+    {
+        // Fibonacci hashing spreads the line addresses, whose low bits
+        // are all zero, over the whole table
+        return (addr * 0x9e3779b97f4a7c15ULL) >> m_shift;
+    }
+
+    std::vector<Slot> m_slots;
+    std::size_t m_mask = 0;
+    int m_shift = 63;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_ADDRESSINDEX_HH__
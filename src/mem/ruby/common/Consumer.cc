@@ -40,6 +40,9 @@
 
 #include "mem/ruby/common/Consumer.hh"
 
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+
 namespace gem5
 {
 
@@ -47,23 +50,88 @@ namespace ruby
 {
 
 Consumer::Consumer(ClockedObject *_em, Event::Priority ev_prio)
-    : m_wakeup_event([this]{ processCurrentEvent(); },
+    : m_window_mask(0), m_window_start(0), m_window_period(0),
+      m_wakeup_event([this]{ processCurrentEvent(); },
                     "Consumer Event", false, ev_prio),
       em(_em)
 { }
 
+bool
+Consumer::alreadyScheduled(Tick time) const
+{
+    int slot;
+    if (windowSlot(time, slot) && bits(m_window_mask, slot))
+        return true;
+    return m_far_wakeup_ticks.find(time) != m_far_wakeup_ticks.end();
+}
+
+bool
+Consumer::windowSlot(Tick when, int &slot) const
+{
+    if (m_window_period == 0 || when < m_window_start)
+        return false;
+
+    Tick offset = when - m_window_start;
+    if (offset % m_window_period != 0 ||
+        offset / m_window_period >= WakeupWindowSize) {
+        return false;
+    }
+
+    slot = offset / m_window_period;
+    return true;
+}
+
+void
+Consumer::addWakeup(Tick when)
+{
+    // start a new window at the current clock edge when the previous one
+    // has no more pending wakeups
+    if (m_window_mask == 0) {
+        m_window_start = em->clockEdge();
+        m_window_period = em->clockPeriod();
+    }
+
+    // wakeups that are too far away, or that are not aligned to the
+    // window, e.g. after a change of the clock period, are kept aside
+    int slot;
+    if (m_window_period == em->clockPeriod() && windowSlot(when, slot)) {
+        m_window_mask |= 1ULL << slot;
+    } else {
+        m_far_wakeup_ticks.insert(when);
+    }
+}
+
+Tick
+Consumer::nextWakeup(Tick from) const
+{
+    Tick next = MaxTick;
+
+    uint64_t pending = m_window_mask;
+    if (pending && from > m_window_start) {
+        Tick skip = divCeil(from - m_window_start, m_window_period);
+        pending = skip >= WakeupWindowSize ? 0 : pending & ~mask(skip);
+    }
+    if (pending)
+        next = m_window_start + findLsbSet(pending) * m_window_period;
+
+    auto it = m_far_wakeup_ticks.lower_bound(from);
+    if (it != m_far_wakeup_ticks.end() && *it < next)
+        next = *it;
+
+    return next;
+}
+
 void
 Consumer::scheduleEvent(Cycles timeDelta)
 {
-    m_wakeup_ticks.insert(em->clockEdge(timeDelta));
+    addWakeup(em->clockEdge(timeDelta));
     scheduleNextWakeup();
 }
 
 void
 Consumer::scheduleEventAbsolute(Tick evt_time)
 {
-    m_wakeup_ticks.insert(
-        divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
+    addWakeup(divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
     scheduleNextWakeup();
 }
 
@@ -71,9 +139,8 @@ void
 Consumer::scheduleNextWakeup()
 {
     // look for the next tick in the future to schedule
-    auto it = m_wakeup_ticks.lower_bound(em->clockEdge());
-    if (it != m_wakeup_ticks.end()) {
-        Tick when = *it;
+    Tick when = nextWakeup(em->clockEdge());
+    if (when != MaxTick) {
         assert(when >= em->clockEdge());
         if (m_wakeup_event.scheduled() && (when < m_wakeup_event.when()))
             em->reschedule(m_wakeup_event, when, true);
@@ -85,12 +152,19 @@ Consumer::scheduleNextWakeup()
 void
 Consumer::processCurrentEvent()
 {
-    auto curr = m_wakeup_ticks.begin();
-    assert(em->clockEdge() == *curr);
+    Tick curr = em->clockEdge();
+    assert(nextWakeup(0) == curr);
 
-    // remove the current tick from the wakeup list, wake up, and then schedule
-    // the next wakeup
-    m_wakeup_ticks.erase(curr);
+    // remove the current tick from the wakeup list, sliding the window
+    // past it, wake up, and then schedule the next wakeup
+    int slot;
+    if (windowSlot(curr, slot) && bits(m_window_mask, slot)) {
+        int shift = slot + 1;
+        m_window_mask = shift >= WakeupWindowSize ? 0 :
+            m_window_mask >> shift;
+        m_window_start += shift * m_window_period;
+    }
+    m_far_wakeup_ticks.erase(curr);
     wakeup();
     scheduleNextWakeup();
 }
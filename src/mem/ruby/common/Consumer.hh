@@ -72,11 +72,7 @@ class Consumer
     virtual void print(std::ostream& out) const = 0;
     virtual void storeEventInfo(int info) {}
 
-    bool
-    alreadyScheduled(Tick time)
-    {
-        return m_wakeup_ticks.find(time) != m_wakeup_ticks.end();
-    }
+    bool alreadyScheduled(Tick time) const;
 
     ClockedObject *
     getObject()
@@ -88,10 +84,40 @@ class Consumer
     void scheduleEvent(Cycles timeDelta);
 
   private:
-    std::set<Tick> m_wakeup_ticks;
+    /** Number of clock periods covered by the wakeup window */
+    static constexpr int WakeupWindowSize = 64;
+
+    /**
+     * Pending wakeups in the window of WakeupWindowSize clock periods
+     * starting at m_window_start, bit i standing for the tick
+     * m_window_start + i * m_window_period. Almost all wakeups are a few
+     * cycles away, so keeping them in a bitmap lets them be scheduled
+     * and deduplicated without allocating.
+     */
+    uint64_t m_window_mask;
+    Tick m_window_start;
+    Tick m_window_period;
+    /** Pending wakeups that do not fit in the window */
+    std::set<Tick> m_far_wakeup_ticks;
+
     EventFunctionWrapper m_wakeup_event;
     ClockedObject *em;
 
+    /**
+     * Find the slot of a tick in the wakeup window.
+     *
+     * @param when The tick to look for.
+     * @param slot Set to the slot of the tick, if it is in the window.
+     * @return Whether the tick is in the window.
+     */
+    bool windowSlot(Tick when, int &slot) const;
+
+    /** Record a pending wakeup at the given tick */
+    void addWakeup(Tick when);
+
+    /** Get the earliest pending wakeup at or after a tick, or MaxTick */
+    Tick nextWakeup(Tick from) const;
+
     void scheduleNextWakeup();
     void processCurrentEvent();
 };
@@ -40,6 +40,10 @@
 
 #include "mem/ruby/common/DataBlock.hh"
 
+#include <cstring>
+#include <new>
+#include <vector>
+
 #include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
@@ -49,27 +53,84 @@ namespace gem5
 namespace ruby
 {
 
-DataBlock::DataBlock(const DataBlock &cp)
+namespace
+{
+
+// Buffers released to the pool, kept per thread so that the objects
+// simulated by each thread allocate and free blocks without locking
+thread_local std::vector<uint8_t *> freeBuffers;
+
+} // anonymous namespace
+
+uint8_t *
+DataBlock::allocBuffer()
 {
-    uint8_t *block_update;
     size_t block_bytes = RubySystem::getBlockSizeBytes();
-    m_data = new uint8_t[block_bytes];
-    memcpy(m_data, cp.m_data, block_bytes);
+    uint8_t *data;
+    if (!freeBuffers.empty() &&
+        header(freeBuffers.back())->size == block_bytes) {
+        data = freeBuffers.back();
+        freeBuffers.pop_back();
+    } else {
+        uint8_t *raw = static_cast<uint8_t *>(::operator new(
+            BufferAlign + block_bytes, std::align_val_t(BufferAlign)));
+        data = raw + BufferAlign;
+        new (header(data)) BufferHeader;
+        header(data)->size = block_bytes;
+    }
+    header(data)->refs.store(1, std::memory_order_relaxed);
+    return data;
+}
+
+void
+DataBlock::releaseBuffer(const uint8_t *data)
+{
+    BufferHeader *hdr = header(data);
+    if (hdr->refs.fetch_sub(1, std::memory_order_acq_rel) > 1)
+        return;
+
+    if (hdr->size == RubySystem::getBlockSizeBytes()) {
+        freeBuffers.push_back(const_cast<uint8_t *>(data));
+    } else {
+        hdr->~BufferHeader();
+        ::operator delete(hdr, std::align_val_t(BufferAlign));
+    }
+}
+
+void
+DataBlock::unshare(bool preserve)
+{
+    uint8_t *data = allocBuffer();
+    if (preserve)
+        memcpy(data, m_data, RubySystem::getBlockSizeBytes());
+    releaseBuffer(m_data);
+    m_data = data;
+}
+
+DataBlock::DataBlock(const DataBlock &cp)
+{
+    if (cp.m_alloc) {
+        m_data = cp.m_data;
+        shareBuffer(m_data);
+    } else {
+        // blocks assigned an external storage do not share it
+        m_data = allocBuffer();
+        memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
+    }
     m_alloc = true;
     // If this data block is involved in an atomic operation, the effect
     // of applying the atomic operations on the data block are recorded in
     // m_atomicLog. If so, we must copy over every entry in the change log
-    for (size_t i = 0; i < cp.m_atomicLog.size(); i++) {
-        block_update = new uint8_t[block_bytes];
-        memcpy(block_update, cp.m_atomicLog[i], block_bytes);
-        m_atomicLog.push_back(block_update);
+    for (auto log : cp.m_atomicLog) {
+        shareBuffer(log);
+        m_atomicLog.push_back(log);
     }
 }
 
 void
 DataBlock::alloc()
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
+    m_data = allocBuffer();
     m_alloc = true;
     clear();
 }
@@ -77,6 +138,7 @@ DataBlock::alloc()
 void
 DataBlock::clear()
 {
+    makeWritable(false);
     memset(m_data, 0, RubySystem::getBlockSizeBytes());
 }
 
@@ -85,14 +147,15 @@ DataBlock::equal(const DataBlock& obj) const
 {
     size_t block_bytes = RubySystem::getBlockSizeBytes();
     // Check that the block contents match
-    if (memcmp(m_data, obj.m_data, block_bytes)) {
+    if (m_data != obj.m_data && memcmp(m_data, obj.m_data, block_bytes)) {
         return false;
     }
     if (m_atomicLog.size() != obj.m_atomicLog.size()) {
         return false;
     }
     for (size_t i = 0; i < m_atomicLog.size(); i++) {
-        if (memcmp(m_atomicLog[i], obj.m_atomicLog[i], block_bytes)) {
+        if (m_atomicLog[i] != obj.m_atomicLog[i] &&
+            memcmp(m_atomicLog[i], obj.m_atomicLog[i], block_bytes)) {
             return false;
         }
     }
@@ -102,10 +165,14 @@ DataBlock::equal(const DataBlock& obj) const
 void
 DataBlock::copyPartial(const DataBlock &dblk, const WriteMask &mask)
 {
-    for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
-        if (mask.getMask(i, 1)) {
-            m_data[i] = dblk.m_data[i];
-        }
+    makeWritable();
+    const int size = RubySystem::getBlockSizeBytes();
+    // Copy the runs of set bytes in one go.
+    for (int i = mask.firstBitSet(true); i < size;
+            i = mask.firstBitSet(true, i)) {
+        const int end = mask.firstBitSet(false, i);
+        memcpy(&m_data[i], &dblk.m_data[i], end - i);
+        i = end;
     }
 }
 
@@ -113,6 +180,7 @@ void
 DataBlock::atomicPartial(const DataBlock &dblk, const WriteMask &mask,
         bool isAtomicNoReturn)
 {
+    makeWritable(false);
     for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
         m_data[i] = dblk.m_data[i];
     }
@@ -136,19 +204,24 @@ DataBlock::numAtomicLogEntries() const
 {
     return m_atomicLog.size();
 }
-uint8_t*
+const uint8_t*
+DataBlock::atomicLogEntryFront() const
+{
+    assert(m_atomicLog.size() > 0);
+    return m_atomicLog.front();
+}
+void
 DataBlock::popAtomicLogEntryFront()
 {
     assert(m_atomicLog.size() > 0);
-    auto ret = m_atomicLog.front();
+    releaseBuffer(m_atomicLog.front());
     m_atomicLog.pop_front();
-    return ret;
 }
 void
 DataBlock::clearAtomicLogEntries()
 {
     for (auto log : m_atomicLog) {
-        delete [] log;
+        releaseBuffer(log);
     }
     m_atomicLog.clear();
 }
@@ -163,12 +236,14 @@ DataBlock::getData(int offset, int len) const
 uint8_t*
 DataBlock::getDataMod(int offset)
 {
+    makeWritable();
     return &m_data[offset];
 }
 
 void
 DataBlock::setData(const uint8_t *data, int offset, int len)
 {
+    makeWritable(offset != 0 || len != RubySystem::getBlockSizeBytes());
     memcpy(&m_data[offset], data, len);
 }
 
@@ -177,23 +252,35 @@ DataBlock::setData(PacketPtr pkt)
 {
     int offset = getOffset(pkt->getAddr());
     assert(offset + pkt->getSize() <= RubySystem::getBlockSizeBytes());
+    makeWritable();
     pkt->writeData(&m_data[offset]);
 }
 
 DataBlock &
 DataBlock::operator=(const DataBlock & obj)
 {
-    uint8_t *block_update;
-    size_t block_bytes = RubySystem::getBlockSizeBytes();
-    // Copy entire block contents from obj to current block
-    memcpy(m_data, obj.m_data, block_bytes);
+    if (this == &obj)
+        return *this;
+
+    if (m_alloc && obj.m_alloc) {
+        // Share the block contents of obj
+        if (m_data != obj.m_data) {
+            shareBuffer(obj.m_data);
+            releaseBuffer(m_data);
+            m_data = obj.m_data;
+        }
+    } else {
+        // Copy entire block contents from obj to current block, which is
+        // the only option when either of them uses an external storage
+        makeWritable(false);
+        memcpy(m_data, obj.m_data, RubySystem::getBlockSizeBytes());
+    }
     // If this data block is involved in an atomic operation, the effect
     // of applying the atomic operations on the data block are recorded in
     // m_atomicLog. If so, we must copy over every entry in the change log
-    for (size_t i = 0; i < obj.m_atomicLog.size(); i++) {
-        block_update = new uint8_t[block_bytes];
-        memcpy(block_update, obj.m_atomicLog[i], block_bytes);
-        m_atomicLog.push_back(block_update);
+    for (auto log : obj.m_atomicLog) {
+        shareBuffer(log);
+        m_atomicLog.push_back(log);
     }
     return *this;
 }
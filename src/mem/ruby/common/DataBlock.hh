@@ -43,6 +43,7 @@
 
 #include <inttypes.h>
 
+#include <atomic>
 #include <cassert>
 #include <deque>
 #include <iomanip>
@@ -58,6 +59,16 @@ namespace ruby
 
 class WriteMask;
 
+/**
+ * The data of a cache block.
+ *
+ * The storage of the blocks comes from a pool of 64-byte aligned buffers
+ * that are shared copy-on-write: copying a block, e.g. from a message to
+ * a TBE and then to a cache entry, only shares its buffer, and a private
+ * copy is made the first time one of the sharers modifies the data. The
+ * entries of the atomic log are buffers of the same pool, and are shared
+ * as well since they are never modified.
+ */
 class DataBlock
 {
   public:
@@ -71,12 +82,12 @@ class DataBlock
     ~DataBlock()
     {
         if (m_alloc)
-            delete [] m_data;
+            releaseBuffer(m_data);
 
         // If data block involved in atomic
         // operations, free all meta data
         for (auto log : m_atomicLog) {
-            delete [] log;
+            releaseBuffer(log);
         }
     }
 
@@ -84,12 +95,24 @@ class DataBlock
 
     void assign(uint8_t *data);
 
+    /**
+     * Get a buffer of the size of a block from the pool. The buffer holds
+     * one reference, owned by the caller.
+     */
+    static uint8_t *allocBuffer();
+
     void clear();
     uint8_t getByte(int whichByte) const;
     const uint8_t *getData(int offset, int len) const;
-    uint8_t* popAtomicLogEntryFront();
+    const uint8_t *atomicLogEntryFront() const;
+    void popAtomicLogEntryFront();
     int numAtomicLogEntries() const;
     void clearAtomicLogEntries();
+
+    /**
+     * Get a pointer to modify the data of the block. The pointer is only
+     * valid until the block is copied or assigned to another block.
+     */
     uint8_t *getDataMod(int offset);
     void setByte(int whichByte, uint8_t data);
     void setData(const uint8_t *data, int offset, int len);
@@ -102,6 +125,47 @@ class DataBlock
     void print(std::ostream& out) const;
 
   private:
+    /** Header that precedes the data of the buffers of the pool */
+    struct BufferHeader
+    {
+        // Blocks may be shared by objects simulated by different threads
+        std::atomic<int> refs;
+        size_t size;
+    };
+
+    /** Alignment of the data, as well as the space left for the header */
+    static constexpr size_t BufferAlign = 64;
+    static_assert(sizeof(BufferHeader) <= BufferAlign);
+
+    static BufferHeader *
+    header(const uint8_t *data)
+    {
+        return reinterpret_cast<BufferHeader *>(
+                const_cast<uint8_t *>(data) - BufferAlign);
+    }
+
+    static void
+    shareBuffer(const uint8_t *data)
+    {
+        header(data)->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void releaseBuffer(const uint8_t *data);
+
+    // Make sure the data is not shared with other blocks before it is
+    // modified. If preserve is false, the contents of a new private
+    // buffer are left undefined.
+    void
+    makeWritable(bool preserve = true)
+    {
+        if (m_alloc &&
+            header(m_data)->refs.load(std::memory_order_acquire) > 1) {
+            unshare(preserve);
+        }
+    }
+
+    void unshare(bool preserve);
+
     void alloc();
     uint8_t *m_data;
     bool m_alloc;
@@ -115,7 +179,7 @@ DataBlock::assign(uint8_t *data)
 {
     assert(data != NULL);
     if (m_alloc) {
-        delete [] m_data;
+        releaseBuffer(m_data);
     }
     m_data = data;
     m_alloc = false;
@@ -130,6 +194,7 @@ DataBlock::getByte(int whichByte) const
 inline void
 DataBlock::setByte(int whichByte, uint8_t data)
 {
+    makeWritable();
     m_data[whichByte] = data;
 }
 
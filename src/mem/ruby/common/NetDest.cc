@@ -38,63 +38,69 @@ namespace ruby
 
 NetDest::NetDest()
 {
-  resize();
+    m_bits.fill(0);
 }
 
 void
 NetDest::add(MachineID newElement)
 {
-    assert(bitIndex(newElement.num) < m_bits[vecIndex(newElement)].getSize());
-    m_bits[vecIndex(newElement)].add(bitIndex(newElement.num));
+    int index = bitIndex(newElement);
+    m_bits[index / 64] |= 1ULL << (index % 64);
 }
 
 void
 NetDest::addNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].addSet(netDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        m_bits[i] |= netDest.m_bits[i];
     }
 }
 
 void
 NetDest::setNetDest(MachineType machine, const Set& set)
 {
-    // assure that there is only one set of destinations for this machine
-    assert(MachineType_base_level((MachineType)(machine + 1)) -
-           MachineType_base_level(machine) == 1);
-    m_bits[MachineType_base_level(machine)] = set;
+    for (NodeID j = 0; j < MachineType_base_count(machine); j++) {
+        MachineID mach = {machine, j};
+        if (set.isElement(j))
+            add(mach);
+        else
+            remove(mach);
+    }
 }
 
 void
 NetDest::remove(MachineID oldElement)
 {
-    m_bits[vecIndex(oldElement)].remove(bitIndex(oldElement.num));
+    int index = bitIndex(oldElement);
+    m_bits[index / 64] &= ~(1ULL << (index % 64));
 }
 
 void
 NetDest::removeNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].removeSet(netDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        m_bits[i] &= ~netDest.m_bits[i];
     }
 }
 
 void
 NetDest::clear()
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].clear();
-    }
+    m_bits.fill(0);
 }
 
 void
 NetDest::broadcast()
 {
-    for (MachineType machine = MachineType_FIRST;
-         machine < MachineType_NUM; ++machine) {
-        broadcast(machine);
+    int num_machines = MachineType_base_number(MachineType_NUM);
+    for (int i = 0; i < NumWords; i++) {
+        int first = i * 64;
+        if (num_machines >= first + 64)
+            m_bits[i] = ~0ULL;
+        else if (num_machines > first)
+            m_bits[i] = mask(num_machines - first);
+        else
+            m_bits[i] = 0;
     }
 }
 
@@ -109,17 +115,12 @@ NetDest::broadcast(MachineType machineType)
 
 //For Princeton Network
 std::vector<NodeID>
-NetDest::getAllDest()
+NetDest::getAllDest() const
 {
     std::vector<NodeID> dest;
-    dest.clear();
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                int id = MachineType_base_number((MachineType)i) + j;
-                dest.push_back((NodeID)id);
-            }
-        }
+    dest.reserve(count());
+    for (NodeID id = nextDest(0); id < MaxMachines; id = nextDest(id + 1)) {
+        dest.push_back(id);
     }
     return dest;
 }
@@ -128,8 +129,8 @@ int
 NetDest::count() const
 {
     int counter = 0;
-    for (int i = 0; i < m_bits.size(); i++) {
-        counter += m_bits[i].count();
+    for (int i = 0; i < NumWords; i++) {
+        counter += popCount(m_bits[i]);
     }
     return counter;
 }
@@ -137,33 +138,34 @@ NetDest::count() const
 NodeID
 NetDest::elementAt(MachineID index)
 {
-    return m_bits[vecIndex(index)].elementAt(bitIndex(index.num));
+    return isElement(index);
 }
 
 MachineID
 NetDest::smallestElement() const
 {
-    assert(count() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (NodeID j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                MachineID mach = {MachineType_from_base_level(i), j};
-                return mach;
-            }
+    NodeID id = nextDest(0);
+    panic_if(id == MaxMachines, "No smallest element of an empty set.");
+
+    for (MachineType machine = MachineType_FIRST;
+         machine < MachineType_NUM; ++machine) {
+        NodeID base = MachineType_base_number(machine);
+        if (id < base + MachineType_base_count(machine)) {
+            MachineID mach = {machine, id - base};
+            return mach;
         }
     }
-    panic("No smallest element of an empty set.");
+    panic("Destination %d does not belong to any machine.", id);
 }
 
 MachineID
 NetDest::smallestElement(MachineType machine) const
 {
-    int size = m_bits[MachineType_base_level(machine)].getSize();
-    for (NodeID j = 0; j < size; j++) {
-        if (m_bits[MachineType_base_level(machine)].isElement(j)) {
-            MachineID mach = {machine, j};
-            return mach;
-        }
+    NodeID base = MachineType_base_number(machine);
+    NodeID id = nextDest(base);
+    if (id < base + MachineType_base_count(machine)) {
+        MachineID mach = {machine, id - base};
+        return mach;
     }
 
     panic("No smallest element of given MachineType.");
@@ -173,20 +175,15 @@ NetDest::smallestElement(MachineType machine) const
 bool
 NetDest::isBroadcast() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isBroadcast()) {
-            return false;
-        }
-    }
-    return true;
+    return count() == MachineType_base_number(MachineType_NUM);
 }
 
 // Returns true iff no bits are set
 bool
 NetDest::isEmpty() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isEmpty()) {
+    for (int i = 0; i < NumWords; i++) {
+        if (m_bits[i]) {
             return false;
         }
     }
@@ -197,10 +194,9 @@ NetDest::isEmpty() const
 NetDest
 NetDest::OR(const NetDest& orNetDest) const
 {
-    assert(m_bits.size() == orNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].OR(orNetDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        result.m_bits[i] = m_bits[i] | orNetDest.m_bits[i];
     }
     return result;
 }
@@ -209,10 +205,9 @@ NetDest::OR(const NetDest& orNetDest) const
 NetDest
 NetDest::AND(const NetDest& andNetDest) const
 {
-    assert(m_bits.size() == andNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].AND(andNetDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        result.m_bits[i] = m_bits[i] & andNetDest.m_bits[i];
     }
     return result;
 }
@@ -221,53 +216,56 @@ NetDest::AND(const NetDest& andNetDest) const
 bool
 NetDest::intersectionIsNotEmpty(const NetDest& other_netDest) const
 {
-    assert(m_bits.size() == other_netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].intersectionIsEmpty(other_netDest.m_bits[i])) {
-            return true;
-        }
+    uint64_t common = 0;
+    for (int i = 0; i < NumWords; i++) {
+        common |= m_bits[i] & other_netDest.m_bits[i];
     }
-    return false;
+    return common != 0;
 }
 
+// Returns true if the intersection of the two sets is empty
 bool
-NetDest::isSuperset(const NetDest& test) const
+NetDest::intersectionIsEmpty(const NetDest& other_netDest) const
 {
-    assert(m_bits.size() == test.getSize());
+    return !intersectionIsNotEmpty(other_netDest);
+}
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isSuperset(test.m_bits[i])) {
-            return false;
-        }
+bool
+NetDest::isSuperset(const NetDest& test) const
+{
+    uint64_t missing = 0;
+    for (int i = 0; i < NumWords; i++) {
+        missing |= test.m_bits[i] & ~m_bits[i];
     }
-    return true;
+    return missing == 0;
 }
 
 bool
 NetDest::isElement(MachineID element) const
 {
-    return ((m_bits[vecIndex(element)])).isElement(bitIndex(element.num));
+    return test(bitIndex(element));
 }
 
 void
 NetDest::resize()
 {
-    m_bits.resize(MachineType_base_level(MachineType_NUM));
-    assert(m_bits.size() == MachineType_NUM);
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].setSize(MachineType_base_count((MachineType)i));
-    }
+    fatal_if(MachineType_base_number(MachineType_NUM) > MaxMachines,
+             "Number of machines (%d) exceeds the size of NetDest (%d). "
+             "Increase NUMBER_BITS_PER_SET and recompile.\n",
+             MachineType_base_number(MachineType_NUM), MaxMachines);
+    clear();
 }
 
 void
 NetDest::print(std::ostream& out) const
 {
-    out << "[NetDest (" << m_bits.size() << ") ";
+    out << "[NetDest (" << MachineType_NUM << ") ";
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            out << (bool) m_bits[i].isElement(j) << " ";
+    for (MachineType machine = MachineType_FIRST;
+         machine < MachineType_NUM; ++machine) {
+        NodeID base = MachineType_base_number(machine);
+        for (NodeID j = 0; j < MachineType_base_count(machine); j++) {
+            out << test(base + j) << " ";
         }
         out << " - ";
     }
@@ -277,12 +275,7 @@ NetDest::print(std::ostream& out) const
 bool
 NetDest::isEqual(const NetDest& n) const
 {
-    assert(m_bits.size() == n.m_bits.size());
-    for (unsigned int i = 0; i < m_bits.size(); ++i) {
-        if (!m_bits[i].isEqual(n.m_bits[i]))
-            return false;
-    }
-    return true;
+    return m_bits == n.m_bits;
 }
 
 } // namespace ruby
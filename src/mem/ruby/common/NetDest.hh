@@ -29,9 +29,12 @@
 #ifndef __MEM_RUBY_COMMON_NETDEST_HH__
 #define __MEM_RUBY_COMMON_NETDEST_HH__
 
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "mem/ruby/common/Set.hh"
 #include "mem/ruby/common/MachineID.hh"
 
@@ -42,9 +45,18 @@ namespace ruby
 {
 
 // NetDest specifies the network destination of a Message
+//
+// The destinations of all the machine types are kept in a single, inline
+// bitmap indexed by the NodeID of the machines (see
+// MachineType_base_number), so destinations are copied with the messages
+// without any allocation, and set operations work on whole words.
 class NetDest
 {
   public:
+    // Maximum number of machines of all types, the bitmap being sized at
+    // build time as if every machine type had NUMBER_BITS_PER_SET machines
+    static constexpr int MaxMachines = NUMBER_BITS_PER_SET * MachineType_NUM;
+
     // Constructors
     // creates and empty set
     NetDest();
@@ -85,13 +97,36 @@ class NetDest
     bool isEmpty() const;
 
     // For Princeton Network
-    std::vector<NodeID> getAllDest();
+    std::vector<NodeID> getAllDest() const;
+
+    // Returns the smallest NodeID of a destination that is >= from, or
+    // MaxMachines if there is none. Iterating over the destinations this
+    // way does not allocate, unlike getAllDest().
+    NodeID
+    nextDest(NodeID from) const
+    {
+        for (int i = from / 64; i < NumWords; i++) {
+            uint64_t word = m_bits[i];
+            if (i == from / 64)
+                word &= ~mask(from % 64);
+            if (word)
+                return i * 64 + findLsbSet(word);
+        }
+        return MaxMachines;
+    }
+
+    // Whether the machine with this NodeID is in the set
+    bool
+    hasNode(NodeID id) const
+    {
+        assert(id < MaxMachines);
+        return test(id);
+    }
 
     MachineID smallestElement() const;
     MachineID smallestElement(MachineType machine) const;
 
     void resize();
-    int getSize() const { return m_bits.size(); }
 
     // get element for a index
     NodeID elementAt(MachineID index);
@@ -99,19 +134,25 @@ class NetDest
     void print(std::ostream& out) const;
 
   private:
-    // returns a value >= MachineType_base_level("this machine")
-    // and < MachineType_base_level("next highest machine")
+    static constexpr int NumWords = (MaxMachines + 63) / 64;
+
+    // returns the position of a machine in the bitmap, i.e. its NodeID
     int
-    vecIndex(MachineID m) const
+    bitIndex(MachineID m) const
     {
-        int vec_index = MachineType_base_level(m.type);
-        assert(vec_index < m_bits.size());
-        return vec_index;
+        assert(m.num < MachineType_base_count(m.type));
+        int index = MachineType_base_number(m.type) + m.num;
+        assert(index < MaxMachines);
+        return index;
     }
 
-    NodeID bitIndex(NodeID index) const { return index; }
+    bool
+    test(int index) const
+    {
+        return (m_bits[index / 64] >> (index % 64)) & 1;
+    }
 
-    std::vector<Set> m_bits;  // a vector of bit vectors - i.e. Sets
+    std::array<uint64_t, NumWords> m_bits;
 };
 
 inline std::ostream&
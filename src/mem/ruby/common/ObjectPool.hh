@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_COMMON_OBJECTPOOL_HH__
+#define __MEM_RUBY_COMMON_OBJECTPOOL_HH__
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * Pool of the storage of objects of type T. Ruby allocates and frees
+ * messages and cache entries at a very high rate, so these types use it
+ * as their allocator to reuse the storage of the objects no longer in
+ * use instead of going back to the heap for each of them. When the pool
+ * runs dry it is refilled with a slab of SlabSize contiguous objects.
+ * Slabs are kept for the lifetime of the simulation.
+ */
+template <class T>
+class ObjectPool
+{
+  public:
+    static constexpr std::size_t SlabSize = 64;
+
+    static void *
+    allocate(std::size_t size)
+    {
+        // classes derived from T that do not have a pool of their own
+        // get their storage from the heap
+        if (size != sizeof(T))
+            return ::operator new(size);
+
+        if (freeList.empty())
+            refill();
+
+        void *p = freeList.back();
+        freeList.pop_back();
+        return p;
+    }
+
+    static void
+    release(void *p, std::size_t size)
+    {
+        if (size != sizeof(T))
+            ::operator delete(p);
+        else
+            freeList.push_back(p);
+    }
+
+  private:
+    static void
+    refill()
+    {
+        char *slab = static_cast<char *>(::operator new(
+            sizeof(T) * SlabSize, std::align_val_t(alignof(T))));
+        // hand out the slab from its start so that objects allocated
+        // back to back are adjacent in memory
+        for (std::size_t i = SlabSize; i > 0; i--)
+            freeList.push_back(slab + (i - 1) * sizeof(T));
+    }
+
+    // Objects may be freed by another thread than the one that allocated
+    // them, so each thread keeps its own free list
+    static inline thread_local std::vector<void *> freeList;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_OBJECTPOOL_HH__
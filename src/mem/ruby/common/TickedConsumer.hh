@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_COMMON_TICKEDCONSUMER_HH__
+#define __MEM_RUBY_COMMON_TICKEDCONSUMER_HH__
+
+#include <iostream>
+
+#include "mem/ruby/common/Consumer.hh"
+#include "sim/ticked_object.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * Consumer that wakes up a sleeping Ticked object. Setting it as the
+ * consumer of the MessageBuffers a Ticked object reads from lets that
+ * object stop() whenever it runs out of work, and resume ticking on the
+ * clock edge at which the next message becomes ready.
+ */
+class TickedConsumer : public Consumer
+{
+  public:
+    TickedConsumer(ClockedObject *em, Ticked &_ticked)
+        : Consumer(em), ticked(_ticked)
+    {}
+
+    void wakeup() override { ticked.wakeupAt(curTick()); }
+
+    void
+    print(std::ostream &out) const override
+    {
+        out << "[TickedConsumer]";
+    }
+
+  private:
+    Ticked &ticked;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_TICKEDCONSUMER_HH__
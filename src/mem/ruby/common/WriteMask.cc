@@ -30,6 +30,7 @@
 
 #include <string>
 
+#include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
 namespace gem5
@@ -39,8 +40,7 @@ namespace ruby
 {
 
 WriteMask::WriteMask()
-    : mSize(RubySystem::getBlockSizeBytes()), mMask(mSize, false),
-      mAtomic(false)
+    : WriteMask(RubySystem::getBlockSizeBytes())
 {}
 
 void
@@ -48,7 +48,7 @@ WriteMask::print(std::ostream& out) const
 {
     std::string str(mSize,'0');
     for (int i = 0; i < mSize; i++) {
-        str[i] = mMask[i] ? ('1') : ('0');
+        str[i] = test(i) ? ('1') : ('0');
     }
     out << "dirty mask="
         << str
@@ -64,17 +64,19 @@ WriteMask::performAtomic(uint8_t * p,
     // Here, operations occur in FIFO order from the mAtomicOp
     // vector. This is done to match the ordering of packets
     // that was seen when the initial coalesced request was created.
-    for (int i = 0; i < mAtomicOp.size(); i++) {
+    const AtomicOpVector &ops = getAtomicOps();
+    for (int i = 0; i < ops.size(); i++) {
         if (!isAtomicNoReturn) {
             // Save the old value of the data block in case a
             // return value is needed
-            block_update = new uint8_t[mSize];
+            assert(mSize == RubySystem::getBlockSizeBytes());
+            block_update = DataBlock::allocBuffer();
             std::memcpy(block_update, p, mSize);
             log.push_back(block_update);
         }
         // Perform the atomic operation
-        offset = mAtomicOp[i].first;
-        AtomicOpFunctor *fnctr = mAtomicOp[i].second;
+        offset = ops[i].first;
+        AtomicOpFunctor *fnctr = ops[i].second;
         (*fnctr)(&p[offset]);
     }
 }
@@ -41,12 +41,18 @@
 #ifndef __MEM_RUBY_COMMON_WRITEMASK_HH__
 #define __MEM_RUBY_COMMON_WRITEMASK_HH__
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #include "base/amo.hh"
+#include "base/bitfield.hh"
+#include "base/logging.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/common/TypeDefines.hh"
 
@@ -56,24 +62,46 @@ namespace gem5
 namespace ruby
 {
 
+/**
+ * Byte mask of a cache block. The mask is kept inline as an array of
+ * 64 bit words, so it is cheap to copy into messages and TBEs and the
+ * set operations on it work a word at a time. Bits beyond the size of
+ * the mask are always cleared. The atomic operations, which few masks
+ * carry, are shared out of line.
+ */
 class WriteMask
 {
   public:
     typedef std::vector<std::pair<int, AtomicOpFunctor* >> AtomicOpVector;
 
+    /** Largest mask supported, in bytes */
+    static constexpr int MaxSize = 256;
+
     WriteMask();
 
     WriteMask(int size)
-      : mSize(size), mMask(size, false), mAtomic(false)
-    {}
+      : mSize(size), mMask{}, mAtomic(false)
+    {
+        panic_if(size > MaxSize,
+                 "WriteMask supports blocks of up to %d bytes, not %d.",
+                 MaxSize, size);
+    }
 
     WriteMask(int size, std::vector<bool> & mask)
-      : mSize(size), mMask(mask), mAtomic(false)
-    {}
+      : WriteMask(size)
+    {
+        const int len = std::min<int>(size, mask.size());
+        for (int i = 0; i < len; i++) {
+            if (mask[i])
+                mMask[i / WordBits] |= 1ULL << (i % WordBits);
+        }
+    }
 
     WriteMask(int size, std::vector<bool> &mask, AtomicOpVector atomicOp)
-      : mSize(size), mMask(mask), mAtomic(true), mAtomicOp(atomicOp)
-    {}
+      : WriteMask(size, mask)
+    {
+        setAtomicOps(atomicOp);
+    }
 
     ~WriteMask()
     {}
@@ -81,75 +109,77 @@ class WriteMask
     void
     clear()
     {
-        mMask = std::vector<bool>(mSize, false);
+        mMask.fill(0);
     }
 
     bool
     test(int offset) const
     {
         assert(offset < mSize);
-        return mMask[offset];
+        return (mMask[offset / WordBits] >> (offset % WordBits)) & 1;
     }
 
     void
     setMask(int offset, int len, bool val = true)
     {
         assert(mSize >= (offset + len));
-        for (int i = 0; i < len; i++) {
-            mMask[offset + i] = val;
+        for (int w = offset / WordBits; len > 0 && w * WordBits < offset + len;
+                w++) {
+            const uint64_t bits = rangeBits(w, offset, offset + len);
+            if (val)
+                mMask[w] |= bits;
+            else
+                mMask[w] &= ~bits;
         }
     }
+
     void
     fillMask()
     {
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = true;
-        }
+        for (int w = 0; w < numWords(); w++)
+            mMask[w] = validBits(w);
     }
 
     bool
     getMask(int offset, int len) const
     {
-        bool tmp = true;
         assert(mSize >= (offset + len));
-        for (int i = 0; i < len; i++) {
-            tmp = tmp & mMask.at(offset + i);
+        for (int w = offset / WordBits; len > 0 && w * WordBits < offset + len;
+                w++) {
+            const uint64_t bits = rangeBits(w, offset, offset + len);
+            if ((mMask[w] & bits) != bits)
+                return false;
         }
-        return tmp;
+        return true;
     }
 
     bool
     isOverlap(const WriteMask &readMask) const
     {
-        bool tmp = false;
         assert(mSize == readMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            if (readMask.mMask.at(i)) {
-                tmp = tmp | mMask.at(i);
-            }
+        for (int w = 0; w < numWords(); w++) {
+            if (mMask[w] & readMask.mMask[w])
+                return true;
         }
-        return tmp;
+        return false;
     }
 
     bool
     containsMask(const WriteMask &readMask) const
     {
-        bool tmp = true;
         assert(mSize == readMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            if (readMask.mMask.at(i)) {
-                tmp = tmp & mMask.at(i);
-            }
+        for (int w = 0; w < numWords(); w++) {
+            if (readMask.mMask[w] & ~mMask[w])
+                return false;
         }
-        return tmp;
+        return true;
     }
 
     bool isEmpty() const
     {
-        for (int i = 0; i < mSize; i++) {
-            if (mMask.at(i)) {
+        for (int w = 0; w < numWords(); w++) {
+            if (mMask[w])
                 return false;
-            }
         }
         return true;
     }
@@ -157,10 +187,9 @@ class WriteMask
     bool
     isFull() const
     {
-        for (int i = 0; i < mSize; i++) {
-            if (!mMask.at(i)) {
+        for (int w = 0; w < numWords(); w++) {
+            if (mMask[w] != validBits(w))
                 return false;
-            }
         }
         return true;
     }
@@ -169,9 +198,8 @@ class WriteMask
     andMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = (mMask.at(i)) && (writeMask.mMask.at(i));
-        }
+        for (int w = 0; w < numWords(); w++)
+            mMask[w] &= writeMask.mMask[w];
 
         if (writeMask.mAtomic) {
             mAtomic = true;
@@ -183,9 +211,8 @@ class WriteMask
     orMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = (mMask.at(i)) || (writeMask.mMask.at(i));
-        }
+        for (int w = 0; w < numWords(); w++)
+            mMask[w] |= writeMask.mMask[w];
 
         if (writeMask.mAtomic) {
             mAtomic = true;
@@ -197,17 +224,20 @@ class WriteMask
     setInvertedMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = !writeMask.mMask.at(i);
-        }
+        for (int w = 0; w < numWords(); w++)
+            mMask[w] = ~writeMask.mMask[w] & validBits(w);
     }
 
     int
     firstBitSet(bool val, int offset = 0) const
     {
-        for (int i = offset; i < mSize; ++i)
-            if (mMask[i] == val)
-                return i;
+        for (int w = offset / WordBits; w < numWords(); w++) {
+            uint64_t bits = (val ? mMask[w] : ~mMask[w]) & validBits(w);
+            if (w == offset / WordBits)
+                bits &= ~mask(offset % WordBits);
+            if (bits)
+                return w * WordBits + findLsbSet(bits);
+        }
         return mSize;
     }
 
@@ -215,8 +245,12 @@ class WriteMask
     count(int offset = 0) const
     {
         int count = 0;
-        for (int i = offset; i < mSize; ++i)
-            count += mMask[i];
+        for (int w = offset / WordBits; w < numWords(); w++) {
+            uint64_t bits = mMask[w];
+            if (w == offset / WordBits)
+                bits &= ~mask(offset % WordBits);
+            count += popCount(bits);
+        }
         return count;
     }
 
@@ -236,21 +270,44 @@ class WriteMask
     const AtomicOpVector&
     getAtomicOps() const
     {
-        return mAtomicOp;
+        static const AtomicOpVector noOps;
+        return mAtomicOp ? *mAtomicOp : noOps;
     }
 
     void
     setAtomicOps(const AtomicOpVector& atomicOps)
     {
         mAtomic = true;
-        mAtomicOp = std::move(atomicOps);
+        mAtomicOp = std::make_shared<const AtomicOpVector>(atomicOps);
     }
 
   private:
+    static constexpr int WordBits = 64;
+    static constexpr int NumWords = MaxSize / WordBits;
+
+    int numWords() const { return (mSize + WordBits - 1) / WordBits; }
+
+    /** The bits of word w which are within the mask */
+    uint64_t
+    validBits(int w) const
+    {
+        const int left = mSize - w * WordBits;
+        return left >= WordBits ? ~0ULL : mask(left);
+    }
+
+    /** The bits of word w which are within the byte range [lo, hi) */
+    static uint64_t
+    rangeBits(int w, int lo, int hi)
+    {
+        const int first = std::max(lo - w * WordBits, 0);
+        const int last = std::min(hi - w * WordBits, WordBits);
+        return mask(last) & ~mask(first);
+    }
+
     int mSize;
-    std::vector<bool> mMask;
+    std::array<uint64_t, NumWords> mMask;
     bool mAtomic;
-    AtomicOpVector mAtomicOp;
+    std::shared_ptr<const AtomicOpVector> mAtomicOp;
 };
 
 inline std::ostream&
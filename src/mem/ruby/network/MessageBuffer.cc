@@ -138,7 +138,7 @@ MessageBuffer::getSize(Tick curTime)
 {
     if (m_time_last_time_size_checked != curTime) {
         m_time_last_time_size_checked = curTime;
-        m_size_last_time_size_checked = m_prio_heap.size();
+        m_size_last_time_size_checked = numMessages();
     }
 
     return m_size_last_time_size_checked;
@@ -162,7 +162,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
 
     if (m_time_last_time_pop < current_time) {
         // no pops this cycle - heap and stall queue size is correct
-        current_size = m_prio_heap.size();
+        current_size = numMessages();
         current_stall_size = m_stall_map_size;
     } else {
         if (m_time_last_time_enqueue < current_time) {
@@ -185,7 +185,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
         DPRINTF(RubyQueue, "n: %d, current_size: %d, heap size: %d, "
                 "m_max_size: %d\n",
                 n, current_size + current_stall_size,
-                m_prio_heap.size(), m_max_size);
+                numMessages(), m_max_size);
         m_not_avail_count++;
         return false;
     }
@@ -195,7 +195,7 @@ const Message*
 MessageBuffer::peek() const
 {
     DPRINTF(RubyQueue, "Peeking at head of queue.\n");
-    const Message* msg_ptr = m_prio_heap.front().get();
+    const Message* msg_ptr = peekMsgPtr().get();
     assert(msg_ptr);
 
     DPRINTF(RubyQueue, "Message: %s\n", (*msg_ptr));
@@ -282,20 +282,47 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
     msg_ptr->setLastEnqueueTime(arrival_time);
     msg_ptr->setMsgCounter(m_msg_counter);
 
-    // Insert the message into the priority heap
-    m_prio_heap.push_back(message);
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
+            arrival_time, *msg_ptr);
+
+    // Messages sent by an object simulated on another event queue than
+    // the consumer are handed over to the consumer's queue. The latency of
+    // the buffer is the lookahead that keeps the two queues apart
+    assert(m_consumer != NULL);
+    EventQueue *consumer_eq = m_consumer->getObject()->eventQueue();
+    if (inParallelMode && consumer_eq != curEventQueue()) {
+        fatal_if(arrival_time < curTick() + simQuantum,
+                 "%s: Message from another event queue arrives after %d "
+                 "ticks, less than the simulation quantum of %d ticks.\n",
+                 name(), arrival_time - curTick(), simQuantum);
+        fatal_if(m_max_size != 0,
+                 "%s: Buffers between event queues must be infinite.\n",
+                 name());
+
+        auto *delivery = new EventFunctionWrapper(
+            [this, message, arrival_time]() mutable
+            {
+                acceptMessage(std::move(message), arrival_time);
+            },
+            name() + ".delivery", true, CrossQueueDeliveryPri);
+        consumer_eq->schedule(delivery, arrival_time);
+        return;
+    }
+
+    acceptMessage(std::move(message), arrival_time);
+}
+
+void
+MessageBuffer::acceptMessage(MsgPtr message, Tick arrival_time)
+{
+    insertMessage(std::move(message));
     // Increment the number of messages statistic
     m_buf_msgs++;
 
     assert((m_max_size == 0) ||
-           ((m_prio_heap.size() + m_stall_map_size) <= m_max_size));
-
-    DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
-            arrival_time, *(message.get()));
+           ((numMessages() + m_stall_map_size) <= m_max_size));
 
     // Schedule the wakeup
-    assert(m_consumer != NULL);
     m_consumer->scheduleEventAbsolute(arrival_time);
     m_consumer->storeEventInfo(m_vnet_id);
 }
@@ -307,7 +334,7 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     assert(isReady(current_time));
 
     // get MsgPtr of the message about to be dequeued
-    MsgPtr message = m_prio_heap.front();
+    const MsgPtr &message = peekMsgPtr();
 
     // get the delay cycles
     message->updateDelayedTicks(current_time);
@@ -316,15 +343,13 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     // record previous size and time so the current buffer size isn't
     // adjusted until schd cycle
     if (m_time_last_time_pop < current_time) {
-        m_size_at_cycle_start = m_prio_heap.size();
+        m_size_at_cycle_start = numMessages();
         m_stalled_at_cycle_start = m_stall_map_size;
         m_time_last_time_pop = current_time;
         m_dequeues_this_cy = 0;
     }
     ++m_dequeues_this_cy;
 
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
-    m_prio_heap.pop_back();
     if (decrement_messages) {
         // Record how much time is passed since the message was enqueued
         m_stall_time += curTick() - message->getLastEnqueueTime();
@@ -335,6 +360,8 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
         m_buf_msgs--;
     }
 
+    removeHead();
+
     // if a dequeue callback was requested, call it now
     if (m_dequeue_callback) {
         m_dequeue_callback();
@@ -358,7 +385,9 @@ MessageBuffer::unregisterDequeueCallback()
 void
 MessageBuffer::clear()
 {
+    m_msg_fifo.clear();
     m_prio_heap.clear();
+    updateOccupancyMask();
 
     m_msg_counter = 0;
     m_time_last_time_enqueue = 0;
@@ -373,33 +402,61 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 {
     DPRINTF(RubyQueue, "Recycling.\n");
     assert(isReady(current_time));
-    MsgPtr node = m_prio_heap.front();
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    MsgPtr node = removeHead();
 
     Tick future_time = current_time + recycle_latency;
     node->setLastEnqueueTime(future_time);
 
-    m_prio_heap.back() = node;
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    insertMessage(std::move(node));
     m_consumer->scheduleEventAbsolute(future_time);
 }
 
 void
-MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
+MessageBuffer::insertMessage(MsgPtr message)
 {
-    while (!lt.empty()) {
-        MsgPtr m = lt.front();
-        assert(m->getLastEnqueueTime() <= schdTick);
-
-        m_prio_heap.push_back(m);
+    // messages arriving in order are simply appended to the FIFO, only
+    // the ones that have to be reordered pay for the heap
+    if (m_msg_fifo.empty() || !(m_msg_fifo.back() > message)) {
+        m_msg_fifo.push_back(std::move(message));
+    } else {
+        m_prio_heap.push_back(std::move(message));
         push_heap(m_prio_heap.begin(), m_prio_heap.end(),
                   std::greater<MsgPtr>());
+    }
+    updateOccupancyMask();
+}
 
-        m_consumer->scheduleEventAbsolute(schdTick);
+MsgPtr
+MessageBuffer::removeHead()
+{
+    MsgPtr head;
+    if (headInHeap()) {
+        pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
+                 std::greater<MsgPtr>());
+        head = std::move(m_prio_heap.back());
+        m_prio_heap.pop_back();
+    } else {
+        head = std::move(m_msg_fifo.front());
+        m_msg_fifo.pop_front();
+    }
+    updateOccupancyMask();
+    return head;
+}
+
+void
+MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
+{
+    while (!lt.empty()) {
+        MsgPtr &m = lt.front();
+        assert(m->getLastEnqueueTime() <= schdTick);
 
         DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
             schdTick, *(m.get()));
 
+        insertMessage(std::move(m));
+
+        m_consumer->scheduleEventAbsolute(schdTick);
+
         lt.pop_front();
     }
 }
@@ -448,7 +505,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     DPRINTF(RubyQueue, "Stalling due to %#x\n", addr);
     assert(isReady(current_time));
     assert(getOffset(addr) == 0);
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = peekMsgPtr();
 
     // Since the message will just be moved to stall map, indicate that the
     // buffer should not decrement the m_buf_msgs statistic
@@ -459,7 +516,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     // Instead the controller is responsible to call reanalyzeMessages when
     // these addresses change state.
     //
-    (m_stall_msg_map[addr]).push_back(message);
+    (m_stall_msg_map[addr]).push_back(std::move(message));
     m_stall_map_size++;
     m_stall_count++;
 }
@@ -475,7 +532,7 @@ MessageBuffer::deferEnqueueingMessage(Addr addr, MsgPtr message)
 {
     DPRINTF(RubyQueue, "Deferring enqueueing message: %s, Address %#x\n",
             *(message.get()), addr);
-    (m_deferred_msg_map[addr]).push_back(message);
+    (m_deferred_msg_map[addr]).push_back(std::move(message));
 }
 
 void
@@ -486,8 +543,8 @@ MessageBuffer::enqueueDeferredMessages(Addr addr, Tick curTime, Tick delay)
     assert(msg_vec.size() > 0);
 
     // enqueue all deferred messages associated with this address
-    for (MsgPtr m : msg_vec) {
-        enqueue(m, curTime, delay);
+    for (MsgPtr &m : msg_vec) {
+        enqueue(std::move(m), curTime, delay);
     }
 
     msg_vec.clear();
@@ -509,7 +566,8 @@ MessageBuffer::print(std::ostream& out) const
     }
 
     std::vector<MsgPtr> copy(m_prio_heap);
-    std::sort_heap(copy.begin(), copy.end(), std::greater<MsgPtr>());
+    copy.insert(copy.end(), m_msg_fifo.begin(), m_msg_fifo.end());
+    std::sort(copy.begin(), copy.end(), std::greater<MsgPtr>());
     ccprintf(out, "%s] %s", copy, name());
 }
 
@@ -520,8 +578,8 @@ MessageBuffer::isReady(Tick current_time) const
     bool can_dequeue = (m_max_dequeue_rate == 0) ||
                        (m_time_last_time_pop < current_time) ||
                        (m_dequeues_this_cy < m_max_dequeue_rate);
-    bool is_ready = (m_prio_heap.size() > 0) &&
-                   (m_prio_heap.front()->getLastEnqueueTime() <= current_time);
+    bool is_ready = !isEmpty() &&
+                   (peekMsgPtr()->getLastEnqueueTime() <= current_time);
     if (!can_dequeue && is_ready) {
         // Make sure the Consumer executes next cycle to dequeue the ready msg
         m_consumer->scheduleEvent(Cycles(1));
@@ -532,10 +590,10 @@ MessageBuffer::isReady(Tick current_time) const
 Tick
 MessageBuffer::readyTime() const
 {
-    if (m_prio_heap.empty())
+    if (isEmpty())
         return MaxTick;
     else
-        return m_prio_heap.front()->getLastEnqueueTime();
+        return peekMsgPtr()->getLastEnqueueTime();
 }
 
 uint32_t
@@ -546,10 +604,11 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
 
     uint32_t num_functional_accesses = 0;
 
-    // Check the priority heap and write any messages that may
+    // Check the queued messages and write any messages that may
     // correspond to the address in the packet.
-    for (unsigned int i = 0; i < m_prio_heap.size(); ++i) {
-        Message *msg = m_prio_heap[i].get();
+    for (unsigned int i = 0; i < numMessages(); ++i) {
+        Message *msg = i < m_msg_fifo.size() ? m_msg_fifo[i].get() :
+            m_prio_heap[i - m_msg_fifo.size()].get();
         if (is_read && !mask && msg->functionalRead(pkt))
             return 1;
         else if (is_read && mask && msg->functionalRead(pkt, *mask))
@@ -48,6 +48,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <string>
@@ -92,11 +93,7 @@ class MessageBuffer : public SimObject
     void
     delayHead(Tick current_time, Tick delta)
     {
-        MsgPtr m = m_prio_heap.front();
-        std::pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                      std::greater<MsgPtr>());
-        m_prio_heap.pop_back();
-        enqueue(m, current_time, delta);
+        enqueue(removeHead(), current_time, delta);
     }
 
     bool areNSlotsAvailable(unsigned int n, Tick curTime);
@@ -115,14 +112,37 @@ class MessageBuffer : public SimObject
 
     Consumer* getConsumer() { return m_consumer; }
 
+    /**
+     * Keep a bit of a mask owned by the consumer set for as long as the
+     * buffer holds messages, so that the consumer can skip polling empty
+     * buffers.
+     */
+    void
+    setOccupancyMask(uint64_t *mask, unsigned bit)
+    {
+        assert(bit < 64);
+        m_occupancy_mask = mask;
+        m_occupancy_bit = uint64_t(1) << bit;
+        updateOccupancyMask();
+    }
+
     bool getOrdered() { return m_strict_fifo; }
 
     //! Function for extracting the message at the head of the
     //! message queue.  The function assumes that the queue is nonempty.
     const Message* peek() const;
 
-    const MsgPtr &peekMsgPtr() const { return m_prio_heap.front(); }
+    const MsgPtr &
+    peekMsgPtr() const
+    {
+        return headInHeap() ? m_prio_heap.front() : m_msg_fifo.front();
+    }
 
+    /**
+     * Enqueue a message that arrives delta ticks from now. The producer may
+     * be simulated on another event queue than the consumer, as long as the
+     * buffer is infinite and delta is at least the simulation quantum.
+     */
     void enqueue(MsgPtr message, Tick curTime, Tick delta,
                 bool bypassStrictFIFO = false);
 
@@ -146,7 +166,7 @@ class MessageBuffer : public SimObject
     void unregisterDequeueCallback();
 
     void recycle(Tick current_time, Tick recycle_latency);
-    bool isEmpty() const { return m_prio_heap.size() == 0; }
+    bool isEmpty() const { return numMessages() == 0; }
     bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
     unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
 
@@ -196,16 +216,77 @@ class MessageBuffer : public SimObject
   private:
     void reanalyzeList(std::list<MsgPtr> &, Tick);
 
+    //! Number of messages in the buffer, not counting the stalled ones
+    unsigned int
+    numMessages() const
+    {
+        return m_msg_fifo.size() + m_prio_heap.size();
+    }
+
+    //! Whether the message at the head of the buffer is in the heap
+    bool
+    headInHeap() const
+    {
+        return !m_prio_heap.empty() &&
+            (m_msg_fifo.empty() || m_msg_fifo.front() > m_prio_heap.front());
+    }
+
+    //! Insert a message in order of arrival
+    void insertMessage(MsgPtr message);
+
+    void
+    updateOccupancyMask()
+    {
+        if (m_occupancy_mask) {
+            if (isEmpty())
+                *m_occupancy_mask &= ~m_occupancy_bit;
+            else
+                *m_occupancy_mask |= m_occupancy_bit;
+        }
+    }
+
+    /**
+     * Take a message that has been enqueued into the buffer and wake the
+     * consumer up when it arrives. This runs on the event queue of the
+     * consumer, even if the message comes from another queue.
+     */
+    void acceptMessage(MsgPtr message, Tick arrival_time);
+
+    /**
+     * Priority of the events delivering the messages sent from another
+     * event queue, so that they are in the buffer before the consumer
+     * wakes up on the tick they arrive.
+     */
+    static const Event::Priority CrossQueueDeliveryPri =
+        Event::Default_Pri - 1;
+
+    //! Remove the message at the head of the buffer and return it
+    MsgPtr removeHead();
+
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
   private:
     // Data Members (m_ prefix)
     //! Consumer to signal a wakeup(), can be NULL
     Consumer* m_consumer;
+
+    /**
+     * The messages in the buffer, ordered by arrival time and then by the
+     * order in which they were enqueued. Most buffers receive messages in
+     * that order, so they are appended to the m_msg_fifo queue without any
+     * reordering. Only a message arriving before the last one in the queue
+     * goes to the m_prio_heap heap, and the head of the buffer is whichever
+     * of the heads of the two comes first.
+     */
+    std::deque<MsgPtr> m_msg_fifo;
     std::vector<MsgPtr> m_prio_heap;
 
     std::function<void()> m_dequeue_callback;
 
+    //! Consumer mask tracking whether the buffer is empty, can be NULL
+    uint64_t *m_occupancy_mask = nullptr;
+    uint64_t m_occupancy_bit = 0;
+
     // use a std::map for the stalled messages as this container is
     // sorted and ensures a well-defined iteration order
     typedef std::map<Addr, std::list<MsgPtr> > StallMsgMapType;
@@ -213,14 +294,14 @@ class MessageBuffer : public SimObject
     /**
      * A map from line addresses to lists of stalled messages for that line.
      * If this buffer allows the receiver to stall messages, on a stall
-     * request, the stalled message is removed from the m_prio_heap and placed
+     * request, the stalled message is removed from the buffer and placed
      * in the m_stall_msg_map. Messages are held there until the receiver
      * requests they be reanalyzed, at which point they are moved back to
-     * m_prio_heap.
+     * the buffer.
      *
      * NOTE: The stall map holds messages in the order in which they were
      * initially received, and when a line is unblocked, the messages are
-     * moved back to the m_prio_heap in the same order. This prevents starving
+     * moved back to the buffer in the same order. This prevents starving
      * older requests with younger ones.
      */
     StallMsgMapType m_stall_msg_map;
@@ -237,7 +318,7 @@ class MessageBuffer : public SimObject
      * Current size of the stall map.
      * Track the number of messages held in stall map lists. This is used to
      * ensure that if the buffer is finite-sized, it blocks further requests
-     * when the m_prio_heap and m_stall_msg_map contain m_max_size messages.
+     * when the buffer and m_stall_msg_map contain m_max_size messages.
      */
     int m_stall_map_size;
 
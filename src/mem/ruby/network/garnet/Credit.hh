@@ -64,6 +64,18 @@ class Credit : public flit
 
     ~Credit() {};
 
+    static void *
+    operator new(std::size_t size)
+    {
+        return ObjectPool<Credit>::allocate(size);
+    }
+
+    static void
+    operator delete(void *p, std::size_t size)
+    {
+        ObjectPool<Credit>::release(p, size);
+    }
+
     bool is_free_signal() { return m_is_free_signal; }
 
   private:
@@ -43,6 +43,7 @@
 #include "mem/ruby/network/garnet/GarnetLink.hh"
 #include "mem/ruby/network/garnet/NetworkInterface.hh"
 #include "mem/ruby/network/garnet/NetworkLink.hh"
+#include "mem/ruby/network/garnet/OutputUnit.hh"
 #include "mem/ruby/network/garnet/Router.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
@@ -75,6 +76,7 @@ GarnetNetwork::GarnetNetwork(const Params &p)
     m_enable_fault_model = p.enable_fault_model;
     if (m_enable_fault_model)
         fault_model = p.fault_model;
+    m_fast_mode = p.fast_mode;
 
     m_vnet_type.resize(m_virtual_networks);
 
@@ -134,6 +136,16 @@ GarnetNetwork::init()
         m_num_cols = -1;
     }
 
+    // The routing tables and port directions are complete, resolve the
+    // routes of every router once
+    for (Router *router : m_routers) {
+        router->initRouteCache();
+    }
+
+    fatal_if(m_fast_mode && !m_networkbridges.empty(),
+             "%s: fast mode does not support network bridges (clock domain "
+             "crossings or SerDes units)\n", name());
+
     // FaultModel: declare each router to the fault model
     if (isFaultModelEnabled()) {
         for (std::vector<Router*>::const_iterator i= m_routers.begin();
@@ -602,6 +614,27 @@ GarnetNetwork::print(std::ostream& out) const
     out << "[GarnetNetwork]";
 }
 
+Tick
+GarnetNetwork::routeFast(RouteInfo &route, NetworkLink *link, int num_flits,
+                         Tick ready, NetworkInterface *&dest_ni)
+{
+    Tick head = link->reserve(ready, num_flits);
+    while (Router *router = link->getDestRouter()) {
+        route.hops_traversed++;
+        int outport = router->route_compute(route, link->getDestInport(),
+                                            link->getDestInportDirn());
+        link = router->getOutputUnit(outport)->get_out_link();
+        head = link->reserve(
+            head + router->cyclesToTicks(router->get_pipe_stages()),
+            num_flits);
+    }
+
+    dest_ni = link->getDestNI();
+    assert(dest_ni);
+    // The body flits follow the head flit one link cycle after the other
+    return head + link->cyclesToTicks(Cycles(num_flits - 1));
+}
+
 void
 GarnetNetwork::update_traffic_distribution(RouteInfo route)
 {
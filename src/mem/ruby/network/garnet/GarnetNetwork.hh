@@ -82,6 +82,7 @@ class GarnetNetwork : public Network
     int getRoutingAlgorithm() const { return m_routing_algorithm; }
 
     bool isFaultModelEnabled() const { return m_enable_fault_model; }
+    bool isFastMode() const { return m_fast_mode; }
     FaultModel* fault_model;
 
 
@@ -157,6 +158,21 @@ class GarnetNetwork : public Network
     void update_traffic_distribution(RouteInfo route);
     int getNextPacketID() { return m_next_packet_id++; }
 
+    /**
+     * Sends a packet through the network in fast mode. The links on the
+     * route of the packet, starting with the injection link, are reserved
+     * in turn for its flits, and each router adds the latency of its
+     * pipeline.
+     *
+     * @param route Route of the packet, its hop count is updated.
+     * @param link Link from the source NI to the network.
+     * @param ready Tick at which the packet is ready to enter the link.
+     * @param dest_ni Set to the NI the packet is delivered to.
+     * @return Tick at which the tail flit reaches dest_ni.
+     */
+    Tick routeFast(RouteInfo &route, NetworkLink *link, int num_flits,
+                   Tick ready, NetworkInterface *&dest_ni);
+
   protected:
     // Configuration
     int m_num_rows;
@@ -167,6 +183,7 @@ class GarnetNetwork : public Network
     uint32_t m_buffers_per_data_vc;
     int m_routing_algorithm;
     bool m_enable_fault_model;
+    bool m_fast_mode;
 
     // Statistical variables
     statistics::Vector m_packets_received;
@@ -52,6 +52,11 @@ class GarnetNetwork(RubyNetwork):
     garnet_deadlock_threshold = Param.UInt32(
         50000, "network-level deadlock threshold"
     )
+    fast_mode = Param.Bool(
+        False,
+        "model each packet as a single reservation of the links on its "
+        "route instead of moving its flits through the routers",
+    )
 
 
 class GarnetNetworkInterface(ClockedObject):
@@ -57,9 +57,13 @@ InputUnit::InputUnit(int id, PortDirection direction, Router *router)
     }
 
     // Instantiating the virtual channels
+    GarnetNetwork *net_ptr = m_router->get_net_ptr();
     virtualChannels.reserve(m_num_vcs);
     for (int i=0; i < m_num_vcs; i++) {
-        virtualChannels.emplace_back();
+        int vnet = i / m_vc_per_vnet;
+        virtualChannels.emplace_back(
+            net_ptr->get_vnet_type(vnet) == DATA_VNET_ ?
+            net_ptr->getBuffersPerDataVC() : net_ptr->getBuffersPerCtrlVC());
     }
 }
 
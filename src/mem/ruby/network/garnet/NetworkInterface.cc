@@ -32,8 +32,10 @@
 
 #include "mem/ruby/network/garnet/NetworkInterface.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <functional>
 
 #include "base/cast.hh"
 #include "debug/RubyNetwork.hh"
@@ -56,7 +58,9 @@ NetworkInterface::NetworkInterface(const Params &p)
     m_virtual_networks(p.virt_nets), m_vc_per_vnet(0),
     m_vc_allocator(m_virtual_networks, 0),
     m_deadlock_threshold(p.garnet_deadlock_threshold),
-    vc_busy_counter(m_virtual_networks, 0)
+    vc_busy_counter(m_virtual_networks, 0),
+    m_fast_packets(m_virtual_networks),
+    m_fast_blocked(m_virtual_networks, false), m_fast_seq(0)
 {
     m_stall_count.resize(m_virtual_networks);
     niOutVcs.resize(0);
@@ -72,6 +76,7 @@ NetworkInterface::addInPort(NetworkLink *in_link,
     in_link->name(), newInPort->printVnets());
 
     in_link->setLinkConsumer(this);
+    in_link->setDestNI(this);
     credit_link->setSourceQueue(newInPort->outCreditQueue(), this);
     if (m_vc_per_vnet != 0) {
         in_link->setVcsPerVnet(m_vc_per_vnet);
@@ -223,6 +228,8 @@ NetworkInterface::wakeup()
     // message is enqueued to restrict ejection to one message per cycle.
     checkStallQueue();
 
+    deliverFastPackets();
+
     /*********** Check the incoming flit link **********/
     DPRINTF(RubyNetwork, "Number of input ports: %d\n", inPorts.size());
     for (auto &iPort: inPorts) {
@@ -312,6 +319,71 @@ NetworkInterface::wakeup()
     checkReschedule();
 }
 
+void
+NetworkInterface::receiveFast(MsgPtr msg_ptr, int vnet, Tick arrival,
+                              Tick inject_time, Tick src_delay,
+                              int num_flits, int hops)
+{
+    // The packet is handed to the protocol on the first clock edge of the
+    // NI after its tail flit arrived
+    Tick edge = clockEdge(ticksToCycles(arrival -
+                                        std::min(arrival, clockEdge())));
+    DPRINTF(RubyNetwork, "Fast packet on vnet %d arrives at %ld: %s\n",
+            vnet, edge, *msg_ptr);
+
+    auto &packets = m_fast_packets[vnet];
+    packets.push_back({edge, m_fast_seq++, std::move(msg_ptr), inject_time,
+                       src_delay, num_flits, hops});
+    std::push_heap(packets.begin(), packets.end(), std::greater<>());
+    scheduleEventAbsolute(edge);
+}
+
+void
+NetworkInterface::deliverFastPackets()
+{
+    Tick curTime = clockEdge();
+    for (int vnet = 0; vnet < m_fast_packets.size(); ++vnet) {
+        auto &packets = m_fast_packets[vnet];
+        while (!packets.empty() && packets.front().arrival <= curTime) {
+            // Packets wait in the NI while the protocol buffer is full
+            if (!outNode_ptr[vnet]->areNSlotsAvailable(1, curTime)) {
+                m_fast_blocked[vnet] = true;
+                outNode_ptr[vnet]->registerDequeueCallback([this]() {
+                    dequeueCallback(); });
+                break;
+            }
+            if (m_fast_blocked[vnet]) {
+                m_fast_blocked[vnet] = false;
+                if (m_stall_count[vnet] == 0)
+                    outNode_ptr[vnet]->unregisterDequeueCallback();
+            }
+
+            std::pop_heap(packets.begin(), packets.end(), std::greater<>());
+            FastPacket &pkt = packets.back();
+            outNode_ptr[vnet]->enqueue(pkt.msg_ptr, curTime,
+                                       cyclesToTicks(Cycles(1)));
+
+            // Same accounting as for the flits of a packet in detailed mode
+            Tick network_delay = pkt.arrival - pkt.inject_time -
+                                 cyclesToTicks(Cycles(1));
+            Tick queueing_delay = pkt.src_delay + (curTick() - pkt.arrival);
+            for (int i = 0; i < pkt.num_flits; i++) {
+                m_net_ptr->increment_received_flits(vnet);
+                m_net_ptr->increment_flit_network_latency(network_delay,
+                                                          vnet);
+                m_net_ptr->increment_flit_queueing_latency(queueing_delay,
+                                                           vnet);
+                m_net_ptr->increment_total_hops(pkt.hops);
+            }
+            m_net_ptr->increment_received_packets(vnet);
+            m_net_ptr->increment_packet_network_latency(network_delay, vnet);
+            m_net_ptr->increment_packet_queueing_latency(queueing_delay,
+                                                         vnet);
+            packets.pop_back();
+        }
+    }
+}
+
 void
 NetworkInterface::checkStallQueue()
 {
@@ -371,8 +443,8 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
     Message *net_msg_ptr = msg_ptr.get();
     NetDest net_msg_dest = net_msg_ptr->getDestination();
 
-    // gets all the destinations associated with this message.
-    std::vector<NodeID> dest_nodes = net_msg_dest.getAllDest();
+    // number of destinations associated with this message.
+    int num_dests = net_msg_dest.count();
 
     // Number of flits is dependent on the link bandwidth available.
     // This is expressed in terms of bytes/cycle or the flit size
@@ -386,19 +458,25 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         vnet, oPort->bitWidth());
 
     // loop to convert all multicast messages into unicast messages
-    for (int ctr = 0; ctr < dest_nodes.size(); ctr++) {
-
-        // this will return a free output virtual channel
-        int vc = calculateVC(vnet);
-
-        if (vc == -1) {
-            return false ;
+    for (NodeID destID = net_msg_dest.nextDest(0);
+         destID < NetDest::MaxMachines;
+         destID = net_msg_dest.nextDest(destID + 1)) {
+
+        // this will return a free output virtual channel, packets sent
+        // in fast mode do not hold one
+        int vc = -1;
+        if (!m_net_ptr->isFastMode()) {
+            vc = calculateVC(vnet);
+            if (vc == -1) {
+                return false ;
+            }
         }
-        MsgPtr new_msg_ptr = msg_ptr->clone();
-        NodeID destID = dest_nodes[ctr];
+        // a unicast message is moved into the network as is, only the
+        // messages of a multicast need their own copy to each destination
+        MsgPtr new_msg_ptr = num_dests > 1 ? msg_ptr->clone() : msg_ptr;
 
         Message *new_net_msg_ptr = new_msg_ptr.get();
-        if (dest_nodes.size() > 1) {
+        if (num_dests > 1) {
             NetDest personal_dest;
             for (int m = 0; m < (int) MachineType_NUM; m++) {
                 if ((destID >= MachineType_base_number((MachineType) m)) &&
@@ -436,6 +514,19 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
 
         m_net_ptr->increment_injected_packets(vnet);
         m_net_ptr->update_traffic_distribution(route);
+        if (m_net_ptr->isFastMode()) {
+            for (int i = 0; i < num_flits; i++)
+                m_net_ptr->increment_injected_flits(vnet);
+
+            NetworkInterface *dest_ni = nullptr;
+            Tick arrival = m_net_ptr->routeFast(route, oPort->outNetLink(),
+                num_flits, clockEdge(Cycles(1)), dest_ni);
+            dest_ni->receiveFast(std::move(new_msg_ptr), vnet, arrival,
+                                 curTick(), curTick() - msg_ptr->getTime(),
+                                 num_flits, route.hops_traversed);
+            continue;
+        }
+
         int packet_id = m_net_ptr->getNextPacketID();
         for (int i = 0; i < num_flits; i++) {
             m_net_ptr->increment_injected_flits(vnet);
@@ -682,6 +773,13 @@ NetworkInterface::functionalRead(Packet *pkt, WriteMask &mask)
             read = true;
     }
 
+    for (auto &packets : m_fast_packets) {
+        for (auto &fast_pkt : packets) {
+            if (fast_pkt.msg_ptr->functionalRead(pkt, mask))
+                read = true;
+        }
+    }
+
     return read;
 }
 
@@ -696,6 +794,12 @@ NetworkInterface::functionalWrite(Packet *pkt)
     for (auto &oPort: outPorts) {
         num_functional_writes += oPort->outFlitQueue()->functionalWrite(pkt);
     }
+
+    for (auto &packets : m_fast_packets) {
+        for (auto &fast_pkt : packets)
+            num_functional_writes += fast_pkt.msg_ptr->functionalWrite(pkt);
+    }
+
     return num_functional_writes;
 }
 
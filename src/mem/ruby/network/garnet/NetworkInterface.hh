@@ -84,6 +84,17 @@ class NetworkInterface : public ClockedObject, public Consumer
 
     void scheduleFlit(flit *t_flit);
 
+    /**
+     * Receives a packet sent through the network in fast mode.
+     *
+     * @param arrival Tick at which its tail flit reaches the NI.
+     * @param inject_time Tick at which it was injected into the network.
+     * @param src_delay Time the message waited in the source NI.
+     */
+    void receiveFast(MsgPtr msg_ptr, int vnet, Tick arrival,
+                     Tick inject_time, Tick src_delay, int num_flits,
+                     int hops);
+
     int get_router_id(int vnet)
     {
         OutputPort *oPort = getOutportForVnet(vnet);
@@ -293,6 +304,36 @@ class NetworkInterface : public ClockedObject, public Consumer
     // When a vc stays busy for a long time, it indicates a deadlock
     std::vector<int> vc_busy_counter;
 
+    // A packet that crossed the network in fast mode and waits to be
+    // delivered to the protocol
+    struct FastPacket
+    {
+        Tick arrival;
+        uint64_t seq;
+        MsgPtr msg_ptr;
+        Tick inject_time;
+        Tick src_delay;
+        int num_flits;
+        int hops;
+
+        bool
+        operator>(const FastPacket &other) const
+        {
+            if (arrival != other.arrival)
+                return arrival > other.arrival;
+            return seq > other.seq;
+        }
+    };
+
+    // Min-heaps by arrival of the fast mode packets of each vnet. Ties
+    // are broken by the order of reception, which keeps the order of the
+    // packets that arrive on the same cycle.
+    std::vector<std::vector<FastPacket>> m_fast_packets;
+    std::vector<bool> m_fast_blocked;
+    uint64_t m_fast_seq;
+
+    void deliverFastPackets();
+
     void checkStallQueue();
     bool flitisizeMessage(MsgPtr msg_ptr, int vnet);
     int calculateVC(int vnet);
@@ -48,7 +48,8 @@ namespace garnet
 NetworkLink::NetworkLink(const Params &p)
     : ClockedObject(p), Consumer(this), m_id(p.link_id),
       m_type(NUM_LINK_TYPES_),
-      m_latency(p.link_latency), m_link_utilized(0),
+      m_latency(p.link_latency), m_dest_router(nullptr), m_dest_inport(-1),
+      m_dest_ni(nullptr), m_reserved_until(0), m_link_utilized(0),
       m_virt_nets(p.virt_nets), linkBuffer(),
       link_consumer(nullptr), link_srcQueue(nullptr)
 {
@@ -109,6 +110,16 @@ NetworkLink::wakeup()
     }
 }
 
+Tick
+NetworkLink::reserve(Tick ready, int num_flits)
+{
+    Tick start = std::max(ready, m_reserved_until);
+    start = clockEdge(ticksToCycles(start - std::min(start, clockEdge())));
+    m_reserved_until = start + cyclesToTicks(Cycles(num_flits));
+    m_link_utilized += num_flits;
+    return start + cyclesToTicks(m_latency);
+}
+
 void
 NetworkLink::resetStats()
 {
@@ -52,6 +52,8 @@ namespace garnet
 {
 
 class GarnetNetwork;
+class NetworkInterface;
+class Router;
 
 class NetworkLink : public ClockedObject, public Consumer
 {
@@ -85,6 +87,32 @@ class NetworkLink : public ClockedObject, public Consumer
     uint32_t functionalWrite(Packet *);
     void resetStats();
 
+    // Downstream end of the link, used by the fast mode of the network
+    // to follow the route of a packet without handing flits over
+    void
+    setDestRouter(Router *router, int inport, PortDirection inport_dirn)
+    {
+        m_dest_router = router;
+        m_dest_inport = inport;
+        m_dest_inport_dirn = inport_dirn;
+    }
+    void setDestNI(NetworkInterface *ni) { m_dest_ni = ni; }
+    Router *getDestRouter() const { return m_dest_router; }
+    int getDestInport() const { return m_dest_inport; }
+    PortDirection getDestInportDirn() const { return m_dest_inport_dirn; }
+    NetworkInterface *getDestNI() const { return m_dest_ni; }
+
+    /**
+     * Reserves the link for the flits of a packet in fast mode. The
+     * packet starts crossing the link at the first clock edge at which it
+     * is ready and the link has finished sending the packets reserved
+     * before it, and occupies the link for one cycle per flit.
+     *
+     * @param ready Tick at which the head flit reaches the link.
+     * @return Tick at which the head flit leaves the link.
+     */
+    Tick reserve(Tick ready, int num_flits);
+
     std::vector<int> mVnets;
     uint32_t bitWidth;
 
@@ -95,6 +123,15 @@ class NetworkLink : public ClockedObject, public Consumer
 
     ClockedObject *src_object;
 
+    Router *m_dest_router;
+    int m_dest_inport;
+    PortDirection m_dest_inport_dirn;
+    NetworkInterface *m_dest_ni;
+
+    // First tick at which the link is free of the packets reserved in
+    // fast mode
+    Tick m_reserved_until;
+
     // Statistical variables
     unsigned int m_link_utilized;
     std::vector<unsigned int> m_vc_load;
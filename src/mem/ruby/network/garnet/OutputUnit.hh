@@ -78,6 +78,12 @@ class OutputUnit : public Consumer
         return outVcState[vc].get_credit_count();
     }
 
+    inline NetworkLink *
+    get_out_link()
+    {
+        return m_out_link;
+    }
+
     inline int
     get_outlink_id()
     {
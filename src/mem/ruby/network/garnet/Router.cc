@@ -110,6 +110,7 @@ Router::addInPort(PortDirection inport_dirn,
     input_unit->set_in_link(in_link);
     input_unit->set_credit_link(credit_link);
     in_link->setLinkConsumer(this);
+    in_link->setDestRouter(this, port_num, inport_dirn);
     in_link->setVcsPerVnet(get_vc_per_vnet());
     credit_link->setSourceQueue(input_unit->getCreditQueue(), this);
     credit_link->setVcsPerVnet(get_vc_per_vnet());
@@ -135,13 +135,92 @@ RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
         exit(0);
     }
 
+    output_link = selectCandidate(vnet, output_link_candidates.data(),
+                                  num_candidates);
+    return output_link;
+}
+
+int
+RoutingUnit::selectCandidate(int vnet, const int *candidates, int count)
+{
     // Randomly select any candidate output link
     int candidate = 0;
     if (!(m_router->get_net_ptr())->isVNetOrdered(vnet))
-        candidate = rand() % num_candidates;
+        candidate = rand() % count;
 
-    output_link = output_link_candidates.at(candidate);
-    return output_link;
+    return candidates[candidate];
+}
+
+/*
+ * Packets are unicast by the time they are routed, so the output port only
+ * depends on the vnet and the destination NI. Table routing and XY routing
+ * are resolved here once for every destination the routing table knows of,
+ * which turns outportCompute() into an index in m_route_cache. Nothing
+ * changes the routes at run time: the fault model only reports fault
+ * probabilities and does not reroute packets.
+ */
+void
+RoutingUnit::initRouteCache()
+{
+    m_route_cache.clear();
+    m_route_candidates.clear();
+    m_route_cache_dests = 0;
+
+    GarnetNetwork *net = m_router->get_net_ptr();
+    RoutingAlgorithm routing_algorithm =
+        (RoutingAlgorithm) net->getRoutingAlgorithm();
+    if (routing_algorithm == CUSTOM_)
+        return;
+
+    int num_vnets = m_routing_table.size();
+    for (int vnet = 0; vnet < num_vnets; vnet++) {
+        for (const NetDest &dests : m_routing_table[vnet]) {
+            for (NodeID id = dests.nextDest(0); id < NetDest::MaxMachines;
+                 id = dests.nextDest(id + 1)) {
+                m_route_cache_dests = std::max(m_route_cache_dests,
+                                               int(id) + 1);
+            }
+        }
+    }
+
+    m_route_cache.resize(num_vnets * m_route_cache_dests);
+    for (int vnet = 0; vnet < num_vnets; vnet++) {
+        const std::vector<NetDest> &links = m_routing_table[vnet];
+        for (NodeID dest = 0; dest < m_route_cache_dests; dest++) {
+            // Same candidates, in the same order, as lookupRoutingTable()
+            int min_weight = INFINITE_;
+            for (int link = 0; link < links.size(); link++) {
+                if (links[link].hasNode(dest) &&
+                    m_weight_table[link] <= min_weight) {
+                    min_weight = m_weight_table[link];
+                }
+            }
+            if (min_weight == INFINITE_)
+                continue;
+
+            CachedRoute &cached = m_route_cache[vnet * m_route_cache_dests +
+                                                dest];
+            cached.first = m_route_candidates.size();
+
+            if (routing_algorithm == XY_ &&
+                net->get_router_id(dest, vnet) != m_router->get_id()) {
+                RouteInfo route;
+                route.vnet = vnet;
+                route.dest_ni = dest;
+                route.dest_router = net->get_router_id(dest, vnet);
+                m_route_candidates.push_back(
+                    outportComputeXY(route, -1, "Local"));
+            } else {
+                for (int link = 0; link < links.size(); link++) {
+                    if (links[link].hasNode(dest) &&
+                        m_weight_table[link] == min_weight) {
+                        m_route_candidates.push_back(link);
+                    }
+                }
+            }
+            cached.count = m_route_candidates.size() - cached.first;
+        }
+    }
 }
 
 
@@ -171,6 +250,18 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
 {
     int outport = -1;
 
+    if (route.dest_ni < m_route_cache_dests) {
+        const CachedRoute &cached =
+            m_route_cache[route.vnet * m_route_cache_dests + route.dest_ni];
+        if (cached.count == 1)
+            return m_route_candidates[cached.first];
+        if (cached.count > 1) {
+            return selectCandidate(route.vnet,
+                                   &m_route_candidates[cached.first],
+                                   cached.count);
+        }
+    }
+
     if (route.dest_router == m_router->get_id()) {
 
         // Multiple NIs may be connected to this router,
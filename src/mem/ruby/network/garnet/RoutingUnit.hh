@@ -64,6 +64,11 @@ class RoutingUnit
     // get output port from routing table
     int  lookupRoutingTable(int vnet, NetDest net_dest);
 
+    // Precompute the output port candidates of every (vnet, destination)
+    // pair the routing algorithm resolves deterministically. Called once
+    // the topology is built and the routing table is complete.
+    void initRouteCache();
+
     // Topology-specific direction based routing
     void addInDirection(PortDirection inport_dirn, int inport);
     void addOutDirection(PortDirection outport_dirn, int outport);
@@ -84,6 +89,10 @@ class RoutingUnit
 
 
   private:
+    // Randomly pick among the candidate output links of unordered vnets,
+    // the first one is always used for ordered vnets
+    int selectCandidate(int vnet, const int *candidates, int count);
+
     Router *m_router;
 
     // Routing Table
@@ -95,6 +104,17 @@ class RoutingUnit
     std::map<int, PortDirection> m_inports_idx2dirn;
     std::map<int, PortDirection> m_outports_idx2dirn;
     std::map<PortDirection, int> m_outports_dirn2idx;
+
+    // Route cache, a slice of m_route_candidates per (vnet, destination)
+    // pair. An empty slice means the route is computed on every lookup.
+    struct CachedRoute
+    {
+        int first = 0;
+        int count = 0;
+    };
+    std::vector<CachedRoute> m_route_cache;
+    std::vector<int> m_route_candidates;
+    int m_route_cache_dests = 0;
 };
 
 } // namespace garnet
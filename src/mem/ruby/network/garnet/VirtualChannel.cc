@@ -40,10 +40,12 @@ namespace ruby
 namespace garnet
 {
 
-VirtualChannel::VirtualChannel()
+VirtualChannel::VirtualChannel(int depth)
   : inputBuffer(), m_vc_state(IDLE_, Tick(0)), m_output_port(-1),
     m_enqueue_time(INFINITE_), m_output_vc(-1)
 {
+    // credits keep the flits in the VC below its depth
+    inputBuffer.reserve(depth);
 }
 
 void
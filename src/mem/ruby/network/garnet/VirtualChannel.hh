@@ -49,7 +49,7 @@ namespace garnet
 class VirtualChannel
 {
   public:
-    VirtualChannel();
+    VirtualChannel(int depth);
     ~VirtualChannel() = default;
 
     bool need_stage(flit_stage stage, Tick time);
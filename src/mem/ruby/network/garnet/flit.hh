@@ -35,6 +35,7 @@
 #include <iostream>
 
 #include "base/types.hh"
+#include "mem/ruby/common/ObjectPool.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 
@@ -56,6 +57,20 @@ class flit
 
     virtual ~flit(){};
 
+    // Flits are created and destroyed at a very high rate, they get their
+    // storage from a pool
+    static void *
+    operator new(std::size_t size)
+    {
+        return ObjectPool<flit>::allocate(size);
+    }
+
+    static void
+    operator delete(void *p, std::size_t size)
+    {
+        ObjectPool<flit>::release(p, size);
+    }
+
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
     Tick get_enqueue_time() { return m_enqueue_time; }
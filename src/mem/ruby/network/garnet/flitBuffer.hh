@@ -32,6 +32,7 @@
 #define __MEM_RUBY_NETWORK_GARNET_0_FLITBUFFER_HH__
 
 #include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <vector>
 
@@ -58,33 +59,55 @@ class flitBuffer
     void print(std::ostream& out) const;
     bool isFull();
     void setMaxSize(int maximum);
-    int getSize() const { return m_buffer.size(); }
+    int getSize() const { return m_count; }
+
+    /**
+     * Preallocates room for n flits, e.g. the depth of a VC, so that the
+     * buffer does not allocate memory when flits are inserted.
+     */
+    void reserve(int n);
 
     flit *
     getTopFlit()
     {
-        flit *f = m_buffer.front();
-        m_buffer.pop_front();
+        assert(m_count > 0);
+        flit *f = m_ring[m_head];
+        m_head = (m_head + 1) & (m_ring.size() - 1);
+        m_count--;
         return f;
     }
 
     flit *
     peekTopFlit()
     {
-        return m_buffer.front();
+        assert(m_count > 0);
+        return m_ring[m_head];
     }
 
     void
     insert(flit *flt)
     {
-        m_buffer.push_back(flt);
+        if (m_count == m_ring.size())
+            reserve(2 * m_count);
+        m_ring[(m_head + m_count) & (m_ring.size() - 1)] = flt;
+        m_count++;
     }
 
     bool functionalRead(Packet *pkt, WriteMask &mask);
     uint32_t functionalWrite(Packet *pkt);
 
   private:
-    std::deque<flit *> m_buffer;
+    flit *
+    at(unsigned i) const
+    {
+        return m_ring[(m_head + i) & (m_ring.size() - 1)];
+    }
+
+    // The flits are kept in a circular buffer whose size is a power of
+    // two, which only grows when it is full
+    std::vector<flit *> m_ring;
+    unsigned m_head;
+    unsigned m_count;
     int max_size;
 };
 
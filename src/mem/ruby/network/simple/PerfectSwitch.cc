@@ -192,7 +192,11 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int vnet)
     static thread_local std::vector<BaseRoutingUnit::RouteInfo> output_links;
 
     Tick current_time = m_switch->clockEdge();
+    BaseRoutingUnit &routing_unit = m_switch->getRoutingUnit();
+    bool ordered = m_network_ptr->isVNetOrdered(vnet);
 
+    // Drain all the ready messages of the buffer in one pass, until one
+    // of them is blocked by a full output buffer
     while (buffer->isReady(current_time)) {
         DPRINTF(RubyNetwork, "incoming: %d\n", buffer->getIncomingLink());
 
@@ -203,9 +207,7 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int vnet)
 
 
         output_links.clear();
-        m_switch->getRoutingUnit().route(*net_msg_ptr, vnet,
-                                         m_network_ptr->isVNetOrdered(vnet),
-                                         output_links);
+        routing_unit.route(*net_msg_ptr, vnet, ordered, output_links);
 
         // Check for resources - for all outgoing queues
         bool enough = true;
@@ -252,7 +254,10 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int vnet)
             int outgoing = output_links[i].m_link_id;
             OutputPort &out_port = m_out[outgoing];
 
-            if (i > 0) {
+            if (i == output_links.size() - 1 && i > 0) {
+                // the last link can take the unmodified message itself
+                msg_ptr = std::move(unmodified_msg_ptr);
+            } else if (i > 0) {
                 // create a private copy of the unmodified message
                 msg_ptr = unmodified_msg_ptr->clone();
             }
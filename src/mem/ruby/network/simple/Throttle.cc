@@ -40,6 +40,7 @@
 
 #include "mem/ruby/network/simple/Throttle.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/cast.hh"
@@ -117,7 +118,7 @@ Throttle::addLinks(const std::vector<MessageBuffer*>& in_vec,
         MessageBuffer *in_ptr = in_vec[vnet];
         MessageBuffer *out_ptr = out_vec[vnet];
 
-        m_units_remaining.emplace_back(getChannelCnt(vnet),0);
+        m_link_free.emplace_back(getChannelCnt(vnet), 0);
         m_in.push_back(in_ptr);
         m_out.push_back(out_ptr);
 
@@ -162,81 +163,73 @@ Throttle::getChannelCnt(int vnet) const
 }
 
 void
-Throttle::operateVnet(int vnet, int channel, int &total_bw_remaining,
-                      bool &bw_saturated, bool &output_blocked,
+Throttle::operateVnet(int vnet, int channel, Cycles &wakeup_cycle,
+                      bool &output_blocked,
                       MessageBuffer *in, MessageBuffer *out)
 {
     if (out == nullptr || in == nullptr) {
         return;
     }
 
-    int &units_remaining = m_units_remaining[vnet][channel];
+    // The link is a token bucket refilled with bw units every cycle. A
+    // message can start in any cycle the link has bandwidth left in,
+    // and the link is then busy until its units have been sent.
+    const uint64_t bw = m_physical_vnets ?
+                getLinkBandwidth(vnet) : getTotalLinkBandwidth();
+    uint64_t &link_free = m_link_free[m_physical_vnets ? vnet : 0][channel];
 
-    gem5_assert(units_remaining >= 0);
-    Tick current_time = m_switch->clockEdge();
+    const Cycles now = m_switch->curCycle();
+    const Tick current_time = m_switch->clockEdge();
+    const uint64_t cycle_end = (uint64_t(now) + 1) * bw;
 
-    int bw_remaining = m_physical_vnets ?
-                getLinkBandwidth(vnet) : total_bw_remaining;
-
-    auto hasPendingWork = [&]{ return in->isReady(current_time) ||
-                                      units_remaining > 0; };
-    while ((bw_remaining > 0) && hasPendingWork() &&
+    while (in->isReady(current_time) && link_free < cycle_end &&
            out->areNSlotsAvailable(1, current_time)) {
-        // See if we are done transferring the previous message on
-        // this virtual network
-        if (units_remaining == 0 && in->isReady(current_time)) {
-            // Find the size of the message we are moving
-            MsgPtr msg_ptr = in->peekMsgPtr();
-            Message *net_msg_ptr = msg_ptr.get();
-            Tick msg_enqueue_time = msg_ptr->getLastEnqueueTime();
-            units_remaining = network_message_to_size(net_msg_ptr);
-
-            DPRINTF(RubyNetwork, "throttle: %d my bw %d bw spent "
-                    "enqueueing net msg %d time: %lld.\n",
-                    m_node, getLinkBandwidth(vnet), units_remaining,
-                    m_ruby_system->curCycle());
-
-            // Move the message
-            in->dequeue(current_time);
-            out->enqueue(msg_ptr, current_time,
-                         m_switch->cyclesToTicks(m_link_latency));
-
-            // Count the message
-            (*(throttleStats.
-                msg_counts[net_msg_ptr->getMessageSize()]))[vnet]++;
-            throttleStats.total_msg_count += 1;
-            uint32_t total_size =
-                Network::MessageSizeType_to_int(net_msg_ptr->getMessageSize());
-            throttleStats.total_msg_bytes += total_size;
-            total_size -=
-                Network::MessageSizeType_to_int(MessageSizeType_Control);
-            throttleStats.total_data_msg_bytes += total_size;
-            throttleStats.total_msg_wait_time +=
-                current_time - msg_enqueue_time;
-            DPRINTF(RubyNetwork, "%s\n", *out);
-        }
-
-        // Calculate the amount of bandwidth we spent on this message
-        int spent = std::min(units_remaining, bw_remaining);
-        units_remaining -= spent;
-        bw_remaining -= spent;
-        total_bw_remaining -= spent;
+        // Find the size of the message we are moving
+        MsgPtr msg_ptr = in->peekMsgPtr();
+        Message *net_msg_ptr = msg_ptr.get();
+        Tick msg_enqueue_time = msg_ptr->getLastEnqueueTime();
+        const int units = network_message_to_size(net_msg_ptr);
+
+        DPRINTF(RubyNetwork, "throttle: %d my bw %d bw spent "
+                "enqueueing net msg %d time: %lld.\n",
+                m_node, getLinkBandwidth(vnet), units,
+                m_ruby_system->curCycle());
+
+        // Move the message
+        in->dequeue(current_time);
+        out->enqueue(msg_ptr, current_time,
+                     m_switch->cyclesToTicks(m_link_latency));
+
+        // Spend the bandwidth of the message from now on
+        link_free = std::max(link_free, uint64_t(now) * bw) + units;
+        throttleStats.acc_link_utilization +=
+            double(units) / getTotalLinkBandwidth();
+
+        // Count the message
+        (*(throttleStats.
+            msg_counts[net_msg_ptr->getMessageSize()]))[vnet]++;
+        throttleStats.total_msg_count += 1;
+        uint32_t total_size =
+            Network::MessageSizeType_to_int(net_msg_ptr->getMessageSize());
+        throttleStats.total_msg_bytes += total_size;
+        total_size -=
+            Network::MessageSizeType_to_int(MessageSizeType_Control);
+        throttleStats.total_data_msg_bytes += total_size;
+        throttleStats.total_msg_wait_time +=
+            current_time - msg_enqueue_time;
+        DPRINTF(RubyNetwork, "%s\n", *out);
     }
 
-    gem5_assert(units_remaining >= 0);
-    gem5_assert(bw_remaining >= 0);
-    gem5_assert(total_bw_remaining >= 0);
-
-    // Notify caller if
-    //  - we ran out of bandwith and still have stuff to do
-    //  - we had something to do but output queue was unavailable
-    if (hasPendingWork()) {
-        gem5_assert((bw_remaining == 0) ||
-                    !out->areNSlotsAvailable(1, current_time));
-        bw_saturated = bw_saturated || (bw_remaining == 0);
-        output_blocked = output_blocked ||
-            !out->areNSlotsAvailable(1, current_time);
-    }
+    // Messages which aren't ready yet wake us up when they are. Otherwise
+    // let the caller know if
+    //  - we ran out of bandwith, and when there will be some again
+    //  - the output queue was unavailable
+    if (!in->isReady(current_time))
+        return;
+    if (link_free >= cycle_end)
+        wakeup_cycle = std::min(wakeup_cycle, Cycles(link_free / bw));
+    else
+        output_blocked = true;
 }
 
 void
@@ -244,10 +237,10 @@ Throttle::wakeup()
 {
     // Limits the number of message sent to a limited number of bytes/cycle.
     assert(getTotalLinkBandwidth() > 0);
-    int bw_remaining = getTotalLinkBandwidth();
 
     m_wakeups_wo_switch++;
-    bool bw_saturated = false;
+    const Cycles now = m_switch->curCycle();
+    Cycles wakeup_cycle = Cycles(MaxTick);
     bool output_blocked = false;
 
     // variable for deciding the direction in which to iterate
@@ -263,40 +256,35 @@ Throttle::wakeup()
     if (iteration_direction) {
         for (int vnet = 0; vnet < m_vnets; ++vnet) {
             for (int channel = 0; channel < getChannelCnt(vnet); ++channel) {
-                operateVnet(vnet, channel, bw_remaining,
-                            bw_saturated, output_blocked,
+                operateVnet(vnet, channel, wakeup_cycle, output_blocked,
                             m_in[vnet], m_out[vnet]);
             }
         }
     } else {
         for (int vnet = m_vnets-1; vnet >= 0; --vnet) {
             for (int channel = 0; channel < getChannelCnt(vnet); ++channel) {
-                operateVnet(vnet, channel, bw_remaining,
-                            bw_saturated, output_blocked,
+                operateVnet(vnet, channel, wakeup_cycle, output_blocked,
                             m_in[vnet], m_out[vnet]);
             }
         }
     }
 
-    // We should only wake up when we use the bandwidth
-    // This is only mostly true
-    // assert(bw_remaining != getLinkBandwidth());
-
-    // Record that we used some or all of the link bandwidth this cycle
-    double ratio = 1.0 - (double(bw_remaining) /
-                         double(getTotalLinkBandwidth()));
-
-    // If ratio = 0, we used no bandwidth, if ratio = 1, we used all
-    throttleStats.acc_link_utilization += ratio;
-
-    if (bw_saturated) throttleStats.total_bw_sat_cy += 1;
-    if (output_blocked) throttleStats.total_stall_cy += 1;
-
-    if (bw_saturated || output_blocked) {
-        // We are out of bandwidth for this cycle, so wakeup next
-        // cycle and continue
+    const bool bw_saturated = wakeup_cycle != Cycles(MaxTick);
+    if (output_blocked) {
+        // Poll the output queues until they have room again
+        throttleStats.total_stall_cy += 1;
+        if (bw_saturated)
+            throttleStats.total_bw_sat_cy += 1;
         DPRINTF(RubyNetwork, "%s scheduled again\n", *this);
         scheduleEvent(Cycles(1));
+    } else if (bw_saturated) {
+        // Nothing can move until the link has bandwidth left again, so
+        // sleep through the rest of the burst
+        assert(wakeup_cycle > now);
+        throttleStats.total_bw_sat_cy += wakeup_cycle - now;
+        DPRINTF(RubyNetwork, "%s scheduled again in %d cycles\n", *this,
+                wakeup_cycle - now);
+        scheduleEvent(wakeup_cycle - now);
     }
 }
 
@@ -108,8 +108,8 @@ class Throttle : public Consumer
   private:
     void init(NodeID node, Cycles link_latency, int link_bandwidth_multiplier,
               int endpoint_bandwidth);
-    void operateVnet(int vnet, int channel, int &total_bw_remaining,
-                     bool &bw_saturated, bool &output_blocked,
+    void operateVnet(int vnet, int channel, Cycles &wakeup_cycle,
+                     bool &output_blocked,
                      MessageBuffer *in, MessageBuffer *out);
 
     // Private copy constructor and assignment operator
@@ -119,7 +119,10 @@ class Throttle : public Consumer
     std::vector<MessageBuffer*> m_in;
     std::vector<MessageBuffer*> m_out;
     unsigned int m_vnets;
-    std::vector<std::vector<int>> m_units_remaining;
+    // The time, counted in bandwidth units (cycles * link bandwidth),
+    // at which each channel is done sending the messages it started.
+    // Without physical vnets all of them share the one of vnet 0.
+    std::vector<std::vector<uint64_t>> m_link_free;
 
     const int m_switch_id;
     Switch *m_switch;
@@ -82,8 +82,12 @@ WeightBased::route(const Message &msg,
         if (deterministic) {
             // Don't adaptively route
             // Makes sure ordering is reset
-            for (auto &link : m_links)
-                link->m_order = 0;
+            if (m_links_reordered) {
+                for (auto &link : m_links)
+                    link->m_order = 0;
+                sortLinks();
+                m_links_reordered = false;
+            }
         } else {
             // Find how clogged each link is
             for (auto &link : m_links) {
@@ -97,13 +101,46 @@ WeightBased::route(const Message &msg,
                 link->m_order =
                     (out_queue_length << 8) | random_mt.random(0, 0xff);
             }
+            sortLinks();
+            m_links_reordered = true;
         }
-        sortLinks();
+    }
+
+    // Unicast messages, the vast majority, are routed with a single
+    // lookup in the destination cache while the links are in their
+    // static order
+    const NetDest &msg_dsts = msg.getDestination();
+    NodeID dest = msg_dsts.nextDest(0);
+    if (!m_links_reordered && dest < NetDest::MaxMachines &&
+        msg_dsts.nextDest(dest + 1) == NetDest::MaxMachines) {
+        if (!m_dest_link_valid)
+            buildDestLinks();
+        gem5_assert(dest < m_dest_link.size() && m_dest_link[dest] >= 0);
+        out_links.emplace_back(msg_dsts,
+                               m_links[m_dest_link[dest]]->m_link_id);
+        return;
     }
 
     findRoute(msg, out_links);
 }
 
+void
+WeightBased::buildDestLinks()
+{
+    m_dest_link.clear();
+    for (int i = 0; i < m_links.size(); i++) {
+        const NetDest &dst = m_links[i]->m_routing_entry;
+        for (NodeID id = dst.nextDest(0); id < NetDest::MaxMachines;
+             id = dst.nextDest(id + 1)) {
+            if (id >= m_dest_link.size())
+                m_dest_link.resize(id + 1, -1);
+            if (m_dest_link[id] < 0)
+                m_dest_link[id] = i;
+        }
+    }
+    m_dest_link_valid = true;
+}
+
 void
 WeightBased::findRoute(const Message &msg,
                        std::vector<RouteInfo> &out_links) const
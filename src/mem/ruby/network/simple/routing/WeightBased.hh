@@ -80,10 +80,25 @@ class WeightBased : public BaseRoutingUnit
 
     std::vector<std::unique_ptr<LinkInfo>> m_links;
 
+    // Whether adaptive routing moved the links out of their static
+    // (weight, link id) order
+    bool m_links_reordered = false;
+
+    /**
+     * Position in m_links of the link that carries the messages to each
+     * destination, that is the first link whose routing entry contains
+     * it, or -1 if there is none. Rebuilt whenever the links are sorted.
+     */
+    std::vector<int> m_dest_link;
+    bool m_dest_link_valid = false;
+
+    void buildDestLinks();
+
     void findRoute(const Message &msg,
                    std::vector<RouteInfo> &out_links) const;
 
     void sortLinks() {
+        m_dest_link_valid = false;
         std::sort(m_links.begin(), m_links.end(),
             [](const auto &a, const auto &b) {
                 auto tup = [](const auto &li)
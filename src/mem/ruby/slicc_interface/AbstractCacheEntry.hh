@@ -51,6 +51,7 @@
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/common/ObjectPool.hh"
 #include "mem/ruby/protocol/AccessPermission.hh"
 
 namespace gem5
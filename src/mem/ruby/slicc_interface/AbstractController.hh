@@ -290,22 +290,49 @@ class AbstractController : public ClockedObject, public Consumer
         assert(iter != m_inTrans.end());
         auto &trans = iter->second;
 
-        auto stat_iter_ev = stats.inTransStateChanges.find(trans.transaction);
+        profileIncomingTransaction(trans.transaction, trans.state,
+                                   (unsigned)finalState,
+                                   ticksToCycles(curTick() - trans.time));
+
+       m_inTrans.erase(iter);
+    }
+
+    /**
+     * Profiles a transaction that completes within a single transition,
+     * as if it had been started with incomingTransactionStart latency
+     * cycles ago.
+     *
+     * @param type event that started the transaction
+     * @param initialState state of the line before the transaction
+     * @param finalState state of the line after the transaction
+     * @param latency latency to record for the transaction
+     */
+    template<typename EventType, typename StateType>
+    void incomingTransactionComplete(EventType type, StateType initialState,
+        StateType finalState, Cycles latency)
+    {
+        profileIncomingTransaction(type, initialState,
+                                   (unsigned)finalState, latency);
+    }
+
+    /** Records the stats of a completed incoming transaction */
+    void
+    profileIncomingTransaction(unsigned transaction, unsigned state,
+                               unsigned finalState, Cycles latency)
+    {
+        auto stat_iter_ev = stats.inTransStateChanges.find(transaction);
         gem5_assert(stat_iter_ev != stats.inTransStateChanges.end(),
           "%s: event type=%d not marked as in_trans in SLICC",
-          name(), trans.transaction);
+          name(), transaction);
 
-        auto stat_iter_state = stat_iter_ev->second.find(trans.state);
+        auto stat_iter_state = stat_iter_ev->second.find(state);
         gem5_assert(stat_iter_state != stat_iter_ev->second.end(),
           "%s: event type=%d has no transition from state=%d",
-          name(), trans.transaction, trans.state);
+          name(), transaction, state);
 
-        ++(*stat_iter_state->second[(unsigned)finalState]);
+        ++(*stat_iter_state->second[finalState]);
 
-        stats.inTransLatHist[iter->second.transaction]->sample(
-                                ticksToCycles(curTick() - trans.time));
-
-       m_inTrans.erase(iter);
+        stats.inTransLatHist[transaction]->sample(latency);
     }
 
     /**
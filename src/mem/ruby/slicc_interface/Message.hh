@@ -41,12 +41,17 @@
 #ifndef __MEM_RUBY_SLICC_INTERFACE_MESSAGE_HH__
 #define __MEM_RUBY_SLICC_INTERFACE_MESSAGE_HH__
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
-#include <memory>
+#include <new>
 #include <stack>
+#include <vector>
 
+#include "base/refcnt.hh"
 #include "mem/packet.hh"
 #include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/common/ObjectPool.hh"
 #include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/protocol/MessageSizeType.hh"
 
@@ -57,7 +62,7 @@ namespace ruby
 {
 
 class Message;
-typedef std::shared_ptr<Message> MsgPtr;
+typedef RefCountingPtr<Message> MsgPtr;
 
 class Message
 {
@@ -65,12 +70,56 @@ class Message
     Message(Tick curTime)
         : m_time(curTime),
           m_LastEnqueueTime(curTime),
-          m_DelayedTicks(0), m_msg_counter(0)
-    { }
+          m_DelayedTicks(0), m_msg_counter(0), m_refcount(0)
+    {
+        ++s_num_live;
+    }
 
-    Message(const Message &other) = default;
+    /** Copies start with no references, the count is not copied */
+    Message(const Message &other)
+        : m_time(other.m_time),
+          m_LastEnqueueTime(other.m_LastEnqueueTime),
+          m_DelayedTicks(other.m_DelayedTicks),
+          m_msg_counter(other.m_msg_counter),
+          incoming_link(other.incoming_link), vnet(other.vnet),
+          m_refcount(0)
+    {
+        ++s_num_live;
+    }
 
-    virtual ~Message() { }
+    Message &
+    operator=(const Message &other)
+    {
+        m_time = other.m_time;
+        m_LastEnqueueTime = other.m_LastEnqueueTime;
+        m_DelayedTicks = other.m_DelayedTicks;
+        m_msg_counter = other.m_msg_counter;
+        incoming_link = other.incoming_link;
+        vnet = other.vnet;
+        return *this;
+    }
+
+    virtual ~Message() { --s_num_live; }
+
+    /**
+     * Number of messages currently allocated. A message buffer or a
+     * network can only hold a copy of a line while some message is
+     * alive, which lets functional accesses skip scanning them.
+     */
+    static uint64_t numLive() { return s_num_live; }
+
+    /**
+     * Reference counting used by MsgPtr. Messages are only handled by
+     * the thread simulating the Ruby system, so the count does not need
+     * to be atomic.
+     */
+    void incref() const { ++m_refcount; }
+    void
+    decref() const
+    {
+        if (--m_refcount <= 0)
+            delete this;
+    }
 
     virtual MsgPtr clone() const = 0;
     virtual void print(std::ostream& out) const = 0;
@@ -130,6 +179,11 @@ class Message
     // Variables for required network traversal
     int incoming_link;
     int vnet;
+
+    mutable int m_refcount;
+
+    /** Allocated messages, see numLive() */
+    static inline uint64_t s_num_live = 0;
 };
 
 inline bool
@@ -214,8 +214,19 @@ class RubyRequest : public Message
     }
 
     RubyRequest(Tick curTime) : Message(curTime) {}
-    MsgPtr clone() const
-    { return std::shared_ptr<Message>(new RubyRequest(*this)); }
+    MsgPtr clone() const { return new RubyRequest(*this); }
+
+    static void *
+    operator new(std::size_t size)
+    {
+        return ObjectPool<RubyRequest>::allocate(size);
+    }
+
+    static void
+    operator delete(void *p, std::size_t size)
+    {
+        ObjectPool<RubyRequest>::release(p, size);
+    }
 
     Addr getLineAddress() const { return m_LineAddress; }
     Addr getPhysicalAddress() const { return m_PhysicalAddress; }
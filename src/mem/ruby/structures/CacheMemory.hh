@@ -42,13 +42,14 @@
 #ifndef __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
+#include <cstdint>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
 #include "mem/cache/replacement_policies/base.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "mem/ruby/common/AddressIndex.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/protocol/CacheRequestType.hh"
 #include "mem/ruby/protocol/CacheResourceType.hh"
@@ -173,18 +174,35 @@ class CacheMemory : public SimObject
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
 
+    AbstractCacheEntry *&
+    entryAt(int64_t set, int way)
+    {
+        return m_cache[set * m_cache_assoc + way];
+    }
+
+    AbstractCacheEntry *
+    entryAt(int64_t set, int way) const
+    {
+        return m_cache[set * m_cache_assoc + way];
+    }
+
   private:
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    // Maps the line address of every allocated block to its way
+    AddressIndex m_tag_index;
+
+    // The entries of all the sets, each set storing its m_cache_assoc
+    // ways contiguously. Use entryAt() to index it.
+    std::vector<AbstractCacheEntry*> m_cache;
 
     /** We use the replacement policies from the Classic memory system. */
     replacement_policy::Base *m_replacementPolicy_ptr;
 
+    /** Storage reused to pass the ways of a set to the replacement policy */
+    mutable std::vector<ReplaceableEntry*> m_victim_candidates;
+
     BankedArray dataArray;
     BankedArray tagArray;
     ALUFreeListArray atomicALUArray;
@@ -198,14 +216,15 @@ class CacheMemory : public SimObject
     int m_block_size;
 
     /**
-     * We store all the ReplacementData in a 2-dimensional array. By doing
-     * this, we can use all replacement policies from Classic system. Ruby
-     * cache will deallocate cache entry every time we evict the cache block
-     * so we cannot store the ReplacementData inside the cache entry.
+     * We store all the ReplacementData in a flat array, indexed like
+     * m_cache. By doing this, we can use all replacement policies from
+     * Classic system. Ruby cache will deallocate cache entry every time we
+     * evict the cache block so we cannot store the ReplacementData inside
+     * the cache entry.
      * Instantiate ReplacementData for multiple times will break replacement
      * policy like TreePLRU.
      */
-    std::vector<std::vector<ReplData> > replacement_data;
+    std::vector<ReplData> replacement_data;
 
     /**
      * Set to true when using WeightedLRU replacement policy, otherwise, set to
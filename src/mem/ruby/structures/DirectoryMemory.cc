@@ -56,7 +56,8 @@ namespace ruby
 {
 
 DirectoryMemory::DirectoryMemory(const Params &p)
-    : SimObject(p), addrRanges(p.addr_ranges.begin(), p.addr_ranges.end())
+    : SimObject(p), m_host_mem(name()),
+      addrRanges(p.addr_ranges.begin(), p.addr_ranges.end())
 {
     m_size_bytes = 0;
     for (const auto &r: addrRanges) {
@@ -64,26 +65,45 @@ DirectoryMemory::DirectoryMemory(const Params &p)
     }
     m_size_bits = floorLog2(m_size_bytes);
     m_num_entries = 0;
+    m_slab_used = SlabPages;
 }
 
 void
 DirectoryMemory::init()
 {
     m_num_entries = m_size_bytes / RubySystem::getBlockSizeBytes();
-    m_entries = new AbstractCacheEntry*[m_num_entries];
-    for (int i = 0; i < m_num_entries; i++)
-        m_entries[i] = NULL;
+    m_pages.assign(divCeil(m_num_entries, PageEntries), nullptr);
+    m_host_mem.add(m_pages.capacity() * sizeof(AbstractCacheEntry **));
 }
 
 DirectoryMemory::~DirectoryMemory()
 {
     // free up all the directory entries
-    for (uint64_t i = 0; i < m_num_entries; i++) {
-        if (m_entries[i] != NULL) {
-            delete m_entries[i];
+    for (auto page : m_pages) {
+        if (page == nullptr)
+            continue;
+        for (uint64_t i = 0; i < PageEntries; i++) {
+            delete page[i];
         }
     }
-    delete [] m_entries;
+}
+
+AbstractCacheEntry *&
+DirectoryMemory::getEntrySlot(uint64_t idx)
+{
+    assert(idx < m_num_entries);
+    AbstractCacheEntry **&page = m_pages[idx >> PageBits];
+    if (page == nullptr) {
+        if (m_slab_used == SlabPages) {
+            m_slabs.emplace_back(
+                    new AbstractCacheEntry *[SlabPages * PageEntries]());
+            m_slab_used = 0;
+            m_host_mem.add(
+                SlabPages * PageEntries * sizeof(AbstractCacheEntry *));
+        }
+        page = m_slabs.back().get() + m_slab_used++ * PageEntries;
+    }
+    return page[idx & (PageEntries - 1)];
 }
 
 bool
@@ -119,7 +139,8 @@ DirectoryMemory::lookup(Addr address)
 
     uint64_t idx = mapAddressToLocalIdx(address);
     assert(idx < m_num_entries);
-    return m_entries[idx];
+    AbstractCacheEntry **page = m_pages[idx >> PageBits];
+    return page ? page[idx & (PageEntries - 1)] : nullptr;
 }
 
 AbstractCacheEntry*
@@ -130,10 +151,11 @@ DirectoryMemory::allocate(Addr address, AbstractCacheEntry *entry)
     DPRINTF(RubyCache, "Looking up address: %#x\n", address);
 
     idx = mapAddressToLocalIdx(address);
-    assert(idx < m_num_entries);
-    assert(m_entries[idx] == NULL);
+    AbstractCacheEntry *&slot = getEntrySlot(idx);
+    assert(slot == NULL);
     entry->changePermission(AccessPermission_Read_Only);
-    m_entries[idx] = entry;
+    slot = entry;
+    m_host_mem.add(sizeof(AbstractCacheEntry));
 
     return entry;
 }
@@ -146,10 +168,11 @@ DirectoryMemory::deallocate(Addr address)
     DPRINTF(RubyCache, "Removing entry for address: %#x\n", address);
 
     idx = mapAddressToLocalIdx(address);
-    assert(idx < m_num_entries);
-    assert(m_entries[idx] != NULL);
-    delete m_entries[idx];
-    m_entries[idx] = NULL;
+    AbstractCacheEntry *&slot = getEntrySlot(idx);
+    assert(slot != NULL);
+    delete slot;
+    slot = NULL;
+    m_host_mem.sub(sizeof(AbstractCacheEntry));
 }
 
 void
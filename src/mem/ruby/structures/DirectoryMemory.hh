@@ -42,13 +42,16 @@
 #define __MEM_RUBY_STRUCTURES_DIRECTORYMEMORY_HH__
 
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "base/addr_range.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/protocol/DirectoryRequestType.hh"
 #include "mem/ruby/slicc_interface/AbstractCacheEntry.hh"
 #include "params/RubyDirectoryMemory.hh"
+#include "sim/host_mem.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -96,9 +99,44 @@ class DirectoryMemory : public SimObject
     DirectoryMemory(const DirectoryMemory& obj);
     DirectoryMemory& operator=(const DirectoryMemory& obj);
 
+    /**
+     * Return the slot of an entry in its page, the page being allocated
+     * if needed
+     *
+     * @param idx index of the entry in the directory
+     * @return the slot holding the entry
+     */
+    AbstractCacheEntry *&getEntrySlot(uint64_t idx);
+
   private:
+    /** Number of entries in a page, log2 */
+    static constexpr unsigned PageBits = 12;
+    static constexpr uint64_t PageEntries = 1ULL << PageBits;
+
+    /** Number of pages allocated at once */
+    static constexpr uint64_t SlabPages = 16;
+
     const std::string m_name;
-    AbstractCacheEntry **m_entries;
+
+    /**
+     * The entries are stored in pages of PageEntries pointers, only
+     * allocated when an entry in them is first allocated, so the host
+     * memory used follows the memory actually touched rather than the
+     * size of the directory. Pages which were never touched are null.
+     */
+    std::vector<AbstractCacheEntry **> m_pages;
+
+    /** Backing storage of the pages, SlabPages pages at a time */
+    std::vector<std::unique_ptr<AbstractCacheEntry *[]>> m_slabs;
+
+    /** Number of pages handed out from the last slab */
+    uint64_t m_slab_used;
+
+    /**
+     * The pages and slabs, and the entries counted at the size of an
+     * AbstractCacheEntry, which the entries of the protocols extend.
+     */
+    host_mem::Account m_host_mem;
     // int m_size;  // # of memory module blocks this directory is
                     // responsible for
     uint64_t m_size_bytes;
@@ -58,9 +58,9 @@ RubyPrefetcher::RubyPrefetcher(const Params &p)
     : SimObject(p), m_num_streams(p.num_streams),
     m_array(p.num_streams), m_train_misses(p.train_misses),
     m_num_startup_pfs(p.num_startup_pfs),
-    unitFilter(p.unit_filter),
-    negativeFilter(p.unit_filter),
-    nonUnitFilter(p.nonunit_filter),
+    unitFilter(p.unit_filter, p.filter_assoc),
+    negativeFilter(p.unit_filter, p.filter_assoc),
+    nonUnitFilter(p.nonunit_filter, p.filter_assoc),
     m_prefetch_cross_pages(p.cross_page),
     pageShift(p.page_shift),
     rubyPrefetcherStats(this)
@@ -173,6 +173,7 @@ RubyPrefetcher::issueNextPrefetch(Addr address, PrefetchEntry *stream)
         if (!m_prefetch_cross_pages) {
             // Deallocate the stream since we are not prefetching
             // across page boundries
+            unlinkStream(stream - m_array.data());
             stream->m_is_valid = false;
             return;
         }
@@ -181,7 +182,9 @@ RubyPrefetcher::issueNextPrefetch(Addr address, PrefetchEntry *stream)
 
     // launch next prefetch
     rubyPrefetcherStats.numPrefetchRequested++;
+    unlinkStream(stream - m_array.data());
     stream->m_address = line_addr;
+    linkStream(stream - m_array.data());
     stream->m_use_time = m_controller->curCycle();
     DPRINTF(RubyPrefetcher, "Requesting prefetch for %#x\n", line_addr);
     m_controller->enqueuePrefetch(line_addr, stream->m_type);
@@ -214,6 +217,8 @@ RubyPrefetcher::initializeStream(Addr address, int stride,
 
     // initialize the stream prefetcher
     PrefetchEntry *mystream = &(m_array[index]);
+    if (mystream->m_is_valid)
+        unlinkStream(index);
     mystream->m_address = makeLineAddress(address);
     mystream->m_stride = stride;
     mystream->m_use_time = m_controller->curCycle();
@@ -245,45 +250,81 @@ RubyPrefetcher::initializeStream(Addr address, int stride,
 
     // update the address to be the last address prefetched
     mystream->m_address = line_addr;
+    linkStream(index);
+}
+
+void
+RubyPrefetcher::linkStream(uint32_t index)
+{
+    const PrefetchEntry &stream = m_array[index];
+    for (int j = 0; j < m_num_startup_pfs; j++) {
+        m_stream_lookup.emplace(makeNextStrideAddress(stream.m_address,
+            -(stream.m_stride * j)), index);
+    }
+}
+
+void
+RubyPrefetcher::unlinkStream(uint32_t index)
+{
+    const PrefetchEntry &stream = m_array[index];
+    for (int j = 0; j < m_num_startup_pfs; j++) {
+        auto range = m_stream_lookup.equal_range(makeNextStrideAddress(
+            stream.m_address, -(stream.m_stride * j)));
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == index) {
+                m_stream_lookup.erase(it);
+                break;
+            }
+        }
+    }
 }
 
 PrefetchEntry *
 RubyPrefetcher::getPrefetchEntry(Addr address, uint32_t &index)
 {
-    // search all streams for a match
-    for (int i = 0; i < m_num_streams; i++) {
-        // search all the outstanding prefetches for this stream
-        if (m_array[i].m_is_valid) {
-            for (int j = 0; j < m_num_startup_pfs; j++) {
-                if (makeNextStrideAddress(m_array[i].m_address,
-                    -(m_array[i].m_stride*j)) == address) {
-                    return &(m_array[i]);
-                }
-            }
+    // of all the streams with an outstanding prefetch for this address,
+    // return the first one, as searching them in order would
+    auto range = m_stream_lookup.equal_range(address);
+    PrefetchEntry *match = NULL;
+    for (auto it = range.first; it != range.second; ++it) {
+        PrefetchEntry *stream = &m_array[it->second];
+        if (match == NULL || stream < match)
+            match = stream;
+    }
+    if (match == NULL)
+        return NULL;
+
+    for (int j = 0; j < m_num_startup_pfs; j++) {
+        if (makeNextStrideAddress(match->m_address,
+            -(match->m_stride * j)) == address) {
+            index = j;
+            break;
         }
     }
-    return NULL;
+    return match;
 }
 
 bool
-RubyPrefetcher::accessUnitFilter(CircularQueue<UnitFilterEntry>* const filter,
+RubyPrefetcher::accessUnitFilter(FilterTable<UnitFilterEntry>* const filter,
     Addr line_addr, int stride, const RubyRequestType& type)
 {
-    for (auto& entry : *filter) {
-        if (entry.addr == line_addr) {
-            entry.addr = makeNextStrideAddress(entry.addr, stride);
-            entry.hits++;
-            if (entry.hits >= m_train_misses) {
-                // Allocate a new prefetch stream
-                initializeStream(line_addr, stride, getLRUindex(), type);
-            }
-            return true;
+    const int idx = filter->find(line_addr);
+    if (idx != -1) {
+        UnitFilterEntry &entry = (*filter)[idx];
+        entry.addr = makeNextStrideAddress(entry.addr, stride);
+        entry.hits++;
+        const bool train = entry.hits >= m_train_misses;
+        filter->setKey(idx, entry.addr);
+        if (train) {
+            // Allocate a new prefetch stream
+            initializeStream(line_addr, stride, getLRUindex(), type);
         }
+        return true;
     }
 
     // Enter this address in the filter
-    filter->push_back(UnitFilterEntry(
-        makeNextStrideAddress(line_addr, stride)));
+    const Addr next_addr = makeNextStrideAddress(line_addr, stride);
+    filter->insert(next_addr, UnitFilterEntry(next_addr));
 
     return false;
 }
@@ -295,49 +336,49 @@ RubyPrefetcher::accessNonunitFilter(Addr line_addr,
     /// look for non-unit strides based on a (user-defined) page size
     Addr page_addr = pageAddress(line_addr);
 
-    for (auto& entry : nonUnitFilter) {
-        if (pageAddress(entry.addr) == page_addr) {
-            // hit in the non-unit filter
-            // compute the actual stride (for this reference)
-            int delta = line_addr - entry.addr;
-
-            if (delta != 0) {
-                // no zero stride prefetches
-                // check that the stride matches (for the last N times)
-                if (delta == entry.stride) {
-                    // -> stride hit
-                    // increment count (if > 2) allocate stream
-                    entry.hits++;
-                    if (entry.hits > m_train_misses) {
-                        // This stride HAS to be the multiplicative constant of
-                        // dataBlockBytes (bc makeNextStrideAddress is
-                        // calculated based on this multiplicative constant!)
-                        const int stride = entry.stride /
-                            RubySystem::getBlockSizeBytes();
-
-                        // clear this filter entry
-                        entry.clear();
-
-                        initializeStream(line_addr, stride, getLRUindex(),
-                            type);
-                    }
-                } else {
-                    // If delta didn't match reset entry's hit count
-                    entry.hits = 0;
+    const int idx = nonUnitFilter.find(page_addr);
+    if (idx != -1) {
+        NonUnitFilterEntry &entry = nonUnitFilter[idx];
+        // hit in the non-unit filter
+        // compute the actual stride (for this reference)
+        int delta = line_addr - entry.addr;
+
+        if (delta != 0) {
+            // no zero stride prefetches
+            // check that the stride matches (for the last N times)
+            if (delta == entry.stride) {
+                // -> stride hit
+                // increment count (if > 2) allocate stream
+                entry.hits++;
+                if (entry.hits > m_train_misses) {
+                    // This stride HAS to be the multiplicative constant of
+                    // dataBlockBytes (bc makeNextStrideAddress is
+                    // calculated based on this multiplicative constant!)
+                    const int stride = entry.stride /
+                        RubySystem::getBlockSizeBytes();
+
+                    // clear this filter entry
+                    entry.clear();
+
+                    initializeStream(line_addr, stride, getLRUindex(),
+                        type);
                 }
-
-                // update the last address seen & the stride
-                entry.addr = line_addr;
-                entry.stride = delta;
-                return true;
             } else {
-                return false;
+                // If delta didn't match reset entry's hit count
+                entry.hits = 0;
             }
+
+            // update the last address seen & the stride
+            entry.addr = line_addr;
+            entry.stride = delta;
+            return true;
+        } else {
+            return false;
         }
     }
 
     // not found: enter this address in the table
-    nonUnitFilter.push_back(NonUnitFilterEntry(line_addr));
+    nonUnitFilter.insert(page_addr, NonUnitFilterEntry(line_addr));
 
     return false;
 }
@@ -348,22 +389,22 @@ RubyPrefetcher::print(std::ostream& out) const
     out << name() << " Prefetcher State\n";
     // print out unit filter
     out << "unit table:\n";
-    for (const auto& entry : unitFilter) {
+    unitFilter.forEach([&out](const UnitFilterEntry &entry) {
         out << entry.addr << std::endl;
-    }
+    });
 
     out << "negative table:\n";
-    for (const auto& entry : negativeFilter) {
+    negativeFilter.forEach([&out](const UnitFilterEntry &entry) {
         out << entry.addr << std::endl;
-    }
+    });
 
     // print out non-unit stride filter
     out << "non-unit table:\n";
-    for (const auto& entry : nonUnitFilter) {
+    nonUnitFilter.forEach([&out](const NonUnitFilterEntry &entry) {
         out << entry.addr << " "
             << entry.stride << " "
             << entry.hits << std::endl;
-    }
+    });
 
     // print out allocated stream buffers
     out << "streams:\n";
@@ -45,8 +45,10 @@
 // Implements Power 4 like prefetching
 
 #include <bitset>
+#include <unordered_map>
+#include <vector>
 
-#include "base/circular_queue.hh"
+#include "base/logging.hh"
 #include "base/statistics.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/network/MessageBuffer.hh"
@@ -142,6 +144,99 @@ class RubyPrefetcher : public SimObject
             }
         };
 
+        /**
+         * Small set associative table of filter entries, each stored
+         * with the key it is found by. Within a set, entries are looked
+         * up and replaced oldest first, so a table with a single set
+         * behaves like a FIFO of the entries.
+         */
+        template <class Entry>
+        class FilterTable
+        {
+          private:
+            struct Slot
+            {
+                bool valid = false;
+                Addr key = 0;
+                Entry entry;
+            };
+
+            const unsigned ways;
+            const unsigned numSets;
+            std::vector<Slot> slots;
+            /** Oldest way of each set, replaced next */
+            std::vector<unsigned> oldest;
+
+            unsigned
+            setOf(Addr key) const
+            {
+                if (numSets == 1)
+                    return 0;
+                const uint64_t hash = key * 0x9e3779b97f4a7c15ULL;
+                return (hash >> 32) % numSets;
+            }
+
+          public:
+            FilterTable(unsigned entries, unsigned assoc)
+              : ways(assoc ? assoc : entries), numSets(entries / ways),
+                slots(entries), oldest(numSets, 0)
+            {
+                fatal_if(!entries || entries % ways,
+                         "Filter size %d isn't a multiple of its "
+                         "associativity %d\n", entries, ways);
+            }
+
+            /** The slot of the oldest entry with key, or -1 if none */
+            int
+            find(Addr key) const
+            {
+                const unsigned set = setOf(key);
+                for (unsigned i = 0; i < ways; i++) {
+                    const int idx = set * ways + (oldest[set] + i) % ways;
+                    if (slots[idx].valid && slots[idx].key == key)
+                        return idx;
+                }
+                return -1;
+            }
+
+            Entry &operator[](int idx) { return slots[idx].entry; }
+
+            /** Insert an entry in place of the oldest one of its set */
+            void
+            insert(Addr key, const Entry &entry)
+            {
+                const unsigned set = setOf(key);
+                Slot &slot = slots[set * ways + oldest[set]];
+                oldest[set] = (oldest[set] + 1) % ways;
+                slot.valid = true;
+                slot.key = key;
+                slot.entry = entry;
+            }
+
+            /** Change the key of an entry, which may move it */
+            void
+            setKey(int idx, Addr key)
+            {
+                Slot &slot = slots[idx];
+                if (setOf(key) == setOf(slot.key)) {
+                    slot.key = key;
+                } else {
+                    slot.valid = false;
+                    insert(key, slot.entry);
+                }
+            }
+
+            template <class F>
+            void
+            forEach(F f) const
+            {
+                for (const Slot &slot : slots) {
+                    if (slot.valid)
+                        f(slot.entry);
+                }
+            }
+        };
+
         struct NonUnitFilterEntry : public UnitFilterEntry
         {
             /** Stride (in # of cache lines). */
@@ -177,6 +272,11 @@ class RubyPrefetcher : public SimObject
         PrefetchEntry* getPrefetchEntry(Addr address,
             uint32_t &index);
 
+        //! add (remove) the outstanding prefetches of a stream to (from)
+        //! m_stream_lookup
+        void linkStream(uint32_t index);
+        void unlinkStream(uint32_t index);
+
         /**
          * Access a unit stride filter to determine if there is a hit, and
          * update it otherwise.
@@ -187,7 +287,7 @@ class RubyPrefetcher : public SimObject
          * @param type Type of the request that generated the access.
          * @return True if a corresponding entry was found.
          */
-        bool accessUnitFilter(CircularQueue<UnitFilterEntry>* const filter,
+        bool accessUnitFilter(FilterTable<UnitFilterEntry>* const filter,
             Addr line_addr, int stride, const RubyRequestType& type);
 
         /**
@@ -208,6 +308,10 @@ class RubyPrefetcher : public SimObject
         uint32_t m_num_streams;
         //! an array of the active prefetch streams
         std::vector<PrefetchEntry> m_array;
+        //! the streams of the addresses of the outstanding prefetches of
+        //! all valid streams, i.e., the num_startup_pfs addresses ending
+        //! with their m_address
+        std::unordered_multimap<Addr, uint32_t> m_stream_lookup;
 
         //! number of misses I must see before allocating a stream
         uint32_t m_train_misses;
@@ -218,19 +322,19 @@ class RubyPrefetcher : public SimObject
          * A unit stride filter array: helps reduce BW requirement
          * of prefetching.
          */
-        CircularQueue<UnitFilterEntry> unitFilter;
+        FilterTable<UnitFilterEntry> unitFilter;
 
         /**
          * A negative unit stride filter array: helps reduce BW requirement
          * of prefetching.
          */
-        CircularQueue<UnitFilterEntry> negativeFilter;
+        FilterTable<UnitFilterEntry> negativeFilter;
 
         /**
          * A non-unit stride filter array: helps reduce BW requirement of
          * prefetching.
          */
-        CircularQueue<NonUnitFilterEntry> nonUnitFilter;
+        FilterTable<NonUnitFilterEntry> nonUnitFilter;
 
         /// Used for allowing prefetches across pages.
         bool m_prefetch_cross_pages;
@@ -52,6 +52,11 @@ class RubyPrefetcher(SimObject):
     nonunit_filter = Param.UInt32(
         8, "Number of entries in the non-unit filter array"
     )
+    filter_assoc = Param.UInt32(
+        0,
+        "Associativity of the unit and non-unit filters, 0 for fully "
+        "associative",
+    )
     train_misses = Param.UInt32(4, "")
     num_startup_pfs = Param.UInt32(1, "")
     cross_page = Param.Bool(
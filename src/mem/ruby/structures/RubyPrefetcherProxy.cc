@@ -107,47 +107,55 @@ RubyPrefetcherProxy::issuePrefetch()
     assert(prefetcher);
     assert(pfQueue);
 
-    if (pfQueue->areNSlotsAvailable(1, curTick())) {
-        PacketPtr pkt = prefetcher->getPacket();
+    // Issue all the prefetches which are ready while there are slots for
+    // them, rather than a single one per event
+    bool issue_more = true;
+    while (issue_more) {
+        if (!pfQueue->areNSlotsAvailable(1, curTick())) {
+            DPRINTF(HWPrefetch, "No prefetch slots are available\n");
+            break;
+        }
 
-        if (pkt) {
-            DPRINTF(HWPrefetch, "Next prefetch ready %s\n", pkt->print());
-            unsigned blk_size = RubySystem::getBlockSizeBytes();
-            Addr line_addr = pkt->getBlockAddr(blk_size);
-
-            if (issuedPfPkts.count(line_addr) == 0) {
-                DPRINTF(HWPrefetch, "Issued PF request for paddr=%#x, "
-                                    "line_addr=%#x, is_write=%d\n",
-                                    pkt->getAddr(), line_addr,
-                                    pkt->needsWritable());
-
-                RubyRequestType req_type = pkt->needsWritable() ?
-                                    RubyRequestType_ST : RubyRequestType_LD;
-
-                std::shared_ptr<RubyRequest> msg =
-                    std::make_shared<RubyRequest>(cacheCntrl->clockEdge(),
-                                                  pkt->getAddr(),
-                                                  blk_size,
-                                                  0, // pc
-                                                  req_type,
-                                                  RubyAccessMode_Supervisor,
-                                                  pkt,
-                                                  PrefetchBit_Yes);
-
-                // enqueue request into prefetch queue to the cache
-                pfQueue->enqueue(msg, cacheCntrl->clockEdge(),
-                                    cacheCntrl->cyclesToTicks(Cycles(1)));
-
-                // track all pending PF requests
-                issuedPfPkts[line_addr] = pkt;
-            } else {
-                DPRINTF(HWPrefetch, "Aborted PF request for address being "
-                                    "prefetched\n");
-                delete pkt;
-            }
+        PacketPtr pkt = prefetcher->getPacket();
+        if (!pkt)
+            break;
+
+        DPRINTF(HWPrefetch, "Next prefetch ready %s\n", pkt->print());
+        unsigned blk_size = RubySystem::getBlockSizeBytes();
+        Addr line_addr = pkt->getBlockAddr(blk_size);
+
+        if (issuedPfPkts.count(line_addr) == 0) {
+            DPRINTF(HWPrefetch, "Issued PF request for paddr=%#x, "
+                                "line_addr=%#x, is_write=%d\n",
+                                pkt->getAddr(), line_addr,
+                                pkt->needsWritable());
+
+            RubyRequestType req_type = pkt->needsWritable() ?
+                                RubyRequestType_ST : RubyRequestType_LD;
+
+            RefCountingPtr<RubyRequest> msg =
+                new RubyRequest(cacheCntrl->clockEdge(),
+                                pkt->getAddr(),
+                                blk_size,
+                                0, // pc
+                                req_type,
+                                RubyAccessMode_Supervisor,
+                                pkt,
+                                PrefetchBit_Yes);
+
+            // enqueue request into prefetch queue to the cache
+            pfQueue->enqueue(msg, cacheCntrl->clockEdge(),
+                                cacheCntrl->cyclesToTicks(Cycles(1)));
+
+            // track all pending PF requests
+            issuedPfPkts[line_addr] = pkt;
+        } else {
+            DPRINTF(HWPrefetch, "Aborted PF request for address being "
+                                "prefetched\n");
+            delete pkt;
         }
-    } else {
-        DPRINTF(HWPrefetch, "No prefetch slots are available\n");
+
+        issue_more = prefetcher->nextPrefetchReadyTime() <= curTick();
     }
 
     scheduleNextPrefetch();
@@ -42,9 +42,13 @@
 #define __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 
 #include <iostream>
-#include <unordered_map>
+#include <memory>
+#include <new>
+#include <vector>
 
+#include "base/logging.hh"
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/common/AddressIndex.hh"
 
 namespace gem5
 {
@@ -52,13 +56,34 @@ namespace gem5
 namespace ruby
 {
 
+/**
+ * Table of the TBEs of a controller, indexed by line address. The storage
+ * of all the entries is allocated up front for the number of TBEs of the
+ * controller, and entries are constructed in place in a free slot when
+ * they are allocated, so allocating and deallocating a TBE on a miss
+ * neither goes through the heap nor rehashes.
+ */
 template<class ENTRY>
 class TBETable
 {
   public:
     TBETable(int number_of_TBEs)
-        : m_number_of_TBEs(number_of_TBEs)
+        : m_number_of_TBEs(number_of_TBEs),
+          m_storage(new Storage[number_of_TBEs]),
+          m_slot_address(number_of_TBEs, MaxAddr)
+    {
+        m_index.init(number_of_TBEs);
+        m_free_slots.reserve(number_of_TBEs);
+        for (int slot = number_of_TBEs - 1; slot >= 0; slot--)
+            m_free_slots.push_back(slot);
+    }
+
+    ~TBETable()
     {
+        for (int slot = 0; slot < m_number_of_TBEs; slot++) {
+            if (slotEntry(slot))
+                slotEntry(slot)->~ENTRY();
+        }
     }
 
     bool isPresent(Addr address) const;
@@ -67,7 +92,7 @@ class TBETable
     bool
     areNSlotsAvailable(int n, Tick current_time) const
     {
-        return (m_number_of_TBEs - m_map.size()) >= n;
+        return (int)m_free_slots.size() >= n;
     }
 
     ENTRY *getNullEntry();
@@ -81,11 +106,33 @@ class TBETable
     TBETable(const TBETable& obj);
     TBETable& operator=(const TBETable& obj);
 
-    // Data Members (m_prefix)
-    std::unordered_map<Addr, ENTRY> m_map;
+    int numSlots() const { return m_number_of_TBEs; }
+
+    /** Returns the entry held in a slot, or nullptr if the slot is free */
+    ENTRY *
+    slotEntry(int slot)
+    {
+        if (m_slot_address[slot] == MaxAddr)
+            return nullptr;
+        return std::launder(reinterpret_cast<ENTRY *>(&m_storage[slot]));
+    }
 
   private:
+    struct alignas(ENTRY) Storage
+    {
+        unsigned char bytes[sizeof(ENTRY)];
+    };
+
     int m_number_of_TBEs;
+
+    std::unique_ptr<Storage[]> m_storage;
+
+    /** Address of the entry of each slot, MaxAddr for free slots */
+    std::vector<Addr> m_slot_address;
+    std::vector<int> m_free_slots;
+
+    /** Maps the address of every allocated entry to its slot */
+    AddressIndex m_index;
 };
 
 template<class ENTRY>
@@ -102,8 +149,7 @@ inline bool
 TBETable<ENTRY>::isPresent(Addr address) const
 {
     assert(address == makeLineAddress(address));
-    assert(m_map.size() <= m_number_of_TBEs);
-    return !!m_map.count(address);
+    return m_index.find(address) != -1;
 }
 
 template<class ENTRY>
@@ -111,8 +157,14 @@ inline void
 TBETable<ENTRY>::allocate(Addr address)
 {
     assert(!isPresent(address));
-    assert(m_map.size() < m_number_of_TBEs);
-    m_map[address] = ENTRY();
+    panic_if(m_free_slots.empty(),
+             "Allocating more than the %d TBEs of the table\n",
+             m_number_of_TBEs);
+    int slot = m_free_slots.back();
+    m_free_slots.pop_back();
+    new (&m_storage[slot]) ENTRY();
+    m_slot_address[slot] = address;
+    m_index.insert(address, slot);
 }
 
 template<class ENTRY>
@@ -120,8 +172,11 @@ inline void
 TBETable<ENTRY>::deallocate(Addr address)
 {
     assert(isPresent(address));
-    assert(m_map.size() > 0);
-    m_map.erase(address);
+    int slot = m_index.find(address);
+    slotEntry(slot)->~ENTRY();
+    m_slot_address[slot] = MaxAddr;
+    m_free_slots.push_back(slot);
+    m_index.erase(address);
 }
 
 template<class ENTRY>
@@ -136,8 +191,10 @@ template<class ENTRY>
 inline ENTRY*
 TBETable<ENTRY>::lookup(Addr address)
 {
-  if (m_map.find(address) != m_map.end()) return &(m_map.find(address)->second);
-  return NULL;
+    int slot = m_index.find(address);
+    if (slot == -1)
+        return NULL;
+    return slotEntry(slot);
 }
 
 
@@ -52,19 +52,22 @@ TraceRecord::print(std::ostream& out) const
 CacheRecorder::CacheRecorder()
     : m_uncompressed_trace(NULL),
       m_uncompressed_trace_size(0),
-      m_block_size_bytes(RubySystem::getBlockSizeBytes())
+      m_block_size_bytes(RubySystem::getBlockSizeBytes()),
+      m_parallel_warmup(false), m_records_fetched(0)
 {
 }
 
 CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
                              uint64_t uncompressed_trace_size,
                              std::vector<RubyPort*>& ruby_port_map,
-                             uint64_t block_size_bytes)
+                             uint64_t block_size_bytes,
+                             bool parallel_warmup)
     : m_uncompressed_trace(uncompressed_trace),
       m_uncompressed_trace_size(uncompressed_trace_size),
       m_ruby_port_map(ruby_port_map), m_bytes_read(0),
       m_records_read(0), m_records_flushed(0),
-      m_block_size_bytes(block_size_bytes)
+      m_block_size_bytes(block_size_bytes),
+      m_parallel_warmup(parallel_warmup), m_records_fetched(0)
 
 {
     if (m_uncompressed_trace != NULL) {
@@ -93,9 +96,9 @@ CacheRecorder::enqueueNextFlushRequest()
     if (m_records_flushed < m_records.size()) {
         TraceRecord* rec = m_records[m_records_flushed];
         m_records_flushed++;
-        auto req = std::make_shared<Request>(rec->m_data_address,
-                                             m_block_size_bytes, 0,
-                                             Request::funcRequestorId);
+        auto req = makeRequest(rec->m_data_address,
+                               m_block_size_bytes, 0,
+                               Request::funcRequestorId);
         MemCmd::Command requestType = MemCmd::FlushReq;
         Packet *pkt = new Packet(req, requestType);
         pkt->req->setReqInstSeqNum(m_records_flushed);
@@ -115,59 +118,153 @@ CacheRecorder::enqueueNextFlushRequest()
     }
 }
 
-void
-CacheRecorder::enqueueNextFetchRequest()
+int
+CacheRecorder::issueFetchRequest(TraceRecord *traceRecord)
 {
-    if (m_bytes_read < m_uncompressed_trace_size) {
-        TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
-                                                                m_bytes_read);
+    DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
+
+    int num_requests = 0;
+    for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
+            rec_bytes_read += RubySystem::getBlockSizeBytes()) {
+        RequestPtr req;
+        MemCmd::Command requestType;
+
+        if (traceRecord->m_type == RubyRequestType_LD) {
+            requestType = MemCmd::ReadReq;
+            req = makeRequest(
+                traceRecord->m_data_address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0,
+                                Request::funcRequestorId);
+        }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
+            requestType = MemCmd::ReadReq;
+            req = makeRequest(
+                    traceRecord->m_data_address + rec_bytes_read,
+                    RubySystem::getBlockSizeBytes(),
+                    Request::INST_FETCH, Request::funcRequestorId);
+        }   else {
+            requestType = MemCmd::WriteReq;
+            req = makeRequest(
+                traceRecord->m_data_address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0,
+                            Request::funcRequestorId);
+        }
 
-        DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
+        Packet *pkt = new Packet(req, requestType);
+        pkt->dataStatic(traceRecord->m_data + rec_bytes_read);
+        pkt->req->setReqInstSeqNum(m_records_read);
 
-        for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
-                rec_bytes_read += RubySystem::getBlockSizeBytes()) {
-            RequestPtr req;
-            MemCmd::Command requestType;
 
-            if (traceRecord->m_type == RubyRequestType_LD) {
-                requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
-                    traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0,
-                                    Request::funcRequestorId);
-            }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
-                requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
-                        traceRecord->m_data_address + rec_bytes_read,
-                        RubySystem::getBlockSizeBytes(),
-                        Request::INST_FETCH, Request::funcRequestorId);
-            }   else {
-                requestType = MemCmd::WriteReq;
-                req = std::make_shared<Request>(
-                    traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0,
-                                Request::funcRequestorId);
-            }
+        RubyPort* m_ruby_port_ptr =
+            m_ruby_port_map[traceRecord->m_cntrl_id];
+        assert(m_ruby_port_ptr != NULL);
+        m_ruby_port_ptr->makeRequest(pkt);
+        num_requests++;
+    }
 
-            Packet *pkt = new Packet(req, requestType);
-            pkt->dataStatic(traceRecord->m_data + rec_bytes_read);
-            pkt->req->setReqInstSeqNum(m_records_read);
+    m_records_read++;
+    return num_requests;
+}
 
+void
+CacheRecorder::enqueueNextFetchRequest(RubyPort *port)
+{
+    if (m_parallel_warmup) {
+        if (port == nullptr) {
+            startParallelFetch();
+            return;
+        }
 
-            RubyPort* m_ruby_port_ptr =
-                m_ruby_port_map[traceRecord->m_cntrl_id];
-            assert(m_ruby_port_ptr != NULL);
-            m_ruby_port_ptr->makeRequest(pkt);
+        int port_idx = m_port_fetch_idx.at(port);
+        PortFetchState &state = m_port_fetch[port_idx];
+        assert(state.outstanding > 0);
+        if (--state.outstanding > 0)
+            return;
+
+        // the record is complete, let the next record for its block go
+        TraceRecord *rec = state.inFlight;
+        state.inFlight = nullptr;
+        m_records_fetched++;
+
+        auto block = m_block_fetch.find(rec->m_data_address);
+        assert(block->second.front() == rec);
+        block->second.pop_front();
+        if (block->second.empty()) {
+            m_block_fetch.erase(block);
+        } else {
+            RubyPort *next_port =
+                m_ruby_port_map[block->second.front()->m_cntrl_id];
+            tryParallelFetch(m_port_fetch_idx.at(next_port));
         }
+        tryParallelFetch(port_idx);
+
+        if (m_block_fetch.empty()) {
+            exitSimLoop("Finished Warmup", 0);
+            DPRINTF(RubyCacheTrace, "Fetched all %d records\n",
+                    m_records_fetched);
+        }
+        return;
+    }
 
+    if (m_bytes_read < m_uncompressed_trace_size) {
+        TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
+                                                                m_bytes_read);
+        issueFetchRequest(traceRecord);
         m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
-        m_records_read++;
     } else {
         exitSimLoop("Finished Warmup", 0);
         DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
     }
 }
 
+void
+CacheRecorder::startParallelFetch()
+{
+    for (RubyPort *port : m_ruby_port_map) {
+        if (m_port_fetch_idx.emplace(port, m_port_fetch.size()).second) {
+            m_port_fetch.push_back({port});
+        }
+    }
+
+    for (; m_bytes_read < m_uncompressed_trace_size;
+         m_bytes_read += sizeof(TraceRecord) + m_block_size_bytes) {
+        TraceRecord *rec =
+            (TraceRecord *)(m_uncompressed_trace + m_bytes_read);
+        RubyPort *port = m_ruby_port_map[rec->m_cntrl_id];
+        m_port_fetch[m_port_fetch_idx.at(port)].pending.push_back(rec);
+        m_block_fetch[rec->m_data_address].push_back(rec);
+    }
+
+    if (m_block_fetch.empty()) {
+        exitSimLoop("Finished Warmup", 0);
+        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", 0);
+        return;
+    }
+
+    DPRINTF(RubyCacheTrace, "Fetching %d blocks through %d sequencers\n",
+            m_block_fetch.size(), m_port_fetch.size());
+
+    for (int port_idx = 0; port_idx < m_port_fetch.size(); port_idx++) {
+        tryParallelFetch(port_idx);
+    }
+}
+
+void
+CacheRecorder::tryParallelFetch(int port_idx)
+{
+    PortFetchState &state = m_port_fetch[port_idx];
+    if (state.inFlight || state.pending.empty())
+        return;
+
+    // wait for the earlier records of the block to complete
+    TraceRecord *rec = state.pending.front();
+    if (m_block_fetch.at(rec->m_data_address).front() != rec)
+        return;
+
+    state.pending.pop_front();
+    state.inFlight = rec;
+    state.outstanding = issueFetchRequest(rec);
+}
+
 void
 CacheRecorder::addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                          RubyRequestType type, Tick time, DataBlock& data)
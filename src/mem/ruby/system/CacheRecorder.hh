@@ -35,6 +35,8 @@
 #ifndef __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 #define __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 
+#include <deque>
+#include <unordered_map>
 #include <vector>
 
 #include "base/types.hh"
@@ -79,7 +81,8 @@ class CacheRecorder
     CacheRecorder(uint8_t* uncompressed_trace,
                   uint64_t uncompressed_trace_size,
                   std::vector<RubyPort*>& ruby_port_map,
-                  uint64_t block_size_bytes);
+                  uint64_t block_size_bytes,
+                  bool parallel_warmup = false);
     void addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                    RubyRequestType type, Tick time, DataBlock& data);
 
@@ -103,14 +106,40 @@ class CacheRecorder
      * checkpoint and issues fetch requests. Except for the first one, a
      * fetch request is issued only after the previous one has completed.
      * It should be possible to use this with any protocol.
+     *
+     * With parallel warmup, the sequencers work through their own
+     * records concurrently, one record at a time each. A record is
+     * issued only after the earlier records for the same block have
+     * completed, so every block sees its accesses in trace order.
+     *
+     * @param port The sequencer that completed a fetch request, or
+     *             nullptr to start fetching
      */
-    void enqueueNextFetchRequest();
+    void enqueueNextFetchRequest(RubyPort *port = nullptr);
 
   private:
     // Private copy constructor and assignment operator
     CacheRecorder(const CacheRecorder& obj);
     CacheRecorder& operator=(const CacheRecorder& obj);
 
+    /** Issue the requests fetching a record, returning how many */
+    int issueFetchRequest(TraceRecord *rec);
+
+    /** Distribute the records of the trace to their sequencers */
+    void startParallelFetch();
+
+    /** Issue the next record of a sequencer if it is free to go */
+    void tryParallelFetch(int port_idx);
+
+    /** The records of a sequencer during parallel warmup */
+    struct PortFetchState
+    {
+        RubyPort *port;
+        std::deque<TraceRecord*> pending;
+        TraceRecord *inFlight = nullptr;
+        int outstanding = 0;
+    };
+
     std::vector<TraceRecord*> m_records;
     uint8_t* m_uncompressed_trace;
     uint64_t m_uncompressed_trace_size;
@@ -119,6 +148,15 @@ class CacheRecorder
     uint64_t m_records_read;
     uint64_t m_records_flushed;
     uint64_t m_block_size_bytes;
+
+    bool m_parallel_warmup;
+    // sequencers in the order of their first controller, so that the
+    // issue order does not depend on pointer values
+    std::vector<PortFetchState> m_port_fetch;
+    std::unordered_map<RubyPort*, int> m_port_fetch_idx;
+    // records not yet completed for each block, in trace order
+    std::unordered_map<Addr, std::deque<TraceRecord*>> m_block_fetch;
+    uint64_t m_records_fetched;
 };
 
 inline bool
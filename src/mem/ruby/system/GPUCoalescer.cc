@@ -64,77 +64,70 @@ UncoalescedTable::UncoalescedTable(GPUCoalescer *gc)
 }
 
 void
-UncoalescedTable::insertPacket(PacketPtr pkt)
+UncoalescedTable::insertPacket(PacketPtr pkt, RubyRequestType type,
+                               int num_packets)
 {
     uint64_t seqNum = pkt->req->getReqInstSeqNum();
 
-    instMap[seqNum].push_back(pkt);
-    DPRINTF(GPUCoalescer, "Adding 0x%X seqNum %d to map. (map %d vec %d)\n",
-            pkt->getAddr(), seqNum, instMap.size(), instMap[seqNum].size());
-}
-
-void
-UncoalescedTable::insertReqType(PacketPtr pkt, RubyRequestType type)
-{
-    uint64_t seqNum = pkt->req->getReqInstSeqNum();
+    // Find the instruction, or the place to insert it to keep the list
+    // sorted. Searching from the youngest one, this is almost always the
+    // first step.
+    auto iter = insts.end();
+    while (iter != insts.begin() && std::prev(iter)->seqNum > seqNum)
+        --iter;
+
+    if (iter == insts.begin() || std::prev(iter)->seqNum != seqNum) {
+        if (freeInsts.empty())
+            freeInsts.emplace_back();
+        insts.splice(iter, freeInsts, freeInsts.begin());
+        --iter;
+        iter->seqNum = seqNum;
+        iter->reqType = type;
+        iter->pktsRemaining = num_packets;
+        assert(iter->pkts.empty());
+        iter->pkts.reserve(TheGpuISA::NumVecElemPerVecReg);
+    } else {
+        --iter;
+    }
 
-    reqTypeMap[seqNum] = type;
+    iter->pkts.push_back(pkt);
+    DPRINTF(GPUCoalescer, "Adding 0x%X seqNum %d to map. (map %d vec %d)\n",
+            pkt->getAddr(), seqNum, insts.size(), iter->pkts.size());
 }
 
 bool
 UncoalescedTable::packetAvailable()
 {
-    return !instMap.empty();
-}
-
-void
-UncoalescedTable::initPacketsRemaining(InstSeqNum seqNum, int count)
-{
-    if (!instPktsRemaining.count(seqNum)) {
-        instPktsRemaining[seqNum] = count;
-    }
-}
-
-int
-UncoalescedTable::getPacketsRemaining(InstSeqNum seqNum)
-{
-    return instPktsRemaining[seqNum];
-}
-
-void
-UncoalescedTable::setPacketsRemaining(InstSeqNum seqNum, int count)
-{
-    instPktsRemaining[seqNum] = count;
+    return !insts.empty();
 }
 
-PerInstPackets*
-UncoalescedTable::getInstPackets(int offset)
+UncoalescedInst*
+UncoalescedTable::getInst(int offset)
 {
-    if (offset >= instMap.size()) {
+    if (offset >= insts.size()) {
         return nullptr;
     }
 
-    auto instMapIter = instMap.begin();
-    std::advance(instMapIter, offset);
+    auto instIter = insts.begin();
+    std::advance(instIter, offset);
 
-    return &(instMapIter->second);
+    return &(*instIter);
 }
 
 void
 UncoalescedTable::updateResources()
 {
-    for (auto iter = instMap.begin(); iter != instMap.end(); ) {
-        InstSeqNum seq_num = iter->first;
+    for (auto iter = insts.begin(); iter != insts.end(); ) {
+        InstSeqNum seq_num = iter->seqNum;
         DPRINTF(GPUCoalescer, "%s checking remaining pkts for %d\n",
                 coalescer->name().c_str(), seq_num);
-        assert(instPktsRemaining.count(seq_num));
 
-        if (instPktsRemaining[seq_num] == 0) {
-            assert(iter->second.empty());
+        if (iter->pktsRemaining == 0) {
+            assert(iter->pkts.empty());
+            RubyRequestType req_type = iter->reqType;
 
-            // Remove from both maps
-            instMap.erase(iter++);
-            instPktsRemaining.erase(seq_num);
+            // Keep the record around for the next instruction
+            freeInsts.splice(freeInsts.begin(), insts, iter++);
 
             // Release the token if the Ruby system is not in cooldown
             // or warmup phases. When in these phases, the RubyPorts
@@ -143,14 +136,12 @@ UncoalescedTable::updateResources()
             // sending tokens through the port unnecessary
             if (!RubySystem::getWarmupEnabled()
                     && !RubySystem::getCooldownEnabled()) {
-                if (reqTypeMap[seq_num] != RubyRequestType_FLUSH) {
+                if (req_type != RubyRequestType_FLUSH) {
                     DPRINTF(GPUCoalescer,
                             "Returning token seqNum %d\n", seq_num);
                     coalescer->getGMTokenPort().sendTokens(1);
                 }
             }
-
-            reqTypeMap.erase(seq_num);
         } else {
             ++iter;
         }
@@ -161,10 +152,10 @@ bool
 UncoalescedTable::areRequestsDone(const uint64_t instSeqNum) {
     // iterate the instructions held in UncoalescedTable to see whether there
     // are more requests to issue; if yes, not yet done; otherwise, done
-    for (auto& inst : instMap) {
+    for (auto& inst : insts) {
         DPRINTF(GPUCoalescer, "instSeqNum= %d, pending packets=%d\n"
-            ,inst.first, inst.second.size());
-        if (inst.first == instSeqNum) { return false; }
+            ,inst.seqNum, inst.pkts.size());
+        if (inst.seqNum == instSeqNum) { return false; }
     }
 
     return true;
@@ -173,11 +164,11 @@ UncoalescedTable::areRequestsDone(const uint64_t instSeqNum) {
 void
 UncoalescedTable::printRequestTable(std::stringstream& ss)
 {
-    ss << "Listing pending packets from " << instMap.size() << " instructions";
+    ss << "Listing pending packets from " << insts.size() << " instructions";
 
-    for (auto& inst : instMap) {
-        ss << "\tAddr: " << printAddress(inst.first) << " with "
-           << inst.second.size() << " pending packets" << std::endl;
+    for (auto& inst : insts) {
+        ss << "\tAddr: " << printAddress(inst.seqNum) << " with "
+           << inst.pkts.size() << " pending packets" << std::endl;
     }
 }
 
@@ -186,8 +177,8 @@ UncoalescedTable::checkDeadlock(Tick threshold)
 {
     Tick current_time = curTick();
 
-    for (auto &it : instMap) {
-        for (auto &pkt : it.second) {
+    for (auto &it : insts) {
+        for (auto &pkt : it.pkts) {
             if (current_time - pkt->req->time() > threshold) {
                 std::stringstream ss;
                 printRequestTable(ss);
@@ -196,7 +187,7 @@ UncoalescedTable::checkDeadlock(Tick threshold)
                      "version: %d request.paddr: 0x%x uncoalescedTable: %d "
                      "current time: %u issue_time: %d difference: %d\n"
                      "Request Tables:\n\n%s", coalescer->getId(),
-                      pkt->getAddr(), instMap.size(), current_time,
+                      pkt->getAddr(), insts.size(), current_time,
                       pkt->req->time(), current_time - pkt->req->time(),
                       ss.str());
             }
@@ -287,6 +278,26 @@ GPUCoalescer::GPUCoalescer(const Params &p)
 
 GPUCoalescer::~GPUCoalescer()
 {
+    for (auto crequest : freeCoalescedReqs)
+        delete crequest;
+}
+
+CoalescedRequest*
+GPUCoalescer::allocCoalescedRequest(uint64_t seq_num)
+{
+    if (freeCoalescedReqs.empty())
+        return new CoalescedRequest(seq_num);
+
+    CoalescedRequest *crequest = freeCoalescedReqs.back();
+    freeCoalescedReqs.pop_back();
+    crequest->reset(seq_num);
+    return crequest;
+}
+
+void
+GPUCoalescer::freeCoalescedRequest(CoalescedRequest *crequest)
+{
+    freeCoalescedReqs.push_back(crequest);
 }
 
 Port &
@@ -441,7 +452,7 @@ GPUCoalescer::writeCallback(Addr address,
                 forwardRequestTime, firstResponseTime, isRegion);
 
     // remove this crequest in coalescedTable
-    delete crequest;
+    freeCoalescedRequest(crequest);
     coalescedTable.at(address).pop_front();
 
     if (coalescedTable.at(address).empty()) {
@@ -529,7 +540,7 @@ GPUCoalescer::readCallback(Addr address,
     hitCallback(crequest, mach, data, true, crequest->getIssueTime(),
                 forwardRequestTime, firstResponseTime, isRegion);
 
-    delete crequest;
+    freeCoalescedRequest(crequest);
     coalescedTable.at(address).pop_front();
     if (coalescedTable.at(address).empty()) {
       coalescedTable.erase(address);
@@ -566,9 +577,8 @@ GPUCoalescer::hitCallback(CoalescedRequest* crequest,
     // update the data
     //
     // MUST ADD DOING THIS FOR EACH REQUEST IN COALESCER
-    std::vector<PacketPtr> pktList = crequest->getPackets();
+    std::vector<PacketPtr> &pktList = crequest->getPackets();
 
-    uint8_t* log = nullptr;
     DPRINTF(GPUCoalescer, "Responding to %d packets for addr 0x%X\n",
             pktList.size(), request_line_address);
     uint32_t offset;
@@ -606,10 +616,8 @@ GPUCoalescer::hitCallback(CoalescedRequest* crequest,
 
                     // Log entry contains the old value before the current
                     // atomic operation occurred.
-                    log = data.popAtomicLogEntryFront();
-                    pkt->setData(&log[offset]);
-                    delete [] log;
-                    log = nullptr;
+                    pkt->setData(&data.atomicLogEntryFront()[offset]);
+                    data.popAtomicLogEntryFront();
                     break;
                 default:
                     panic("Unsupported ruby packet type:%s\n",
@@ -705,9 +713,7 @@ GPUCoalescer::makeRequest(PacketPtr pkt)
         // it's picked for coalescing process later in this cycle or in a
         // future cycle. Packets remaining is set to the number of excepted
         // requests from the instruction based on its exec_mask.
-        uncoalescedTable.insertPacket(pkt);
-        uncoalescedTable.insertReqType(pkt, getRequestType(pkt));
-        uncoalescedTable.initPacketsRemaining(seq_num, num_packets);
+        uncoalescedTable.insertPacket(pkt, getRequestType(pkt), num_packets);
         DPRINTF(GPUCoalescer, "Put pkt with addr 0x%X to uncoalescedTable\n",
                 pkt->getAddr());
 
@@ -765,16 +771,28 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
     uint64_t seqNum = pkt->req->getReqInstSeqNum();
     Addr line_addr = makeLineAddress(pkt->getAddr());
 
+    // Lanes of the instruction which already hit this line. instLines only
+    // holds requests of the instruction being coalesced, so the seqNum
+    // matches.
+    for (auto &line : instLines) {
+        if (line.first == line_addr) {
+            line.second->insertPacket(pkt);
+            return true;
+        }
+    }
+
     // If the packet has the same line address as a request already in the
     // coalescedTable and has the same sequence number, it can be coalesced.
-    if (coalescedTable.count(line_addr)) {
+    auto table_iter = coalescedTable.find(line_addr);
+    if (table_iter != coalescedTable.end()) {
         // Search for a previous coalesced request with the same seqNum.
-        auto& creqQueue = coalescedTable.at(line_addr);
+        auto& creqQueue = table_iter->second;
         auto citer = std::find_if(creqQueue.begin(), creqQueue.end(),
             [&](CoalescedRequest* c) { return c->getSeqNum() == seqNum; }
         );
         if (citer != creqQueue.end()) {
             (*citer)->insertPacket(pkt);
+            instLines.emplace_back(line_addr, *citer);
             return true;
         }
     }
@@ -785,26 +803,22 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
         DPRINTF(GPUCoalescer, "Creating new or aliased request for 0x%X\n",
                 line_addr);
 
-        CoalescedRequest *creq = new CoalescedRequest(seqNum);
+        CoalescedRequest *creq = allocCoalescedRequest(seqNum);
         creq->insertPacket(pkt);
         creq->setRubyType(getRequestType(pkt));
         creq->setIssueTime(curCycle());
+        instLines.emplace_back(line_addr, creq);
 
-        if (!coalescedTable.count(line_addr)) {
+        if (table_iter == coalescedTable.end()) {
             // If there is no outstanding request for this line address,
             // create a new coalecsed request and issue it immediately.
-            auto reqList = std::deque<CoalescedRequest*> { creq };
-            coalescedTable.insert(std::make_pair(line_addr, reqList));
-            if (!coalescedReqs.count(seqNum)) {
-                coalescedReqs.insert(std::make_pair(seqNum, reqList));
-            } else {
-                coalescedReqs.at(seqNum).push_back(creq);
-            }
+            coalescedTable[line_addr].push_back(creq);
+            coalescedReqs.push_back(creq);
         } else {
             // The request is for a line address that is already outstanding
             // but for a different instruction. Add it as a new request to be
             // issued when the current outstanding request is completed.
-            coalescedTable.at(line_addr).push_back(creq);
+            table_iter->second.push_back(creq);
             DPRINTF(GPUCoalescer, "found address 0x%X with new seqNum %d\n",
                     line_addr, seqNum);
         }
@@ -859,21 +873,20 @@ GPUCoalescer::completeIssue()
     // Iterate over the maximum number of instructions we can coalesce
     // per cycle (coalescingWindow).
     for (int instIdx = 0; instIdx < coalescingWindow; ++instIdx) {
-        PerInstPackets *pkt_list =
-            uncoalescedTable.getInstPackets(instIdx);
+        UncoalescedInst *inst = uncoalescedTable.getInst(instIdx);
 
-        // getInstPackets will return nullptr if no instruction
+        // getInst will return nullptr if no instruction
         // exists at the current offset.
-        if (!pkt_list) {
+        if (!inst) {
             break;
-        } else if (pkt_list->empty()) {
+        } else if (inst->pkts.empty()) {
             // Found something, but it has not been cleaned up by update
             // resources yet. See if there is anything else to coalesce.
             // Assume we can't check anymore if the coalescing window is 1.
             continue;
         } else {
-            // All packets in the list have the same seqNum, use first.
-            InstSeqNum seq_num = pkt_list->front()->req->getReqInstSeqNum();
+            PerInstPackets *pkt_list = &inst->pkts;
+            InstSeqNum seq_num = inst->seqNum;
 
             // The difference in list size before and after tells us the
             // number of packets which were coalesced.
@@ -883,29 +896,28 @@ GPUCoalescer::completeIssue()
             // erase them from the list if coalescing is successful and
             // leave them in the list otherwise. This aggressively attempts
             // to coalesce as many packets as possible from the current inst.
-            pkt_list->remove_if(
-                [&](PacketPtr pkt) { return coalescePacket(pkt); }
-            );
-
-            if (coalescedReqs.count(seq_num)) {
-                auto& creqs = coalescedReqs.at(seq_num);
-                for (auto creq : creqs) {
-                    DPRINTF(GPUCoalescer, "Issued req type %s seqNum %d\n",
-                            RubyRequestType_to_string(creq->getRubyType()),
-                                                      seq_num);
-                    issueRequest(creq);
-                }
-                coalescedReqs.erase(seq_num);
+            instLines.clear();
+            pkt_list->erase(std::remove_if(pkt_list->begin(),
+                                           pkt_list->end(),
+                [&](PacketPtr pkt) { return coalescePacket(pkt); }),
+                pkt_list->end());
+
+            for (auto creq : coalescedReqs) {
+                DPRINTF(GPUCoalescer, "Issued req type %s seqNum %d\n",
+                        RubyRequestType_to_string(creq->getRubyType()),
+                                                  seq_num);
+                issueRequest(creq);
             }
+            coalescedReqs.clear();
 
             assert(pkt_list_size >= pkt_list->size());
             size_t pkt_list_diff = pkt_list_size - pkt_list->size();
 
-            int num_remaining = uncoalescedTable.getPacketsRemaining(seq_num);
+            int num_remaining = inst->pktsRemaining;
             num_remaining -= pkt_list_diff;
             assert(num_remaining >= 0);
 
-            uncoalescedTable.setPacketsRemaining(seq_num, num_remaining);
+            inst->pktsRemaining = num_remaining;
             DPRINTF(GPUCoalescer,
                     "Coalesced %d pkts for seqNum %d, %d remaining\n",
                     pkt_list_diff, seq_num, num_remaining);
@@ -958,7 +970,7 @@ GPUCoalescer::atomicCallback(Addr address,
     hitCallback(crequest, mach, (DataBlock&)data, true,
                 crequest->getIssueTime(), Cycles(0), Cycles(0), false);
 
-    delete crequest;
+    freeCoalescedRequest(crequest);
     coalescedTable.at(address).pop_front();
 
     if (coalescedTable.at(address).empty()) {
@@ -1007,7 +1019,7 @@ GPUCoalescer::completeHitCallback(std::vector<PacketPtr> & mylist)
 
     RubySystem *rs = m_ruby_system;
     if (RubySystem::getWarmupEnabled()) {
-        rs->m_cache_recorder->enqueueNextFetchRequest();
+        rs->m_cache_recorder->enqueueNextFetchRequest(this);
     } else if (RubySystem::getCooldownEnabled()) {
         rs->m_cache_recorder->enqueueNextFlushRequest();
     } else {
@@ -33,7 +33,10 @@
 #define __MEM_RUBY_SYSTEM_GPU_COALESCER_HH__
 
 #include <iostream>
+#include <list>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "gpu-compute/gpu_dyn_inst.hh"
@@ -62,7 +65,17 @@ struct MachineID;
 class CacheMemory;
 
 // List of packets that belongs to a specific instruction.
-typedef std::list<PacketPtr> PerInstPackets;
+typedef std::vector<PacketPtr> PerInstPackets;
+
+// The packets of an instruction waiting to be coalesced, along with the
+// number of packets the instruction still has to send or coalesce.
+struct UncoalescedInst
+{
+    InstSeqNum seqNum = 0;
+    RubyRequestType reqType = RubyRequestType_NULL;
+    int pktsRemaining = 0;
+    PerInstPackets pkts;
+};
 
 class UncoalescedTable
 {
@@ -70,21 +83,16 @@ class UncoalescedTable
     UncoalescedTable(GPUCoalescer *gc);
     ~UncoalescedTable() {}
 
-    void insertPacket(PacketPtr pkt);
-    void insertReqType(PacketPtr pkt, RubyRequestType type);
+    // Add a packet to the record of its instruction, creating the record
+    // with the given request type and number of expected packets if the
+    // instruction has not been seen before.
+    void insertPacket(PacketPtr pkt, RubyRequestType type, int num_packets);
     bool packetAvailable();
     void printRequestTable(std::stringstream& ss);
 
-    // Modify packets remaining map. Init sets value iff the seqNum has not
-    // yet been seen before. get/set act as a regular getter/setter.
-    void initPacketsRemaining(InstSeqNum seqNum, int count);
-    int getPacketsRemaining(InstSeqNum seqNum);
-    void setPacketsRemaining(InstSeqNum seqNum, int count);
-
-    // Returns a pointer to the list of packets corresponding to an
-    // instruction in the instruction map or nullptr if there are no
-    // instructions at the offset.
-    PerInstPackets* getInstPackets(int offset);
+    // Returns a pointer to the record of the instruction at the offset in
+    // age order, or nullptr if there are no instructions at the offset.
+    UncoalescedInst* getInst(int offset);
     void updateResources();
     bool areRequestsDone(const InstSeqNum instSeqNum);
 
@@ -95,15 +103,16 @@ class UncoalescedTable
   private:
     GPUCoalescer *coalescer;
 
-    // Maps an instructions unique sequence number to a queue of packets
-    // which need responses. This data structure assumes the sequence number
-    // is monotonically increasing (which is true for CU class) in order to
-    // issue packets in age order.
-    std::map<InstSeqNum, PerInstPackets> instMap;
-
-    std::map<InstSeqNum, int> instPktsRemaining;
+    // The instructions with packets which need responses, sorted by their
+    // unique sequence number in order to issue packets in age order. The
+    // sequence number is monotonically increasing (which is true for CU
+    // class), so new instructions are almost always added at the end.
+    std::list<UncoalescedInst> insts;
 
-    std::map<InstSeqNum, RubyRequestType> reqTypeMap;
+    // Records of retired instructions. They are spliced back into insts
+    // when new instructions arrive so their nodes and packet vectors are
+    // reused instead of allocated again.
+    std::list<UncoalescedInst> freeInsts;
 };
 
 class CoalescedRequest
@@ -115,6 +124,17 @@ class CoalescedRequest
     {}
     ~CoalescedRequest() {}
 
+    // Make the request look newly constructed, keeping the storage of its
+    // packet list so that it can be reused.
+    void
+    reset(uint64_t _seqNum)
+    {
+        seqNum = _seqNum;
+        issueTime = Cycles(0);
+        rubyType = RubyRequestType_NULL;
+        pkts.clear();
+    }
+
     void insertPacket(PacketPtr pkt) { pkts.push_back(pkt); }
     void setSeqNum(uint64_t _seqNum) { seqNum = _seqNum; }
     void setIssueTime(Cycles _issueTime) { issueTime = _issueTime; }
@@ -179,7 +199,7 @@ class PendingWriteInst
         assert(numPendingStores == 0);
 
         // make a response packet
-        PacketPtr pkt = new Packet(std::make_shared<Request>(),
+        PacketPtr pkt = new Packet(makeRequest(),
                                    MemCmd::WriteCompleteResp);
 
         if (!usingRubyTester) {
@@ -412,6 +432,11 @@ class GPUCoalescer : public RubyPort
     // "target" list of the coalescedTable.
     bool coalescePacket(PacketPtr pkt);
 
+    // Coalesced requests are recycled through a free list rather than
+    // allocated for every cache line an instruction touches.
+    CoalescedRequest *allocCoalescedRequest(uint64_t seq_num);
+    void freeCoalescedRequest(CoalescedRequest *crequest);
+
     EventFunctionWrapper issueEvent;
 
   protected:
@@ -436,10 +461,17 @@ class GPUCoalescer : public RubyPort
     // (typically the number of blocks in TCP). If there are duplicates of
     // an address, the are serviced in age order.
     std::map<Addr, std::deque<CoalescedRequest*>> coalescedTable;
-    // Map of instruction sequence number to coalesced requests that get
-    // created in coalescePacket, used in completeIssue to send the fully
-    // coalesced request
-    std::unordered_map<uint64_t, std::deque<CoalescedRequest*>> coalescedReqs;
+    // Coalesced requests created in coalescePacket for the instruction
+    // completeIssue is working on, which are sent once all the packets it
+    // could coalesce this cycle have been.
+    std::vector<CoalescedRequest*> coalescedReqs;
+    // The line addresses and requests the packets of the instruction
+    // completeIssue is working on were coalesced into so far. Lanes mostly
+    // hit the same few lines, and this small table saves searching
+    // coalescedTable for each of them.
+    std::vector<std::pair<Addr, CoalescedRequest*>> instLines;
+    // Unused coalesced requests, see allocCoalescedRequest()
+    std::vector<CoalescedRequest*> freeCoalescedReqs;
 
     // a map btw an instruction sequence number and PendingWriteInst
     // this is used to do a final call back for each write when it is
@@ -232,9 +232,11 @@ RubyPort::PioResponsePort::recvTimingReq(PacketPtr pkt)
 Tick
 RubyPort::PioResponsePort::recvAtomic(PacketPtr pkt)
 {
-    // Only atomic_noncaching mode supported!
-    if (!owner.system->bypassCaches()) {
-        panic("Ruby supports atomic accesses only in noncaching mode\n");
+    // Only atomic_noncaching mode and atomic warmup are supported!
+    if (!owner.system->bypassCaches() &&
+        !owner.m_ruby_system->getAtomicWarmup()) {
+        panic("Ruby supports atomic accesses only in noncaching mode "
+              "or with atomic_warmup set\n");
     }
 
     for (size_t i = 0; i < owner.request_ports.size(); ++i) {
@@ -321,9 +323,11 @@ RubyPort::MemResponsePort::recvTimingReq(PacketPtr pkt)
 Tick
 RubyPort::MemResponsePort::recvAtomic(PacketPtr pkt)
 {
-    // Only atomic_noncaching mode supported!
-    if (!owner.system->bypassCaches()) {
-        panic("Ruby supports atomic accesses only in noncaching mode\n");
+    // Only atomic_noncaching mode and atomic warmup are supported!
+    if (!owner.system->bypassCaches() &&
+        !owner.m_ruby_system->getAtomicWarmup()) {
+        panic("Ruby supports atomic accesses only in noncaching mode "
+              "or with atomic_warmup set\n");
     }
 
     // Check for pio requests and directly send them to the dedicated
@@ -345,6 +349,12 @@ RubyPort::MemResponsePort::recvAtomic(PacketPtr pkt)
 
         assert(getOffset(pkt->getAddr()) + pkt->getSize() <=
                RubySystem::getBlockSizeBytes());
+
+        // Caches are not accessed in atomic mode, only remember the
+        // line to bring it in when switching to timing mode
+        if (!owner.system->bypassCaches()) {
+            owner.m_ruby_system->recordAtomicAccess(&owner, pkt);
+        }
     }
 
     // Find the machine type of memory controller interface
@@ -498,7 +508,7 @@ RubyPort::ruby_stale_translation_callback(Addr txnId)
     // Allocate the invalidate request and packet on the stack, as it is
     // assumed they will not be modified or deleted by receivers.
     // TODO: should this really be using funcRequestorId?
-    auto request = std::make_shared<Request>(
+    auto request = makeRequest(
         0, RubySystem::getBlockSizeBytes(), Request::TLBI_EXT_SYNC,
         Request::funcRequestorId);
     // Store the txnId in extraData instead of the address
@@ -698,7 +708,7 @@ RubyPort::ruby_eviction_callback(Addr address)
     // Allocate the invalidate request and packet on the stack, as it is
     // assumed they will not be modified or deleted by receivers.
     // TODO: should this really be using funcRequestorId?
-    auto request = std::make_shared<Request>(
+    auto request = makeRequest(
         address, RubySystem::getBlockSizeBytes(), 0,
         Request::funcRequestorId);
 
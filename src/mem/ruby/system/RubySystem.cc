@@ -43,6 +43,7 @@
 #include <fcntl.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <list>
 
@@ -53,6 +54,7 @@
 #include "debug/RubySystem.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/network/Network.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
 #include "mem/ruby/system/DMASequencer.hh"
 #include "mem/ruby/system/Sequencer.hh"
 #include "mem/simple_mem.hh"
@@ -78,7 +80,9 @@ bool RubySystem::m_cooldown_enabled = false;
 
 RubySystem::RubySystem(const Params &p)
     : ClockedObject(p), m_access_backing_store(p.access_backing_store),
-      m_cache_recorder(NULL)
+      m_atomic_warmup(p.atomic_warmup),
+      m_atomic_warmup_lines(p.atomic_warmup_lines),
+      m_atomic_access_seq(0), m_cache_recorder(NULL)
 {
     m_randomization = p.randomization;
 
@@ -213,7 +217,8 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
     // Create the CacheRecorder and record the cache trace
     m_cache_recorder = new CacheRecorder(uncompressed_trace, cache_trace_size,
                                          ruby_port_map,
-                                         block_size_bytes);
+                                         block_size_bytes,
+                                         params().parallel_cache_warmup);
 }
 
 void
@@ -362,6 +367,113 @@ RubySystem::drainResume()
         delete m_cache_recorder;
         m_cache_recorder = NULL;
     }
+
+    // Bring the lines touched while fast-forwarding in atomic mode
+    // into the caches before proceeding in timing mode
+    if (!m_atomic_accesses.empty() && params().system->isTimingMode()) {
+        warmupFromAtomicAccesses();
+    }
+}
+
+void
+RubySystem::recordAtomicAccess(RubyPort *port, PacketPtr pkt)
+{
+    assert(m_atomic_warmup);
+
+    RubyRequestType type = RubyRequestType_LD;
+    if (pkt->req->isInstFetch()) {
+        type = RubyRequestType_IFETCH;
+    } else if (pkt->isWrite()) {
+        type = RubyRequestType_ST;
+    }
+
+    // instruction fetches are kept apart from data accesses to the
+    // same line as they warm a different cache, the line address
+    // leaving the lowest bit free to tell them apart
+    Addr line = makeLineAddress(pkt->getAddr());
+    Addr key = line | (type == RubyRequestType_IFETCH ? 1 : 0);
+
+    AtomicAccessLines &lines = m_atomic_accesses[port];
+    auto it = lines.index.find(key);
+    if (it != lines.index.end()) {
+        // a store to a line that was only loaded so far needs the
+        // line with write permission
+        if (type == RubyRequestType_ST) {
+            it->second->type = type;
+        }
+        it->second->seq = m_atomic_access_seq++;
+        lines.lru.splice(lines.lru.end(), lines.lru, it->second);
+        return;
+    }
+
+    if (lines.lru.size() == m_atomic_warmup_lines) {
+        const AtomicAccessRecord &victim = lines.lru.front();
+        lines.index.erase(victim.line |
+            (victim.type == RubyRequestType_IFETCH ? 1 : 0));
+        lines.lru.pop_front();
+    }
+
+    lines.lru.push_back({line, type, m_atomic_access_seq++});
+    lines.index.emplace(key, std::prev(lines.lru.end()));
+}
+
+void
+RubySystem::warmupFromAtomicAccesses()
+{
+    // the cache recorder identifies a sequencer by the index of its
+    // controller
+    std::vector<std::pair<int, const AtomicAccessRecord *>> records;
+    for (int cntrl = 0; cntrl < m_abs_cntrl_vec.size(); cntrl++) {
+        RubyPort *port = m_abs_cntrl_vec[cntrl]->getGPUCoalescer() ?
+            (RubyPort *)m_abs_cntrl_vec[cntrl]->getGPUCoalescer() :
+            (RubyPort *)m_abs_cntrl_vec[cntrl]->getCPUSequencer();
+        auto it = m_atomic_accesses.find(port);
+        if (port == nullptr || it == m_atomic_accesses.end())
+            continue;
+        for (const auto &record : it->second.lru) {
+            records.emplace_back(cntrl, &record);
+        }
+        // a sequencer shared by several controllers is replayed once
+        m_atomic_accesses.erase(it);
+    }
+    m_atomic_accesses.clear();
+
+    // replay in the order the lines were last used, so the cache
+    // replacement state ends up reflecting the most recent uses
+    std::sort(records.begin(), records.end(),
+              [](const auto &a, const auto &b)
+              { return a.second->seq < b.second->seq; });
+
+    const uint64_t record_size = sizeof(TraceRecord) + getBlockSizeBytes();
+    const uint64_t trace_size = records.size() * record_size;
+    uint8_t *trace = new uint8_t[trace_size];
+
+    for (int i = 0; i < records.size(); i++) {
+        const auto &[cntrl, record] = records[i];
+        TraceRecord *rec = (TraceRecord *)(trace + i * record_size);
+        rec->m_cntrl_id = cntrl;
+        rec->m_time = record->seq;
+        rec->m_data_address = record->line;
+        rec->m_pc_address = 0;
+        rec->m_type = record->type;
+
+        // the replay installs the data of the trace, so take it from
+        // wherever the current copy of the line is
+        RequestPtr req = std::make_shared<Request>(record->line,
+            getBlockSizeBytes(), 0, Request::funcRequestorId);
+        Packet pkt(req, MemCmd::ReadReq);
+        pkt.dataStatic(rec->m_data);
+        fatal_if(!functionalRead(&pkt), "Could not read line %#x to warm "
+                 "the caches\n", record->line);
+    }
+
+    DPRINTF(RubyCacheTrace, "Warming caches with %d lines recorded in "
+            "atomic mode\n", records.size());
+
+    m_warmup_enabled = true;
+    m_systems_to_warmup++;
+    makeCacheRecorder(trace, trace_size, getBlockSizeBytes());
+    runCacheWarmup();
 }
 
 void
@@ -449,39 +561,45 @@ RubySystem::startup()
     // state was checkpointed.
 
     if (m_warmup_enabled) {
-        DPRINTF(RubyCacheTrace, "Starting ruby cache warmup\n");
-        // save the current tick value
-        Tick curtick_original = curTick();
-        // save the event queue head
-        Event* eventq_head = eventq->replaceHead(NULL);
-        // save the exit event pointer
-        GlobalSimLoopExitEvent *original_simulate_limit_event = nullptr;
-        original_simulate_limit_event = simulate_limit_event;
-        // set curTick to 0 and reset Ruby System's clock
-        setCurTick(0);
-        resetClock();
-
-        // Schedule an event to start cache warmup
-        enqueueRubyEvent(curTick());
-        simulate();
+        runCacheWarmup();
+    }
 
-        delete m_cache_recorder;
-        m_cache_recorder = NULL;
-        m_systems_to_warmup--;
-        if (m_systems_to_warmup == 0) {
-            m_warmup_enabled = false;
-        }
+    resetStats();
+}
 
-        // Restore eventq head
-        eventq->replaceHead(eventq_head);
-        // Restore exit event pointer
-        simulate_limit_event = original_simulate_limit_event;
-        // Restore curTick and Ruby System's clock
-        setCurTick(curtick_original);
-        resetClock();
+void
+RubySystem::runCacheWarmup()
+{
+    DPRINTF(RubyCacheTrace, "Starting ruby cache warmup\n");
+    // save the current tick value
+    Tick curtick_original = curTick();
+    // save the event queue head
+    Event* eventq_head = eventq->replaceHead(NULL);
+    // save the exit event pointer
+    GlobalSimLoopExitEvent *original_simulate_limit_event = nullptr;
+    original_simulate_limit_event = simulate_limit_event;
+    // set curTick to 0 and reset Ruby System's clock
+    setCurTick(0);
+    resetClock();
+
+    // Schedule an event to start cache warmup
+    enqueueRubyEvent(curTick());
+    simulate();
+
+    delete m_cache_recorder;
+    m_cache_recorder = NULL;
+    m_systems_to_warmup--;
+    if (m_systems_to_warmup == 0) {
+        m_warmup_enabled = false;
     }
 
-    resetStats();
+    // Restore eventq head
+    eventq->replaceHead(eventq_head);
+    // Restore exit event pointer
+    simulate_limit_event = original_simulate_limit_event;
+    // Restore curTick and Ruby System's clock
+    setCurTick(curtick_original);
+    resetClock();
 }
 
 void
@@ -598,7 +716,7 @@ RubySystem::functionalRead(PacketPtr pkt)
             ctrl_ro->functionalRead(line_address, pkt);
         }
         return true;
-    } else if ((num_busy + num_maybe_stale) > 0) {
+    } else if ((num_busy + num_maybe_stale) > 0 && Message::numLive() > 0) {
         // No controller has a valid copy of the block, but a transient or
         // stale state indicates a valid copy should be in transit in the
         // network or in a message buffer waiting to be handled
@@ -688,7 +806,7 @@ RubySystem::functionalRead(PacketPtr pkt)
     // if there is any busy controller or bytes still not set, then a partial
     // and/or dirty copy of the line might be in a message buffer or the
     // network
-    if (!ctrl_busy.empty() || !bytes.isFull()) {
+    if ((!ctrl_busy.empty() || !bytes.isFull()) && Message::numLive() > 0) {
         DPRINTF(RubySystem, "Reading from remaining controllers, "
                             "buffers and networks\n");
         if (ctrl_rw != nullptr)
@@ -738,8 +856,12 @@ RubySystem::functionalWrite(PacketPtr pkt)
     int request_net_id = requestorToNetwork[pkt->requestorId()];
     assert(netCntrls.count(request_net_id));
 
+    // Buffers and networks can only hold the line while messages exist
+    const bool messages_live = Message::numLive() > 0;
+
     for (auto& cntrl : netCntrls[request_net_id]) {
-        num_functional_writes += cntrl->functionalWriteBuffers(pkt);
+        if (messages_live)
+            num_functional_writes += cntrl->functionalWriteBuffers(pkt);
 
         access_perm = cntrl->getAccessPermission(line_addr);
         if (access_perm != AccessPermission_Invalid &&
@@ -760,8 +882,10 @@ RubySystem::functionalWrite(PacketPtr pkt)
         }
     }
 
-    for (auto& network : m_networks) {
-        num_functional_writes += network->functionalWrite(pkt);
+    if (messages_live) {
+        for (auto& network : m_networks) {
+            num_functional_writes += network->functionalWrite(pkt);
+        }
     }
     DPRINTF(RubySystem, "Messages written = %u\n", num_functional_writes);
 
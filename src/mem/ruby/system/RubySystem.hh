@@ -35,6 +35,7 @@
 #ifndef __MEM_RUBY_SYSTEM_RUBYSYSTEM_HH__
 #define __MEM_RUBY_SYSTEM_RUBYSYSTEM_HH__
 
+#include <list>
 #include <unordered_map>
 
 #include "base/callback.hh"
@@ -59,6 +60,7 @@ namespace ruby
 
 class Network;
 class AbstractController;
+class RubyPort;
 
 class RubySystem : public ClockedObject
 {
@@ -78,6 +80,7 @@ class RubySystem : public ClockedObject
     memory::SimpleMemory *getPhysMem() { return m_phys_mem; }
     Cycles getStartCycle() { return m_start_cycle; }
     bool getAccessBackingStore() { return m_access_backing_store; }
+    bool getAtomicWarmup() const { return m_atomic_warmup; }
 
     // Public Methods
     Profiler*
@@ -103,6 +106,16 @@ class RubySystem : public ClockedObject
     bool functionalRead(Packet *ptr);
     bool functionalWrite(Packet *ptr);
 
+    /**
+     * Remember the line touched by an atomic access made through a
+     * sequencer in atomic warmup mode, so that it can be brought into
+     * the caches when switching to timing mode.
+     *
+     * @param port The sequencer the access came through
+     * @param pkt The atomic request
+     */
+    void recordAtomicAccess(RubyPort *port, PacketPtr pkt);
+
     void registerNetwork(Network*);
     void registerAbstractController(AbstractController*);
     void registerMachineID(const MachineID& mach_id, Network* network);
@@ -111,9 +124,7 @@ class RubySystem : public ClockedObject
     bool eventQueueEmpty() { return eventq->empty(); }
     void enqueueRubyEvent(Tick tick)
     {
-        auto e = new EventFunctionWrapper(
-            [this]{ processRubyEvent(); }, "RubyEvent");
-        schedule(e, tick);
+        scheduleOneShot([this]{ processRubyEvent(); }, tick);
     }
 
   private:
@@ -132,6 +143,35 @@ class RubySystem : public ClockedObject
                                      uint64_t uncompressed_trace_size);
 
     void processRubyEvent();
+
+    /**
+     * Replay the trace held by the cache recorder into the caches,
+     * with time reset to zero and restored afterwards.
+     */
+    void runCacheWarmup();
+
+    /**
+     * Build a cache trace from the lines recorded in atomic warmup
+     * mode, with their current data, and replay it.
+     */
+    void warmupFromAtomicAccesses();
+
+    /** A line touched in atomic warmup mode */
+    struct AtomicAccessRecord
+    {
+        Addr line;
+        RubyRequestType type;
+        uint64_t seq;
+    };
+
+    /** The recorded lines of a sequencer, least recently used first */
+    struct AtomicAccessLines
+    {
+        std::list<AtomicAccessRecord> lru;
+        std::unordered_map<Addr,
+            std::list<AtomicAccessRecord>::iterator> index;
+    };
+
   private:
     // configuration parameters
     static bool m_randomization;
@@ -144,6 +184,10 @@ class RubySystem : public ClockedObject
     static bool m_cooldown_enabled;
     memory::SimpleMemory *m_phys_mem;
     const bool m_access_backing_store;
+    const bool m_atomic_warmup;
+    const unsigned m_atomic_warmup_lines;
+    std::unordered_map<RubyPort *, AtomicAccessLines> m_atomic_accesses;
+    uint64_t m_atomic_access_seq;
 
     //std::vector<Network *> m_networks;
     std::vector<std::unique_ptr<Network>> m_networks;
@@ -57,6 +57,28 @@ class RubySystem(ClockedObject):
         store and only use ruby for timing.",
     )
 
+    parallel_cache_warmup = Param.Bool(
+        False,
+        "Restore the caches from a checkpoint with all sequencers "
+        "replaying their records concurrently",
+    )
+
+    # Fast-forwarding in atomic mode with caches warmed by Ruby. Atomic
+    # accesses go directly to memory, as in atomic_noncaching mode, and
+    # only the lines they touch are recorded. When switching to a timing
+    # mode, the recorded lines are fetched into the caches with the same
+    # replay used to restore the cache contents from a checkpoint.
+    atomic_warmup = Param.Bool(
+        False,
+        "Accept atomic accesses, warming the caches with the lines they "
+        "touch when switching to timing mode",
+    )
+    atomic_warmup_lines = Param.Unsigned(
+        65536,
+        "Number of most recently used lines per sequencer that are "
+        "replayed into the caches after atomic warmup",
+    )
+
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
@@ -76,6 +76,7 @@ Sequencer::Sequencer(const Params &p)
     m_dataCache_ptr = p.dcache;
     m_max_outstanding_requests = p.max_outstanding_requests;
     m_deadlock_threshold = p.deadlock_threshold;
+    m_RequestTable.init(m_max_outstanding_requests);
 
     m_coreId = p.coreid; // for tracking the two CorePair sequencers
     assert(m_max_outstanding_requests > 0);
@@ -234,20 +235,20 @@ Sequencer::wakeup()
     // Check across all outstanding requests
     [[maybe_unused]] int total_outstanding = 0;
 
-    for (const auto &table_entry : m_RequestTable) {
-        for (const auto &seq_req : table_entry.second) {
+    for (const auto &seq_req_list : m_RequestTable) {
+        for (const auto &seq_req : seq_req_list) {
             if (current_time - seq_req.issue_time < m_deadlock_threshold)
                 continue;
 
             panic("Possible Deadlock detected. Aborting!\n version: %d "
                   "request.paddr: 0x%x m_readRequestTable: %d current time: "
                   "%u issue_time: %d difference: %d\n", m_version,
-                  seq_req.pkt->getAddr(), table_entry.second.size(),
+                  seq_req.pkt->getAddr(), seq_req_list.size(),
                   current_time * clockPeriod(), seq_req.issue_time
                   * clockPeriod(), (current_time * clockPeriod())
                   - (seq_req.issue_time * clockPeriod()));
         }
-        total_outstanding += table_entry.second.size();
+        total_outstanding += seq_req_list.size();
     }
 
     assert(m_outstanding_count == total_outstanding);
@@ -263,8 +264,8 @@ Sequencer::functionalWrite(Packet *func_pkt)
 {
     int num_written = RubyPort::functionalWrite(func_pkt);
 
-    for (const auto &table_entry : m_RequestTable) {
-        for (const auto& seq_req : table_entry.second) {
+    for (const auto &seq_req_list : m_RequestTable) {
+        for (const auto& seq_req : seq_req_list) {
             if (seq_req.functionalWrite(func_pkt))
                 ++num_written;
         }
@@ -468,7 +469,7 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
     // to this cache line when response for the write comes back
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
+    assert(m_RequestTable.contains(address));
     auto &seq_req_list = m_RequestTable[address];
 
     // Perform hitCallback on every cpu request made to this cache block while
@@ -571,7 +572,7 @@ Sequencer::readCallback(Addr address, DataBlock& data,
     // or end of the corresponding list.
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
+    assert(m_RequestTable.contains(address));
     auto &seq_req_list = m_RequestTable[address];
 
     // Perform hitCallback on every cpu request made to this cache block while
@@ -626,7 +627,7 @@ Sequencer::atomicCallback(Addr address, DataBlock& data,
     // (the opperation could be performed remotly)
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
+    assert(m_RequestTable.contains(address));
     auto &seq_req_list = m_RequestTable[address];
 
     // Perform hitCallback only on the first cpu request that
@@ -763,7 +764,7 @@ Sequencer::hitCallback(SequencerRequest* srequest, DataBlock& data,
     if (RubySystem::getWarmupEnabled()) {
         assert(pkt->req);
         delete pkt;
-        rs->m_cache_recorder->enqueueNextFetchRequest();
+        rs->m_cache_recorder->enqueueNextFetchRequest(this);
     } else if (RubySystem::getCooldownEnabled()) {
         delete pkt;
         rs->m_cache_recorder->enqueueNextFlushRequest();
@@ -852,7 +853,7 @@ Sequencer::completeHitCallback(std::vector<PacketPtr> & mylist)
 
     RubySystem *rs = m_ruby_system;
     if (RubySystem::getWarmupEnabled()) {
-        rs->m_cache_recorder->enqueueNextFetchRequest();
+        rs->m_cache_recorder->enqueueNextFetchRequest(this);
     } else if (RubySystem::getCooldownEnabled()) {
         rs->m_cache_recorder->enqueueNextFlushRequest();
     } else {
@@ -887,7 +888,7 @@ Sequencer::invL1()
         Addr addr = m_dataCache_ptr->getAddressAtIdx(i);
         // Evict Read-only data
         RubyRequestType request_type = RubyRequestType_REPLACEMENT;
-        std::shared_ptr<RubyRequest> msg = std::make_shared<RubyRequest>(
+        RefCountingPtr<RubyRequest> msg = new RubyRequest(
             clockEdge(), addr, 0, 0,
             request_type, RubyAccessMode_Supervisor,
             nullptr);
@@ -1058,12 +1059,12 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
 
     // check if the packet has data as for example prefetch and flush
     // requests do not
-    std::shared_ptr<RubyRequest> msg;
+    RefCountingPtr<RubyRequest> msg;
     if (pkt->req->isMemMgmt()) {
-        msg = std::make_shared<RubyRequest>(clockEdge(),
-                                            pc, secondary_type,
-                                            RubyAccessMode_Supervisor, pkt,
-                                            proc_id, core_id);
+        msg = new RubyRequest(clockEdge(),
+                              pc, secondary_type,
+                              RubyAccessMode_Supervisor, pkt,
+                              proc_id, core_id);
 
         DPRINTFR(ProtocolTrace, "%15s %3s %10s%20s %6s>%-6s %s\n",
                 curTick(), m_version, "Seq", "Begin", "", "",
@@ -1087,10 +1088,10 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
                     msg->m_tlbiTransactionUid);
         }
     } else {
-        msg = std::make_shared<RubyRequest>(clockEdge(), pkt->getAddr(),
-                                            pkt->getSize(), pc, secondary_type,
-                                            RubyAccessMode_Supervisor, pkt,
-                                            PrefetchBit_No, proc_id, core_id);
+        msg = new RubyRequest(clockEdge(), pkt->getAddr(),
+                              pkt->getSize(), pc, secondary_type,
+                              RubyAccessMode_Supervisor, pkt,
+                              PrefetchBit_No, proc_id, core_id);
 
         if (pkt->isAtomicOp() &&
             ((secondary_type == RubyRequestType_ATOMIC_RETURN) ||
@@ -1126,13 +1127,12 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
     m_mandatory_q_ptr->enqueue(msg, clockEdge(), latency);
 }
 
-template <class KEY, class VALUE>
 std::ostream &
-operator<<(std::ostream &out, const std::unordered_map<KEY, VALUE> &map)
+operator<<(std::ostream &out, const SequencerRequestTable &table)
 {
-    for (const auto &table_entry : map) {
-        out << "[ " << table_entry.first << " =";
-        for (const auto &seq_req : table_entry.second) {
+    for (const auto &seq_req_list : table) {
+        out << "[ " << seq_req_list.address() << " =";
+        for (const auto &seq_req : seq_req_list) {
             out << " " << RubyRequestType_to_string(seq_req.m_second_type);
         }
     }
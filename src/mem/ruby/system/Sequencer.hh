@@ -41,11 +41,13 @@
 #ifndef __MEM_RUBY_SYSTEM_SEQUENCER_HH__
 #define __MEM_RUBY_SYSTEM_SEQUENCER_HH__
 
+#include <deque>
 #include <iostream>
-#include <list>
 #include <unordered_map>
+#include <vector>
 
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/common/AddressIndex.hh"
 #include "mem/ruby/protocol/MachineType.hh"
 #include "mem/ruby/protocol/RubyRequestType.hh"
 #include "mem/ruby/protocol/SequencerRequestType.hh"
@@ -83,6 +85,259 @@ struct SequencerRequest
 
 std::ostream& operator<<(std::ostream& out, const SequencerRequest& obj);
 
+/**
+ * The outstanding requests of a sequencer, grouped by cache line. The
+ * lines and the requests are kept in storage sized for
+ * max_outstanding_requests and recycled, and an open-addressing index
+ * maps the line addresses to their slots, so that tracking a request does
+ * not allocate. The requests to a line form a FIFO list threaded through
+ * the request storage. Lines and requests never move: callbacks may add
+ * requests while they walk the list of a line. The storage grows in the
+ * rare case more requests are outstanding, as HTM aborts bypass the limit.
+ */
+class SequencerRequestTable
+{
+  private:
+    struct Node
+    {
+        SequencerRequest req{nullptr, RubyRequestType_NULL,
+                             RubyRequestType_NULL, Cycles(0)};
+        int next = -1;
+    };
+
+  public:
+    //! The requests to one line, oldest first
+    class List
+    {
+      public:
+        class const_iterator
+        {
+          public:
+            const_iterator(const SequencerRequestTable *table, int node)
+                : m_table(table), m_node(node)
+            {}
+
+            const SequencerRequest &
+            operator*() const
+            {
+                return m_table->m_nodes[m_node].req;
+            }
+
+            const_iterator &
+            operator++()
+            {
+                m_node = m_table->m_nodes[m_node].next;
+                return *this;
+            }
+
+            bool
+            operator!=(const const_iterator &other) const
+            {
+                return m_node != other.m_node;
+            }
+
+          private:
+            const SequencerRequestTable *m_table;
+            int m_node;
+        };
+
+        bool empty() const { return m_size == 0; }
+        std::size_t size() const { return m_size; }
+        Addr address() const { return m_addr; }
+
+        SequencerRequest &
+        front()
+        {
+            assert(!empty());
+            return m_table->m_nodes[m_head].req;
+        }
+
+        void
+        emplace_back(PacketPtr pkt, RubyRequestType type,
+                     RubyRequestType second_type, Cycles issue_time)
+        {
+            int node = m_table->allocateNode();
+            m_table->m_nodes[node].req =
+                SequencerRequest(pkt, type, second_type, issue_time);
+            if (m_tail < 0)
+                m_head = node;
+            else
+                m_table->m_nodes[m_tail].next = node;
+            m_tail = node;
+            m_size++;
+        }
+
+        void
+        pop_front()
+        {
+            assert(!empty());
+            int node = m_head;
+            m_head = m_table->m_nodes[node].next;
+            if (m_head < 0)
+                m_tail = -1;
+            m_size--;
+            m_table->freeNode(node);
+        }
+
+        const_iterator begin() const { return {m_table, m_head}; }
+        const_iterator end() const { return {m_table, -1}; }
+
+      private:
+        friend class SequencerRequestTable;
+
+        SequencerRequestTable *m_table = nullptr;
+        //! MaxAddr while the slot is not used by a line
+        Addr m_addr = MaxAddr;
+        int m_head = -1;
+        int m_tail = -1;
+        std::size_t m_size = 0;
+    };
+
+    //! Iterates over the lines that have outstanding requests
+    class const_iterator
+    {
+      public:
+        const_iterator(const SequencerRequestTable *table, int slot)
+            : m_table(table), m_slot(slot)
+        {
+            skipFree();
+        }
+
+        const List &operator*() const { return m_table->m_lines[m_slot]; }
+
+        const_iterator &
+        operator++()
+        {
+            m_slot++;
+            skipFree();
+            return *this;
+        }
+
+        bool
+        operator!=(const const_iterator &other) const
+        {
+            return m_slot != other.m_slot;
+        }
+
+      private:
+        void
+        skipFree()
+        {
+            while (m_slot < m_table->m_lines.size() &&
+                   m_table->m_lines[m_slot].m_addr == MaxAddr) {
+                m_slot++;
+            }
+        }
+
+        const SequencerRequestTable *m_table;
+        int m_slot;
+    };
+
+    SequencerRequestTable() = default;
+    SequencerRequestTable(const SequencerRequestTable &) = delete;
+    SequencerRequestTable &operator=(const SequencerRequestTable &) = delete;
+
+    void
+    init(std::size_t max_requests)
+    {
+        m_nodes.resize(max_requests);
+        for (int i = max_requests - 1; i >= 0; i--)
+            m_free_nodes.push_back(i);
+        growLines(max_requests);
+    }
+
+    //! The requests to a line, an empty list is created if there is none
+    List &
+    operator[](Addr line_addr)
+    {
+        int slot = m_index.find(line_addr);
+        if (slot >= 0)
+            return m_lines[slot];
+
+        if (m_free_lines.empty())
+            growLines(2 * m_lines.size());
+        slot = m_free_lines.back();
+        m_free_lines.pop_back();
+        m_index.insert(line_addr, slot);
+        m_num_lines++;
+
+        List &list = m_lines[slot];
+        list.m_addr = line_addr;
+        return list;
+    }
+
+    bool
+    contains(Addr line_addr) const
+    {
+        return m_index.find(line_addr) >= 0;
+    }
+
+    //! Forget a line, its list must be empty
+    void
+    erase(Addr line_addr)
+    {
+        int slot = m_index.find(line_addr);
+        if (slot < 0)
+            return;
+        assert(m_lines[slot].empty());
+        m_lines[slot].m_addr = MaxAddr;
+        m_index.erase(line_addr);
+        m_free_lines.push_back(slot);
+        m_num_lines--;
+    }
+
+    bool empty() const { return m_num_lines == 0; }
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, int(m_lines.size())}; }
+
+  private:
+    int
+    allocateNode()
+    {
+        if (m_free_nodes.empty()) {
+            m_nodes.emplace_back();
+            return m_nodes.size() - 1;
+        }
+        int node = m_free_nodes.back();
+        m_free_nodes.pop_back();
+        return node;
+    }
+
+    void
+    freeNode(int node)
+    {
+        m_nodes[node].next = -1;
+        m_free_nodes.push_back(node);
+    }
+
+    void
+    growLines(std::size_t num_lines)
+    {
+        int first = m_lines.size();
+        m_lines.resize(std::max<std::size_t>(num_lines, 1));
+        for (int i = m_lines.size() - 1; i >= first; i--) {
+            m_lines[i].m_table = this;
+            m_free_lines.push_back(i);
+        }
+
+        // Re-index the lines in use for the new capacity
+        m_index.init(m_lines.size());
+        for (int i = 0; i < first; i++) {
+            if (m_lines[i].m_addr != MaxAddr)
+                m_index.insert(m_lines[i].m_addr, i);
+        }
+    }
+
+    // std::deque keeps the existing elements in place when it grows
+    std::deque<Node> m_nodes;
+    std::vector<int> m_free_nodes;
+    std::deque<List> m_lines;
+    std::vector<int> m_free_lines;
+    std::size_t m_num_lines = 0;
+    AddressIndex m_index;
+};
+
 class Sequencer : public RubyPort
 {
   public:
@@ -233,7 +488,7 @@ class Sequencer : public RubyPort
 
   protected:
     // RequestTable contains both read and write requests, handles aliasing
-    std::unordered_map<Addr, std::list<SequencerRequest>> m_RequestTable;
+    SequencerRequestTable m_RequestTable;
     // UnadressedRequestTable contains "unaddressed" requests,
     // guaranteed not to alias each other
     std::unordered_map<uint64_t, SequencerRequest> m_UnaddressedRequestTable;
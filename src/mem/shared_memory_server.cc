@@ -31,14 +31,18 @@
 #include <fcntl.h>
 #include <poll.h>
 #include <sys/mman.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include <algorithm>
+#include <cassert>
 #include <cerrno>
 #include <cstring>
+#include <new>
+#include <vector>
 
 // check if filesystem library is available
 #if defined(__cpp_lib_filesystem) || __has_include(<filesystem>)
@@ -56,9 +60,11 @@
     }
 #endif
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/output.hh"
 #include "base/pollevent.hh"
+#include "sim/cur_tick.hh"
 
 namespace gem5
 {
@@ -85,9 +91,12 @@ buildListenSocket(const std::string &path, const std::string &name)
 SharedMemoryServer::SharedMemoryServer(const SharedMemoryServerParams& params)
     : SimObject(params),
       system(params.system),
+      channelEntries(params.channel_entries),
       listener(buildListenSocket(params.server_path, name()))
 {
     fatal_if(system == nullptr, "Requires a system to share memory from!");
+    fatal_if(!isPowerOf2(channelEntries),
+             "The number of channel entries must be a power of 2");
     listener->listen();
 
     listenSocketEvent.reset(new ListenSocketEvent(listener->getfd(), this));
@@ -148,77 +157,28 @@ SharedMemoryServer::ClientSocketEvent::process(int revents)
         // Receive a request packet. We ignore the endianness as unix socket
         // only allows communication on the same system anyway.
         RequestType req_type;
-        struct
-        {
-            uint64_t start;
-            uint64_t end;
-        } request;
         if (!tryReadAll(&req_type, sizeof(req_type))) {
             break;
         }
-        if (req_type != RequestType::kGetPhysRange) {
-            warn("%s: receive unknown request: %d", name(),
-                 static_cast<int>(req_type));
+        bool done = false;
+        switch (req_type) {
+          case RequestType::kGetPhysRange:
+            done = getPhysRange();
             break;
-        }
-        if (!tryReadAll(&request, sizeof(request))) {
+          case RequestType::kGetAllPhysRanges:
+            done = getAllPhysRanges();
             break;
-        }
-        AddrRange range(request.start, request.end);
-        inform("%s: receive request: %s", name(), range.to_string());
-
-        // Identify the backing store.
-        const auto& stores = shmServer->system->getPhysMem().getBackingStore();
-        auto it = std::find_if(
-            stores.begin(), stores.end(), [&](const BackingStoreEntry& entry) {
-                return entry.shmFd >= 0 && range.isSubset(entry.range);
-            });
-        if (it == stores.end()) {
-            warn("%s: cannot find backing store for %s", name(),
-                 range.to_string());
+          case RequestType::kOpenChannel:
+            done = openChannel();
             break;
-        }
-        inform("%s: find shared backing store for %s at %s, shm=%d:%lld",
-               name(), range.to_string(), it->range.to_string(), it->shmFd,
-               (unsigned long long)it->shmOffset);
-
-        // Populate response message.
-        // mmap fd @ offset <===> [start, end] in simulated phys mem.
-        msghdr msg = {};
-        // Setup iovec for fields other than fd. We ignore the endianness as
-        // unix socket only allows communication on the same system anyway.
-        struct
-        {
-            off_t offset;
-        } response;
-        // (offset of the request range in shared memory) =
-        //     (offset of the full range in shared memory) +
-        //     (offset of the request range in the full range)
-        response.offset = it->shmOffset + (range.start() - it->range.start());
-        iovec ios = {.iov_base = &response, .iov_len = sizeof(response)};
-        msg.msg_iov = &ios;
-        msg.msg_iovlen = 1;
-        // Setup fd as an ancillary data.
-        union
-        {
-            char buf[CMSG_SPACE(sizeof(it->shmFd))];
-            struct cmsghdr align;
-        } cmsgs;
-        msg.msg_control = cmsgs.buf;
-        msg.msg_controllen = sizeof(cmsgs.buf);
-        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
-        cmsg->cmsg_level = SOL_SOCKET;
-        cmsg->cmsg_type = SCM_RIGHTS;
-        cmsg->cmsg_len = CMSG_LEN(sizeof(it->shmFd));
-        memcpy(CMSG_DATA(cmsg), &it->shmFd, sizeof(it->shmFd));
-        // Send the response.
-        int retv = sendmsg(pfd.fd, &msg, 0);
-        if (retv < 0) {
-            warn("%s: sendmsg failed: %s", name(), strerror(errno));
+          case RequestType::kFence:
+            done = fence();
             break;
+          default:
+            warn("%s: receive unknown request: %d", name(),
+                 static_cast<int>(req_type));
         }
-        if (retv != sizeof(response)) {
-            warn("%s: failed to send all response at once", name());
+        if (!done) {
             break;
         }
 
@@ -230,8 +190,282 @@ SharedMemoryServer::ClientSocketEvent::process(int revents)
     // If we ever reach here, our client either close the connection or is
     // somehow broken. We'll just close the connection and move on.
     inform("%s: closing connection", name());
-    close(pfd.fd);
-    shmServer->clientSocketEvents.erase(pfd.fd);
+    shmServer->closeClient(pfd.fd);
+}
+
+bool
+SharedMemoryServer::ClientSocketEvent::getPhysRange()
+{
+    struct
+    {
+        uint64_t start;
+        uint64_t end;
+    } request;
+    if (!tryReadAll(&request, sizeof(request))) {
+        return false;
+    }
+    AddrRange range(request.start, request.end);
+    inform("%s: receive request: %s", name(), range.to_string());
+
+    // Identify the backing store.
+    const auto& stores = shmServer->system->getPhysMem().getBackingStore();
+    auto it = std::find_if(
+        stores.begin(), stores.end(), [&](const BackingStoreEntry& entry) {
+            return entry.shmFd >= 0 && range.isSubset(entry.range);
+        });
+    if (it == stores.end()) {
+        warn("%s: cannot find backing store for %s", name(),
+             range.to_string());
+        return false;
+    }
+    inform("%s: find shared backing store for %s at %s, shm=%d:%lld",
+           name(), range.to_string(), it->range.to_string(), it->shmFd,
+           (unsigned long long)it->shmOffset);
+
+    // mmap fd @ offset <===> [start, end] in simulated phys mem.
+    struct
+    {
+        off_t offset;
+    } response;
+    // (offset of the request range in shared memory) =
+    //     (offset of the full range in shared memory) +
+    //     (offset of the request range in the full range)
+    response.offset = it->shmOffset + (range.start() - it->range.start());
+    return sendResponse(&response, sizeof(response), &it->shmFd, 1);
+}
+
+bool
+SharedMemoryServer::ClientSocketEvent::getAllPhysRanges()
+{
+    // Each range is described by its bounds and its offset in the
+    // shared memory, which is the same file for all of them, so that a
+    // client maps as much memory as it wants with a single request.
+    struct Range
+    {
+        uint64_t start;
+        uint64_t end;
+        uint64_t offset;
+    };
+    std::vector<Range> ranges;
+    int shm_fd = -1;
+    const auto& stores = shmServer->system->getPhysMem().getBackingStore();
+    for (const auto& entry : stores) {
+        if (entry.shmFd < 0) {
+            continue;
+        }
+        if (shm_fd >= 0 && entry.shmFd != shm_fd) {
+            warn("%s: shared ranges are not in a single shared memory",
+                 name());
+            return false;
+        }
+        shm_fd = entry.shmFd;
+        ranges.push_back({entry.range.start(), entry.range.end() - 1,
+                          (uint64_t)entry.shmOffset});
+    }
+    inform("%s: receive request for all %d shared ranges", name(),
+           ranges.size());
+
+    uint64_t count = ranges.size();
+    if (!sendResponse(&count, sizeof(count), &shm_fd, shm_fd >= 0 ? 1 : 0)) {
+        return false;
+    }
+    return ranges.empty() ||
+        sendResponse(ranges.data(), ranges.size() * sizeof(Range));
+}
+
+bool
+SharedMemoryServer::ClientSocketEvent::openChannel()
+{
+    auto& channel = shmServer->channels[pfd.fd];
+    if (channel) {
+        warn("%s: channel is already open", name());
+        return false;
+    }
+
+    int doorbell = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (doorbell < 0) {
+        warn("%s: eventfd failed: %s", name(), strerror(errno));
+        shmServer->channels.erase(pfd.fd);
+        return false;
+    }
+    channel.reset(new Channel(doorbell, pfd.fd, shmServer));
+    if (!channel->create(shmServer->channelEntries)) {
+        shmServer->channels.erase(pfd.fd);
+        return false;
+    }
+    inform("%s: open channel with %d entries", name(),
+           shmServer->channelEntries);
+
+    // The client maps the memory, rings the first doorbell when it
+    // sends messages and waits on the second one for messages sent to
+    // it.
+    uint64_t entries = shmServer->channelEntries;
+    const int fds[] = {channel->memFd, channel->toServerBell,
+                       channel->fromServerBell};
+    if (!sendResponse(&entries, sizeof(entries), fds, 3)) {
+        return false;
+    }
+    pollQueue.schedule(channel.get());
+    return true;
+}
+
+bool
+SharedMemoryServer::ClientSocketEvent::fence()
+{
+    // Requests are only handled between events, so all the accesses of
+    // the simulator to the shared memory so far are done, and made
+    // visible to the client by the fence.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t tick = curTick();
+    return sendResponse(&tick, sizeof(tick));
+}
+
+bool
+SharedMemoryServer::ClientSocketEvent::sendResponse(
+    const void* buffer, size_t size, const int* fds, size_t num_fds)
+{
+    msghdr msg = {};
+    // Setup iovec for fields other than fd. We ignore the endianness as
+    // unix socket only allows communication on the same system anyway.
+    iovec ios = {.iov_base = const_cast<void*>(buffer), .iov_len = size};
+    msg.msg_iov = &ios;
+    msg.msg_iovlen = 1;
+    // Setup fds as an ancillary data.
+    union
+    {
+        char buf[CMSG_SPACE(sizeof(int) * 3)];
+        struct cmsghdr align;
+    } cmsgs;
+    assert(num_fds <= 3);
+    if (num_fds) {
+        msg.msg_control = cmsgs.buf;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * num_fds);
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * num_fds);
+        memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * num_fds);
+    }
+    // Send the response, the data of which is never split so that the
+    // fds arrive with all of it.
+    ssize_t retv = sendmsg(pfd.fd, &msg, 0);
+    if (retv < 0) {
+        warn("%s: sendmsg failed: %s", name(), strerror(errno));
+        return false;
+    }
+    if (retv != (ssize_t)size) {
+        warn("%s: failed to send all response at once", name());
+        return false;
+    }
+    return true;
+}
+
+SharedMemoryServer::Channel::Channel(int doorbell, int client,
+                                     SharedMemoryServer* shm_server)
+    : BaseShmPollEvent(doorbell, shm_server), toServerBell(doorbell),
+      client(client)
+{
+}
+
+SharedMemoryServer::Channel::~Channel()
+{
+    if (layout)
+        munmap(layout, size);
+    if (memFd >= 0)
+        close(memFd);
+    if (fromServerBell >= 0)
+        close(fromServerBell);
+    close(toServerBell);
+}
+
+bool
+SharedMemoryServer::Channel::create(uint64_t entries)
+{
+    fromServerBell = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    memFd = memfd_create(name().c_str(), MFD_CLOEXEC);
+    if (fromServerBell < 0 || memFd < 0) {
+        warn("%s: cannot create channel: %s", name(), strerror(errno));
+        return false;
+    }
+    size = sizeof(ChannelLayout) + 2 * entries * sizeof(ChannelMessage);
+    if (ftruncate(memFd, size) < 0) {
+        warn("%s: cannot size channel: %s", name(), strerror(errno));
+        return false;
+    }
+    void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     memFd, 0);
+    if (mem == MAP_FAILED) {
+        warn("%s: cannot map channel: %s", name(), strerror(errno));
+        return false;
+    }
+    layout = new (mem) ChannelLayout{};
+    layout->magic = ChannelMagic;
+    layout->entries = entries;
+    return true;
+}
+
+void
+SharedMemoryServer::Channel::process(int revents)
+{
+    uint64_t count;
+    [[maybe_unused]] ssize_t retv = read(toServerBell, &count, sizeof(count));
+
+    // Drain the ring, and check it again after updating the head, as
+    // the client only rings the doorbell when it finds the ring empty.
+    ChannelRing& ring = layout->toServer;
+    const ChannelMessage* msgs = messages(true);
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    uint64_t tail;
+    while ((tail = ring.tail.load(std::memory_order_seq_cst)) != head) {
+        for (; head != tail; ++head) {
+            const ChannelMessage msg = msgs[head & (layout->entries - 1)];
+            if (shmServer->messageHandler)
+                shmServer->messageHandler(client, msg);
+        }
+        ring.head.store(head, std::memory_order_seq_cst);
+    }
+}
+
+bool
+SharedMemoryServer::Channel::send(const ChannelMessage& msg)
+{
+    ChannelRing& ring = layout->fromServer;
+    const uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+    const uint64_t head = ring.head.load(std::memory_order_seq_cst);
+    if (tail - head == layout->entries)
+        return false;
+
+    messages(false)[tail & (layout->entries - 1)] = msg;
+    ring.tail.store(tail + 1, std::memory_order_seq_cst);
+    // Only wake the client up if it may have seen the ring empty.
+    if (ring.head.load(std::memory_order_seq_cst) == tail) {
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t retv =
+            write(fromServerBell, &one, sizeof(one));
+    }
+    return true;
+}
+
+void
+SharedMemoryServer::setMessageHandler(MessageHandler handler)
+{
+    messageHandler = std::move(handler);
+}
+
+bool
+SharedMemoryServer::sendMessage(int channel, const ChannelMessage& msg)
+{
+    auto it = channels.find(channel);
+    panic_if(it == channels.end(), "%s: no channel %d", name(), channel);
+    return it->second->send(msg);
+}
+
+void
+SharedMemoryServer::closeClient(int fd)
+{
+    close(fd);
+    channels.erase(fd);
+    clientSocketEvents.erase(fd);
 }
 
 } // namespace memory
@@ -28,6 +28,9 @@
 #ifndef __MEM_SHARED_MEMORY_SERVER_HH__
 #define __MEM_SHARED_MEMORY_SERVER_HH__
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -43,17 +46,88 @@ namespace gem5
 namespace memory
 {
 
+/**
+ * Exposes the shared backing store of a system to other processes
+ * through a unix socket, so that they can map the simulated memory and
+ * access it directly.
+ *
+ * Besides memory ranges, a client can open a channel: a pair of single
+ * producer, single consumer rings of fixed size messages, in memory
+ * shared with the server, with an eventfd doorbell for each direction.
+ * Messages are only handed to the simulator between events, so an
+ * external model exchanging requests and responses with a simulated
+ * device through a channel stays synchronized with the simulation
+ * without a round trip through the socket for each of them.
+ */
 class SharedMemoryServer : public SimObject
 {
   public:
     enum class RequestType : int
     {
+        /** Map a single range, answered with the offset and the fd */
         kGetPhysRange = 0,
+        /** Map all the shared ranges at once */
+        kGetAllPhysRanges = 1,
+        /** Open a channel, answered with its memory and doorbells */
+        kOpenChannel = 2,
+        /**
+         * Make the accesses of the simulator so far visible to the
+         * client, answered with the current tick
+         */
+        kFence = 3,
     };
 
+    /** A message exchanged through a channel, of a cache line */
+    struct ChannelMessage
+    {
+        uint64_t type;
+        uint64_t addr;
+        uint64_t size;
+        uint64_t data[5];
+    };
+    static_assert(sizeof(ChannelMessage) == 64);
+
+    /** Indices of a ring, each written by one side only */
+    struct ChannelRing
+    {
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+    /**
+     * Layout of the memory of a channel, followed by the messages of
+     * the ring to the simulator and then those of the ring from it.
+     */
+    struct ChannelLayout
+    {
+        uint64_t magic;
+        uint64_t entries;
+        ChannelRing toServer;
+        ChannelRing fromServer;
+    };
+    static constexpr uint64_t ChannelMagic = 0x6d65683567636863ULL;
+
+    /**
+     * Called for each message received from a channel, identified by
+     * the fd of its client.
+     */
+    using MessageHandler =
+        std::function<void(int channel, const ChannelMessage &msg)>;
+
     explicit SharedMemoryServer(const SharedMemoryServerParams& params);
     ~SharedMemoryServer();
 
+    /** Set the function handling the messages received from channels */
+    void setMessageHandler(MessageHandler handler);
+
+    /**
+     * Send a message to the client of a channel.
+     *
+     * @return false if the ring of the channel is full
+     */
+    bool sendMessage(int channel, const ChannelMessage &msg);
+
   private:
     class BaseShmPollEvent : public PollEvent
     {
@@ -81,15 +155,63 @@ class SharedMemoryServer : public SimObject
       public:
         using BaseShmPollEvent::BaseShmPollEvent;
         void process(int revent) override;
+
+      private:
+        bool getPhysRange();
+        bool getAllPhysRanges();
+        bool openChannel();
+        bool fence();
+
+        /** Send a response, with fds attached to it */
+        bool sendResponse(const void *buffer, size_t size,
+                          const int *fds=nullptr, size_t num_fds=0);
+    };
+
+    /** The shared memory and doorbells of a channel */
+    class Channel : public BaseShmPollEvent
+    {
+      public:
+        Channel(int doorbell, int client, SharedMemoryServer* shm_server);
+        ~Channel();
+
+        bool create(uint64_t entries);
+        void process(int revent) override;
+        bool send(const ChannelMessage &msg);
+
+        int memFd = -1;
+        int toServerBell;
+        int fromServerBell = -1;
+
+      private:
+        int client;
+        ChannelLayout *layout = nullptr;
+        size_t size = 0;
+
+        ChannelMessage *
+        messages(bool to_server)
+        {
+            return reinterpret_cast<ChannelMessage *>(layout + 1) +
+                (to_server ? 0 : layout->entries);
+        }
     };
 
+    /** Close a client connection and its channel */
+    void closeClient(int fd);
+
     System* system;
 
+    /** Number of messages in each ring of a channel */
+    const uint64_t channelEntries;
+
+    MessageHandler messageHandler;
+
     ListenSocketPtr listener;
 
     std::unique_ptr<ListenSocketEvent> listenSocketEvent;
     std::unordered_map<int, std::unique_ptr<ClientSocketEvent>>
         clientSocketEvents;
+    /** Channels, by fd of their client */
+    std::unordered_map<int, std::unique_ptr<Channel>> channels;
 };
 
 } // namespace memory
@@ -86,7 +86,7 @@ Tick
 SimpleMemory::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &_backdoor)
 {
     Tick latency = recvAtomic(pkt);
-    getBackdoor(_backdoor);
+    getBackdoor(_backdoor, pkt->getAddr());
     return latency;
 }
 
@@ -112,7 +112,7 @@ void
 SimpleMemory::recvMemBackdoorReq(const MemBackdoorReq &req,
         MemBackdoorPtr &_backdoor)
 {
-    getBackdoor(_backdoor);
+    getBackdoor(_backdoor, req.range().start());
 }
 
 bool
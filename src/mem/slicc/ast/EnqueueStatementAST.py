@@ -75,8 +75,8 @@ class EnqueueStatementAST(StatementAST):
 
         # Declare message
         code(
-            "std::shared_ptr<${{msg_type.c_ident}}> out_msg = "
-            "std::make_shared<${{msg_type.c_ident}}>(clockEdge());"
+            "RefCountingPtr<${{msg_type.c_ident}}> out_msg = "
+            "new ${{msg_type.c_ident}}(clockEdge());"
         )
 
         # The other statements
@@ -89,16 +89,18 @@ class EnqueueStatementAST(StatementAST):
                 bypass_strict_fifo_code = self.bypass_strict_fifo.inline(False)
                 code(
                     "(${{self.queue_name.var.code}}).enqueue("
-                    "out_msg, clockEdge(), cyclesToTicks(Cycles($rcode)), $bypass_strict_fifo_code);"
+                    "std::move(out_msg), clockEdge(), "
+                    "cyclesToTicks(Cycles($rcode)), $bypass_strict_fifo_code);"
                 )
             else:
                 code(
                     "(${{self.queue_name.var.code}}).enqueue("
-                    "out_msg, clockEdge(), cyclesToTicks(Cycles($rcode)));"
+                    "std::move(out_msg), clockEdge(), "
+                    "cyclesToTicks(Cycles($rcode)));"
                 )
         else:
             code(
-                "(${{self.queue_name.var.code}}).enqueue(out_msg, "
+                "(${{self.queue_name.var.code}}).enqueue(std::move(out_msg), "
                 "clockEdge(), cyclesToTicks(Cycles(1)));"
             )
 
@@ -38,6 +38,8 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from slicc.ast.DeclAST import DeclAST
+from slicc.ast.IfStatementAST import IfStatementAST
+from slicc.ast.MethodCallExprAST import MemberMethodCallExprAST
 from slicc.ast.TypeAST import TypeAST
 from slicc.symbols import (
     Func,
@@ -59,6 +61,21 @@ class InPortDeclAST(DeclAST):
     def __repr__(self):
         return f"[InPortDecl: {self.ident}]"
 
+    def guardedByReady(self):
+        """Whether the port does nothing unless its queue is ready, that is
+        whether its body is a single if (port.isReady(...)) with no else"""
+        if self.statements is None or len(self.statements.statements) != 1:
+            return False
+        stmt = self.statements.statements[0]
+        if not isinstance(stmt, IfStatementAST) or stmt.else_ is not None:
+            return False
+        cond = stmt.cond
+        return (
+            isinstance(cond, MemberMethodCallExprAST)
+            and cond.proc_name == "isReady"
+            and getattr(cond.obj_expr_ast, "name", None) == self.ident
+        )
+
     def generate(self):
         symtab = self.symtab
         void_type = symtab.find("void", Type)
@@ -78,6 +95,9 @@ class InPortDeclAST(DeclAST):
 
         type = self.queue_type.type
         self.pairs["buffer_expr"] = self.var_expr
+        self.pairs["buffer_type"] = queue_type.ident
+        if self.guardedByReady():
+            self.pairs["ready_guarded"] = True
         in_port = Var(
             self.symtab,
             self.ident,
@@ -54,11 +54,20 @@ from slicc.symbols import SymbolTable
 
 class SLICC(Grammar):
     def __init__(
-        self, filename, base_dir, verbose=False, traceback=False, **kwargs
+        self,
+        filename,
+        base_dir,
+        verbose=False,
+        traceback=False,
+        transition_tables=False,
+        hot_transitions=None,
+        **kwargs,
     ):
         self.protocol = None
         self.traceback = traceback
         self.verbose = verbose
+        self.transition_tables = transition_tables
+        self.hot_transitions = self.readHotTransitions(hot_transitions)
         self.symtab = SymbolTable(self)
         self.base_dir = base_dir
 
@@ -69,6 +78,26 @@ class SLICC(Grammar):
                 sys.exit(str(e))
             raise
 
+    @staticmethod
+    def readHotTransitions(filename):
+        """Read a hint file naming hot transitions, one per line, as
+        <Machine>_Controller.<State>.<Event>. Anything after the first
+        whitespace or a '::' is ignored so grepped stats.txt lines can be
+        used directly. Returns a set of (controller, state, event)."""
+        hot = set()
+        if not filename:
+            return hot
+        with open(filename) as f:
+            for line in f:
+                fields = line.split()
+                if not fields or fields[0].startswith("#"):
+                    continue
+                name = fields[0].split("::")[0].split(".")
+                if len(name) < 3:
+                    sys.exit(f"{filename}: malformed transition '{fields[0]}'")
+                hot.add(tuple(name[-3:]))
+        return hot
+
     def currentLocation(self):
         return util.Location(
             self.current_source, self.current_line, no_warning=not self.verbose
@@ -254,6 +254,18 @@ class StateMachine(Symbol):
                 in_msg_bufs[buf_name].append(port)
         return port_to_buf_map, in_msg_bufs, msg_bufs
 
+    def readyMaskPorts(self, ident):
+        """Map the in_ports whose body only runs when their MessageBuffer
+        is ready to the bit tracking that buffer in m_occupied_in_buffers"""
+        port_to_buf_map, in_msg_bufs, msg_bufs = self.getBufferMaps(ident)
+        return {
+            port: port_to_buf_map[port]
+            for port in self.in_ports
+            if port.get("buffer_type") == "MessageBuffer"
+            and "ready_guarded" in port
+            and port_to_buf_map[port] < 64
+        }
+
     def writeCodeFiles(self, path, includes):
         self.printControllerPython(path)
         self.printControllerHH(path)
@@ -442,6 +454,9 @@ TransitionResult doTransitionWorker(${ident}_Event event,
 ${ident}_Event m_curTransitionEvent;
 ${ident}_State m_curTransitionNextState;
 
+//! Bit per in_port buffer, set while the buffer holds messages
+uint64_t m_occupied_in_buffers;
+
 ${ident}_Event curTransitionEvent() { return m_curTransitionEvent; }
 ${ident}_State curTransitionNextState() { return m_curTransitionNextState; }
 
@@ -786,6 +801,10 @@ $c_ident::init()
             # Set the queue consumers
             code("${{port.code}}.setConsumer(this);")
 
+        code("m_occupied_in_buffers = 0;")
+        for port, bit in self.readyMaskPorts(self.ident).items():
+            code("${{port.code}}.setOccupancyMask(&m_occupied_in_buffers, $bit);")
+
         # Initialize the transition profiling
         code()
         for trans in self.transitions:
@@ -1447,6 +1466,7 @@ $c_ident::functionalReadBuffers(PacketPtr& pkt, WriteMask &mask)
             code('#include "${{include_path}}"')
 
         port_to_buf_map, in_msg_bufs, msg_bufs = self.getBufferMaps(ident)
+        ready_mask_ports = self.readyMaskPorts(ident)
 
         code(
             """
@@ -1492,6 +1512,12 @@ ${ident}_Controller::wakeup()
                 code('m_cur_in_port = ${{port.pairs["rank"]}};')
             else:
                 code("m_cur_in_port = 0;")
+            # Ports that only act on a ready message are skipped while
+            # their buffer is empty
+            if port in ready_mask_ports:
+                bit = ready_mask_ports[port]
+                code("if (m_occupied_in_buffers & (uint64_t(1) << $bit)) {")
+                code.indent()
             if port in port_to_buf_map:
                 code("try {")
                 code.indent()
@@ -1501,11 +1527,14 @@ ${ident}_Controller::wakeup()
                 code.dedent()
                 code(
                     """
-            } catch (const RejectException & e) {
-                rejected[${{port_to_buf_map[port]}}]++;
-            }
+} catch (const RejectException & e) {
+    rejected[${{port_to_buf_map[port]}}]++;
+}
 """
                 )
+            if port in ready_mask_ports:
+                code.dedent()
+                code("}")
             code.dedent()
             code("")
 
@@ -1725,14 +1754,90 @@ ${ident}_Controller::doTransitionWorker(${ident}_Event event,
 {
     m_curTransitionEvent = event;
     m_curTransitionNextState = next_state;
-    switch(HASH_FUN(state, event)) {
 """
         )
 
+        if self.symtab.slicc.transition_tables:
+            self.printTransitionTable(code)
+        else:
+            self.printTransitionCases(code, self.transitions, True)
+
+        code(
+            """
+}
+
+} // namespace ruby
+} // namespace gem5
+"""
+        )
+        code.write(path, f"{self.ident}_Transitions.cc")
+
+    def transitionResourceCode(self, trans):
+        """Resource checks and request type bookkeeping for a transition"""
+        ident = self.ident
+        code = self.symtab.codeFormatter()
+
+        # Check for resources
+        case_sorter = []
+        for key, val in trans.resources.items():
+            val = f"""
+if (!{key.code}.areNSlotsAvailable({val}, clockEdge()))
+    return TransitionResult_ResourceStall;
+"""
+            case_sorter.append(val)
+
+        # Check all of the request_types for resource constraints
+        for request_type in trans.request_types:
+            val = """
+if (!checkResourceAvailable({}_RequestType_{}, addr)) {{
+    return TransitionResult_ResourceStall;
+}}
+""".format(
+                self.ident,
+                request_type.ident,
+            )
+            case_sorter.append(val)
+
+        # Emit the code sequences in a sorted order.  This makes the
+        # output deterministic (without this the output order can vary
+        # since Map's keys() on a vector of pointers is not deterministic
+        for c in sorted(case_sorter):
+            code("$c")
+
+        # Record access types for this transition
+        for request_type in trans.request_types:
+            code(
+                "recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);"
+            )
+
+        return str(code)
+
+    def transitionStalls(self, trans):
+        return any(action.ident == "z_stall" for action in trans.actions)
+
+    def actionArgs(self):
+        if self.TBEType != None and self.EntryType != None:
+            return "m_tbe_ptr, m_cache_entry_ptr, addr"
+        elif self.TBEType != None:
+            return "m_tbe_ptr, addr"
+        elif self.EntryType != None:
+            return "m_cache_entry_ptr, addr"
+        else:
+            return "addr"
+
+    def printTransitionCases(self, code, transitions, exhaustive):
+        """Output a switch with one case per transition. If the switch is
+        not exhaustive, unmatched transitions fall through to the code that
+        follows it."""
+        ident = self.ident
+        args = self.actionArgs()
+
+        code("    switch(HASH_FUN(state, event)) {")
+
         # This map will allow suppress generating duplicate code
         cases = OrderedDict()
 
-        for trans in self.transitions:
+        for trans in transitions:
             case_string = "{}_State_{}, {}_Event_{}".format(
                 self.ident,
                 trans.state.ident,
@@ -1761,67 +1866,15 @@ ${ident}_Controller::doTransitionWorker(${ident}_Event event,
                         "m_curTransitionNextState = next_state;"
                     )
 
-            actions = trans.actions
-            request_types = trans.request_types
-
-            # Check for resources
-            case_sorter = []
-            res = trans.resources
-            for key, val in res.items():
-                val = f"""
-if (!{key.code}.areNSlotsAvailable({val}, clockEdge()))
-    return TransitionResult_ResourceStall;
-"""
-                case_sorter.append(val)
-
-            # Check all of the request_types for resource constraints
-            for request_type in request_types:
-                val = """
-if (!checkResourceAvailable({}_RequestType_{}, addr)) {{
-    return TransitionResult_ResourceStall;
-}}
-""".format(
-                    self.ident,
-                    request_type.ident,
-                )
-                case_sorter.append(val)
-
-            # Emit the code sequences in a sorted order.  This makes the
-            # output deterministic (without this the output order can vary
-            # since Map's keys() on a vector of pointers is not deterministic
-            for c in sorted(case_sorter):
-                case("$c")
-
-            # Record access types for this transition
-            for request_type in request_types:
-                case(
-                    "recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);"
-                )
+            resources = self.transitionResourceCode(trans)
+            case("$resources")
 
             # Figure out if we stall
-            stall = False
-            for action in actions:
-                if action.ident == "z_stall":
-                    stall = True
-                    break
-
-            if stall:
+            if self.transitionStalls(trans):
                 case("return TransitionResult_ProtocolStall;")
             else:
-                if self.TBEType != None and self.EntryType != None:
-                    for action in actions:
-                        case(
-                            "${{action.ident}}(m_tbe_ptr, m_cache_entry_ptr, addr);"
-                        )
-                elif self.TBEType != None:
-                    for action in actions:
-                        case("${{action.ident}}(m_tbe_ptr, addr);")
-                elif self.EntryType != None:
-                    for action in actions:
-                        case("${{action.ident}}(m_cache_entry_ptr, addr);")
-                else:
-                    for action in actions:
-                        case("${{action.ident}}(addr);")
+                for action in trans.actions:
+                    case("${{action.ident}}($args);")
                 case("return TransitionResult_Valid;")
 
             case = str(case)
@@ -1841,8 +1894,9 @@ if (!checkResourceAvailable({}_RequestType_{}, addr)) {{
                 code("  case HASH_FUN($trans):")
             code("    $case\n")
 
-        code(
-            """
+        if exhaustive:
+            code(
+                """
       default:
         panic("Invalid transition\\n"
               "%s time: %d addr: %#x event: %s state: %s\\n",
@@ -1850,13 +1904,193 @@ if (!checkResourceAvailable({}_RequestType_{}, addr)) {{
     }
 
     return TransitionResult_Valid;
-}
+"""
+            )
+        else:
+            code(
+                """
+      default:
+        break;
+    }
+"""
+            )
 
-} // namespace ruby
-} // namespace gem5
+    def printTransitionTable(self, code):
+        """Output doTransitionWorker as a lookup in a constant
+        [state][event] table. Each entry names a slice of a shared array of
+        action member pointers, how the next state is chosen and which
+        resource check, if any, guards the transition. Transitions named
+        in the hot transition hint file are emitted as direct switch cases
+        ahead of the lookup so the compiler can inline their actions."""
+        ident = self.ident
+        c_ident = f"{self.ident}_Controller"
+        args = self.actionArgs()
+
+        hot_names = self.symtab.slicc.hot_transitions
+        hot = [
+            trans
+            for trans in self.transitions
+            if (c_ident, trans.state.ident, trans.event.ident) in hot_names
+        ]
+        if hot:
+            self.printTransitionCases(code, hot, False)
+
+        # Action sequences are stored back to back in one array; identical
+        # sequences and the resource check blocks are shared between
+        # transitions.
+        action_list = []
+        sequences = {}
+        resources = OrderedDict()
+        entries = {}
+        computed = False
+        for trans in self.transitions:
+            stall = self.transitionStalls(trans)
+            seq = () if stall else tuple(a.ident for a in trans.actions)
+            if seq and seq not in sequences:
+                sequences[seq] = len(action_list)
+                action_list.extend(seq)
+            first = sequences.get(seq, 0)
+
+            res = self.transitionResourceCode(trans)
+            res_idx = 0
+            if res.strip():
+                if res not in resources:
+                    resources[res] = len(resources) + 1
+                res_idx = resources[res]
+
+            if trans.state == trans.nextState:
+                next_kind, next_state = "TransitionNextSame", "FIRST"
+            elif trans.nextState.isWildcard():
+                next_kind, next_state = "TransitionNextComputed", "FIRST"
+                computed = True
+            else:
+                next_kind = "TransitionNextFixed"
+                next_state = trans.nextState.ident
+
+            kind = "TransitionProtocolStall" if stall else "TransitionValid"
+            entries[(trans.state.ident, trans.event.ident)] = (
+                f"{{{first}, {len(seq)}, {kind}, {next_kind}, {res_idx}, "
+                f"{ident}_State_{next_state}}}"
+            )
+
+        if len(action_list) >= 1 << 16:
+            self.error("Too many actions for the transition table")
+
+        if self.TBEType != None and self.EntryType != None:
+            params = (
+                f"{self.TBEType.c_ident}*&, {self.EntryType.c_ident}*&, Addr"
+            )
+        elif self.TBEType != None:
+            params = f"{self.TBEType.c_ident}*&, Addr"
+        elif self.EntryType != None:
+            params = f"{self.EntryType.c_ident}*&, Addr"
+        else:
+            params = "Addr"
+
+        code(
+            """
+
+    typedef void (${c_ident}::*TransitionAction)($params);
+    static constexpr TransitionAction transitionActions[] = {
+"""
+        )
+        for action in action_list:
+            code("        &${c_ident}::${action},")
+        if not action_list:
+            code("        nullptr,")
+        code(
+            """
+    };
+
+    enum : uint8_t
+    {
+        TransitionInvalid = 0,
+        TransitionValid,
+        TransitionProtocolStall
+    };
+
+    enum : uint8_t
+    {
+        TransitionNextSame = 0,
+        TransitionNextFixed,
+        TransitionNextComputed
+    };
+
+    struct TransitionEntry
+    {
+        uint16_t action;     // First entry in transitionActions
+        uint8_t numActions;
+        uint8_t kind;
+        uint8_t next;
+        uint16_t resources;  // Resource check case, 0 if there is none
+        ${ident}_State nextState;
+    };
+
+    static constexpr TransitionEntry
+    transitionTable[${ident}_State_NUM][${ident}_Event_NUM] = {
+"""
+        )
+        for state in self.states.values():
+            code("        { // ${{state.ident}}")
+            for event in self.events.values():
+                entry = entries.get((state.ident, event.ident), "{}")
+                code("            $entry, // ${{event.ident}}")
+            code("        },")
+        code(
+            """
+    };
+
+    const TransitionEntry &entry = transitionTable[state][event];
+    if (entry.kind == TransitionInvalid) {
+        panic("Invalid transition\\n"
+              "%s time: %d addr: %#x event: %s state: %s\\n",
+              name(), curCycle(), addr, event, state);
+    }
+
+    if (entry.next == TransitionNextFixed) {
+        next_state = entry.nextState;
+        m_curTransitionNextState = next_state;
+    }
+"""
+        )
+        # getNextState() is only declared by machines that use wildcard
+        # next states
+        if computed:
+            code(
+                """
+    if (entry.next == TransitionNextComputed) {
+        next_state = getNextState(addr);
+        m_curTransitionNextState = next_state;
+    }
+"""
+            )
+        code(
+            """
+
+    switch (entry.resources) {
+"""
+        )
+        for res, idx in resources.items():
+            code("      case $idx:")
+            code.indent(2)
+            code("$res")
+            code("break;")
+            code.dedent(2)
+        code(
+            """
+      default:
+        break;
+    }
+
+    if (entry.kind == TransitionProtocolStall)
+        return TransitionResult_ProtocolStall;
+
+    for (int i = 0; i < entry.numActions; ++i)
+        (this->*transitionActions[entry.action + i])($args);
+
+    return TransitionResult_Valid;
 """
         )
-        code.write(path, f"{self.ident}_Transitions.cc")
 
     # **************************
     # ******* HTML Files *******
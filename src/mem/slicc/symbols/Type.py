@@ -319,14 +319,26 @@ $klass ${{self.c_ident}}$parent
             code.dedent()
             code("}")
 
-        # create a clone member
+        # create a clone member, and have messages allocated from a pool
         if self.isMessage:
             code(
                 """
 MsgPtr
 clone() const
 {
-     return std::shared_ptr<Message>(new ${{self.c_ident}}(*this));
+     return new ${{self.c_ident}}(*this);
+}
+
+static void *
+operator new(std::size_t size)
+{
+    return ObjectPool<${{self.c_ident}}>::allocate(size);
+}
+
+static void
+operator delete(void *p, std::size_t size)
+{
+    ObjectPool<${{self.c_ident}}>::release(p, size);
 }
 """
             )
@@ -341,6 +353,25 @@ clone() const
 """
             )
 
+            # cache entries are created and destroyed on every fill and
+            # eviction, so they are allocated from slabs as well
+            if self.get("interface") == "AbstractCacheEntry":
+                code(
+                    """
+static void *
+operator new(std::size_t size)
+{
+    return ObjectPool<${{self.c_ident}}>::allocate(size);
+}
+
+static void
+operator delete(void *p, std::size_t size)
+{
+    ObjectPool<${{self.c_ident}}>::release(p, size);
+}
+"""
+                )
+
         if not self.isGlobal:
             # const Get methods for each field
             code("// Const accessors methods for each field")
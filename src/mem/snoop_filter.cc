@@ -52,6 +52,25 @@ namespace gem5
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
+void
+SnoopFilter::SnoopFilterCache::rehash(size_t num_slots)
+{
+    assert(isPowerOf2(num_slots) && num_slots > numItems);
+
+    std::vector<Slot> old_slots(num_slots, Slot{EmptyKey, SnoopItem()});
+    old_slots.swap(slots);
+    hostMem.sub(old_slots.capacity() * sizeof(Slot));
+    hostMem.add(slots.capacity() * sizeof(Slot));
+    hashShift = 64 - floorLog2(num_slots);
+    numItems = 0;
+    numUsed = 0;
+
+    for (const Slot &slot : old_slots) {
+        if (slot.first != EmptyKey && slot.first != ErasedKey)
+            emplace(slot.first, slot.second);
+    }
+}
+
 void
 SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
 {
@@ -113,8 +132,7 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
 
     // If we are not allocating, we are done
     if (!allocate)
-        return snoopSelected(maskToPortList(interested & ~req_port),
-                             lookupLatency);
+        return snoopSelected(interested & ~req_port, lookupLatency);
 
     if (cpkt->needsResponse()) {
         if (!cpkt->cacheResponding()) {
@@ -153,7 +171,7 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         }
     }
 
-    return snoopSelected(maskToPortList(interested & ~req_port), lookupLatency);
+    return snoopSelected(interested & ~req_port, lookupLatency);
 }
 
 void
@@ -237,7 +255,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         eraseIfNullEntry(sf_it);
     }
 
-    return snoopSelected(maskToPortList(interested), lookupLatency);
+    return snoopSelected(interested, lookupLatency);
 }
 
 void
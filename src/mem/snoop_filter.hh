@@ -44,13 +44,16 @@
 #define __MEM_SNOOP_FILTER_HH__
 
 #include <bitset>
-#include <unordered_map>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
 #include "params/SnoopFilter.hh"
+#include "sim/host_mem.hh"
 #include "sim/sim_object.hh"
 #include "sim/system.hh"
 
@@ -93,10 +96,89 @@ class SnoopFilter : public SimObject
     // Change for systems with more than 256 ports tracked by this object
     static const int SNOOP_MASK_SIZE = 256;
 
-    typedef std::vector<QueuedResponsePort*> SnoopList;
+    typedef std::vector<QueuedResponsePort*> PortList;
+
+    /**
+     * The underlying type for the bitmask we use for tracking. This
+     * limits the number of snooping ports supported per crossbar.
+     */
+    typedef std::bitset<SNOOP_MASK_SIZE> SnoopMask;
+
+    /**
+     * The CPU-side ports a packet has to be snooped on. The ports are
+     * kept as a mask of the snooping ports of the filter, so a lookup
+     * does not build a list of ports, but they are iterated over as if
+     * they were one.
+     */
+    class SnoopList
+    {
+      public:
+        class const_iterator
+        {
+          public:
+            const_iterator(const SnoopList &list, size_t idx)
+                : list(list), idx(idx)
+            {
+                skip();
+            }
+
+            QueuedResponsePort *
+            operator*() const
+            {
+                return (*list.ports)[idx];
+            }
+
+            const_iterator &
+            operator++()
+            {
+                ++idx;
+                skip();
+                return *this;
+            }
+
+            bool
+            operator!=(const const_iterator &other) const
+            {
+                return idx != other.idx;
+            }
+
+          private:
+            /** Move to the next port in the mask */
+            void
+            skip()
+            {
+                while (idx < list.ports->size() && !list.mask[idx])
+                    ++idx;
+            }
+
+            const SnoopList &list;
+            size_t idx;
+        };
+
+        SnoopList(const PortList &ports, const SnoopMask &mask)
+            : ports(&ports), mask(mask)
+        {}
+
+        const_iterator begin() const { return const_iterator(*this, 0); }
+        const_iterator
+        end() const
+        {
+            return const_iterator(*this, ports->size());
+        }
+
+        size_t size() const { return mask.count(); }
+        bool empty() const { return mask.none(); }
+
+      private:
+        /** The snooping ports of the filter */
+        const PortList *ports;
+        /** The ports to snoop, indexed as ports */
+        SnoopMask mask;
+    };
 
     SnoopFilter (const SnoopFilterParams &p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
+        SimObject(p), cachedLocations(name() + ".cachedLocations"),
+        reqLookupResult(cachedLocations.end()),
         linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
         maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
         stats(this)
@@ -109,7 +191,7 @@ class SnoopFilter : public SimObject
      *
      * @param _cpu_side_ports Response ports that the bus is attached to.
      */
-    void setCPUSidePorts(const SnoopList& _cpu_side_ports) {
+    void setCPUSidePorts(const PortList& _cpu_side_ports) {
         localResponsePortIds.resize(_cpu_side_ports.size(), InvalidPortID);
 
         PortID id = 0;
@@ -204,12 +286,6 @@ class SnoopFilter : public SimObject
 
   protected:
 
-    /**
-     * The underlying type for the bitmask we use for tracking. This
-     * limits the number of snooping ports supported per crossbar.
-     */
-    typedef std::bitset<SNOOP_MASK_SIZE> SnoopMask;
-
     /**
     * Per cache line item tracking a bitmask of ResponsePorts who have an
     * outstanding request to this line (requested) or already share a
@@ -220,27 +296,97 @@ class SnoopFilter : public SimObject
         SnoopMask requested;
         SnoopMask holder;
     };
+
     /**
-     * HashMap of SnoopItems indexed by line address
+     * Hash table of SnoopItems indexed by line address. The items are
+     * kept in a single array searched by linear probing, rather than in
+     * one heap allocation per line, so looking a line up touches
+     * adjacent memory and tracking a new line does not allocate. As for
+     * an unordered_map, iterators are only invalidated by inserting
+     * items: an erased item is turned into a tombstone and the other
+     * items stay in place.
      */
-    typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
+    class SnoopFilterCache
+    {
+      public:
+        /** A slot of the table, holding a line address and its item */
+        struct Slot
+        {
+            Addr first;
+            SnoopItem second;
+        };
+
+        typedef Slot* iterator;
+
+        explicit SnoopFilterCache(const std::string &name) : hostMem(name)
+        {}
+
+        iterator end() { return nullptr; }
+
+        iterator find(Addr addr);
+
+        /**
+         * Insert an item if the line is not tracked yet.
+         *
+         * @return Pair of an iterator to the item of the line and whether
+         *         it was inserted.
+         */
+        std::pair<iterator, bool> emplace(Addr addr, const SnoopItem &item);
+
+        SnoopItem &
+        operator[](Addr addr)
+        {
+            return emplace(addr, SnoopItem()).first->second;
+        }
+
+        void erase(iterator it);
+
+        size_t size() const { return numItems; }
+
+      private:
+        /** Keys of the free slots, which cannot be line addresses */
+        static constexpr Addr EmptyKey = MaxAddr;
+        static constexpr Addr ErasedKey = MaxAddr - 1;
+
+        /** Slot to start probing for an address from */
+        size_t
+        hash(Addr addr) const
+        {
+            return (addr * 0x9e3779b97f4a7c15ULL) >> hashShift;
+        }
+
+        /** Reinsert all items in a table of the given number of slots */
+        void rehash(size_t num_slots);
+
+        std::vector<Slot> slots;
+        /** Number of items in the table */
+        size_t numItems = 0;
+        /** Number of slots holding an item or a tombstone */
+        size_t numUsed = 0;
+        /** Shift keeping the bits of the hash that index the slots */
+        int hashShift = 64;
+
+        host_mem::Account hostMem;
+    };
 
     /**
      * Simple factory methods for standard return values.
      */
     std::pair<SnoopList, Cycles> snoopAll(Cycles latency) const
     {
-        return std::make_pair(cpuSidePorts, latency);
+        SnoopMask all;
+        for (size_t i = 0; i < cpuSidePorts.size(); i++)
+            all.set(i);
+        return std::make_pair(SnoopList(cpuSidePorts, all), latency);
     }
-    std::pair<SnoopList, Cycles> snoopSelected(const SnoopList&
-                                _cpu_side_ports, Cycles latency) const
+    std::pair<SnoopList, Cycles> snoopSelected(SnoopMask ports,
+                                               Cycles latency) const
     {
-        return std::make_pair(_cpu_side_ports, latency);
+        return std::make_pair(SnoopList(cpuSidePorts, ports), latency);
     }
     std::pair<SnoopList, Cycles> snoopDown(Cycles latency) const
     {
-        SnoopList empty;
-        return std::make_pair(empty , latency);
+        return std::make_pair(SnoopList(cpuSidePorts, 0), latency);
     }
 
     /**
@@ -249,12 +395,6 @@ class SnoopFilter : public SimObject
      * @return One-hot bitmask corresponding to the port.
      */
     SnoopMask portToMask(const ResponsePort& port) const;
-    /**
-     * Converts a bitmask of ports into the corresponing list of ports
-     * @param ports SnoopMask of the requested ports
-     * @return SnoopList containing all the requested ResponsePorts
-     */
-    SnoopList maskToPortList(SnoopMask ports) const;
 
   private:
 
@@ -297,8 +437,11 @@ class SnoopFilter : public SimObject
         ReqLookupResult() = delete;
     } reqLookupResult;
 
-    /** List of all attached snooping CPU-side ports. */
-    SnoopList cpuSidePorts;
+    /**
+     * List of all attached snooping CPU-side ports, in the order of
+     * their bit in a SnoopMask.
+     */
+    PortList cpuSidePorts;
     /** Track the mapping from port ids to the local mask ids. */
     std::vector<PortID> localResponsePortIds;
     /** Cache line size. */
@@ -332,6 +475,61 @@ class SnoopFilter : public SimObject
     } stats;
 };
 
+inline SnoopFilter::SnoopFilterCache::iterator
+SnoopFilter::SnoopFilterCache::find(Addr addr)
+{
+    if (numItems == 0)
+        return end();
+
+    const size_t mask = slots.size() - 1;
+    for (size_t idx = hash(addr); ; idx = (idx + 1) & mask) {
+        Slot &slot = slots[idx];
+        if (slot.first == addr)
+            return &slot;
+        if (slot.first == EmptyKey)
+            return end();
+    }
+}
+
+inline std::pair<SnoopFilter::SnoopFilterCache::iterator, bool>
+SnoopFilter::SnoopFilterCache::emplace(Addr addr, const SnoopItem &item)
+{
+    assert(addr != EmptyKey && addr != ErasedKey);
+
+    // Keep at least a quarter of the slots empty for probes to end early
+    if ((numUsed + 1) * 4 > slots.size() * 3)
+        rehash(std::max<size_t>(16, size_t(1) << ceilLog2(
+            (numItems + 1) * 2)));
+
+    const size_t mask = slots.size() - 1;
+    Slot *erased = nullptr;
+    for (size_t idx = hash(addr); ; idx = (idx + 1) & mask) {
+        Slot &slot = slots[idx];
+        if (slot.first == addr)
+            return std::make_pair(&slot, false);
+        if (slot.first == ErasedKey && !erased)
+            erased = &slot;
+        if (slot.first == EmptyKey) {
+            // Reuse the first tombstone met on the way, if any
+            Slot *target = erased ? erased : &slot;
+            if (!erased)
+                numUsed++;
+            numItems++;
+            target->first = addr;
+            target->second = item;
+            return std::make_pair(target, true);
+        }
+    }
+}
+
+inline void
+SnoopFilter::SnoopFilterCache::erase(iterator it)
+{
+    assert(it != end() && it->first != EmptyKey && it->first != ErasedKey);
+    it->first = ErasedKey;
+    numItems--;
+}
+
 inline SnoopFilter::SnoopMask
 SnoopFilter::portToMask(const ResponsePort& port) const
 {
@@ -341,16 +539,6 @@ SnoopFilter::portToMask(const ResponsePort& port) const
         ((SnoopMask)1) << localResponsePortIds[port.getId()];
 }
 
-inline SnoopFilter::SnoopList
-SnoopFilter::maskToPortList(SnoopMask port_mask) const
-{
-    SnoopList res;
-    for (const auto& p : cpuSidePorts)
-        if ((port_mask & portToMask(*p)).any())
-            res.push_back(p);
-    return res;
-}
-
 } // namespace gem5
 
 #endif // __MEM_SNOOP_FILTER_HH__
@@ -48,6 +48,7 @@
 #include "arch/generic/mmu.hh"
 #include "base/chunk_generator.hh"
 #include "cpu/base.hh"
+#include "mem/backdoor.hh"
 #include "cpu/thread_context.hh"
 #include "sim/system.hh"
 
@@ -121,4 +122,68 @@ TranslatingPortProxy::tryMemsetBlob(Addr addr, uint8_t v, uint64_t size) const
     });
 }
 
+bool
+TranslatingPortProxy::tryLoadBlob(
+        Addr addr, const void *p, uint64_t size) const
+{
+    constexpr auto mode = BaseMMU::Write;
+    return tryOnBlob(mode, _tc->getMMUPtr()->translateFunctional(
+            addr, size, _tc, mode, flags),
+        [this, &p](const auto &range) {
+            PortProxy::loadBlobPhys(range.paddr, flags, p, range.size);
+            p = static_cast<const uint8_t *>(p) + range.size;
+    });
+}
+
+bool
+TranslatingPortProxy::tryLoadZeros(Addr addr, uint64_t size) const
+{
+    constexpr auto mode = BaseMMU::Write;
+    return tryOnBlob(mode, _tc->getMMUPtr()->translateFunctional(
+            addr, size, _tc, mode, flags),
+        [this](const auto &range) {
+            PortProxy::loadZerosPhys(range.paddr, flags, range.size);
+    });
+}
+
+bool
+TranslatingPortProxy::tryHostIovecs(Addr addr, uint64_t size,
+        BaseMMU::Mode mode, std::vector<struct iovec> &iov) const
+{
+    const auto access = mode == BaseMMU::Read ?
+        MemBackdoor::Readable : MemBackdoor::Writeable;
+    MemBackdoorPtr backdoor = nullptr;
+    bool reachable = true;
+
+    iov.clear();
+    const bool translated = tryOnBlob(mode,
+            _tc->getMMUPtr()->translateFunctional(addr, size, _tc, mode,
+                flags),
+        [&](const auto &range) {
+            if (!reachable || range.size == 0)
+                return;
+            const AddrRange phys(range.paddr, range.paddr + range.size);
+            if (!backdoor || !phys.isSubset(backdoor->range())) {
+                backdoor = nullptr;
+                _tc->sendMemBackdoorReq(MemBackdoorReq(phys, access),
+                        backdoor);
+                if (!backdoor || backdoor->range().interleaved() ||
+                        !phys.isSubset(backdoor->range()) ||
+                        !(backdoor->flags() & access)) {
+                    reachable = false;
+                    return;
+                }
+            }
+            uint8_t *host = backdoor->ptr() +
+                (range.paddr - backdoor->range().start());
+            if (!iov.empty() && static_cast<uint8_t *>(iov.back().iov_base) +
+                    iov.back().iov_len == host) {
+                iov.back().iov_len += range.size;
+            } else {
+                iov.push_back({host, range.size});
+            }
+    });
+    return translated && reachable;
+}
+
 } // namespace gem5
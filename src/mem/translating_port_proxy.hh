@@ -41,7 +41,10 @@
 #ifndef __MEM_TRANSLATING_PORT_PROXY_HH__
 #define __MEM_TRANSLATING_PORT_PROXY_HH__
 
+#include <sys/uio.h>
+
 #include <functional>
+#include <vector>
 
 #include "arch/generic/mmu.hh"
 #include "mem/port_proxy.hh"
@@ -87,6 +90,26 @@ class TranslatingPortProxy : public PortProxy
      * Fill size bytes starting at addr with byte value val.
      */
     bool tryMemsetBlob(Addr address, uint8_t  v, uint64_t size) const override;
+
+    /** Versions of tryLoadBlob and tryLoadZeros that translate virt->phys
+      * and deal with page boundries. */
+    bool tryLoadBlob(Addr addr, const void *p, uint64_t size) const override;
+    bool tryLoadZeros(Addr addr, uint64_t size) const override;
+
+    /**
+     * Find where the memory behind size bytes at addr is in the
+     * simulator, so it can be accessed without going through the port.
+     * This only works if memory hands out back doors for all of it, which
+     * it won't do if, for instance, a cache is in the way.
+     *
+     * @param mode Read if the memory will be read, Write if it will be
+     *        written.
+     * @param iov Filled with the host memory the range maps to, with the
+     *        pieces which are contiguous in the host merged.
+     * @return Whether all of the range translated and has a back door.
+     */
+    bool tryHostIovecs(Addr addr, uint64_t size, BaseMMU::Mode mode,
+            std::vector<struct iovec> &iov) const;
 };
 
 } // namespace gem5
@@ -147,7 +147,8 @@ BaseXBar::Layer<SrcType, DstType>::Layer(DstType& _port, BaseXBar& _xbar,
                                        const std::string& _name) :
     statistics::Group(&_xbar, _name.c_str()),
     port(_port), xbar(_xbar), _name(xbar.name() + "." + _name), state(IDLE),
-    waitingForPeer(NULL), releaseEvent([this]{ releaseLayer(); }, name()),
+    busyUntil(0), waitingForPeer(NULL),
+    releaseEvent([this]{ releaseLayer(); }, name()),
     ADD_STAT(occupancy, statistics::units::Tick::get(), "Layer occupancy (ticks)"),
     ADD_STAT(utilization, statistics::units::Ratio::get(), "Layer utilization")
 {
@@ -172,7 +173,12 @@ void BaseXBar::Layer<SrcType, DstType>::occupyLayer(Tick until)
 
     // until should never be 0 as express snoops never occupy the layer
     assert(until != 0);
-    xbar.schedule(releaseEvent, until);
+    busyUntil = until;
+
+    // only bother releasing the layer if someone is waiting for it,
+    // otherwise it is considered idle again once until has passed
+    if (!waitingForLayer.empty() || drainState() == DrainState::Draining)
+        scheduleRelease();
 
     // account for the occupied ticks
     occupancy += until - curTick();
@@ -181,10 +187,30 @@ void BaseXBar::Layer<SrcType, DstType>::occupyLayer(Tick until)
             curTick(), until);
 }
 
+template <typename SrcType, typename DstType>
+void
+BaseXBar::Layer<SrcType, DstType>::checkRelease()
+{
+    if (state == BUSY && !releaseEvent.scheduled() && curTick() >= busyUntil)
+        state = IDLE;
+}
+
+template <typename SrcType, typename DstType>
+void
+BaseXBar::Layer<SrcType, DstType>::scheduleRelease()
+{
+    // while the packet is being forwarded the release time is not
+    // known yet, occupyLayer will schedule it
+    if (state == BUSY && !releaseEvent.scheduled() && busyUntil != MaxTick)
+        xbar.schedule(releaseEvent, std::max(busyUntil, curTick()));
+}
+
 template <typename SrcType, typename DstType>
 bool
 BaseXBar::Layer<SrcType, DstType>::tryTiming(SrcType* src_port)
 {
+    checkRelease();
+
     // if we are in the retry state, we will not see anything but the
     // retrying port (or in the case of the snoop ports the snoop
     // response port that mirrors the actual CPU-side port) as we leave
@@ -204,10 +230,12 @@ BaseXBar::Layer<SrcType, DstType>::tryTiming(SrcType* src_port)
         // that transaction to go through, and then the layer to free
         // up)
         waitingForLayer.push_back(src_port);
+        scheduleRelease();
         return false;
     }
 
     state = BUSY;
+    busyUntil = MaxTick;
 
     return true;
 }
@@ -323,10 +351,12 @@ BaseXBar::Layer<SrcType, DstType>::recvRetry()
 
     // if the layer is idle, retry this port straight away, if we
     // are busy, then simply let the port wait for its turn
+    checkRelease();
     if (state == IDLE) {
         retryWaiting();
     } else {
         assert(state == BUSY);
+        scheduleRelease();
     }
 }
 
@@ -447,6 +477,10 @@ BaseXBar::recvRangeChange(PortID mem_side_port_id)
     // modules, go ahead and tell our connected memory-side-port modules in
     // turn, this effectively assumes a tree structure of the system
     if (gotAllAddrRanges) {
+        // the ranges rarely change once we have them all, so decode
+        // with the flat table until they do
+        portMap.freeze();
+
         DPRINTF(AddrRanges, "Aggregating address ranges\n");
         xbarRanges.clear();
 
@@ -600,8 +634,11 @@ BaseXBar::Layer<SrcType, DstType>::drain()
     //We should check that we're not "doing" anything, and that noone is
     //waiting. We might be idle but have someone waiting if the device we
     //contacted for a retry didn't actually retry.
+    checkRelease();
     if (state != IDLE) {
         DPRINTF(Drain, "Crossbar not drained\n");
+        // release the layer to signal when it is drained
+        scheduleRelease();
         return DrainState::Draining;
     } else {
         return DrainState::Drained;
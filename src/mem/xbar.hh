@@ -204,6 +204,28 @@ class BaseXBar : public ClockedObject
 
         State state;
 
+        /**
+         * The tick until which the layer is busy, or MaxTick while a
+         * packet that got the layer is being forwarded. The layer only
+         * schedules releaseEvent at this tick if a port is waiting for
+         * it, or it is asked to drain. Otherwise it goes back to idle
+         * the first time it is looked at after this tick, see
+         * checkRelease().
+         */
+        Tick busyUntil;
+
+        /**
+         * Go back to idle if the layer is busy, the time it was occupied
+         * for has passed, and no release event was scheduled.
+         */
+        void checkRelease();
+
+        /**
+         * Make sure the layer gets released, so that the waiting ports
+         * are retried or draining completes.
+         */
+        void scheduleRelease();
+
         /**
          * A deque of ports that retry should be called on because
          * the original send was delayed due to a busy layer.
@@ -41,6 +41,7 @@ from m5.objects import (
     AddrRange,
     DRAMInterface,
     MemCtrl,
+    MultiChannelMemCtrl,
     Port,
 )
 from m5.util.convert import toMemorySize
@@ -157,8 +158,8 @@ class ChanneledMemory(AbstractMemorySystem):
             )
 
         intlv_bits = log(self._num_channels, 2)
-        for i, ctrl in enumerate(self.mem_ctrl):
-            ctrl.dram.range = AddrRange(
+        for i, dram in enumerate(self._dram):
+            dram.range = AddrRange(
                 start=self._mem_range.start,
                 size=self._mem_range.size(),
                 intlvHighBit=intlv_low_bit + intlv_bits - 1,
@@ -203,3 +204,33 @@ class ChanneledMemory(AbstractMemorySystem):
             )
         self._mem_range = ranges[0]
         self._interleave_addresses()
+
+
+class SingleControllerChanneledMemory(ChanneledMemory):
+    """A multi-channel memory system with a single controller
+
+    Rather than one MemCtrl per channel, each behind its own port on the
+    board's memory bus, a single MultiChannelMemCtrl schedules all the
+    channels and decodes the channel of a request from its address. The
+    channels are interleaved the same way as in ChanneledMemory.
+    """
+
+    @overrides(ChanneledMemory)
+    def _create_mem_interfaces_controller(self):
+        if not _isPow2(self._num_channels):
+            raise ValueError("The number of channels should be a power of 2")
+
+        self._dram = [
+            self._dram_class(addr_mapping=self._addr_mapping)
+            for _ in range(self._num_channels)
+        ]
+
+        self.mem_ctrl = MultiChannelMemCtrl(channels=self._dram)
+
+    @overrides(ChanneledMemory)
+    def get_mem_ports(self) -> Sequence[Tuple[AddrRange, Port]]:
+        return [(self._mem_range, self.mem_ctrl.port)]
+
+    @overrides(ChanneledMemory)
+    def get_memory_controllers(self) -> List[MemCtrl]:
+        return [self.mem_ctrl]
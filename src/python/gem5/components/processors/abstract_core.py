@@ -35,6 +35,7 @@ from typing import (
 
 from m5.objects import (
     BaseMMU,
+    LooppointProfiler,
     PcCountTrackerManager,
     Port,
     SubSystem,
@@ -175,3 +176,14 @@ class AbstractCore(SubSystem):
         self, target_pair: List[PcCountPair], manager: PcCountTrackerManager
     ) -> None:
         raise NotImplementedError
+
+    def add_looppoint_profiler_probe(
+        self, profiler: LooppointProfiler
+    ) -> None:
+        """Feed the instructions this core retires to a LooppointProfiler.
+
+        :param profiler: The profiler shared by all the cores.
+        """
+        raise NotImplementedError(
+            "This core type does not support LoopPoint profiling"
+        )
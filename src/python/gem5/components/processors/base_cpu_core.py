@@ -32,6 +32,8 @@ from typing import (
 from m5.objects import (
     BaseCPU,
     BaseMMU,
+    LooppointProfiler,
+    LooppointProfilerProbe,
     PcCountTracker,
     PcCountTrackerManager,
     Port,
@@ -187,3 +189,11 @@ class BaseCPUCore(AbstractCore):
         pair_tracker.core = self.core
         pair_tracker.ptmanager = manager
         self.core.probeListener = pair_tracker
+
+    @overrides(AbstractCore)
+    def add_looppoint_profiler_probe(
+        self, profiler: LooppointProfiler
+    ) -> None:
+        self.core.looppointProfilerProbe = LooppointProfilerProbe(
+            profiler=profiler
+        )
@@ -77,6 +77,9 @@ class BaseCPUProcessor(AbstractProcessor):
                 for obj in core.get_simobject().descendants():
                     obj.eventq_index = 0
                 core.get_simobject().eventq_index = i + 1
+                # Don't make the vCPU threads wait for the devices when
+                # writing to them
+                core.get_simobject().postDeviceWrites = True
             board.set_mem_mode(MemMode.ATOMIC_NONCACHING)
         elif isinstance(
             self.cores[0].get_simobject(),
@@ -102,6 +102,9 @@ class SwitchableProcessor(AbstractProcessor):
                 for obj in core.get_simobject().descendants():
                     obj.eventq_index = 0
                 core.get_simobject().eventq_index = i + 1
+                # Don't make the vCPU threads wait for the devices when
+                # writing to them
+                core.get_simobject().postDeviceWrites = True
 
     @overrides(AbstractProcessor)
     def get_num_cores(self) -> int:
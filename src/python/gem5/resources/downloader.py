@@ -52,8 +52,9 @@ from ..utils.socks_ssl_context import get_proxy_context
 from .client import get_resource_json_obj
 from .client import list_resources as client_list_resources
 from .md5_utils import (
+    md5_cache_path,
     md5_dir,
-    md5_file,
+    md5_file_cached,
 )
 
 """
@@ -257,7 +258,7 @@ def get_resource(
 
         if os.path.exists(to_path):
             if os.path.isfile(to_path):
-                md5 = md5_file(Path(to_path))
+                md5 = md5_file_cached(Path(to_path))
             else:
                 md5 = md5_dir(Path(to_path))
 
@@ -268,6 +269,8 @@ def get_resource(
             elif download_md5_mismatch:
                 if os.path.isfile(to_path):
                     os.remove(to_path)
+                    if md5_cache_path(to_path).exists():
+                        os.remove(md5_cache_path(to_path))
                 else:
                     shutil.rmtree(to_path)
             else:
@@ -350,7 +353,7 @@ def get_resource(
             unzip_to = download_dest[: -len(zip_extension)]
             with gzip.open(download_dest, "rb") as f:
                 with open(unzip_to, "wb") as o:
-                    shutil.copyfileobj(f, o)
+                    shutil.copyfileobj(f, o, 1024 * 1024)
             os.remove(download_dest)
             download_dest = unzip_to
             if not quiet:
@@ -26,8 +26,17 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 import hashlib
+import json
+import os
 from pathlib import Path
-from typing import Type
+from typing import (
+    Optional,
+    Type,
+)
+
+# Reading large chunks keeps the per-read Python overhead out of the hashing
+# of multi-GB disk images.
+_CHUNK_SIZE = 1024 * 1024
 
 
 def _md5_update_from_file(
@@ -50,7 +59,7 @@ def _md5_update_from_file(
         desc=f"Computing md5sum on {filename}",
         total=filename.stat().st_size,
     ) as f:
-        for chunk in iter(lambda: f.read(4096), b""):
+        for chunk in iter(lambda: f.read(_CHUNK_SIZE), b""):
             hash.update(chunk)
     return hash
 
@@ -105,3 +114,67 @@ def md5_dir(directory: Path) -> str:
         if empty files are included or filenames are changed.
     """
     return str(_md5_update_from_dir(directory, hashlib.md5()).hexdigest())
+
+
+def md5_cache_path(filename: Path) -> Path:
+    """
+    The file in which ``md5_file_cached`` records the md5 of a file.
+    """
+    return Path(f"{filename}.md5cache")
+
+
+def _file_key(filename: Path) -> dict:
+    stat = filename.stat()
+    return {
+        "path": str(filename.resolve()),
+        "size": stat.st_size,
+        "mtime_ns": stat.st_mtime_ns,
+        "inode": stat.st_ino,
+    }
+
+
+def _cached_md5(filename: Path, key: dict) -> Optional[str]:
+    try:
+        with open(md5_cache_path(filename)) as f:
+            entry = json.load(f)
+    except (OSError, ValueError):
+        return None
+    if not isinstance(entry, dict) or entry.get("key") != key:
+        return None
+    md5 = entry.get("md5")
+    return md5 if isinstance(md5, str) else None
+
+
+def md5_file_cached(filename: Path) -> str:
+    """
+    Gives the md5 hash of a file, like ``md5_file``, but records it next to
+    the file so it is only computed again once the file has changed. The file
+    is considered unchanged as long as its path, size, modification time and
+    inode are, which saves hashing large disk images on every run.
+
+    The record is best effort: if it can't be written, for instance on a
+    read-only file system, the md5 is simply computed every time.
+
+    :filename: The file in which the md5 is to be calculated.
+    """
+    key = _file_key(filename)
+    md5 = _cached_md5(filename, key)
+    if md5 is not None:
+        return md5
+
+    md5 = md5_file(filename)
+    # The file may have changed while it was hashed, in which case the md5 is
+    # returned but not recorded.
+    if _file_key(filename) == key:
+        cache = md5_cache_path(filename)
+        tmp = Path(f"{cache}.{os.getpid()}.tmp")
+        try:
+            with open(tmp, "w") as f:
+                json.dump({"key": key, "md5": md5}, f)
+            os.replace(tmp, cache)
+        except OSError:
+            try:
+                tmp.unlink()
+            except OSError:
+                pass
+    return md5
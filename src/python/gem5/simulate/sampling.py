@@ -0,0 +1,252 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+SMARTS-style systematic sampling.
+
+A SMARTS sampler splits the simulation into periods of a fixed number of
+instructions. Each period starts with functional warming on the starting
+(atomic) cores of a ``SimpleSwitchableProcessor``, which keeps the caches
+warm at a fraction of the cost of detailed simulation. The last part of each
+period is simulated on the switched-to (detailed) cores: a detailed warmup
+window that fills the pipeline and trains the branch predictors, followed by
+a measurement window. The chosen stats are read from the detailed cores at
+the end of every measurement window and the mean of each is reported with a
+confidence interval.
+
+Example use:
+
+.. code-block:: python
+
+    processor = SimpleSwitchableProcessor(
+        starting_core_type=CPUTypes.ATOMIC,
+        switch_core_type=CPUTypes.O3,
+        isa=ISA.X86,
+        num_cores=1,
+    )
+    ...
+    sampler = SmartsSampler(
+        processor=processor,
+        period=10_000_000,
+        detailed_warmup=20_000,
+        measurement=10_000,
+    )
+    simulator = Simulator(board=board, sampler=sampler)
+    simulator.run()
+    ipc = sampler.get_estimates()["ipc"]
+    print(f"IPC: {ipc.mean} +/- {ipc.half_width}")
+"""
+
+import math
+from dataclasses import dataclass
+from statistics import (
+    NormalDist,
+    mean,
+    stdev,
+)
+from typing import (
+    Dict,
+    Generator,
+    List,
+    Optional,
+)
+
+import m5.stats
+
+from ..components.processors.simple_switchable_processor import (
+    SimpleSwitchableProcessor,
+)
+
+
+@dataclass
+class SampleEstimate:
+    """The estimate of one stat from a set of measurement windows."""
+
+    # The mean of the stat over the measurement windows.
+    mean: float
+    # The sample standard deviation of the stat.
+    stdev: float
+    # The number of measurement windows.
+    samples: int
+    # The confidence level of the interval, e.g., 0.997.
+    confidence: float
+    # The half width of the confidence interval around the mean.
+    half_width: float
+
+    @property
+    def relative_error(self) -> float:
+        """The half width of the confidence interval relative to the mean."""
+        return self.half_width / abs(self.mean) if self.mean else math.inf
+
+
+def estimate(samples: List[float], confidence: float) -> SampleEstimate:
+    """
+    Estimates the mean of a stat and its confidence interval from its value
+    in each measurement window, assuming the sample mean is normally
+    distributed.
+
+    :param samples: The value of the stat in each measurement window.
+    :param confidence: The confidence level, in (0, 1).
+    """
+    if not 0 < confidence < 1:
+        raise ValueError("The confidence level must be in (0, 1).")
+    if not samples:
+        raise ValueError("Cannot estimate a stat without samples.")
+
+    n = len(samples)
+    sample_mean = mean(samples)
+    sample_stdev = stdev(samples) if n > 1 else math.inf
+    z = NormalDist().inv_cdf((1 + confidence) / 2)
+    return SampleEstimate(
+        mean=sample_mean,
+        stdev=sample_stdev,
+        samples=n,
+        confidence=confidence,
+        half_width=z * sample_stdev / math.sqrt(n),
+    )
+
+
+class SmartsSampler:
+    """
+    Alternates functional warming, detailed warmup and measurement windows
+    at a fixed instruction interval. It is driven by ``MAX_INSTS`` exit
+    events and is installed by passing it to the ``Simulator`` as
+    ``sampler``.
+    """
+
+    def __init__(
+        self,
+        processor: SimpleSwitchableProcessor,
+        period: int,
+        detailed_warmup: int,
+        measurement: int,
+        stats: List[str] = ["ipc"],
+        confidence: float = 0.997,
+        max_samples: Optional[int] = None,
+    ) -> None:
+        """
+        :param processor: The processor to sample. Its starting cores are
+                          used for functional warming and its switched-to
+                          cores for the detailed windows. Only single core
+                          processors are supported.
+        :param period: The number of instructions in each sampling period.
+        :param detailed_warmup: The number of instructions simulated in
+                                detail before each measurement window.
+        :param measurement: The number of instructions in each measurement
+                            window.
+        :param stats: The stats to sample, relative to the detailed core
+                      (e.g., ``ipc`` or ``numCycles``). They must be
+                      scalars, vectors or formulas.
+        :param confidence: The confidence level of the reported intervals.
+        :param max_samples: If set, exit the simulation loop after this many
+                            measurement windows.
+        """
+        if not isinstance(processor, SimpleSwitchableProcessor):
+            raise Exception(
+                "SMARTS sampling requires a SimpleSwitchableProcessor."
+            )
+        if processor.get_num_cores() != 1:
+            raise Exception("SMARTS sampling only supports a single core.")
+        if measurement <= 0 or detailed_warmup < 0:
+            raise Exception(
+                "The measurement window must be positive and the detailed "
+                "warmup must not be negative."
+            )
+        if period <= detailed_warmup + measurement:
+            raise Exception(
+                "The sampling period must be longer than the detailed "
+                "warmup and measurement windows combined."
+            )
+        if not 0 < confidence < 1:
+            raise Exception("The confidence level must be in (0, 1).")
+
+        self._processor = processor
+        self._period = period
+        self._detailed_warmup = detailed_warmup
+        self._measurement = measurement
+        self._confidence = confidence
+        self._max_samples = max_samples
+        self._samples = {name: [] for name in stats}
+
+    def start(self, simulator: "Simulator") -> Generator[bool, None, None]:
+        """
+        Schedules the first functional warming window on ``simulator`` and
+        returns the ``MAX_INSTS`` exit event generator driving the sampling.
+        This is called by the ``Simulator`` when the sampler is passed to it.
+        """
+        functional = self._period - self._detailed_warmup - self._measurement
+        simulator.schedule_max_insts(functional)
+        return self._generator(simulator, functional)
+
+    def _generator(
+        self, simulator: "Simulator", functional: int
+    ) -> Generator[bool, None, None]:
+        while True:
+            # End of functional warming.
+            self._processor.switch()
+            if self._detailed_warmup:
+                simulator.schedule_max_insts(self._detailed_warmup)
+                yield False
+
+            # End of the detailed warmup.
+            m5.stats.reset()
+            simulator.schedule_max_insts(self._measurement)
+            yield False
+
+            # End of the measurement window.
+            self._record()
+            self._processor.switch()
+            if self._max_samples and self.get_num_samples() >= (
+                self._max_samples
+            ):
+                # No further windows are scheduled.
+                while True:
+                    yield True
+            simulator.schedule_max_insts(functional)
+            yield False
+
+    def _record(self) -> None:
+        core = self._processor.get_cores()[0].get_simobject()
+        for name, samples in self._samples.items():
+            samples.append(core.resolveStat(name).total)
+
+    def get_num_samples(self) -> int:
+        """Returns the number of measurement windows completed so far."""
+        return len(next(iter(self._samples.values()), []))
+
+    def get_samples(self) -> Dict[str, List[float]]:
+        """Returns the value of each stat in each measurement window."""
+        return self._samples
+
+    def get_estimates(self) -> Dict[str, SampleEstimate]:
+        """
+        Returns the mean and confidence interval of each stat over the
+        measurement windows completed so far.
+        """
+        return {
+            name: estimate(samples, self._confidence)
+            for name, samples in self._samples.items()
+        }
@@ -28,9 +28,11 @@ import os
 import sys
 from pathlib import Path
 from typing import (
+    Any,
     Callable,
     Dict,
     Generator,
+    Iterable,
     List,
     Optional,
     Tuple,
@@ -55,6 +57,7 @@ from .exit_event_generators import (
     switch_generator,
     warn_default_decorator,
 )
+from .sampling import SmartsSampler
 
 
 class Simulator:
@@ -104,6 +107,7 @@ class Simulator:
         ] = None,
         expected_execution_order: Optional[List[ExitEvent]] = None,
         checkpoint_path: Optional[Path] = None,
+        sampler: Optional[SmartsSampler] = None,
     ) -> None:
         """
         :param board: The board to be simulated.
@@ -138,6 +142,9 @@ class Simulator:
                                 the path is ``None``. **This parameter is deprecated.
                                 Please set the checkpoint when setting the board's
                                 workload**.
+        :param sampler: An optional SMARTS sampler. When set, it drives the
+                        simulation through ``MAX_INSTS`` exit events, which
+                        therefore cannot be handled by ``on_exit_event``.
 
         ``on_exit_event`` usage notes
         ---------------------------
@@ -359,6 +366,14 @@ class Simulator:
 
         self._checkpoint_path = checkpoint_path
 
+        if sampler:
+            if on_exit_event and ExitEvent.MAX_INSTS in on_exit_event:
+                raise Exception(
+                    "A sampler cannot be used with a `MAX_INSTS` "
+                    "`on_exit_event`."
+                )
+            self._on_exit_event[ExitEvent.MAX_INSTS] = sampler.start(self)
+
     def schedule_simpoint(self, simpoint_start_insts: List[int]) -> None:
         """
         Schedule ``SIMPOINT_BEGIN`` exit events
@@ -648,3 +663,98 @@ class Simulator:
                                will be saved.
         """
         m5.checkpoint(str(checkpoint_dir))
+
+    def fork(self, simout: Optional[str] = None) -> int:
+        """
+        Fork the simulation in its current state, instantiating the board
+        first if needed. The child continues with its outputs in a new
+        directory, and shares the memory of the parent copy-on-write.
+
+        Forking needs the listeners to be disabled (see
+        ``m5.disableAllListeners()``), and the memories not to use a
+        shared backing store, which the processes would write to together.
+
+        :param simout: The output directory of the child. See ``m5.fork()``
+                       for the formatting, the default being the parent's
+                       directory with a ``.fN`` suffix.
+
+        :returns: The PID of the child in the parent, 0 in the child.
+        """
+        self._instantiate()
+        if simout is None:
+            return m5.fork()
+        return m5.fork(simout)
+
+    def sweep(
+        self,
+        points: Iterable[Any],
+        configure: Callable[[Any], None],
+        max_ticks: int = m5.MaxTick,
+        max_processes: Optional[int] = None,
+        simout: str = "%(parent)s.p%(index)d",
+    ) -> List[int]:
+        """
+        Run a sweep from the current state of the simulation, for instance
+        once the workload has been restored and warmed up, rather than
+        setting up and warming up each point of the sweep again.
+
+        For each point the simulation is forked (see ``fork()``). The child
+        calls ``configure`` with the point, which may change anything that
+        can be changed with the simulation already running, such as the
+        inputs of the workload or runtime knobs of the models, then runs
+        the simulation and exits when ``run()`` returns. The parent waits
+        for all the children and returns their exit codes.
+
+        .. code-block::
+
+            simulator.run()  # Until the end of the warmup
+            codes = simulator.sweep(
+                seeds, lambda seed: set_workload_seed(board, seed)
+            )
+
+        :param points: The points of the sweep.
+        :param configure: Called in each child with its point.
+        :param max_ticks: The ``max_ticks`` each child runs with.
+        :param max_processes: The number of children to run at most at the
+                              same time. The default is the number of host
+                              CPUs.
+        :param simout: The output directory of each child. The formatting
+                       dictionary has ``parent``, the output directory of
+                       the parent, and ``index``, the index of the point.
+
+        :returns: The exit codes of the children, in the order of the points.
+                  A child killed by a signal gets the negated signal number.
+        """
+        if max_processes is None:
+            max_processes = os.cpu_count() or 1
+        if max_processes < 1:
+            raise ValueError("max_processes must be at least 1")
+
+        codes = []
+        running = {}
+
+        def wait_child() -> None:
+            pid, status = os.wait()
+            if os.WIFSIGNALED(status):
+                codes[running.pop(pid)] = -os.WTERMSIG(status)
+            else:
+                codes[running.pop(pid)] = os.WEXITSTATUS(status)
+
+        for index, point in enumerate(points):
+            while len(running) >= max_processes:
+                wait_child()
+
+            outdir = simout % {"parent": m5.options.outdir, "index": index}
+            pid = self.fork(outdir.replace("%", "%%"))
+            if pid == 0:
+                configure(point)
+                self.run(max_ticks)
+                sys.exit(0)
+
+            codes.append(None)
+            running[pid] = index
+
+        while running:
+            wait_child()
+
+        return codes
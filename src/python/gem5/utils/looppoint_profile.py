@@ -0,0 +1,284 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+LoopPoint region selection for multithreaded workloads.
+
+Profiling runs the whole workload once, usually with atomic CPUs, with a
+``LooppointProfiler`` fed by every core. The profiler divides the execution
+into regions which end at loop entries and records the basic block vector
+(BBV) of each region, with the blocks of each thread counted separately.
+The regions are then clustered here like SimPoint does, by projecting the
+BBVs to a few random dimensions and running k-means for a range of k. The
+region closest to the center of each cluster represents it, and is
+simulated with a multiplier accounting for the instructions of the whole
+cluster. The result is a ``Looppoint`` which can be written out as the JSON
+file read by ``LooppointJsonLoader``.
+
+Example use:
+
+.. code-block:: python
+
+    # Profiling run
+    profiler = add_looppoint_profiler(board.get_processor(), 100_000_000)
+    simulator.run()
+
+    # Afterwards, e.g. in the checkpointing run
+    looppoint = select_looppoint_regions(
+        read_looppoint_profile("m5out/looppoint.profile"), warmup_regions=1
+    )
+    looppoint.output_json_file(filepath="looppoint.json")
+"""
+
+import math
+import random
+from dataclasses import (
+    dataclass,
+    field,
+)
+from pathlib import Path
+from typing import (
+    Dict,
+    List,
+    Sequence,
+    Union,
+)
+
+from m5.objects import LooppointProfiler
+from m5.params import PcCountPair
+
+from ..resources.looppoint import (
+    Looppoint,
+    LooppointRegion,
+    LooppointRegionPC,
+    LooppointRegionWarmup,
+    LooppointSimulation,
+)
+
+
+@dataclass
+class ProfiledRegion:
+    """A region found by a ``LooppointProfiler``."""
+
+    rid: int
+    start_pc: int
+    start_count: int
+    end_pc: int
+    end_count: int
+    insts: int
+    # The instructions retired in each block, by block ID
+    bbv: Dict[int, int] = field(default_factory=dict)
+
+
+def add_looppoint_profiler(
+    processor: "AbstractProcessor",
+    region_length: int,
+    profile_file: str = "looppoint.profile",
+) -> LooppointProfiler:
+    """
+    Profiles LoopPoint regions on all the cores of a processor.
+
+    :param processor: The processor running the workload.
+    :param region_length: The minimum number of instructions retired by all
+                          the cores in a region.
+    :param profile_file: The profile file, in the output directory.
+    """
+    profiler = LooppointProfiler(
+        region_length=region_length, profile_file=profile_file
+    )
+    processor.looppoint_profiler = profiler
+    for core in processor.get_cores():
+        core.add_looppoint_profiler_probe(profiler)
+    return profiler
+
+
+def read_looppoint_profile(path: Union[str, Path]) -> List[ProfiledRegion]:
+    """
+    Reads the regions written by a ``LooppointProfiler``.
+
+    :param path: The profile file.
+    """
+    regions = []
+    with open(path) as f:
+        for line in f:
+            words = line.split()
+            if not words:
+                continue
+            if words[0] == "region":
+                rid, start_pc, start_count, end_pc, end_count, insts = (
+                    int(word, 0) for word in words[1:7]
+                )
+                regions.append(
+                    ProfiledRegion(
+                        rid, start_pc, start_count, end_pc, end_count, insts
+                    )
+                )
+            elif words[0] == "bbv" and regions:
+                for entry in words[1:]:
+                    _, block, count = entry.split(":")
+                    regions[-1].bbv[int(block)] = int(count)
+    return regions
+
+
+def _project(
+    regions: Sequence[ProfiledRegion], dims: int, seed: int
+) -> List[List[float]]:
+    """Normalize the BBVs and project them to dims random dimensions."""
+    rng = random.Random(seed)
+    projection = {}
+    points = []
+    for region in regions:
+        point = [0.0] * dims
+        total = sum(region.bbv.values()) or 1
+        for block in sorted(region.bbv):
+            if block not in projection:
+                projection[block] = [rng.uniform(-1, 1) for _ in range(dims)]
+            weight = region.bbv[block] / total
+            for d, value in enumerate(projection[block]):
+                point[d] += weight * value
+        points.append(point)
+    return points
+
+
+def _distance(a: Sequence[float], b: Sequence[float]) -> float:
+    return sum((x - y) ** 2 for x, y in zip(a, b))
+
+
+def _kmeans(points, k, rng, iterations=100):
+    """Returns the cluster of each point and the cluster centers."""
+    # Choose the initial centers furthest first from a random point.
+    centers = [list(rng.choice(points))]
+    while len(centers) < k:
+        furthest = max(
+            points, key=lambda p: min(_distance(p, c) for c in centers)
+        )
+        centers.append(list(furthest))
+
+    labels = [0] * len(points)
+    for iteration in range(iterations):
+        new_labels = [
+            min(range(k), key=lambda c: _distance(p, centers[c]))
+            for p in points
+        ]
+        if iteration > 0 and new_labels == labels:
+            break
+        labels = new_labels
+        for c in range(k):
+            members = [p for p, label in zip(points, labels) if label == c]
+            if members:
+                centers[c] = [sum(x) / len(members) for x in zip(*members)]
+    return labels, centers
+
+
+def _bic(points, labels, centers) -> float:
+    """The Bayesian Information Criterion of a clustering, as in X-means."""
+    num, dims, k = len(points), len(points[0]), len(centers)
+    if num <= k:
+        return -math.inf
+    distances = [
+        _distance(p, centers[label]) for p, label in zip(points, labels)
+    ]
+    # The variance of each dimension, shared by all the clusters
+    variance = max(sum(distances) / ((num - k) * dims), 1e-300)
+    likelihood = -sum(distances) / (2 * variance)
+    for c in range(k):
+        size = labels.count(c)
+        if size == 0:
+            continue
+        likelihood += size * math.log(size / num) - size * dims / 2 * math.log(
+            2 * math.pi * variance
+        )
+    params = k * (dims + 1)
+    return likelihood - params / 2 * math.log(num)
+
+
+def select_looppoint_regions(
+    regions: Sequence[ProfiledRegion],
+    max_k: int = 20,
+    dims: int = 15,
+    bic_threshold: float = 0.9,
+    warmup_regions: int = 1,
+    seed: int = 1,
+) -> Looppoint:
+    """
+    Clusters profiled regions and returns the representative ones.
+
+    :param regions: The regions read by ``read_looppoint_profile``.
+    :param max_k: The maximum number of clusters.
+    :param dims: The number of dimensions to project the BBVs to.
+    :param bic_threshold: The smallest k whose BIC score is at least this
+                          fraction of the way from the worst to the best
+                          score is chosen, as SimPoint does.
+    :param warmup_regions: The number of regions before a representative
+                           one to warm up with, if there are that many.
+    :param seed: The seed of the projection and of the clustering.
+    """
+    if not regions:
+        raise ValueError("No regions to select from")
+
+    points = _project(regions, dims, seed)
+    max_k = min(max_k, len(points))
+    clusterings = []
+    for k in range(1, max_k + 1):
+        labels, centers = _kmeans(points, k, random.Random(seed + k))
+        clusterings.append((labels, centers, _bic(points, labels, centers)))
+
+    scores = [bic for _, _, bic in clusterings if bic != -math.inf]
+    labels, centers, _ = clusterings[0]
+    if scores:
+        low, high = min(scores), max(scores)
+        for candidate in clusterings:
+            if candidate[2] >= low + bic_threshold * (high - low):
+                labels, centers, _ = candidate
+                break
+
+    selected = {}
+    for c, center in enumerate(centers):
+        members = [i for i, label in enumerate(labels) if label == c]
+        if not members:
+            continue
+        rep = min(members, key=lambda i: _distance(points[i], center))
+        region = regions[rep]
+        insts = sum(regions[i].insts for i in members)
+
+        simulation = LooppointSimulation(
+            start=LooppointRegionPC(region.start_pc, region.start_count),
+            end=LooppointRegionPC(region.end_pc, region.end_count),
+        )
+        warmup = None
+        if warmup_regions and rep >= warmup_regions:
+            first = regions[rep - warmup_regions]
+            warmup = LooppointRegionWarmup(
+                start=PcCountPair(first.start_pc, first.start_count),
+                end=PcCountPair(region.start_pc, region.start_count),
+            )
+        selected[region.rid] = LooppointRegion(
+            simulation=simulation,
+            multiplier=insts / max(region.insts, 1),
+            warmup=warmup,
+        )
+
+    return Looppoint(regions=dict(sorted(selected.items())))
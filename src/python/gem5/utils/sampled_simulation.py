@@ -0,0 +1,485 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+A driver for sampled simulation with SimPoints or LoopPoints.
+
+Sampled simulation runs in two phases. First, a single fast-forwarding
+simulation (e.g., with a KVM or atomic CPU) takes a checkpoint at the start
+of every region of interest. Then, every region is restored and simulated in
+detail in its own gem5 process. The per-region statistics are finally merged
+with the region weights into one estimate for the whole workload.
+
+``SampledSimulation`` drives both phases on top of
+``gem5.utils.multiprocessing``. Each gem5 process writes to its own output
+directory under ``m5.options.outdir``: the checkpointing run uses
+``checkpoints/`` and each detailed run uses the name of its region.
+
+Example use:
+
+run.py:
+
+.. code-block:: python
+
+    from gem5.resources.resource import SimpointResource
+    from gem5.utils.sampled_simulation import SampledSimulation
+    from boards import checkpoint_board, detailed_board
+
+    if __name__ == "__m5_main__":
+        simpoint = SimpointResource(
+            simpoint_interval=1000000,
+            simpoint_list=[2, 3, 4, 15],
+            weight_list=[0.1, 0.2, 0.4, 0.3],
+            warmup_interval=1000000,
+        )
+        sampled = SampledSimulation.from_simpoint(
+            simpoint=simpoint,
+            checkpoint_dir="simpoint-checkpoints",
+            checkpoint_board_function=checkpoint_board,
+            detailed_board_function=detailed_board,
+            max_processes=8,
+        )
+        stats = sampled.run()
+        print(stats["board.processor.cores.core.ipc"])
+
+As with ``gem5.utils.multiprocessing``, the board functions are pickled and
+must therefore be importable from a module other than the run script
+(``boards.py`` above). ``checkpoint_board()`` takes no arguments and returns
+a board with the SimPoint or LoopPoint workload set. ``detailed_board(region)``
+takes a ``SampledRegion`` and returns a board restoring from
+``region.checkpoint``.
+"""
+
+import os
+from dataclasses import dataclass
+from multiprocessing.connection import wait
+from pathlib import Path
+from typing import (
+    Callable,
+    Dict,
+    Iterable,
+    List,
+    Optional,
+    Tuple,
+    Union,
+)
+
+from .multiprocessing import Process
+
+
+@dataclass
+class SampledRegion:
+    """A single region of interest of a sampled simulation."""
+
+    # The name of the region. It names the checkpoint and the output directory
+    # of the detailed run, e.g., "SimPoint0" or "Region1".
+    name: str
+    # The checkpoint taken at the start of the region (including its warmup).
+    checkpoint: Path
+    # The weight (SimPoint) or multiplier (LoopPoint) of the region.
+    weight: float
+    # The number of instructions to warm up for before collecting stats.
+    warmup_insts: int = 0
+    # The number of instructions to collect stats for. When 0, the end of the
+    # warmup and of the region are signalled by ``SIMPOINT_BEGIN`` exit
+    # events, as is the case for LoopPoint regions.
+    detail_insts: int = 0
+
+
+def simpoint_regions(
+    simpoint: "SimpointResource", checkpoint_dir: Union[str, Path]
+) -> List[SampledRegion]:
+    """
+    Returns the regions of a SimPoint. The checkpoint names match those taken
+    by ``simpoints_save_checkpoint_generator``.
+
+    :param simpoint: The SimPoint to take the regions from.
+    :param checkpoint_dir: The directory holding the checkpoints.
+    """
+    checkpoint_dir = Path(checkpoint_dir).absolute()
+    return [
+        SampledRegion(
+            name=f"SimPoint{i}",
+            checkpoint=checkpoint_dir / f"cpt.SimPoint{i}",
+            weight=weight,
+            warmup_insts=warmup,
+            detail_insts=simpoint.get_simpoint_interval(),
+        )
+        for i, (weight, warmup) in enumerate(
+            zip(simpoint.get_weight_list(), simpoint.get_warmup_list())
+        )
+    ]
+
+
+def looppoint_regions(
+    looppoint: "Looppoint", checkpoint_dir: Union[str, Path]
+) -> List[SampledRegion]:
+    """
+    Returns the regions of a LoopPoint, weighted by their multipliers. The
+    checkpoint names match those taken by
+    ``looppoint_save_checkpoint_generator``.
+
+    :param looppoint: The LoopPoint to take the regions from.
+    :param checkpoint_dir: The directory holding the checkpoints.
+    """
+    checkpoint_dir = Path(checkpoint_dir).absolute()
+    return [
+        SampledRegion(
+            name=f"Region{rid}",
+            checkpoint=checkpoint_dir / f"cpt.Region{rid}",
+            weight=region.get_multiplier(),
+        )
+        for rid, region in looppoint.get_regions().items()
+    ]
+
+
+def parse_stats_txt(path: Union[str, Path]) -> List[Dict[str, float]]:
+    """
+    Parses a text stats file into one dictionary per stats dump. Each
+    dictionary maps the stat names to the first value on their line, so a
+    distribution bucket maps to its sample count. Values that are not numbers
+    are skipped.
+
+    :param path: The path of the stats file.
+    """
+    dumps = []
+    current = None
+    with open(path) as f:
+        for line in f:
+            if line.startswith("---------- Begin Simulation Statistics"):
+                current = {}
+            elif line.startswith("---------- End Simulation Statistics"):
+                dumps.append(current)
+                current = None
+            elif current is not None:
+                fields = line.split()
+                if len(fields) < 2:
+                    continue
+                try:
+                    current[fields[0]] = float(fields[1])
+                except ValueError:
+                    pass
+    return dumps
+
+
+def merge_weighted_stats(
+    region_stats: Iterable[Tuple[float, Dict[str, float]]],
+    normalize: bool = True,
+) -> Dict[str, float]:
+    """
+    Merges the stats of several regions into the weighted sum of each stat.
+
+    With ``normalize``, the sum of each stat is divided by the total weight
+    of the regions reporting it, giving the weighted mean. This is the usual
+    estimate for SimPoints. Without it, the weighted sum is returned as is,
+    which extrapolates LoopPoint regions by their multipliers.
+
+    :param region_stats: A ``(weight, stats)`` pair for each region.
+    :param normalize: Whether to divide by the total weight.
+    """
+    sums = {}
+    weights = {}
+    for weight, stats in region_stats:
+        for name, value in stats.items():
+            sums[name] = sums.get(name, 0.0) + weight * value
+            weights[name] = weights.get(name, 0.0) + weight
+
+    if not normalize:
+        return sums
+    return {
+        name: value / weights[name] if weights[name] else 0.0
+        for name, value in sums.items()
+    }
+
+
+def _take_checkpoints(
+    board_function: Callable[[], "AbstractBoard"],
+    source: str,
+    checkpoint_dir: Path,
+) -> None:
+    """The target of the checkpointing process."""
+    from ..simulate.exit_event import ExitEvent
+    from ..simulate.exit_event_generators import (
+        looppoint_save_checkpoint_generator,
+        simpoints_save_checkpoint_generator,
+    )
+    from ..simulate.simulator import Simulator
+
+    board = board_function()
+    checkpoint_dir.mkdir(parents=True, exist_ok=True)
+    if source == "simpoint":
+        generator = simpoints_save_checkpoint_generator(
+            checkpoint_dir, board.get_simpoint()
+        )
+    else:
+        generator = looppoint_save_checkpoint_generator(
+            checkpoint_dir, board.get_looppoint()
+        )
+
+    simulator = Simulator(
+        board=board, on_exit_event={ExitEvent.SIMPOINT_BEGIN: generator}
+    )
+    simulator.run()
+
+    if source == "looppoint":
+        # The relative counts are needed to restore the regions.
+        board.get_looppoint().output_json_file(
+            filepath=(checkpoint_dir / "looppoint.json").as_posix()
+        )
+
+
+def _run_region(
+    board_function: Callable[[SampledRegion], "AbstractBoard"],
+    region: SampledRegion,
+) -> None:
+    """The target of a detailed simulation process."""
+    from m5.stats import (
+        dump,
+        reset,
+    )
+
+    from ..simulate.exit_event import ExitEvent
+    from ..simulate.simulator import Simulator
+
+    board = board_function(region)
+
+    if region.detail_insts:
+
+        def end_of_interval():
+            if region.warmup_insts:
+                reset()
+                simulator.schedule_max_insts(region.detail_insts)
+                yield False
+            dump()
+            yield True
+
+        exit_event = ExitEvent.MAX_INSTS
+    else:
+
+        def end_of_interval():
+            if len(board.get_looppoint().get_targets()) > 1:
+                reset()
+                yield False
+            dump()
+            yield True
+
+        exit_event = ExitEvent.SIMPOINT_BEGIN
+
+    simulator = Simulator(
+        board=board, on_exit_event={exit_event: end_of_interval()}
+    )
+    if region.detail_insts:
+        simulator.schedule_max_insts(
+            region.warmup_insts or region.detail_insts
+        )
+    simulator.run()
+
+
+def _stats_file_path(outdir: Path) -> Path:
+    from m5 import options
+
+    stats_file = options.stats_file
+    if "://" in stats_file:
+        scheme, stats_file = stats_file.split("://", 1)
+        if scheme != "text":
+            raise Exception(
+                f"Sampled simulation needs text stats, got '{scheme}'."
+            )
+        stats_file = stats_file.split("?", 1)[0]
+    return outdir / stats_file
+
+
+class SampledSimulation:
+    """
+    Takes the checkpoints of a set of regions, simulates every region in
+    detail in parallel and merges their weighted stats.
+    """
+
+    def __init__(
+        self,
+        regions: List[SampledRegion],
+        source: str,
+        checkpoint_board_function: Optional[Callable[[], "AbstractBoard"]],
+        detailed_board_function: Callable[[SampledRegion], "AbstractBoard"],
+        max_processes: Optional[int] = None,
+        normalize: bool = True,
+    ):
+        """
+        :param regions: The regions to simulate in detail.
+        :param source: ``"simpoint"`` or ``"looppoint"``, which selects the
+                       exit event generator used to take the checkpoints.
+        :param checkpoint_board_function: Returns the board to take the
+                                          checkpoints with. If ``None``, the
+                                          checkpoints must already exist.
+        :param detailed_board_function: Returns the board to simulate a
+                                        region with.
+        :param max_processes: The maximum number of detailed simulations to
+                              run at once. Defaults to the number of host
+                              CPUs.
+        :param normalize: Whether ``run()`` returns the weighted mean rather
+                          than the weighted sum of the region stats.
+        """
+        if source not in ("simpoint", "looppoint"):
+            raise Exception(f"Unknown sampled simulation source '{source}'.")
+        if not regions:
+            raise Exception("A sampled simulation needs at least one region.")
+        self._regions = regions
+        self._source = source
+        self._checkpoint_board_function = checkpoint_board_function
+        self._detailed_board_function = detailed_board_function
+        self._max_processes = max_processes or os.cpu_count() or 1
+        self._normalize = normalize
+        self._region_stats = {}
+
+    @classmethod
+    def from_simpoint(
+        cls,
+        simpoint: "SimpointResource",
+        checkpoint_dir: Union[str, Path],
+        **kwargs,
+    ) -> "SampledSimulation":
+        """Creates a sampled simulation of the regions of a SimPoint."""
+        return cls(
+            regions=simpoint_regions(simpoint, checkpoint_dir),
+            source="simpoint",
+            **kwargs,
+        )
+
+    @classmethod
+    def from_looppoint(
+        cls,
+        looppoint: "Looppoint",
+        checkpoint_dir: Union[str, Path],
+        **kwargs,
+    ) -> "SampledSimulation":
+        """
+        Creates a sampled simulation of the regions of a LoopPoint. The stats
+        are extrapolated by the region multipliers rather than averaged.
+        """
+        kwargs.setdefault("normalize", False)
+        return cls(
+            regions=looppoint_regions(looppoint, checkpoint_dir),
+            source="looppoint",
+            **kwargs,
+        )
+
+    def get_regions(self) -> List[SampledRegion]:
+        """Returns the regions of this sampled simulation."""
+        return self._regions
+
+    def get_region_stats(self) -> Dict[str, Dict[str, float]]:
+        """Returns the stats of each region simulated by ``run()``."""
+        return self._region_stats
+
+    def take_checkpoints(self) -> None:
+        """
+        Takes the checkpoints of all the regions in one gem5 process, unless
+        they all exist already.
+        """
+        if all(region.checkpoint.exists() for region in self._regions):
+            return
+        if self._checkpoint_board_function is None:
+            raise Exception(
+                "Checkpoints are missing and no checkpoint board function "
+                "was given to take them."
+            )
+
+        checkpoint_dir = self._regions[0].checkpoint.parent
+        process = Process(
+            target=_take_checkpoints,
+            args=(
+                self._checkpoint_board_function,
+                self._source,
+                checkpoint_dir,
+            ),
+            name="checkpoints",
+        )
+        process.start()
+        process.join()
+        missing = [r.name for r in self._regions if not r.checkpoint.exists()]
+        if process.exitcode != 0 or missing:
+            raise Exception(
+                f"Taking the checkpoints failed (exit code "
+                f"{process.exitcode}), missing: {', '.join(missing)}."
+            )
+
+    def run_regions(self) -> None:
+        """
+        Simulates all the regions in detail, running at most
+        ``max_processes`` gem5 processes at once.
+        """
+        pending = list(self._regions)
+        running = {}
+        failed = []
+        while pending or running:
+            while pending and len(running) < self._max_processes:
+                region = pending.pop(0)
+                process = Process(
+                    target=_run_region,
+                    args=(self._detailed_board_function, region),
+                    name=region.name,
+                )
+                process.start()
+                running[process.sentinel] = (process, region)
+
+            for sentinel in wait(list(running)):
+                process, region = running.pop(sentinel)
+                process.join()
+                if process.exitcode != 0:
+                    failed.append(region.name)
+
+        if failed:
+            raise Exception(
+                f"Detailed simulation failed for: {', '.join(failed)}."
+            )
+
+    def run(self) -> Dict[str, float]:
+        """
+        Takes the checkpoints, simulates every region and returns the merged
+        weighted stats.
+        """
+        from m5 import options
+
+        self.take_checkpoints()
+        self.run_regions()
+
+        self._region_stats = {}
+        for region in self._regions:
+            dumps = parse_stats_txt(
+                _stats_file_path(Path(options.outdir) / region.name)
+            )
+            if not dumps:
+                raise Exception(f"No stats were dumped for {region.name}.")
+            # Later dumps come from the stats dump at exit.
+            self._region_stats[region.name] = dumps[0]
+
+        return merge_weighted_stats(
+            (
+                (region.weight, self._region_stats[region.name])
+                for region in self._regions
+            ),
+            normalize=self._normalize,
+        )
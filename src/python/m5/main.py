@@ -233,6 +233,14 @@ def parse_options():
         callback=_stats_help,
         help="Display documentation for available stat visitors",
     )
+    option(
+        "--stats-filter",
+        metavar="PATTERN",
+        action="append",
+        default=[],
+        help="Only dump the stats whose full name matches the glob PATTERN, "
+        "e.g. 'system.cpu*.ipc'. May be given multiple times",
+    )
 
     # Configuration Options
     group("Configuration Options")
@@ -301,6 +309,22 @@ def parse_options():
         help="Sets the output file for debug. Append '.gz' to the name for it"
         " to be compressed automatically [Default: %default]",
     )
+    option(
+        "--debug-binary",
+        action="store_true",
+        default=False,
+        help="Write debug output to --debug-file in a compact binary format"
+        " that is much faster to produce. Decode it with"
+        " util/decode_debug_trace.py",
+    )
+    option(
+        "--debug-flight-recorder",
+        metavar="SIZE",
+        default=None,
+        help="Keep the last SIZE bytes (e.g. 16MiB) of binary debug output"
+        " per thread in memory. They are written to --debug-file (default:"
+        " flight_recorder.bin) when gem5 exits, panics or receives SIGHUP",
+    )
     option(
         "--debug-activate",
         metavar="EXPR[,EXPR]",
@@ -393,6 +417,7 @@ def main():
         trace,
     )
     from .util import (
+        fatal,
         inform,
         isInteractive,
         panic,
@@ -558,6 +583,8 @@ def main():
 
     # set stats options
     stats.addStatVisitor(options.stats_file)
+    for pattern in options.stats_filter:
+        stats.addStatFilter(pattern)
 
     # Disable listeners unless running interactively or explicitly
     # enabled
@@ -610,7 +637,21 @@ def main():
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_flight_recorder:
+        from .util.convert import toMemorySize
+
+        debug_file = options.debug_file
+        if debug_file in ("cout", "cerr"):
+            debug_file = "flight_recorder.bin"
+        trace.outputFlightRecorder(
+            debug_file, toMemorySize(options.debug_flight_recorder)
+        )
+    elif options.debug_binary:
+        if options.debug_file in ("cout", "cerr"):
+            fatal("--debug-binary needs a --debug-file")
+        trace.outputBinary(options.debug_file)
+    else:
+        trace.output(options.debug_file)
 
     for activate in options.debug_activate:
         _check_tracing()
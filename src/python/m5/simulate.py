@@ -73,12 +73,14 @@ MaxTick = 2**64 - 1
 _drain_manager = _m5.drain.DrainManager.instance()
 
 _instantiated = False  # Has m5.instantiate() been called?
+_objects = []  # All the SimObjects in the hierarchy after instantiate()
 
 
 # The final call to instantiate the SimObject graph and initialize the
 # system.
 def instantiate(ckpt_dir=None):
     global _instantiated
+    global _objects
     from m5 import options
 
     if _instantiated:
@@ -99,14 +101,18 @@ def instantiate(ckpt_dir=None):
     for obj in root.descendants():
         obj.adoptOrphanParams()
 
+    # The hierarchy is complete now, so walk it once and reuse the list of
+    # objects for all the passes below
+    _objects = objs = list(root.descendants())
+
     # Unproxy in sorted order for determinism
-    for obj in root.descendants():
+    for obj in objs:
         obj.unproxyParams()
 
     if options.dump_config:
         ini_file = open(os.path.join(options.outdir, options.dump_config), "w")
         # Print ini sections in sorted order for easier diffing
-        for obj in sorted(root.descendants(), key=lambda o: o.path()):
+        for obj in sorted(objs, key=lambda o: o.path()):
             obj.print_ini(ini_file)
         ini_file.close()
 
@@ -131,13 +137,13 @@ def instantiate(ckpt_dir=None):
     stats.initSimStats()
 
     # Create the C++ sim objects and connect ports
-    for obj in root.descendants():
+    for obj in objs:
         obj.createCCObject()
-    for obj in root.descendants():
+    for obj in objs:
         obj.connectPorts()
 
     # Do a second pass to finish initializing the sim objects
-    for obj in root.descendants():
+    for obj in objs:
         obj.init()
 
     # Do a third pass to initialize statistics
@@ -145,11 +151,11 @@ def instantiate(ckpt_dir=None):
     root.regStats()
 
     # Do a fourth pass to initialize probe points
-    for obj in root.descendants():
+    for obj in objs:
         obj.regProbePoints()
 
     # Do a fifth pass to connect probe listeners
-    for obj in root.descendants():
+    for obj in objs:
         obj.regProbeListeners()
 
     # We want to generate the DVFS diagram for the system. This can only be
@@ -165,10 +171,10 @@ def instantiate(ckpt_dir=None):
     if ckpt_dir:
         _drain_manager.preCheckpointRestore()
         ckpt = _m5.core.getCheckpoint(ckpt_dir)
-        for obj in root.descendants():
+        for obj in objs:
             obj.loadState(ckpt)
     else:
-        for obj in root.descendants():
+        for obj in objs:
             obj.initState()
 
     # Check to see if any of the stat events are in the past after resuming from
@@ -189,8 +195,7 @@ def simulate(*args, **kwargs):
         fatal("m5.instantiate() must be called before m5.simulate().")
 
     if need_startup:
-        root = objects.Root.getInstance()
-        for obj in root.descendants():
+        for obj in _objects:
             obj.startup()
         need_startup = False
 
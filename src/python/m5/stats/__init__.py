@@ -190,16 +190,58 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
 
+@_url_factory(["columnar"])
+def _columnarFactory(fn, desc=True, formulas=True, delta=False):
+    """Output stats in a binary, column-oriented format.
+
+    Columnar stat files are meant for frequent periodic dumps. The
+    names, units and descriptions of all stat values are written once,
+    to a JSON schema file named after the stat file with a .json
+    suffix. Every dump then only appends the tick and the raw values,
+    which makes dumping cheap and keeps the files small. The files can
+    be loaded, or memory-mapped, with util/columnar_stats.py.
+
+    Known limitations:
+      * Sparse histograms are unsupported.
+      * The set of stats must not change between dumps.
+
+    Parameters:
+      * desc (bool): Output stat units and descriptions (default: True)
+      * formulas (bool): Output derived stats (default: True)
+      * delta (bool): Only store the values that changed since the
+        previous dump instead of all of them (default: False)
+
+    Example:
+      columnar://stats.bin?delta=True
+
+    """
+
+    return _m5.stats.initColumnar(fn, desc, formulas, delta)
+
+
 @_url_factory(["json"])
-def _jsonFactory(fn):
+def _jsonFactory(fn, indent=4):
     """Output stats in JSON format.
 
+    The JSON is written out while the stats are visited, and has the
+    same layout as the one written by m5.ext.pystats, so it can be
+    loaded with m5.ext.pystats.jsonloader. Each dump replaces the
+    contents of the file.
+
+    Known limitations:
+      * Formulas, 2d vectors, vector distributions and sparse
+        histograms are not written.
+
+    Parameters:
+      * indent (int): Number of spaces to indent nested members by
+        (default: 4)
+
     Example:
-      json://stats.json
+      json://stats.json?indent=2
 
     """
 
-    return JsonOutputVistor(fn)
+    return _m5.stats.initJson(fn, indent)
 
 
 def addStatVisitor(url):
@@ -307,6 +349,37 @@ names = []
 stats_dict = {}
 stats_list = []
 
+# Regular expressions matching the full names of the stats to keep. All the
+# stats are kept when there are none.
+_stat_filters = []
+
+
+def _glob_to_regex(pattern):
+    regex = ""
+    for c in pattern:
+        if c == "*":
+            regex += ".*"
+        elif c == "?":
+            regex += "."
+        elif c.isalnum() or c == "_":
+            regex += c
+        else:
+            regex += "\\" + c
+    return regex
+
+
+def addStatFilter(pattern, regex=False):
+    """Only keep the stats whose full name (e.g. system.cpu.ipc) matches
+    one of the filters added. The pattern is a glob, where '*' matches any
+    string and '?' any character, unless regex is True, in which case it is
+    an ECMAScript regular expression matching the whole name.
+
+    Filtered stats are still updated and reset, but they are neither
+    prepared nor dumped. Legacy stats, which don't belong to any stat group,
+    are not filtered. Filters must be added before m5.instantiate()."""
+
+    _stat_filters.append(pattern if regex else _glob_to_regex(pattern))
+
 
 def enable():
     """Enable the statistics package.  Before the statistics package is
@@ -338,6 +411,10 @@ def enable():
         stat.enable()
 
     # New stats
+    if _stat_filters:
+        Root.getInstance().filterStats(
+            "|".join(f"(?:{f})" for f in _stat_filters)
+        )
     _visit_stats(check_stat)
     _visit_stats(lambda g, s: s.enable())
 
@@ -353,30 +430,24 @@ def prepare():
         stat.prepare()
 
     # New stats
-    _visit_stats(lambda g, s: s.prepare())
+    sim_root = Root.getInstance()
+    if sim_root:
+        sim_root.prepareStats()
 
 
 def _dump_to_visitor(visitor, roots=None):
-    # New stats
-    def dump_group(group):
-        for stat in group.getStats():
-            stat.visit(visitor)
-        for n, g in group.getStatGroups().items():
-            visitor.beginGroup(n)
-            dump_group(g)
-            visitor.endGroup()
-
+    # New stats, the stat groups are traversed in C++.
     if roots:
         # New stats from selected subroots.
         for root in roots:
             for p in root.path_list():
                 visitor.beginGroup(p)
-            dump_group(root)
+            root.visitStats(visitor)
             for p in reversed(root.path_list()):
                 visitor.endGroup()
     else:
         # New stats starting from root.
-        dump_group(Root.getInstance())
+        Root.getInstance().visitStats(visitor)
 
         # Legacy stats
         for stat in stats_list:
@@ -429,6 +500,14 @@ def dump(roots=None):
                 _dump_to_visitor(output, roots=all_roots)
                 output.end()
 
+    # Everything that has been dumped is now up to date in all
+    # outputs, which lets later dumps skip the stats that don't change.
+    if all_roots:
+        for root in all_roots:
+            root.cleanStats()
+    else:
+        Root.getInstance().cleanStats()
+
 
 def reset():
     """Reset all statistics to the base state"""
@@ -31,4 +31,6 @@ from _m5.trace import (
     enable,
     ignore,
     output,
+    outputBinary,
+    outputFlightRecorder,
 )
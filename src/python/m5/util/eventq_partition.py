@@ -0,0 +1,355 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Automatic assignment of SimObjects to event queues.
+
+Multi-threaded simulation needs every SimObject to be placed on one of
+the main event queues (``eventq_index``) and a ThreadBridge wherever a
+memory port crosses from one queue to another. ``partition()`` does this
+for a configuration that has been built but not instantiated yet:
+
+1. The object tree is split into *units*. A unit is an object that owns
+   connected ports, together with all of its descendants, which stay on
+   the unit's queue. Containers (Root, System, SubSystem and objects
+   without ports of their own) are not units, their children are
+   visited instead. Containers with ports, such as a System and its
+   system_port, are kept on queue 0.
+2. Ports between units become the edges of a graph. Connections that
+   cannot be bridged are contracted so that both ends share a queue.
+3. The units are assigned to queues so that the estimated cost per queue
+   is balanced and as few edges as possible cross queues. Costs come
+   from a profiling run (see ``costs_from_stats()``) and default to one
+   per unit.
+4. A ThreadBridge is spliced into every crossing memory connection,
+   unless the requestor migrates between queues on its own (KVM CPUs).
+
+ThreadBridge only forwards atomic and functional accesses, so bridged
+partitions are only valid for simulations that do not use timing mode.
+As for any multi-queue simulation, ``Root.sim_quantum`` must be set.
+"""
+
+import re
+
+import m5
+from m5.params import (
+    PortRef,
+    VectorPortRef,
+    isNullPointer,
+)
+from m5.SimObject import (
+    isRoot,
+    isSimObjectVector,
+)
+from m5.util import (
+    fatal,
+    inform,
+)
+
+
+def _children(obj):
+    for child in obj._children.values():
+        if isNullPointer(child):
+            continue
+        if isSimObjectVector(child):
+            for elem in child:
+                if not isNullPointer(elem):
+                    yield elem
+        else:
+            yield child
+
+
+def _connected_ports(obj):
+    for ref in obj._port_refs.values():
+        if isinstance(ref, VectorPortRef):
+            for elem in ref.elements:
+                if isinstance(elem.peer, PortRef):
+                    yield elem
+        elif isinstance(ref.peer, PortRef):
+            yield ref
+
+
+def _is_container(obj):
+    if isRoot(obj):
+        return True
+    for name in ("System", "SubSystem"):
+        cls = getattr(m5.objects, name, None)
+        if cls is not None and isinstance(obj, cls):
+            return True
+    return next(_connected_ports(obj), None) is None
+
+
+def _is_memory_link(req, resp):
+    return req.role == "GEM5 REQUESTOR" and resp.role == "GEM5 RESPONDER"
+
+
+def _migrates_itself(req, resp):
+    kvm = getattr(m5.objects, "BaseKvmCPU", None)
+    return kvm is not None and isinstance(req.simobj, kvm)
+
+
+class _UnionFind:
+    def __init__(self):
+        self.parent = {}
+
+    def find(self, x):
+        root = x
+        while self.parent.get(root, root) != root:
+            root = self.parent[root]
+        while x != root:
+            self.parent[x], x = root, self.parent.get(x, x)
+        return root
+
+    def union(self, a, b):
+        a, b = self.find(a), self.find(b)
+        if a != b:
+            # Keep the smallest name as representative to stay deterministic
+            if b < a:
+                a, b = b, a
+            self.parent[b] = a
+
+
+def assign_event_queues(costs, edges, num_queues, pinned=None, passes=4):
+    """
+    Assign graph nodes to event queues.
+
+    :param costs: Dictionary mapping every node to its estimated cost.
+    :param edges: Dictionary mapping (node, node) pairs to the weight of
+        the traffic between them.
+    :param num_queues: Number of event queues to distribute nodes over.
+    :param pinned: Optional dictionary mapping nodes to a fixed queue.
+    :param passes: Number of refinement passes.
+
+    :returns: A dictionary mapping each node to a queue index.
+
+    Nodes are first placed greedily, heaviest first, on the queue they
+    have most traffic with among those that still have room. Refinement
+    passes then move single nodes if that reduces the traffic crossing
+    queues without overloading their new queue.
+    """
+    if num_queues < 1:
+        fatal("Cannot partition a system onto %d event queues", num_queues)
+    pinned = dict(pinned or {})
+
+    adj = {node: {} for node in costs}
+    for (a, b), weight in edges.items():
+        if a == b:
+            continue
+        adj[a][b] = adj[a].get(b, 0) + weight
+        adj[b][a] = adj[b].get(a, 0) + weight
+
+    # Allow queues to be slightly unbalanced to keep clusters together
+    total = sum(costs.values())
+    limit = max(1.1 * total / num_queues, max(costs.values(), default=0))
+
+    queue = {}
+    load = [0.0] * num_queues
+    for node, q in pinned.items():
+        queue[node] = q
+        load[q] += costs[node]
+
+    def affinity(node, q):
+        return sum(w for peer, w in adj[node].items() if queue.get(peer) == q)
+
+    order = sorted(
+        (n for n in costs if n not in pinned), key=lambda n: (-costs[n], n)
+    )
+    for node in order:
+        fits = [q for q in range(num_queues) if load[q] + costs[node] <= limit]
+        if fits:
+            best = max(fits, key=lambda q: (affinity(node, q), -load[q], -q))
+        else:
+            best = min(range(num_queues), key=lambda q: (load[q], q))
+        queue[node] = best
+        load[best] += costs[node]
+
+    for _ in range(passes):
+        moved = False
+        for node in sorted(n for n in costs if n not in pinned):
+            cur = queue[node]
+            gains = {
+                q: affinity(node, q) - affinity(node, cur)
+                for q in range(num_queues)
+                if q != cur and load[q] + costs[node] <= limit
+            }
+            if not gains:
+                continue
+            best = max(gains, key=lambda q: (gains[q], -load[q], -q))
+            # Also accept neutral moves that improve the balance
+            if gains[best] > 0 or (
+                gains[best] == 0 and load[best] + costs[node] < load[cur]
+            ):
+                load[cur] -= costs[node]
+                load[best] += costs[node]
+                queue[node] = best
+                moved = True
+        if not moved:
+            break
+
+    return queue
+
+
+def costs_from_stats(stats_file, stat="numCycles"):
+    """
+    Estimate the cost of SimObjects from the stats.txt of a profiling run.
+
+    :param stats_file: Path to a stats.txt file.
+    :param stat: Name of the per-object statistic to use as cost.
+
+    :returns: A dictionary mapping SimObject paths to the value of the
+        statistic in the last dump of the file.
+    """
+    costs = {}
+    pattern = re.compile(r"^(\S+)\.%s\s+(\S+)" % re.escape(stat))
+    with open(stats_file) as f:
+        for line in f:
+            if line.startswith("---------- Begin"):
+                costs = {}
+                continue
+            match = pattern.match(line)
+            if match:
+                try:
+                    costs[match.group(1)] = float(match.group(2))
+                except ValueError:
+                    pass
+    return costs
+
+
+def partition(
+    root,
+    num_queues,
+    costs=None,
+    can_bridge=_is_memory_link,
+    needs_bridge=lambda req, resp: not _migrates_itself(req, resp),
+):
+    """
+    Place the SimObjects below root on num_queues event queues.
+
+    Must be called before m5.instantiate().
+
+    :param root: The root of the object tree to partition.
+    :param num_queues: Number of main event queues to use.
+    :param costs: Optional dictionary mapping SimObject paths to their
+        estimated cost, e.g., from costs_from_stats(). Every unit costs
+        the sum of the costs of its objects, or one if none are listed.
+    :param can_bridge: Predicate on a (requestor, responder) pair of
+        port references that tells if they may end up on different
+        queues. By default only memory ports may be split.
+    :param needs_bridge: Predicate on a (requestor, responder) pair that
+        tells if a ThreadBridge has to be inserted when they are split.
+
+    :returns: A dictionary mapping the path of every unit to its queue.
+    """
+    costs = costs or {}
+
+    # Map every object to the node of the partition graph it belongs to.
+    owner = {}
+    nodes = {}
+    pinned = set()
+
+    def visit(obj, unit):
+        if unit is None and _is_container(obj):
+            owner[obj] = obj
+            if next(_connected_ports(obj), None) is not None:
+                nodes[obj.path()] = obj
+                pinned.add(obj.path())
+        else:
+            unit = unit or obj
+            owner[obj] = unit
+            nodes[unit.path()] = unit
+        for child in _children(obj):
+            visit(child, unit)
+
+    visit(root, None)
+
+    unit_cost = {}
+    for obj, node in owner.items():
+        if node.path() in nodes:
+            name = node.path()
+            unit_cost.setdefault(name, 0.0)
+            unit_cost[name] += costs.get(obj.path(), 0.0)
+    for name in unit_cost:
+        unit_cost[name] = unit_cost[name] or 1.0
+
+    # Collect the connections between nodes, seen from the requestor.
+    links = []
+    for obj, node in owner.items():
+        if node.path() not in nodes:
+            continue
+        for port in _connected_ports(obj):
+            peer = port.peer
+            if peer.simobj not in owner or not port.is_source:
+                continue
+            peer_node = owner[peer.simobj].path()
+            if peer_node != node.path() and peer_node in nodes:
+                links.append((port, peer, node.path(), peer_node))
+
+    # Contract connections that must not cross queues.
+    groups = _UnionFind()
+    for req, resp, a, b in links:
+        if not can_bridge(req, resp):
+            groups.union(a, b)
+
+    group_cost = {}
+    for name, cost in unit_cost.items():
+        group = groups.find(name)
+        group_cost[group] = group_cost.get(group, 0.0) + cost
+
+    group_edges = {}
+    for req, resp, a, b in links:
+        key = tuple(sorted((groups.find(a), groups.find(b))))
+        if key[0] != key[1]:
+            group_edges[key] = group_edges.get(key, 0) + 1
+
+    group_pins = {groups.find(name): 0 for name in pinned}
+    group_queue = assign_event_queues(
+        group_cost, group_edges, num_queues, pinned=group_pins
+    )
+
+    queue = {name: group_queue[groups.find(name)] for name in nodes}
+    for name, q in queue.items():
+        if name not in pinned:
+            nodes[name].eventq_index = q
+
+    bridges = []
+    for req, resp, a, b in links:
+        if queue[a] == queue[b] or not needs_bridge(req, resp):
+            continue
+        bridge = m5.objects.ThreadBridge(eventq_index=queue[b])
+        req.splice(bridge.in_port, bridge.out_port)
+        bridges.append(bridge)
+
+    if bridges:
+        root.eventq_bridges = bridges
+
+    inform(
+        "Partitioned %d units onto %d event queues with %d thread bridges",
+        len(nodes),
+        num_queues,
+        len(bridges),
+    )
+
+    return queue
@@ -310,7 +310,10 @@ pybind_init_core(py::module_ &m_native)
         .def("disableAllListeners", &ListenSocket::disableAll)
         .def("listenersDisabled", &ListenSocket::allDisabled)
         .def("listenersLoopbackOnly", &ListenSocket::loopbackOnly)
-        .def("seedRandom", [](uint64_t seed) { random_mt.init(seed); })
+        .def("seedRandom", [](uint64_t seed) {
+            random_mt.init(seed);
+            RandomStream::setGlobalSeed(seed);
+        })
 
 
         .def("fixClockFrequency", &fixClockFrequency)
@@ -49,7 +49,9 @@
 #include "base/debug.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
+#include "sim/init_signals.hh"
 
 namespace py = pybind11;
 
@@ -67,6 +69,29 @@ output(const char *filename)
     trace::setDebugLogger(new trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+outputBinary(const char *filename)
+{
+    auto *logger = new trace::BinaryLogger(simout.resolve(filename));
+    trace::setDebugLogger(logger);
+
+    // The logger is never deleted, so make sure that the messages
+    // still in its buffers reach the file.
+    registerExitCallback([logger]() { logger->flush(); });
+}
+
+static void
+outputFlightRecorder(const char *filename, size_t size)
+{
+    auto *logger = new trace::BinaryLogger(simout.resolve(filename), size,
+                                           true);
+    trace::setDebugLogger(logger);
+
+    registerExitCallback([logger]() { logger->flush(); });
+    Logger::addExitHook([logger]() { logger->flush(); });
+    initSigHup();
+}
+
 static void
 activate(const char *expr)
 {
@@ -129,6 +154,8 @@ pybind_init_debug(py::module_ &m_native)
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("outputBinary", &outputBinary)
+        .def("outputFlightRecorder", &outputFlightRecorder)
         .def("activate", &activate)
         .def("ignore", &ignore)
         .def("enable", &trace::enable)
@@ -41,7 +41,11 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
+#include <regex>
+
 #include "base/statistics.hh"
+#include "base/stats/columnar.hh"
+#include "base/stats/json.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -114,6 +118,8 @@ pybind_init_stats(py::module_ &m_native)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
+        .def("initColumnar", &statistics::initColumnar)
+        .def("initJson", &statistics::initJson)
         .def("registerPythonStatsHandlers",
              &statistics::registerPythonStatsHandlers)
         .def("schedStatEvent", &statistics::schedStatEvent)
@@ -130,6 +136,7 @@ pybind_init_stats(py::module_ &m_native)
         .def("begin", &statistics::Output::begin)
         .def("end", &statistics::Output::end)
         .def("valid", &statistics::Output::valid)
+        .def("onlyChanged", &statistics::Output::onlyChanged)
         .def("beginGroup", &statistics::Output::beginGroup)
         .def("endGroup", &statistics::Output::endGroup)
         ;
@@ -221,6 +228,9 @@ pybind_init_stats(py::module_ &m_native)
         .def("regStats", &statistics::Group::regStats)
         .def("resetStats", &statistics::Group::resetStats)
         .def("preDumpStats", &statistics::Group::preDumpStats)
+        .def("prepareStats", &statistics::Group::prepareStats)
+        .def("visitStats", &statistics::Group::visitStats)
+        .def("cleanStats", &statistics::Group::cleanStats)
         .def("getStats", [](const statistics::Group &self)
              -> std::vector<py::object> {
 
@@ -234,6 +244,13 @@ pybind_init_stats(py::module_ &m_native)
             })
         .def("getStatGroups", &statistics::Group::getStatGroups)
         .def("addStatGroup", &statistics::Group::addStatGroup)
+        .def("filterStats", [](statistics::Group &self,
+                               const std::string &pattern) {
+                 const std::regex keep(pattern, std::regex::optimize);
+                 self.filterStats([&keep](const std::string &name) {
+                     return std::regex_match(name, keep);
+                 });
+             })
         .def("resolveStat", [](const statistics::Group &self,
                                const std::string &name) -> py::object {
                  const statistics::Info *stat = self.resolveStat(name);
@@ -31,6 +31,11 @@ from m5.SimObject import SimObject
 from m5.util import fatal
 
 
+class EventQueueBackend(ScopedEnum):
+    "Data structure used to keep the pending events of an event queue sorted."
+    vals = ["BinList", "Calendar"]
+
+
 class Root(SimObject):
     _the_instance = None
 
@@ -66,6 +71,47 @@ class Root(SimObject):
     # Simulation Quantum for multiple main event queue simulation.
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
+    # Skip quantum synchronizations when no event queue has anything to
+    # do before the next quantum ends. Requires that events scheduled on
+    # another queue are at least sim_quantum ticks away in the future.
+    sim_quantum_adaptive = Param.Bool(
+        False, "grow quanta while all event queues are idle"
+    )
+
+    # Backend of each main event queue, indexed by eventq_index. Queues
+    # without an entry use the last one.
+    eventq_backend = VectorParam.EventQueueBackend(
+        ["BinList"], "event queue backend, per main event queue"
+    )
+    eventq_calendar_bucket_width = Param.Tick(
+        1000, "ticks covered by one bucket of a calendar event queue"
+    )
+    eventq_calendar_buckets = Param.UInt64(
+        8192, "number of buckets in a calendar event queue"
+    )
+
+    # Profile the host time spent servicing each kind of event and write
+    # it as JSON to this file in the output directory at exit. Ignored by
+    # builds without tracing support (gem5.fast).
+    eventq_profile = Param.String(
+        "", "file to write the event service time profile to"
+    )
+
+    # Sample the host CPU time used by the simulator this many times per
+    # second and charge each sample to the SimObject whose event was being
+    # serviced, reported as a hostTime stat of every SimObject. Uses
+    # SIGPROF, so it can't be combined with other SIGPROF profilers. Ignored
+    # by builds without tracing support (gem5.fast).
+    host_profile_frequency = Param.Unsigned(
+        0, "host time samples per second, 0 to disable"
+    )
+
+    # Report the host memory accounted to each SimObject by the structures
+    # it owns as a hostMemoryAccounted stat of every SimObject. The largest
+    # accounts can also be written to stderr at any time with SIGVTALRM.
+    host_memory_stats = Param.Bool(
+        False, "report the accounted host memory of every SimObject"
+    )
 
     full_system = Param.Bool("if this is a full system simulation")
 
@@ -49,6 +49,14 @@ class MemoryMode(Enum):
     vals = ["invalid", "atomic", "timing", "atomic_noncaching"]
 
 
+class MemoryCheckpointFormat(ScopedEnum):
+    vals = ["gzip", "chunked", "raw"]
+
+
+class HugePageMode(ScopedEnum):
+    vals = ["none", "transparent", "hugetlb"]
+
+
 class System(SimObject):
     type = "System"
     cxx_header = "sim/system.hh"
@@ -79,6 +87,15 @@ class System(SimObject):
         False, "mmap the backing store without reserving swap"
     )
 
+    # Large memories take many host TLB entries to access. The backing
+    # store can either be advised to use transparent huge pages, or be
+    # allocated from the huge pages reserved on the host with
+    # MAP_HUGETLB, in which case the memory sizes must be multiples of
+    # 2 MiB and a shared backstore cannot be used.
+    mmap_huge_pages = Param.HugePageMode(
+        "none", "Use host huge pages for the backing store"
+    )
+
     # The memory ranges are to be populated when creating the system
     # such that these can be passed from the I/O subsystem through an
     # I/O bridge or cache
@@ -104,6 +121,33 @@ class System(SimObject):
         "shared_backstore is non-empty.",
     )
 
+    # The backing store images in a checkpoint are either a single gzip
+    # stream per store, a chunked image that is compressed, written
+    # and restored by several host threads, or an uncompressed raw
+    # image. Raw images are mapped copy-on-write straight from the
+    # checkpoint when restoring, so pages are only read when touched
+    # and are shared between simulations started from the same
+    # checkpoint. Restoring always accepts all formats.
+    memory_checkpoint_format = Param.MemoryCheckpointFormat(
+        "chunked", "Format of the memory images written to checkpoints"
+    )
+    checkpoint_threads = Param.Unsigned(
+        0,
+        "Number of host threads used to write and restore chunked "
+        "memory images, 0 to use all host threads",
+    )
+    # Incremental checkpoints only contain the pages of memory written
+    # since the previous checkpoint taken or restored by this
+    # simulation, and refer to the memory images of that checkpoint,
+    # which have to be kept. Pages written by KVM CPUs are tracked with
+    # the KVM dirty log. Memory written through a memory backdoor, e.g.
+    # by an atomic CPU, is always checkpointed in full.
+    incremental_checkpoints = Param.Bool(
+        False,
+        "Only write the pages of memory written since the previous "
+        "checkpoint",
+    )
+
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
     redirect_paths = VectorParam.RedirectPath([], "Path redirections")
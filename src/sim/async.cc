@@ -35,5 +35,7 @@ volatile bool async_statreset = false;
 volatile bool async_exit = false;
 volatile bool async_io = false;
 volatile bool async_exception = false;
+volatile bool async_tracedump = false;
+volatile bool async_hostmemdump = false;
 
 } // namespace gem5
@@ -47,6 +47,8 @@ extern volatile bool async_statreset;   ///< Async request to reset stats.
 extern volatile bool async_exit;        ///< Async request to exit simulator.
 extern volatile bool async_io;          ///< Async I/O request (SIGIO).
 extern volatile bool async_exception;   ///< Python exception.
+extern volatile bool async_tracedump;   ///< Async request to write the trace.
+extern volatile bool async_hostmemdump; ///< Async request to dump host memory.
 //@}
 
 } // namespace gem5
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/cxx_config_bin.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "base/inifile.hh"
+#include "base/str.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+const char cacheMagic[8] = "gem5cfg";
+const uint32_t cacheVersion = 1;
+
+void
+writeInt(std::ostream &os, uint64_t value)
+{
+    os.write((const char *)&value, sizeof(value));
+}
+
+void
+writeString(std::ostream &os, const std::string &str)
+{
+    writeInt(os, str.size());
+    os.write(str.data(), str.size());
+}
+
+/** Reads the fields of a cache held in memory, failing on overruns */
+class CacheReader
+{
+  private:
+    const std::string &buf;
+    size_t pos = 0;
+    bool failed = false;
+
+  public:
+    CacheReader(const std::string &buf_) : buf(buf_) {}
+
+    bool good() const { return !failed; }
+    bool done() const { return pos == buf.size(); }
+
+    bool
+    read(void *dest, size_t size)
+    {
+        if (failed || buf.size() - pos < size) {
+            failed = true;
+            return false;
+        }
+        std::memcpy(dest, buf.data() + pos, size);
+        pos += size;
+        return true;
+    }
+
+    uint64_t
+    readInt()
+    {
+        uint64_t value = 0;
+        read(&value, sizeof(value));
+        return value;
+    }
+
+    std::string
+    readString()
+    {
+        const uint64_t size = readInt();
+        if (failed || buf.size() - pos < size) {
+            failed = true;
+            return std::string();
+        }
+        std::string str(buf, pos, size);
+        pos += size;
+        return str;
+    }
+};
+
+} // anonymous namespace
+
+bool
+CxxBinaryConfigFile::isCache(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(cacheMagic)];
+    return file.read(magic, sizeof(magic)) &&
+        std::memcmp(magic, cacheMagic, sizeof(magic)) == 0;
+}
+
+const CxxBinaryConfigFile::Entry *
+CxxBinaryConfigFile::findEntry(const std::string &object_name,
+    const std::string &param_name) const
+{
+    auto object = objects.find(object_name);
+    if (object == objects.end())
+        return nullptr;
+
+    auto entry = object->second.find(param_name);
+    return entry == object->second.end() ? nullptr : &entry->second;
+}
+
+void
+CxxBinaryConfigFile::clear()
+{
+    objectNames.clear();
+    objects.clear();
+}
+
+bool
+CxxBinaryConfigFile::getParam(const std::string &object_name,
+    const std::string &param_name,
+    std::string &value) const
+{
+    const Entry *entry = findEntry(object_name, param_name);
+    if (entry)
+        value = entry->value;
+    return entry;
+}
+
+bool
+CxxBinaryConfigFile::getParamVector(const std::string &object_name,
+    const std::string &param_name,
+    std::vector<std::string> &values) const
+{
+    const Entry *entry = findEntry(object_name, param_name);
+    if (entry)
+        values.insert(values.end(), entry->values.begin(),
+            entry->values.end());
+    return entry;
+}
+
+bool
+CxxBinaryConfigFile::getPortPeers(const std::string &object_name,
+    const std::string &port_name,
+    std::vector<std::string> &peers) const
+{
+    return getParamVector(object_name, port_name, peers);
+}
+
+bool
+CxxBinaryConfigFile::objectExists(const std::string &object_name) const
+{
+    return objects.count(object_name);
+}
+
+void
+CxxBinaryConfigFile::getAllObjectNames(std::vector<std::string> &list) const
+{
+    list.insert(list.end(), objectNames.begin(), objectNames.end());
+}
+
+void
+CxxBinaryConfigFile::getObjectChildren(const std::string &object_name,
+    std::vector<std::string> &children, bool return_paths) const
+{
+    const size_t first = children.size();
+    if (!getParamVector(object_name, "children", children))
+        return;
+
+    if (return_paths && object_name != "root") {
+        for (auto i = children.begin() + first; i != children.end(); ++i)
+            *i = object_name + "." + *i;
+    }
+}
+
+bool
+CxxBinaryConfigFile::load(const std::string &filename)
+{
+    clear();
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+        return false;
+    const std::string buf((std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+
+    CacheReader reader(buf);
+    char magic[sizeof(cacheMagic)];
+    uint32_t version = 0;
+    if (!reader.read(magic, sizeof(magic)) ||
+            std::memcmp(magic, cacheMagic, sizeof(magic)) != 0 ||
+            !reader.read(&version, sizeof(version)) ||
+            version != cacheVersion) {
+        return false;
+    }
+
+    const uint64_t num_objects = reader.readInt();
+    for (uint64_t i = 0; i < num_objects && reader.good(); i++) {
+        objectNames.push_back(reader.readString());
+        Object &object = objects[objectNames.back()];
+
+        const uint64_t num_entries = reader.readInt();
+        for (uint64_t j = 0; j < num_entries && reader.good(); j++) {
+            Entry &entry = object[reader.readString()];
+            entry.value = reader.readString();
+            const uint64_t num_values = reader.readInt();
+            for (uint64_t k = 0; k < num_values && reader.good(); k++)
+                entry.values.push_back(reader.readString());
+        }
+    }
+
+    if (!reader.good() || !reader.done()) {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+bool
+CxxBinaryConfigFile::loadIni(const std::string &filename)
+{
+    clear();
+
+    IniFile ini_file;
+    if (!ini_file.load(filename))
+        return false;
+
+    ini_file.getSectionNames(objectNames);
+    std::sort(objectNames.begin(), objectNames.end());
+
+    for (const auto &object_name : objectNames) {
+        Object &object = objects[object_name];
+        ini_file.visitSection(object_name,
+            [&object](const std::string &key, const std::string &value)
+            {
+                Entry &entry = object[key];
+                entry.value = value;
+                tokenize(entry.values, value, ' ', true);
+            });
+    }
+    return true;
+}
+
+bool
+CxxBinaryConfigFile::save(const std::string &filename) const
+{
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+
+    file.write(cacheMagic, sizeof(cacheMagic));
+    file.write((const char *)&cacheVersion, sizeof(cacheVersion));
+
+    writeInt(file, objectNames.size());
+    for (const auto &object_name : objectNames) {
+        const Object &object = objects.at(object_name);
+        writeString(file, object_name);
+
+        // Sort the entries so that the same config gives the same file
+        std::vector<const Object::value_type *> entries;
+        for (const auto &entry : object)
+            entries.push_back(&entry);
+        std::sort(entries.begin(), entries.end(),
+            [](const Object::value_type *a, const Object::value_type *b)
+            { return a->first < b->first; });
+
+        writeInt(file, entries.size());
+        for (const auto *entry : entries) {
+            writeString(file, entry->first);
+            writeString(file, entry->second.value);
+            writeInt(file, entry->second.values.size());
+            for (const auto &value : entry->second.values)
+                writeString(file, value);
+        }
+    }
+
+    return bool(file);
+}
+
+} // namespace gem5
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *
+ *  Binary config cache for use with CxxConfigManager
+ */
+
+#ifndef __SIM_CXX_CONFIG_BIN_HH__
+#define __SIM_CXX_CONFIG_BIN_HH__
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sim/cxx_config.hh"
+
+namespace gem5
+{
+
+/**
+ * CxxConfigManager interface for binary config caches.
+ *
+ * A cache holds the same objects and parameters as the config.ini file it
+ * was converted from, but vector values are stored already split and the
+ * whole file is read with a handful of large reads, so a parameter sweep
+ * loading the same configuration many times doesn't parse the .ini text
+ * each time. Overrides are applied on top with CxxConfigManager::setParam
+ * as usual.
+ *
+ * The cache is written in host byte order and is only meant to be read
+ * back by the same build of gem5 on the same host.
+ */
+class CxxBinaryConfigFile : public CxxConfigFileBase
+{
+  protected:
+    struct Entry
+    {
+        std::string value;
+        /** value split at spaces, as CxxIniFile::getParamVector does */
+        std::vector<std::string> values;
+    };
+
+    typedef std::unordered_map<std::string, Entry> Object;
+
+    /** Object names sorted, to keep getAllObjectNames deterministic */
+    std::vector<std::string> objectNames;
+    std::unordered_map<std::string, Object> objects;
+
+    const Entry *findEntry(const std::string &object_name,
+        const std::string &param_name) const;
+
+    void clear();
+
+  public:
+    /** Does the named file start like a config cache? */
+    static bool isCache(const std::string &filename);
+
+    CxxBinaryConfigFile() { }
+
+    bool getParam(const std::string &object_name,
+        const std::string &param_name,
+        std::string &value) const;
+
+    bool getParamVector(const std::string &object_name,
+        const std::string &param_name,
+        std::vector<std::string> &values) const;
+
+    bool getPortPeers(const std::string &object_name,
+        const std::string &port_name,
+        std::vector<std::string> &peers) const;
+
+    bool objectExists(const std::string &object_name) const;
+
+    void getAllObjectNames(std::vector<std::string> &list) const;
+
+    void getObjectChildren(const std::string &object_name,
+        std::vector<std::string> &children,
+        bool return_paths = false) const;
+
+    /** Load a config cache written by save */
+    bool load(const std::string &filename);
+
+    /** Replace the contents with those of a config.ini file */
+    bool loadIni(const std::string &filename);
+
+    /** Write the contents out as a config cache */
+    bool save(const std::string &filename) const;
+};
+
+} // namespace gem5
+
+#endif // __SIM_CXX_CONFIG_BIN_HH__
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "sim/cxx_config_bin.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const char iniText[] =
+    "[root]\n"
+    "type=Root\n"
+    "children=system\n"
+    "eventq_index=0\n"
+    "\n"
+    "[system]\n"
+    "type=System\n"
+    "children=cpu0 cpu1\n"
+    "mem_ranges=0:536870911 1073741824:1610612735\n"
+    "system_port=system.membus.cpu_side_ports[0]\n"
+    "\n"
+    "[system.cpu0]\n"
+    "type=BaseCPU\n"
+    "clock=500\n"
+    "\n"
+    "[system.cpu1]\n"
+    "type=BaseCPU\n"
+    "clock=500\n";
+
+class CxxBinaryConfigFileTest : public ::testing::Test
+{
+  protected:
+    char iniName[20] = "config-XXXXXX";
+    char cacheName[20] = "cache-XXXXXX";
+
+    void
+    SetUp() override
+    {
+        for (char *name : {iniName, cacheName}) {
+            int fd = mkstemp(name);
+            ASSERT_NE(-1, fd);
+            close(fd);
+        }
+        std::ofstream(iniName) << iniText;
+    }
+
+    void
+    TearDown() override
+    {
+        unlink(iniName);
+        unlink(cacheName);
+    }
+
+    static void
+    checkContents(const CxxConfigFileBase &conf)
+    {
+        std::vector<std::string> names;
+        conf.getAllObjectNames(names);
+        EXPECT_EQ(std::vector<std::string>({"root", "system", "system.cpu0",
+                    "system.cpu1"}), names);
+
+        EXPECT_TRUE(conf.objectExists("system.cpu1"));
+        EXPECT_FALSE(conf.objectExists("system.cpu2"));
+
+        std::string value;
+        EXPECT_TRUE(conf.getParam("system.cpu0", "clock", value));
+        EXPECT_EQ("500", value);
+        EXPECT_FALSE(conf.getParam("system.cpu0", "voltage", value));
+        EXPECT_FALSE(conf.getParam("system.cpu2", "clock", value));
+
+        std::vector<std::string> values;
+        EXPECT_TRUE(conf.getParamVector("system", "mem_ranges", values));
+        EXPECT_EQ(std::vector<std::string>({"0:536870911",
+                    "1073741824:1610612735"}), values);
+
+        std::vector<std::string> peers;
+        EXPECT_TRUE(conf.getPortPeers("system", "system_port", peers));
+        EXPECT_EQ(std::vector<std::string>(
+                    {"system.membus.cpu_side_ports[0]"}), peers);
+
+        std::vector<std::string> children;
+        conf.getObjectChildren("root", children, true);
+        EXPECT_EQ(std::vector<std::string>({"system"}), children);
+        children.clear();
+        conf.getObjectChildren("system", children, true);
+        EXPECT_EQ(std::vector<std::string>({"system.cpu0", "system.cpu1"}),
+                children);
+        children.clear();
+        conf.getObjectChildren("system", children);
+        EXPECT_EQ(std::vector<std::string>({"cpu0", "cpu1"}), children);
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(CxxBinaryConfigFileTest, LoadIni)
+{
+    CxxBinaryConfigFile conf;
+    ASSERT_TRUE(conf.loadIni(iniName));
+    checkContents(conf);
+    EXPECT_FALSE(CxxBinaryConfigFile::isCache(iniName));
+}
+
+TEST_F(CxxBinaryConfigFileTest, SaveAndLoad)
+{
+    CxxBinaryConfigFile conf;
+    ASSERT_TRUE(conf.loadIni(iniName));
+    ASSERT_TRUE(conf.save(cacheName));
+    EXPECT_TRUE(CxxBinaryConfigFile::isCache(cacheName));
+
+    CxxBinaryConfigFile cache;
+    ASSERT_TRUE(cache.load(cacheName));
+    checkContents(cache);
+}
+
+TEST_F(CxxBinaryConfigFileTest, LoadIniAsCache)
+{
+    CxxBinaryConfigFile conf;
+    EXPECT_FALSE(conf.load(iniName));
+    EXPECT_FALSE(conf.objectExists("root"));
+}
+
+TEST_F(CxxBinaryConfigFileTest, LoadTruncatedCache)
+{
+    CxxBinaryConfigFile conf;
+    ASSERT_TRUE(conf.loadIni(iniName));
+    ASSERT_TRUE(conf.save(cacheName));
+
+    std::string contents;
+    {
+        std::ifstream file(cacheName, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>());
+    }
+    std::ofstream(cacheName, std::ios::binary | std::ios::trunc) <<
+        contents.substr(0, contents.size() - 1);
+
+    CxxBinaryConfigFile cache;
+    EXPECT_FALSE(cache.load(cacheName));
+    EXPECT_FALSE(cache.objectExists("root"));
+}
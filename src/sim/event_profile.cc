@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_profile.hh"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace event_profile
+{
+
+bool enabled = false;
+
+namespace
+{
+
+/** The profile collected by one simulation thread. */
+struct Tables
+{
+    std::unordered_map<std::string, Entry> descriptions;
+    std::unordered_map<std::string, Entry> names;
+};
+
+std::mutex tablesMutex;
+std::vector<std::unique_ptr<Tables>> allTables;
+
+/**
+ * Get the tables of the calling thread. They are owned by allTables so
+ * that they outlive the thread and can still be dumped at exit.
+ */
+Tables &
+localTables()
+{
+    static thread_local Tables *tables = nullptr;
+    if (!tables) {
+        std::lock_guard<std::mutex> lock(tablesMutex);
+        allTables.emplace_back(new Tables);
+        tables = allTables.back().get();
+    }
+    return *tables;
+}
+
+void
+merge(Entry &into, const Entry &from)
+{
+    into.count += from.count;
+    into.totalNs += from.totalNs;
+    for (int i = 0; i < NumBuckets; i++)
+        into.histogram[i] += from.histogram[i];
+}
+
+void
+writeString(std::ostream &os, const std::string &str)
+{
+    os << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\')
+            os << '\\' << c;
+        else if (c >= ' ')
+            os << c;
+    }
+    os << '"';
+}
+
+void
+writeEntries(std::ostream &os, const std::map<std::string, Entry> &entries)
+{
+    os << "{";
+    const char *sep = "\n";
+    for (const auto &[key, entry] : entries) {
+        os << sep << "    ";
+        writeString(os, key);
+        os << ": {\"count\": " << entry.count
+           << ", \"total_ns\": " << entry.totalNs
+           << ", \"histogram\": [";
+        for (int i = 0; i < NumBuckets; i++)
+            os << (i ? ", " : "") << entry.histogram[i];
+        os << "]}";
+        sep = ",\n";
+    }
+    os << "\n  }";
+}
+
+} // anonymous namespace
+
+void
+Entry::sample(uint64_t ns)
+{
+    count++;
+    totalNs += ns;
+    int bucket = ns < 2 ? 0 : floorLog2(ns);
+    histogram[bucket < NumBuckets ? bucket : NumBuckets - 1]++;
+}
+
+void
+enable()
+{
+    enabled = true;
+}
+
+void
+process(Event *event)
+{
+    // The event may be deleted by its own process() method, so look up
+    // everything that identifies it first.
+    const std::string name = event->name();
+    const char *description = event->description();
+
+    auto start = std::chrono::steady_clock::now();
+    event->process();
+    auto end = std::chrono::steady_clock::now();
+
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            end - start).count();
+
+    Tables &tables = localTables();
+    tables.descriptions[description].sample(ns);
+    tables.names[name].sample(ns);
+}
+
+void
+dump(std::ostream &os)
+{
+    std::map<std::string, Entry> descriptions;
+    std::map<std::string, Entry> names;
+
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    for (const auto &tables : allTables) {
+        for (const auto &[key, entry] : tables->descriptions)
+            merge(descriptions[key], entry);
+        for (const auto &[key, entry] : tables->names)
+            merge(names[key], entry);
+    }
+
+    os << "{\n  \"descriptions\": ";
+    writeEntries(os, descriptions);
+    os << ",\n  \"names\": ";
+    writeEntries(os, names);
+    os << "\n}\n";
+}
+
+void
+reset()
+{
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    for (auto &tables : allTables) {
+        tables->descriptions.clear();
+        tables->names.clear();
+    }
+}
+
+} // namespace event_profile
+} // namespace gem5
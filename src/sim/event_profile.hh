@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Host time profiling of the events serviced by the event queues.
+ */
+
+#ifndef __SIM_EVENT_PROFILE_HH__
+#define __SIM_EVENT_PROFILE_HH__
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+
+namespace gem5
+{
+
+class Event;
+
+namespace event_profile
+{
+
+/**
+ * Number of buckets of the host time histograms. Bucket 0 counts the
+ * events that took less than 2ns, and bucket i > 0 those that took
+ * [2^i, 2^(i+1)) nanoseconds. The last bucket also counts anything
+ * longer.
+ */
+constexpr int NumBuckets = 32;
+
+/** Statistics about the events that share a description or a name. */
+struct Entry
+{
+    uint64_t count = 0;
+    uint64_t totalNs = 0;
+    std::array<uint64_t, NumBuckets> histogram = {};
+
+    void sample(uint64_t ns);
+};
+
+/**
+ * Whether the event queues should profile the events they service.
+ * Only consulted by builds with TRACING_ON; other builds never profile.
+ */
+extern bool enabled;
+
+/** Start profiling the events serviced from now on. */
+void enable();
+
+/**
+ * Process an event and account the host time it took to both its
+ * description and its name. Called by EventQueue::serviceOne() instead
+ * of Event::process() while profiling is enabled.
+ */
+void process(Event *event);
+
+/**
+ * Write the profile of all simulation threads as a JSON object with
+ * one entry per event description and one per event name. This and
+ * reset() must only be called while no simulation thread is running.
+ */
+void dump(std::ostream &os);
+
+/** Drop the data collected so far. */
+void reset();
+
+} // namespace event_profile
+} // namespace gem5
+
+#endif // __SIM_EVENT_PROFILE_HH__
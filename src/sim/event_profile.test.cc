@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "sim/event_profile.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class NamedEvent : public Event
+{
+  public:
+    NamedEvent(const std::string &_name) : _name(_name) {}
+
+    void process() override { processed++; }
+    const std::string name() const override { return _name; }
+    const char *description() const override { return "NamedEvent"; }
+
+    int processed = 0;
+
+  private:
+    std::string _name;
+};
+
+} // anonymous namespace
+
+TEST(EventProfileTest, BucketsBySize)
+{
+    event_profile::Entry entry;
+    entry.sample(0);
+    entry.sample(1);
+    entry.sample(2);
+    entry.sample(3);
+    entry.sample(1000);
+    entry.sample(~0ULL);
+
+    EXPECT_EQ(entry.count, 6);
+    EXPECT_EQ(entry.histogram[0], 2);
+    EXPECT_EQ(entry.histogram[1], 2);
+    EXPECT_EQ(entry.histogram[9], 1);
+    EXPECT_EQ(entry.histogram[event_profile::NumBuckets - 1], 1);
+}
+
+TEST(EventProfileTest, ProfilesServicedEvents)
+{
+    EventQueue eq("eq");
+    NamedEvent a("obj.a");
+    NamedEvent b("obj.b");
+
+    event_profile::reset();
+    event_profile::enable();
+    eq.schedule(&a, 10);
+    eq.schedule(&b, 20);
+    while (!eq.empty())
+        eq.serviceOne();
+    eq.schedule(&a, 30);
+    eq.serviceOne();
+    event_profile::enabled = false;
+
+    EXPECT_EQ(a.processed, 2);
+    EXPECT_EQ(b.processed, 1);
+
+    std::ostringstream os;
+    event_profile::dump(os);
+    const std::string json = os.str();
+
+    EXPECT_NE(json.find("\"NamedEvent\": {\"count\": 3,"), std::string::npos);
+    EXPECT_NE(json.find("\"obj.a\": {\"count\": 2,"), std::string::npos);
+    EXPECT_NE(json.find("\"obj.b\": {\"count\": 1,"), std::string::npos);
+
+    event_profile::reset();
+    std::ostringstream empty;
+    event_profile::dump(empty);
+    EXPECT_EQ(empty.str().find("obj.a"), std::string::npos);
+}
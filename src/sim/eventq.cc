@@ -37,15 +37,20 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
+#include "sim/event_profile.hh"
+#include "sim/host_profile.hh"
 
 namespace gem5
 {
 
 Tick simQuantum = 0;
+bool adaptiveSimQuantum = false;
 
 //
 // Main Event Queues
@@ -58,18 +63,63 @@ std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+namespace
+{
+
+struct MainQueueBackend
+{
+    EventQueue::Backend backend;
+    Tick bucketWidth;
+    uint64_t numBuckets;
+
+    void
+    apply(EventQueue *eq) const
+    {
+        eq->setBackend(backend, bucketWidth, numBuckets);
+    }
+};
+
+//! Backends requested for main event queues, indexed by queue index.
+//! Queues past the end use the last entry.
+std::vector<MainQueueBackend> mainQueueBackends;
+
+} // anonymous namespace
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
     while (numMainEventQueues <= index) {
+        EventQueue *eq =
+            new EventQueue(csprintf("MainEventQueue-%d", index));
+        if (!mainQueueBackends.empty()) {
+            mainQueueBackends[std::min<size_t>(numMainEventQueues,
+                    mainQueueBackends.size() - 1)].apply(eq);
+        }
         numMainEventQueues++;
-        mainEventQueue.push_back(
-            new EventQueue(csprintf("MainEventQueue-%d", index)));
+        mainEventQueue.push_back(eq);
     }
 
     return mainEventQueue[index];
 }
 
+void
+setMainEventQueueBackend(uint32_t index, EventQueue::Backend backend,
+                         Tick bucket_width, uint64_t num_buckets)
+{
+    if (mainQueueBackends.size() <= index) {
+        mainQueueBackends.resize(index + 1, mainQueueBackends.empty() ?
+                MainQueueBackend{EventQueue::Backend::BinList, 1000, 8192} :
+                mainQueueBackends.back());
+    }
+    mainQueueBackends[index] = {backend, bucket_width, num_buckets};
+
+    bool is_last = index == mainQueueBackends.size() - 1;
+    for (uint32_t i = index; i < numMainEventQueues; i++) {
+        if (i == index || is_last)
+            mainQueueBackends[index].apply(mainEventQueue[i]);
+    }
+}
+
 #ifndef NDEBUG
 Counter Event::instanceCounter = 0;
 #endif
@@ -137,16 +187,35 @@ Event::releaseImpl()
 void
 EventQueue::insert(Event *event)
 {
-    // Deal with the head case
-    if (!head || *event <= *head) {
-        head = Event::insertBefore(event, head);
+    if (_backend == Backend::BinList) {
+        insertAfter(event, nullptr);
         return;
     }
 
+    insertAfter(event, calFindBinBefore(event));
+
+    // The event is now the top of either an existing bin or a new one
+    if (event->nextInBin)
+        calReplaceTop(event->nextInBin, event);
+    else
+        calAddBin(event);
+}
+
+void
+EventQueue::insertAfter(Event *event, Event *prev)
+{
+    if (!prev) {
+        // Deal with the head case
+        if (!head || *event <= *head) {
+            head = Event::insertBefore(event, head);
+            return;
+        }
+        prev = head;
+    }
+
     // Figure out either which 'in bin' list we are on, or where a new list
     // needs to be inserted
-    Event *prev = head;
-    Event *curr = head->nextBin;
+    Event *curr = prev->nextBin;
     while (curr && *curr < *event) {
         prev = curr;
         curr = curr->nextBin;
@@ -196,28 +265,46 @@ EventQueue::remove(Event *event)
 
     assert(event->queue == this);
 
-    // deal with an event on the head's 'in bin' list (event has the same
-    // time as the head)
-    if (*head == *event) {
+    if (_backend == Backend::BinList)
+        removeAfter(event, nullptr);
+    else
+        removeAfter(event, calFindBinBefore(event));
+}
+
+void
+EventQueue::removeAfter(Event *event, Event *prev)
+{
+    Event *curr;
+    if (!prev && *head == *event) {
+        // deal with an event on the head's 'in bin' list (event has the
+        // same time as the head)
+        curr = head;
         head = Event::removeItem(event, head);
-        return;
-    }
+    } else {
+        // Find the 'in bin' list that this event belongs on
+        if (!prev)
+            prev = head;
+        curr = prev->nextBin;
+        while (curr && *curr < *event) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
 
-    // Find the 'in bin' list that this event belongs on
-    Event *prev = head;
-    Event *curr = head->nextBin;
-    while (curr && *curr < *event) {
-        prev = curr;
-        curr = curr->nextBin;
-    }
+        if (!curr || *curr != *event)
+            panic("event not found!");
 
-    if (!curr || *curr != *event)
-        panic("event not found!");
+        // curr points to the top item of the the correct 'in bin' list,
+        // when we remove an item, it returns the new top item (which may
+        // be unchanged)
+        prev->nextBin = Event::removeItem(event, curr);
+    }
 
-    // curr points to the top item of the the correct 'in bin' list, when
-    // we remove an item, it returns the new top item (which may be
-    // unchanged)
-    prev->nextBin = Event::removeItem(event, curr);
+    if (_backend == Backend::Calendar && event == curr) {
+        if (curr->nextInBin)
+            calReplaceTop(curr, curr->nextInBin);
+        else
+            calRemoveBin(curr, prev);
+    }
 }
 
 Event *
@@ -240,13 +327,27 @@ EventQueue::serviceOne()
         head = head->nextBin;
     }
 
+    if (_backend == Backend::Calendar) {
+        if (next)
+            calReplaceTop(event, next);
+        else
+            calRemoveBin(event, nullptr);
+    }
+
     // handle action
     if (!event->squashed()) {
         // forward current cycle to the time when this event occurs.
         setCurTick(event->when());
         if (debug::Event)
             event->trace("executed");
-        event->process();
+#if TRACING_ON
+        if (host_profile::enabled)
+            host_profile::process(event);
+        else if (event_profile::enabled)
+            event_profile::process(event);
+        else
+#endif
+            event->process();
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -375,6 +476,37 @@ EventQueue::debugVerify() const
         nextBin = nextBin->nextBin;
     }
 
+    if (_backend == Backend::Calendar) {
+        uint64_t used = 0;
+        Event *prev = nullptr;
+        for (Event *bin = head; bin; prev = bin, bin = bin->nextBin) {
+            uint64_t bucket = calBucket(bin);
+            if (!calInWindow(bucket))
+                continue;
+
+            uint64_t idx = bucket & calMask;
+            const CalendarBucket &b = calBuckets[idx];
+            bool first = !prev || calBucket(prev) != bucket;
+            bool last = !bin->nextBin || calBucket(bin->nextBin) != bucket;
+            if (!(calInUse[idx / 64] & (1ULL << (idx % 64))) ||
+                (b.first == bin) != first || (b.last == bin) != last) {
+                cprintf("calendar out of sync!");
+                bin->dump();
+                return false;
+            }
+            if (first)
+                used++;
+        }
+
+        uint64_t in_use = 0;
+        for (auto word : calInUse)
+            in_use += popCount(word);
+        if (used != in_use) {
+            cprintf("calendar has stale buckets!");
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -383,9 +515,172 @@ EventQueue::replaceHead(Event* s)
 {
     Event* t = head;
     head = s;
+    if (_backend == Backend::Calendar)
+        calRebuild();
     return t;
 }
 
+void
+EventQueue::setBackend(Backend backend, Tick bucket_width,
+                       uint64_t num_buckets)
+{
+    _backend = backend;
+    if (backend == Backend::BinList) {
+        calBuckets.clear();
+        calInUse.clear();
+        return;
+    }
+
+    fatal_if(bucket_width == 0, "%s: calendar buckets must be at least "
+             "one tick wide.", name());
+    fatal_if(num_buckets == 0, "%s: calendar needs at least one bucket.",
+             name());
+
+    num_buckets = 1ULL << ceilLog2(num_buckets);
+    calBuckets.resize(num_buckets);
+    calInUse.resize(divCeil(num_buckets, 64));
+    calMask = num_buckets - 1;
+    calWidth = bucket_width;
+    calRebuild();
+}
+
+Event *
+EventQueue::calFindBinBefore(const Event *event)
+{
+    uint64_t bucket = calBucket(event);
+    if (!calInWindow(bucket)) {
+        // Events before the window sort before every indexed bin.
+        if (bucket < calBase)
+            return nullptr;
+
+        calAdvance();
+        // Far future events are found by walking the bins that
+        // follow the window.
+        if (!calInWindow(bucket))
+            return calLastBinBefore(calBase + calMask + 1);
+    }
+
+    uint64_t idx = bucket & calMask;
+    if (calInUse[idx / 64] & (1ULL << (idx % 64))) {
+        const CalendarBucket &b = calBuckets[idx];
+        if (*b.last < *event)
+            return b.last;
+        if (*b.first < *event)
+            return b.first;
+    }
+
+    return calLastBinBefore(bucket);
+}
+
+Event *
+EventQueue::calLastBinBefore(uint64_t bucket) const
+{
+    uint64_t remaining = bucket - calBase;
+    while (remaining) {
+        uint64_t idx = (bucket - 1) & calMask;
+        unsigned bit = idx % 64;
+        unsigned span = std::min<uint64_t>(bit + 1, remaining);
+
+        // Only look at the buckets [bucket - span, bucket)
+        uint64_t word = calInUse[idx / 64] & mask(bit + 1) &
+            ~mask(bit + 1 - span);
+        if (word)
+            return calBuckets[idx - bit + findMsbSet(word)].last;
+
+        bucket -= span;
+        remaining -= span;
+    }
+
+    return nullptr;
+}
+
+void
+EventQueue::calReplaceTop(Event *old_top, Event *new_top)
+{
+    uint64_t bucket = calBucket(old_top);
+    if (!calInWindow(bucket))
+        return;
+
+    CalendarBucket &b = calBuckets[bucket & calMask];
+    if (b.first == old_top)
+        b.first = new_top;
+    if (b.last == old_top)
+        b.last = new_top;
+}
+
+void
+EventQueue::calAddBin(Event *top)
+{
+    uint64_t bucket = calBucket(top);
+    if (!calInWindow(bucket))
+        return;
+
+    uint64_t idx = bucket & calMask;
+    CalendarBucket &b = calBuckets[idx];
+    uint64_t &word = calInUse[idx / 64];
+    if (!(word & (1ULL << (idx % 64)))) {
+        word |= 1ULL << (idx % 64);
+        b.first = b.last = top;
+    } else if (*top < *b.first) {
+        b.first = top;
+    } else if (*b.last < *top) {
+        b.last = top;
+    }
+}
+
+void
+EventQueue::calRemoveBin(Event *top, Event *prev)
+{
+    uint64_t bucket = calBucket(top);
+    if (!calInWindow(bucket))
+        return;
+
+    uint64_t idx = bucket & calMask;
+    CalendarBucket &b = calBuckets[idx];
+    if (b.first == top && b.last == top) {
+        calInUse[idx / 64] &= ~(1ULL << (idx % 64));
+        b.first = b.last = nullptr;
+    } else if (b.first == top) {
+        // The following bin is in the same bucket
+        b.first = top->nextBin;
+    } else if (b.last == top) {
+        // The preceding bin is in the same bucket
+        assert(prev);
+        b.last = prev;
+    }
+}
+
+void
+EventQueue::calAdvance()
+{
+    Tick now = head ? std::min(head->when(), getCurTick()) : getCurTick();
+    uint64_t base = now / calWidth;
+    if (base <= calBase)
+        return;
+
+    // Nothing is pending before 'now', so the buckets we leave behind
+    // are empty and can be reused for the new end of the window.
+    Event *last = calLastBinBefore(calBase + calMask + 1);
+    Event *bin = last ? last->nextBin : head;
+    calBase = base;
+    for (; bin && calInWindow(calBucket(bin)); bin = bin->nextBin)
+        calAddBin(bin);
+}
+
+void
+EventQueue::calRebuild()
+{
+    std::fill(calBuckets.begin(), calBuckets.end(), CalendarBucket());
+    std::fill(calInUse.begin(), calInUse.end(), 0);
+
+    Tick now = head ? std::min(head->when(), getCurTick()) : getCurTick();
+    calBase = now / calWidth;
+    for (Event *bin = head; bin && calInWindow(calBucket(bin));
+         bin = bin->nextBin) {
+        calAddBin(bin);
+    }
+}
+
 void
 dumpMainQueue()
 {
@@ -447,25 +742,90 @@ EventQueue::EventQueue(const std::string &n)
 }
 
 void
-EventQueue::asyncInsert(Event *event)
+EventQueue::asyncInsert(Event *first, Event *last)
+{
+    Event *top = async_queue.load(std::memory_order_relaxed);
+    do {
+        last->nextBin = top;
+    } while (!async_queue.compare_exchange_weak(top, first,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
+}
+
+Tick
+EventQueue::nextPendingTick()
 {
-    async_queue_mutex.lock();
-    async_queue.push_back(event);
-    async_queue_mutex.unlock();
+    Tick next = empty() ? MaxTick : nextTick();
+
+    // Producers only ever push new events on top of the stack, so the
+    // events below a snapshot of the top are stable until the owning
+    // thread drains the queue.
+    Event *event = async_queue.load(std::memory_order_acquire);
+    for (; event; event = event->nextBin)
+        next = std::min(next, event->when());
+
+    return next;
 }
 
 void
 EventQueue::handleAsyncInsertions()
 {
     assert(this == curEventQueue());
-    async_queue_mutex.lock();
 
-    while (!async_queue.empty()) {
-        insert(async_queue.front());
-        async_queue.pop_front();
+    if (!async_queue.load(std::memory_order_relaxed))
+        return;
+
+    Event *stack = async_queue.exchange(nullptr, std::memory_order_acquire);
+
+    // The stack holds the most recent event on top. Reverse it so that
+    // events are inserted in the order in which they were added.
+    Event *fifo = nullptr;
+    while (stack) {
+        Event *next = stack->nextBin;
+        stack->nextBin = fifo;
+        fifo = stack;
+        stack = next;
+    }
+
+    while (fifo) {
+        Event *next = fifo->nextBin;
+        insert(fifo);
+        fifo = next;
     }
+}
+
+void
+EventQueue::ScheduleBatch::schedule(Event *event, Tick when)
+{
+    if (!inParallelMode || eventq == curEventQueue()) {
+        eventq->schedule(event, when);
+        return;
+    }
+
+    assert(!event->scheduled());
+    assert(event->initialized());
+
+    event->setWhen(when, eventq);
+    event->flags.set(Event::Scheduled);
+    event->acquire();
+
+    if (debug::Event)
+        event->trace("scheduled");
+
+    event->nextBin = first;
+    first = event;
+    if (!last)
+        last = event;
+}
+
+void
+EventQueue::ScheduleBatch::flush()
+{
+    if (!first)
+        return;
 
-    async_queue_mutex.unlock();
+    eventq->asyncInsert(first, last);
+    first = last = nullptr;
 }
 
 } // namespace gem5
@@ -36,6 +36,7 @@
 #define __SIM_EVENTQ_HH__
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <functional>
@@ -43,9 +44,13 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
+#include "base/free_list.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
 #include "base/type_traits.hh"
@@ -68,6 +73,13 @@ class BaseGlobalEvent;
 //! Queue B should be at least simQuantum ticks away in future.
 extern Tick simQuantum;
 
+//! Let quanta grow beyond simQuantum when no queue has an event that
+//! could affect another queue before the end of the default quantum.
+//! Since cross-queue events are at least simQuantum away from the event
+//! that caused them, the next synchronization only has to happen
+//! simQuantum ticks after the earliest pending event of any queue.
+extern bool adaptiveSimQuantum;
+
 //! Current number of allocated main event queues.
 extern uint32_t numMainEventQueues;
 
@@ -264,7 +276,9 @@ class Event : public EventBase, public Serializable
     // result is that the insert/removal in 'nextBin' is
     // linear/constant, and the lookup/removal in 'nextInBin' is
     // constant/constant.  Hopefully this is a significant improvement
-    // over the current fully linear insertion.
+    // over the current fully linear insertion. While an event waits
+    // in the async queue of an event queue, 'nextBin' links it into
+    // that queue instead.
     Event *nextBin;
     Event *nextInBin;
 
@@ -610,10 +624,35 @@ operator!=(const Event &l, const Event &r)
  * handleAsyncInsertions() method). Note that this implies that such
  * events must happen at least one simulation quantum into the future,
  * otherwise they risk being scheduled in the past by
- * handleAsyncInsertions().
+ * handleAsyncInsertions(). The async queue is a lock-free stack that
+ * any number of threads may push to, and a ScheduleBatch can be used
+ * to hand several events over to it in a single operation.
+ *
+ * The pending events are always kept in the sorted list of bins
+ * described in Event. How a new event finds its position in that list
+ * depends on the queue's backend (see EventQueue::Backend). The
+ * default, BinList, walks the list from the head. The Calendar
+ * backend additionally keeps a calendar of tick buckets that points
+ * at the first and last bin of every bucket in a window starting at
+ * the current tick. Events that land in the window are inserted after
+ * a walk that is bounded by the number of bins in their bucket, which
+ * gives amortized O(1) scheduling for queues with many pending
+ * events. Both backends produce exactly the same event order.
  */
 class EventQueue
 {
+  public:
+    /**
+     * Data structure used to find the insertion point of an event.
+     *
+     * @ingroup api_eventq
+     */
+    enum class Backend
+    {
+        BinList,
+        Calendar
+    };
+
   private:
     friend void curEventQueue(EventQueue *);
 
@@ -621,11 +660,74 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
-    //! Mutex to protect async queue.
-    UncontendedMutex async_queue_mutex;
+    /**
+     * @defgroup calendar Calendar backend state
+     *
+     * Bucket n covers the ticks [n * calWidth, (n + 1) * calWidth) and
+     * lives in calBuckets[n & calMask]. The window consists of the
+     * buckets [calBase, calBase + calBuckets.size()). Every bin in the
+     * window is indexed by its bucket, bins beyond the window are only
+     * reachable through the bin list.
+     * @{
+     */
+    struct CalendarBucket
+    {
+        /** Top event of the first bin in the bucket */
+        Event *first = nullptr;
+        /** Top event of the last bin in the bucket */
+        Event *last = nullptr;
+    };
+
+    Backend _backend = Backend::BinList;
+    std::vector<CalendarBucket> calBuckets;
+    /** One bit per entry in calBuckets, set if the bucket is in use */
+    std::vector<uint64_t> calInUse;
+    uint64_t calMask = 0;
+    Tick calWidth = 1;
+    uint64_t calBase = 0;
+    /** @} */
+
+    uint64_t calBucket(const Event *event) const
+    {
+        return event->when() / calWidth;
+    }
+
+    bool
+    calInWindow(uint64_t bucket) const
+    {
+        return bucket >= calBase && bucket - calBase <= calMask;
+    }
 
-    //! List of events added by other threads to this event queue.
-    std::list<Event*> async_queue;
+    /**
+     * Find the top event of a bin that sorts strictly before the
+     * given event. Returns nullptr if the search has to start at the
+     * head of the queue.
+     */
+    Event *calFindBinBefore(const Event *event);
+
+    /** Last bin of the closest used bucket in [calBase, bucket). */
+    Event *calLastBinBefore(uint64_t bucket) const;
+
+    /** Update the calendar after the top of a bin changed. */
+    void calReplaceTop(Event *old_top, Event *new_top);
+    /** Update the calendar after a bin was added to the list. */
+    void calAddBin(Event *top);
+    /** Update the calendar after a bin was removed from the list. */
+    void calRemoveBin(Event *top, Event *prev);
+
+    /** Slide the window so that it starts at the current tick. */
+    void calAdvance();
+    /** Drop and recreate the calendar from the bin list. */
+    void calRebuild();
+
+    /**
+     * Events added by other threads to this event queue. This is an
+     * intrusive lock-free stack linked through Event::nextBin, with the
+     * most recently added event on top. Producers push with a single
+     * compare-and-swap, and the owning thread takes the whole stack at
+     * once in handleAsyncInsertions().
+     */
+    std::atomic<Event *> async_queue{nullptr};
 
     /**
      * Lock protecting event handling.
@@ -654,14 +756,60 @@ class EventQueue
     void insert(Event *event);
     void remove(Event *event);
 
+    //! Start the linear part of insert() and remove() at bin 'prev'
+    //! (nullptr means at the head of the queue).
+    void insertAfter(Event *event, Event *prev);
+    void removeAfter(Event *event, Event *prev);
+
     //! Function for adding events to the async queue. The added events
     //! are added to main event queue later. Threads, other than the
     //! owning thread, should call this function instead of insert().
-    void asyncInsert(Event *event);
+    void asyncInsert(Event *event) { asyncInsert(event, event); }
+
+    //! Push the chain of events first -> ... -> last, linked through
+    //! nextBin, to the async queue in one operation.
+    void asyncInsert(Event *first, Event *last);
 
     EventQueue(const EventQueue &);
 
   public:
+    /**
+     * Schedule a group of events on an event queue from a thread that
+     * does not own it.
+     *
+     * The events are collected locally and handed over to the queue's
+     * async queue in a single operation when the batch is flushed or
+     * destroyed, which keeps producers that generate many events from
+     * contending on the queue. The events are inserted in the order in
+     * which they were added. If the calling thread may schedule on the
+     * queue directly (it owns it, or the simulation is not running in
+     * parallel), events are scheduled immediately instead.
+     */
+    class ScheduleBatch
+    {
+      public:
+        ScheduleBatch(EventQueue *_eventq) : eventq(_eventq) {}
+        ~ScheduleBatch() { flush(); }
+
+        ScheduleBatch(const ScheduleBatch &) = delete;
+        ScheduleBatch &operator=(const ScheduleBatch &) = delete;
+
+        /** Add an event to be scheduled at the given tick. */
+        void schedule(Event *event, Tick when);
+
+        /** Hand all the events added so far over to the queue. */
+        void flush();
+
+        bool empty() const { return first == nullptr; }
+
+      private:
+        EventQueue *eventq;
+        //! The most recently added event
+        Event *first = nullptr;
+        //! The event that was added first
+        Event *last = nullptr;
+    };
+
     class ScopedMigration
     {
       public:
@@ -740,6 +888,21 @@ class EventQueue
      */
     EventQueue(const std::string &n);
 
+    /**
+     * Select the data structure used to sort pending events. This can
+     * be called at any time, events that are already scheduled stay
+     * scheduled.
+     *
+     * @param backend Backend to use.
+     * @param bucket_width Ticks covered by one calendar bucket.
+     * @param num_buckets Calendar size, rounded up to a power of two.
+     *
+     * @ingroup api_eventq
+     */
+    void setBackend(Backend backend, Tick bucket_width = 1000,
+                    uint64_t num_buckets = 8192);
+    Backend backend() const { return _backend; }
+
     /**
      * @ingroup api_eventq
      * @{
@@ -834,6 +997,13 @@ class EventQueue
     }
 
     Tick nextTick() const { return head->when(); }
+
+    /**
+     * Time of the earliest event pending on this queue, including
+     * events that were scheduled by other threads and are waiting to
+     * be merged into the queue. Returns MaxTick if there is none.
+     */
+    Tick nextPendingTick();
     void setCurTick(Tick newVal) { _curTick = newVal; }
 
     /**
@@ -977,6 +1147,55 @@ curEventQueue(EventQueue *q)
 
 void dumpMainQueue();
 
+//! Select the backend of the main event queue with the provided
+//! index. Queues that do not exist yet use it once getEventQueue()
+//! allocates them.
+void setMainEventQueueBackend(uint32_t index, EventQueue::Backend backend,
+                              Tick bucket_width, uint64_t num_buckets);
+
+/**
+ * A nameless event that runs a callback once and deletes itself.
+ *
+ * Unlike an auto-deleted EventFunctionWrapper, creating a OneShotEvent
+ * does not touch the heap: the event is allocated from a thread-local
+ * free list, and the callback, which has to fit in BufferSize bytes
+ * (e.g., a lambda capturing a few pointers), is stored inline.
+ *
+ * @ingroup api_eventq
+ */
+class OneShotEvent final : public Event,
+                           public FreeListAllocated<OneShotEvent>
+{
+  public:
+    static constexpr std::size_t BufferSize = 4 * sizeof(void *);
+
+    template <typename F>
+    explicit OneShotEvent(F &&callback, Priority p = Default_Pri)
+        : Event(p, AutoDelete)
+    {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= BufferSize,
+                      "Callback too large for a OneShotEvent");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t),
+                      "Callback alignment not supported by OneShotEvent");
+
+        new (buffer) Fn(std::forward<F>(callback));
+        invokeFn = [](void *b) { (*static_cast<Fn *>(b))(); };
+        destroyFn = [](void *b) { static_cast<Fn *>(b)->~Fn(); };
+    }
+
+    ~OneShotEvent() { destroyFn(buffer); }
+
+    void process() override { invokeFn(buffer); }
+
+    const char *description() const override { return "OneShotEvent"; }
+
+  private:
+    alignas(std::max_align_t) unsigned char buffer[BufferSize];
+    void (*invokeFn)(void *);
+    void (*destroyFn)(void *);
+};
+
 class EventManager
 {
   protected:
@@ -1041,6 +1260,21 @@ class EventManager
         eventq->schedule(event, when);
     }
 
+    /**
+     * Schedule a callback to run once at the given tick. See
+     * OneShotEvent for the constraints on the callback.
+     *
+     * @ingroup api_eventq
+     */
+    template <typename F>
+    void
+    scheduleOneShot(F &&callback, Tick when,
+                    Event::Priority p = Event::Default_Pri)
+    {
+        eventq->schedule(new OneShotEvent(std::forward<F>(callback), p),
+                         when);
+    }
+
     /**
      * @ingroup api_eventq
      */
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2000-2005 The Regents of The University of Michigan
+ * Copyright (c) 2013 Advanced Micro Devices, Inc.
+ * Copyright (c) 2013 Mark D. Hill and David A. Wood
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Event that records its id in a shared log when processed. */
+class LogEvent : public Event
+{
+  public:
+    LogEvent(std::vector<int> &_log, int _id, Priority p)
+        : Event(p), log(_log), id(_id)
+    {}
+
+    void process() override { log.push_back(id); }
+
+  private:
+    std::vector<int> &log;
+    int id;
+};
+
+/**
+ * Run the same pseudo-random sequence of schedule, deschedule and
+ * reschedule operations on a queue and return the order in which the
+ * events were serviced.
+ */
+std::vector<int>
+runRandomWorkload(EventQueue &eq, unsigned seed)
+{
+    const int num_events = 512;
+    const Event::Priority prios[] = {
+        Event::Minimum_Pri, Event::Default_Pri, Event::Default_Pri + 1,
+        Event::Maximum_Pri };
+
+    std::mt19937 rng(seed);
+    std::vector<int> log;
+    std::vector<std::unique_ptr<LogEvent>> events;
+    for (int i = 0; i < num_events; i++)
+        events.emplace_back(new LogEvent(log, i, prios[rng() % 4]));
+
+    auto pick_tick = [&]() -> Tick {
+        Tick now = eq.getCurTick();
+        switch (rng() % 4) {
+          case 0: return now;
+          case 1: return now + rng() % 16;
+          case 2: return now + rng() % 1024;
+          default: return now + rng() % 100000;
+        }
+    };
+
+    for (int round = 0; round < 20000; round++) {
+        LogEvent *e = events[rng() % num_events].get();
+        switch (rng() % 4) {
+          case 0:
+          case 1:
+            if (e->scheduled())
+                eq.reschedule(e, pick_tick());
+            else
+                eq.schedule(e, pick_tick());
+            break;
+          case 2:
+            if (e->scheduled())
+                eq.deschedule(e);
+            break;
+          default:
+            if (!eq.empty())
+                eq.serviceOne();
+            break;
+        }
+
+        if (round % 64 == 0) {
+            EXPECT_TRUE(eq.debugVerify());
+        }
+    }
+
+    while (!eq.empty())
+        eq.serviceOne();
+
+    return log;
+}
+
+} // anonymous namespace
+
+/** The calendar must service events in exactly the bin list's order. */
+TEST(EventQueueTest, CalendarMatchesBinList)
+{
+    for (unsigned seed = 0; seed < 4; seed++) {
+        EventQueue list_eq("list");
+        EventQueue cal_eq("calendar");
+        // A small calendar makes sure the window slides and that far
+        // future events are scheduled beyond it.
+        cal_eq.setBackend(EventQueue::Backend::Calendar, 4, 64);
+
+        auto expected = runRandomWorkload(list_eq, seed);
+        auto actual = runRandomWorkload(cal_eq, seed);
+        ASSERT_FALSE(expected.empty());
+        EXPECT_EQ(expected, actual);
+    }
+}
+
+/** Events in the same bin are serviced in LIFO order by both backends. */
+TEST(EventQueueTest, SameBinIsLifo)
+{
+    for (auto backend : { EventQueue::Backend::BinList,
+                          EventQueue::Backend::Calendar }) {
+        EventQueue eq("eq");
+        eq.setBackend(backend);
+
+        std::vector<int> log;
+        LogEvent e0(log, 0, Event::Default_Pri);
+        LogEvent e1(log, 1, Event::Default_Pri);
+        LogEvent e2(log, 2, Event::Default_Pri);
+        LogEvent late(log, 3, Event::Maximum_Pri);
+
+        eq.schedule(&late, 100);
+        eq.schedule(&e0, 100);
+        eq.schedule(&e1, 100);
+        eq.schedule(&e2, 100);
+        while (!eq.empty())
+            eq.serviceOne();
+
+        EXPECT_EQ(log, std::vector<int>({2, 1, 0, 3}));
+    }
+}
+
+/** Switching the backend keeps the events that are already scheduled. */
+TEST(EventQueueTest, SwitchBackendWithPendingEvents)
+{
+    EventQueue eq("eq");
+    std::vector<int> log;
+    LogEvent e0(log, 0, Event::Default_Pri);
+    LogEvent e1(log, 1, Event::Default_Pri);
+    LogEvent e2(log, 2, Event::Default_Pri);
+
+    eq.schedule(&e2, 3000000);
+    eq.schedule(&e0, 10);
+    eq.setBackend(EventQueue::Backend::Calendar, 100, 16);
+    eq.schedule(&e1, 500);
+    eq.setBackend(EventQueue::Backend::BinList);
+    eq.deschedule(&e2);
+    eq.setBackend(EventQueue::Backend::Calendar);
+    eq.schedule(&e2, 20);
+
+    ASSERT_TRUE(eq.debugVerify());
+    while (!eq.empty())
+        eq.serviceOne();
+
+    EXPECT_EQ(log, std::vector<int>({0, 2, 1}));
+}
+
+/** One-shot events run their callback once and then release it. */
+TEST(EventQueueTest, OneShotEvent)
+{
+    EventQueue eq("eq");
+    auto token = std::make_shared<int>(0);
+
+    eq.schedule(new OneShotEvent([token]() { (*token)++; }), 10);
+    eq.schedule(new OneShotEvent([token]() { (*token) += 10; },
+                                 Event::Maximum_Pri), 10);
+    EXPECT_EQ(token.use_count(), 3);
+
+    while (!eq.empty())
+        eq.serviceOne();
+
+    EXPECT_EQ(*token, 11);
+    EXPECT_EQ(token.use_count(), 1);
+}
+
+/**
+ * Events scheduled from other threads, one by one and in batches, all
+ * reach the target queue, and the events of one producer keep their
+ * order.
+ */
+TEST(EventQueueTest, AsyncInsertions)
+{
+    const int num_threads = 4;
+    const int per_thread = 1000;
+
+    EventQueue target("target");
+    std::vector<int> log;
+    std::vector<std::unique_ptr<LogEvent>> events;
+    for (int i = 0; i < num_threads * per_thread; i++)
+        events.emplace_back(new LogEvent(log, i, Event::Default_Pri));
+
+    inParallelMode = true;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            EventQueue own("own");
+            curEventQueue(&own);
+            EventQueue::ScheduleBatch batch(&target);
+            for (int i = 0; i < per_thread; i++) {
+                int id = t * per_thread + i;
+                if (t % 2)
+                    target.schedule(events[id].get(), 100 + id);
+                else
+                    batch.schedule(events[id].get(), 100 + id);
+                if (i % 64 == 63)
+                    batch.flush();
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    EXPECT_EQ(target.nextPendingTick(), 100);
+
+    curEventQueue(&target);
+    target.handleAsyncInsertions();
+    inParallelMode = false;
+
+    ASSERT_TRUE(target.debugVerify());
+    while (!target.empty())
+        target.serviceOne();
+
+    ASSERT_EQ(log.size(), num_threads * per_thread);
+    for (int i = 0; i < num_threads * per_thread; i++)
+        EXPECT_EQ(log[i], i);
+}
+
+/** A batch hands its events over in the order in which they were added. */
+TEST(EventQueueTest, ScheduleBatchOrder)
+{
+    EventQueue target("target");
+    EventQueue own("own");
+    std::vector<int> log;
+    LogEvent e0(log, 0, Event::Default_Pri);
+    LogEvent e1(log, 1, Event::Default_Pri);
+    LogEvent e2(log, 2, Event::Default_Pri);
+
+    inParallelMode = true;
+    curEventQueue(&own);
+    {
+        EventQueue::ScheduleBatch batch(&target);
+        batch.schedule(&e0, 100);
+        batch.schedule(&e1, 100);
+        batch.schedule(&e2, 100);
+        EXPECT_TRUE(target.empty());
+    }
+
+    curEventQueue(&target);
+    target.handleAsyncInsertions();
+    inParallelMode = false;
+
+    while (!target.empty())
+        target.serviceOne();
+
+    // Same order as if the events had been scheduled directly.
+    EXPECT_EQ(log, std::vector<int>({2, 1, 0}));
+}
@@ -102,6 +102,7 @@ FDArray::FDArray(std::string const& input, std::string const& output,
 void
 FDArray::updateFileOffsets()
 {
+    std::lock_guard<std::recursive_mutex> guard(mutex);
     for (auto& fdp : _fdArray) {
         /**
          * It only makes sense to check the offsets if the file descriptor
@@ -125,6 +126,7 @@ FDArray::updateFileOffsets()
 void
 FDArray::restoreFileOffsets()
 {
+    std::lock_guard<std::recursive_mutex> guard(mutex);
     /**
      * Use this lambda to highlight what we mean to do with the seek.
      * Notice that this either seeks correctly (sets the file location on the
@@ -284,6 +286,7 @@ FDArray::restoreFileOffsets()
 int
 FDArray::allocFD(std::shared_ptr<FDEntry> in)
 {
+    std::lock_guard<std::recursive_mutex> guard(mutex);
     for (int i = 0; i < _fdArray.size(); i++) {
         std::shared_ptr<FDEntry> fdp = _fdArray[i];
         if (!fdp) {
@@ -319,6 +322,7 @@ FDArray::openOutputFile(std::string const& filename) const
 std::shared_ptr<FDEntry>
 FDArray::getFDEntry(int tgt_fd)
 {
+    std::lock_guard<std::recursive_mutex> guard(mutex);
     assert(0 <= tgt_fd && tgt_fd < _fdArray.size());
     return _fdArray[tgt_fd];
 }
@@ -326,6 +330,7 @@ FDArray::getFDEntry(int tgt_fd)
 void
 FDArray::setFDEntry(int tgt_fd, std::shared_ptr<FDEntry> fdep)
 {
+    std::lock_guard<std::recursive_mutex> guard(mutex);
     assert(0 <= tgt_fd && tgt_fd < _fdArray.size());
     _fdArray[tgt_fd] = fdep;
 }
@@ -333,6 +338,7 @@ FDArray::setFDEntry(int tgt_fd, std::shared_ptr<FDEntry> fdep)
 int
 FDArray::closeFDEntry(int tgt_fd)
 {
+    std::lock_guard<std::recursive_mutex> guard(mutex);
     if (tgt_fd >= _fdArray.size() || tgt_fd < 0)
         return -EBADF;
 
@@ -35,6 +35,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "sim/fd_entry.hh"
@@ -126,6 +127,12 @@ class FDArray : public Serializable
 
 
   private:
+    /**
+     * Threads sharing the array may be simulated by several event queues
+     * at once, so the accesses to the entries hold this lock.
+     */
+    mutable std::recursive_mutex mutex;
+
     /**
      * Help clarify our intention when opening files in the init and
      * restoration code. These are helper functions which are not meant to
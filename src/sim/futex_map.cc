@@ -58,6 +58,7 @@ FutexMap::suspend(Addr addr, uint64_t tgid, ThreadContext *tc)
 int
 FutexMap::wakeup(Addr addr, uint64_t tgid, int count)
 {
+    auto guard = lock();
     FutexKey key(addr, tgid);
     auto it = find(key);
 
@@ -73,7 +74,7 @@ FutexMap::wakeup(Addr addr, uint64_t tgid, int count)
         // must only count threads that were actually
         // woken up by this syscall.
         auto& tc = waiterList.front().tc;
-        tc->activate();
+        tc->activateFromAnyQueue();
         woken_up++;
         waiterList.pop_front();
         waitingTcs.erase(tc);
@@ -89,6 +90,7 @@ void
 FutexMap::suspend_bitset(Addr addr, uint64_t tgid, ThreadContext *tc,
                int bitmask)
 {
+    auto guard = lock();
     FutexKey key(addr, tgid);
     auto it = find(key);
 
@@ -107,6 +109,7 @@ FutexMap::suspend_bitset(Addr addr, uint64_t tgid, ThreadContext *tc,
 int
 FutexMap::wakeup_bitset(Addr addr, uint64_t tgid, int bitmask)
 {
+    auto guard = lock();
     FutexKey key(addr, tgid);
     auto it = find(key);
 
@@ -122,7 +125,7 @@ FutexMap::wakeup_bitset(Addr addr, uint64_t tgid, int bitmask)
         WaiterState& waiter = *iter;
 
         if (waiter.checkMask(bitmask)) {
-            waiter.tc->activate();
+            waiter.tc->activateFromAnyQueue();
             waitingTcs.erase(waiter.tc);
             iter = waiterList.erase(iter);
             woken_up++;
@@ -140,6 +143,7 @@ FutexMap::wakeup_bitset(Addr addr, uint64_t tgid, int bitmask)
 int
 FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
 {
+    auto guard = lock();
     FutexKey key1(addr1, tgid);
     auto it1 = find(key1);
 
@@ -150,7 +154,7 @@ FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
     auto &waiterList1 = it1->second;
 
     while (!waiterList1.empty() && woken_up < count) {
-        waiterList1.front().tc->activate();
+        waiterList1.front().tc->activateFromAnyQueue();
         waiterList1.pop_front();
         woken_up++;
     }
@@ -184,6 +188,7 @@ FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
 bool
 FutexMap::is_waiting(ThreadContext *tc)
 {
+    auto guard = lock();
     return waitingTcs.find(tc) != waitingTcs.end();
 }
 
@@ -29,6 +29,7 @@
 #ifndef __FUTEX_MAP_HH__
 #define __FUTEX_MAP_HH__
 
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -104,11 +105,20 @@ class WaiterState
 typedef std::list<WaiterState> WaiterList;
 
 /**
- * FutexMap class holds a map of all futexes used in the system
+ * FutexMap class holds a map of all futexes used in the system. Its
+ * methods may be called from the threads of several event queues at
+ * once. To make a check of a futex word and the operation depending on
+ * it a single step, hold lock() around both.
  */
 class FutexMap : public std::unordered_map<FutexKey, WaiterList>
 {
   public:
+    std::unique_lock<std::recursive_mutex>
+    lock()
+    {
+        return std::unique_lock<std::recursive_mutex>(mutex);
+    }
+
     /** Inserts a futex into the map with one waiting TC */
     void suspend(Addr addr, uint64_t tgid, ThreadContext *tc);
 
@@ -140,6 +150,7 @@ class FutexMap : public std::unordered_map<FutexKey, WaiterList>
 
   private:
 
+    std::recursive_mutex mutex;
     std::unordered_set<ThreadContext *> waitingTcs;
 };
 
@@ -29,6 +29,8 @@
 
 #include "sim/global_event.hh"
 
+#include <algorithm>
+
 #include "sim/cur_tick.hh"
 
 namespace gem5
@@ -157,9 +159,22 @@ GlobalSyncEvent::BarrierEvent::process()
 void
 GlobalSyncEvent::process()
 {
-    if (repeat) {
-        schedule(curTick() + repeat);
+    if (!repeat)
+        return;
+
+    Tick next = curTick() + repeat;
+    if (adaptiveSimQuantum) {
+        // All other threads are waiting on the barrier, so their queues
+        // can safely be inspected here.
+        Tick pending = MaxTick;
+        for (uint32_t i = 0; i < numMainEventQueues; ++i)
+            pending = std::min(pending, mainEventQueue[i]->nextPendingTick());
+
+        if (pending < MaxTick - repeat)
+            next = std::max(next, pending + repeat);
     }
+
+    schedule(next);
 }
 
 const char *
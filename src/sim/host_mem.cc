@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/host_mem.hh"
+
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/hostinfo.hh"
+
+namespace gem5
+{
+
+namespace host_mem
+{
+
+namespace
+{
+
+/**
+ * The existing accounts. Accounts may be created by static objects, so
+ * this is only constructed when first used.
+ */
+struct Registry
+{
+    std::mutex mutex;
+    std::set<const Account *> accounts;
+};
+
+Registry &
+registry()
+{
+    static Registry *reg = new Registry;
+    return *reg;
+}
+
+} // anonymous namespace
+
+Account::Account(const std::string &name) : _name(name), _bytes(0)
+{
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.accounts.insert(this);
+}
+
+Account::~Account()
+{
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.accounts.erase(this);
+}
+
+std::map<std::string, uint64_t>
+usage()
+{
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::map<std::string, uint64_t> bytes;
+    for (const Account *account : reg.accounts)
+        bytes[account->name()] += account->bytes();
+    return bytes;
+}
+
+uint64_t
+total()
+{
+    uint64_t bytes = 0;
+    for (const auto &[name, account_bytes] : usage())
+        bytes += account_bytes;
+    return bytes;
+}
+
+void
+dump(std::ostream &os, unsigned top)
+{
+    const auto bytes = usage();
+    std::vector<std::pair<std::string, uint64_t>> sorted(
+            bytes.begin(), bytes.end());
+    std::stable_sort(sorted.begin(), sorted.end(),
+            [](const auto &a, const auto &b) { return a.second > b.second; });
+
+    // memUsage() is the virtual memory size, in kilobytes.
+    const uint64_t used = memUsage() * 1024;
+    uint64_t accounted = 0;
+    for (const auto &[name, account_bytes] : sorted)
+        accounted += account_bytes;
+
+    ccprintf(os, "Host virtual memory: %d bytes, %d accounted for\n",
+             used, accounted);
+    for (size_t i = 0; i < sorted.size() && i < top; i++) {
+        ccprintf(os, "%14d %5.1f%% %s\n", sorted[i].second,
+                 used ? 100.0 * sorted[i].second / used : 0.0,
+                 sorted[i].first);
+    }
+}
+
+} // namespace host_mem
+} // namespace gem5
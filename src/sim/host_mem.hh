@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Accounting of the host memory used by the larger structures of the
+ * simulator, so it can be charged to the SimObjects owning them.
+ */
+
+#ifndef __SIM_HOST_MEM_HH__
+#define __SIM_HOST_MEM_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace gem5
+{
+
+namespace host_mem
+{
+
+/**
+ * The number of bytes of host memory used by one structure. The owner
+ * updates it as the structure grows and shrinks. Accounts are known to
+ * the accounting for as long as they exist, and several of them may
+ * have the same name.
+ */
+class Account
+{
+  private:
+    const std::string _name;
+    std::atomic<int64_t> _bytes;
+
+  public:
+    /**
+     * @param name Name of the structure. When it starts with the name of
+     * a SimObject followed by a '.', or is the name of one, the memory is
+     * charged to that SimObject.
+     */
+    explicit Account(const std::string &name);
+    ~Account();
+
+    Account(const Account &) = delete;
+    Account &operator=(const Account &) = delete;
+
+    const std::string &name() const { return _name; }
+    uint64_t bytes() const { return _bytes; }
+
+    void add(uint64_t bytes) { _bytes += bytes; }
+    void sub(uint64_t bytes) { _bytes -= bytes; }
+};
+
+/** The bytes of all the accounts, by account name. */
+std::map<std::string, uint64_t> usage();
+
+/** The bytes of all the accounts. */
+uint64_t total();
+
+/**
+ * Write the largest accounts and their share of the memory used by the
+ * process.
+ *
+ * @param os Stream to write to.
+ * @param top How many accounts to write, at most.
+ */
+void dump(std::ostream &os, unsigned top = 20);
+
+} // namespace host_mem
+} // namespace gem5
+
+#endif // __SIM_HOST_MEM_HH__
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "sim/host_mem.hh"
+
+using namespace gem5;
+
+TEST(HostMemTest, AccountsAreMergedByName)
+{
+    host_mem::Account a("test.a");
+    host_mem::Account b("test.b");
+    host_mem::Account other_a("test.a");
+
+    a.add(100);
+    b.add(20);
+    other_a.add(3);
+    a.sub(50);
+
+    EXPECT_EQ(a.bytes(), 50);
+    auto usage = host_mem::usage();
+    EXPECT_EQ(usage["test.a"], 53);
+    EXPECT_EQ(usage["test.b"], 20);
+}
+
+TEST(HostMemTest, DestroyedAccountsAreDropped)
+{
+    const uint64_t before = host_mem::total();
+    {
+        host_mem::Account account("test.gone");
+        account.add(1000);
+        EXPECT_EQ(host_mem::total(), before + 1000);
+    }
+    EXPECT_EQ(host_mem::total(), before);
+    EXPECT_EQ(host_mem::usage().count("test.gone"), 0);
+}
+
+TEST(HostMemTest, DumpListsLargestFirst)
+{
+    host_mem::Account small("test.small");
+    host_mem::Account large("test.large");
+    small.add(10);
+    large.add(1000000);
+
+    std::ostringstream os;
+    host_mem::dump(os);
+    const std::string out = os.str();
+    ASSERT_NE(out.find("test.large"), std::string::npos);
+    ASSERT_NE(out.find("test.small"), std::string::npos);
+    EXPECT_LT(out.find("test.large"), out.find("test.small"));
+
+    std::ostringstream top_only;
+    host_mem::dump(top_only, 1);
+    EXPECT_EQ(top_only.str().find("test.small"), std::string::npos);
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/host_profile.hh"
+
+#include <sys/time.h>
+
+#include <atomic>
+#include <csignal>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "sim/event_profile.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace host_profile
+{
+
+bool enabled = false;
+
+namespace
+{
+
+/** Host CPU seconds between two samples. */
+double samplingInterval = 0.0;
+
+/**
+ * Whether the thread is servicing an event, and the samples it took
+ * since it started to. Both are written by the signal handler.
+ */
+thread_local volatile std::sig_atomic_t inEvent = 0;
+thread_local volatile std::sig_atomic_t pending = 0;
+
+/** Samples taken by threads not servicing any event. */
+std::atomic<uint64_t> outsideSamples(0);
+
+/** The samples taken by one simulation thread, by event name. */
+using Table = std::unordered_map<std::string, uint64_t>;
+
+std::mutex tablesMutex;
+std::vector<std::unique_ptr<Table>> allTables;
+
+/**
+ * Get the table of the calling thread. They are owned by allTables so
+ * that they outlive the thread and can still be read at exit.
+ */
+Table &
+localTable()
+{
+    static thread_local Table *table = nullptr;
+    if (!table) {
+        std::lock_guard<std::mutex> lock(tablesMutex);
+        allTables.emplace_back(new Table);
+        table = allTables.back().get();
+    }
+    return *table;
+}
+
+void
+handleSignal(int)
+{
+    sample();
+}
+
+} // anonymous namespace
+
+bool
+enable(unsigned frequency)
+{
+    if (frequency == 0 || frequency > 1000000)
+        return false;
+
+    struct sigaction action = {};
+    action.sa_handler = handleSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, nullptr) != 0)
+        return false;
+
+    const long period_us = 1000000 / frequency;
+    struct itimerval timer = {};
+    timer.it_interval.tv_sec = period_us / 1000000;
+    timer.it_interval.tv_usec = period_us % 1000000;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0)
+        return false;
+
+    samplingInterval = period_us / 1e6;
+    enabled = true;
+    return true;
+}
+
+double
+interval()
+{
+    return samplingInterval;
+}
+
+void
+sample()
+{
+    if (inEvent)
+        pending = pending + 1;
+    else
+        outsideSamples.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+process(Event *event)
+{
+    inEvent = 1;
+#if TRACING_ON
+    if (event_profile::enabled)
+        event_profile::process(event);
+    else
+#endif
+        event->process();
+    inEvent = 0;
+
+    // Naming the event allocates, so only do it when it was sampled.
+    // The event queue relies on the event surviving its own process()
+    // method as well: it is only released once this returns.
+    if (pending) {
+        uint64_t count = pending;
+        pending = 0;
+        localTable()[event->name()] += count;
+    }
+}
+
+std::map<std::string, uint64_t>
+samples()
+{
+    std::map<std::string, uint64_t> merged;
+
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    for (const auto &table : allTables) {
+        for (const auto &[name, count] : *table)
+            merged[name] += count;
+    }
+    uint64_t outside = outsideSamples.load(std::memory_order_relaxed);
+    if (outside)
+        merged[""] += outside;
+    return merged;
+}
+
+void
+reset()
+{
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    for (auto &table : allTables)
+        table->clear();
+    outsideSamples.store(0, std::memory_order_relaxed);
+}
+
+std::map<std::string, uint64_t>
+attribute(const std::map<std::string, uint64_t> &samples,
+          const std::set<std::string> &owners, const std::string &fallback)
+{
+    std::map<std::string, uint64_t> charged;
+    for (const auto &[name, count] : samples) {
+        std::string owner = name;
+        while (!owner.empty() && !owners.count(owner)) {
+            auto pos = owner.rfind('.');
+            owner.erase(pos == std::string::npos ? 0 : pos);
+        }
+        charged[owner.empty() ? fallback : owner] += count;
+    }
+    return charged;
+}
+
+} // namespace host_profile
+} // namespace gem5
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Sampling profiler attributing host CPU time to the events, and so to
+ * the SimObjects, that the event queues service.
+ */
+
+#ifndef __SIM_HOST_PROFILE_HH__
+#define __SIM_HOST_PROFILE_HH__
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+
+namespace gem5
+{
+
+class Event;
+
+namespace host_profile
+{
+
+/**
+ * Whether the event queues should let the profiler know which event
+ * they are servicing. Only consulted by builds with TRACING_ON; other
+ * builds never profile.
+ */
+extern bool enabled;
+
+/**
+ * Start sampling. A SIGPROF timer fires every 1/frequency seconds of
+ * host CPU time used by the process, and each time it fires the event
+ * being serviced by the interrupted thread takes one sample.
+ *
+ * @param frequency Samples per host CPU second, at most one million.
+ * @return Whether the signal handler and the timer could be installed.
+ */
+bool enable(unsigned frequency);
+
+/** Host CPU seconds each sample stands for. */
+double interval();
+
+/**
+ * Take one sample on the calling thread. This is the body of the
+ * SIGPROF handler and only touches async-signal-safe state.
+ */
+void sample();
+
+/**
+ * Process an event, charging the samples taken while it ran to its
+ * name. Called by EventQueue::serviceOne() instead of Event::process()
+ * while profiling is enabled.
+ */
+void process(Event *event);
+
+/**
+ * The number of samples taken so far, by event name, merged across all
+ * simulation threads. The samples taken outside of any event are under
+ * the empty name. This and reset() must only be called while no
+ * simulation thread is running.
+ */
+std::map<std::string, uint64_t> samples();
+
+/** Drop the samples taken so far. */
+void reset();
+
+/**
+ * Charge each event's samples to its owner: the longest prefix of its
+ * name, cut at a '.', found in owners. Events owned by none of them,
+ * and the samples taken outside of any event, are charged to fallback.
+ */
+std::map<std::string, uint64_t>
+attribute(const std::map<std::string, uint64_t> &samples,
+          const std::set<std::string> &owners, const std::string &fallback);
+
+} // namespace host_profile
+} // namespace gem5
+
+#endif // __SIM_HOST_PROFILE_HH__
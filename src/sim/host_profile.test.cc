@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "sim/eventq.hh"
+#include "sim/host_profile.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** An event which takes some host profile samples while it runs. */
+class SampledEvent : public Event
+{
+  public:
+    SampledEvent(const std::string &_name, int _samples)
+        : _name(_name), _samples(_samples)
+    {}
+
+    void
+    process() override
+    {
+        for (int i = 0; i < _samples; i++)
+            host_profile::sample();
+    }
+
+    const std::string name() const override { return _name; }
+
+  private:
+    std::string _name;
+    int _samples;
+};
+
+} // anonymous namespace
+
+TEST(HostProfileTest, ChargesSamplesToServicedEvents)
+{
+    SampledEvent a("obj.a", 2);
+    SampledEvent b("obj.b", 0);
+
+    host_profile::reset();
+    host_profile::process(&a);
+    host_profile::process(&b);
+    host_profile::process(&a);
+    host_profile::sample();
+
+    const auto samples = host_profile::samples();
+    EXPECT_EQ(samples.size(), 2);
+    EXPECT_EQ(samples.at("obj.a"), 4);
+    EXPECT_EQ(samples.at(""), 1);
+
+    host_profile::reset();
+    EXPECT_TRUE(host_profile::samples().empty());
+}
+
+TEST(HostProfileTest, AttributesToLongestOwner)
+{
+    const std::map<std::string, uint64_t> samples = {
+        {"system.cpu.tickEvent", 3},
+        {"system.cpu.icache.mem_side.sendEvent", 2},
+        {"system.cpu", 1},
+        {"system.membus.reqLayer0.event", 4},
+        {"Event_42", 5},
+        {"", 6},
+    };
+    const std::set<std::string> owners = {
+        "root", "system", "system.cpu", "system.cpu.icache",
+    };
+
+    const auto charged = host_profile::attribute(samples, owners, "root");
+
+    EXPECT_EQ(charged.size(), 4);
+    EXPECT_EQ(charged.at("system.cpu"), 4);
+    EXPECT_EQ(charged.at("system.cpu.icache"), 2);
+    EXPECT_EQ(charged.at("system"), 4);
+    EXPECT_EQ(charged.at("root"), 11);
+}
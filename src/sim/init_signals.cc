@@ -134,6 +134,26 @@ dumprstStatsHandler(int sigtype)
     getEventQueue(0)->wakeup();
 }
 
+/// Debug trace signal handler.
+void
+dumpTraceHandler(int sigtype)
+{
+    async_event = true;
+    async_tracedump = true;
+    /* Wake up some event queue to handle event */
+    getEventQueue(0)->wakeup();
+}
+
+/// Host memory accounting dump signal handler.
+static void
+dumpHostMemHandler(int sigtype)
+{
+    async_event = true;
+    async_hostmemdump = true;
+    /* Wake up some event queue to handle event */
+    getEventQueue(0)->wakeup();
+}
+
 /// Exit signal handler.
 void
 exitNowHandler(int sigtype)
@@ -197,6 +217,10 @@ initSignals()
     // Dump intermediate stats and reset them
     installSignalHandler(SIGUSR2, dumprstStatsHandler);
 
+    // Dump the largest host memory accounts. The simulator never uses
+    // SIGVTALRM timers, so the signal is free.
+    installSignalHandler(SIGVTALRM, dumpHostMemHandler);
+
     // Print the current cycle number and a backtrace on abort. Make
     // sure the signal is unmasked and the handler reset when a signal
     // is delivered to be able to invoke the default handler.
@@ -230,5 +254,10 @@ void restoreSigInt()
     sigaction(SIGINT, &old_int_sa, NULL);
 }
 
+void initSigHup()
+{
+    installSignalHandler(SIGHUP, dumpTraceHandler);
+}
+
 
 } // namespace gem5
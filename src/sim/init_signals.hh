@@ -36,8 +36,12 @@ void dumpStatsHandler(int sigtype);
 void dumprstStatsHandler(int sigtype);
 void exitNowHandler(int sigtype);
 void abortHandler(int sigtype);
+void dumpTraceHandler(int sigtype);
 void initSignals();
 
+// Write out the debug trace on SIGHUP, e.g. for a flight recorder
+void initSigHup();
+
 // separate out sigint handler so that we can restore the python one
 void initSigInt();
 void restoreSigInt();
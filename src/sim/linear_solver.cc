@@ -37,6 +37,12 @@
 
 #include "sim/linear_solver.hh"
 
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+#include "base/logging.hh"
+
 namespace gem5
 {
 
@@ -87,4 +93,90 @@ LinearSystem::solve() const
     return ret;
 }
 
+void
+FactorizedLinearSystem::factorize()
+{
+    // LU decomposition with partial pivoting, in place
+    std::vector <double> lu = coeffs;
+    perm.resize(order);
+    std::iota(perm.begin(), perm.end(), 0);
+
+    for (unsigned col = 0; col < order; col++) {
+        unsigned pivot = col;
+        for (unsigned row = col + 1; row < order; row++) {
+            if (std::fabs(lu[row * order + col]) >
+                    std::fabs(lu[pivot * order + col])) {
+                pivot = row;
+            }
+        }
+        panic_if(lu[pivot * order + col] == 0.0,
+                 "Singular linear system, unknown %d is free.", col);
+        if (pivot != col) {
+            std::swap_ranges(lu.begin() + pivot * order,
+                             lu.begin() + (pivot + 1) * order,
+                             lu.begin() + col * order);
+            std::swap(perm[pivot], perm[col]);
+        }
+
+        const double *pivot_row = &lu[col * order];
+        for (unsigned row = col + 1; row < order; row++) {
+            double *cur_row = &lu[row * order];
+            if (cur_row[col] == 0.0)
+                continue;
+            const double factor = cur_row[col] / pivot_row[col];
+            cur_row[col] = factor;
+            for (unsigned i = col + 1; i < order; i++)
+                cur_row[i] -= factor * pivot_row[i];
+        }
+    }
+
+    // Keep the non-zero terms only
+    lower = SparseRows();
+    upper = SparseRows();
+    invDiag.resize(order);
+    for (unsigned row = 0; row < order; row++) {
+        lower.start.push_back(lower.column.size());
+        upper.start.push_back(upper.column.size());
+        for (unsigned col = 0; col < order; col++) {
+            const double value = lu[row * order + col];
+            if (col == row) {
+                invDiag[row] = 1.0 / value;
+            } else if (value != 0.0) {
+                SparseRows &factor = col < row ? lower : upper;
+                factor.column.push_back(col);
+                factor.value.push_back(value);
+            }
+        }
+    }
+    lower.start.push_back(lower.column.size());
+    upper.start.push_back(upper.column.size());
+
+    factorized = true;
+}
+
+std::vector <double>
+FactorizedLinearSystem::solve(const std::vector <double> &cnt)
+{
+    assert(cnt.size() == order);
+    if (!factorized)
+        factorize();
+
+    // A * x = -cnt, so L * y = -P * cnt, then U * x = y
+    std::vector <double> x(order);
+    for (unsigned row = 0; row < order; row++) {
+        double sum = -cnt[perm[row]];
+        for (unsigned i = lower.start[row]; i < lower.start[row + 1]; i++)
+            sum -= lower.value[i] * x[lower.column[i]];
+        x[row] = sum;
+    }
+    for (int row = order - 1; row >= 0; row--) {
+        double sum = x[row];
+        for (unsigned i = upper.start[row]; i < upper.start[row + 1]; i++)
+            sum -= upper.value[i] * x[upper.column[i]];
+        x[row] = sum * invDiag[row];
+    }
+
+    return x;
+}
+
 } // namespace gem5
@@ -134,6 +134,69 @@ class LinearSystem
     std::vector < LinearEquation > matrix;
 };
 
+/**
+ * A linear system A * x + b = 0 solved many times with the same
+ * coefficients A, and different constant terms b. A is factorised once,
+ * the first time the system is solved after it changed, and each
+ * solution then only takes a forward and a backward substitution.
+ *
+ * The factors are kept in compressed sparse rows, so the substitutions
+ * only go through their non-zero terms, which are few for matrices such
+ * as the ones of circuits where each node is connected to a handful of
+ * others.
+ */
+class FactorizedLinearSystem
+{
+  public:
+    FactorizedLinearSystem(unsigned unknowns)
+        : order(unknowns), coeffs(unknowns * unknowns, 0.0),
+          factorized(false)
+    {}
+
+    unsigned unknowns() const { return order; }
+
+    /** Add to the coefficient of an unknown in an equation */
+    void
+    addCoeff(unsigned eq, unsigned unkw, double value)
+    {
+        assert(eq < order && unkw < order);
+        coeffs[eq * order + unkw] += value;
+        factorized = false;
+    }
+
+    /**
+     * Solve the system for a set of constant terms.
+     *
+     * @param cnt The constant term of each equation.
+     * @return The value of each unknown.
+     */
+    std::vector <double> solve(const std::vector <double> &cnt);
+
+  private:
+    /** Compressed sparse rows of one of the factors */
+    struct SparseRows
+    {
+        std::vector <unsigned> start;
+        std::vector <unsigned> column;
+        std::vector <double> value;
+    };
+
+    void factorize();
+
+    unsigned order;
+    /** Dense coefficients, row by row */
+    std::vector <double> coeffs;
+
+    bool factorized;
+    /** Row of A which became each row of the factors */
+    std::vector <unsigned> perm;
+    /** Unit lower factor, without its diagonal */
+    SparseRows lower;
+    /** Upper factor, without its diagonal, and its inverted diagonal */
+    SparseRows upper;
+    std::vector <double> invDiag;
+};
+
 } // namespace gem5
 
 #endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "sim/linear_solver.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Coefficients of a chain of resistors, as in a thermal model */
+void
+chain(unsigned n, LinearSystem &ls, FactorizedLinearSystem &fls)
+{
+    for (unsigned i = 0; i < n; i++) {
+        const double g = 1.0 + i;
+        ls[i][i] += -g - 0.5;
+        fls.addCoeff(i, i, -g - 0.5);
+        if (i + 1 < n) {
+            ls[i][i + 1] += g;
+            ls[i + 1][i] += g;
+            ls[i + 1][i + 1] += -g;
+            fls.addCoeff(i, i + 1, g);
+            fls.addCoeff(i + 1, i, g);
+            fls.addCoeff(i + 1, i + 1, -g);
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(FactorizedLinearSystemTest, MatchesGaussElimination)
+{
+    const unsigned n = 8;
+    LinearSystem ls(n);
+    FactorizedLinearSystem fls(n);
+    chain(n, ls, fls);
+
+    for (unsigned step = 0; step < 3; step++) {
+        std::vector<double> cnt(n);
+        for (unsigned i = 0; i < n; i++) {
+            cnt[i] = (i * 7 + step * 3) % 5 - 2.0;
+            ls[i][ls[i].cnt()] = cnt[i];
+        }
+
+        const std::vector<double> expected = ls.solve();
+        const std::vector<double> result = fls.solve(cnt);
+        ASSERT_EQ(n, result.size());
+        for (unsigned i = 0; i < n; i++)
+            EXPECT_NEAR(expected[i], result[i], 1e-9);
+    }
+}
+
+TEST(FactorizedLinearSystemTest, Pivoting)
+{
+    // x1 + 2 = 0, x0 + x1 - 1 = 0, which needs the rows swapped
+    FactorizedLinearSystem fls(2);
+    fls.addCoeff(0, 1, 1.0);
+    fls.addCoeff(1, 0, 1.0);
+    fls.addCoeff(1, 1, 1.0);
+
+    const std::vector<double> result = fls.solve({2.0, -1.0});
+    EXPECT_NEAR(3.0, result[0], 1e-12);
+    EXPECT_NEAR(-2.0, result[1], 1e-12);
+}
+
+TEST(FactorizedLinearSystemTest, Refactorized)
+{
+    // 2 * x0 - 4 = 0, then 4 * x0 - 4 = 0
+    FactorizedLinearSystem fls(1);
+    fls.addCoeff(0, 0, 2.0);
+    EXPECT_DOUBLE_EQ(2.0, fls.solve({-4.0})[0]);
+    fls.addCoeff(0, 0, 2.0);
+    EXPECT_DOUBLE_EQ(1.0, fls.solve({-4.0})[0]);
+}
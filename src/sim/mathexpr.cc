@@ -166,6 +166,58 @@ MathExpr::eval(const Node *n, EvalCallback fn) const {
     return 0;
 }
 
+double
+MathExpr::Program::apply(Operator op, double a, double b)
+{
+    switch (op) {
+      case bAdd:
+        return a + b;
+      case bSub:
+        return a - b;
+      case bMul:
+        return a * b;
+      case bDiv:
+        return a / b;
+      case bPow:
+        return std::pow(a, b);
+      default:
+        panic("Invalid instruction!\n");
+    }
+}
+
+MathExpr::Program
+MathExpr::compile(BindCallback bind) const
+{
+    Program prog;
+    compile(root, bind, prog, 0);
+    return prog;
+}
+
+void
+MathExpr::compile(const Node *n, BindCallback &bind, Program &prog,
+                  unsigned depth) const
+{
+    // Same results as eval(), including for missing operands
+    if (!n) {
+        prog.instrs.push_back({sValue, 0, 0});
+    } else if (n->op == sValue) {
+        prog.instrs.push_back({sValue, 0, n->value});
+    } else if (n->op == sVariable) {
+        prog.instrs.push_back({sVariable, bind(n->variable), 0});
+    } else if (n->op == uNeg) {
+        compile(n->r, bind, prog, depth);
+        prog.instrs.push_back({uNeg, 0, 0});
+        return;
+    } else {
+        panic_if(n->op == nInvalid, "Invalid node!\n");
+        compile(n->l, bind, prog, depth);
+        compile(n->r, bind, prog, depth + 1);
+        prog.instrs.push_back({n->op, 0, 0});
+        return;
+    }
+    prog.maxDepth = std::max(prog.maxDepth, depth + 1);
+}
+
 std::string
 MathExpr::toStr(Node *n, std::string prefix) const {
     std::string ret;
@@ -49,12 +49,96 @@ namespace gem5
 
 class MathExpr
 {
+  private:
+    enum Operator
+    {
+        bAdd, bSub, bMul, bDiv, bPow, uNeg, sValue, sVariable, nInvalid
+    };
+
   public:
 
     MathExpr(std::string expr);
 
     typedef std::function<double(std::string)> EvalCallback;
 
+    /**
+     * An expression flattened into a postfix program, with its variables
+     * bound to indices, so evaluating it needs neither walking a tree nor
+     * looking variables up by name.
+     */
+    class Program
+    {
+      public:
+        /**
+         * Evaluate the program.
+         *
+         * @param var Returns the value of a variable given its index.
+         *
+         * @return The value of the expression
+         */
+        template <class VarFn>
+        double
+        eval(VarFn &&var) const
+        {
+            // Programs are short, only deep ones need the heap
+            std::array<double, 32> small_stack;
+            std::vector<double> big_stack;
+            double *stack = small_stack.data();
+            if (maxDepth > small_stack.size()) {
+                big_stack.resize(maxDepth);
+                stack = big_stack.data();
+            }
+
+            unsigned top = 0;
+            for (const auto &instr: instrs) {
+                switch (instr.op) {
+                  case sValue:
+                    stack[top++] = instr.value;
+                    break;
+                  case sVariable:
+                    stack[top++] = var(instr.index);
+                    break;
+                  case uNeg:
+                    stack[top - 1] = -stack[top - 1];
+                    break;
+                  default:
+                    top--;
+                    stack[top - 1] =
+                        apply(instr.op, stack[top - 1], stack[top]);
+                    break;
+                }
+            }
+            return top ? stack[0] : 0;
+        }
+
+      private:
+        friend class MathExpr;
+
+        struct Instr
+        {
+            Operator op;
+            unsigned index;
+            double value;
+        };
+
+        static double apply(Operator op, double a, double b);
+
+        std::vector<Instr> instrs;
+        unsigned maxDepth = 0;
+    };
+
+    typedef std::function<unsigned(const std::string &)> BindCallback;
+
+    /**
+     * Compile the expression into a program.
+     *
+     * @param bind A callback giving the index the program should use for
+     * a variable.
+     *
+     * @return The compiled expression
+     */
+    Program compile(BindCallback bind) const;
+
     /**
      * Prints an ASCII representation of the expression tree
      *
@@ -88,11 +172,6 @@ class MathExpr
     }
 
   private:
-    enum Operator
-    {
-        bAdd, bSub, bMul, bDiv, bPow, uNeg, sValue, sVariable, nInvalid
-    };
-
     // Match operators
     const int MAX_PRIO = 4;
     typedef double (*binOp)(double, double);
@@ -144,6 +223,10 @@ class MathExpr
     /** Eval a node */
     double eval(const Node *n, EvalCallback fn) const;
 
+    /** Append the instructions of a node to a program */
+    void compile(const Node *n, BindCallback &bind, Program &prog,
+                 unsigned depth) const;
+
     /** Return all variable reachable from a node to a vector of
      * strings */
     void getVariables(const Node *n, std::vector<std::string> &vars) const;
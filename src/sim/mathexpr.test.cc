@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sim/mathexpr.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Check that the compiled form of an expression matches the tree one */
+void
+checkCompiled(const std::string &str, std::map<std::string, double> vars)
+{
+    MathExpr expr(str);
+    std::vector<std::string> names;
+    MathExpr::Program prog = expr.compile(
+        [&names](const std::string &name) {
+            names.push_back(name);
+            return names.size() - 1;
+        });
+
+    EXPECT_DOUBLE_EQ(
+        expr.eval([&vars](std::string name) { return vars.at(name); }),
+        prog.eval([&](unsigned index) { return vars.at(names[index]); }))
+        << str;
+}
+
+} // anonymous namespace
+
+TEST(MathExprTest, Constants)
+{
+    checkCompiled("1", {});
+    checkCompiled("1 + 2 * 3", {});
+    checkCompiled("(1 + 2) * 3 - 4 / 8", {});
+    checkCompiled("2 ^ 10", {});
+    checkCompiled("-3 + -(2 * 4)", {});
+}
+
+TEST(MathExprTest, Variables)
+{
+    std::map<std::string, double> vars = {
+        {"a", 1.5}, {"b", -2.0}, {"temp", 40.0}, {"voltage", 0.9}};
+
+    checkCompiled("a", vars);
+    checkCompiled("a * b + temp", vars);
+    checkCompiled("voltage ^ 2 * (a + b) - temp / 100", vars);
+    checkCompiled("-(a - b) * -voltage", vars);
+}
+
+TEST(MathExprTest, Deep)
+{
+    // Deep right leaning expressions need more than the inline stack
+    std::string str = "1";
+    for (int i = 0; i < 50; i++)
+        str = "x + (" + str + ")";
+    checkCompiled(str, {{"x", 0.5}});
+}
@@ -59,6 +59,8 @@ MemState::operator=(const MemState &in)
     if (this == &in)
         return *this;
 
+    std::scoped_lock guard(mutex, in.mutex);
+
     _pageBytes = in._pageBytes;
     _brkPoint = in._brkPoint;
     _stackBase = in._stackBase;
@@ -81,6 +83,7 @@ MemState::resetOwner(Process *owner)
 bool
 MemState::isUnmapped(Addr start_addr, Addr length)
 {
+    auto guard = lock();
     Addr end_addr = start_addr + length;
     const AddrRange range(start_addr, end_addr);
     for (const auto &vma : _vmaList) {
@@ -106,6 +109,7 @@ MemState::isUnmapped(Addr start_addr, Addr length)
 void
 MemState::updateBrkRegion(Addr old_brk, Addr new_brk)
 {
+    auto guard = lock();
     /**
      * The regions must be page aligned but the break point can be set on
      * byte boundaries. Ensure that the restriction is maintained here by
@@ -172,6 +176,7 @@ void
 MemState::mapRegion(Addr start_addr, Addr length,
                     const std::string& region_name, int sim_fd, Addr offset)
 {
+    auto guard = lock();
     DPRINTF(Vma, "memstate: creating vma (%s) [0x%x - 0x%x]\n",
             region_name.c_str(), start_addr, start_addr + length);
 
@@ -191,6 +196,7 @@ MemState::mapRegion(Addr start_addr, Addr length,
 void
 MemState::unmapRegion(Addr start_addr, Addr length)
 {
+    auto guard = lock();
     Addr end_addr = start_addr + length;
     const AddrRange range(start_addr, end_addr);
 
@@ -288,6 +294,7 @@ MemState::unmapRegion(Addr start_addr, Addr length)
 void
 MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
 {
+    auto guard = lock();
     Addr end_addr = start_addr + length;
     const AddrRange range(start_addr, end_addr);
 
@@ -391,6 +398,7 @@ MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
 bool
 MemState::fixupFault(Addr vaddr)
 {
+    auto guard = lock();
     /**
      * Check if we are accessing a mapped virtual address. If so then we
      * just haven't allocated it a physical page yet and can do so here.
@@ -456,6 +464,7 @@ MemState::fixupFault(Addr vaddr)
 Addr
 MemState::extendMmap(Addr length)
 {
+    auto guard = lock();
     Addr start = _mmapEnd;
 
     if (_ownerProcess->mmapGrowsDown())
@@ -484,6 +493,7 @@ MemState::extendMmap(Addr length)
 std::string
 MemState::printVmaList()
 {
+    auto guard = lock();
     std::stringstream file_content;
 
     for (auto vma : _vmaList) {
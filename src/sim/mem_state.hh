@@ -34,6 +34,7 @@
 
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -78,6 +79,18 @@ class MemState : public Serializable
      */
     void resetOwner(Process *owner);
 
+    /**
+     * The threads sharing this address space may be simulated by several
+     * event queues at once. The methods which change or look at the
+     * regions hold this lock, and a syscall which does several of them
+     * in a row holds it across all of them.
+     */
+    std::unique_lock<std::recursive_mutex>
+    lock() const
+    {
+        return std::unique_lock<std::recursive_mutex>(mutex);
+    }
+
     /**
      * Get/set base addresses and sizes for the stack and data segments of
      * the process' memory.
@@ -252,6 +265,8 @@ class MemState : public Serializable
     std::string printVmaList();
 
   private:
+    mutable std::recursive_mutex mutex;
+
     /**
      * @param
      */
@@ -71,15 +71,69 @@ MathExprPowerModel::startup()
             statsMap[var] = info;
         }
     }
+
+    // Resolve the variables once so that evaluating the expressions, done
+    // each time the power is sampled, doesn't look anything up by name.
+    auto bind_var = [this](const std::string &name) { return bind(name); };
+    dynProg = dyn_expr.compile(bind_var);
+    stProg = st_expr.compile(bind_var);
+}
+
+unsigned
+MathExprPowerModel::bind(const std::string &name)
+{
+    using namespace statistics;
+
+    const auto it = variableIndex.find(name);
+    if (it != variableIndex.end())
+        return it->second;
+
+    Variable var;
+    if (name == "temp") {
+        var.kind = Variable::Temp;
+    } else if (name == "voltage") {
+        var.kind = Variable::Voltage;
+    } else if (name == "clock_period") {
+        var.kind = Variable::ClockPeriod;
+    } else {
+        const Info *info = statsMap.at(name);
+        // Try to cast the stat, only these are supported right now
+        if ((var.scalar = dynamic_cast<const ScalarInfo *>(info)))
+            var.kind = Variable::Scalar;
+        else if ((var.formula = dynamic_cast<const FormulaInfo *>(info)))
+            var.kind = Variable::Formula;
+        else
+            panic("Unknown stat type!\n");
+    }
+
+    variables.push_back(var);
+    return variableIndex[name] = variables.size() - 1;
+}
+
+double
+MathExprPowerModel::getValue(const Variable &var) const
+{
+    switch (var.kind) {
+      case Variable::Temp:
+        return _temp.toCelsius();
+      case Variable::Voltage:
+        return clocked_object->voltage();
+      case Variable::ClockPeriod:
+        return clocked_object->clockPeriod();
+      case Variable::Scalar:
+        return var.scalar->value();
+      case Variable::Formula:
+        return var.formula->total();
+      default:
+        panic("Unknown variable kind!\n");
+    }
 }
 
 double
-MathExprPowerModel::eval(const MathExpr &expr) const
+MathExprPowerModel::eval(const MathExpr::Program &prog) const
 {
-    return expr.eval(
-        std::bind(&MathExprPowerModel::getStatValue,
-                  this, std::placeholders::_1)
-        );
+    return prog.eval(
+        [this](unsigned index) { return getValue(variables[index]); });
 }
 
 double
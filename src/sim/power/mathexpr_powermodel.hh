@@ -39,6 +39,7 @@
 #define __SIM_MATHEXPR_POWERMODEL_PM_HH__
 
 #include <unordered_map>
+#include <vector>
 
 #include "params/MathExprPowerModel.hh"
 #include "sim/mathexpr.hh"
@@ -50,6 +51,8 @@ namespace gem5
 namespace statistics
 {
     class Info;
+    class ScalarInfo;
+    class FormulaInfo;
 }
 
 /**
@@ -68,14 +71,14 @@ class MathExprPowerModel : public PowerModelState
      *
      * @return Power (Watts) consumed by this object (dynamic component)
      */
-    double getDynamicPower() const override { return eval(dyn_expr); }
+    double getDynamicPower() const override { return eval(dynProg); }
 
     /**
      * Get the static power consumption.
      *
      * @return Power (Watts) consumed by this object (static component)
      */
-    double getStaticPower() const override { return eval(st_expr); }
+    double getStaticPower() const override { return eval(stProg); }
 
     /**
      * Get the value for a variable (maps to a stat)
@@ -91,17 +94,37 @@ class MathExprPowerModel : public PowerModelState
 
   private:
     /**
-     * Evaluate an expression in the context of this object, fatal if
-     * evaluation fails.
+     * Evaluate a compiled expression in the context of this object.
      *
-     * @param expr Expression to evaluate
+     * @param prog Compiled expression to evaluate
      * @return Value of expression.
      */
-    double eval(const MathExpr &expr) const;
+    double eval(const MathExpr::Program &prog) const;
+
+    /** A variable of the expressions, resolved when compiling them */
+    struct Variable
+    {
+        enum Kind { Temp, Voltage, ClockPeriod, Scalar, Formula };
+
+        Kind kind;
+        const statistics::ScalarInfo *scalar = nullptr;
+        const statistics::FormulaInfo *formula = nullptr;
+    };
+
+    /** Get the value of a resolved variable */
+    double getValue(const Variable &var) const;
+
+    /** Resolve a variable and return its index in variables */
+    unsigned bind(const std::string &name);
 
     // Math expressions for dynamic and static power
     MathExpr dyn_expr, st_expr;
 
+    // The expressions compiled at startup, and the variables they use
+    MathExpr::Program dynProg, stProg;
+    std::vector<Variable> variables;
+    std::unordered_map<std::string, unsigned> variableIndex;
+
     // Map that contains relevant stats for this power model
     std::unordered_map<std::string, const statistics::Info*> statsMap;
 };
@@ -83,14 +83,13 @@ ThermalDomain::emitUpdate()
 }
 
 
-LinearEquation
-ThermalDomain::getEquation(ThermalNode * tn, unsigned n, double step) const
+void
+ThermalDomain::addConstants(std::vector<double> &cnt, double step) const
 {
-    LinearEquation eq(n);
+    if (node->isref)
+        return;
     double power = subsystem->getDynamicPower() + subsystem->getStaticPower();
-    if (tn == node)
-        eq[eq.cnt()] = power;
-    return eq;
+    cnt[node->id] += power;
 }
 
 } // namespace gem5
@@ -83,9 +83,9 @@ class ThermalDomain : public SimObject, public ThermalEntity
     void setNode(ThermalNode * n) { node = n; }
     ThermalNode * getNode() const { return node; }
 
-    /** Get nodal equation imposed by this node */
-    LinearEquation getEquation(ThermalNode * tn, unsigned n,
-                               double step) const override;
+    /** Add the power going into the node to its nodal equation */
+    void addConstants(std::vector<double> &cnt,
+                      double step) const override;
 
     /**
       *  Emit a temperature update through probe points interface
@@ -38,12 +38,14 @@
 #ifndef __SIM_THERMAL_ENTITY_HH__
 #define __SIM_THERMAL_ENTITY_HH__
 
+#include <vector>
+
 #include "sim/sim_object.hh"
 
 namespace gem5
 {
 
-class LinearEquation;
+class FactorizedLinearSystem;
 class ThermalNode;
 
 /**
@@ -54,9 +56,19 @@ class ThermalNode;
 class ThermalEntity
 {
   public:
-    // Get the equation given a node and a step in seconds (assuming N nodes)
-    virtual LinearEquation getEquation(ThermalNode *tn, unsigned n,
-                                       double step) const = 0;
+    /**
+     * Add the terms of the entity to the nodal equations of the nodes it
+     * is connected to, the equation of a node being indexed by its id.
+     * Only the nodes which aren't references have one.
+     *
+     * The coefficients of the unknown temperatures only depend on the
+     * step, in seconds, and are added once. The constant terms depend on
+     * the current state of the circuit and are added for every step.
+     */
+    virtual void addCoefficients(FactorizedLinearSystem &system,
+                                 double step) const {}
+    virtual void addConstants(std::vector<double> &cnt,
+                              double step) const = 0;
 };
 
 } // namespace gem5
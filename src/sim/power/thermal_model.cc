@@ -58,11 +58,10 @@ ThermalReference::ThermalReference(const Params &p)
 {
 }
 
-LinearEquation
-ThermalReference::getEquation(ThermalNode * n, unsigned nnodes,
-                              double step) const {
-    // Just return an empty equation
-    return LinearEquation(nnodes);
+void
+ThermalReference::addConstants(std::vector<double> &cnt, double step) const
+{
+    // The temperature of the node is known, it has no equation
 }
 
 /**
@@ -73,31 +72,32 @@ ThermalResistor::ThermalResistor(const Params &p)
 {
 }
 
-LinearEquation
-ThermalResistor::getEquation(ThermalNode * n, unsigned nnodes,
-                             double step) const
+void
+ThermalResistor::addCoefficients(FactorizedLinearSystem &system,
+                                 double step) const
 {
-    // i[n] = (Vn2 - Vn1)/R
-    LinearEquation eq(nnodes);
-
-    if (n != node1 && n != node2)
-        return eq;
-
-    if (node1->isref)
-        eq[eq.cnt()] += -node1->temp.toKelvin() / _resistance;
-    else
-        eq[node1->id] += -1.0f / _resistance;
-
-    if (node2->isref)
-        eq[eq.cnt()] += node2->temp.toKelvin() / _resistance;
-    else
-        eq[node2->id] += 1.0f / _resistance;
-
-    // We've assumed n was node1, reverse if necessary
-    if (n == node2)
-        eq *= -1.0f;
+    // i[n1] = (Vn2 - Vn1)/R, i[n2] = -i[n1]
+    const double g = 1.0f / _resistance;
+    if (!node1->isref) {
+        system.addCoeff(node1->id, node1->id, -g);
+        if (!node2->isref)
+            system.addCoeff(node1->id, node2->id, g);
+    }
+    if (!node2->isref) {
+        system.addCoeff(node2->id, node2->id, -g);
+        if (!node1->isref)
+            system.addCoeff(node2->id, node1->id, g);
+    }
+}
 
-    return eq;
+void
+ThermalResistor::addConstants(std::vector<double> &cnt, double step) const
+{
+    // References are the only known temperatures
+    if (!node1->isref && node2->isref)
+        cnt[node1->id] += node2->temp.toKelvin() / _resistance;
+    if (!node2->isref && node1->isref)
+        cnt[node2->id] += node1->temp.toKelvin() / _resistance;
 }
 
 /**
@@ -108,42 +108,49 @@ ThermalCapacitor::ThermalCapacitor(const Params &p)
 {
 }
 
-LinearEquation
-ThermalCapacitor::getEquation(ThermalNode * n, unsigned nnodes,
-                              double step) const
+void
+ThermalCapacitor::addCoefficients(FactorizedLinearSystem &system,
+                                  double step) const
 {
     // i(t) = C * d(Vn2 - Vn1)/dt
-    // i[n] = C/step * (Vn2 - Vn1 - Vn2[n-1] + Vn1[n-1])
-    LinearEquation eq(nnodes);
-
-    if (n != node1 && n != node2)
-        return eq;
-
-    eq[eq.cnt()] += _capacitance / step *
-        (node1->temp - node2->temp).toKelvin();
-
-    if (node1->isref)
-        eq[eq.cnt()] += _capacitance / step * (-node1->temp.toKelvin());
-    else
-        eq[node1->id] += -1.0f * _capacitance / step;
-
-    if (node2->isref)
-        eq[eq.cnt()] += _capacitance / step * (node2->temp.toKelvin());
-    else
-        eq[node2->id] += 1.0f * _capacitance / step;
-
-    // We've assumed n was node1, reverse if necessary
-    if (n == node2)
-        eq *= -1.0f;
+    // i[n1] = C/step * (Vn2 - Vn1 - Vn2[n-1] + Vn1[n-1]), i[n2] = -i[n1]
+    const double k = _capacitance / step;
+    if (!node1->isref) {
+        system.addCoeff(node1->id, node1->id, -k);
+        if (!node2->isref)
+            system.addCoeff(node1->id, node2->id, k);
+    }
+    if (!node2->isref) {
+        system.addCoeff(node2->id, node2->id, -k);
+        if (!node1->isref)
+            system.addCoeff(node2->id, node1->id, k);
+    }
+}
 
-    return eq;
+void
+ThermalCapacitor::addConstants(std::vector<double> &cnt, double step) const
+{
+    // Previous temperatures, and the temperature of references
+    const double k = _capacitance / step;
+    const double prev = k * (node1->temp - node2->temp).toKelvin();
+    if (!node1->isref) {
+        cnt[node1->id] += prev;
+        if (node2->isref)
+            cnt[node1->id] += k * node2->temp.toKelvin();
+    }
+    if (!node2->isref) {
+        cnt[node2->id] -= prev;
+        if (node1->isref)
+            cnt[node2->id] += k * node1->temp.toKelvin();
+    }
 }
 
 /**
  * ThermalModel
  */
 ThermalModel::ThermalModel(const Params &p)
-    : ClockedObject(p), stepEvent([this]{ doStep(); }, name()), _step(p.step)
+    : ClockedObject(p), system(0), stepEvent([this]{ doStep(); }, name()),
+      _step(p.step)
 {
 }
 
@@ -151,20 +158,14 @@ void
 ThermalModel::doStep()
 {
     // Calculate new temperatures!
-    // For each node in the system, create the kirchhoff nodal equation
-    LinearSystem ls(eq_nodes.size());
-    for (unsigned i = 0; i < eq_nodes.size(); i++) {
-        auto n = eq_nodes[i];
-        LinearEquation node_equation (eq_nodes.size());
-        for (auto e : entities) {
-            LinearEquation eq = e->getEquation(n, eq_nodes.size(), _step);
-            node_equation = node_equation + eq;
-        }
-        ls[i] = node_equation;
-    }
+    // The kirchhoff nodal equations only differ from one step to the next
+    // by their constant terms.
+    std::vector <double> cnt(eq_nodes.size(), 0.0);
+    for (auto e : entities)
+        e->addConstants(cnt, _step);
 
     // Get temperatures for this iteration
-    std::vector <double> temps = ls.solve();
+    std::vector <double> temps = system.solve(cnt);
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->temp = Temperature::fromKelvin(temps[i]);
 
@@ -205,6 +206,12 @@ ThermalModel::startup()
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->id = i;
 
+    // Resistances, capacitances and the step don't change, neither do the
+    // coefficients of the nodal equations.
+    system = FactorizedLinearSystem(eq_nodes.size());
+    for (auto e : entities)
+        e->addCoefficients(system, _step);
+
     // Schedule first thermal update
     schedule(stepEvent, curTick() + sim_clock::as_int::s * _step);
 }
@@ -42,6 +42,7 @@
 
 #include "base/temperature.hh"
 #include "sim/clocked_object.hh"
+#include "sim/linear_solver.hh"
 #include "sim/power/thermal_domain.hh"
 #include "sim/power/thermal_entity.hh"
 #include "sim/power/thermal_node.hh"
@@ -71,8 +72,10 @@ class ThermalResistor : public SimObject, public ThermalEntity
         node2 = n2;
     }
 
-    LinearEquation getEquation(ThermalNode * tn, unsigned n,
-                               double step) const override;
+    void addCoefficients(FactorizedLinearSystem &system,
+                         double step) const override;
+    void addConstants(std::vector<double> &cnt,
+                      double step) const override;
 
   private:
     /* Resistance value in K/W */
@@ -92,8 +95,10 @@ class ThermalCapacitor : public SimObject, public ThermalEntity
     typedef ThermalCapacitorParams Params;
     ThermalCapacitor(const Params &p);
 
-    LinearEquation getEquation(ThermalNode * tn, unsigned n,
-                               double step) const override;
+    void addCoefficients(FactorizedLinearSystem &system,
+                         double step) const override;
+    void addConstants(std::vector<double> &cnt,
+                      double step) const override;
 
     void setNodes(ThermalNode * n1, ThermalNode * n2) {
         node1 = n1;
@@ -123,8 +128,8 @@ class ThermalReference : public SimObject, public ThermalEntity
         node = n;
     }
 
-    LinearEquation getEquation(ThermalNode * tn, unsigned n,
-                               double step) const override;
+    void addConstants(std::vector<double> &cnt,
+                      double step) const override;
 
     /* Fixed temperature value */
     const Temperature _temperature;
@@ -173,6 +178,9 @@ class ThermalModel : public ClockedObject
     std::vector <ThermalNode*> nodes;
     std::vector <ThermalNode*> eq_nodes;
 
+    /** Nodal equations of eq_nodes, factorised once and for all */
+    FactorizedLinearSystem system;
+
     /** Stepping event to update the model values */
     EventFunctionWrapper stepEvent;
 
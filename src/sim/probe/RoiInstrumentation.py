@@ -0,0 +1,54 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.SimObject import SimObject
+
+
+class RoiInstrumentation(SimObject):
+    """Turns instrumentation on inside regions of interest, and off
+    outside of them, without exiting the simulation loop. The regions
+    are reported by the RegionOfInterest probe point of the sources,
+    e.g. a System for m5 work items or a PcCountTrackerManager. Regions
+    of several sources may overlap, the instrumentation is on while any
+    of them is active.
+    """
+
+    type = "RoiInstrumentation"
+    cxx_header = "sim/probe/roi_instrumentation.hh"
+    cxx_class = "gem5::RoiInstrumentation"
+
+    sources = VectorParam.SimObject(
+        "Objects whose RegionOfInterest probe points mark the regions"
+    )
+    debug_flags = VectorParam.String(
+        [], "Debug flags to enable inside the regions"
+    )
+    mem_probes = VectorParam.BaseMemProbe(
+        [], "Memory probes, e.g. MemTraceProbes, to enable inside the regions"
+    )
+    reset_stats = Param.Bool(False, "Reset the stats when entering a region")
+    dump_stats = Param.Bool(False, "Dump the stats when leaving a region")
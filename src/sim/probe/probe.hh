@@ -215,6 +215,21 @@ class ProbeListenerArgBase : public ProbeListener
         : ProbeListener(pm, name)
     {}
     virtual void notify(const Arg &val) = 0;
+
+    /**
+     * Called when the ProbePoint notifies several values at once.
+     * Listeners that can process a batch more cheaply than one value at
+     * a time should override this.
+     *
+     * @param vals the values, in the order they were produced.
+     * @param count the number of values.
+     */
+    virtual void
+    notifyBatch(const Arg *vals, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            notify(vals[i]);
+    }
 };
 
 /**
@@ -312,10 +327,48 @@ class ProbePointArg : public ProbePoint
     void
     notify(const Arg &arg)
     {
+        if (GEM5_LIKELY(listeners.empty()))
+            return;
         for (auto l = listeners.begin(); l != listeners.end(); ++l) {
             (*l)->notify(arg);
         }
     }
+
+    /**
+     * @brief Like notify(), but only builds the argument if a listener is
+     *        attached. Use this when building the argument costs more than
+     *        a check, e.g. because it copies reference counted pointers.
+     * @param make_arg a callable returning the argument to pass to each
+     *        listener. It is called at most once.
+     */
+    template <typename F>
+    void
+    notifyLazy(F &&make_arg)
+    {
+        if (GEM5_LIKELY(listeners.empty()))
+            return;
+        const Arg &arg = make_arg();
+        for (auto l = listeners.begin(); l != listeners.end(); ++l) {
+            (*l)->notify(arg);
+        }
+    }
+
+    /**
+     * @brief passes several values to each listener in one call, which
+     *        saves a virtual call per value and listener for listeners
+     *        overriding ProbeListenerArgBase::notifyBatch().
+     * @param args the values to pass, in the order they were produced.
+     * @param count the number of values.
+     */
+    void
+    notifyBatch(const Arg *args, size_t count)
+    {
+        if (GEM5_LIKELY(listeners.empty()) || count == 0)
+            return;
+        for (auto l = listeners.begin(); l != listeners.end(); ++l) {
+            (*l)->notifyBatch(args, count);
+        }
+    }
 };
 
 
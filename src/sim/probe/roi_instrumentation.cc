@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/probe/roi_instrumentation.hh"
+
+#include "base/debug.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/ProbeVerbose.hh"
+#include "mem/probes/base.hh"
+#include "params/RoiInstrumentation.hh"
+#include "sim/stat_control.hh"
+
+namespace gem5
+{
+
+RoiInstrumentation::RoiInstrumentation(const RoiInstrumentationParams &p)
+    : SimObject(p), memProbes(p.mem_probes.begin(), p.mem_probes.end()),
+      resetStats(p.reset_stats), dumpStats(p.dump_stats), depth(0)
+{
+    for (const auto &name : p.debug_flags) {
+        debug::Flag *flag = debug::findFlag(name);
+        fatal_if(!flag, "%s: Unknown debug flag '%s'.\n", this->name(),
+                 name);
+        flags.push_back(flag);
+    }
+}
+
+void
+RoiInstrumentation::init()
+{
+    SimObject::init();
+
+    // The probes attach their listeners after this, so they won't be
+    // notified of anything until a region begins.
+    for (auto *probe : memProbes)
+        probe->setEnabled(false);
+}
+
+void
+RoiInstrumentation::regProbeListeners()
+{
+    const RoiInstrumentationParams &p =
+        dynamic_cast<const RoiInstrumentationParams &>(params());
+
+    for (auto *source : p.sources) {
+        listeners.emplace_back(new ProbeListenerArgFunc<bool>(
+            source->getProbeManager(), "RegionOfInterest",
+            [this](const bool &enter) { regionOfInterest(enter); }));
+    }
+}
+
+void
+RoiInstrumentation::regionOfInterest(bool enter)
+{
+    if (enter) {
+        if (depth++ == 0)
+            instrument(true);
+    } else if (depth > 0) {
+        if (--depth == 0)
+            instrument(false);
+    }
+}
+
+void
+RoiInstrumentation::instrument(bool on)
+{
+    DPRINTF(ProbeVerbose, "%s the region of interest\n",
+            on ? "Entering" : "Leaving");
+
+    for (auto *flag : flags) {
+        if (on)
+            flag->enable();
+        else
+            flag->disable();
+    }
+
+    for (auto *probe : memProbes)
+        probe->setEnabled(on);
+
+    if (on && resetStats)
+        statistics::schedStatEvent(false, true);
+    if (!on && dumpStats)
+        statistics::schedStatEvent(true, false);
+}
+
+} // namespace gem5
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_PROBE_ROI_INSTRUMENTATION_HH__
+#define __SIM_PROBE_ROI_INSTRUMENTATION_HH__
+
+#include <memory>
+#include <vector>
+
+#include "sim/probe/probe.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class BaseMemProbe;
+struct RoiInstrumentationParams;
+
+namespace debug
+{
+class Flag;
+} // namespace debug
+
+/**
+ * Switches instrumentation on and off at the boundaries of regions of
+ * interest reported through RegionOfInterest probe points. Everything
+ * happens within the simulation loop, so short regions don't pay for
+ * an exit to Python and back.
+ */
+class RoiInstrumentation : public SimObject
+{
+  public:
+    RoiInstrumentation(const RoiInstrumentationParams &params);
+
+    void init() override;
+    void regProbeListeners() override;
+
+    /** Whether a region of interest is active */
+    bool active() const { return depth > 0; }
+
+  protected:
+    void regionOfInterest(bool enter);
+
+    /** Turn the instrumentation on or off */
+    void instrument(bool on);
+
+    std::vector<debug::Flag *> flags;
+    std::vector<BaseMemProbe *> memProbes;
+    const bool resetStats;
+    const bool dumpStats;
+
+    /** Number of regions currently active, as they may overlap */
+    unsigned depth;
+
+    std::vector<std::unique_ptr<ProbeListenerArgFunc<bool>>> listeners;
+};
+
+} // namespace gem5
+
+#endif // __SIM_PROBE_ROI_INSTRUMENTATION_HH__
@@ -518,6 +518,7 @@ workbegin(ThreadContext *tc, uint64_t workid, uint64_t threadid)
 
         uint64_t systemWorkBeginCount = sys->incWorkItemsBegin();
         int cpuId = tc->getCpuPtr()->cpuId();
+        sys->regionOfInterest(true);
 
         if (params.work_cpus_ckpt_count != 0 &&
             sys->markWorkItem(cpuId) >= params.work_cpus_ckpt_count) {
@@ -580,6 +581,7 @@ workend(ThreadContext *tc, uint64_t workid, uint64_t threadid)
 
         uint64_t systemWorkEndCount = sys->incWorkItemsEnd();
         int cpuId = tc->getCpuPtr()->cpuId();
+        sys->regionOfInterest(false);
 
         if (params.work_cpus_ckpt_count != 0 &&
             sys->markWorkItem(cpuId) >= params.work_cpus_ckpt_count) {
@@ -41,12 +41,16 @@
 
 #include "base/hostinfo.hh"
 #include "base/logging.hh"
+#include "base/output.hh"
 #include "base/trace.hh"
 #include "debug/TimeSync.hh"
 #include "sim/core.hh"
 #include "sim/cur_tick.hh"
+#include "sim/event_profile.hh"
 #include "sim/eventq.hh"
 #include "sim/full_system.hh"
+#include "sim/host_mem.hh"
+#include "sim/host_profile.hh"
 #include "sim/root.hh"
 
 namespace gem5
@@ -187,6 +191,40 @@ Root::Root(const RootParams &p, int)
     lastTime.setTimer();
 
     simQuantum = p.sim_quantum;
+    adaptiveSimQuantum = p.sim_quantum_adaptive;
+
+    for (uint32_t i = 0; i < p.eventq_backend.size(); i++) {
+        setMainEventQueueBackend(i,
+                p.eventq_backend[i] == EventQueueBackend::Calendar ?
+                    EventQueue::Backend::Calendar :
+                    EventQueue::Backend::BinList,
+                p.eventq_calendar_bucket_width, p.eventq_calendar_buckets);
+    }
+
+    if (!p.eventq_profile.empty()) {
+#if TRACING_ON
+        event_profile::enable();
+        const std::string profile_file = p.eventq_profile;
+        registerExitCallback([profile_file]() {
+            OutputStream *os = simout.create(profile_file);
+            event_profile::dump(*os->stream());
+            simout.close(os);
+        });
+#else
+        warn("Ignoring eventq_profile, this build has no tracing support.");
+#endif
+    }
+
+    if (p.host_profile_frequency) {
+#if TRACING_ON
+        fatal_if(!host_profile::enable(p.host_profile_frequency),
+                 "Could not start sampling the host time %d times a second.",
+                 p.host_profile_frequency);
+#else
+        warn("Ignoring host_profile_frequency, this build has no tracing "
+             "support.");
+#endif
+    }
 
     // Some of the statistics are global and need to be accessed by
     // stat formulas. The most convenient way to implement that is by
@@ -201,6 +239,85 @@ Root::startup()
     timeSyncEnable(params().time_sync_enable);
 }
 
+void
+Root::regStats()
+{
+    SimObject::regStats();
+
+    if (!host_profile::enabled && !params().host_memory_stats)
+        return;
+
+    // Find every SimObject in the hierarchy to give them the host stats.
+    // The stat groups of SimObjects mirror the SimObject hierarchy.
+    std::vector<SimObject *> objects = { this };
+    for (size_t i = 0; i < objects.size(); i++) {
+        for (const auto &[name, group] : objects[i]->getStatGroups()) {
+            if (auto *obj = dynamic_cast<SimObject *>(group))
+                objects.push_back(obj);
+        }
+    }
+
+    if (params().host_memory_stats) {
+        for (SimObject *obj : objects) {
+            const std::string obj_name = obj->name();
+            hostMemoryOwners.insert(obj_name);
+            auto *host_mem = new statistics::Value(obj,
+                    "hostMemoryAccounted", statistics::units::Byte::get(),
+                    "Host memory used by the structures of this object");
+            host_mem->functor([this, obj_name]() {
+                    auto it = hostMemoryBytes.find(obj_name);
+                    return it == hostMemoryBytes.end() ? 0 : it->second;
+                });
+            hostMemoryStats.emplace_back(host_mem);
+        }
+    }
+
+    if (!host_profile::enabled)
+        return;
+
+    for (SimObject *obj : objects) {
+        auto *host_time = new statistics::Value(obj, "hostTime",
+                statistics::units::Second::get(),
+                "Host CPU time spent servicing the events of this object "
+                "(sampled)");
+        const std::string obj_name = obj->name();
+        hostTimeOwners.insert(obj_name);
+        host_time->functor([this, obj_name]() {
+                auto it = hostTimeSamples.find(obj_name);
+                return it == hostTimeSamples.end() ? 0.0 :
+                    it->second * host_profile::interval();
+            })
+            .precision(3);
+        hostTimeStats.emplace_back(host_time);
+    }
+}
+
+void
+Root::resetStats()
+{
+    SimObject::resetStats();
+
+    if (host_profile::enabled)
+        host_profile::reset();
+}
+
+void
+Root::preDumpStats()
+{
+    SimObject::preDumpStats();
+
+    if (params().host_memory_stats) {
+        hostMemoryBytes = host_profile::attribute(host_mem::usage(),
+                                                  hostMemoryOwners, name());
+    }
+
+    if (!host_profile::enabled)
+        return;
+
+    hostTimeSamples = host_profile::attribute(host_profile::samples(),
+                                              hostTimeOwners, name());
+}
+
 void
 Root::serialize(CheckpointOut &cp) const
 {
@@ -51,6 +51,12 @@
 #ifndef __SIM_ROOT_HH__
 #define __SIM_ROOT_HH__
 
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
 #include "base/statistics.hh"
 #include "base/time.hh"
 #include "base/types.hh"
@@ -80,6 +86,20 @@ class Root : public SimObject
     void timeSync();
     EventFunctionWrapper syncEvent;
 
+    /** The hostTime stat of each SimObject, when host profiling. */
+    std::vector<std::unique_ptr<statistics::Value>> hostTimeStats;
+    /** The names of the SimObjects host profile samples go to. */
+    std::set<std::string> hostTimeOwners;
+    /** Host profile samples by SimObject name, as of the last dump. */
+    std::map<std::string, uint64_t> hostTimeSamples;
+
+    /** The hostMemoryAccounted stat of each SimObject, when enabled. */
+    std::vector<std::unique_ptr<statistics::Value>> hostMemoryStats;
+    /** The names of the SimObjects host memory is charged to. */
+    std::set<std::string> hostMemoryOwners;
+    /** Accounted host memory by SimObject name, as of the last dump. */
+    std::map<std::string, uint64_t> hostMemoryBytes;
+
   public:
     /**
      * Use this function to get a pointer to the single Root object in the
@@ -148,6 +168,10 @@ class Root : public SimObject
      */
     void startup() override;
 
+    void regStats() override;
+    void resetStats() override;
+    void preDumpStats() override;
+
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 };
@@ -74,18 +74,21 @@ SEWorkload::syscall(ThreadContext *tc)
 Addr
 SEWorkload::allocPhysPages(int npages, int pool_id)
 {
+    std::lock_guard<std::mutex> guard(memPoolsMutex);
     return memPools.allocPhysPages(npages, pool_id);
 }
 
 Addr
 SEWorkload::memSize(int pool_id) const
 {
+    std::lock_guard<std::mutex> guard(memPoolsMutex);
     return memPools.memSize(pool_id);
 }
 
 Addr
 SEWorkload::freeMemSize(int pool_id) const
 {
+    std::lock_guard<std::mutex> guard(memPoolsMutex);
     return memPools.freeMemSize(pool_id);
 }
 
@@ -28,6 +28,8 @@
 #ifndef __SIM_SE_WORKLOAD_HH__
 #define __SIM_SE_WORKLOAD_HH__
 
+#include <mutex>
+
 #include "params/SEWorkload.hh"
 #include "sim/mem_pool.hh"
 #include "sim/workload.hh"
@@ -40,6 +42,8 @@ class SEWorkload : public Workload
   protected:
     /** Memory allocation objects for all physical memories in the system. */
     MemPools memPools;
+    /** The processes may allocate from several event queues at once. */
+    mutable std::mutex memPoolsMutex;
 
   public:
     using Params = SEWorkloadParams;
@@ -43,13 +43,16 @@
 #include "sim/simulate.hh"
 
 #include <atomic>
+#include <iostream>
 #include <thread>
 
 #include "base/logging.hh"
 #include "base/pollevent.hh"
+#include "base/trace.hh"
 #include "base/types.hh"
 #include "sim/async.hh"
 #include "sim/eventq.hh"
+#include "sim/host_mem.hh"
 #include "sim/init_signals.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
@@ -317,6 +320,16 @@ doSimLoop(EventQueue *eventq)
                 pollQueue.service();
             }
 
+            if (async_tracedump) {
+                async_tracedump = false;
+                trace::getDebugLogger()->flush();
+            }
+
+            if (async_hostmemdump) {
+                async_hostmemdump = false;
+                host_mem::dump(std::cerr);
+            }
+
             if (async_exit) {
                 async_exit = false;
                 exitSimLoop("user interrupt received");
@@ -93,23 +93,53 @@ ignoreWarnOnceFunc(SyscallDesc *desc, ThreadContext *tc)
 static void
 exitFutexWake(ThreadContext *tc, VPtr<> addr, uint64_t tgid)
 {
+    FutexMap &futex_map = tc->getSystemPtr()->futexMap;
+    auto futex_guard = futex_map.lock();
+
     // Clear value at address pointed to by thread's childClearTID field.
     BufferArg ctidBuf(addr, sizeof(long));
     long *ctid = (long *)ctidBuf.bufferPtr();
     *ctid = 0;
     ctidBuf.copyOut(SETranslatingPortProxy(tc));
 
-    FutexMap &futex_map = tc->getSystemPtr()->futexMap;
     // Wake one of the waiting threads.
     futex_map.wakeup(addr, tgid, 1);
 }
 
+/**
+ * Exit the simulation loop if no thread of any system is running anymore.
+ */
+static void
+exitIfLastThread(int status)
+{
+    int activeContexts = 0;
+    for (auto &system: System::systemList)
+        activeContexts += system->threads.numRunning();
+
+    if (activeContexts == 0) {
+        /**
+         * Even though we are terminating the final thread context, dist-gem5
+         * requires the simulation to remain active and provide
+         * synchronization messages to the switch process. So we just halt
+         * the last thread context and return. The simulation will be
+         * terminated by dist-gem5 in a coordinated manner once all nodes
+         * have signaled their readiness to exit. For non dist-gem5
+         * simulations, readyToExit() always returns true.
+         */
+        if (!DistIface::readyToExit(0))
+            return;
+
+        exitSimLoop("exiting with last active thread context", status & 0xff);
+    }
+}
+
 static SyscallReturn
 exitImpl(SyscallDesc *desc, ThreadContext *tc, bool group, int status)
 {
     auto p = tc->getProcessPtr();
 
     System *sys = tc->getSystemPtr();
+    std::lock_guard<std::recursive_mutex> process_guard(sys->processLock);
 
     if (group)
         *p->exitGroup = true;
@@ -157,7 +187,10 @@ exitImpl(SyscallDesc *desc, ThreadContext *tc, bool group, int status)
                  * all threads in the group.
                  */
                 if (*(p->exitGroup)) {
-                    tc->halt();
+                    // If the thread is halted later, in its own event
+                    // queue, it may be the one to end the simulation.
+                    tc->haltFromAnyQueue(
+                        [status]() { exitIfLastThread(status); });
                 } else {
                     last_thread = false;
                 }
@@ -201,7 +234,7 @@ exitImpl(SyscallDesc *desc, ThreadContext *tc, bool group, int status)
     if (!p->vforkContexts.empty()) {
         ThreadContext *vtc = sys->threads[p->vforkContexts.front()];
         assert(vtc->status() == ThreadContext::Suspended);
-        vtc->activate();
+        vtc->activateFromAnyQueue();
     }
 
     tc->halt();
@@ -210,27 +243,7 @@ exitImpl(SyscallDesc *desc, ThreadContext *tc, bool group, int status)
      * check to see if there is no more active thread in the system. If so,
      * exit the simulation loop
      */
-    int activeContexts = 0;
-    for (auto &system: sys->systemList)
-        activeContexts += system->threads.numRunning();
-
-    if (activeContexts == 0) {
-        /**
-         * Even though we are terminating the final thread context, dist-gem5
-         * requires the simulation to remain active and provide
-         * synchronization messages to the switch process. So we just halt
-         * the last thread context and return. The simulation will be
-         * terminated by dist-gem5 in a coordinated manner once all nodes
-         * have signaled their readiness to exit. For non dist-gem5
-         * simulations, readyToExit() always returns true.
-         */
-        if (!DistIface::readyToExit(0)) {
-            return status;
-        }
-
-        exitSimLoop("exiting with last active thread context", status & 0xff);
-        return status;
-    }
+    exitIfLastThread(status);
 
     return status;
 }
@@ -261,6 +274,7 @@ brkFunc(SyscallDesc *desc, ThreadContext *tc, VPtr<> new_brk)
     auto p = tc->getProcessPtr();
 
     std::shared_ptr<MemState> mem_state = p->memState;
+    auto mem_guard = mem_state->lock();
     Addr brk_point = mem_state->getBrkPoint();
 
     // in Linux at least, brk(0) returns the current break value
@@ -395,6 +395,10 @@ futexFunc(SyscallDesc *desc, ThreadContext *tc,
     op &= ~OS::TGT_FUTEX_CLOCK_REALTIME_FLAG;
 
     FutexMap &futex_map = tc->getSystemPtr()->futexMap;
+    // Threads of other event queues may use the futexes at the same
+    // time. Keep the checks of the futex words and what is done because
+    // of them together.
+    auto futex_guard = futex_map.lock();
 
     if (OS::TGT_FUTEX_WAIT == op || OS::TGT_FUTEX_WAIT_BITSET == op) {
         // Ensure futex system call accessed atomically.
@@ -1274,6 +1278,8 @@ pollFunc(SyscallDesc *desc, ThreadContext *tc,
              * to return the signal interrupt instead.
              */
             System *sysh = tc->getSystemPtr();
+            std::lock_guard<std::recursive_mutex> process_guard(
+                    sysh->processLock);
             std::list<BasicSignal>::iterator it;
             for (it=sysh->signalList.begin(); it!=sysh->signalList.end(); it++)
                 if (it->receiver == p)
@@ -1346,6 +1352,8 @@ mremapFunc(SyscallDesc *desc, ThreadContext *tc,
 
     new_length = roundUp(new_length, page_bytes);
 
+    auto mem_guard = p->memState->lock();
+
     if (new_length > old_length) {
         Addr mmap_end = p->memState->getMmapEnd();
 
@@ -1717,6 +1725,9 @@ doClone(SyscallDesc *desc, ThreadContext *tc, RegVal flags, RegVal newStack,
         ((flags & OS::TGT_CLONE_VM)     && !(newStack)))
         return -EINVAL;
 
+    std::lock_guard<std::recursive_mutex> process_guard(
+            tc->getSystemPtr()->processLock);
+
     ThreadContext *ctc;
     if (!(ctc = tc->getSystemPtr()->threads.findFree())) {
         DPRINTF_SYSCALL(Verbose, "clone: no spare thread context in system"
@@ -1807,7 +1818,7 @@ doClone(SyscallDesc *desc, ThreadContext *tc, RegVal flags, RegVal newStack,
 
     desc->returnInto(ctc, 0);
 
-    ctc->activate();
+    ctc->activateFromAnyQueue();
 
     if (flags & OS::TGT_CLONE_VFORK) {
         tc->suspend();
@@ -1873,6 +1884,28 @@ fstatfsFunc(SyscallDesc *desc, ThreadContext *tc,
     return 0;
 }
 
+/**
+ * Find the host memory behind all the buffers of a target iovec array.
+ * @return Whether all of them can be accessed in place.
+ */
+template <class OS>
+bool
+mapDirectIovecs(const SETranslatingPortProxy &prox,
+        const typename OS::tgt_iovec *tiov, typename OS::size_t count,
+        bool write, std::vector<struct iovec> &iov)
+{
+    for (typename OS::size_t i = 0; i < count; ++i) {
+        const uint64_t len = gtoh(tiov[i].iov_len, OS::byteOrder);
+        if (len == 0)
+            continue;
+        DirectBufferArg buf(gtoh(tiov[i].iov_base, OS::byteOrder), len);
+        if (!buf.map(prox, write))
+            return false;
+        iov.insert(iov.end(), buf.iovecs().begin(), buf.iovecs().end());
+    }
+    return true;
+}
+
 /// Target readv() handler.
 template <class OS>
 SyscallReturn
@@ -1889,10 +1922,23 @@ readvFunc(SyscallDesc *desc, ThreadContext *tc,
 
     SETranslatingPortProxy prox(tc);
     typename OS::tgt_iovec tiov[count];
-    struct iovec hiov[count];
     for (typename OS::size_t i = 0; i < count; ++i) {
         prox.readBlob(tiov_base + (i * sizeof(typename OS::tgt_iovec)),
                       &tiov[i], sizeof(typename OS::tgt_iovec));
+    }
+
+    // Read straight into target memory if all of it can be reached.
+    std::vector<struct iovec> direct_iov;
+    if (mapDirectIovecs<OS>(prox, tiov, count, true, direct_iov)) {
+        ssize_t result = DirectBufferArg::transfer(direct_iov,
+            [sim_fd](const struct iovec *iov, int iovcnt, ssize_t) {
+                return readv(sim_fd, iov, iovcnt);
+            });
+        return (result == -1) ? -errno : result;
+    }
+
+    struct iovec hiov[count];
+    for (typename OS::size_t i = 0; i < count; ++i) {
         hiov[i].iov_len = gtoh(tiov[i].iov_len, OS::byteOrder);
         hiov[i].iov_base = new char [hiov[i].iov_len];
     }
@@ -1926,16 +1972,28 @@ writevFunc(SyscallDesc *desc, ThreadContext *tc,
     int sim_fd = hbfdp->getSimFD();
 
     SETranslatingPortProxy prox(tc);
-    struct iovec hiov[count];
+    typename OS::tgt_iovec tiov[count];
     for (typename OS::size_t i = 0; i < count; ++i) {
-        typename OS::tgt_iovec tiov;
-
         prox.readBlob(tiov_base + i*sizeof(typename OS::tgt_iovec),
-                      &tiov, sizeof(typename OS::tgt_iovec));
-        hiov[i].iov_len = gtoh(tiov.iov_len, OS::byteOrder);
+                      &tiov[i], sizeof(typename OS::tgt_iovec));
+    }
+
+    // Write straight from target memory if all of it can be reached.
+    std::vector<struct iovec> direct_iov;
+    if (mapDirectIovecs<OS>(prox, tiov, count, false, direct_iov)) {
+        ssize_t result = DirectBufferArg::transfer(direct_iov,
+            [sim_fd](const struct iovec *iov, int iovcnt, ssize_t) {
+                return writev(sim_fd, iov, iovcnt);
+            });
+        return (result == -1) ? -errno : result;
+    }
+
+    struct iovec hiov[count];
+    for (typename OS::size_t i = 0; i < count; ++i) {
+        hiov[i].iov_len = gtoh(tiov[i].iov_len, OS::byteOrder);
         hiov[i].iov_base = new char [hiov[i].iov_len];
-        prox.readBlob(gtoh(tiov.iov_base, OS::byteOrder), hiov[i].iov_base,
-                      hiov[i].iov_len);
+        prox.readBlob(gtoh(tiov[i].iov_base, OS::byteOrder),
+                      hiov[i].iov_base, hiov[i].iov_len);
     }
 
     int result = writev(sim_fd, hiov, count);
@@ -2033,6 +2091,9 @@ mmapFunc(SyscallDesc *desc, ThreadContext *tc,
         }
     }
 
+    // Find and map the region in one step.
+    auto mem_guard = p->memState->lock();
+
     /**
      * Not TGT_MAP_FIXED means we can start wherever we want.
      */
@@ -2101,11 +2162,21 @@ pread64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
-    BufferArg bufArg(bufPtr, nbytes);
+    int bytes_read;
+    DirectBufferArg direct_arg(bufPtr, nbytes);
+    if (nbytes > 0 && direct_arg.map(SETranslatingPortProxy(tc), true)) {
+        bytes_read = direct_arg.transfer(
+            [sim_fd, offset](const struct iovec *iov, int iovcnt,
+                    ssize_t done) {
+                return preadv(sim_fd, iov, iovcnt, offset + done);
+            });
+    } else {
+        BufferArg bufArg(bufPtr, nbytes);
 
-    int bytes_read = pread(sim_fd, bufArg.bufferPtr(), nbytes, offset);
+        bytes_read = pread(sim_fd, bufArg.bufferPtr(), nbytes, offset);
 
-    bufArg.copyOut(SETranslatingPortProxy(tc));
+        bufArg.copyOut(SETranslatingPortProxy(tc));
+    }
 
     return (bytes_read == -1) ? -errno : bytes_read;
 }
@@ -2122,10 +2193,20 @@ pwrite64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
-    BufferArg bufArg(bufPtr, nbytes);
-    bufArg.copyIn(SETranslatingPortProxy(tc));
+    int bytes_written;
+    DirectBufferArg direct_arg(bufPtr, nbytes);
+    if (nbytes > 0 && direct_arg.map(SETranslatingPortProxy(tc), false)) {
+        bytes_written = direct_arg.transfer(
+            [sim_fd, offset](const struct iovec *iov, int iovcnt,
+                    ssize_t done) {
+                return pwritev(sim_fd, iov, iovcnt, offset + done);
+            });
+    } else {
+        BufferArg bufArg(bufPtr, nbytes);
+        bufArg.copyIn(SETranslatingPortProxy(tc));
 
-    int bytes_written = pwrite(sim_fd, bufArg.bufferPtr(), nbytes, offset);
+        bytes_written = pwrite(sim_fd, bufArg.bufferPtr(), nbytes, offset);
+    }
 
     return (bytes_written == -1) ? -errno : bytes_written;
 }
@@ -2334,7 +2415,7 @@ execveFunc(SyscallDesc *desc, ThreadContext *tc,
     if (!p->vforkContexts.empty()) {
         ThreadContext *vtc = p->system->threads[p->vforkContexts.front()];
         assert(vtc->status() == ThreadContext::Suspended);
-        vtc->activate();
+        vtc->activateFromAnyQueue();
     }
 
     /**
@@ -2698,6 +2779,8 @@ selectFunc(SyscallDesc *desc, ThreadContext *tc, int nfds,
              * signal would break the poll out of the retry cycle and try to
              * return the signal interrupt instead.
              */
+            std::lock_guard<std::recursive_mutex> process_guard(
+                    tc->getSystemPtr()->processLock);
             for (auto sig : tc->getSystemPtr()->signalList)
                 if (sig.receiver == p)
                     return -EINTR;
@@ -2762,11 +2845,20 @@ readFunc(SyscallDesc *desc, ThreadContext *tc,
         && !(hbfdp->getFlags() & OS::TGT_O_NONBLOCK))
         return SyscallReturn::retry();
 
-    BufferArg buf_arg(buf_ptr, nbytes);
-    int bytes_read = read(sim_fd, buf_arg.bufferPtr(), nbytes);
+    int bytes_read;
+    DirectBufferArg direct_arg(buf_ptr, nbytes);
+    if (nbytes > 0 && direct_arg.map(SETranslatingPortProxy(tc), true)) {
+        bytes_read = direct_arg.transfer(
+            [sim_fd](const struct iovec *iov, int iovcnt, ssize_t) {
+                return readv(sim_fd, iov, iovcnt);
+            });
+    } else {
+        BufferArg buf_arg(buf_ptr, nbytes);
+        bytes_read = read(sim_fd, buf_arg.bufferPtr(), nbytes);
 
-    if (bytes_read > 0)
-        buf_arg.copyOut(SETranslatingPortProxy(tc));
+        if (bytes_read > 0)
+            buf_arg.copyOut(SETranslatingPortProxy(tc));
+    }
 
     return (bytes_read == -1) ? -errno : bytes_read;
 }
@@ -2783,8 +2875,12 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = hbfdp->getSimFD();
 
-    BufferArg buf_arg(buf_ptr, nbytes);
-    buf_arg.copyIn(SETranslatingPortProxy(tc));
+    DirectBufferArg direct_arg(buf_ptr, nbytes);
+    const bool direct =
+        nbytes > 0 && direct_arg.map(SETranslatingPortProxy(tc), false);
+    BufferArg buf_arg(buf_ptr, direct ? 0 : nbytes);
+    if (!direct)
+        buf_arg.copyIn(SETranslatingPortProxy(tc));
 
     struct pollfd pfd;
     pfd.fd = sim_fd;
@@ -2802,7 +2898,15 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
             return SyscallReturn::retry();
     }
 
-    int bytes_written = write(sim_fd, buf_arg.bufferPtr(), nbytes);
+    int bytes_written;
+    if (direct) {
+        bytes_written = direct_arg.transfer(
+            [sim_fd](const struct iovec *iov, int iovcnt, ssize_t) {
+                return writev(sim_fd, iov, iovcnt);
+            });
+    } else {
+        bytes_written = write(sim_fd, buf_arg.bufferPtr(), nbytes);
+    }
 
     if (bytes_written != -1)
         fsync(sim_fd);
@@ -2831,6 +2935,7 @@ wait4Func(SyscallDesc *desc, ThreadContext *tc,
      * call.
      */
     System *sysh = tc->getSystemPtr();
+    std::lock_guard<std::recursive_mutex> process_guard(sysh->processLock);
     std::list<BasicSignal>::iterator iter;
     for (iter=sysh->signalList.begin(); iter!=sysh->signalList.end(); iter++) {
         if (iter->receiver == p) {
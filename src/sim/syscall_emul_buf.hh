@@ -35,7 +35,13 @@
 /// This file defines buffer classes used to handle pointer arguments
 /// in emulated syscalls.
 
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <climits>
 #include <cstring>
+#include <vector>
 
 #include "base/types.hh"
 #include "mem/se_translating_port_proxy.hh"
@@ -168,6 +174,69 @@ class TypedBufferArg : public BaseBufferArg
     T &operator[](int i) { return ((T *)bufPtr)[i]; }
 };
 
+/**
+ * DirectBufferArg represents a buffer in target user space which the
+ * host reads or writes in place, when memory hands out back doors to it,
+ * instead of going through a copy in simulator space.
+ */
+class DirectBufferArg
+{
+  public:
+    DirectBufferArg(Addr _addr, uint64_t _size) : addr(_addr), size(_size) {}
+
+    /**
+     * Find the host memory behind the buffer.
+     * @param write Whether the buffer will be written.
+     * @return Whether the buffer can be accessed in place.
+     */
+    bool
+    map(const TranslatingPortProxy &memproxy, bool write)
+    {
+        return memproxy.tryHostIovecs(addr, size,
+                write ? BaseMMU::Write : BaseMMU::Read, iov);
+    }
+
+    /** The host memory behind the buffer, once mapped */
+    const std::vector<struct iovec> &iovecs() const { return iov; }
+
+    /**
+     * Move data in or out of host memory with a function like readv(),
+     * giving it at most IOV_MAX pieces at a time.
+     * @param op Called with the pieces, how many there are and how many
+     *        bytes were moved before them. Returns what readv() would.
+     * @return The number of bytes moved, or what op returned if it failed
+     *         before moving anything.
+     */
+    template <class Op>
+    static ssize_t
+    transfer(const std::vector<struct iovec> &iov, Op op)
+    {
+        ssize_t done = 0;
+        for (size_t first = 0; first < iov.size(); first += IOV_MAX) {
+            const int count = std::min<size_t>(iov.size() - first, IOV_MAX);
+            ssize_t wanted = 0;
+            for (int i = 0; i < count; i++)
+                wanted += iov[first + i].iov_len;
+
+            const ssize_t ret = op(&iov[first], count, done);
+            if (ret < 0)
+                return done ? done : ret;
+            done += ret;
+            if (ret < wanted)
+                break;
+        }
+        return done;
+    }
+
+    template <class Op>
+    ssize_t transfer(Op op) const { return transfer(iov, op); }
+
+  private:
+    const Addr addr;
+    const uint64_t size;
+    std::vector<struct iovec> iov;
+};
+
 } // namespace gem5
 
 #endif // __SIM_SYSCALL_EMUL_BUF_HH__
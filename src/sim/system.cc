@@ -59,6 +59,7 @@
 #include "params/System.hh"
 #include "sim/byteswap.hh"
 #include "sim/debug.hh"
+#include "sim/probe/probe.hh"
 #include "sim/redirect_path.hh"
 #include "sim/serialize_handlers.hh"
 
@@ -171,7 +172,9 @@ System::System(const Params &p)
       physProxy(_systemPort, p.cache_line_size),
       workload(p.workload),
       physmem(name() + ".physmem", p.memories, p.mmap_using_noreserve,
-              p.shared_backstore, p.auto_unlink_shared_backstore),
+              p.shared_backstore, p.auto_unlink_shared_backstore,
+              p.memory_checkpoint_format, p.checkpoint_threads,
+              p.incremental_checkpoints, p.mmap_huge_pages),
       ShadowRomRanges(p.shadow_rom_ranges.begin(),
                       p.shadow_rom_ranges.end()),
       memoryMode(p.mem_mode),
@@ -390,6 +393,21 @@ System::workItemEnd(uint32_t tid, uint32_t workid)
     lastWorkItemStarted.erase(p);
 }
 
+void
+System::regionOfInterest(bool enter)
+{
+    if (ppRegionOfInterest)
+        ppRegionOfInterest->notify(enter);
+}
+
+void
+System::regProbePoints()
+{
+    SimObject::regProbePoints();
+    ppRegionOfInterest = new ProbePointArg<bool>(getProbeManager(),
+                                                 "RegionOfInterest");
+}
+
 bool
 System::trapToGdb(GDBSignal signal, ContextID ctx_id) const
 {
@@ -42,6 +42,7 @@
 #ifndef __SYSTEM_HH__
 #define __SYSTEM_HH__
 
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -69,6 +70,7 @@ namespace gem5
 
 class BaseRemoteGDB;
 class KvmVM;
+template <typename Arg> class ProbePointArg;
 class ThreadContext;
 
 class System : public SimObject, public PCEventScope
@@ -550,6 +552,16 @@ class System : public SimObject, public PCEventScope
 
     void workItemEnd(uint32_t tid, uint32_t workid);
 
+    /**
+     * Called by pseudo_inst when a tracked work item begins or ends, to
+     * notify the listeners of the RegionOfInterest probe point.
+     *
+     * @param enter Whether the work item begins.
+     */
+    void regionOfInterest(bool enter);
+
+    void regProbePoints() override;
+
     /* Returns whether we successfully trapped into GDB. */
     bool trapToGdb(GDBSignal signal, ContextID ctx_id) const;
 
@@ -584,6 +596,9 @@ class System : public SimObject, public PCEventScope
     std::map<std::pair<uint32_t, uint32_t>, Tick>  lastWorkItemStarted;
     std::map<uint32_t, statistics::Histogram*> workItemStats;
 
+    /** Notified with true when a work item begins, false when it ends */
+    ProbePointArg<bool> *ppRegionOfInterest = nullptr;
+
     ////////////////////////////////////////////
     //
     // STATIC GLOBAL SYSTEM LIST
@@ -597,6 +612,13 @@ class System : public SimObject, public PCEventScope
 
     FutexMap futexMap;
 
+    /**
+     * Held by syscall emulation while it looks at or changes the
+     * processes and threads of the system, the PIDs in use and the
+     * signals, which threads of several event queues may do at once.
+     */
+    std::recursive_mutex processLock;
+
     static const int maxPID = 32768;
 
     /** Process set to track which PIDs have already been allocated */
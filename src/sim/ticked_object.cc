@@ -60,13 +60,38 @@ Ticked::Ticked(ClockedObject &object_,
 void
 Ticked::processClockEvent() {
     ++tickCycles;
-    ++numCycles;
-    countCycles(Cycles(1));
+    if (running) {
+        ++numCycles;
+        countCycles(Cycles(1));
+    } else {
+        // Woken up by wakeupAt(), account for the cycles slept through
+        // (which are idle cycles) and for this one in one go.
+        Cycles delta = cyclesSinceLastStopped();
+        running = true;
+        numCycles += delta;
+        countCycles(delta);
+    }
     evaluate();
     if (running)
         object.schedule(event, object.clockEdge(Cycles(1)));
 }
 
+void
+Ticked::wakeupAt(Tick when)
+{
+    if (running)
+        return;
+
+    Tick edge = object.clockEdge();
+    if (when > edge)
+        edge += object.cyclesToTicks(object.ticksToCycles(when - edge));
+
+    if (!event.scheduled())
+        object.schedule(event, edge);
+    else if (event.when() > edge)
+        object.reschedule(event, edge);
+}
+
 void
 Ticked::regStats()
 {
@@ -57,7 +57,15 @@ struct TickedObjectParams;
  *  calls and provides a start/stop interface to ticking.
  *
  *  Ticked is not a ClockedObject but can be attached to one by
- *  inheritance and by calling regStats, serialize/unserialize */
+ *  inheritance and by calling regStats, serialize/unserialize
+ *
+ *  An object that finds nothing to do in evaluate() can call stop() to
+ *  go quiescent instead of ticking through empty cycles. Whatever can
+ *  give it work again (a port receive function, a Ruby MessageBuffer
+ *  through ruby::TickedConsumer, another object) then calls wakeup()
+ *  or wakeupAt(), which restart ticking from the first clock edge at
+ *  or after the given tick. The skipped cycles are accounted as idle
+ *  cycles and reported to countCycles() in one go. */
 class Ticked : public Serializable
 {
   protected:
@@ -106,8 +114,11 @@ class Ticked : public Serializable
     start()
     {
         if (!running) {
+            Tick next = object.clockEdge(Cycles(1));
             if (!event.scheduled())
-                object.schedule(event, object.clockEdge(Cycles(1)));
+                object.schedule(event, next);
+            else if (event.when() > next)
+                object.reschedule(event, next);
             running = true;
             numCycles += cyclesSinceLastStopped();
             countCycles(cyclesSinceLastStopped());
@@ -128,18 +139,32 @@ class Ticked : public Serializable
         lastStopped = object.curCycle();
     }
 
-    /** Cancel the next tick event and issue no more */
+    /** Cancel the next tick event (or pending wakeup) and issue no more */
     void
     stop()
     {
+        if (event.scheduled())
+            object.deschedule(event);
         if (running) {
-            if (event.scheduled())
-                object.deschedule(event);
             running = false;
             resetLastStopped();
         }
     }
 
+    /**
+     * Resume ticking at the first clock edge at or after the given
+     * tick, unless the object is running already or has been woken up
+     * for an earlier edge. Unlike start(), the cycles until then are
+     * still accounted as stopped.
+     */
+    void wakeupAt(Tick when);
+
+    /** Resume ticking at the next clock edge. */
+    void wakeup() { wakeupAt(object.clockEdge(Cycles(1))); }
+
+    /** Is the object ticking, as opposed to stopped or sleeping? */
+    bool isRunning() const { return running; }
+
     /** Checkpoint lastStopped */
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
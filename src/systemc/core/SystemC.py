@@ -23,6 +23,7 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+from m5.params import *
 from m5.SimObject import (
     SimObject,
     cxxMethod,
@@ -37,6 +38,12 @@ class SystemC_Kernel(SimObject):
     cxx_class = "sc_gem5::Kernel"
     cxx_header = "systemc/core/kernel.hh"
 
+    tlm_quantum = Param.Latency(
+        "0ns",
+        "Global quantum of TLM loosely timed models, if not set by the "
+        "models themselves. Zero to use sim_quantum.",
+    )
+
 
 # This class represents systemc sc_object instances in python config files. It
 # inherits from SimObject in python, but the c++ version, sc_core::sc_object,
@@ -28,11 +28,13 @@
 #include "systemc/core/kernel.hh"
 
 #include "base/logging.hh"
+#include "sim/eventq.hh"
 #include "systemc/core/channel.hh"
 #include "systemc/core/module.hh"
 #include "systemc/core/port.hh"
 #include "systemc/core/sc_main_fiber.hh"
 #include "systemc/core/scheduler.hh"
+#include "systemc/ext/tlm_core/2/quantum/global_quantum.hh"
 
 namespace sc_gem5
 {
@@ -56,7 +58,8 @@ void Kernel::status(sc_core::sc_status s) { _status = s; }
 
 Kernel::Kernel(const Params &params, int) :
     gem5::SimObject(params),
-    t0Event(*this, false, gem5::EventBase::Default_Pri - 1)
+    t0Event(*this, false, gem5::EventBase::Default_Pri - 1),
+    tlmQuantum(params.tlm_quantum)
 {
     // Install ourselves as the scheduler's event manager.
     ::sc_gem5::scheduler.setEventQueue(eventQueue());
@@ -71,6 +74,14 @@ Kernel::init()
     if (stopAfterCallbacks)
         fatal("Simulation called sc_stop during elaboration.\n");
 
+    // Unless sc_main chose a quantum, let quantum keepers run ahead of
+    // gem5 as far as the event queues of a parallel simulation can.
+    auto &quantum = tlm::tlm_global_quantum::instance();
+    const gem5::Tick quantum_ticks = tlmQuantum ? tlmQuantum :
+        gem5::simQuantum;
+    if (quantum.get() == sc_core::SC_ZERO_TIME && quantum_ticks)
+        quantum.set(sc_core::sc_time::from_value(quantum_ticks));
+
     status(::sc_core::SC_BEFORE_END_OF_ELABORATION);
     for (auto p: allPorts)
         p->sc_port_base()->before_end_of_elaboration();
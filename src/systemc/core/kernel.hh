@@ -66,6 +66,9 @@ class Kernel : public gem5::SimObject
     static void stopWork();
 
     gem5::MemberEventWrapper<&Kernel::t0Handler> t0Event;
+
+    /** Quantum LT models may run ahead of gem5 by, if they set none */
+    gem5::Tick tlmQuantum;
 };
 
 extern Kernel *kernel;
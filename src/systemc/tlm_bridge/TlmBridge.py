@@ -56,6 +56,17 @@ class TlmToGem5BridgeBase(SystemC_ScModule):
 
     gem5 = RequestPort("gem5 request port")
 
+    direct_b_transport = Param.Bool(
+        False,
+        "Serve b_transport calls hitting a backdoor the bridge was given "
+        "by accessing it directly, without sending a packet",
+    )
+    backdoor_latency = Param.Latency(
+        "0ns",
+        "Latency of accesses through backdoors, from b_transport calls or "
+        "through DMI",
+    )
+
 
 class Gem5ToTlmBridge32(Gem5ToTlmBridgeBase):
     type = "Gem5ToTlmBridge32"
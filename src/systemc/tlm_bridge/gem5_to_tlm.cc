@@ -148,7 +148,8 @@ packet2payload(PacketPtr packet)
         return trans;
     }
 
-    trans = mm.allocate();
+    // The packet pointer is attached to the TLM transaction to keep track.
+    trans = mm.allocate(packet);
     trans->acquire();
 
     trans->set_address(packet->getAddr());
@@ -175,10 +176,6 @@ packet2payload(PacketPtr packet)
         trans->set_command(tlm::TLM_IGNORE_COMMAND);
     }
 
-    // Attach the packet pointer to the TLM transaction to keep track.
-    auto *extension = new Gem5SystemC::Gem5Extension(packet);
-    trans->set_auto_extension(extension);
-
     if (packet->isAtomicOp()) {
         auto *atomic_ex = new Gem5SystemC::AtomicExtension(
             std::shared_ptr<AtomicOpFunctor>(
@@ -232,7 +229,7 @@ Gem5ToTlmBridge<BITWIDTH>::pec(
         }
     }
     if (phase == tlm::BEGIN_RESP) {
-        PacketPtr packet = packetMap[&trans];
+        PacketPtr packet = getPacket(trans);
 
         sc_assert(!blockingResponse);
         sc_assert(packet);
@@ -259,13 +256,46 @@ Gem5ToTlmBridge<BITWIDTH>::pec(
                 sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
                 socket->nb_transport_fw(trans, fw_phase, delay);
                 // Release the transaction with all the extensions.
-                packetMap.erase(&trans);
+                releasePacket(trans);
                 trans.release();
             }
         }
     }
 }
 
+template <unsigned int BITWIDTH>
+void
+Gem5ToTlmBridge<BITWIDTH>::trackPacket(
+        tlm::tlm_generic_payload &trans, PacketPtr packet)
+{
+    Gem5SystemC::Gem5Extension *extension = nullptr;
+    trans.get_extension(extension);
+    if (!extension)
+        packetMap.emplace(&trans, packet);
+}
+
+template <unsigned int BITWIDTH>
+PacketPtr
+Gem5ToTlmBridge<BITWIDTH>::getPacket(tlm::tlm_generic_payload &trans)
+{
+    Gem5SystemC::Gem5Extension *extension = nullptr;
+    trans.get_extension(extension);
+    if (extension)
+        return extension->getPacket();
+    auto it = packetMap.find(&trans);
+    return it == packetMap.end() ? nullptr : it->second;
+}
+
+template <unsigned int BITWIDTH>
+void
+Gem5ToTlmBridge<BITWIDTH>::releasePacket(tlm::tlm_generic_payload &trans)
+{
+    Gem5SystemC::Gem5Extension *extension = nullptr;
+    trans.get_extension(extension);
+    if (!extension)
+        packetMap.erase(&trans);
+}
+
 template <unsigned int BITWIDTH>
 MemBackdoorPtr
 Gem5ToTlmBridge<BITWIDTH>::getBackdoor(tlm::tlm_generic_payload &trans)
@@ -435,13 +465,13 @@ Gem5ToTlmBridge<BITWIDTH>::recvTimingReq(PacketPtr packet)
         sc_assert(phase == tlm::BEGIN_REQ);
         // Accepted but is now blocking until END_REQ (exclusion rule).
         blockingRequest = trans;
-        packetMap.emplace(trans, packet);
+        trackPacket(*trans, packet);
     } else if (status == tlm::TLM_UPDATED) {
         // The Timing annotation must be honored:
         sc_assert(phase == tlm::END_REQ || phase == tlm::BEGIN_RESP);
         // Accepted but is now blocking until END_REQ (exclusion rule).
         blockingRequest = trans;
-        packetMap.emplace(trans, packet);
+        trackPacket(*trans, packet);
         auto cb = [this, trans, phase]() { pec(*trans, phase); };
         auto event = new EventFunctionWrapper(
                 cb, "pec", true, getPriorityOfTlmPhase(phase));
@@ -482,7 +512,7 @@ Gem5ToTlmBridge<BITWIDTH>::recvRespRetry()
     tlm::tlm_generic_payload *trans = blockingResponse;
     blockingResponse = nullptr;
 
-    PacketPtr packet = packetMap[trans];
+    PacketPtr packet = getPacket(*trans);
     sc_assert(packet);
 
     bool need_retry = !bridgeResponsePort.sendTimingResp(packet);
@@ -493,7 +523,7 @@ Gem5ToTlmBridge<BITWIDTH>::recvRespRetry()
     tlm::tlm_phase phase = tlm::END_RESP;
     socket->nb_transport_fw(*trans, phase, delay);
     // Release transaction with all the extensions
-    packetMap.erase(trans);
+    releasePacket(*trans);
     trans->release();
 }
 
@@ -175,8 +175,10 @@ class Gem5ToTlmBridge : public Gem5ToTlmBridgeBase
     tlm::tlm_generic_payload *blockingResponse;
 
     /**
-     * A map to record the association between payload and packet. This helps us
-     * could get the correct packet when handling nonblocking interfaces.
+     * A map to record the association between payload and packet for the
+     * payloads which came from the TLM world and have no Gem5Extension to
+     * hold it. This helps us get the correct packet when handling
+     * nonblocking interfaces.
      */
     std::unordered_map<tlm::tlm_generic_payload *, gem5::PacketPtr> packetMap;
 
@@ -185,6 +187,11 @@ class Gem5ToTlmBridge : public Gem5ToTlmBridgeBase
   protected:
     void pec(tlm::tlm_generic_payload &trans, const tlm::tlm_phase &phase);
 
+    /** Remember, find and forget the packet of an outstanding payload */
+    void trackPacket(tlm::tlm_generic_payload &trans, gem5::PacketPtr packet);
+    gem5::PacketPtr getPacket(tlm::tlm_generic_payload &trans);
+    void releasePacket(tlm::tlm_generic_payload &trans);
+
     gem5::MemBackdoorPtr getBackdoor(tlm::tlm_generic_payload &trans);
     gem5::AddrRangeMap<gem5::MemBackdoorPtr> backdoorMap;
 
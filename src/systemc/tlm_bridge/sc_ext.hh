@@ -64,6 +64,7 @@ class Gem5Extension: public tlm::tlm_extension<Gem5Extension>
     static Gem5Extension &getExtension(
             const tlm::tlm_generic_payload &payload);
     gem5::PacketPtr getPacket();
+    void setPacket(gem5::PacketPtr p);
 
   private:
     gem5::PacketPtr packet;
@@ -43,6 +43,8 @@ MemoryManager::~MemoryManager()
         delete payload;
         numberOfFrees++;
     }
+    for (Gem5Extension *extension: freeExtensions)
+        delete extension;
 }
 
 gp *
@@ -58,10 +60,35 @@ MemoryManager::allocate()
     }
 }
 
+gp *
+MemoryManager::allocate(gem5::PacketPtr packet)
+{
+    gp *payload = allocate();
+    Gem5Extension *extension;
+    if (freeExtensions.empty()) {
+        extension = new Gem5Extension(packet);
+    } else {
+        extension = freeExtensions.back();
+        freeExtensions.pop_back();
+        extension->setPacket(packet);
+    }
+    payload->set_extension(extension);
+    return payload;
+}
+
 void
 MemoryManager::free(gp *payload)
 {
     payload->reset(); // clears all extensions
+
+    // Pooled extensions are not automatic ones, take them back
+    Gem5Extension *extension = nullptr;
+    payload->get_extension(extension);
+    if (extension) {
+        payload->clear_extension(extension);
+        freeExtensions.push_back(extension);
+    }
+
     freePayloads.push_back(payload);
 }
 
@@ -35,13 +35,19 @@
 
 #include <vector>
 
+#include "mem/packet.hh"
 #include "systemc/ext/tlm_core/2/generic_payload/gp.hh"
+#include "systemc/tlm_bridge/sc_ext.hh"
 
 namespace Gem5SystemC
 {
 
 typedef tlm::tlm_generic_payload gp;
 
+/**
+ * Pool of payloads, and of the Gem5Extensions tying them to the packets
+ * they were created for, so neither is allocated for every transaction.
+ */
 class MemoryManager : public tlm::tlm_mm_interface
 {
   public:
@@ -50,10 +56,17 @@ class MemoryManager : public tlm::tlm_mm_interface
     virtual gp *allocate();
     virtual void free(gp *payload);
 
+    /**
+     * Allocate a payload with a Gem5Extension holding a packet. The
+     * extension goes back to the pool when the payload is freed.
+     */
+    gp *allocate(gem5::PacketPtr packet);
+
   private:
     unsigned int numberOfAllocations;
     unsigned int numberOfFrees;
     std::vector<gp *> freePayloads;
+    std::vector<Gem5Extension *> freeExtensions;
 };
 
 } // namespace Gem5SystemC
@@ -57,6 +57,7 @@
 
 #include "systemc/tlm_bridge/tlm_to_gem5.hh"
 
+#include <cstring>
 #include <utility>
 
 #include "base/trace.hh"
@@ -138,7 +139,7 @@ payload2packet(RequestorID _id, tlm::tlm_generic_payload &trans)
         AtomicOpFunctorPtr amo_op = AtomicOpFunctorPtr(
             atomic_ex->getAtomicOpFunctor()->clone());
         // FIXME: correct the context_id and pc state.
-        req = std::make_shared<Request>(
+        req = makeRequest(
             trans.get_address(), trans.get_data_length(), flags, _id,
             0, 0, std::move(amo_op));
         req->setPaddr(trans.get_address());
@@ -158,7 +159,7 @@ payload2packet(RequestorID _id, tlm::tlm_generic_payload &trans)
                             "command");
         }
         Request::Flags flags;
-        req = std::make_shared<Request>(
+        req = makeRequest(
             trans.get_address(), trans.get_data_length(), flags, _id);
     }
 
@@ -207,25 +208,7 @@ void
 TlmToGem5Bridge<BITWIDTH>::sendBeginResp(tlm::tlm_generic_payload &trans,
                                          sc_core::sc_time &delay)
 {
-    MemBackdoor::Flags flags;
-    switch (trans.get_command()) {
-      case tlm::TLM_READ_COMMAND:
-        flags = MemBackdoor::Readable;
-        break;
-      case tlm::TLM_WRITE_COMMAND:
-        flags = MemBackdoor::Writeable;
-        break;
-      default:
-        panic("TlmToGem5Bridge: "
-                "received transaction with unsupported command");
-    }
-    Addr start_addr = trans.get_address();
-    Addr length = trans.get_data_length();
-
-    MemBackdoorReq req({start_addr, start_addr + length}, flags);
-    MemBackdoorPtr backdoor = nullptr;
-
-    bmp.sendMemBackdoorReq(req, backdoor);
+    MemBackdoorPtr backdoor = getBackdoor(trans);
 
     if (backdoor)
         trans.set_dmi_allowed(true);
@@ -317,6 +300,42 @@ TlmToGem5Bridge<BITWIDTH>::cacheBackdoor(gem5::MemBackdoorPtr backdoor)
     }
 }
 
+template <unsigned int BITWIDTH>
+MemBackdoorPtr
+TlmToGem5Bridge<BITWIDTH>::getBackdoor(tlm::tlm_generic_payload &trans)
+{
+    MemBackdoor::Flags flags;
+    switch (trans.get_command()) {
+      case tlm::TLM_READ_COMMAND:
+        flags = MemBackdoor::Readable;
+        break;
+      case tlm::TLM_WRITE_COMMAND:
+        flags = MemBackdoor::Writeable;
+        break;
+      default:
+        panic("TlmToGem5Bridge: "
+                "received transaction with unsupported command");
+    }
+    Addr start_addr = trans.get_address();
+    Addr length = trans.get_data_length();
+
+    MemBackdoorReq req({start_addr, start_addr + length}, flags);
+
+    // Look for a backdoor we were given before and which is still valid,
+    // as every response asks for one to set the DMI hint.
+    for (auto backdoor: requestedBackdoors) {
+        if (req.range().isSubset(backdoor->range()) &&
+                (backdoor->flags() & flags) == flags) {
+            return backdoor;
+        }
+    }
+
+    MemBackdoorPtr backdoor = nullptr;
+    bmp.sendMemBackdoorReq(req, backdoor);
+    cacheBackdoor(backdoor);
+    return backdoor;
+}
+
 template <unsigned int BITWIDTH>
 void
 TlmToGem5Bridge<BITWIDTH>::invalidateDmi(const gem5::MemBackdoor &backdoor)
@@ -369,11 +388,57 @@ TlmToGem5Bridge<BITWIDTH>::nb_transport_fw(
     return tlm::TLM_ACCEPTED;
 }
 
+template <unsigned int BITWIDTH>
+bool
+TlmToGem5Bridge<BITWIDTH>::backdoorTransport(tlm::tlm_generic_payload &trans,
+                                             sc_core::sc_time &t)
+{
+    // Only plain accesses, which a packet would carry nothing more for.
+    const auto cmd = trans.get_command();
+    if ((cmd != tlm::TLM_READ_COMMAND && cmd != tlm::TLM_WRITE_COMMAND) ||
+            trans.get_byte_enable_ptr() ||
+            trans.get_streaming_width() < trans.get_data_length()) {
+        return false;
+    }
+    Gem5SystemC::Gem5Extension *extension = nullptr;
+    trans.get_extension(extension);
+    Gem5SystemC::AtomicExtension *atomic_ex = nullptr;
+    trans.get_extension(atomic_ex);
+    if (extension || atomic_ex)
+        return false;
+
+    const bool write = cmd == tlm::TLM_WRITE_COMMAND;
+    const Addr start = trans.get_address();
+    const Addr length = trans.get_data_length();
+    const AddrRange range(start, start + length);
+    for (auto backdoor: requestedBackdoors) {
+        if (!range.isSubset(backdoor->range()) ||
+                !(write ? backdoor->writeable() : backdoor->readable())) {
+            continue;
+        }
+
+        uint8_t *ptr = backdoor->ptr() + (start - backdoor->range().start());
+        if (write)
+            std::memcpy(ptr, trans.get_data_ptr(), length);
+        else
+            std::memcpy(trans.get_data_ptr(), ptr, length);
+
+        trans.set_dmi_allowed(true);
+        trans.set_response_status(tlm::TLM_OK_RESPONSE);
+        t += sc_core::sc_time::from_value(backdoorLatency);
+        return true;
+    }
+    return false;
+}
+
 template <unsigned int BITWIDTH>
 void
 TlmToGem5Bridge<BITWIDTH>::b_transport(tlm::tlm_generic_payload &trans,
                                        sc_core::sc_time &t)
 {
+    if (directBTransport && backdoorTransport(trans, t))
+        return;
+
     auto [pkt, pkt_created] = payload2packet(_id, trans);
     pkt->pushSenderState(new Gem5SystemC::TlmSenderState(trans));
 
@@ -455,25 +520,7 @@ bool
 TlmToGem5Bridge<BITWIDTH>::get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
                                               tlm::tlm_dmi &dmi_data)
 {
-    MemBackdoor::Flags flags;
-    switch (trans.get_command()) {
-      case tlm::TLM_READ_COMMAND:
-        flags = MemBackdoor::Readable;
-        break;
-      case tlm::TLM_WRITE_COMMAND:
-        flags = MemBackdoor::Writeable;
-        break;
-      default:
-        panic("TlmToGem5Bridge: "
-                "received transaction with unsupported command");
-    }
-    Addr start_addr = trans.get_address();
-    Addr length = trans.get_data_length();
-
-    MemBackdoorReq req({start_addr, start_addr + length}, flags);
-    MemBackdoorPtr backdoor = nullptr;
-
-    bmp.sendMemBackdoorReq(req, backdoor);
+    MemBackdoorPtr backdoor = getBackdoor(trans);
 
     if (backdoor) {
         trans.set_dmi_allowed(true);
@@ -488,7 +535,10 @@ TlmToGem5Bridge<BITWIDTH>::get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
         if (backdoor->writeable())
             access = (access_t)(access | tlm::tlm_dmi::DMI_ACCESS_WRITE);
         dmi_data.set_granted_access(access);
-        cacheBackdoor(backdoor);
+        dmi_data.set_read_latency(
+                sc_core::sc_time::from_value(backdoorLatency));
+        dmi_data.set_write_latency(
+                sc_core::sc_time::from_value(backdoorLatency));
     }
 
     trans.set_response_status(tlm::TLM_OK_RESPONSE);
@@ -601,6 +651,8 @@ TlmToGem5Bridge<BITWIDTH>::TlmToGem5Bridge(
     bmp(std::string(name()) + "master", *this), socket("tlm_socket"),
     wrapper(socket, std::string(name()) + ".tlm", InvalidPortID),
     system(params.system),
+    directBTransport(params.direct_b_transport),
+    backdoorLatency(params.backdoor_latency),
     _id(params.system->getGlobalRequestorId(
                 std::string("[systemc].") + name()))
 {
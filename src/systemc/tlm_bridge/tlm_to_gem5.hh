@@ -132,6 +132,10 @@ class TlmToGem5Bridge : public TlmToGem5BridgeBase
 
     gem5::System *system;
 
+    /** Serve b_transport calls through known backdoors when possible */
+    const bool directBTransport;
+    const gem5::Tick backdoorLatency;
+
     void sendEndReq(tlm::tlm_generic_payload &trans);
     void sendBeginResp(tlm::tlm_generic_payload &trans,
                        sc_core::sc_time &delay);
@@ -145,6 +149,21 @@ class TlmToGem5Bridge : public TlmToGem5BridgeBase
 
     void cacheBackdoor(gem5::MemBackdoorPtr backdoor);
 
+    /**
+     * Find a backdoor for the range and command of a transaction, either
+     * among the ones already requested or by asking the gem5 side.
+     */
+    gem5::MemBackdoorPtr getBackdoor(tlm::tlm_generic_payload &trans);
+
+    /**
+     * Complete a b_transport call by accessing a backdoor we were given
+     * before, as a DMI capable initiator would, if there is one for it.
+     *
+     * @return Whether the transaction was completed.
+     */
+    bool backdoorTransport(tlm::tlm_generic_payload &trans,
+                           sc_core::sc_time &t);
+
   protected:
     // payload event call back
     void peq_cb(tlm::tlm_generic_payload &trans, const tlm::tlm_phase &phase);
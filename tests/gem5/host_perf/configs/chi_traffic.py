@@ -0,0 +1,92 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+The Ruby CHI workload of the host-performance benchmarks: 16 random
+traffic generators sharing memory through the CHI protocol's private L1
+cache hierarchy.
+"""
+
+import argparse
+
+import m5
+from m5.objects import Root
+
+from gem5.coherence_protocol import CoherenceProtocol
+from gem5.components.boards.test_board import TestBoard
+from gem5.components.cachehierarchies.chi.private_l1_cache_hierarchy import (
+    PrivateL1CacheHierarchy,
+)
+from gem5.components.memory import DualChannelDDR4_2400
+from gem5.components.processors.random_generator import RandomGenerator
+from gem5.utils.requires import requires
+
+parser = argparse.ArgumentParser(
+    description="The Ruby CHI workload of the host-performance benchmarks."
+)
+
+parser.add_argument(
+    "--num-cores",
+    type=int,
+    default=16,
+    help="The number of traffic generators.",
+)
+
+parser.add_argument(
+    "--duration",
+    type=str,
+    default="100us",
+    help="How long, in simulated time, to generate traffic for.",
+)
+
+args = parser.parse_args()
+
+requires(coherence_protocol_required=CoherenceProtocol.CHI)
+
+memory = DualChannelDDR4_2400(size="1GiB")
+
+generator = RandomGenerator(
+    duration=args.duration,
+    rate="40GB/s",
+    num_cores=args.num_cores,
+    max_addr=memory.get_size(),
+)
+
+board = TestBoard(
+    clk_freq="3GHz",
+    generator=generator,
+    memory=memory,
+    cache_hierarchy=PrivateL1CacheHierarchy(size="32KiB", assoc=8),
+)
+
+root = Root(full_system=False, system=board)
+
+board._pre_instantiate()
+m5.instantiate()
+
+generator.start_traffic()
+exit_event = m5.simulate()
+print(f"Exiting @ tick {m5.curTick()} because {exit_event.getCause()}.")
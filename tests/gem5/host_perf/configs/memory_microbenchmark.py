@@ -0,0 +1,257 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+"""
+The memory-system microbenchmarks of the host-performance benchmarks: a
+traffic generator driving one memory-system component, with everything
+around it kept as cheap as possible, so the host time measured is mostly
+spent in that component.
+
+The components are:
+
+* `mem-ctrl`: a DDR4 MemCtrl, with no caches;
+* `hbm-ctrl`: an HBM2 stack of HBMCtrls, with no caches;
+* `xbar`: the CoherentXBar shared by several generators, with no caches,
+  in front of a SimpleMemory;
+* `cache`: classic private L1 caches in front of a SimpleMemory, with the
+  replacement policy given by `--replacement-policy` and optionally the
+  compressor given by `--compressor`;
+* `ruby-mesi`: the Ruby MESI_Two_Level hierarchy in front of a
+  SimpleMemory;
+* `ruby-chi`: the Ruby CHI private L1 hierarchy in front of a SimpleMemory.
+
+The requests the generators sent are counted by their `numPackets` stat,
+or by the `totalReads` and `totalWrites` stats of the GUPS generator.
+"""
+
+import argparse
+
+import m5
+from m5.objects import (
+    CompressedTags,
+    Root,
+)
+from m5.params import NULL
+from m5.util.convert import toMemorySize
+
+from gem5.coherence_protocol import CoherenceProtocol
+from gem5.components.boards.test_board import TestBoard
+from gem5.components.cachehierarchies.classic.no_cache import NoCache
+from gem5.components.memory import (
+    HBM2Stack,
+    SingleChannelDDR4_2400,
+)
+from gem5.components.memory.simple import SingleChannelSimpleMemory
+from gem5.components.processors.gups_generator import GUPSGenerator
+from gem5.components.processors.gups_generator_ep import GUPSGeneratorEP
+from gem5.components.processors.linear_generator import LinearGenerator
+from gem5.components.processors.random_generator import RandomGenerator
+from gem5.utils.requires import requires
+
+parser = argparse.ArgumentParser(
+    description="The memory-system microbenchmarks of the host-performance "
+    "benchmarks."
+)
+
+parser.add_argument(
+    "component",
+    type=str,
+    choices=[
+        "mem-ctrl",
+        "hbm-ctrl",
+        "xbar",
+        "cache",
+        "ruby-mesi",
+        "ruby-chi",
+    ],
+    help="The memory-system component to benchmark.",
+)
+
+parser.add_argument(
+    "--generator",
+    type=str,
+    choices=["linear", "random", "gups"],
+    default="random",
+    help="The traffic pattern.",
+)
+
+parser.add_argument(
+    "--num-cores",
+    type=int,
+    default=1,
+    help="The number of traffic generators.",
+)
+
+parser.add_argument(
+    "--duration",
+    type=str,
+    default="100us",
+    help="How long, in simulated time, the linear and random generators "
+    "generate traffic for.",
+)
+
+parser.add_argument(
+    "--updates",
+    type=int,
+    default=100000,
+    help="The number of updates each GUPS generator makes.",
+)
+
+parser.add_argument(
+    "--rd-perc",
+    type=int,
+    default=70,
+    help="The percentage of reads the linear and random generators send.",
+)
+
+parser.add_argument(
+    "--working-set",
+    type=str,
+    default="1GiB",
+    help="The size of the memory the generators address.",
+)
+
+parser.add_argument(
+    "--replacement-policy",
+    type=str,
+    default="LRURP",
+    help="The replacement policy of the caches of the cache component.",
+)
+
+parser.add_argument(
+    "--compressor",
+    type=str,
+    default=None,
+    help="The compressor of the caches of the cache component. The caches "
+    "are not compressed when this is not given.",
+)
+
+args = parser.parse_args()
+
+
+def simple_memory():
+    # Cheap enough to keep the memory out of the measurements of the
+    # components in front of it.
+    return SingleChannelSimpleMemory(
+        latency="30ns", latency_var="0ns", bandwidth="64GiB/s", size="1GiB"
+    )
+
+
+if args.component == "mem-ctrl":
+    memory = SingleChannelDDR4_2400(size="1GiB")
+elif args.component == "hbm-ctrl":
+    memory = HBM2Stack(size="1GiB")
+else:
+    memory = simple_memory()
+
+if args.component == "cache":
+    from gem5.components.cachehierarchies.classic.private_l1_cache_hierarchy import (
+        PrivateL1CacheHierarchy,
+    )
+
+    cache_hierarchy = PrivateL1CacheHierarchy(
+        l1d_size="32KiB", l1i_size="32KiB"
+    )
+elif args.component == "ruby-mesi":
+    requires(coherence_protocol_required=CoherenceProtocol.MESI_TWO_LEVEL)
+    from gem5.components.cachehierarchies.ruby.mesi_two_level_cache_hierarchy import (
+        MESITwoLevelCacheHierarchy,
+    )
+
+    cache_hierarchy = MESITwoLevelCacheHierarchy(
+        l1i_size="32KiB",
+        l1i_assoc=8,
+        l1d_size="32KiB",
+        l1d_assoc=8,
+        l2_size="256KiB",
+        l2_assoc=16,
+        num_l2_banks=1,
+    )
+elif args.component == "ruby-chi":
+    requires(coherence_protocol_required=CoherenceProtocol.CHI)
+    from gem5.components.cachehierarchies.chi.private_l1_cache_hierarchy import (
+        PrivateL1CacheHierarchy,
+    )
+
+    cache_hierarchy = PrivateL1CacheHierarchy(size="32KiB", assoc=8)
+else:
+    cache_hierarchy = NoCache()
+
+working_set = min(toMemorySize(args.working_set), memory.get_size())
+
+if args.generator == "gups":
+    if args.num_cores == 1:
+        generator = GUPSGenerator(
+            start_addr=0, mem_size=working_set, update_limit=args.updates
+        )
+    else:
+        generator = GUPSGeneratorEP(
+            num_cores=args.num_cores,
+            start_addr=0,
+            mem_size=working_set,
+            update_limit=args.updates,
+        )
+else:
+    generator_class = {
+        "linear": LinearGenerator,
+        "random": RandomGenerator,
+    }[args.generator]
+    generator = generator_class(
+        num_cores=args.num_cores,
+        duration=args.duration,
+        rate="40GB/s",
+        max_addr=working_set,
+        rd_perc=args.rd_perc,
+    )
+
+board = TestBoard(
+    clk_freq="3GHz",
+    generator=generator,
+    memory=memory,
+    cache_hierarchy=cache_hierarchy,
+)
+
+root = Root(full_system=False, system=board)
+
+board._pre_instantiate()
+
+if args.component == "cache":
+    for cache in cache_hierarchy.l1dcaches:
+        # The prefetcher would only add work around the tags.
+        cache.prefetcher = NULL
+        cache.replacement_policy = getattr(
+            m5.objects, args.replacement_policy
+        )()
+        if args.compressor is not None:
+            cache.compressor = getattr(m5.objects, args.compressor)()
+            cache.tags = CompressedTags()
+
+m5.instantiate()
+
+generator.start_traffic()
+exit_event = m5.simulate()
+print(f"Exiting @ tick {m5.curTick()} because {exit_event.getCause()}.")
@@ -0,0 +1,361 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+A wrapper which runs another gem5 configuration script and reports how fast
+gem5 itself ran it. The wrapped script is run unmodified:
+
+```
+gem5 run_benchmark.py [--report host_perf.json] <config> [config args...]
+```
+
+When the wrapped script exits, a JSON report is written to the output
+directory containing:
+
+* the host wall-clock time and peak resident set size;
+* the simulated instructions and the host time per simulated instruction;
+* the host instructions retired, when the host exposes the
+  `perf_event_open` instruction counter to this process;
+* the number of events serviced and the event rate;
+* the host time spent servicing the events of each SimObject;
+* the simulated requests, and the host time and events per request, when
+  the stats counting them are given with `--request-stat`.
+
+The event counts and the per-component times come from the Root's
+`eventq_profile`, which needs a build with tracing support (gem5.opt or
+gem5.debug). With gem5.fast, or when `--no-event-profile` is given, those
+fields are left out of the report.
+"""
+
+import argparse
+import atexit
+import ctypes
+import json
+import os
+import platform
+import re
+import resource
+import runpy
+import sys
+import time
+from collections import defaultdict
+from typing import (
+    Dict,
+    Iterator,
+    Optional,
+    Tuple,
+)
+
+import _m5.stats
+import m5
+import m5.simulate
+from m5.objects import Root
+
+parser = argparse.ArgumentParser(
+    description="Run a gem5 configuration script and report the host "
+    "performance of the simulation."
+)
+
+parser.add_argument(
+    "--report",
+    type=str,
+    default="host_perf.json",
+    help="The file, in the output directory, to write the report to.",
+)
+
+parser.add_argument(
+    "--no-event-profile",
+    action="store_true",
+    help="Do not profile the event queue. This removes the profiling "
+    "overhead from the host time, at the cost of not reporting events/sec "
+    "or the per-component host time.",
+)
+
+parser.add_argument(
+    "--component-depth",
+    type=int,
+    default=3,
+    help="The number of levels of the SimObject hierarchy the per-component "
+    "host time is rolled up to.",
+)
+
+parser.add_argument(
+    "--request-stat",
+    type=str,
+    action="append",
+    default=[],
+    help="A regular expression matching the full names of the stats which "
+    "count the requests simulated, e.g. "
+    r"'system\.processor\.cores\d*\.generator\.numPackets'. The totals of "
+    "all the matching stats are summed. May be given more than once.",
+)
+
+parser.add_argument(
+    "config", type=str, help="The gem5 configuration script to benchmark."
+)
+
+parser.add_argument(
+    "config_args",
+    nargs=argparse.REMAINDER,
+    help="The arguments passed to the configuration script.",
+)
+
+args = parser.parse_args()
+
+_profile_file = "host_perf_eventq.json"
+
+
+class _HostInstructionCounter:
+    """
+    Counts the user-space instructions retired by this process using the
+    Linux `perf_event_open` system call. If the counter cannot be opened
+    (not Linux, an unknown host architecture, or a restrictive
+    `perf_event_paranoid` setting) `read()` returns None.
+    """
+
+    # The perf_event_open system call number for each host architecture.
+    _syscall_numbers = {"x86_64": 298, "aarch64": 241, "riscv64": 241}
+
+    # The leading fields of `struct perf_event_attr`. The kernel accepts
+    # this, the original (PERF_ATTR_SIZE_VER0) layout.
+    class _Attr(ctypes.Structure):
+        _fields_ = [
+            ("type", ctypes.c_uint32),
+            ("size", ctypes.c_uint32),
+            ("config", ctypes.c_uint64),
+            ("sample_period", ctypes.c_uint64),
+            ("sample_type", ctypes.c_uint64),
+            ("read_format", ctypes.c_uint64),
+            ("flags", ctypes.c_uint64),
+            ("wakeup_events", ctypes.c_uint32),
+            ("bp_type", ctypes.c_uint32),
+            ("config1", ctypes.c_uint64),
+        ]
+
+    _PERF_TYPE_HARDWARE = 0
+    _PERF_COUNT_HW_INSTRUCTIONS = 1
+    _EXCLUDE_KERNEL = 1 << 5
+    _EXCLUDE_HV = 1 << 6
+
+    def __init__(self):
+        self._fd = -1
+        syscall_number = self._syscall_numbers.get(platform.machine())
+        if platform.system() != "Linux" or syscall_number is None:
+            return
+
+        attr = self._Attr()
+        attr.type = self._PERF_TYPE_HARDWARE
+        attr.size = ctypes.sizeof(attr)
+        attr.config = self._PERF_COUNT_HW_INSTRUCTIONS
+        attr.flags = self._EXCLUDE_KERNEL | self._EXCLUDE_HV
+
+        libc = ctypes.CDLL(None, use_errno=True)
+        libc.syscall.restype = ctypes.c_long
+        self._fd = libc.syscall(
+            ctypes.c_long(syscall_number),
+            ctypes.byref(attr),
+            ctypes.c_int(0),  # This process...
+            ctypes.c_int(-1),  # ...on any CPU.
+            ctypes.c_int(-1),  # No event group.
+            ctypes.c_ulong(0),
+        )
+
+    def read(self) -> Optional[int]:
+        if self._fd < 0:
+            return None
+        return int.from_bytes(os.read(self._fd, 8), sys.byteorder)
+
+
+class _Benchmark:
+    def __init__(self):
+        self._start_time = None
+        self._counter = None
+        self._start_instructions = None
+
+    def start(self) -> None:
+        self._counter = _HostInstructionCounter()
+        self._start_instructions = self._counter.read()
+        self._start_time = time.perf_counter()
+
+    def _sim_stat(self, name: str) -> Optional[float]:
+        info = Root.getInstance().resolveStat(name)
+        return None if info is None else info.total
+
+    def _all_stats(self) -> Iterator[Tuple[str, object]]:
+        """
+        Every stat, with its full name. The stats of the stat groups are
+        named by their path from the Root, the legacy stats registered
+        outside of a group are already named in full.
+        """
+
+        def visit(path, group):
+            for stat in group.getStats():
+                yield path + stat.name, stat
+            for name, child in group.getStatGroups().items():
+                yield from visit(f"{path}{name}.", child)
+
+        yield from visit("", Root.getInstance())
+        for stat in _m5.stats.statsList():
+            yield stat.name, stat
+
+    def _sim_requests(self) -> Optional[float]:
+        if not args.request_stat:
+            return None
+        patterns = [re.compile(pattern) for pattern in args.request_stat]
+        requests = None
+        for name, stat in self._all_stats():
+            total = getattr(stat, "total", None)
+            if total is None:
+                continue
+            if any(pattern.fullmatch(name) for pattern in patterns):
+                requests = (requests or 0) + total
+        return requests
+
+    def _event_profile(self) -> Optional[Dict]:
+        path = os.path.join(m5.options.outdir, _profile_file)
+        if args.no_event_profile or not os.path.isfile(path):
+            return None
+        with open(path) as profile_file:
+            return json.load(profile_file)
+
+    def _components(self, names: Dict) -> Dict[str, int]:
+        """
+        Attribute the host time of each named event to the SimObject
+        scheduling it: event names are the path of their owner followed
+        by the name of the event itself. Events without an owner are
+        gathered under "(unnamed)".
+        """
+        components = defaultdict(int)
+        for name, entry in names.items():
+            path = name.split(".")[:-1]
+            component = ".".join(path[: args.component_depth])
+            components[component or "(unnamed)"] += entry["total_ns"]
+        return dict(
+            sorted(components.items(), key=lambda item: item[1], reverse=True)
+        )
+
+    def report(self) -> Dict:
+        host_seconds = time.perf_counter() - self._start_time
+        sim_insts = self._sim_stat("simInsts")
+        sim_requests = self._sim_requests()
+
+        report = {
+            "config": args.config,
+            "config_args": args.config_args,
+            "host_seconds": host_seconds,
+            "peak_rss_bytes": self._peak_rss(),
+            "sim_insts": sim_insts,
+            "sim_ops": self._sim_stat("simOps"),
+            "sim_seconds": self._sim_stat("simSeconds"),
+        }
+
+        if sim_insts:
+            report["host_ns_per_sim_inst"] = host_seconds * 1e9 / sim_insts
+
+        if sim_requests is not None:
+            report["sim_requests"] = sim_requests
+        if sim_requests:
+            report["host_ns_per_request"] = host_seconds * 1e9 / sim_requests
+
+        end_instructions = self._counter.read()
+        if end_instructions is not None:
+            host_instructions = end_instructions - self._start_instructions
+            report["host_instructions"] = host_instructions
+            if sim_insts:
+                report["host_instructions_per_sim_inst"] = (
+                    host_instructions / sim_insts
+                )
+
+        profile = self._event_profile()
+        if profile is not None:
+            names = profile["names"]
+            events = sum(entry["count"] for entry in names.values())
+            event_ns = sum(entry["total_ns"] for entry in names.values())
+            report["events"] = events
+            report["events_per_second"] = events / host_seconds
+            if events:
+                report["host_ns_per_event"] = event_ns / events
+            report["component_host_ns"] = self._components(names)
+            if sim_requests:
+                report["events_per_request"] = events / sim_requests
+
+        return report
+
+    def _peak_rss(self) -> int:
+        # ru_maxrss is in kilobytes on Linux but in bytes on macOS.
+        peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+        return peak if platform.system() == "Darwin" else peak * 1024
+
+    def write_report(self) -> None:
+        if self._start_time is None:
+            print("The benchmarked configuration never instantiated.")
+            return
+        report = self.report()
+        with open(os.path.join(m5.options.outdir, args.report), "w") as f:
+            json.dump(report, f, indent=2)
+
+        print(f"Host seconds: {report['host_seconds']:.3f}")
+        if "host_ns_per_sim_inst" in report:
+            print(
+                "Host ns per simulated instruction: "
+                f"{report['host_ns_per_sim_inst']:.2f}"
+            )
+        if "host_ns_per_request" in report:
+            print(
+                "Host ns per simulated request: "
+                f"{report['host_ns_per_request']:.2f}"
+            )
+        if "events_per_request" in report:
+            print(f"Events per request: {report['events_per_request']:.2f}")
+        if "events_per_second" in report:
+            print(f"Events per second: {report['events_per_second']:.0f}")
+        print(f"Peak RSS: {report['peak_rss_bytes'] / 2**20:.1f} MiB")
+
+
+benchmark = _Benchmark()
+_instantiate = m5.simulate.instantiate
+
+
+def _benchmark_instantiate(*instantiate_args, **instantiate_kwargs):
+    if not args.no_event_profile:
+        Root.getInstance().eventq_profile = _profile_file
+
+    # Registered before the first `m5.simulate()` registers the C++ exit
+    # callbacks, so this runs after them and finds the event profile on
+    # disk.
+    atexit.register(benchmark.write_report)
+
+    _instantiate(*instantiate_args, **instantiate_kwargs)
+    benchmark.start()
+
+
+# Configuration scripts may call either.
+m5.instantiate = _benchmark_instantiate
+m5.simulate.instantiate = _benchmark_instantiate
+
+sys.argv = [args.config] + args.config_args
+sys.path.insert(0, os.path.dirname(os.path.abspath(args.config)))
+runpy.run_path(args.config, run_name="__m5_main__")
@@ -0,0 +1,358 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Host-performance benchmarks: fixed configurations covering the main hot
+paths of the simulator, each run through `configs/run_benchmark.py` so the
+speed of gem5 itself (host time per simulated instruction, events/sec, host
+instructions, peak RSS and host time per component) is reported in
+`host_perf.json` in the test's output directory.
+
+These are not correctness tests. The verifiers check the report was
+written and print its headline numbers so they can be compared across
+commits. The memory-system microbenchmarks also count the simulated
+requests, and are checked against the baselines in `baselines/`: the events
+serviced per request depend only on the simulator, not on the host, so a
+benchmark fails when they grow by more than `HostPerfBaseline.tolerance`.
+The host time per request is only compared and logged. Running with
+`GEM5_HOST_PERF_UPDATE_BASELINES=1` in the environment records the measured
+numbers as the new baselines.
+"""
+
+import json
+import os
+
+from testlib import *
+from testlib import log
+
+if config.bin_path:
+    resource_path = config.bin_path
+else:
+    resource_path = joinpath(absdirpath(__file__), "..", "resources")
+
+benchmark_wrapper = joinpath(
+    absdirpath(__file__), "configs", "run_benchmark.py"
+)
+
+
+class HostPerfReport(verifier.Verifier):
+    """
+    Checks the benchmark wrapper wrote its report and logs the headline
+    numbers.
+    """
+
+    _required = ("host_seconds", "peak_rss_bytes")
+
+    _headline = (
+        "host_seconds",
+        "host_ns_per_sim_inst",
+        "host_instructions",
+        "events_per_second",
+        "host_ns_per_request",
+        "events_per_request",
+        "peak_rss_bytes",
+    )
+
+    def __init__(self, report_name="host_perf.json"):
+        super().__init__()
+        self.report_name = report_name
+
+    def test(self, params):
+        tempdir = params.fixtures[constants.tempdir_fixture_name].path
+        report_file = joinpath(tempdir, self.report_name)
+        if not os.path.isfile(report_file):
+            test_util.fail(f"Could not find the report {report_file}")
+
+        with open(report_file) as f:
+            report = json.load(f)
+
+        missing = [key for key in self._required if key not in report]
+        if missing:
+            test_util.fail(f"{report_file} is missing {', '.join(missing)}")
+
+        for key in self._headline:
+            if key in report:
+                log.test_log.message(f"{key}: {report[key]}")
+
+
+class HostPerfBaseline(verifier.Verifier):
+    """
+    Compares the host time and the events serviced per simulated request
+    with the baseline of the benchmark, failing if the events per request
+    grew by more than the tolerance.
+    """
+
+    tolerance = 0.05
+
+    _baseline_keys = ("events_per_request", "host_ns_per_request")
+
+    def __init__(self, baseline_file, report_name="host_perf.json"):
+        super().__init__()
+        self.baseline_file = baseline_file
+        self.report_name = report_name
+
+    def test(self, params):
+        tempdir = params.fixtures[constants.tempdir_fixture_name].path
+        report_file = joinpath(tempdir, self.report_name)
+        if not os.path.isfile(report_file):
+            test_util.fail(f"Could not find the report {report_file}")
+
+        with open(report_file) as f:
+            report = json.load(f)
+        measured = {
+            key: report[key] for key in self._baseline_keys if key in report
+        }
+        if "events_per_request" not in measured:
+            test_util.fail(
+                f"{report_file} has no events per request. The benchmark "
+                "needs a --request-stat and the event profile."
+            )
+
+        if os.environ.get("GEM5_HOST_PERF_UPDATE_BASELINES"):
+            os.makedirs(os.path.dirname(self.baseline_file), exist_ok=True)
+            with open(self.baseline_file, "w") as f:
+                json.dump(measured, f, indent=2)
+                f.write("\n")
+            log.test_log.message(f"Updated {self.baseline_file}")
+            return
+
+        if not os.path.isfile(self.baseline_file):
+            log.test_log.message(f"No baseline {self.baseline_file}")
+            return
+
+        with open(self.baseline_file) as f:
+            baseline = json.load(f)
+
+        for key, value in measured.items():
+            if key in baseline and baseline[key]:
+                change = value / baseline[key] - 1
+                log.test_log.message(
+                    f"{key}: {value:.2f}, baseline {baseline[key]:.2f} "
+                    f"({change:+.1%})"
+                )
+
+        expected = baseline.get("events_per_request")
+        actual = measured["events_per_request"]
+        if expected and actual > expected * (1 + self.tolerance):
+            test_util.fail(
+                f"Events per request regressed from {expected:.2f} to "
+                f"{actual:.2f}, more than {self.tolerance:.0%}"
+            )
+
+
+baselines_dir = joinpath(absdirpath(__file__), "baselines")
+
+
+def host_perf_benchmark(
+    name: str,
+    config_path: str,
+    config_args: list,
+    valid_isa: str,
+    protocol: str = None,
+    request_stats: list = (),
+):
+    verifiers = (HostPerfReport(),)
+    wrapper_args = []
+    if request_stats:
+        verifiers += (
+            HostPerfBaseline(joinpath(baselines_dir, f"{name}.json")),
+        )
+        for stat in request_stats:
+            wrapper_args += ["--request-stat", stat]
+
+    gem5_verify_config(
+        name=f"host-perf-{name}",
+        verifiers=verifiers,
+        fixtures=(),
+        config=benchmark_wrapper,
+        config_args=wrapper_args + [config_path] + config_args,
+        valid_isas=(valid_isa,),
+        valid_variants=(constants.opt_tag,),
+        protocol=protocol,
+        length=constants.very_long_tag,
+    )
+
+
+se_workload = joinpath(absdirpath(__file__), "configs", "se_workload.py")
+
+host_perf_benchmark(
+    name="atomic-se",
+    config_path=se_workload,
+    config_args=["atomic", "NoCache", "--resource-directory", resource_path],
+    valid_isa=constants.x86_tag,
+)
+
+host_perf_benchmark(
+    name="o3-classic-caches",
+    config_path=se_workload,
+    config_args=[
+        "o3",
+        "PrivateL1PrivateL2",
+        "--resource-directory",
+        resource_path,
+    ],
+    valid_isa=constants.x86_tag,
+)
+
+# The requests sent by the traffic generators of the TestBoard, and by the
+# GUPS generators.
+generator_requests = r"system\.processor\.cores\d*\.generator\.numPackets"
+gups_requests = (
+    r"system\.processor\.cores\d*\.generator\.total(Reads|Writes)"
+)
+
+host_perf_benchmark(
+    name="ruby-chi-16-core",
+    config_path=joinpath(absdirpath(__file__), "configs", "chi_traffic.py"),
+    config_args=["--num-cores", "16"],
+    valid_isa=constants.all_compiled_tag,
+    protocol="CHI",
+    request_stats=[generator_requests],
+)
+
+host_perf_benchmark(
+    name="garnet-mesh",
+    config_path=joinpath(
+        config.base_dir, "configs", "example", "garnet_synth_traffic.py"
+    ),
+    config_args=[
+        "--network=garnet",
+        "--topology=Mesh_XY",
+        "--num-cpus=16",
+        "--num-dirs=16",
+        "--mesh-rows=4",
+        "--synthetic=uniform_random",
+        "--injectionrate=0.1",
+        "--sim-cycles=100000",
+    ],
+    valid_isa=constants.null_tag,
+    protocol="Garnet_standalone",
+    request_stats=[r"system\.ruby\.network\.packets_injected"],
+)
+
+# The GPU benchmark drives the VIPER GPU memory system with the GPU random
+# tester rather than running a compiled GPU kernel, so it needs no GPU
+# toolchain or resources.
+host_perf_benchmark(
+    name="gpu-viper",
+    config_path=joinpath(
+        config.base_dir, "configs", "example", "ruby_gpu_random_test.py"
+    ),
+    config_args=["--test-length", "50000", "--num-dmas", "0"],
+    valid_isa=constants.vega_x86_tag,
+)
+
+memory_microbenchmark = joinpath(
+    absdirpath(__file__), "configs", "memory_microbenchmark.py"
+)
+
+
+def memory_benchmark(
+    name: str,
+    component: str,
+    generator: str = "random",
+    extra_args: list = (),
+    protocol: str = None,
+):
+    host_perf_benchmark(
+        name=name,
+        config_path=memory_microbenchmark,
+        config_args=[component, "--generator", generator] + list(extra_args),
+        valid_isa=constants.all_compiled_tag,
+        protocol=protocol,
+        request_stats=[
+            gups_requests if generator == "gups" else generator_requests
+        ],
+    )
+
+
+for generator in ("linear", "random", "gups"):
+    memory_benchmark(f"mem-ctrl-{generator}", "mem-ctrl", generator)
+    memory_benchmark(f"hbm-ctrl-{generator}", "hbm-ctrl", generator)
+
+memory_benchmark("xbar-8-core", "xbar", extra_args=["--num-cores", "8"])
+
+# A working set of a few times the size of the caches, so the replacement
+# policies and compressors see both hits and evictions.
+cache_args = ["--working-set", "128KiB"]
+
+replacement_policies = [
+    "BIPRP",
+    "BRRIPRP",
+    "DRRIPRP",
+    "FIFORP",
+    "LFURP",
+    "LIPRP",
+    "LRURP",
+    "MRURP",
+    "NRURP",
+    "RRIPRP",
+    "RandomRP",
+    "SHiPMemRP",
+    "SHiPPCRP",
+    "SecondChanceRP",
+    "TreePLRURP",
+    "WeightedLRURP",
+]
+
+for policy in replacement_policies:
+    memory_benchmark(
+        f"cache-{policy}",
+        "cache",
+        extra_args=cache_args + ["--replacement-policy", policy],
+    )
+
+compressors = [
+    "BDI",
+    "Base64Delta8",
+    "CPack",
+    "FPC",
+    "FPCD",
+    "FrequentValuesCompressor",
+    "PerfectCompressor",
+    "RepeatedQwordsCompressor",
+    "ZeroCompressor",
+]
+
+for compressor in compressors:
+    memory_benchmark(
+        f"cache-{compressor}",
+        "cache",
+        extra_args=cache_args + ["--compressor", compressor],
+    )
+
+memory_benchmark(
+    "ruby-mesi-4-core",
+    "ruby-mesi",
+    extra_args=["--num-cores", "4"],
+    protocol="MESI_Two_Level",
+)
+memory_benchmark(
+    "ruby-chi-4-core",
+    "ruby-chi",
+    extra_args=["--num-cores", "4"],
+    protocol="CHI",
+)
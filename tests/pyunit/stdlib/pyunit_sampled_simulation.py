@@ -0,0 +1,123 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import os
+import tempfile
+import unittest
+from pathlib import Path
+
+from gem5.resources.resource import SimpointResource
+from gem5.utils.sampled_simulation import (
+    merge_weighted_stats,
+    parse_stats_txt,
+    simpoint_regions,
+)
+
+STATS_TXT = """
+---------- Begin Simulation Statistics ----------
+simSeconds                                   0.001000  # (Second)
+board.processor.cores.core.ipc               1.500000  # IPC ((Count/Cycle))
+board.cache.hits::total                          1000  # number of hits (Count)
+board.cache.latency::samples                      10  # latency (Tick)
+board.cache.latency::mean                         nan  # latency (Tick)
+
+---------- End Simulation Statistics   ----------
+
+---------- Begin Simulation Statistics ----------
+simSeconds                                   0.002000  # (Second)
+
+---------- End Simulation Statistics   ----------
+"""
+
+
+class SampledSimulationTestSuite(unittest.TestCase):
+    """Tests the utils.sampled_simulation helpers."""
+
+    def test_parse_stats_txt(self) -> None:
+        with tempfile.TemporaryDirectory() as tmpdir:
+            path = Path(tmpdir) / "stats.txt"
+            path.write_text(STATS_TXT)
+            dumps = parse_stats_txt(path)
+
+        self.assertEqual(2, len(dumps))
+        self.assertEqual(0.001, dumps[0]["simSeconds"])
+        self.assertEqual(1.5, dumps[0]["board.processor.cores.core.ipc"])
+        self.assertEqual(1000, dumps[0]["board.cache.hits::total"])
+        self.assertEqual(10, dumps[0]["board.cache.latency::samples"])
+        self.assertNotEqual(
+            dumps[0]["board.cache.latency::mean"],
+            dumps[0]["board.cache.latency::mean"],
+        )
+        self.assertEqual({"simSeconds": 0.002}, dumps[1])
+
+    def test_merge_weighted_mean(self) -> None:
+        merged = merge_weighted_stats(
+            [
+                (0.25, {"ipc": 1.0, "insts": 100.0}),
+                (0.75, {"ipc": 2.0, "insts": 300.0}),
+            ]
+        )
+        self.assertAlmostEqual(1.75, merged["ipc"])
+        self.assertAlmostEqual(250.0, merged["insts"])
+
+    def test_merge_weighted_mean_missing_stat(self) -> None:
+        merged = merge_weighted_stats(
+            [(0.5, {"ipc": 1.0, "misses": 4.0}), (0.5, {"ipc": 3.0})]
+        )
+        self.assertAlmostEqual(2.0, merged["ipc"])
+        self.assertAlmostEqual(4.0, merged["misses"])
+
+    def test_merge_weighted_sum(self) -> None:
+        merged = merge_weighted_stats(
+            [(2.0, {"insts": 100.0}), (3.0, {"insts": 10.0})],
+            normalize=False,
+        )
+        self.assertAlmostEqual(230.0, merged["insts"])
+
+    def test_simpoint_regions(self) -> None:
+        simpoint = SimpointResource(
+            simpoint_interval=1000000,
+            simpoint_list=[2, 3, 4, 15],
+            weight_list=[0.1, 0.2, 0.4, 0.3],
+            warmup_interval=1000000,
+        )
+        regions = simpoint_regions(simpoint, "cpts")
+
+        self.assertEqual(4, len(regions))
+        for i, region in enumerate(regions):
+            self.assertEqual(f"SimPoint{i}", region.name)
+            self.assertEqual(
+                Path(os.getcwd()) / "cpts" / f"cpt.SimPoint{i}",
+                region.checkpoint,
+            )
+            self.assertEqual(1000000, region.detail_insts)
+        self.assertEqual(
+            [0.1, 0.2, 0.4, 0.3], [region.weight for region in regions]
+        )
+        self.assertEqual(
+            simpoint.get_warmup_list(),
+            [region.warmup_insts for region in regions],
+        )
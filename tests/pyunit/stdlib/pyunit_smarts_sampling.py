@@ -0,0 +1,65 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import math
+import unittest
+
+from gem5.simulate.sampling import estimate
+
+
+class SmartsEstimateTestSuite(unittest.TestCase):
+    """Tests the simulate.sampling.estimate function."""
+
+    def test_estimate(self) -> None:
+        result = estimate([1.0, 2.0, 3.0, 4.0], confidence=0.95)
+
+        self.assertAlmostEqual(2.5, result.mean)
+        self.assertAlmostEqual(math.sqrt(5 / 3), result.stdev)
+        self.assertEqual(4, result.samples)
+        self.assertAlmostEqual(
+            1.959964 * math.sqrt(5 / 3) / 2, result.half_width, places=5
+        )
+        self.assertAlmostEqual(
+            result.half_width / 2.5, result.relative_error
+        )
+
+    def test_estimate_constant(self) -> None:
+        result = estimate([1.5] * 10, confidence=0.997)
+
+        self.assertEqual(1.5, result.mean)
+        self.assertEqual(0.0, result.half_width)
+
+    def test_estimate_single_sample(self) -> None:
+        result = estimate([1.5], confidence=0.997)
+
+        self.assertEqual(1.5, result.mean)
+        self.assertEqual(math.inf, result.half_width)
+
+    def test_estimate_invalid(self) -> None:
+        with self.assertRaises(ValueError):
+            estimate([], confidence=0.997)
+        with self.assertRaises(ValueError):
+            estimate([1.0, 2.0], confidence=1.0)
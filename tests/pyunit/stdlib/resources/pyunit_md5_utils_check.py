@@ -31,8 +31,10 @@ import unittest
 from pathlib import Path
 
 from gem5.resources.md5_utils import (
+    md5_cache_path,
     md5_dir,
     md5_file,
+    md5_file_cached,
 )
 
 
@@ -74,6 +76,49 @@ class MD5FileTestSuite(unittest.TestCase):
         self.assertEqual(first_file_md5, second_file_md5)
 
 
+class MD5FileCachedTestSuite(unittest.TestCase):
+    """Test cases for gem5.resources.md5_utils.md5_file_cached()"""
+
+    def setUp(self) -> None:
+        self.dir = Path(tempfile.mkdtemp())
+        self.file = self.dir / "file"
+        with open(self.file, "w") as f:
+            f.write("This is a test string, to be put in a temp file")
+
+    def tearDown(self) -> None:
+        shutil.rmtree(self.dir)
+
+    def test_md5FileCachedMatchesMd5File(self) -> None:
+        # The cached md5 must be the md5 of the file, whether it was just
+        # computed or read from the cache.
+
+        self.assertEqual(md5_file(self.file), md5_file_cached(self.file))
+        self.assertTrue(md5_cache_path(self.file).exists())
+        self.assertEqual(md5_file(self.file), md5_file_cached(self.file))
+
+    def test_md5FileCachedIsUsed(self) -> None:
+        # As long as the file is unchanged, the recorded md5 is returned
+        # without hashing the file again.
+
+        md5_file_cached(self.file)
+        cache = md5_cache_path(self.file)
+        with open(cache) as f:
+            recorded = f.read()
+        with open(cache, "w") as f:
+            f.write(recorded.replace(md5_file(self.file), "0" * 32))
+
+        self.assertEqual("0" * 32, md5_file_cached(self.file))
+
+    def test_md5FileCachedInvalidated(self) -> None:
+        # Changing the file must invalidate the recorded md5.
+
+        md5_file_cached(self.file)
+        with open(self.file, "w") as f:
+            f.write("Some other, longer, contents of the temp file")
+
+        self.assertEqual(md5_file(self.file), md5_file_cached(self.file))
+
+
 class MD5DirTestSuite(unittest.TestCase):
     """Test cases for gem5.resources.md5_utils.md5_dir()"""
 
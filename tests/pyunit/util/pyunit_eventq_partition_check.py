@@ -0,0 +1,86 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import unittest
+
+from m5.util.eventq_partition import assign_event_queues
+
+
+class AssignEventQueuesTestSuite(unittest.TestCase):
+    """Test cases for the event queue partitioning heuristic"""
+
+    def test_single_queue(self):
+        costs = {"a": 1.0, "b": 2.0, "c": 3.0}
+        edges = {("a", "b"): 1, ("b", "c"): 1}
+        queue = assign_event_queues(costs, edges, 1)
+        self.assertEqual(queue, {"a": 0, "b": 0, "c": 0})
+
+    def test_balance_unconnected(self):
+        costs = {f"cpu{i}": 1.0 for i in range(4)}
+        queue = assign_event_queues(costs, {}, 4)
+        self.assertEqual(sorted(queue.values()), [0, 1, 2, 3])
+
+    def test_keeps_clusters_together(self):
+        # Two clusters of a CPU and its private caches, joined by a
+        # single link between the L2s.
+        costs = {}
+        edges = {}
+        for c in range(2):
+            names = [f"cpu{c}", f"l1i{c}", f"l1d{c}", f"l2{c}"]
+            for name in names:
+                costs[name] = 1.0
+            for name in names[1:3]:
+                edges[(names[0], name)] = 1
+                edges[(name, names[3])] = 1
+        edges[("l20", "l21")] = 1
+
+        queue = assign_event_queues(costs, edges, 2)
+        for c in range(2):
+            q = queue[f"cpu{c}"]
+            for name in (f"l1i{c}", f"l1d{c}", f"l2{c}"):
+                self.assertEqual(queue[name], q)
+        self.assertNotEqual(queue["cpu0"], queue["cpu1"])
+
+    def test_pinned(self):
+        costs = {"system": 1.0, "membus": 1.0, "cpu0": 5.0, "cpu1": 5.0}
+        edges = {
+            ("system", "membus"): 1,
+            ("cpu0", "membus"): 1,
+            ("cpu1", "membus"): 1,
+        }
+        queue = assign_event_queues(
+            costs, edges, 3, pinned={"system": 0, "membus": 0}
+        )
+        self.assertEqual(queue["system"], 0)
+        self.assertEqual(queue["membus"], 0)
+        self.assertEqual({queue["cpu0"], queue["cpu1"]}, {1, 2})
+
+    def test_deterministic(self):
+        costs = {f"n{i}": float(i % 3 + 1) for i in range(16)}
+        edges = {(f"n{i}", f"n{(i * 7) % 16}"): 1 for i in range(16)}
+        first = assign_event_queues(costs, edges, 4)
+        for _ in range(3):
+            self.assertEqual(assign_event_queues(costs, edges, 4), first)
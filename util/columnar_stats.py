@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Load stat files written by the columnar stat output
+# (columnar://stats.bin) into numpy arrays. Dense files are
+# memory-mapped, delta files are expanded into a dense array.
+#
+# As a script it prints the value of every stat at every dump, or of
+# the stats whose names contain one of the given substrings:
+#
+#   columnar_stats.py m5out/stats.bin [pattern ...]
+
+import json
+import sys
+
+import numpy as np
+
+MAGIC = b"gem5cols"
+VERSION = 1
+HEADER_SIZE = 16
+
+
+def load(path):
+    """Load a columnar stat file.
+
+    Returns a tuple (columns, ticks, values) where columns is the list
+    of column descriptions from the schema, ticks is an array with the
+    tick of every dump and values is a 2-d array with one row per dump
+    and one column per stat value.
+    """
+
+    with open(path + ".json") as f:
+        schema = json.load(f)
+    columns = schema["columns"]
+
+    raw = np.memmap(path, dtype=np.uint8, mode="r")
+    if bytes(raw[:8]) != MAGIC:
+        raise ValueError(f"{path} is not a columnar stat file")
+    version, encoding = np.frombuffer(raw[8:HEADER_SIZE], dtype=np.uint32)
+    if version != VERSION:
+        raise ValueError(f"{path} has unsupported version {version}")
+
+    if encoding == 0:
+        record = np.dtype([("tick", "u8"), ("values", "f8", len(columns))])
+        records = np.memmap(
+            path, dtype=record, mode="r", offset=HEADER_SIZE
+        )
+        return columns, records["tick"], records["values"]
+
+    change = np.dtype([("column", "u4"), ("value", "f8")])
+    ticks = []
+    rows = []
+    current = np.zeros(len(columns))
+    pos = HEADER_SIZE
+    while pos < len(raw):
+        tick = int(np.frombuffer(raw[pos : pos + 8], dtype=np.uint64)[0])
+        count = int(np.frombuffer(raw[pos + 8 : pos + 12], np.uint32)[0])
+        pos += 12
+        end = pos + count * change.itemsize
+        changes = np.frombuffer(raw[pos:end], dtype=change)
+        current[changes["column"]] = changes["value"]
+        pos = end
+        ticks.append(tick)
+        rows.append(current.copy())
+
+    return (
+        columns,
+        np.array(ticks, dtype=np.uint64),
+        np.array(rows).reshape(len(rows), len(columns)),
+    )
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(f"Usage: {sys.argv[0]} <stat file> [pattern ...]")
+        sys.exit(1)
+
+    columns, ticks, values = load(sys.argv[1])
+    patterns = sys.argv[2:]
+    selected = [
+        i
+        for i, column in enumerate(columns)
+        if not patterns or any(p in column["name"] for p in patterns)
+    ]
+
+    for dump, tick in enumerate(ticks):
+        print(f"# dump {dump} at tick {tick}")
+        for i in selected:
+            print(f"{columns[i]['name']} {values[dump, i]:g}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,24 @@
+# Physical memory stores record the format of their image file. Images
+# written before this was introduced are all single gzip streams.
+def upgrader(cpt):
+    import re
+
+    for sec in cpt.sections():
+        if re.search(r"\.store\d+$", sec) and cpt.has_option(sec, "store_id"):
+            if not cpt.has_option(sec, "format"):
+                cpt.set(sec, "format", "gzip")
+
+
+def downgrader(cpt):
+    import re
+
+    for sec in cpt.sections():
+        if re.search(r"\.store\d+$", sec) and cpt.has_option(sec, "format"):
+            if cpt.get(sec, "format") != "gzip":
+                # The image itself would have to be rewritten, which
+                # is not possible from here.
+                raise ValueError(
+                    "memory image of %s is not a gzip stream, take the "
+                    "checkpoint with memory_checkpoint_format='gzip'" % sec
+                )
+            cpt.remove_option(sec, "format")
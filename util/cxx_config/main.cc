@@ -62,6 +62,7 @@
 #include "base/str.hh"
 #include "base/trace.hh"
 #include "cpu/base.hh"
+#include "sim/cxx_config_bin.hh"
 #include "sim/cxx_config_ini.hh"
 #include "sim/cxx_manager.hh"
 #include "sim/init_signals.hh"
@@ -78,7 +79,7 @@ void
 usage(const std::string &prog_name)
 {
     std::cerr << "Usage: " << prog_name << (
-        " <config-file.ini> [ <option> ]\n\n"
+        " <config-file.ini | config-cache> [ <option> ]\n\n"
         "OPTIONS:\n"
         "    -p <object> <param> <value>  -- set a parameter\n"
         "    -v <object> <param> <values> -- set a vector parameter from"
@@ -93,6 +94,10 @@ usage(const std::string &prog_name)
         "    -c <from> <to> <ticks>       -- switch from cpu 'from' to cpu"
         " 'to' after\n"
         "                                    the given number of ticks\n"
+        "    -w <file>                    -- write the config file, without"
+        " the\n"
+        "                                    -p/-v overrides, as a config"
+        " cache\n"
         "\n"
         );
 
@@ -123,7 +128,13 @@ main(int argc, char **argv)
 
     const std::string config_file(argv[arg_ptr]);
 
-    CxxConfigFileBase *conf = new CxxIniFile();
+    // Config caches written with -w are recognised by their contents
+    const bool is_cache = CxxBinaryConfigFile::isCache(config_file);
+    CxxConfigFileBase *conf;
+    if (is_cache)
+        conf = new CxxBinaryConfigFile();
+    else
+        conf = new CxxIniFile();
 
     if (!conf->load(config_file.c_str())) {
         std::cerr << "Can't open config file: " << config_file << '\n';
@@ -192,6 +203,18 @@ main(int argc, char **argv)
                 to_cpu = argv[arg_ptr + 1];
                 std::istringstream(argv[arg_ptr + 2]) >> pre_switch_time;
                 arg_ptr += 3;
+            } else if (option == "-w") {
+                if (num_args < 1)
+                    usage(prog_name);
+                CxxBinaryConfigFile cache;
+                bool converted = is_cache ? cache.load(config_file) :
+                    cache.loadIni(config_file);
+                if (!converted || !cache.save(argv[arg_ptr])) {
+                    std::cerr << "Can't write config cache: " <<
+                        argv[arg_ptr] << '\n';
+                    return EXIT_FAILURE;
+                }
+                arg_ptr++;
             } else {
                 usage(prog_name);
             }
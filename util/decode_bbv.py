@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Convert the binary basic block vectors written by a SimPoint probe with
+# binary_output set into the text format read by the SimPoint tools:
+#
+#   decode_bbv.py m5out/simpoint.bb.gz [-o simpoint.bb]
+#
+# Compressed input is recognised by its contents rather than its name.
+# The file format is described in src/cpu/simple/probes/simpoint.hh.
+
+import argparse
+import gzip
+import struct
+import sys
+
+MAGIC = b"gem5bbv\0"
+VERSION = 1
+
+HEADER = struct.Struct("=8sIQ")
+COUNT = struct.Struct("=QQ")
+
+
+def decode(data, out):
+    if len(data) < HEADER.size:
+        sys.exit("Not a binary BBV file")
+    magic, version, _interval = HEADER.unpack_from(data)
+    if magic != MAGIC:
+        sys.exit("Not a binary BBV file")
+    if version != VERSION:
+        sys.exit(f"Unsupported BBV file version {version}")
+
+    pos = HEADER.size
+    while pos + 4 <= len(data):
+        (num,) = struct.unpack_from("=I", data, pos)
+        pos += 4
+        if pos + num * COUNT.size > len(data):
+            print(
+                "Warning: the file ends in a partial interval",
+                file=sys.stderr,
+            )
+            break
+        line = ["T"]
+        for bb_id, count in COUNT.iter_unpack(
+            data[pos : pos + num * COUNT.size]
+        ):
+            line.append(":%d:%d " % (bb_id, count))
+        pos += num * COUNT.size
+        out.write("".join(line) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert binary SimPoint BBVs to text"
+    )
+    parser.add_argument("bbv", help="Binary BBV file")
+    parser.add_argument(
+        "-o", "--output", help="Output file (default: standard output)"
+    )
+    args = parser.parse_args()
+
+    with open(args.bbv, "rb") as f:
+        data = f.read()
+    if data[:2] == b"\x1f\x8b":
+        data = gzip.decompress(data)
+
+    if args.output:
+        with open(args.output, "w") as out:
+            decode(data, out)
+    else:
+        decode(data, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,519 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Decode a binary debug trace (written with --debug-binary) into the
+# text that gem5 would have written with the default debug logger:
+#
+#   decode_debug_trace.py m5out/trace.bin [-o trace.txt]
+#
+# Messages are formatted here the way cprintf formats them, including
+# its differences from printf (e.g. "%f" without a precision uses the
+# shortest representation). The file format is described in
+# src/base/binary_trace.hh.
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"gem5dbg\0"
+VERSION = 1
+
+REC_STRING = 0
+REC_MESSAGE = 1
+REC_TEXT = 2
+
+PREFIX_TICK = 0x1
+PREFIX_FLAG = 0x2
+
+ARG_SIGNED_CHAR = 0x01
+ARG_UNSIGNED_CHAR = 0x02
+ARG_BOOL = 0x03
+ARG_DOUBLE = 0x04
+ARG_POINTER = 0x05
+ARG_STRING = 0x06
+ARG_SIGNED = 0x10
+ARG_UNSIGNED = 0x20
+
+# The kinds of argument, as far as cprintf is concerned
+INT, CHAR, BOOL, DOUBLE, POINTER, STRING = range(6)
+
+# Format.format
+F_NONE, F_STRING, F_INTEGER, F_CHARACTER, F_FLOATING = range(5)
+# Format.base
+DEC, HEX, OCT = range(3)
+# Format.floatFormat
+BEST, FIXED, SCIENTIFIC = range(3)
+
+
+class Arg:
+    def __init__(self, kind, value, size=8, signed=True):
+        self.kind = kind
+        self.value = value
+        self.size = size
+        self.signed = signed
+
+
+class Format:
+    def __init__(self):
+        self.alternate = False
+        self.flush_left = False
+        self.print_sign = False
+        self.fill_zero = False
+        self.uppercase = False
+        self.base = DEC
+        self.format = F_NONE
+        self.float_format = BEST
+        self.precision = -1
+        self.width = 0
+        self.get_precision = False
+        self.get_width = False
+
+
+def _pad(text, width, fill, left):
+    if len(text) >= width:
+        return text
+    if left:
+        return text + fill * (width - len(text))
+    return fill * (width - len(text)) + text
+
+
+def _float(value, field, precision, showpos=False, uppercase=False):
+    """Stream a double with the given floatfield and precision."""
+    conv = {None: "g", "f": "f", "e": "e"}[field]
+    if uppercase:
+        conv = conv.upper()
+    return ("%" + ("+" if showpos else "") + ".%d" % precision + conv) % value
+
+
+def _insert(
+    arg,
+    precision,
+    base=DEC,
+    showbase=False,
+    showpos=False,
+    uppercase=False,
+):
+    """The text of "out << arg" with the given stream flags."""
+    if arg.kind == CHAR or arg.kind == STRING:
+        return arg.value
+    if arg.kind == DOUBLE:
+        return _float(arg.value, None, precision, showpos, uppercase)
+    if arg.kind == POINTER:
+        # Pointers are always printed in hex with a base prefix
+        return "0x%x" % arg.value if arg.value else "0"
+
+    value = arg.value
+    if base == DEC:
+        if showpos and arg.signed and value >= 0:
+            return "+%d" % value
+        return "%d" % value
+
+    value &= (1 << (8 * arg.size)) - 1
+    digits = ("%x" if base == HEX else "%o") % value
+    if uppercase:
+        digits = digits.upper()
+    if showbase and value:
+        if base == HEX:
+            digits = ("0X" if uppercase else "0x") + digits
+        else:
+            digits = "0" + digits
+    return digits
+
+
+class Printer:
+    """A port of cp::Print that formats one message."""
+
+    def __init__(self, fmt):
+        self.fmt = fmt
+        self.ptr = 0
+        self.cont = False
+        self.out = []
+        self.spec = Format()
+        # Streams start with a precision of 6, and setting the
+        # precision for one argument affects the ones after it.
+        self.precision = 6
+
+    def _char(self, offset=0):
+        pos = self.ptr + offset
+        return self.fmt[pos] if pos < len(self.fmt) else "\0"
+
+    def _text(self, extra_args):
+        self.spec = Format()
+        while self.ptr < len(self.fmt):
+            c = self._char()
+            if c == "%":
+                if self._char(1) != "%":
+                    if not extra_args:
+                        self._process_flag()
+                        return
+                    self.out.append("<extra arg>")
+                self.out.append("%")
+                self.ptr += 2
+            elif c == "\n":
+                self.out.append("\n")
+                self.ptr += 1
+            elif c == "\r":
+                self.ptr += 1
+                if self._char() != "\n":
+                    self.out.append("\n")
+            else:
+                end = self.ptr
+                while end < len(self.fmt) and self.fmt[end] not in "%\n\r":
+                    end += 1
+                self.out.append(self.fmt[self.ptr : end])
+                self.ptr = end
+
+    def _process_flag(self):
+        fmt = self.spec
+        done = False
+        end_number = False
+        have_precision = False
+        number = 0
+
+        while not done:
+            self.ptr += 1
+            c = self._char()
+            if "0" <= c <= "9":
+                if end_number:
+                    continue
+            elif number > 0:
+                end_number = True
+
+            if c == "s":
+                fmt.format = F_STRING
+                done = True
+            elif c == "c":
+                fmt.format = F_CHARACTER
+                done = True
+            elif c == "l":
+                continue
+            elif c == "p":
+                fmt.format = F_INTEGER
+                fmt.base = HEX
+                fmt.alternate = True
+                done = True
+            elif c in "Xx":
+                fmt.uppercase = c == "X"
+                fmt.base = HEX
+                fmt.format = F_INTEGER
+                done = True
+            elif c == "o":
+                fmt.base = OCT
+                fmt.format = F_INTEGER
+                done = True
+            elif c in "diu":
+                fmt.format = F_INTEGER
+                done = True
+            elif c in "Gg":
+                fmt.uppercase = c == "G"
+                fmt.format = F_FLOATING
+                fmt.float_format = BEST
+                done = True
+            elif c in "Ee":
+                fmt.uppercase = c == "E"
+                fmt.format = F_FLOATING
+                fmt.float_format = SCIENTIFIC
+                done = True
+            elif c == "f":
+                fmt.format = F_FLOATING
+                fmt.float_format = FIXED
+                done = True
+            elif c == "n":
+                self.out.append("we don't do %n!!!\n")
+                done = True
+            elif c == "#":
+                fmt.alternate = True
+            elif c == "-":
+                fmt.flush_left = True
+            elif c == "+":
+                fmt.print_sign = True
+            elif c == " ":
+                pass
+            elif c == ".":
+                fmt.width = number
+                fmt.precision = 0
+                have_precision = True
+                number = 0
+                end_number = False
+            elif c == "0" and number == 0:
+                fmt.fill_zero = True
+            elif "0" <= c <= "9":
+                number = number * 10 + int(c)
+            elif c == "*":
+                if have_precision:
+                    fmt.get_precision = True
+                else:
+                    fmt.get_width = True
+            else:
+                done = True
+
+            if end_number:
+                if have_precision:
+                    fmt.precision = number
+                else:
+                    fmt.width = number
+                end_number = False
+                number = 0
+
+            if done:
+                if fmt.format == F_INTEGER and have_precision:
+                    fmt.width = fmt.precision
+                    fmt.fill_zero = True
+                elif (
+                    fmt.format == F_FLOATING
+                    and not have_precision
+                    and fmt.fill_zero
+                ):
+                    fmt.precision = fmt.width
+
+        self.ptr += 1
+
+    def _integer(self, arg, fmt):
+        if arg.kind == CHAR:
+            arg = Arg(INT, arg.number, 4, True)
+        elif arg.kind == BOOL:
+            arg = Arg(INT, arg.value, 8, True)
+
+        out = ""
+        width = fmt.width
+        if fmt.alternate and fmt.fill_zero:
+            if fmt.base == HEX:
+                out = "0x"
+                width -= 2
+            elif fmt.base == OCT:
+                out = "0"
+                width -= 1
+        text = _insert(
+            arg,
+            self.precision,
+            fmt.base,
+            fmt.alternate and not fmt.fill_zero,
+            fmt.print_sign,
+            fmt.uppercase,
+        )
+        fill = "0" if fmt.fill_zero else " "
+        left = fmt.flush_left and not fmt.fill_zero
+        return out + _pad(text, width, fill, left)
+
+    def _floating(self, arg, fmt):
+        if arg.kind != DOUBLE:
+            return "<bad arg type for float format>"
+
+        field = None
+        uppercase = False
+        width = fmt.width if fmt.width > 0 else 0
+        if fmt.float_format == SCIENTIFIC:
+            if fmt.precision != -1:
+                if fmt.precision == 0:
+                    self.precision = 1
+                else:
+                    field = "e"
+                    self.precision = fmt.precision
+            uppercase = fmt.uppercase
+        elif fmt.float_format == FIXED:
+            if fmt.precision != -1:
+                field = "f"
+                self.precision = fmt.precision
+        elif fmt.precision != -1:
+            self.precision = fmt.precision
+
+        text = _float(arg.value, field, self.precision, False, uppercase)
+        return _pad(text, width, "0" if fmt.fill_zero else " ", False)
+
+    def _string(self, arg, fmt):
+        text = _insert(arg, self.precision)
+        # The width is measured on a fresh stream
+        length = len(_insert(arg, 6))
+        if fmt.width > length:
+            spaces = " " * (fmt.width - length)
+            return text + spaces if fmt.flush_left else spaces + text
+        return text
+
+    def add(self, arg):
+        if not self.cont:
+            self._text(False)
+        fmt = self.spec
+
+        if fmt.get_width:
+            fmt.get_width = False
+            self.cont = True
+            fmt.width = arg.value if _is_int(arg) else 0
+            return
+        if fmt.get_precision:
+            fmt.get_precision = False
+            self.cont = True
+            fmt.precision = arg.value if _is_int(arg) else 0
+            return
+
+        if fmt.format == F_CHARACTER:
+            if arg.kind == CHAR:
+                self.out.append(arg.value)
+            elif arg.kind == INT:
+                self.out.append(chr(arg.value & 0xFF))
+            else:
+                self.out.append("<bad arg type for char format>")
+        elif fmt.format == F_INTEGER:
+            self.out.append(self._integer(arg, fmt))
+        elif fmt.format == F_FLOATING:
+            self.out.append(self._floating(arg, fmt))
+        elif fmt.format == F_STRING:
+            self.out.append(self._string(arg, fmt))
+        else:
+            self.out.append("<bad format>")
+
+    def finish(self):
+        self._text(True)
+        return "".join(self.out)
+
+
+def _is_int(arg):
+    """Only ints (not other integer types) give a '*' width."""
+    return arg.kind == INT and arg.signed and arg.size == 4
+
+
+def cprintf(fmt, args):
+    printer = Printer(fmt)
+    for arg in args:
+        printer.add(arg)
+    return printer.finish()
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def get(self, fmt):
+        values = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += struct.calcsize(fmt)
+        return values[0] if len(values) == 1 else values
+
+    def string(self):
+        length = self.get("=I")
+        # latin-1 maps bytes to characters one to one, so the output
+        # has exactly the bytes gem5 would have written.
+        text = self.data[self.pos : self.pos + length].decode("latin-1")
+        self.pos += length
+        return text
+
+    def arg(self):
+        tag = self.get("=B")
+        if tag in (ARG_SIGNED_CHAR, ARG_UNSIGNED_CHAR):
+            byte = self.data[self.pos : self.pos + 1]
+            arg = Arg(CHAR, byte.decode("latin-1"))
+            arg.number = struct.unpack(
+                "=b" if tag == ARG_SIGNED_CHAR else "=B", byte
+            )[0]
+            self.pos += 1
+            return arg
+        if tag == ARG_BOOL:
+            return Arg(BOOL, self.get("=B"))
+        if tag == ARG_DOUBLE:
+            return Arg(DOUBLE, self.get("=d"))
+        if tag == ARG_POINTER:
+            return Arg(POINTER, self.get("=Q"))
+        if tag == ARG_STRING:
+            return Arg(STRING, self.string())
+        size = tag & 0xF
+        signed = tag & 0xF0 == ARG_SIGNED
+        code = {1: "b", 2: "h", 4: "i", 8: "q"}[size]
+        value = self.get("=" + (code if signed else code.upper()))
+        return Arg(INT, value, size, signed)
+
+
+def decode(data, out):
+    if data[: len(MAGIC)] != MAGIC:
+        sys.exit("Not a binary debug trace")
+    reader = Reader(data)
+    reader.pos = len(MAGIC)
+    version = reader.get("=I")
+    if version != VERSION:
+        sys.exit(f"Unsupported trace version {version}")
+
+    strings = {}
+    while reader.pos < len(data):
+        thread, length = reader.get("=II")
+        end = reader.pos + length
+        ids = strings.setdefault(thread, {})
+        while reader.pos < end:
+            rec = reader.get("=B")
+            if rec == REC_STRING:
+                str_id = reader.get("=I")
+                ids[str_id] = reader.string()
+                continue
+
+            tick, name, flag, prefix = reader.get("=QIIB")
+            if rec == REC_MESSAGE:
+                fmt, nargs = reader.get("=IB")
+                args = [reader.arg() for _ in range(nargs)]
+                message = cprintf(ids[fmt], args)
+            elif rec == REC_TEXT:
+                message = reader.string()
+            else:
+                sys.exit(f"Unknown record type {rec}")
+
+            line = []
+            if prefix & PREFIX_TICK:
+                line.append("%7d: " % tick)
+            if prefix & PREFIX_FLAG:
+                line.append(ids[flag] + ": ")
+            if ids[name]:
+                line.append(ids[name] + ": ")
+            line.append(message)
+            out.write("".join(line))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode a binary gem5 debug trace."
+    )
+    parser.add_argument("trace", help="Binary trace file")
+    parser.add_argument(
+        "-o", "--output", default="-", help="Output file [default: stdout]"
+    )
+    args = parser.parse_args()
+
+    with open(args.trace, "rb") as f:
+        data = f.read()
+
+    if args.output == "-":
+        out = open(
+            sys.stdout.fileno(),
+            "w",
+            encoding="latin-1",
+            newline="",
+            closefd=False,
+        )
+    else:
+        out = open(args.output, "w", encoding="latin-1", newline="")
+    with out:
+        decode(data, out)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Decode an instruction trace written by a BinaryExeTracer into the text
+# an ExeTracer would have written with the same debug flags:
+#
+#   decode_exec_trace.py m5out/system.cpu.tracer.bin [-o trace.txt]
+#
+# The disassembly and the other text of each instruction is stored once
+# in the trace, the first time the instruction is seen at a PC, and is
+# reused for every later execution. The file format is described in
+# src/cpu/binary_exetrace.hh.
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"gem5exe\0"
+VERSION = 1
+
+REC_CPU = 0
+REC_FORMAT = 1
+REC_INST = 2
+REC_EXEC = 3
+
+FMT_ASID = 0x1
+FMT_THREAD = 0x2
+FMT_SYMBOL = 0x4
+FMT_OPCLASS = 0x8
+FMT_RESULT = 0x10
+FMT_EFFADDR = 0x20
+FMT_FETCHSEQ = 0x40
+FMT_CPSEQ = 0x80
+FMT_FLAGS = 0x100
+FMT_TICKSOFF = 0x200
+FMT_FLAG = 0x400
+
+EXEC_RAN = 0x1
+EXEC_PREDICATE = 0x2
+EXEC_USER_MODE = 0x4
+EXEC_MEM_VALID = 0x8
+EXEC_FETCH_SEQ_VALID = 0x10
+EXEC_CP_SEQ_VALID = 0x20
+EXEC_HAS_ASID = 0x40
+
+DATA_INVALID = 0
+DATA_REG = 5
+
+# tick, pc, data, addr, inst, cpu, thread, micro pc, bits, data status
+EXEC_RECORD = struct.Struct("=QQQQIHHHBB4x")
+
+
+class Inst:
+    def __init__(self, microop, disasm, symbol, op_class, flags):
+        self.microop = microop
+        self.disasm = disasm
+        self.symbol = symbol
+        self.op_class = op_class
+        self.flags = flags
+
+
+def _hex(value):
+    """The text of cprintf's "%#x"."""
+    return "0x%x" % value if value else "0"
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def done(self):
+        return self.pos >= len(self.data)
+
+    def unpack(self, fmt):
+        if isinstance(fmt, str):
+            fmt = struct.Struct("=" + fmt)
+        if self.pos + fmt.size > len(self.data):
+            raise EOFError
+        values = fmt.unpack_from(self.data, self.pos)
+        self.pos += fmt.size
+        return values
+
+    def string(self):
+        (length,) = self.unpack("I")
+        if self.pos + length > len(self.data):
+            raise EOFError
+        text = self.data[self.pos : self.pos + length]
+        self.pos += length
+        return text.decode("utf-8", "replace")
+
+
+def decode(data, out):
+    reader = Reader(data)
+    if data[: len(MAGIC)] != MAGIC:
+        sys.exit("Not a binary instruction trace")
+    reader.pos = len(MAGIC)
+    version, _freq, full_system = reader.unpack("IQB")
+    if version != VERSION:
+        sys.exit(f"Unsupported trace version {version}")
+
+    cpus = {}
+    insts = {}
+    fmt = 0
+    while not reader.done():
+        try:
+            (kind,) = reader.unpack("B")
+            if kind == REC_CPU:
+                (cpu_id,) = reader.unpack("H")
+                cpus[cpu_id] = reader.string()
+            elif kind == REC_FORMAT:
+                (fmt,) = reader.unpack("I")
+            elif kind == REC_INST:
+                inst_id, microop = reader.unpack("IB")
+                insts[inst_id] = Inst(
+                    microop,
+                    reader.string(),
+                    reader.string(),
+                    reader.string(),
+                    reader.string(),
+                )
+            elif kind == REC_EXEC:
+                decode_exec(reader, full_system, cpus, insts, fmt, out)
+            else:
+                sys.exit(f"Unknown record type {kind} at {reader.pos - 1}")
+        except EOFError:
+            print(
+                "Warning: the trace ends in a partial record", file=sys.stderr
+            )
+            break
+
+
+def decode_exec(reader, full_system, cpus, insts, fmt, out):
+    (
+        tick,
+        pc,
+        data,
+        addr,
+        inst_id,
+        cpu_id,
+        thread,
+        micro_pc,
+        bits,
+        data_status,
+    ) = reader.unpack(EXEC_RECORD)
+    fetch_seq = reader.unpack("Q")[0] if bits & EXEC_FETCH_SEQ_VALID else 0
+    cp_seq = reader.unpack("Q")[0] if bits & EXEC_CP_SEQ_VALID else 0
+    asid = reader.unpack("Q")[0] if bits & EXEC_HAS_ASID else 0
+    result = reader.string() if data_status == DATA_REG else None
+
+    inst = insts[inst_id]
+    user_mode = bits & EXEC_USER_MODE
+
+    text = []
+    if fmt & FMT_ASID:
+        text.append("A%d " % asid)
+    if fmt & FMT_THREAD:
+        text.append("T%d : " % thread)
+    text.append(_hex(pc))
+    if (
+        fmt & FMT_SYMBOL
+        and (not full_system or not user_mode)
+        and inst.symbol
+    ):
+        text.append(" " + inst.symbol)
+    text.append(".%2d" % micro_pc if inst.microop else "   ")
+    text.append(" : ")
+    text.append(inst.disasm.ljust(26))
+
+    if bits & EXEC_RAN:
+        text.append(" : ")
+        if fmt & FMT_OPCLASS:
+            text.append(inst.op_class + " : ")
+        if fmt & FMT_RESULT and not bits & EXEC_PREDICATE:
+            text.append("Predicated False")
+        if fmt & FMT_RESULT and data_status != DATA_INVALID:
+            if result is not None:
+                text.append(" D=%s" % result)
+            else:
+                text.append(" D=0x%016x" % data)
+        if fmt & FMT_EFFADDR and bits & EXEC_MEM_VALID:
+            text.append(" A=0x%x" % addr)
+        if fmt & FMT_FETCHSEQ and bits & EXEC_FETCH_SEQ_VALID:
+            text.append("  FetchSeq=%d" % fetch_seq)
+        if fmt & FMT_CPSEQ and bits & EXEC_CP_SEQ_VALID:
+            text.append("  CPSeq=%d" % cp_seq)
+        if fmt & FMT_FLAGS:
+            text.append("  flags=(%s)" % inst.flags)
+
+    prefix = ""
+    if not fmt & FMT_TICKSOFF:
+        prefix += "%7d: " % tick
+    if fmt & FMT_FLAG:
+        prefix += "ExecEnable: "
+    prefix += cpus[cpu_id] + ": "
+    out.write(prefix + "".join(text) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode a binary instruction trace into text"
+    )
+    parser.add_argument("trace", help="Binary trace to decode")
+    parser.add_argument(
+        "-o", "--output", help="Output file (default: standard output)"
+    )
+    args = parser.parse_args()
+
+    with open(args.trace, "rb") as f:
+        data = f.read()
+
+    if args.output:
+        with open(args.output, "w") as out:
+            decode(data, out)
+    else:
+        decode(data, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -35,10 +35,11 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-# This script is used to dump protobuf packet traces to ASCII
-# format.
+# This script is used to dump protobuf packet traces, and the binary
+# traces of MemTraceProbe, to ASCII format.
 
 import os
+import struct
 import subprocess
 import sys
 
@@ -50,6 +51,41 @@ subprocess.check_call(["make", "--quiet", "-C", util_dir, "packet_pb2.py"])
 import packet_pb2
 
 
+def decode_binary(trace_in, ascii_out):
+    # See MemTraceProbe::BinaryRecord in src/mem/probes/mem_trace.hh
+    version, record_size, tick_freq, num_ids = struct.unpack(
+        "=IIQI", trace_in.read(20)
+    )
+    if version != 1:
+        print("Unsupported binary trace version", version)
+        exit(-1)
+
+    print("Tick frequency:", tick_freq)
+    for _ in range(num_ids):
+        key, length = struct.unpack("=HI", trace_in.read(6))
+        print("Master id %d: %s" % (key, trace_in.read(length).decode()))
+
+    print("Parsing packets")
+
+    record = struct.Struct("=QQQQIHH")
+    num_packets = 0
+    while True:
+        data = trace_in.read(record_size)
+        if len(data) < record_size:
+            break
+        num_packets += 1
+        tick, addr, flags, pc, size, cmd, pkt_id = record.unpack_from(data)
+        # ReadReq is 1 and WriteReq is 4 in src/mem/packet.hh Command enum
+        cmd = "r" if cmd == 1 else ("w" if cmd == 4 else "u")
+        ascii_out.write(f"{pkt_id},{cmd},{addr},{size},{flags},{tick}")
+        if pc:
+            ascii_out.write(f",{pc}\n")
+        else:
+            ascii_out.write("\n")
+
+    print("Parsed packets:", num_packets)
+
+
 def main():
     if len(sys.argv) != 3:
         print("Usage: ", sys.argv[0], " <protobuf input> <ASCII output>")
@@ -65,7 +101,13 @@ def main():
         exit(-1)
 
     # Read the magic number in 4-byte Little Endian
-    magic_number = proto_in.read(4).decode()
+    magic_number = proto_in.read(4).decode(errors="replace")
+
+    if magic_number == "m5pk" and proto_in.read(4) == b"tbin":
+        decode_binary(proto_in, ascii_out)
+        ascii_out.close()
+        proto_in.close()
+        return
 
     if magic_number != "gem5":
         print("Unrecognized file", sys.argv[1])
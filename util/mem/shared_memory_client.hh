@@ -28,15 +28,20 @@
 #ifndef __UTIL_MEM_SHARED_MEMORY_CLIENT_HH__
 #define __UTIL_MEM_SHARED_MEMORY_CLIENT_HH__
 
+#include <algorithm>
+#include <atomic>
 #include <cinttypes>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <err.h>
 #include <errno.h>
+#include <poll.h>
 #include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -50,15 +55,93 @@ namespace util
 namespace memory
 {
 
+// A message exchanged with the simulator through a channel, it must match
+// SharedMemoryServer::ChannelMessage in gem5.
+struct ChannelMessage
+{
+    uint64_t type;
+    uint64_t addr;
+    uint64_t size;
+    uint64_t data[5];
+};
+
+// A pair of rings of messages shared with a SharedMemoryServer. Messages are
+// passed through the shared memory, and the doorbells are only rung when the
+// other side may be waiting, so exchanging messages costs no system call as
+// long as both sides are busy. A channel must only be used by one thread.
+class SharedMemoryChannel
+{
+  public:
+    SharedMemoryChannel(int mem_fd, int to_server_bell, int from_server_bell,
+                        uint64_t entries);
+    ~SharedMemoryChannel();
+
+    SharedMemoryChannel(const SharedMemoryChannel&) = delete;
+    SharedMemoryChannel& operator=(const SharedMemoryChannel&) = delete;
+
+    bool Valid() const { return layout_ != nullptr; }
+
+    // Send a message to the simulator, false if the ring is full.
+    bool Send(const ChannelMessage& msg);
+
+    // Receive a message from the simulator, false if there is none.
+    bool Receive(ChannelMessage* msg);
+
+    // Wait until a message can be received, or timeout_ms milliseconds have
+    // passed, -1 to wait forever. Returns whether a message can be received.
+    bool Wait(int timeout_ms = -1);
+
+  private:
+    // These must match SharedMemoryServer::ChannelRing and ChannelLayout in
+    // gem5.
+    struct Ring
+    {
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+    };
+    struct Layout
+    {
+        uint64_t magic;
+        uint64_t entries;
+        Ring to_server;
+        Ring from_server;
+    };
+    static constexpr uint64_t kMagic = 0x6d65683567636863ULL;
+
+    ChannelMessage* Messages(bool to_server)
+    {
+        return reinterpret_cast<ChannelMessage*>(layout_ + 1) +
+               (to_server ? 0 : layout_->entries);
+    }
+
+    Layout* layout_ = nullptr;
+    size_t size_ = 0;
+    int mem_fd_;
+    int to_server_bell_;
+    int from_server_bell_;
+};
+
 class SharedMemoryClient
 {
   public:
     enum RequestType : int
     {
-        kGetPhysRange = 0
+        kGetPhysRange = 0,
+        kGetAllPhysRanges = 1,
+        kOpenChannel = 2,
+        kFence = 3,
+    };
+
+    // A range [start, end] of physical memory mapped at mem.
+    struct MappedRange
+    {
+        uint64_t start;
+        uint64_t end;
+        void* mem;
     };
 
     explicit SharedMemoryClient(const std::string& server_path);
+    ~SharedMemoryClient();
 
     // Request to access the range [start, end] of physical memory from the
     // viewpoint of the gem5 system providing the shared memory service.
@@ -68,12 +151,31 @@ class SharedMemoryClient
     // configure the kernel running in gem5 simulator to reserve such range.
     void* MapMemory(uint64_t start, uint64_t end);
 
+    // Request to access all the shared physical memory with a single request.
+    // Returns the ranges mapped, which are unmapped with UnmapMemory as well.
+    std::vector<MappedRange> MapAllMemory();
+
     // Unmap previous mapped region, no client is needed here.
     static bool UnmapMemory(void* mem);
 
+    // Open a channel to exchange messages with the simulator. The channel is
+    // closed when the client is destroyed. Returns nullptr on failure.
+    SharedMemoryChannel* OpenChannel();
+
+    // Make the accesses of the simulator so far visible to this process, and
+    // those of this process visible to the simulator. Returns the current
+    // tick of the simulation, or -1 on failure.
+    int64_t Fence();
+
   private:
     using AllocRecordStorage = std::unordered_map<void*, size_t>;
 
+    // Connection kept for the requests needing one, as the server closes
+    // the channel of a client with its connection.
+    int GetPersistentConnection();
+    bool RecvResponse(int sock_fd, void* buffer, size_t size, int* fds,
+                      size_t num_fds);
+
     int GetConnection();
     bool SendGetPhysRangeRequest(int sock_fd, uint64_t start, uint64_t end);
     bool RecvGetPhysRangeResponse(int sock_fd, int* ptr_fd, off_t* ptr_offset);
@@ -84,13 +186,116 @@ class SharedMemoryClient
     static AllocRecordStorage& GetAllocRecordStorage();
 
     std::string server_path_;
+    int persistent_fd_ = -1;
+    SharedMemoryChannel* channel_ = nullptr;
 };
 
+inline SharedMemoryChannel::SharedMemoryChannel(int mem_fd,
+                                                int to_server_bell,
+                                                int from_server_bell,
+                                                uint64_t entries)
+    : mem_fd_(mem_fd), to_server_bell_(to_server_bell),
+      from_server_bell_(from_server_bell)
+{
+    size_ = sizeof(Layout) + 2 * entries * sizeof(ChannelMessage);
+    void* mem = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     mem_fd_, 0);
+    if (mem == MAP_FAILED) {
+        warn("mmap failed");
+        return;
+    }
+    layout_ = reinterpret_cast<Layout*>(mem);
+    if (layout_->magic != kMagic || layout_->entries != entries) {
+        warnx("invalid channel memory");
+        munmap(mem, size_);
+        layout_ = nullptr;
+    }
+}
+
+inline SharedMemoryChannel::~SharedMemoryChannel()
+{
+    if (layout_) {
+        munmap(layout_, size_);
+    }
+    close(mem_fd_);
+    close(to_server_bell_);
+    close(from_server_bell_);
+}
+
+inline bool
+SharedMemoryChannel::Send(const ChannelMessage& msg)
+{
+    Ring& ring = layout_->to_server;
+    const uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+    if (tail - ring.head.load(std::memory_order_seq_cst) == layout_->entries) {
+        return false;
+    }
+    Messages(true)[tail & (layout_->entries - 1)] = msg;
+    ring.tail.store(tail + 1, std::memory_order_seq_cst);
+    // The simulator drains the ring until it finds it empty, so it only needs
+    // a doorbell if it may have done so already.
+    if (ring.head.load(std::memory_order_seq_cst) == tail) {
+        uint64_t one = 1;
+        if (write(to_server_bell_, &one, sizeof(one)) != sizeof(one)) {
+            warn("doorbell failed");
+        }
+    }
+    return true;
+}
+
+inline bool
+SharedMemoryChannel::Receive(ChannelMessage* msg)
+{
+    Ring& ring = layout_->from_server;
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (ring.tail.load(std::memory_order_seq_cst) == head) {
+        return false;
+    }
+    *msg = Messages(false)[head & (layout_->entries - 1)];
+    ring.head.store(head + 1, std::memory_order_seq_cst);
+    return true;
+}
+
+inline bool
+SharedMemoryChannel::Wait(int timeout_ms)
+{
+    Ring& ring = layout_->from_server;
+    auto ready = [&]() {
+        return ring.tail.load(std::memory_order_seq_cst) !=
+               ring.head.load(std::memory_order_relaxed);
+    };
+    while (!ready()) {
+        pollfd pfd = {.fd = from_server_bell_, .events = POLLIN, .revents = 0};
+        int retv = poll(&pfd, 1, timeout_ms);
+        if (retv < 0 && errno == EINTR) {
+            continue;
+        }
+        if (retv <= 0) {
+            return ready();
+        }
+        uint64_t count;
+        if (read(from_server_bell_, &count, sizeof(count)) < 0 &&
+            errno != EAGAIN) {
+            warn("doorbell failed");
+            return ready();
+        }
+    }
+    return true;
+}
+
 inline SharedMemoryClient::SharedMemoryClient(const std::string& server_path)
     : server_path_(server_path)
 {
 }
 
+inline SharedMemoryClient::~SharedMemoryClient()
+{
+    delete channel_;
+    if (persistent_fd_ >= 0) {
+        close(persistent_fd_);
+    }
+}
+
 
 inline void*
 SharedMemoryClient::MapMemory(uint64_t start, uint64_t end)
@@ -135,6 +340,152 @@ SharedMemoryClient::MapMemory(uint64_t start, uint64_t end)
     return mem;
 }
 
+inline std::vector<SharedMemoryClient::MappedRange>
+SharedMemoryClient::MapAllMemory()
+{
+    struct Range
+    {
+        uint64_t start;
+        uint64_t end;
+        uint64_t offset;
+    };
+    std::vector<MappedRange> mapped;
+    int sock_fd = GetConnection();
+    if (sock_fd < 0) {
+        warnx("cannot connect to shared memory server");
+        return mapped;
+    }
+
+    int shm_fd = -1;
+    int req_type = RequestType::kGetAllPhysRanges;
+    uint64_t count = 0;
+    std::vector<Range> ranges;
+    do {
+        if (!SendAll(sock_fd, &req_type, sizeof(req_type))) {
+            warnx("cannot send request to shared memory server");
+            break;
+        }
+        if (!RecvResponse(sock_fd, &count, sizeof(count), &shm_fd, 1)) {
+            warnx("failed to read shared memory server response");
+            break;
+        }
+        ranges.resize(count);
+        if (count && !RecvResponse(sock_fd, ranges.data(),
+                                   count * sizeof(Range), nullptr, 0)) {
+            warnx("failed to read shared memory server response");
+            ranges.clear();
+            break;
+        }
+    } while (false);
+
+    for (const auto& range : ranges) {
+        void* mem = DoMap(shm_fd, range.offset, range.end - range.start + 1);
+        if (mem == nullptr) {
+            warnx("failed to create memory mapping");
+            for (const auto& m : mapped) {
+                UnmapMemory(m.mem);
+            }
+            mapped.clear();
+            break;
+        }
+        mapped.push_back({range.start, range.end, mem});
+    }
+
+    close(sock_fd);
+    if (shm_fd >= 0) {
+        close(shm_fd);
+    }
+    return mapped;
+}
+
+inline SharedMemoryChannel*
+SharedMemoryClient::OpenChannel()
+{
+    if (channel_) {
+        return channel_;
+    }
+    int sock_fd = GetPersistentConnection();
+    if (sock_fd < 0) {
+        warnx("cannot connect to shared memory server");
+        return nullptr;
+    }
+    int req_type = RequestType::kOpenChannel;
+    uint64_t entries;
+    int fds[3] = {-1, -1, -1};
+    if (!SendAll(sock_fd, &req_type, sizeof(req_type)) ||
+        !RecvResponse(sock_fd, &entries, sizeof(entries), fds, 3)) {
+        warnx("cannot open channel");
+        return nullptr;
+    }
+    channel_ = new SharedMemoryChannel(fds[0], fds[1], fds[2], entries);
+    if (!channel_->Valid()) {
+        delete channel_;
+        channel_ = nullptr;
+    }
+    return channel_;
+}
+
+inline int64_t
+SharedMemoryClient::Fence()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int sock_fd = GetPersistentConnection();
+    int req_type = RequestType::kFence;
+    uint64_t tick;
+    if (sock_fd < 0 || !SendAll(sock_fd, &req_type, sizeof(req_type)) ||
+        !RecvResponse(sock_fd, &tick, sizeof(tick), nullptr, 0)) {
+        warnx("fence failed");
+        return -1;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return tick;
+}
+
+inline int
+SharedMemoryClient::GetPersistentConnection()
+{
+    if (persistent_fd_ < 0) {
+        persistent_fd_ = GetConnection();
+    }
+    return persistent_fd_;
+}
+
+inline bool
+SharedMemoryClient::RecvResponse(int sock_fd, void* buffer, size_t size,
+                                 int* fds, size_t num_fds)
+{
+    msghdr msg = {};
+    iovec io = {.iov_base = buffer, .iov_len = size};
+    msg.msg_iov = &io;
+    msg.msg_iovlen = 1;
+    union
+    {
+        char buffer[CMSG_SPACE(sizeof(int) * 3)];
+        struct cmsghdr align;
+    } cmsgs;
+    if (num_fds) {
+        msg.msg_control = cmsgs.buffer;
+        msg.msg_controllen = sizeof(cmsgs.buffer);
+    }
+    ssize_t retv = recvmsg(sock_fd, &msg, MSG_WAITALL);
+    if (retv < 0) {
+        warn("recvmsg failed");
+        return false;
+    }
+    if (retv != (ssize_t)size) {
+        warnx("cannot receive all response");
+        return false;
+    }
+    // The server sends no fd when there is nothing to map.
+    cmsghdr* cmsg = num_fds ? CMSG_FIRSTHDR(&msg) : nullptr;
+    if (cmsg && cmsg->cmsg_type == SCM_RIGHTS) {
+        size_t received = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        memcpy(fds, CMSG_DATA(cmsg),
+               sizeof(int) * std::min(received, num_fds));
+    }
+    return true;
+}
+
 inline bool
 SharedMemoryClient::UnmapMemory(void* mem)
 {
@@ -39,7 +39,9 @@
 
 import argparse
 import copy
+import mmap
 import os
+import struct
 import sys
 
 # Temporary storage for instructions. The queue is filled in out-of-order
@@ -66,6 +68,70 @@ insts = {
 }
 
 
+class BinaryTrace:
+    """Reads a trace written by a PipeTracer, presenting it as the text
+    lines the O3PipeView debug flag prints."""
+
+    magic = b"gem5pip\0"
+    header = struct.Struct("=8sIIQQ")
+    # seq_num, pc, disasm, micro_pc, pad and the ticks of fetch, decode,
+    # rename, dispatch, issue, complete, retire and store.
+    record = struct.Struct("=QQIHH8Q")
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        magic, version, record_size, num_records, num_strings = (
+            self.header.unpack_from(self.data)
+        )
+        if magic != self.magic or version != 1:
+            raise ValueError(f"{path} is not a pipe trace")
+        if record_size != self.record.size:
+            raise ValueError(f"{path} has records of {record_size} bytes")
+
+        offset = self.header.size + num_records * record_size
+        self.strings = []
+        for _ in range(num_strings):
+            (length,) = struct.unpack_from("=I", self.data, offset)
+            offset += 4
+            self.strings.append(self.data[offset : offset + length].decode())
+            offset += length
+
+        self.num_records = num_records
+        self.next_record = 0
+        self.lines = []
+
+    @classmethod
+    def detect(cls, path):
+        with open(path, "rb") as f:
+            return f.read(len(cls.magic)) == cls.magic
+
+    def readline(self):
+        if not self.lines:
+            if self.next_record == self.num_records:
+                return ""
+            sn, pc, disasm, upc, _, *ticks = self.record.unpack_from(
+                self.data,
+                self.header.size + self.next_record * self.record.size,
+            )
+            self.next_record += 1
+            fetch, decode, rename, dispatch, issue, complete, retire, store = (
+                ticks
+            )
+            self.lines = [
+                f"O3PipeView:fetch:{fetch}:0x{pc:08x}:{upc}:{sn}:"
+                f"{self.strings[disasm]}\n",
+                f"O3PipeView:decode:{decode}\n",
+                f"O3PipeView:rename:{rename}\n",
+                f"O3PipeView:dispatch:{dispatch}\n",
+                f"O3PipeView:issue:{issue}\n",
+                f"O3PipeView:complete:{complete}\n",
+                f"O3PipeView:retire:{retire}:store:{store}\n",
+            ]
+            self.lines.reverse()
+        return self.lines.pop()
+
+
 def process_trace(
     trace,
     outfile,
@@ -511,19 +577,22 @@ def main():
         sys.exit(1)
     # Process trace
     print("Processing trace... ", end=" ")
-    with open(args.tracefile) as trace:
-        with open(args.outfile, "w") as out:
-            process_trace(
-                trace,
-                out,
-                args.cycle_time,
-                args.width,
-                args.color,
-                args.timestamps,
-                args.only_committed,
-                args.store_completions,
-                *(tick_range + inst_range),
-            )
+    if BinaryTrace.detect(args.tracefile):
+        trace = BinaryTrace(args.tracefile)
+    else:
+        trace = open(args.tracefile)
+    with open(args.outfile, "w") as out:
+        process_trace(
+            trace,
+            out,
+            args.cycle_time,
+            args.width,
+            args.color,
+            args.timestamps,
+            args.only_committed,
+            args.store_completions,
+            *(tick_range + inst_range),
+        )
     print("done!")
 
 
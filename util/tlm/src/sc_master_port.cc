@@ -46,7 +46,7 @@ gem5::PacketPtr
 SCMasterPort::generatePacket(tlm::tlm_generic_payload& trans)
 {
     gem5::Request::Flags flags;
-    auto req = std::make_shared<gem5::Request>(
+    auto req = gem5::makeRequest(
         trans.get_address(), trans.get_data_length(), flags,
         owner.id);
 